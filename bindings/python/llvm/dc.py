@@ -0,0 +1,362 @@
+#===- dc.py - Python DC Bindings -----------------------------*- python -*--===#
+#
+#                     The LLVM Compiler Infrastructure
+#
+# This file is distributed under the University of Illinois Open Source
+# License. See LICENSE.TXT for details.
+#
+#===------------------------------------------------------------------------===#
+
+r"""
+Decompiler Interface
+====================
+
+This module exposes the decompiler library: the control flow graph of the code
+of a binary, as recovered by llvm-dec, and its translation to IR.
+
+The functions, basic blocks and instructions of a Binary are numbered in
+address order. Their properties are arrays owned by the binary, exposed
+without copies as ctypes arrays: they support the buffer protocol, so that
+scripts can scan them with memoryview, or numpy.frombuffer, rather than by
+creating an object per instruction.
+
+    binary = Binary('/bin/ls', arch='x86_64')
+
+    # The functions, and their blocks, as objects.
+    for function in binary.functions:
+        for block in function.blocks:
+            print hex(block.address), len(block.instruction_addresses)
+
+    # All the instructions, as arrays.
+    import numpy
+    opcodes = numpy.frombuffer(binary.instruction_opcodes, dtype=numpy.uint32)
+    sizes = numpy.frombuffer(binary.instruction_sizes, dtype=numpy.uint8)
+
+    # The IR of the code, as an llvm.core.Module.
+    module = binary.translate(opt_level=2)
+"""
+
+from ctypes import POINTER
+from ctypes import byref
+from ctypes import c_char_p
+from ctypes import c_size_t
+from ctypes import c_uint
+from ctypes import c_uint32
+from ctypes import c_uint64
+from ctypes import c_uint8
+from ctypes import c_void_p
+from ctypes import create_string_buffer
+from ctypes import sizeof
+
+from .common import CachedProperty
+from .common import LLVMObject
+from .common import c_object_p
+from .common import get_library
+from .core import Context
+from .core import Module
+
+__all__ = [
+    'BasicBlock',
+    'Binary',
+    'Function',
+    'Instruction',
+    'lib',
+]
+
+lib = get_library()
+
+_initialized = False
+_targets = ['AArch64', 'X86']
+def _ensure_initialized():
+    global _initialized
+    if not _initialized:
+        # As in disassembler.py: the LLVMInitializeAll* functions are static
+        # inline, so the initializers of each target are called instead.
+        for tgt in _targets:
+            for initializer in ('TargetInfo', 'TargetMC', 'Disassembler',
+                                'TargetDC'):
+                try:
+                    f = getattr(lib, 'LLVMInitialize' + tgt + initializer)
+                except AttributeError:
+                    continue
+                f()
+        _initialized = True
+
+def _array(binary, ptr, ctype, begin, end):
+    """Obtain the elements [begin, end) of a C array of the binary, in place.
+
+    The array keeps a reference to the binary, which owns its memory.
+    """
+    array = (ctype * (end - begin))
+    if begin == end or not ptr:
+        return array()
+    view = array.from_address(ptr + begin * sizeof(ctype))
+    view._binary = binary
+    return view
+
+class Binary(LLVMObject):
+    """Represents a binary, disassembled.
+
+    The control flow graph of its code is recovered when it is created.
+    """
+
+    def __init__(self, filename, arch=None, jobs=1):
+        """Load and disassemble the object file at filename.
+
+        arch selects the slice of a universal binary, such as 'x86_64'.
+        jobs is the number of threads disassembling the code.
+        """
+        _ensure_initialized()
+
+        out = c_char_p(None)
+        ptr = lib.LLVMDCCreateBinary(filename, arch, jobs, byref(out))
+        if not ptr:
+            raise Exception('Could not load binary: %s' % out.value)
+
+        LLVMObject.__init__(self, ptr, disposer=lib.LLVMDCDisposeBinary)
+
+    @CachedProperty
+    def triple(self):
+        """The target triple of the binary."""
+        return lib.LLVMDCGetBinaryTriple(self)
+
+    @CachedProperty
+    def entrypoint(self):
+        """The address of the entrypoint of the binary, or 0."""
+        return lib.LLVMDCGetBinaryEntrypoint(self)
+
+    @CachedProperty
+    def num_functions(self):
+        return lib.LLVMDCGetNumFunctions(self)
+
+    @CachedProperty
+    def num_basic_blocks(self):
+        return lib.LLVMDCGetNumBasicBlocks(self)
+
+    @CachedProperty
+    def num_instructions(self):
+        return lib.LLVMDCGetNumInstructions(self)
+
+    @CachedProperty
+    def function_addresses(self):
+        """The entry address of each function, as a uint64 array."""
+        return _array(self, lib.LLVMDCGetFunctionAddresses(self), c_uint64,
+                      0, self.num_functions)
+
+    @CachedProperty
+    def function_block_begins(self):
+        """The first block of each function, and the number of blocks."""
+        return _array(self, lib.LLVMDCGetFunctionBlockBegins(self), c_uint32,
+                      0, self.num_functions + 1)
+
+    @CachedProperty
+    def block_addresses(self):
+        """The start address of each basic block, as a uint64 array."""
+        return _array(self, lib.LLVMDCGetBlockAddresses(self), c_uint64,
+                      0, self.num_basic_blocks)
+
+    @CachedProperty
+    def block_instruction_begins(self):
+        """The first instruction of each block, and the number of
+        instructions."""
+        return _array(self, lib.LLVMDCGetBlockInstructionBegins(self),
+                      c_uint64, 0, self.num_basic_blocks + 1)
+
+    @CachedProperty
+    def instruction_addresses(self):
+        """The address of each instruction, as a uint64 array."""
+        return self.get_instruction_addresses(0, self.num_instructions)
+
+    @CachedProperty
+    def instruction_sizes(self):
+        """The size of each instruction, as a uint8 array."""
+        return self.get_instruction_sizes(0, self.num_instructions)
+
+    @CachedProperty
+    def instruction_opcodes(self):
+        """The target opcode of each instruction, as a uint32 array."""
+        return self.get_instruction_opcodes(0, self.num_instructions)
+
+    def get_instruction_addresses(self, begin, end):
+        """Obtain the addresses of the instructions [begin, end), in place."""
+        return _array(self, lib.LLVMDCGetInstructionAddresses(self), c_uint64,
+                      begin, end)
+
+    def get_instruction_sizes(self, begin, end):
+        """Obtain the sizes of the instructions [begin, end), in place."""
+        return _array(self, lib.LLVMDCGetInstructionSizes(self), c_uint8,
+                      begin, end)
+
+    def get_instruction_opcodes(self, begin, end):
+        """Obtain the opcodes of the instructions [begin, end), in place."""
+        return _array(self, lib.LLVMDCGetInstructionOpcodes(self), c_uint32,
+                      begin, end)
+
+    @property
+    def functions(self):
+        """The functions of the binary, in address order.
+
+        This is a generator for llvm.dc.Function instances.
+        """
+        for i in range(self.num_functions):
+            yield Function(self, i)
+
+    def get_opcode_name(self, opcode):
+        """Obtain the name of a target opcode, or None."""
+        return lib.LLVMDCGetOpcodeName(self, opcode)
+
+    def get_instruction_text(self, index):
+        """Obtain instruction index, in the assembly syntax of the target."""
+        buf = create_string_buffer(128)
+        size = lib.LLVMDCPrintInstruction(self, index, buf, len(buf))
+        if size >= len(buf):
+            buf = create_string_buffer(size + 1)
+            lib.LLVMDCPrintInstruction(self, index, buf, len(buf))
+        return buf.value
+
+    def translate(self, opt_level=2, jobs=1, context=None):
+        """Translate the code of the binary to an llvm.core.Module.
+
+        opt_level is the -O level of llvm-dec, from 0 to 3. The binary can be
+        translated again, at other levels.
+        """
+        if context is None:
+            context = Context.GetGlobalContext()
+        return Module(lib.LLVMDCTranslateBinary(self, context, opt_level,
+                                                jobs))
+
+class Function(object):
+    """Represents a function of a Binary."""
+
+    def __init__(self, binary, index):
+        self.binary = binary
+        self.index = index
+
+    @CachedProperty
+    def name(self):
+        return lib.LLVMDCGetFunctionName(self.binary, self.index)
+
+    @CachedProperty
+    def address(self):
+        return self.binary.function_addresses[self.index]
+
+    @property
+    def blocks(self):
+        """The basic blocks of the function, in address order.
+
+        This is a generator for llvm.dc.BasicBlock instances.
+        """
+        begins = self.binary.function_block_begins
+        for i in range(begins[self.index], begins[self.index + 1]):
+            yield BasicBlock(self.binary, i)
+
+class BasicBlock(object):
+    """Represents a basic block of a Binary."""
+
+    def __init__(self, binary, index):
+        self.binary = binary
+        self.index = index
+
+    @CachedProperty
+    def address(self):
+        return self.binary.block_addresses[self.index]
+
+    @CachedProperty
+    def instruction_range(self):
+        """The indices of the instructions of the block, as (begin, end)."""
+        begins = self.binary.block_instruction_begins
+        return (begins[self.index], begins[self.index + 1])
+
+    @CachedProperty
+    def instruction_addresses(self):
+        return self.binary.get_instruction_addresses(*self.instruction_range)
+
+    @CachedProperty
+    def instruction_sizes(self):
+        return self.binary.get_instruction_sizes(*self.instruction_range)
+
+    @CachedProperty
+    def instruction_opcodes(self):
+        return self.binary.get_instruction_opcodes(*self.instruction_range)
+
+    @property
+    def instructions(self):
+        """The instructions of the block.
+
+        This is a generator for llvm.dc.Instruction instances: scanning the
+        arrays is faster.
+        """
+        for i in range(*self.instruction_range):
+            yield Instruction(self.binary, i)
+
+class Instruction(object):
+    """Represents an instruction of a Binary."""
+
+    def __init__(self, binary, index):
+        self.binary = binary
+        self.index = index
+
+    @CachedProperty
+    def address(self):
+        return self.binary.instruction_addresses[self.index]
+
+    @CachedProperty
+    def size(self):
+        return self.binary.instruction_sizes[self.index]
+
+    @CachedProperty
+    def opcode(self):
+        return self.binary.instruction_opcodes[self.index]
+
+    @CachedProperty
+    def opcode_name(self):
+        return self.binary.get_opcode_name(self.opcode)
+
+    @CachedProperty
+    def text(self):
+        return self.binary.get_instruction_text(self.index)
+
+def register_library(library):
+    library.LLVMDCCreateBinary.argtypes = [c_char_p, c_char_p, c_uint,
+                                           POINTER(c_char_p)]
+    library.LLVMDCCreateBinary.restype = c_object_p
+
+    library.LLVMDCDisposeBinary.argtypes = [Binary]
+
+    library.LLVMDCGetBinaryTriple.argtypes = [Binary]
+    library.LLVMDCGetBinaryTriple.restype = c_char_p
+
+    library.LLVMDCGetBinaryEntrypoint.argtypes = [Binary]
+    library.LLVMDCGetBinaryEntrypoint.restype = c_uint64
+
+    library.LLVMDCGetNumFunctions.argtypes = [Binary]
+    library.LLVMDCGetNumFunctions.restype = c_uint
+
+    library.LLVMDCGetNumBasicBlocks.argtypes = [Binary]
+    library.LLVMDCGetNumBasicBlocks.restype = c_uint
+
+    library.LLVMDCGetNumInstructions.argtypes = [Binary]
+    library.LLVMDCGetNumInstructions.restype = c_uint64
+
+    library.LLVMDCGetFunctionName.argtypes = [Binary, c_uint]
+    library.LLVMDCGetFunctionName.restype = c_char_p
+
+    # The arrays are read in place: their addresses are kept as integers.
+    for name in ['FunctionAddresses', 'FunctionBlockBegins', 'BlockAddresses',
+                 'BlockInstructionBegins', 'InstructionAddresses',
+                 'InstructionSizes', 'InstructionOpcodes']:
+        f = getattr(library, 'LLVMDCGet' + name)
+        f.argtypes = [Binary]
+        f.restype = c_void_p
+
+    library.LLVMDCGetOpcodeName.argtypes = [Binary, c_uint]
+    library.LLVMDCGetOpcodeName.restype = c_char_p
+
+    library.LLVMDCPrintInstruction.argtypes = [Binary, c_uint64, c_char_p,
+                                               c_size_t]
+    library.LLVMDCPrintInstruction.restype = c_size_t
+
+    library.LLVMDCTranslateBinary.argtypes = [Binary, Context, c_uint, c_uint]
+    library.LLVMDCTranslateBinary.restype = c_object_p
+
+register_library(lib)
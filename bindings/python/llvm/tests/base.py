@@ -36,3 +36,10 @@ class TestBase(unittest.TestCase):
 
     def get_test_bc(self):
         return os.path.join(os.path.dirname(os.path.abspath(__file__)), "test.bc")
+
+    def get_test_macho(self):
+        """The x86-64 Mach-O executable of the object file tests."""
+        return os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                            os.pardir, os.pardir, os.pardir, os.pardir,
+                            "test", "Object", "Inputs",
+                            "hello-world.macho-x86_64")
@@ -0,0 +1,66 @@
+from ctypes import addressof
+
+from .base import TestBase
+from ..core import Module
+from ..dc import BasicBlock
+from ..dc import Binary
+from ..dc import Function
+
+class TestDC(TestBase):
+    def get_binary(self):
+        return Binary(self.get_test_macho())
+
+    def test_create_from_file(self):
+        b = self.get_binary()
+        self.assertTrue(b.triple.startswith('x86_64'))
+        self.assertEqual(b.entrypoint, 0x100000F30)
+
+    def test_functions(self):
+        b = self.get_binary()
+        functions = list(b.functions)
+        self.assertEqual(len(functions), b.num_functions)
+        self.assertEqual([f.address for f in functions], [0x100000F30])
+        for f in functions:
+            assert isinstance(f, Function)
+            assert isinstance(f.name, str)
+            for block in f.blocks:
+                assert isinstance(block, BasicBlock)
+
+    def test_arrays(self):
+        b = self.get_binary()
+        addresses = b.instruction_addresses
+        sizes = b.instruction_sizes
+        self.assertEqual(len(addresses), b.num_instructions)
+        self.assertEqual(len(sizes), b.num_instructions)
+        self.assertEqual(len(b.instruction_opcodes), b.num_instructions)
+        self.assertEqual(b.block_instruction_begins[b.num_basic_blocks],
+                         b.num_instructions)
+        # The instructions of a block follow each other.
+        for f in b.functions:
+            for block in f.blocks:
+                begin, end = block.instruction_range
+                self.assertEqual(block.instruction_addresses[0],
+                                 block.address)
+                for i in range(begin + 1, end):
+                    self.assertEqual(addresses[i],
+                                     addresses[i - 1] + sizes[i - 1])
+        # The arrays are views of the binary.
+        block = next(next(b.functions).blocks)
+        self.assertEqual(addressof(block.instruction_addresses),
+                         addressof(addresses) + 8 * block.instruction_range[0])
+
+    def test_instructions(self):
+        b = self.get_binary()
+        f = next(b.functions)
+        i = next(next(f.blocks).instructions)
+        self.assertEqual(i.address, 0x100000F30)
+        self.assertEqual(i.size, 1)
+        self.assertEqual(i.opcode_name, 'PUSH64r')
+        self.assertEqual(i.text, 'pushq\t%rbp')
+
+    def test_translate(self):
+        b = self.get_binary()
+        m = b.translate(opt_level=2)
+        assert isinstance(m, Module)
+        names = [f.name for f in m]
+        self.assertIn('fn_100000F30', names)
@@ -0,0 +1,111 @@
+/*===-- llvm-c/DC.h - Decompiler Lib C Iface --------------------*- C++ -*-===*/
+/*                                                                            */
+/*                     The LLVM Compiler Infrastructure                       */
+/*                                                                            */
+/* This file is distributed under the University of Illinois Open Source      */
+/* License. See LICENSE.TXT for details.                                      */
+/*                                                                            */
+/*===----------------------------------------------------------------------===*/
+/*                                                                            */
+/* This header declares the C interface to libLLVMDC.a, which recovers the    */
+/* control flow graph of the code of object files, and translates it to IR.   */
+/*                                                                            */
+/* The functions, basic blocks and instructions of a binary are numbered in   */
+/* address order, and their properties are read as arrays, owned by the       */
+/* binary: the bindings can scan them without a call per instruction.         */
+/*                                                                            */
+/*===----------------------------------------------------------------------===*/
+
+#ifndef LLVM_C_DC_H
+#define LLVM_C_DC_H
+
+#include "llvm-c/Core.h"
+#include "llvm/Support/DataTypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup LLVMCDC Decompiler
+ * @ingroup LLVMC
+ *
+ * The targets, their disassemblers and their DC semantics must be
+ * initialized first, see LLVMInitializeAllTargetDCs.
+ *
+ * @{
+ */
+
+typedef struct LLVMOpaqueDCBinary *LLVMDCBinaryRef;
+
+/**
+ * Load the object file at Path, or, for a universal binary, its ArchName
+ * slice, and recover the control flow graph of its code, with NumJobs
+ * threads.
+ * Returns NULL, with why in OutMessage, to be freed with LLVMDisposeMessage,
+ * if it can't be loaded or disassembled.
+ */
+LLVMDCBinaryRef LLVMDCCreateBinary(const char *Path, const char *ArchName,
+                                   unsigned NumJobs, char **OutMessage);
+void LLVMDCDisposeBinary(LLVMDCBinaryRef B);
+
+/** The target triple of the binary. */
+const char *LLVMDCGetBinaryTriple(LLVMDCBinaryRef B);
+/** The address of the entrypoint of the binary, or 0 if it has none. */
+uint64_t LLVMDCGetBinaryEntrypoint(LLVMDCBinaryRef B);
+
+unsigned LLVMDCGetNumFunctions(LLVMDCBinaryRef B);
+unsigned LLVMDCGetNumBasicBlocks(LLVMDCBinaryRef B);
+uint64_t LLVMDCGetNumInstructions(LLVMDCBinaryRef B);
+
+/** The name of function F. */
+const char *LLVMDCGetFunctionName(LLVMDCBinaryRef B, unsigned F);
+/** The entry addresses of the functions. */
+const uint64_t *LLVMDCGetFunctionAddresses(LLVMDCBinaryRef B);
+/**
+ * The first basic block of each function, and the number of basic blocks:
+ * the blocks of function F are [Begins[F], Begins[F + 1]).
+ */
+const uint32_t *LLVMDCGetFunctionBlockBegins(LLVMDCBinaryRef B);
+
+/** The start addresses of the basic blocks. */
+const uint64_t *LLVMDCGetBlockAddresses(LLVMDCBinaryRef B);
+/**
+ * The first instruction of each basic block, and the number of instructions:
+ * the instructions of block BB are [Begins[BB], Begins[BB + 1]).
+ */
+const uint64_t *LLVMDCGetBlockInstructionBegins(LLVMDCBinaryRef B);
+
+/** The addresses, sizes, and target opcodes of the instructions. */
+const uint64_t *LLVMDCGetInstructionAddresses(LLVMDCBinaryRef B);
+const uint8_t *LLVMDCGetInstructionSizes(LLVMDCBinaryRef B);
+const uint32_t *LLVMDCGetInstructionOpcodes(LLVMDCBinaryRef B);
+
+/** The name of target opcode Opcode, or NULL if it isn't one. */
+const char *LLVMDCGetOpcodeName(LLVMDCBinaryRef B, unsigned Opcode);
+
+/**
+ * Print instruction I to OutString, in the assembly syntax of the target.
+ * Returns the length of the text, which is truncated to OutStringSize - 1
+ * characters and NUL terminated.
+ */
+size_t LLVMDCPrintInstruction(LLVMDCBinaryRef B, uint64_t I, char *OutString,
+                              size_t OutStringSize);
+
+/**
+ * Translate the code of the binary to a module of context C, optimized at
+ * OptLevel, 0 to 3, as with the -O option of llvm-dec, by NumJobs threads.
+ * The binary can be translated again, at other levels.
+ */
+LLVMModuleRef LLVMDCTranslateBinary(LLVMDCBinaryRef B, LLVMContextRef C,
+                                    unsigned OptLevel, unsigned NumJobs);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
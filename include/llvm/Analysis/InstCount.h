@@ -0,0 +1,47 @@
+//===- llvm/Analysis/InstCount.h - Count the instructions -------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares InstCounts, the counts of the InstCount pass, for the
+// clients that want them without going through the statistics.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ANALYSIS_INSTCOUNT_H
+#define LLVM_ANALYSIS_INSTCOUNT_H
+
+#include "llvm/IR/Instruction.h"
+#include "llvm/Support/DataTypes.h"
+
+namespace llvm {
+
+class Function;
+class Module;
+
+/// \brief The number of functions with a body, of basic blocks, and of
+/// instructions of each opcode, of some functions.
+struct InstCounts {
+  uint64_t NumFunctions;
+  uint64_t NumBlocks;
+  uint64_t NumInsts;
+  uint64_t NumOpcodeInsts[Instruction::OtherOpsEnd];
+
+  InstCounts();
+
+  /// \brief Count the instructions of \p F, if it has a body.
+  void add(const Function &F);
+  /// \brief Count the instructions of all the functions of \p M.
+  void add(const Module &M);
+  void add(const InstCounts &Other);
+
+  uint64_t get(unsigned Opcode) const { return NumOpcodeInsts[Opcode]; }
+};
+
+} // end namespace llvm
+
+#endif
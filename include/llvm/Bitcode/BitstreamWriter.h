@@ -61,12 +61,6 @@ class BitstreamWriter {
   };
   std::vector<BlockInfo> BlockInfoRecords;
 
-  // BackpatchWord - Backpatch a 32-bit word in the output with the specified
-  // value.
-  void BackpatchWord(unsigned ByteNo, unsigned NewWord) {
-    support::endian::write32le(&Out[ByteNo], NewWord);
-  }
-
   void WriteByte(unsigned char Value) {
     Out.push_back(Value);
   }
@@ -99,6 +93,35 @@ public:
   /// \brief Retrieve the current position in the stream, in bits.
   uint64_t GetCurrentBitNo() const { return GetBufferOffset() * 8 + CurBit; }
 
+  /// \brief Backpatch a 32-bit word in the output at the given bit offset
+  /// with the specified value. The bit offset doesn't need to be word, or even
+  /// byte aligned, but the word must have been flushed to the output.
+  void BackpatchWord(uint64_t BitNo, unsigned NewWord) {
+    unsigned ByteNo = BitNo / 8;
+    unsigned Shift = BitNo & 7;
+    if (!Shift) {
+      support::endian::write32le(&Out[ByteNo], NewWord);
+      return;
+    }
+    // The unaligned word straddles 5 bytes: merge it with the bits around it.
+    uint64_t Bits = 0;
+    for (unsigned i = 0; i != 5; ++i)
+      Bits |= uint64_t((unsigned char)Out[ByteNo + i]) << (i * 8);
+    Bits &= ~(uint64_t(0xFFFFFFFFu) << Shift);
+    Bits |= uint64_t(NewWord) << Shift;
+    for (unsigned i = 0; i != 5; ++i)
+      Out[ByteNo + i] = (char)(Bits >> (i * 8));
+  }
+
+  /// \brief Append \p Words, whole 32-bit words written by another
+  /// BitstreamWriter, e.g. blocks encoded on another thread. The stream must
+  /// be on a word boundary.
+  void EmitWords(StringRef Words) {
+    assert(CurBit == 0 && "Not 32-bit aligned");
+    assert((Words.size() & 3) == 0 && "Not a whole number of words");
+    Out.append(Words.begin(), Words.end());
+  }
+
   //===--------------------------------------------------------------------===//
   // Basic Primitives for emitting bits to the stream.
   //===--------------------------------------------------------------------===//
@@ -232,10 +255,10 @@ public:
 
     // Compute the size of the block, in words, not counting the size field.
     unsigned SizeInWords = GetWordIndex() - B.StartSizeWord - 1;
-    unsigned ByteNo = B.StartSizeWord*4;
+    uint64_t BitNo = uint64_t(B.StartSizeWord) * 32;
 
     // Update the block size field in the header of this sub-block.
-    BackpatchWord(ByteNo, SizeInWords);
+    BackpatchWord(BitNo, SizeInWords);
 
     // Restore the inner block's code size and abbrev table.
     CurCodeSize = B.PrevCodeSize;
@@ -0,0 +1,49 @@
+//===-- llvm/DC/DCAddressTable.h - DC Address Table -------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares functions to read the machine code address each IR
+// instruction was translated from, as tagged by DCIRBuilder, and to write them
+// as a compact address table, suitable as a sidecar of the output module.
+//
+// The table lists each defined function, in module order, followed by the runs
+// of consecutive instructions sharing an address:
+//
+//   <function name> <number of runs>
+//   <index of the first instruction of the run> <hex address, or '-'>
+//   ...
+//
+// Instructions are indexed in function order, starting at 0. A run with no
+// address ('-') covers untagged instructions.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_DC_DCADDRESSTABLE_H
+#define LLVM_DC_DCADDRESSTABLE_H
+
+#include "llvm/Support/DataTypes.h"
+
+namespace llvm {
+class Instruction;
+class Module;
+class raw_ostream;
+
+/// \brief Get the address \p I was translated from, in \p Addr.
+/// Also accepts the hexadecimal string tags of older modules.
+/// \returns false if \p I isn't tagged.
+bool getDCInstAddress(const Instruction &I, uint64_t &Addr);
+
+/// \brief Write the address table of all the defined functions of \p M.
+void writeDCAddressTable(const Module &M, raw_ostream &OS);
+
+/// \brief Remove the address tags of all the instructions in \p M.
+void stripDCInstAddresses(Module &M);
+
+} // end namespace llvm
+
+#endif
@@ -19,6 +19,9 @@
 
 #include "llvm/DC/DCTranslatedInstTracker.h"
 #include "llvm/IR/AssemblyAnnotationWriter.h"
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace llvm {
 class MCInstPrinter;
@@ -31,6 +34,14 @@ class DCAnnotationWriter : public AssemblyAnnotationWriter {
   const MCRegisterInfo &MRI;
   MCInstPrinter &IP;
   const MCSubtargetInfo &STI;
+  /// \brief The text of each tracked instruction, by position in DTIT, once
+  /// printed, with the instruction it was printed from: the positions change
+  /// when DTIT is finalized again.
+  std::vector<std::pair<const MCDecodedInst *, std::string>> InstTexts;
+
+  /// \brief Get the text of the tracked instruction \p VI is an info of,
+  /// printing it the first time.
+  StringRef getInstText(const DCTranslatedInst::ValueInfo &VI);
 
 public:
   DCAnnotationWriter(const DCTranslatedInstTracker &DTIT,
@@ -0,0 +1,70 @@
+//===-- llvm/DC/DCBlockProfile.h - Block profile of a run -------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares DCBlockProfile, the number of times each edge of the MC
+// CFG of a module was taken, and each function entered, in a run of its
+// translation, as counted from the block trace -enable-dc-block-trace writes.
+//
+// The translation of the conditional branches then gets the weights of their
+// edges, and the functions their entry count: the optimizer and the code
+// generator lay the hot paths out as straight-line traces, with the cold
+// blocks out of the way, as a dynamic translator forms superblocks.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_DC_DCBLOCKPROFILE_H
+#define LLVM_DC_DCBLOCKPROFILE_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringRef.h"
+#include <string>
+#include <utility>
+
+namespace llvm {
+
+class MCModule;
+
+class DCBlockProfile {
+public:
+  /// \brief Count the edges and function entries of the block trace
+  /// \p Trace, one hexadecimal block address per line, under the thread
+  /// headers, with the blocks of \p MCM.
+  /// A trace entry that isn't the start of a block of the module, or that
+  /// doesn't follow a block it is a successor of, isn't counted.
+  /// \returns false, with the reason in \p ErrMsg, if \p Trace isn't a block
+  /// trace.
+  bool read(StringRef Trace, const MCModule &MCM, std::string &ErrMsg);
+
+  /// \brief Get the number of times the edge from the block at \p From to
+  /// that at \p To was taken.
+  uint64_t getEdgeCount(uint64_t From, uint64_t To) const {
+    auto I = EdgeCounts.find(std::make_pair(From, To));
+    return I == EdgeCounts.end() ? 0 : I->second;
+  }
+
+  /// \brief Get the number of times the function at \p Addr was entered.
+  uint64_t getEntryCount(uint64_t Addr) const {
+    auto I = EntryCounts.find(Addr);
+    return I == EntryCounts.end() ? 0 : I->second;
+  }
+
+  bool empty() const { return EdgeCounts.empty() && EntryCounts.empty(); }
+
+  /// \brief Hash the counts, which the translation of the branches depends
+  /// on, for the translation cache.
+  std::string hash() const;
+
+private:
+  DenseMap<std::pair<uint64_t, uint64_t>, uint64_t> EdgeCounts;
+  DenseMap<uint64_t, uint64_t> EntryCounts;
+};
+
+} // end namespace llvm
+
+#endif
@@ -0,0 +1,81 @@
+//===-- llvm/DC/DCCallSummaries.h - Register usage of callees ---*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares DCCallSummaries, the registers each function of an
+// MCModule can read and clobber, with everything it calls, so that the call
+// sites only save the registers the callee can read to the regset, and only
+// reload those it can change.
+//
+// The summaries are computed bottom-up over the direct call graph, one
+// strongly connected component at a time: the functions of a component share
+// theirs. The calls that don't go to a function of the module, to external
+// functions or through a register, read and clobber what the calling
+// convention allows, as with -enable-dc-abi-calls.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_DC_DCCALLSUMMARIES_H
+#define LLVM_DC_DCCALLSUMMARIES_H
+
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/DenseMap.h"
+#include <string>
+#include <vector>
+
+namespace llvm {
+
+class DCRegisterSema;
+class MCInstrAnalysis;
+class MCModule;
+struct DCStubTargets;
+
+/// \brief The registers a call to a function can read and clobber. Only the
+/// largest registers, those with a slot in the regset, are set.
+struct DCCallSummary {
+  BitVector Read;
+  BitVector Clobbered;
+  /// \brief Whether the function can access memory other than the regset:
+  /// it loads or stores, has side effects, or calls out of the module.
+  bool AccessesMemory = false;
+};
+
+class DCCallSummaries {
+public:
+  /// \brief Compute the summaries of the functions of \p MCM, whose
+  /// instructions must not be released yet, with the calls found by \p MIA,
+  /// the registers and calling convention of \p DRS, and the stubs of
+  /// \p Stubs, if not null. The usage of each function is computed on
+  /// \p NumJobs threads.
+  void compute(const MCModule &MCM, const MCInstrAnalysis &MIA,
+               DCRegisterSema &DRS, const DCStubTargets *Stubs,
+               unsigned NumJobs);
+
+  /// \brief Get the summary of the function at \p Addr, or null if it isn't
+  /// known.
+  const DCCallSummary *lookup(uint64_t Addr) const {
+    auto I = SummaryIndices.find(Addr);
+    return I == SummaryIndices.end() ? nullptr : &Summaries[I->second];
+  }
+
+  bool empty() const { return SummaryIndices.empty(); }
+
+  /// \brief Hash the summaries, which the translation of the calls depends
+  /// on, for the translation cache.
+  std::string hash() const;
+
+private:
+  /// \brief The summary of each strongly connected component.
+  std::vector<DCCallSummary> Summaries;
+  /// \brief The index in Summaries of each function, by entry address.
+  DenseMap<uint64_t, unsigned> SummaryIndices;
+};
+
+} // end namespace llvm
+
+#endif
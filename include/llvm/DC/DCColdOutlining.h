@@ -0,0 +1,39 @@
+//===-- llvm/DC/DCColdOutlining.h - Cold path outlining ---------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares outlineColdPaths, which moves the cold paths of a
+// translated function to functions of their own.
+//
+// A block is cold if it calls a function that doesn't return to report an
+// error: objc_exception_throw, __assert_rtn, the swift_*Failure functions of
+// the Swift runtime, llvm.trap, the C and C++ runtime functions known not to
+// return, or any declared noreturn. The block, and those it dominates, only
+// run on the way to that call: they are outlined together, except for the
+// blocks that return, which stay in the function.
+//
+// It adds functions to the module, which a FunctionPass can't: it runs on
+// each function once its function passes are done, when the registers are
+// SSA values, which the outlined code takes as arguments.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_DC_DCCOLDOUTLINING_H
+#define LLVM_DC_DCCOLDOUTLINING_H
+
+namespace llvm {
+class Function;
+
+/// \brief Outline the cold paths of \p F, each to a function named after it,
+/// with a ".cold" suffix.
+/// \returns true if anything was outlined.
+bool outlineColdPaths(Function &F);
+
+} // end namespace llvm
+
+#endif
@@ -0,0 +1,212 @@
+//===-- llvm/DC/DCDecompilerSession.h - Embeddable decompiler ---*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares the DCDecompilerTarget and DCDecompilerSession classes,
+// the whole decompilation pipeline, from an object file to IR modules, for
+// the clients that decompile many inputs in the same process.
+//
+// The target description is built once, and shared by all threads; each
+// thread has its own session, which reuses its semantics from one input to
+// the next.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_DC_DCDECOMPILERSESSION_H
+#define LLVM_DC_DCDECOMPILERSESSION_H
+
+#include "llvm/DC/DCInstrSema.h"
+#include "llvm/DC/DCTranslator.h"
+#include "llvm/IR/DataLayout.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include <memory>
+#include <string>
+
+namespace llvm {
+
+class MCAsmInfo;
+class MCContext;
+class MCDisassembler;
+class MCInstPrinter;
+class MCInstrAnalysis;
+class MCInstrInfo;
+class MCModule;
+class MCObjectDisassembler;
+class MCObjectFileInfo;
+class MCObjectSymbolizer;
+class MCRegisterInfo;
+class MCSubtargetInfo;
+class Target;
+
+namespace object {
+class ObjectFile;
+}
+
+/// \brief The MC description of a target, for a triple.
+/// It is only read once created: it can be shared by all the sessions, on
+/// all threads, and must outlive them.
+class DCDecompilerTarget {
+  const Target *TheTarget;
+  std::string TripleName;
+  DataLayout DL;
+  std::unique_ptr<const MCRegisterInfo> MRI;
+  std::unique_ptr<const MCAsmInfo> MAI;
+  std::unique_ptr<const MCSubtargetInfo> STI;
+  std::unique_ptr<const MCInstrInfo> MII;
+  std::unique_ptr<const MCInstrAnalysis> MIA;
+
+  DCDecompilerTarget(const Target *TheTarget, StringRef TripleName);
+
+public:
+  ~DCDecompilerTarget();
+
+  /// \brief Create the description of the target of \p TripleName. Return
+  /// null, and why in \p Error, if the target or any of its MC tables is
+  /// unavailable.
+  static std::unique_ptr<DCDecompilerTarget> create(StringRef TripleName,
+                                                    std::string &Error);
+
+  const Target &getTarget() const { return *TheTarget; }
+  const std::string &getTripleName() const { return TripleName; }
+  const DataLayout &getDataLayout() const { return DL; }
+  const MCRegisterInfo &getRegisterInfo() const { return *MRI; }
+  const MCAsmInfo &getAsmInfo() const { return *MAI; }
+  const MCSubtargetInfo &getSubtargetInfo() const { return *STI; }
+  const MCInstrInfo &getInstrInfo() const { return *MII; }
+  /// \brief The instruction analysis, or null if the target has none.
+  const MCInstrAnalysis *getInstrAnalysis() const { return MIA.get(); }
+};
+
+/// \brief The MC CFG of an object file, and what its translation needs of
+/// the disassembly. It refers to the object file, which must outlive it.
+class DCDisassembly {
+  friend class DCDecompilerSession;
+
+  std::unique_ptr<MCObjectFileInfo> MOFI;
+  std::unique_ptr<MCContext> MCCtx;
+  std::unique_ptr<MCDisassembler> DisAsmImpl;
+  std::unique_ptr<MCDisassembler> DisAsm;
+  std::unique_ptr<MCInstPrinter> MIP;
+  std::unique_ptr<MCObjectSymbolizer> MOS;
+  DCStubTargets Stubs;
+  DCDataSectionList DataSections;
+  std::unique_ptr<MCObjectDisassembler> OD;
+  std::unique_ptr<MCModule> MCM;
+
+  DCDisassembly();
+
+public:
+  ~DCDisassembly();
+
+  MCModule &getModule() { return *MCM; }
+  const MCModule &getModule() const { return *MCM; }
+  MCInstPrinter &getInstPrinter() { return *MIP; }
+  /// \brief The entrypoint of the object, or 0 if it has none.
+  uint64_t getEntrypoint() const;
+};
+
+/// \brief The decompilation of inputs for a target, one at a time.
+/// The DC semantics are created once, and switched to the module of each
+/// input: the session isn't thread-safe, but the threads can each have their
+/// own, for the same target.
+class DCDecompilerSession {
+public:
+  struct Options {
+    TransOpt::Level OptLevel;
+    /// \brief The threads of the disassembly, and of the translation.
+    unsigned MCJobs;
+    unsigned DCJobs;
+    /// \brief Cache the decoded instructions, see MCCachingDisassembler.
+    bool DisassemblyCache;
+    /// \brief The function the main function wrapper calls, or 0 for the
+    /// entrypoint of the object.
+    uint64_t Entrypoint;
+    /// \brief Wrap the external functions to run the translation, rather
+    /// than only declare them, see DCTranslator::setExternalWrappers.
+    bool ExternalWrappers;
+    /// \brief For Mach-O inputs, translate the read-only sections to one
+    /// global each, see collectMachODataSections.
+    bool SectionGlobals;
+    /// \brief See DCCallSummaries.
+    bool CallSummaries;
+    /// \brief See DCTranslator::setCalleeSavedSpillAnalysis.
+    bool ElideCalleeSaved;
+    /// \brief Reuse the translations of the cache, which the sessions can
+    /// share, see DCTranslator::setTranslationCache.
+    DCTranslationCache *Cache;
+    /// \brief The names of the functions, and the Objective-C methods, see
+    /// DCTranslator::setFunctionNames and setObjCMessageIndex.
+    const DCFunctionNameMap *FunctionNames;
+    const DCObjCMessageIndex *ObjCMessages;
+    /// \brief Pass the modules to the streamer once they have
+    /// StreamFunctions functions, or StreamInsts IR instructions, see
+    /// DCTranslator::setModuleStreaming. The last one is returned.
+    unsigned StreamFunctions;
+    uint64_t StreamInsts;
+    DCTranslator::ModuleStreamerTy Streamer;
+
+    Options()
+        : OptLevel(TransOpt::Default), MCJobs(1), DCJobs(1),
+          DisassemblyCache(false), Entrypoint(0), ExternalWrappers(false),
+          SectionGlobals(false), CallSummaries(false),
+          ElideCalleeSaved(false), Cache(nullptr), FunctionNames(nullptr),
+          ObjCMessages(nullptr), StreamFunctions(0), StreamInsts(0),
+          Streamer() {}
+  };
+
+private:
+  const DCDecompilerTarget &DTarget;
+  std::unique_ptr<DCRegisterSema> DRS;
+  std::unique_ptr<DCInstrSema> DIS;
+
+  DCDecompilerSession(const DCDecompilerTarget &DTarget,
+                      std::unique_ptr<DCRegisterSema> DRS,
+                      std::unique_ptr<DCInstrSema> DIS);
+
+public:
+  ~DCDecompilerSession();
+
+  /// \brief Create a session decompiling for \p DTarget. Return null, and
+  /// why in \p Error, if the target has no DC semantics.
+  static std::unique_ptr<DCDecompilerSession>
+  create(const DCDecompilerTarget &DTarget, std::string &Error);
+
+  const DCDecompilerTarget &getTarget() const { return DTarget; }
+  DCRegisterSema &getRegisterSema() { return *DRS; }
+  DCInstrSema &getInstrSema() { return *DIS; }
+
+  /// \brief Decompile \p Obj, for the target of the session, into a module of
+  /// \p Ctx. Return null, and why in \p Error, if it can't be disassembled.
+  /// Nothing of \p Obj is kept once this returns, but what the options
+  /// point to.
+  std::unique_ptr<Module> decompile(const object::ObjectFile &Obj,
+                                    LLVMContext &Ctx, const Options &Opts,
+                                    std::string &Error);
+
+  /// \brief Recover the MC CFG of \p Obj, the first half of decompile.
+  /// Return null, and why in \p Error, if it can't be disassembled.
+  std::unique_ptr<DCDisassembly> disassemble(const object::ObjectFile &Obj,
+                                             const Options &Opts,
+                                             std::string &Error);
+
+  /// \brief Translate \p D, disassembled by this session, into a module of
+  /// \p Ctx, the second half of decompile. \p D can be translated again,
+  /// with other options.
+  std::unique_ptr<Module> translate(DCDisassembly &D, LLVMContext &Ctx,
+                                    const Options &Opts);
+
+  /// \brief Decompile the object file in \p Buffer, or, for a universal
+  /// binary, its \p ArchName slice, as the other overload does.
+  std::unique_ptr<Module> decompile(MemoryBufferRef Buffer, StringRef ArchName,
+                                    LLVMContext &Ctx, const Options &Opts,
+                                    std::string &Error);
+};
+
+} // end namespace llvm
+
+#endif
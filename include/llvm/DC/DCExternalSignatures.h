@@ -0,0 +1,77 @@
+//===-- llvm/DC/DCExternalSignatures.h - External call types ----*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares DCExternalSignatures, the C types of the external
+// functions the binaries commonly call through their stubs: libSystem, the
+// CoreFoundation and Foundation C functions, and the Objective-C runtime.
+// With -enable-dc-typed-external-calls, the calls to them are translated to
+// direct calls taking and returning their arguments, rather than the regset.
+//
+// A signature is a string of type characters, the result, then the
+// arguments:
+//   v  void              c  i8 (bool, char)     i  i32
+//   l  i64 (long, size)  p  i8* (pointer, id)   r  i8** (pointer to one)
+//   f  float             d  double
+// The variadic functions, e.g. printf or objc_msgSend, pass some arguments on
+// the stack, and aren't in the database.
+//
+// The builtin signatures can be extended, or overridden, by the file given
+// with -dc-external-signatures, with one "<name> <signature>" by line, and
+// comments starting with '#'.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_DC_DCEXTERNALSIGNATURES_H
+#define LLVM_DC_DCEXTERNALSIGNATURES_H
+
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include <string>
+
+namespace llvm {
+
+class FunctionType;
+class LLVMContext;
+
+class DCExternalSignatures {
+public:
+  /// \brief Get the signatures of the process, loaded the first time.
+  static const DCExternalSignatures &get();
+
+  /// \brief Get the signature of the external function \p Name, or an empty
+  /// string if it isn't known.
+  StringRef lookup(StringRef Name) const {
+    auto I = Signatures.find(Name);
+    return I == Signatures.end() ? StringRef() : StringRef(I->second);
+  }
+
+  /// \brief Get the function type of signature \p Sig.
+  static FunctionType *getFunctionType(StringRef Sig, LLVMContext &Ctx);
+
+  /// \brief Hash the signatures, which the translation of the calls depends
+  /// on, for the translation cache.
+  StringRef hash() const { return Hash; }
+
+  /// \brief Parse the "<name> <signature>" lines of \p Buffer, named
+  /// \p BufferName, into the signatures. Return false, with why in \p Error,
+  /// if one isn't valid.
+  bool parse(StringRef Buffer, StringRef BufferName, std::string &Error);
+
+  DCExternalSignatures();
+
+private:
+  StringMap<std::string> Signatures;
+  std::string Hash;
+
+  void computeHash();
+};
+
+} // end namespace llvm
+
+#endif
@@ -0,0 +1,69 @@
+//===-- llvm/DC/DCGuestMemory.h - Memory of translated code -----*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares the DCGuestMemory class, the memory of a Mach-O whose
+// translated code runs in the current process, with its segments mapped in
+// the host.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_DC_DCGUESTMEMORY_H
+#define LLVM_DC_DCGUESTMEMORY_H
+
+#include "llvm/Support/DataTypes.h"
+#include <cstddef>
+#include <system_error>
+
+namespace llvm {
+
+namespace object {
+class MachOObjectFile;
+}
+
+/// \brief The segments of a Mach-O, copied to a single host mapping.
+///
+/// The segments are mapped at their own addresses when the host has them
+/// free, and the translated code then uses the guest addresses as they are.
+/// Otherwise, they are mapped elsewhere, and the translated code adds the
+/// base of the mapping, getBase(), to the addresses it loads from and stores
+/// to: see DCRegisterSema::setGuestMemoryBase. Either way, the accesses don't
+/// need a lookup.
+///
+/// The segments are all readable and writable, and __PAGEZERO isn't mapped.
+/// Nothing is bound nor rebased: the pointers of the segments are the guest
+/// addresses, as the translated code expects them, but the imported symbols
+/// aren't resolved.
+class DCGuestMemory {
+  void *Region;
+  size_t RegionSize;
+  uint64_t Base;
+
+  DCGuestMemory(const DCGuestMemory &) = delete;
+  void operator=(const DCGuestMemory &) = delete;
+
+public:
+  DCGuestMemory() : Region(nullptr), RegionSize(0), Base(0) {}
+  ~DCGuestMemory();
+
+  /// \brief Map the segments of \p MachO: at \p HostAddr, if not 0, or at
+  /// their own addresses if they are free, or wherever the host puts them.
+  std::error_code map(const object::MachOObjectFile &MachO,
+                      uint64_t HostAddr = 0);
+
+  /// \brief What to add to a guest address for the host one, 0 if the
+  /// segments are at their own addresses.
+  uint64_t getBase() const { return Base; }
+  void *getHostAddress(uint64_t GuestAddr) const {
+    return reinterpret_cast<void *>(uintptr_t(GuestAddr + Base));
+  }
+};
+
+} // end namespace llvm
+
+#endif
@@ -0,0 +1,398 @@
+//===-- llvm/DC/DCIRBuilder.h - DC IR Builder -------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines DCIRBuilder, the IRBuilder used by the DC semantics.
+// It can tag every instruction it creates with the address of the machine
+// instruction being translated. See DCAddressTable.h for a compact, sidecar
+// form of these tags.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_DC_DCIRBUILDER_H
+#define LLVM_DC_DCIRBUILDER_H
+
+#include "llvm/IR/ConstantFolder.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Metadata.h"
+#include "llvm/IR/NoFolder.h"
+
+namespace llvm {
+
+/// \brief The name of the metadata kind DC builders tag instructions with.
+/// The attached node holds a single i64 constant: the address of the machine
+/// instruction the IR instruction was translated from.
+static const char DCInstAddressMDKind[] = "num";
+
+/// \brief The address of the machine code being translated, kept by each
+/// DCRegisterSema (and thus each translator) instead of living in the
+/// LLVMContext.
+struct DCInstAddress {
+  /// \brief Whether new instructions should be tagged with Addr.
+  bool Record;
+  uint64_t Addr;
+  /// \brief The number of instructions created by the builders using this,
+  /// to measure how much IR the semantics produce.
+  mutable uint64_t NumCreated;
+
+  DCInstAddress()
+      : Record(false), Addr(0), NumCreated(0), Node(nullptr),
+        NodeCtx(nullptr), NodeAddr(0) {}
+
+  /// \brief Get the address node for Addr in \p Ctx.
+  /// The last node is cached: consecutive instructions mostly share their
+  /// address, and don't need to go through the uniquing tables. The node
+  /// is never looked at to check the cache: it is freed with its context.
+  MDNode *getNode(LLVMContext &Ctx) const {
+    if (!Node || NodeAddr != Addr || NodeCtx != &Ctx) {
+      Node = MDNode::get(Ctx, ConstantAsMetadata::get(ConstantInt::get(
+                                  Type::getInt64Ty(Ctx), Addr)));
+      NodeCtx = &Ctx;
+      NodeAddr = Addr;
+    }
+    return Node;
+  }
+
+private:
+  mutable MDNode *Node;
+  mutable const LLVMContext *NodeCtx;
+  mutable uint64_t NodeAddr;
+};
+
+/// \brief IRBuilder inserter that tags new instructions with the current
+/// DCInstAddress, as DCInstAddressMDKind metadata.
+class DCIRInserter : public IRBuilderDefaultInserter<true> {
+  const DCInstAddress *CurAddr;
+  unsigned MDKind;
+
+public:
+  DCIRInserter(const DCInstAddress *CurAddr = nullptr, unsigned MDKind = 0)
+      : CurAddr(CurAddr), MDKind(MDKind) {}
+
+protected:
+  void InsertHelper(Instruction *I, const Twine &Name, BasicBlock *BB,
+                    BasicBlock::iterator InsertPt) const {
+    IRBuilderDefaultInserter<true>::InsertHelper(I, Name, BB, InsertPt);
+    if (!CurAddr)
+      return;
+    ++CurAddr->NumCreated;
+    if (CurAddr->Record)
+      I->setMetadata(MDKind, CurAddr->getNode(I->getContext()));
+  }
+};
+
+/// \brief The IRBuilder folder of the DC builders: a NoFolder, so that each
+/// operation of the semantics is an instruction tagged with its address, or
+/// with -dc-fold, a ConstantFolder, so that the operations on constants (e.g.
+/// the immediates and the instruction address) don't reach the IR at all.
+class DCFolder {
+  bool Fold;
+
+public:
+  explicit DCFolder(bool Fold = false) : Fold(Fold) {}
+
+  bool isFolding() const { return Fold; }
+
+  Value *CreateAdd(Constant *LHS, Constant *RHS,
+                   bool HasNUW = false, bool HasNSW = false) const {
+    if (Fold)
+      return ConstantFolder().CreateAdd(LHS, RHS, HasNUW, HasNSW);
+    return NoFolder().CreateAdd(LHS, RHS, HasNUW, HasNSW);
+  }
+  Value *CreateFAdd(Constant *LHS, Constant *RHS) const {
+    if (Fold)
+      return ConstantFolder().CreateFAdd(LHS, RHS);
+    return NoFolder().CreateFAdd(LHS, RHS);
+  }
+  Value *CreateSub(Constant *LHS, Constant *RHS,
+                   bool HasNUW = false, bool HasNSW = false) const {
+    if (Fold)
+      return ConstantFolder().CreateSub(LHS, RHS, HasNUW, HasNSW);
+    return NoFolder().CreateSub(LHS, RHS, HasNUW, HasNSW);
+  }
+  Value *CreateFSub(Constant *LHS, Constant *RHS) const {
+    if (Fold)
+      return ConstantFolder().CreateFSub(LHS, RHS);
+    return NoFolder().CreateFSub(LHS, RHS);
+  }
+  Value *CreateMul(Constant *LHS, Constant *RHS,
+                   bool HasNUW = false, bool HasNSW = false) const {
+    if (Fold)
+      return ConstantFolder().CreateMul(LHS, RHS, HasNUW, HasNSW);
+    return NoFolder().CreateMul(LHS, RHS, HasNUW, HasNSW);
+  }
+  Value *CreateFMul(Constant *LHS, Constant *RHS) const {
+    if (Fold)
+      return ConstantFolder().CreateFMul(LHS, RHS);
+    return NoFolder().CreateFMul(LHS, RHS);
+  }
+  Value *CreateUDiv(Constant *LHS, Constant *RHS,
+                    bool isExact = false) const {
+    if (Fold)
+      return ConstantFolder().CreateUDiv(LHS, RHS, isExact);
+    return NoFolder().CreateUDiv(LHS, RHS, isExact);
+  }
+  Value *CreateSDiv(Constant *LHS, Constant *RHS,
+                    bool isExact = false) const {
+    if (Fold)
+      return ConstantFolder().CreateSDiv(LHS, RHS, isExact);
+    return NoFolder().CreateSDiv(LHS, RHS, isExact);
+  }
+  Value *CreateFDiv(Constant *LHS, Constant *RHS) const {
+    if (Fold)
+      return ConstantFolder().CreateFDiv(LHS, RHS);
+    return NoFolder().CreateFDiv(LHS, RHS);
+  }
+  Value *CreateURem(Constant *LHS, Constant *RHS) const {
+    if (Fold)
+      return ConstantFolder().CreateURem(LHS, RHS);
+    return NoFolder().CreateURem(LHS, RHS);
+  }
+  Value *CreateSRem(Constant *LHS, Constant *RHS) const {
+    if (Fold)
+      return ConstantFolder().CreateSRem(LHS, RHS);
+    return NoFolder().CreateSRem(LHS, RHS);
+  }
+  Value *CreateFRem(Constant *LHS, Constant *RHS) const {
+    if (Fold)
+      return ConstantFolder().CreateFRem(LHS, RHS);
+    return NoFolder().CreateFRem(LHS, RHS);
+  }
+  Value *CreateShl(Constant *LHS, Constant *RHS,
+                   bool HasNUW = false, bool HasNSW = false) const {
+    if (Fold)
+      return ConstantFolder().CreateShl(LHS, RHS, HasNUW, HasNSW);
+    return NoFolder().CreateShl(LHS, RHS, HasNUW, HasNSW);
+  }
+  Value *CreateLShr(Constant *LHS, Constant *RHS,
+                    bool isExact = false) const {
+    if (Fold)
+      return ConstantFolder().CreateLShr(LHS, RHS, isExact);
+    return NoFolder().CreateLShr(LHS, RHS, isExact);
+  }
+  Value *CreateAShr(Constant *LHS, Constant *RHS,
+                    bool isExact = false) const {
+    if (Fold)
+      return ConstantFolder().CreateAShr(LHS, RHS, isExact);
+    return NoFolder().CreateAShr(LHS, RHS, isExact);
+  }
+  Value *CreateAnd(Constant *LHS, Constant *RHS) const {
+    if (Fold)
+      return ConstantFolder().CreateAnd(LHS, RHS);
+    return NoFolder().CreateAnd(LHS, RHS);
+  }
+  Value *CreateOr(Constant *LHS, Constant *RHS) const {
+    if (Fold)
+      return ConstantFolder().CreateOr(LHS, RHS);
+    return NoFolder().CreateOr(LHS, RHS);
+  }
+  Value *CreateXor(Constant *LHS, Constant *RHS) const {
+    if (Fold)
+      return ConstantFolder().CreateXor(LHS, RHS);
+    return NoFolder().CreateXor(LHS, RHS);
+  }
+  Value *CreateBinOp(Instruction::BinaryOps Opc,
+                     Constant *LHS, Constant *RHS) const {
+    if (Fold)
+      return ConstantFolder().CreateBinOp(Opc, LHS, RHS);
+    return NoFolder().CreateBinOp(Opc, LHS, RHS);
+  }
+  Value *CreateNeg(Constant *C,
+                   bool HasNUW = false, bool HasNSW = false) const {
+    if (Fold)
+      return ConstantFolder().CreateNeg(C, HasNUW, HasNSW);
+    return NoFolder().CreateNeg(C, HasNUW, HasNSW);
+  }
+  Value *CreateFNeg(Constant *C) const {
+    if (Fold)
+      return ConstantFolder().CreateFNeg(C);
+    return NoFolder().CreateFNeg(C);
+  }
+  Value *CreateNot(Constant *C) const {
+    if (Fold)
+      return ConstantFolder().CreateNot(C);
+    return NoFolder().CreateNot(C);
+  }
+  Value *CreateGetElementPtr(Type *Ty, Constant *C,
+                             ArrayRef<Constant *> IdxList) const {
+    if (Fold)
+      return ConstantFolder().CreateGetElementPtr(Ty, C, IdxList);
+    return NoFolder().CreateGetElementPtr(Ty, C, IdxList);
+  }
+  Value *CreateGetElementPtr(Type *Ty, Constant *C, Constant *Idx) const {
+    if (Fold)
+      return ConstantFolder().CreateGetElementPtr(Ty, C, Idx);
+    return NoFolder().CreateGetElementPtr(Ty, C, Idx);
+  }
+  Value *CreateGetElementPtr(Type *Ty, Constant *C,
+                             ArrayRef<Value *> IdxList) const {
+    if (Fold)
+      return ConstantFolder().CreateGetElementPtr(Ty, C, IdxList);
+    return NoFolder().CreateGetElementPtr(Ty, C, IdxList);
+  }
+  Value *CreateInBoundsGetElementPtr(Type *Ty, Constant *C,
+                                     ArrayRef<Constant *> IdxList) const {
+    if (Fold)
+      return ConstantFolder().CreateInBoundsGetElementPtr(Ty, C, IdxList);
+    return NoFolder().CreateInBoundsGetElementPtr(Ty, C, IdxList);
+  }
+  Value *CreateInBoundsGetElementPtr(Type *Ty, Constant *C,
+                                     Constant *Idx) const {
+    if (Fold)
+      return ConstantFolder().CreateInBoundsGetElementPtr(Ty, C, Idx);
+    return NoFolder().CreateInBoundsGetElementPtr(Ty, C, Idx);
+  }
+  Value *CreateInBoundsGetElementPtr(Type *Ty, Constant *C,
+                                     ArrayRef<Value *> IdxList) const {
+    if (Fold)
+      return ConstantFolder().CreateInBoundsGetElementPtr(Ty, C, IdxList);
+    return NoFolder().CreateInBoundsGetElementPtr(Ty, C, IdxList);
+  }
+  Value *CreateCast(Instruction::CastOps Op, Constant *C,
+                    Type *DestTy) const {
+    if (Fold)
+      return ConstantFolder().CreateCast(Op, C, DestTy);
+    return NoFolder().CreateCast(Op, C, DestTy);
+  }
+  Value *CreatePointerCast(Constant *C, Type *DestTy) const {
+    if (Fold)
+      return ConstantFolder().CreatePointerCast(C, DestTy);
+    return NoFolder().CreatePointerCast(C, DestTy);
+  }
+  Value *CreatePointerBitCastOrAddrSpaceCast(Constant *C,
+                                             Type *DestTy) const {
+    if (Fold)
+      return ConstantFolder().CreatePointerBitCastOrAddrSpaceCast(C, DestTy);
+    return CastInst::CreatePointerBitCastOrAddrSpaceCast(C, DestTy);
+  }
+  Value *CreateIntCast(Constant *C, Type *DestTy,
+                       bool isSigned) const {
+    if (Fold)
+      return ConstantFolder().CreateIntCast(C, DestTy, isSigned);
+    return NoFolder().CreateIntCast(C, DestTy, isSigned);
+  }
+  Value *CreateFPCast(Constant *C, Type *DestTy) const {
+    if (Fold)
+      return ConstantFolder().CreateFPCast(C, DestTy);
+    return NoFolder().CreateFPCast(C, DestTy);
+  }
+  Value *CreateBitCast(Constant *C, Type *DestTy) const {
+    if (Fold)
+      return ConstantFolder().CreateBitCast(C, DestTy);
+    return NoFolder().CreateBitCast(C, DestTy);
+  }
+  Value *CreateIntToPtr(Constant *C, Type *DestTy) const {
+    if (Fold)
+      return ConstantFolder().CreateIntToPtr(C, DestTy);
+    return NoFolder().CreateIntToPtr(C, DestTy);
+  }
+  Value *CreatePtrToInt(Constant *C, Type *DestTy) const {
+    if (Fold)
+      return ConstantFolder().CreatePtrToInt(C, DestTy);
+    return NoFolder().CreatePtrToInt(C, DestTy);
+  }
+  Value *CreateZExtOrBitCast(Constant *C, Type *DestTy) const {
+    if (Fold)
+      return ConstantFolder().CreateZExtOrBitCast(C, DestTy);
+    return NoFolder().CreateZExtOrBitCast(C, DestTy);
+  }
+  Value *CreateSExtOrBitCast(Constant *C, Type *DestTy) const {
+    if (Fold)
+      return ConstantFolder().CreateSExtOrBitCast(C, DestTy);
+    return NoFolder().CreateSExtOrBitCast(C, DestTy);
+  }
+  Value *CreateTruncOrBitCast(Constant *C, Type *DestTy) const {
+    if (Fold)
+      return ConstantFolder().CreateTruncOrBitCast(C, DestTy);
+    return NoFolder().CreateTruncOrBitCast(C, DestTy);
+  }
+  Value *CreateICmp(CmpInst::Predicate P, Constant *LHS,
+                    Constant *RHS) const {
+    if (Fold)
+      return ConstantFolder().CreateICmp(P, LHS, RHS);
+    return NoFolder().CreateICmp(P, LHS, RHS);
+  }
+  Value *CreateFCmp(CmpInst::Predicate P, Constant *LHS,
+                    Constant *RHS) const {
+    if (Fold)
+      return ConstantFolder().CreateFCmp(P, LHS, RHS);
+    return NoFolder().CreateFCmp(P, LHS, RHS);
+  }
+  Value *CreateSelect(Constant *C, Constant *True, Constant *False) const {
+    if (Fold)
+      return ConstantFolder().CreateSelect(C, True, False);
+    return NoFolder().CreateSelect(C, True, False);
+  }
+  Value *CreateExtractElement(Constant *Vec, Constant *Idx) const {
+    if (Fold)
+      return ConstantFolder().CreateExtractElement(Vec, Idx);
+    return NoFolder().CreateExtractElement(Vec, Idx);
+  }
+  Value *CreateInsertElement(Constant *Vec, Constant *NewElt,
+                             Constant *Idx) const {
+    if (Fold)
+      return ConstantFolder().CreateInsertElement(Vec, NewElt, Idx);
+    return NoFolder().CreateInsertElement(Vec, NewElt, Idx);
+  }
+  Value *CreateShuffleVector(Constant *V1, Constant *V2,
+                             Constant *Mask) const {
+    if (Fold)
+      return ConstantFolder().CreateShuffleVector(V1, V2, Mask);
+    return NoFolder().CreateShuffleVector(V1, V2, Mask);
+  }
+  Value *CreateExtractValue(Constant *Agg,
+                            ArrayRef<unsigned> IdxList) const {
+    if (Fold)
+      return ConstantFolder().CreateExtractValue(Agg, IdxList);
+    return NoFolder().CreateExtractValue(Agg, IdxList);
+  }
+  Value *CreateInsertValue(Constant *Agg, Constant *Val,
+                           ArrayRef<unsigned> IdxList) const {
+    if (Fold)
+      return ConstantFolder().CreateInsertValue(Agg, Val, IdxList);
+    return NoFolder().CreateInsertValue(Agg, Val, IdxList);
+  }
+};
+
+class DCIRBuilder : public IRBuilder<true, DCFolder, DCIRInserter> {
+  typedef IRBuilder<true, DCFolder, DCIRInserter> BaseTy;
+
+public:
+  explicit DCIRBuilder(LLVMContext &C, const DCInstAddress *CurAddr = nullptr)
+      : BaseTy(C, DCFolder(shouldFold()), getInserter(C, CurAddr)) {}
+
+  explicit DCIRBuilder(BasicBlock *TheBB,
+                       const DCInstAddress *CurAddr = nullptr)
+      : BaseTy(TheBB->getContext(), DCFolder(shouldFold()),
+               getInserter(TheBB->getContext(), CurAddr)) {
+    SetInsertPoint(TheBB);
+  }
+
+  DCIRBuilder(BasicBlock *TheBB, BasicBlock::iterator IP,
+              const DCInstAddress *CurAddr = nullptr)
+      : BaseTy(TheBB->getContext(), DCFolder(shouldFold()),
+               getInserter(TheBB->getContext(), CurAddr)) {
+    SetInsertPoint(TheBB, IP);
+  }
+
+  /// \brief Whether new builders fold constants, per -dc-fold.
+  static bool shouldFold();
+
+private:
+  static DCIRInserter getInserter(LLVMContext &C,
+                                  const DCInstAddress *CurAddr) {
+    if (!CurAddr)
+      return DCIRInserter();
+    return DCIRInserter(CurAddr, C.getMDKindID(DCInstAddressMDKind));
+  }
+};
+
+} // end namespace llvm
+
+#endif
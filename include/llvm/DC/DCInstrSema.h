@@ -22,30 +22,150 @@
 
 #include "llvm/DC/DCOpcodes.h"
 #include "llvm/DC/DCRegisterSema.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/Triple.h"
+#include "llvm/ADT/Twine.h"
 #include "llvm/CodeGen/ValueTypes.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/Function.h"
-#include "llvm/IR/IRBuilder.h"
 #include "llvm/IR/Module.h"
-#include "llvm/IR/NoFolder.h"
+#include "llvm/MC/MCAnalysis/MCCalleeSavedSpills.h"
+#include "llvm/MC/MCAnalysis/MCConstantRegs.h"
+#include "llvm/MC/MCAnalysis/MCMemoryTransfers.h"
 #include "llvm/MC/MCAnalysis/MCFunction.h"
 #include "llvm/MC/MCInst.h"
 #include "llvm/MC/MCStreamer.h"
 #include "llvm/Support/ErrorHandling.h"
+#include <string>
 #include <vector>
 
 namespace llvm {
+class DCBlockProfile;
+class DCCallSummaries;
 class MCContext;
+class MCInstrAnalysis;
 class DCTranslatedInst;
+class raw_ostream;
+
+// The name of the metadata kind setTagCallBasicBlocks tags the calls of the
+// call basic blocks with. The attached node holds a single i64 constant: the
+// start address of the machine basic block of the call.
+static const char DCCallBBMDKind[] = "dc.call.bb";
+
+// The functions the stubs of an executable jump to, resolved before the
+// translation: calls to a stub are translated to calls to the external
+// function it jumps to, by name, or to the local one, by address.
+// The calls through the constant pointers of the GOT and of the pointer
+// tables, found with DCInstrSema::setConstantCallAnalysis, are translated the
+// same way, from the pointers by address.
+struct DCStubTargets {
+  DenseMap<uint64_t, std::string> ExternalNames;
+  DenseMap<uint64_t, uint64_t> LocalAddrs;
+  DenseMap<uint64_t, std::string> PointerNames;
+  DenseMap<uint64_t, uint64_t> PointerAddrs;
+
+  bool isStub(uint64_t Addr) const {
+    return ExternalNames.count(Addr) || LocalAddrs.count(Addr);
+  }
+  bool empty() const {
+    return ExternalNames.empty() && LocalAddrs.empty() &&
+           PointerNames.empty() && PointerAddrs.empty();
+  }
+};
+
+// The names of the functions, by address, computed before the translation.
+// The functions without one are named "fn_<address>".
+typedef DenseMap<uint64_t, std::string> DCFunctionNameMap;
+
+// A section of pointers, or of constant objects, that the code refers to by
+// address: with constant folding, see DCInstrSema::FoldConstants, the
+// addresses of its entries are translated to global variables, e.g.
+// @selref_<address>, rather than to integers.
+// The globals of the C strings and the CFStrings are constants, initialized
+// from Contents; the others are declarations.
+// A whole Section is a single global, an external [Size x i8] constant named
+// @section_<address>, in the section Name: the addresses in it are offsets
+// in that global, which is meant to be backed by the bytes of the file.
+struct DCDataSection {
+  enum KindTy {
+    SelRefs,   ///< __objc_selrefs: pointers to selector names.
+    ClassRefs, ///< __objc_classrefs: pointers to classes.
+    CFStrings, ///< __cfstring: constant CFString objects.
+    GOT,       ///< __got: pointers to external symbols.
+    CStrings,  ///< __cstring: NUL-terminated strings, of EntrySize 1.
+    Section    ///< A read-only section, of EntrySize 1.
+  };
+  uint64_t Addr;
+  uint64_t Size;
+  uint64_t EntrySize;
+  KindTy Kind;
+  // The contents of the CStrings and CFStrings sections, which must outlive
+  // the translation, or empty.
+  StringRef Contents;
+  // The "segment,section" name of a Section.
+  std::string Name;
+};
+// The data sections, sorted by address.
+typedef std::vector<DCDataSection> DCDataSectionList;
+
+// The Objective-C metadata that the calls to objc_msgSend are resolved with,
+// computed before the translation: the selectors and classes the selector
+// and class references point to, by address, and the class methods of the
+// binary, by "+[Class selector]" name. A message to a class, whose receiver
+// and selector are loaded from references in the block of the call, goes
+// directly to its method. The references also name the selectors and classes
+// of the messages setTagObjCMessages tags.
+struct DCObjCMessageIndex {
+  DenseMap<uint64_t, std::string> SelectorRefs;
+  DenseMap<uint64_t, std::string> ClassRefs;
+  StringMap<uint64_t> ClassMethods;
+
+  bool empty() const { return ClassMethods.empty(); }
+};
+
+// A synthesized Objective-C property accessor, found with
+// DCInstrSema::matchObjCAccessor: a getter loads the instance variable at
+// Offset from self, of Size bytes, into the result register, and a setter
+// stores the value argument to it. If RuntimeFn isn't empty, the getter
+// returns its result on the loaded object, and the setter calls it with the
+// address of the variable and the value instead, as in:
+//   ldr x0, [x0, #8]                    add x0, x0, #8
+//   b   _objc_retainAutoreleaseReturnValue   mov x1, x2
+//                                       b   _objc_storeStrong
+struct DCObjCAccessor {
+  bool IsSetter;
+  int64_t Offset;
+  unsigned Size;
+  StringRef RuntimeFn;
+};
+
+// The inline cache of an objc_msgSend call site, with
+// -enable-dc-objc-message-caches: the translation of the method that the
+// first receiver, whose isa was Isa, was sent. The receivers with the same
+// isa call Entry directly; the others, and nil, go through the
+// __llvm_dc_objc_cache_miss runtime function, which fills the cache once,
+// and otherwise lets objc_msgSend look up the method.
+struct DCObjCMessageCache {
+  uint64_t Isa;
+  void *Entry;
+};
 
 class DCInstrSema {
 public:
   virtual ~DCInstrSema();
 
+  // Translate \p DecodedInst, recording the values it used and defined in
+  // \p TranslatedInst, for the annotations. Without annotations, pass null:
+  // nothing is recorded, and no value handle created.
   bool translateInst(const MCDecodedInst &DecodedInst,
-                     DCTranslatedInst &TranslatedInst);
+                     DCTranslatedInst *TranslatedInst = nullptr);
 
   void SwitchToModule(Module *TheModule);
   void SwitchToFunction(const MCFunction *MCFN);
@@ -55,71 +175,356 @@ public:
   Function *FinalizeFunction();
   void FinalizeBasicBlock();
 
+  /// \brief Return the block at \p StartAddress, created empty if needed:
+  /// FinalizeFunction makes those that are still empty trap.
   BasicBlock *getOrCreateBasicBlock(uint64_t StartAddress);
 
   Function *getOrCreateMainFunction(Function *EntryFn);
   Function *getOrCreateInitRegSetFunction();
   Function *getOrCreateFiniRegSetFunction();
 
+  // Define the function at \p Addr as a wrapper that calls the native
+  // external function \p Name, moving the arguments out of the regset: what
+  // running the translation needs.
   void createExternalWrapperFunction(uint64_t Addr, StringRef Name);
-  void createExternalTailCallBB(uint64_t Addr);
-  /*
-  add by -death
-   */
-  
-  void set_record_add(bool record_add){
-    record_or_not = record_add;
+  // Make the function at \p Addr the declaration of the external function
+  // \p Name, as stubs are, and point the callers that already declared it
+  // to that. From then on, getFunction gives that declaration in every
+  // module.
+  void declareExternalFunction(uint64_t Addr, StringRef Name);
+  // Define the function at \p Addr as a tail call to the one at
+  // \p TargetAddr, passing the regset along: what a function identical to
+  // another one translates to.
+  void createThunkFunction(uint64_t Addr, uint64_t TargetAddr);
+  // Check whether \p MCFN, a method, is a synthesized property accessor, by
+  // its instructions. Return true if it is, and what it does in \p A.
+  virtual bool matchObjCAccessor(const MCFunction &MCFN,
+                                 DCObjCAccessor &A) const {
+    return false;
+  }
+  // Define the function at \p Addr, instead of translating it, as the
+  // accessor \p A that matchObjCAccessor found: the instance variable is
+  // accessed directly, only the registers it sets go through the regset.
+  void createObjCAccessorFunction(uint64_t Addr, const DCObjCAccessor &A);
+  bool isExternalFunction(uint64_t Addr) const {
+    return ExternalNames.count(Addr);
   }
-  /*
-  add by -death end;
-   */
+  void createExternalTailCallBB(uint64_t Addr);
+
+  // Tag the IR created from now on with the address of the machine code it
+  // was translated from, if enabled. translateInst sets the address of each
+  // instruction.
+  void setRecordAddresses(bool Record) { DRS.setRecordAddresses(Record); }
+  bool getRecordAddresses() const { return DRS.getRecordAddresses(); }
+  void setCurrentAddress(uint64_t Addr) { DRS.setCurrentAddress(Addr); }
+
+  // Describe the command line options that change the translation, including
+  // those of DCRegisterSema, as in "regset-diff=0,...". Used to key the
+  // translation cache.
+  static std::string getTranslationOptions();
+
+  // The hash of the semantics tables of the target, generated along with
+  // them. Used to key the translation cache.
+  StringRef getSemanticsHash() const { return SemanticsHash; }
+
+  // Whether the calls to the Objective-C ARC runtime are translated to calls
+  // taking and returning the object pointers, per -enable-dc-objc-arc-calls,
+  // for the ObjCARC passes to optimize.
+  static bool translatesObjCARCCalls();
+
+  // Whether the exclusive load/store retry loops that the targets recognize
+  // are translated to single atomic instructions, per
+  // -enable-dc-atomic-loops.
+  static bool translatesAtomicLoops();
 
         DCRegisterSema &getDRS()       { return DRS; }
   const DCRegisterSema &getDRS() const { return DRS; }
 
-  // Set the callback used for dynamically translating indirect branches/calls.
-  // \p A pointer to a function taking an indirect target, and returning an
-  // executable translated address.  Used like:
-  //   %translated_pc = void(%regset*)* %FnPtr(i8* %new_pc)
+  // The indirect branches and calls go through the runtime function
+  // __llvm_dc_translate_at, which takes an indirect target, and returns an
+  // executable translated address. Used like:
+  //   %translated_pc = void(%regset*)* @__llvm_dc_translate_at(i8* %new_pc)
   //   call %translated_pc(%regset* %regset_ptr)
-  void setDynTranslateAtCallback(void *FnPtr) { DynTranslateAtCBPtr = FnPtr; }
+  // The code running the translation, e.g. DCJIT, defines it.
+  //
+  // Get the host address of the runtime symbol \p Name, defined by the
+  // semantics (e.g. __llvm_dc_current_instr), or 0 if there is none.
+  static uint64_t getRuntimeSymbolAddress(StringRef Name);
+
+  // With -enable-dc-edge-coverage, the 8-bit counters of the edges of each
+  // function are the global "<EdgeCountersPrefix><function>", and the table
+  // of their addresses "<EdgePCsPrefix><function>", as
+  // -fsanitize-coverage=inline-8bit-counters,pc-table lays them out. A module
+  // constructor registers their sections with libFuzzer; the code running
+  // the translation without constructors, e.g. DCJIT, registers them itself.
+  static const char *const EdgeCountersPrefix;
+  static const char *const EdgePCsPrefix;
+
+  // Set the triple of the translated code, whose object format the globals
+  // the translation adds for the runtime follow.
+  void setTargetTriple(StringRef TT) { TargetTriple = Triple(TT); }
+
+  // Set the stubs whose calls go directly to their target, see getCallTarget.
+  // \p Stubs must outlive the translation.
+  void setStubTargets(const DCStubTargets *Stubs) { StubTargets = Stubs; }
+  const DCStubTargets *getStubTargets() const { return StubTargets; }
+
+  // Name the functions created from now on after \p Names. The names must be
+  // unique, and \p Names must outlive the translation.
+  void setFunctionNames(const DCFunctionNameMap *Names) {
+    FunctionNames = Names;
+  }
+  const DCFunctionNameMap *getFunctionNames() const { return FunctionNames; }
+
+  // Refer to the entries of \p Sections as global variables, where the
+  // target folds constant addresses. \p Sections must outlive the
+  // translation.
+  void setDataSections(const DCDataSectionList *Sections) {
+    DataSections = Sections;
+  }
+  const DCDataSectionList *getDataSections() const { return DataSections; }
+
+  // Resolve the messages to classes with \p Index, see DCObjCMessageIndex.
+  // This needs the data sections, and the stub targets, to find the
+  // references and objc_msgSend. \p Index must outlive the translation.
+  void setObjCMessageIndex(const DCObjCMessageIndex *Index) {
+    ObjCMessages = Index;
+  }
+  const DCObjCMessageIndex *getObjCMessageIndex() const {
+    return ObjCMessages;
+  }
+
+  // Tag the calls to objc_msgSend with their address, and their selector and
+  // receiver class, if the block of the call loads them from the references
+  // of the ObjCMessageIndex, see DCObjCMessageTable.h. The tail calls aren't:
+  // they branch to a block shared by all those of the function.
+  void setTagObjCMessages(bool Tag) { TagObjCMessages = Tag; }
+  bool getTagObjCMessages() const { return TagObjCMessages; }
+
+  // Tag the calls of the call basic blocks with the address of their machine
+  // basic block, to find the blocks back once their module went through
+  // bitcode and was linked, and wasn't translated by this DCInstrSema.
+  void setTagCallBasicBlocks(bool Tag) { TagCallBBs = Tag; }
+
+  // Mark the functions at \p Addrs always-inline, as SwitchToFunction
+  // creates them: they are fragments of their callers, as the machine
+  // outliner makes, for the inliner to put back. \p Addrs must outlive the
+  // translation.
+  void setInlinedFunctions(const DenseSet<uint64_t> *Addrs) {
+    InlinedFunctions = Addrs;
+  }
+  const DenseSet<uint64_t> *getInlinedFunctions() const {
+    return InlinedFunctions;
+  }
+
+  // Around the direct calls to the functions of \p Summaries, only save and
+  // restore the registers of their DCCallSummary; around the other calls,
+  // those the calling convention allows. \p Summaries must outlive the
+  // translation.
+  void setCallSummaries(const DCCallSummaries *Summaries) {
+    CallSummaries = Summaries;
+  }
+  const DCCallSummaries *getCallSummaries() const { return CallSummaries; }
+
+  // Weigh the edges of the conditional branches, and count the entries of
+  // the functions, per \p Profile: the hot paths are laid out as traces.
+  // \p Profile must outlive the translation.
+  void setBlockProfile(const DCBlockProfile *Profile) {
+    BlockProfile = Profile;
+  }
+  const DCBlockProfile *getBlockProfile() const { return BlockProfile; }
+
+  // Skip the saves of the callee-saved registers in the prologues, and their
+  // restores in the epilogues, found with \p MIA, see MCCalleeSavedSpills:
+  // the restores give the registers their incoming value. The saved
+  // registers are listed in the "dc-callee-saved" attribute of the
+  // functions. \p MIA must outlive the translation.
+  void setCalleeSavedSpillAnalysis(const MCInstrAnalysis *MIA) {
+    CalleeSavedMIA = MIA;
+  }
+  const MCInstrAnalysis *getCalleeSavedSpillAnalysis() const {
+    return CalleeSavedMIA;
+  }
+
+  // Translate the runs of register pair loads and stores that copy or clear
+  // a block of memory, found with \p MIA, see MCMemoryTransfers, to a
+  // memmove or a memset, and the loads of what the registers hold after
+  // them. \p MIA must outlive the translation.
+  void setMemoryTransferAnalysis(const MCInstrAnalysis *MIA) {
+    MemoryTransferMIA = MIA;
+  }
+  const MCInstrAnalysis *getMemoryTransferAnalysis() const {
+    return MemoryTransferMIA;
+  }
+
+  // Translate the indirect calls and branches to a register holding a
+  // constant, or a pointer of StubTargets, on all the paths to them, found
+  // with \p MIA, see MCConstantRegs, as the direct ones. \p MIA must outlive
+  // the translation.
+  void setConstantCallAnalysis(const MCInstrAnalysis *MIA) {
+    ConstantCallMIA = MIA;
+  }
+  const MCInstrAnalysis *getConstantCallAnalysis() const {
+    return ConstantCallMIA;
+  }
+
+  // The name getFunction gives the function at \p Addr.
+  std::string getFunctionName(uint64_t Addr) const;
+
+  // With -enable-dc-unknown-fallback, instructions without semantics are
+  // translated to calls to opaque "dc.unknown.<opcode>" functions, taking the
+  // regset and the instruction address. These count them, by opcode name, or,
+  // without it, those that translateInst dropped.
+  const StringMap<unsigned> &getUnknownInstCounts() const {
+    return UnknownInstCounts;
+  }
+  void mergeUnknownInstCounts(const DCInstrSema &Other);
+  void addUnknownInstCount(StringRef Name, unsigned Count) {
+    UnknownInstCounts[Name] += Count;
+  }
+  void clearUnknownInstCounts() { UnknownInstCounts.clear(); }
+  void printUnknownInstSummary(raw_ostream &OS) const;
+
+  // The functions of the current module, by address, including declarations
+  // of call targets, and the call basic blocks inserted in them, with the
+  // start address of the basic block they were split from. With
+  // -enable-dc-inline-calls, they are the blocks the calls were merged back
+  // into, once per call. Both are reset by SwitchToModule.
+  typedef DenseMap<uint64_t, Function *> FunctionMapTy;
+  typedef std::vector<std::pair<uint64_t, BasicBlock *>> CallBBListTy;
+  const FunctionMapTy &getFunctions() const { return FunctionsByAddr; }
+  const CallBBListTy &getCallBasicBlocks() const { return CallBBsByAddr; }
+  Function *getFunctionAt(uint64_t Addr) const {
+    return FunctionsByAddr.lookup(Addr);
+  }
+  // Like getFunctionAt, but declare the function if there is none yet.
+  Function *getFunction(uint64_t Addr);
+  // Get the function a call to \p Addr goes to: that of getFunction, unless
+  // \p Addr is a stub, in which case it is the external function declared
+  // under the name of the stub's symbol, or the local function it jumps to.
+  Constant *getCallTarget(uint64_t Addr);
+  // The reverse of getFunctionAt: get the address \p F was created for.
+  bool getFunctionAddress(const Function *F, uint64_t &Addr) const {
+    auto I = AddrsByFunction.find(F);
+    if (I == AddrsByFunction.end())
+      return false;
+    Addr = I->second;
+    return true;
+  }
+
+  // Record functions and call basic blocks that were translated elsewhere and
+  // linked into the current module.
+  void registerFunction(uint64_t Addr, Function *F) {
+    FunctionsByAddr[Addr] = F;
+    AddrsByFunction[F] = Addr;
+  }
+  void registerCallBasicBlock(uint64_t Addr, BasicBlock *BB) {
+    CallBBsByAddr.push_back(std::make_pair(Addr, BB));
+  }
 
 private:
   // Autogenerated by tblgen
   const unsigned *OpcodeToSemaIdx;
-  const unsigned *SemanticsArray;
+  const uint16_t *SemanticsArray;
   const uint64_t *ConstantArray;
+  const char *SemanticsHash;
+
+  // The IR type of each simple value type, resolved once per module.
+  Type *VTTypes[MVT::LAST_VALUETYPE];
+
+  // Whether the current instruction hit unknown semantics, see
+  // unknownSemantics.
+  bool CurrentInstUnknown;
+  StringMap<unsigned> UnknownInstCounts;
+
+  // The translation costs of each opcode, with -dc-opcode-stats. They are
+  // added to the totals of the process on destruction, printed on exit.
+  struct OpcodeStats {
+    uint64_t NumInsts;
+    uint64_t NumIRInsts;
+    double Seconds;
+  };
+  std::vector<OpcodeStats> OpcodeStatsTable;
+
+  bool translateInstImpl(const MCDecodedInst &DecodedInst,
+                         DCTranslatedInst *TranslatedInst);
+  // Translate the current instruction if it is a save or restore of
+  // CalleeSavedSpills, and return true, or return false.
+  bool translateCalleeSavedSpill();
+  // Translate the current instruction if it is the return after a tail call
+  // of TheMCFunction, as a return bypassing ExitBB, and return true, or
+  // return false.
+  bool translateTailCallReturn();
+  // Translate the current instruction if it is part of a run of
+  // MemoryTransfers, the whole run at its first instruction, and return
+  // true, or return false.
+  bool translateMemoryTransfer();
 
 protected:
-  DCInstrSema(const unsigned *OpcodeToSemaIdx, const unsigned *SemanticsArray,
-              const uint64_t *ConstantArray, DCRegisterSema &DRS);
+  DCInstrSema(const unsigned *OpcodeToSemaIdx, const uint16_t *SemanticsArray,
+              const uint64_t *ConstantArray, const char *SemanticsHash,
+              DCRegisterSema &DRS);
 
   // Following members are always valid.
-  void *DynTranslateAtCBPtr;
-  /*
-    add by -death
-   */
-  bool record_or_not;
-  /*
-  add by -death end;
-   */
+  Triple TargetTriple;
+  const DCStubTargets *StubTargets;
+  const DCFunctionNameMap *FunctionNames;
+  const DCDataSectionList *DataSections;
+  const DCObjCMessageIndex *ObjCMessages;
+  const DenseSet<uint64_t> *InlinedFunctions;
+  const DCCallSummaries *CallSummaries;
+  const DCBlockProfile *BlockProfile;
+  const MCInstrAnalysis *CalleeSavedMIA;
+  const MCInstrAnalysis *MemoryTransferMIA;
+  const MCInstrAnalysis *ConstantCallMIA;
+  bool TagObjCMessages;
+  bool TagCallBBs;
+  // The names of the external functions found by declareExternalFunction,
+  // by address. Unlike FunctionsByAddr, they are kept across modules.
+  DenseMap<uint64_t, std::string> ExternalNames;
+  // Whether the binary operations of constants are folded, e.g. the AArch64
+  // ADRP + ADD pairs that compute addresses, rather than left to the
+  // optimizer. The folded addresses in DataSections become globals.
+  bool FoldConstants;
+  // Opcodes that translate to nothing (hints, prefetches, barriers), filled
+  // by the target. translateInst skips them before doing anything else.
+  BitVector NopOpcodes;
   // Following members are valid only inside a Module.
   LLVMContext *Ctx;
   Module *TheModule;
   DCRegisterSema &DRS;
   FunctionType *FuncType;
-  
+  // The llvm.trap declaration, see getTrapFunction.
+  Function *TrapFn;
+  FunctionMapTy FunctionsByAddr;
+  DenseMap<const Function *, uint64_t> AddrsByFunction;
+  CallBBListTy CallBBsByAddr;
+  // The external functions getCallTarget gave for stubs, by stub address.
+  DenseMap<uint64_t, Constant *> ExternalsByStubAddr;
+  // The address of the data section entry of each global of getDataAddress.
+  DenseMap<const GlobalVariable *, uint64_t> DataEntryAddrs;
+
   // Following members are valid only inside a Function
   Function *TheFunction;
   const MCFunction *TheMCFunction;
+  // The saves and restores skipped in the current function.
+  MCCalleeSavedSpills CalleeSavedSpills;
+  // The block copies and clears of the current function.
+  MCMemoryTransfers MemoryTransfers;
+  // The registers of the current function that hold a constant.
+  MCConstantRegs ConstantRegs;
   std::map<uint64_t, BasicBlock *> BBByAddr;
   BasicBlock *ExitBB;
+  // The block after ExitBB that records the regset trace, if enabled.
+  BasicBlock *TraceExitBB;
   std::vector<BasicBlock *> CallBBs;
+  // The call blocks of unknown instructions, that clobber all registers.
+  SmallPtrSet<BasicBlock *, 4> UnknownCallBBs;
 
   // Following members are valid only inside a Basic Block
   BasicBlock *TheBB;
+  uint64_t TheBBAddr;
   const MCBasicBlock *TheMCBB;
-  typedef IRBuilder<true, NoFolder> DCIRBuilder;
   std::unique_ptr<DCIRBuilder> Builder;
 
   // translation vars.
@@ -128,11 +533,38 @@ protected:
   unsigned Opcode;
   SmallVector<Value *, 1> Vals;
   const MCDecodedInst *CurrentInst;
+  // Where the values of the current instruction are recorded, or null.
   DCTranslatedInst *CurrentTInst;
 
   unsigned Next() { return SemanticsArray[Idx++]; }
   EVT NextVT() { return EVT(MVT::SimpleValueType(Next())); }
 
+  // Equivalent to VT.getTypeForEVT(*Ctx), without going through the type
+  // uniquing tables for every node.
+  Type *getTypeForVT(EVT VT) {
+    if (!VT.isSimple() || VT.getSimpleVT().SimpleTy >= MVT::LAST_VALUETYPE)
+      return VT.getTypeForEVT(*Ctx);
+    Type *&Ty = VTTypes[VT.getSimpleVT().SimpleTy];
+    if (!Ty)
+      Ty = VT.getTypeForEVT(*Ctx);
+    return Ty;
+  }
+
+  // Return the llvm.trap declaration of the module, declared on first use:
+  // the blocks left untranslated trap, see FinalizeFunction.
+  Function *getTrapFunction();
+
+  // Count the runs of each edge into the blocks of the function at
+  // \p FnAddr, with -enable-dc-edge-coverage, see FinalizeFunction.
+  void insertEdgeCoverage(uint64_t FnAddr);
+  // Create the constructor registering the coverage sections of the module,
+  // once.
+  void createEdgeCoverageCtor();
+
+  // Put the loops of the MC CFG of the function in loop-simplified form,
+  // with -enable-dc-structured-loops, see FinalizeFunction.
+  void structureLoops();
+
   Value *getNextOperand() {
     unsigned OpIdx = Next();
     assert(OpIdx < Vals.size() && "Trying to access non-existent operand");
@@ -153,13 +585,33 @@ protected:
   Value *getReg(unsigned RegNo) { return DRS.getReg(RegNo); }
   void setReg(unsigned RegNo, Value *Val) { DRS.setReg(RegNo, Val); }
 
-  Function *getFunction(uint64_t Addr);
+  /// \brief Get a pointer of type \p PtrTy to the host memory of the guest
+  /// address \p Addr, an integer, for the loads and stores: it is offset by
+  /// the base of the guest memory, if any.
+  Value *getGuestPtr(Value *Addr, Type *PtrTy);
 
   void insertCall(Value *CallTarget);
+  /// \brief Get the function the current indirect call, or branch, goes
+  /// to, if its register holds a constant, see setConstantCallAnalysis, or
+  /// null.
+  Constant *getConstantCallTarget();
+  /// \brief Jump to \p Target, an indirect branch: to the targets of the
+  /// jump table of the current MC block, if any, and otherwise to its
+  /// translation, and return.
+  void insertIndirectBr(Value *Target);
   Value *insertTranslateAt(Value *OrigTarget);
+  /// \brief Switch on \p Target to the successors of the current MC block,
+  /// the targets of its jump table, and go on inserting in the default case.
+  void insertJumpTableSwitch(Value *Target);
 
   bool translateOpcode(unsigned Opcode);
 
+  // Report that the semantics of the current instruction need something that
+  // isn't implemented, described by \p Reason. This is a fatal error, unless
+  // -enable-dc-unknown-fallback is given: the rest of the semantics are then
+  // skipped, and the instruction is translated to an opaque call.
+  void unknownSemantics(const Twine &Reason);
+
   virtual void translateTargetOpcode() = 0;
   virtual void translateCustomOperand(unsigned OperandType,
                                       unsigned MIOperandNo) = 0;
@@ -171,17 +623,106 @@ protected:
   // Called before translating an instruction.
   // Return true if the translation shouldn't proceed.
   virtual bool translateTargetInst() { return false; }
+  // Analyze \p MCFN, about to be translated, for translateTargetInst.
+  virtual void analyzeTargetFunction(const MCFunction &MCFN) {}
 
   uint64_t getBasicBlockStartAddress() const;
   uint64_t getBasicBlockEndAddress() const;
 
+  // Get \p Addr, of type \p IntTy, as the address of the global variable of
+  // the entry of DataSections it is in, or as a constant if there is none.
+  Constant *getDataAddress(uint64_t Addr, IntegerType *IntTy);
+  // Get the section of DataSections \p Addr is in, or null.
+  const DCDataSection *getDataSection(uint64_t Addr) const;
+  // Get the address \p Addr, in the Section \p S, as a pointer into its
+  // global.
+  Constant *getSectionPointer(const DCDataSection &S, uint64_t Addr);
+  // Get @cstr_<Addr>, the constant string at \p Addr, in \p S.
+  GlobalVariable *getCStringGlobal(const DCDataSection &S, uint64_t Addr);
+  // Get the initializer of the CFString at \p EntryAddr, in \p S, of type
+  // \p Ty, or null if the contents of \p S aren't known.
+  Constant *getCFStringInitializer(const DCDataSection &S, uint64_t EntryAddr,
+                                   StructType *Ty);
+  // If \p V is loaded from the entry of a data section, get its address.
+  bool getLoadedDataEntry(Value *V, uint64_t &EntryAddr) const;
+
+  // Get the registers of the receiver and of the selector of objc_msgSend,
+  // if the target resolves Objective-C messages.
+  virtual bool getObjCMessageRegs(unsigned &ReceiverReg,
+                                  unsigned &SelectorReg) const {
+    return false;
+  }
+  // If \p Target is the stub of objc_msgSend, get the selector and the class
+  // of the receiver of the message, if the block loads them from references
+  // of ObjCMessages, or empty strings, and return true.
+  bool getObjCMessage(uint64_t Target, StringRef &Selector, StringRef &Class);
+  // If the call to \p Target is a message that can be resolved with
+  // ObjCMessages, get the method it goes to.
+  Function *resolveObjCMessage(uint64_t Target);
+  // If \p Target is objc_msgSend, and -enable-dc-objc-message-caches is set,
+  // insert the lookup of the DCObjCMessageCache of the call site, and get the
+  // function it gives: the cached translation, or the one the runtime finds,
+  // or objc_msgSend itself.
+  Value *insertObjCMessageCache(uint64_t Target);
+
+  // Get the registers of the first two arguments of the Objective-C ARC
+  // runtime functions, and that of their result, if the target translates
+  // the calls to them with insertObjCARCCall.
+  virtual bool getObjCARCRegs(unsigned &Arg0Reg, unsigned &Arg1Reg,
+                              unsigned &ResultReg) const {
+    return false;
+  }
+  // If \p Target is the stub of an ARC runtime function, and the calls to
+  // them are translated, insert a direct call to it, as in:
+  //   %1 = call i8* @objc_retain(i8* %0)
+  // moving the arguments and the result in and out of the registers, and
+  // return true. The call doesn't go through the regset.
+  bool insertObjCARCCall(uint64_t Target);
+
+  // The registers of the arguments and of the result of the C functions, as
+  // the target's calling convention passes them, and what its call
+  // instructions push on the stack, that the callee's return pops.
+  struct ExternalCallRegs {
+    ArrayRef<unsigned> IntArgRegs;
+    ArrayRef<unsigned> FPArgRegs;
+    unsigned IntResultReg;
+    unsigned FPResultReg;
+    unsigned StackPtrReg;
+    unsigned ReturnAddrSize;
+  };
+  // Get the ExternalCallRegs, if the target translates the calls to the
+  // external functions with insertTypedExternalCall.
+  virtual bool getExternalCallRegs(ExternalCallRegs &Regs) const {
+    return false;
+  }
+  // If \p Target is the stub of an external function DCExternalSignatures
+  // knows, and the calls to them are translated, insert a direct call to it,
+  // as in:
+  //   %2 = call i64 @strlen(i8* %1)
+  // moving the arguments and the result in and out of the registers, and
+  // return true. The call doesn't go through the regset.
+  bool insertTypedExternalCall(uint64_t Target);
+
 private:
   void translateOperand(unsigned OperandType, unsigned MIOperandNo);
 
   void translateBinOp(Instruction::BinaryOps Opc);
   void translateCastOp(Instruction::CastOps Opc);
 
-  BasicBlock *insertCallBB(Value *CallTarget);
+  BasicBlock *insertCallBB(Value *CallTarget,
+                           ArrayRef<Value *> ExtraArgs = None);
+  // Merge the call blocks of the function, and their continuations, into
+  // the blocks they were split from, once the registers are saved and
+  // restored around the calls.
+  void mergeCallBasicBlocks();
+  // Whether the function at \p Addr, and everything it calls, only accesses
+  // the regset, per the call summaries: its translation is argmemonly.
+  bool isArgMemOnly(uint64_t Addr) const;
+  // Weigh the successors of the conditional branch \p TI that ends the
+  // current block with the counts of the block profile.
+  void weighBranch(TerminatorInst *TI);
+
+  void translateUnknownInst();
 
   void prepareBasicBlockForInsertion(BasicBlock *BB);
 
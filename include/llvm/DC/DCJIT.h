@@ -0,0 +1,137 @@
+//===-- llvm/DC/DCJIT.h - Run translated code -------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares the DCJIT class, which compiles the IR translated by a
+// DCTranslator with an ORC JIT, to run it in the current process.
+//
+// The code is translated as it runs: the targets of indirect branches and
+// calls are translated, and compiled, when first reached, through the
+// __llvm_dc_translate_at runtime function, which the JIT defines along with
+// the rest of the runtime of DCInstrSema. The translated entry points
+// are cached, by guest address, so that reaching a target again only costs
+// a lookup.
+//
+// The objc_msgSend call sites with an inline cache, see
+// DCObjCMessageCache, miss to the __llvm_dc_objc_cache_miss runtime function,
+// also defined by the JIT: it looks up the method with the Objective-C
+// runtime of the process, gets its translation as __llvm_dc_translate_at
+// does, and fills the cache with it.
+//
+// The JIT can also be lazy, on hosts that support ORC compile callbacks: the
+// functions are then translated, and compiled, one at a time, when first
+// called. Their callers call them through a stub, which first goes to a
+// compile callback, keyed by the guest address of the callee, and then to
+// the translation.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_DC_DCJIT_H
+#define LLVM_DC_DCJIT_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ExecutionEngine/RuntimeDyld.h"
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace llvm {
+
+struct DCObjCMessageCache;
+class DCTranslator;
+class Function;
+class TargetMachine;
+
+namespace object {
+class ObjectFile;
+}
+
+class DCJIT {
+public:
+  /// Called with each object the JIT loads, and where it was loaded.
+  typedef std::function<void(const object::ObjectFile &,
+                             const RuntimeDyld::LoadedObjectInfo &)>
+      ObjectLoadedFnTy;
+
+  /// \brief Compile the code translated by \p DT for \p TM, calling
+  /// \p ObjectLoaded, if set, for each object loaded. If \p Lazy, and the
+  /// host supports it, each function is only translated when first called.
+  /// The calls to __llvm_dc_translate_at are routed to this JIT: there can
+  /// only be one at a time.
+  DCJIT(DCTranslator &DT, TargetMachine &TM,
+        ObjectLoadedFnTy ObjectLoaded = ObjectLoadedFnTy(), bool Lazy = false);
+  ~DCJIT();
+
+  /// \brief Get the entry point of the translation of the function at guest
+  /// address \p Addr, translating and compiling it, and, unless the JIT is
+  /// lazy, the functions it calls, if it wasn't yet.
+  void *getTranslatedAt(uint64_t Addr);
+
+  bool isLazy() const { return Lazy; }
+
+  /// \brief Compile the functions translated so far, in the current module
+  /// of the translator, which then starts a new one. When lazy, the functions
+  /// it declares that weren't translated yet get a stub.
+  void addCurrentModule();
+
+  /// \brief Get the address of the compiled function named \p Name, or 0.
+  uint64_t getSymbolAddress(StringRef Name);
+  /// \brief Get the address of the compiled function \p F, compiling the
+  /// current module if it is in it.
+  void *getFunctionAddress(const Function *F);
+
+  /// \brief The number of entry points looked up, and of those that had to
+  /// be translated.
+  uint64_t getNumLookups() const { return NumLookups; }
+  uint64_t getNumTranslations() const { return NumTranslations; }
+  /// \brief The number of Objective-C message caches filled.
+  uint64_t getNumObjCCacheFills() const { return NumObjCCacheFills; }
+
+private:
+  class JITStack;
+
+  DCTranslator &DT;
+  std::unique_ptr<JITStack> Stack;
+  bool Lazy;
+  /// The entry points translated so far, by guest address.
+  DenseMap<uint64_t, void *> EntryPoints;
+  /// The name of the pointer of the stubs of the lazy functions, that goes
+  /// to their translation once it exists, by guest address.
+  DenseMap<uint64_t, std::string> StubPointers;
+  uint64_t NumLookups;
+  uint64_t NumTranslations;
+  uint64_t NumObjCCacheFills;
+
+  /// \brief Give a stub to the functions the current module of the
+  /// translator declares, that weren't translated yet.
+  void addStubs();
+
+  /// The definition of __llvm_dc_translate_at, which takes the guest address
+  /// and returns the host one: it goes to the current DCJIT.
+  static void *translateAt(void *Addr);
+
+  /// \brief Get the translation of the method that \p Receiver, of isa
+  /// \p Isa, or 0 if it isn't an object, gets for \p Selector, filling
+  /// \p Cache with it if it is empty. Return null if the method can't be
+  /// translated, for objc_msgSend to send the message.
+  void *getObjCMethodTranslation(DCObjCMessageCache &Cache, uint64_t Isa,
+                                 void *Receiver, void *Selector);
+
+  /// The definition of __llvm_dc_objc_cache_miss, which goes to the
+  /// getObjCMethodTranslation of the current DCJIT.
+  static void *objcCacheMiss(void *Cache, uint64_t Isa, void *Receiver,
+                             void *Selector);
+
+  DCJIT(const DCJIT &) = delete;
+  void operator=(const DCJIT &) = delete;
+};
+
+} // end namespace llvm
+
+#endif
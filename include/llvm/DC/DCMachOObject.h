@@ -0,0 +1,98 @@
+//===-- llvm/DC/DCMachOObject.h - Mach-O inputs of DC -----------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares what the translation needs to know of a Mach-O
+// executable beforehand: resolveMachOStubs, and resolveDyldCacheStubs for the
+// images of a dyld shared cache, to find the functions its stubs jump to, and
+// collectMachODataSections, to find the sections it refers to as
+// globals; and readCodePageHashes, to find the code changed since an earlier
+// version.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_DC_DCMACHOOBJECT_H
+#define LLVM_DC_DCMACHOOBJECT_H
+
+#include "llvm/DC/DCInstrSema.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace llvm {
+
+class MCObjectSymbolizer;
+
+namespace object {
+class DyldSharedCache;
+class MachOBindingIndex;
+class MachOObjectFile;
+}
+
+/// \brief Resolve the AArch64 stubs of \p MachO, and the authenticating
+/// stubs of arm64e, into \p Stubs: those whose lazy pointer points to a local
+/// function jump to it, and the others to the external function their
+/// pointer is bound to in \p Binds. The stubs without such a binding are
+/// named from the indirect symbol table, by \p MOS.
+void resolveMachOStubs(const object::MachOObjectFile &MachO,
+                       const object::MachOBindingIndex &Binds,
+                       MCObjectSymbolizer &MOS, DCStubTargets &Stubs);
+
+/// \brief Resolve the pointers of the GOT of \p MachO, and of the pointer
+/// tables of its __DATA*,__const sections, into the PointerNames and
+/// PointerAddrs of \p Stubs: those bound in \p Binds point to external
+/// functions, and those rebased into __text to local ones.
+void resolveMachOPointers(const object::MachOObjectFile &MachO,
+                          const object::MachOBindingIndex &Binds,
+                          DCStubTargets &Stubs);
+
+/// \brief Resolve the stubs of \p MachO, an image of \p Cache, that
+/// resolveMachOStubs left to \p Stubs: the pointers they load, and the
+/// branches dyld made direct, point into other images of the cache, and are
+/// named from the symbols they export.
+void resolveDyldCacheStubs(const object::MachOObjectFile &MachO,
+                           const object::DyldSharedCache &Cache,
+                           DCStubTargets &Stubs);
+
+/// \brief Find the sections of Objective-C references, C strings, constant
+/// CFStrings and GOT entries of \p MachO, which the translation refers to as
+/// globals, into \p Sections, sorted by address. The contents of the strings
+/// point into \p MachO. With \p WholeSections, the read-only sections are
+/// each a single global instead.
+void collectMachODataSections(const object::MachOObjectFile &MachO,
+                              bool WholeSections, DCDataSectionList &Sections);
+
+/// \brief The hashes of the pages of a Mach-O, per the code directory of its
+/// code signature: Hashes[I], in hex, is the hash of the bytes of the file at
+/// [I * PageSize, (I + 1) * PageSize).
+struct DCCodePageHashes {
+  uint64_t PageSize;
+  std::vector<std::string> Hashes;
+
+  DCCodePageHashes() : PageSize(0) {}
+};
+
+/// \brief Read the page hashes of the code signature of \p MachO into
+/// \p Pages.
+/// \returns false if it has no code signature, or one that can't be read.
+bool readCodePageHashes(const object::MachOObjectFile &MachO,
+                        DCCodePageHashes &Pages);
+
+/// \brief Find the address ranges of \p MachO whose bytes changed since the
+/// version whose page hashes were \p OldPages, per its own page hashes,
+/// \p Pages: those of the segments in the pages whose hash differs, or that
+/// only one of the versions has. The ranges are sorted, and [begin, end).
+/// \returns false if the hashes of the two versions can't be compared.
+bool findChangedCodeRanges(
+    const object::MachOObjectFile &MachO, const DCCodePageHashes &OldPages,
+    const DCCodePageHashes &Pages,
+    std::vector<std::pair<uint64_t, uint64_t>> &Ranges);
+
+} // end namespace llvm
+
+#endif
@@ -0,0 +1,68 @@
+//===-- llvm/DC/DCObjCMessageTable.h - objc_msgSend call sites --*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares functions to read the objc_msgSend call sites of a
+// module, as tagged by DCInstrSema::setTagObjCMessages, and to write them as
+// a table sorted by selector, suitable as a sidecar of the output module:
+//
+//   <selector, or '-'> <hex address> <function name> <instruction index>
+//       <receiver class, or '-'>
+//
+// on one line per call site. The address is that of the call instruction,
+// and the index that of the IR call in its function, in function order,
+// starting at 0, as in the address table. The selector and the class are
+// known when the block of the call loads them from the selector and class
+// references.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_DC_DCOBJCMESSAGETABLE_H
+#define LLVM_DC_DCOBJCMESSAGETABLE_H
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/DataTypes.h"
+#include <string>
+#include <vector>
+
+namespace llvm {
+class Instruction;
+class LLVMContext;
+class MDNode;
+class Module;
+class raw_ostream;
+
+/// \brief The metadata kind of the objc_msgSend calls, tagged with
+/// !{i64 <address>, !"<selector>", !"<class>"}, the strings empty if unknown.
+static const char DCObjCMessageMDKind[] = "dc.objc.msg";
+
+/// \brief An objc_msgSend call site.
+struct DCObjCMessageSite {
+  std::string Selector;
+  uint64_t Addr;
+  std::string Function;
+  unsigned InstIndex;
+  std::string Class;
+};
+
+/// \brief Create the tag of the objc_msgSend call at \p Addr.
+MDNode *createDCObjCMessageTag(LLVMContext &Ctx, uint64_t Addr,
+                               StringRef Selector, StringRef Class);
+
+/// \brief Add the tagged call sites of all the defined functions of \p M to
+/// \p Sites.
+void collectDCObjCMessageSites(const Module &M,
+                               std::vector<DCObjCMessageSite> &Sites);
+
+/// \brief Write \p Sites, sorted by selector, then by address, to \p OS.
+void writeDCObjCMessageTable(std::vector<DCObjCMessageSite> &Sites,
+                             raw_ostream &OS);
+
+} // end namespace llvm
+
+#endif
@@ -23,7 +23,8 @@ namespace DCINS {
 
 enum DCOpcodes {
   // We live in the same space as *ISD, this doesn't overlap.
-  DC_OPCODE_START = 0xFFFFFF00,
+  // The semantics tables are made of 16-bit values: stay below 0x10000.
+  DC_OPCODE_START = 0xFF00,
   /// Get the value of a register operand, only defined by its Register Class.
   GET_RC,
 
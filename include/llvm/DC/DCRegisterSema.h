@@ -27,9 +27,10 @@
 #ifndef LLVM_DC_DCREGISTERSEMA_H
 #define LLVM_DC_DCREGISTERSEMA_H
 
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/DC/DCIRBuilder.h"
 #include "llvm/Support/Compiler.h"
-#include "llvm/IR/IRBuilder.h"
-#include "llvm/IR/NoFolder.h"
 #include <vector>
 
 namespace llvm {
@@ -38,8 +39,10 @@ class DataLayout;
 class Function;
 class LLVMContext;
 class MCDecodedInst;
+class MCFunction;
 class MCInstrInfo;
 class MCRegisterInfo;
+class MDNode;
 class Module;
 class StructType;
 class Value;
@@ -56,9 +59,26 @@ public:
   typedef std::vector<unsigned> RegSizeTy;
   typedef void (*InitSpecialRegSizesFnTy)(RegSizeTy &RegSizes);
 
+  // How often the translated code uses a largest register, to lay out the
+  // regset with the hot registers first, per -dc-regset-layout.
+  enum RegSetRank { RSR_Hot, RSR_Vector, RSR_Rare };
+  typedef RegSetRank (*GetRegSetRankFnTy)(const MCRegisterInfo &MRI,
+                                          unsigned RegNo);
+
+  // The order of the registers in the regset.
+  enum RegSetLayout {
+    // The order of the register enumeration.
+    RSL_RegNo,
+    // The hot registers first, then the vector ones, then the others, per
+    // GetRegSetRankFn; in the order of the enumeration in each rank.
+    RSL_Hot
+  };
+  static RegSetLayout getRegSetLayout();
+
   DCRegisterSema(const MCRegisterInfo &MRI, const MCInstrInfo &MII,
                  const DataLayout &DL,
-                 InitSpecialRegSizesFnTy InitSpecialRegSizesFn = 0);
+                 InitSpecialRegSizesFnTy InitSpecialRegSizesFn = 0,
+                 GetRegSetRankFnTy GetRegSetRankFn = 0);
   virtual ~DCRegisterSema();
 
   const MCRegisterInfo &MRI;
@@ -87,13 +107,24 @@ protected:
   // NumLargest elements not equal to -1.
   std::vector<int> RegOffsetsInSet;
 
+  // The largest registers, after a 0, in the order of the regset.
   std::vector<unsigned> LargestRegs;
 
+  // The bits of a super-register covered by one of its sub-registers.
+  struct SubRegSlice {
+    unsigned Idx;
+    unsigned Offset;
+    unsigned Size;
+  };
+  // The slice of each (Super, Sub) pair, for the sub-register indices that
+  // cover a bit range, computed once instead of on every access.
+  DenseMap<std::pair<unsigned, unsigned>, SubRegSlice> SubRegSlices;
+  const SubRegSlice &getSubRegSlice(unsigned Super, unsigned Sub) const;
+
   // Valid only inside a Module.
   Module *TheModule;
   LLVMContext *Ctx;
   StructType *RegSetType;
-  typedef IRBuilder<true, NoFolder> DCIRBuilder;
   std::unique_ptr<DCIRBuilder> Builder;
 
   // Valid only inside a Function.
@@ -101,15 +132,46 @@ protected:
   std::vector<Value *> RegAllocas;
   std::vector<Value *> RegInits;
   std::vector<unsigned> RegAssignments;
+  // The registers with a local alloca, so that function-wide operations only
+  // look at the registers actually used.
+  BitVector FnRegs;
+  // The largest registers the current function can write, both according
+  // to the MCInstrDescs of its instructions (see analyzeMCFunction), and to
+  // the semantics actually emitted. The others still hold their incoming
+  // value at the exit, and don't need to be saved there.
+  BitVector FnWrittenRegs;
+  // Whether setting a register adds it to FnWrittenRegs. Reloading the
+  // regset after a call doesn't change it.
+  bool TrackWrittenRegs;
 
   Function *TheFunction;
 
   // Valid only inside a BasicBlock.
+  // A sub-register's value is extracted from its largest super on first use,
+  // and dropped whenever one of its super-registers is set.
   std::vector<Value *> RegVals;
+  // The registers with a value in RegVals.
+  BitVector BBRegs;
+
+  // The largest registers for which isCalleeReadReg and isCallClobberedReg
+  // are true, computed on first use.
+  BitVector CalleeReadRegs, CallClobberedRegs;
 
   // Valid only inside an instruction.
   const MCDecodedInst *CurrentInst;
 
+  // The address new IR is tagged with, shared by all the builders of this
+  // DCRegisterSema and its DCInstrSema.
+  DCInstAddress CurAddr;
+
+  // What the translated code adds to the guest addresses to access the host
+  // memory, 0 when the guest memory is at its own addresses.
+  uint64_t GuestMemoryBase;
+
+  // Get the guest address of the host address \p HostAddr, an integer, as
+  // the registers hold it.
+  Value *getGuestAddr(Value *HostAddr);
+
   // Methods to be overriden for specific targets.
 
   // Do we need to keep the value of the bits not covered by Idx, or does
@@ -122,19 +184,79 @@ protected:
   // Called when a register was just set.
   virtual void onRegisterSet(unsigned RegNo, Value *Val) {}
 
+  // Calling convention, used to only save and restore some registers around
+  // calls. Both are only asked about the largest registers.
+  // Can a callee read the value of \p RegNo?
+  virtual bool isCalleeReadReg(unsigned RegNo) const { return true; }
+  // Can a callee change the value of \p RegNo?
+  virtual bool isCallClobberedReg(unsigned RegNo) const { return true; }
+  // The stack pointer, or 0 if it isn't known.
+  virtual unsigned getStackPointerReg() const { return 0; }
+
 public:
-  /*
-   add by -death
-   */
-  void set_builder_cur_add(uint64_t cur_add){
-    Builder->set_record_or_not(true);
-    Builder->set_cur_address(cur_add);
-  }
- 
-  /*
-    add by -death end ;
-   */
+  // Tag the IR created from now on with the address of the machine code it
+  // was translated from, if enabled.
+  void setRecordAddresses(bool Record) { CurAddr.Record = Record; }
+  // Run the translated code with the guest memory mapped at \p Base plus its
+  // addresses: the loads and stores add \p Base to the guest addresses, and
+  // the stack and the arguments the regset is initialized with are rebased
+  // the other way.
+  void setGuestMemoryBase(uint64_t Base) { GuestMemoryBase = Base; }
+  uint64_t getGuestMemoryBase() const { return GuestMemoryBase; }
+  bool getRecordAddresses() const { return CurAddr.Record; }
+  void setCurrentAddress(uint64_t Addr) { CurAddr.Addr = Addr; }
+  const DCInstAddress *getCurrentAddress() const { return &CurAddr; }
+
+  // Describe the command line options that change the translation, as in
+  // "reg-ssa=0". Used to key the translation cache.
+  static std::string getTranslationOptions();
+
+  // What the translation names in the IR, per -dc-names. Functions are always
+  // named, as they are looked up, and linked, by name; basic blocks and
+  // register values are optional, their addresses are known from side tables.
+  enum NameLevel { NL_None, NL_Blocks, NL_All };
+  static NameLevel getNameLevel();
+
   StructType *getRegSetType() const { return RegSetType; }
+  // Get the largest register \p RegNo is part of.
+  unsigned getLargestSuper(unsigned RegNo) const {
+    return RegLargestSupers[RegNo];
+  }
+  // Get the largest registers a callee can read, and those it can change,
+  // per the calling convention.
+  const BitVector &getCalleeReadRegs() {
+    if (CalleeReadRegs.empty())
+      computeCallRegs();
+    return CalleeReadRegs;
+  }
+  const BitVector &getCallClobberedRegs() {
+    if (CallClobberedRegs.empty())
+      computeCallRegs();
+    return CallClobberedRegs;
+  }
+  // The TBAA tags of the accesses of the translated code, in \p C: each slot
+  // of the regset, by its largest register, the guest memory, and the stack
+  // frames DCStackFramePass recovers are of a type of their own, which no
+  // other aliases. Null without -enable-dc-tbaa.
+  MDNode *getRegSetTBAATag(LLVMContext &C, unsigned RegNo) const;
+  static MDNode *getGuestMemoryTBAATag(LLVMContext &C);
+  static MDNode *getStackFrameTBAATag(LLVMContext &C);
+  // Do the calls and returns push and pop the return address on the stack,
+  // rather than keep it in a register?
+  virtual bool doCallsUseStack() const { return true; }
+  // Compute the regset indices of the registers that calls preserve, per the
+  // calling convention, into \p Preserved, and those of them that a callee can
+  // also read into \p CalleeRead.
+  void getCallPreservedRegSetIndices(BitVector &Preserved,
+                                     BitVector &CalleeRead) const;
+  // Get the index of \p RegNo in the regset, or -1 if it has none: only the
+  // largest registers do.
+  int getRegSetIndex(unsigned RegNo) const { return RegOffsetsInSet[RegNo]; }
+  // Get the index of the stack pointer in the regset, or -1 if it isn't known.
+  int getStackPointerRegSetIndex() const {
+    unsigned SP = getStackPointerReg();
+    return SP ? RegOffsetsInSet[RegLargestSupers[SP]] : -1;
+  }
   // Compute the register's offset in bytes from the start of the regset.
   // Also return it's size in bytes.
   std::pair<size_t, size_t> getRegSizeOffsetInRegSet(unsigned RegNo) const;
@@ -143,6 +265,16 @@ public:
   //     void @__llvm_dc_print_regset_diff(i8* fn, %regset* v1, %regset* v2)
   Function *getOrCreateRegSetDiffFunction(bool Definition = false);
 
+  // Record, at the exit of the current function, the registers it wrote that
+  // changed, in the regset trace printed when the process exits: their
+  // incoming value is kept at the start of \p EntryBB, and compared to the
+  // regset before the terminator of \p ExitBB, which must follow the block
+  // where the registers are saved. \p FnAddr is the address the trace gives.
+  void insertRegSetTraceCode(BasicBlock *EntryBB, BasicBlock *ExitBB,
+                             uint64_t FnAddr);
+  // Get the name of \p RegNo, as an i8* to a string global of the module.
+  Constant *getRegNameString(unsigned RegNo);
+
   virtual void SwitchToModule(Module *TheModule);
   virtual void SwitchToFunction(Function *TheFunction);
   virtual void SwitchToBasicBlock(BasicBlock *TheBB);
@@ -151,15 +283,51 @@ public:
   virtual void FinalizeFunction(BasicBlock *ExitBB);
   virtual void FinalizeBasicBlock();
 
+  // Compute the registers written by \p MCFN, to be translated next.
+  void analyzeMCFunction(const MCFunction &MCFN);
+
+  // Get the value \p RegNo had at the entry of the current function, as
+  // loaded from the incoming regset.
+  Value *getIncomingReg(unsigned RegNo);
+
+  // Tag the loads and stores of the current function with its register
+  // slots and allocas, and of the guest memory, with their TBAA tags.
+  void tagMemoryAccesses();
+
   void saveAllLocalRegs(BasicBlock *BB, BasicBlock::iterator IP);
+  // Variant of saveAllLocalRegs for function exits, that only saves the
+  // registers in FnWrittenRegs.
+  void saveWrittenLocalRegs(BasicBlock *BB, BasicBlock::iterator IP);
   void restoreLocalRegs(BasicBlock *BB, BasicBlock::iterator IP);
+  // Variants of saveAllLocalRegs and restoreLocalRegs for call sites, that
+  // only save the registers a callee can read, and only restore those it can
+  // change: those of \p Read and \p Clobbered, e.g. from a DCCallSummary,
+  // or, if null, those the calling convention allows.
+  void saveLocalRegsForCall(BasicBlock *BB, BasicBlock::iterator IP,
+                            const BitVector *Read = nullptr);
+  void restoreLocalRegsAfterCall(BasicBlock *BB, BasicBlock::iterator IP,
+                                 const BitVector *Clobbered = nullptr);
+  // Return the first register after \p RI that saveAllLocalRegs and
+  // restoreLocalRegs look at, or -1.
+  int findNextSavedReg(int RI) const;
+  void computeCallRegs();
+  // Rewrite the loads and stores of the register allocas of the current
+  // function to SSA values.
+  void promoteLocalRegs();
 
   void defineAllSubSuperRegs(unsigned RegNo);
   Value *extractSubRegFromSuper(unsigned Super, unsigned Sub,
                                 Value *SuperValue = 0);
   Value *recreateSuperRegFromSub(unsigned Super, unsigned Sub);
 
+  // Make sure \p RegNo has a local copy: only the largest registers have one,
+  // the others are extracted from it.
   void createLocalValueForReg(unsigned RegNo);
+  // Set the value of \p RegNo in the current basic block.
+  void setRegVal(unsigned RegNo, Value *Val) {
+    RegVals[RegNo] = Val;
+    BBRegs.set(RegNo);
+  }
   void setRegValWithName(unsigned RegNo, Value *Val);
   void setRegNoSubSuper(unsigned RegNo, Value *Val);
 
@@ -193,17 +361,20 @@ public:
   Value *insertBitsInValue(Value *FullVal, Value *ValToInsert,
                            unsigned Offset = 0, bool ClearOldValue = false);
 
-  // Get a constant expression expressing \p FPtr as a \p FTy value.
-  template <typename T>
-  Value *getCallTargetForExtFn(FunctionType *FTy, T FPtr) {
-    LLVMContext &Ctx = FTy->getContext();
-
-    // FIXME: bitness
-    ConstantInt *FnPtrInt = ConstantInt::get(Type::getInt64Ty(Ctx),
-                                             reinterpret_cast<uint64_t>(FPtr));
-    return ConstantExpr::getBitCast(
-        ConstantExpr::getIntToPtr(FnPtrInt, Type::getInt8PtrTy(Ctx)),
-        FTy->getPointerTo());
+  // Get the declaration of the runtime function \p Name, of type \p FTy.
+  // The translated code refers to the runtime by name, rather than by host
+  // address, so that it can be cached, and linked in another process: see
+  // getRuntimeSymbolAddress.
+  Constant *getRuntimeFunction(StringRef Name, FunctionType *FTy);
+
+  // Get the host address of the runtime symbol \p Name, defined by the
+  // register semantics, or 0 if there is none.
+  static uint64_t getRuntimeSymbolAddress(StringRef Name);
+
+  // Get the value \p RegNo has in the current basic block, if it was set or
+  // read in it, without loading it otherwise.
+  Value *getLocalRegValue(unsigned RegNo) const {
+    return BBRegs.test(RegNo) ? RegVals[RegNo] : nullptr;
   }
 };
 }
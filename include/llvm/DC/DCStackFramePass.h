@@ -0,0 +1,55 @@
+//===-- llvm/DC/DCStackFramePass.h - Stack frame recovery -------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares DCStackFramePass, which turns the accesses of a
+// translated function to its own stack frame, done through inttoptr of the
+// stack pointer plus a constant, into accesses to an alloca.
+//
+// The stack pointer loaded from the regset at the entry is followed through
+// the additions and subtractions of constants: its delta is known at each
+// access, so the accesses below the incoming stack pointer, which only the
+// function can see, are moved to a single alloca covering them. SROA then
+// splits it into a value per slot. Callees may read and write the frame
+// (stack arguments, the return address pushed by an x86 CALL): the alloca is
+// copied to the stack before each call, and back after it.
+//
+// The function is left alone if the frame can be reached otherwise: if the
+// stack pointer is moved by a variable amount, or an address in the frame is
+// stored to memory, or to a register of the regset that the function reads
+// back after a call: only the callees can then see it, as the stack and frame
+// pointers.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_DC_DCSTACKFRAMEPASS_H
+#define LLVM_DC_DCSTACKFRAMEPASS_H
+
+#include "llvm/Pass.h"
+
+namespace llvm {
+
+class DCRegisterSema;
+
+class DCStackFramePass : public FunctionPass {
+  // The index of the stack pointer in the regset, or -1.
+  int SPIndex;
+
+public:
+  static char ID;
+
+  explicit DCStackFramePass(const DCRegisterSema &DRS);
+
+  const char *getPassName() const override { return "DC Stack Frame Pass"; }
+
+  bool runOnFunction(Function &F) override;
+};
+
+} // end namespace llvm
+
+#endif
@@ -18,11 +18,12 @@
 #ifndef LLVM_DC_DCTRANSLATEDINSTTRACKER_H
 #define LLVM_DC_DCTRANSLATEDINSTTRACKER_H
 
-#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/IR/ValueHandle.h"
-#include "llvm/IR/ValueMap.h"
 #include "llvm/MC/MCAnalysis/MCFunction.h"
+#include <vector>
 
 namespace llvm {
 
@@ -90,23 +91,65 @@ public:
   DCTranslatedInst(const MCDecodedInst &MCDI) : DecodedInst(&MCDI) {}
 };
 
+/// \brief The translated instructions, and the values they used and defined,
+/// in the order they were tracked: the instructions, and the values of each
+/// IR value, are only indexed once, in finalize. This keeps tracking linear
+/// in the number of instructions, and the values in a single flat array.
 class DCTranslatedInstTracker {
-  typedef ValueMap<const Value *, SmallVector<DCTranslatedInst::ValueInfo, 2>>
-      ValInfoMapTy;
-  ValInfoMapTy ValInfo;
+public:
+  typedef DCTranslatedInst::ValueInfo ValueInfo;
+
+private:
+  /// \brief The values of all the tracked instructions, each instruction's
+  /// in a contiguous range.
+  std::vector<ValueInfo> ValueInfos;
+
+  struct TrackedInst {
+    const MCDecodedInst *DecodedInst;
+    unsigned ValuesBegin, ValuesEnd;
+  };
+  /// \brief The tracked instructions, sorted by decoded inst address once
+  /// finalized.
+  std::vector<TrackedInst> TrackedInsts;
+
+  /// \brief The indices in ValueInfos of the infos of each value, as of the
+  /// last finalize: the values of the handles then, after RAUW and deletion.
+  DenseMap<const Value *, SmallVector<unsigned, 2>> ValueInfoIndices;
 
-  typedef std::vector<DCTranslatedInst> TranslatedInstListTy;
-  // All translated instruction info, sorted by decoded inst address.
-  TranslatedInstListTy TranslatedInsts;
+  /// \brief The start of the values of each tracked instruction in
+  /// ValueInfos, in tracking order, with its position in TrackedInsts, as of
+  /// the last finalize.
+  std::vector<std::pair<unsigned, unsigned>> ValueRangeInsts;
+
+  bool Finalized;
 
 public:
+  DCTranslatedInstTracker() : Finalized(true) {}
+
   void trackInst(const DCTranslatedInst &TI);
 
-  void getInstsForValue(
-      const Value &V,
-      const SmallVectorImpl<DCTranslatedInst::ValueInfo> *&TrackedInsts) const;
+  /// \brief Index the instructions tracked so far, for the queries below.
+  void finalize();
+
+  /// \brief Get, in \p Infos, the infos of the instructions that used or
+  /// defined \p V, in the order they were tracked.
+  void getInstsForValue(const Value &V,
+                        SmallVectorImpl<const ValueInfo *> &Infos) const;
+
+  /// \brief Get the number of instructions tracked as of the last finalize.
+  size_t getNumTrackedInsts() const { return TrackedInsts.size(); }
+
+  /// \brief Get the position, in [0, getNumTrackedInsts()), of the tracked
+  /// instruction \p VI is an info of, as one of getInstsForValue.
+  unsigned getTrackedInstIndex(const ValueInfo &VI) const;
+
+  /// \brief Get the infos of the values \p MCDI used and defined, if it was
+  /// tracked.
+  ArrayRef<ValueInfo> getTrackedInfo(const MCDecodedInst &MCDI) const;
 
-  const DCTranslatedInst *getTrackedInfo(const MCDecodedInst &MCDI) const;
+  /// \brief Get an estimate of the heap memory used by the tracked
+  /// instructions and values, in bytes.
+  size_t getMemoryUsage() const;
 
   void clear();
 };
@@ -0,0 +1,95 @@
+//===-- llvm/DC/DCTranslationCache.h - DC Translation Cache -----*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares DCTranslatedUnit, the translation of a group of functions
+// in a module of its own, serialized as bitcode, and DCTranslationCache, a
+// persistent, content-addressed, store of the translation units of single
+// functions.
+//
+// Cache entries are keyed by a hash of everything their translation depends
+// on: the translator configuration, with its semantics tables, options and
+// passes, and the decoded instructions, addresses and CFG of the function. Translated IR refers to the addresses of the
+// machine code everywhere, so a function only hits in the cache when it is
+// unchanged and at the same address.
+//
+// Each entry is a file named after its key, in the cache directory. Entries
+// are written to a temporary file first, then renamed, so that concurrent
+// translations can share a cache.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_DC_DCTRANSLATIONCACHE_H
+#define LLVM_DC_DCTRANSLATIONCACHE_H
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/DataTypes.h"
+#include "llvm/Support/ErrorOr.h"
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace llvm {
+class MCFunction;
+class raw_ostream;
+
+/// \brief The translation of some functions, in a module of their own, along
+/// with what's needed to register its functions once the module is linked.
+/// Modules can't be moved between contexts: the units are handed over between
+/// threads, or processes, and written to the cache, as bitcode.
+struct DCTranslatedUnit {
+  SmallVector<char, 0> Bitcode;
+  /// The addresses of all the functions of the module, including
+  /// declarations.
+  std::vector<uint64_t> FunctionAddrs;
+  /// The addresses of the functions with call basic blocks. Their calls are
+  /// tagged with the address of their machine block, see DCCallBBMDKind.
+  std::vector<uint64_t> CallBBFunctionAddrs;
+  /// The number of defined functions, and of their IR instructions.
+  unsigned NumFunctions;
+  uint64_t NumInsts;
+  /// The instructions translated with the unknown semantics fallback.
+  std::vector<std::pair<std::string, unsigned>> UnknownInstCounts;
+
+  DCTranslatedUnit() : NumFunctions(0), NumInsts(0) {}
+
+  /// \brief Write the unit to \p OS, as in the cache entries.
+  void write(raw_ostream &OS) const;
+
+  /// \brief Read a unit written by write at the start of \p Data, and drop
+  /// it from \p Data.
+  /// \returns false if \p Data doesn't start with a complete unit.
+  bool read(StringRef &Data);
+};
+
+class DCTranslationCache {
+  std::string Dir;
+
+  explicit DCTranslationCache(StringRef Dir) : Dir(Dir) {}
+
+public:
+  /// \brief Open the cache in directory \p Dir, creating it if needed.
+  static ErrorOr<std::unique_ptr<DCTranslationCache>> create(StringRef Dir);
+
+  /// \brief Get the key of the translation of \p MCFN, by a translator
+  /// configured as described by \p Config.
+  std::string getKey(StringRef Config, const MCFunction &MCFN) const;
+
+  /// \brief Read the entry for \p Key in \p Unit.
+  /// \returns false if there is none, or if it is unreadable.
+  bool lookup(StringRef Key, DCTranslatedUnit &Unit) const;
+
+  /// \brief Write \p Unit as the entry for \p Key.
+  std::error_code store(StringRef Key, const DCTranslatedUnit &Unit) const;
+};
+
+} // end namespace llvm
+
+#endif
@@ -21,24 +21,39 @@
 
 #include "llvm/DC/DCAnnotationWriter.h"
 #include "llvm/DC/DCTranslatedInstTracker.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
 #include "llvm/MC/MCAnalysis/MCModule.h"
 #include "llvm/MC/MCObjectDisassembler.h"
+#include <atomic>
+#include <functional>
+#include <mutex>
 #include <vector>
 
 namespace llvm {
+class FunctionPass;
 class MCFunction;
 class MCInstPrinter;
+class MCInstrAnalysis;
 class MCModule;
 }
 
 namespace llvm {
 
+class DCBlockProfile;
+class DCCallSummaries;
 class DCInstrSema;
+struct DCDataSection;
+struct DCObjCAccessor;
+struct DCObjCMessageIndex;
+struct DCStubTargets;
 class DCRegisterSema;
+class DCTranslationCache;
+struct DCTranslatedUnit;
 
 namespace TransOpt {
 enum Level {
@@ -50,6 +65,64 @@ enum Level {
 }
 
 class DCTranslator {
+public:
+  /// \brief Create a new DCRegisterSema in \p DRS, and return a new
+  /// DCInstrSema using it, or null on failure.
+  /// Used to give each worker of a parallel translation its own semantics.
+  typedef std::function<std::unique_ptr<DCInstrSema>(
+      std::unique_ptr<DCRegisterSema> &DRS)> SemaFactoryTy;
+
+  /// \brief Write out the current module \p M, before it is freed.
+  /// Used to stream the translation out, see setModuleStreaming.
+  typedef std::function<void(Module &M)> ModuleStreamerTy;
+
+  /// \brief Return the memory used by the process, in bytes.
+  /// Used to bound it, see setModuleStreamingMemoryLimit.
+  typedef std::function<uint64_t()> MemoryProbeTy;
+
+  /// Used to select the functions to translate, see setFunctionFilter.
+  typedef std::function<bool(uint64_t Addr)> FunctionFilterTy;
+
+  /// \brief Cost of the translation of one function, see
+  /// setRecordFunctionStats.
+  struct FunctionStats {
+    uint64_t Addr;
+    /// \brief Time spent in DCInstrSema, translating the instructions.
+    double TranslateSeconds;
+    /// \brief Time spent in the function pass manager.
+    double OptimizeSeconds;
+    /// \brief IR instructions in the function, once optimized.
+    uint64_t NumIRInsts;
+    /// \brief Growth of the heap during the translation. This is measured
+    /// on the whole process, so is only exact without concurrent work.
+    int64_t MallocBytes;
+  };
+
+  /// \brief Counters of the progress of the translation. They are updated
+  /// once per function, and can be read by other threads while it runs.
+  /// With worker processes, a range of functions is only counted once its
+  /// worker is done.
+  struct Progress {
+    /// \brief Functions to translate in translateAllKnownFunctions.
+    std::atomic<uint64_t> NumFunctions;
+    /// \brief Functions translated, or found in the translation cache.
+    std::atomic<uint64_t> NumDoneFunctions;
+    /// \brief Machine instructions in the functions done.
+    std::atomic<uint64_t> NumInsts;
+
+    Progress() : NumFunctions(0), NumDoneFunctions(0), NumInsts(0) {}
+  };
+
+  /// \brief Where the function at an address was translated, in any of the
+  /// modules: see getTranslatedFunctionAt.
+  struct TranslatedFunction {
+    /// \brief The module of the function, or null once it was streamed out.
+    Module *M;
+    /// \brief The function, in M, or null along with M.
+    Function *F;
+  };
+
+private:
   LLVMContext &Ctx;
   const DataLayout DL;
 
@@ -69,6 +142,57 @@ class DCTranslator {
 
   TransOpt::Level OptLevel;
 
+  unsigned NumJobs;
+  SemaFactoryTy SemaFactory;
+
+  DCTranslationCache *Cache;
+  std::string CacheConfig;
+  unsigned NumCachedFunctions;
+
+  bool ProcessIsolation;
+  std::vector<uint64_t> CrashedFunctions;
+  // The over-budget and the flattened functions, translated by any worker.
+  mutable std::mutex OverBudgetMutex;
+  std::vector<uint64_t> OverBudgetFunctions;
+  std::vector<uint64_t> FlattenedFunctions;
+
+  // Streaming: the limits of each module (0 for none), and what the current
+  // module holds so far.
+  unsigned StreamMaxFunctions;
+  uint64_t StreamMaxInsts;
+  // The memory limit, and the usage the next module must reach first.
+  uint64_t StreamMaxBytes;
+  uint64_t StreamMinBytes;
+  MemoryProbeTy MemoryProbe;
+  ModuleStreamerTy Streamer;
+  unsigned NumModuleFunctions;
+  uint64_t NumModuleInsts;
+
+  FunctionFilterTy FunctionFilter;
+
+  bool ExternalWrappers;
+
+  bool RecordFunctionStats;
+  std::mutex FunctionStatsMutex;
+  std::vector<FunctionStats> FuncStats;
+
+  Progress TheProgress;
+  std::atomic<uint64_t> OptimizeNanoseconds;
+
+  bool ReleaseMCInsts;
+  /// \brief Release the instructions of \p MCFN, with setReleaseMCInsts.
+  void releaseMCInsts(MCFunction &MCFN);
+
+  /// \brief The functions with a body, in any of the modules so far, by
+  /// entry address: translateRecursivelyAt doesn't translate them again.
+  DenseMap<uint64_t, TranslatedFunction> TranslatedFunctions;
+  /// \brief Add the function at \p Addr to TranslatedFunctions, if it has a
+  /// body in the current module.
+  void recordTranslatedFunction(uint64_t Addr);
+  /// \brief Whether translateAllKnownFunctions translates the function at
+  /// \p Addr: it isn't a stub, and passes the filter.
+  bool shouldTranslate(uint64_t Addr) const;
+
 public:
   DCTranslator(LLVMContext &Ctx, const DataLayout &DL,
                TransOpt::Level OptLevel, DCInstrSema &DIS, DCRegisterSema &DRS,
@@ -82,17 +206,329 @@ public:
 
   Module *finalizeTranslationModule();
   Module *getCurrentTranslationModule() { return CurrentModule; }
+  /// \brief Give up the current module to the caller, and go on in a new
+  /// one, as streaming the module out does.
+  std::unique_ptr<Module> takeCurrentModule();
+
+  /// \brief Translate the function at \p Addr, and all the functions it
+  /// calls, recursively, in the current module. The functions translated in
+  /// an earlier module are only declared. Without a disassembler, only the
+  /// functions of the MCModule can be translated.
+  /// \returns the function at \p Addr in the current module.
+  Function *translateRecursivelyAt(uint64_t Addr) {
+    return translateAt(Addr, /*Recursive=*/true);
+  }
+
+  /// \brief Translate the function at \p Addr in the current module, or, if
+  /// \p Recursive, along with all the functions it calls, as
+  /// translateRecursivelyAt does. Otherwise, the callees are only declared:
+  /// see getDeclaredFunctionsToTranslate.
+  Function *translateAt(uint64_t Addr, bool Recursive);
+
+  /// \brief Whether translateAt can translate the function at \p Addr: with
+  /// a disassembler, any code can be, and otherwise only that of the module.
+  bool canTranslateAt(uint64_t Addr);
 
-  Function *translateRecursivelyAt(uint64_t Addr);
+  /// \brief Get the functions the current module declares, as call targets,
+  /// and that weren't translated yet, with their address.
+  void getDeclaredFunctionsToTranslate(
+      SmallVectorImpl<std::pair<uint64_t, Function *>> &Fns);
 
+  /// \brief Translate the body of \p F, a function of the current module
+  /// that was only declared, as a call target, or left out by the function
+  /// filter: this translates functions when a client first needs them.
+  /// Unlike translateRecursivelyAt, the callees are left declared, and only
+  /// functions already in the MCModule are translated.
+  /// \returns \p F if it now has a body, or null if it is external, or
+  /// unknown to the MCModule.
+  Function *translateOnDemand(Function *F);
+
+  /// \brief Translate all the functions in the MCModule.
+  /// If parallel translation was enabled using setNumJobs, the functions are
+  /// split in shards, translated by worker threads, each in its own
+  /// LLVMContext, and linked into the current module, in order, by the
+  /// calling thread, as they are translated: with module streaming, the
+  /// streamer runs while the workers translate the next shards. The shards
+  /// are balanced by code size, and the largest are translated first.
   void translateAllKnownFunctions();
 
+  /// \brief Disassemble each function of the ranges of the disassembler, in
+  /// address order, translate it, and release its instructions, before
+  /// going on to the next one: the MCModule, built with
+  /// MCObjectDisassembler::buildLazyModule, never holds more than the
+  /// instructions of one function. This is sequential, without the
+  /// translation cache, and without IR annotations, which keep the
+  /// instructions.
+  void translateAllFunctionsFused();
+
+  /// \brief Use \p Jobs threads in translateAllKnownFunctions, getting their
+  /// semantics from \p Factory.
+  /// Parallel translation is unavailable with IR annotations, which track the
+  /// translated instructions of the current module only.
+  void setNumJobs(unsigned Jobs, SemaFactoryTy Factory) {
+    NumJobs = Jobs ? Jobs : 1;
+    SemaFactory = std::move(Factory);
+  }
+
+  /// \brief Reuse the translations that \p Cache has of the functions, and
+  /// add the others to it, in translateAllKnownFunctions.
+  /// \p Config describes what else than the options of the translator changes
+  /// the translation, such as the target triple.
+  /// The cache is filled and read by the workers of the parallel translation:
+  /// it needs a semantics factory, see setNumJobs, even for a single job, and
+  /// is unavailable with IR annotations.
+  /// With -dc-cache-unoptimized, the cache keeps the translations before the
+  /// function passes, which the workers run on each function, whether found
+  /// in the cache or not: the entries are then shared by all the pass
+  /// pipelines, and -O levels.
+  void setTranslationCache(DCTranslationCache *Cache, StringRef Config) {
+    this->Cache = Cache;
+    CacheConfig = Config;
+  }
+
+  /// \brief Get the number of functions translateAllKnownFunctions found in
+  /// the translation cache.
+  unsigned getNumCachedFunctions() const { return NumCachedFunctions; }
+
+  /// \brief Translate in worker processes instead of threads, in
+  /// translateAllKnownFunctions, so that a crash only takes a worker down.
+  /// The functions of a failed worker are split in halves, and translated
+  /// again, until the function that crashes is alone: it is then defined as
+  /// a trap, see getCrashedFunctions.
+  /// This needs a semantics factory, see setNumJobs, even for a single job.
+  /// It is only available on Unix, and forks: the process shouldn't run
+  /// other threads.
+  void setProcessIsolation(bool Enable) { ProcessIsolation = Enable; }
+
+  /// \brief Get the entry addresses of the functions whose translation
+  /// crashed a worker process, in increasing order.
+  const std::vector<uint64_t> &getCrashedFunctions() const {
+    return CrashedFunctions;
+  }
+
+  /// \brief Get the entry addresses of the functions whose translation ran
+  /// out of the -dc-function-budget, in increasing order. Those translated
+  /// in worker processes aren't known.
+  std::vector<uint64_t> getOverBudgetFunctions() const;
+
+  /// \brief Get the entry addresses of the functions whose control flow
+  /// looks flattened, see MCFlattenedCFG, in increasing order. They are only
+  /// looked for with -dc-flattened-as-large; those reused from the cache, or
+  /// translated in worker processes, aren't known.
+  std::vector<uint64_t> getFlattenedFunctions() const;
+
+  /// \brief Stream the translation out, to bound the memory it uses.
+  /// Once the current module holds \p MaxFunctions translated functions, or
+  /// \p MaxInsts IR instructions, translateAllKnownFunctions passes it to
+  /// \p Streamer and frees it, then goes on in a new module. A limit of 0 is
+  /// no limit. \p Streamer is always called on the thread that called
+  /// translateAllKnownFunctions. The last module is left current, for the caller to finish.
+  /// Modules only refer to functions of other modules by name, through
+  /// declarations: they can be linked back together.
+  void setModuleStreaming(unsigned MaxFunctions, uint64_t MaxInsts,
+                          ModuleStreamerTy Streamer) {
+    StreamMaxFunctions = MaxFunctions;
+    StreamMaxInsts = MaxInsts;
+    this->Streamer = std::move(Streamer);
+  }
+
+  /// \brief Also stream the current module out, see setModuleStreaming, once
+  /// \p Probe reports \p MaxBytes or more: a large input then makes more
+  /// modules, rather than more memory. The memory freed isn't always given
+  /// back to the system: the next module is only streamed once the usage
+  /// grew again, by a 64th of \p MaxBytes.
+  void setModuleStreamingMemoryLimit(uint64_t MaxBytes, MemoryProbeTy Probe) {
+    StreamMaxBytes = MaxBytes;
+    StreamMinBytes = 0;
+    MemoryProbe = std::move(Probe);
+  }
+
+  /// \brief Only translate, in translateAllKnownFunctions, the functions
+  /// whose entry address \p Filter accepts. Calls to the others are still
+  /// translated, to declarations.
+  void setFunctionFilter(FunctionFilterTy Filter) {
+    FunctionFilter = std::move(Filter);
+  }
+
+  /// \brief Translate the calls to the stubs in \p Stubs directly to calls
+  /// to their targets, with all the semantics, and don't translate the stubs
+  /// themselves. \p Stubs must outlive the translator.
+  void setStubTargets(const DCStubTargets *Stubs);
+
+  /// \brief Name the translated functions after \p Names, rather than
+  /// "fn_<address>", see DCInstrSema::setFunctionNames.
+  void setFunctionNames(const DenseMap<uint64_t, std::string> *Names);
+
+  /// \brief Refer to the entries of \p Sections as global variables, see
+  /// DCInstrSema::setDataSections. \p Sections must outlive the translator.
+  void setDataSections(const std::vector<DCDataSection> *Sections);
+
+  /// \brief Call the methods of the messages to classes directly, see
+  /// DCInstrSema::setObjCMessageIndex. \p Index must outlive the translator.
+  void setObjCMessageIndex(const DCObjCMessageIndex *Index);
+
+  /// \brief Mark the functions at \p Addrs always-inline, see
+  /// DCInstrSema::setInlinedFunctions. \p Addrs must outlive the translator.
+  void setInlinedFunctions(const DenseSet<uint64_t> *Addrs);
+
+  /// \brief Only save and restore, around the calls, the registers the
+  /// callees can read and clobber, see DCInstrSema::setCallSummaries.
+  /// \p Summaries must outlive the translator.
+  void setCallSummaries(const DCCallSummaries *Summaries);
+
+  /// \brief Weigh the branches, and count the function entries, per
+  /// \p Profile, see DCInstrSema::setBlockProfile. \p Profile must outlive
+  /// the translator.
+  void setBlockProfile(const DCBlockProfile *Profile);
+
+  /// \brief Skip the saves and restores of the callee-saved registers found
+  /// with \p MIA, see DCInstrSema::setCalleeSavedSpillAnalysis. \p MIA must
+  /// outlive the translator.
+  void setCalleeSavedSpillAnalysis(const MCInstrAnalysis *MIA);
+
+  /// \brief Translate the block copies and clears found with \p MIA to
+  /// memmoves and memsets, see DCInstrSema::setMemoryTransferAnalysis.
+  /// \p MIA must outlive the translator.
+  void setMemoryTransferAnalysis(const MCInstrAnalysis *MIA);
+
+  /// \brief Translate the indirect calls to the constants found with \p MIA
+  /// as direct calls, see DCInstrSema::setConstantCallAnalysis. \p MIA must
+  /// outlive the translator.
+  void setConstantCallAnalysis(const MCInstrAnalysis *MIA);
+
+  /// \brief Whether the external functions found while translating get a
+  /// wrapper calling the native function, as running the translation needs
+  /// (the default), or are only declared, under their names, as the stubs'
+  /// targets are.
+  void setExternalWrappers(bool Enable) { ExternalWrappers = Enable; }
+
+  /// \brief Measure the cost of each function translated from now on.
+  /// The functions found in the translation cache, or translated in worker
+  /// processes, aren't measured.
+  void setRecordFunctionStats(bool Record) { RecordFunctionStats = Record; }
+
+  /// \brief Free the instructions and blocks of each MCFunction once
+  /// translateAllKnownFunctions has translated it, see
+  /// MCFunction::releaseInsts: only its address and name are kept.
+  /// This is ignored with IR annotations, which refer to the instructions.
+  void setReleaseMCInsts(bool Release) { ReleaseMCInsts = Release; }
+
+  /// \brief Get the cost of the translated functions, in the order they
+  /// were translated.
+  const std::vector<FunctionStats> &getFunctionStats() const {
+    return FuncStats;
+  }
+
+  const Progress &getProgress() const { return TheProgress; }
+
+  /// \brief Get the time spent in the function pass managers, summed over
+  /// the threads. The functions found in the translation cache, or
+  /// translated in worker processes, aren't counted.
+  double getOptimizeSeconds() const { return OptimizeNanoseconds * 1e-9; }
+
+  /// \brief Get the tracker of the translated instructions, only used with
+  /// IR annotations.
+  const DCTranslatedInstTracker &getTranslatedInstTracker() const {
+    return DTIT;
+  }
+
+  /// \brief Get the names of the passes run on each translated function at
+  /// \p OptLevel, comma separated: those of -dc-passes, if given.
+  static std::string getFunctionPassPipeline(TransOpt::Level OptLevel);
+
+  /// \brief Create the passes of getFunctionPassPipeline, in order, for code
+  /// translated with the register semantics \p DRS. This is what the
+  /// function pass manager of the translator holds, along with timers, with
+  /// -dc-time-passes.
+  static std::vector<std::unique_ptr<FunctionPass>>
+  createFunctionPasses(TransOpt::Level OptLevel, const DCRegisterSema &DRS);
+
+  /// \brief Add to \p FPM the alias analyses of the TBAA tags of the
+  /// translated accesses, which the translator's pass managers ask first.
+  static void addAliasAnalyses(legacy::FunctionPassManager &FPM);
+
+  /// \brief Get the entry address of the function the calling thread is
+  /// translating, if any. This is meant to be called on crashes: it is safe
+  /// to call from a signal handler.
+  static bool getFunctionInTranslation(uint64_t &Addr);
+
   void printCurrentModule(raw_ostream &OS);
 
+  /// \brief Get the IR function translated from, or called at, \p Addr in
+  /// the current module, or null if there is none.
+  /// Unlike looking up "fn_<addr>" by name, this still works once functions
+  /// have been renamed.
+  Function *getFunctionAt(uint64_t Addr) const;
+
+  /// \brief Like getFunctionAt, but declare the function if there is none, as
+  /// when it was defined in an earlier, streamed out, module.
+  Function *getOrDeclareFunctionAt(uint64_t Addr);
+
+  /// \brief Define the function at \p Addr, instead of translating it, as a
+  /// call to the function at \p TargetAddr, whose machine code is the same.
+  /// It is defined in the current module, like a translated function.
+  void createThunkFunction(uint64_t Addr, uint64_t TargetAddr);
+
+  /// \brief Define the function at \p Addr, instead of translating it, as
+  /// the Objective-C accessor \p A, see DCInstrSema::matchObjCAccessor. It
+  /// is defined in the current module, like a translated function.
+  void createObjCAccessorFunction(uint64_t Addr, const DCObjCAccessor &A);
+
+  /// \brief Get where the function at \p Addr was translated, in any of the
+  /// modules so far, or null if it has no body in any.
+  const TranslatedFunction *getTranslatedFunctionAt(uint64_t Addr) const;
+
+  /// \brief Get all the functions of the current module, by address.
+  const DenseMap<uint64_t, Function *> &getFunctions() const;
+
+  /// \brief Get the call basic blocks of the current module, each with the
+  /// start address of the machine basic block containing the call.
+  const std::vector<std::pair<uint64_t, BasicBlock *>> &
+  getCallBasicBlocks() const;
+
 private:
+  std::unique_ptr<legacy::FunctionPassManager> createFPM(Module *M) const;
+
   void
   translateFunction(MCFunction *MCFN,
-                    const MCObjectDisassembler::AddressSetTy &TailCallTargets);
+                    const MCObjectDisassembler::AddressSetTy &TailCallTargets) {
+    translateFunction(MCFN, TailCallTargets, DIS, CurrentFPM.get(),
+                      AnnotWriter ? &DTIT : nullptr);
+    recordTranslatedFunction(MCFN->getEntryBlock()->getStartAddr());
+  }
+  /// \brief Translate \p MCFN with \p TheDIS, and optimize it with \p FPM,
+  /// if not null.
+  /// Return false if it ran out of the -dc-function-budget: the blocks it
+  /// didn't get to then trap, and it isn't optimized.
+  bool
+  translateFunction(MCFunction *MCFN,
+                    const MCObjectDisassembler::AddressSetTy &TailCallTargets,
+                    DCInstrSema &TheDIS, legacy::FunctionPassManager *FPM,
+                    DCTranslatedInstTracker *Tracker);
+
+  /// \brief Optimize \p Fn, the translation of \p MCFN, with \p FPM, or with
+  /// the -dc-large-function-passes if it is large.
+  void optimizeFunction(const MCFunction &MCFN, Function &Fn,
+                        const DCRegisterSema &DRS,
+                        legacy::FunctionPassManager &FPM);
+
+  /// \brief Optimize the function of \p Unit, the unoptimized translation of
+  /// \p MCFN named \p Name, as translateFunction would have, and update the
+  /// rest of \p Unit to match. The module is read back in \p Ctx.
+  void optimizeUnit(const MCFunction &MCFN, StringRef Name,
+                    DCTranslatedUnit &Unit, LLVMContext &Ctx,
+                    const DCRegisterSema &DRS);
+
+  void translateAllKnownFunctionsInParallel();
+
+  /// \brief Count \p MCFN as done in the progress counters.
+  void addDoneFunction(const MCFunction &MCFN);
+
+  /// \brief Whether the current module reached the streaming limits.
+  bool isCurrentModuleFull() const;
+  /// \brief Pass the current module to the streamer, free it, and switch to
+  /// a new one.
+  void streamCurrentModule();
 };
 
 } // end namespace llvm
@@ -120,15 +120,6 @@ public:
   void SetInstDebugLocation(Instruction *I) const {
     if (CurDbgLocation)
       I->setDebugLoc(CurDbgLocation);
-    if(getContext().getRecordOrNot() ==true){
-       //char tmp_char[5] = {0x0,0x0,0x0,0x0,0x0};
-      //memcpy(((char*)&cur_code_add),tmp_char,4);
-      //MDNode* tmp_node = MDNode::get(getContext(),MDString::get(getContext(),tmp_char));
-     MDNode* tmp_node = MDNode::get(getContext(),MDString::get(getContext(),utohexstr(getContext().getCurAdd())));
-      I->setMetadata("num",tmp_node);
-    }
-    else{
-    }
   }
 
   /// \brief Get the return type of the current function that we're emitting
@@ -537,28 +528,7 @@ public:
   explicit IRBuilder(LLVMContext &C, MDNode *FPMathTag = nullptr)
     : IRBuilderBase(C, FPMathTag), Folder() {
   }
-  
-  /*
-   add by -death
-   */
-   /*
-   add by -death
-   */
-  bool record_or_not=false;
-  void set_record_or_not(bool record){
-    record_or_not = record;
-  }
-  uint64_t cur_code_add;
-  void set_cur_address(uint64_t cur_address){
-    cur_code_add = cur_address;
-  }
-  /*
-   add by -death end 
-   */
-  /*
-   add by -death end 
-   */
-  
+
   explicit IRBuilder(BasicBlock *TheBB, const T &F, MDNode *FPMathTag = nullptr)
     : IRBuilderBase(TheBB->getContext(), FPMathTag), Folder(F) {
     SetInsertPoint(TheBB);
@@ -608,6 +578,14 @@ public:
     return C;
   }
 
+  /// \brief Overload for the folders that return Value*: insert \p V if it
+  /// is an instruction, and return it as is otherwise.
+  Value *Insert(Value *V, const Twine &Name = "") const {
+    if (Instruction *I = dyn_cast<Instruction>(V))
+      return Insert(I, Name);
+    return V;
+  }
+
   //===--------------------------------------------------------------------===//
   // Instruction creation methods: Terminators
   //===--------------------------------------------------------------------===//
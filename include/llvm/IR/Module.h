@@ -648,6 +648,11 @@ public:
   void print(raw_ostream &OS, AssemblyAnnotationWriter *AAW,
              bool ShouldPreserveUseListOrder = false) const;
 
+  /// Print the module to an output stream, like print without annotations,
+  /// using \p NumJobs threads to print the functions. The output is the
+  /// same: functions are printed in order, with the same slot numbers.
+  void printInParallel(raw_ostream &OS, unsigned NumJobs) const;
+
   /// Dump the module to stderr (for debugging).
   void dump() const;
   
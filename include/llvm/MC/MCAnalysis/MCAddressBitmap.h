@@ -0,0 +1,114 @@
+//===-- llvm/MC/MCAnalysis/MCAddressBitmap.h --------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the declaration of the MCAddressBitmap class, a compact
+// set of instruction addresses.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_MC_MCANALYSIS_MCADDRESSBITMAP_H
+#define LLVM_MC_MCANALYSIS_MCADDRESSBITMAP_H
+
+#include "llvm/ADT/BitVector.h"
+#include "llvm/Support/DataTypes.h"
+#include <iterator>
+#include <vector>
+
+namespace llvm {
+
+/// \brief A set of addresses inside a few known regions (typically, the text
+/// sections of an object file), stored as one bit per instruction slot.
+/// Slots are \p Granularity bytes wide: an address is identified by the slot
+/// (Addr - RegionBase) / Granularity. Addresses outside all regions are never
+/// in the set.
+class MCAddressBitmap {
+  struct Region {
+    uint64_t Base;
+    uint64_t End;
+    BitVector Bits;
+  };
+  /// \brief Regions, sorted by base address.
+  std::vector<Region> Regions;
+  unsigned Granularity;
+  /// \brief Total number of set bits.
+  size_t NumSet;
+
+  const Region *findRegion(uint64_t Addr) const;
+  Region *findRegion(uint64_t Addr) {
+    return const_cast<Region *>(
+        static_cast<const MCAddressBitmap *>(this)->findRegion(Addr));
+  }
+
+public:
+  explicit MCAddressBitmap(unsigned Granularity = 4)
+      : Granularity(Granularity), NumSet(0) {}
+
+  unsigned getGranularity() const { return Granularity; }
+  void setGranularity(unsigned G) {
+    assert(Regions.empty() && "Can't change granularity of used bitmap!");
+    Granularity = G;
+  }
+
+  /// \brief Track the \p Size bytes starting at \p Base. If \p SetAll, all the
+  /// slots in the region are added to the set.
+  /// A region that overlaps others is merged with them, keeping the addresses
+  /// already in the set.
+  void addRegion(uint64_t Base, uint64_t Size, bool SetAll = false);
+
+  /// \brief Add \p Addr to the set.
+  /// \returns true if it was not already in the set, false if it was, or if
+  /// it isn't inside any region.
+  bool insert(uint64_t Addr);
+
+  /// \brief Return true if \p Addr is in the set.
+  bool test(uint64_t Addr) const;
+
+  /// \brief Return the number of addresses in the set.
+  size_t count() const { return NumSet; }
+  bool empty() const { return NumSet == 0; }
+
+  /// \brief Iterate over the addresses in the set, in increasing order.
+  /// Each address is the start of its slot.
+  class const_iterator
+      : public std::iterator<std::forward_iterator_tag, uint64_t> {
+    const MCAddressBitmap *Map;
+    size_t RegionIdx;
+    int Bit;
+
+    /// \brief Move to the next set bit, possibly in a later region.
+    void advance();
+
+  public:
+    const_iterator(const MCAddressBitmap *Map, size_t RegionIdx)
+        : Map(Map), RegionIdx(RegionIdx), Bit(-1) {
+      advance();
+    }
+
+    uint64_t operator*() const {
+      return Map->Regions[RegionIdx].Base + uint64_t(Bit) * Map->Granularity;
+    }
+    const_iterator &operator++();
+    const_iterator operator++(int) {
+      const_iterator Tmp = *this;
+      ++*this;
+      return Tmp;
+    }
+    bool operator==(const const_iterator &RHS) const {
+      return Map == RHS.Map && RegionIdx == RHS.RegionIdx && Bit == RHS.Bit;
+    }
+    bool operator!=(const const_iterator &RHS) const { return !(*this == RHS); }
+  };
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, Regions.size()); }
+};
+
+} // end namespace llvm
+
+#endif
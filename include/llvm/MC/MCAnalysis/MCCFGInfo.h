@@ -0,0 +1,76 @@
+//===-- llvm/MC/MCAnalysis/MCCFGInfo.h --------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the declaration of the MCCFGInfo class, the structure of
+// the CFG of an MCFunction: its dominator tree, its loops, and its strongly
+// connected components.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_MC_MCANALYSIS_MCCFGINFO_H
+#define LLVM_MC_MCANALYSIS_MCCFGINFO_H
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/BitVector.h"
+#include "llvm/MC/MCAnalysis/MCDominators.h"
+#include "llvm/MC/MCAnalysis/MCLoopInfo.h"
+#include <vector>
+
+namespace llvm {
+
+/// \brief The dominator tree, the loops and the strongly connected
+/// components of the CFG of an MCFunction, for the analyses that need its
+/// structure before it is translated. They only cover the blocks reachable
+/// from the entry.
+class MCCFGInfo {
+  MCDominatorTree DT;
+  MCLoopInfo LI;
+  /// \brief The blocks of all the SCCs, those of SCC I in
+  /// [SCCBegins[I], SCCBegins[I + 1]).
+  std::vector<const MCBasicBlock *> SCCBlocks;
+  std::vector<uint32_t> SCCBegins;
+  /// \brief The SCCs that are cycles: more than one block, or a block that
+  /// branches to itself.
+  BitVector CyclicSCCs;
+  /// \brief The SCC of each block, by block index, or NoSCC.
+  std::vector<uint32_t> BlockSCCs;
+
+public:
+  static const uint32_t NoSCC = ~0U;
+
+  /// \brief Analyze \p F, which mustn't be empty, dropping the previous
+  /// results.
+  void analyze(const MCFunction &F);
+
+  /// \brief Analyze each of \p Funcs, on \p NumJobs threads. The functions
+  /// without blocks are left unanalyzed.
+  static std::vector<MCCFGInfo> analyzeAll(ArrayRef<const MCFunction *> Funcs,
+                                           unsigned NumJobs);
+
+  const MCDominatorTree &getDomTree() const { return DT; }
+  const MCLoopInfo &getLoopInfo() const { return LI; }
+
+  /// \brief The SCCs are numbered in reverse topological order: an SCC comes
+  /// before those that branch to it.
+  size_t getNumSCCs() const { return CyclicSCCs.size(); }
+  ArrayRef<const MCBasicBlock *> getSCC(uint32_t I) const {
+    return makeArrayRef(SCCBlocks.data() + SCCBegins[I],
+                        SCCBlocks.data() + SCCBegins[I + 1]);
+  }
+  bool isCyclicSCC(uint32_t I) const { return CyclicSCCs.test(I); }
+  /// \brief Get the SCC of \p BB, or NoSCC if it isn't reachable.
+  uint32_t getSCCIndex(const MCBasicBlock *BB) const {
+    return BB->getIndex() < BlockSCCs.size() ? BlockSCCs[BB->getIndex()]
+                                             : NoSCC;
+  }
+};
+
+} // end namespace llvm
+
+#endif
@@ -13,6 +13,9 @@
 #include "llvm/MC/MCDisassembler.h"
 #include "llvm/MC/MCInst.h"
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace llvm {
@@ -25,13 +28,17 @@ namespace llvm {
 
 /// MCCachingDisassembler - Provide a transparent caching layer around
 /// an arbitrary MCDisassembler.
+///
+/// For fixed-width instruction sets (e.g. AArch64), a specialized mode keys
+/// the cache on the 32-bit encoding word, using a hash table sharded by
+/// word hash. In that mode, the cache is thread-safe, and only contains
+/// instructions that decode to the same MCInst at a different address, so
+/// that no PC-relative fixup is needed on a hit.
 class MCCachingDisassembler : public MCDisassembler {
 public:
+  /// \param FixedWidth If true, use the 4-byte fixed-width cache.
   MCCachingDisassembler(const MCDisassembler &Disassembler,
-                        const MCSubtargetInfo &STI)
-      : MCDisassembler(STI, Disassembler.getContext()),
-        Impl(Disassembler), TempInstKeys(), TempInstValues(), CachedInsts(),
-        LongestCachedRawBytes(0) {}
+                        const MCSubtargetInfo &STI, bool FixedWidth = false);
 
   virtual ~MCCachingDisassembler();
 
@@ -39,8 +46,58 @@ public:
                               ArrayRef<uint8_t> Bytes, uint64_t Address,
                               raw_ostream &VStream,
                               raw_ostream &CStream) const override;
+
+  /// \brief Return true if getInstruction can be called concurrently.
+  /// This is only the case in fixed-width mode.
+  bool isThreadSafe() const { return FixedWidth; }
+
+  /// \name Cache statistics.
+  /// @{
+  uint64_t getNumLookups() const { return NumLookups; }
+  uint64_t getNumHits() const { return NumHits; }
+  /// @}
+
+  /// \brief Get an estimate of the heap memory used by the cache tables, in
+  /// bytes.
+  size_t getMemoryUsage() const;
+
 private:
   const MCDisassembler &Impl;
+  const bool FixedWidth;
+
+  mutable std::atomic<uint64_t> NumLookups;
+  mutable std::atomic<uint64_t> NumHits;
+
+  /// \name Fixed-width mode.
+  /// @{
+  struct WordEntry {
+    enum StateTy : uint8_t { Empty, Cached, Uncacheable };
+    StateTy State;
+    uint32_t Word;
+    MCInst Inst;
+    WordEntry() : State(Empty), Word(0) {}
+  };
+
+  /// \brief An open-addressing hash table of encoding words, with its lock.
+  struct WordShard {
+    std::mutex Lock;
+    std::vector<WordEntry> Entries;
+    size_t NumUsed;
+    WordShard() : NumUsed(0) {}
+
+    /// \brief Find the entry for \p Word, or the empty entry to use for it.
+    WordEntry &lookup(uint32_t Word, unsigned Hash);
+    void grow();
+  };
+
+  enum { NumWordShards = 64 };
+  std::unique_ptr<WordShard[]> WordShards;
+
+  DecodeStatus getFixedWidthInstruction(MCInst &Instr, uint64_t &Size,
+                                        ArrayRef<uint8_t> Bytes,
+                                        uint64_t Address, raw_ostream &VStream,
+                                        raw_ostream &CStream) const;
+  /// @}
 
   struct TempInstKey {
     ArrayRef<uint8_t> Bytes;
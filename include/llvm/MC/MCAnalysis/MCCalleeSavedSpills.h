@@ -0,0 +1,61 @@
+//===-- llvm/MC/MCAnalysis/MCCalleeSavedSpills.h ----------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the declaration of the MCCalleeSavedSpills class, the
+// saves of the callee-saved registers by the prologue of an MCFunction, and
+// their restores by its epilogues.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_MC_MCANALYSIS_MCCALLEESAVEDSPILLS_H
+#define LLVM_MC_MCANALYSIS_MCCALLEESAVEDSPILLS_H
+
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/DenseSet.h"
+
+namespace llvm {
+
+class MCFunction;
+class MCInstrAnalysis;
+class MCRegisterInfo;
+
+/// \brief The instructions of a function that save callee-saved registers to
+/// the stack, in the prologue, and restore them, in the epilogues, found with
+/// MCInstrAnalysis::evaluateStackSpill.
+/// They are only found if they match: each epilogue restores all the saved
+/// registers, from the stack slots they were saved to, as the stack pointer
+/// is tracked from the entry, and from the returns back. The restored
+/// registers then hold their incoming value, and the saves are only read by
+/// the restores, unless the function reads its own frame records.
+class MCCalleeSavedSpills {
+  /// \brief The registers saved.
+  BitVector SavedRegs;
+  /// \brief The addresses of the saves and restores.
+  DenseSet<uint64_t> SpillAddrs;
+
+public:
+  /// \brief Find the saves and restores of \p F. Return false, and find
+  /// nothing, if there are none, or if they don't match.
+  bool analyze(const MCFunction &F, const MCInstrAnalysis &MIA,
+               const MCRegisterInfo &MRI);
+
+  void clear() {
+    SavedRegs.clear();
+    SpillAddrs.clear();
+  }
+  bool empty() const { return SpillAddrs.empty(); }
+
+  const BitVector &getSavedRegs() const { return SavedRegs; }
+  bool isSpill(uint64_t Addr) const { return SpillAddrs.count(Addr); }
+  size_t getNumSpills() const { return SpillAddrs.size(); }
+};
+
+} // end namespace llvm
+
+#endif
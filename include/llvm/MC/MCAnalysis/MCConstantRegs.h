@@ -0,0 +1,85 @@
+//===-- llvm/MC/MCAnalysis/MCConstantRegs.h ---------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the declaration of the MCConstantRegs class, the
+// registers of an MCFunction that hold a constant, or a pointer loaded from a
+// constant address, as the targets of the indirect calls often do.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_MC_MCANALYSIS_MCCONSTANTREGS_H
+#define LLVM_MC_MCANALYSIS_MCCONSTANTREGS_H
+
+#include "llvm/ADT/DenseMap.h"
+#include <vector>
+
+namespace llvm {
+
+class MCDecodedInst;
+class MCFunction;
+class MCInstrAnalysis;
+class MCInstrInfo;
+class MCRegisterInfo;
+
+/// \brief The values of the registers of a function, propagated along its
+/// CFG from the instructions MCInstrAnalysis::evaluateConstantDef describes,
+/// e.g.:
+///   adrp x8, _got@PAGE
+///   cbz  x0, next                 (any block boundaries)
+///   ldr  x9, [x8, _got@PAGEOFF]   x9 is the pointer at _got
+///   blr  x9
+/// A register has a value before an instruction if it has the same one on all
+/// the paths from the entry of the function: the value of the blocks is the
+/// intersection of that of their predecessors. Only the registers set in the
+/// function have one, and the calls clobber them all.
+class MCConstantRegs {
+public:
+  struct Value {
+    uint64_t Val;
+    /// \brief Whether this is the pointer loaded from the address Val, rather
+    /// than Val itself.
+    bool IsLoad;
+
+    bool operator==(const Value &Other) const {
+      return Val == Other.Val && IsLoad == Other.IsLoad;
+    }
+    bool operator!=(const Value &Other) const { return !(*this == Other); }
+  };
+
+private:
+  typedef DenseMap<unsigned, Value> RegValues;
+
+  const MCFunction *F;
+  const MCInstrAnalysis *MIA;
+  const MCInstrInfo *MII;
+  const MCRegisterInfo *MRI;
+  /// \brief The values at the start of each block, by block index.
+  std::vector<RegValues> BlockValues;
+
+  void transfer(const MCDecodedInst &DI, RegValues &Values) const;
+  void setReg(unsigned Reg, const Value *V, RegValues &Values) const;
+
+public:
+  MCConstantRegs() : F(nullptr), MIA(nullptr), MII(nullptr), MRI(nullptr) {}
+
+  void analyze(const MCFunction &F, const MCInstrAnalysis &MIA,
+               const MCInstrInfo &MII, const MCRegisterInfo &MRI);
+  void clear() {
+    F = nullptr;
+    BlockValues.clear();
+  }
+
+  /// \brief Get the value \p Reg has before the instruction at \p Addr.
+  /// Return true if it has one, in \p V.
+  bool lookup(uint64_t Addr, unsigned Reg, Value &V) const;
+};
+
+} // end namespace llvm
+
+#endif
@@ -0,0 +1,143 @@
+//===-- llvm/MC/MCAnalysis/MCDominators.h -----------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the GraphTraits of the MC CFG, and the declaration of the
+// MCDominatorTree class, the dominator tree of an MCFunction, computed before
+// it is translated.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_MC_MCANALYSIS_MCDOMINATORS_H
+#define LLVM_MC_MCANALYSIS_MCDOMINATORS_H
+
+#include "llvm/ADT/GraphTraits.h"
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/Support/GenericDomTree.h"
+
+namespace llvm {
+
+/// \brief An iterator over the edges of a block that yields the blocks
+/// non-const, for the generic dominator tree and loops, which take their
+/// blocks non-const, but only walk them.
+class MCBasicBlockEdgeIterator
+    : public iterator_adaptor_base<
+          MCBasicBlockEdgeIterator, MCBasicBlock::edge_iterator,
+          std::random_access_iterator_tag, MCBasicBlock *, std::ptrdiff_t,
+          MCBasicBlock *const *, MCBasicBlock *> {
+public:
+  MCBasicBlockEdgeIterator() {}
+  explicit MCBasicBlockEdgeIterator(MCBasicBlock::edge_iterator I)
+      : MCBasicBlockEdgeIterator::iterator_adaptor_base(I) {}
+
+  MCBasicBlock *operator*() const { return const_cast<MCBasicBlock *>(*I); }
+};
+
+template <> struct GraphTraits<MCBasicBlock *> {
+  typedef MCBasicBlock NodeType;
+  typedef MCBasicBlockEdgeIterator ChildIteratorType;
+
+  static NodeType *getEntryNode(MCBasicBlock *BB) { return BB; }
+  static ChildIteratorType child_begin(NodeType *N) {
+    return ChildIteratorType(N->succ_begin());
+  }
+  static ChildIteratorType child_end(NodeType *N) {
+    return ChildIteratorType(N->succ_end());
+  }
+};
+
+template <> struct GraphTraits<Inverse<MCBasicBlock *>> {
+  typedef MCBasicBlock NodeType;
+  typedef MCBasicBlockEdgeIterator ChildIteratorType;
+
+  static NodeType *getEntryNode(Inverse<MCBasicBlock *> G) { return G.Graph; }
+  static ChildIteratorType child_begin(NodeType *N) {
+    return ChildIteratorType(N->pred_begin());
+  }
+  static ChildIteratorType child_end(NodeType *N) {
+    return ChildIteratorType(N->pred_end());
+  }
+};
+
+template <> struct GraphTraits<const MCBasicBlock *> {
+  typedef const MCBasicBlock NodeType;
+  typedef MCBasicBlock::succ_const_iterator ChildIteratorType;
+
+  static NodeType *getEntryNode(const MCBasicBlock *BB) { return BB; }
+  static ChildIteratorType child_begin(NodeType *N) { return N->succ_begin(); }
+  static ChildIteratorType child_end(NodeType *N) { return N->succ_end(); }
+};
+
+template <> struct GraphTraits<Inverse<const MCBasicBlock *>> {
+  typedef const MCBasicBlock NodeType;
+  typedef MCBasicBlock::pred_const_iterator ChildIteratorType;
+
+  static NodeType *getEntryNode(Inverse<const MCBasicBlock *> G) {
+    return G.Graph;
+  }
+  static ChildIteratorType child_begin(NodeType *N) { return N->pred_begin(); }
+  static ChildIteratorType child_end(NodeType *N) { return N->pred_end(); }
+};
+
+template <>
+struct GraphTraits<MCFunction *> : public GraphTraits<MCBasicBlock *> {
+  static NodeType *getEntryNode(MCFunction *F) { return F->getEntryBlock(); }
+  static unsigned size(MCFunction *F) { return F->size(); }
+};
+
+template <>
+struct GraphTraits<const MCFunction *>
+    : public GraphTraits<const MCBasicBlock *> {
+  static NodeType *getEntryNode(const MCFunction *F) {
+    return F->getEntryBlock();
+  }
+  typedef MCFunction::const_iterator nodes_iterator;
+  static nodes_iterator nodes_begin(const MCFunction *F) { return F->begin(); }
+  static nodes_iterator nodes_end(const MCFunction *F) { return F->end(); }
+  static unsigned size(const MCFunction *F) { return F->size(); }
+};
+
+typedef DomTreeNodeBase<MCBasicBlock> MCDomTreeNode;
+
+/// \brief The dominator tree of the blocks of an MCFunction that are reachable
+/// from its entry block. The blocks only reached through edges the
+/// disassembler didn't find, as from a jump table, aren't in the tree.
+class MCDominatorTree : public DominatorTreeBase<MCBasicBlock> {
+public:
+  MCDominatorTree() : DominatorTreeBase<MCBasicBlock>(false) {}
+
+  /// \brief Compute the tree of \p F, dropping the previous one.
+  void recalculate(const MCFunction &F);
+
+  MCDomTreeNode *getNode(const MCBasicBlock *BB) const {
+    return DominatorTreeBase<MCBasicBlock>::getNode(
+        const_cast<MCBasicBlock *>(BB));
+  }
+};
+
+template <> struct GraphTraits<MCDomTreeNode *> {
+  typedef MCDomTreeNode NodeType;
+  typedef NodeType::iterator ChildIteratorType;
+
+  static NodeType *getEntryNode(NodeType *N) { return N; }
+  static ChildIteratorType child_begin(NodeType *N) { return N->begin(); }
+  static ChildIteratorType child_end(NodeType *N) { return N->end(); }
+};
+
+template <> struct GraphTraits<const MCDomTreeNode *> {
+  typedef const MCDomTreeNode NodeType;
+  typedef NodeType::const_iterator ChildIteratorType;
+
+  static NodeType *getEntryNode(NodeType *N) { return N; }
+  static ChildIteratorType child_begin(NodeType *N) { return N->begin(); }
+  static ChildIteratorType child_end(NodeType *N) { return N->end(); }
+};
+
+} // end namespace llvm
+
+#endif
@@ -0,0 +1,71 @@
+//===-- llvm/MC/MCAnalysis/MCFlattenedCFG.h ---------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the declaration of the MCFlattenedCFG class, the
+// detection of the MCFunctions whose control flow was flattened by an
+// obfuscator.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_MC_MCANALYSIS_MCFLATTENEDCFG_H
+#define LLVM_MC_MCANALYSIS_MCFLATTENEDCFG_H
+
+#include "llvm/Support/DataTypes.h"
+
+namespace llvm {
+
+class MCBasicBlock;
+class MCFunction;
+class MCInstrInfo;
+
+/// \brief The dispatcher of a function whose control flow was flattened, as
+/// OLLVM does: the blocks of the original function all end by setting a
+/// state variable to a constant, the number of the next one, and by going
+/// back to a single block, which branches, on the state, to that next block.
+///
+/// It is found on the MC CFG: a block that most of the blocks of the
+/// function go back to, the hub, which reaches, on its own, a block with
+/// many successors, the dispatcher; and most of the blocks that go back to
+/// the hub last set the same register to a constant.
+/// The original edges aren't recovered: the state is only known by the
+/// dispatcher.
+class MCFlattenedCFG {
+  const MCBasicBlock *Hub;
+  const MCBasicBlock *Dispatcher;
+  unsigned StateReg;
+  unsigned NumCases;
+
+public:
+  /// \brief The smallest number of blocks going back to the hub.
+  static const unsigned MinCases = 8;
+
+  MCFlattenedCFG() { clear(); }
+
+  /// \brief Find the dispatcher of \p F. Return false, and find nothing, if
+  /// it doesn't look flattened.
+  bool analyze(const MCFunction &F, const MCInstrInfo &MII);
+
+  void clear() {
+    Hub = Dispatcher = nullptr;
+    StateReg = NumCases = 0;
+  }
+  bool empty() const { return !Dispatcher; }
+
+  /// \brief The block the cases go back to, which can be the dispatcher.
+  const MCBasicBlock *getHub() const { return Hub; }
+  const MCBasicBlock *getDispatcher() const { return Dispatcher; }
+  /// \brief The register the cases set the state in.
+  unsigned getStateReg() const { return StateReg; }
+  /// \brief The number of blocks that go back to the hub.
+  unsigned getNumCases() const { return NumCases; }
+};
+
+} // end namespace llvm
+
+#endif
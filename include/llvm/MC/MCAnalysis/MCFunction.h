@@ -15,8 +15,13 @@
 #ifndef LLVM_MC_MCANALYSIS_MCFUNCTION_H
 #define LLVM_MC_MCANALYSIS_MCFUNCTION_H
 
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/iterator.h"
 #include "llvm/MC/MCInst.h"
+#include "llvm/MC/MCInstrAnalysis.h"
+#include <algorithm>
 #include <list>
 #include <string>
 #include <vector>
@@ -35,19 +40,33 @@ public:
   MCInst Inst;
   uint64_t Address;
   uint64_t Size;
-  MCDecodedInst(const MCInst &Inst, uint64_t Address, uint64_t Size)
-    : Inst(Inst), Address(Address), Size(Size) {}
+  /// The control flow properties of Inst, if the disassembler classified it.
+  MCInstrAnalysis::Classification Class;
+  MCDecodedInst(const MCInst &Inst, uint64_t Address, uint64_t Size,
+                MCInstrAnalysis::Classification Class =
+                    MCInstrAnalysis::Classification())
+    : Inst(Inst), Address(Address), Size(Size), Class(Class) {}
+
+  /// \brief Get the classification of Inst, computing it with \p MIA if it
+  /// wasn't kept.
+  MCInstrAnalysis::Classification
+  classify(const MCInstrAnalysis &MIA) const {
+    return Class.isClassified() ? Class : MIA.classify(Inst, Address, Size);
+  }
 };
 
 /// \brief Basic block containing a sequence of disassembled instructions.
 /// Create a basic block using MCFunction::createBlock.
+/// The instructions are a [begin, end) slice of contiguous storage, usually
+/// owned by the parent MCFunction (see MCFunction::moveInsts). So are the
+/// edges, as indices of blocks of the parent (see MCFunction::setEdges).
 class MCBasicBlock {
-  typedef std::vector<MCDecodedInst> InstListTy;
-  InstListTy Insts;
+  MCDecodedInst *InstsBegin, *InstsEnd;
+  /// \brief Storage for the instructions appended using addInst.
+  std::vector<MCDecodedInst> OwnedInsts;
 
   std::string Name;
   uint64_t StartAddr, SizeInBytes;
-  uint64_t InstCount;
 
   /// \brief The address of the next appended instruction, i.e., the
   /// address immediately after the last instruction in the block.
@@ -55,20 +74,37 @@ class MCBasicBlock {
 
   // MCFunction owns the basic block.
   MCFunction *Parent;
+  /// \brief The position of the block in its parent.
+  uint32_t Index;
 
   // MCFunction owns the basic block.
   friend class MCFunction;
   // MCObjectDisassembler fills in the basic block.
   friend class MCObjectDisassembler;
+  // MCModuleBinaryIO saves and restores it.
+  friend class MCModuleBinaryIO;
+  // MCModule measures its memory.
+  friend class MCModule;
+
+  MCBasicBlock(uint64_t StartAddr, MCFunction *Parent, uint32_t Index);
 
-  MCBasicBlock(uint64_t StartAddr, MCFunction *Parent);
+  /// \brief Make this block use the instructions in [\p Begin, \p End),
+  /// whose storage isn't owned by the block.
+  void setInsts(MCDecodedInst *Begin, MCDecodedInst *End, uint64_t Size);
 
   /// \name Predecessors/Successors, to represent the CFG.
+  /// The successors are [EdgesBegin, PredsBegin), and the predecessors
+  /// [PredsBegin, EdgesEnd), as block indices.
   /// @{
-  typedef std::vector<const MCBasicBlock *> BasicBlockListTy;
-  BasicBlockListTy Successors;
-  BasicBlockListTy Predecessors;
+  const uint32_t *EdgesBegin, *PredsBegin, *EdgesEnd;
+  /// \brief Storage for the edges added using addSuccessor/addPredecessor,
+  /// until MCFunction::finalizeEdges.
+  std::vector<uint32_t> OwnedEdges;
   /// @}
+
+  /// \brief Make the edges of this block owned, to add one.
+  void ownEdges();
+
 public:
   /// Append an instruction.
   void addInst(const MCInst &Inst, uint64_t InstSize);
@@ -82,12 +118,26 @@ public:
 
   /// \name Instruction list access
   /// @{
-  typedef InstListTy::const_iterator const_iterator;
-  const_iterator begin() const { return Insts.begin(); }
-  const_iterator end()   const { return Insts.end(); }
-
-  const MCDecodedInst &back() const { return Insts.back(); }
-  size_t size() const { return InstCount; }
+  typedef const MCDecodedInst *const_iterator;
+  const_iterator begin() const { return InstsBegin; }
+  const_iterator end()   const { return InstsEnd; }
+
+  typedef MCDecodedInst *iterator;
+  iterator begin() { return InstsBegin; }
+  iterator end()   { return InstsEnd; }
+
+  const MCDecodedInst &back() const { return InstsEnd[-1]; }
+        MCDecodedInst &back()       { return InstsEnd[-1]; }
+  size_t size() const { return InstsEnd - InstsBegin; }
+  bool empty() const { return InstsBegin == InstsEnd; }
+
+  /// \brief Find the instruction, if any, that contains \p Addr.
+  const MCDecodedInst *findInst(uint64_t Addr) const;
+
+  /// \brief Remove the instructions for which \p ShouldRemove returns true.
+  /// The remaining instructions keep their address, and the block its size.
+  /// \returns the number of removed instructions.
+  size_t removeInsts(function_ref<bool(const MCDecodedInst &)> ShouldRemove);
   /// @}
 
   /// \name Get the owning MCFunction.
@@ -96,15 +146,30 @@ public:
         MCFunction *getParent()       { return Parent; }
   /// @}
 
+  /// \brief Get the position of the block in its parent, which its edges
+  /// refer to it by.
+  uint32_t getIndex() const { return Index; }
+
   /// MC CFG access: Predecessors/Successors.
   /// @{
-  typedef BasicBlockListTy::const_iterator succ_const_iterator;
-  succ_const_iterator succ_begin() const { return Successors.begin(); }
-  succ_const_iterator succ_end()   const { return Successors.end(); }
-
-  typedef BasicBlockListTy::const_iterator pred_const_iterator;
-  pred_const_iterator pred_begin() const { return Predecessors.begin(); }
-  pred_const_iterator pred_end()   const { return Predecessors.end(); }
+  class edge_iterator;
+  typedef edge_iterator succ_const_iterator;
+  succ_const_iterator succ_begin() const;
+  succ_const_iterator succ_end()   const;
+
+  typedef edge_iterator pred_const_iterator;
+  pred_const_iterator pred_begin() const;
+  pred_const_iterator pred_end()   const;
+
+  /// \brief Get the successors and predecessors as block indices.
+  ArrayRef<uint32_t> succ_indices() const {
+    return makeArrayRef(EdgesBegin, PredsBegin);
+  }
+  ArrayRef<uint32_t> pred_indices() const {
+    return makeArrayRef(PredsBegin, EdgesEnd);
+  }
+  size_t succ_size() const { return PredsBegin - EdgesBegin; }
+  size_t pred_size() const { return EdgesEnd - PredsBegin; }
 
   void addSuccessor(const MCBasicBlock *MCBB);
   bool isSuccessor(const MCBasicBlock *MCBB) const;
@@ -124,11 +189,38 @@ class MCFunction {
   MCModule *ParentModule;
   typedef std::vector<MCBasicBlock *> BasicBlockListTy;
   BasicBlockListTy Blocks;
+  /// \brief The storage of the blocks: chunks of as many blocks as were
+  /// created before (up to a limit), or as reserveBlocks asked for. A block
+  /// takes one allocation in the many small functions, and the blocks of the
+  /// big ones are mostly contiguous.
+  std::vector<MCBasicBlock *> BlockChunks;
+  MCBasicBlock *NextBlock, *BlocksEnd;
+  /// \brief The blocks, sorted by start address, for the lookups. It is
+  /// built by the first lookup after blocks were created.
+  mutable BasicBlockListTy SortedBlocks;
+  /// \brief The instruction arrays the blocks are slices of, see moveInsts.
+  std::vector<std::vector<MCDecodedInst>> InstArrays;
+  /// \brief The edges of all the blocks, in compressed sparse row form: the
+  /// successors then the predecessors of each block, in block order. The
+  /// blocks' edges are slices of it, see setEdges.
+  std::vector<uint32_t> Edges;
+  /// \brief The instructions of all the blocks, in block order, encoded by
+  /// packInsts, or empty.
+  std::vector<uint8_t> PackedInsts;
+  bool InstsReleased;
+  uint32_t UnwindEncoding;
+  /// \brief The addresses of the jumps to other functions that were rewritten
+  /// into calls, each followed by a return, sorted.
+  std::vector<uint64_t> TailCalls;
 
   // MCModule owns the function.
   friend class MCModule;
   MCFunction(StringRef Name, MCModule *Parent);
 
+  /// \brief Get the blocks sorted by start address, sorting them if blocks
+  /// were created since the last time.
+  const BasicBlockListTy &getSortedBlocks() const;
+
   // MCObjectDisassembler fills in the function.
   friend class MCObjectDisassembler;
 
@@ -139,9 +231,69 @@ public:
   /// \param Insts Sequence of straight-line code backing the basic block.
   /// \returns The newly created basic block.
   MCBasicBlock &createBlock(uint64_t StartAddr);
+  /// \brief Make room for \p NumBlocks more blocks, to be created together.
+  void reserveBlocks(size_t NumBlocks);
+
+  /// \brief Move \p Insts to contiguous storage owned by the function, and
+  /// return it, for its blocks to use slices of. The storage lives until the
+  /// function is destroyed, or releaseInsts is called.
+  MutableArrayRef<MCDecodedInst> moveInsts(MutableArrayRef<MCDecodedInst> Insts);
+
+  /// \brief Set the edges of all the blocks at once. \p NewEdges are the
+  /// indices of the successors then the predecessors of each block, in
+  /// block order: those of block I are in [EdgeBegins[2 * I],
+  /// EdgeBegins[2 * I + 1]) and [EdgeBegins[2 * I + 1], EdgeBegins[2 * I + 2]).
+  void setEdges(std::vector<uint32_t> NewEdges, ArrayRef<uint32_t> EdgeBegins);
+  /// \brief Set the successors of all the blocks at once, and make the
+  /// predecessors match: those of block I are Succs[SuccBegins[I],
+  /// SuccBegins[I + 1]). The predecessors of a block are in block order.
+  void setSuccessors(ArrayRef<uint32_t> Succs, ArrayRef<uint32_t> SuccBegins);
+  /// \brief Move the edges added with MCBasicBlock::addSuccessor and
+  /// addPredecessor to the contiguous storage of the function.
+  void finalizeEdges();
+
+  /// \brief Fill this function, which has no blocks, with copies of the
+  /// blocks of \p Src, their instructions and their edges, as from another
+  /// build of the same code. \p Src mustn't be packed nor released.
+  void copyBlocks(const MCFunction &Src);
+
+  /// \brief Free the instructions and the blocks of the function, once they
+  /// aren't needed anymore, as after the function is translated. Only the
+  /// entry block is left, empty, for the function to keep its address.
+  void releaseInsts();
+  /// \brief Whether releaseInsts was called.
+  bool areInstsReleased() const { return InstsReleased; }
+
+  /// \brief Encode the instructions of the function compactly, as LEB128
+  /// opcodes, operands and address deltas, and free the decoded ones: the
+  /// blocks are then empty, but keep their address, size and edges, until
+  /// unpackInsts. A decoded AArch64 instruction takes about 130 bytes, a
+  /// packed one about 12.
+  /// \returns false, leaving the instructions as they are, if they have
+  /// expression or instruction operands, which can't be packed.
+  bool packInsts();
+  /// \brief Decode the instructions packed by packInsts back into the
+  /// blocks, if they are packed.
+  void unpackInsts();
+  /// \brief Whether packInsts was called, but not unpackInsts since.
+  bool areInstsPacked() const { return !PackedInsts.empty(); }
 
   StringRef getName() const { return Name; }
 
+  /// \brief Get the compact unwind encoding of the function, as in the
+  /// __unwind_info of the object, or 0 if it is unknown. See
+  /// object::MachOUnwindInfo to decode it.
+  uint32_t getUnwindEncoding() const { return UnwindEncoding; }
+
+  /// \brief Get the addresses, sorted, of the jumps to other functions that
+  /// were rewritten into calls. Each call is followed, in its block, by a
+  /// return of no size, which isn't in the code.
+  ArrayRef<uint64_t> getTailCalls() const { return TailCalls; }
+  /// \brief Whether the instruction at \p Addr is one of getTailCalls.
+  bool isTailCall(uint64_t Addr) const {
+    return std::binary_search(TailCalls.begin(), TailCalls.end(), Addr);
+  }
+
   /// \name Get the owning MC Module.
   /// @{
   const MCModule *getParent() const { return ParentModule; }
@@ -170,6 +322,14 @@ public:
   const MCBasicBlock*  back() const { return Blocks.back(); }
         MCBasicBlock*  back()       { return Blocks.back(); }
 
+  /// \brief Get the block at \p Index, as the edges refer to it.
+  const MCBasicBlock *getBlock(uint32_t Index) const { return Blocks[Index]; }
+        MCBasicBlock *getBlock(uint32_t Index)       { return Blocks[Index]; }
+
+  // The lookups below are binary searches of the blocks sorted by start
+  // address. The first one after blocks are created sorts them: it can't run
+  // concurrently with other lookups of the function.
+
   /// \brief Find the basic block, if any, that starts at \p StartAddr.
   const MCBasicBlock *find(uint64_t StartAddr) const;
         MCBasicBlock *find(uint64_t StartAddr);
@@ -184,6 +344,36 @@ public:
   /// @}
 };
 
+/// \brief An iterator over the edges of a block, stored as block indices,
+/// that yields the blocks.
+class MCBasicBlock::edge_iterator
+    : public iterator_adaptor_base<
+          edge_iterator, const uint32_t *, std::random_access_iterator_tag,
+          const MCBasicBlock *, std::ptrdiff_t, const MCBasicBlock *const *,
+          const MCBasicBlock *> {
+  const MCFunction *Parent;
+
+public:
+  edge_iterator() : Parent(nullptr) {}
+  edge_iterator(const uint32_t *I, const MCFunction *Parent)
+      : edge_iterator::iterator_adaptor_base(I), Parent(Parent) {}
+
+  const MCBasicBlock *operator*() const { return Parent->getBlock(*I); }
+};
+
+inline MCBasicBlock::succ_const_iterator MCBasicBlock::succ_begin() const {
+  return edge_iterator(EdgesBegin, Parent);
+}
+inline MCBasicBlock::succ_const_iterator MCBasicBlock::succ_end() const {
+  return edge_iterator(PredsBegin, Parent);
+}
+inline MCBasicBlock::pred_const_iterator MCBasicBlock::pred_begin() const {
+  return edge_iterator(PredsBegin, Parent);
+}
+inline MCBasicBlock::pred_const_iterator MCBasicBlock::pred_end() const {
+  return edge_iterator(EdgesEnd, Parent);
+}
+
 }
 
 #endif
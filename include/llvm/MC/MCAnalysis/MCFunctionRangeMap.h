@@ -0,0 +1,98 @@
+//===-- llvm/MC/MCAnalysis/MCFunctionRangeMap.h -----------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the declaration of the MCFunctionRangeMap class, which
+// maps addresses to the function ranges delimited by a set of known function
+// start addresses, and optionally of known function end addresses.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_MC_MCANALYSIS_MCFUNCTIONRANGEMAP_H
+#define LLVM_MC_MCANALYSIS_MCFUNCTIONRANGEMAP_H
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/Support/DataTypes.h"
+#include <utility>
+#include <vector>
+
+namespace llvm {
+
+/// \brief A sorted set of function start addresses, such as the ones found in
+/// the LC_FUNCTION_STARTS of a stripped binary.
+/// Each function is assumed to span from its start to the next function start,
+/// or to the first known end before it, as from the unwind info.
+/// All lookups are binary searches.
+class MCFunctionRangeMap {
+  std::vector<uint64_t> Starts;
+  std::vector<uint64_t> Ends;
+
+public:
+  typedef std::vector<uint64_t>::const_iterator const_iterator;
+
+  MCFunctionRangeMap() {}
+  /// \brief Build a map from \p Starts, which doesn't need to be sorted or
+  /// uniqued.
+  explicit MCFunctionRangeMap(std::vector<uint64_t> Starts);
+
+  const_iterator begin() const { return Starts.begin(); }
+  const_iterator end() const { return Starts.end(); }
+  size_t size() const { return Starts.size(); }
+  bool empty() const { return Starts.empty(); }
+  ArrayRef<uint64_t> getStarts() const { return Starts; }
+
+  /// \brief Set the addresses where functions are known to end, past their
+  /// last byte, as \p Ends, which doesn't need to be sorted or uniqued.
+  void setEnds(std::vector<uint64_t> Ends);
+  ArrayRef<uint64_t> getEnds() const { return Ends; }
+
+  /// \brief Find the function starting exactly at \p Addr, or end().
+  const_iterator find(uint64_t Addr) const;
+
+  /// \brief Find the function containing \p Addr, that is, the last function
+  /// starting at or before \p Addr, or end() if there is none.
+  const_iterator findContaining(uint64_t Addr) const;
+
+  /// \brief Find the first function starting strictly after \p Addr, or end().
+  const_iterator findNextStart(uint64_t Addr) const;
+
+  /// \brief Return the end address of the function starting at \p I, i.e. the
+  /// start of the next function, or the first known end after \p I if it is
+  /// before, or UINT64_MAX if there is neither.
+  uint64_t getEndAddr(const_iterator I) const {
+    return getNextBoundary(*I);
+  }
+
+  /// \brief Return the first function start or known end strictly after
+  /// \p Addr, or UINT64_MAX if there is none.
+  uint64_t getNextBoundary(uint64_t Addr) const;
+
+  /// \brief Return true if \p Addr is inside a function with a known end,
+  /// that is, between the first and the last function start (inclusive), or
+  /// before the last known end.
+  bool isInBoundedFunction(uint64_t Addr) const {
+    if (Starts.empty() || Addr < Starts.front())
+      return false;
+    return (Starts.size() > 1 && Addr <= Starts.back()) ||
+           (!Ends.empty() && Addr < Ends.back());
+  }
+
+  /// \brief Split the functions in \p NumShards ranges of consecutive
+  /// functions, of about the same size, and return the range of \p Shard, as
+  /// [first, second). Each function is weighted by its size, to the next
+  /// start, or to \p EndAddr for the last one: that is its number of
+  /// instructions, on fixed width targets. The ranges cover all addresses,
+  /// and only depend on the starts.
+  std::pair<uint64_t, uint64_t> getShardRange(unsigned Shard,
+                                              unsigned NumShards,
+                                              uint64_t EndAddr) const;
+};
+
+} // end namespace llvm
+
+#endif
@@ -0,0 +1,47 @@
+//===-- llvm/MC/MCAnalysis/MCLoopInfo.h -------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the declaration of the MCLoop and MCLoopInfo classes, the
+// natural loops of an MCFunction, found on its MCDominatorTree.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_MC_MCANALYSIS_MCLOOPINFO_H
+#define LLVM_MC_MCANALYSIS_MCLOOPINFO_H
+
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/MC/MCAnalysis/MCDominators.h"
+
+namespace llvm {
+
+/// \brief A natural loop of the MC CFG: a header, which dominates the blocks
+/// that branch back to it, and the blocks that reach those without going
+/// through the header.
+class MCLoop : public LoopBase<MCBasicBlock, MCLoop> {
+  friend class LoopInfoBase<MCBasicBlock, MCLoop>;
+  explicit MCLoop(MCBasicBlock *Header)
+      : LoopBase<MCBasicBlock, MCLoop>(Header) {}
+
+public:
+  MCLoop() {}
+};
+
+/// \brief The loops of an MCFunction, with the innermost loop of each block.
+/// As the MCDominatorTree it is computed from, it only has the blocks
+/// reachable from the entry.
+class MCLoopInfo : public LoopInfoBase<MCBasicBlock, MCLoop> {
+public:
+  /// \brief Find the loops of the function \p DT is the tree of, dropping
+  /// the previous ones.
+  void recalculate(const MCDominatorTree &DT);
+};
+
+} // end namespace llvm
+
+#endif
@@ -0,0 +1,94 @@
+//===-- llvm/MC/MCAnalysis/MCMemoryTransfers.h ------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the declaration of the MCMemoryTransfers class, the runs
+// of loads and stores of register pairs of an MCFunction that copy or clear a
+// block of memory, as the inlined copies and clears of structures are
+// unrolled to.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_MC_MCANALYSIS_MCMEMORYTRANSFERS_H
+#define LLVM_MC_MCANALYSIS_MCMEMORYTRANSFERS_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+#include <vector>
+
+namespace llvm {
+
+class MCFunction;
+class MCInstrAnalysis;
+class MCRegisterInfo;
+
+/// \brief The runs of consecutive instructions of a function, found with
+/// MCInstrAnalysis::evaluateMemoryPair, that:
+///   - store the zero register to a contiguous block, in any order:
+///       stp xzr, xzr, [x0]
+///       stp xzr, xzr, [x0, #16]
+///   - or load a contiguous block into distinct registers, then store them
+///     all, each at the same offset from the destination as it was loaded
+///     from the source, in any order:
+///       ldp q0, q1, [x1]
+///       ldp q2, q3, [x1, #32]
+///       stp q2, q3, [x0, #32]
+///       stp q0, q1, [x0]
+/// As the registers are all loaded before they are stored, a copy reads the
+/// source before writing the destination, even where they overlap.
+class MCMemoryTransfers {
+public:
+  struct Transfer {
+    /// \brief The address of the first instruction, and of the one after
+    /// the last.
+    uint64_t BeginAddr, EndAddr;
+    /// \brief The destination, from its base register.
+    unsigned DstBaseReg;
+    int64_t DstOffset;
+    /// \brief The source of a copy, from its base register, or 0 for a
+    /// clear.
+    unsigned SrcBaseReg;
+    int64_t SrcOffset;
+    /// \brief The size of the block, in bytes.
+    uint64_t Size;
+    /// \brief The registers a copy loads, and the offset, from the
+    /// destination base register, that each one is stored to: what they hold
+    /// after the run.
+    SmallVector<std::pair<unsigned, int64_t>, 8> Regs;
+
+    bool isClear() const { return !SrcBaseReg; }
+  };
+
+private:
+  std::vector<Transfer> Transfers;
+  /// \brief The index in Transfers of each instruction of the runs, by
+  /// address.
+  DenseMap<uint64_t, unsigned> InstTransfers;
+
+public:
+  /// \brief Find the runs of \p F of at least \p MinStores stores.
+  void analyze(const MCFunction &F, const MCInstrAnalysis &MIA,
+               const MCRegisterInfo &MRI, unsigned MinStores = 2);
+
+  void clear() {
+    Transfers.clear();
+    InstTransfers.clear();
+  }
+  bool empty() const { return Transfers.empty(); }
+  size_t size() const { return Transfers.size(); }
+
+  /// \brief Get the run the instruction at \p Addr is part of, or null.
+  const Transfer *lookup(uint64_t Addr) const {
+    auto I = InstTransfers.find(Addr);
+    return I == InstTransfers.end() ? nullptr : &Transfers[I->second];
+  }
+};
+
+} // end namespace llvm
+
+#endif
@@ -15,6 +15,7 @@
 #ifndef LLVM_MC_MCANALYSIS_MCMODULE_H
 #define LLVM_MC_MCANALYSIS_MCMODULE_H
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/iterator_range.h"
@@ -26,6 +27,7 @@
 namespace llvm {
 
 class MCBasicBlock;
+class MCDecodedInst;
 class MCFunction;
 class MCObjectDisassembler;
 
@@ -39,11 +41,26 @@ class MCModule {
   DenseMap<uint64_t, MCFunction *> FunctionsByAddr;
   /// @}
 
+  /// \brief A range of addresses covered by contiguous blocks of a function.
+  struct FunctionRange {
+    uint64_t Begin, End;
+    /// \brief The greatest End of this range and of those before it.
+    uint64_t MaxEnd;
+    MCFunction *Function;
+  };
+  typedef std::vector<FunctionRange> FunctionRangeListTy;
+  /// \brief The ranges of all the functions, sorted by Begin, see
+  /// findContaining. Built by the first lookup.
+  mutable FunctionRangeListTy AddressIndex;
+  const FunctionRangeListTy &getAddressIndex() const;
+
   MCModule           (const MCModule &) = delete;
   MCModule& operator=(const MCModule &) = delete;
 
   // MCObjectDisassembler creates MCModules.
   friend class MCObjectDisassembler;
+  // MCModuleBinaryIO saves and restores them.
+  friend class MCModuleBinaryIO;
 
 public:
   MCModule();
@@ -54,6 +71,32 @@ public:
 
   MCFunction *findFunctionAt(uint64_t BeginAddr);
 
+  /// \brief What contains an address: a function, its block, and the
+  /// instruction, or null.
+  struct AddressLocation {
+    MCFunction *Function;
+    const MCBasicBlock *Block;
+    const MCDecodedInst *Inst;
+
+    AddressLocation() : Function(nullptr), Block(nullptr), Inst(nullptr) {}
+  };
+
+  /// \brief Find the function, block and instruction containing \p Addr.
+  /// When the blocks of several functions contain it, the function whose
+  /// blocks start closest before \p Addr is picked. Once the instructions
+  /// of the function are released, only its entry block is found, without
+  /// an instruction.
+  ///
+  /// The lookups go through an index of the ranges of all the blocks, built
+  /// by the first lookup, once the module is complete: it can't run
+  /// concurrently with other lookups, and only createFunction resets it.
+  AddressLocation findContaining(uint64_t Addr) const;
+  /// \brief Find what contains each of \p Addrs, into the same position of
+  /// \p Locs. The addresses are sorted, and looked up in a single sweep of
+  /// the index: this is for looking up many addresses at once.
+  void findContaining(ArrayRef<uint64_t> Addrs,
+                      std::vector<AddressLocation> &Locs) const;
+
   /// \name Access to the owned function list.
   /// @{
   typedef FunctionListTy::const_iterator const_func_iterator;
@@ -71,6 +114,27 @@ public:
     return const_func_iterator_range(func_begin(), func_end());
   }
   /// @}
+
+  /// \brief Heap memory used by the module, in bytes, by component. This is
+  /// an estimate: the strings and vectors are counted by capacity, and the
+  /// operands of the instructions that don't fit inline by number.
+  struct MemoryUsage {
+    /// \brief The functions, their names, the function lists and the address
+    /// index.
+    size_t Functions;
+    /// \brief The blocks, their names and their successor and predecessor
+    /// lists.
+    size_t Blocks;
+    /// \brief The decoded instructions, with their operands.
+    size_t Insts;
+  };
+  MemoryUsage getMemoryUsage() const;
+
+private:
+  /// \brief Find what contains \p Addr among the ranges of the address
+  /// index before \p I, which are those that begin at or before it.
+  AddressLocation locate(FunctionRangeListTy::const_iterator I,
+                         uint64_t Addr) const;
 };
 
 }
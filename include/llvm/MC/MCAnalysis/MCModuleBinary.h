@@ -0,0 +1,56 @@
+//===- MCModuleBinary.h - MCModule binary serialization ---------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// \brief This file declares the compact binary representation of MCModule,
+/// meant to checkpoint the MC CFG of big modules, where YAML is too slow.
+///
+/// The representation is a header followed by flat arrays of fixed-size,
+/// little-endian records: functions, basic blocks, CFG edges, instructions,
+/// operands, and finally the strings. Records refer to each other by index,
+/// so it can be read in place, from a mapped file.
+/// Opcodes and registers are stored as enum values: the representation can
+/// only be read back with the same target description.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_MC_MCANALYSIS_MCMODULEBINARY_H
+#define LLVM_MC_MCANALYSIS_MCMODULEBINARY_H
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/MC/MCAnalysis/MCModule.h"
+#include "llvm/Support/raw_ostream.h"
+#include <memory>
+
+namespace llvm {
+
+class MCInstrInfo;
+class MCRegisterInfo;
+
+/// \brief Return true if \p Data starts like a binary MCModule.
+bool isMCModuleBinary(StringRef Data);
+
+/// \brief Dump a binary representation of the MCModule \p MCM to \p OS.
+/// \p Tag is stored along, to identify what the module was built from.
+/// \returns The empty string on success, an error message on failure.
+StringRef mcmodule2binary(raw_ostream &OS, const MCModule &MCM,
+                          const MCInstrInfo &MII, const MCRegisterInfo &MRI,
+                          StringRef Tag = "");
+
+/// \brief Creates a new module from its binary representation \p Data, and
+/// returns it in \p MCM.
+/// Fails if the module was stored with another tag than \p Tag.
+/// \returns The empty string on success, an error message on failure.
+StringRef binary2mcmodule(std::unique_ptr<MCModule> &MCM, StringRef Data,
+                          const MCInstrInfo &MII, const MCRegisterInfo &MRI,
+                          StringRef Tag = "");
+
+} // end namespace llvm
+
+#endif
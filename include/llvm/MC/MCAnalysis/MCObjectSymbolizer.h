@@ -19,6 +19,8 @@
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/MC/MCSymbolizer.h"
 #include "llvm/Object/ObjectFile.h"
+#include "llvm/Object/MachOAddressSpaceMap.h"
+#include <atomic>
 #include <vector>
 
 namespace llvm {
@@ -27,6 +29,7 @@ class MCExpr;
 class MCInst;
 class MCRelocationInfo;
 class MCSymbol;
+class MCSymbolRefExpr;
 class raw_ostream;
 
 /// \brief An ObjectFile-backed symbolizer.
@@ -41,6 +44,13 @@ protected:
   // relocation (referencing the minuend symbol) is followed by an UNSIGNED
   // relocation (referencing the subtrahend symbol).
   const object::RelocationRef *findRelocationAt(uint64_t Addr) const;
+
+  /// \brief Same as findRelocationAt, for lookups of increasing addresses:
+  /// \p Cursor is the index in the sorted relocations where the last lookup
+  /// stopped, and is moved to where this one does. Starting with 0, the
+  /// lookups of a block cost about a step each.
+  const object::RelocationRef *findRelocationAt(uint64_t Addr,
+                                                size_t &Cursor) const;
   const object::SectionRef *findSectionContaining(uint64_t Addr) const;
 
 public:
@@ -83,20 +93,24 @@ public:
   virtual uint64_t getOriginalLoadAddr(uint64_t EffectiveAddr);
   /// @}
 
+  /// \brief Build the lookup tables that are otherwise built on first use:
+  /// the lookups are then read-only, and can be done from several threads.
+  void buildLookupTables();
+
 protected:
   struct FunctionSymbol {
     uint64_t Addr;
     uint64_t Size;
-    MCSymbol *Sym;
-    FunctionSymbol(uint64_t Addr, uint64_t Size = 0, MCSymbol *Sym = 0) :
-      Addr(Addr), Size(Size), Sym(Sym) { }
+    const MCSymbolRefExpr *Ref;
+    FunctionSymbol(uint64_t Addr, uint64_t Size = 0,
+                   const MCSymbolRefExpr *Ref = nullptr)
+        : Addr(Addr), Size(Size), Ref(Ref) {}
     bool operator<(const FunctionSymbol &RHS) const { return Addr < RHS.Addr; }
   };
 
   struct SectionInfo {
     SectionInfo(object::SectionRef S) : Section(S) {}
     object::SectionRef Section;
-    std::vector<object::RelocationRef> Relocs;
     bool operator<(uint64_t Addr) const {
       return Section.getAddress() + Section.getSize() <= Addr;
     }
@@ -109,12 +123,22 @@ protected:
   // FIXME: Just keep the uint64_t ?
   std::vector<std::pair<object::SymbolRef, uint64_t>> SymbolSizes;
   std::vector<SectionInfo> SortedSections;
+  /// \brief The addresses of the relocations of all the sections, sorted,
+  /// and the relocations, in the same order.
+  std::vector<uint64_t> RelocAddrs;
+  std::vector<object::RelocationRef> SortedRelocs;
+  /// \brief Where the last lookup of tryAddingSymbolicOperand stopped. It is
+  /// only a hint: the lookups are right from anywhere, so the threads that
+  /// symbolize at once can move it under each other.
+  std::atomic<size_t> RelocCursor;
   std::vector<FunctionSymbol> AddrToFunctionSymbol;
+  bool AddrToFunctionSymbolBuilt;
 
   void buildAddrToFunctionSymbolMap();
   void buildSectionList();
-  void buildRelocationByAddrMap(SectionInfo &SecInfo);
-  MCSymbol *findContainingFunction(uint64_t Addr, uint64_t &Offset);
+  void buildRelocationList();
+  const MCSymbolRefExpr *findContainingFunction(uint64_t Addr,
+                                                uint64_t &Offset);
 
   const SectionInfo *findSectionInfoContaining(uint64_t Addr) const;
   SectionInfo *findSectionInfoContaining(uint64_t Addr);
@@ -123,10 +147,10 @@ protected:
 class MCMachObjectSymbolizer final : public MCObjectSymbolizer {
   const object::MachOObjectFile &MOOF;
   // __TEXT;__stubs support.
-  uint64_t StubsStart;
-  uint64_t StubsCount;
-  uint64_t StubSize;
-  uint64_t StubsIndSymIndex;
+  object::MachOAddressSpaceMap AddrSpace;
+  /// \brief The external function each stub jumps to, without the leading
+  /// '_', by stub index. Empty for stubs to defined symbols.
+  std::vector<StringRef> StubFunctionNames;
 
   uint64_t VMAddrSlide;
 
@@ -135,6 +159,8 @@ class MCMachObjectSymbolizer final : public MCObjectSymbolizer {
   // __DATA;__mod_exit_func support.
   llvm::StringRef ModExitContents;
 
+  void buildStubFunctionNames();
+
 public:
   /// \brief Construct a Mach-O specific object symbolizer.
   /// \param VMAddrSlide The virtual address slide applied by dyld.
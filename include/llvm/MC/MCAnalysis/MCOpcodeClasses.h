@@ -0,0 +1,79 @@
+//===-- llvm/MC/MCAnalysis/MCOpcodeClasses.h --------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the declaration of the MCOpcodeClasses class, a table of
+// the control flow class of each opcode of a target, computed once from its
+// MCInstrDescs, and of the opcodes tail calls are rewritten to.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_MC_MCANALYSIS_MCOPCODECLASSES_H
+#define LLVM_MC_MCANALYSIS_MCOPCODECLASSES_H
+
+#include "llvm/Support/DataTypes.h"
+#include <vector>
+
+namespace llvm {
+
+class MCInstrAnalysis;
+class MCInstrDesc;
+
+/// \brief The control flow class of the opcodes of a target, looked up with
+/// a single array access, and the opcodes the disassembler rewrites tail
+/// calls to.
+/// Nothing is hardcoded: the classes come from the MCInstrDesc flags, and the
+/// rewrite opcodes from the MCInstrAnalysis hooks.
+class MCOpcodeClasses {
+public:
+  enum ClassFlags : uint8_t {
+    Branch         = 1 << 0,
+    CondBranch     = 1 << 1,
+    IndirectBranch = 1 << 2,
+    Call           = 1 << 3,
+    Return         = 1 << 4,
+    Terminator     = 1 << 5,
+    Barrier        = 1 << 6
+  };
+
+  explicit MCOpcodeClasses(const MCInstrAnalysis &MIA);
+
+  /// \brief Get the ClassFlags of \p Opcode.
+  uint8_t getClass(unsigned Opcode) const { return Classes[Opcode]; }
+
+  bool isCall(unsigned Opcode) const { return getClass(Opcode) & Call; }
+  bool isReturn(unsigned Opcode) const { return getClass(Opcode) & Return; }
+
+  /// \brief Is \p Opcode a direct unconditional branch, that isn't a call: a
+  /// jump that can be a tail call.
+  bool isDirectJump(unsigned Opcode) const {
+    return (getClass(Opcode) & (Branch | CondBranch | IndirectBranch | Call |
+                                Barrier)) == (Branch | Barrier);
+  }
+
+  /// \brief Get the direct call the direct jump \p Opcode is rewritten to
+  /// when it is a tail call, or 0.
+  unsigned getTailCallOpcode(unsigned Opcode) const {
+    return Opcode < TailCallOpcodes.size() ? TailCallOpcodes[Opcode] : 0;
+  }
+
+  /// \brief Get the return added after the rewritten tail calls, or 0.
+  unsigned getReturnOpcode() const { return ReturnOpcode; }
+
+private:
+  std::vector<uint8_t> Classes;
+  /// \brief The getTailCallOpcode of each opcode, up to the last direct jump.
+  std::vector<unsigned> TailCallOpcodes;
+  unsigned ReturnOpcode;
+
+  static uint8_t computeClass(const MCInstrDesc &Desc);
+};
+
+} // end namespace llvm
+
+#endif
@@ -0,0 +1,57 @@
+//===-- llvm/MC/MCAnalysis/MCRegisterUsage.h --------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the declaration of the MCRegisterUsage class, a summary
+// of the registers read and written by the instructions of an MCFunction.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_MC_MCANALYSIS_MCREGISTERUSAGE_H
+#define LLVM_MC_MCANALYSIS_MCREGISTERUSAGE_H
+
+#include "llvm/ADT/BitVector.h"
+
+namespace llvm {
+
+class MCBasicBlock;
+class MCFunction;
+class MCInst;
+class MCInstrInfo;
+class MCRegisterInfo;
+
+/// \brief The registers read and written by some machine code, as described
+/// by the MCInstrDescs: explicit register operands, and implicit uses/defs.
+/// Only the registers named by the instructions are recorded, not their
+/// aliases.
+class MCRegisterUsage {
+  const MCInstrInfo &MII;
+  BitVector Read;
+  BitVector Written;
+
+public:
+  MCRegisterUsage(const MCInstrInfo &MII, const MCRegisterInfo &MRI);
+
+  void clear() {
+    Read.reset();
+    Written.reset();
+  }
+
+  void addInst(const MCInst &Inst);
+  void addBasicBlock(const MCBasicBlock &BB);
+  void addFunction(const MCFunction &F);
+
+  const BitVector &getRead() const { return Read; }
+  const BitVector &getWritten() const { return Written; }
+  bool isRead(unsigned Reg) const { return Read.test(Reg); }
+  bool isWritten(unsigned Reg) const { return Written.test(Reg); }
+};
+
+} // end namespace llvm
+
+#endif
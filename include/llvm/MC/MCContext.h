@@ -22,6 +22,7 @@
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/raw_ostream.h"
 #include <map>
+#include <mutex>
 #include <tuple>
 #include <vector> // FIXME: Shouldn't be needed.
 
@@ -31,6 +32,7 @@ namespace llvm {
   class MCSection;
   class MCSymbol;
   class MCSymbolELF;
+  class MCSymbolRefExpr;
   class MCLabel;
   struct MCDwarfFile;
   class MCDwarfLoc;
@@ -74,6 +76,19 @@ namespace llvm {
     /// Bindings of names to symbols.
     SymbolTable Symbols;
 
+    /// The cache of getOrCreateSymbolRefConcurrently: the references to the
+    /// symbols, by name, in shards picked by the hash of the name, each with
+    /// its own lock.
+    struct ConcurrentSymbolShard {
+      std::mutex Lock;
+      StringMap<const MCSymbolRefExpr *> Refs;
+    };
+    static const unsigned NumConcurrentSymbolShards = 16;
+    ConcurrentSymbolShard ConcurrentSymbolShards[NumConcurrentSymbolShards];
+
+    /// Held to create objects in the context from several threads.
+    std::mutex CreationLock;
+
     /// ELF sections can have a corresponding symbol. This maps one to the
     /// other.
     DenseMap<const MCSectionELF *, MCSymbolELF *> SectionSymbols;
@@ -283,6 +298,19 @@ namespace llvm {
     /// Get the symbol for \p Name, or null.
     MCSymbol *lookupSymbol(const Twine &Name) const;
 
+    /// Get the reference to the symbol \p Name, creating both the first
+    /// time. This can be called from several threads at once, as long as
+    /// the other accesses to the context take the lockForCreation lock. The
+    /// references are found in a lock-striped cache. Only their creation
+    /// takes the lock of the context, once per name.
+    const MCSymbolRefExpr *getOrCreateSymbolRefConcurrently(StringRef Name);
+
+    /// Lock the context, to create other objects in it, such as expressions,
+    /// while getOrCreateSymbolRefConcurrently may run on other threads.
+    std::unique_lock<std::mutex> lockForCreation() {
+      return std::unique_lock<std::mutex>(CreationLock);
+    }
+
     /// getSymbols - Get a reference for the symbol table for clients that
     /// want to, for example, iterate over all symbols. 'const' because we
     /// still want any modifications to the table itself to use the MCContext
@@ -15,9 +15,11 @@
 #ifndef LLVM_MC_MCINSTRANALYSIS_H
 #define LLVM_MC_MCINSTRANALYSIS_H
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/MC/MCInst.h"
 #include "llvm/MC/MCInstrDesc.h"
 #include "llvm/MC/MCInstrInfo.h"
+#include <vector>
 
 namespace llvm {
 
@@ -31,6 +33,8 @@ public:
 
   virtual ~MCInstrAnalysis() {}
 
+  const MCInstrInfo &getInstrInfo() const { return *Info; }
+
   virtual bool isBranch(const MCInst &Inst) const {
     return Info->get(Inst.getOpcode()).isBranch();
   }
@@ -64,6 +68,182 @@ public:
   virtual bool
   evaluateBranch(const MCInst &Inst, uint64_t Addr, uint64_t Size,
                  uint64_t &Target) const;
+
+  /// \brief Given an instruction that refers to an address relative to its
+  /// own, other than as a branch target, as the PC-relative loads and
+  /// address computations do, try to get that address. Return true on
+  /// success, the address in \p Target, and the operand holding the offset
+  /// in \p OpIdx.
+  virtual bool evaluatePCRelativeAddress(const MCInst &Inst, uint64_t Addr,
+                                         uint64_t Size, unsigned &OpIdx,
+                                         uint64_t &Target) const {
+    return false;
+  }
+
+  /// \brief The control flow properties of an instruction, and the target of
+  /// its branch, as computed at once by classify.
+  struct Classification {
+    enum : uint16_t {
+      Branch              = 1 << 0,
+      ConditionalBranch   = 1 << 1,
+      UnconditionalBranch = 1 << 2,
+      IndirectBranch      = 1 << 3,
+      Call                = 1 << 4,
+      Return              = 1 << 5,
+      Terminator          = 1 << 6,
+      /// evaluateBranch succeeded, and Target is valid.
+      HasTarget           = 1 << 7,
+      /// Set by classify, unlike the default constructor.
+      Classified          = 1 << 8
+    };
+    uint16_t Flags;
+    uint64_t Target;
+
+    Classification() : Flags(0), Target(0) {}
+
+    bool isClassified() const { return Flags & Classified; }
+    bool isBranch() const { return Flags & Branch; }
+    bool isConditionalBranch() const { return Flags & ConditionalBranch; }
+    bool isUnconditionalBranch() const { return Flags & UnconditionalBranch; }
+    bool isIndirectBranch() const { return Flags & IndirectBranch; }
+    bool isCall() const { return Flags & Call; }
+    bool isReturn() const { return Flags & Return; }
+    bool isTerminator() const { return Flags & Terminator; }
+    bool evaluateBranch(uint64_t &T) const {
+      if (!(Flags & HasTarget))
+        return false;
+      T = Target;
+      return true;
+    }
+  };
+
+  /// \brief Get the is* properties of \p Inst, and evaluateBranch for the
+  /// branches and calls, looking up its descriptor once.
+  /// The targets that override the is* hooks override this as well.
+  virtual Classification classify(const MCInst &Inst, uint64_t Addr,
+                                  uint64_t Size) const;
+
+  /// \brief Get the direct call that the direct jump \p JumpOpcode is
+  /// rewritten to when it is a tail call, or 0 if it can't be.
+  /// By default, this is the only direct call taking the same operands.
+  virtual unsigned getTailCallOpcode(unsigned JumpOpcode) const;
+
+  /// \brief Get the return added after the rewritten tail calls, or 0 if
+  /// tail calls can't be rewritten.
+  /// By default, this is the only encodable return without side effects.
+  virtual unsigned getReturnOpcode() const;
+
+  /// \brief A table of branch targets, as switches are lowered to: the
+  /// target of entry I is Base + (entry I << EntryShift).
+  struct JumpTable {
+    uint64_t TableAddr;
+    uint64_t Base;
+    /// \brief The size of an entry, in bytes.
+    unsigned EntrySize;
+    bool SignedEntries;
+    unsigned EntryShift;
+    /// \brief The number of entries, from the bounds check of the index, or
+    /// 0 if it wasn't found.
+    uint64_t NumEntries;
+  };
+
+  /// \brief Given the instructions \p Insts, at \p Addrs, that lead to an
+  /// indirect branch, the last one, try to find the jump table it branches
+  /// through. Return true on success, and the table in \p JT.
+  virtual bool evaluateJumpTable(ArrayRef<MCInst> Insts,
+                                 ArrayRef<uint64_t> Addrs,
+                                 JumpTable &JT) const {
+    return false;
+  }
+
+  /// \brief A store of callee-saved registers to the stack, as prologues
+  /// save them with, or a load of them back, as epilogues restore them with.
+  struct StackSpill {
+    /// \brief The stack pointer.
+    unsigned BaseReg;
+    /// \brief The registers, the second one, if any, right after the first.
+    unsigned Regs[2];
+    unsigned NumRegs;
+    /// \brief The size of each register in the stack, in bytes.
+    unsigned RegSize;
+    bool IsLoad;
+    /// \brief The address of the first register, from the stack pointer
+    /// before the instruction.
+    int64_t Offset;
+    /// \brief What the instruction adds to the stack pointer, if it is pre-
+    /// or post-indexed, or 0.
+    int64_t SPAdjust;
+  };
+
+  /// \brief Given an instruction, check whether it stores callee-saved
+  /// registers to the stack, or loads them, at a constant offset from the
+  /// stack pointer. Return true if it does, and the spill in \p S.
+  virtual bool evaluateStackSpill(const MCInst &Inst, StackSpill &S) const {
+    return false;
+  }
+
+  /// \brief Given an instruction, check whether it adds a constant to the
+  /// stack pointer, and nothing else. Return true if it does, and the
+  /// constant in \p Adjust.
+  virtual bool evaluateStackAdjust(const MCInst &Inst, int64_t &Adjust) const {
+    return false;
+  }
+
+  /// \brief A load or a store of a pair of registers, at a constant offset
+  /// from a base register that it doesn't write back, as the inlined copies
+  /// and clears of structures are unrolled to.
+  struct MemoryPair {
+    unsigned BaseReg;
+    /// \brief The registers, the second one right after the first.
+    unsigned Regs[2];
+    /// \brief The size of each register in memory, in bytes.
+    unsigned RegSize;
+    bool IsLoad;
+    /// \brief Whether both stored registers read as zero.
+    bool StoresZero;
+    /// \brief The address of the first register, from the base register.
+    int64_t Offset;
+  };
+
+  /// \brief Given an instruction, check whether it loads or stores a pair of
+  /// registers at a constant offset from a base register, and nothing else.
+  /// Return true if it does, and the pair in \p P.
+  virtual bool evaluateMemoryPair(const MCInst &Inst, MemoryPair &P) const {
+    return false;
+  }
+
+  /// \brief How an instruction sets a register from constants, and from
+  /// another register, as the addresses of calls are materialized.
+  struct ConstantDef {
+    enum KindTy {
+      Value,  ///< Imm.
+      Add,    ///< SrcReg + Imm.
+      Insert, ///< SrcReg, with the bits of Mask replaced by those of Imm.
+      Load    ///< The pointer at SrcReg + Imm.
+    } Kind;
+    unsigned DefReg;
+    unsigned SrcReg;
+    int64_t Imm;
+    uint64_t Mask;
+  };
+
+  /// \brief Given an instruction at \p Addr, of \p Size bytes, check whether
+  /// it sets a pointer-sized register as described by ConstantDef, and has
+  /// no other effect on the registers. Return true if it does, and how in
+  /// \p D.
+  virtual bool evaluateConstantDef(const MCInst &Inst, uint64_t Addr,
+                                   uint64_t Size, ConstantDef &D) const {
+    return false;
+  }
+
+  /// \brief Scan the code \p Bytes, at \p Addr, for the direct calls,
+  /// matching their encoding rather than decoding it, and add their targets
+  /// to \p Targets, unsorted. Return false if the target can't: only the
+  /// fixed length encodings can be scanned reliably.
+  virtual bool findDirectCallTargets(ArrayRef<uint8_t> Bytes, uint64_t Addr,
+                                     std::vector<uint64_t> &Targets) const {
+    return false;
+  }
 };
 
 } // End llvm namespace
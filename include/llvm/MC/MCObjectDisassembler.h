@@ -16,11 +16,21 @@
 #define LLVM_MC_MCOBJECTDISASSEMBLER_H
 
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/DataTypes.h"
 #include "llvm/MC/MCInst.h"
+#include "llvm/MC/MCAnalysis/MCAddressBitmap.h"
+#include "llvm/MC/MCAnalysis/MCFunctionRangeMap.h"
+#include "llvm/MC/MCAnalysis/MCOpcodeClasses.h"
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
 #include <vector>
-#include "llvm/Object/ObjectiveCFile.h"
+#include "llvm/Object/MachOAddressSpaceMap.h"
+#include "llvm/Object/MachOUnwindInfo.h"
 #include "llvm/ADT/SetVector.h"
 
 namespace llvm {
@@ -34,6 +44,7 @@ class MCBasicBlock;
 class MCDisassembler;
 class MCFunction;
 class MCInstrAnalysis;
+class MCDecodedInst;
 class MCInst;
 class MCModule;
 class MCObjectSymbolizer;
@@ -54,6 +65,12 @@ public:
 
   MCModule *buildEmptyModule();
 
+  /// \brief Build an MCModule without functions, but find the function
+  /// ranges as buildModule does: nothing is decoded until createFunction is
+  /// called on each of them. This is meant for a client that translates each
+  /// function as soon as it is disassembled, and then frees it.
+  MCModule *buildLazyModule();
+
   typedef std::vector<uint64_t> AddressSetTy;
   /// \name Create a new MCFunction.
   MCFunction *createFunction(MCModule *Module, uint64_t BeginAddr,
@@ -70,17 +87,207 @@ public:
   /// \brief Set the symbolizer to use to get information on external functions.
   /// Note that this isn't used to do instruction-level symbolization (that is,
   /// plugged into MCDisassembler), but to symbolize function call targets.
-  void setSymbolizer(MCObjectSymbolizer *ObjectSymbolizer) {
-    MOS = ObjectSymbolizer;
+  /// Its lookup tables are all built here, for the threads of setNumJobs to
+  /// share it.
+  void setSymbolizer(MCObjectSymbolizer *ObjectSymbolizer);
+
+  /// \brief Set the number of threads used to disassemble the functions found
+  /// in stripped mode. Functions are still created in address order, and the
+  /// per-function results are merged deterministically, so the resulting
+  /// MCModule doesn't depend on \p Jobs.
+  /// Note that the MCDisassembler must then be safe to use concurrently.
+  void setNumJobs(unsigned Jobs) { NumJobs = Jobs ? Jobs : 1; }
+
+  /// \brief Predicate on function start addresses, see setFunctionFilter.
+  typedef std::function<bool(uint64_t BeginAddr)> FunctionFilterTy;
+
+  /// \brief Only disassemble, in stripped mode, the functions starting at an
+  /// address accepted by \p Filter. The others are left out of the module,
+  /// but still bound the regions of their neighbours.
+  void setFunctionFilter(FunctionFilterTy Filter) {
+    FunctionFilter = std::move(Filter);
   }
 
-    AddressSetTy findFunctionStarts();
-    
-    // For evaluating outcome of the recursive disassembler
+  /// \brief Return true if the function at \p BeginAddr passes the filter.
+  bool isWantedFunction(uint64_t BeginAddr) const {
+    return !FunctionFilter || FunctionFilter(BeginAddr);
+  }
+
+  /// \brief Callback on the functions disassembled, see setFunctionCallback.
+  typedef std::function<void(const MCFunction &MCFN)> FunctionCallbackTy;
+
+  /// \brief Call \p Callback on each function disassembled, as soon as its
+  /// CFG is final, rather than once the whole module is built. With
+  /// setNumJobs, it is called by the threads, concurrently, in no particular
+  /// order. It isn't called on the external functions, which have no CFG.
+  void setFunctionCallback(FunctionCallbackTy Callback) {
+    FunctionCallback = std::move(Callback);
+  }
+
+  /// \brief Only disassemble, in stripped mode, the functions at \p Roots,
+  /// and the known functions they call, directly or not, up to \p MaxDepth
+  /// calls away from a root, or all of them if \p MaxDepth is negative.
+  /// The functions rejected by the filter are neither disassembled nor
+  /// followed. The slice is disassembled one call depth at a time, each
+  /// with the threads of setNumJobs.
+  void setReachableFrom(AddressSetTy Roots, int MaxDepth = -1) {
+    SliceRoots = std::move(Roots);
+    SliceMaxDepth = MaxDepth;
+  }
+
+  /// \brief Copy the functions accepted by \p Reuse from \p Prior, the
+  /// module of an earlier build of the same object, rather than disassembling
+  /// them again: \p Reuse tells the functions whose code didn't change since.
+  /// Only the functions built from the same range are copied. \p Prior must
+  /// outlive buildModule.
+  void setPriorModule(MCModule *Prior, FunctionFilterTy Reuse) {
+    PriorModule = Prior;
+    PriorFilter = std::move(Reuse);
+  }
+
+  /// \brief Read the function starts from LC_FUNCTION_STARTS, or, if the
+  /// object has none, use scanFunctionStarts. With setScanFunctionStarts,
+  /// both are merged. The starts of the unwind info ranges, and the function
+  /// symbols, are added to both.
+  AddressSetTy findFunctionStarts();
+
+  /// \brief Get the ends of the unwind info ranges, and of the function
+  /// symbols with a size, which are function ends, sorted: the functions are
+  /// bounded by them as well as by the next start.
+  AddressSetTy findFunctionEnds();
+
+  /// \brief A function symbol of the object, in a text section.
+  struct FunctionSymbol {
+    /// \brief The address, in the object, as opposed to the effective load
+    /// address of the symbolizer.
+    uint64_t Addr;
+    /// \brief The size, or 0 if the object doesn't tell, as in Mach-O.
+    uint64_t Size;
+    /// \brief The name, without the Mach-O global prefix.
+    StringRef Name;
+  };
+
+  /// \brief Get the function symbols of the object, indexed once by
+  /// address: one by address, the first of the symbol table.
+  ArrayRef<FunctionSymbol> getFunctionSymbols() const {
+    return FunctionSymbols;
+  }
+
+  /// \brief Get the name of the function at \p Addr: that of its symbol if
+  /// there is one, or "fn_<address>".
+  std::string getFunctionName(uint64_t Addr) const;
+
+  /// \brief Get the compact unwind info of the object, empty if it has none.
+  /// Its addresses are those of the object, as opposed to the effective
+  /// load addresses of the symbolizer.
+  const object::MachOUnwindInfo &getUnwindInfo() const { return UnwindInfo; }
+
+  /// \brief Get the compact unwind encoding of the function at \p Addr, or 0
+  /// if it is unknown.
+  uint32_t getUnwindEncoding(uint64_t Addr) const;
+
+  /// \brief Find the targets of the direct calls in the text sections,
+  /// outside of data in code and of the stubs, scanning the code with
+  /// MCInstrAnalysis::findDirectCallTargets rather than disassembling it,
+  /// and the entrypoint, with the symbolizer. They are sorted and unique, or
+  /// empty if the target can't be scanned.
+  AddressSetTy scanFunctionStarts();
+
+  /// \brief Add the direct call targets, from scanFunctionStarts, to the
+  /// function starts of LC_FUNCTION_STARTS, for the functions it misses.
+  void setScanFunctionStarts(bool Scan) { ScanFunctionStarts = Scan; }
+
+  /// \brief Use \p Starts as the function starts, in buildModule, instead of
+  /// reading them from the object with findFunctionStarts. This is meant for
+  /// code that isn't in an executable, as the fallback region.
+  void setFunctionStarts(AddressSetTy Starts) {
+    FunctionStarts = std::move(Starts);
+  }
+
+  /// \brief Get the function ranges used in stripped mode, built from
+  /// findFunctionStarts by buildModule.
+  const MCFunctionRangeMap &getFunctionRanges() const { return FunctionRanges; }
+
+  /// \brief Cost of the disassembly of one function, see
+  /// setRecordFunctionStats.
+  struct FunctionStats {
+    /// \brief Time spent in MCDisassembler::getInstruction.
+    double DecodeSeconds;
+    /// \brief Time spent walking the CFG, splitting and creating the blocks.
+    double CFGSeconds;
+    unsigned NumInsts;
+
+    FunctionStats() : DecodeSeconds(0), CFGSeconds(0), NumInsts(0) {}
+  };
+  typedef std::map<uint64_t, FunctionStats> FunctionStatsMapTy;
+
+  /// \brief Time the disassembly of each function created from now on.
+  /// This is off by default, as it reads the clock around each instruction.
+  void setRecordFunctionStats(bool Record) { RecordFunctionStats = Record; }
+
+  /// \brief Get the recorded disassembly costs, by function start address.
+  const FunctionStatsMapTy &getFunctionStats() const { return FuncStats; }
+
+  /// \brief Counters of the progress of buildModule. They are updated once
+  /// per function, and can be read by other threads while it runs.
+  struct Progress {
+    /// \brief Functions to disassemble. In a slice, this grows as the calls
+    /// are followed.
+    std::atomic<uint64_t> NumFunctions;
+    std::atomic<uint64_t> NumDoneFunctions;
+    /// \brief Instructions decoded in the functions done.
+    std::atomic<uint64_t> NumInsts;
+    /// \brief Of those, the instructions that were decoded for another
+    /// function sharing them, and reused.
+    std::atomic<uint64_t> NumSharedInsts;
+    /// \brief Functions copied from the prior module, see setPriorModule.
+    std::atomic<uint64_t> NumReusedFunctions;
+
+    Progress()
+        : NumFunctions(0), NumDoneFunctions(0), NumInsts(0),
+          NumSharedInsts(0), NumReusedFunctions(0) {}
+  };
+  const Progress &getProgress() const { return TheProgress; }
+
+  /// \brief A range of the text sections that isn't in any basic block.
+  struct CoverageGap {
+    enum KindTy {
+      /// \brief Declared data-in-code, or bytes that don't decode.
+      DataInCode,
+      /// \brief Only zeros and nops.
+      Padding,
+      /// \brief Decodable code, likely a function nothing was found to call.
+      MissedFunction
+    };
+    uint64_t BeginAddr;
+    uint64_t EndAddr;
+    KindTy Kind;
+    /// \brief For a MissedFunction, the first instruction past the padding.
+    uint64_t CodeAddr;
+
+    CoverageGap(uint64_t BeginAddr, uint64_t EndAddr)
+        : BeginAddr(BeginAddr), EndAddr(EndAddr), Kind(DataInCode),
+          CodeAddr(BeginAddr) {}
+  };
+  typedef std::vector<CoverageGap> CoverageGapListTy;
+
+  /// \brief Find the ranges of the text sections that are in none of the
+  /// basic blocks of \p Module, in address order, and classify them with a
+  /// linear sweep, using NumJobs threads.
+  /// \p Module doesn't need to have been built by this disassembler.
+  CoverageGapListTy findCoverageGaps(const MCModule &Module);
+
+  static const char *getCoverageGapKindName(CoverageGap::KindTy Kind);
     
-    SmallSetVector<uint64_t, 16> TextSegList;
-    SmallSetVector<uint64_t, 16> InstParsedList;
-    SmallSetVector<uint64_t, 16> NoneGeneralOperandList;
+    // For evaluating outcome of the recursive disassembler.
+    // The number of minimal instruction slots (4 bytes on ARM/AArch64, 1 byte
+    // elsewhere) of the text sections, and bitmaps over them. The sections
+    // of relocatable objects overlap, at address 0: the bitmaps only have one
+    // bit for the addresses of all of them.
+
+    uint64_t LinearCodeSize = 0;
+    MCAddressBitmap InstParsedList;
+    MCAddressBitmap NoneGeneralOperandList;
     
     unsigned int DisInstSize[8] = {0};
     
@@ -88,6 +295,8 @@ protected:
   const object::ObjectFile &Obj;
   const MCDisassembler &Dis;
   const MCInstrAnalysis &MIA;
+  /// \brief The classes of the opcodes of the target, from MIA.
+  const MCOpcodeClasses OpcodeClasses;
   MCObjectSymbolizer *MOS;
 
   struct MemoryRegion {
@@ -101,16 +310,110 @@ protected:
   /// \brief The fallback memory region, outside the object file.
   MemoryRegion FallbackRegion;
 
+  /// \brief A range of data in a text section, from LC_DATA_IN_CODE, as
+  /// [begin, end) addresses.
+  typedef std::pair<uint64_t, uint64_t> DataInCodeRange;
+  /// \brief The data-in-code ranges, sorted by address. They don't overlap.
+  std::vector<DataInCodeRange> DataInCodeRanges;
+
   std::vector<MemoryRegion> SectionRegions;
+  /// \brief The other sections with contents, sorted by address, read for
+  /// jump tables.
+  std::vector<MemoryRegion> DataRegions;
 
   /// \brief Return a memory region suitable for reading starting at \p Addr.
   /// In most cases, this returns an ArrayRef backed by the
   /// containing section. When no section was found, this returns the
   /// FallbackRegion, if it is suitable.
   /// If it is not, or if there is no fallback region, this an empty region.
-  const MemoryRegion &getRegionFor(uint64_t Addr);
+  /// In stripped mode, the region stops at the next known function start.
+  /// The region stops at the next data-in-code range, and is empty in one.
+  /// Regions are returned by value, and only reference the section contents.
+  MemoryRegion getRegionFor(uint64_t Addr) const;
+
+  /// \brief Fill SectionRegions with the text sections, DataRegions
+  /// with the others, and DataInCodeRanges, if not done yet.
+  void collectSectionRegions();
+
+  /// \brief Find the data-in-code range containing \p Addr, or else the
+  /// first one after it, or null if there is none.
+  const DataInCodeRange *findDataInCode(uint64_t Addr) const;
+  bool isDataInCode(uint64_t Addr) const {
+    const DataInCodeRange *DI = findDataInCode(Addr);
+    return DI && DI->first <= Addr;
+  }
+
+  /// \brief Find the section region containing \p Addr, using a binary
+  /// search in the sorted SectionRegions, or null if there is none.
+  const MemoryRegion *findSectionRegion(uint64_t Addr) const;
+
+  /// \brief Read the \p Size bytes at \p Addr, in a text or data section, as
+  /// an integer of the byte order of the object.
+  /// \returns false if they aren't all in one section.
+  bool readSectionInt(uint64_t Addr, unsigned Size, uint64_t &Value) const;
 
 private:
+  /// \brief Coverage statistics gathered by disassembleFunctionAt, kept apart
+  /// from the evaluation lists so that functions can be disassembled
+  /// concurrently, and merged back in function order.
+  struct CoverageStats {
+    AddressSetTy ParsedInsts;
+    AddressSetTy NoneGeneralOperandInsts;
+    unsigned DisInstSize[8];
+    /// \brief Only filled when recording the function stats.
+    FunctionStats Cost;
+
+    CoverageStats() : DisInstSize() {}
+  };
+
+  /// \brief Add \p Stats, of the function at \p BeginAddr, to TextSegList
+  /// & co.
+  void mergeCoverageStats(uint64_t BeginAddr, const CoverageStats &Stats);
+
+  /// \brief Fill \p MCFN with the function at \p BeginAddr of the prior
+  /// module, if it can be reused, as disassembleFunctionAt would have.
+  /// \returns false if it can't.
+  bool copyPriorFunction(MCFunction *MCFN, uint64_t BeginAddr,
+                         AddressSetTy &CallTargets,
+                         AddressSetTy &TailCallTargets, CoverageStats &Stats);
+
+  /// \brief Call disassembleFunctionAt, timing it if RecordFunctionStats.
+  void disassembleFunction(MCModule *Module, MCFunction *MCFN,
+                           uint64_t BeginAddr, AddressSetTy &CallTargets,
+                           AddressSetTy &TailCallTargets, CoverageStats &Stats);
+
+  /// \brief Create and disassemble the functions at \p Addrs, using NumJobs
+  /// threads. The results are merged in the order of \p Addrs.
+  void buildFunctionsInParallel(MCModule *Module, ArrayRef<uint64_t> Addrs,
+                                AddressSetTy &CallTargets,
+                                AddressSetTy &TailCallTargets);
+
+  /// \brief Add to \p Targets the targets of the jump table that the indirect
+  /// branch ending \p Insts, at \p Addrs, branches through, if MIA finds
+  /// one. Only the targets in the function [\p FnBegin, \p FnEnd) are kept:
+  /// when the size of the table is unknown, it ends at the first entry
+  /// outside the function.
+  void findJumpTableTargets(ArrayRef<MCInst> Insts, ArrayRef<uint64_t> Addrs,
+                            uint64_t FnBegin, uint64_t FnEnd,
+                            AddressSetTy &Targets) const;
+
+  /// \brief Create and disassemble the functions reachable from SliceRoots.
+  void buildReachableFunctions(MCModule *Module, AddressSetTy &CallTargets,
+                               AddressSetTy &TailCallTargets);
+
+  /// \brief Get the data-in-code ranges of the object, sorted by address.
+  std::vector<std::pair<uint64_t, uint64_t>> getDataInCodeRanges() const;
+
+  /// \brief Set the kind of \p Gap with a linear sweep of its bytes. Gaps
+  /// overlapping one of the sorted \p DataInCode ranges are data.
+  void classifyCoverageGap(
+      CoverageGap &Gap,
+      ArrayRef<std::pair<uint64_t, uint64_t>> DataInCode) const;
+
+  /// \brief Return true if the \p Size bytes at \p Bytes are padding: zeros,
+  /// or a nop of the target.
+  bool isPadding(ArrayRef<uint8_t> Bytes, uint64_t Size) const;
+
   /// \brief Enrich \p Module with a CFG consisting of MCFunctions.
   /// \param Module An MCModule returned by buildModule, with no CFG.
   /// NOTE: Each MCBasicBlock in a MCFunction is backed by a single MCTextAtom.
@@ -118,15 +421,55 @@ private:
   /// single MCTextAtom will be split in multiple basic block atoms.
   void buildCFG(MCModule *Module);
 
+  /// \brief Find the function ranges of stripped mode, from the starts of
+  /// setFunctionStarts, or of the object.
+  void buildFunctionRanges();
+
   void disassembleFunctionAt(MCModule *Module, MCFunction *MCFN,
                              uint64_t BeginAddr, AddressSetTy &CallTargets,
-                             AddressSetTy &TailCallTargets);
+                             AddressSetTy &TailCallTargets,
+                             CoverageStats &Stats);
     bool checkBranch(MCInst &Inst, uint64_t Target);
 
+  /// \brief Get the instructions decoded for the block at \p Addr of a
+  /// function built before, if any.
+  ArrayRef<MCDecodedInst> findDecodedBlock(uint64_t Addr);
+  /// \brief Add the decoded instructions of blocks, by start address, for
+  /// the functions built after to reuse.
+  void addDecodedBlocks(
+      ArrayRef<std::pair<uint64_t, ArrayRef<MCDecodedInst>>> Blocks);
+
+
+  MCFunctionRangeMap FunctionRanges;
+  AddressSetTy FunctionStarts;
+  bool ScanFunctionStarts;
+  unsigned NumJobs;
+  FunctionFilterTy FunctionFilter;
+  FunctionCallbackTy FunctionCallback;
+  MCModule *PriorModule;
+  FunctionFilterTy PriorFilter;
+  AddressSetTy SliceRoots;
+  int SliceMaxDepth;
+  bool RecordFunctionStats;
+  FunctionStatsMapTy FuncStats;
+  Progress TheProgress;
+  /// \brief The decoded instructions of the blocks of the functions built
+  /// so far, by block start address. Functions sharing code, as tails, reuse
+  /// them instead of decoding it again. They are slices of the instructions
+  /// of the functions, as decoded, without the tail call rewrites. They are
+  /// only kept during buildCFG: the functions may free their instructions
+  /// after.
+  DenseMap<uint64_t, ArrayRef<MCDecodedInst>> DecodedBlocks;
+  std::mutex DecodedBlocksLock;
+  bool ShareDecodedBlocks;
+  /// \brief Section kinds of the Mach-O object, used to classify branches.
+  std::unique_ptr<object::MachOAddressSpaceMap> AddrSpace;
+  /// \brief The function ranges of __unwind_info, parsed once.
+  object::MachOUnwindInfo UnwindInfo;
+  /// \brief The function symbols, sorted by address.
+  std::vector<FunctionSymbol> FunctionSymbols;
 
-    AddressSetTy FunctionStarts;
-  bool Stripped;
-    std::unique_ptr<ObjectiveCFile> ObjCFile;
+  void buildFunctionSymbols();
 };
 
 }
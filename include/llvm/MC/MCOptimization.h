@@ -1,4 +1,4 @@
-//===-- llvm/MC/MCObjectDisassembler.h --------------------------*- C++ -*-===//
+//===-- llvm/MC/MCOptimization.h --------------------------------*- C++ -*-===//
 //
 //                     The LLVM Compiler Infrastructure
 //
@@ -7,149 +7,117 @@
 //
 //===----------------------------------------------------------------------===//
 //
-// This file contains the declaration of the MCObjectDisassembler class, which
-// can be used to construct an MCModule and an MC CFG from an ObjectFile.
+// This file contains the declaration of the MCOptimization class, a small
+// pass manager running MCPeephole rewrites over the functions of an MCModule,
+// to shrink the instruction stream before it is translated to IR.
 //
 //===----------------------------------------------------------------------===//
 
 #ifndef LLVM_MC_MCOPTIMIZATION_H
 #define LLVM_MC_MCOPTIMIZATION_H
 
-#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
-#include "llvm/Support/DataTypes.h"
-#include "llvm/Object/ObjectFile.h"
-#include "llvm/MC/MCAsmInfo.h"
-#include "llvm/MC/MCAnalysis/MCCachingDisassembler.h"
 #include "llvm/MC/MCAnalysis/MCFunction.h"
 #include "llvm/MC/MCAnalysis/MCModule.h"
-#include "llvm/MC/MCAnalysis/MCObjectSymbolizer.h"
-#include "llvm/MC/MCContext.h"
-#include "llvm/MC/MCDisassembler.h"
 #include "llvm/MC/MCInst.h"
-#include "llvm/MC/MCInstBuilder.h"
-#include "llvm/MC/MCInstPrinter.h"
-#include "llvm/MC/MCInstrAnalysis.h"
 #include "llvm/MC/MCInstrInfo.h"
-#include "llvm/MC/MCObjectDisassembler.h"
-#include "llvm/MC/MCObjectFileInfo.h"
 #include "llvm/MC/MCRegisterInfo.h"
-#include "llvm/MC/MCSubtargetInfo.h"
+#include "llvm/Object/MachO.h"
+#include "llvm/Object/MachOAddressSpaceMap.h"
+#include "llvm/Support/DataTypes.h"
+#include <memory>
 #include <vector>
-#include "llvm/Object/ObjectiveCFile.h"
-
-extern "C" {
-  unsigned AArch64GetOpcodeType(unsigned); 
-}
 
 namespace llvm {
-  
-/// \brief Disassemble an ObjectFile to an MCModule and MCFunctions.
-/// This class builds on MCDisassembler to create a control flow graph
-/// consisting of MCFunctions and MCBasicBlocks.
+
+class raw_ostream;
+class MCOptimization;
+
+/// \brief A rewrite of the instructions of an MCFunction.
+/// Peepholes are run concurrently on different functions: runOnFunction must
+/// only modify the function it is given.
+class MCPeephole {
+public:
+  virtual ~MCPeephole();
+
+  virtual const char *getName() const = 0;
+
+  /// \brief Rewrite the instructions of \p F in place.
+  /// \returns the number of rewrites.
+  virtual unsigned runOnFunction(MCFunction &F) const = 0;
+};
+
+/// \brief The AArch64 Mach-O peepholes, in the order they should run.
+/// ARC elimination, selector propagation and canary stripping replace
+/// instructions by nops, which NOP removal then erases.
+std::unique_ptr<MCPeephole>
+createARCEliminationPeephole(const MCOptimization &);
+std::unique_ptr<MCPeephole>
+createSelectorPropagationPeephole(const MCOptimization &);
+std::unique_ptr<MCPeephole>
+createStackCanaryStrippingPeephole(const MCOptimization &);
+std::unique_ptr<MCPeephole> createNopRemovalPeephole(const MCOptimization &);
+
+/// \brief Run MCPeepholes over the functions of an MCModule, disassembled
+/// from an AArch64 Mach-O file.
+/// Opcodes and registers are found by name, and stubs by index: the
+/// peepholes get them from here.
 class MCOptimization {
-    #define OP_BL 125
-    #define OP_BR 127
-  
-private: 
-  /*
-    current important value
-   */
   MCModule* cur_module;
   llvm::object::MachOObjectFile* cur_file;
-  //llvm::object::SectionRef* stub_section; 
-  uint64_t stub_section_add;
-  uint64_t stub_section_size;
-  struct machO_sym_table{
-    uint32_t str_index;
-    uint32_t pad;
-    uint64_t value;
+  // section kinds of cur_file, used to find the stub a call goes through
+  llvm::object::MachOAddressSpaceMap address_space;
+  // the symbol each stub goes through, by stub index
+  std::vector<StringRef> stub_names;
+  StringMap<unsigned> opcodes_by_name;
+  StringMap<unsigned> regs_by_name;
+
+  struct PeepholeInfo {
+    std::unique_ptr<MCPeephole> P;
+    uint64_t NumRewrites;
+    double WallTime;
   };
-  uint64_t* sym_name_add;
-  uint32_t sym_size;
-  
-  uint32_t NoneSemanticARC;
-  uint32_t SemanticARC;
+  std::vector<PeepholeInfo> peepholes;
 
-  const char* objc_release_str = "_objc_release";
-  
-  std::list<std::string> NoneSideEffectAPI =
-    {
-/*
- https://clang.llvm.org/docs/AutomaticReferenceCounting.html
- 
- id objc_autorelease(id value);
- void objc_autoreleasePoolPop(void *pool);
- void *objc_autoreleasePoolPush(void);
- id objc_autoreleaseReturnValue(id value);
- void objc_copyWeak(id *dest, id *src); x
- void objc_destroyWeak(id *object);
- id objc_initWeak(id *object, id value);
- id objc_loadWeak(id *object);
- id objc_loadWeakRetained(id *object);
- void objc_moveWeak(id *dest, id *src);
- void objc_release(id value);
- id objc_retain(id value);
- id objc_retainAutorelease(id value);
- id objc_retainAutoreleaseReturnValue(id value);
- id objc_retainAutoreleasedReturnValue(id value);
- id objc_retainBlock(id value);
- void objc_storeStrong(id *object, id value);
- id objc_storeWeak(id *object, id value);
- 
- */
-// for these explicitly state as `Always returns value'
-        "_objc_autorelease",
-        "_objc_autoreleaseReturnValue",
-        "_objc_retain",
-        "_objc_retainAutorelease",
-        "_objc_retainAutoreleaseReturnValue",
-        "_objc_retainAutoreleasedReturnValue",
+  void analyze_macho_file_for_dynamic_symbol_name(llvm::object::MachOObjectFile*);
+public:
+  MCOptimization(MCModule* target_module, llvm::object::MachOObjectFile* target_obj_file,
+                 const MCInstrInfo &MII, const MCRegisterInfo &MRI);
+  ~MCOptimization();
 
-// for those remainings that take 1 arguments.
-        "_objc_release",
-        "_objc_destroyWeak",
-        "_objc_autoreleasePoolPush",
-        "_objc_autoreleasePoolPop"
-            
-    };
-    std::list<std::string> MoveX1ToX0Call = {
-      "_objc_copyWeak",
-      "_objc_moveWeak"
-    };
+  /// \brief Add \p P, to run after the peepholes already added.
+  void addPeephole(std::unique_ptr<MCPeephole> P);
+  /// \brief Add all the create*Peephole peepholes above.
+  void addDefaultPeepholes();
 
-    std::list<std::string> StrX1ToX0ADDCall = {
-      "_objc_storeStrong",
-      "_objc_storeWeak",
-      "_objc_initWeak"
-    };
+  // run all peepholes, one after the other, each on all functions, using
+  // NumJobs threads: functions are independent
+  void try_to_optimize(unsigned NumJobs = 1);
 
-    std::list<std::string> LDRX0ADDToX0Call = { // later  i'll add comment for different code;
-      "_objc_loadWeak",
-      "_objc_loadWeakRetained"
-    };
+  /// \brief Print the number of rewrites and the time spent in each peephole.
+  void printStatistics(raw_ostream &OS) const;
 
-  
-    
-  const uint64_t stub_item_size = 0xC;
-  /*
-  
-   */
-  void analyze_macho_file_for_dynamic_symbol_name(llvm::object::MachOObjectFile*);
-  void optimize_func_code(MCFunction*);
-  char* get_called_func_name(uint64_t);
-public:
-  MCOptimization(MCModule* target_module, llvm::object::MachOObjectFile* target_obj_file){
-    cur_module = target_module;
-    cur_file = target_obj_file;
-    NoneSemanticARC = 0;
-      SemanticARC = 0;
-    analyze_macho_file_for_dynamic_symbol_name(cur_file);
+  /// \name Helpers for the peepholes.
+  /// @{
+  llvm::object::MachOObjectFile &getFile() const { return *cur_file; }
+  const llvm::object::MachOAddressSpaceMap &getAddressSpace() const {
+    return address_space;
   }
-  void try_to_optimize();
-  uint64_t getNoneSemanticARCCount() const;
-  uint64_t getSemanticARCCount() const;
-
+  /// \brief Get the opcode named \p Name, or 0 if there is none.
+  unsigned getOpcode(StringRef Name) const { return opcodes_by_name.lookup(Name); }
+  /// \brief Get the register named \p Name, or 0 (NoRegister).
+  unsigned getReg(StringRef Name) const { return regs_by_name.lookup(Name); }
+  /// \brief Get the symbol of the stub at \p Addr, or an empty string if
+  /// \p Addr isn't a stub.
+  StringRef getStubName(uint64_t Addr) const;
+  size_t getNumStubs() const { return stub_names.size(); }
+  StringRef getStubNameByIndex(size_t Index) const { return stub_names[Index]; }
+  /// \brief Compute the index of the stub at \p Addr, in \p Index.
+  bool getStubIndex(uint64_t Addr, uint64_t &Index) const {
+    return address_space.getStubIndex(Addr, Index) && Index < stub_names.size();
+  }
+  /// @}
 };
 }
 #endif
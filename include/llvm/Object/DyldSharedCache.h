@@ -0,0 +1,113 @@
+//===- DyldSharedCache.h - Images of a dyld shared cache --------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares the DyldSharedCache class, a view of the images of a
+// dyld shared cache, the file the system frameworks are prelinked into.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_OBJECT_DYLDSHAREDCACHE_H
+#define LLVM_OBJECT_DYLDSHAREDCACHE_H
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/ErrorOr.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace llvm {
+namespace object {
+
+class MachOObjectFile;
+
+/// \brief The images of a dyld shared cache, in place.
+///
+/// The images are MachOObjectFiles over the whole cache, with their header
+/// where the cache has it: their load commands already use the offsets of
+/// the cache, so nothing is copied. The pointers of the cache are read as the
+/// slide info of the cache encodes them, and the exported symbols of all the
+/// images can be looked up by address, to name the functions of another image
+/// that stubs jump to.
+///
+/// Only caches in a single file are handled: the images of the subcaches of
+/// the recent caches aren't mapped by the main file, and can't be created.
+class DyldSharedCache {
+public:
+  struct Image {
+    uint64_t Address;
+    /// \brief The install name of the image, in the cache.
+    StringRef Path;
+  };
+
+private:
+  struct Mapping {
+    uint64_t Address;
+    uint64_t Size;
+    uint64_t FileOffset;
+  };
+
+  MemoryBufferRef Buffer;
+  std::vector<Mapping> Mappings;
+  std::vector<Image> Images;
+  /// \brief The version of the slide info, 0 if there's none this handles.
+  uint32_t SlideVersion;
+  uint64_t DeltaMask;
+  uint64_t ValueAdd;
+
+  /// \brief The exported symbols of all the images, sorted by address, built
+  /// on the first lookup.
+  mutable std::vector<std::pair<uint64_t, StringRef>> Symbols;
+  mutable std::once_flag SymbolsBuilt;
+
+  explicit DyldSharedCache(MemoryBufferRef Buffer);
+  std::error_code parse();
+  void buildSymbols() const;
+
+public:
+  /// \brief Whether \p Buffer starts like a dyld shared cache.
+  static bool isDyldSharedCache(StringRef Buffer);
+
+  /// \brief Parse the header of the cache in \p Buffer, which must outlive
+  /// it.
+  static ErrorOr<std::unique_ptr<DyldSharedCache>>
+  create(MemoryBufferRef Buffer);
+
+  ArrayRef<Image> images() const { return Images; }
+
+  /// \brief Find the image installed at \p Path, or, failing that, the single
+  /// one named \p Path, as "UIKit" for the UIKit framework. Return null if
+  /// there's none.
+  const Image *findImage(StringRef Path) const;
+
+  /// \brief The Mach-O of \p I, over the buffer of the cache.
+  ErrorOr<std::unique_ptr<MachOObjectFile>>
+  createImageObject(const Image &I) const;
+
+  /// \brief Compute the offset in the cache file of \p Addr, in \p Offset.
+  /// \returns false if no mapping of this file has \p Addr.
+  bool getFileOffset(uint64_t Addr, uint64_t &Offset) const;
+
+  /// \brief Read the pointer at \p Addr into \p Value, as dyld would slide
+  /// it, with no slide: the address it points to. Return false if \p Addr
+  /// isn't in the cache.
+  bool readPointer(uint64_t Addr, uint64_t &Value) const;
+
+  /// \brief The name of the symbol an image exports at \p Addr, or an empty
+  /// string if there's none. The first lookup reads the symbol tables of all
+  /// the images.
+  StringRef findSymbolAt(uint64_t Addr) const;
+};
+
+} // end namespace object
+} // end namespace llvm
+
+#endif
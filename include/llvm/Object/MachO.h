@@ -193,8 +193,11 @@ public:
   typedef SmallVector<LoadCommandInfo, 4> LoadCommandList;
   typedef LoadCommandList::const_iterator load_command_iterator;
 
+  /// \brief Parse the Mach-O at \p HeaderOffset in \p Object. The offsets of
+  /// the load commands are still relative to the start of \p Object, as in
+  /// the images of a dyld shared cache.
   MachOObjectFile(MemoryBufferRef Object, bool IsLittleEndian, bool Is64Bits,
-                  std::error_code &EC);
+                  std::error_code &EC, uint64_t HeaderOffset = 0);
 
   void moveSymbolNext(DataRefImpl &Symb) const override;
 
@@ -418,6 +421,9 @@ public:
 
   bool hasPageZeroSegment() const { return HasPageZeroSegment; }
 
+  /// \brief The offset of the mach header in the buffer.
+  uint64_t getHeaderOffset() const { return HeaderOffset; }
+
   static bool classof(const Binary *v) {
     return v->isMachO();
   }
@@ -452,6 +458,7 @@ private:
   typedef SmallVector<const char*, 1> LibraryList;
   LibraryList Libraries;
   LoadCommandList LoadCommands;
+  uint64_t HeaderOffset;
   typedef SmallVector<StringRef, 1> LibraryShortName;
   mutable LibraryShortName LibrariesShortNames;
   const char *SymtabLoadCmd;
@@ -0,0 +1,92 @@
+//===- MachOAddressSpaceMap.h - Mach-O section kind lookup ------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares the MachOAddressSpaceMap class, a one-time classification
+// of the address space of a Mach-O image into section kinds.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_OBJECT_MACHOADDRESSSPACEMAP_H
+#define LLVM_OBJECT_MACHOADDRESSSPACEMAP_H
+
+#include "llvm/Support/DataTypes.h"
+#include <vector>
+
+namespace llvm {
+namespace object {
+
+class MachOObjectFile;
+
+/// \brief Classify the addresses of a Mach-O image by the kind of section
+/// they belong to, without walking the section list on every query.
+/// Addresses are the original (unslid) virtual addresses.
+class MachOAddressSpaceMap {
+public:
+  enum SectionKind {
+    SK_Unknown,          ///< Not in any section.
+    SK_Text,             ///< __TEXT,__text, or any other code section.
+    SK_Stubs,            ///< __TEXT,__stubs
+    SK_StubHelper,       ///< __TEXT,__stub_helper
+    SK_CString,          ///< __TEXT,__cstring
+    SK_ObjCMethName,     ///< __TEXT,__objc_methname
+    SK_ObjCConst,        ///< __DATA,__objc_const
+    SK_ObjCClassRefs,    ///< __DATA,__objc_classrefs
+    SK_ObjCSelRefs,      ///< __DATA,__objc_selrefs
+    SK_LazySymbolPtr,    ///< __DATA,__la_symbol_ptr
+    SK_NonLazySymbolPtr, ///< __DATA,__nl_symbol_ptr and __DATA,__got
+    SK_Other             ///< Any other section.
+  };
+
+  struct Range {
+    uint64_t Start;
+    uint64_t End;
+    SectionKind Kind;
+    /// \brief The section's reserved1 (indirect symbol table index) and
+    /// reserved2 (stub size) fields.
+    uint32_t Reserved1;
+    uint32_t Reserved2;
+  };
+
+  explicit MachOAddressSpaceMap(const MachOObjectFile &MachO);
+
+  /// \brief Find the section range containing \p Addr, or null.
+  const Range *findRange(uint64_t Addr) const;
+
+  SectionKind getKind(uint64_t Addr) const {
+    const Range *R = findRange(Addr);
+    return R ? R->Kind : SK_Unknown;
+  }
+
+  /// \brief Return the __stubs range, or null if there is none.
+  const Range *getStubs() const { return HasStubs ? &Stubs : nullptr; }
+
+  bool isStub(uint64_t Addr) const {
+    return HasStubs && Stubs.Start <= Addr && Addr < Stubs.End;
+  }
+
+  /// \brief Compute the index of the stub containing \p Addr, in \p Index.
+  /// \returns false if \p Addr isn't in __stubs.
+  bool getStubIndex(uint64_t Addr, uint64_t &Index) const {
+    if (!isStub(Addr) || !Stubs.Reserved2)
+      return false;
+    Index = (Addr - Stubs.Start) / Stubs.Reserved2;
+    return Index < (Stubs.End - Stubs.Start) / Stubs.Reserved2;
+  }
+
+private:
+  /// \brief Section ranges, sorted by start address.
+  std::vector<Range> Ranges;
+  bool HasStubs;
+  Range Stubs;
+};
+
+} // end namespace object
+} // end namespace llvm
+
+#endif
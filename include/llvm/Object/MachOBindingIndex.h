@@ -0,0 +1,97 @@
+//===- MachOBindingIndex.h - Mach-O dyld binding lookup ---------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares the MachOBindingIndex class, the dyld bind, weak-bind and
+// lazy-bind opcodes of a Mach-O image, or its chained fixups, decoded once
+// into an address-sorted table.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_OBJECT_MACHOBINDINGINDEX_H
+#define LLVM_OBJECT_MACHOBINDINGINDEX_H
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Object/MachO.h"
+#include "llvm/Support/DataTypes.h"
+#include <vector>
+
+namespace llvm {
+namespace object {
+
+/// \brief Find the symbol dyld binds to a given address, without interpreting
+/// the binding opcodes on every query.
+/// Addresses are the original (unslid) virtual addresses.
+///
+/// The images with chained fixups (LC_DYLD_CHAINED_FIXUPS) have no binding
+/// opcodes: their pointers are chained through each page of the data
+/// segments, and encode the rebase or the bind of each. The chains are
+/// walked once: the binds are regular bindings, and the value of each chained
+/// pointer is kept, for the readers of the data to see what they would
+/// without chained fixups, see applyChainedFixups. The arm64e images that
+/// predate chained fixups chain their pointers the same way, from threaded
+/// bind opcodes, and are decoded as if they had chained fixups.
+class MachOBindingIndex {
+public:
+  struct Binding {
+    uint64_t Address;
+    /// \brief The symbol name, pointing into the image's binding opcodes, or
+    /// its chained fixups imports.
+    StringRef SymbolName;
+    int64_t Addend;
+    int Ordinal;
+    MachOBindEntry::Kind Kind;
+  };
+
+  explicit MachOBindingIndex(const MachOObjectFile &MachO);
+
+  /// \brief Find the binding of kind \p K at \p Addr, or null.
+  /// If the opcodes bind \p Addr several times, return the first binding.
+  const Binding *find(uint64_t Addr, MachOBindEntry::Kind K) const;
+
+  /// \brief Return the name of the symbol bound at \p Addr with kind \p K,
+  /// or an empty string.
+  StringRef getSymbolName(uint64_t Addr, MachOBindEntry::Kind K) const {
+    const Binding *B = find(Addr, K);
+    return B ? B->SymbolName : StringRef();
+  }
+
+  size_t size() const { return Bindings.size(); }
+  bool empty() const { return Bindings.empty(); }
+
+  /// \brief Whether the image has chained fixups, in a supported format.
+  bool hasChainedFixups() const { return !ChainedValues.empty(); }
+
+  /// \brief Get in \p Value the value the chained pointer at \p Addr would
+  /// have without chained fixups: the unslid target of a rebase, or 0 for a
+  /// bind. Return false if there is no chained pointer at \p Addr.
+  bool getChainedValue(uint64_t Addr, uint64_t &Value) const;
+
+  /// \brief Replace the chained pointers in \p Bytes, the contents at
+  /// \p Addr, with their value, see getChainedValue.
+  void applyChainedFixups(uint64_t Addr, MutableArrayRef<uint8_t> Bytes) const;
+
+private:
+  /// \brief Bindings, sorted by address and kind, then in opcode order.
+  std::vector<Binding> Bindings;
+  /// \brief The values of the chained pointers, sorted by address.
+  std::vector<std::pair<uint64_t, uint64_t>> ChainedValues;
+
+  void addChainedFixups(const MachOObjectFile &MachO,
+                        ArrayRef<uint64_t> SegmentAddrs,
+                        ArrayRef<uint64_t> SegmentOffsets, uint64_t ImageBase);
+  void addThreadedBinds(const MachOObjectFile &MachO,
+                        ArrayRef<uint64_t> SegmentAddrs,
+                        ArrayRef<uint64_t> SegmentOffsets, uint64_t ImageBase);
+};
+
+} // end namespace object
+} // end namespace llvm
+
+#endif
@@ -0,0 +1,79 @@
+//===- MachOStringSection.h - Mach-O C string section index -----*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares the MachOStringSection class, the strings of a section of
+// C strings (__cstring, __objc_methname, __objc_classname), delimited once so
+// that looking one up doesn't scan it.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_OBJECT_MACHOSTRINGSECTION_H
+#define LLVM_OBJECT_MACHOSTRINGSECTION_H
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/DataTypes.h"
+#include <vector>
+
+namespace llvm {
+namespace object {
+
+/// \brief The NUL-terminated strings of a section, found in a single pass over
+/// its contents.
+/// The strings point into the contents: nothing is copied. An address may be
+/// in the middle of a string, since the linker merges the strings that are
+/// the suffix of another one.
+class MachOStringSection {
+public:
+  struct Entry {
+    uint64_t Address;
+    StringRef String;
+  };
+
+  MachOStringSection() : Address(0) {}
+  /// \brief Delimit the strings of \p Contents, loaded at \p Address.
+  MachOStringSection(uint64_t Address, StringRef Contents);
+
+  uint64_t getAddress() const { return Address; }
+  StringRef getContents() const { return Contents; }
+  bool contains(uint64_t Addr) const {
+    return Addr >= Address && Addr - Address < Contents.size();
+  }
+
+  /// \brief Return the string at \p Addr, up to its terminator, or to the end
+  /// of the section if it has none. It is empty if \p Addr is outside of the
+  /// section, or on a terminator.
+  StringRef getString(uint64_t Addr) const;
+
+  /// \brief The non-empty strings, by address.
+  size_t size() const { return Strings.size(); }
+  bool empty() const { return Strings.empty(); }
+  Entry operator[](size_t I) const {
+    Entry E;
+    E.Address = Address + Strings[I].Begin;
+    E.String = Contents.slice(Strings[I].Begin, Strings[I].End);
+    return E;
+  }
+
+private:
+  struct Range {
+    uint32_t Begin;
+    uint32_t End;
+  };
+
+  uint64_t Address;
+  StringRef Contents;
+  /// \brief The offsets of the non-empty strings in Contents, sorted. End is
+  /// that of the terminator.
+  std::vector<Range> Strings;
+};
+
+} // end namespace object
+} // end namespace llvm
+
+#endif
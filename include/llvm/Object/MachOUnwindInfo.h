@@ -0,0 +1,100 @@
+//===- MachOUnwindInfo.h - Mach-O compact unwind info index -----*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares the MachOUnwindInfo class, the function ranges of the
+// __TEXT,__unwind_info section of a linked Mach-O image, with their compact
+// unwind encodings, parsed once into a sorted table.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_OBJECT_MACHOUNWINDINFO_H
+#define LLVM_OBJECT_MACHOUNWINDINFO_H
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/Triple.h"
+#include "llvm/Support/DataTypes.h"
+#include <vector>
+
+namespace llvm {
+namespace object {
+
+class MachOObjectFile;
+
+/// \brief The ranges of the compact unwind info of an image.
+/// The linker describes each function, from its start to the start of the
+/// next one, with a 32-bit encoding of its frame, and folds the consecutive
+/// functions with the same encoding in one range: the start of a range is
+/// always that of a function, but a range may span several functions. The
+/// end of the last range is that of the last function.
+class MachOUnwindInfo {
+public:
+  struct Entry {
+    uint64_t BeginAddr;
+    uint64_t EndAddr;
+    uint32_t Encoding;
+  };
+
+  /// \brief The kind of frame of an encoding.
+  enum FrameKind {
+    /// No encoding, or one of another architecture.
+    UnknownFrame,
+    /// The function doesn't set up a frame pointer: the stack pointer is
+    /// adjusted by a constant, and the saved registers are above it.
+    FramelessFrame,
+    /// The function sets up a frame pointer, and saves the registers below.
+    PointerFrame,
+    /// The frame is described in __eh_frame instead.
+    DwarfFrame
+  };
+
+  MachOUnwindInfo() : Arch(Triple::UnknownArch) {}
+  /// \brief Parse \p Contents, an __unwind_info section of an image of
+  /// \p Arch whose __TEXT segment is at \p TextAddr. If it is malformed, or
+  /// of a version other than 1, the table is empty.
+  MachOUnwindInfo(StringRef Contents, uint64_t TextAddr,
+                  Triple::ArchType Arch);
+
+  /// \brief Parse the __unwind_info section of \p Obj, if it has one.
+  static MachOUnwindInfo create(const MachOObjectFile &Obj);
+
+  Triple::ArchType getArch() const { return Arch; }
+
+  /// \brief The ranges, sorted by address.
+  typedef std::vector<Entry>::const_iterator const_iterator;
+  const_iterator begin() const { return Entries.begin(); }
+  const_iterator end() const { return Entries.end(); }
+  size_t size() const { return Entries.size(); }
+  bool empty() const { return Entries.empty(); }
+
+  /// \brief Find the range containing \p Addr, or null.
+  const Entry *find(uint64_t Addr) const;
+
+  /// \name Decoding of the encodings, which depends on the architecture.
+  /// @{
+  static FrameKind getFrameKind(Triple::ArchType Arch, uint32_t Encoding);
+  /// \brief Return the number of callee-saved registers the encoding
+  /// restores, or -1 if it doesn't tell, as for the DWARF frames.
+  static int getNumSavedRegs(Triple::ArchType Arch, uint32_t Encoding);
+  /// \brief Whether the function saves no register and sets up no frame
+  /// pointer: it has no spills of the callee-saved registers to look for.
+  static bool isFramelessLeaf(Triple::ArchType Arch, uint32_t Encoding) {
+    return getFrameKind(Arch, Encoding) == FramelessFrame &&
+           getNumSavedRegs(Arch, Encoding) == 0;
+  }
+  /// @}
+
+private:
+  Triple::ArchType Arch;
+  std::vector<Entry> Entries;
+};
+
+} // end namespace object
+} // end namespace llvm
+
+#endif
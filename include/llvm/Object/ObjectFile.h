@@ -296,7 +296,7 @@ public:
   createELFObjectFile(MemoryBufferRef Object);
 
   static ErrorOr<std::unique_ptr<MachOObjectFile>>
-  createMachOObjectFile(MemoryBufferRef Object);
+  createMachOObjectFile(MemoryBufferRef Object, uint64_t HeaderOffset = 0);
 };
 
 // Inline function definitions.
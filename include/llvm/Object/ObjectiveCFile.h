@@ -1,17 +1,33 @@
 #ifndef LLVM_OBJECTIVECFILE_H
 #define LLVM_OBJECTIVECFILE_H
 
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/Object/MachO.h"
+#include "llvm/Object/MachOBindingIndex.h"
+#include "llvm/Object/MachOStringSection.h"
+#include "llvm/Support/Allocator.h"
+#include "llvm/Support/StringSaver.h"
 
-#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace llvm {
 
     class ObjectiveCFile {
     public:
-        ObjectiveCFile(object::MachOObjectFile *MachO) : MachO(MachO) {
-            resolveMethods();
+        /// \brief Give access to the methods of \p MachO. Class names that are
+        /// only known from binding info are looked up in \p Binds, or, if null,
+        /// in an index of the bindings of \p MachO built for this file.
+        /// The Objective-C metadata is only read on the first query.
+        ObjectiveCFile(object::MachOObjectFile *MachO,
+                       const object::MachOBindingIndex *Binds = nullptr)
+            : MachO(MachO), Binds(Binds), Resolved(false), NameSaver(NameAlloc) {
+            if (!Binds) {
+                OwnedBinds.reset(new object::MachOBindingIndex(*MachO));
+                this->Binds = OwnedBinds.get();
+            }
         };
 
         struct ObjcClass_t {
@@ -27,11 +43,49 @@ namespace llvm {
         };
         typedef struct ObjcMethod_t ObjcMethod_t;
 
-        std::map<uint64_t, std::string> getFunctionNames() {
-            return FunctionNames;
-        };
-        std::string getFunctionName(uint64_t Address) {
-            return FunctionNames[Address];
+        /// \brief The methods, sorted by implementation address. The class and
+        /// method names point into the mapped object file.
+        const std::vector<ObjcMethod_t> &getMethods() const {
+            ensureResolved();
+            return Methods;
+        }
+        /// \brief Return the name of the method implemented at \p Address,
+        /// "-[Class selector]" or "+[Class selector]", or an empty string.
+        /// Names are only built for the addresses asked for.
+        StringRef getFunctionName(uint64_t Address) const;
+        /// \brief Build the name of \p M, as getFunctionName does, without
+        /// keeping it.
+        static std::string getMethodName(const ObjcMethod_t &M);
+
+        /// \brief The selector references (__objc_selrefs), by address, with
+        /// the name of the selector each points to.
+        std::vector<std::pair<uint64_t, StringRef>> getSelectorRefs() const;
+        /// \brief The class references (__objc_classrefs), by address, with
+        /// the name of the class each points to: one of the classes of the
+        /// file, or one bound by the dynamic linker.
+        std::vector<std::pair<uint64_t, StringRef>> getClassRefs() const;
+
+        /// \brief The strings of __objc_methname, __objc_classname and
+        /// __cstring, where the names of the Swift classes are. They point
+        /// into the mapped object file.
+        const object::MachOStringSection &getMethodNameStrings() const {
+            ensureResolved();
+            return ObjcMethodnames;
+        }
+        const object::MachOStringSection &getClassNameStrings() const {
+            ensureResolved();
+            return ObjcClassnames;
+        }
+        const object::MachOStringSection &getCStrings() const {
+            ensureResolved();
+            return cStrings;
+        }
+        /// \brief The pointers of the metadata to these strings: the selector
+        /// references, the class and method names, and the CFStrings, as
+        /// (pointer address, string address) pairs sorted by string address.
+        const std::vector<std::pair<uint64_t, uint64_t>> &getStringXRefs() const {
+            ensureResolved();
+            return StringXRefs;
         }
     private:
         struct ObjcDataStruct_t {
@@ -79,6 +133,8 @@ namespace llvm {
 
 
         object::MachOObjectFile *MachO;
+        const object::MachOBindingIndex *Binds;
+        std::unique_ptr<object::MachOBindingIndex> OwnedBinds;
 
         uint64_t ObjcClasslistAddress = 0;
         ArrayRef<uint8_t> ObjcClasslistData;
@@ -92,33 +148,64 @@ namespace llvm {
         uint64_t ObjcConstAddress = 0;
         ArrayRef<uint8_t> ObjcConstData;
 
-        uint64_t ObjcMethodnamesAddress = 0;
-        ArrayRef<uint8_t> ObjcMethodnamesData;
-
-        uint64_t ObjcClassnamesAddress = 0;
-        ArrayRef<uint8_t> ObjcClassnamesData;
-
+        object::MachOStringSection ObjcMethodnames;
+        object::MachOStringSection ObjcClassnames;
         //__cstring section strings ,to get Swift classname.
-        uint64_t cStringsAddress = 0;
-        ArrayRef<uint8_t> cStringsData;
+        object::MachOStringSection cStrings;
+
+        uint64_t CFStringsAddress = 0;
+        ArrayRef<uint8_t> CFStringsData;
 
         uint64_t ObjcCatlistAddress = 0;
         ArrayRef<uint8_t> ObjcCatlistData;
 
-        std::map<uint64_t, std::string> FunctionNames;
+        uint64_t ObjcSelrefsAddress = 0;
+        ArrayRef<uint8_t> ObjcSelrefsData;
+
+        uint64_t ObjcClassrefsAddress = 0;
+        ArrayRef<uint8_t> ObjcClassrefsData;
+
+        std::vector<std::pair<uint64_t, uint64_t>> StringXRefs;
+
+        // The names of the classes of the file, by address.
+        DenseMap<uint64_t, StringRef> ClassNames;
+
+        // Whether resolveMethods() ran. It only fills in caches, not visible
+        // outside: the queries are const. They can be made from several
+        // threads: the caches are filled under the lock.
+        mutable std::mutex Lock;
+        mutable bool Resolved;
+        std::vector<ObjcMethod_t> Methods;
+        // The copies of the sections, with chained fixups.
+        BumpPtrAllocator SectionAlloc;
+        // The names built by getFunctionName.
+        mutable BumpPtrAllocator NameAlloc;
+        mutable StringSaver NameSaver;
+        mutable DenseMap<uint64_t, StringRef> FunctionNames;
+
+        void ensureResolved() const {
+            std::lock_guard<std::mutex> L(Lock);
+            if (!Resolved)
+                const_cast<ObjectiveCFile *>(this)->resolveMethods();
+        }
+        void addMethod(uint64_t IMP, bool ClassMethod, StringRef ClassName,
+                       StringRef MethodName);
 
         void resolveMethods();
+        ArrayRef<uint8_t> getSectionData(const object::SectionRef &Section);
 
         void resolveMethods(ObjcClassInfoStruct_t *ClassInfo, bool ClassMethods, bool isSwiftClass);
         void resolveMethods(ObjcCatInfoStruct_t *CatInfo, bool ClassMethods, uint64_t CatInfoAddress, ObjcClassInfoStruct_t *ClassInfo, bool isSwiftClass);
 
-        StringRef getClassName(ArrayRef<uint8_t> &ObjcClassnames, uint64_t ObjcClassNamesAddress, uint64_t Address);
-        StringRef getClassName(ArrayRef<uint8_t> &cStrings, uint64_t cStringsAddress, uint64_t Address, bool isSwiftClass);
-        
-        StringRef getMethodName(ArrayRef<uint8_t> &ObjcMethodnames, uint64_t ObjcMethodnamesAddress, uint64_t Address);
+        StringRef getClassName(const ObjcClassInfoStruct_t *ClassInfo, bool isSwiftClass);
+        StringRef getMethodName(const ObjcMethodListEntry_t &Entry);
+        void resolveStringXRefs();
+        // The address of \p Field, within __objc_const.
+        uint64_t getConstAddress(const void *Field) const {
+            return ObjcConstAddress + ((const uint8_t*)Field - ObjcConstData.data());
+        }
 
         StringRef getClassName(uint64_t Pointer);
-        MachO::segment_command_64 getSegment(uint64_t SegmentNo);
     };
 
 }
@@ -0,0 +1,193 @@
+//===- SwiftMetadataIndex.h - Mach-O Swift metadata index -------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares the SwiftMetadataIndex class, the types, fields, vtables
+// and protocol conformances a Mach-O image describes in its Swift 5 metadata
+// sections (__swift5_types, __swift5_fieldmd and __swift5_proto), read once.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_OBJECT_SWIFTMETADATAINDEX_H
+#define LLVM_OBJECT_SWIFTMETADATAINDEX_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/DataTypes.h"
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace llvm {
+namespace object {
+
+class MachOObjectFile;
+
+/// \brief The Swift metadata of a Mach-O image, by address.
+/// The sections are lists of 32-bit pointers, relative to themselves, to the
+/// descriptors: they are all followed in a single pass, on the first query.
+/// Only the descriptors of the image are read: a protocol of another image,
+/// say, has a conformance but no requirements. Like the Objective-C metadata,
+/// absolute pointers are expected to be rebased already.
+class SwiftMetadataIndex {
+public:
+  /// \brief The kinds of methods of vtables and of protocol requirements.
+  enum MethodKind {
+    MK_Method,
+    MK_Init,
+    MK_Getter,
+    MK_Setter,
+    MK_ModifyCoroutine,
+    MK_ReadCoroutine,
+    MK_Other
+  };
+
+  struct Method {
+    /// \brief The method descriptor, where the class describes it.
+    uint64_t Descriptor;
+    /// \brief The implementation, or 0 if it isn't a function of the image.
+    uint64_t Impl;
+    MethodKind Kind;
+    bool IsInstance;
+  };
+
+  /// \brief The implementation, in a class, of a method of a superclass.
+  struct Override {
+    /// \brief The descriptor of the method in the superclass.
+    uint64_t Method;
+    uint64_t Impl;
+  };
+
+  struct Type {
+    /// \brief The address of the type context descriptor.
+    uint64_t Descriptor;
+    /// \brief The context descriptor kind: 16 for classes, 17 for structs,
+    /// 18 for enums.
+    unsigned Kind;
+    /// \brief The name, qualified by those of the enclosing contexts, as in
+    /// "Module.Outer.Inner".
+    std::string Name;
+    /// \brief The type metadata accessor, or 0.
+    uint64_t AccessFunction;
+    /// \brief The names of the stored properties or enum cases.
+    std::vector<StringRef> Fields;
+    /// \brief The offset, in words from the class metadata, of the first
+    /// vtable entry of the class itself.
+    unsigned VTableOffset;
+    /// \brief The methods the class adds to the vtable, by slot.
+    std::vector<Method> VTable;
+    std::vector<Override> Overrides;
+  };
+
+  struct Conformance {
+    uint64_t Descriptor;
+    /// \brief The type context descriptor of the conforming type, or 0 if it
+    /// is in another image, or an Objective-C class.
+    uint64_t Type;
+    std::string TypeName;
+    /// \brief The protocol name, empty if the protocol is in another image.
+    std::string ProtocolName;
+    /// \brief The functions of the witness table, with the kind of the
+    /// requirement each implements, and the index of the requirement.
+    struct Witness {
+      unsigned Requirement;
+      MethodKind Kind;
+      uint64_t Impl;
+    };
+    std::vector<Witness> Witnesses;
+  };
+
+  explicit SwiftMetadataIndex(const MachOObjectFile &MachO);
+
+  /// \brief The types of __swift5_types, in section order.
+  const std::vector<Type> &getTypes() const {
+    ensureResolved();
+    return Types;
+  }
+  /// \brief Return the type described at \p Descriptor, or null.
+  const Type *getType(uint64_t Descriptor) const;
+
+  /// \brief The conformances of __swift5_proto, in section order.
+  const std::vector<Conformance> &getConformances() const {
+    ensureResolved();
+    return Conformances;
+  }
+
+  /// \brief The functions the metadata points to, sorted by address, with a
+  /// name after what they implement: "type metadata accessor for T",
+  /// "T.getter.2" for the vtable slot 2 of the class T, "T.override.method.0"
+  /// for its first override, and "protocol witness for P.method.1 in T".
+  const std::vector<std::pair<uint64_t, std::string>> &
+  getFunctionNames() const {
+    ensureResolved();
+    return FunctionNames;
+  }
+  /// \brief Return the name of the function at \p Address, or an empty
+  /// string.
+  StringRef getFunctionName(uint64_t Address) const;
+
+  /// \brief Return the implementation of the vtable entry at \p WordOffset,
+  /// in words from the metadata, of the class described at \p Descriptor, if
+  /// the class defines or overrides it, or 0.
+  uint64_t getVTableImpl(uint64_t Descriptor, unsigned WordOffset) const;
+
+  static const char *getMethodKindName(MethodKind Kind);
+
+private:
+  struct Section {
+    uint64_t Address;
+    StringRef Contents;
+    bool IsText;
+  };
+
+  const MachOObjectFile &MachO;
+  mutable std::mutex Lock;
+  mutable bool Resolved;
+  /// \brief All the sections, sorted by address, to follow the pointers.
+  std::vector<Section> Sections;
+  std::vector<Type> Types;
+  DenseMap<uint64_t, unsigned> TypeIndex;
+  /// \brief The vtable word offset of each method descriptor.
+  DenseMap<uint64_t, unsigned> MethodOffsets;
+  /// \brief The field names of each field descriptor of __swift5_fieldmd.
+  DenseMap<uint64_t, std::vector<StringRef>> FieldDescriptors;
+  std::vector<Conformance> Conformances;
+  std::vector<std::pair<uint64_t, std::string>> FunctionNames;
+
+  void ensureResolved() const {
+    std::lock_guard<std::mutex> L(Lock);
+    if (!Resolved)
+      const_cast<SwiftMetadataIndex *>(this)->resolve();
+  }
+  void resolve();
+
+  const Section *findSection(uint64_t Addr) const;
+  bool read32(uint64_t Addr, uint32_t &Value) const;
+  bool read64(uint64_t Addr, uint64_t &Value) const;
+  bool isCode(uint64_t Addr) const;
+  StringRef getCString(uint64_t Addr) const;
+  /// \brief Follow the relative pointer at \p Addr, or return 0 if it is null.
+  uint64_t getRelative(uint64_t Addr) const;
+  /// \brief Follow the relative pointer at \p Addr, and the absolute pointer
+  /// it points to if its low bit is set, or return 0 if either is null.
+  uint64_t getRelativeIndirectable(uint64_t Addr) const;
+  std::string getContextName(uint64_t Descriptor, unsigned Depth = 0) const;
+
+  void addFields(uint64_t Addr, StringRef Contents);
+  void addType(uint64_t Descriptor);
+  void addClassVTable(Type &T, uint32_t Flags);
+  void addConformance(uint64_t Descriptor);
+  void addProtocolWitnesses(Conformance &C, uint64_t Protocol,
+                            uint64_t WitnessTable);
+};
+
+} // end namespace object
+} // end namespace llvm
+
+#endif
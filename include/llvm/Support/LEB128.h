@@ -15,6 +15,8 @@
 #ifndef LLVM_SUPPORT_LEB128_H
 #define LLVM_SUPPORT_LEB128_H
 
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/raw_ostream.h"
 
 namespace llvm {
@@ -90,6 +92,66 @@ inline uint64_t decodeULEB128(const uint8_t *p, unsigned *n = nullptr) {
   return Value;
 }
 
+/// Utility function to decode a ULEB128 value in [p, end). n is set to the
+/// size of the value, or to 0 if it doesn't end before \p end.
+/// When at least eight bytes are left, the value is decoded a word at a time:
+/// its end is the first byte without the continuation bit, and its bits are
+/// squeezed out of the word in three steps, without a loop.
+inline uint64_t decodeULEB128(const uint8_t *p, const uint8_t *end,
+                              unsigned *n) {
+  if (end - p >= 8) {
+    uint64_t Word = support::endian::read64le(p);
+    uint64_t Ends = ~Word & 0x8080808080808080ULL;
+    if (Ends) {
+      unsigned Size = countTrailingZeros(Ends) / 8 + 1;
+      if (Size != 8)
+        Word &= (1ULL << (8 * Size)) - 1;
+      Word &= 0x7f7f7f7f7f7f7f7fULL;
+      Word = (Word & 0x007f007f007f007fULL) |
+             ((Word & 0x7f007f007f007f00ULL) >> 1);
+      Word = (Word & 0x00003fff00003fffULL) |
+             ((Word & 0x3fff00003fff0000ULL) >> 2);
+      Word = (Word & 0x000000000fffffffULL) |
+             ((Word & 0x0fffffff00000000ULL) >> 4);
+      *n = Size;
+      return Word;
+    }
+  }
+  // Near the end, or longer than eight bytes.
+  const uint8_t *orig_p = p;
+  uint64_t Value = 0;
+  unsigned Shift = 0;
+  while (p != end) {
+    if (Shift < 64)
+      Value |= uint64_t(*p & 0x7f) << Shift;
+    Shift += 7;
+    if (*p++ < 128) {
+      *n = (unsigned)(p - orig_p);
+      return Value;
+    }
+  }
+  *n = 0;
+  return Value;
+}
+
+/// Utility function to decode the run of ULEB128 values in [p, end), passing
+/// each to \p F, until it returns false or a value doesn't end before
+/// \p end. Returns a pointer past the last value decoded.
+template <typename Fn>
+inline const uint8_t *decodeULEB128Run(const uint8_t *p, const uint8_t *end,
+                                       Fn F) {
+  while (p != end) {
+    unsigned n;
+    uint64_t Value = decodeULEB128(p, end, &n);
+    if (!n)
+      break;
+    p += n;
+    if (!F(Value))
+      break;
+  }
+  return p;
+}
+
 /// Utility function to decode a SLEB128 value.
 inline int64_t decodeSLEB128(const uint8_t *p, unsigned *n = nullptr) {
   const uint8_t *orig_p = p;
@@ -98,7 +160,7 @@ inline int64_t decodeSLEB128(const uint8_t *p, unsigned *n = nullptr) {
   uint8_t Byte;
   do {
     Byte = *p++;
-    Value |= ((Byte & 0x7f) << Shift);
+    Value |= (int64_t(Byte & 0x7f) << Shift);
     Shift += 7;
   } while (Byte >= 128);
   // Sign extend negative numbers.
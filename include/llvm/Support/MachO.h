@@ -132,7 +132,9 @@ namespace llvm {
       LC_DYLIB_CODE_SIGN_DRS  = 0x0000002Bu,
       LC_ENCRYPTION_INFO_64   = 0x0000002Cu,
       LC_LINKER_OPTION        = 0x0000002Du,
-      LC_LINKER_OPTIMIZATION_HINT = 0x0000002Eu
+      LC_LINKER_OPTIMIZATION_HINT = 0x0000002Eu,
+      LC_DYLD_EXPORTS_TRIE    = 0x80000033u,
+      LC_DYLD_CHAINED_FIXUPS  = 0x80000034u
     };
 
     enum : uint32_t {
@@ -317,7 +319,40 @@ namespace llvm {
       BIND_OPCODE_DO_BIND                          = 0x90u,
       BIND_OPCODE_DO_BIND_ADD_ADDR_ULEB            = 0xA0u,
       BIND_OPCODE_DO_BIND_ADD_ADDR_IMM_SCALED      = 0xB0u,
-      BIND_OPCODE_DO_BIND_ULEB_TIMES_SKIPPING_ULEB = 0xC0u
+      BIND_OPCODE_DO_BIND_ULEB_TIMES_SKIPPING_ULEB = 0xC0u,
+      BIND_OPCODE_THREADED                         = 0xD0u
+    };
+
+    enum {
+      BIND_SUBOPCODE_THREADED_SET_BIND_ORDINAL_TABLE_SIZE_ULEB = 0x00u,
+      BIND_SUBOPCODE_THREADED_APPLY                            = 0x01u
+    };
+
+    enum ChainedPointerFormat {
+      DYLD_CHAINED_PTR_ARM64E              = 1,
+      DYLD_CHAINED_PTR_64                  = 2,
+      DYLD_CHAINED_PTR_32                  = 3,
+      DYLD_CHAINED_PTR_32_CACHE            = 4,
+      DYLD_CHAINED_PTR_32_FIRMWARE         = 5,
+      DYLD_CHAINED_PTR_64_OFFSET           = 6,
+      DYLD_CHAINED_PTR_ARM64E_KERNEL       = 7,
+      DYLD_CHAINED_PTR_64_KERNEL_CACHE     = 8,
+      DYLD_CHAINED_PTR_ARM64E_USERLAND     = 9,
+      DYLD_CHAINED_PTR_ARM64E_FIRMWARE     = 10,
+      DYLD_CHAINED_PTR_X86_64_KERNEL_CACHE = 11,
+      DYLD_CHAINED_PTR_ARM64E_USERLAND24   = 12
+    };
+
+    enum ChainedImportFormat {
+      DYLD_CHAINED_IMPORT          = 1,
+      DYLD_CHAINED_IMPORT_ADDEND   = 2,
+      DYLD_CHAINED_IMPORT_ADDEND64 = 3
+    };
+
+    enum {
+      DYLD_CHAINED_PTR_START_NONE  = 0xFFFFu,
+      DYLD_CHAINED_PTR_START_MULTI = 0x8000u,
+      DYLD_CHAINED_PTR_START_LAST  = 0x8000u
     };
 
     enum {
@@ -0,0 +1,207 @@
+//===-- llvm/Support/ThreadPool.h - A work-stealing thread pool -*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares ThreadPool, a pool of threads running tasks, and the
+// parallel algorithms built on it: parallel_for, parallel_for_each and
+// parallel_sort.
+//
+// Each worker has its own queue of tasks. It runs the tasks from the back of
+// its queue, and when it is empty, steals from the front of the others'.
+//
+// The results of the algorithms don't depend on the number of threads, or on
+// the order the tasks run in: each index only writes its own results, which
+// the caller then reads in index order. PerThread gives each thread its own
+// scratch state, such as a BumpPtrAllocator arena or a counter, to merge once
+// the tasks are done.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_SUPPORT_THREADPOOL_H
+#define LLVM_SUPPORT_THREADPOOL_H
+
+#include "llvm/Support/thread.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace llvm {
+
+/// \brief A pool of worker threads running tasks, each from its own queue,
+/// and stealing from the others when it is empty.
+/// With no threads, or when LLVM isn't multithreaded, the tasks run within
+/// async.
+class ThreadPool {
+public:
+  typedef std::function<void()> TaskTy;
+
+  /// \brief Start \p NumThreads workers.
+  explicit ThreadPool(unsigned NumThreads);
+  /// \brief Wait for the tasks, and stop the workers.
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  unsigned getNumThreads() const { return Threads.size(); }
+
+  /// \brief Queue \p Task. From a worker, it goes to the worker's own queue,
+  /// otherwise to the next queue, round-robin.
+  void async(TaskTy Task);
+
+  /// \brief Wait until all the tasks have run. This must not be called from
+  /// a task.
+  void wait();
+
+  /// \brief Get the index of the current thread: that of the worker, in
+  /// [0, getNumThreads()), or getNumThreads() outside the pool.
+  unsigned getThreadIndex() const;
+
+  /// \brief Run one of the queued tasks, if there is any, on the current
+  /// thread. This is how the threads waiting for a TaskGroup help.
+  bool runQueuedTask();
+
+private:
+  struct WorkerQueue {
+    std::mutex Lock;
+    std::deque<TaskTy> Tasks;
+  };
+  std::vector<std::unique_ptr<WorkerQueue>> Queues;
+  std::vector<std::thread> Threads;
+
+  /// \brief Guards the counts below, and is held to push tasks, so that a
+  /// queued task is always in a queue.
+  std::mutex Lock;
+  std::condition_variable WorkAvailable;
+  std::condition_variable AllDone;
+  /// \brief The tasks in the queues.
+  size_t NumQueued;
+  /// \brief The tasks queued or running.
+  size_t NumPending;
+  bool Stopping;
+  unsigned NextQueue;
+
+  /// \brief Take a task for worker \p Self: its own last one, or else the
+  /// first one of another worker.
+  bool takeTask(unsigned Self, TaskTy &Task);
+  void runTask(TaskTy &Task);
+  void runWorker(unsigned Self);
+};
+
+/// \brief A group of tasks of a ThreadPool that can be waited for on their
+/// own, while the pool runs others. The waiting thread runs queued tasks
+/// until the group is done, so groups can be waited for from tasks.
+class TaskGroup {
+  ThreadPool &Pool;
+  std::mutex Lock;
+  std::condition_variable AllDone;
+  size_t NumPending;
+
+public:
+  explicit TaskGroup(ThreadPool &Pool) : Pool(Pool), NumPending(0) {}
+  ~TaskGroup() { wait(); }
+
+  void async(ThreadPool::TaskTy Task);
+  void wait();
+};
+
+/// \brief Scratch state of type \p T of each thread of a ThreadPool, and of
+/// the threads outside of it, e.g. a BumpPtrAllocator arena, or partial
+/// results to merge once the tasks are done.
+template <typename T> class PerThread {
+  const ThreadPool &Pool;
+  std::vector<T> Slots;
+
+public:
+  explicit PerThread(const ThreadPool &Pool)
+      : Pool(Pool), Slots(Pool.getNumThreads() + 1) {}
+
+  /// \brief Get the state of the current thread. The threads outside of the
+  /// pool share a slot: only one of them may use it at a time.
+  T &local() { return Slots[Pool.getThreadIndex()]; }
+
+  typedef typename std::vector<T>::iterator iterator;
+  iterator begin() { return Slots.begin(); }
+  iterator end() { return Slots.end(); }
+};
+
+/// \brief Call \p F on each index of [Begin, End), on the threads of \p Pool
+/// and the calling thread. The indices are taken one at a time, in order, by
+/// the first thread that is free. \p F must only write what's specific to
+/// its index.
+template <typename FuncT>
+void parallel_for(ThreadPool &Pool, size_t Begin, size_t End, FuncT F) {
+  if (Begin >= End)
+    return;
+  std::atomic<size_t> Next(Begin);
+  auto Work = [&]() {
+    for (size_t I = Next++; I < End; I = Next++)
+      F(I);
+  };
+  TaskGroup Group(Pool);
+  const size_t NumHelpers =
+      std::min<size_t>(Pool.getNumThreads(), End - Begin - 1);
+  for (size_t I = 0; I != NumHelpers; ++I)
+    Group.async(Work);
+  Work();
+  Group.wait();
+}
+
+/// \brief Call \p F on each element of the random access range
+/// [Begin, End), as parallel_for does on their indices.
+template <typename IterT, typename FuncT>
+void parallel_for_each(ThreadPool &Pool, IterT Begin, IterT End, FuncT F) {
+  parallel_for(Pool, 0, End - Begin, [&](size_t I) { F(Begin[I]); });
+}
+
+/// \brief Sort the random access range [Begin, End) with \p Comp: one chunk
+/// per thread is sorted in parallel, then the chunks are merged pairwise.
+template <typename IterT, typename CompT>
+void parallel_sort(ThreadPool &Pool, IterT Begin, IterT End, CompT Comp) {
+  const size_t Size = End - Begin;
+  // Below this, sorting is cheaper than handing it over.
+  const size_t MinChunkSize = 1024;
+  size_t NumChunks = std::min<size_t>(Pool.getNumThreads() + 1,
+                                      Size / MinChunkSize);
+  if (NumChunks <= 1) {
+    std::sort(Begin, End, Comp);
+    return;
+  }
+  auto ChunkBegin = [&](size_t C) { return Begin + Size * C / NumChunks; };
+  parallel_for(Pool, 0, NumChunks, [&](size_t C) {
+    std::sort(ChunkBegin(C), ChunkBegin(C + 1), Comp);
+  });
+  // Merge the chunks pairwise, the merges of a round in parallel.
+  for (size_t Width = 1; Width < NumChunks; Width *= 2) {
+    const size_t NumMerges = (NumChunks + 2 * Width - 1) / (2 * Width);
+    parallel_for(Pool, 0, NumMerges, [&](size_t M) {
+      const size_t First = 2 * Width * M;
+      if (First + Width >= NumChunks)
+        return;
+      std::inplace_merge(ChunkBegin(First), ChunkBegin(First + Width),
+                         ChunkBegin(std::min(First + 2 * Width, NumChunks)),
+                         Comp);
+    });
+  }
+}
+
+template <typename IterT>
+void parallel_sort(ThreadPool &Pool, IterT Begin, IterT End) {
+  typedef typename std::iterator_traits<IterT>::value_type ValueT;
+  parallel_sort(Pool, Begin, End, std::less<ValueT>());
+}
+
+} // end namespace llvm
+
+#endif
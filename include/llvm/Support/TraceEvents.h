@@ -0,0 +1,91 @@
+//===-- llvm/Support/TraceEvents.h - Chrome trace events --------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares a recorder of trace events, written in the Trace Event
+// Format that chrome://tracing and similar viewers read: each TraceScope is
+// a span of time of the thread it runs on.
+//
+// The events are recorded in a buffer of each thread, without any locking,
+// and only gathered when written. When tracing isn't enabled, a TraceScope
+// costs a single check.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_SUPPORT_TRACEEVENTS_H
+#define LLVM_SUPPORT_TRACEEVENTS_H
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/DataTypes.h"
+#include <atomic>
+
+namespace llvm {
+
+class raw_ostream;
+
+namespace trace {
+/// \brief Whether the events are recorded: see enableTraceEvents.
+extern std::atomic<bool> Enabled;
+} // end namespace trace
+
+/// \brief Start recording the trace events, from now on.
+void enableTraceEvents();
+
+inline bool areTraceEventsEnabled() {
+  return trace::Enabled.load(std::memory_order_relaxed);
+}
+
+/// \brief Write the events recorded so far, by all threads, to \p OS, as a
+/// JSON trace. The threads that record events must be done, or joined.
+void writeTraceEvents(raw_ostream &OS);
+
+/// \brief Get the time, in microseconds since tracing was enabled, at which
+/// a span starts, for recordTraceEvent.
+int64_t getTraceTime();
+
+/// \brief Record an event named \p Name, which must be a string literal, about
+/// \p Detail, from \p Start to now. This is for the spans that aren't scopes:
+/// use TraceScope where possible.
+void recordTraceEvent(const char *Name, StringRef Detail, int64_t Start);
+
+/// \brief Record, if the trace events are enabled, the lifetime of the scope
+/// as an event named \p Name, which must be a string literal.
+/// The event is about either \p Detail, or the function at \p Addr.
+class TraceScope {
+  const char *Name;
+  StringRef Detail;
+  uint64_t Addr;
+  bool HasAddr;
+  int64_t Start;
+
+  void begin();
+  void end();
+
+public:
+  explicit TraceScope(const char *Name, StringRef Detail = StringRef())
+      : Name(Name), Detail(Detail), Addr(0), HasAddr(false), Start(-1) {
+    if (areTraceEventsEnabled())
+      begin();
+  }
+  TraceScope(const char *Name, uint64_t Addr)
+      : Name(Name), Addr(Addr), HasAddr(true), Start(-1) {
+    if (areTraceEventsEnabled())
+      begin();
+  }
+  ~TraceScope() {
+    if (Start >= 0)
+      end();
+  }
+
+  TraceScope(const TraceScope &) = delete;
+  TraceScope &operator=(const TraceScope &) = delete;
+};
+
+} // end namespace llvm
+
+#endif
@@ -11,14 +11,17 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "llvm/Analysis/InstCount.h"
 #include "llvm/Analysis/Passes.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/IR/Function.h"
-#include "llvm/IR/InstVisitor.h"
+#include "llvm/IR/Module.h"
 #include "llvm/Pass.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <iterator>
 using namespace llvm;
 
 #define DEBUG_TYPE "instcount"
@@ -34,22 +37,38 @@ STATISTIC(TotalMemInst, "Number of memory instructions");
 #include "llvm/IR/Instruction.def"
 
 
-namespace {
-  class InstCount : public FunctionPass, public InstVisitor<InstCount> {
-    friend class InstVisitor<InstCount>;
+InstCounts::InstCounts() : NumFunctions(0), NumBlocks(0), NumInsts(0) {
+  std::fill(std::begin(NumOpcodeInsts), std::end(NumOpcodeInsts), 0);
+}
 
-    void visitFunction  (Function &F) { ++TotalFuncs; }
-    void visitBasicBlock(BasicBlock &BB) { ++TotalBlocks; }
+void InstCounts::add(const Function &F) {
+  if (F.isDeclaration())
+    return;
+  ++NumFunctions;
+  for (const BasicBlock &BB : F) {
+    ++NumBlocks;
+    for (const Instruction &I : BB) {
+      ++NumOpcodeInsts[I.getOpcode()];
+      ++NumInsts;
+    }
+  }
+}
 
-#define HANDLE_INST(N, OPCODE, CLASS) \
-    void visit##OPCODE(CLASS &) { ++Num##OPCODE##Inst; ++TotalInsts; }
+void InstCounts::add(const Module &M) {
+  for (const Function &F : M)
+    add(F);
+}
 
-#include "llvm/IR/Instruction.def"
+void InstCounts::add(const InstCounts &Other) {
+  NumFunctions += Other.NumFunctions;
+  NumBlocks += Other.NumBlocks;
+  NumInsts += Other.NumInsts;
+  for (unsigned i = 0; i != Instruction::OtherOpsEnd; ++i)
+    NumOpcodeInsts[i] += Other.NumOpcodeInsts[i];
+}
 
-    void visitInstruction(Instruction &I) {
-      errs() << "Instruction Count does not know about " << I;
-      llvm_unreachable(nullptr);
-    }
+namespace {
+  class InstCount : public FunctionPass {
   public:
     static char ID; // Pass identification, replacement for typeid
     InstCount() : FunctionPass(ID) {
@@ -76,13 +95,20 @@ FunctionPass *llvm::createInstCountPass() { return new InstCount(); }
 // function.
 //
 bool InstCount::runOnFunction(Function &F) {
-  unsigned StartMemInsts =
-    NumGetElementPtrInst + NumLoadInst + NumStoreInst + NumCallInst +
-    NumInvokeInst + NumAllocaInst;
-  visit(F);
-  unsigned EndMemInsts =
-    NumGetElementPtrInst + NumLoadInst + NumStoreInst + NumCallInst +
-    NumInvokeInst + NumAllocaInst;
-  TotalMemInst += EndMemInsts-StartMemInsts;
+  InstCounts Counts;
+  Counts.add(F);
+  TotalFuncs += Counts.NumFunctions;
+  TotalBlocks += Counts.NumBlocks;
+  TotalInsts += Counts.NumInsts;
+
+#define HANDLE_INST(N, OPCODE, CLASS) \
+  Num ## OPCODE ## Inst += Counts.get(N);
+
+#include "llvm/IR/Instruction.def"
+
+  TotalMemInst +=
+    Counts.get(Instruction::GetElementPtr) + Counts.get(Instruction::Load) +
+    Counts.get(Instruction::Store) + Counts.get(Instruction::Call) +
+    Counts.get(Instruction::Invoke) + Counts.get(Instruction::Alloca);
   return false;
 }
@@ -147,6 +147,9 @@ class BitcodeReader : public GVMaterializer {
   BitstreamCursor Stream;
   uint64_t NextUnreadBit = 0;
   bool SeenValueSymbolTable = false;
+  /// The bit offset of the module-level VST, if it follows the function
+  /// blocks, or 0.
+  uint64_t VSTOffset = 0;
 
   std::vector<Type*> TypeList;
   BitcodeReaderValueList ValueList;
@@ -370,7 +373,7 @@ private:
   std::error_code parseTypeTable();
   std::error_code parseTypeTableBody();
 
-  std::error_code parseValueSymbolTable();
+  std::error_code parseValueSymbolTable(uint64_t Offset = 0);
   std::error_code parseConstants();
   std::error_code rememberAndSkipFunctionBody();
   /// Save the positions of the Metadata blocks and skip parsing the blocks.
@@ -1583,7 +1586,24 @@ std::error_code BitcodeReader::parseTypeTableBody() {
   }
 }
 
-std::error_code BitcodeReader::parseValueSymbolTable() {
+/// Parse a value symbol table. If \p Offset isn't 0, it is the bit offset of
+/// the module-level VST, found after the function blocks: jump there, and come
+/// back to the current position when done.
+std::error_code BitcodeReader::parseValueSymbolTable(uint64_t Offset) {
+  uint64_t CurrentBit = 0;
+  // FNENTRY records give the offset of the function blocks, but the position
+  // to remember is after their block ID, as in rememberAndSkipFunctionBody.
+  uint64_t FuncBitOffsetDelta = 0;
+  if (Offset) {
+    CurrentBit = Stream.GetCurrentBitNo();
+    FuncBitOffsetDelta = Stream.getAbbrevIDWidth() + bitc::BlockIDWidth;
+    Stream.JumpToBit(Offset);
+    BitstreamEntry Entry = Stream.advance();
+    if (Entry.Kind != BitstreamEntry::SubBlock ||
+        Entry.ID != bitc::VALUE_SYMTAB_BLOCK_ID)
+      return error("Expected value symbol table subblock");
+  }
+
   if (Stream.EnterSubBlock(bitc::VALUE_SYMTAB_BLOCK_ID))
     return error("Invalid record");
 
@@ -1591,6 +1611,24 @@ std::error_code BitcodeReader::parseValueSymbolTable() {
 
   Triple TT(TheModule->getTargetTriple());
 
+  // Name the value \p ValueID, and return it.
+  auto setValueName = [&](uint64_t ValueID, StringRef Name) -> Value *{
+    if (ValueID >= ValueList.size() || !ValueList[ValueID])
+      return nullptr;
+    Value *V = ValueList[ValueID];
+
+    V->setName(Name);
+    if (auto *GO = dyn_cast<GlobalObject>(V)) {
+      if (GO->getComdat() == reinterpret_cast<Comdat *>(1)) {
+        if (TT.isOSBinFormatMachO())
+          GO->setComdat(nullptr);
+        else
+          GO->setComdat(TheModule->getOrInsertComdat(V->getName()));
+      }
+    }
+    return V;
+  };
+
   // Read all the records for this value table.
   SmallString<128> ValueName;
   while (1) {
@@ -1601,6 +1639,8 @@ std::error_code BitcodeReader::parseValueSymbolTable() {
     case BitstreamEntry::Error:
       return error("Malformed block");
     case BitstreamEntry::EndBlock:
+      if (Offset)
+        Stream.JumpToBit(CurrentBit);
       return std::error_code();
     case BitstreamEntry::Record:
       // The interesting case.
@@ -1615,20 +1655,22 @@ std::error_code BitcodeReader::parseValueSymbolTable() {
     case bitc::VST_CODE_ENTRY: {  // VST_ENTRY: [valueid, namechar x N]
       if (convertToString(Record, 1, ValueName))
         return error("Invalid record");
-      unsigned ValueID = Record[0];
-      if (ValueID >= ValueList.size() || !ValueList[ValueID])
+      if (!setValueName(Record[0], ValueName))
         return error("Invalid record");
-      Value *V = ValueList[ValueID];
-
-      V->setName(StringRef(ValueName.data(), ValueName.size()));
-      if (auto *GO = dyn_cast<GlobalObject>(V)) {
-        if (GO->getComdat() == reinterpret_cast<Comdat *>(1)) {
-          if (TT.isOSBinFormatMachO())
-            GO->setComdat(nullptr);
-          else
-            GO->setComdat(TheModule->getOrInsertComdat(V->getName()));
-        }
-      }
+      ValueName.clear();
+      break;
+    }
+    case bitc::VST_CODE_FNENTRY: {
+      // VST_FNENTRY: [valueid, offset, namechar x N]
+      if (convertToString(Record, 2, ValueName))
+        return error("Invalid record");
+      auto *F = dyn_cast_or_null<Function>(setValueName(Record[0], ValueName));
+      if (!F)
+        return error("Invalid record");
+      // When the VST is only reached by scanning, the function bodies were
+      // all found on the way.
+      if (Offset)
+        DeferredFunctionInfo[F] = Record[1] + FuncBitOffsetDelta;
       ValueName.clear();
       break;
     }
@@ -2851,6 +2893,13 @@ std::error_code BitcodeReader::parseModule(bool Resume,
           return EC;
         break;
       case bitc::VALUE_SYMTAB_BLOCK_ID:
+        // The module-level VST may already have been parsed, when its offset
+        // was known beforehand.
+        if (SeenValueSymbolTable) {
+          if (Stream.SkipBlock())
+            return error("Invalid record");
+          break;
+        }
         if (std::error_code EC = parseValueSymbolTable())
           return EC;
         SeenValueSymbolTable = true;
@@ -2879,6 +2928,16 @@ std::error_code BitcodeReader::parseModule(bool Resume,
           if (std::error_code EC = globalCleanup())
             return EC;
           SeenFirstFunctionBody = true;
+
+          // If the VST follows the function bodies, and its offset is known,
+          // parse it now: it also gives the position of every function body,
+          // so that materializing one doesn't need to scan all the previous.
+          if (VSTOffset && !SeenValueSymbolTable &&
+              Stream.canSkipToPos(VSTOffset / 8)) {
+            if (std::error_code EC = parseValueSymbolTable(VSTOffset))
+              return EC;
+            SeenValueSymbolTable = true;
+          }
         }
 
         if (std::error_code EC = rememberAndSkipFunctionBody())
@@ -2968,6 +3027,12 @@ std::error_code BitcodeReader::parseModule(bool Resume,
       GCTable.push_back(S);
       break;
     }
+    case bitc::MODULE_CODE_VSTOFFSET: { // VSTOFFSET: [offset]
+      if (Record.size() < 1)
+        return error("Invalid record");
+      VSTOffset = Record[0] * 32;
+      break;
+    }
     case bitc::MODULE_CODE_COMDAT: { // COMDAT: [selection_kind, name]
       if (Record.size() < 2)
         return error("Invalid record");
@@ -4722,11 +4787,18 @@ std::error_code BitcodeReader::materializeModule(Module *M) {
     if (std::error_code EC = materialize(F))
       return EC;
   }
-  // At this point, if there are any function bodies, the current bit is
-  // pointing to the END_BLOCK record after them. Now make sure the rest
-  // of the bits in the module have been read.
-  if (NextUnreadBit)
-    parseModule(true);
+  // At this point, if there are any function bodies, make sure the rest of the
+  // bits in the module have been read. When the VST gave the position of the
+  // bodies, they were materialized without scanning the stream past them, so
+  // go on until the END_BLOCK record after them.
+  if (NextUnreadBit) {
+    uint64_t PrevBit;
+    do {
+      PrevBit = NextUnreadBit;
+      if (std::error_code EC = parseModule(true))
+        return EC;
+    } while (NextUnreadBit != PrevBit);
+  }
 
   // Check that all block address forward references got resolved (as we
   // promised above).
@@ -29,8 +29,11 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/Program.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/raw_ostream.h"
 #include <cctype>
+#include <iterator>
 #include <map>
 using namespace llvm;
 
@@ -2066,15 +2069,73 @@ static void WriteInstruction(const Instruction &I, unsigned InstID,
 }
 
 // Emit names for globals/functions etc.
-static void WriteValueSymbolTable(const ValueSymbolTable &VST,
-                                  const ValueEnumerator &VE,
-                                  BitstreamWriter &Stream) {
-  if (VST.empty()) return;
+/// Bit offsets of the function blocks, from the start of the bitcode.
+typedef DenseMap<const Function *, uint64_t> FunctionBitcodeIndexTy;
+
+/// Emit a placeholder for the offset of the module-level VST, which is written
+/// after the function blocks so that it can record where each of them starts.
+/// Return the bit position of the placeholder, for WriteValueSymbolTable to
+/// backpatch it.
+static uint64_t WriteValueSymbolTableForwardDecl(BitstreamWriter &Stream) {
+  // The VST follows a block, so it is 32-bit aligned, and a 32-bit word offset
+  // is enough. The field is fixed-width, to be able to patch it in place.
+  BitCodeAbbrev *Abbv = new BitCodeAbbrev();
+  Abbv->Add(BitCodeAbbrevOp(bitc::MODULE_CODE_VSTOFFSET));
+  Abbv->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Fixed, 32));
+  unsigned VSTOffsetAbbrev = Stream.EmitAbbrev(Abbv);
+
+  SmallVector<unsigned, 1> Vals;
+  Vals.push_back(0);
+  Stream.EmitRecord(bitc::MODULE_CODE_VSTOFFSET, Vals, VSTOffsetAbbrev);
+  return Stream.GetCurrentBitNo() - 32;
+}
+
+/// Emit the value symbol table \p VST. For the module-level VST written after
+/// the function blocks, \p FunctionIndex gives the block offsets to record in
+/// FNENTRY records, and \p VSTOffsetPlaceholder is where to patch the offset
+/// of the VST itself.
+static void
+WriteValueSymbolTable(const ValueSymbolTable &VST, const ValueEnumerator &VE,
+                      BitstreamWriter &Stream,
+                      const FunctionBitcodeIndexTy *FunctionIndex = nullptr,
+                      uint64_t VSTOffsetPlaceholder = 0,
+                      uint64_t BitcodeStartBit = 0) {
+  if (VST.empty()) {
+    assert(!FunctionIndex && "Expected a VST to patch the VST offset");
+    return;
+  }
+
+  unsigned FnEntry8BitAbbrev = 0, FnEntry7BitAbbrev = 0, FnEntry6BitAbbrev = 0;
+  if (FunctionIndex) {
+    uint64_t VSTOffset = Stream.GetCurrentBitNo() - BitcodeStartBit;
+    assert((VSTOffset & 31) == 0 && "VST not 32-bit aligned");
+    Stream.BackpatchWord(VSTOffsetPlaceholder, VSTOffset / 32);
+  }
+
   Stream.EnterSubblock(bitc::VALUE_SYMTAB_BLOCK_ID, 4);
 
+  if (FunctionIndex) {
+    // VST_FNENTRY: [valueid, offset, namechar x N]
+    auto EmitFnEntryAbbrev = [&](BitCodeAbbrevOp CharOp) {
+      BitCodeAbbrev *Abbv = new BitCodeAbbrev();
+      Abbv->Add(BitCodeAbbrevOp(bitc::VST_CODE_FNENTRY));
+      Abbv->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::VBR, 8));
+      Abbv->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::VBR, 8));
+      Abbv->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Array));
+      Abbv->Add(CharOp);
+      return Stream.EmitAbbrev(Abbv);
+    };
+    FnEntry8BitAbbrev =
+        EmitFnEntryAbbrev(BitCodeAbbrevOp(BitCodeAbbrevOp::Fixed, 8));
+    FnEntry7BitAbbrev =
+        EmitFnEntryAbbrev(BitCodeAbbrevOp(BitCodeAbbrevOp::Fixed, 7));
+    FnEntry6BitAbbrev =
+        EmitFnEntryAbbrev(BitCodeAbbrevOp(BitCodeAbbrevOp::Char6));
+  }
+
   // FIXME: Set up the abbrev, we know how many values there are!
   // FIXME: We know if the type names can use 7-bit ascii.
-  SmallVector<unsigned, 64> NameVals;
+  SmallVector<uint64_t, 64> NameVals;
 
   for (const ValueName &Name : VST) {
 
@@ -2094,12 +2155,25 @@ static void WriteValueSymbolTable(const ValueSymbolTable &VST,
     unsigned AbbrevToUse = VST_ENTRY_8_ABBREV;
 
     // VST_ENTRY:   [valueid, namechar x N]
+    // VST_FNENTRY: [valueid, offset, namechar x N]
     // VST_BBENTRY: [bbid, namechar x N]
     unsigned Code;
+    const Function *F = dyn_cast<Function>(Name.getValue());
+    FunctionBitcodeIndexTy::const_iterator FI;
     if (isa<BasicBlock>(Name.getValue())) {
       Code = bitc::VST_CODE_BBENTRY;
       if (isChar6)
         AbbrevToUse = VST_BBENTRY_6_ABBREV;
+    } else if (FunctionIndex && F &&
+               (FI = FunctionIndex->find(F)) != FunctionIndex->end()) {
+      Code = bitc::VST_CODE_FNENTRY;
+      AbbrevToUse = FnEntry8BitAbbrev;
+      if (isChar6)
+        AbbrevToUse = FnEntry6BitAbbrev;
+      else if (is7Bit)
+        AbbrevToUse = FnEntry7BitAbbrev;
+      NameVals.push_back(VE.getValueID(F));
+      NameVals.push_back(FI->second);
     } else {
       Code = bitc::VST_CODE_ENTRY;
       if (isChar6)
@@ -2108,7 +2182,8 @@ static void WriteValueSymbolTable(const ValueSymbolTable &VST,
         AbbrevToUse = VST_ENTRY_7_ABBREV;
     }
 
-    NameVals.push_back(VE.getValueID(Name.getValue()));
+    if (Code != bitc::VST_CODE_FNENTRY)
+      NameVals.push_back(VE.getValueID(Name.getValue()));
     for (const char *P = Name.getKeyData(),
          *E = Name.getKeyData()+Name.getKeyLength(); P != E; ++P)
       NameVals.push_back((unsigned char)*P);
@@ -2156,7 +2231,11 @@ static void WriteUseListBlock(const Function *F, ValueEnumerator &VE,
 
 /// WriteFunction - Emit a function body to the module stream.
 static void WriteFunction(const Function &F, ValueEnumerator &VE,
-                          BitstreamWriter &Stream) {
+                          BitstreamWriter &Stream,
+                          FunctionBitcodeIndexTy &FunctionIndex,
+                          uint64_t BitcodeStartBit) {
+  // Remember where the block starts, for the module-level VST.
+  FunctionIndex[&F] = Stream.GetCurrentBitNo() - BitcodeStartBit;
   Stream.EnterSubblock(bitc::FUNCTION_BLOCK_ID, 4);
   VE.incorporateFunction(F);
 
@@ -2402,9 +2481,109 @@ static void WriteBlockInfo(const ValueEnumerator &VE, BitstreamWriter &Stream) {
   Stream.ExitBlock();
 }
 
+// The number of functions each job writes at once, and the number of pending
+// jobs per thread: the blocks of a round of jobs are kept in memory until all
+// are done.
+static const size_t FunctionsPerWriteJob = 64;
+static const size_t WriteJobsPerThread = 4;
+
+namespace {
+/// The function blocks encoded by a job, and where each of them starts.
+struct FunctionWriteJob {
+  SmallVector<char, 0> Buffer;
+  /// The byte range of the blocks in Buffer.
+  uint64_t Begin, End;
+  /// The bit offsets of the blocks, from Begin.
+  FunctionBitcodeIndexTy Index;
+};
+}
+
+/// Emit the bodies of the functions \p Funcs, as WriteFunction does, on
+/// \p NumJobs threads.
+///
+/// Each thread incorporates the functions into its own copy of the module
+/// enumeration, and each job writes its functions into its own buffer, with
+/// the abbreviations of WriteBlockInfo. Function blocks start and end on word
+/// boundaries, and their bits don't depend on where they are: the buffers are
+/// spliced into \p Stream in order, and give the same bitcode as writing the
+/// functions one after another.
+static void WriteFunctionsInParallel(ArrayRef<const Function *> Funcs,
+                                     ValueEnumerator &VE,
+                                     BitstreamWriter &Stream,
+                                     FunctionBitcodeIndexTy &FunctionIndex,
+                                     uint64_t BitcodeStartBit,
+                                     unsigned NumJobs) {
+  // The stream is only on a word boundary after a block: write the first
+  // function in place if it isn't yet.
+  if (!Funcs.empty() && Stream.GetCurrentBitNo() % 32) {
+    WriteFunction(*Funcs.front(), VE, Stream, FunctionIndex, BitcodeStartBit);
+    Funcs = Funcs.slice(1);
+  }
+
+  // WriteUseListBlock takes the use-list orders of each function from the
+  // back of the stack, in function order: hand them out ahead of time.
+  std::vector<UseListOrderStack> UseListOrders(Funcs.size());
+  if (VE.shouldPreserveUseListOrder()) {
+    UseListOrderStack &Stack = VE.UseListOrders;
+    for (size_t I = 0; I != Funcs.size(); ++I) {
+      auto Begin = Stack.end();
+      while (Begin != Stack.begin() && std::prev(Begin)->F == Funcs[I])
+        --Begin;
+      UseListOrders[I].assign(std::make_move_iterator(Begin),
+                              std::make_move_iterator(Stack.end()));
+      Stack.erase(Begin, Stack.end());
+    }
+  }
+
+  ThreadPool Pool(NumJobs - 1);
+  PerThread<std::unique_ptr<ValueEnumerator>> ThreadVEs(Pool);
+  const size_t NumWriteJobs =
+      (Funcs.size() + FunctionsPerWriteJob - 1) / FunctionsPerWriteJob;
+  const size_t JobsPerRound = NumJobs * WriteJobsPerThread;
+
+  std::vector<FunctionWriteJob> Jobs(JobsPerRound);
+  for (size_t FirstJob = 0; FirstJob < NumWriteJobs; FirstJob += JobsPerRound) {
+    const size_t EndJob = std::min(FirstJob + JobsPerRound, NumWriteJobs);
+    parallel_for(Pool, FirstJob, EndJob, [&](size_t J) {
+      std::unique_ptr<ValueEnumerator> &JobVE = ThreadVEs.local();
+      if (!JobVE)
+        JobVE = VE.cloneModuleEnumeration();
+
+      FunctionWriteJob &Job = Jobs[J - FirstJob];
+      Job.Buffer.clear();
+      Job.Index.clear();
+      BitstreamWriter JobStream(Job.Buffer);
+      // Nest the blocks in a module block, as in Stream, for them to be
+      // entered with the same code width and to use the same abbreviations.
+      JobStream.EnterSubblock(bitc::MODULE_BLOCK_ID, 3);
+      WriteBlockInfo(*JobVE, JobStream);
+      Job.Begin = JobStream.GetCurrentBitNo() / 8;
+      for (size_t I = J * FunctionsPerWriteJob,
+                  E = std::min(I + FunctionsPerWriteJob, Funcs.size());
+           I != E; ++I) {
+        JobVE->UseListOrders = std::move(UseListOrders[I]);
+        WriteFunction(*Funcs[I], *JobVE, JobStream, Job.Index, Job.Begin * 8);
+        assert(JobVE->UseListOrders.empty() && "Use-list orders left over");
+      }
+      Job.End = JobStream.GetCurrentBitNo() / 8;
+      JobStream.ExitBlock();
+    });
+
+    for (size_t J = FirstJob; J != EndJob; ++J) {
+      FunctionWriteJob &Job = Jobs[J - FirstJob];
+      uint64_t BlocksStartBit = Stream.GetCurrentBitNo() - BitcodeStartBit;
+      for (const auto &Entry : Job.Index)
+        FunctionIndex[Entry.first] = BlocksStartBit + Entry.second;
+      Stream.EmitWords(StringRef(Job.Buffer.data() + Job.Begin,
+                                 Job.End - Job.Begin));
+    }
+  }
+}
+
 /// WriteModule - Emit the specified module to the bitstream.
 static void WriteModule(const Module *M, BitstreamWriter &Stream,
-                        bool ShouldPreserveUseListOrder) {
+                        bool ShouldPreserveUseListOrder,
+                        uint64_t BitcodeStartBit, unsigned NumJobs) {
   Stream.EnterSubblock(bitc::MODULE_BLOCK_ID, 3);
 
   SmallVector<unsigned, 1> Vals;
@@ -2433,6 +2612,17 @@ static void WriteModule(const Module *M, BitstreamWriter &Stream,
   // descriptors for global variables, and function prototype info.
   WriteModuleInfo(M, VE, Stream);
 
+  // If there are function bodies, the module-level VST is written after them,
+  // with the offset of each: a lazy reader can then find any function without
+  // scanning the others. Emit the forward declaration of its offset first.
+  bool HasFunctionBodies = false;
+  for (const Function &F : *M)
+    HasFunctionBodies |= !F.isDeclaration();
+  bool WriteVSTLast = HasFunctionBodies && !M->getValueSymbolTable().empty();
+  uint64_t VSTOffsetPlaceholder = 0;
+  if (WriteVSTLast)
+    VSTOffsetPlaceholder = WriteValueSymbolTableForwardDecl(Stream);
+
   // Emit constants.
   WriteModuleConstants(VE, Stream);
 
@@ -2443,16 +2633,32 @@ static void WriteModule(const Module *M, BitstreamWriter &Stream,
   WriteModuleMetadataStore(M, Stream);
 
   // Emit names for globals/functions etc.
-  WriteValueSymbolTable(M->getValueSymbolTable(), VE, Stream);
+  if (!WriteVSTLast)
+    WriteValueSymbolTable(M->getValueSymbolTable(), VE, Stream);
 
   // Emit module-level use-lists.
   if (VE.shouldPreserveUseListOrder())
     WriteUseListBlock(nullptr, VE, Stream);
 
   // Emit function bodies.
-  for (Module::const_iterator F = M->begin(), E = M->end(); F != E; ++F)
-    if (!F->isDeclaration())
-      WriteFunction(*F, VE, Stream);
+  FunctionBitcodeIndexTy FunctionIndex;
+  if (NumJobs > 1 && llvm_is_multithreaded()) {
+    std::vector<const Function *> Funcs;
+    for (const Function &F : *M)
+      if (!F.isDeclaration())
+        Funcs.push_back(&F);
+    WriteFunctionsInParallel(Funcs, VE, Stream, FunctionIndex, BitcodeStartBit,
+                             NumJobs);
+  } else {
+    for (Module::const_iterator F = M->begin(), E = M->end(); F != E; ++F)
+      if (!F->isDeclaration())
+        WriteFunction(*F, VE, Stream, FunctionIndex, BitcodeStartBit);
+  }
+
+  // Emit names for globals/functions etc., now that the functions are placed.
+  if (WriteVSTLast)
+    WriteValueSymbolTable(M->getValueSymbolTable(), VE, Stream, &FunctionIndex,
+                          VSTOffsetPlaceholder, BitcodeStartBit);
 
   Stream.ExitBlock();
 }
@@ -2530,7 +2736,8 @@ static void EmitDarwinBCHeaderAndTrailer(SmallVectorImpl<char> &Buffer,
 /// WriteBitcodeToFile - Write the specified module to the specified output
 /// stream.
 void llvm::WriteBitcodeToFile(const Module *M, raw_ostream &Out,
-                              bool ShouldPreserveUseListOrder) {
+                              bool ShouldPreserveUseListOrder,
+                              unsigned NumJobs) {
   SmallVector<char, 0> Buffer;
   Buffer.reserve(256*1024);
 
@@ -2544,6 +2751,9 @@ void llvm::WriteBitcodeToFile(const Module *M, raw_ostream &Out,
   {
     BitstreamWriter Stream(Buffer);
 
+    // Offsets in the bitcode are relative to its start, after any header.
+    uint64_t BitcodeStartBit = Stream.GetCurrentBitNo();
+
     // Emit the file header.
     Stream.Emit((unsigned)'B', 8);
     Stream.Emit((unsigned)'C', 8);
@@ -2553,7 +2763,8 @@ void llvm::WriteBitcodeToFile(const Module *M, raw_ostream &Out,
     Stream.Emit(0xD, 4);
 
     // Emit the module.
-    WriteModule(M, Stream, ShouldPreserveUseListOrder);
+    WriteModule(M, Stream, ShouldPreserveUseListOrder, BitcodeStartBit,
+                NumJobs);
   }
 
   if (TT.isOSDarwin())
@@ -19,6 +19,7 @@
 #include "llvm/ADT/UniqueVector.h"
 #include "llvm/IR/Attributes.h"
 #include "llvm/IR/UseListOrder.h"
+#include <memory>
 #include <vector>
 
 namespace llvm {
@@ -100,11 +101,17 @@ private:
   unsigned FirstFuncConstantID;
   unsigned FirstInstID;
 
-  ValueEnumerator(const ValueEnumerator &) = delete;
+  /// Copy everything but the use-list orders, for cloneModuleEnumeration.
+  ValueEnumerator(const ValueEnumerator &VE);
   void operator=(const ValueEnumerator &) = delete;
 public:
   ValueEnumerator(const Module &M, bool ShouldPreserveUseListOrder);
 
+  /// cloneModuleEnumeration - Copy the enumeration of the module, for another
+  /// thread to incorporate functions into.  No function may be incorporated,
+  /// and the use-list orders are left out.
+  std::unique_ptr<ValueEnumerator> cloneModuleEnumeration() const;
+
   void dump() const;
   void print(raw_ostream &OS, const ValueMapType &Map, const char *Name) const;
   void print(raw_ostream &OS, const MetadataMapType &Map,
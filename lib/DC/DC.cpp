@@ -0,0 +1,256 @@
+//===-- DC.cpp - C bindings to the decompiler library ---------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines the C bindings to the decompiler library: the MC CFG of
+// a binary, as arrays, and its translation.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm-c/DC.h"
+#include "llvm/ADT/Triple.h"
+#include "llvm/DC/DCDecompilerSession.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCAnalysis/MCModule.h"
+#include "llvm/MC/MCInstPrinter.h"
+#include "llvm/MC/MCInstrInfo.h"
+#include "llvm/MC/MCSubtargetInfo.h"
+#include "llvm/Object/MachOUniversal.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace llvm;
+using namespace object;
+
+namespace {
+/// \brief A binary, disassembled, with its functions, blocks and
+/// instructions numbered in address order, and their properties as arrays.
+struct DCBinary {
+  std::unique_ptr<MemoryBuffer> Buffer;
+  std::unique_ptr<Binary> Bin;
+  std::unique_ptr<MachOObjectFile> Slice;
+  std::unique_ptr<DCDecompilerTarget> DTarget;
+  std::unique_ptr<DCDecompilerSession> Session;
+  std::unique_ptr<DCDisassembly> Disassembly;
+
+  std::vector<std::string> FunctionNames;
+  std::vector<uint64_t> FunctionAddrs;
+  std::vector<uint32_t> FunctionBlockBegins;
+  std::vector<const MCBasicBlock *> Blocks;
+  std::vector<uint64_t> BlockAddrs;
+  std::vector<uint64_t> BlockInstBegins;
+  std::vector<uint64_t> InstAddrs;
+  std::vector<uint8_t> InstSizes;
+  std::vector<uint32_t> InstOpcodes;
+
+  void buildArrays();
+};
+} // end anonymous namespace
+
+static DCBinary *unwrap(LLVMDCBinaryRef B) {
+  return reinterpret_cast<DCBinary *>(B);
+}
+
+static LLVMDCBinaryRef wrap(const DCBinary *B) {
+  return reinterpret_cast<LLVMDCBinaryRef>(const_cast<DCBinary *>(B));
+}
+
+static bool BBBeginAddrLess(const MCBasicBlock *LHS, const MCBasicBlock *RHS) {
+  return LHS->getStartAddr() < RHS->getStartAddr();
+}
+
+void DCBinary::buildArrays() {
+  MCModule &MCM = Disassembly->getModule();
+  std::vector<MCFunction *> Functions;
+  for (const auto &F : MCM.funcs())
+    Functions.push_back(F.get());
+  std::sort(Functions.begin(), Functions.end(),
+            [](const MCFunction *L, const MCFunction *R) {
+              return L->getEntryBlock()->getStartAddr() <
+                     R->getEntryBlock()->getStartAddr();
+            });
+
+  uint64_t NumInsts = 0;
+  for (MCFunction *F : Functions) {
+    // The instructions are printed from the blocks.
+    F->unpackInsts();
+    for (const MCBasicBlock *BB : *F)
+      NumInsts += BB->size();
+  }
+  InstAddrs.reserve(NumInsts);
+  InstSizes.reserve(NumInsts);
+  InstOpcodes.reserve(NumInsts);
+
+  for (const MCFunction *F : Functions) {
+    FunctionNames.push_back(F->getName());
+    FunctionAddrs.push_back(F->getEntryBlock()->getStartAddr());
+    FunctionBlockBegins.push_back(Blocks.size());
+    const size_t FirstBlock = Blocks.size();
+    for (const MCBasicBlock *BB : *F)
+      Blocks.push_back(BB);
+    std::sort(Blocks.begin() + FirstBlock, Blocks.end(), BBBeginAddrLess);
+    for (size_t I = FirstBlock, E = Blocks.size(); I != E; ++I) {
+      BlockAddrs.push_back(Blocks[I]->getStartAddr());
+      BlockInstBegins.push_back(InstAddrs.size());
+      for (const MCDecodedInst &DI : *Blocks[I]) {
+        InstAddrs.push_back(DI.Address);
+        InstSizes.push_back(DI.Size);
+        InstOpcodes.push_back(DI.Inst.getOpcode());
+      }
+    }
+  }
+  FunctionBlockBegins.push_back(Blocks.size());
+  BlockInstBegins.push_back(InstAddrs.size());
+}
+
+LLVMDCBinaryRef LLVMDCCreateBinary(const char *Path, const char *ArchName,
+                                   unsigned NumJobs, char **OutMessage) {
+  std::unique_ptr<DCBinary> B(new DCBinary());
+  auto Fail = [&](const Twine &Msg) {
+    *OutMessage = strdup((Twine(Path) + ": " + Msg).str().c_str());
+    return nullptr;
+  };
+
+  ErrorOr<std::unique_ptr<MemoryBuffer>> BufOrErr =
+      MemoryBuffer::getFile(Path);
+  if (std::error_code EC = BufOrErr.getError())
+    return Fail(EC.message());
+  B->Buffer = std::move(*BufOrErr);
+  ErrorOr<std::unique_ptr<Binary>> BinOrErr =
+      createBinary(B->Buffer->getMemBufferRef());
+  if (std::error_code EC = BinOrErr.getError())
+    return Fail(EC.message());
+  B->Bin = std::move(*BinOrErr);
+  const ObjectFile *Obj = dyn_cast<ObjectFile>(B->Bin.get());
+  if (auto *UB = dyn_cast<MachOUniversalBinary>(B->Bin.get())) {
+    auto SliceOrErr = UB->getObjectForArch(ArchName ? ArchName : "");
+    if (std::error_code EC = SliceOrErr.getError())
+      return Fail(Twine(ArchName ? ArchName : "") + ": " + EC.message());
+    B->Slice = std::move(*SliceOrErr);
+    Obj = B->Slice.get();
+  }
+  if (!Obj)
+    return Fail("unrecognized file type");
+
+  Triple TheTriple("unknown-unknown-unknown");
+  TheTriple.setArch(Triple::ArchType(Obj->getArch()));
+  if (Obj->isMachO())
+    TheTriple.setObjectFormat(Triple::MachO);
+  std::string Error;
+  B->DTarget = DCDecompilerTarget::create(TheTriple.getTriple(), Error);
+  if (!B->DTarget)
+    return Fail(Error);
+  B->Session = DCDecompilerSession::create(*B->DTarget, Error);
+  if (!B->Session)
+    return Fail(Error);
+
+  DCDecompilerSession::Options Opts;
+  Opts.MCJobs = NumJobs ? NumJobs : 1;
+  B->Disassembly = B->Session->disassemble(*Obj, Opts, Error);
+  if (!B->Disassembly)
+    return Fail(Error);
+  B->buildArrays();
+  return wrap(B.release());
+}
+
+void LLVMDCDisposeBinary(LLVMDCBinaryRef B) { delete unwrap(B); }
+
+const char *LLVMDCGetBinaryTriple(LLVMDCBinaryRef B) {
+  return unwrap(B)->DTarget->getTripleName().c_str();
+}
+
+uint64_t LLVMDCGetBinaryEntrypoint(LLVMDCBinaryRef B) {
+  return unwrap(B)->Disassembly->getEntrypoint();
+}
+
+unsigned LLVMDCGetNumFunctions(LLVMDCBinaryRef B) {
+  return unwrap(B)->FunctionAddrs.size();
+}
+
+unsigned LLVMDCGetNumBasicBlocks(LLVMDCBinaryRef B) {
+  return unwrap(B)->BlockAddrs.size();
+}
+
+uint64_t LLVMDCGetNumInstructions(LLVMDCBinaryRef B) {
+  return unwrap(B)->InstAddrs.size();
+}
+
+const char *LLVMDCGetFunctionName(LLVMDCBinaryRef B, unsigned F) {
+  return unwrap(B)->FunctionNames[F].c_str();
+}
+
+const uint64_t *LLVMDCGetFunctionAddresses(LLVMDCBinaryRef B) {
+  return unwrap(B)->FunctionAddrs.data();
+}
+
+const uint32_t *LLVMDCGetFunctionBlockBegins(LLVMDCBinaryRef B) {
+  return unwrap(B)->FunctionBlockBegins.data();
+}
+
+const uint64_t *LLVMDCGetBlockAddresses(LLVMDCBinaryRef B) {
+  return unwrap(B)->BlockAddrs.data();
+}
+
+const uint64_t *LLVMDCGetBlockInstructionBegins(LLVMDCBinaryRef B) {
+  return unwrap(B)->BlockInstBegins.data();
+}
+
+const uint64_t *LLVMDCGetInstructionAddresses(LLVMDCBinaryRef B) {
+  return unwrap(B)->InstAddrs.data();
+}
+
+const uint8_t *LLVMDCGetInstructionSizes(LLVMDCBinaryRef B) {
+  return unwrap(B)->InstSizes.data();
+}
+
+const uint32_t *LLVMDCGetInstructionOpcodes(LLVMDCBinaryRef B) {
+  return unwrap(B)->InstOpcodes.data();
+}
+
+const char *LLVMDCGetOpcodeName(LLVMDCBinaryRef B, unsigned Opcode) {
+  const MCInstrInfo &MII = unwrap(B)->DTarget->getInstrInfo();
+  if (Opcode >= MII.getNumOpcodes())
+    return nullptr;
+  return MII.getName(Opcode);
+}
+
+size_t LLVMDCPrintInstruction(LLVMDCBinaryRef B, uint64_t I, char *OutString,
+                              size_t OutStringSize) {
+  DCBinary &DB = *unwrap(B);
+  // The block of I is the last one starting at or before it.
+  size_t BBI = std::upper_bound(DB.BlockInstBegins.begin(),
+                                std::prev(DB.BlockInstBegins.end()), I) -
+               DB.BlockInstBegins.begin() - 1;
+  const MCDecodedInst &DI =
+      *(DB.Blocks[BBI]->begin() + (I - DB.BlockInstBegins[BBI]));
+
+  std::string Text;
+  raw_string_ostream OS(Text);
+  DB.Disassembly->getInstPrinter().printInst(
+      &DI.Inst, OS, "", DB.DTarget->getSubtargetInfo());
+  StringRef Str = StringRef(OS.str()).ltrim();
+  if (OutStringSize) {
+    size_t Len = std::min(Str.size(), OutStringSize - 1);
+    std::memcpy(OutString, Str.data(), Len);
+    OutString[Len] = '\0';
+  }
+  return Str.size();
+}
+
+LLVMModuleRef LLVMDCTranslateBinary(LLVMDCBinaryRef B, LLVMContextRef C,
+                                    unsigned OptLevel, unsigned NumJobs) {
+  DCBinary &DB = *unwrap(B);
+  DCDecompilerSession::Options Opts;
+  Opts.OptLevel = TransOpt::Level(std::min(OptLevel, 3U));
+  Opts.DCJobs = NumJobs ? NumJobs : 1;
+  return wrap(
+      DB.Session->translate(*DB.Disassembly, *unwrap(C), Opts).release());
+}
@@ -0,0 +1,77 @@
+//===-- lib/DC/DCAddressTable.cpp - DC Address Table ------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/DC/DCAddressTable.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/DC/DCIRBuilder.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace llvm;
+
+bool llvm::getDCInstAddress(const Instruction &I, uint64_t &Addr) {
+  MDNode *Node = I.getMetadata(DCInstAddressMDKind);
+  if (!Node || Node->getNumOperands() != 1)
+    return false;
+  const MDOperand &Op = Node->getOperand(0);
+  if (ConstantInt *CI = mdconst::dyn_extract<ConstantInt>(Op)) {
+    Addr = CI->getZExtValue();
+    return true;
+  }
+  if (MDString *S = dyn_cast<MDString>(Op))
+    return !S->getString().getAsInteger(16, Addr);
+  return false;
+}
+
+namespace {
+struct AddressRun {
+  unsigned FirstInst;
+  bool HasAddr;
+  uint64_t Addr;
+};
+} // end anonymous namespace
+
+void llvm::writeDCAddressTable(const Module &M, raw_ostream &OS) {
+  SmallVector<AddressRun, 64> Runs;
+  for (const Function &F : M) {
+    if (F.isDeclaration())
+      continue;
+
+    Runs.clear();
+    unsigned Idx = 0;
+    for (const BasicBlock &BB : F) {
+      for (const Instruction &I : BB) {
+        AddressRun R = {Idx++, false, 0};
+        R.HasAddr = getDCInstAddress(I, R.Addr);
+        if (Runs.empty() || Runs.back().HasAddr != R.HasAddr ||
+            Runs.back().Addr != R.Addr)
+          Runs.push_back(R);
+      }
+    }
+
+    OS << F.getName() << ' ' << Runs.size() << '\n';
+    for (const AddressRun &R : Runs) {
+      OS << R.FirstInst << ' ';
+      if (R.HasAddr)
+        OS << utohexstr(R.Addr);
+      else
+        OS << '-';
+      OS << '\n';
+    }
+  }
+}
+
+void llvm::stripDCInstAddresses(Module &M) {
+  unsigned MDKind = M.getContext().getMDKindID(DCInstAddressMDKind);
+  for (Function &F : M)
+    for (BasicBlock &BB : F)
+      for (Instruction &I : BB)
+        I.setMetadata(MDKind, nullptr);
+}
@@ -22,28 +22,40 @@ DCAnnotationWriter::DCAnnotationWriter(const DCTranslatedInstTracker &DTIT,
                                        const MCSubtargetInfo &STI)
     : AssemblyAnnotationWriter(), DTIT(DTIT), MRI(MRI), IP(IP), STI(STI) {}
 
+StringRef
+DCAnnotationWriter::getInstText(const DCTranslatedInst::ValueInfo &VI) {
+  if (InstTexts.size() != DTIT.getNumTrackedInsts())
+    InstTexts.assign(DTIT.getNumTrackedInsts(),
+                     std::make_pair(nullptr, std::string()));
+  auto &Text = InstTexts[DTIT.getTrackedInstIndex(VI)];
+  if (Text.first != VI.DecodedInst) {
+    Text.first = VI.DecodedInst;
+    Text.second.clear();
+    raw_string_ostream OS(Text.second);
+    IP.printInst(&VI.DecodedInst->Inst, OS, "", STI);
+  }
+  return Text.second;
+}
+
 void DCAnnotationWriter::printInfoComment(const Value &V,
                                           formatted_raw_ostream &OS) {
   if (!isa<Instruction>(&V))
     return;
 
-  const SmallVectorImpl<DCTranslatedInst::ValueInfo> *Infos = 0;
+  SmallVector<const DCTranslatedInst::ValueInfo *, 4> Infos;
   DTIT.getInstsForValue(V, Infos);
 
-  if (Infos == 0)
-    return;
-
-  for (int vii = 0, vie = Infos->size(); vii != vie; ++vii) {
+  for (int vii = 0, vie = Infos.size(); vii != vie; ++vii) {
 
     if (vii)
       OS << "\n";
 
-    const MCDecodedInst *MCDI = (*Infos)[vii].DecodedInst;
+    const MCDecodedInst *MCDI = Infos[vii]->DecodedInst;
     uint64_t Addr = MCDI->Address;
 
     bool printMI = false;
 
-    const DCTranslatedInst::ValueInfo &VI = (*Infos)[vii];
+    const DCTranslatedInst::ValueInfo &VI = *Infos[vii];
     OS.PadToColumn(48) << "  ; ";
     switch (VI.OpKind) {
     default:
@@ -99,7 +111,7 @@ void DCAnnotationWriter::printInfoComment(const Value &V,
 
     if (MCDI)
       OS << ": ";
-    IP.printInst(&MCDI->Inst, OS.PadToColumn(90), "", STI);
+    OS.PadToColumn(90) << getInstText(VI);
   }
 }
 
@@ -0,0 +1,107 @@
+//===-- lib/DC/DCBlockProfile.cpp - Block profile of a run ------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/DC/DCBlockProfile.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCAnalysis/MCModule.h"
+#include "llvm/Support/MD5.h"
+#include <algorithm>
+#include <vector>
+
+using namespace llvm;
+
+bool DCBlockProfile::read(StringRef Trace, const MCModule &MCM,
+                          std::string &ErrMsg) {
+  SmallVector<StringRef, 256> Lines;
+  Trace.split(Lines, "\n", -1, /*KeepEmpty=*/false);
+
+  // Look up all the blocks of the trace at once, each once.
+  std::vector<uint64_t> Addrs(Lines.size(), 0);
+  for (size_t I = 0, E = Lines.size(); I != E; ++I)
+    if (Lines[I].getAsInteger(16, Addrs[I]) &&
+        !Lines[I].startswith("thread ") && !Lines[I].startswith("dropped ")) {
+      ErrMsg = utostr(I + 1) + ": invalid block trace entry";
+      return false;
+    }
+  std::vector<uint64_t> Blocks(Addrs);
+  std::sort(Blocks.begin(), Blocks.end());
+  Blocks.erase(std::unique(Blocks.begin(), Blocks.end()), Blocks.end());
+  std::vector<MCModule::AddressLocation> Locs;
+  MCM.findContaining(Blocks, Locs);
+
+  // The calls don't end blocks: after the blocks of a callee, the trace goes
+  // on with a successor of the block of the call. Each thread keeps the
+  // blocks it is in, one per active function, the innermost last: a block
+  // that isn't the entry of a function follows the innermost of those it is
+  // a successor of, and the calls left are the ones it returned from.
+  std::vector<const MCBasicBlock *> Active;
+  for (size_t I = 0, E = Lines.size(); I != E; ++I) {
+    uint64_t Addr;
+    // A thread starts afresh, and the dropped entries lose track of where
+    // it was.
+    if (Lines[I].getAsInteger(16, Addr)) {
+      Active.clear();
+      continue;
+    }
+    const MCModule::AddressLocation &L =
+        Locs[std::lower_bound(Blocks.begin(), Blocks.end(), Addr) -
+             Blocks.begin()];
+    if (!L.Block || L.Block->getStartAddr() != Addr) {
+      Active.clear();
+      continue;
+    }
+    const MCBasicBlock *BB = L.Block;
+    if (BB == L.Function->getEntryBlock() &&
+        (Active.empty() || !Active.back()->isSuccessor(BB))) {
+      ++EntryCounts[BB->getStartAddr()];
+      Active.push_back(BB);
+      continue;
+    }
+    while (!Active.empty() && !Active.back()->isSuccessor(BB))
+      Active.pop_back();
+    if (Active.empty()) {
+      Active.push_back(BB);
+      continue;
+    }
+    ++EdgeCounts[std::make_pair(Active.back()->getStartAddr(),
+                                BB->getStartAddr())];
+    Active.back() = BB;
+  }
+  return true;
+}
+
+std::string DCBlockProfile::hash() const {
+  if (empty())
+    return "none";
+  typedef std::pair<std::pair<uint64_t, uint64_t>, uint64_t> EdgeCount;
+  std::vector<EdgeCount> Edges(EdgeCounts.begin(), EdgeCounts.end());
+  std::sort(Edges.begin(), Edges.end());
+  std::vector<std::pair<uint64_t, uint64_t>> Entries(EntryCounts.begin(),
+                                                     EntryCounts.end());
+  std::sort(Entries.begin(), Entries.end());
+  MD5 Hash;
+  for (const EdgeCount &Edge : Edges) {
+    std::string Field = utohexstr(Edge.first.first) + ">" +
+                        utohexstr(Edge.first.second) + ":" +
+                        utostr(Edge.second);
+    Hash.update(StringRef(Field.c_str(), Field.size() + 1));
+  }
+  for (const auto &Entry : Entries) {
+    std::string Field = utohexstr(Entry.first) + ":" + utostr(Entry.second);
+    Hash.update(StringRef(Field.c_str(), Field.size() + 1));
+  }
+  MD5::MD5Result Result;
+  Hash.final(Result);
+  SmallString<32> Str;
+  MD5::stringifyResult(Result, Str);
+  return Str.str();
+}
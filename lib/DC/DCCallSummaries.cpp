@@ -0,0 +1,209 @@
+//===-- lib/DC/DCCallSummaries.cpp - Register usage of callees ------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/DC/DCCallSummaries.h"
+#include "llvm/ADT/SCCIterator.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/DC/DCInstrSema.h"
+#include "llvm/DC/DCRegisterSema.h"
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCAnalysis/MCModule.h"
+#include "llvm/MC/MCAnalysis/MCRegisterUsage.h"
+#include "llvm/MC/MCInstrAnalysis.h"
+#include "llvm/MC/MCInstrInfo.h"
+#include "llvm/MC/MCRegisterInfo.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/ThreadPool.h"
+#include <algorithm>
+
+using namespace llvm;
+
+namespace {
+/// \brief A function of the direct call graph, or the root, which calls all
+/// of them so that scc_iterator visits every function.
+struct CallNode {
+  std::vector<CallNode *> Callees;
+  unsigned FuncIndex;
+};
+} // end anonymous namespace
+
+namespace llvm {
+template <> struct GraphTraits<CallNode *> {
+  typedef CallNode NodeType;
+  typedef std::vector<CallNode *>::iterator ChildIteratorType;
+  static NodeType *getEntryNode(CallNode *N) { return N; }
+  static ChildIteratorType child_begin(NodeType *N) {
+    return N->Callees.begin();
+  }
+  static ChildIteratorType child_end(NodeType *N) { return N->Callees.end(); }
+};
+} // end namespace llvm
+
+void DCCallSummaries::compute(const MCModule &MCM, const MCInstrAnalysis &MIA,
+                              DCRegisterSema &DRS, const DCStubTargets *Stubs,
+                              unsigned NumJobs) {
+  Summaries.clear();
+  SummaryIndices.clear();
+  const unsigned NumRegs = DRS.MRI.getNumRegs();
+  const BitVector &ABIRead = DRS.getCalleeReadRegs();
+  const BitVector &ABIClobbered = DRS.getCallClobberedRegs();
+  // The registers the calling convention has the callees read, and preserve,
+  // are the stack and frame pointers. The instructions don't always name them
+  // (say, an x86 RET), and the translation of a call and of its return do
+  // change the stack pointer: every call reads and clobbers them.
+  BitVector StackRegs = ABIRead;
+  StackRegs.reset(ABIClobbered);
+
+  std::vector<const MCFunction *> Funcs;
+  DenseMap<uint64_t, unsigned> FuncIndices;
+  for (const auto &F : MCM.funcs()) {
+    if (F->empty())
+      continue;
+    FuncIndices[F->getEntryBlock()->getStartAddr()] = Funcs.size();
+    Funcs.push_back(&*F);
+  }
+
+  // The registers each function reads and writes itself, and the functions
+  // it calls. That is where the time goes: the functions are scanned in
+  // parallel, each only writes its own entries.
+  std::vector<DCCallSummary> Own(Funcs.size());
+  std::vector<std::vector<unsigned>> Callees(Funcs.size());
+  ThreadPool Pool(NumJobs > 1 ? NumJobs - 1 : 0);
+  parallel_for(Pool, 0, Funcs.size(), [&](size_t I) {
+    MCRegisterUsage Usage(DRS.MII, DRS.MRI);
+    // Whether the function calls, or jumps, out of the module.
+    bool CallsOut = false;
+    bool AccessesMemory = false;
+    for (const MCBasicBlock *BB : *Funcs[I])
+      for (const MCDecodedInst &DI : *BB) {
+        Usage.addInst(DI.Inst);
+        const MCInstrDesc &Desc = DRS.MII.get(DI.Inst.getOpcode());
+        // The side effects of the calls and returns are their control flow:
+        // only the return address can be in memory.
+        if (Desc.isCall() || Desc.isReturn()
+                ? DRS.doCallsUseStack()
+                : Desc.mayLoad() || Desc.mayStore() ||
+                      Desc.hasUnmodeledSideEffects())
+          AccessesMemory = true;
+        const MCInstrAnalysis::Classification C = DI.classify(MIA);
+        if (C.isCall()) {
+          uint64_t Target;
+          if (!C.evaluateBranch(Target)) {
+            CallsOut = true;
+            continue;
+          }
+          if (Stubs) {
+            auto LI = Stubs->LocalAddrs.find(Target);
+            if (LI != Stubs->LocalAddrs.end())
+              Target = LI->second;
+          }
+          auto FI = FuncIndices.find(Target);
+          if (FI == FuncIndices.end())
+            CallsOut = true;
+          else
+            Callees[I].push_back(FI->second);
+        } else if (MIA.isIndirectBranch(DI.Inst)) {
+          // This may be a tail call, as well as a jump table.
+          CallsOut = true;
+        }
+      }
+
+    DCCallSummary &S = Own[I];
+    S.Read = StackRegs;
+    S.Clobbered = StackRegs;
+    S.Read.resize(NumRegs);
+    S.Clobbered.resize(NumRegs);
+    // Writing part of a register may keep the rest of it: the written
+    // registers are read, too.
+    BitVector Used = Usage.getRead();
+    Used |= Usage.getWritten();
+    for (int R = Used.find_first(); R != -1; R = Used.find_next(R))
+      for (MCRegAliasIterator AI(R, &DRS.MRI, true); AI.isValid(); ++AI)
+        S.Read.set(DRS.getLargestSuper(*AI));
+    const BitVector &Written = Usage.getWritten();
+    for (int R = Written.find_first(); R != -1; R = Written.find_next(R))
+      for (MCRegAliasIterator AI(R, &DRS.MRI, true); AI.isValid(); ++AI)
+        S.Clobbered.set(DRS.getLargestSuper(*AI));
+    if (CallsOut) {
+      S.Read |= ABIRead;
+      S.Clobbered |= ABIClobbered;
+    }
+    S.AccessesMemory = AccessesMemory || CallsOut;
+  });
+
+  std::vector<CallNode> Nodes(Funcs.size() + 1);
+  CallNode &Root = Nodes.back();
+  for (unsigned I = 0, E = Funcs.size(); I != E; ++I) {
+    Nodes[I].FuncIndex = I;
+    for (unsigned Callee : Callees[I])
+      Nodes[I].Callees.push_back(&Nodes[Callee]);
+    Root.Callees.push_back(&Nodes[I]);
+  }
+  Root.FuncIndex = ~0U;
+
+  // The components come callees first: those a component calls are done.
+  const unsigned NotDone = ~0U;
+  std::vector<unsigned> ComponentOf(Funcs.size(), NotDone);
+  for (scc_iterator<CallNode *> SI = scc_begin(&Root); !SI.isAtEnd(); ++SI) {
+    const std::vector<CallNode *> &Component = *SI;
+    if (Component.front() == &Root)
+      continue;
+    const unsigned Index = Summaries.size();
+    for (CallNode *N : Component)
+      ComponentOf[N->FuncIndex] = Index;
+    DCCallSummary S;
+    S.Read.resize(NumRegs);
+    S.Clobbered.resize(NumRegs);
+    for (CallNode *N : Component) {
+      S.Read |= Own[N->FuncIndex].Read;
+      S.Clobbered |= Own[N->FuncIndex].Clobbered;
+      S.AccessesMemory |= Own[N->FuncIndex].AccessesMemory;
+      for (CallNode *Callee : N->Callees) {
+        const unsigned CalleeIndex = ComponentOf[Callee->FuncIndex];
+        if (CalleeIndex == Index)
+          continue;
+        assert(CalleeIndex != NotDone && "Callee summarized after its caller");
+        S.Read |= Summaries[CalleeIndex].Read;
+        S.Clobbered |= Summaries[CalleeIndex].Clobbered;
+        S.AccessesMemory |= Summaries[CalleeIndex].AccessesMemory;
+      }
+    }
+    Summaries.push_back(std::move(S));
+  }
+
+  for (unsigned I = 0, E = Funcs.size(); I != E; ++I)
+    SummaryIndices[Funcs[I]->getEntryBlock()->getStartAddr()] = ComponentOf[I];
+}
+
+std::string DCCallSummaries::hash() const {
+  if (empty())
+    return "none";
+  std::vector<std::pair<uint64_t, unsigned>> Indices(SummaryIndices.begin(),
+                                                     SummaryIndices.end());
+  std::sort(Indices.begin(), Indices.end());
+  MD5 Hash;
+  for (const auto &AddrIndex : Indices) {
+    const DCCallSummary &S = Summaries[AddrIndex.second];
+    std::string Field = utohexstr(AddrIndex.first) + ":";
+    for (int R = S.Read.find_first(); R != -1; R = S.Read.find_next(R))
+      Field += utostr(R) + ",";
+    Field += ":";
+    for (int R = S.Clobbered.find_first(); R != -1;
+         R = S.Clobbered.find_next(R))
+      Field += utostr(R) + ",";
+    Field += S.AccessesMemory ? ":mem" : ":nomem";
+    Hash.update(StringRef(Field.c_str(), Field.size() + 1));
+  }
+  MD5::MD5Result Result;
+  Hash.final(Result);
+  SmallString<32> Str;
+  MD5::stringifyResult(Result, Str);
+  return Str.str();
+}
@@ -0,0 +1,160 @@
+//===-- lib/DC/DCColdOutlining.cpp - Cold path outlining --------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/DC/DCColdOutlining.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringSwitch.h"
+#include "llvm/IR/CFG.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/Intrinsics.h"
+#include "llvm/Transforms/Utils/CodeExtractor.h"
+#include <algorithm>
+
+using namespace llvm;
+
+#define DEBUG_TYPE "dc-cold-outlining"
+
+STATISTIC(NumColdRegions, "Number of cold regions outlined");
+STATISTIC(NumColdInsts, "Number of instructions in the outlined regions");
+
+// An outlined region costs a call, and a function: the untranslated blocks,
+// a trap alone, aren't worth it.
+static const unsigned MinColdRegionInsts = 8;
+
+// The names are those of the external functions, without the leading
+// underscore of Mach-O.
+static bool isColdFunction(const Function &F) {
+  if (F.doesNotReturn() || F.getIntrinsicID() == Intrinsic::trap)
+    return true;
+  StringRef Name = F.getName();
+  if (Name.startswith("swift_") && Name.endswith("Failure"))
+    return true;
+  return StringSwitch<bool>(Name)
+      .Cases("objc_exception_throw", "objc_exception_rethrow",
+             "objc_terminate", true)
+      .Cases("__assert_rtn", "__assert_fail", "__stack_chk_fail", true)
+      .Cases("__cxa_throw", "__cxa_rethrow", "__cxa_bad_cast",
+             "__cxa_bad_typeid", "_ZSt9terminatev", true)
+      .Cases("abort", "exit", "_exit", "_Exit", "quick_exit", true)
+      .Cases("err", "errx", "verr", "verrx", true)
+      .Cases("longjmp", "_longjmp", "siglongjmp", "pthread_exit", true)
+      .Default(false);
+}
+
+static bool callsColdFunction(const BasicBlock &BB) {
+  for (const Instruction &I : BB)
+    if (const CallInst *CI = dyn_cast<CallInst>(&I))
+      if (const Function *Callee = CI->getCalledFunction())
+        if (isColdFunction(*Callee))
+          return true;
+  return false;
+}
+
+bool llvm::outlineColdPaths(Function &F) {
+  // A block that can only go to a cold one is cold as well: e.g. the block of
+  // the call instruction, before its call block, or the last translated block
+  // before the one that traps. The entry dominates everything: it would take
+  // the whole function.
+  BasicBlock *Entry = &F.getEntryBlock();
+  SmallPtrSet<BasicBlock *, 4> RootSet;
+  for (BasicBlock &BB : F) {
+    if (&BB == Entry || !callsColdFunction(BB))
+      continue;
+    BasicBlock *Root = &BB;
+    while (BasicBlock *Pred = Root->getSinglePredecessor()) {
+      if (Pred == Entry || Pred->getTerminator()->getNumSuccessors() != 1)
+        break;
+      Root = Pred;
+    }
+    RootSet.insert(Root);
+  }
+  if (RootSet.empty())
+    return false;
+
+  // The regions are the subtrees of the dominator tree rooted at the cold
+  // blocks. The roots are visited in preorder: those nested in the region of
+  // another root are part of it, if it is outlined, and the others are
+  // disjoint, so that outlining one leaves the others intact.
+  DominatorTree DT(F);
+  SmallVector<DomTreeNode *, 4> Roots;
+  for (BasicBlock *Root : RootSet)
+    if (DomTreeNode *RootNode = DT.getNode(Root))
+      Roots.push_back(RootNode);
+  DT.updateDFSNumbers();
+  std::sort(Roots.begin(), Roots.end(),
+            [](const DomTreeNode *L, const DomTreeNode *R) {
+              return L->getDFSNumIn() < R->getDFSNumIn();
+            });
+  SmallPtrSet<BasicBlock *, 4> OutlinedRoots;
+  std::vector<SmallVector<BasicBlock *, 8>> Regions;
+  for (DomTreeNode *RootNode : Roots) {
+    BasicBlock *Root = RootNode->getBlock();
+    bool IsNested = false;
+    for (DomTreeNode *N = RootNode->getIDom(); N && !IsNested;
+         N = N->getIDom())
+      IsNested = OutlinedRoots.count(N->getBlock());
+    if (IsNested || isa<ReturnInst>(Root->getTerminator()))
+      continue;
+
+    SmallVector<BasicBlock *, 8> Descendants;
+    DT.getDescendants(Root, Descendants);
+    // The blocks that return stay in the function, which the outlined one
+    // then branches back to.
+    SmallVector<BasicBlock *, 8> Region;
+    SmallPtrSet<BasicBlock *, 8> InRegion;
+    unsigned NumInsts = 0;
+    for (BasicBlock *BB : Descendants) {
+      if (isa<ReturnInst>(BB->getTerminator()))
+        continue;
+      Region.push_back(BB);
+      InRegion.insert(BB);
+      NumInsts += BB->size();
+    }
+    if (NumInsts < MinColdRegionInsts)
+      continue;
+    // Only the root can be entered from outside, which the unreachable
+    // blocks, not in the dominator tree, could break.
+    bool IsSingleEntry = true;
+    for (BasicBlock *BB : Region)
+      if (BB != Root)
+        for (BasicBlock *Pred : predecessors(BB))
+          IsSingleEntry &= InRegion.count(Pred) != 0;
+    if (!IsSingleEntry)
+      continue;
+    // The root goes first: it is the entry of the outlined function.
+    std::swap(Region.front(), *std::find(Region.begin(), Region.end(), Root));
+    // The nested roots only stay in the function if this one goes.
+    if (!CodeExtractor(Region).isEligible())
+      continue;
+    Regions.push_back(std::move(Region));
+    OutlinedRoots.insert(Root);
+  }
+
+  bool Changed = false;
+  for (const auto &Region : Regions) {
+    CodeExtractor CE(Region);
+    Function *Cold = CE.extractCodeRegion();
+    if (!Cold)
+      continue;
+    Cold->setName(F.getName() + ".cold");
+    Cold->addFnAttr(Attribute::Cold);
+    Cold->addFnAttr(Attribute::NoInline);
+    Cold->addFnAttr(Attribute::MinSize);
+    Cold->addFnAttr(Attribute::OptimizeForSize);
+    ++NumColdRegions;
+    for (const BasicBlock &BB : *Cold)
+      NumColdInsts += BB.size();
+    Changed = true;
+  }
+  return Changed;
+}
@@ -0,0 +1,278 @@
+//===-- lib/DC/DCDecompilerSession.cpp - Embeddable decompiler ------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/DC/DCDecompilerSession.h"
+#include "llvm/ADT/Triple.h"
+#include "llvm/DC/DCCallSummaries.h"
+#include "llvm/DC/DCMachOObject.h"
+#include "llvm/DC/DCRegisterSema.h"
+#include "llvm/MC/MCAnalysis/MCCachingDisassembler.h"
+#include "llvm/MC/MCAnalysis/MCModule.h"
+#include "llvm/MC/MCAnalysis/MCObjectSymbolizer.h"
+#include "llvm/MC/MCAsmInfo.h"
+#include "llvm/MC/MCContext.h"
+#include "llvm/MC/MCDisassembler.h"
+#include "llvm/MC/MCInstPrinter.h"
+#include "llvm/MC/MCInstrAnalysis.h"
+#include "llvm/MC/MCInstrInfo.h"
+#include "llvm/MC/MCObjectDisassembler.h"
+#include "llvm/MC/MCObjectFileInfo.h"
+#include "llvm/MC/MCRegisterInfo.h"
+#include "llvm/MC/MCSubtargetInfo.h"
+#include "llvm/Object/MachO.h"
+#include "llvm/Object/MachOBindingIndex.h"
+#include "llvm/Object/MachOUniversal.h"
+#include "llvm/Support/TargetRegistry.h"
+
+using namespace llvm;
+using namespace object;
+
+DCDecompilerTarget::DCDecompilerTarget(const Target *TheTarget,
+                                       StringRef TripleName)
+    : TheTarget(TheTarget), TripleName(TripleName), DL("") {}
+
+DCDecompilerTarget::~DCDecompilerTarget() {}
+
+std::unique_ptr<DCDecompilerTarget>
+DCDecompilerTarget::create(StringRef TripleName, std::string &Error) {
+  const Target *TheTarget = TargetRegistry::lookupTarget(TripleName, Error);
+  if (!TheTarget)
+    return nullptr;
+
+  std::unique_ptr<DCDecompilerTarget> DT(
+      new DCDecompilerTarget(TheTarget, TripleName));
+  const std::string &TN = DT->TripleName;
+  DT->MRI.reset(TheTarget->createMCRegInfo(TN));
+  if (!DT->MRI) {
+    Error = "no register info for target " + TN;
+    return nullptr;
+  }
+  DT->MAI.reset(TheTarget->createMCAsmInfo(*DT->MRI, TN));
+  if (!DT->MAI) {
+    Error = "no assembly info for target " + TN;
+    return nullptr;
+  }
+  DT->STI.reset(TheTarget->createMCSubtargetInfo(TN, "", ""));
+  if (!DT->STI) {
+    Error = "no subtarget info for target " + TN;
+    return nullptr;
+  }
+  DT->MII.reset(TheTarget->createMCInstrInfo());
+  if (!DT->MII) {
+    Error = "no instruction info for target " + TN;
+    return nullptr;
+  }
+  DT->MIA.reset(TheTarget->createMCInstrAnalysis(DT->MII.get()));
+  return DT;
+}
+
+DCDecompilerSession::DCDecompilerSession(const DCDecompilerTarget &DTarget,
+                                         std::unique_ptr<DCRegisterSema> DRS,
+                                         std::unique_ptr<DCInstrSema> DIS)
+    : DTarget(DTarget), DRS(std::move(DRS)), DIS(std::move(DIS)) {}
+
+DCDecompilerSession::~DCDecompilerSession() {}
+
+// Create the DC semantics of DTarget, in DRS and the result, or return null.
+static std::unique_ptr<DCInstrSema>
+createSema(const DCDecompilerTarget &DTarget,
+           std::unique_ptr<DCRegisterSema> &DRS) {
+  const Target &T = DTarget.getTarget();
+  DRS.reset(T.createDCRegisterSema(DTarget.getTripleName(),
+                                   DTarget.getRegisterInfo(),
+                                   DTarget.getInstrInfo(),
+                                   DTarget.getDataLayout()));
+  if (!DRS)
+    return nullptr;
+  return std::unique_ptr<DCInstrSema>(T.createDCInstrSema(
+      DTarget.getTripleName(), *DRS, DTarget.getRegisterInfo(),
+      DTarget.getInstrInfo()));
+}
+
+std::unique_ptr<DCDecompilerSession>
+DCDecompilerSession::create(const DCDecompilerTarget &DTarget,
+                            std::string &Error) {
+  std::unique_ptr<DCRegisterSema> DRS;
+  std::unique_ptr<DCInstrSema> DIS = createSema(DTarget, DRS);
+  if (!DIS) {
+    Error = (DRS ? "no dc instruction sema for target "
+                 : "no dc register sema for target ") +
+            DTarget.getTripleName();
+    return nullptr;
+  }
+  return std::unique_ptr<DCDecompilerSession>(
+      new DCDecompilerSession(DTarget, std::move(DRS), std::move(DIS)));
+}
+
+std::unique_ptr<Module>
+DCDecompilerSession::decompile(MemoryBufferRef Buffer, StringRef ArchName,
+                               LLVMContext &Ctx, const Options &Opts,
+                               std::string &Error) {
+  ErrorOr<std::unique_ptr<Binary>> BinaryOrErr = createBinary(Buffer);
+  if (std::error_code EC = BinaryOrErr.getError()) {
+    Error = EC.message();
+    return nullptr;
+  }
+  std::unique_ptr<Binary> Bin = std::move(*BinaryOrErr);
+  std::unique_ptr<MachOObjectFile> Slice;
+  if (MachOUniversalBinary *UB = dyn_cast<MachOUniversalBinary>(Bin.get())) {
+    auto SliceOrErr = UB->getObjectForArch(ArchName);
+    if (std::error_code EC = SliceOrErr.getError()) {
+      Error = (ArchName + ": " + EC.message()).str();
+      return nullptr;
+    }
+    Slice = std::move(*SliceOrErr);
+  }
+  const ObjectFile *Obj = Slice ? Slice.get() : dyn_cast<ObjectFile>(Bin.get());
+  if (!Obj) {
+    Error = "unrecognized file type";
+    return nullptr;
+  }
+  return decompile(*Obj, Ctx, Opts, Error);
+}
+
+DCDisassembly::DCDisassembly() {}
+
+DCDisassembly::~DCDisassembly() {}
+
+uint64_t DCDisassembly::getEntrypoint() const { return MOS->getEntrypoint(); }
+
+std::unique_ptr<Module>
+DCDecompilerSession::decompile(const ObjectFile &Obj, LLVMContext &Ctx,
+                               const Options &Opts, std::string &Error) {
+  std::unique_ptr<DCDisassembly> D = disassemble(Obj, Opts, Error);
+  if (!D)
+    return nullptr;
+  return translate(*D, Ctx, Opts);
+}
+
+std::unique_ptr<DCDisassembly>
+DCDecompilerSession::disassemble(const ObjectFile &Obj, const Options &Opts,
+                                 std::string &Error) {
+  const Target &TheTarget = DTarget.getTarget();
+  const std::string &TripleName = DTarget.getTripleName();
+  const MCRegisterInfo &MRI = DTarget.getRegisterInfo();
+  const MCSubtargetInfo &STI = DTarget.getSubtargetInfo();
+  const MCInstrInfo &MII = DTarget.getInstrInfo();
+  const MCInstrAnalysis *MIA = DTarget.getInstrAnalysis();
+  if (!MIA) {
+    Error = "no instruction analysis for target " + TripleName;
+    return nullptr;
+  }
+
+  // What depends on the object, or keeps state while disassembling it, is
+  // created for it.
+  std::unique_ptr<DCDisassembly> D(new DCDisassembly());
+  D->MOFI.reset(new MCObjectFileInfo);
+  D->MCCtx.reset(new MCContext(&DTarget.getAsmInfo(), &MRI, D->MOFI.get()));
+  MCContext &MCCtx = *D->MCCtx;
+  D->DisAsm.reset(TheTarget.createMCDisassembler(STI, MCCtx));
+  if (!D->DisAsm) {
+    Error = "no disassembler for target " + TripleName;
+    return nullptr;
+  }
+  if (Opts.DisassemblyCache) {
+    D->DisAsmImpl = std::move(D->DisAsm);
+    // AArch64 instructions are all 4 bytes wide.
+    const Triple::ArchType Arch = Triple(TripleName).getArch();
+    D->DisAsm.reset(new MCCachingDisassembler(
+        *D->DisAsmImpl, STI,
+        Arch == Triple::aarch64 || Arch == Triple::aarch64_be));
+  }
+  D->MIP.reset(TheTarget.createMCInstPrinter(
+      Triple(TripleName), 0, DTarget.getAsmInfo(), MII, MRI));
+  if (!D->MIP) {
+    Error = "no instprinter for target " + TripleName;
+    return nullptr;
+  }
+  std::unique_ptr<MCRelocationInfo> RelInfo(
+      TheTarget.createMCRelocationInfo(TripleName, MCCtx));
+  if (!RelInfo) {
+    Error = "no relocation info for target " + TripleName;
+    return nullptr;
+  }
+  D->MOS.reset(
+      TheTarget.createMCObjectSymbolizer(MCCtx, Obj, std::move(RelInfo)));
+  if (!D->MOS) {
+    Error = "no object symbolizer for target " + TripleName;
+    return nullptr;
+  }
+
+  if (const MachOObjectFile *MachO = dyn_cast<MachOObjectFile>(&Obj)) {
+    MachOBindingIndex Binds(*MachO);
+    resolveMachOStubs(*MachO, Binds, *D->MOS, D->Stubs);
+    collectMachODataSections(*MachO, Opts.SectionGlobals, D->DataSections);
+  }
+
+  D->OD.reset(new MCObjectDisassembler(Obj, *D->DisAsm, *MIA));
+  // The caching disassembler isn't thread-safe.
+  if (!Opts.DisassemblyCache ||
+      static_cast<MCCachingDisassembler &>(*D->DisAsm).isThreadSafe())
+    D->OD->setNumJobs(Opts.MCJobs);
+  D->MCM.reset(D->OD->buildModule());
+  if (!D->MCM) {
+    Error = "no code to disassemble";
+    return nullptr;
+  }
+  return D;
+}
+
+std::unique_ptr<Module> DCDecompilerSession::translate(DCDisassembly &D,
+                                                       LLVMContext &Ctx,
+                                                       const Options &Opts) {
+  const std::string &TripleName = DTarget.getTripleName();
+  const MCInstrAnalysis *MIA = DTarget.getInstrAnalysis();
+  MCModule &MCM = *D.MCM;
+  // Only report the unknown instructions of this input.
+  DIS->clearUnknownInstCounts();
+
+  DCTranslator DT(Ctx, DTarget.getDataLayout(), Opts.OptLevel, *DIS, *DRS,
+                  *D.MIP, DTarget.getSubtargetInfo(), MCM, D.OD.get());
+  if (Opts.DCJobs > 1 || Opts.Cache)
+    DT.setNumJobs(Opts.DCJobs, [&](std::unique_ptr<DCRegisterSema> &WorkerDRS) {
+      return createSema(DTarget, WorkerDRS);
+    });
+  if (Opts.Cache)
+    DT.setTranslationCache(Opts.Cache, TripleName);
+  DT.setStubTargets(&D.Stubs);
+  DT.setExternalWrappers(Opts.ExternalWrappers);
+  DT.setDataSections(&D.DataSections);
+  if (Opts.FunctionNames)
+    DT.setFunctionNames(Opts.FunctionNames);
+  if (Opts.ObjCMessages)
+    DT.setObjCMessageIndex(Opts.ObjCMessages);
+  DCCallSummaries Summaries;
+  if (Opts.CallSummaries) {
+    Summaries.compute(MCM, *MIA, *DRS, &D.Stubs, Opts.DCJobs);
+    DT.setCallSummaries(&Summaries);
+  }
+  if (Opts.ElideCalleeSaved)
+    DT.setCalleeSavedSpillAnalysis(MIA);
+
+  uint64_t Entrypoint = Opts.Entrypoint;
+  if (!Entrypoint)
+    Entrypoint = D.getEntrypoint();
+  bool EntrypointStreamed = false;
+  if (Opts.Streamer)
+    DT.setModuleStreaming(Opts.StreamFunctions, Opts.StreamInsts,
+                          [&](Module &M) {
+                            if (Function *F = DT.getFunctionAt(Entrypoint))
+                              EntrypointStreamed |= !F->isDeclaration();
+                            Opts.Streamer(M);
+                          });
+  DT.translateAllKnownFunctions();
+
+  Function *MainFn = DT.getFunctionAt(Entrypoint);
+  // The entrypoint can be defined in a module that was already streamed out.
+  if (!MainFn && EntrypointStreamed)
+    MainFn = DT.getOrDeclareFunctionAt(Entrypoint);
+  if (MainFn)
+    DT.createMainFunctionWrapper(MainFn);
+  return DT.takeCurrentModule();
+}
@@ -0,0 +1,408 @@
+//===-- DCExternalSignatures.cpp - External call types ----------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/DC/DCExternalSignatures.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include <algorithm>
+#include <vector>
+
+using namespace llvm;
+
+static cl::opt<std::string> ExternalSignaturesFile(
+    "dc-external-signatures",
+    cl::desc("Read more signatures of external functions, for "
+             "-enable-dc-typed-external-calls, from <file>"),
+    cl::value_desc("file"), cl::init(""));
+
+namespace {
+struct BuiltinSignature {
+  const char *Name;
+  const char *Sig;
+};
+} // end anonymous namespace
+
+// The result, then the arguments, as in DCExternalSignatures.h.
+static const BuiltinSignature BuiltinSignatures[] = {
+    // libSystem: the C library.
+    {"strlen", "lp"},
+    {"strnlen", "lpl"},
+    {"strcmp", "ipp"},
+    {"strncmp", "ippl"},
+    {"strcasecmp", "ipp"},
+    {"strncasecmp", "ippl"},
+    {"strcpy", "ppp"},
+    {"strncpy", "pppl"},
+    {"strlcpy", "lppl"},
+    {"strcat", "ppp"},
+    {"strncat", "pppl"},
+    {"strlcat", "lppl"},
+    {"strchr", "ppi"},
+    {"strrchr", "ppi"},
+    {"strstr", "ppp"},
+    {"strdup", "pp"},
+    {"strndup", "ppl"},
+    {"strerror", "pi"},
+    {"memcpy", "pppl"},
+    {"memmove", "pppl"},
+    {"memset", "ppil"},
+    {"memcmp", "ippl"},
+    {"memchr", "ppil"},
+    {"bzero", "vpl"},
+    {"bcopy", "vppl"},
+    {"malloc", "pl"},
+    {"calloc", "pll"},
+    {"realloc", "ppl"},
+    {"reallocf", "ppl"},
+    {"valloc", "pl"},
+    {"free", "vp"},
+    {"malloc_size", "lp"},
+    {"abort", "v"},
+    {"exit", "vi"},
+    {"_exit", "vi"},
+    {"atexit", "ip"},
+    {"atoi", "ip"},
+    {"atol", "lp"},
+    {"atof", "dp"},
+    {"strtol", "lppi"},
+    {"strtoul", "lppi"},
+    {"strtoll", "lppi"},
+    {"strtoull", "lppi"},
+    {"strtod", "dpp"},
+    {"strtof", "fpp"},
+    {"getenv", "pp"},
+    {"setenv", "ippi"},
+    {"unsetenv", "ip"},
+    {"puts", "ip"},
+    {"putchar", "ii"},
+    {"getchar", "i"},
+    {"fopen", "ppp"},
+    {"fdopen", "pip"},
+    {"fclose", "ip"},
+    {"fflush", "ip"},
+    {"fgets", "ppip"},
+    {"fputs", "ipp"},
+    {"fputc", "iip"},
+    {"fgetc", "ip"},
+    {"fread", "lpllp"},
+    {"fwrite", "lpllp"},
+    {"fseek", "ipli"},
+    {"ftell", "lp"},
+    {"feof", "ip"},
+    {"ferror", "ip"},
+    {"read", "lipl"},
+    {"write", "lipl"},
+    {"close", "ii"},
+    {"lseek", "lili"},
+    {"unlink", "ip"},
+    {"getpid", "i"},
+    {"usleep", "ii"},
+    {"sleep", "ii"},
+    {"time", "lp"},
+    {"rand", "i"},
+    {"srand", "vi"},
+    {"random", "l"},
+    {"arc4random", "i"},
+    {"arc4random_uniform", "ii"},
+    {"qsort", "vpllp"},
+    {"__error", "p"},
+    {"__stack_chk_fail", "v"},
+    {"__cxa_atexit", "ippp"},
+    {"dlopen", "ppi"},
+    {"dlsym", "ppp"},
+    {"dlclose", "ip"},
+    // libSystem: the math library.
+    {"sqrt", "dd"},
+    {"sqrtf", "ff"},
+    {"sin", "dd"},
+    {"sinf", "ff"},
+    {"cos", "dd"},
+    {"cosf", "ff"},
+    {"tan", "dd"},
+    {"atan", "dd"},
+    {"atan2", "ddd"},
+    {"exp", "dd"},
+    {"log", "dd"},
+    {"log10", "dd"},
+    {"pow", "ddd"},
+    {"powf", "fff"},
+    {"fmod", "ddd"},
+    {"floor", "dd"},
+    {"floorf", "ff"},
+    {"ceil", "dd"},
+    {"ceilf", "ff"},
+    {"round", "dd"},
+    {"roundf", "ff"},
+    {"fabs", "dd"},
+    {"fabsf", "ff"},
+    // libSystem: threads, dispatch and blocks.
+    {"pthread_self", "p"},
+    {"pthread_mutex_init", "ipp"},
+    {"pthread_mutex_destroy", "ip"},
+    {"pthread_mutex_lock", "ip"},
+    {"pthread_mutex_trylock", "ip"},
+    {"pthread_mutex_unlock", "ip"},
+    {"pthread_once", "ipp"},
+    {"pthread_create", "ipppp"},
+    {"pthread_join", "ipp"},
+    {"pthread_getspecific", "pl"},
+    {"pthread_setspecific", "ilp"},
+    {"os_unfair_lock_lock", "vp"},
+    {"os_unfair_lock_unlock", "vp"},
+    {"dispatch_once", "vpp"},
+    {"dispatch_async", "vpp"},
+    {"dispatch_sync", "vpp"},
+    {"dispatch_after", "vlpp"},
+    {"dispatch_get_global_queue", "pll"},
+    {"dispatch_queue_create", "ppp"},
+    {"dispatch_time", "lll"},
+    {"dispatch_semaphore_create", "pl"},
+    {"dispatch_semaphore_signal", "lp"},
+    {"dispatch_semaphore_wait", "lpl"},
+    {"dispatch_group_create", "p"},
+    {"dispatch_group_async", "vppp"},
+    {"dispatch_group_notify", "vppp"},
+    {"dispatch_group_wait", "lpl"},
+    {"dispatch_retain", "vp"},
+    {"dispatch_release", "vp"},
+    {"dispatch_main", "v"},
+    {"_Block_copy", "pp"},
+    {"_Block_release", "vp"},
+    {"_Block_object_assign", "vppi"},
+    {"_Block_object_dispose", "vpi"},
+    // CoreFoundation.
+    {"CFRetain", "pp"},
+    {"CFRelease", "vp"},
+    {"CFAutorelease", "pp"},
+    {"CFGetRetainCount", "lp"},
+    {"CFGetTypeID", "lp"},
+    {"CFHash", "lp"},
+    {"CFEqual", "cpp"},
+    {"CFCopyDescription", "pp"},
+    {"CFShow", "vp"},
+    {"CFStringGetLength", "lp"},
+    {"CFStringGetCStringPtr", "ppi"},
+    {"CFStringGetCString", "cppli"},
+    {"CFStringCreateWithCString", "pppi"},
+    {"CFStringCreateCopy", "ppp"},
+    {"CFStringCompare", "lppl"},
+    {"CFStringHasPrefix", "cpp"},
+    {"CFStringHasSuffix", "cpp"},
+    {"CFArrayGetCount", "lp"},
+    {"CFArrayGetValueAtIndex", "ppl"},
+    {"CFArrayAppendValue", "vpp"},
+    {"CFArrayCreateMutable", "pplp"},
+    {"CFDictionaryGetCount", "lp"},
+    {"CFDictionaryGetValue", "ppp"},
+    {"CFDictionaryContainsKey", "cpp"},
+    {"CFDictionarySetValue", "vppp"},
+    {"CFDictionaryCreateMutable", "pplpp"},
+    {"CFDataGetLength", "lp"},
+    {"CFDataGetBytePtr", "pp"},
+    {"CFDataCreate", "pppl"},
+    {"CFNumberCreate", "pplp"},
+    {"CFNumberGetValue", "cplp"},
+    {"CFBooleanGetValue", "cp"},
+    {"CFBundleGetMainBundle", "p"},
+    {"CFBundleGetValueForInfoDictionaryKey", "ppp"},
+    {"CFRunLoopGetCurrent", "p"},
+    {"CFRunLoopGetMain", "p"},
+    {"CFRunLoopRun", "v"},
+    {"CFAbsoluteTimeGetCurrent", "d"},
+    // Foundation.
+    {"NSStringFromClass", "pp"},
+    {"NSClassFromString", "pp"},
+    {"NSStringFromSelector", "pp"},
+    {"NSSelectorFromString", "pp"},
+    {"NSStringFromProtocol", "pp"},
+    {"NSProtocolFromString", "pp"},
+    {"NSSearchPathForDirectoriesInDomains", "pllc"},
+    {"NSHomeDirectory", "p"},
+    {"NSTemporaryDirectory", "p"},
+    {"NSUserName", "p"},
+    {"NSApplicationMain", "iip"},
+    {"UIApplicationMain", "iippp"},
+    // The Objective-C runtime.
+    {"objc_getClass", "pp"},
+    {"objc_lookUpClass", "pp"},
+    {"objc_getMetaClass", "pp"},
+    {"objc_getProtocol", "pp"},
+    {"objc_getAssociatedObject", "ppp"},
+    {"objc_setAssociatedObject", "vpppl"},
+    {"object_getClass", "pp"},
+    {"object_getClassName", "pp"},
+    {"object_getIvar", "ppp"},
+    {"object_setIvar", "vppp"},
+    {"class_getName", "pp"},
+    {"class_getSuperclass", "pp"},
+    {"class_getInstanceMethod", "ppp"},
+    {"class_getClassMethod", "ppp"},
+    {"class_getInstanceSize", "lp"},
+    {"class_respondsToSelector", "cpp"},
+    {"class_conformsToProtocol", "cpp"},
+    {"class_addMethod", "cpppp"},
+    {"class_replaceMethod", "ppppp"},
+    {"sel_registerName", "pp"},
+    {"sel_getName", "pp"},
+    {"method_getImplementation", "pp"},
+    {"method_setImplementation", "ppp"},
+    {"method_exchangeImplementations", "vpp"},
+    {"objc_alloc", "pp"},
+    {"objc_alloc_init", "pp"},
+    {"objc_allocWithZone", "pp"},
+    {"objc_opt_new", "pp"},
+    {"objc_opt_self", "pp"},
+    {"objc_opt_class", "pp"},
+    {"objc_opt_isKindOfClass", "cpp"},
+    {"objc_opt_respondsToSelector", "cpp"},
+    {"objc_getProperty", "ppplc"},
+    {"objc_setProperty", "vpplpcc"},
+    {"objc_setProperty_atomic", "vpppl"},
+    {"objc_setProperty_nonatomic", "vpppl"},
+    {"objc_setProperty_atomic_copy", "vpppl"},
+    {"objc_setProperty_nonatomic_copy", "vpppl"},
+    {"objc_copyStruct", "vpplcc"},
+    {"objc_enumerationMutation", "vp"},
+    {"objc_sync_enter", "ip"},
+    {"objc_sync_exit", "ip"},
+    {"objc_exception_throw", "vp"},
+    {"objc_exception_rethrow", "v"},
+    {"objc_begin_catch", "pp"},
+    {"objc_end_catch", "v"},
+    {"objc_terminate", "v"},
+    {"objc_retain", "pp"},
+    {"objc_retainAutoreleasedReturnValue", "pp"},
+    {"objc_unsafeClaimAutoreleasedReturnValue", "pp"},
+    {"objc_retainBlock", "pp"},
+    {"objc_release", "vp"},
+    {"objc_autorelease", "pp"},
+    {"objc_autoreleaseReturnValue", "pp"},
+    {"objc_retainAutorelease", "pp"},
+    {"objc_retainAutoreleaseReturnValue", "pp"},
+    {"objc_autoreleasePoolPush", "p"},
+    {"objc_autoreleasePoolPop", "vp"},
+    {"objc_loadWeak", "pr"},
+    {"objc_loadWeakRetained", "pr"},
+    {"objc_destroyWeak", "vr"},
+    {"objc_storeWeak", "prp"},
+    {"objc_initWeak", "prp"},
+    {"objc_storeStrong", "vrp"},
+    {"objc_moveWeak", "vrr"},
+    {"objc_copyWeak", "vrr"},
+};
+
+// Check that \p Sig is a result, then arguments, none of them void.
+static bool isValidSignature(StringRef Sig) {
+  if (Sig.empty() || Sig.find_first_not_of("vcilprfd") != StringRef::npos)
+    return false;
+  return Sig.find('v', 1) == StringRef::npos;
+}
+
+DCExternalSignatures::DCExternalSignatures() {
+  for (const BuiltinSignature &B : BuiltinSignatures) {
+    assert(isValidSignature(B.Sig) && "Invalid builtin signature!");
+    Signatures[B.Name] = B.Sig;
+  }
+  computeHash();
+}
+
+bool DCExternalSignatures::parse(StringRef Buffer, StringRef BufferName,
+                                 std::string &Error) {
+  unsigned LineNo = 0;
+  while (!Buffer.empty()) {
+    StringRef Line;
+    std::tie(Line, Buffer) = Buffer.split('\n');
+    ++LineNo;
+    Line = Line.split('#').first.trim();
+    if (Line.empty())
+      continue;
+    StringRef Name, Sig;
+    std::tie(Name, Sig) = Line.split(' ');
+    Sig = Sig.trim();
+    if (Name.empty() || !isValidSignature(Sig)) {
+      Error = (BufferName + ":" + Twine(LineNo) +
+               ": expected '<name> <signature>', got '" + Line + "'").str();
+      return false;
+    }
+    Signatures[Name] = Sig;
+  }
+  computeHash();
+  return true;
+}
+
+void DCExternalSignatures::computeHash() {
+  std::vector<std::pair<StringRef, StringRef>> Sorted;
+  for (const auto &S : Signatures)
+    Sorted.push_back(std::make_pair(S.getKey(), StringRef(S.getValue())));
+  std::sort(Sorted.begin(), Sorted.end());
+  MD5 H;
+  for (const auto &NameSig : Sorted) {
+    std::string Field = (NameSig.first + " " + NameSig.second).str();
+    H.update(StringRef(Field.c_str(), Field.size() + 1));
+  }
+  MD5::MD5Result Result;
+  H.final(Result);
+  SmallString<32> Str;
+  MD5::stringifyResult(Result, Str);
+  Hash = Str.str();
+}
+
+namespace {
+struct LoadedSignatures {
+  DCExternalSignatures Sigs;
+
+  LoadedSignatures() {
+    if (!ExternalSignaturesFile.empty()) {
+      ErrorOr<std::unique_ptr<MemoryBuffer>> BufOrErr =
+          MemoryBuffer::getFile(ExternalSignaturesFile);
+      if (std::error_code EC = BufOrErr.getError())
+        report_fatal_error("DC: unable to read " + ExternalSignaturesFile +
+                           ": " + EC.message());
+      std::string Error;
+      if (!Sigs.parse((*BufOrErr)->getBuffer(), ExternalSignaturesFile, Error))
+        report_fatal_error("DC: " + Error);
+    }
+  }
+};
+} // end anonymous namespace
+
+static ManagedStatic<LoadedSignatures> Loaded;
+
+const DCExternalSignatures &DCExternalSignatures::get() {
+  return Loaded->Sigs;
+}
+
+FunctionType *DCExternalSignatures::getFunctionType(StringRef Sig,
+                                                    LLVMContext &Ctx) {
+  assert(isValidSignature(Sig) && "Invalid signature!");
+  auto GetType = [&](char C) -> Type * {
+    switch (C) {
+    case 'v': return Type::getVoidTy(Ctx);
+    case 'c': return Type::getInt8Ty(Ctx);
+    case 'i': return Type::getInt32Ty(Ctx);
+    case 'l': return Type::getInt64Ty(Ctx);
+    case 'p': return Type::getInt8PtrTy(Ctx);
+    case 'r': return Type::getInt8PtrTy(Ctx)->getPointerTo();
+    case 'f': return Type::getFloatTy(Ctx);
+    case 'd': return Type::getDoubleTy(Ctx);
+    }
+    llvm_unreachable("Invalid signature type!");
+  };
+  SmallVector<Type *, 8> Params;
+  for (char C : Sig.drop_front())
+    Params.push_back(GetType(C));
+  return FunctionType::get(GetType(Sig[0]), Params, false);
+}
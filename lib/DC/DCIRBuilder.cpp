@@ -0,0 +1,21 @@
+//===-- lib/DC/DCIRBuilder.cpp - DC IR Builder ------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/DC/DCIRBuilder.h"
+#include "llvm/Support/CommandLine.h"
+
+using namespace llvm;
+
+static cl::opt<bool> DCFold(
+    "dc-fold",
+    cl::desc("Fold the operations of the semantics on constants while "
+             "translating, instead of creating an instruction for each"),
+    cl::init(false));
+
+bool DCIRBuilder::shouldFold() { return DCFold; }
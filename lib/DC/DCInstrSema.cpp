@@ -9,11 +9,19 @@
 
 #include "llvm/DC/DCInstrSema.h"
 #include "llvm/ADT/APInt.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringSwitch.h"
 #include "llvm/CodeGen/ISDOpcodes.h"
+#include "llvm/DC/DCBlockProfile.h"
+#include "llvm/DC/DCCallSummaries.h"
+#include "llvm/DC/DCExternalSignatures.h"
+#include "llvm/DC/DCObjCMessageTable.h"
 #include "llvm/DC/DCRegisterSema.h"
 #include "llvm/DC/DCTranslatedInstTracker.h"
 #include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/CFG.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/Function.h"
@@ -23,12 +31,28 @@
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/Intrinsics.h"
 #include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/MDBuilder.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Type.h"
+#include "llvm/MC/MCAnalysis/MCDominators.h"
 #include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCAnalysis/MCLoopInfo.h"
+#include "llvm/MC/MCInstrAnalysis.h"
+#include "llvm/MC/MCInstrInfo.h"
 #include "llvm/MC/MCRegisterInfo.h"
+#include "llvm/Object/MachOUnwindInfo.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/DynamicLibrary.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Transforms/Utils/BasicBlockUtils.h"
+#include "llvm/Transforms/Utils/ModuleUtils.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+
 using namespace llvm;
 
 #define DEBUG_TYPE "dc-sema"
@@ -36,30 +60,283 @@ using namespace llvm;
 static cl::opt<bool> EnableRegSetDiff("enable-dc-regset-diff", cl::desc(""),
                                       cl::init(false));
 
+static cl::opt<bool> EnableRegSetTrace(
+    "enable-dc-regset-trace",
+    cl::desc("At each function exit, record the registers the function wrote "
+             "that changed, in a trace printed at process exit, instead of "
+             "copying and diffing the whole regset as -enable-dc-regset-diff "
+             "does"),
+    cl::init(false));
+
 static cl::opt<bool> EnableInstAddrSave("enable-dc-pc-save", cl::desc(""),
                                         cl::init(false));
 
+static cl::opt<bool> EnableBlockTrace(
+    "enable-dc-block-trace",
+    cl::desc("At the entry of each basic block, record its address in a "
+             "per-thread ring buffer, written at process exit; unlike "
+             "-enable-dc-pc-save, this doesn't serialize each instruction. "
+             "llvm-dc -expand-block-trace gives back the instructions run"),
+    cl::init(false));
+
+static cl::opt<std::string> BlockTraceFile(
+    "dc-block-trace-file",
+    cl::desc("Where -enable-dc-block-trace writes the trace "
+             "(default = stderr)"),
+    cl::value_desc("file"));
+
+static cl::opt<bool> EnableEdgeCoverage(
+    "enable-dc-edge-coverage",
+    cl::desc("Count the runs of each edge of the MC CFG in inline 8-bit "
+             "counters, with a table of their addresses, laid out as "
+             "-fsanitize-coverage=inline-8bit-counters,pc-table does, so "
+             "that libFuzzer can drive the translated code"),
+    cl::init(false));
+
+static cl::opt<bool> EnableStructuredLoops(
+    "enable-dc-structured-loops",
+    cl::desc("Give the loops of the MC CFG of each translated function a "
+             "preheader, a single backedge and dedicated exits, as "
+             "LoopSimplify does, so that the passes after translation find "
+             "them in that form"),
+    cl::init(false));
+
+static cl::opt<bool> EnableABIAwareCalls(
+    "enable-dc-abi-calls",
+    cl::desc("Around calls, only save the registers the callee can read, and "
+             "restore those it can change, per the calling convention"),
+    cl::init(false));
+
+static cl::opt<bool> EnableInlineCalls(
+    "enable-dc-inline-calls",
+    cl::desc("Leave the calls, with the saves and restores of the registers "
+             "around them, in the block of the call instruction, instead of "
+             "splitting it in a call block and a continuation"),
+    cl::init(false));
+
+static cl::opt<bool> EnableUnknownFallback(
+    "enable-dc-unknown-fallback",
+    cl::desc("Translate instructions with unimplemented semantics to calls to "
+             "opaque dc.unknown.<opcode> functions, instead of aborting"),
+    cl::init(false));
+
+static cl::opt<bool> EnableObjCARCCalls(
+    "enable-dc-objc-arc-calls",
+    cl::desc("Translate the calls to the Objective-C ARC runtime, e.g. "
+             "objc_retain, to calls taking and returning the object "
+             "pointers, as the ObjCARC passes know them"),
+    cl::init(false));
+
+static cl::opt<bool> EnableTypedExternalCalls(
+    "enable-dc-typed-external-calls",
+    cl::desc("Translate the calls to the external functions whose C types "
+             "are known, e.g. strlen, to calls taking and returning their "
+             "arguments, rather than the regset"),
+    cl::init(false));
+
+static cl::opt<bool> EnableAtomicLoops(
+    "enable-dc-atomic-loops",
+    cl::desc("Translate the exclusive load/store retry loops of the atomic "
+             "operations to atomicrmw and cmpxchg instructions, where the "
+             "target recognizes them"),
+    cl::init(false));
+
+static cl::opt<bool> EnableObjCMessageCaches(
+    "enable-dc-objc-message-caches",
+    cl::desc("Send the objc_msgSend messages through a monomorphic inline "
+             "cache of each call site, that calls the translation of the "
+             "method directly when the receiver has the isa it was filled "
+             "with, as the JIT runtime fills it"),
+    cl::init(false));
+
+static cl::opt<bool> EnableTailCallReturns(
+    "enable-dc-tail-call-returns",
+    cl::desc("Return right after the calls the tail calls to other functions "
+             "were rewritten to, leaving the regset as the callee did, "
+             "instead of through the exit block"),
+    cl::init(true));
+
+static cl::opt<bool> DCOpcodeStats(
+    "dc-opcode-stats",
+    cl::desc("Measure the cost of translating each opcode: instructions, IR "
+             "instructions created and time, printed on exit"),
+    cl::init(false));
+
+namespace {
+/// \brief The opcode costs of all the semantics of the process, by opcode
+/// name, printed once they are all destroyed, as the statistics are.
+struct OpcodeStatsTotals {
+  struct Totals {
+    uint64_t NumInsts = 0;
+    uint64_t NumIRInsts = 0;
+    double Seconds = 0;
+  };
+  std::mutex Lock;
+  StringMap<Totals> ByOpcode;
+
+  ~OpcodeStatsTotals();
+};
+} // end anonymous namespace
+
+static ManagedStatic<OpcodeStatsTotals> OpcodeTotals;
+
+namespace llvm { extern raw_ostream *CreateInfoOutputFile(); }
+
+OpcodeStatsTotals::~OpcodeStatsTotals() {
+  if (ByOpcode.empty())
+    return;
+  std::vector<std::pair<StringRef, const Totals *>> Sorted;
+  double TotalSeconds = 0;
+  for (const auto &KV : ByOpcode) {
+    Sorted.push_back(std::make_pair(KV.getKey(), &KV.getValue()));
+    TotalSeconds += KV.getValue().Seconds;
+  }
+  // Most expensive first, then by name, for a stable output.
+  std::sort(Sorted.begin(), Sorted.end(),
+            [](const std::pair<StringRef, const Totals *> &L,
+               const std::pair<StringRef, const Totals *> &R) {
+              return L.second->Seconds != R.second->Seconds
+                         ? L.second->Seconds > R.second->Seconds
+                         : L.first < R.first;
+            });
+
+  raw_ostream &OS = *CreateInfoOutputFile();
+  OS << "===" << std::string(73, '-') << "===\n"
+     << "                  ... DC translation cost per opcode ...\n"
+     << "===" << std::string(73, '-') << "===\n"
+     << format("  Total: %.4f seconds\n\n", TotalSeconds)
+     << "       Count    IR insts  IR/inst    Seconds   Time%  Opcode\n";
+  for (const auto &S : Sorted) {
+    const Totals &T = *S.second;
+    OS << format("  %10llu  %10llu  %7.2f  %9.4f  %5.1f%%  ",
+                 (unsigned long long)T.NumInsts,
+                 (unsigned long long)T.NumIRInsts,
+                 T.NumInsts ? double(T.NumIRInsts) / T.NumInsts : 0.0,
+                 T.Seconds,
+                 TotalSeconds ? 100 * T.Seconds / TotalSeconds : 0.0)
+       << S.first << "\n";
+  }
+  OS.flush();
+  delete &OS;
+}
+
+// Whether to name basic blocks, per -dc-names. Their addresses are known
+// from BBByAddr and the call basic block list anyway.
+static bool nameBlocks() {
+  return DCRegisterSema::getNameLevel() != DCRegisterSema::NL_None;
+}
+
 DCInstrSema::DCInstrSema(const unsigned *OpcodeToSemaIdx,
-                         const unsigned *SemanticsArray,
-                         const uint64_t *ConstantArray, DCRegisterSema &DRS)
+                         const uint16_t *SemanticsArray,
+                         const uint64_t *ConstantArray,
+                         const char *SemanticsHash, DCRegisterSema &DRS)
     : OpcodeToSemaIdx(OpcodeToSemaIdx), SemanticsArray(SemanticsArray),
-      ConstantArray(ConstantArray), DynTranslateAtCBPtr(0), Ctx(0),
-      TheModule(0), DRS(DRS), FuncType(0), TheFunction(0), TheMCFunction(0),
-      BBByAddr(), ExitBB(0), CallBBs(), TheBB(0), TheMCBB(0), Builder(), Idx(0),
-      ResEVT(), Opcode(0), Vals(), CurrentInst(0) {}
+      ConstantArray(ConstantArray), SemanticsHash(SemanticsHash),
+      StubTargets(0),
+      FunctionNames(0), DataSections(0), ObjCMessages(0), InlinedFunctions(0),
+      CallSummaries(0), BlockProfile(0), CalleeSavedMIA(0),
+      MemoryTransferMIA(0),
+      ConstantCallMIA(0),
+      TagObjCMessages(false), TagCallBBs(false),
+      FoldConstants(false),
+      NopOpcodes(DRS.MII.getNumOpcodes()), Ctx(0),
+      TheModule(0), DRS(DRS), FuncType(0), TrapFn(0), TheFunction(0),
+      TheMCFunction(0),
+      BBByAddr(), ExitBB(0), TraceExitBB(0), CallBBs(), TheBB(0), TheBBAddr(0),
+      TheMCBB(0),
+      Builder(), Idx(0), ResEVT(), Opcode(0), Vals(), CurrentInst(0) {
+  std::fill(VTTypes, VTTypes + MVT::LAST_VALUETYPE, nullptr);
+  CurrentInstUnknown = false;
+  if (DCOpcodeStats)
+    OpcodeStatsTable.resize(DRS.MII.getNumOpcodes());
+}
+
+DCInstrSema::~DCInstrSema() {
+  if (OpcodeStatsTable.empty())
+    return;
+  std::lock_guard<std::mutex> Lock(OpcodeTotals->Lock);
+  for (unsigned Opc = 0, E = OpcodeStatsTable.size(); Opc != E; ++Opc) {
+    const OpcodeStats &S = OpcodeStatsTable[Opc];
+    if (!S.NumInsts)
+      continue;
+    OpcodeStatsTotals::Totals &T = OpcodeTotals->ByOpcode[DRS.MII.getName(Opc)];
+    T.NumInsts += S.NumInsts;
+    T.NumIRInsts += S.NumIRInsts;
+    T.Seconds += S.Seconds;
+  }
+}
 
-DCInstrSema::~DCInstrSema() {}
+std::string DCInstrSema::getTranslationOptions() {
+  return (Twine("regset-diff=") + (EnableRegSetDiff ? "1" : "0") +
+          ",regset-trace=" + (EnableRegSetTrace ? "1" : "0") +
+          ",pc-save=" + (EnableInstAddrSave ? "1" : "0") +
+          ",block-trace=" + (EnableBlockTrace ? "1" : "0") +
+          ",edge-coverage=" + (EnableEdgeCoverage ? "1" : "0") +
+          ",structured-loops=" + (EnableStructuredLoops ? "1" : "0") +
+          ",abi-calls=" + (EnableABIAwareCalls ? "1" : "0") +
+          ",inline-calls=" + (EnableInlineCalls ? "1" : "0") +
+          ",unknown-fallback=" + (EnableUnknownFallback ? "1" : "0") +
+          ",objc-arc=" + (EnableObjCARCCalls ? "1" : "0") +
+          ",atomic-loops=" + (EnableAtomicLoops ? "1" : "0") +
+          ",objc-caches=" + (EnableObjCMessageCaches ? "1" : "0") +
+          ",tail-call-returns=" + (EnableTailCallReturns ? "1" : "0") +
+          ",typed-externals=" +
+          (EnableTypedExternalCalls ? DCExternalSignatures::get().hash()
+                                    : "0") +
+          ",fold=" + (DCIRBuilder::shouldFold() ? "1" : "0") + "," +
+          DCRegisterSema::getTranslationOptions()).str();
+}
 
 Function *DCInstrSema::FinalizeFunction() {
+  // The blocks that were branched to, but not translated, trap.
+  const uint64_t LastAddr = DRS.getCurrentAddress()->Addr;
+  for (const auto &AddrBB : BBByAddr) {
+    if (!AddrBB.second->empty())
+      continue;
+    setCurrentAddress(AddrBB.first);
+    DCIRBuilder BBBuilder(AddrBB.second, DRS.getCurrentAddress());
+    BBBuilder.CreateCall(getTrapFunction());
+    BBBuilder.CreateUnreachable();
+  }
+  setCurrentAddress(LastAddr);
+
   for (auto *CallBB : CallBBs) {
     assert(CallBB->size() == 2 &&
            "Call basic block has wrong number of instructions!");
     auto CallI = CallBB->begin();
+    // Nothing is known about what unknown instructions read and write.
+    if ((EnableABIAwareCalls || CallSummaries) &&
+        !UnknownCallBBs.count(CallBB)) {
+      const DCCallSummary *Summary = nullptr;
+      if (CallSummaries)
+        if (Function *Callee = cast<CallInst>(CallI)->getCalledFunction()) {
+          auto AI = AddrsByFunction.find(Callee);
+          if (AI != AddrsByFunction.end())
+            Summary = CallSummaries->lookup(AI->second);
+        }
+      DRS.saveLocalRegsForCall(CallBB, CallI,
+                               Summary ? &Summary->Read : nullptr);
+      DRS.restoreLocalRegsAfterCall(CallBB, ++CallI,
+                                    Summary ? &Summary->Clobbered : nullptr);
+      continue;
+    }
     DRS.saveAllLocalRegs(CallBB, CallI);
     DRS.restoreLocalRegs(CallBB, ++CallI);
   }
+  if (EnableInlineCalls)
+    mergeCallBasicBlocks();
+  if (TraceExitBB) {
+    DRS.insertRegSetTraceCode(&TheFunction->getEntryBlock(), TraceExitBB,
+                              AddrsByFunction.lookup(TheFunction));
+    TraceExitBB = nullptr;
+  }
+  if (EnableEdgeCoverage)
+    insertEdgeCoverage(AddrsByFunction.lookup(TheFunction));
   DRS.FinalizeFunction(ExitBB);
+  if (EnableStructuredLoops)
+    structureLoops();
   CallBBs.clear();
+  UnknownCallBBs.clear();
   BBByAddr.clear();
   Function *Fn = TheFunction;
   TheFunction = nullptr;
@@ -70,11 +347,42 @@ Function *DCInstrSema::FinalizeFunction() {
 void DCInstrSema::FinalizeBasicBlock() {
   if (!TheBB->getTerminator())
     BranchInst::Create(getOrCreateBasicBlock(getBasicBlockEndAddress()), TheBB);
+  if (BlockProfile && TheMCBB)
+    weighBranch(TheBB->getTerminator());
   DRS.FinalizeBasicBlock();
   TheBB = nullptr;
   TheMCBB = nullptr;
 }
 
+void DCInstrSema::weighBranch(TerminatorInst *TI) {
+  BranchInst *BI = dyn_cast<BranchInst>(TI);
+  if (!BI || !BI->isConditional())
+    return;
+  // The successors of the branch are the blocks of the MC successors, or
+  // others, e.g. those that trap: those are never taken.
+  uint64_t Counts[2] = {0, 0};
+  uint64_t Max = 0;
+  for (const MCBasicBlock *Succ :
+       make_range(TheMCBB->succ_begin(), TheMCBB->succ_end())) {
+    auto It = BBByAddr.find(Succ->getStartAddr());
+    if (It == BBByAddr.end())
+      continue;
+    uint64_t Count = BlockProfile->getEdgeCount(TheMCBB->getStartAddr(),
+                                                Succ->getStartAddr());
+    for (unsigned I = 0; I != 2; ++I)
+      if (BI->getSuccessor(I) == It->second)
+        Counts[I] = Count;
+    Max = std::max(Max, Count);
+  }
+  // Leave the branches that weren't run to the heuristics.
+  if (!Max)
+    return;
+  const uint64_t Scale = Max / UINT32_MAX + 1;
+  BI->setMetadata(LLVMContext::MD_prof,
+                  MDBuilder(*Ctx).createBranchWeights(
+                      uint32_t(Counts[0] / Scale), uint32_t(Counts[1] / Scale)));
+}
+
 Function *DCInstrSema::getOrCreateMainFunction(Function *EntryFn) {
   Type *MainArgs[] = {Builder->getInt32Ty(),
                       Builder->getInt8PtrTy()->getPointerTo()};
@@ -151,8 +459,12 @@ Function *DCInstrSema::getOrCreateFiniRegSetFunction() {
 }
 
 void DCInstrSema::createExternalWrapperFunction(uint64_t Addr, StringRef Name) {
-  Function *ExtFn = cast<Function>(TheModule->getOrInsertFunction(
-      Name, FunctionType::get(Builder->getVoidTy(), false)));
+  // The typed calls may have declared it with its C type already: the
+  // wrapper only needs its address.
+  Function *ExtFn = cast<Function>(
+      TheModule->getOrInsertFunction(
+                     Name, FunctionType::get(Builder->getVoidTy(), false))
+          ->stripPointerCasts());
 
   Function *Fn = getFunction(Addr);
   if (!Fn->isDeclaration())
@@ -163,11 +475,50 @@ void DCInstrSema::createExternalWrapperFunction(uint64_t Addr, StringRef Name) {
   ReturnInst::Create(*Ctx, BB);
 }
 
+void DCInstrSema::declareExternalFunction(uint64_t Addr, StringRef Name) {
+  ExternalNames[Addr] = Name;
+  Function *ExtFn = TheModule->getFunction(Name);
+  if (!ExtFn)
+    ExtFn = Function::Create(FuncType, GlobalValue::ExternalLinkage, Name,
+                             TheModule);
+
+  Function *&Fn = FunctionsByAddr[Addr];
+  if (Fn && Fn != ExtFn) {
+    assert(Fn->isDeclaration() && "Defined function turned external!");
+    Fn->replaceAllUsesWith(ConstantExpr::getBitCast(ExtFn, Fn->getType()));
+    AddrsByFunction.erase(Fn);
+    Fn->eraseFromParent();
+  }
+  Fn = ExtFn;
+  AddrsByFunction[ExtFn] = Addr;
+}
+
+void DCInstrSema::createThunkFunction(uint64_t Addr, uint64_t TargetAddr) {
+  Function *Fn = getFunction(Addr);
+  if (!Fn->isDeclaration())
+    return;
+  Fn->setDoesNotAlias(1);
+  Fn->setDoesNotCapture(1);
+
+  BasicBlock *BB = BasicBlock::Create(*Ctx, "", Fn);
+  CallInst *Call =
+      CallInst::Create(getFunction(TargetAddr), &*Fn->arg_begin(), "", BB);
+  Call->setTailCall();
+  ReturnInst::Create(*Ctx, BB);
+}
+
 void DCInstrSema::createExternalTailCallBB(uint64_t Addr) {
   // First create a basic block for the tail call.
   SwitchToBasicBlock(Addr);
+  // The ARC runtime and typed calls don't go through the regset: the
+  // registers they set are saved by ExitBB.
+  if (insertObjCARCCall(Addr) || insertTypedExternalCall(Addr)) {
+    Builder->CreateBr(ExitBB);
+    DRS.FinalizeBasicBlock();
+    return;
+  }
   // Now do the call to that function.
-  insertCallBB(getFunction(Addr));
+  insertCallBB(getCallTarget(Addr));
   // Finally, return directly, bypassing the ExitBB.
   Builder->CreateRetVoid();
 }
@@ -175,29 +526,128 @@ void DCInstrSema::createExternalTailCallBB(uint64_t Addr) {
 void DCInstrSema::SwitchToModule(Module *M) {
   TheModule = M;
   Ctx = &TheModule->getContext();
+  FunctionsByAddr.clear();
+  AddrsByFunction.clear();
+  CallBBsByAddr.clear();
+  ExternalsByStubAddr.clear();
+  DataEntryAddrs.clear();
+  TrapFn = nullptr;
+  std::fill(VTTypes, VTTypes + MVT::LAST_VALUETYPE, nullptr);
   DRS.SwitchToModule(TheModule);
   FuncType = FunctionType::get(Type::getVoidTy(*Ctx),
                                DRS.getRegSetType()->getPointerTo(), false);
-  Builder.reset(new DCIRBuilder(*Ctx));
+  Builder.reset(new DCIRBuilder(*Ctx, DRS.getCurrentAddress()));
 }
 
 extern "C" uintptr_t __llvm_dc_current_fn = 0;
 extern "C" uintptr_t __llvm_dc_current_bb = 0;
 extern "C" uintptr_t __llvm_dc_current_instr = 0;
 
+namespace {
+// The block trace of a thread: the addresses of the last blocks it entered.
+struct BlockTraceBuffer {
+  static const uint64_t Size = 1 << 16;
+  unsigned Thread;
+  uint64_t NumEntries;
+  uint64_t Addrs[Size];
+};
+} // end anonymous namespace
+
+// The buffers are only ever added to, and are written when the process exits,
+// each thread's after the other.
+static std::mutex &getBlockTraceMutex() {
+  static std::mutex M;
+  return M;
+}
+static std::vector<BlockTraceBuffer *> &getBlockTraceBuffers() {
+  static std::vector<BlockTraceBuffer *> Buffers;
+  return Buffers;
+}
+static LLVM_THREAD_LOCAL BlockTraceBuffer *ThreadBlockTrace;
+
+static void writeBlockTrace() {
+  FILE *F = stderr;
+  if (!BlockTraceFile.empty() && !(F = fopen(BlockTraceFile.c_str(), "w"))) {
+    fprintf(stderr, "error: can't write the block trace to %s\n",
+            BlockTraceFile.c_str());
+    return;
+  }
+  std::lock_guard<std::mutex> Lock(getBlockTraceMutex());
+  for (const BlockTraceBuffer *B : getBlockTraceBuffers()) {
+    fprintf(F, "thread %u\n", B->Thread);
+    uint64_t Begin = 0;
+    if (B->NumEntries > BlockTraceBuffer::Size) {
+      Begin = B->NumEntries - BlockTraceBuffer::Size;
+      fprintf(F, "dropped %llu\n", (unsigned long long)Begin);
+    }
+    for (uint64_t I = Begin; I != B->NumEntries; ++I)
+      fprintf(F, "%llx\n",
+              (unsigned long long)B->Addrs[I % BlockTraceBuffer::Size]);
+  }
+  if (F != stderr)
+    fclose(F);
+}
+
+extern "C" void __llvm_dc_trace_block(uint64_t Addr) {
+  BlockTraceBuffer *B = ThreadBlockTrace;
+  if (!B) {
+    B = ThreadBlockTrace = new BlockTraceBuffer();
+    std::lock_guard<std::mutex> Lock(getBlockTraceMutex());
+    std::vector<BlockTraceBuffer *> &Buffers = getBlockTraceBuffers();
+    B->Thread = Buffers.size();
+    if (Buffers.empty())
+      atexit(writeBlockTrace);
+    Buffers.push_back(B);
+  }
+  B->Addrs[B->NumEntries++ % BlockTraceBuffer::Size] = Addr;
+}
+
+static uint64_t EmptyCoverageSection[1];
+
+static void noCoverageInit(const void *, const void *) {}
+
+uint64_t DCInstrSema::getRuntimeSymbolAddress(StringRef Name) {
+  if (Name == "__llvm_dc_current_instr")
+    return reinterpret_cast<uintptr_t>(&__llvm_dc_current_instr);
+  if (Name == "__llvm_dc_trace_block")
+    return reinterpret_cast<uintptr_t>(&__llvm_dc_trace_block);
+  // The constructor registering the coverage sections isn't run: they are
+  // empty, and libFuzzer ignores them. Any libFuzzer is the process's.
+  if (Name.startswith("__start___sancov_") ||
+      Name.startswith("__stop___sancov_") ||
+      Name.startswith("section$start$__DATA$__sancov_") ||
+      Name.startswith("section$end$__DATA$__sancov_"))
+    return reinterpret_cast<uintptr_t>(&EmptyCoverageSection);
+  if (Name == "__sanitizer_cov_8bit_counters_init" ||
+      Name == "__sanitizer_cov_pcs_init") {
+    if (void *Addr = sys::DynamicLibrary::SearchForAddressOfSymbol(Name))
+      return reinterpret_cast<uintptr_t>(Addr);
+    return reinterpret_cast<uintptr_t>(&noCoverageInit);
+  }
+  return DCRegisterSema::getRuntimeSymbolAddress(Name);
+}
+
 void DCInstrSema::SwitchToFunction(const MCFunction *MCFN) {
   assert(!MCFN->empty() && "Trying to translate empty MC function");
   const uint64_t StartAddr = MCFN->getEntryBlock()->getStartAddr();
 
+  TheMCFunction = MCFN;
   TheFunction = getFunction(StartAddr);
   TheFunction->setDoesNotAlias(1);
   TheFunction->setDoesNotCapture(1);
+  if (InlinedFunctions && InlinedFunctions->count(StartAddr))
+    TheFunction->addFnAttr(Attribute::AlwaysInline);
+  if (BlockProfile)
+    TheFunction->setEntryCount(BlockProfile->getEntryCount(StartAddr));
 
   // Create the entry and exit basic blocks.
-  TheBB =
-      BasicBlock::Create(*Ctx, "entry_fn_" + utohexstr(StartAddr), TheFunction);
-  ExitBB =
-      BasicBlock::Create(*Ctx, "exit_fn_" + utohexstr(StartAddr), TheFunction);
+  bool NameBBs = nameBlocks();
+  TheBB = BasicBlock::Create(
+      *Ctx, NameBBs ? "entry_fn_" + utohexstr(StartAddr) : std::string(),
+      TheFunction);
+  ExitBB = BasicBlock::Create(
+      *Ctx, NameBBs ? "exit_fn_" + utohexstr(StartAddr) : std::string(),
+      TheFunction);
 
   // From now on we insert in the entry basic block.
   Builder->SetInsertPoint(TheBB);
@@ -212,9 +662,10 @@ void DCInstrSema::SwitchToFunction(const MCFunction *MCFN) {
     // Second, insert a call to the diff function, in a separate exit block.
     // Move the return to that block, and branch to it from ExitBB.
     BasicBlock *DiffExitBB = BasicBlock::Create(
-        *Ctx, "diff_exit_fn_" + utohexstr(StartAddr), TheFunction);
+        *Ctx, NameBBs ? "diff_exit_fn_" + utohexstr(StartAddr) : std::string(),
+        TheFunction);
 
-    DCIRBuilder ExitBBBuilder(DiffExitBB);
+    DCIRBuilder ExitBBBuilder(DiffExitBB, DRS.getCurrentAddress());
 
     Value *FnAddr = ExitBBBuilder.CreateIntToPtr(
         ExitBBBuilder.getInt64(reinterpret_cast<uint64_t>(StartAddr)),
@@ -224,6 +675,14 @@ void DCInstrSema::SwitchToFunction(const MCFunction *MCFN) {
                              {FnAddr, SavedRegSet, RegSetArg});
     ReturnInst::Create(*Ctx, DiffExitBB);
     BranchInst::Create(DiffExitBB, ExitBB);
+  } else if (EnableRegSetTrace) {
+    // The registers the function writes are only all known once it is
+    // translated: FinalizeFunction inserts the trace in a separate exit block.
+    TraceExitBB = BasicBlock::Create(
+        *Ctx, NameBBs ? "trace_exit_fn_" + utohexstr(StartAddr) : std::string(),
+        TheFunction);
+    ReturnInst::Create(*Ctx, TraceExitBB);
+    BranchInst::Create(TraceExitBB, ExitBB);
   } else {
     // Create a ret void in the exit basic block.
     ReturnInst::Create(*Ctx, ExitBB);
@@ -234,22 +693,56 @@ void DCInstrSema::SwitchToFunction(const MCFunction *MCFN) {
   Builder->CreateBr(getOrCreateBasicBlock(StartAddr));
 
   DRS.SwitchToFunction(TheFunction);
+  DRS.analyzeMCFunction(*MCFN);
+
+  CalleeSavedSpills.clear();
+  // The unwind info tells the functions that save no register: there are no
+  // spills to look for in them.
+  if (CalleeSavedMIA &&
+      !object::MachOUnwindInfo::isFramelessLeaf(TargetTriple.getArch(),
+                                                MCFN->getUnwindEncoding()) &&
+      CalleeSavedSpills.analyze(*MCFN, *CalleeSavedMIA, DRS.MRI)) {
+    std::string Saved;
+    const BitVector &Regs = CalleeSavedSpills.getSavedRegs();
+    for (int R = Regs.find_first(); R != -1; R = Regs.find_next(R)) {
+      if (!Saved.empty())
+        Saved += ',';
+      Saved += StringRef(DRS.MRI.getName(R)).lower();
+    }
+    TheFunction->addFnAttr("dc-callee-saved", Saved);
+  }
+
+  MemoryTransfers.clear();
+  if (MemoryTransferMIA)
+    MemoryTransfers.analyze(*MCFN, *MemoryTransferMIA, DRS.MRI);
+  ConstantRegs.clear();
+  if (ConstantCallMIA)
+    ConstantRegs.analyze(*MCFN, *ConstantCallMIA, DRS.MII, DRS.MRI);
+  analyzeTargetFunction(*MCFN);
 }
 
 void DCInstrSema::prepareBasicBlockForInsertion(BasicBlock *BB) {
-  assert((BB->size() == 2 && isa<UnreachableInst>(++BB->begin())) &&
-         "Several BBs at the same address?");
-  BB->begin()->eraseFromParent();
-  BB->begin()->eraseFromParent();
+  assert(BB->empty() && "Several BBs at the same address?");
 }
 
 void DCInstrSema::SwitchToBasicBlock(const MCBasicBlock *MCBB) {
   TheMCBB = MCBB;
   SwitchToBasicBlock(getBasicBlockStartAddress());
+
+  // Only the blocks are traced: the instructions run are known from the MC
+  // CFG, and the optimizations aren't held back at each of them.
+  if (EnableBlockTrace) {
+    Type *TraceArgTys[] = {Builder->getInt64Ty()};
+    Constant *TraceFn = TheModule->getOrInsertFunction(
+        "__llvm_dc_trace_block",
+        FunctionType::get(Builder->getVoidTy(), TraceArgTys, false));
+    Builder->CreateCall(TraceFn, Builder->getInt64(TheBBAddr));
+  }
 }
 
 void DCInstrSema::SwitchToBasicBlock(uint64_t BeginAddr) {
   TheBB = getOrCreateBasicBlock(BeginAddr);
+  TheBBAddr = BeginAddr;
   prepareBasicBlockForInsertion(TheBB);
 
   Builder->SetInsertPoint(TheBB);
@@ -273,73 +766,1058 @@ uint64_t DCInstrSema::getBasicBlockEndAddress() const {
   return TheMCBB->getEndAddr();
 }
 
+std::string DCInstrSema::getFunctionName(uint64_t Addr) const {
+  if (!ExternalNames.empty()) {
+    auto I = ExternalNames.find(Addr);
+    if (I != ExternalNames.end())
+      return I->second;
+  }
+  if (FunctionNames) {
+    auto I = FunctionNames->find(Addr);
+    if (I != FunctionNames->end())
+      return I->second;
+  }
+  return "fn_" + utohexstr(Addr);
+}
+
+bool DCInstrSema::isArgMemOnly(uint64_t Addr) const {
+  // The instrumentation stores to its globals, and the unknown instructions
+  // may do anything.
+  if (!CallSummaries || EnableUnknownFallback || EnableRegSetDiff ||
+      EnableRegSetTrace || EnableInstAddrSave || EnableBlockTrace ||
+      EnableEdgeCoverage)
+    return false;
+  const DCCallSummary *Summary = CallSummaries->lookup(Addr);
+  return Summary && !Summary->AccessesMemory;
+}
+
 Function *DCInstrSema::getFunction(uint64_t Addr) {
-  std::string Name = "fn_" + utohexstr(Addr);
-  TheModule->getOrInsertFunction(Name, FuncType);
-  return TheModule->getFunction(Name);
+  Function *&Fn = FunctionsByAddr[Addr];
+  if (!Fn) {
+    std::string Name = getFunctionName(Addr);
+    Fn = TheModule->getFunction(Name);
+    if (!Fn)
+      Fn = Function::Create(FuncType, GlobalValue::ExternalLinkage, Name,
+                            TheModule);
+    // The declarations are annotated as well, for the calls to them.
+    if (isArgMemOnly(Addr))
+      Fn->addFnAttr(Attribute::ArgMemOnly);
+    AddrsByFunction[Fn] = Addr;
+  }
+  return Fn;
+}
+
+Constant *DCInstrSema::getCallTarget(uint64_t Addr) {
+  if (StubTargets) {
+    auto LI = StubTargets->LocalAddrs.find(Addr);
+    if (LI != StubTargets->LocalAddrs.end())
+      return getFunction(LI->second);
+    auto EI = StubTargets->ExternalNames.find(Addr);
+    if (EI != StubTargets->ExternalNames.end()) {
+      Constant *&ExtFn = ExternalsByStubAddr[Addr];
+      if (!ExtFn)
+        ExtFn = TheModule->getOrInsertFunction(EI->second, FuncType);
+      return ExtFn;
+    }
+  }
+  return getFunction(Addr);
+}
+
+const DCDataSection *DCInstrSema::getDataSection(uint64_t Addr) const {
+  if (!DataSections)
+    return nullptr;
+  auto I = std::upper_bound(
+      DataSections->begin(), DataSections->end(), Addr,
+      [](uint64_t A, const DCDataSection &S) { return A < S.Addr; });
+  if (I == DataSections->begin() || Addr - (I - 1)->Addr >= (I - 1)->Size)
+    return nullptr;
+  return &*(I - 1);
+}
+
+Constant *DCInstrSema::getDataAddress(uint64_t Addr, IntegerType *IntTy) {
+  const DCDataSection *Section = getDataSection(Addr);
+  if (!Section)
+    return ConstantInt::get(IntTy, Addr);
+  const DCDataSection &S = *Section;
+  uint64_t Offset = (Addr - S.Addr) % S.EntrySize;
+  uint64_t EntryAddr = Addr - Offset;
+
+  if (S.Kind == DCDataSection::CStrings && !S.Contents.empty())
+    return ConstantExpr::getPtrToInt(getCStringGlobal(S, Addr), IntTy);
+  if (S.Kind == DCDataSection::Section)
+    return ConstantExpr::getPtrToInt(getSectionPointer(S, Addr), IntTy);
+
+  Type *Ty = Type::getInt8PtrTy(*Ctx);
+  const char *Prefix = nullptr;
+  switch (S.Kind) {
+  case DCDataSection::SelRefs: Prefix = "selref_"; break;
+  case DCDataSection::ClassRefs: Prefix = "classref_"; break;
+  case DCDataSection::GOT: Prefix = "got_"; break;
+  case DCDataSection::CStrings: Prefix = "cstr_"; Ty = Type::getInt8Ty(*Ctx); break;
+  case DCDataSection::Section: llvm_unreachable("Sections have no entries");
+  case DCDataSection::CFStrings: {
+    // The layout of the constant CFStrings: isa, flags, characters, and a
+    // pointer-sized length.
+    Prefix = "cfstring_";
+    StructType *CFStringTy = TheModule->getTypeByName("struct.__CFString");
+    if (!CFStringTy)
+      CFStringTy = StructType::create(
+          "struct.__CFString", Ty, Type::getInt32Ty(*Ctx), Ty,
+          Type::getIntNTy(*Ctx, S.EntrySize / 4 * 8), nullptr);
+    Ty = CFStringTy;
+    break;
+  }
+  }
+  Constant *GV =
+      TheModule->getOrInsertGlobal(Prefix + utohexstr(EntryAddr), Ty);
+  if (GlobalVariable *EntryGV = dyn_cast<GlobalVariable>(GV)) {
+    DataEntryAddrs[EntryGV] = EntryAddr;
+    if (S.Kind == DCDataSection::CFStrings && EntryGV->isDeclaration())
+      if (Constant *Init = getCFStringInitializer(S, EntryAddr,
+                                                  cast<StructType>(Ty))) {
+        EntryGV->setInitializer(Init);
+        EntryGV->setConstant(true);
+        EntryGV->setLinkage(GlobalValue::WeakODRLinkage);
+      }
+  }
+  Constant *Entry = ConstantExpr::getPtrToInt(GV, IntTy);
+  if (Offset)
+    Entry = ConstantExpr::getAdd(Entry, ConstantInt::get(IntTy, Offset));
+  return Entry;
+}
+
+Constant *DCInstrSema::getSectionPointer(const DCDataSection &S,
+                                         uint64_t Addr) {
+  std::string Name = "section_" + utohexstr(S.Addr);
+  GlobalVariable *GV = TheModule->getNamedGlobal(Name);
+  if (!GV) {
+    GV = new GlobalVariable(*TheModule,
+                            ArrayType::get(Type::getInt8Ty(*Ctx), S.Size),
+                            /*isConstant=*/true,
+                            GlobalValue::ExternalLinkage, nullptr, Name);
+    GV->setSection(S.Name);
+  }
+  Constant *Indices[] = {
+      ConstantInt::get(Type::getInt64Ty(*Ctx), 0),
+      ConstantInt::get(Type::getInt64Ty(*Ctx), Addr - S.Addr)};
+  return ConstantExpr::getInBoundsGetElementPtr(GV->getValueType(), GV,
+                                                Indices);
+}
+
+GlobalVariable *DCInstrSema::getCStringGlobal(const DCDataSection &S,
+                                              uint64_t Addr) {
+  // A string may be the suffix of another one, which the linker merged: each
+  // address referred to has its own global, up to the terminator.
+  std::string Name = "cstr_" + utohexstr(Addr);
+  if (GlobalVariable *GV = TheModule->getNamedGlobal(Name))
+    return GV;
+  StringRef Str = S.Contents.substr(Addr - S.Addr);
+  size_t Len = Str.find('\0');
+  const bool Terminated = Len != StringRef::npos;
+  Constant *Init = ConstantDataArray::getString(
+      *Ctx, Terminated ? Str.substr(0, Len) : Str, Terminated);
+  // The modules translated in parallel refer to the same strings: they are
+  // merged when the modules are linked.
+  GlobalVariable *GV =
+      new GlobalVariable(*TheModule, Init->getType(), /*isConstant=*/true,
+                         GlobalValue::WeakODRLinkage, Init, Name);
+  GV->setAlignment(1);
+  DataEntryAddrs[GV] = Addr;
+  return GV;
+}
+
+Constant *DCInstrSema::getCFStringInitializer(const DCDataSection &S,
+                                              uint64_t EntryAddr,
+                                              StructType *Ty) {
+  const unsigned PtrSize = S.EntrySize / 4;
+  if (S.Contents.size() < EntryAddr - S.Addr + S.EntrySize ||
+      (PtrSize != 4 && PtrSize != 8))
+    return nullptr;
+  // The Mach-O targets DC translates are little-endian.
+  const char *Entry = S.Contents.data() + (EntryAddr - S.Addr);
+  auto ReadField = [&](unsigned Offset, unsigned Size) {
+    uint64_t V = 0;
+    for (unsigned I = 0; I != Size; ++I)
+      V |= uint64_t(uint8_t(Entry[Offset + I])) << (8 * I);
+    return V;
+  };
+  PointerType *PtrTy = Type::getInt8PtrTy(*Ctx);
+  IntegerType *IntPtrTy = Type::getIntNTy(*Ctx, PtrSize * 8);
+
+  // The isa is bound by dyld to the class of the constant strings.
+  Constant *ISA = TheModule->getOrInsertGlobal(
+      "__CFConstantStringClassReference",
+      ArrayType::get(Type::getInt32Ty(*Ctx), 0));
+  ISA = ConstantExpr::getBitCast(ISA, PtrTy);
+  Constant *Flags =
+      ConstantInt::get(Type::getInt32Ty(*Ctx), ReadField(PtrSize, 4));
+  const uint64_t CharsAddr = ReadField(2 * PtrSize, PtrSize);
+  Constant *Chars;
+  const DCDataSection *CharsSection = getDataSection(CharsAddr);
+  if (CharsSection && CharsSection->Kind == DCDataSection::CStrings &&
+      !CharsSection->Contents.empty())
+    Chars = ConstantExpr::getBitCast(
+        getCStringGlobal(*CharsSection, CharsAddr), PtrTy);
+  else if (CharsSection && CharsSection->Kind == DCDataSection::Section)
+    Chars = getSectionPointer(*CharsSection, CharsAddr);
+  else
+    Chars = ConstantExpr::getIntToPtr(ConstantInt::get(IntPtrTy, CharsAddr),
+                                      PtrTy);
+  Constant *Length =
+      ConstantInt::get(IntPtrTy, ReadField(3 * PtrSize, PtrSize));
+  return ConstantStruct::get(Ty, ISA, Flags, Chars, Length, nullptr);
+}
+
+// Look through the operations that leave \p V unchanged, as the register
+// moves translate to, e.g. "or i64 0, (shl i64 %v, 0)" for an AArch64 mov.
+static Value *stripIdentityOps(Value *V) {
+  while (BinaryOperator *BO = dyn_cast_or_null<BinaryOperator>(V)) {
+    ConstantInt *RHS = dyn_cast<ConstantInt>(BO->getOperand(1));
+    ConstantInt *LHS = dyn_cast<ConstantInt>(BO->getOperand(0));
+    switch (BO->getOpcode()) {
+    case Instruction::Or:
+    case Instruction::Add:
+    case Instruction::Xor:
+      if (LHS && LHS->isZero()) {
+        V = BO->getOperand(1);
+        continue;
+      }
+      // Fallthrough.
+    case Instruction::Shl:
+    case Instruction::LShr:
+    case Instruction::AShr:
+    case Instruction::Sub:
+      if (RHS && RHS->isZero()) {
+        V = BO->getOperand(0);
+        continue;
+      }
+      break;
+    default:
+      break;
+    }
+    break;
+  }
+  return V;
+}
+
+bool DCInstrSema::getLoadedDataEntry(Value *V, uint64_t &EntryAddr) const {
+  LoadInst *LI = dyn_cast_or_null<LoadInst>(stripIdentityOps(V));
+  if (!LI)
+    return false;
+  // The address of the load is the ptrtoint of the global, cast back to a
+  // pointer, by an instruction as the builder doesn't fold.
+  Value *Ptr = LI->getPointerOperand()->stripPointerCasts();
+  if (IntToPtrInst *ITP = dyn_cast<IntToPtrInst>(Ptr))
+    Ptr = ITP->getOperand(0);
+  else if (ConstantExpr *CE = dyn_cast<ConstantExpr>(Ptr))
+    if (CE->getOpcode() == Instruction::IntToPtr)
+      Ptr = CE->getOperand(0);
+  if (ConstantExpr *CE = dyn_cast<ConstantExpr>(Ptr))
+    if (CE->getOpcode() == Instruction::PtrToInt)
+      Ptr = CE->getOperand(0);
+  GlobalVariable *GV = dyn_cast<GlobalVariable>(Ptr->stripPointerCasts());
+  if (!GV)
+    return false;
+  auto It = DataEntryAddrs.find(GV);
+  if (It == DataEntryAddrs.end())
+    return false;
+  EntryAddr = It->second;
+  return true;
+}
+
+bool DCInstrSema::getObjCMessage(uint64_t Target, StringRef &Selector,
+                                 StringRef &Class) {
+  unsigned ReceiverReg, SelectorReg;
+  if (!ObjCMessages || !StubTargets ||
+      !getObjCMessageRegs(ReceiverReg, SelectorReg))
+    return false;
+  auto EI = StubTargets->ExternalNames.find(Target);
+  if (EI == StubTargets->ExternalNames.end() || EI->second != "objc_msgSend")
+    return false;
+
+  Selector = Class = StringRef();
+  uint64_t Ref;
+  if (getLoadedDataEntry(DRS.getLocalRegValue(SelectorReg), Ref)) {
+    auto SI = ObjCMessages->SelectorRefs.find(Ref);
+    if (SI != ObjCMessages->SelectorRefs.end())
+      Selector = SI->second;
+  }
+  if (getLoadedDataEntry(DRS.getLocalRegValue(ReceiverReg), Ref)) {
+    auto CI = ObjCMessages->ClassRefs.find(Ref);
+    if (CI != ObjCMessages->ClassRefs.end())
+      Class = CI->second;
+  }
+  return true;
+}
+
+Function *DCInstrSema::resolveObjCMessage(uint64_t Target) {
+  StringRef Selector, Class;
+  if (!ObjCMessages || ObjCMessages->empty() ||
+      !getObjCMessage(Target, Selector, Class) || Selector.empty() ||
+      Class.empty())
+    return nullptr;
+  auto MI = ObjCMessages->ClassMethods.find(("+[" + Class + " " + Selector +
+                                             "]").str());
+  if (MI == ObjCMessages->ClassMethods.end())
+    return nullptr;
+  return getFunction(MI->getValue());
+}
+
+Value *DCInstrSema::insertObjCMessageCache(uint64_t Target) {
+  unsigned ReceiverReg, SelectorReg;
+  if (!EnableObjCMessageCaches || !getObjCMessageRegs(ReceiverReg, SelectorReg))
+    return nullptr;
+  // objc_msgSend is called through its stub, or declared by the module.
+  StringRef Name;
+  if (StubTargets) {
+    auto EI = StubTargets->ExternalNames.find(Target);
+    if (EI != StubTargets->ExternalNames.end())
+      Name = EI->second;
+  }
+  auto EI = ExternalNames.find(Target);
+  if (Name.empty() && EI != ExternalNames.end())
+    Name = EI->second;
+  if (Name != "objc_msgSend")
+    return nullptr;
+
+  Type *Int8PtrTy = Builder->getInt8PtrTy();
+  IntegerType *Int64Ty = Builder->getInt64Ty();
+  PointerType *FnPtrTy = FuncType->getPointerTo();
+  StructType *CacheTy = StructType::get(Int64Ty, FnPtrTy, nullptr);
+  GlobalVariable *Cache = new GlobalVariable(
+      *TheModule, CacheTy, false, GlobalValue::InternalLinkage,
+      Constant::getNullValue(CacheTy),
+      "objc_cache_" + utohexstr(CurrentInst->Address));
+
+  // nil, and the tagged pointers, with their top or bottom bit set, have no
+  // isa to load: they miss.
+  Value *Receiver = getReg(ReceiverReg);
+  Value *Selector = getReg(SelectorReg);
+  IntegerType *RegTy = cast<IntegerType>(Receiver->getType());
+  Value *IsObject = Builder->CreateAnd(
+      Builder->CreateICmpSGT(Receiver, ConstantInt::get(RegTy, 0)),
+      Builder->CreateICmpEQ(
+          Builder->CreateAnd(Receiver, ConstantInt::get(RegTy, 1)),
+          ConstantInt::get(RegTy, 0)));
+  Value *IsaPtr = getGuestPtr(Receiver, Int64Ty->getPointerTo());
+
+  BasicBlock *PrevBB = TheBB;
+  BasicBlock *IsaBB = BasicBlock::Create(*Ctx, "", TheFunction);
+  BasicBlock *HitBB = BasicBlock::Create(*Ctx, "", TheFunction);
+  BasicBlock *MissBB = BasicBlock::Create(*Ctx, "", TheFunction);
+  Builder->CreateCondBr(IsObject, IsaBB, MissBB);
+  DRS.FinalizeBasicBlock();
+  TheBB = BasicBlock::Create(*Ctx, "", TheFunction);
+
+  DCIRBuilder IsaBuilder(IsaBB, DRS.getCurrentAddress());
+  Value *Isa = IsaBuilder.CreateLoad(IsaPtr);
+  Value *CachedIsa =
+      IsaBuilder.CreateLoad(IsaBuilder.CreateStructGEP(CacheTy, Cache, 0));
+  IsaBuilder.CreateCondBr(IsaBuilder.CreateICmpEQ(Isa, CachedIsa), HitBB,
+                          MissBB);
+
+  DCIRBuilder HitBuilder(HitBB, DRS.getCurrentAddress());
+  Value *Entry =
+      HitBuilder.CreateLoad(HitBuilder.CreateStructGEP(CacheTy, Cache, 1));
+  HitBuilder.CreateBr(TheBB);
+
+  // The runtime returns the translation of the method, or null for
+  // objc_msgSend to send the message.
+  DCIRBuilder MissBuilder(MissBB, DRS.getCurrentAddress());
+  PHINode *MissIsa = MissBuilder.CreatePHI(Int64Ty, 2);
+  MissIsa->addIncoming(ConstantInt::get(Int64Ty, 0), PrevBB);
+  MissIsa->addIncoming(Isa, IsaBB);
+  Type *MissArgTys[] = {Int8PtrTy, Int64Ty, Int8PtrTy, Int8PtrTy};
+  Value *Method = MissBuilder.CreateCall(
+      DRS.getRuntimeFunction("__llvm_dc_objc_cache_miss",
+                             FunctionType::get(FnPtrTy, MissArgTys, false)),
+      {MissBuilder.CreateBitCast(Cache, Int8PtrTy), MissIsa,
+       MissBuilder.CreateBitCast(IsaPtr, Int8PtrTy),
+       MissBuilder.CreateIntToPtr(Selector, Int8PtrTy)});
+  Value *MissEntry = MissBuilder.CreateSelect(
+      MissBuilder.CreateICmpEQ(Method, ConstantPointerNull::get(FnPtrTy)),
+      ConstantExpr::getBitCast(getCallTarget(Target), FnPtrTy), Method);
+  MissBuilder.CreateBr(TheBB);
+
+  DRS.SwitchToBasicBlock(TheBB);
+  Builder->SetInsertPoint(TheBB);
+  PHINode *Callee = Builder->CreatePHI(FnPtrTy, 2);
+  Callee->addIncoming(Entry, HitBB);
+  Callee->addIncoming(MissEntry, MissBB);
+  return Callee;
+}
+
+const char *const DCInstrSema::EdgeCountersPrefix = "__sancov_gen_";
+const char *const DCInstrSema::EdgePCsPrefix = "__sancov_pcs_";
+
+// The section of the coverage globals named \p Name, and its bounds, as the
+// linker names them.
+static std::string getCoverageSection(const Triple &TT, StringRef Name) {
+  if (TT.isOSBinFormatMachO())
+    return ("__DATA," + Name).str();
+  return Name;
+}
+
+static Constant *getCoverageSectionBound(const Triple &TT, Module &M, Type *Ty,
+                                         StringRef Name, bool Start) {
+  std::string BoundName =
+      TT.isOSBinFormatMachO()
+          ? ("\1section$" + Twine(Start ? "start" : "end") + "$__DATA$" + Name)
+                .str()
+          : ("__" + Twine(Start ? "start_" : "stop_") + Name).str();
+  GlobalVariable *Bound = M.getGlobalVariable(BoundName);
+  if (!Bound) {
+    Bound = new GlobalVariable(M, Ty, false, GlobalValue::ExternalLinkage,
+                               nullptr, BoundName);
+    Bound->setVisibility(GlobalValue::HiddenVisibility);
+  }
+  return Bound;
+}
+
+// Keep \p GV, which nothing refers to, up to the linker.
+static void appendToCompilerUsed(Module &M, GlobalValue *GV) {
+  Type *Int8PtrTy = Type::getInt8PtrTy(M.getContext());
+  SmallVector<Constant *, 8> Used;
+  if (GlobalVariable *Old = M.getGlobalVariable("llvm.compiler.used")) {
+    if (auto *Init = dyn_cast<ConstantArray>(Old->getInitializer()))
+      for (Use &U : Init->operands())
+        Used.push_back(cast<Constant>(U));
+    Old->eraseFromParent();
+  }
+  Used.push_back(ConstantExpr::getBitCast(GV, Int8PtrTy));
+  ArrayType *UsedTy = ArrayType::get(Int8PtrTy, Used.size());
+  GlobalVariable *New = new GlobalVariable(
+      M, UsedTy, false, GlobalValue::AppendingLinkage,
+      ConstantArray::get(UsedTy, Used), "llvm.compiler.used");
+  New->setSection("llvm.metadata");
+}
+
+void DCInstrSema::insertEdgeCoverage(uint64_t FnAddr) {
+  // Each edge gets a counter, incremented where only that edge goes: at the
+  // end of its source, or at the start of its target, or in a block splitting
+  // it. The entry is first, as in SanitizerCoverage.
+  struct Edge {
+    Instruction *IP;
+    uint64_t Addr;
+  };
+  SmallVector<Edge, 16> Edges;
+  BasicBlock *EntryBB = &TheFunction->getEntryBlock();
+  Edges.push_back({EntryBB->getTerminator(), FnAddr});
+
+  SmallVector<BasicBlock *, 4> Preds;
+  SmallPtrSet<BasicBlock *, 4> SeenPreds;
+  for (const auto &AddrBB : BBByAddr) {
+    BasicBlock *BB = AddrBB.second;
+    Preds.clear();
+    SeenPreds.clear();
+    for (BasicBlock *Pred : predecessors(BB))
+      if (Pred != EntryBB && SeenPreds.insert(Pred).second)
+        Preds.push_back(Pred);
+    if (Preds.size() == 1 && AddrBB.first != FnAddr) {
+      Edges.push_back({BB->getFirstInsertionPt(), AddrBB.first});
+      continue;
+    }
+    for (BasicBlock *Pred : Preds) {
+      TerminatorInst *TI = Pred->getTerminator();
+      if (TI->getNumSuccessors() == 1) {
+        Edges.push_back({TI, AddrBB.first});
+        continue;
+      }
+      // The edges of an indirectbr can't be split; the others all come from
+      // the branches of a block that can.
+      BasicBlock *EdgeBB = SplitCriticalEdge(
+          Pred, BB, CriticalEdgeSplittingOptions().setMergeIdenticalEdges());
+      if (EdgeBB)
+        Edges.push_back({EdgeBB->getTerminator(), AddrBB.first});
+    }
+  }
+
+  Type *Int8Ty = Builder->getInt8Ty();
+  Type *IntPtrTy = Builder->getInt64Ty();
+  std::string FnName = TheFunction->getName();
+  ArrayType *CountersTy = ArrayType::get(Int8Ty, Edges.size());
+  GlobalVariable *Counters = new GlobalVariable(
+      *TheModule, CountersTy, false, GlobalValue::InternalLinkage,
+      Constant::getNullValue(CountersTy), EdgeCountersPrefix + FnName);
+  Counters->setSection(getCoverageSection(TargetTriple, "__sancov_cntrs"));
+
+  // The table has the address of the target of each edge, and its flags: 1
+  // for the function entry.
+  SmallVector<Constant *, 32> PCs;
+  for (unsigned I = 0, E = Edges.size(); I != E; ++I) {
+    DCIRBuilder EdgeBuilder(Edges[I].IP->getParent(), Edges[I].IP,
+                            DRS.getCurrentAddress());
+    Value *Counter = EdgeBuilder.CreateConstInBoundsGEP2_64(Counters, 0, I);
+    EdgeBuilder.CreateStore(
+        EdgeBuilder.CreateAdd(EdgeBuilder.CreateLoad(Counter),
+                              EdgeBuilder.getInt8(1)),
+        Counter);
+    PCs.push_back(ConstantInt::get(IntPtrTy, Edges[I].Addr));
+    PCs.push_back(ConstantInt::get(IntPtrTy, I == 0));
+  }
+  ArrayType *PCsTy = ArrayType::get(IntPtrTy, PCs.size());
+  GlobalVariable *PCTable = new GlobalVariable(
+      *TheModule, PCsTy, true, GlobalValue::InternalLinkage,
+      ConstantArray::get(PCsTy, PCs), EdgePCsPrefix + FnName);
+  PCTable->setSection(getCoverageSection(TargetTriple, "__sancov_pcs"));
+  PCTable->setAlignment(8);
+  appendToCompilerUsed(*TheModule, PCTable);
+
+  createEdgeCoverageCtor();
+}
+
+void DCInstrSema::structureLoops() {
+  MCDominatorTree DT;
+  DT.recalculate(*TheMCFunction);
+  MCLoopInfo LI;
+  LI.recalculate(DT);
+  if (LI.empty())
+    return;
+
+  // Each block is in the innermost loop of the MC block it was translated
+  // from: the blocks of BBByAddr, and those only reached through them, such
+  // as the call blocks and their continuations.
+  DenseMap<BasicBlock *, MCLoop *> BBLoops;
+  DenseMap<MCLoop *, std::vector<BasicBlock *>> LoopBlocks;
+  SmallPtrSet<BasicBlock *, 32> Heads;
+  for (const auto &AddrBB : BBByAddr)
+    Heads.insert(AddrBB.second);
+  SmallVector<BasicBlock *, 8> Worklist;
+  for (const MCBasicBlock *MCBB : *TheMCFunction) {
+    auto It = BBByAddr.find(MCBB->getStartAddr());
+    if (It == BBByAddr.end())
+      continue;
+    MCLoop *L = LI.getLoopFor(MCBB);
+    if (!BBLoops.insert(std::make_pair(It->second, L)).second)
+      continue;
+    Worklist.push_back(It->second);
+    while (!Worklist.empty()) {
+      BasicBlock *BB = Worklist.pop_back_val();
+      if (L)
+        LoopBlocks[L].push_back(BB);
+      for (BasicBlock *Succ : successors(BB))
+        if (Succ != ExitBB && !Heads.count(Succ) &&
+            BBLoops.insert(std::make_pair(Succ, L)).second)
+          Worklist.push_back(Succ);
+    }
+  }
+  auto IsInLoop = [&](BasicBlock *BB, MCLoop *L) {
+    MCLoop *BBLoop = BBLoops.lookup(BB);
+    return BBLoop && (BBLoop == L || L->contains(BBLoop));
+  };
+  auto AddToLoop = [&](BasicBlock *BB, MCLoop *L) {
+    BBLoops[BB] = L;
+    if (L)
+      LoopBlocks[L].push_back(BB);
+  };
+  // Collect the unique predecessors of BB, inside L or not. Return false if
+  // one is an indirectbr, whose edges can't be split.
+  auto GetPreds = [&](BasicBlock *BB, MCLoop *L,
+                      SmallVectorImpl<BasicBlock *> &Inside,
+                      SmallVectorImpl<BasicBlock *> &Outside) {
+    SmallPtrSet<BasicBlock *, 4> Seen;
+    for (BasicBlock *Pred : predecessors(BB)) {
+      if (!Seen.insert(Pred).second)
+        continue;
+      if (isa<IndirectBrInst>(Pred->getTerminator()))
+        return false;
+      (IsInLoop(Pred, L) ? Inside : Outside).push_back(Pred);
+    }
+    return true;
+  };
+
+  // The inner loops go first: the blocks they add to their parents are then
+  // in place when those are structured.
+  SmallVector<MCLoop *, 8> Loops(LI.begin(), LI.end());
+  for (unsigned I = 0; I != Loops.size(); ++I)
+    Loops.append(Loops[I]->begin(), Loops[I]->end());
+  const bool NameBBs = nameBlocks();
+  for (MCLoop *L : make_range(Loops.rbegin(), Loops.rend())) {
+    MCLoop *Parent = L->getParentLoop();
+    std::vector<BasicBlock *> Blocks = std::move(LoopBlocks[L]);
+    BasicBlock *Header = BBByAddr[L->getHeader()->getStartAddr()];
+    SmallVector<BasicBlock *, 4> Latches, OutsidePreds;
+    if (GetPreds(Header, L, Latches, OutsidePreds)) {
+      if (!OutsidePreds.empty() &&
+          (OutsidePreds.size() != 1 ||
+           OutsidePreds[0]->getTerminator()->getNumSuccessors() != 1))
+        AddToLoop(SplitBlockPredecessors(Header, OutsidePreds,
+                                         NameBBs ? ".preheader" : ""),
+                  Parent);
+      if (Latches.size() > 1) {
+        BasicBlock *Backedge = SplitBlockPredecessors(
+            Header, Latches, NameBBs ? ".backedge" : "");
+        BBLoops[Backedge] = L;
+        Blocks.push_back(Backedge);
+      }
+    }
+
+    SetVector<BasicBlock *> Exits;
+    for (BasicBlock *BB : Blocks)
+      for (BasicBlock *Succ : successors(BB))
+        if (!IsInLoop(Succ, L))
+          Exits.insert(Succ);
+    for (BasicBlock *Exit : Exits) {
+      SmallVector<BasicBlock *, 4> InsidePreds, Others;
+      if (!GetPreds(Exit, L, InsidePreds, Others) || Others.empty())
+        continue;
+      // The exit block is in the innermost loop that has both sides of it.
+      MCLoop *ExitLoop = Parent;
+      while (ExitLoop && !IsInLoop(Exit, ExitLoop))
+        ExitLoop = ExitLoop->getParentLoop();
+      AddToLoop(SplitBlockPredecessors(Exit, InsidePreds,
+                                       NameBBs ? ".loopexit" : ""),
+                ExitLoop);
+    }
+
+    if (Parent) {
+      std::vector<BasicBlock *> &ParentBlocks = LoopBlocks[Parent];
+      ParentBlocks.insert(ParentBlocks.end(), Blocks.begin(), Blocks.end());
+    }
+  }
+}
+
+void DCInstrSema::createEdgeCoverageCtor() {
+  const char *CtorName = "sancov.module_ctor_8bit_counters";
+  if (TheModule->getFunction(CtorName))
+    return;
+  // It's the same in all modules: the linker keeps one, and libFuzzer
+  // ignores the same sections registered again.
+  Function *Ctor = Function::Create(
+      FunctionType::get(Builder->getVoidTy(), false),
+      GlobalValue::LinkOnceODRLinkage, CtorName, TheModule);
+  Ctor->setVisibility(GlobalValue::HiddenVisibility);
+  DCIRBuilder CtorBuilder(BasicBlock::Create(*Ctx, "", Ctor));
+
+  Type *Int8Ty = CtorBuilder.getInt8Ty();
+  Type *IntPtrTy = CtorBuilder.getInt64Ty();
+  Constant *CountersInit = TheModule->getOrInsertFunction(
+      "__sanitizer_cov_8bit_counters_init", CtorBuilder.getVoidTy(),
+      Int8Ty->getPointerTo(), Int8Ty->getPointerTo(), nullptr);
+  CtorBuilder.CreateCall(
+      CountersInit,
+      {getCoverageSectionBound(TargetTriple, *TheModule, Int8Ty,
+                               "__sancov_cntrs", true),
+       getCoverageSectionBound(TargetTriple, *TheModule, Int8Ty,
+                               "__sancov_cntrs", false)});
+  Constant *PCsInit = TheModule->getOrInsertFunction(
+      "__sanitizer_cov_pcs_init", CtorBuilder.getVoidTy(),
+      IntPtrTy->getPointerTo(), IntPtrTy->getPointerTo(), nullptr);
+  CtorBuilder.CreateCall(
+      PCsInit, {getCoverageSectionBound(TargetTriple, *TheModule, IntPtrTy,
+                                        "__sancov_pcs", true),
+                getCoverageSectionBound(TargetTriple, *TheModule, IntPtrTy,
+                                        "__sancov_pcs", false)});
+  CtorBuilder.CreateRetVoid();
+  appendToGlobalCtors(*TheModule, Ctor, 2);
+}
+
+Function *DCInstrSema::getTrapFunction() {
+  if (!TrapFn)
+    TrapFn = Intrinsic::getDeclaration(TheModule, Intrinsic::trap);
+  return TrapFn;
 }
 
 BasicBlock *DCInstrSema::getOrCreateBasicBlock(uint64_t Addr) {
   BasicBlock *&BB = BBByAddr[Addr];
   if (!BB) {
-    BB = BasicBlock::Create(*Ctx, "bb_" + utohexstr(Addr), TheFunction);
-    DCIRBuilder BBBuilder(BB);
-    BBBuilder.CreateCall(Intrinsic::getDeclaration(TheModule, Intrinsic::trap));
-    BBBuilder.CreateUnreachable();
+    BB = BasicBlock::Create(
+        *Ctx, nameBlocks() ? "bb_" + utohexstr(Addr) : std::string(),
+        TheFunction);
   }
   return BB;
 }
 
-BasicBlock *DCInstrSema::insertCallBB(Value *Target) {
-  BasicBlock *CallBB =
-      BasicBlock::Create(*Ctx, TheBB->getName() + "_call", TheFunction);
-  Value *RegSetArg = &TheFunction->getArgumentList().front();
-  DCIRBuilder CallBuilder(CallBB);
-  CallBuilder.CreateCall(Target, {RegSetArg});
+BasicBlock *DCInstrSema::insertCallBB(Value *Target,
+                                      ArrayRef<Value *> ExtraArgs) {
+  bool NameBBs = nameBlocks();
+  BasicBlock *CallBB = BasicBlock::Create(
+      *Ctx, NameBBs ? TheBB->getName() + "_call" : Twine(), TheFunction);
+  SmallVector<Value *, 2> Args;
+  Args.push_back(&TheFunction->getArgumentList().front());
+  Args.append(ExtraArgs.begin(), ExtraArgs.end());
+  DCIRBuilder CallBuilder(CallBB, DRS.getCurrentAddress());
+  CallInst *Call = CallBuilder.CreateCall(Target, Args);
+  if (TagCallBBs)
+    Call->setMetadata(DCCallBBMDKind,
+                      MDNode::get(*Ctx, ConstantAsMetadata::get(
+                                            Builder->getInt64(TheBBAddr))));
   Builder->CreateBr(CallBB);
   assert(Builder->GetInsertPoint() == TheBB->end() &&
          "Call basic blocks can't be inserted at the middle of a basic block!");
-  StringRef BBName = TheBB->getName();
-  BBName = BBName.substr(0, BBName.find_first_of("_c"));
-  TheBB = BasicBlock::Create(
-      *Ctx, BBName + "_c" + utohexstr(CurrentInst->Address), TheFunction);
+  std::string BBName;
+  if (NameBBs) {
+    StringRef PrevName = TheBB->getName();
+    BBName = (PrevName.substr(0, PrevName.find_first_of("_c")) + "_c" +
+              utohexstr(CurrentInst->Address)).str();
+  }
+  TheBB = BasicBlock::Create(*Ctx, BBName, TheFunction);
   DRS.FinalizeBasicBlock();
   DRS.SwitchToBasicBlock(TheBB);
   Builder->SetInsertPoint(TheBB);
   CallBuilder.CreateBr(TheBB);
   CallBBs.push_back(CallBB);
+  CallBBsByAddr.push_back(std::make_pair(TheBBAddr, CallBB));
   // FIXME: Insert return address checking, to unwind back to the translator if
   // the call returned to an unexpected address.
   return CallBB;
 }
 
-Value *DCInstrSema::insertTranslateAt(Value *OrigTarget) {
-  void *CBPtr = DynTranslateAtCBPtr;
-  if (!CBPtr) {
-    // If we don't have access to the dynamic translate_at function, jump to
-    // some bad address.
-    // FIXME: A better target would be a dedicated IR function with just trap+
-    // unreachable, which would make it possible to debug more easily.
-    // FIXME: We should be able generate a table with all possible call targets
-    // from the symbol table.
-    CBPtr = reinterpret_cast<void *>(0xDEAD);
+void DCInstrSema::mergeCallBasicBlocks() {
+  // The call blocks of the function are the last ones recorded, in order.
+  assert(CallBBsByAddr.size() >= CallBBs.size() &&
+         "Call basic blocks weren't all recorded!");
+  auto Entry = CallBBsByAddr.end() - CallBBs.size();
+  for (BasicBlock *CallBB : CallBBs) {
+    assert(Entry->second == CallBB && "Call basic blocks out of order!");
+    // The saves and restores are in place: fold the call block, then the
+    // continuation, back into the block it was split from. Earlier calls of
+    // the same block were merged already, so that it is the final block.
+    BasicBlock *Pred = CallBB->getSinglePredecessor();
+    BasicBlock *Cont = CallBB->getSingleSuccessor();
+    if (Pred && MergeBlockIntoPredecessor(CallBB)) {
+      Entry->second = Pred;
+      if (Cont)
+        MergeBlockIntoPredecessor(Cont);
+    }
+    ++Entry;
   }
+}
 
+Value *DCInstrSema::getGuestPtr(Value *Addr, Type *PtrTy) {
+  if (uint64_t Base = DRS.getGuestMemoryBase())
+    Addr = Builder->CreateAdd(Addr, ConstantInt::get(Addr->getType(), Base));
+  return Builder->CreateIntToPtr(Addr, PtrTy);
+}
+
+Value *DCInstrSema::insertTranslateAt(Value *OrigTarget) {
+  // FIXME: We should be able generate a table with all possible call targets
+  // from the symbol table.
   FunctionType *CallbackType = FunctionType::get(
       FuncType->getPointerTo(), Builder->getInt8PtrTy(), false);
   return Builder->CreateCall(
-      DRS.getCallTargetForExtFn(CallbackType, CBPtr),
+      DRS.getRuntimeFunction("__llvm_dc_translate_at", CallbackType),
       {Builder->CreateIntToPtr(OrigTarget, Builder->getInt8PtrTy())});
 }
 
+void DCInstrSema::insertJumpTableSwitch(Value *Target) {
+  BasicBlock *DefaultBB = BasicBlock::Create(*Ctx, "", TheFunction);
+  SwitchInst *SI = Builder->CreateSwitch(
+      Target, DefaultBB, TheMCBB->succ_end() - TheMCBB->succ_begin());
+  IntegerType *TargetTy = cast<IntegerType>(Target->getType());
+  for (const MCBasicBlock *Succ :
+       make_range(TheMCBB->succ_begin(), TheMCBB->succ_end()))
+    SI->addCase(ConstantInt::get(TargetTy, Succ->getStartAddr()),
+                getOrCreateBasicBlock(Succ->getStartAddr()));
+
+  DRS.FinalizeBasicBlock();
+  TheBB = DefaultBB;
+  DRS.SwitchToBasicBlock(TheBB);
+  Builder->SetInsertPoint(TheBB);
+}
+
+bool DCInstrSema::translatesObjCARCCalls() { return EnableObjCARCCalls; }
+
+bool DCInstrSema::translatesAtomicLoops() { return EnableAtomicLoops; }
+
+// Get the type of the Objective-C ARC runtime function \p Name, as
+// ObjCARCInstKind recognizes it, or null if it isn't one.
+static FunctionType *getObjCARCFunctionType(StringRef Name, LLVMContext &Ctx) {
+  // The result, then the arguments, as DCExternalSignatures has them: 'v'oid,
+  // 'p' for an object (i8*), 'r' for a reference to one (i8**).
+  const char *Sig = StringSwitch<const char *>(Name)
+                        .Case("objc_retain", "pp")
+                        .Case("objc_retainAutoreleasedReturnValue", "pp")
+                        .Case("objc_retainBlock", "pp")
+                        .Case("objc_release", "vp")
+                        .Case("objc_autorelease", "pp")
+                        .Case("objc_autoreleaseReturnValue", "pp")
+                        .Case("objc_retainAutorelease", "pp")
+                        .Case("objc_retainAutoreleaseReturnValue", "pp")
+                        .Case("objc_autoreleasePoolPush", "p")
+                        .Case("objc_autoreleasePoolPop", "vp")
+                        .Case("objc_loadWeak", "pr")
+                        .Case("objc_loadWeakRetained", "pr")
+                        .Case("objc_destroyWeak", "vr")
+                        .Case("objc_storeWeak", "prp")
+                        .Case("objc_initWeak", "prp")
+                        .Case("objc_storeStrong", "vrp")
+                        .Case("objc_moveWeak", "vrr")
+                        .Case("objc_copyWeak", "vrr")
+                        .Default(nullptr);
+  if (!Sig)
+    return nullptr;
+  return DCExternalSignatures::getFunctionType(Sig, Ctx);
+}
+
+bool DCInstrSema::insertObjCARCCall(uint64_t Target) {
+  unsigned ArgRegs[2], ResultReg;
+  if (!EnableObjCARCCalls || !StubTargets ||
+      !getObjCARCRegs(ArgRegs[0], ArgRegs[1], ResultReg))
+    return false;
+  auto EI = StubTargets->ExternalNames.find(Target);
+  if (EI == StubTargets->ExternalNames.end())
+    return false;
+  FunctionType *FTy = getObjCARCFunctionType(EI->second, *Ctx);
+  if (!FTy)
+    return false;
+
+  SmallVector<Value *, 2> Args;
+  for (unsigned I = 0, E = FTy->getNumParams(); I != E; ++I)
+    Args.push_back(
+        Builder->CreateIntToPtr(getReg(ArgRegs[I]), FTy->getParamType(I)));
+  Value *Res = Builder->CreateCall(
+      TheModule->getOrInsertFunction(EI->second, FTy), Args);
+  // The registers the runtime clobbers aren't read before they are written
+  // again: they keep their value.
+  if (!FTy->getReturnType()->isVoidTy())
+    setReg(ResultReg,
+           Builder->CreatePtrToInt(Res, DRS.getRegType(ResultReg)));
+  return true;
+}
+
+void DCInstrSema::createObjCAccessorFunction(uint64_t Addr,
+                                             const DCObjCAccessor &A) {
+  ExternalCallRegs Regs;
+  bool HasRegs = getExternalCallRegs(Regs);
+  assert(HasRegs && Regs.IntArgRegs.size() > 2 &&
+         "Accessors need the argument registers");
+  (void)HasRegs;
+  Function *Fn = getFunction(Addr);
+  if (!Fn->isDeclaration())
+    return;
+  Fn->setDoesNotAlias(1);
+  Fn->setDoesNotCapture(1);
+
+  BasicBlock *BB = BasicBlock::Create(*Ctx, "", Fn);
+  Builder->SetInsertPoint(BB);
+  Value *RegSet = &*Fn->arg_begin();
+  auto GetRegPtr = [&](unsigned RegNo) {
+    Value *Idx[] = {Builder->getInt32(0),
+                    Builder->getInt32(DRS.getRegSetIndex(RegNo))};
+    return Builder->CreateInBoundsGEP(RegSet, Idx);
+  };
+  Value *Self = Builder->CreateLoad(GetRegPtr(Regs.IntArgRegs[0]));
+  Type *IvarTy = Builder->getIntNTy(A.Size * 8);
+  Value *IvarPtr = getGuestPtr(
+      Builder->CreateAdd(Self, ConstantInt::get(Self->getType(), A.Offset)),
+      IvarTy->getPointerTo());
+  FunctionType *RuntimeFTy =
+      A.RuntimeFn.empty() ? nullptr : getObjCARCFunctionType(A.RuntimeFn, *Ctx);
+  Constant *RuntimeFn =
+      RuntimeFTy ? TheModule->getOrInsertFunction(A.RuntimeFn, RuntimeFTy)
+                 : nullptr;
+
+  if (A.IsSetter) {
+    Value *Val = Builder->CreateLoad(GetRegPtr(Regs.IntArgRegs[2]));
+    if (RuntimeFn) {
+      Builder->CreateCall(
+          RuntimeFn,
+          {Builder->CreateBitCast(IvarPtr, RuntimeFTy->getParamType(0)),
+           Builder->CreateIntToPtr(Val, RuntimeFTy->getParamType(1))});
+    } else {
+      Builder->CreateStore(Builder->CreateTrunc(Val, IvarTy), IvarPtr);
+    }
+  } else {
+    Value *ResultPtr = GetRegPtr(Regs.IntResultReg);
+    Type *ResultTy = cast<PointerType>(ResultPtr->getType())->getElementType();
+    Value *Res = Builder->CreateZExt(Builder->CreateLoad(IvarPtr), ResultTy);
+    if (RuntimeFn)
+      Res = Builder->CreatePtrToInt(
+          Builder->CreateCall(RuntimeFn, Builder->CreateIntToPtr(
+                                             Res, RuntimeFTy->getParamType(0))),
+          ResultTy);
+    Builder->CreateStore(Res, ResultPtr);
+  }
+  Builder->CreateRetVoid();
+}
+
+bool DCInstrSema::insertTypedExternalCall(uint64_t Target) {
+  ExternalCallRegs Regs;
+  if (!EnableTypedExternalCalls || !StubTargets || !getExternalCallRegs(Regs))
+    return false;
+  auto EI = StubTargets->ExternalNames.find(Target);
+  if (EI == StubTargets->ExternalNames.end())
+    return false;
+  StringRef Sig = DCExternalSignatures::get().lookup(EI->second);
+  if (Sig.empty())
+    return false;
+  FunctionType *FTy = DCExternalSignatures::getFunctionType(Sig, *Ctx);
+
+  // Assign the registers first: the arguments past them are on the stack,
+  // and those calls are left to the regset.
+  SmallVector<unsigned, 8> ArgRegs;
+  unsigned NumIntArgs = 0, NumFPArgs = 0;
+  for (Type *ParamTy : FTy->params()) {
+    if (ParamTy->isFloatingPointTy()) {
+      if (NumFPArgs == Regs.FPArgRegs.size())
+        return false;
+      ArgRegs.push_back(Regs.FPArgRegs[NumFPArgs++]);
+    } else {
+      if (NumIntArgs == Regs.IntArgRegs.size())
+        return false;
+      ArgRegs.push_back(Regs.IntArgRegs[NumIntArgs++]);
+    }
+  }
+
+  SmallVector<Value *, 8> Args;
+  for (unsigned I = 0, E = FTy->getNumParams(); I != E; ++I) {
+    Type *ParamTy = FTy->getParamType(I);
+    Value *Reg = getReg(ArgRegs[I]);
+    if (ParamTy->isPointerTy()) {
+      Args.push_back(Builder->CreateIntToPtr(Reg, ParamTy));
+    } else if (ParamTy->isIntegerTy()) {
+      Args.push_back(Builder->CreateZExtOrTrunc(Reg, ParamTy));
+    } else {
+      // The FP arguments are the low bits of the vector registers.
+      Value *Bits = Builder->CreateTrunc(
+          Reg, Builder->getIntNTy(ParamTy->getPrimitiveSizeInBits()));
+      Args.push_back(Builder->CreateBitCast(Bits, ParamTy));
+    }
+  }
+  Value *Res = Builder->CreateCall(
+      TheModule->getOrInsertFunction(EI->second, FTy), Args);
+
+  // The registers the callee clobbers are dead after the call, per the
+  // calling convention: they keep their value.
+  Type *ResTy = FTy->getReturnType();
+  if (ResTy->isPointerTy()) {
+    setReg(Regs.IntResultReg, Builder->CreatePtrToInt(
+                                  Res, DRS.getRegType(Regs.IntResultReg)));
+  } else if (ResTy->isIntegerTy()) {
+    setReg(Regs.IntResultReg,
+           Builder->CreateZExt(Res, DRS.getRegType(Regs.IntResultReg)));
+  } else if (ResTy->isFloatingPointTy()) {
+    Value *Bits = Builder->CreateBitCast(
+        Res, Builder->getIntNTy(ResTy->getPrimitiveSizeInBits()));
+    setReg(Regs.FPResultReg,
+           Builder->CreateZExt(Bits, DRS.getRegType(Regs.FPResultReg)));
+  }
+  // Pop what the call pushed, as the callee's return would have.
+  if (Regs.ReturnAddrSize) {
+    Value *SP = getReg(Regs.StackPtrReg);
+    setReg(Regs.StackPtrReg,
+           Builder->CreateAdd(
+               SP, ConstantInt::get(SP->getType(), Regs.ReturnAddrSize)));
+  }
+  return true;
+}
+
 void DCInstrSema::insertCall(Value *CallTarget) {
+  MDNode *MessageTag = nullptr;
   if (ConstantInt *CI = dyn_cast<ConstantInt>(CallTarget)) {
     uint64_t Target = CI->getValue().getZExtValue();
-    CallTarget = getFunction(Target);
+    if (insertObjCARCCall(Target) || insertTypedExternalCall(Target))
+      return;
+    StringRef Selector, Class;
+    if (TagObjCMessages && getObjCMessage(Target, Selector, Class))
+      MessageTag = createDCObjCMessageTag(*Ctx, CurrentInst->Address,
+                                          Selector, Class);
+    if (Function *Method = resolveObjCMessage(Target))
+      CallTarget = Method;
+    else if (Value *Cached = insertObjCMessageCache(Target))
+      CallTarget = Cached;
+    else
+      CallTarget = getCallTarget(Target);
+  } else if (Constant *Callee = getConstantCallTarget()) {
+    CallTarget = Callee;
   } else {
     CallTarget = insertTranslateAt(CallTarget);
   }
-  insertCallBB(CallTarget);
+  BasicBlock *CallBB = insertCallBB(CallTarget);
+  if (MessageTag)
+    CallBB->front().setMetadata(DCObjCMessageMDKind, MessageTag);
+}
+
+Constant *DCInstrSema::getConstantCallTarget() {
+  // The indirect calls and branches go to their first operand.
+  const MCInst &Inst = CurrentInst->Inst;
+  MCConstantRegs::Value V;
+  if (!ConstantCallMIA || Inst.getNumOperands() == 0 ||
+      !Inst.getOperand(0).isReg() ||
+      !ConstantRegs.lookup(CurrentInst->Address, Inst.getOperand(0).getReg(),
+                           V))
+    return nullptr;
+  if (!V.IsLoad)
+    return getCallTarget(V.Val);
+  if (!StubTargets)
+    return nullptr;
+  auto AI = StubTargets->PointerAddrs.find(V.Val);
+  if (AI != StubTargets->PointerAddrs.end())
+    return getFunction(AI->second);
+  auto NI = StubTargets->PointerNames.find(V.Val);
+  if (NI != StubTargets->PointerNames.end())
+    return TheModule->getOrInsertFunction(NI->second, FuncType);
+  return nullptr;
+}
+
+void DCInstrSema::insertIndirectBr(Value *Target) {
+  setReg(DRS.MRI.getProgramCounter(), Target);
+  // The successors of an indirect branch are the targets of its jump table:
+  // switch to them, and only translate the other targets at runtime.
+  if (TheMCBB && TheMCBB->succ_begin() != TheMCBB->succ_end() &&
+      Target->getType()->isIntegerTy())
+    insertJumpTableSwitch(Target);
+  // FIXME: this should be only a branch!?
+  insertCall(Target);
+  Builder->CreateBr(ExitBB);
+}
+
+void DCInstrSema::unknownSemantics(const Twine &Reason) {
+  StringRef Name = DRS.MII.getName(CurrentInst->Inst.getOpcode());
+  if (!EnableUnknownFallback)
+    report_fatal_error("DC: " + Reason + " in " + Name + " at 0x" +
+                       utohexstr(CurrentInst->Address));
+  DEBUG(dbgs() << "Unknown semantics (" << Reason << ") in " << Name
+               << " at 0x" << utohexstr(CurrentInst->Address) << "\n");
+  CurrentInstUnknown = true;
+}
+
+void DCInstrSema::translateUnknownInst() {
+  StringRef Name = DRS.MII.getName(CurrentInst->Inst.getOpcode());
+  ++UnknownInstCounts[Name];
+
+  // void @dc.unknown.<opcode>(%regset*, i64 address)
+  Type *ArgTys[] = {DRS.getRegSetType()->getPointerTo(), Builder->getInt64Ty()};
+  Constant *Callee = TheModule->getOrInsertFunction(
+      ("dc.unknown." + Name).str(),
+      FunctionType::get(Builder->getVoidTy(), ArgTys, false));
+
+  // The semantics translated before reaching their unknown part are kept: they
+  // have no effect unless they already set a register, as the registers are
+  // all saved before the call, and reloaded after it.
+  UnknownCallBBs.insert(
+      insertCallBB(Callee, Builder->getInt64(CurrentInst->Address)));
+}
+
+void DCInstrSema::mergeUnknownInstCounts(const DCInstrSema &Other) {
+  for (const auto &KV : Other.UnknownInstCounts)
+    UnknownInstCounts[KV.getKey()] += KV.getValue();
+}
+
+void DCInstrSema::printUnknownInstSummary(raw_ostream &OS) const {
+  if (UnknownInstCounts.empty())
+    return;
+  std::vector<std::pair<unsigned, StringRef>> Counts;
+  unsigned Total = 0;
+  for (const auto &KV : UnknownInstCounts) {
+    Counts.push_back(std::make_pair(KV.getValue(), KV.getKey()));
+    Total += KV.getValue();
+  }
+  // Most frequent first, then by name, for a stable output.
+  std::sort(Counts.begin(), Counts.end(),
+            [](const std::pair<unsigned, StringRef> &L,
+               const std::pair<unsigned, StringRef> &R) {
+              return L.first != R.first ? L.first > R.first
+                                        : L.second < R.second;
+            });
+  OS << "DC: " << Total << " instructions (" << Counts.size()
+     << " opcodes) "
+     << (EnableUnknownFallback ? "translated to opaque dc.unknown calls"
+                               : "dropped, without semantics")
+     << ":\n";
+  for (const auto &C : Counts)
+    OS << format("%10u", C.first) << "  " << C.second << "\n";
 }
 
 void DCInstrSema::translateBinOp(Instruction::BinaryOps Opc) {
@@ -347,6 +1825,17 @@ void DCInstrSema::translateBinOp(Instruction::BinaryOps Opc) {
   Value *V2 = getNextOperand();
   if (Instruction::isShift(Opc) && V2->getType() != V1->getType())
     V2 = Builder->CreateZExt(V2, V1->getType());
+  Constant *C1 = dyn_cast<Constant>(V1), *C2 = dyn_cast<Constant>(V2);
+  if (FoldConstants && C1 && C2) {
+    Constant *Res = ConstantExpr::get(Opc, C1, C2);
+    // Only the sums are addresses, e.g. page + offset.
+    if (Opc == Instruction::Add)
+      if (ConstantInt *CI = dyn_cast<ConstantInt>(Res))
+        if (CI->getBitWidth() <= 64)
+          Res = getDataAddress(CI->getZExtValue(), CI->getType());
+    registerResult(Res);
+    return;
+  }
   registerResult(Builder->CreateBinOp(Opc, V1, V2));
 }
 
@@ -356,27 +1845,39 @@ void DCInstrSema::translateCastOp(Instruction::CastOps Opc) {
   if (ResEVT.getSimpleVT() == MVT::Untyped) {
     ResType = Val->getType();
   } else {
-    ResType = ResEVT.getTypeForEVT(*Ctx);
+    ResType = getTypeForVT(ResEVT);
   }
   registerResult(Builder->CreateCast(Opc, Val, ResType));
 }
 
 bool DCInstrSema::translateInst(const MCDecodedInst &DecodedInst,
-                                DCTranslatedInst &TranslatedInst) {
+                                DCTranslatedInst *TranslatedInst) {
+  if (OpcodeStatsTable.empty())
+    return translateInstImpl(DecodedInst, TranslatedInst);
+
+  // The IR created by the builders is what the semantics cost in IR; the
+  // rest, such as the call blocks, is shared by all instructions.
+  const DCInstAddress &CurAddr = *DRS.getCurrentAddress();
+  const uint64_t NumCreated = CurAddr.NumCreated;
+  auto Start = std::chrono::steady_clock::now();
+  bool Translated = translateInstImpl(DecodedInst, TranslatedInst);
+  std::chrono::duration<double> D = std::chrono::steady_clock::now() - Start;
+  OpcodeStats &S = OpcodeStatsTable[DecodedInst.Inst.getOpcode()];
+  ++S.NumInsts;
+  S.NumIRInsts += CurAddr.NumCreated - NumCreated;
+  S.Seconds += D.count();
+  return Translated;
+}
+
+bool DCInstrSema::translateInstImpl(const MCDecodedInst &DecodedInst,
+                                    DCTranslatedInst *TranslatedInst) {
+  if (NopOpcodes.test(DecodedInst.Inst.getOpcode()))
+    return true;
+
   CurrentInst = &DecodedInst;
-  CurrentTInst = &TranslatedInst;
-  /*
-    add by -death
-   */
-  if(record_or_not == true){
-    Builder->set_record_or_not(true);
-    Builder->set_cur_address(DecodedInst.Address);
-    DRS.set_builder_cur_add(DecodedInst.Address);
-  }
-  /*
-    add by -death end 
-   */
-  
+  CurrentTInst = TranslatedInst;
+  setCurrentAddress(DecodedInst.Address);
+
   DRS.SwitchToInst(DecodedInst);
 
   if (CurrentInst->Address == 0x101AC6BC8) {
@@ -387,9 +1888,8 @@ bool DCInstrSema::translateInst(const MCDecodedInst &DecodedInst,
   if (EnableInstAddrSave) {
     ConstantInt *CurIVal =
         Builder->getInt64(reinterpret_cast<uint64_t>(CurrentInst->Address));
-    Value *CurIPtr = ConstantExpr::getIntToPtr(
-        Builder->getInt64(reinterpret_cast<uint64_t>(&__llvm_dc_current_instr)),
-        Builder->getInt64Ty()->getPointerTo());
+    Value *CurIPtr = TheModule->getOrInsertGlobal("__llvm_dc_current_instr",
+                                                  Builder->getInt64Ty());
     Builder->CreateStore(CurIVal, CurIPtr, true);
   }
 //    CurrentInst->Inst.dump();
@@ -399,22 +1899,18 @@ bool DCInstrSema::translateInst(const MCDecodedInst &DecodedInst,
         errs() << "foo";
     }
   Idx = OpcodeToSemaIdx[CurrentInst->Inst.getOpcode()];
-  /*
-    add by -death  测试删除所有的nop代码。
-    删除该测试代码
-   */
-  /*
-  if(CurrentInst->Inst.getOpcode()==738){       // DCInstrSema scales to both X86 and AArch64, move this code snippet to AArch64InstrSema instead. AArch64::HINT http://infocenter.arm.com/help/index.jsp?topic=/com.arm.doc.dui0802a/HINT.html
-   // errs()<<"the opcode is hint \n";
-    return true;
-  }*/
-  /*
-    add by -death end 
-   */
   DEBUG(errs() << "[+]Idx: " << Idx << "\n");
-  if (!translateTargetInst()) {
-    if (Idx == 0)
-      return false;
+  CurrentInstUnknown = false;
+  if (!translateTailCallReturn() && !translateCalleeSavedSpill() &&
+      !translateMemoryTransfer() && !translateTargetInst()) {
+    if (Idx == 0) {
+      if (!EnableUnknownFallback) {
+        // The instruction is dropped: it is only counted, for the summary.
+        ++UnknownInstCounts[DRS.MII.getName(CurrentInst->Inst.getOpcode())];
+        return false;
+      }
+      CurrentInstUnknown = true;
+    }
 
     {
       // Increment the PC before anything.
@@ -426,14 +1922,20 @@ bool DCInstrSema::translateInst(const MCDecodedInst &DecodedInst,
       //                 CurrentInst->Size)));
     }
 
-    while ((Opcode = Next()) != DCINS::END_OF_INSTRUCTION) {
+    while (!CurrentInstUnknown &&
+           (Opcode = Next()) != DCINS::END_OF_INSTRUCTION) {
 //      errs() << "[+]Opcode: " << utohexstr(Opcode) << "\n";
       if (translateOpcode(Opcode)) continue;
 //      errs() << "[!]CurrentInst->Address: " << utohexstr(CurrentInst->Address) << "\n";
+      if (EnableUnknownFallback)
+        CurrentInstUnknown = true;
       break;
     }
   }
 
+  if (CurrentInstUnknown)
+    translateUnknownInst();
+
   Vals.clear();
     
 //    delete CurrentInst;
@@ -444,6 +1946,84 @@ bool DCInstrSema::translateInst(const MCDecodedInst &DecodedInst,
   return true;
 }
 
+bool DCInstrSema::translateCalleeSavedSpill() {
+  if (!CalleeSavedSpills.isSpill(CurrentInst->Address))
+    return false;
+  MCInstrAnalysis::StackSpill S;
+  bool IsSpill = CalleeSavedMIA->evaluateStackSpill(CurrentInst->Inst, S);
+  assert(IsSpill && "Callee-saved spill not recognized again?");
+  (void)IsSpill;
+  // The saved values are only read by the restores, which get them from the
+  // regset instead: the saves have nothing left to do.
+  if (S.IsLoad)
+    for (unsigned I = 0; I != S.NumRegs; ++I)
+      setReg(S.Regs[I], DRS.getIncomingReg(S.Regs[I]));
+  if (S.SPAdjust) {
+    Value *SP = getReg(S.BaseReg);
+    setReg(S.BaseReg,
+           Builder->CreateAdd(SP, ConstantInt::get(SP->getType(), S.SPAdjust)));
+  }
+  return true;
+}
+
+bool DCInstrSema::translateTailCallReturn() {
+  // The exit instrumentation must run on all the returns. With the calls
+  // that only save some registers, the others are only saved by ExitBB.
+  if (!EnableTailCallReturns || EnableRegSetDiff || EnableRegSetTrace ||
+      EnableABIAwareCalls || CallSummaries || !TheMCFunction || !TheMCBB ||
+      CurrentInst <= TheMCBB->begin() || CurrentInst >= TheMCBB->end() ||
+      !TheMCFunction->isTailCall((CurrentInst - 1)->Address))
+    return false;
+  // The call went through the regset, as a call block, unless it was to the
+  // ARC runtime or typed: the registers those set are saved by ExitBB.
+  if (CallBBs.empty() || !TheBB->empty() ||
+      TheBB->getSinglePredecessor() != CallBBs.back())
+    return false;
+  // All the registers were saved before the call, and the callee left the
+  // regset as the function returns it: ExitBB would only store back what
+  // the call reloaded.
+  Builder->CreateRetVoid();
+  return true;
+}
+
+bool DCInstrSema::translateMemoryTransfer() {
+  const MCMemoryTransfers::Transfer *T =
+      MemoryTransfers.lookup(CurrentInst->Address);
+  if (!T)
+    return false;
+  // The whole run is translated at its first instruction.
+  if (CurrentInst->Address != T->BeginAddr)
+    return true;
+  // The base registers aren't written by the run.
+  Value *DstBase = getReg(T->DstBaseReg);
+  auto getBlockPtr = [&](Value *Base, int64_t Offset, Type *PtrTy) {
+    if (Offset)
+      Base =
+          Builder->CreateAdd(Base, ConstantInt::get(Base->getType(), Offset));
+    return getGuestPtr(Base, PtrTy);
+  };
+  Value *Dst = getBlockPtr(DstBase, T->DstOffset, Builder->getInt8PtrTy());
+  if (T->isClear()) {
+    Builder->CreateMemSet(Dst, Builder->getInt8(0), T->Size, 1);
+    return true;
+  }
+  // The registers are all loaded before being stored: the source is read
+  // before the destination is written, as memmove does.
+  Value *Src = getBlockPtr(getReg(T->SrcBaseReg), T->SrcOffset,
+                           Builder->getInt8PtrTy());
+  Builder->CreateMemMove(Dst, Src, T->Size, 1);
+  // Each register holds what it was stored, which the source may not
+  // anymore, if they overlap.
+  for (const auto &RegOffset : T->Regs) {
+    Type *RegTy = DRS.getRegType(RegOffset.first);
+    setReg(RegOffset.first,
+           Builder->CreateAlignedLoad(
+               getBlockPtr(DstBase, RegOffset.second, RegTy->getPointerTo()),
+               1));
+  }
+  return true;
+}
+
 // Change translateOpcode type to boolean to judge whether translate successfully or not. 
 bool DCInstrSema::translateOpcode(unsigned Opcode) {
   ResEVT = NextVT();
@@ -568,10 +2148,20 @@ bool DCInstrSema::translateOpcode(unsigned Opcode) {
     break;
   }
 
+  case ISD::SCALAR_TO_VECTOR: {
+    // The other elements are undefined in the DAG, but the moves that match
+    // it (as MOVD) clear them.
+    Value *Val = getNextOperand();
+    Type *VecTy = ResEVT.getTypeForEVT(*Ctx);
+    registerResult(Builder->CreateInsertElement(
+        Constant::getNullValue(VecTy), Val, Builder->getInt32(0)));
+    break;
+  }
+
   case ISD::SMUL_LOHI: {
     EVT Re2EVT = NextVT();
-    IntegerType *LoResType = cast<IntegerType>(ResEVT.getTypeForEVT(*Ctx));
-    IntegerType *HiResType = cast<IntegerType>(Re2EVT.getTypeForEVT(*Ctx));
+    IntegerType *LoResType = cast<IntegerType>(getTypeForVT(ResEVT));
+    IntegerType *HiResType = cast<IntegerType>(getTypeForVT(Re2EVT));
     IntegerType *ResType = IntegerType::get(*Ctx, LoResType->getBitWidth() +
                                                       HiResType->getBitWidth());
     Value *Op1 = getNextOperand(), *Op2 = getNextOperand();
@@ -584,8 +2174,8 @@ bool DCInstrSema::translateOpcode(unsigned Opcode) {
   }
   case ISD::UMUL_LOHI: {
     EVT Re2EVT = NextVT();
-    IntegerType *LoResType = cast<IntegerType>(ResEVT.getTypeForEVT(*Ctx));
-    IntegerType *HiResType = cast<IntegerType>(Re2EVT.getTypeForEVT(*Ctx));
+    IntegerType *LoResType = cast<IntegerType>(getTypeForVT(ResEVT));
+    IntegerType *HiResType = cast<IntegerType>(getTypeForVT(Re2EVT));
     IntegerType *ResType = IntegerType::get(*Ctx, LoResType->getBitWidth() +
                                                       HiResType->getBitWidth());
     Value *Op1 = getNextOperand(), *Op2 = getNextOperand();
@@ -602,10 +2192,10 @@ bool DCInstrSema::translateOpcode(unsigned Opcode) {
     if (ResEVT.getSimpleVT() == MVT::Untyped) {
       ResType = Ptr->getType();
     } else {
-      ResType = ResEVT.getTypeForEVT(*Ctx);
+      ResType = getTypeForVT(ResEVT);
     }
     if (!Ptr->getType()->isPointerTy())
-      Ptr = Builder->CreateIntToPtr(Ptr, ResType->getPointerTo());
+      Ptr = getGuestPtr(Ptr, ResType->getPointerTo());
     assert(Ptr->getType()->getPointerElementType() == ResType &&
            "Mismatch between a LOAD's address operand and return type!");
     registerResult(Builder->CreateAlignedLoad(Ptr, 1));
@@ -617,18 +2207,14 @@ bool DCInstrSema::translateOpcode(unsigned Opcode) {
     Type *ValPtrTy = Val->getType()->getPointerTo();
     Type *PtrTy = Ptr->getType();
     if (!PtrTy->isPointerTy())
-      Ptr = Builder->CreateIntToPtr(Ptr, ValPtrTy);
+      Ptr = getGuestPtr(Ptr, ValPtrTy);
     else if (PtrTy != ValPtrTy)
       Ptr = Builder->CreateBitCast(Ptr, ValPtrTy);
     Builder->CreateAlignedStore(Val, Ptr, 1);
     break;
   }
   case ISD::BRIND: {
-    Value *Op1 = getNextOperand();
-    setReg(DRS.MRI.getProgramCounter(), Op1);
-    // FIXME: this should be only a branch!?
-    insertCall(Op1);
-    Builder->CreateBr(ExitBB);
+    insertIndirectBr(getNextOperand());
     break;
   }
   case ISD::BR: {
@@ -640,7 +2226,7 @@ bool DCInstrSema::translateOpcode(unsigned Opcode) {
     break;
   }
   case ISD::TRAP: {
-    Builder->CreateCall(Intrinsic::getDeclaration(TheModule, Intrinsic::trap));
+    Builder->CreateCall(getTrapFunction());
     break;
   }
   case DCINS::PUT_RC: {
@@ -663,21 +2249,23 @@ bool DCInstrSema::translateOpcode(unsigned Opcode) {
 
     assert(Res->getType() == RegType);
     setReg(RegNo, Res);
-    CurrentTInst->addRegOpDef(MIOperandNo, Res);
+    if (CurrentTInst)
+      CurrentTInst->addRegOpDef(MIOperandNo, Res);
     break;
   }
   case DCINS::PUT_REG: {
     unsigned RegNo = Next();
     Value *Res = getNextOperand();
     setReg(RegNo, Res);
-    CurrentTInst->addImpDef(RegNo, Res);
+    if (CurrentTInst)
+      CurrentTInst->addImpDef(RegNo, Res);
     break;
   }
   case DCINS::GET_RC: {
       unsigned MIOperandNo = Next();
     Type *ResType = NULL;
-    if (ResEVT.getEVTString() != "Untyped") {
-      ResType = ResEVT.getTypeForEVT(*Ctx);
+    if (ResEVT.getSimpleVT() != MVT::Untyped) {
+      ResType = getTypeForVT(ResEVT);
     }
 
     Value *Reg = getReg(getRegOp(MIOperandNo));
@@ -688,29 +2276,33 @@ bool DCInstrSema::translateOpcode(unsigned Opcode) {
     if (ResType && !ResType->isIntegerTy())
       Reg = Builder->CreateBitCast(Reg, ResType);
     registerResult(Reg);
-    CurrentTInst->addRegOpUse(MIOperandNo, Reg);
+    if (CurrentTInst)
+      CurrentTInst->addRegOpUse(MIOperandNo, Reg);
     break;
   }
   case DCINS::GET_REG: {
     unsigned RegNo = Next();
     Value *RegVal = getReg(RegNo);
     registerResult(RegVal);
-    CurrentTInst->addImpUse(RegNo, RegVal);
+    if (CurrentTInst)
+      CurrentTInst->addImpUse(RegNo, RegVal);
     break;
   }
   case DCINS::CUSTOM_OP: {
     unsigned OperandType = Next(), MIOperandNo = Next();
     translateOperand(OperandType, MIOperandNo);
-    CurrentTInst->addOpUse(MIOperandNo, OperandType, Vals.back());
+    if (CurrentTInst)
+      CurrentTInst->addOpUse(MIOperandNo, OperandType, Vals.back());
     break;
   }
   case DCINS::CONSTANT_OP: {
     unsigned MIOperandNo = Next();
-    Type *ResType = ResEVT.getTypeForEVT(*Ctx);
+    Type *ResType = getTypeForVT(ResEVT);
     Value *Cst =
         ConstantInt::get(cast<IntegerType>(ResType), getImmOp(MIOperandNo));
     registerResult(Cst);
-    CurrentTInst->addImmOpUse(MIOperandNo, Cst);
+    if (CurrentTInst)
+      CurrentTInst->addImmOpUse(MIOperandNo, Cst);
     break;
   }
   case DCINS::MOV_CONSTANT: {
@@ -720,7 +2312,7 @@ bool DCInstrSema::translateOpcode(unsigned Opcode) {
       // FIXME: what should we do here? Maybe use DL's intptr type?
       ResType = Builder->getInt64Ty();
     else
-      ResType = ResEVT.getTypeForEVT(*Ctx);
+      ResType = getTypeForVT(ResEVT);
     registerResult(ConstantInt::get(ResType, ConstantArray[ValIdx]));
     break;
   }
@@ -743,7 +2335,7 @@ bool DCInstrSema::translateOpcode(unsigned Opcode) {
     break;
   }
   case ISD::BSWAP: {
-    Type *ResType = ResEVT.getTypeForEVT(*Ctx);
+    Type *ResType = getTypeForVT(ResEVT);
     Value *Op = getNextOperand();
     Value *IntDecl =
         Intrinsic::getDeclaration(TheModule, Intrinsic::bswap, ResType);
@@ -769,14 +2361,14 @@ bool DCInstrSema::translateOpcode(unsigned Opcode) {
     if (ResEVT.isVector()) {
       Value *vec = getNextOperand();
       Value *result = Builder->getInt(APInt(ResEVT.getSizeInBits(), 0));
-      result = Builder->CreateBitCast(result, ResEVT.getTypeForEVT(*Ctx));
+      result = Builder->CreateBitCast(result, getTypeForVT(ResEVT));
       for (unsigned i = 0; i < ResEVT.getVectorNumElements(); ++i) {
         Value *elem = Builder->CreateExtractElement(vec, i);
         result = Builder->CreateInsertElement(result, count(elem), i);
       }
       registerResult(result);
     } else {
-      Type *ResType = ResEVT.getTypeForEVT(*Ctx);
+      Type *ResType = getTypeForVT(ResEVT);
       Value *Op = getNextOperand();
       registerResult(count(Op));
     }
@@ -835,12 +2427,12 @@ bool DCInstrSema::translateOpcode(unsigned Opcode) {
     break;
   }
   case ISD::ConstantFP: {
-    registerResult(ConstantFP::get(ResEVT.getTypeForEVT(*Ctx), 0.0));
+    registerResult(ConstantFP::get(getTypeForVT(ResEVT), 0.0));
     break;
   }
   case ISD::MULHU: {
     Type *ExtType = IntegerType::get(
-        *Ctx, 2 * ResEVT.getTypeForEVT(*Ctx)->getIntegerBitWidth());
+        *Ctx, 2 * getTypeForVT(ResEVT)->getIntegerBitWidth());
 
     Value *LHS = getNextOperand();
     Value *RHS = getNextOperand();
@@ -850,13 +2442,13 @@ bool DCInstrSema::translateOpcode(unsigned Opcode) {
     Value *Result = Builder->CreateMul(LHS, RHS);
     Result = Builder->CreateLShr(Result,
                                  Result->getType()->getIntegerBitWidth() / 2);
-    Result = Builder->CreateTrunc(Result, ResEVT.getTypeForEVT(*Ctx));
+    Result = Builder->CreateTrunc(Result, getTypeForVT(ResEVT));
     registerResult(Result);
     break;
   }
   case ISD::MULHS: {
     Type *ExtType = IntegerType::get(
-        *Ctx, 2 * ResEVT.getTypeForEVT(*Ctx)->getIntegerBitWidth());
+        *Ctx, 2 * getTypeForVT(ResEVT)->getIntegerBitWidth());
 
     Value *LHS = getNextOperand();
     Value *RHS = getNextOperand();
@@ -866,7 +2458,7 @@ bool DCInstrSema::translateOpcode(unsigned Opcode) {
     Value *Result = Builder->CreateMul(LHS, RHS);
     Result = Builder->CreateLShr(Result,
                                  Result->getType()->getIntegerBitWidth() / 2);
-    Result = Builder->CreateTrunc(Result, ResEVT.getTypeForEVT(*Ctx));
+    Result = Builder->CreateTrunc(Result, getTypeForVT(ResEVT));
     registerResult(Result);
     break;
   }
@@ -876,7 +2468,7 @@ bool DCInstrSema::translateOpcode(unsigned Opcode) {
         Builder->getInt(APInt(ResEVT.getSimpleVT().getScalarSizeInBits() *
                                   ResEVT.getSimpleVT().getVectorNumElements(),
                               0));
-    Vector = Builder->CreateBitCast(Vector, ResEVT.getTypeForEVT(*Ctx));
+    Vector = Builder->CreateBitCast(Vector, getTypeForVT(ResEVT));
     registerResult(Vector);
     break;
   }
@@ -966,7 +2558,7 @@ bool DCInstrSema::translateOpcode(unsigned Opcode) {
     assert(constantInt);
     //          constantInt->dump();
     Value *result = Builder->getInt(APInt(ResEVT.getSizeInBits(), 0));
-    result = Builder->CreateBitCast(result, ResEVT.getTypeForEVT(*Ctx));
+    result = Builder->CreateBitCast(result, getTypeForVT(ResEVT));
     //          if (constantInt->getZExtValue() == 2) {
     for (unsigned i = 0; i < ResEVT.getVectorNumElements(); ++i) {
       Value *elem =
@@ -1008,7 +2600,7 @@ bool DCInstrSema::translateOpcode(unsigned Opcode) {
       Value *vec1 = getNextOperand();
       Value *vec2 = getNextOperand();
       Value *res = Builder->getInt(APInt(ResEVT.getSizeInBits(), 0));
-      res = Builder->CreateBitCast(res, ResEVT.getTypeForEVT(*Ctx));
+      res = Builder->CreateBitCast(res, getTypeForVT(ResEVT));
 
       for (unsigned i = 0; i < ResEVT.getVectorNumElements(); ++i) {
         Value *elem1 = Builder->CreateExtractElement(vec1, i);
@@ -1059,7 +2651,7 @@ bool DCInstrSema::translateOpcode(unsigned Opcode) {
     if (ResEVT.isVector()) {
       Value *vec = getNextOperand();
       Value *res = Builder->getInt(APInt(ResEVT.getSizeInBits(), 0));
-      res = Builder->CreateBitCast(res, ResEVT.getTypeForEVT(*Ctx));
+      res = Builder->CreateBitCast(res, getTypeForVT(ResEVT));
 
       for (unsigned i = 0; i < ResEVT.getVectorNumElements(); ++i) {
         Value *elem = Builder->CreateExtractElement(vec, i);
@@ -0,0 +1,474 @@
+//===-- lib/DC/DCMachOObject.cpp - Mach-O inputs of DC --------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/DC/DCMachOObject.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/MC/MCAnalysis/MCObjectSymbolizer.h"
+#include "llvm/Object/DyldSharedCache.h"
+#include "llvm/Object/MachO.h"
+#include "llvm/Object/MachOBindingIndex.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+
+#define DEBUG_TYPE "macho-stubs"
+
+using namespace llvm;
+using namespace object;
+
+// Decode the 12-byte AArch64 stub at StubAddr, one of:
+//   nop                     or   adrp x16, lazy_ptr@PAGE
+//   ldr  x16, lazy_ptr           ldr  x16, [x16, lazy_ptr@PAGEOFF]
+//   br   x16                     br   x16
+// and compute the address of the lazy pointer it jumps through.
+static bool decodeStub(const uint8_t *Bytes, uint64_t StubAddr,
+                       uint64_t &LazyPtrAddr) {
+  uint32_t First = support::endian::read32le(Bytes);
+  uint32_t Load = support::endian::read32le(Bytes + 4);
+  uint32_t Branch = support::endian::read32le(Bytes + 8);
+
+  // br xN
+  if ((Branch & 0xFFFFFC1F) != 0xD61F0000)
+    return false;
+
+  if (First == 0xD503201F) {
+    // ldr xN, literal: imm19 words from the ldr.
+    if ((Load & 0xFF000000) != 0x58000000)
+      return false;
+    int64_t Imm = SignExtend64<19>((Load >> 5) & 0x7FFFF);
+    LazyPtrAddr = StubAddr + 4 + Imm * 4;
+    return true;
+  }
+
+  if ((First & 0x9F000000) == 0x90000000) {
+    // adrp xN, page: immhi:immlo pages from the page of the adrp.
+    int64_t Page = SignExtend64<21>((((First >> 5) & 0x7FFFF) << 2) |
+                                    ((First >> 29) & 0x3));
+    // ldr xN, [xN, #imm12 * 8]
+    if ((Load & 0xFFC00000) != 0xF9400000)
+      return false;
+    uint64_t Offset = ((Load >> 10) & 0xFFF) * 8;
+    LazyPtrAddr = (StubAddr & ~0xFFFULL) + Page * 4096 + Offset;
+    return true;
+  }
+  return false;
+}
+
+// Decode the 16-byte arm64e stub at StubAddr, which authenticates the
+// pointer it jumps through, of __auth_got:
+//   adrp x17, ptr@PAGE
+//   add  x17, x17, ptr@PAGEOFF
+//   ldr  x16, [x17]
+//   braa x16, x17
+// and compute the address of the pointer.
+static bool decodeAuthStub(const uint8_t *Bytes, uint64_t StubAddr,
+                           uint64_t &PtrAddr) {
+  uint32_t First = support::endian::read32le(Bytes);
+  uint32_t Add = support::endian::read32le(Bytes + 4);
+  uint32_t Load = support::endian::read32le(Bytes + 8);
+  uint32_t Branch = support::endian::read32le(Bytes + 12);
+  if ((First & 0x9F00001F) != 0x90000011 ||
+      (Add & 0xFFC003FF) != 0x91000231 || Load != 0xF9400230 ||
+      Branch != 0xD71F0A11)
+    return false;
+  int64_t Page = SignExtend64<21>((((First >> 5) & 0x7FFFF) << 2) |
+                                  ((First >> 29) & 0x3));
+  PtrAddr = (StubAddr & ~0xFFFULL) + Page * 4096 + ((Add >> 10) & 0xFFF);
+  return true;
+}
+
+// Decode the 12-byte AArch64 stub at StubAddr that the dyld shared cache
+// builder made direct:
+//   adrp x16, target@PAGE
+//   add  x16, x16, target@PAGEOFF
+//   br   x16
+// and compute the address it jumps to.
+static bool decodeDirectStub(const uint8_t *Bytes, uint64_t StubAddr,
+                             uint64_t &TargetAddr) {
+  uint32_t First = support::endian::read32le(Bytes);
+  uint32_t Add = support::endian::read32le(Bytes + 4);
+  uint32_t Branch = support::endian::read32le(Bytes + 8);
+  if ((Branch & 0xFFFFFC1F) != 0xD61F0000 ||
+      (First & 0x9F000000) != 0x90000000 ||
+      // add xN, xN, #imm12, unshifted
+      (Add & 0xFFC00000) != 0x91000000)
+    return false;
+  int64_t Page = SignExtend64<21>((((First >> 5) & 0x7FFFF) << 2) |
+                                  ((First >> 29) & 0x3));
+  TargetAddr = (StubAddr & ~0xFFFULL) + Page * 4096 + ((Add >> 10) & 0xFFF);
+  return true;
+}
+
+// Get the name of the external function the lazy pointer at LazyPtrAddr is
+// bound to, with the binding kind K, without its leading '_'.
+static StringRef getBoundFunctionName(const MachOBindingIndex &Binds,
+                                      uint64_t LazyPtrAddr,
+                                      MachOBindEntry::Kind K) {
+  StringRef Name = Binds.getSymbolName(LazyPtrAddr, K);
+  if (Name.empty())
+    return Name;
+  return Name.substr(1);
+}
+
+void llvm::resolveMachOStubs(const MachOObjectFile &MachO,
+                             const MachOBindingIndex &Binds,
+                             MCObjectSymbolizer &MOS, DCStubTargets &Stubs) {
+  // The stubs of arm64e are in __auth_stubs, and those of other binaries
+  // that call through unauthenticated pointers in __stubs.
+  struct StubSection {
+    StringRef Bytes;
+    uint64_t Addr;
+    bool IsAuth;
+  };
+  SmallVector<StubSection, 2> StubSections;
+  StringRef LazyPtrBytes;
+  uint64_t LazyPtrSectionAddr = 0;
+  uint64_t StubHelperAddr = 0, StubHelperSize = 0;
+  uint64_t TextAddr = 0, TextSize = 0;
+  for (const SectionRef &Section : MachO.sections()) {
+    StringRef Name;
+    Section.getName(Name);
+    if (Name == "__stubs" || Name == "__auth_stubs") {
+      StubSection S = {StringRef(), Section.getAddress(),
+                       Name == "__auth_stubs"};
+      Section.getContents(S.Bytes);
+      StubSections.push_back(S);
+    } else if (Name == "__stub_helper") {
+      StubHelperAddr = Section.getAddress();
+      StubHelperSize = Section.getSize();
+    } else if (Name == "__la_symbol_ptr") {
+      Section.getContents(LazyPtrBytes);
+      LazyPtrSectionAddr = Section.getAddress();
+    } else if (Name == "__text") {
+      TextAddr = Section.getAddress();
+      TextSize = Section.getSize();
+    }
+  }
+
+  for (const StubSection &Sect : StubSections) {
+    const uint64_t StubSize = Sect.IsAuth ? 16 : 12;
+    for (uint64_t Index = 0; Index + StubSize <= Sect.Bytes.size();
+         Index += StubSize) {
+      uint64_t StubAddr = Sect.Addr + Index;
+      const uint8_t *Bytes = Sect.Bytes.bytes_begin() + Index;
+
+      StringRef Name;
+      uint64_t LazyPtrAddr;
+      if (!(Sect.IsAuth ? decodeAuthStub(Bytes, StubAddr, LazyPtrAddr)
+                        : decodeStub(Bytes, StubAddr, LazyPtrAddr))) {
+        DEBUG(dbgs() << "Unknown stub at " << utohexstr(StubAddr) << "\n");
+      } else if (LazyPtrAddr < LazyPtrSectionAddr ||
+                 LazyPtrAddr - LazyPtrSectionAddr + 8 > LazyPtrBytes.size()) {
+        // Without lazy binding, as with chained fixups, the stubs load a
+        // pointer of __got (or __auth_got), which dyld binds at launch.
+        Name = getBoundFunctionName(Binds, LazyPtrAddr,
+                                    MachOBindEntry::Kind::Regular);
+        // Or a chained rebase, to a local function.
+        uint64_t Target;
+        if (Name.empty() && Binds.getChainedValue(LazyPtrAddr, Target) &&
+            Target >= TextAddr && Target < TextAddr + TextSize) {
+          Stubs.LocalAddrs[StubAddr] = Target;
+          continue;
+        }
+        DEBUG(if (Name.empty()) dbgs() << "Stub at " << utohexstr(StubAddr)
+                                       << " doesn't use a bound pointer\n");
+      } else {
+        uint64_t LazyPtr = support::endian::read64le(
+            LazyPtrBytes.data() + (LazyPtrAddr - LazyPtrSectionAddr));
+        if (LazyPtr >= StubHelperAddr &&
+            LazyPtr <= StubHelperAddr + StubHelperSize) {
+          // The lazy pointer initially points to the stub helper, that has dyld
+          // resolve the lazy binding of the pointer.
+          Name = getBoundFunctionName(Binds, LazyPtrAddr,
+                                      MachOBindEntry::Kind::Lazy);
+        } else if (LazyPtr >= TextAddr && LazyPtr <= TextAddr + TextSize) {
+          DEBUG(dbgs() << "Stub: " << utohexstr(StubAddr) << " -> "
+                       << utohexstr(LazyPtr) << "\n");
+          Stubs.LocalAddrs[StubAddr] = LazyPtr;
+          continue;
+        } else if (LazyPtr == 0) {
+          Name = getBoundFunctionName(Binds, LazyPtrAddr,
+                                      MachOBindEntry::Kind::Weak);
+        }
+      }
+
+      // Fall back to the indirect symbol of the stub.
+      if (Name.empty())
+        Name = MOS.findExternalFunctionAt(StubAddr);
+      if (Name.empty())
+        continue;
+      DEBUG(dbgs() << "Resolved Symbol \"" << Name << "\": "
+                   << utohexstr(StubAddr) << "\n");
+      Stubs.ExternalNames[StubAddr] = Name;
+    }
+  }
+}
+
+void llvm::resolveMachOPointers(const MachOObjectFile &MachO,
+                                const MachOBindingIndex &Binds,
+                                DCStubTargets &Stubs) {
+  if (!MachO.is64Bit())
+    return;
+  uint64_t TextAddr = 0, TextSize = 0;
+  for (const SectionRef &Section : MachO.sections()) {
+    StringRef Name;
+    if (!Section.getName(Name) && Name == "__text") {
+      TextAddr = Section.getAddress();
+      TextSize = Section.getSize();
+    }
+  }
+
+  for (const SectionRef &Section : MachO.sections()) {
+    StringRef Name, Contents;
+    if (Section.getName(Name))
+      continue;
+    StringRef Segment =
+        MachO.getSectionFinalSegmentName(Section.getRawDataRefImpl());
+    // The pointer tables, e.g. the vtables, are only read-only once
+    // relocated: they are in the __const of the data segments.
+    const bool IsGOT = Name == "__got" || Name == "__auth_got";
+    if (!IsGOT && !(Name == "__const" && Segment.startswith("__DATA")))
+      continue;
+    if (Section.getContents(Contents))
+      continue;
+    const uint64_t Addr = Section.getAddress();
+    for (uint64_t Offset = 0; Offset + 8 <= Contents.size(); Offset += 8) {
+      const uint64_t PtrAddr = Addr + Offset;
+      StringRef Symbol = getBoundFunctionName(Binds, PtrAddr,
+                                              MachOBindEntry::Kind::Regular);
+      if (!Symbol.empty()) {
+        Stubs.PointerNames[PtrAddr] = Symbol;
+        continue;
+      }
+      // The pointers to local functions are rebased: chained, or the
+      // unslid address in place.
+      uint64_t Target;
+      if (Binds.hasChainedFixups()) {
+        if (!Binds.getChainedValue(PtrAddr, Target))
+          continue;
+      } else {
+        Target = support::endian::read64le(Contents.data() + Offset);
+      }
+      if (Target >= TextAddr && Target < TextAddr + TextSize)
+        Stubs.PointerAddrs[PtrAddr] = Target;
+    }
+  }
+}
+
+void llvm::resolveDyldCacheStubs(const MachOObjectFile &MachO,
+                                 const DyldSharedCache &Cache,
+                                 DCStubTargets &Stubs) {
+  StringRef StubsBytes;
+  uint64_t StubsAddr = 0, TextAddr = 0, TextSize = 0;
+  for (const SectionRef &Section : MachO.sections()) {
+    StringRef Name;
+    Section.getName(Name);
+    if (Name == "__stubs") {
+      Section.getContents(StubsBytes);
+      StubsAddr = Section.getAddress();
+    } else if (Name == "__text") {
+      TextAddr = Section.getAddress();
+      TextSize = Section.getSize();
+    }
+  }
+
+  const uint64_t StubSize = 12;
+  for (uint64_t Index = 0; Index + StubSize <= StubsBytes.size();
+       Index += StubSize) {
+    uint64_t StubAddr = StubsAddr + Index;
+    if (Stubs.isStub(StubAddr))
+      continue;
+
+    const uint8_t *Bytes =
+        reinterpret_cast<const uint8_t *>(StubsBytes.data()) + Index;
+    uint64_t PtrAddr, Target;
+    if (decodeStub(Bytes, StubAddr, PtrAddr)) {
+      if (!Cache.readPointer(PtrAddr, Target))
+        continue;
+    } else if (!decodeDirectStub(Bytes, StubAddr, Target)) {
+      DEBUG(dbgs() << "Unknown stub at " << utohexstr(StubAddr) << "\n");
+      continue;
+    }
+
+    if (Target >= TextAddr && Target < TextAddr + TextSize) {
+      Stubs.LocalAddrs[StubAddr] = Target;
+      continue;
+    }
+    StringRef Name = Cache.findSymbolAt(Target);
+    if (Name.empty()) {
+      DEBUG(dbgs() << "Stub at " << utohexstr(StubAddr) << " jumps to "
+                   << utohexstr(Target) << ", which no image exports\n");
+      continue;
+    }
+    DEBUG(dbgs() << "Resolved Symbol \"" << Name << "\" in the cache: "
+                 << utohexstr(StubAddr) << "\n");
+    Stubs.ExternalNames[StubAddr] = Name.substr(1);
+  }
+}
+
+void llvm::collectMachODataSections(const MachOObjectFile &MachO,
+                                    bool WholeSections,
+                                    DCDataSectionList &Sections) {
+  const uint64_t PtrSize = MachO.is64Bit() ? 8 : 4;
+  for (const SectionRef &Section : MachO.sections()) {
+    StringRef Name;
+    if (Section.getName(Name))
+      continue;
+    DCDataSection S;
+    S.Addr = Section.getAddress();
+    S.Size = Section.getSize();
+    S.EntrySize = PtrSize;
+    if (WholeSections && (Name == "__const" || Name == "__objc_const" ||
+                          Name == "__cstring")) {
+      S.Kind = DCDataSection::Section;
+      S.EntrySize = 1;
+      S.Name = (MachO.getSectionFinalSegmentName(Section.getRawDataRefImpl()) +
+                "," + Name).str();
+    } else if (Name == "__objc_selrefs")
+      S.Kind = DCDataSection::SelRefs;
+    else if (Name == "__objc_classrefs")
+      S.Kind = DCDataSection::ClassRefs;
+    else if (Name == "__got" || Name == "__auth_got")
+      S.Kind = DCDataSection::GOT;
+    else if (Name == "__cfstring") {
+      S.Kind = DCDataSection::CFStrings;
+      S.EntrySize = 4 * PtrSize;
+    } else if (Name == "__cstring") {
+      S.Kind = DCDataSection::CStrings;
+      S.EntrySize = 1;
+    } else
+      continue;
+    if ((S.Kind == DCDataSection::CFStrings ||
+         S.Kind == DCDataSection::CStrings) &&
+        Section.getContents(S.Contents))
+      continue;
+    Sections.push_back(S);
+  }
+  std::sort(Sections.begin(), Sections.end(),
+            [](const DCDataSection &A, const DCDataSection &B) {
+              return A.Addr < B.Addr;
+            });
+}
+
+// The blobs of the code signature this reads, all big-endian.
+enum {
+  CSMagicEmbeddedSignature = 0xFADE0CC0,
+  CSMagicCodeDirectory = 0xFADE0C02,
+  CSSlotCodeDirectory = 0
+};
+
+static std::string toHexString(StringRef Bytes) {
+  std::string Hex;
+  Hex.reserve(Bytes.size() * 2);
+  for (unsigned char C : Bytes) {
+    Hex += hexdigit(C >> 4, /*LowerCase=*/true);
+    Hex += hexdigit(C & 0xF, /*LowerCase=*/true);
+  }
+  return Hex;
+}
+
+bool llvm::readCodePageHashes(const MachOObjectFile &MachO,
+                              DCCodePageHashes &Pages) {
+  StringRef Data = MachO.getData();
+  for (const auto &Load : MachO.load_commands()) {
+    if (Load.C.cmd != MachO::LC_CODE_SIGNATURE)
+      continue;
+    MachO::linkedit_data_command Sig = MachO.getLinkeditDataLoadCommand(Load);
+    if (uint64_t(Sig.dataoff) + Sig.datasize > Data.size() ||
+        Sig.datasize < 12)
+      return false;
+    const uint8_t *Blob = Data.bytes_begin() + Sig.dataoff;
+    auto read32 = [&](uint64_t Off) {
+      return support::endian::read32be(Blob + Off);
+    };
+    if (read32(0) != CSMagicEmbeddedSignature)
+      return false;
+    // The first code directory: the alternate ones only hash with other
+    // algorithms.
+    uint32_t Count = read32(8);
+    if (12 + uint64_t(Count) * 8 > Sig.datasize)
+      return false;
+    for (uint32_t I = 0; I != Count; ++I) {
+      if (read32(12 + I * 8) != CSSlotCodeDirectory)
+        continue;
+      uint64_t CD = read32(12 + I * 8 + 4);
+      if (CD + 40 > Sig.datasize || read32(CD) != CSMagicCodeDirectory)
+        return false;
+      uint64_t HashOffset = read32(CD + 16);
+      uint64_t NumCodeSlots = read32(CD + 28);
+      unsigned HashSize = Blob[CD + 36];
+      unsigned PageShift = Blob[CD + 39];
+      // A page size of 0 is a single page, the whole file: it tells nothing.
+      if (!PageShift || PageShift >= 32 || !HashSize ||
+          CD + HashOffset + NumCodeSlots * HashSize > Sig.datasize)
+        return false;
+      Pages.PageSize = uint64_t(1) << PageShift;
+      Pages.Hashes.clear();
+      Pages.Hashes.reserve(NumCodeSlots);
+      const char *Hashes =
+          reinterpret_cast<const char *>(Blob + CD + HashOffset);
+      for (uint64_t Slot = 0; Slot != NumCodeSlots; ++Slot)
+        Pages.Hashes.push_back(
+            toHexString(StringRef(Hashes + Slot * HashSize, HashSize)));
+      return true;
+    }
+    return false;
+  }
+  return false;
+}
+
+bool llvm::findChangedCodeRanges(
+    const MachOObjectFile &MachO, const DCCodePageHashes &OldPages,
+    const DCCodePageHashes &Pages,
+    std::vector<std::pair<uint64_t, uint64_t>> &Ranges) {
+  if (!Pages.PageSize || OldPages.PageSize != Pages.PageSize)
+    return false;
+  // The file ranges of the changed pages, merged.
+  std::vector<std::pair<uint64_t, uint64_t>> FileRanges;
+  const size_t NumPages = std::max(OldPages.Hashes.size(), Pages.Hashes.size());
+  for (size_t I = 0; I != NumPages; ++I) {
+    if (I < OldPages.Hashes.size() && I < Pages.Hashes.size() &&
+        OldPages.Hashes[I] == Pages.Hashes[I])
+      continue;
+    uint64_t Begin = I * Pages.PageSize;
+    if (!FileRanges.empty() && FileRanges.back().second == Begin)
+      FileRanges.back().second += Pages.PageSize;
+    else
+      FileRanges.push_back(std::make_pair(Begin, Begin + Pages.PageSize));
+  }
+
+  Ranges.clear();
+  for (const auto &Load : MachO.load_commands()) {
+    uint64_t VMAddr, FileOff, FileSize;
+    if (Load.C.cmd == MachO::LC_SEGMENT_64) {
+      MachO::segment_command_64 Seg = MachO.getSegment64LoadCommand(Load);
+      VMAddr = Seg.vmaddr;
+      FileOff = Seg.fileoff;
+      FileSize = Seg.filesize;
+    } else if (Load.C.cmd == MachO::LC_SEGMENT) {
+      MachO::segment_command Seg = MachO.getSegmentLoadCommand(Load);
+      VMAddr = Seg.vmaddr;
+      FileOff = Seg.fileoff;
+      FileSize = Seg.filesize;
+    } else {
+      continue;
+    }
+    for (const auto &R : FileRanges) {
+      uint64_t Begin = std::max(R.first, FileOff);
+      uint64_t End = std::min(R.second, FileOff + FileSize);
+      if (Begin < End)
+        Ranges.push_back(std::make_pair(VMAddr + (Begin - FileOff),
+                                        VMAddr + (End - FileOff)));
+    }
+  }
+  std::sort(Ranges.begin(), Ranges.end());
+  return true;
+}
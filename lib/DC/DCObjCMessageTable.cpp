@@ -0,0 +1,67 @@
+//===-- lib/DC/DCObjCMessageTable.cpp - objc_msgSend call sites -*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/DC/DCObjCMessageTable.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Metadata.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+
+using namespace llvm;
+
+MDNode *llvm::createDCObjCMessageTag(LLVMContext &Ctx, uint64_t Addr,
+                                     StringRef Selector, StringRef Class) {
+  Metadata *Ops[] = {
+      ConstantAsMetadata::get(ConstantInt::get(Type::getInt64Ty(Ctx), Addr)),
+      MDString::get(Ctx, Selector), MDString::get(Ctx, Class)};
+  return MDNode::get(Ctx, Ops);
+}
+
+void llvm::collectDCObjCMessageSites(const Module &M,
+                                     std::vector<DCObjCMessageSite> &Sites) {
+  unsigned MDKind = M.getContext().getMDKindID(DCObjCMessageMDKind);
+  for (const Function &F : M) {
+    if (F.isDeclaration())
+      continue;
+    unsigned Idx = 0;
+    for (const BasicBlock &BB : F) {
+      for (const Instruction &I : BB) {
+        const unsigned InstIdx = Idx++;
+        MDNode *Node = I.getMetadata(MDKind);
+        if (!Node || Node->getNumOperands() != 3)
+          continue;
+        ConstantInt *Addr =
+            mdconst::dyn_extract<ConstantInt>(Node->getOperand(0));
+        MDString *Sel = dyn_cast<MDString>(Node->getOperand(1));
+        MDString *Class = dyn_cast<MDString>(Node->getOperand(2));
+        if (!Addr || !Sel || !Class)
+          continue;
+        DCObjCMessageSite S = {Sel->getString(), Addr->getZExtValue(),
+                               F.getName(), InstIdx, Class->getString()};
+        Sites.push_back(std::move(S));
+      }
+    }
+  }
+}
+
+void llvm::writeDCObjCMessageTable(std::vector<DCObjCMessageSite> &Sites,
+                                   raw_ostream &OS) {
+  std::sort(Sites.begin(), Sites.end(),
+            [](const DCObjCMessageSite &L, const DCObjCMessageSite &R) {
+              return std::tie(L.Selector, L.Addr) <
+                     std::tie(R.Selector, R.Addr);
+            });
+  for (const DCObjCMessageSite &S : Sites)
+    OS << (S.Selector.empty() ? "-" : S.Selector) << ' ' << utohexstr(S.Addr)
+       << ' ' << S.Function << ' ' << S.InstIndex << ' '
+       << (S.Class.empty() ? "-" : S.Class) << '\n';
+}
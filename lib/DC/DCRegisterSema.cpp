@@ -9,31 +9,79 @@
 
 #include "llvm/DC/DCRegisterSema.h"
 #include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringSwitch.h"
 #include "llvm/IR/DataLayout.h"
 #include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/IR/Instructions.h"
 #include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/MDBuilder.h"
 #include "llvm/IR/Module.h"
+#include "llvm/IR/Operator.h"
 #include "llvm/IR/Type.h"
+#include "llvm/MC/MCAnalysis/MCRegisterUsage.h"
 #include "llvm/MC/MCRegisterInfo.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Transforms/Utils/PromoteMemToReg.h"
 #include <algorithm>
+#include <cstring>
 #include <dlfcn.h>
 #include <llvm/Target/TargetRegisterInfo.h>
 
 using namespace llvm;
 
+static cl::opt<bool> EnableRegSSA(
+    "enable-dc-reg-ssa",
+    cl::desc("Promote the local copies of registers to SSA values when "
+             "finalizing each translated function"),
+    cl::init(false));
+
+static cl::opt<bool> EnableTBAA(
+    "enable-dc-tbaa",
+    cl::desc("Tag the accesses to each register slot of the regset, to the "
+             "guest memory, and to the recovered stack frames, with TBAA "
+             "types that don't alias one another"),
+    cl::init(true));
+
+static cl::opt<DCRegisterSema::NameLevel> DCNames(
+    "dc-names",
+    cl::desc("What to name in the translated IR (default = all)"),
+    cl::values(clEnumValN(DCRegisterSema::NL_None, "none", "Only functions"),
+               clEnumValN(DCRegisterSema::NL_Blocks, "blocks",
+                          "Functions and basic blocks"),
+               clEnumValN(DCRegisterSema::NL_All, "all",
+                          "Functions, basic blocks and register values"),
+               clEnumValEnd),
+    cl::init(DCRegisterSema::NL_All));
+
+static cl::opt<DCRegisterSema::RegSetLayout> DCRegSetLayout(
+    "dc-regset-layout",
+    cl::desc("Order of the registers in the regset (default = regno)"),
+    cl::values(clEnumValN(DCRegisterSema::RSL_RegNo, "regno",
+                          "The order of the register enumeration"),
+               clEnumValN(DCRegisterSema::RSL_Hot, "hot",
+                          "The general purpose registers and the flags "
+                          "first, then the vector registers, then the "
+                          "others"),
+               clEnumValEnd),
+    cl::init(DCRegisterSema::RSL_RegNo));
+
 #define DEBUG_TYPE "dc-regsema"
 
 DCRegisterSema::DCRegisterSema(const MCRegisterInfo &MRI,
                                const MCInstrInfo &MII,
                                const DataLayout &DL,
-                               InitSpecialRegSizesFnTy InitSpecialRegSizesFn)
+                               InitSpecialRegSizesFnTy InitSpecialRegSizesFn,
+                               GetRegSetRankFnTy GetRegSetRankFn)
     : MRI(MRI), MII(MII), DL(DL), NumRegs(MRI.getNumRegs()), NumLargest(0),
       RegSizes(NumRegs), RegLargestSupers(NumRegs),
       RegOffsetsInSet(NumRegs, -1), LargestRegs(), TheModule(0), Ctx(0),
       RegSetType(0), Builder(), RegPtrs(NumRegs), RegAllocas(NumRegs),
-      RegInits(NumRegs), RegAssignments(NumRegs), TheFunction(0),
-      RegVals(NumRegs), CurrentInst(0) {
+      RegInits(NumRegs), RegAssignments(NumRegs), FnRegs(NumRegs),
+      FnWrittenRegs(NumRegs), TrackWrittenRegs(true), TheFunction(0),
+      RegVals(NumRegs), BBRegs(NumRegs), CalleeReadRegs(),
+      CallClobberedRegs(), CurrentInst(0), CurAddr(), GuestMemoryBase(0) {
 
   // First, determine the (spill) size of each register, in bits.
   // FIXME: the best (only) way to know the size of a reg is to find a
@@ -76,34 +124,101 @@ DCRegisterSema::DCRegisterSema(const MCRegisterInfo &MRI,
   // starting with register index 0, which we again don't care about.
   NumLargest = LargestRegs.size();
 
+  // The registers most functions use share the first cache lines of the
+  // regset, rather than being spread between the vector and system ones.
+  if (getRegSetLayout() == RSL_Hot && GetRegSetRankFn)
+    std::stable_sort(LargestRegs.begin() + 1, LargestRegs.end(),
+                     [&](unsigned L, unsigned R) {
+                       return GetRegSetRankFn(MRI, L) <
+                              GetRegSetRankFn(MRI, R);
+                     });
+
   for (unsigned I = 1, E = getNumLargest(); I != E; ++I) {
     assert(RegSizes[LargestRegs[I]] != 0 &&
            "Largest super-register doesn't have a type!");
     RegOffsetsInSet[LargestRegs[I]] = I - 1;
   }
+
+  // Finally, find out where each sub-register lives in its supers.
+  for (unsigned RI = 1, RE = getNumRegs(); RI != RE; ++RI) {
+    if (RegSizes[RI] == 0)
+      continue;
+    for (MCSubRegIterator SRI(RI, &MRI); SRI.isValid(); ++SRI) {
+      SubRegSlice Slice;
+      Slice.Idx = MRI.getSubRegIndex(RI, *SRI);
+      if (!Slice.Idx)
+        continue;
+      Slice.Offset = MRI.getSubRegIdxOffset(Slice.Idx);
+      Slice.Size = MRI.getSubRegIdxSize(Slice.Idx);
+      if (Slice.Offset == (unsigned)-1 || Slice.Size == (unsigned)-1)
+        continue;
+      SubRegSlices[std::make_pair(RI, unsigned(*SRI))] = Slice;
+    }
+  }
 }
 
 DCRegisterSema::~DCRegisterSema() {}
 
+std::string DCRegisterSema::getTranslationOptions() {
+  return std::string("reg-ssa=") + (EnableRegSSA ? "1" : "0") +
+         ",tbaa=" + (EnableTBAA ? "1" : "0") + ",names=" + utostr(DCNames) + ",regset-layout=" +
+         utostr(DCRegSetLayout);
+}
+
+DCRegisterSema::RegSetLayout DCRegisterSema::getRegSetLayout() {
+  return DCRegSetLayout;
+}
+
+DCRegisterSema::NameLevel DCRegisterSema::getNameLevel() { return DCNames; }
+
+Value *DCRegisterSema::getGuestAddr(Value *HostAddr) {
+  if (!GuestMemoryBase)
+    return HostAddr;
+  return Builder->CreateSub(
+      HostAddr, ConstantInt::get(HostAddr->getType(), GuestMemoryBase));
+}
+
 void DCRegisterSema::SwitchToModule(Module *Mod) {
   TheModule = Mod;
   Ctx = &TheModule->getContext();
-  Builder.reset(new DCIRBuilder(*Ctx));
+  Builder.reset(new DCIRBuilder(*Ctx, &CurAddr));
 
   std::vector<Type *> LargestRegTypes(getNumLargest() - 1);
   for (unsigned I = 1, E = getNumLargest(); I != E; ++I)
     LargestRegTypes[I - 1] = getRegType(LargestRegs[I]);
 
-  RegSetType = StructType::create(LargestRegTypes, "regset");
+  // The regset type of the context is reused by all its modules, rather than
+  // uniqued again as regset.<n> for each, if it has the same registers.
+  RegSetType = TheModule->getTypeByName("regset");
+  if (!RegSetType || RegSetType->elements() != makeArrayRef(LargestRegTypes))
+    RegSetType = StructType::create(LargestRegTypes, "regset");
 }
 
 void DCRegisterSema::SwitchToFunction(Function *Fn) { TheFunction = Fn; }
 
+void DCRegisterSema::analyzeMCFunction(const MCFunction &MCFN) {
+  MCRegisterUsage Usage(MII, MRI);
+  Usage.addFunction(MCFN);
+  // Writing any part of a register changes all of its largest supers.
+  const BitVector &Written = Usage.getWritten();
+  for (int RI = Written.find_first(); RI != -1; RI = Written.find_next(RI))
+    for (MCRegAliasIterator AI(RI, &MRI, true); AI.isValid(); ++AI)
+      FnWrittenRegs.set(RegLargestSupers[*AI]);
+}
+
+Value *DCRegisterSema::getIncomingReg(unsigned RegNo) {
+  createLocalValueForReg(RegNo);
+  unsigned LargestSuper = RegLargestSupers[RegNo];
+  if (LargestSuper == RegNo)
+    return RegInits[RegNo];
+  return extractSubRegFromSuper(LargestSuper, RegNo, RegInits[LargestSuper]);
+}
+
 void DCRegisterSema::SwitchToBasicBlock(BasicBlock *TheBB) {
   // Clear all local values.
-  for (unsigned RI = 1, RE = MRI.getNumRegs(); RI != RE; ++RI) {
+  for (int RI = BBRegs.find_first(); RI != -1; RI = BBRegs.find_next(RI))
     RegVals[RI] = 0;
-  }
+  BBRegs.reset();
   Builder->SetInsertPoint(TheBB);
 }
 
@@ -111,17 +226,29 @@ void DCRegisterSema::SwitchToInst(const MCDecodedInst &DecodedInst) {
   CurrentInst = &DecodedInst;
 }
 
+// Registers always saved and restored around calls, even when unused.
+// FIXME: These are AArch64 X0-X8, the argument and indirect result registers.
+static const int FirstForcedSavedReg = 199, LastForcedSavedReg = 207;
+
+int DCRegisterSema::findNextSavedReg(int RI) const {
+  // Registers with an alloca are in FnRegs. This is also called while
+  // creating allocas: registers before RI that get one are skipped, later
+  // ones are found, as when looking at all registers in order.
+  int Next = FnRegs.find_next(RI);
+  if (RI < LastForcedSavedReg) {
+    int Forced = std::max(RI + 1, FirstForcedSavedReg);
+    if (Forced < (int)getNumRegs() && (Next == -1 || Forced < Next))
+      Next = Forced;
+  }
+  return Next;
+}
+
 void DCRegisterSema::saveAllLocalRegs(BasicBlock *BB, BasicBlock::iterator IP) {
-  DCIRBuilder LocalBuilder(BB, IP);
+  DCIRBuilder LocalBuilder(BB, IP, &CurAddr);
 
-  for (unsigned RI = 1, RE = getNumRegs(); RI != RE; ++RI) {
-    if (!RegAllocas[RI]) {
-      if (RI >= 199 && RI <= 207) {
-          createLocalValueForReg(RI);
-      } else {
-          continue;
-      }
-    }
+  for (int RI = findNextSavedReg(0); RI != -1; RI = findNextSavedReg(RI)) {
+    if (!RegAllocas[RI])
+      createLocalValueForReg(RI);
     int OffsetInSet = RegOffsetsInSet[RI];
     if (OffsetInSet != -1)
       LocalBuilder.CreateStore(LocalBuilder.CreateLoad(RegAllocas[RI]),
@@ -129,39 +256,206 @@ void DCRegisterSema::saveAllLocalRegs(BasicBlock *BB, BasicBlock::iterator IP) {
   }
 }
 
+void DCRegisterSema::saveWrittenLocalRegs(BasicBlock *BB,
+                                          BasicBlock::iterator IP) {
+  DCIRBuilder LocalBuilder(BB, IP, &CurAddr);
+
+  // FnRegs has the registers with a local copy; only the largest ones, that
+  // are in the regset, are saved.
+  for (int RI = FnRegs.find_first(); RI != -1; RI = FnRegs.find_next(RI)) {
+    if (RegOffsetsInSet[RI] != -1 && FnWrittenRegs.test(RI))
+      LocalBuilder.CreateStore(LocalBuilder.CreateLoad(RegAllocas[RI]),
+                               RegPtrs[RI]);
+  }
+}
+
 void DCRegisterSema::restoreLocalRegs(BasicBlock *BB, BasicBlock::iterator IP) {
   SwitchToBasicBlock(BB);
   Builder->SetInsertPoint(BB, IP);
+  TrackWrittenRegs = false;
 
-  for (unsigned RI = 1, RE = getNumRegs(); RI != RE; ++RI) {
-      if (!RegAllocas[RI]) {
-        if (RI >= 199 && RI <= 207) {
-            createLocalValueForReg(RI);
-        } else {
-            continue;
-        }
-    }
+  for (int RI = findNextSavedReg(0); RI != -1; RI = findNextSavedReg(RI)) {
+    if (!RegAllocas[RI])
+      createLocalValueForReg(RI);
     int OffsetInSet = RegOffsetsInSet[RI];
     if (OffsetInSet != -1)
       setReg(RI, Builder->CreateLoad(RegPtrs[RI]));
   }
+  TrackWrittenRegs = true;
+  FinalizeBasicBlock();
+}
+
+void DCRegisterSema::promoteLocalRegs() {
+  std::vector<AllocaInst *> Allocas;
+  for (int RI = FnRegs.find_first(); RI != -1; RI = FnRegs.find_next(RI)) {
+    AllocaInst *AI = cast<AllocaInst>(RegAllocas[RI]);
+    // Register allocas are only ever loaded and stored, but be careful.
+    if (isAllocaPromotable(AI))
+      Allocas.push_back(AI);
+  }
+  if (Allocas.empty())
+    return;
+  DominatorTree DT(*TheFunction);
+  PromoteMemToReg(Allocas, DT);
+}
+
+// The types of the DC accesses are all scalars of the same root: a type only
+// aliases itself.
+static MDNode *getTBAATag(LLVMContext &C, StringRef Name) {
+  if (!EnableTBAA)
+    return nullptr;
+  MDBuilder MDB(C);
+  MDNode *Type =
+      MDB.createTBAAScalarTypeNode(Name, MDB.createTBAARoot("DC TBAA"));
+  return MDB.createTBAAStructTagNode(Type, Type, 0);
+}
+
+MDNode *DCRegisterSema::getRegSetTBAATag(LLVMContext &C,
+                                         unsigned RegNo) const {
+  return getTBAATag(C, (Twine("regset ") + MRI.getName(RegNo)).str());
+}
+
+MDNode *DCRegisterSema::getGuestMemoryTBAATag(LLVMContext &C) {
+  return getTBAATag(C, "guest memory");
+}
+
+MDNode *DCRegisterSema::getStackFrameTBAATag(LLVMContext &C) {
+  return getTBAATag(C, "stack frame");
+}
+
+void DCRegisterSema::tagMemoryAccesses() {
+  MDNode *GuestTag = getGuestMemoryTBAATag(*Ctx);
+  if (!GuestTag)
+    return;
+  // A register is only accessed through its pointer in the regset, and its
+  // alloca, which the other accesses never reach: they don't know about
+  // either.
+  SmallDenseMap<Value *, MDNode *, 32> RegTags;
+  for (int RI = FnRegs.find_first(); RI != -1; RI = FnRegs.find_next(RI)) {
+    MDNode *Tag = getRegSetTBAATag(*Ctx, RI);
+    RegTags[RegPtrs[RI]] = Tag;
+    RegTags[RegAllocas[RI]] = Tag;
+  }
+  for (BasicBlock &BB : *TheFunction)
+    for (Instruction &I : BB) {
+      Value *Ptr;
+      if (auto *LI = dyn_cast<LoadInst>(&I))
+        Ptr = LI->getPointerOperand();
+      else if (auto *SI = dyn_cast<StoreInst>(&I))
+        Ptr = SI->getPointerOperand();
+      else if (auto *RMWI = dyn_cast<AtomicRMWInst>(&I))
+        Ptr = RMWI->getPointerOperand();
+      else if (auto *CXI = dyn_cast<AtomicCmpXchgInst>(&I))
+        Ptr = CXI->getPointerOperand();
+      else
+        continue;
+      if (I.getMetadata(LLVMContext::MD_tbaa))
+        continue;
+      auto RI = RegTags.find(Ptr);
+      if (RI != RegTags.end()) {
+        I.setMetadata(LLVMContext::MD_tbaa, RI->second);
+        continue;
+      }
+      // The guest memory is accessed through the inttoptr of an address,
+      // maybe with an offset.
+      for (;;) {
+        if (auto *GEP = dyn_cast<GEPOperator>(Ptr))
+          Ptr = GEP->getPointerOperand();
+        else if (auto *BC = dyn_cast<BitCastOperator>(Ptr))
+          Ptr = BC->getOperand(0);
+        else
+          break;
+      }
+      if (Operator::getOpcode(Ptr) == Instruction::IntToPtr)
+        I.setMetadata(LLVMContext::MD_tbaa, GuestTag);
+    }
+}
+
+void DCRegisterSema::computeCallRegs() {
+  CalleeReadRegs.resize(getNumRegs());
+  CallClobberedRegs.resize(getNumRegs());
+  for (unsigned I = 1, E = getNumLargest(); I != E; ++I) {
+    unsigned Reg = LargestRegs[I];
+    if (isCalleeReadReg(Reg))
+      CalleeReadRegs.set(Reg);
+    if (isCallClobberedReg(Reg))
+      CallClobberedRegs.set(Reg);
+  }
+}
+
+void DCRegisterSema::getCallPreservedRegSetIndices(
+    BitVector &Preserved, BitVector &CalleeRead) const {
+  Preserved.clear();
+  Preserved.resize(getNumLargest());
+  CalleeRead.clear();
+  CalleeRead.resize(getNumLargest());
+  for (unsigned I = 1, E = getNumLargest(); I != E; ++I) {
+    unsigned Reg = LargestRegs[I];
+    if (isCallClobberedReg(Reg))
+      continue;
+    Preserved.set(RegOffsetsInSet[Reg]);
+    if (isCalleeReadReg(Reg))
+      CalleeRead.set(RegOffsetsInSet[Reg]);
+  }
+}
+
+void DCRegisterSema::saveLocalRegsForCall(BasicBlock *BB,
+                                          BasicBlock::iterator IP,
+                                          const BitVector *Read) {
+  if (!Read)
+    Read = &getCalleeReadRegs();
+  DCIRBuilder LocalBuilder(BB, IP, &CurAddr);
+
+  // Registers without a local value still hold their value in the regset.
+  for (int RI = FnRegs.find_first(); RI != -1; RI = FnRegs.find_next(RI)) {
+    if (RegOffsetsInSet[RI] != -1 && Read->test(RI))
+      LocalBuilder.CreateStore(LocalBuilder.CreateLoad(RegAllocas[RI]),
+                               RegPtrs[RI]);
+  }
+}
+
+void DCRegisterSema::restoreLocalRegsAfterCall(BasicBlock *BB,
+                                               BasicBlock::iterator IP,
+                                               const BitVector *Clobbered) {
+  if (!Clobbered)
+    Clobbered = &getCallClobberedRegs();
+  SwitchToBasicBlock(BB);
+  Builder->SetInsertPoint(BB, IP);
+  TrackWrittenRegs = false;
+
+  for (int RI = findNextSavedReg(0); RI != -1; RI = findNextSavedReg(RI)) {
+    if (!RegAllocas[RI])
+      createLocalValueForReg(RI);
+    if (RegOffsetsInSet[RI] != -1 && Clobbered->test(RI))
+      setReg(RI, Builder->CreateLoad(RegPtrs[RI]));
+  }
+  TrackWrittenRegs = true;
   FinalizeBasicBlock();
 }
 
 void DCRegisterSema::FinalizeFunction(BasicBlock *ExitBB) {
-  saveAllLocalRegs(ExitBB, ExitBB->getTerminator());
+  // The registers that aren't written still hold their incoming value in the
+  // regset, or the one reloaded after the last call.
+  saveWrittenLocalRegs(ExitBB, ExitBB->getTerminator());
+  tagMemoryAccesses();
 
-  for (unsigned RI = 1, RE = getNumRegs(); RI != RE; ++RI) {
+  if (EnableRegSSA)
+    promoteLocalRegs();
+
+  for (int RI = FnRegs.find_first(); RI != -1; RI = FnRegs.find_next(RI)) {
     RegAllocas[RI] = 0;
     RegPtrs[RI] = 0;
     RegInits[RI] = 0;
   }
+  FnRegs.reset();
+  FnWrittenRegs.reset();
 }
 
 void DCRegisterSema::FinalizeBasicBlock() {
   if (Instruction *TI = Builder->GetInsertBlock()->getTerminator())
     Builder->SetInsertPoint(TI);
-  for (unsigned RI = 1, RE = getNumRegs(); RI != RE; ++RI) {
+  // Registers without a value here have nothing to store.
+  for (int RI = BBRegs.find_first(); RI != -1; RI = BBRegs.find_next(RI)) {
     onRegisterGet(RI);
     if (!RegVals[RI])
       continue;
@@ -169,6 +463,7 @@ void DCRegisterSema::FinalizeBasicBlock() {
       Builder->CreateStore(RegVals[RI], RegAllocas[RI]);
     RegVals[RI] = 0;
   }
+  BBRegs.reset();
 }
 
 Value *DCRegisterSema::getReg(unsigned RegNo) {
@@ -187,11 +482,15 @@ Value *DCRegisterSema::getRegNoCallback(unsigned RegNo) {
   if (RV)
     return RV;
 
-  // Ensure the reg has an alloca; extract it from a super if it has one.
+  // Ensure the reg has an alloca, or its largest super does.
   createLocalValueForReg(RegNo);
 
   // Now, we have an alloca; if we don't have the reg in this BB, load it here!
-  if (!RV)
+  // Sub-registers are extracted from the current value of their super.
+  unsigned LargestSuper = RegLargestSupers[RegNo];
+  if (LargestSuper != RegNo)
+    RV = extractSubRegFromSuper(LargestSuper, RegNo);
+  else
     RV = Builder->CreateLoad(RegAllocas[RegNo]);
   setRegValWithName(RegNo, RV);
   onRegisterSet(RegNo, RV);
@@ -199,15 +498,19 @@ Value *DCRegisterSema::getRegNoCallback(unsigned RegNo) {
 }
 
 void DCRegisterSema::setRegValWithName(unsigned RegNo, Value *Val) {
-  RegVals[RegNo] = Val;
-  if (!Val->hasName())
+  setRegVal(RegNo, Val);
+  if (DCNames == NL_All && !Val->hasName())
     Val->setName((Twine(MRI.getName(RegNo)) + "_" +
                   utostr(RegAssignments[RegNo]++)).str());
 }
 
 void DCRegisterSema::createLocalValueForReg(unsigned RegNo) {
+  // Sub-registers don't have a local copy of their own.
+  unsigned LargestSuper = RegLargestSupers[RegNo];
+  if (LargestSuper != RegNo)
+    RegNo = LargestSuper;
+
   StringRef RegName = MRI.getName(RegNo);
-  Value *&RV = RegVals[RegNo];
   Value *&RA = RegAllocas[RegNo];
   Value *&RP = RegPtrs[RegNo];
   Value *&RI = RegInits[RegNo];
@@ -219,30 +522,23 @@ void DCRegisterSema::createLocalValueForReg(unsigned RegNo) {
   assert(RI == 0 && "Register has a start value but no local value!");
   IRBuilderBase::InsertPoint CurIP = Builder->saveIP();
   BasicBlock *EntryBB = &TheFunction->getEntryBlock();
-  unsigned LargestSuper = RegLargestSupers[RegNo];
-  if (LargestSuper != RegNo) {
-    // If the reg has a super-register, extract from it.
-    RV = extractSubRegFromSuper(LargestSuper, RegNo);
-    // Also extract from the super reg to initialize the alloca.
-    Builder->SetInsertPoint(EntryBB, EntryBB->getTerminator());
-    assert(RegInits[LargestSuper] != 0 && "Super-register non initialized!");
-    RI = extractSubRegFromSuper(LargestSuper, RegNo, RegInits[LargestSuper]);
-  } else {
-    // Else, it should be in the regset, load it from there.
-    Builder->SetInsertPoint(EntryBB, EntryBB->getTerminator());
-    // First, extract the register's value from the incoming regset.
-    Value *RegSetArg = &TheFunction->getArgumentList().front();
-    int OffsetInRegSet = RegOffsetsInSet[RegNo];
-    assert(OffsetInRegSet != -1 && "Getting a register not in the regset!");
-    Value *Idx[] = { Builder->getInt32(0), Builder->getInt32(OffsetInRegSet) };
-    RP = Builder->CreateInBoundsGEP(RegSetArg, Idx);
-    RP->setName((RegName + "_ptr").str());
-    RI = Builder->CreateLoad(RP);
-  }
-  RI->setName((RegName + "_init").str());
+  // It should be in the regset, load it from there.
+  Builder->SetInsertPoint(EntryBB, EntryBB->getTerminator());
+  // First, extract the register's value from the incoming regset.
+  Value *RegSetArg = &TheFunction->getArgumentList().front();
+  int OffsetInRegSet = RegOffsetsInSet[RegNo];
+  assert(OffsetInRegSet != -1 && "Getting a register not in the regset!");
+  Value *Idx[] = { Builder->getInt32(0), Builder->getInt32(OffsetInRegSet) };
+  RP = Builder->CreateInBoundsGEP(RegSetArg, Idx);
+  RI = Builder->CreateLoad(RP);
   // Then, create an alloca for the register.
   RA = Builder->CreateAlloca(RI->getType());
-  RA->setName(RegName);
+  if (DCNames == NL_All) {
+    RP->setName((RegName + "_ptr").str());
+    RI->setName((RegName + "_init").str());
+    RA->setName(RegName);
+  }
+  FnRegs.set(RegNo);
   // Finally, initialize the local copy of the register.
   Builder->CreateStore(RI, RA);
   Builder->restoreIP(CurIP);
@@ -275,34 +571,33 @@ Value *DCRegisterSema::insertBitsInValue(Value *FullVal, Value *ToInsert,
                                      FullVal, ConstantInt::get(ValType, Mask)));
 }
 
+const DCRegisterSema::SubRegSlice &
+DCRegisterSema::getSubRegSlice(unsigned Super, unsigned Sub) const {
+  auto I = SubRegSlices.find(std::make_pair(Super, Sub));
+  if (I == SubRegSlices.end())
+    llvm_unreachable("Used subreg index doesn't cover a bit range?");
+  return I->second;
+}
+
 Value *DCRegisterSema::extractSubRegFromSuper(unsigned Super, unsigned Sub,
                                               Value *SRV) {
-  unsigned Idx = MRI.getSubRegIndex(Super, Sub);
-  assert(Idx && "Superreg's subreg doesn't have an index?");
-  unsigned Offset = MRI.getSubRegIdxOffset(Idx),
-           Size = MRI.getSubRegIdxSize(Idx);
-  if (Offset == (unsigned)-1 || Size == (unsigned)-1)
-    llvm_unreachable("Used subreg index doesn't cover a bit range?");
+  const SubRegSlice &Slice = getSubRegSlice(Super, Sub);
 
   // If no SuperValue was provided, get the current one.
   if (SRV == 0)
     SRV = getReg(Super);
 
-  return extractBitsFromValue(Offset, Size, SRV);
+  return extractBitsFromValue(Slice.Offset, Slice.Size, SRV);
 }
 
 Value *DCRegisterSema::recreateSuperRegFromSub(unsigned Super, unsigned Sub) {
-  unsigned Idx = MRI.getSubRegIndex(Super, Sub);
-  assert(Idx && "Superreg's subreg doesn't have an index?");
-  unsigned Offset = MRI.getSubRegIdxOffset(Idx),
-           Size = MRI.getSubRegIdxSize(Idx);
-  if (Offset == (unsigned)-1 || Size == (unsigned)-1)
-    llvm_unreachable("Used subreg index doesn't cover a bit range?");
+  const SubRegSlice &Slice = getSubRegSlice(Super, Sub);
 
   Value *RV = getReg(Sub);
   Value *SRV = getReg(Super);
 
-  return insertBitsInValue(SRV, RV, Offset, doesSubRegIndexClearSuper(Idx));
+  return insertBitsInValue(SRV, RV, Slice.Offset,
+                           doesSubRegIndexClearSuper(Slice.Idx));
 }
 
 void DCRegisterSema::defineAllSubSuperRegs(unsigned RegNo) {
@@ -310,16 +605,17 @@ void DCRegisterSema::defineAllSubSuperRegs(unsigned RegNo) {
     setRegNoSubSuper(*SRI, recreateSuperRegFromSub(*SRI, RegNo));
   }
 
-  for (MCSubRegIterator SRI(RegNo, &MRI); SRI.isValid(); ++SRI) {
-    setRegNoSubSuper(*SRI, extractSubRegFromSuper(RegNo, *SRI));
-  }
+  // Sub-registers are only extracted again when they are read.
+  for (MCSubRegIterator SRI(RegNo, &MRI); SRI.isValid(); ++SRI)
+    RegVals[*SRI] = 0;
 }
 
 void DCRegisterSema::setRegNoSubSuper(unsigned RegNo, Value *Val) {
-  // FIXME: This will needlessly extract the subreg from the largest super.
   createLocalValueForReg(RegNo);
   setRegValWithName(RegNo, Val);
   onRegisterSet(RegNo, Val);
+  if (TrackWrittenRegs)
+    FnWrittenRegs.set(RegLargestSupers[RegNo]);
 }
 
 void DCRegisterSema::setReg(unsigned RegNo, Value *Val) {
@@ -351,7 +647,7 @@ DCRegisterSema::getRegSizeOffsetInRegSet(unsigned RegNo) const {
   return std::make_pair(Size, Offset);
 }
 
-extern "C" void __llvm_dc_print_reg_diff_fn(void *FPtr) {
+static void printRegDiffFn(void *FPtr) {
   printf("Different Registers for '");
   Dl_info DLI;
   if (dladdr(FPtr, &DLI))
@@ -361,6 +657,10 @@ extern "C" void __llvm_dc_print_reg_diff_fn(void *FPtr) {
   printf("':\n");
 }
 
+extern "C" void __llvm_dc_print_reg_diff_fn(void *FPtr) {
+  printRegDiffFn(FPtr);
+}
+
 extern "C" void __llvm_dc_print_reg_diff(char *Name, uint8_t *v1, uint8_t *v2,
                                          uint32_t Size) {
   bool Diff = false;
@@ -377,6 +677,87 @@ extern "C" void __llvm_dc_print_reg_diff(char *Name, uint8_t *v1, uint8_t *v2,
   printf("\n");
 }
 
+namespace {
+// An entry of the regset trace: the new value of a register that changed,
+// at the exit of a function.
+// The name is copied, as the trace outlives the translated code, say, in a
+// JIT.
+struct RegTraceEntry {
+  void *FPtr;
+  char Name[16];
+  // Which exit of a function the entry is of: the registers of an exit are
+  // printed together.
+  uint64_t Exit;
+  uint32_t Size;
+  uint8_t Value[64];
+};
+} // end anonymous namespace
+
+// The last entries of the trace, printed when the process exits.
+static const uint64_t RegTraceSize = 4096;
+static RegTraceEntry RegTrace[RegTraceSize];
+static uint64_t RegTraceNumEntries, RegTraceNumExits;
+static void *RegTraceFPtr;
+
+extern "C" void __llvm_dc_print_regset_trace() {
+  uint64_t Begin = 0;
+  if (RegTraceNumEntries > RegTraceSize) {
+    Begin = RegTraceNumEntries - RegTraceSize;
+    printf("(%llu earlier changes dropped)\n", (unsigned long long)Begin);
+  }
+  uint64_t LastExit = 0;
+  for (uint64_t I = Begin; I != RegTraceNumEntries; ++I) {
+    const RegTraceEntry &E = RegTrace[I % RegTraceSize];
+    if (I == Begin || E.Exit != LastExit)
+      printRegDiffFn(E.FPtr);
+    LastExit = E.Exit;
+    printf("%s = ", E.Name);
+    for (uint32_t i = 0; i < E.Size; ++i)
+      printf("%.2x", E.Value[E.Size - i - 1]);
+    printf("\n");
+  }
+}
+
+extern "C" void __llvm_dc_trace_regset_fn(void *FPtr) {
+  if (!RegTraceNumExits)
+    atexit(__llvm_dc_print_regset_trace);
+  ++RegTraceNumExits;
+  RegTraceFPtr = FPtr;
+}
+
+extern "C" void __llvm_dc_trace_reg(char *Name, uint8_t *v1, uint8_t *v2,
+                                    uint32_t Size) {
+  if (!memcmp(v1, v2, Size))
+    return;
+  RegTraceEntry &E = RegTrace[RegTraceNumEntries++ % RegTraceSize];
+  E.FPtr = RegTraceFPtr;
+  strncpy(E.Name, Name, sizeof(E.Name) - 1);
+  E.Name[sizeof(E.Name) - 1] = '\0';
+  E.Exit = RegTraceNumExits;
+  // The vector registers are at most 512 bits; keep the low bytes of wider
+  // ones.
+  E.Size = std::min<uint32_t>(Size, sizeof(E.Value));
+  memcpy(E.Value, v2, E.Size);
+}
+
+Constant *DCRegisterSema::getRuntimeFunction(StringRef Name,
+                                             FunctionType *FTy) {
+  return TheModule->getOrInsertFunction(Name, FTy);
+}
+
+uint64_t DCRegisterSema::getRuntimeSymbolAddress(StringRef Name) {
+  return StringSwitch<uint64_t>(Name)
+      .Case("__llvm_dc_print_reg_diff_fn",
+            reinterpret_cast<uintptr_t>(&__llvm_dc_print_reg_diff_fn))
+      .Case("__llvm_dc_print_reg_diff",
+            reinterpret_cast<uintptr_t>(&__llvm_dc_print_reg_diff))
+      .Case("__llvm_dc_trace_regset_fn",
+            reinterpret_cast<uintptr_t>(&__llvm_dc_trace_regset_fn))
+      .Case("__llvm_dc_trace_reg",
+            reinterpret_cast<uintptr_t>(&__llvm_dc_trace_reg))
+      .Default(0);
+}
+
 Function *DCRegisterSema::getOrCreateRegSetDiffFunction(bool Definition) {
   Type *I8PtrTy = Builder->getInt8PtrTy();
   Type *RegSetPtrTy = RegSetType->getPointerTo();
@@ -406,7 +787,7 @@ Function *DCRegisterSema::getOrCreateRegSetDiffFunction(bool Definition) {
       FunctionType::get(Builder->getVoidTy(), PrintFnArgTys, false);
 
   Builder->CreateCall(
-      getCallTargetForExtFn(PrintFnType, &__llvm_dc_print_reg_diff_fn), FnAddr);
+      getRuntimeFunction("__llvm_dc_print_reg_diff_fn", PrintFnType), FnAddr);
 
   // We use a C++ helper function to diff and print each individual register:
   //   __llvm_dc_print_reg_diff (defined above).
@@ -415,7 +796,7 @@ Function *DCRegisterSema::getOrCreateRegSetDiffFunction(bool Definition) {
       FunctionType::get(Builder->getVoidTy(), RegDiffArgTys, false);
 
   Value *RegDiffFnPtr =
-      getCallTargetForExtFn(RegDiffFnType, &__llvm_dc_print_reg_diff);
+      getRuntimeFunction("__llvm_dc_print_reg_diff", RegDiffFnType);
 
   for (auto Reg : LargestRegs) {
     if (Reg == 0)
@@ -439,3 +820,55 @@ Function *DCRegisterSema::getOrCreateRegSetDiffFunction(bool Definition) {
 
   return RSDiffFn;
 }
+
+Constant *DCRegisterSema::getRegNameString(unsigned RegNo) {
+  const std::string GVName =
+      (Twine("__llvm_dc_regname_") + MRI.getName(RegNo)).str();
+  GlobalVariable *GV = TheModule->getNamedGlobal(GVName);
+  if (!GV) {
+    Constant *Init = ConstantDataArray::getString(*Ctx, MRI.getName(RegNo));
+    GV = new GlobalVariable(*TheModule, Init->getType(), /*isConstant=*/true,
+                            GlobalValue::PrivateLinkage, Init, GVName);
+  }
+  return ConstantExpr::getBitCast(GV, Builder->getInt8PtrTy());
+}
+
+void DCRegisterSema::insertRegSetTraceCode(BasicBlock *EntryBB,
+                                           BasicBlock *ExitBB,
+                                           uint64_t FnAddr) {
+  Type *I8PtrTy = Builder->getInt8PtrTy();
+  Type *TraceFnArgTys[] = {I8PtrTy};
+  FunctionType *TraceFnType =
+      FunctionType::get(Builder->getVoidTy(), TraceFnArgTys, false);
+  Type *TraceRegArgTys[] = {I8PtrTy, I8PtrTy, I8PtrTy, Builder->getInt32Ty()};
+  FunctionType *TraceRegType =
+      FunctionType::get(Builder->getVoidTy(), TraceRegArgTys, false);
+  Constant *TraceRegFn =
+      getRuntimeFunction("__llvm_dc_trace_reg", TraceRegType);
+
+  DCIRBuilder EntryBuilder(EntryBB, EntryBB->getFirstInsertionPt(), &CurAddr);
+  DCIRBuilder ExitBuilder(ExitBB, ExitBB->getTerminator(), &CurAddr);
+  ExitBuilder.CreateCall(
+      getRuntimeFunction("__llvm_dc_trace_regset_fn", TraceFnType),
+      ExitBuilder.CreateIntToPtr(ExitBuilder.getInt64(FnAddr), I8PtrTy));
+
+  // Only the incoming value of the registers the function wrote is kept, and
+  // compared to their value at the exit, once they are saved to the regset.
+  Value *RegSet = &TheFunction->getArgumentList().front();
+  for (int RI = FnWrittenRegs.find_first(); RI != -1;
+       RI = FnWrittenRegs.find_next(RI)) {
+    int OffsetInSet = RegOffsetsInSet[RI];
+    if (OffsetInSet == -1)
+      continue;
+    Value *Idx[] = {EntryBuilder.getInt32(0),
+                    EntryBuilder.getInt32(OffsetInSet)};
+    Value *RegPtr = EntryBuilder.CreateInBoundsGEP(RegSet, Idx);
+    Value *Saved = EntryBuilder.CreateAlloca(getRegType(RI));
+    EntryBuilder.CreateStore(EntryBuilder.CreateLoad(RegPtr), Saved);
+    ExitBuilder.CreateCall(
+        TraceRegFn, {getRegNameString(RI),
+                     ExitBuilder.CreateBitCast(Saved, I8PtrTy),
+                     ExitBuilder.CreateBitCast(RegPtr, I8PtrTy),
+                     ExitBuilder.getInt32(RegSizes[RI] / 8)});
+  }
+}
@@ -0,0 +1,325 @@
+//===-- lib/DC/DCStackFramePass.cpp - Stack frame recovery ------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/DC/DCStackFramePass.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/DC/DCRegisterSema.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/DataLayout.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/Module.h"
+
+using namespace llvm;
+
+char DCStackFramePass::ID = 0;
+
+// The stack accesses are at a delta from the stack pointer plus the base of
+// the guest memory, when there's one: they aren't recognized.
+DCStackFramePass::DCStackFramePass(const DCRegisterSema &DRS)
+    : FunctionPass(ID),
+      SPIndex(DRS.getGuestMemoryBase() ? -1
+                                       : DRS.getStackPointerRegSetIndex()) {}
+
+// Get the value of \p V if it is a constant, possibly extended or truncated
+// by an instruction the semantics didn't fold.
+static bool getConstant(Value *V, int64_t &C) {
+  if (auto *Cast = dyn_cast<CastInst>(V))
+    if (auto *Op = dyn_cast<ConstantInt>(Cast->getOperand(0)))
+      V = ConstantExpr::getCast(Cast->getOpcode(), Op, Cast->getType());
+  auto *CI = dyn_cast<ConstantInt>(V);
+  if (!CI || CI->getBitWidth() > 64)
+    return false;
+  C = CI->getSExtValue();
+  return true;
+}
+
+namespace {
+/// \brief An access to the stack, at a known delta from the incoming stack
+/// pointer.
+struct StackAccess {
+  Instruction *I;
+  int64_t Offset;
+  uint64_t Size;
+};
+
+/// \brief The values derived from the incoming stack pointer, by adding
+/// constants to it, and what is done with them.
+class StackPointerDeltas {
+  const DataLayout &DL;
+  // The regset pointers, the GEPs of the entry block, by regset index.
+  const DenseMap<Value *, unsigned> &RegPtrs;
+
+  SmallVector<Value *, 32> Worklist;
+
+public:
+  DenseMap<Value *, int64_t> Offsets;
+  SmallVector<StackAccess, 32> Accesses;
+  // The regset indices an address in the stack is stored to.
+  SmallVector<unsigned, 4> StoredRegs;
+  // The phis and selects, whose operands must all have the same delta.
+  SmallVector<Instruction *, 8> Merges;
+
+  StackPointerDeltas(const DataLayout &DL,
+                     const DenseMap<Value *, unsigned> &RegPtrs)
+      : DL(DL), RegPtrs(RegPtrs) {}
+
+  // Follow the uses of \p SP, at delta 0. Return false if the stack may be
+  // accessed otherwise than through a known delta.
+  bool run(Value *SP);
+
+private:
+  bool addDerived(Value *V, int64_t Offset);
+  bool visitUser(Value *V, int64_t Offset, User *U);
+  bool visitPointer(Value *Ptr, int64_t Offset);
+};
+} // end anonymous namespace
+
+bool StackPointerDeltas::run(Value *SP) {
+  if (!addDerived(SP, 0))
+    return false;
+  while (!Worklist.empty()) {
+    Value *V = Worklist.pop_back_val();
+    const int64_t Offset = Offsets[V];
+    for (User *U : V->users())
+      if (!visitUser(V, Offset, U))
+        return false;
+  }
+
+  for (Instruction *I : Merges) {
+    const int64_t Offset = Offsets[I];
+    for (unsigned OI = isa<SelectInst>(I) ? 1 : 0, OE = I->getNumOperands();
+         OI != OE; ++OI) {
+      auto It = Offsets.find(I->getOperand(OI));
+      if (It == Offsets.end() || It->second != Offset)
+        return false;
+    }
+  }
+  return true;
+}
+
+bool StackPointerDeltas::addDerived(Value *V, int64_t Offset) {
+  auto Ins = Offsets.insert(std::make_pair(V, Offset));
+  if (!Ins.second)
+    return Ins.first->second == Offset;
+  Worklist.push_back(V);
+  return true;
+}
+
+bool StackPointerDeltas::visitUser(Value *V, int64_t Offset, User *U) {
+  if (auto *BO = dyn_cast<BinaryOperator>(U)) {
+    int64_t C;
+    if (BO->getOpcode() == Instruction::Add) {
+      Value *Other = BO->getOperand(BO->getOperand(0) == V ? 1 : 0);
+      return getConstant(Other, C) && addDerived(BO, Offset + C);
+    }
+    if (BO->getOpcode() == Instruction::Sub && BO->getOperand(0) == V)
+      return getConstant(BO->getOperand(1), C) && addDerived(BO, Offset - C);
+    return false;
+  }
+  if (auto *ITP = dyn_cast<IntToPtrInst>(U))
+    return visitPointer(ITP, Offset);
+  if (auto *SI = dyn_cast<StoreInst>(U)) {
+    // Only the callees can see an address in the stack stored to a register.
+    if (SI->getValueOperand() != V)
+      return false;
+    auto It = RegPtrs.find(SI->getPointerOperand());
+    if (It == RegPtrs.end())
+      return false;
+    StoredRegs.push_back(It->second);
+    return true;
+  }
+  if (isa<PHINode>(U) || isa<SelectInst>(U)) {
+    if (isa<SelectInst>(U) && U->getOperand(0) == V)
+      return false;
+    if (!Offsets.count(U))
+      Merges.push_back(cast<Instruction>(U));
+    return addDerived(U, Offset);
+  }
+  // The flags computed from the stack pointer don't let the address escape.
+  if (isa<ICmpInst>(U))
+    return true;
+  if (auto *TI = dyn_cast<TruncInst>(U))
+    return TI->getDestTy()->getIntegerBitWidth() < DL.getPointerSizeInBits();
+  if (auto *II = dyn_cast<IntrinsicInst>(U)) {
+    if (!II->doesNotAccessMemory())
+      return false;
+    // Only the overflow bit of the *.with.overflow intrinsics is used.
+    for (User *IU : II->users()) {
+      auto *EVI = dyn_cast<ExtractValueInst>(IU);
+      if (!EVI || EVI->getNumIndices() != 1 || EVI->getIndices()[0] != 1)
+        return false;
+    }
+    return true;
+  }
+  return false;
+}
+
+bool StackPointerDeltas::visitPointer(Value *Ptr, int64_t Offset) {
+  for (User *U : Ptr->users()) {
+    if (auto *BC = dyn_cast<BitCastInst>(U)) {
+      if (!visitPointer(BC, Offset))
+        return false;
+      continue;
+    }
+    StackAccess A;
+    A.I = cast<Instruction>(U);
+    A.Offset = Offset;
+    if (auto *LI = dyn_cast<LoadInst>(U)) {
+      if (!LI->isSimple())
+        return false;
+      A.Size = DL.getTypeStoreSize(LI->getType());
+    } else if (auto *SI = dyn_cast<StoreInst>(U)) {
+      if (!SI->isSimple() || SI->getPointerOperand() != Ptr)
+        return false;
+      A.Size = DL.getTypeStoreSize(SI->getValueOperand()->getType());
+    } else {
+      return false;
+    }
+    Accesses.push_back(A);
+  }
+  return true;
+}
+
+bool DCStackFramePass::runOnFunction(Function &F) {
+  if (F.isDeclaration() || F.isIntrinsic() || SPIndex < 0 ||
+      F.arg_size() != 1)
+    return false;
+  const DataLayout &DL = F.getParent()->getDataLayout();
+  Argument *RegSet = &*F.arg_begin();
+
+  // The pointers to the registers in the regset are all in the entry block.
+  BasicBlock &EntryBB = F.getEntryBlock();
+  DenseMap<Value *, unsigned> RegPtrs;
+  for (Instruction &I : EntryBB)
+    if (auto *GEP = dyn_cast<GetElementPtrInst>(&I))
+      if (GEP->getPointerOperand() == RegSet && GEP->getNumOperands() == 3)
+        if (auto *Idx = dyn_cast<ConstantInt>(GEP->getOperand(2)))
+          RegPtrs[GEP] = Idx->getZExtValue();
+
+  // The incoming values of the registers are loaded before anything is
+  // stored to the regset: in the entry block, or in the straight line of
+  // blocks it starts, where the passes before may have sunk them.
+  SmallPtrSet<LoadInst *, 32> InitLoads;
+  LoadInst *SPInit = nullptr;
+  for (BasicBlock *BB = &EntryBB; BB;) {
+    bool Stop = false;
+    for (Instruction &I : *BB) {
+      if (auto *LI = dyn_cast<LoadInst>(&I)) {
+        auto It = RegPtrs.find(LI->getPointerOperand());
+        if (It == RegPtrs.end())
+          continue;
+        InitLoads.insert(LI);
+        if (!SPInit && It->second == unsigned(SPIndex))
+          SPInit = LI;
+      } else if ((isa<CallInst>(&I) && !isa<IntrinsicInst>(&I)) ||
+                 (isa<StoreInst>(&I) &&
+                  RegPtrs.count(cast<StoreInst>(&I)->getPointerOperand()))) {
+        Stop = true;
+        break;
+      }
+    }
+    BasicBlock *Succ = BB->getSingleSuccessor();
+    BB = !Stop && Succ && Succ->getSinglePredecessor() ? Succ : nullptr;
+  }
+  if (!SPInit)
+    return false;
+
+  StackPointerDeltas Deltas(DL, RegPtrs);
+  if (!Deltas.run(SPInit))
+    return false;
+
+  // The registers an address in the frame is stored to must not be read back
+  // after the entry: the callees return whatever they like in them.
+  for (unsigned Reg : Deltas.StoredRegs)
+    for (auto &PtrIdx : RegPtrs) {
+      if (PtrIdx.second != Reg)
+        continue;
+      for (User *U : PtrIdx.first->users())
+        if (auto *LI = dyn_cast<LoadInst>(U))
+          if (!InitLoads.count(LI) && !LI->use_empty())
+            return false;
+    }
+
+  // The frame is what the function accesses below the incoming stack
+  // pointer. What is above belongs to the caller.
+  int64_t FrameBegin = 0;
+  for (const StackAccess &A : Deltas.Accesses) {
+    if (A.Offset >= 0)
+      continue;
+    if (A.Offset + int64_t(A.Size) > 0)
+      return false;
+    FrameBegin = std::min(FrameBegin, A.Offset);
+  }
+  if (FrameBegin == 0)
+    return false;
+  const uint64_t FrameSize = -FrameBegin;
+
+  LLVMContext &Ctx = F.getContext();
+  Type *I8Ty = Type::getInt8Ty(Ctx);
+  AllocaInst *Frame = new AllocaInst(ArrayType::get(I8Ty, FrameSize), "frame",
+                                     &*EntryBB.begin());
+  Frame->setAlignment(16);
+  IRBuilder<> Builder(SPInit->getParent(),
+                      std::next(BasicBlock::iterator(SPInit)));
+  Value *FrameAddr = Builder.CreateIntToPtr(
+      Builder.CreateAdd(SPInit, Builder.getInt64(FrameBegin)),
+      Type::getInt8PtrTy(Ctx), "frame_addr");
+
+  // Only the function sees the frame: its accesses aren't to the guest
+  // memory anymore.
+  MDNode *FrameTag = DCRegisterSema::getStackFrameTBAATag(Ctx);
+  SmallPtrSet<Instruction *, 32> OldPtrs;
+  for (const StackAccess &A : Deltas.Accesses) {
+    if (A.Offset >= 0)
+      continue;
+    const unsigned PtrOp = isa<LoadInst>(A.I) ? 0 : 1;
+    Value *OldPtr = A.I->getOperand(PtrOp);
+    Builder.SetInsertPoint(A.I);
+    Value *Ptr = Builder.CreateConstInBoundsGEP2_64(Frame, 0,
+                                                    A.Offset - FrameBegin);
+    A.I->setOperand(PtrOp, Builder.CreateBitCast(Ptr, OldPtr->getType()));
+    A.I->setMetadata(LLVMContext::MD_tbaa, FrameTag);
+    OldPtrs.insert(cast<Instruction>(OldPtr));
+  }
+
+  // The callees see the frame in the stack, and can change it.
+  SmallVector<CallInst *, 16> Calls;
+  for (BasicBlock &BB : F)
+    for (Instruction &I : BB)
+      if (auto *CI = dyn_cast<CallInst>(&I))
+        if (!isa<IntrinsicInst>(CI) && !CI->doesNotAccessMemory())
+          Calls.push_back(CI);
+  for (CallInst *CI : Calls) {
+    Builder.SetInsertPoint(CI);
+    Builder.CreateMemCpy(FrameAddr, Frame, FrameSize, 1);
+    if (CI->doesNotReturn())
+      continue;
+    Builder.SetInsertPoint(CI->getParent(),
+                           std::next(BasicBlock::iterator(CI)));
+    Builder.CreateMemCpy(Frame, FrameAddr, FrameSize, 1);
+  }
+
+  // Drop the inttoptrs and bitcasts left without uses.
+  SmallSetVector<Instruction *, 32> Dead(OldPtrs.begin(), OldPtrs.end());
+  while (!Dead.empty()) {
+    Instruction *I = Dead.pop_back_val();
+    if (!I->use_empty())
+      continue;
+    if (auto *Op = dyn_cast<Instruction>(I->getOperand(0)))
+      if (isa<CastInst>(Op) && Op->getType()->isPointerTy())
+        Dead.insert(Op);
+    I->eraseFromParent();
+  }
+  return true;
+}
@@ -8,56 +8,113 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/DC/DCTranslatedInstTracker.h"
+#include <algorithm>
 
 using namespace llvm;
 
-static bool TranslatedInstAddrComp(const DCTranslatedInst &LHS, uint64_t Addr) {
-  return LHS.DecodedInst->Address < Addr;
-}
-
 void DCTranslatedInstTracker::trackInst(const DCTranslatedInst &TI) {
-  TranslatedInstListTy::iterator I =
-      std::lower_bound(TranslatedInsts.begin(), TranslatedInsts.end(),
-                       TI.DecodedInst->Address, TranslatedInstAddrComp);
   // NOTE: It is possible that there would be several translated instructions
   // at the same address. This happens for instance when a basic block is
   // shared by different functions.
-  TranslatedInsts.insert(I, TI);
+  TrackedInst I = {TI.DecodedInst, unsigned(ValueInfos.size()), 0};
+  ValueInfos.insert(ValueInfos.end(), TI.OperandUseVals.begin(), TI.OperandUseVals.end());
+  ValueInfos.insert(ValueInfos.end(), TI.OperandDefVals.begin(), TI.OperandDefVals.end());
+  ValueInfos.insert(ValueInfos.end(), TI.ImpDefVals.begin(), TI.ImpDefVals.end());
+  ValueInfos.insert(ValueInfos.end(), TI.ImpUseVals.begin(), TI.ImpUseVals.end());
+  I.ValuesEnd = ValueInfos.size();
+  TrackedInsts.push_back(I);
+  Finalized = false;
+}
 
-  for (int i = 0, e = TI.OperandUseVals.size(); i != e; ++i)
-    ValInfo[TI.OperandUseVals[i].VH].push_back(TI.OperandUseVals[i]);
-  for (int i = 0, e = TI.OperandDefVals.size(); i != e; ++i)
-    ValInfo[TI.OperandDefVals[i].VH].push_back(TI.OperandDefVals[i]);
-  for (int i = 0, e = TI.ImpDefVals.size(); i != e; ++i)
-    ValInfo[TI.ImpDefVals[i].VH].push_back(TI.ImpDefVals[i]);
-  for (int i = 0, e = TI.ImpUseVals.size(); i != e; ++i)
-    ValInfo[TI.ImpUseVals[i].VH].push_back(TI.ImpUseVals[i]);
+void DCTranslatedInstTracker::finalize() {
+  if (Finalized)
+    return;
+  std::stable_sort(TrackedInsts.begin(), TrackedInsts.end(),
+                   [](const TrackedInst &LHS, const TrackedInst &RHS) {
+                     return LHS.DecodedInst->Address <
+                            RHS.DecodedInst->Address;
+                   });
+  ValueInfoIndices.clear();
+  for (unsigned i = 0, e = ValueInfos.size(); i != e; ++i)
+    if (const Value *V = ValueInfos[i].VH)
+      ValueInfoIndices[V].push_back(i);
+  // The value ranges were appended in tracking order: sorting them back
+  // keeps the empty ones before the one starting at the same index.
+  ValueRangeInsts.clear();
+  ValueRangeInsts.reserve(TrackedInsts.size());
+  for (unsigned i = 0, e = TrackedInsts.size(); i != e; ++i)
+    ValueRangeInsts.push_back(std::make_pair(TrackedInsts[i].ValuesBegin, i));
+  std::stable_sort(ValueRangeInsts.begin(), ValueRangeInsts.end(),
+                   [](const std::pair<unsigned, unsigned> &LHS,
+                      const std::pair<unsigned, unsigned> &RHS) {
+                     return LHS.first < RHS.first;
+                   });
+  Finalized = true;
 }
 
 void DCTranslatedInstTracker::getInstsForValue(
-    const Value &V,
-    const SmallVectorImpl<DCTranslatedInst::ValueInfo> *&TrackedInsts) const {
-
-  TrackedInsts = 0;
-  ValInfoMapTy::const_iterator I = ValInfo.find(&V);
-  if (I == ValInfo.end())
+    const Value &V, SmallVectorImpl<const ValueInfo *> &Infos) const {
+  assert(Finalized && "Tracked instructions aren't indexed!");
+  Infos.clear();
+  auto I = ValueInfoIndices.find(&V);
+  if (I == ValueInfoIndices.end())
     return;
+  for (unsigned Idx : I->second)
+    Infos.push_back(&ValueInfos[Idx]);
+}
 
-  TrackedInsts = &I->second;
+unsigned
+DCTranslatedInstTracker::getTrackedInstIndex(const ValueInfo &VI) const {
+  assert(Finalized && "Tracked instructions aren't indexed!");
+  const unsigned Idx = &VI - ValueInfos.data();
+  assert(&VI >= ValueInfos.data() && Idx < ValueInfos.size() &&
+         "Value info isn't tracked!");
+  auto I = std::upper_bound(ValueRangeInsts.begin(), ValueRangeInsts.end(),
+                            Idx,
+                            [](unsigned Idx,
+                               const std::pair<unsigned, unsigned> &Range) {
+                              return Idx < Range.first;
+                            });
+  assert(I != ValueRangeInsts.begin() && "Value info before all the ranges!");
+  return std::prev(I)->second;
 }
 
-const DCTranslatedInst *
+ArrayRef<DCTranslatedInstTracker::ValueInfo>
 DCTranslatedInstTracker::getTrackedInfo(const MCDecodedInst &MCDI) const {
-
-  TranslatedInstListTy::const_iterator I =
-      std::lower_bound(TranslatedInsts.begin(), TranslatedInsts.end(),
-                       MCDI.Address, TranslatedInstAddrComp);
-  if (I == TranslatedInsts.end() || I->DecodedInst != &MCDI)
-    return 0;
-  return &*I;
+  assert(Finalized && "Tracked instructions aren't indexed!");
+  auto I = std::lower_bound(TrackedInsts.begin(), TrackedInsts.end(),
+                            MCDI.Address,
+                            [](const TrackedInst &LHS, uint64_t Addr) {
+                              return LHS.DecodedInst->Address < Addr;
+                            });
+  for (auto E = TrackedInsts.end();
+       I != E && I->DecodedInst->Address == MCDI.Address; ++I)
+    if (I->DecodedInst == &MCDI)
+      return makeArrayRef(ValueInfos.data() + I->ValuesBegin,
+                          ValueInfos.data() + I->ValuesEnd);
+  return None;
 }
 
 void DCTranslatedInstTracker::clear() {
-  ValInfo.clear();
-  TranslatedInsts.clear();
+  ValueInfos.clear();
+  TrackedInsts.clear();
+  ValueInfoIndices.clear();
+  ValueRangeInsts.clear();
+  Finalized = true;
+}
+
+// The heap memory of V, if its elements don't fit inline.
+template <typename T, unsigned N>
+static size_t getHeapSize(const SmallVector<T, N> &V) {
+  return V.capacity() > N ? V.capacity() * sizeof(T) : 0;
+}
+
+size_t DCTranslatedInstTracker::getMemoryUsage() const {
+  size_t Size = ValueInfos.capacity() * sizeof(ValueInfo) +
+                TrackedInsts.capacity() * sizeof(TrackedInst) +
+                ValueInfoIndices.getMemorySize() +
+                ValueRangeInsts.capacity() * sizeof(ValueRangeInsts[0]);
+  for (const auto &KV : ValueInfoIndices)
+    Size += getHeapSize(KV.second);
+  return Size;
 }
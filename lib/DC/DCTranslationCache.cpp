@@ -0,0 +1,279 @@
+//===-- lib/DC/DCTranslationCache.cpp - DC Translation Cache ----*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/DC/DCTranslationCache.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/Config/llvm-config.h"
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCExpr.h"
+#include "llvm/MC/MCInst.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/Errc.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace llvm;
+using namespace support;
+
+#define DEBUG_TYPE "dc-translation-cache"
+
+// The version of the translation: bump it when the code translating the
+// instructions, or the IR it creates, changes, to invalidate the existing
+// cache entries. The generated semantics tables, the options and the passes
+// are part of the configuration the entries are keyed by instead.
+static const char TranslatorVersion[] = "dc-translator-3";
+
+// The entries start with a magic and the version of their layout, followed
+// by the unit:
+//   u32 NumFunctions, u64 NumInsts,
+//   u32 count, then the function addresses, as u64,
+//   u32 count, then the addresses of the functions with call basic blocks,
+//                                                                 as u64,
+//   u32 count, then the unknown instruction counts, as u32 name size, name,
+//                                                      u32 count,
+//   u64 size, then the bitcode.
+// All integers are little endian.
+static const char EntryMagic[] = "DCTC";
+static const uint32_t EntryFormatVersion = 2;
+
+ErrorOr<std::unique_ptr<DCTranslationCache>>
+DCTranslationCache::create(StringRef Dir) {
+  if (std::error_code EC = sys::fs::create_directories(Dir))
+    return EC;
+  return std::unique_ptr<DCTranslationCache>(new DCTranslationCache(Dir));
+}
+
+namespace {
+class KeyHasher {
+  MD5 Hash;
+
+public:
+  void add(uint64_t V) {
+    uint8_t Bytes[8];
+    endian::write64le(Bytes, V);
+    Hash.update(Bytes);
+  }
+  void add(StringRef S) {
+    add(S.size());
+    Hash.update(S);
+  }
+  void add(const MCInst &Inst) {
+    add(Inst.getOpcode());
+    add(Inst.getNumOperands());
+    for (const MCOperand &Op : Inst) {
+      if (Op.isReg()) {
+        add('r');
+        add(Op.getReg());
+      } else if (Op.isImm()) {
+        add('i');
+        add(Op.getImm());
+      } else if (Op.isFPImm()) {
+        add('f');
+        add(DoubleToBits(Op.getFPImm()));
+      } else if (Op.isExpr()) {
+        std::string Str;
+        raw_string_ostream OS(Str);
+        Op.getExpr()->print(OS, nullptr);
+        add('e');
+        add(OS.str());
+      } else if (Op.isInst()) {
+        add('n');
+        add(*Op.getInst());
+      } else {
+        add('-');
+      }
+    }
+  }
+  std::string final() {
+    MD5::MD5Result Result;
+    Hash.final(Result);
+    SmallString<32> Str;
+    MD5::stringifyResult(Result, Str);
+    return Str.str();
+  }
+};
+} // end anonymous namespace
+
+std::string DCTranslationCache::getKey(StringRef Config,
+                                       const MCFunction &MCFN) const {
+  KeyHasher H;
+  H.add(TranslatorVersion);
+  H.add(LLVM_VERSION_STRING);
+  H.add(Config);
+  H.add(MCFN.getName());
+  // The blocks are hashed in function order, which is also the order they are
+  // translated in.
+  H.add(MCFN.size());
+  for (const MCBasicBlock *BB : MCFN) {
+    H.add(BB->getStartAddr());
+    H.add(BB->getSizeInBytes());
+    H.add(BB->size());
+    for (const MCDecodedInst &I : *BB) {
+      H.add(I.Address);
+      H.add(I.Size);
+      H.add(I.Inst);
+    }
+    H.add(BB->succ_end() - BB->succ_begin());
+    for (auto SI = BB->succ_begin(), SE = BB->succ_end(); SI != SE; ++SI)
+      H.add((*SI)->getStartAddr());
+  }
+  return H.final();
+}
+
+namespace {
+// Reads the entries, failing on the first read past their end.
+class EntryReader {
+  StringRef Data;
+  bool Failed;
+
+public:
+  explicit EntryReader(StringRef Data) : Data(Data), Failed(false) {}
+
+  bool failed() const { return Failed; }
+  StringRef getRemaining() const { return Data; }
+
+  StringRef readBytes(uint64_t Size) {
+    if (Failed || Size > Data.size()) {
+      Failed = true;
+      return StringRef();
+    }
+    StringRef Bytes = Data.substr(0, Size);
+    Data = Data.substr(Size);
+    return Bytes;
+  }
+  uint32_t read32() {
+    StringRef Bytes = readBytes(4);
+    return Failed ? 0 : endian::read32le(Bytes.data());
+  }
+  uint64_t read64() {
+    StringRef Bytes = readBytes(8);
+    return Failed ? 0 : endian::read64le(Bytes.data());
+  }
+};
+
+class EntryWriter {
+  raw_ostream &OS;
+
+public:
+  explicit EntryWriter(raw_ostream &OS) : OS(OS) {}
+
+  void write32(uint32_t V) {
+    char Bytes[4];
+    endian::write32le(Bytes, V);
+    OS.write(Bytes, sizeof(Bytes));
+  }
+  void write64(uint64_t V) {
+    char Bytes[8];
+    endian::write64le(Bytes, V);
+    OS.write(Bytes, sizeof(Bytes));
+  }
+};
+} // end anonymous namespace
+
+static std::string getEntryPath(StringRef Dir, StringRef Key) {
+  SmallString<128> Path(Dir);
+  sys::path::append(Path, Key + ".dctc");
+  return Path.str();
+}
+
+void DCTranslatedUnit::write(raw_ostream &OS) const {
+  EntryWriter W(OS);
+  W.write32(NumFunctions);
+  W.write64(NumInsts);
+  W.write32(FunctionAddrs.size());
+  for (uint64_t Addr : FunctionAddrs)
+    W.write64(Addr);
+  W.write32(CallBBFunctionAddrs.size());
+  for (uint64_t Addr : CallBBFunctionAddrs)
+    W.write64(Addr);
+  W.write32(UnknownInstCounts.size());
+  for (const auto &NameCount : UnknownInstCounts) {
+    W.write32(NameCount.first.size());
+    OS << NameCount.first;
+    W.write32(NameCount.second);
+  }
+  W.write64(Bitcode.size());
+  OS.write(Bitcode.data(), Bitcode.size());
+}
+
+bool DCTranslatedUnit::read(StringRef &Data) {
+  EntryReader R(Data);
+  DCTranslatedUnit U;
+  U.NumFunctions = R.read32();
+  U.NumInsts = R.read64();
+  // The reader fails past the end of the data: the loops stop there.
+  for (uint32_t I = 0, E = R.read32(); I != E && !R.failed(); ++I)
+    U.FunctionAddrs.push_back(R.read64());
+  for (uint32_t I = 0, E = R.read32(); I != E && !R.failed(); ++I)
+    U.CallBBFunctionAddrs.push_back(R.read64());
+  for (uint32_t I = 0, E = R.read32(); I != E && !R.failed(); ++I) {
+    StringRef Name = R.readBytes(R.read32());
+    U.UnknownInstCounts.push_back(std::make_pair(Name.str(), R.read32()));
+  }
+  StringRef BC = R.readBytes(R.read64());
+  if (R.failed())
+    return false;
+  U.Bitcode.append(BC.begin(), BC.end());
+  *this = std::move(U);
+  Data = R.getRemaining();
+  return true;
+}
+
+bool DCTranslationCache::lookup(StringRef Key, DCTranslatedUnit &Unit) const {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> BufOrErr =
+      MemoryBuffer::getFile(getEntryPath(Dir, Key), /*FileSize=*/-1,
+                            /*RequiresNullTerminator=*/false);
+  if (!BufOrErr)
+    return false;
+
+  EntryReader R((*BufOrErr)->getBuffer());
+  if (R.readBytes(strlen(EntryMagic)) != EntryMagic ||
+      R.read32() != EntryFormatVersion)
+    return false;
+  StringRef Data = R.getRemaining();
+  if (!Unit.read(Data)) {
+    DEBUG(dbgs() << "Ignoring truncated cache entry " << Key << "\n");
+    return false;
+  }
+  return true;
+}
+
+std::error_code DCTranslationCache::store(StringRef Key,
+                                          const DCTranslatedUnit &Unit) const {
+  SmallString<128> TempPath;
+  int FD;
+  if (std::error_code EC = sys::fs::createUniqueFile(
+          getEntryPath(Dir, Key) + "-%%%%%%.tmp", FD, TempPath))
+    return EC;
+  {
+    raw_fd_ostream OS(FD, /*shouldClose=*/true);
+    EntryWriter W(OS);
+    OS << EntryMagic;
+    W.write32(EntryFormatVersion);
+    Unit.write(OS);
+    OS.close();
+    if (OS.has_error()) {
+      OS.clear_error();
+      sys::fs::remove(TempPath);
+      return make_error_code(errc::io_error);
+    }
+  }
+  // Replace any entry written concurrently: they are the same.
+  if (std::error_code EC = sys::fs::rename(TempPath, getEntryPath(Dir, Key))) {
+    sys::fs::remove(TempPath);
+    return EC;
+  }
+  return std::error_code();
+}
@@ -8,167 +8,166 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/DC/DCTranslator.h"
+#include "llvm/ADT/Optional.h"
 #include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/StringExtras.h"
+#include "llvm/Analysis/BasicAliasAnalysis.h"
+#include "llvm/Analysis/ObjCARCAnalysisUtils.h"
+#include "llvm/Analysis/Passes.h"
+#include "llvm/Analysis/ScopedNoAliasAA.h"
+#include "llvm/Analysis/TypeBasedAliasAnalysis.h"
+#include "llvm/Bitcode/ReaderWriter.h"
+#include "llvm/Config/config.h"
+#include "llvm/DC/DCBlockProfile.h"
+#include "llvm/DC/DCCallSummaries.h"
+#include "llvm/DC/DCColdOutlining.h"
 #include "llvm/DC/DCInstrSema.h"
 #include "llvm/DC/DCRegisterSema.h"
+#include "llvm/DC/DCStackFramePass.h"
+#include "llvm/DC/DCTranslationCache.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Intrinsics.h"
+#include "llvm/IR/ValueHandle.h"
+#include "llvm/Linker/Linker.h"
+#include "llvm/MC/MCAnalysis/MCFlattenedCFG.h"
 #include "llvm/MC/MCAnalysis/MCFunction.h"
 #include "llvm/MC/MCAnalysis/MCModule.h"
 #include "llvm/MC/MCObjectDisassembler.h"
 #include "llvm/Pass.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/PrettyStackTrace.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
+#include "llvm/Support/TraceEvents.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Transforms/ObjCARC.h"
 #include "llvm/Transforms/Scalar.h"
 #include "llvm/Transforms/Utils/Cloning.h"
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <sstream>
+#ifdef LLVM_ON_UNIX
+#include <cerrno>
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 
-// seems that `mem2reg' pass can accomplish this task. For performance consideration?
 namespace llvm {
+/// \brief Use the registers that calls preserve, per the calling convention,
+/// as such: the values stored to them in the regset are forwarded to the
+/// loads after the stores, across calls, in the same block, and the stores
+/// to the ones callees can't even read are removed.
+/// The registers are found in the regset by their indices, from
+/// DCRegisterSema::getCallPreservedRegSetIndices.
 class NonVolatileRegistersPass : public FunctionPass {
-    public:
-        static char ID;
+  BitVector Preserved;
+  BitVector CalleeRead;
 
-        NonVolatileRegistersPass() : FunctionPass(ID) { };
-        const char * getPassName() const override {return "NonVolatileRegisters Pass";}
+public:
+  static char ID;
 
-        virtual bool runOnFunction(Function &F);
+  explicit NonVolatileRegistersPass(const DCRegisterSema &DRS)
+      : FunctionPass(ID) {
+    DRS.getCallPreservedRegSetIndices(Preserved, CalleeRead);
+  }
 
-    private:
-        bool hasCall(const BasicBlock &BB);
-        bool isNonVolatile(uint64_t Idx);
-        bool isStack(uint64_t Idx);
-        void replaceLoaded(Instruction *StoreInst);
-    };
-}
+  const char *getPassName() const override {
+    return "NonVolatileRegisters Pass";
+  }
+
+  bool runOnFunction(Function &F) override;
+};
+} // end namespace llvm
 
 using namespace llvm;
 
 char NonVolatileRegistersPass::ID = 0;
 
 bool NonVolatileRegistersPass::runOnFunction(Function &F) {
-
-        if (F.isDeclaration() || F.isIntrinsic()) {
-            return false;
-        }
-        std::set<Value *> NonVolatileAndStackPointers;
-        std::set<Value *> NonVolatilePointers;
-
-        BasicBlock &Entry = F.getEntryBlock();
-        for (BasicBlock::iterator I_it = Entry.begin(); I_it != Entry.end(); ++I_it) {
-            if (I_it->getOpcode() == Instruction::GetElementPtr) {
-                if (ConstantInt *ConstIdx = dyn_cast<ConstantInt>(I_it->getOperand(2))) {
-                    if (isNonVolatile(ConstIdx->getZExtValue())) {
-                        NonVolatileAndStackPointers.insert(&*I_it);
-                        NonVolatilePointers.insert(&*I_it);
-                    } else if (isStack(ConstIdx->getZExtValue())) {
-                        NonVolatileAndStackPointers.insert(&*I_it);
-                    }
-                }
-            }
-        }
-
-        for (Function::iterator BB_it = F.begin(); BB_it != F.end(); ++BB_it) {
-            if (!hasCall(*BB_it))
-                continue;
-            for (BasicBlock::iterator I_it = BB_it->begin(); I_it != BB_it->end(); ++I_it) {
-                if (I_it->getOpcode() == Instruction::Store) {
-                    std::set<Value *>::iterator S_it = NonVolatileAndStackPointers.find(I_it->getOperand(1));
-                    if (S_it != NonVolatileAndStackPointers.end()) {
-                        replaceLoaded(&*I_it);
-                    }
-                }
-            }
-        }
-
-        std::set<Instruction*> toRemove;
-
-        for (auto &ptr : NonVolatilePointers) {
-
-            for (auto ptrUser : ptr->users()) {
-                if (StoreInst *storeInst = dyn_cast<StoreInst>(ptrUser)) {
-                    toRemove.insert(storeInst);
-                }
-            }
-        }
-
-        for (auto &r : toRemove) {
-            r->dropAllReferences();
-            r->removeFromParent();
-//                r->dump();
-        }
-        return true;
-}
-
-bool NonVolatileRegistersPass::hasCall(const BasicBlock &BB) {
-    for (BasicBlock::const_iterator I_it = BB.begin(); I_it != BB.end(); ++I_it) {
-        if (I_it->getOpcode() == Instruction::Call) {
-            return true;
-        }
-    }
-    return false;
-}
-
-//check AArch64RegisterInfo.td AArch64GenRegisterInfo.inc for detail??
-//https://stackoverflow.com/questions/261419/what-registers-to-save-in-the-arm-c-calling-convention
-//callee-saved register https://developer.arm.com/docs/ihi0055/latest/procedure-call-standard-for-the-arm-64-bit-architecture
-
-bool NonVolatileRegistersPass::isNonVolatile(uint64_t Idx) {
-    switch (Idx) {
-        default:
-            break;
-        case 24:
-        case 25:
-        case 26:
-        case 27:
-        case 28:
-        case 29:
-        case 30:
-        case 31:
-        case 32:
-        case 33:
-            return true;
-    }
+  if (F.isDeclaration() || F.isIntrinsic())
     return false;
-}
 
-bool NonVolatileRegistersPass::isStack(uint64_t Idx) {
-    switch (Idx) {
-        default:
-            break;
-        case 3:
-        case 0:
-            return true;
-    }
+  // The pointers to the registers in the regset are all in the entry block.
+  SmallPtrSet<Value *, 16> Ptrs;
+  SmallVector<Value *, 16> DeadStorePtrs;
+  for (Instruction &I : F.getEntryBlock()) {
+    auto *GEP = dyn_cast<GetElementPtrInst>(&I);
+    if (!GEP || GEP->getNumOperands() != 3)
+      continue;
+    auto *Idx = dyn_cast<ConstantInt>(GEP->getOperand(2));
+    if (!Idx || Idx->getZExtValue() >= Preserved.size() ||
+        !Preserved.test(Idx->getZExtValue()))
+      continue;
+    Ptrs.insert(GEP);
+    if (!CalleeRead.test(Idx->getZExtValue()))
+      DeadStorePtrs.push_back(GEP);
+  }
+  if (Ptrs.empty())
     return false;
-}
 
-void NonVolatileRegistersPass::replaceLoaded(Instruction *StoreInst) {
-    Value *Ptr = StoreInst->getOperand(1);
-    Value *V = StoreInst->getOperand(0);
-    if (!V)
-        StoreInst->dump();
-    assert(V);
+  // Only the blocks that both store and load one of the registers have loads
+  // to forward to: find them from the uses, then walk each of them once.
+  SmallPtrSet<BasicBlock *, 16> StoreBBs;
+  SmallSetVector<BasicBlock *, 16> ForwardBBs;
+  for (Value *Ptr : Ptrs)
+    for (User *U : Ptr->users())
+      if (auto *SI = dyn_cast<StoreInst>(U))
+        if (SI->getPointerOperand() == Ptr)
+          StoreBBs.insert(SI->getParent());
+  for (Value *Ptr : Ptrs)
+    for (User *U : Ptr->users())
+      if (auto *LI = dyn_cast<LoadInst>(U))
+        if (StoreBBs.count(LI->getParent()))
+          ForwardBBs.insert(LI->getParent());
 
-    BasicBlock *BB = StoreInst->getParent();
-    Instruction *Load = nullptr;
-    for (BasicBlock::iterator I_it = BB->begin(); I_it != BB->end(); ++I_it) {
-        if (I_it->getOpcode() == Instruction::Load && I_it->getOperand(0) == Ptr) {
-            Load = &*I_it;
+  bool Changed = false;
+  SmallDenseMap<Value *, Value *, 16> StoredVals;
+  for (BasicBlock *BB : ForwardBBs) {
+    StoredVals.clear();
+    for (Instruction &I : *BB) {
+      if (auto *SI = dyn_cast<StoreInst>(&I)) {
+        if (Ptrs.count(SI->getPointerOperand()))
+          StoredVals[SI->getPointerOperand()] = SI->getValueOperand();
+      } else if (auto *LI = dyn_cast<LoadInst>(&I)) {
+        auto It = StoredVals.find(LI->getPointerOperand());
+        if (It != StoredVals.end() && It->second != LI && !LI->use_empty()) {
+          LI->replaceAllUsesWith(It->second);
+          Changed = true;
         }
+      }
     }
+  }
 
-    if (!Load)
-        return;
-
-//    for (Value::const_use_iterator U_it = Load->use_begin(); U_it != Load->use_end(); ++U_it) {
-//
-//    }
-    if (Load != V)
-        Load->replaceAllUsesWith(V);
+  for (Value *Ptr : DeadStorePtrs) {
+    for (auto UI = Ptr->user_begin(), UE = Ptr->user_end(); UI != UE;) {
+      auto *SI = dyn_cast<StoreInst>(*UI++);
+      if (SI && SI->getPointerOperand() == Ptr) {
+        SI->eraseFromParent();
+        Changed = true;
+      }
+    }
+  }
+  return Changed;
 }
 
 #define DEBUG_TYPE "dctranslator"
@@ -180,7 +179,13 @@ DCTranslator::DCTranslator(LLVMContext &Ctx, const DataLayout &DL,
                            MCObjectDisassembler *MCOD, bool EnableIRAnnotation)
     : Ctx(Ctx), DL(DL), ModuleSet(), MCOD(MCOD), MCM(MCM),
       CurrentModule(nullptr), CurrentFPM(), DTIT(), AnnotWriter(), DIS(DIS),
-      OptLevel(TransOptLevel) {
+      OptLevel(TransOptLevel), NumJobs(1), SemaFactory(), Cache(nullptr),
+      CacheConfig(), NumCachedFunctions(0), ProcessIsolation(false),
+      StreamMaxFunctions(0), StreamMaxInsts(0), StreamMaxBytes(0),
+      StreamMinBytes(0), MemoryProbe(), Streamer(),
+      NumModuleFunctions(0), NumModuleInsts(0), FunctionFilter(),
+      ExternalWrappers(true), RecordFunctionStats(false), OptimizeNanoseconds(0),
+      ReleaseMCInsts(false) {
 
   // FIXME: now this can move to print, we don't need to keep it around
   if (EnableIRAnnotation)
@@ -196,42 +201,1204 @@ Module *DCTranslator::finalizeTranslationModule() {
       CurrentModule = new Module(
           (Twine("dct module #") + utohexstr(ModuleSet.size())).str(), Ctx));
   CurrentModule->setDataLayout(DL);
+  NumModuleFunctions = 0;
+  NumModuleInsts = 0;
 
-  CurrentFPM.reset(new legacy::FunctionPassManager(CurrentModule));
+  CurrentFPM = createFPM(CurrentModule);
 
-  if (OptLevel >= TransOpt::Less) {
-    CurrentFPM->add(new NonVolatileRegistersPass());
-    CurrentFPM->add(createInstructionCombiningPass());
-    CurrentFPM->add(createSROAPass());
-//    CurrentFPM->add(createCFGSimplificationPass());
-//    CurrentFPM->add(createConstantPropagationPass());
+  DIS.SwitchToModule(CurrentModule);
+  return OldModule;
+}
+
+static cl::opt<std::string> DCPasses(
+    "dc-passes",
+    cl::desc("The passes run on each translated function, in order, as a "
+             "comma separated list of: nvregs, sroa, stack-frames, mem2reg, "
+             "instcombine, early-cse, constprop, objc-arc, gvn, dse, dce "
+             "(default: those of the -O level)"),
+    cl::value_desc("passes"));
+
+static cl::opt<bool> DCStackFrames(
+    "dc-stack-frames",
+    cl::desc("Turn the accesses to the stack frame of the translated "
+             "functions into allocas, in the default passes"),
+    cl::init(false));
+
+static cl::opt<bool> DCOutlineCold(
+    "dc-outline-cold",
+    cl::desc("Outline the paths of the translated functions that end in "
+             "error reporting calls, e.g. objc_exception_throw or "
+             "__assert_rtn, once the function passes ran"),
+    cl::init(false));
+
+static cl::opt<unsigned> DCLargeFunctionInsts(
+    "dc-large-function-insts",
+    cl::desc("Only run the -dc-large-function-passes on the translated "
+             "functions of more than <n> machine instructions (default = 0, "
+             "no limit)"),
+    cl::value_desc("n"), cl::init(0));
+
+static cl::opt<std::string> DCLargeFunctionPasses(
+    "dc-large-function-passes",
+    cl::desc("The passes run on the functions above "
+             "-dc-large-function-insts, as with -dc-passes (default: sroa)"),
+    cl::value_desc("passes"), cl::init("sroa"));
+
+static cl::opt<bool> DCFlattenedAsLarge(
+    "dc-flattened-as-large",
+    cl::desc("Also only run the -dc-large-function-passes on the functions "
+             "whose control flow looks flattened by an obfuscator"),
+    cl::init(false));
+
+static cl::opt<double> DCFunctionBudget(
+    "dc-function-budget",
+    cl::desc("Stop translating a function after <seconds>: the blocks left "
+             "trap, and the function isn't optimized (default = 0, no "
+             "limit)"),
+    cl::value_desc("seconds"), cl::init(0));
+
+static cl::opt<bool> DCCacheUnoptimized(
+    "dc-cache-unoptimized",
+    cl::desc("Keep the translations in the -dc-cache before the function "
+             "passes, and only run those on the cached functions: changing "
+             "the passes, or the -O level, doesn't translate again"),
+    cl::init(false));
 
-//    CurrentFPM->add(createPromoteMemoryToRegisterPass());
+static cl::opt<bool> DCTimePasses(
+    "dc-time-passes",
+    cl::desc("Time each pass run on the translated functions, printed on "
+             "exit"),
+    cl::init(false));
+
+std::string DCTranslator::getFunctionPassPipeline(TransOpt::Level OptLevel) {
+  if (DCPasses.getNumOccurrences())
+    return DCPasses;
+  if (OptLevel == TransOpt::None)
+    return "";
+  // SROA runs first, so that the passes after it see SSA values rather than
+  // the register allocas: instcombine is much cheaper that way, and a single
+  // run of it is enough.
+  std::string Passes = "nvregs,sroa";
+  // The stack frames are recovered from the stack pointer deltas SROA leaves
+  // as SSA values; the frame alloca is split by a second SROA run.
+  if (DCStackFrames)
+    Passes += ",stack-frames,sroa";
+  if (OptLevel == TransOpt::Aggressive)
+    Passes += ",early-cse";
+  Passes += ",instcombine";
+  // The objects of the ARC runtime calls are only traced back to the calls
+  // that returned them once instcombine folded the register round trips.
+  if (DCInstrSema::translatesObjCARCCalls())
+    Passes += ",objc-arc";
+  if (OptLevel != TransOpt::Less)
+    Passes += ",dce";
+  return Passes;
+}
+
+namespace {
+/// \brief ObjCARCOpt, run on the functions of modules that call the ARC
+/// runtime. It only looks at the module in doInitialization, which pass
+/// managers run before anything is translated in the module: each function
+/// gets a pass manager of its own.
+class ObjCARCOptPass : public FunctionPass {
+public:
+  static char ID;
+
+  ObjCARCOptPass() : FunctionPass(ID) {}
+
+  const char *getPassName() const override { return "DC ObjC ARC Pass"; }
+
+  bool runOnFunction(Function &F) override {
+    Module &M = *F.getParent();
+    if (!objcarc::ModuleHasARC(M))
+      return false;
+    legacy::FunctionPassManager FPM(&M);
+    FPM.add(createBasicAliasAnalysisPass());
+    FPM.add(createObjCARCAliasAnalysisPass());
+    FPM.add(createObjCARCOptPass());
+    FPM.doInitialization();
+    bool Changed = FPM.run(F);
+    FPM.doFinalization();
+    return Changed;
   }
-  if (OptLevel >= TransOpt::Default)
-    CurrentFPM->add(createDeadCodeEliminationPass());
-  if (OptLevel >= TransOpt::Aggressive)
-    CurrentFPM->add(createInstructionCombiningPass());
+};
+} // end anonymous namespace
 
-  DIS.SwitchToModule(CurrentModule);
-  return OldModule;
+char ObjCARCOptPass::ID = 0;
+
+static FunctionPass *createFunctionPass(StringRef Name,
+                                        const DCRegisterSema &DRS) {
+  if (Name == "nvregs")
+    return new NonVolatileRegistersPass(DRS);
+  if (Name == "sroa")
+    return createSROAPass();
+  if (Name == "stack-frames")
+    return new DCStackFramePass(DRS);
+  if (Name == "objc-arc")
+    return new ObjCARCOptPass();
+  if (Name == "mem2reg")
+    return createPromoteMemoryToRegisterPass();
+  if (Name == "instcombine")
+    return createInstructionCombiningPass();
+  if (Name == "early-cse")
+    return createEarlyCSEPass();
+  if (Name == "constprop")
+    return createConstantPropagationPass();
+  if (Name == "gvn")
+    return createGVNPass();
+  if (Name == "dse")
+    return createDeadStoreEliminationPass();
+  if (Name == "dce")
+    return createDeadCodeEliminationPass();
+  report_fatal_error("DC: unknown pass '" + Name + "' in the pass pipeline");
+}
+
+static std::vector<std::string> getPassNames(TransOpt::Level OptLevel) {
+  std::string Pipeline = DCTranslator::getFunctionPassPipeline(OptLevel);
+  SmallVector<StringRef, 8> Names;
+  StringRef(Pipeline).split(Names, ",", -1, /*KeepEmpty=*/false);
+  std::vector<std::string> Trimmed;
+  for (StringRef Name : Names)
+    Trimmed.push_back(Name.trim());
+  return Trimmed;
+}
+
+// The translated accesses are tagged with their TBAA types, see
+// DCRegisterSema::tagMemoryAccesses: those answer most alias queries, in
+// constant time, without looking at the pointers.
+void DCTranslator::addAliasAnalyses(legacy::FunctionPassManager &FPM) {
+  FPM.add(createTypeBasedAliasAnalysisPass());
+  FPM.add(createScopedNoAliasAAPass());
+}
+
+// Run the -dc-large-function-passes on F, in a pass manager of its own: the
+// large functions are few, but their passes are the ones that take long.
+static void runLargeFunctionPasses(Function &F, const DCRegisterSema &DRS) {
+  legacy::FunctionPassManager FPM(F.getParent());
+  DCTranslator::addAliasAnalyses(FPM);
+  SmallVector<StringRef, 4> Names;
+  StringRef(DCLargeFunctionPasses).split(Names, ",", -1, /*KeepEmpty=*/false);
+  for (StringRef Name : Names)
+    FPM.add(createFunctionPass(Name.trim(), DRS));
+  FPM.doInitialization();
+  FPM.run(F);
+  FPM.doFinalization();
+}
+
+std::vector<std::unique_ptr<FunctionPass>>
+DCTranslator::createFunctionPasses(TransOpt::Level OptLevel,
+                                   const DCRegisterSema &DRS) {
+  std::vector<std::unique_ptr<FunctionPass>> Passes;
+  for (const std::string &Name : getPassNames(OptLevel))
+    Passes.emplace_back(createFunctionPass(Name, DRS));
+  return Passes;
+}
+
+namespace {
+/// \brief The time of each pass of all the function pass managers of the
+/// process, with -dc-time-passes, by pass name in pipeline order, printed
+/// once they are all destroyed, as the statistics are.
+struct PassTimeTotals {
+  struct Totals {
+    std::string Name;
+    uint64_t NumRuns;
+    double Seconds;
+  };
+  std::mutex Lock;
+  std::vector<Totals> ByPass;
+
+  ~PassTimeTotals();
+};
+
+/// \brief The last time one of the PassTimers of a pass manager ran.
+struct PassClock {
+  std::chrono::steady_clock::time_point Last;
+};
+
+/// \brief A pass that does nothing but time the passes before it, since the
+/// previous PassTimer of the same manager: with one after each pass, that is
+/// the time of each pass, including the analyses it asked for.
+/// The legacy -time-passes has a timer per pass instance, which is unusable
+/// with a manager per module and per thread; the timers add up per name.
+class PassTimer : public FunctionPass {
+  std::shared_ptr<PassClock> Clock;
+  // The name of the pass timed, or empty for the first timer, which only
+  // starts the clock.
+  std::string Name;
+  uint64_t NumRuns;
+  double Seconds;
+
+public:
+  static char ID;
+
+  PassTimer(std::shared_ptr<PassClock> Clock, StringRef Name)
+      : FunctionPass(ID), Clock(std::move(Clock)), Name(Name), NumRuns(0),
+        Seconds(0) {}
+  ~PassTimer() override;
+
+  const char *getPassName() const override { return "DC pass timer"; }
+
+  void getAnalysisUsage(AnalysisUsage &AU) const override {
+    AU.setPreservesAll();
+  }
+
+  bool runOnFunction(Function &F) override {
+    auto Now = std::chrono::steady_clock::now();
+    if (!Name.empty()) {
+      Seconds += std::chrono::duration<double>(Now - Clock->Last).count();
+      ++NumRuns;
+    }
+    // Don't count the time of the timer itself.
+    Clock->Last = std::chrono::steady_clock::now();
+    return false;
+  }
+};
+} // end anonymous namespace
+
+char PassTimer::ID = 0;
+
+static ManagedStatic<PassTimeTotals> PassTimes;
+
+namespace llvm { extern raw_ostream *CreateInfoOutputFile(); }
+
+PassTimer::~PassTimer() {
+  if (Name.empty() || !NumRuns)
+    return;
+  std::lock_guard<std::mutex> Lock(PassTimes->Lock);
+  auto &ByPass = PassTimes->ByPass;
+  auto I = std::find_if(ByPass.begin(), ByPass.end(),
+                        [&](const PassTimeTotals::Totals &T) {
+                          return T.Name == Name;
+                        });
+  if (I == ByPass.end()) {
+    ByPass.push_back(PassTimeTotals::Totals{Name, 0, 0});
+    I = std::prev(ByPass.end());
+  }
+  I->NumRuns += NumRuns;
+  I->Seconds += Seconds;
+}
+
+PassTimeTotals::~PassTimeTotals() {
+  if (ByPass.empty())
+    return;
+  double TotalSeconds = 0;
+  for (const Totals &T : ByPass)
+    TotalSeconds += T.Seconds;
+
+  raw_ostream &OS = *CreateInfoOutputFile();
+  OS << "===" << std::string(73, '-') << "===\n"
+     << "                ... DC function pass execution timing ...\n"
+     << "===" << std::string(73, '-') << "===\n"
+     << format("  Total: %.4f seconds\n\n", TotalSeconds)
+     << "    Seconds   Time%        Runs  Pass\n";
+  for (const Totals &T : ByPass)
+    OS << format("  %9.4f  %5.1f%%  %10llu  ", T.Seconds,
+                 TotalSeconds ? 100 * T.Seconds / TotalSeconds : 0.0,
+                 (unsigned long long)T.NumRuns)
+       << T.Name << "\n";
+  OS.flush();
+  delete &OS;
+}
+
+std::unique_ptr<legacy::FunctionPassManager>
+DCTranslator::createFPM(Module *M) const {
+  std::unique_ptr<legacy::FunctionPassManager> FPM(
+      new legacy::FunctionPassManager(M));
+  addAliasAnalyses(*FPM);
+  if (!DCTimePasses) {
+    for (auto &P : createFunctionPasses(OptLevel, DIS.getDRS()))
+      FPM->add(P.release());
+    return FPM;
+  }
+  // Interleave the passes with timers, by pass name.
+  std::shared_ptr<PassClock> Clock = std::make_shared<PassClock>();
+  FPM->add(new PassTimer(Clock, StringRef()));
+  for (const std::string &Name : getPassNames(OptLevel)) {
+    FPM->add(createFunctionPass(Name, DIS.getDRS()));
+    FPM->add(new PassTimer(Clock, Name));
+  }
+  return FPM;
+}
+
+void DCTranslator::addDoneFunction(const MCFunction &MCFN) {
+  uint64_t NumInsts = 0;
+  for (const MCBasicBlock *BB : MCFN)
+    NumInsts += BB->size();
+  TheProgress.NumInsts += NumInsts;
+  ++TheProgress.NumDoneFunctions;
+}
+
+void DCTranslator::releaseMCInsts(MCFunction &MCFN) {
+  if (ReleaseMCInsts && !AnnotWriter)
+    MCFN.releaseInsts();
+}
+
+static uint64_t countInstructions(const Function &F) {
+  uint64_t NumInsts = 0;
+  for (const BasicBlock &BB : F)
+    NumInsts += BB.size();
+  return NumInsts;
+}
+
+// Call \p Fn with each call of \p F tagged by setTagCallBasicBlocks, and the
+// address of its machine basic block.
+static void
+forEachTaggedCall(Function &F, unsigned MDKind,
+                  function_ref<void(Instruction &, uint64_t)> Fn) {
+  for (BasicBlock &BB : F)
+    for (Instruction &I : BB)
+      if (MDNode *Node = I.getMetadata(MDKind))
+        Fn(I, mdconst::extract<ConstantInt>(Node->getOperand(0))
+                  ->getZExtValue());
+}
+
+static void stripCallBBTags(Function &F, unsigned MDKind) {
+  forEachTaggedCall(F, MDKind, [&](Instruction &I, uint64_t) {
+    I.setMetadata(MDKind, nullptr);
+  });
+}
+
+bool DCTranslator::isCurrentModuleFull() const {
+  if (!Streamer || !NumModuleFunctions)
+    return false;
+  if ((StreamMaxFunctions && NumModuleFunctions >= StreamMaxFunctions) ||
+      (StreamMaxInsts && NumModuleInsts >= StreamMaxInsts))
+    return true;
+  if (!StreamMaxBytes)
+    return false;
+  const uint64_t Bytes = MemoryProbe();
+  return Bytes >= StreamMaxBytes && Bytes >= StreamMinBytes;
+}
+
+void DCTranslator::streamCurrentModule() {
+  // The module is still current: the registries of DIS describe it.
+  Streamer(*CurrentModule);
+  takeCurrentModule();
+  if (StreamMaxBytes)
+    StreamMinBytes = MemoryProbe() + StreamMaxBytes / 64;
+}
+
+std::unique_ptr<Module> DCTranslator::takeCurrentModule() {
+  for (const auto &AddrFn : DIS.getFunctions()) {
+    auto It = TranslatedFunctions.find(AddrFn.first);
+    if (It != TranslatedFunctions.end() && It->second.M == CurrentModule)
+      It->second = TranslatedFunction{nullptr, nullptr};
+  }
+  Module *Taken = finalizeTranslationModule();
+  auto It = std::find_if(
+      ModuleSet.begin(), ModuleSet.end(),
+      [&](const std::unique_ptr<Module> &M) { return M.get() == Taken; });
+  std::unique_ptr<Module> M = std::move(*It);
+  ModuleSet.erase(It);
+  return M;
+}
+
+void DCTranslator::setStubTargets(const DCStubTargets *Stubs) {
+  DIS.setStubTargets(Stubs);
+}
+
+void DCTranslator::setFunctionNames(const DCFunctionNameMap *Names) {
+  DIS.setFunctionNames(Names);
+}
+
+void DCTranslator::setDataSections(const DCDataSectionList *Sections) {
+  DIS.setDataSections(Sections);
+}
+
+void DCTranslator::setObjCMessageIndex(const DCObjCMessageIndex *Index) {
+  DIS.setObjCMessageIndex(Index);
+}
+
+void DCTranslator::setInlinedFunctions(const DenseSet<uint64_t> *Addrs) {
+  DIS.setInlinedFunctions(Addrs);
+}
+
+void DCTranslator::setCallSummaries(const DCCallSummaries *Summaries) {
+  DIS.setCallSummaries(Summaries);
+}
+
+void DCTranslator::setBlockProfile(const DCBlockProfile *Profile) {
+  DIS.setBlockProfile(Profile);
+}
+
+void DCTranslator::setCalleeSavedSpillAnalysis(const MCInstrAnalysis *MIA) {
+  DIS.setCalleeSavedSpillAnalysis(MIA);
+}
+
+void DCTranslator::setMemoryTransferAnalysis(const MCInstrAnalysis *MIA) {
+  DIS.setMemoryTransferAnalysis(MIA);
+}
+
+void DCTranslator::setConstantCallAnalysis(const MCInstrAnalysis *MIA) {
+  DIS.setConstantCallAnalysis(MIA);
+}
+
+bool DCTranslator::shouldTranslate(uint64_t Addr) const {
+  const DCStubTargets *Stubs = DIS.getStubTargets();
+  if (Stubs && Stubs->isStub(Addr))
+    return false;
+  return !FunctionFilter || FunctionFilter(Addr);
 }
 
 void DCTranslator::translateAllKnownFunctions() {
+  // The translation cache is only used by the workers, even for one job.
+  if (SemaFactory && !AnnotWriter &&
+      ((NumJobs > 1 && llvm_is_multithreaded()) || Cache ||
+       ProcessIsolation)) {
+    translateAllKnownFunctionsInParallel();
+    return;
+  }
+
+  TheProgress.NumFunctions =
+      std::count_if(MCM.func_begin(), MCM.func_end(),
+                    [&](const std::unique_ptr<MCFunction> &F) {
+                      return shouldTranslate(
+                          F->getEntryBlock()->getStartAddr());
+                    });
+
   MCObjectDisassembler::AddressSetTy DummyTailCallTargets;
   for (const auto &F : MCM.funcs()) {
-//      if (F->getName() != "fn_100ADE014")
-//          continue;
-    //  StringRef FAddress = F->getName().substr(3);
-    //  uint64_t address = 0;
-    //  FAddress.getAsInteger<uint64_t>(16, address);
-    //  if (address && address < 0x100BC2AE4) {
-    //      continue;
-    //  }
+      if (!shouldTranslate(F->getEntryBlock()->getStartAddr()))
+        continue;
+      if (isCurrentModuleFull())
+        streamCurrentModule();
       translateFunction(&*F, DummyTailCallTargets);
+      ++NumModuleFunctions;
+      if (Function *Fn = DIS.getFunctionAt(F->getEntryBlock()->getStartAddr()))
+        NumModuleInsts += countInstructions(*Fn);
+      releaseMCInsts(*F);
+  }
+}
+
+void DCTranslator::translateAllFunctionsFused() {
+  assert(MCOD && "Fused translation without a disassembler!");
+  assert(!AnnotWriter && "Fused translation releases the instructions!");
+  const MCFunctionRangeMap &Ranges = MCOD->getFunctionRanges();
+  TheProgress.NumFunctions =
+      std::count_if(Ranges.begin(), Ranges.end(), [&](uint64_t Addr) {
+        return MCOD->isWantedFunction(Addr) && shouldTranslate(Addr);
+      });
+
+  MCObjectDisassembler::AddressSetTy CallTargets, TailCallTargets;
+  for (uint64_t Addr : Ranges) {
+    if (!MCOD->isWantedFunction(Addr) || !shouldTranslate(Addr))
+      continue;
+    // The targets are only used to translate recursively.
+    CallTargets.clear();
+    TailCallTargets.clear();
+    MCFunction *MCFN =
+        MCOD->createFunction(&MCM, Addr, CallTargets, TailCallTargets);
+    if (MCFN->empty()) {
+      DIS.declareExternalFunction(Addr, MCFN->getName());
+      continue;
+    }
+    if (isCurrentModuleFull())
+      streamCurrentModule();
+    translateFunction(MCFN, TailCallTargets);
+    ++NumModuleFunctions;
+    if (Function *Fn = DIS.getFunctionAt(Addr))
+      NumModuleInsts += countInstructions(*Fn);
+    MCFN->releaseInsts();
   }
 }
 
+// Link the module of \p Unit, read back in \p Ctx, with \p L, and free its
+// bitcode.
+static void linkInUnit(Linker &L, DCTranslatedUnit &Unit, LLVMContext &Ctx) {
+  const SmallVectorImpl<char> &BC = Unit.Bitcode;
+  ErrorOr<std::unique_ptr<Module>> UnitOrErr = parseBitcodeFile(
+      MemoryBufferRef(StringRef(BC.data(), BC.size()), "dct shard"), Ctx);
+  if (std::error_code EC = UnitOrErr.getError())
+    report_fatal_error("DC: Unable to read back translated shard: " +
+                       EC.message());
+  if (L.linkInModule(UnitOrErr.get().get()))
+    report_fatal_error("DC: Unable to link translated shard");
+  // Free the bitcode as we go, the final module is big enough.
+  SmallVector<char, 0>().swap(Unit.Bitcode);
+}
+
+// The most functions translated into each shard module.
+// Shards are claimed by the workers one at a time, and linked in order: the
+// final module doesn't depend on the number of jobs.
+static const size_t FunctionsPerShard = 64;
+
+// Split the functions, of FuncBytes bytes each, into shards of consecutive
+// functions, of at most FunctionsPerShard functions, and of about the bytes
+// of an average shard: a function larger than that is alone in its shard, so
+// that the others don't wait for it. Return the first function of each
+// shard, then the number of functions.
+static std::vector<size_t> splitShards(ArrayRef<uint64_t> FuncBytes,
+                                       uint64_t TotalBytes) {
+  std::vector<size_t> Begins;
+  if (FuncBytes.empty())
+    return std::vector<size_t>(1, 0);
+  const uint64_t MaxBytes = std::max<uint64_t>(
+      TotalBytes * FunctionsPerShard / FuncBytes.size(), 1);
+  uint64_t Bytes = 0;
+  for (size_t I = 0, E = FuncBytes.size(); I != E; ++I) {
+    if (Begins.empty() || I - Begins.back() == FunctionsPerShard ||
+        (Bytes && Bytes + FuncBytes[I] > MaxBytes)) {
+      Begins.push_back(I);
+      Bytes = 0;
+    }
+    Bytes += FuncBytes[I];
+  }
+  Begins.push_back(FuncBytes.size());
+  return Begins;
+}
+
+// Return the order in which the workers claim the shards, of ShardBytes
+// bytes each: first those with more than a quarter of the share of a worker,
+// largest first, which would finish last if they were started in turn, then
+// the others, in the order they are linked. The first NumLarge are the large
+// ones: there are at most 4 * Jobs of them.
+static std::vector<size_t> getShardClaimOrder(ArrayRef<uint64_t> ShardBytes,
+                                              uint64_t TotalBytes,
+                                              unsigned Jobs,
+                                              size_t &NumLarge) {
+  std::vector<size_t> Order;
+  const uint64_t MinLargeBytes = TotalBytes / (4 * uint64_t(Jobs)) + 1;
+  for (size_t S = 0, E = ShardBytes.size(); S != E; ++S)
+    if (ShardBytes[S] >= MinLargeBytes)
+      Order.push_back(S);
+  // Stable, so that the order only depends on the sizes.
+  std::stable_sort(Order.begin(), Order.end(), [&](size_t L, size_t R) {
+    return ShardBytes[L] > ShardBytes[R];
+  });
+  NumLarge = Order.size();
+  for (size_t S = 0, E = ShardBytes.size(); S != E; ++S)
+    if (ShardBytes[S] < MinLargeBytes)
+      Order.push_back(S);
+  return Order;
+}
+
+#ifdef LLVM_ON_UNIX
+// Let a worker process die on crashes, without running the cleanups of its
+// parent, such as removing its output files.
+static void exitWorkerOnFatalError(void *, const std::string &Reason, bool) {
+  const std::string Message = "LLVM ERROR: " + Reason + "\n";
+  ssize_t Written = ::write(2, Message.data(), Message.size());
+  (void)Written;
+  _exit(1);
+}
+
+static void resetCrashHandlersInWorker() {
+  for (int Sig : {SIGILL, SIGTRAP, SIGABRT, SIGFPE, SIGBUS, SIGSEGV, SIGSYS})
+    ::signal(Sig, SIG_DFL);
+  remove_fatal_error_handler();
+  install_fatal_error_handler(exitWorkerOnFatalError, nullptr);
+}
+
+// Exit status of the worker processes that couldn't create their semantics.
+static const int FailedSemaExitCode = 2;
+
+namespace {
+/// \brief The functions [Begin, End) of a shard, as translated by a worker
+/// process.
+struct ShardRange {
+  size_t Shard, Begin, End;
+};
+} // end anonymous namespace
+#endif
+
+// Define \p F, whose translation crashed, as a trap.
+static void defineCrashedFunction(Function &F) {
+  BasicBlock *BB =
+      BasicBlock::Create(F.getContext(), "entry_" + F.getName(), &F);
+  IRBuilder<> Builder(BB);
+  Builder.CreateCall(Intrinsic::getDeclaration(F.getParent(), Intrinsic::trap));
+  Builder.CreateUnreachable();
+}
+
+// An MD5 hash of fields, for the translation cache key. Each field ends with
+// a NUL, so that different lists of fields can't hash the same.
+namespace {
+class FieldHasher {
+  MD5 Hash;
+
+public:
+  void add(StringRef Field) {
+    Hash.update(Field);
+    Hash.update(StringRef("", 1));
+  }
+  void add(uint64_t Field) { add(utohexstr(Field)); }
+  std::string final() {
+    MD5::MD5Result Result;
+    Hash.final(Result);
+    SmallString<32> Str;
+    MD5::stringifyResult(Result, Str);
+    return Str.str();
+  }
+};
+} // end anonymous namespace
+
+// Hash \p Stubs, which the translation of every call depends on.
+static std::string hashStubTargets(const DCStubTargets *Stubs) {
+  if (!Stubs || Stubs->empty())
+    return "none";
+  std::vector<std::pair<uint64_t, uint64_t>> Locals(Stubs->LocalAddrs.begin(),
+                                                    Stubs->LocalAddrs.end());
+  std::sort(Locals.begin(), Locals.end());
+  std::vector<std::pair<uint64_t, StringRef>> Externals;
+  for (const auto &KV : Stubs->ExternalNames)
+    Externals.push_back(std::make_pair(KV.first, StringRef(KV.second)));
+  std::sort(Externals.begin(), Externals.end());
+  std::vector<std::pair<uint64_t, uint64_t>> PointerLocals(
+      Stubs->PointerAddrs.begin(), Stubs->PointerAddrs.end());
+  std::sort(PointerLocals.begin(), PointerLocals.end());
+  std::vector<std::pair<uint64_t, StringRef>> PointerExternals;
+  for (const auto &KV : Stubs->PointerNames)
+    PointerExternals.push_back(std::make_pair(KV.first, StringRef(KV.second)));
+  std::sort(PointerExternals.begin(), PointerExternals.end());
+
+  FieldHasher H;
+  for (const auto &KV : Locals) {
+    H.add(KV.first);
+    H.add(KV.second);
+  }
+  H.add("externals");
+  for (const auto &KV : Externals) {
+    H.add(KV.first);
+    H.add(KV.second);
+  }
+  H.add("pointers");
+  for (const auto &KV : PointerLocals) {
+    H.add(KV.first);
+    H.add(KV.second);
+  }
+  for (const auto &KV : PointerExternals) {
+    H.add(KV.first);
+    H.add(KV.second);
+  }
+  return H.final();
+}
+
+// Hash \p Names, which the translation of every function and call depends on.
+static std::string hashFunctionNames(const DCFunctionNameMap *Names) {
+  if (!Names || Names->empty())
+    return "none";
+  std::vector<std::pair<uint64_t, StringRef>> Sorted;
+  for (const auto &KV : *Names)
+    Sorted.push_back(std::make_pair(KV.first, StringRef(KV.second)));
+  std::sort(Sorted.begin(), Sorted.end());
+
+  FieldHasher H;
+  for (const auto &KV : Sorted) {
+    H.add(KV.first);
+    H.add(KV.second);
+  }
+  return H.final();
+}
+
+// Hash \p Sections, which the translation of the addresses in them, and the
+// initializers of the strings, depend on.
+static std::string hashDataSections(const DCDataSectionList *Sections) {
+  if (!Sections || Sections->empty())
+    return "none";
+  FieldHasher H;
+  for (const DCDataSection &S : *Sections) {
+    H.add(S.Addr);
+    H.add(S.Size);
+    H.add(S.EntrySize);
+    H.add(S.Kind);
+    H.add(S.Contents);
+    H.add(S.Name);
+  }
+  return H.final();
+}
+
+// Hash the class methods of \p Index, and the references they are found
+// through, which the translation of the messages depends on.
+static std::string hashObjCMessageIndex(const DCObjCMessageIndex *Index) {
+  if (!Index || (Index->empty() && Index->SelectorRefs.empty() &&
+                 Index->ClassRefs.empty()))
+    return "none";
+  FieldHasher H;
+  for (const auto *Refs : {&Index->SelectorRefs, &Index->ClassRefs}) {
+    std::vector<std::pair<uint64_t, StringRef>> Sorted;
+    for (const auto &KV : *Refs)
+      Sorted.push_back(std::make_pair(KV.first, StringRef(KV.second)));
+    std::sort(Sorted.begin(), Sorted.end());
+    H.add("refs");
+    for (const auto &KV : Sorted) {
+      H.add(KV.first);
+      H.add(KV.second);
+    }
+  }
+  std::vector<std::pair<StringRef, uint64_t>> Methods;
+  for (const auto &KV : Index->ClassMethods)
+    Methods.push_back(std::make_pair(KV.getKey(), KV.getValue()));
+  std::sort(Methods.begin(), Methods.end());
+  H.add("methods");
+  for (const auto &KV : Methods) {
+    H.add(KV.first);
+    H.add(KV.second);
+  }
+  return H.final();
+}
+
+// Hash \p Addrs, which the attributes of the translated functions depend on.
+static std::string hashInlinedFunctions(const DenseSet<uint64_t> *Addrs) {
+  if (!Addrs || Addrs->empty())
+    return "none";
+  std::vector<uint64_t> Sorted(Addrs->begin(), Addrs->end());
+  std::sort(Sorted.begin(), Sorted.end());
+  FieldHasher H;
+  for (uint64_t Addr : Sorted)
+    H.add(Addr);
+  return H.final();
+}
+
+void DCTranslator::translateAllKnownFunctionsInParallel() {
+  std::vector<MCFunction *> Funcs;
+  for (const auto &F : MCM.funcs())
+    if (shouldTranslate(F->getEntryBlock()->getStartAddr()))
+      Funcs.push_back(&*F);
+  TheProgress.NumFunctions = Funcs.size();
+
+  // The cost of the translation of a function is estimated by its size, in
+  // bytes of machine code.
+  std::vector<uint64_t> FuncBytes(Funcs.size());
+  uint64_t TotalBytes = 0;
+  for (size_t I = 0, E = Funcs.size(); I != E; ++I) {
+    for (const MCBasicBlock *BB : *Funcs[I])
+      FuncBytes[I] += BB->getSizeInBytes();
+    TotalBytes += FuncBytes[I];
+  }
+  const std::vector<size_t> ShardBegins = splitShards(FuncBytes, TotalBytes);
+  const size_t NumShards = ShardBegins.size() - 1;
+  std::vector<uint64_t> ShardBytes(NumShards);
+  for (size_t S = 0; S != NumShards; ++S)
+    for (size_t I = ShardBegins[S]; I != ShardBegins[S + 1]; ++I)
+      ShardBytes[S] += FuncBytes[I];
+  size_t NumLargeShards;
+  const std::vector<size_t> ClaimOrder = getShardClaimOrder(
+      ShardBytes, TotalBytes,
+      llvm_is_multithreaded() || ProcessIsolation ? NumJobs : 1,
+      NumLargeShards);
+  // Each shard is translated as a single unit, or, with a translation cache,
+  // as one unit per function, each either read from the cache or added to it.
+  std::vector<std::vector<DCTranslatedUnit>> Shards(NumShards);
+  // The functions of each shard whose translation crashed a worker process.
+  std::vector<std::vector<uint64_t>> ShardCrashes(NumShards);
+  std::atomic<size_t> NextShard(0);
+  std::atomic<bool> FailedSema(false);
+  std::atomic<unsigned> NumCached(0);
+
+  // The unoptimized translations don't depend on the passes.
+  const bool CacheUnoptimized = Cache && DCCacheUnoptimized;
+  std::string Config;
+  if (Cache)
+    Config = CacheConfig + ",passes=" +
+             (CacheUnoptimized ? std::string("none")
+                               : getFunctionPassPipeline(OptLevel)) +
+             ",outline-cold=" +
+             (DCOutlineCold && !CacheUnoptimized ? "1" : "0") +
+             ",addrs=" + (DIS.getRecordAddresses() ? "1" : "0") + "," +
+             DCInstrSema::getTranslationOptions() + ",sema=" +
+             DIS.getSemanticsHash().str() + ",stubs=" +
+             hashStubTargets(DIS.getStubTargets()) + ",names=" +
+             hashFunctionNames(DIS.getFunctionNames()) + ",data=" +
+             hashDataSections(DIS.getDataSections()) + ",objc=" +
+             hashObjCMessageIndex(DIS.getObjCMessageIndex()) + ",inline=" +
+             hashInlinedFunctions(DIS.getInlinedFunctions()) + ",calls=" +
+             (DIS.getCallSummaries() ? DIS.getCallSummaries()->hash()
+                                     : std::string("none")) +
+             ",profile=" +
+             (DIS.getBlockProfile() ? DIS.getBlockProfile()->hash()
+                                    : std::string("none")) +
+             ",callee-saved=" +
+             (DIS.getCalleeSavedSpillAnalysis() ? "1" : "0") +
+             ",memory-transfers=" +
+             (DIS.getMemoryTransferAnalysis() ? "1" : "0") +
+             ",constant-calls=" +
+             (DIS.getConstantCallAnalysis() ? "1" : "0") +
+             ",objc-tags=" + (DIS.getTagObjCMessages() ? "1" : "0");
+  if (Cache && !CacheUnoptimized)
+    Config += ",large=" + utostr(DCLargeFunctionInsts) + ":" +
+              DCLargeFunctionPasses + ",flattened=" +
+              (DCFlattenedAsLarge ? "1" : "0");
+
+  // Translate the functions [I, E) of shard S with the semantics of a worker,
+  // appending the units to Units.
+  auto TranslateRange = [&](DCInstrSema &WorkerDIS, LLVMContext &WorkerCtx,
+                            size_t S, size_t I, size_t E,
+                            std::vector<DCTranslatedUnit> &Units) {
+    MCObjectDisassembler::AddressSetTy DummyTailCallTargets;
+    // Translate the functions [I, E) in a module of their own, into Out.
+    // Return false if any ran out of its budget.
+    auto TranslateUnit = [&](size_t I, size_t E, DCTranslatedUnit &Out) {
+      Module Unit((Twine("dct shard #") + utohexstr(S)).str(), WorkerCtx);
+      Unit.setDataLayout(DL);
+      std::unique_ptr<legacy::FunctionPassManager> FPM;
+      if (!CacheUnoptimized)
+        FPM = createFPM(&Unit);
+      WorkerDIS.SwitchToModule(&Unit);
+      bool Complete = true;
+      for (; I != E; ++I)
+        Complete &= translateFunction(Funcs[I], DummyTailCallTargets,
+                                      WorkerDIS, FPM.get(), nullptr);
+
+      // The call basic blocks are found by their tags once the unit is
+      // linked. Those outlined to cold functions, which aren't registered,
+      // are dropped.
+      unsigned CallBBMDKind = WorkerCtx.getMDKindID(DCCallBBMDKind);
+      for (Function &F : Unit) {
+        if (F.isDeclaration())
+          continue;
+        ++Out.NumFunctions;
+        Out.NumInsts += countInstructions(F);
+        uint64_t Addr;
+        bool HasCallBBs = false;
+        forEachTaggedCall(F, CallBBMDKind,
+                          [&](Instruction &, uint64_t) { HasCallBBs = true; });
+        if (!WorkerDIS.getFunctionAddress(&F, Addr))
+          stripCallBBTags(F, CallBBMDKind);
+        else if (HasCallBBs)
+          Out.CallBBFunctionAddrs.push_back(Addr);
+      }
+      for (const auto &KV : WorkerDIS.getFunctions())
+        Out.FunctionAddrs.push_back(KV.first);
+      for (const auto &KV : WorkerDIS.getUnknownInstCounts())
+        Out.UnknownInstCounts.push_back(
+            std::make_pair(KV.getKey().str(), KV.getValue()));
+      WorkerDIS.clearUnknownInstCounts();
+
+      raw_svector_ostream OS(Out.Bitcode);
+      WriteBitcodeToFile(&Unit, OS);
+      return Complete;
+    };
+
+    if (!Cache) {
+      Units.emplace_back();
+      TranslateUnit(I, E, Units.back());
+      return;
+    }
+    for (size_t FI = I; FI != E; ++FI) {
+      Units.emplace_back();
+      DCTranslatedUnit &Unit = Units.back();
+      // The key is the same whether the instructions were packed or not.
+      Funcs[FI]->unpackInsts();
+      const std::string Key = Cache->getKey(Config, *Funcs[FI]);
+      if (Cache->lookup(Key, Unit)) {
+        ++NumCached;
+        if (CacheUnoptimized)
+          optimizeUnit(*Funcs[FI],
+                       WorkerDIS.getFunctionName(
+                           Funcs[FI]->getEntryBlock()->getStartAddr()),
+                       Unit, WorkerCtx, WorkerDIS.getDRS());
+        addDoneFunction(*Funcs[FI]);
+        continue;
+      }
+      // What the budget cut short depends on the load: it isn't cached, nor
+      // optimized.
+      if (!TranslateUnit(FI, FI + 1, Unit))
+        continue;
+      if (std::error_code EC = Cache->store(Key, Unit))
+        DEBUG(dbgs() << "Unable to store translation of "
+                     << Funcs[FI]->getName() << ": " << EC.message()
+                     << "\n");
+      if (CacheUnoptimized)
+        optimizeUnit(*Funcs[FI],
+                     WorkerDIS.getFunctionName(
+                         Funcs[FI]->getEntryBlock()->getStartAddr()),
+                     Unit, WorkerCtx, WorkerDIS.getDRS());
+    }
+  };
+
+  auto CreateWorkerSema = [&](std::unique_ptr<DCRegisterSema> &WorkerDRS) {
+    std::unique_ptr<DCInstrSema> WorkerDIS = SemaFactory(WorkerDRS);
+    if (WorkerDIS) {
+      WorkerDIS->setRecordAddresses(DIS.getRecordAddresses());
+      WorkerDIS->setStubTargets(DIS.getStubTargets());
+      WorkerDIS->setFunctionNames(DIS.getFunctionNames());
+      WorkerDIS->setDataSections(DIS.getDataSections());
+      WorkerDIS->setObjCMessageIndex(DIS.getObjCMessageIndex());
+      WorkerDIS->setTagObjCMessages(DIS.getTagObjCMessages());
+      WorkerDIS->setTagCallBasicBlocks(true);
+      WorkerDIS->setInlinedFunctions(DIS.getInlinedFunctions());
+      WorkerDIS->setCallSummaries(DIS.getCallSummaries());
+      WorkerDIS->setBlockProfile(DIS.getBlockProfile());
+      WorkerDIS->setCalleeSavedSpillAnalysis(
+          DIS.getCalleeSavedSpillAnalysis());
+      WorkerDIS->setMemoryTransferAnalysis(DIS.getMemoryTransferAnalysis());
+      WorkerDIS->setConstantCallAnalysis(DIS.getConstantCallAnalysis());
+    }
+    return WorkerDIS;
+  };
+
+  // Linking can replace declarations by definitions: only look the functions
+  // of the shards up once all of those going in the current module are in.
+  size_t FirstUnregistered = 0;
+  auto RegisterShards = [&](size_t End) {
+    for (size_t S = FirstUnregistered; S != End; ++S) {
+      for (const DCTranslatedUnit &Unit : Shards[S]) {
+        for (uint64_t Addr : Unit.FunctionAddrs)
+          if (Function *F =
+                  CurrentModule->getFunction(DIS.getFunctionName(Addr)))
+            DIS.registerFunction(Addr, F);
+
+        // The calls of the call basic blocks are tagged with the address of
+        // their machine block, which bitcode, linking and the passes keep:
+        // register the blocks holding them, and drop the tags.
+        unsigned CallBBMDKind =
+            CurrentModule->getContext().getMDKindID(DCCallBBMDKind);
+        for (uint64_t Addr : Unit.CallBBFunctionAddrs) {
+          Function *F = DIS.getFunctionAt(Addr);
+          if (!F || F->isDeclaration()) {
+            DEBUG(dbgs() << "Call basic blocks of fn_" << utohexstr(Addr)
+                         << " weren't linked\n");
+            continue;
+          }
+          forEachTaggedCall(*F, CallBBMDKind,
+                            [&](Instruction &I, uint64_t BBAddr) {
+            DIS.registerCallBasicBlock(BBAddr, I.getParent());
+            I.setMetadata(CallBBMDKind, nullptr);
+          });
+        }
+      }
+    }
+    FirstUnregistered = End;
+  };
+
+  // Link the units of shard S into the current module, after streaming it
+  // out if it is full. The shards are linked in order.
+  std::unique_ptr<Linker> L;
+  auto LinkShard = [&](size_t S) {
+    if (isCurrentModuleFull()) {
+      RegisterShards(S);
+      streamCurrentModule();
+      L.reset();
+    }
+    // Declare the functions of the shard first: the linker then maps its
+    // regset type to the one of the current module, instead of adding its
+    // own, as it only considers types the current module already uses when
+    // it is created.
+    for (size_t I = ShardBegins[S], E = ShardBegins[S + 1]; I != E; ++I)
+      DIS.getFunction(Funcs[I]->getEntryBlock()->getStartAddr());
+    if (!L)
+      L.reset(new Linker(CurrentModule));
+    for (DCTranslatedUnit &Unit : Shards[S]) {
+      linkInUnit(*L, Unit, Ctx);
+      NumModuleFunctions += Unit.NumFunctions;
+      NumModuleInsts += Unit.NumInsts;
+      for (const auto &NameCount : Unit.UnknownInstCounts)
+        DIS.addUnknownInstCount(NameCount.first, NameCount.second);
+    }
+    for (uint64_t Addr : ShardCrashes[S]) {
+      Function *F = DIS.getFunction(Addr);
+      if (!F->isDeclaration())
+        continue;
+      defineCrashedFunction(*F);
+      ++NumModuleFunctions;
+    }
+    for (size_t I = ShardBegins[S], E = ShardBegins[S + 1]; I != E; ++I) {
+      recordTranslatedFunction(Funcs[I]->getEntryBlock()->getStartAddr());
+      releaseMCInsts(*Funcs[I]);
+    }
+  };
+
+#ifdef LLVM_ON_UNIX
+  if (ProcessIsolation) {
+    // Each child process translates a range of functions, and writes its
+    // units to a temporary file: the number of functions it found in the
+    // cache, as a little endian u32, then the units.
+    // The ranges of the processes that fail are split in halves, and
+    // translated again, until the function that crashes is alone.
+    std::vector<std::map<size_t, std::vector<DCTranslatedUnit>>> RangeUnits(
+        NumShards);
+    std::deque<ShardRange> Pending;
+    for (size_t S : ClaimOrder)
+      Pending.push_back({S, ShardBegins[S], ShardBegins[S + 1]});
+    std::map<pid_t, std::pair<ShardRange, std::string>> Children;
+
+    while (!Pending.empty() || !Children.empty()) {
+      while (!Pending.empty() && Children.size() < NumJobs) {
+        const ShardRange R = Pending.front();
+        Pending.pop_front();
+        int FD;
+        SmallString<128> Path;
+        if (std::error_code EC =
+                sys::fs::createTemporaryFile("dc-shard", "units", FD, Path))
+          report_fatal_error("DC: Unable to create a shard file: " +
+                             EC.message());
+        const pid_t Pid = ::fork();
+        if (Pid < 0)
+          report_fatal_error("DC: Unable to start a worker process");
+        if (Pid == 0) {
+          resetCrashHandlersInWorker();
+          LLVMContext WorkerCtx;
+          std::unique_ptr<DCRegisterSema> WorkerDRS;
+          std::unique_ptr<DCInstrSema> WorkerDIS = CreateWorkerSema(WorkerDRS);
+          if (!WorkerDIS)
+            _exit(FailedSemaExitCode);
+          std::vector<DCTranslatedUnit> Units;
+          const unsigned CachedBefore = NumCached;
+          TranslateRange(*WorkerDIS, WorkerCtx, R.Shard, R.Begin, R.End,
+                         Units);
+          raw_fd_ostream OS(FD, /*shouldClose=*/true);
+          support::endian::Writer<support::little>(OS).write<uint32_t>(
+              NumCached - CachedBefore);
+          for (const DCTranslatedUnit &Unit : Units)
+            Unit.write(OS);
+          OS.close();
+          // Don't run the destructors and exit handlers of the parent.
+          _exit(OS.has_error() ? 1 : 0);
+        }
+        ::close(FD);
+        Children[Pid] = std::make_pair(R, Path.str());
+      }
+
+      int Status;
+      const pid_t Pid = ::waitpid(-1, &Status, 0);
+      if (Pid < 0) {
+        if (errno == EINTR)
+          continue;
+        report_fatal_error("DC: Unable to wait for the worker processes");
+      }
+      auto It = Children.find(Pid);
+      if (It == Children.end())
+        continue;
+      const ShardRange R = It->second.first;
+      const std::string Path = It->second.second;
+      Children.erase(It);
+
+      if (WIFEXITED(Status) && WEXITSTATUS(Status) == FailedSemaExitCode) {
+        FailedSema = true;
+        sys::fs::remove(Path);
+        continue;
+      }
+      std::vector<DCTranslatedUnit> Units;
+      bool Succeeded = WIFEXITED(Status) && WEXITSTATUS(Status) == 0;
+      if (Succeeded) {
+        ErrorOr<std::unique_ptr<MemoryBuffer>> BufOrErr =
+            MemoryBuffer::getFile(Path, /*FileSize=*/-1,
+                                  /*RequiresNullTerminator=*/false);
+        StringRef Data;
+        if (BufOrErr)
+          Data = (*BufOrErr)->getBuffer();
+        Succeeded = Data.size() >= 4;
+        if (Succeeded) {
+          NumCached += support::endian::read32le(Data.data());
+          Data = Data.substr(4);
+        }
+        while (Succeeded && !Data.empty()) {
+          Units.emplace_back();
+          Succeeded = Units.back().read(Data);
+        }
+      }
+      sys::fs::remove(Path);
+
+      if (Succeeded) {
+        RangeUnits[R.Shard][R.Begin] = std::move(Units);
+        // The counters of the worker were its own.
+        for (size_t I = R.Begin; I != R.End; ++I)
+          addDoneFunction(*Funcs[I]);
+      } else if (R.End - R.Begin > 1) {
+        const size_t Mid = R.Begin + (R.End - R.Begin) / 2;
+        Pending.push_front({R.Shard, Mid, R.End});
+        Pending.push_front({R.Shard, R.Begin, Mid});
+      } else {
+        const uint64_t Addr = Funcs[R.Begin]->getEntryBlock()->getStartAddr();
+        DEBUG(dbgs() << "Translation of fn_" << utohexstr(Addr)
+                     << " crashed its worker\n");
+        ShardCrashes[R.Shard].push_back(Addr);
+        CrashedFunctions.push_back(Addr);
+        addDoneFunction(*Funcs[R.Begin]);
+      }
+    }
+
+    // The units of each shard go in function order.
+    for (size_t S = 0; S != NumShards; ++S) {
+      for (auto &BeginUnits : RangeUnits[S])
+        for (DCTranslatedUnit &Unit : BeginUnits.second)
+          Shards[S].push_back(std::move(Unit));
+      std::sort(ShardCrashes[S].begin(), ShardCrashes[S].end());
+    }
+    std::sort(CrashedFunctions.begin(), CrashedFunctions.end());
+    if (FailedSema)
+      report_fatal_error("DC: Unable to create the semantics of a worker");
+    for (size_t S = 0; S != NumShards; ++S)
+      LinkShard(S);
+  } else
+#endif
+  {
+    // The workers translate the shards while this thread links them, in
+    // order, and streams the full modules out: translating, linking, naming
+    // and writing overlap. The workers stay at most MaxShardsAhead shards
+    // ahead of the linking, so that the units waiting to be linked are
+    // bounded, rather than all there until the last shard is translated.
+    const unsigned Jobs = llvm_is_multithreaded() ? NumJobs : 1;
+    size_t MaxShardsAhead = 2 * size_t(Jobs);
+    std::mutex Lock;
+    std::condition_variable ShardTranslated, ShardLinked;
+    // Both guarded by Lock.
+    std::vector<bool> Translated(NumShards);
+    size_t NumLinked = 0;
+
+    auto Worker = [&]() {
+      LLVMContext WorkerCtx;
+      std::unique_ptr<DCRegisterSema> WorkerDRS;
+      std::unique_ptr<DCInstrSema> WorkerDIS = CreateWorkerSema(WorkerDRS);
+      if (!WorkerDIS) {
+        std::lock_guard<std::mutex> Guard(Lock);
+        FailedSema = true;
+        ShardTranslated.notify_all();
+        ShardLinked.notify_all();
+        return;
+      }
+      for (size_t C = NextShard++; C < NumShards; C = NextShard++) {
+        const size_t S = ClaimOrder[C];
+        // The large shards are few: they are translated ahead of the window.
+        {
+          std::unique_lock<std::mutex> Guard(Lock);
+          ShardLinked.wait(Guard, [&] {
+            return FailedSema || C < NumLargeShards ||
+                   S < NumLinked + MaxShardsAhead;
+          });
+          if (FailedSema)
+            return;
+        }
+        TranslateRange(*WorkerDIS, WorkerCtx, S, ShardBegins[S],
+                       ShardBegins[S + 1], Shards[S]);
+        std::lock_guard<std::mutex> Guard(Lock);
+        Translated[S] = true;
+        ShardTranslated.notify_all();
+      }
+    };
+
+    // Each worker keeps its context and semantics from shard to shard: it is
+    // a single task of the pool, rather than one task per shard.
+    const unsigned NumWorkers = std::min<size_t>(Jobs, NumShards);
+    ThreadPool Pool(NumWorkers);
+    // Without threads, the worker runs within async, before anything is
+    // linked.
+    if (!Pool.getNumThreads())
+      MaxShardsAhead = NumShards;
+    for (unsigned J = 0; J != NumWorkers; ++J)
+      Pool.async(Worker);
+    for (size_t S = 0; S != NumShards; ++S) {
+      {
+        std::unique_lock<std::mutex> Guard(Lock);
+        ShardTranslated.wait(Guard,
+                             [&] { return FailedSema || Translated[S]; });
+        if (FailedSema)
+          break;
+      }
+      LinkShard(S);
+      std::lock_guard<std::mutex> Guard(Lock);
+      NumLinked = S + 1;
+      ShardLinked.notify_all();
+    }
+    Pool.wait();
+    if (FailedSema)
+      report_fatal_error("DC: Unable to create the semantics of a worker");
+  }
+
+  NumCachedFunctions += NumCached;
+  RegisterShards(NumShards);
+}
+
 DCTranslator::~DCTranslator() {}
 
 Function *DCTranslator::getInitRegSetFunction() {
@@ -244,40 +1411,95 @@ Function *DCTranslator::createMainFunctionWrapper(Function *Entrypoint) {
   return DIS.getOrCreateMainFunction(Entrypoint);
 }
 
-Function *DCTranslator::translateRecursivelyAt(uint64_t Addr) {
+Function *DCTranslator::translateAt(uint64_t Addr, bool Recursive) {
   SmallSetVector<uint64_t, 16> WorkList;
   WorkList.insert(Addr);
   for (size_t i = 0; i < WorkList.size(); ++i) {
     uint64_t Addr = WorkList[i];
-    // FIXME: look up in other modules
-    Function *F = CurrentModule->getFunction("fn_" + utohexstr(Addr));
-    if (F && !F->isDeclaration())
+    // The functions translated in an earlier module are resolved by name,
+    // and callers already declared them, as are the external functions.
+    if (TranslatedFunctions.count(Addr) || DIS.isExternalFunction(Addr))
       continue;
 
     DEBUG(dbgs() << "Translating function at " << utohexstr(Addr) << "\n");
 
-    if (!MCOD) {
-      llvm_unreachable(("Unable to translate unknown function at " +
-                        utohexstr(Addr) + " without a disassembler!").c_str());
-    }
-
     MCObjectDisassembler::AddressSetTy CallTargets, TailCallTargets;
-    MCFunction *MCFN = MCOD->createFunction(&MCM, Addr, CallTargets, TailCallTargets);
+    MCFunction *MCFN;
+    if (MCOD) {
+      MCFN = MCOD->createFunction(&MCM, Addr, CallTargets, TailCallTargets);
+    } else {
+      // Without a disassembler, only the functions of the module can be
+      // translated.
+      MCFN = MCM.findFunctionAt(Addr);
+      if (!MCFN)
+        report_fatal_error("DC: unable to translate unknown function at 0x" +
+                           utohexstr(Addr) + " without a disassembler");
+    }
 
     // If the function is empty, it is the declaration of an external function.
     if (MCFN->empty()) {
       StringRef ExtFnName = MCFN->getName();
       assert(!ExtFnName.empty() && "Unnamed function declaration!");
       DEBUG(dbgs() << "Found external function: " << ExtFnName << "\n");
-      DIS.createExternalWrapperFunction(Addr, ExtFnName);
+      if (ExternalWrappers) {
+        DIS.createExternalWrapperFunction(Addr, ExtFnName);
+        recordTranslatedFunction(Addr);
+      } else {
+        DIS.declareExternalFunction(Addr, ExtFnName);
+      }
       continue;
     }
 
     translateFunction(MCFN, TailCallTargets);
+    if (!Recursive)
+      break;
     for (auto CallTarget : CallTargets)
       WorkList.insert(CallTarget);
+    // Without a disassembler, the callees are the functions of the module
+    // the translation declared.
+    if (!MCOD) {
+      SmallVector<std::pair<uint64_t, Function *>, 8> Callees;
+      getDeclaredFunctionsToTranslate(Callees);
+      for (const auto &AddrFn : Callees)
+        WorkList.insert(AddrFn.first);
+    }
   }
-  return CurrentModule->getFunction("fn_" + utohexstr(Addr));
+  return getOrDeclareFunctionAt(Addr);
+}
+
+bool DCTranslator::canTranslateAt(uint64_t Addr) {
+  return MCOD || TranslatedFunctions.count(Addr) ||
+         DIS.isExternalFunction(Addr) || MCM.findFunctionAt(Addr);
+}
+
+void DCTranslator::getDeclaredFunctionsToTranslate(
+    SmallVectorImpl<std::pair<uint64_t, Function *>> &Fns) {
+  // Without a disassembler, only the functions of the module can be
+  // translated.
+  for (const auto &AddrFn : DIS.getFunctions())
+    if (AddrFn.second->isDeclaration() &&
+        !TranslatedFunctions.count(AddrFn.first) &&
+        (MCOD || MCM.findFunctionAt(AddrFn.first)))
+      Fns.push_back(AddrFn);
+}
+
+Function *DCTranslator::translateOnDemand(Function *F) {
+  if (!F->isDeclaration())
+    return F;
+  uint64_t Addr;
+  if (F->getParent() != CurrentModule || !DIS.getFunctionAddress(F, Addr))
+    return nullptr;
+  MCFunction *MCFN = MCM.findFunctionAt(Addr);
+  if (!MCFN || MCFN->empty())
+    return nullptr;
+
+  DEBUG(dbgs() << "Translating function at " << utohexstr(Addr)
+               << " on demand\n");
+  MCObjectDisassembler::AddressSetTy DummyTailCallTargets;
+  translateFunction(MCFN, DummyTailCallTargets);
+  ++NumModuleFunctions;
+  NumModuleInsts += countInstructions(*F);
+  return F;
 }
 
 namespace {
@@ -295,65 +1517,258 @@ public:
 };
 } // end anonymous namespace
 
+// The entry address of the function being translated by each thread, plus
+// one, or 0: plain thread-local integers can be read from signal handlers.
+static LLVM_THREAD_LOCAL uint64_t FunctionInTranslation = 0;
+
+namespace {
+struct FunctionInTranslationRAII {
+  explicit FunctionInTranslationRAII(uint64_t Addr) {
+    FunctionInTranslation = Addr + 1;
+  }
+  ~FunctionInTranslationRAII() { FunctionInTranslation = 0; }
+};
+} // end anonymous namespace
+
+bool DCTranslator::getFunctionInTranslation(uint64_t &Addr) {
+  if (!FunctionInTranslation)
+    return false;
+  Addr = FunctionInTranslation - 1;
+  return true;
+}
+
 static bool BBBeginAddrLess(const MCBasicBlock *LHS, const MCBasicBlock *RHS) {
   return LHS->getStartAddr() < RHS->getStartAddr();
 }
 
-void DCTranslator::translateFunction(
-    MCFunction *MCFN,
-    const MCObjectDisassembler::AddressSetTy &TailCallTargets) {
+bool DCTranslator::translateFunction(
+    MCFunction *MCFN, const MCObjectDisassembler::AddressSetTy &TailCallTargets,
+    DCInstrSema &TheDIS, legacy::FunctionPassManager *FPM,
+    DCTranslatedInstTracker *Tracker) {
+  assert(!MCFN->areInstsReleased() &&
+         "Translating a function whose instructions were released!");
+  MCFN->unpackInsts();
 
   AddrPrettyStackTraceEntry X(MCFN->getEntryBlock()->getStartAddr(),
                               "Function");
-  getGlobalContext().setCurAdd(MCFN->getEntryBlock()->getStartAddr());
-  DIS.SwitchToFunction(MCFN);
+  FunctionInTranslationRAII InTranslation(
+      MCFN->getEntryBlock()->getStartAddr());
+  TraceScope Trace("translate", MCFN->getEntryBlock()->getStartAddr());
+  typedef std::chrono::steady_clock Clock;
+  const bool HasBudget = DCFunctionBudget > 0;
+  Clock::time_point Start;
+  size_t StartMalloc = 0;
+  if (RecordFunctionStats || HasBudget)
+    Start = Clock::now();
+  if (RecordFunctionStats)
+    StartMalloc = sys::Process::GetMallocUsage();
+  const Clock::time_point Deadline =
+      Start + std::chrono::duration_cast<Clock::duration>(
+                  std::chrono::duration<double>(DCFunctionBudget));
+
+  TheDIS.setCurrentAddress(MCFN->getEntryBlock()->getStartAddr());
+  TheDIS.SwitchToFunction(MCFN);
 
   // First, make sure all basic blocks are created, and sorted.
   std::vector<const MCBasicBlock *> BasicBlocks;
   std::copy(MCFN->begin(), MCFN->end(), std::back_inserter(BasicBlocks));
   std::sort(BasicBlocks.begin(), BasicBlocks.end(), BBBeginAddrLess);
   for (auto &BB : BasicBlocks){
-    getGlobalContext().setCurAdd(BB->getStartAddr());
-    DIS.getOrCreateBasicBlock(BB->getStartAddr());
+    TheDIS.setCurrentAddress(BB->getStartAddr());
+    TheDIS.getOrCreateBasicBlock(BB->getStartAddr());
   }
 
+  bool OverBudget = false;
+  size_t NumMCInsts = 0;
   for (auto &BB : *MCFN) {
+    NumMCInsts += BB->size();
+    // Past the budget, the blocks are left empty: they trap.
+    if (HasBudget && !OverBudget && Clock::now() > Deadline)
+      OverBudget = true;
+    if (OverBudget)
+      continue;
     AddrPrettyStackTraceEntry X(BB->getStartAddr(), "Basic Block");
-    getGlobalContext().setCurAdd(BB->getStartAddr());
+    TheDIS.setCurrentAddress(BB->getStartAddr());
     DEBUG(dbgs() << "Translating basic block starting at 0x"
                  << utohexstr(BB->getStartAddr()) << ", with " << BB->size()
                  << " instructions.\n");
-    DIS.SwitchToBasicBlock(BB);
+    TheDIS.SwitchToBasicBlock(BB);
     for (auto &I : *BB) {
-      getGlobalContext().setCurAdd(I.Address);
       //(dbgs() << "Translating instruction:\n " << I.Inst << " at 0x" << utohexstr(I.Address) << "\n");
-      DCTranslatedInst TI(I);
-      if (!DIS.translateInst(I, TI)) {
-        errs() << "Cannot translate instruction: \n  ";
-        errs() << I.Inst << "\n";
-        // llvm_unreachable("Couldn't translate instruction\n");
-      }
-      if (AnnotWriter)
-        DTIT.trackInst(TI);
+      // The values of the instructions are only recorded for the tracker.
+      Optional<DCTranslatedInst> TI;
+      if (Tracker)
+        TI.emplace(I);
+      // The instructions it can't translate are counted in the summary of
+      // the unknown ones: printing them here would interleave the output of
+      // the parallel workers.
+      if (!TheDIS.translateInst(I, TI ? TI.getPointer() : nullptr))
+        DEBUG(dbgs() << "Cannot translate instruction at 0x"
+                     << utohexstr(I.Address) << ": " << I.Inst << "\n");
+      if (Tracker)
+        Tracker->trackInst(*TI);
     }
-    DIS.FinalizeBasicBlock();
+    TheDIS.FinalizeBasicBlock();
   }
 
   for (auto TailCallTarget : TailCallTargets){
-    getGlobalContext().setCurAdd(TailCallTarget);
-    DIS.createExternalTailCallBB(TailCallTarget);
+    TheDIS.setCurrentAddress(TailCallTarget);
+    TheDIS.createExternalTailCallBB(TailCallTarget);
+  }
+
+  Function *Fn = TheDIS.FinalizeFunction();
+  const Clock::time_point Optimize = Clock::now();
+  if (OverBudget) {
+    std::lock_guard<std::mutex> Lock(OverBudgetMutex);
+    OverBudgetFunctions.push_back(MCFN->getEntryBlock()->getStartAddr());
+  } else if (FPM) {
+    optimizeFunction(*MCFN, *Fn, TheDIS.getDRS(), *FPM);
+  }
+  const Clock::time_point End = Clock::now();
+
+  if (RecordFunctionStats) {
+    std::chrono::duration<double> Translate = Optimize - Start;
+    std::chrono::duration<double> Opt = End - Optimize;
+    FunctionStats FS = {MCFN->getEntryBlock()->getStartAddr(),
+                        Translate.count(), Opt.count(),
+                        countInstructions(*Fn),
+                        int64_t(sys::Process::GetMallocUsage()) -
+                            int64_t(StartMalloc)};
+    std::lock_guard<std::mutex> Lock(FunctionStatsMutex);
+    FuncStats.push_back(FS);
   }
+  addDoneFunction(*MCFN);
+  return !OverBudget;
+}
 
-  Function *Fn = DIS.FinalizeFunction();
+void DCTranslator::optimizeFunction(const MCFunction &MCFN, Function &Fn,
+                                    const DCRegisterSema &DRS,
+                                    legacy::FunctionPassManager &FPM) {
+  typedef std::chrono::steady_clock Clock;
+  const Clock::time_point Start = Clock::now();
+  // The flattened functions are one big loop around a switch: most passes
+  // are costly on them, and do little.
+  uint64_t NumMCInsts = 0;
+  for (const MCBasicBlock *BB : MCFN)
+    NumMCInsts += BB->size();
+  bool IsLarge = DCLargeFunctionInsts && NumMCInsts > DCLargeFunctionInsts;
+  if (!IsLarge && DCFlattenedAsLarge) {
+    MCFlattenedCFG Flat;
+    if (Flat.analyze(MCFN, DRS.MII)) {
+      IsLarge = true;
+      std::lock_guard<std::mutex> Lock(OverBudgetMutex);
+      FlattenedFunctions.push_back(MCFN.getEntryBlock()->getStartAddr());
+    }
+  }
   {
-    // ValueToValueMapTy VMap;
-    // Function *OrigFn = CloneFunction(Fn, VMap, false);
-    // OrigFn->setName(Fn->getName() + "_orig");
-    // CurrentModule->getFunctionList().push_back(OrigFn);
-    CurrentFPM->run(*Fn);
+    TraceScope FPMTrace("fpm", MCFN.getEntryBlock()->getStartAddr());
+    if (IsLarge)
+      runLargeFunctionPasses(Fn, DRS);
+    else
+      FPM.run(Fn);
   }
+  // This adds functions to the module, which the function passes can't.
+  if (DCOutlineCold)
+    outlineColdPaths(Fn);
+  OptimizeNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             Clock::now() - Start).count();
+}
+
+void DCTranslator::optimizeUnit(const MCFunction &MCFN, StringRef Name,
+                                DCTranslatedUnit &Unit, LLVMContext &Ctx,
+                                const DCRegisterSema &DRS) {
+  const SmallVectorImpl<char> &BC = Unit.Bitcode;
+  ErrorOr<std::unique_ptr<Module>> ModOrErr = parseBitcodeFile(
+      MemoryBufferRef(StringRef(BC.data(), BC.size()), "dct shard"), Ctx);
+  if (std::error_code EC = ModOrErr.getError())
+    report_fatal_error("DC: Unable to read back unoptimized translation: " +
+                       EC.message());
+  Module &M = **ModOrErr;
+  Function *Fn = M.getFunction(Name);
+  if (!Fn || Fn->isDeclaration())
+    return;
+
+  // The passes keep the tags of the call basic blocks, but those outlined
+  // with -dc-outline-cold go to functions that aren't registered: drop their
+  // tags.
+  SmallPtrSet<const Function *, 8> Defined;
+  for (const Function &F : M)
+    if (!F.isDeclaration())
+      Defined.insert(&F);
+
+  std::unique_ptr<legacy::FunctionPassManager> FPM = createFPM(&M);
+  optimizeFunction(MCFN, *Fn, DRS, *FPM);
+
+  unsigned CallBBMDKind = Ctx.getMDKindID(DCCallBBMDKind);
+  for (Function &F : M)
+    if (!F.isDeclaration() && !Defined.count(&F))
+      stripCallBBTags(F, CallBBMDKind);
+
+  Unit.NumInsts = 0;
+  for (const Function &F : M)
+    if (!F.isDeclaration())
+      Unit.NumInsts += countInstructions(F);
+  Unit.Bitcode.clear();
+  raw_svector_ostream OS(Unit.Bitcode);
+  WriteBitcodeToFile(&M, OS);
+}
+
+std::vector<uint64_t> DCTranslator::getOverBudgetFunctions() const {
+  std::lock_guard<std::mutex> Lock(OverBudgetMutex);
+  std::vector<uint64_t> Addrs = OverBudgetFunctions;
+  std::sort(Addrs.begin(), Addrs.end());
+  return Addrs;
+}
+
+std::vector<uint64_t> DCTranslator::getFlattenedFunctions() const {
+  std::lock_guard<std::mutex> Lock(OverBudgetMutex);
+  std::vector<uint64_t> Addrs = FlattenedFunctions;
+  std::sort(Addrs.begin(), Addrs.end());
+  return Addrs;
 }
 
 void DCTranslator::printCurrentModule(raw_ostream &OS) {
+  if (AnnotWriter)
+    DTIT.finalize();
   CurrentModule->print(OS, AnnotWriter.get());
 }
+
+Function *DCTranslator::getFunctionAt(uint64_t Addr) const {
+  return DIS.getFunctionAt(Addr);
+}
+
+Function *DCTranslator::getOrDeclareFunctionAt(uint64_t Addr) {
+  return DIS.getFunction(Addr);
+}
+
+void DCTranslator::createThunkFunction(uint64_t Addr, uint64_t TargetAddr) {
+  DIS.createThunkFunction(Addr, TargetAddr);
+  recordTranslatedFunction(Addr);
+}
+
+void DCTranslator::createObjCAccessorFunction(uint64_t Addr,
+                                              const DCObjCAccessor &A) {
+  DIS.createObjCAccessorFunction(Addr, A);
+  recordTranslatedFunction(Addr);
+}
+
+const DCTranslator::TranslatedFunction *
+DCTranslator::getTranslatedFunctionAt(uint64_t Addr) const {
+  auto It = TranslatedFunctions.find(Addr);
+  return It == TranslatedFunctions.end() ? nullptr : &It->second;
+}
+
+void DCTranslator::recordTranslatedFunction(uint64_t Addr) {
+  Function *F = DIS.getFunctionAt(Addr);
+  if (F && !F->isDeclaration())
+    TranslatedFunctions[Addr] = TranslatedFunction{CurrentModule, F};
+}
+
+const DenseMap<uint64_t, Function *> &DCTranslator::getFunctions() const {
+  return DIS.getFunctions();
+}
+
+const std::vector<std::pair<uint64_t, BasicBlock *>> &
+DCTranslator::getCallBasicBlocks() const {
+  return DIS.getCallBasicBlocks();
+}
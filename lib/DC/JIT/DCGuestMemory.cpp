@@ -0,0 +1,112 @@
+//===-- DCGuestMemory.cpp - Memory of translated code ---------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/DC/DCGuestMemory.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Object/MachO.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/mman.h>
+#include <vector>
+
+using namespace llvm;
+using namespace object;
+
+#define DEBUG_TYPE "dc-guest-memory"
+
+namespace {
+struct Segment {
+  uint64_t VMAddr, VMSize, FileOff, FileSize;
+};
+}
+
+static void collectSegments(const MachOObjectFile &MachO,
+                            std::vector<Segment> &Segments) {
+  for (const auto &Load : MachO.load_commands()) {
+    Segment Seg;
+    StringRef Name;
+    if (Load.C.cmd == MachO::LC_SEGMENT_64) {
+      MachO::segment_command_64 SC = MachO.getSegment64LoadCommand(Load);
+      Seg = {SC.vmaddr, SC.vmsize, SC.fileoff, SC.filesize};
+      Name = StringRef(SC.segname, strnlen(SC.segname, sizeof(SC.segname)));
+    } else if (Load.C.cmd == MachO::LC_SEGMENT) {
+      MachO::segment_command SC = MachO.getSegmentLoadCommand(Load);
+      Seg = {SC.vmaddr, SC.vmsize, SC.fileoff, SC.filesize};
+      Name = StringRef(SC.segname, strnlen(SC.segname, sizeof(SC.segname)));
+    } else {
+      continue;
+    }
+    if (Seg.VMSize && Name != "__PAGEZERO")
+      Segments.push_back(Seg);
+  }
+}
+
+// Map Size bytes at Addr, or anywhere if Addr is 0. With Exact, fail rather
+// than map them elsewhere.
+static void *mapRegion(uint64_t Addr, size_t Size, bool Exact) {
+  void *Hint = reinterpret_cast<void *>(uintptr_t(Addr));
+  void *P = ::mmap(Hint, Size, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (P == MAP_FAILED)
+    return nullptr;
+  if (Exact && P != Hint) {
+    ::munmap(P, Size);
+    return nullptr;
+  }
+  return P;
+}
+
+DCGuestMemory::~DCGuestMemory() {
+  if (Region)
+    ::munmap(Region, RegionSize);
+}
+
+std::error_code DCGuestMemory::map(const MachOObjectFile &MachO,
+                                   uint64_t HostAddr) {
+  std::vector<Segment> Segments;
+  collectSegments(MachO, Segments);
+  if (Segments.empty())
+    return object_error::parse_failed;
+  const StringRef Data = MachO.getData();
+  uint64_t Begin = UINT64_MAX, End = 0;
+  for (const Segment &Seg : Segments) {
+    if (Seg.FileOff + Seg.FileSize > Data.size())
+      return object_error::parse_failed;
+    Begin = std::min(Begin, Seg.VMAddr);
+    End = std::max(End, Seg.VMAddr + Seg.VMSize);
+  }
+  const uint64_t PageSize = sys::Process::getPageSize();
+  Begin &= ~(PageSize - 1);
+  End = (End + PageSize - 1) & ~(PageSize - 1);
+
+  if (Region)
+    ::munmap(Region, RegionSize);
+  RegionSize = End - Begin;
+  if (HostAddr)
+    Region = mapRegion(HostAddr, RegionSize, /*Exact=*/true);
+  else if (!(Region = mapRegion(Begin, RegionSize, /*Exact=*/true)))
+    Region = mapRegion(0, RegionSize, /*Exact=*/false);
+  if (!Region) {
+    RegionSize = 0;
+    Base = 0;
+    return std::error_code(ENOMEM, std::generic_category());
+  }
+  Base = uint64_t(uintptr_t(Region)) - Begin;
+  DEBUG(dbgs() << "Guest memory at 0x" << utohexstr(uintptr_t(Region))
+               << ", base 0x" << utohexstr(Base) << "\n");
+
+  for (const Segment &Seg : Segments)
+    std::memcpy(getHostAddress(Seg.VMAddr), Data.data() + Seg.FileOff,
+                std::min(Seg.FileSize, Seg.VMSize));
+  return std::error_code();
+}
@@ -0,0 +1,362 @@
+//===-- DCJIT.cpp - Run translated code -----------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/DC/DCJIT.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/Triple.h"
+#include "llvm/DC/DCInstrSema.h"
+#include "llvm/DC/DCTranslator.h"
+#include "llvm/ExecutionEngine/Orc/CompileUtils.h"
+#include "llvm/ExecutionEngine/Orc/IRCompileLayer.h"
+#include "llvm/ExecutionEngine/Orc/IndirectionUtils.h"
+#include "llvm/ExecutionEngine/Orc/LambdaResolver.h"
+#include "llvm/ExecutionEngine/Orc/LazyEmittingLayer.h"
+#include "llvm/ExecutionEngine/Orc/ObjectLinkingLayer.h"
+#include "llvm/ExecutionEngine/Orc/OrcTargetSupport.h"
+#include "llvm/ExecutionEngine/SectionMemoryManager.h"
+#include "llvm/IR/Mangler.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/DynamicLibrary.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetMachine.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace llvm;
+using namespace orc;
+
+#define DEBUG_TYPE "dc-jit"
+
+namespace {
+/// \brief Forward the objects the JIT loads to a DCJIT::ObjectLoadedFnTy.
+struct NotifyObjectLoaded {
+  DCJIT::ObjectLoadedFnTy ObjectLoaded;
+
+  template <typename ObjSetT, typename LoadResult>
+  void operator()(ObjectLinkingLayerBase::ObjSetHandleT,
+                  const ObjSetT &Objects, const LoadResult &Infos) {
+    if (!ObjectLoaded)
+      return;
+    for (size_t I = 0, E = Objects.size(); I != E; ++I)
+      ObjectLoaded(*Objects[I], *Infos[I]);
+  }
+};
+} // end anonymous namespace
+
+static void lazyTranslationFailed() {
+  report_fatal_error("DC: unable to translate a function lazily");
+}
+
+/// \brief The ORC layers: the modules are compiled when one of their symbols
+/// is first looked up.
+class DCJIT::JITStack {
+  typedef ObjectLinkingLayer<NotifyObjectLoaded> ObjLayerT;
+  typedef IRCompileLayer<ObjLayerT> CompileLayerT;
+  typedef LazyEmittingLayer<CompileLayerT> LazyEmitLayerT;
+  typedef JITCompileCallbackManager<CompileLayerT, OrcX86_64>
+      CallbackManagerT;
+
+  const DataLayout DL;
+  /// The modules the JIT created, rather than the translator: the stubs.
+  std::vector<std::unique_ptr<Module>> OwnedModules;
+  ObjLayerT ObjectLayer;
+  CompileLayerT CompileLayer;
+  LazyEmitLayerT LazyEmitLayer;
+  /// The compile callbacks of the lazy functions, created with the first.
+  SectionMemoryManager CallbackMemMgr;
+  std::unique_ptr<CallbackManagerT> CallbackMgr;
+
+public:
+  typedef LazyEmitLayerT::ModuleSetHandleT ModuleHandleT;
+
+  JITStack(TargetMachine &TM, ObjectLoadedFnTy ObjectLoaded)
+      : DL(TM.createDataLayout()),
+        ObjectLayer(NotifyObjectLoaded{std::move(ObjectLoaded)}),
+        CompileLayer(ObjectLayer, SimpleCompiler(TM)),
+        LazyEmitLayer(CompileLayer) {}
+
+  /// \brief Whether the host supports the compile callbacks.
+  static bool supportsCompileCallbacks() {
+    return Triple(sys::getProcessTriple()).getArch() == Triple::x86_64;
+  }
+
+  /// \brief Get a compile callback, which runs \p Compile, and goes to the
+  /// address it returns.
+  TargetAddress getCompileCallback(LLVMContext &Ctx,
+                                   JITCompileCallbackManagerBase::CompileFtor
+                                       Compile) {
+    if (!CallbackMgr)
+      CallbackMgr.reset(new CallbackManagerT(
+          CompileLayer, CallbackMemMgr, Ctx,
+          reinterpret_cast<uintptr_t>(&lazyTranslationFailed),
+          /*NumTrampolinesPerBlock=*/64));
+    auto CCI = CallbackMgr->getCompileCallback(Ctx);
+    CCI.setCompileAction(std::move(Compile));
+    return CCI.getAddress();
+  }
+
+  ModuleHandleT addModule(Module *M) {
+    DEBUG(M->dump());
+    // Resolve the symbols in the modules added so far, then in the runtime,
+    // then in the process.
+    auto Resolver = createLambdaResolver(
+        [this](const std::string &Name) {
+          if (auto Sym = LazyEmitLayer.findSymbol(Name, false))
+            return RuntimeDyld::SymbolInfo(Sym.getAddress(), Sym.getFlags());
+          if (auto Addr = findRuntimeSymbol(Name))
+            return RuntimeDyld::SymbolInfo(Addr, JITSymbolFlags::Exported);
+          if (auto Addr = RTDyldMemoryManager::getSymbolAddressInProcess(Name))
+            return RuntimeDyld::SymbolInfo(Addr, JITSymbolFlags::Exported);
+          return RuntimeDyld::SymbolInfo(nullptr);
+        },
+        [](const std::string &) { return nullptr; });
+    std::vector<Module *> Ms(1, M);
+    return LazyEmitLayer.addModuleSet(std::move(Ms),
+                                      make_unique<SectionMemoryManager>(),
+                                      std::move(Resolver));
+  }
+
+  /// \brief Get the address of the runtime symbol \p MangledName, used by
+  /// the translated code, or 0.
+  uint64_t findRuntimeSymbol(StringRef MangledName) {
+    StringRef Name = MangledName;
+    // The bounds of the Mach-O sections have no prefix.
+    if (Name.startswith("section$"))
+      return DCInstrSema::getRuntimeSymbolAddress(Name);
+    if (char Prefix = DL.getGlobalPrefix()) {
+      if (Name.empty() || Name.front() != Prefix)
+        return 0;
+      Name = Name.drop_front();
+    }
+    if (Name == "__llvm_dc_translate_at")
+      return reinterpret_cast<uintptr_t>(&DCJIT::translateAt);
+    if (Name == "__llvm_dc_objc_cache_miss")
+      return reinterpret_cast<uintptr_t>(&DCJIT::objcCacheMiss);
+    return DCInstrSema::getRuntimeSymbolAddress(Name);
+  }
+
+  /// \brief Register the edge coverage counters of \p M, added as \p H, and
+  /// their table, with the libFuzzer of the process, if any, as the
+  /// constructor of the module, which isn't run, would.
+  void registerEdgeCoverage(ModuleHandleT H, const Module &M) {
+    // The counters of the module are contiguous in their section, the table
+    // too, in the same order.
+    uint64_t Counters = 0, CountersEnd = 0, PCs = 0, PCsEnd = 0;
+    for (const GlobalVariable &GV : M.globals()) {
+      StringRef Name = GV.getName();
+      if (!Name.startswith(DCInstrSema::EdgeCountersPrefix))
+        continue;
+      std::string PCsName =
+          (DCInstrSema::EdgePCsPrefix +
+           Name.substr(strlen(DCInstrSema::EdgeCountersPrefix)))
+              .str();
+      uint64_t NumEdges =
+          cast<ArrayType>(GV.getType()->getElementType())->getNumElements();
+      uint64_t Addr = LazyEmitLayer.findSymbolIn(H, mangle(Name), false)
+                          .getAddress();
+      uint64_t PCsAddr = LazyEmitLayer.findSymbolIn(H, mangle(PCsName), false)
+                             .getAddress();
+      if (!Addr || !PCsAddr)
+        continue;
+      if (!Counters || Addr < Counters)
+        Counters = Addr;
+      CountersEnd = std::max(CountersEnd, Addr + NumEdges);
+      if (!PCs || PCsAddr < PCs)
+        PCs = PCsAddr;
+      PCsEnd = std::max(PCsEnd, PCsAddr + NumEdges * 2 * sizeof(uint64_t));
+    }
+    if (!Counters)
+      return;
+    typedef void InitFnTy(const void *, const void *);
+    auto *InitCounters = reinterpret_cast<InitFnTy *>(
+        DCInstrSema::getRuntimeSymbolAddress(
+            "__sanitizer_cov_8bit_counters_init"));
+    auto *InitPCs = reinterpret_cast<InitFnTy *>(
+        DCInstrSema::getRuntimeSymbolAddress("__sanitizer_cov_pcs_init"));
+    InitCounters(reinterpret_cast<void *>(Counters),
+                 reinterpret_cast<void *>(CountersEnd));
+    InitPCs(reinterpret_cast<void *>(PCs), reinterpret_cast<void *>(PCsEnd));
+  }
+
+  ModuleHandleT addOwnedModule(std::unique_ptr<Module> M) {
+    M->setDataLayout(DL);
+    OwnedModules.push_back(std::move(M));
+    return addModule(OwnedModules.back().get());
+  }
+
+  std::string mangle(StringRef Name) {
+    std::string MangledName;
+    {
+      raw_string_ostream MangledNameStream(MangledName);
+      Mangler::getNameWithPrefix(MangledNameStream, Name, DL);
+    }
+    return MangledName;
+  }
+
+  uint64_t getSymbolAddress(StringRef Name, bool ExportedSymbolsOnly = true) {
+    return LazyEmitLayer.findSymbol(mangle(Name), ExportedSymbolsOnly)
+        .getAddress();
+  }
+
+  uint64_t getSymbolAddressIn(ModuleHandleT H, StringRef Name) {
+    return LazyEmitLayer.findSymbolIn(H, mangle(Name), true).getAddress();
+  }
+};
+
+/// The DCJIT the translate-at callback goes to.
+static DCJIT *CurrentJIT;
+
+DCJIT::DCJIT(DCTranslator &DT, TargetMachine &TM,
+             ObjectLoadedFnTy ObjectLoaded, bool Lazy)
+    : DT(DT), Stack(new JITStack(TM, std::move(ObjectLoaded))),
+      Lazy(Lazy && JITStack::supportsCompileCallbacks()), EntryPoints(),
+      StubPointers(), NumLookups(0), NumTranslations(0),
+      NumObjCCacheFills(0) {
+  assert(!CurrentJIT && "Only one DCJIT can run at a time!");
+  CurrentJIT = this;
+  // The symbols of the process, e.g. libFuzzer's, are found by the
+  // translations, and by the runtime.
+  sys::DynamicLibrary::LoadLibraryPermanently(nullptr);
+}
+
+DCJIT::~DCJIT() { CurrentJIT = nullptr; }
+
+void *DCJIT::translateAt(void *Addr) {
+  return CurrentJIT->getTranslatedAt(reinterpret_cast<uintptr_t>(Addr));
+}
+
+void *DCJIT::objcCacheMiss(void *Cache, uint64_t Isa, void *Receiver,
+                           void *Selector) {
+  return CurrentJIT->getObjCMethodTranslation(
+      *static_cast<DCObjCMessageCache *>(Cache), Isa, Receiver, Selector);
+}
+
+void *DCJIT::getObjCMethodTranslation(DCObjCMessageCache &Cache, uint64_t Isa,
+                                      void *Receiver, void *Selector) {
+  // The Objective-C runtime of the process, if any, finds the method.
+  typedef void *GetClassFnTy(void *);
+  typedef void *GetMethodFnTy(void *, void *);
+  static auto *GetClass = reinterpret_cast<GetClassFnTy *>(
+      sys::DynamicLibrary::SearchForAddressOfSymbol("object_getClass"));
+  static auto *GetMethod = reinterpret_cast<GetMethodFnTy *>(
+      sys::DynamicLibrary::SearchForAddressOfSymbol(
+          "class_getMethodImplementation"));
+  if (!Isa || !GetClass || !GetMethod)
+    return nullptr;
+  uint64_t Addr =
+      reinterpret_cast<uintptr_t>(GetMethod(GetClass(Receiver), Selector));
+  // The forwarding, and the methods of other images, are left to the
+  // runtime, unless the translator can disassemble any code.
+  if (!Addr || !DT.canTranslateAt(Addr))
+    return nullptr;
+  void *Entry = getTranslatedAt(Addr);
+  // The cache is only filled once: the entry is set before the isa that
+  // makes it valid, and stays valid.
+  if (!Cache.Isa) {
+    ++NumObjCCacheFills;
+    Cache.Entry = Entry;
+    Cache.Isa = Isa;
+  }
+  return Entry;
+}
+
+void *DCJIT::getTranslatedAt(uint64_t Addr) {
+  ++NumLookups;
+  auto It = EntryPoints.find(Addr);
+  if (It != EntryPoints.end())
+    return It->second;
+
+  ++NumTranslations;
+  Function *F = DT.translateAt(Addr, /*Recursive=*/!Lazy);
+  std::string Name = F->getName();
+  DEBUG(dbgs() << "Translated " << Name << " for 0x" << utohexstr(Addr)
+               << "\n");
+  uint64_t EntryAddr;
+  if (F->isDeclaration()) {
+    // It was translated in an earlier module.
+    EntryAddr = getSymbolAddress(Name);
+  } else {
+    // Look in the module just translated: the name can also be a stub.
+    if (Lazy)
+      addStubs();
+    Module *M = DT.finalizeTranslationModule();
+    auto H = Stack->addModule(M);
+    Stack->registerEdgeCoverage(H, *M);
+    EntryAddr = Stack->getSymbolAddressIn(H, Name);
+  }
+  if (!EntryAddr)
+    report_fatal_error("DC: unable to compile the function at 0x" +
+                       utohexstr(Addr));
+  void *Entry = reinterpret_cast<void *>(EntryAddr);
+  EntryPoints[Addr] = Entry;
+
+  // Send the calls through the stub straight to the translation.
+  auto StubIt = StubPointers.find(Addr);
+  if (StubIt != StubPointers.end())
+    *reinterpret_cast<void **>(Stack->getSymbolAddress(
+        StubIt->second, /*ExportedSymbolsOnly=*/false)) = Entry;
+  return Entry;
+}
+
+void DCJIT::addStubs() {
+  SmallVector<std::pair<uint64_t, Function *>, 8> Callees;
+  DT.getDeclaredFunctionsToTranslate(Callees);
+  std::unique_ptr<Module> StubsM;
+  for (const auto &AddrFn : Callees) {
+    uint64_t Addr = AddrFn.first;
+    Function *F = AddrFn.second;
+    if (StubPointers.count(Addr))
+      continue;
+    if (!StubsM)
+      StubsM.reset(new Module("dc-stubs", F->getContext()));
+
+    // The stub calls through a pointer, first to the compile callback, then
+    // to the translation.
+    TargetAddress CallbackAddr = Stack->getCompileCallback(
+        F->getContext(), [this, Addr]() {
+          return static_cast<TargetAddress>(
+              reinterpret_cast<uintptr_t>(getTranslatedAt(Addr)));
+        });
+    std::string PointerName = (F->getName() + "$impl").str();
+    GlobalVariable *Pointer = createImplPointer(
+        *F->getType(), *StubsM, PointerName,
+        createIRTypedAddress(*F->getFunctionType(), CallbackAddr));
+    makeStub(*cloneFunctionDecl(*StubsM, *F), *Pointer);
+    StubPointers[Addr] = PointerName;
+  }
+  // The stubs come first, so that the callers find them rather than the
+  // translations.
+  if (StubsM)
+    Stack->addOwnedModule(std::move(StubsM));
+}
+
+void DCJIT::addCurrentModule() {
+  if (Lazy)
+    addStubs();
+  Module *M = DT.finalizeTranslationModule();
+  Stack->registerEdgeCoverage(Stack->addModule(M), *M);
+}
+
+uint64_t DCJIT::getSymbolAddress(StringRef Name) {
+  return Stack->getSymbolAddress(Name);
+}
+
+void *DCJIT::getFunctionAddress(const Function *F) {
+  // The functions of an earlier module are compiled, or can be: the others
+  // are in the current module.
+  uint64_t Addr = getSymbolAddress(F->getName());
+  if (!Addr) {
+    addCurrentModule();
+    Addr = getSymbolAddress(F->getName());
+  }
+  return reinterpret_cast<void *>(Addr);
+}
@@ -41,9 +41,12 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FormattedStream.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <thread>
 using namespace llvm;
 
 // Make virtual table appear in this compilation unit.
@@ -592,6 +595,10 @@ private:
   /// asMap - The slot map for attribute sets.
   DenseMap<AttributeSet, unsigned> asMap;
   unsigned asNext;
+
+  /// ModuleSlots - If set, the initialized tracker holding the module level
+  /// slots, which this one only keeps the function slots of.
+  const SlotTracker *ModuleSlots;
 public:
   /// Construct from a module.
   ///
@@ -607,6 +614,10 @@ public:
   /// within a function (even if no functions have been initialized).
   explicit SlotTracker(const Function *F,
                        bool ShouldInitializeAllMetadata = false);
+  /// Construct a function level tracker, sharing the module level slots of
+  /// \p ModuleSlots, which must have processed all functions already.
+  /// Trackers sharing the same ModuleSlots can be used concurrently.
+  explicit SlotTracker(const SlotTracker *ModuleSlots);
 
   /// Return the slot number of the specified value in it's type
   /// plane.  If something is not in the SlotTracker, return -1.
@@ -746,7 +757,7 @@ static SlotTracker *createSlotTracker(const Value *V) {
 SlotTracker::SlotTracker(const Module *M, bool ShouldInitializeAllMetadata)
     : TheModule(M), TheFunction(nullptr), FunctionProcessed(false),
       ShouldInitializeAllMetadata(ShouldInitializeAllMetadata), mNext(0),
-      fNext(0), mdnNext(0), asNext(0) {}
+      fNext(0), mdnNext(0), asNext(0), ModuleSlots(nullptr) {}
 
 // Function level constructor. Causes the contents of the Module and the one
 // function provided to be added to the slot table.
@@ -754,7 +765,12 @@ SlotTracker::SlotTracker(const Function *F, bool ShouldInitializeAllMetadata)
     : TheModule(F ? F->getParent() : nullptr), TheFunction(F),
       FunctionProcessed(false),
       ShouldInitializeAllMetadata(ShouldInitializeAllMetadata), mNext(0),
-      fNext(0), mdnNext(0), asNext(0) {}
+      fNext(0), mdnNext(0), asNext(0), ModuleSlots(nullptr) {}
+
+SlotTracker::SlotTracker(const SlotTracker *ModuleSlots)
+    : TheModule(nullptr), TheFunction(nullptr), FunctionProcessed(false),
+      ShouldInitializeAllMetadata(false), mNext(0), fNext(0), mdnNext(0),
+      asNext(0), ModuleSlots(ModuleSlots) {}
 
 inline void SlotTracker::initialize() {
   if (TheModule) {
@@ -817,6 +833,12 @@ void SlotTracker::processFunction() {
     if (!AI->hasName())
       CreateFunctionSlot(AI);
 
+  // The module level slots of shared trackers are all there already.
+  // processFunctionMetadata walks the whole function: calling it once per
+  // block made numbering quadratic in the number of blocks.
+  if (!ModuleSlots)
+    processFunctionMetadata(*TheFunction);
+
   ST_DEBUG("Inserting Instructions:\n");
 
   // Add all of the basic blocks and instructions with no names.
@@ -824,11 +846,11 @@ void SlotTracker::processFunction() {
     if (!BB.hasName())
       CreateFunctionSlot(&BB);
 
-    processFunctionMetadata(*TheFunction);
-
     for (auto &I : BB) {
       if (!I.getType()->isVoidTy() && !I.hasName())
         CreateFunctionSlot(&I);
+      if (ModuleSlots)
+        continue;
 
       // We allow direct calls to any llvm.foo function here, because the
       // target may not be linked into the optimizer.
@@ -893,6 +915,11 @@ void SlotTracker::purgeFunction() {
 
 /// getGlobalSlot - Get the slot number of a global value.
 int SlotTracker::getGlobalSlot(const GlobalValue *V) {
+  if (ModuleSlots) {
+    ValueMap::const_iterator MI = ModuleSlots->mMap.find(V);
+    return MI == ModuleSlots->mMap.end() ? -1 : (int)MI->second;
+  }
+
   // Check for uninitialized state and do lazy initialization.
   initialize();
 
@@ -903,6 +930,11 @@ int SlotTracker::getGlobalSlot(const GlobalValue *V) {
 
 /// getMetadataSlot - Get the slot number of a MDNode.
 int SlotTracker::getMetadataSlot(const MDNode *N) {
+  if (ModuleSlots) {
+    auto MI = ModuleSlots->mdnMap.find(N);
+    return MI == ModuleSlots->mdnMap.end() ? -1 : (int)MI->second;
+  }
+
   // Check for uninitialized state and do lazy initialization.
   initialize();
 
@@ -924,6 +956,11 @@ int SlotTracker::getLocalSlot(const Value *V) {
 }
 
 int SlotTracker::getAttributeGroupSlot(AttributeSet AS) {
+  if (ModuleSlots) {
+    auto AI = ModuleSlots->asMap.find(AS);
+    return AI == ModuleSlots->asMap.end() ? -1 : (int)AI->second;
+  }
+
   // Check for uninitialized state and do lazy initialization.
   initialize();
 
@@ -2004,12 +2041,14 @@ class AssemblyWriter {
   const Module *TheModule;
   std::unique_ptr<SlotTracker> SlotTrackerStorage;
   SlotTracker &Machine;
-  TypePrinting TypePrinter;
+  TypePrinting TypePrinterStorage;
+  TypePrinting &TypePrinter;
   AssemblyAnnotationWriter *AnnotationWriter;
   SetVector<const Comdat *> Comdats;
   bool ShouldPreserveUseListOrder;
   UseListOrderStack UseListOrders;
   SmallVector<StringRef, 8> MDNames;
+  unsigned NumJobs;
 
 public:
   /// Construct an AssemblyWriter with an external SlotTracker
@@ -2022,6 +2061,15 @@ public:
                  AssemblyAnnotationWriter *AAW,
                  bool ShouldPreserveUseListOrder = false);
 
+  /// Construct an AssemblyWriter printing the functions of the module of
+  /// \p Parent, with a SlotTracker sharing its module level slots. It shares
+  /// the types of \p Parent, and can be used concurrently with it.
+  AssemblyWriter(formatted_raw_ostream &o, SlotTracker &Mac,
+                 const AssemblyWriter &Parent);
+
+  /// Print the functions of printModule using \p Jobs threads.
+  void setNumJobs(unsigned Jobs) { NumJobs = Jobs ? Jobs : 1; }
+
   void printMDNodeBody(const MDNode *MD);
   void printNamedMDNode(const NamedMDNode *NMD);
 
@@ -2054,6 +2102,9 @@ public:
 private:
   void init();
 
+  /// Print the functions of \p M, as printModule does, on NumJobs threads.
+  void printFunctionsInParallel(const Module *M);
+
   /// \brief Print out metadata attachments.
   void printMetadataAttachments(
       const SmallVectorImpl<std::pair<unsigned, MDNode *>> &MDs,
@@ -2084,8 +2135,9 @@ void AssemblyWriter::init() {
 AssemblyWriter::AssemblyWriter(formatted_raw_ostream &o, SlotTracker &Mac,
                                const Module *M, AssemblyAnnotationWriter *AAW,
                                bool ShouldPreserveUseListOrder)
-    : Out(o), TheModule(M), Machine(Mac), AnnotationWriter(AAW),
-      ShouldPreserveUseListOrder(ShouldPreserveUseListOrder) {
+    : Out(o), TheModule(M), Machine(Mac), TypePrinter(TypePrinterStorage),
+      AnnotationWriter(AAW),
+      ShouldPreserveUseListOrder(ShouldPreserveUseListOrder), NumJobs(1) {
   init();
 }
 
@@ -2093,11 +2145,18 @@ AssemblyWriter::AssemblyWriter(formatted_raw_ostream &o, const Module *M,
                                AssemblyAnnotationWriter *AAW,
                                bool ShouldPreserveUseListOrder)
     : Out(o), TheModule(M), SlotTrackerStorage(createSlotTracker(M)),
-      Machine(*SlotTrackerStorage), AnnotationWriter(AAW),
-      ShouldPreserveUseListOrder(ShouldPreserveUseListOrder) {
+      Machine(*SlotTrackerStorage), TypePrinter(TypePrinterStorage),
+      AnnotationWriter(AAW),
+      ShouldPreserveUseListOrder(ShouldPreserveUseListOrder), NumJobs(1) {
   init();
 }
 
+AssemblyWriter::AssemblyWriter(formatted_raw_ostream &o, SlotTracker &Mac,
+                               const AssemblyWriter &Parent)
+    : Out(o), TheModule(Parent.TheModule), Machine(Mac),
+      TypePrinter(Parent.TypePrinter), AnnotationWriter(nullptr),
+      ShouldPreserveUseListOrder(false), NumJobs(1) {}
+
 void AssemblyWriter::writeOperand(const Value *Operand, bool PrintType) {
   if (!Operand) {
     Out << "<null operand!>";
@@ -2240,8 +2299,12 @@ void AssemblyWriter::printModule(const Module *M) {
   printUseLists(nullptr);
 
   // Output all of the functions.
-  for (const Function &F : *M)
-    printFunction(&F);
+  if (NumJobs > 1 && !ShouldPreserveUseListOrder && !AnnotationWriter &&
+      llvm_is_multithreaded())
+    printFunctionsInParallel(M);
+  else
+    for (const Function &F : *M)
+      printFunction(&F);
   assert(UseListOrders.empty() && "All use-lists should have been consumed");
 
   // Output all attribute groups.
@@ -2263,6 +2326,61 @@ void AssemblyWriter::printModule(const Module *M) {
   }
 }
 
+// The number of functions each job prints at once, and the number of pending
+// jobs per thread: the output of a round of jobs is kept in memory until all
+// are done.
+static const size_t FunctionsPerPrintJob = 64;
+static const size_t PrintJobsPerThread = 4;
+
+void AssemblyWriter::printFunctionsInParallel(const Module *M) {
+  // Number everything first, in module order: function metadata and call
+  // attributes get the same slots as when printing sequentially. The workers
+  // then only number the values local to their functions.
+  for (const Function &F : *M) {
+    Machine.incorporateFunction(&F);
+    Machine.initialize();
+    Machine.purgeFunction();
+  }
+
+  std::vector<const Function *> Funcs;
+  for (const Function &F : *M)
+    Funcs.push_back(&F);
+  const size_t NumPrintJobs =
+      (Funcs.size() + FunctionsPerPrintJob - 1) / FunctionsPerPrintJob;
+  const size_t JobsPerRound = NumJobs * PrintJobsPerThread;
+
+  std::vector<SmallString<0>> Buffers(JobsPerRound);
+  for (size_t FirstJob = 0; FirstJob < NumPrintJobs; FirstJob += JobsPerRound) {
+    const size_t EndJob = std::min(FirstJob + JobsPerRound, NumPrintJobs);
+    std::atomic<size_t> NextJob(FirstJob);
+    auto Worker = [&]() {
+      SlotTracker WorkerMachine(&Machine);
+      for (size_t J = NextJob++; J < EndJob; J = NextJob++) {
+        SmallString<0> &Buffer = Buffers[J - FirstJob];
+        Buffer.clear();
+        raw_svector_ostream OS(Buffer);
+        formatted_raw_ostream FOS(OS);
+        AssemblyWriter W(FOS, WorkerMachine, *this);
+        for (size_t I = J * FunctionsPerPrintJob,
+                    E = std::min(I + FunctionsPerPrintJob, Funcs.size());
+             I != E; ++I)
+          W.printFunction(Funcs[I]);
+      }
+    };
+
+    std::vector<std::thread> Threads;
+    for (size_t T = 1, E = std::min<size_t>(NumJobs, EndJob - FirstJob);
+         T < E; ++T)
+      Threads.emplace_back(Worker);
+    Worker();
+    for (std::thread &T : Threads)
+      T.join();
+
+    for (size_t J = FirstJob; J != EndJob; ++J)
+      Out << Buffers[J - FirstJob].str();
+  }
+}
+
 static void printMetadataIdentifier(StringRef Name,
                                     formatted_raw_ostream &Out) {
   if (Name.empty()) {
@@ -3216,6 +3334,14 @@ void Module::print(raw_ostream &ROS, AssemblyAnnotationWriter *AAW,
   W.printModule(this);
 }
 
+void Module::printInParallel(raw_ostream &ROS, unsigned NumJobs) const {
+  SlotTracker SlotTable(this);
+  formatted_raw_ostream OS(ROS);
+  AssemblyWriter W(OS, SlotTable, this, nullptr);
+  W.setNumJobs(NumJobs);
+  W.printModule(this);
+}
+
 void NamedMDNode::print(raw_ostream &ROS) const {
   SlotTracker SlotTable(getParent());
   formatted_raw_ostream OS(ROS);
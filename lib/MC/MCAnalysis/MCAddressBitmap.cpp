@@ -0,0 +1,90 @@
+//===- lib/MC/MCAnalysis/MCAddressBitmap.cpp ------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MC/MCAnalysis/MCAddressBitmap.h"
+#include <algorithm>
+
+using namespace llvm;
+
+const MCAddressBitmap::Region *
+MCAddressBitmap::findRegion(uint64_t Addr) const {
+  auto I = std::upper_bound(
+      Regions.begin(), Regions.end(), Addr,
+      [](uint64_t Addr, const Region &R) { return Addr < R.Base; });
+  if (I == Regions.begin())
+    return nullptr;
+  --I;
+  if (Addr < I->End)
+    return &*I;
+  return nullptr;
+}
+
+void MCAddressBitmap::addRegion(uint64_t Base, uint64_t Size, bool SetAll) {
+  // The regions that overlap the new one are merged with it: in relocatable
+  // objects, the sections all start at address 0. The addresses in the
+  // overlap can't be told apart; the set keeps their union.
+  auto I = std::upper_bound(
+      Regions.begin(), Regions.end(), Base,
+      [](uint64_t Addr, const Region &R) { return Addr < R.Base; });
+  if (I != Regions.begin() && std::prev(I)->End > Base)
+    --I;
+  auto E = I;
+  uint64_t End = Base + Size;
+  while (E != Regions.end() && E->Base < End)
+    ++E;
+  if (I != E) {
+    Base = std::min(Base, I->Base);
+    End = std::max(End, std::prev(E)->End);
+  }
+
+  Region R;
+  R.Base = Base;
+  R.End = End;
+  R.Bits.resize((End - Base + Granularity - 1) / Granularity, SetAll);
+  for (auto MI = I; MI != E; ++MI) {
+    NumSet -= MI->Bits.count();
+    for (int Bit = MI->Bits.find_first(); Bit != -1;
+         Bit = MI->Bits.find_next(Bit))
+      R.Bits.set((MI->Base + uint64_t(Bit) * Granularity - Base) /
+                 Granularity);
+  }
+  NumSet += R.Bits.count();
+  Regions.insert(Regions.erase(I, E), std::move(R));
+}
+
+bool MCAddressBitmap::insert(uint64_t Addr) {
+  Region *R = findRegion(Addr);
+  if (!R)
+    return false;
+  const size_t Slot = (Addr - R->Base) / Granularity;
+  if (R->Bits.test(Slot))
+    return false;
+  R->Bits.set(Slot);
+  ++NumSet;
+  return true;
+}
+
+bool MCAddressBitmap::test(uint64_t Addr) const {
+  const Region *R = findRegion(Addr);
+  return R && R->Bits.test((Addr - R->Base) / Granularity);
+}
+
+void MCAddressBitmap::const_iterator::advance() {
+  for (size_t E = Map->Regions.size(); RegionIdx != E; ++RegionIdx, Bit = -1) {
+    const BitVector &Bits = Map->Regions[RegionIdx].Bits;
+    Bit = Bit == -1 ? Bits.find_first() : Bits.find_next(Bit);
+    if (Bit != -1)
+      return;
+  }
+}
+
+MCAddressBitmap::const_iterator &MCAddressBitmap::const_iterator::operator++() {
+  advance();
+  return *this;
+}
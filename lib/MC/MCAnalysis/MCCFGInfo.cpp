@@ -0,0 +1,49 @@
+//===- lib/MC/MCAnalysis/MCCFGInfo.cpp - MC CFG structure -----------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MC/MCAnalysis/MCCFGInfo.h"
+#include "llvm/ADT/SCCIterator.h"
+#include "llvm/Support/ThreadPool.h"
+
+using namespace llvm;
+
+const uint32_t MCCFGInfo::NoSCC;
+
+void MCCFGInfo::analyze(const MCFunction &F) {
+  DT.recalculate(F);
+  LI.recalculate(DT);
+
+  SCCBlocks.clear();
+  SCCBegins.assign(1, 0);
+  CyclicSCCs.clear();
+  BlockSCCs.assign(F.size(), NoSCC);
+  for (scc_iterator<const MCFunction *> I = scc_begin(&F); !I.isAtEnd(); ++I) {
+    const uint32_t SCC = SCCBegins.size() - 1;
+    for (const MCBasicBlock *BB : *I) {
+      SCCBlocks.push_back(BB);
+      BlockSCCs[BB->getIndex()] = SCC;
+    }
+    SCCBegins.push_back(SCCBlocks.size());
+    CyclicSCCs.resize(SCC + 1);
+    if (I.hasLoop())
+      CyclicSCCs.set(SCC);
+  }
+}
+
+std::vector<MCCFGInfo>
+MCCFGInfo::analyzeAll(ArrayRef<const MCFunction *> Funcs, unsigned NumJobs) {
+  // Each function only writes its own info.
+  std::vector<MCCFGInfo> Infos(Funcs.size());
+  ThreadPool Pool(NumJobs > 1 ? NumJobs - 1 : 0);
+  parallel_for(Pool, 0, Funcs.size(), [&](size_t I) {
+    if (!Funcs[I]->empty())
+      Infos[I].analyze(*Funcs[I]);
+  });
+  return Infos;
+}
@@ -18,14 +18,60 @@ using namespace llvm;
 STATISTIC(NumTranslatedInsts, "Number of instructions translated");
 STATISTIC(NumUniquedInsts   , "Number of instructions uniqued");
 
+MCCachingDisassembler::MCCachingDisassembler(
+    const MCDisassembler &Disassembler, const MCSubtargetInfo &STI,
+    bool FixedWidth)
+    : MCDisassembler(STI, Disassembler.getContext()), Impl(Disassembler),
+      FixedWidth(FixedWidth), NumLookups(0), NumHits(0), TempInstKeys(),
+      TempInstValues(), CachedInsts(), LongestCachedRawBytes(0) {
+  if (FixedWidth) {
+    WordShards.reset(new WordShard[NumWordShards]);
+    for (unsigned i = 0; i != NumWordShards; ++i)
+      WordShards[i].Entries.resize(1024);
+  }
+}
+
 MCCachingDisassembler::~MCCachingDisassembler() {}
 
+// The heap memory of the operands of Inst, which only holds one inline.
+static size_t getOperandsHeapSize(const MCInst &Inst) {
+  return Inst.size() > 1 ? Inst.size() * sizeof(MCOperand) : 0;
+}
+
+size_t MCCachingDisassembler::getMemoryUsage() const {
+  size_t Size = TempInstKeys.capacity() * sizeof(TempInstKey) +
+                TempInstValues.capacity() * sizeof(MCInst) +
+                CachedInsts.capacity() * sizeof(CachedInstEntry);
+  for (const MCInst &Inst : TempInstValues)
+    Size += getOperandsHeapSize(Inst);
+  for (const CachedInstEntry &Entry : CachedInsts)
+    Size += getOperandsHeapSize(Entry.Inst);
+  if (!FixedWidth)
+    return Size;
+
+  Size += NumWordShards * sizeof(WordShard);
+  for (unsigned i = 0; i != NumWordShards; ++i) {
+    WordShard &Shard = WordShards[i];
+    std::lock_guard<std::mutex> Lock(Shard.Lock);
+    Size += Shard.Entries.capacity() * sizeof(WordEntry);
+    for (const WordEntry &Entry : Shard.Entries)
+      if (Entry.State == WordEntry::Cached)
+        Size += getOperandsHeapSize(Entry.Inst);
+  }
+  return Size;
+}
+
 MCDisassembler::DecodeStatus MCCachingDisassembler::getInstruction(
     MCInst &Inst, uint64_t &InstSize, ArrayRef<uint8_t> Bytes, uint64_t Addr,
     raw_ostream &vStream, raw_ostream &cStream) const {
+  if (FixedWidth)
+    return getFixedWidthInstruction(Inst, InstSize, Bytes, Addr, vStream,
+                                    cStream);
 
+  ++NumLookups;
   if (findCachedInstruction(Inst, InstSize, Bytes)) {
     ++NumUniquedInsts;
+    ++NumHits;
     return Success;
   }
 
@@ -130,3 +176,106 @@ void MCCachingDisassembler::uniqueTempInstructions() const {
   TempInstKeys.reserve(7000);
   TempInstValues.reserve(7000);
 }
+
+//===- Fixed-width mode ---------------------------------------------------===//
+
+static unsigned hashWord(uint32_t Word) {
+  // Fibonacci hashing: the top bits select the shard, the low bits the slot.
+  return Word * 0x9E3779B1U;
+}
+
+static bool isSameInst(const MCInst &LHS, const MCInst &RHS) {
+  if (LHS.getOpcode() != RHS.getOpcode() ||
+      LHS.getNumOperands() != RHS.getNumOperands())
+    return false;
+  for (unsigned i = 0, e = LHS.getNumOperands(); i != e; ++i) {
+    const MCOperand &L = LHS.getOperand(i), &R = RHS.getOperand(i);
+    if (L.isReg() && R.isReg() && L.getReg() == R.getReg())
+      continue;
+    if (L.isImm() && R.isImm() && L.getImm() == R.getImm())
+      continue;
+    if (L.isFPImm() && R.isFPImm() && L.getFPImm() == R.getFPImm())
+      continue;
+    // Expressions and nested instructions are never considered identical.
+    return false;
+  }
+  return true;
+}
+
+MCCachingDisassembler::WordEntry &
+MCCachingDisassembler::WordShard::lookup(uint32_t Word, unsigned Hash) {
+  const size_t Mask = Entries.size() - 1;
+  for (size_t I = Hash & Mask;; I = (I + 1) & Mask) {
+    WordEntry &E = Entries[I];
+    if (E.State == WordEntry::Empty || E.Word == Word)
+      return E;
+  }
+}
+
+void MCCachingDisassembler::WordShard::grow() {
+  std::vector<WordEntry> OldEntries(Entries.size() * 2);
+  std::swap(OldEntries, Entries);
+  for (WordEntry &Old : OldEntries)
+    if (Old.State != WordEntry::Empty)
+      std::swap(lookup(Old.Word, hashWord(Old.Word)), Old);
+}
+
+MCDisassembler::DecodeStatus MCCachingDisassembler::getFixedWidthInstruction(
+    MCInst &Inst, uint64_t &InstSize, ArrayRef<uint8_t> Bytes, uint64_t Addr,
+    raw_ostream &vStream, raw_ostream &cStream) const {
+  if (Bytes.size() < 4)
+    return Impl.getInstruction(Inst, InstSize, Bytes, Addr, vStream, cStream);
+
+  const uint32_t Word = (Bytes[0] << 0) | (Bytes[1] << 8) | (Bytes[2] << 16) |
+                        (uint32_t(Bytes[3]) << 24);
+  const unsigned Hash = hashWord(Word);
+  WordShard &Shard = WordShards[Hash >> 26];
+  static_assert(NumWordShards == 1 << (32 - 26), "Shard index mismatch!");
+
+  ++NumLookups;
+  bool KnownUncacheable = false;
+  {
+    std::lock_guard<std::mutex> Lock(Shard.Lock);
+    const WordEntry &E = Shard.lookup(Word, Hash);
+    if (E.State == WordEntry::Cached) {
+      ++NumUniquedInsts;
+      ++NumHits;
+      Inst = E.Inst;
+      InstSize = 4;
+      return Success;
+    }
+    KnownUncacheable = E.State == WordEntry::Uncacheable;
+  }
+
+  DecodeStatus S =
+      Impl.getInstruction(Inst, InstSize, Bytes, Addr, vStream, cStream);
+  if (S != Success || KnownUncacheable)
+    return S;
+  ++NumTranslatedInsts;
+
+  // Decode the same word at another address: if the MCInst is the same, it
+  // doesn't depend on the PC, and can be reused anywhere as is.
+  bool Cacheable = false;
+  if (InstSize == 4) {
+    const uint64_t AddrDelta = 1ULL << 24;
+    MCInst OtherInst;
+    uint64_t OtherSize;
+    Cacheable = Impl.getInstruction(OtherInst, OtherSize, Bytes,
+                                    Addr + AddrDelta, nulls(),
+                                    nulls()) == Success &&
+                OtherSize == 4 && isSameInst(Inst, OtherInst);
+  }
+
+  std::lock_guard<std::mutex> Lock(Shard.Lock);
+  if ((Shard.NumUsed + 1) * 2 > Shard.Entries.size())
+    Shard.grow();
+  WordEntry &E = Shard.lookup(Word, Hash);
+  if (E.State == WordEntry::Empty) {
+    ++Shard.NumUsed;
+    E.Word = Word;
+    E.State = Cacheable ? WordEntry::Cached : WordEntry::Uncacheable;
+    if (Cacheable)
+      E.Inst = Inst;
+  }
+  return S;
+}
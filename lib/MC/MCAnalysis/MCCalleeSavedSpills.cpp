@@ -0,0 +1,173 @@
+//===- lib/MC/MCAnalysis/MCCalleeSavedSpills.cpp - Callee-saved spills ----===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MC/MCAnalysis/MCCalleeSavedSpills.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCInstrAnalysis.h"
+#include "llvm/MC/MCRegisterInfo.h"
+
+using namespace llvm;
+
+namespace {
+/// \brief The registers an instruction writes, and all their aliases.
+class WrittenRegs {
+  const MCInstrInfo &MII;
+  const MCRegisterInfo &MRI;
+  BitVector Regs;
+
+  void add(unsigned Reg) {
+    for (MCRegAliasIterator AI(Reg, &MRI, true); AI.isValid(); ++AI)
+      Regs.set(*AI);
+  }
+
+public:
+  WrittenRegs(const MCInstrInfo &MII, const MCRegisterInfo &MRI)
+      : MII(MII), MRI(MRI), Regs(MRI.getNumRegs()) {}
+
+  void clear() { Regs.reset(); }
+  bool test(unsigned Reg) const { return Regs.test(Reg); }
+  const BitVector &getRegs() const { return Regs; }
+
+  void addInst(const MCInst &Inst) {
+    const MCInstrDesc &Desc = MII.get(Inst.getOpcode());
+    for (unsigned I = 0, E = Desc.getNumDefs(); I != E && I != Inst.size();
+         ++I)
+      if (Inst.getOperand(I).isReg() && Inst.getOperand(I).getReg())
+        add(Inst.getOperand(I).getReg());
+    for (const MCPhysReg *R = Desc.getImplicitDefs(); R && *R; ++R)
+      add(*R);
+  }
+};
+} // end anonymous namespace
+
+/// \brief Whether the scans for the saves and restores can step over
+/// \p Inst: it doesn't touch memory, nor leave the block.
+static bool isStepOver(const MCInst &Inst, const MCInstrAnalysis &MIA) {
+  const MCInstrDesc &Desc = MIA.getInstrInfo().get(Inst.getOpcode());
+  return !Desc.mayLoad() && !Desc.mayStore() &&
+         !Desc.hasUnmodeledSideEffects() && !MIA.isCall(Inst) &&
+         !MIA.isBranch(Inst) && !MIA.isTerminator(Inst) &&
+         !MIA.isReturn(Inst);
+}
+
+bool MCCalleeSavedSpills::analyze(const MCFunction &F,
+                                  const MCInstrAnalysis &MIA,
+                                  const MCRegisterInfo &MRI) {
+  clear();
+  if (F.empty() || F.getEntryBlock()->pred_size())
+    return false;
+
+  const MCInstrInfo &MII = MIA.getInstrInfo();
+  typedef MCInstrAnalysis::StackSpill StackSpill;
+
+  // The prologue: the saves, at the entry, before the registers are written,
+  // and the slot of each register, from the incoming stack pointer.
+  DenseMap<unsigned, int64_t> Slots;
+  SmallVector<uint64_t, 8> Addrs;
+  BitVector Saved(MRI.getNumRegs());
+  WrittenRegs Written(MII, MRI);
+  // The stack registers the saves are based on.
+  BitVector BaseRegs(MRI.getNumRegs());
+  int64_t Delta = 0;
+  for (const MCDecodedInst &DI : *F.getEntryBlock()) {
+    StackSpill S;
+    int64_t Adjust;
+    if (MIA.evaluateStackSpill(DI.Inst, S) && !S.IsLoad) {
+      if (Written.test(S.BaseReg))
+        break;
+      bool AllSaved = true;
+      for (unsigned I = 0; I != S.NumRegs; ++I) {
+        unsigned Reg = S.Regs[I];
+        if (Saved.test(Reg))
+          return false;
+        AllSaved &= !Written.test(Reg);
+      }
+      if (!AllSaved)
+        break;
+      for (unsigned I = 0; I != S.NumRegs; ++I) {
+        Saved.set(S.Regs[I]);
+        Slots[S.Regs[I]] = Delta + S.Offset + I * S.RegSize;
+      }
+      BaseRegs.set(S.BaseReg);
+      Delta += S.SPAdjust;
+      Addrs.push_back(DI.Address);
+    } else if (MIA.evaluateStackAdjust(DI.Inst, Adjust)) {
+      Delta += Adjust;
+    } else if (isStepOver(DI.Inst, MIA)) {
+      Written.addInst(DI.Inst);
+      // The stack pointer moved by something else than the adjustments.
+      if (Written.getRegs().anyCommon(BaseRegs))
+        break;
+    } else {
+      break;
+    }
+  }
+  if (Addrs.empty())
+    return false;
+
+  // The epilogues: the restores of all the saved registers, from their
+  // slots, before each exit. The stack pointer at the exit is the incoming
+  // one: they are walked back from there.
+  unsigned NumExits = 0;
+  for (const MCBasicBlock *BB : F) {
+    if (BB->succ_size() || BB->empty())
+      continue;
+    const MCInst &Term = BB->back().Inst;
+    // Blocks ending in a call don't return (say, to abort).
+    if (!MIA.isReturn(Term) && (!MIA.isBranch(Term) || MIA.isCall(Term)))
+      continue;
+    ++NumExits;
+
+    BitVector Restored(MRI.getNumRegs());
+    Written.clear();
+    Delta = 0;
+    for (auto I = BB->end() - 1; I != BB->begin();) {
+      const MCDecodedInst &DI = *--I;
+      StackSpill S;
+      int64_t Adjust;
+      if (MIA.evaluateStackSpill(DI.Inst, S) && S.IsLoad) {
+        // The registers are written after the restore, or the stack pointer
+        // moved by something else than the adjustments.
+        if (Written.test(S.BaseReg))
+          break;
+        const int64_t DeltaBefore = Delta - S.SPAdjust;
+        bool AllMatch = true;
+        for (unsigned J = 0; J != S.NumRegs; ++J) {
+          unsigned Reg = S.Regs[J];
+          auto SI = Slots.find(Reg);
+          AllMatch &= SI != Slots.end() && !Restored.test(Reg) &&
+                      !Written.test(Reg) &&
+                      SI->second == DeltaBefore + S.Offset + J * S.RegSize;
+        }
+        if (!AllMatch)
+          break;
+        for (unsigned J = 0; J != S.NumRegs; ++J)
+          Restored.set(S.Regs[J]);
+        Delta = DeltaBefore;
+        Addrs.push_back(DI.Address);
+      } else if (MIA.evaluateStackAdjust(DI.Inst, Adjust)) {
+        Delta -= Adjust;
+      } else if (isStepOver(DI.Inst, MIA)) {
+        Written.addInst(DI.Inst);
+      } else {
+        break;
+      }
+    }
+    if (Restored != Saved)
+      return false;
+  }
+  if (!NumExits)
+    return false;
+
+  SavedRegs = std::move(Saved);
+  SpillAddrs.insert(Addrs.begin(), Addrs.end());
+  return true;
+}
@@ -0,0 +1,141 @@
+//===- lib/MC/MCAnalysis/MCConstantRegs.cpp - Constant registers ----------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MC/MCAnalysis/MCConstantRegs.h"
+#include "llvm/ADT/BitVector.h"
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCInstrAnalysis.h"
+#include "llvm/MC/MCInstrInfo.h"
+#include "llvm/MC/MCRegisterInfo.h"
+
+using namespace llvm;
+
+typedef MCInstrAnalysis::ConstantDef ConstantDef;
+
+void MCConstantRegs::setReg(unsigned Reg, const Value *V,
+                            RegValues &Values) const {
+  // The registers it overlaps no longer hold their value.
+  for (MCRegAliasIterator AI(Reg, MRI, true); AI.isValid(); ++AI)
+    Values.erase(*AI);
+  if (V)
+    Values[Reg] = *V;
+}
+
+void MCConstantRegs::transfer(const MCDecodedInst &DI,
+                              RegValues &Values) const {
+  if (MIA->isCall(DI.Inst)) {
+    Values.clear();
+    return;
+  }
+
+  ConstantDef D;
+  if (MIA->evaluateConstantDef(DI.Inst, DI.Address, DI.Size, D)) {
+    Value V = {uint64_t(D.Imm), false};
+    bool Known = true;
+    if (D.Kind != ConstantDef::Value) {
+      auto SI = Values.find(D.SrcReg);
+      Known = SI != Values.end() && !SI->second.IsLoad;
+      if (Known) {
+        const uint64_t Src = SI->second.Val;
+        switch (D.Kind) {
+        case ConstantDef::Value: break;
+        case ConstantDef::Add: V.Val = Src + D.Imm; break;
+        case ConstantDef::Insert: V.Val = (Src & ~D.Mask) | D.Imm; break;
+        case ConstantDef::Load: V.Val = Src + D.Imm; V.IsLoad = true; break;
+        }
+      }
+    }
+    setReg(D.DefReg, Known ? &V : nullptr, Values);
+    return;
+  }
+
+  const MCInstrDesc &Desc = MII->get(DI.Inst.getOpcode());
+  for (unsigned I = 0, E = Desc.getNumDefs(); I != E; ++I)
+    if (DI.Inst.getOperand(I).isReg())
+      setReg(DI.Inst.getOperand(I).getReg(), nullptr, Values);
+  for (unsigned I = 0, E = Desc.getNumImplicitDefs(); I != E; ++I)
+    setReg(Desc.getImplicitDefs()[I], nullptr, Values);
+}
+
+void MCConstantRegs::analyze(const MCFunction &F, const MCInstrAnalysis &MIA,
+                             const MCInstrInfo &MII,
+                             const MCRegisterInfo &MRI) {
+  clear();
+  if (F.empty())
+    return;
+  this->F = &F;
+  this->MIA = &MIA;
+  this->MII = &MII;
+  this->MRI = &MRI;
+  BlockValues.resize(F.size());
+
+  // The values at the end of the blocks reached so far: the predecessors
+  // that weren't reached yet are left out of the intersections, and the
+  // values only ever go away, until they don't change anymore.
+  std::vector<RegValues> OutValues(F.size());
+  BitVector Reached(F.size());
+  std::vector<uint32_t> Worklist(1, F.getEntryBlock()->getIndex());
+  while (!Worklist.empty()) {
+    const MCBasicBlock &BB = *F.getBlock(Worklist.back());
+    Worklist.pop_back();
+    const uint32_t Index = BB.getIndex();
+
+    // Nothing is known on entry to the function.
+    RegValues In;
+    bool First = true;
+    if (&BB != F.getEntryBlock()) {
+      for (uint32_t Pred : BB.pred_indices()) {
+        if (!Reached.test(Pred))
+          continue;
+        if (First) {
+          In = OutValues[Pred];
+          First = false;
+          continue;
+        }
+        const RegValues &PredOut = OutValues[Pred];
+        for (auto I = In.begin(), E = In.end(); I != E; ++I) {
+          auto PI = PredOut.find(I->first);
+          if (PI == PredOut.end() || PI->second != I->second)
+            In.erase(I);
+        }
+      }
+    }
+
+    RegValues Out = In;
+    for (const MCDecodedInst &DI : BB)
+      transfer(DI, Out);
+    BlockValues[Index] = std::move(In);
+
+    if (Reached.test(Index) && Out.size() == OutValues[Index].size())
+      continue;
+    Reached.set(Index);
+    OutValues[Index] = std::move(Out);
+    for (uint32_t Succ : BB.succ_indices())
+      Worklist.push_back(Succ);
+  }
+}
+
+bool MCConstantRegs::lookup(uint64_t Addr, unsigned Reg, Value &V) const {
+  if (!F)
+    return false;
+  const MCBasicBlock *BB = F->findContaining(Addr);
+  if (!BB)
+    return false;
+  RegValues Values = BlockValues[BB->getIndex()];
+  for (const MCDecodedInst &DI : *BB) {
+    if (DI.Address == Addr)
+      break;
+    transfer(DI, Values);
+  }
+  auto I = Values.find(Reg);
+  if (I == Values.end())
+    return false;
+  V = I->second;
+  return true;
+}
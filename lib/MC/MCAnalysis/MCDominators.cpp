@@ -0,0 +1,26 @@
+//===- lib/MC/MCAnalysis/MCDominators.cpp - MC CFG dominator tree ---------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MC/MCAnalysis/MCDominators.h"
+#include "llvm/Support/GenericDomTreeConstruction.h"
+
+using namespace llvm;
+
+void MCDominatorTree::recalculate(const MCFunction &F) {
+  assert(!F.empty() && "Dominator tree of a function without blocks?");
+  // DominatorTreeBase::recalculate, without the post-dominators, which
+  // would need the blocks of the function as graph nodes.
+  reset();
+  Vertex.push_back(nullptr);
+  MCBasicBlock *Entry = const_cast<MCBasicBlock *>(F.getEntryBlock());
+  Roots.push_back(Entry);
+  IDoms[Entry] = nullptr;
+  DomTreeNodes[Entry] = nullptr;
+  Calculate<MCFunction, MCBasicBlock *>(*this, const_cast<MCFunction &>(F));
+}
@@ -0,0 +1,92 @@
+//===- lib/MC/MCAnalysis/MCFlattenedCFG.cpp - Flattened control flow ------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MC/MCAnalysis/MCFlattenedCFG.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCInstrInfo.h"
+#include <algorithm>
+
+using namespace llvm;
+
+/// \brief The register \p Inst sets to a constant, or 0 if it doesn't: it
+/// only writes that register, from immediates, and from that register for
+/// the moves that set it piecewise.
+static unsigned getConstantDef(const MCInst &Inst, const MCInstrInfo &MII) {
+  const MCInstrDesc &Desc = MII.get(Inst.getOpcode());
+  if (Desc.getNumDefs() != 1 || Desc.getImplicitDefs() || Desc.mayLoad() ||
+      Desc.mayStore() || Desc.isBranch() || Desc.isCall() || !Inst.size() ||
+      !Inst.getOperand(0).isReg() || !Inst.getOperand(0).getReg())
+    return 0;
+  bool HasImm = false;
+  for (unsigned I = 1, E = Inst.size(); I != E; ++I) {
+    const MCOperand &Op = Inst.getOperand(I);
+    if (Op.isImm())
+      HasImm = true;
+    else if (!Op.isReg() ||
+             (I < Desc.getNumOperands() &&
+              Desc.getOperandConstraint(I, MCOI::TIED_TO) != 0))
+      return 0;
+  }
+  return HasImm ? Inst.getOperand(0).getReg() : 0;
+}
+
+bool MCFlattenedCFG::analyze(const MCFunction &F, const MCInstrInfo &MII) {
+  clear();
+
+  // The hub is the block with the most predecessors; they must be a good
+  // share of the function.
+  const MCBasicBlock *H = nullptr;
+  for (const MCBasicBlock *BB : F)
+    if (!H || BB->pred_size() > H->pred_size())
+      H = BB;
+  if (!H || H->pred_size() < MinCases || H->pred_size() * 4 < F.size())
+    return false;
+
+  // The hub reaches the dispatcher on its own, through the blocks that load
+  // the state, say.
+  const MCBasicBlock *D = H;
+  for (unsigned I = 0; I != 4 && D->succ_size() == 1; ++I) {
+    D = *D->succ_begin();
+    if (D == H)
+      return false;
+  }
+  if (D->succ_size() < 2)
+    return false;
+
+  // Most cases set the state to a constant, in the same register. The cases
+  // with two next blocks select between two constants, in other registers:
+  // any register set to a constant counts.
+  DenseMap<unsigned, unsigned> RegCases;
+  SmallVector<unsigned, 4> Regs;
+  for (const MCBasicBlock *Case : make_range(H->pred_begin(), H->pred_end())) {
+    Regs.clear();
+    for (const MCDecodedInst &DI : *Case)
+      if (unsigned Reg = getConstantDef(DI.Inst, MII))
+        if (std::find(Regs.begin(), Regs.end(), Reg) == Regs.end())
+          Regs.push_back(Reg);
+    for (unsigned Reg : Regs)
+      ++RegCases[Reg];
+  }
+  unsigned Reg = 0, Count = 0;
+  for (const auto &RC : RegCases)
+    if (RC.second > Count || (RC.second == Count && RC.first < Reg)) {
+      Reg = RC.first;
+      Count = RC.second;
+    }
+  if (Count * 2 < H->pred_size())
+    return false;
+
+  Hub = H;
+  Dispatcher = D;
+  StateReg = Reg;
+  NumCases = H->pred_size();
+  return true;
+}
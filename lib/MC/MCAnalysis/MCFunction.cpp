@@ -9,25 +9,281 @@
 
 #include "llvm/MC/MCAnalysis/MCFunction.h"
 #include "llvm/MC/MCAnalysis/MCModule.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/LEB128.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/raw_ostream.h"
 #include <algorithm>
+#include <new>
 
 using namespace llvm;
 
 // MCFunction
 
 MCFunction::MCFunction(StringRef Name, MCModule *Parent)
-  : Name(Name), ParentModule(Parent)
+  : Name(Name), ParentModule(Parent), NextBlock(nullptr), BlocksEnd(nullptr),
+    InstsReleased(false), UnwindEncoding(0)
 {}
 
 MCFunction::~MCFunction() {
   for (auto BB : Blocks)
-    delete BB;
+    BB->~MCBasicBlock();
+  for (MCBasicBlock *Chunk : BlockChunks)
+    ::operator delete(Chunk);
+}
+
+MutableArrayRef<MCDecodedInst>
+MCFunction::moveInsts(MutableArrayRef<MCDecodedInst> Insts) {
+  if (Insts.empty())
+    return MutableArrayRef<MCDecodedInst>();
+  // The arrays are only ever appended: moving them along with InstArrays
+  // doesn't move their elements.
+  InstArrays.emplace_back(std::make_move_iterator(Insts.begin()),
+                          std::make_move_iterator(Insts.end()));
+  return InstArrays.back();
+}
+
+void MCFunction::releaseInsts() {
+  InstsReleased = true;
+  std::vector<uint8_t>().swap(PackedInsts);
+  BasicBlockListTy().swap(SortedBlocks);
+  if (Blocks.empty())
+    return;
+  for (size_t I = 1, E = Blocks.size(); I != E; ++I)
+    Blocks[I]->~MCBasicBlock();
+  // The entry block moves to a chunk of its own, for the others to be freed.
+  MCBasicBlock *OldEntry = Blocks.front();
+  MCBasicBlock *Entry = static_cast<MCBasicBlock *>(
+      ::operator new(sizeof(MCBasicBlock)));
+  new (Entry) MCBasicBlock(OldEntry->StartAddr, this, 0);
+  Entry->Name = std::move(OldEntry->Name);
+  Entry->SizeInBytes = OldEntry->SizeInBytes;
+  Entry->NextInstAddress = OldEntry->NextInstAddress;
+  OldEntry->~MCBasicBlock();
+  for (MCBasicBlock *Chunk : BlockChunks)
+    ::operator delete(Chunk);
+  BlockChunks.assign(1, Entry);
+  NextBlock = BlocksEnd = Entry + 1;
+  BasicBlockListTy(1, Entry).swap(Blocks);
+  std::vector<std::vector<MCDecodedInst>>().swap(InstArrays);
+  std::vector<uint32_t>().swap(Edges);
+}
+
+void MCFunction::setEdges(std::vector<uint32_t> NewEdges,
+                          ArrayRef<uint32_t> EdgeBegins) {
+  assert(EdgeBegins.size() == 2 * Blocks.size() + 1 &&
+         EdgeBegins.back() == NewEdges.size() && "Invalid edge ranges!");
+  Edges = std::move(NewEdges);
+  const uint32_t *Data = Edges.data();
+  for (size_t I = 0, E = Blocks.size(); I != E; ++I) {
+    MCBasicBlock *BB = Blocks[I];
+    std::vector<uint32_t>().swap(BB->OwnedEdges);
+    BB->EdgesBegin = Data + EdgeBegins[2 * I];
+    BB->PredsBegin = Data + EdgeBegins[2 * I + 1];
+    BB->EdgesEnd = Data + EdgeBegins[2 * I + 2];
+  }
+}
+
+void MCFunction::setSuccessors(ArrayRef<uint32_t> Succs,
+                               ArrayRef<uint32_t> SuccBegins) {
+  const size_t NumBlocks = Blocks.size();
+  assert(SuccBegins.size() == NumBlocks + 1 &&
+         SuccBegins.back() == Succs.size() && "Invalid successor ranges!");
+  std::vector<uint32_t> NextPred(NumBlocks);
+  for (uint32_t Succ : Succs)
+    ++NextPred[Succ];
+  std::vector<uint32_t> EdgeBegins(2 * NumBlocks + 1);
+  uint32_t NumEdges = 0;
+  for (size_t I = 0; I != NumBlocks; ++I) {
+    EdgeBegins[2 * I] = NumEdges;
+    NumEdges += SuccBegins[I + 1] - SuccBegins[I];
+    EdgeBegins[2 * I + 1] = NumEdges;
+    NumEdges += NextPred[I];
+    NextPred[I] = EdgeBegins[2 * I + 1];
+  }
+  EdgeBegins[2 * NumBlocks] = NumEdges;
+
+  // Visiting the blocks in order puts their predecessors in order.
+  std::vector<uint32_t> NewEdges(NumEdges);
+  for (size_t I = 0; I != NumBlocks; ++I) {
+    uint32_t *Out = &NewEdges[EdgeBegins[2 * I]];
+    for (size_t SI = SuccBegins[I], SE = SuccBegins[I + 1]; SI != SE; ++SI) {
+      *Out++ = Succs[SI];
+      NewEdges[NextPred[Succs[SI]]++] = I;
+    }
+  }
+  setEdges(std::move(NewEdges), EdgeBegins);
+}
+
+void MCFunction::finalizeEdges() {
+  std::vector<uint32_t> NewEdges, EdgeBegins;
+  EdgeBegins.reserve(2 * Blocks.size() + 1);
+  for (const MCBasicBlock *BB : Blocks) {
+    EdgeBegins.push_back(NewEdges.size());
+    NewEdges.insert(NewEdges.end(), BB->EdgesBegin, BB->PredsBegin);
+    EdgeBegins.push_back(NewEdges.size());
+    NewEdges.insert(NewEdges.end(), BB->PredsBegin, BB->EdgesEnd);
+  }
+  EdgeBegins.push_back(NewEdges.size());
+  setEdges(std::move(NewEdges), EdgeBegins);
+}
+
+void MCFunction::copyBlocks(const MCFunction &Src) {
+  assert(Blocks.empty() && "Copying blocks into a function with blocks!");
+  assert(!Src.areInstsPacked() && !Src.areInstsReleased() &&
+         "Copying blocks without instructions!");
+  std::vector<MCDecodedInst> Insts;
+  for (const MCBasicBlock *BB : Src)
+    Insts.insert(Insts.end(), BB->begin(), BB->end());
+  MutableArrayRef<MCDecodedInst> Owned = moveInsts(Insts);
+
+  reserveBlocks(Src.size());
+  std::vector<uint32_t> NewEdges, EdgeBegins;
+  EdgeBegins.reserve(2 * Src.size() + 1);
+  size_t Begin = 0;
+  for (const MCBasicBlock *SrcBB : Src) {
+    MCBasicBlock &BB = createBlock(SrcBB->getStartAddr());
+    BB.setInsts(Owned.data() + Begin, Owned.data() + Begin + SrcBB->size(),
+                SrcBB->getSizeInBytes());
+    Begin += SrcBB->size();
+    EdgeBegins.push_back(NewEdges.size());
+    NewEdges.insert(NewEdges.end(), SrcBB->succ_indices().begin(),
+                    SrcBB->succ_indices().end());
+    EdgeBegins.push_back(NewEdges.size());
+    NewEdges.insert(NewEdges.end(), SrcBB->pred_indices().begin(),
+                    SrcBB->pred_indices().end());
+  }
+  EdgeBegins.push_back(NewEdges.size());
+  setEdges(std::move(NewEdges), EdgeBegins);
+  TailCalls = Src.TailCalls;
+}
+
+// The operand kinds of packed instructions.
+enum PackedOperandKind { POK_Invalid, POK_Reg, POK_Imm, POK_FPImm };
+
+bool MCFunction::packInsts() {
+  if (areInstsPacked() || InstsReleased)
+    return true;
+  SmallString<256> Packed;
+  raw_svector_ostream OS(Packed);
+  for (const MCBasicBlock *BB : Blocks) {
+    encodeULEB128(BB->size(), OS);
+    // The instructions mostly follow each other: their address is the delta
+    // from the end of the previous one.
+    uint64_t NextAddr = BB->getStartAddr();
+    for (const MCDecodedInst &I : *BB) {
+      encodeSLEB128(I.Address - NextAddr, OS);
+      encodeULEB128(I.Size, OS);
+      encodeULEB128(I.Inst.getOpcode(), OS);
+      encodeULEB128(I.Inst.getNumOperands(), OS);
+      for (const MCOperand &Op : I.Inst) {
+        if (Op.isReg()) {
+          OS << char(POK_Reg);
+          encodeULEB128(Op.getReg(), OS);
+        } else if (Op.isImm()) {
+          OS << char(POK_Imm);
+          encodeSLEB128(Op.getImm(), OS);
+        } else if (Op.isFPImm()) {
+          OS << char(POK_FPImm);
+          encodeULEB128(DoubleToBits(Op.getFPImm()), OS);
+        } else if (!Op.isValid()) {
+          OS << char(POK_Invalid);
+        } else {
+          return false;
+        }
+      }
+      NextAddr = I.Address + I.Size;
+    }
+  }
+  if (Packed.empty())
+    return true;
+
+  PackedInsts.assign(Packed.begin(), Packed.end());
+  for (MCBasicBlock *BB : Blocks) {
+    BB->InstsBegin = BB->InstsEnd = nullptr;
+    std::vector<MCDecodedInst>().swap(BB->OwnedInsts);
+  }
+  std::vector<std::vector<MCDecodedInst>>().swap(InstArrays);
+  return true;
+}
+
+void MCFunction::unpackInsts() {
+  if (!areInstsPacked())
+    return;
+  const uint8_t *P = PackedInsts.data();
+  auto ReadU = [&]() {
+    unsigned N;
+    uint64_t V = decodeULEB128(P, &N);
+    P += N;
+    return V;
+  };
+  auto ReadS = [&]() {
+    unsigned N;
+    int64_t V = decodeSLEB128(P, &N);
+    P += N;
+    return V;
+  };
+
+  std::vector<MCDecodedInst> Insts;
+  std::vector<size_t> BlockEnds;
+  for (const MCBasicBlock *BB : Blocks) {
+    uint64_t NextAddr = BB->getStartAddr();
+    for (uint64_t NumInsts = ReadU(); NumInsts; --NumInsts) {
+      const uint64_t Addr = NextAddr + ReadS();
+      const uint64_t Size = ReadU();
+      MCInst Inst;
+      Inst.setOpcode(ReadU());
+      for (uint64_t NumOps = ReadU(); NumOps; --NumOps) {
+        switch (*P++) {
+        case POK_Reg: Inst.addOperand(MCOperand::createReg(ReadU())); break;
+        case POK_Imm: Inst.addOperand(MCOperand::createImm(ReadS())); break;
+        case POK_FPImm:
+          Inst.addOperand(MCOperand::createFPImm(BitsToDouble(ReadU())));
+          break;
+        default: Inst.addOperand(MCOperand()); break;
+        }
+      }
+      Insts.push_back(MCDecodedInst(Inst, Addr, Size));
+      NextAddr = Addr + Size;
+    }
+    BlockEnds.push_back(Insts.size());
+  }
+  assert(P == PackedInsts.data() + PackedInsts.size() &&
+         "Packed instructions don't match the blocks!");
+  std::vector<uint8_t>().swap(PackedInsts);
+
+  MutableArrayRef<MCDecodedInst> Owned = moveInsts(Insts);
+  size_t Begin = 0;
+  for (size_t I = 0, E = Blocks.size(); I != E; ++I) {
+    MCBasicBlock *BB = Blocks[I];
+    BB->setInsts(Owned.data() + Begin, Owned.data() + BlockEnds[I],
+                 BB->SizeInBytes);
+    Begin = BlockEnds[I];
+  }
+}
+
+const MCFunction::BasicBlockListTy &MCFunction::getSortedBlocks() const {
+  // Blocks are only ever appended, but by releaseInsts.
+  if (SortedBlocks.size() != Blocks.size()) {
+    SortedBlocks = Blocks;
+    std::sort(SortedBlocks.begin(), SortedBlocks.end(),
+              [](const MCBasicBlock *L, const MCBasicBlock *R) {
+                return L->getStartAddr() < R->getStartAddr();
+              });
+  }
+  return SortedBlocks;
+}
+
+static bool startsBefore(const MCBasicBlock *BB, uint64_t Addr) {
+  return BB->getStartAddr() < Addr;
 }
 
 MCBasicBlock *MCFunction::find(uint64_t StartAddr) {
-  for (auto BB : *this)
-    if (BB->getStartAddr() == StartAddr)
-      return BB;
+  const BasicBlockListTy &Sorted = getSortedBlocks();
+  auto I = std::lower_bound(Sorted.begin(), Sorted.end(), StartAddr,
+                            startsBefore);
+  if (I != Sorted.end() && (*I)->getStartAddr() == StartAddr)
+    return const_cast<MCBasicBlock *>(*I);
   return nullptr;
 }
 
@@ -36,10 +292,15 @@ const MCBasicBlock *MCFunction::find(uint64_t StartAddr) const {
 }
 
 MCBasicBlock *MCFunction::findContaining(uint64_t Addr) {
-  for (auto BB : *this)
-    if (BB->getStartAddr() <= Addr && BB->getEndAddr() > Addr)
-      return BB;
-  return nullptr;
+  // The blocks don't overlap: only the last one starting at or before Addr
+  // can contain it.
+  const BasicBlockListTy &Sorted = getSortedBlocks();
+  auto I = std::upper_bound(
+      Sorted.begin(), Sorted.end(), Addr,
+      [](uint64_t A, const MCBasicBlock *BB) { return A < BB->getStartAddr(); });
+  if (I == Sorted.begin() || (*(I - 1))->getEndAddr() <= Addr)
+    return nullptr;
+  return const_cast<MCBasicBlock *>(*(I - 1));
 }
 
 const MCBasicBlock *MCFunction::findContaining(uint64_t Addr) const {
@@ -47,53 +308,129 @@ const MCBasicBlock *MCFunction::findContaining(uint64_t Addr) const {
 }
 
 MCBasicBlock *MCFunction::findFirstAfter(uint64_t Addr) {
-  MCBasicBlock *FirstAfter = nullptr;
-  for (auto BB : *this)
-    if (BB->getStartAddr() > Addr)
-      if (!FirstAfter || FirstAfter->getStartAddr() > BB->getStartAddr())
-        FirstAfter = BB;
-  return FirstAfter;
+  const BasicBlockListTy &Sorted = getSortedBlocks();
+  auto I = std::upper_bound(
+      Sorted.begin(), Sorted.end(), Addr,
+      [](uint64_t A, const MCBasicBlock *BB) { return A < BB->getStartAddr(); });
+  return I == Sorted.end() ? nullptr : const_cast<MCBasicBlock *>(*I);
 }
 
 const MCBasicBlock *MCFunction::findFirstAfter(uint64_t Addr) const {
   return const_cast<MCFunction *>(this)->findFirstAfter(Addr);
 }
 
+void MCFunction::reserveBlocks(size_t NumBlocks) {
+  if (size_t(BlocksEnd - NextBlock) >= NumBlocks)
+    return;
+  NextBlock = static_cast<MCBasicBlock *>(
+      ::operator new(NumBlocks * sizeof(MCBasicBlock)));
+  BlocksEnd = NextBlock + NumBlocks;
+  BlockChunks.push_back(NextBlock);
+}
+
 MCBasicBlock &MCFunction::createBlock(uint64_t StartAddr) {
-  Blocks.push_back(new MCBasicBlock(StartAddr, this));
-  return *Blocks.back();
+  if (NextBlock == BlocksEnd)
+    reserveBlocks(std::max<size_t>(1, std::min<size_t>(Blocks.size(), 256)));
+  MCBasicBlock *BB =
+      new (NextBlock++) MCBasicBlock(StartAddr, this, Blocks.size());
+  Blocks.push_back(BB);
+  return *BB;
 }
 
 // MCBasicBlock
 
-MCBasicBlock::MCBasicBlock(uint64_t StartAddr, MCFunction *Parent)
-    : StartAddr(StartAddr), SizeInBytes(0), InstCount(0),
-      NextInstAddress(StartAddr), Parent(Parent) {
+MCBasicBlock::MCBasicBlock(uint64_t StartAddr, MCFunction *Parent,
+                           uint32_t Index)
+    : InstsBegin(nullptr), InstsEnd(nullptr), StartAddr(StartAddr),
+      SizeInBytes(0), NextInstAddress(StartAddr), Parent(Parent),
+      Index(Index), EdgesBegin(nullptr), PredsBegin(nullptr),
+      EdgesEnd(nullptr) {
+}
+
+void MCBasicBlock::setInsts(MCDecodedInst *Begin, MCDecodedInst *End,
+                            uint64_t Size) {
+  OwnedInsts.clear();
+  InstsBegin = Begin;
+  InstsEnd = End;
+  SizeInBytes = Size;
+  NextInstAddress = StartAddr + Size;
+}
+
+size_t MCBasicBlock::removeInsts(
+    function_ref<bool(const MCDecodedInst &)> ShouldRemove) {
+  MCDecodedInst *NewEnd = std::remove_if(InstsBegin, InstsEnd, ShouldRemove);
+  const size_t NumRemoved = InstsEnd - NewEnd;
+  if (InstsBegin == OwnedInsts.data()) {
+    OwnedInsts.erase(OwnedInsts.begin() + (NewEnd - InstsBegin),
+                     OwnedInsts.end());
+    InstsBegin = OwnedInsts.data();
+    NewEnd = InstsBegin + OwnedInsts.size();
+  }
+  InstsEnd = NewEnd;
+  return NumRemoved;
+}
+
+const MCDecodedInst *MCBasicBlock::findInst(uint64_t Addr) const {
+  const MCDecodedInst *I = std::upper_bound(
+      begin(), end(), Addr,
+      [](uint64_t A, const MCDecodedInst &Inst) { return A < Inst.Address; });
+  if (I == begin() || (I - 1)->Address + (I - 1)->Size <= Addr)
+    return nullptr;
+  return I - 1;
+}
+
+void MCBasicBlock::ownEdges() {
+  // If the edges live elsewhere, we need our own copy to grow it.
+  if (EdgesBegin == OwnedEdges.data())
+    return;
+  const size_t NumSuccs = succ_size();
+  OwnedEdges.assign(EdgesBegin, EdgesEnd);
+  EdgesBegin = OwnedEdges.data();
+  PredsBegin = EdgesBegin + NumSuccs;
+  EdgesEnd = EdgesBegin + OwnedEdges.size();
 }
 
 void MCBasicBlock::addSuccessor(const MCBasicBlock *MCBB) {
-  if (!isSuccessor(MCBB))
-    Successors.push_back(MCBB);
+  assert(MCBB->Parent == Parent && "Edge to another function!");
+  if (isSuccessor(MCBB))
+    return;
+  ownEdges();
+  const size_t NumSuccs = succ_size();
+  OwnedEdges.insert(OwnedEdges.begin() + NumSuccs, MCBB->Index);
+  EdgesBegin = OwnedEdges.data();
+  PredsBegin = EdgesBegin + NumSuccs + 1;
+  EdgesEnd = EdgesBegin + OwnedEdges.size();
 }
 
 bool MCBasicBlock::isSuccessor(const MCBasicBlock *MCBB) const {
-  return std::find(Successors.begin(), Successors.end(),
-                   MCBB) != Successors.end();
+  return MCBB->Parent == Parent &&
+         std::find(EdgesBegin, PredsBegin, MCBB->Index) != PredsBegin;
 }
 
 void MCBasicBlock::addPredecessor(const MCBasicBlock *MCBB) {
-  if (!isPredecessor(MCBB))
-    Predecessors.push_back(MCBB);
+  assert(MCBB->Parent == Parent && "Edge from another function!");
+  if (isPredecessor(MCBB))
+    return;
+  ownEdges();
+  const size_t NumSuccs = succ_size();
+  OwnedEdges.push_back(MCBB->Index);
+  EdgesBegin = OwnedEdges.data();
+  PredsBegin = EdgesBegin + NumSuccs;
+  EdgesEnd = EdgesBegin + OwnedEdges.size();
 }
 
 bool MCBasicBlock::isPredecessor(const MCBasicBlock *MCBB) const {
-  return std::find(Predecessors.begin(), Predecessors.end(),
-                   MCBB) != Predecessors.end();
+  return MCBB->Parent == Parent &&
+         std::find(PredsBegin, EdgesEnd, MCBB->Index) != EdgesEnd;
 }
 
 void MCBasicBlock::addInst(const MCInst &I, uint64_t InstSize) {
-  Insts.push_back(MCDecodedInst(I, NextInstAddress, InstSize));
+  // If the instructions live elsewhere, we need our own copy to grow it.
+  if (InstsBegin != OwnedInsts.data())
+    OwnedInsts.assign(InstsBegin, InstsEnd);
+  OwnedInsts.push_back(MCDecodedInst(I, NextInstAddress, InstSize));
+  InstsBegin = OwnedInsts.data();
+  InstsEnd = InstsBegin + OwnedInsts.size();
   NextInstAddress += InstSize;
   SizeInBytes += InstSize;
-  ++InstCount;
 }
@@ -0,0 +1,84 @@
+//===- lib/MC/MCAnalysis/MCFunctionRangeMap.cpp ---------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MC/MCAnalysis/MCFunctionRangeMap.h"
+#include <algorithm>
+#include <cassert>
+#include <functional>
+
+using namespace llvm;
+
+MCFunctionRangeMap::MCFunctionRangeMap(std::vector<uint64_t> Starts)
+    : Starts(std::move(Starts)) {
+  // The starts read from LC_FUNCTION_STARTS are strictly increasing already.
+  if (std::adjacent_find(this->Starts.begin(), this->Starts.end(),
+                         std::greater_equal<uint64_t>()) ==
+      this->Starts.end())
+    return;
+  std::sort(this->Starts.begin(), this->Starts.end());
+  this->Starts.erase(std::unique(this->Starts.begin(), this->Starts.end()),
+                     this->Starts.end());
+}
+
+void MCFunctionRangeMap::setEnds(std::vector<uint64_t> NewEnds) {
+  Ends = std::move(NewEnds);
+  std::sort(Ends.begin(), Ends.end());
+  Ends.erase(std::unique(Ends.begin(), Ends.end()), Ends.end());
+}
+
+uint64_t MCFunctionRangeMap::getNextBoundary(uint64_t Addr) const {
+  const_iterator NextStart = findNextStart(Addr);
+  auto NextEnd = std::upper_bound(Ends.begin(), Ends.end(), Addr);
+  uint64_t Boundary = NextStart == end() ? UINT64_MAX : *NextStart;
+  if (NextEnd != Ends.end())
+    Boundary = std::min(Boundary, *NextEnd);
+  return Boundary;
+}
+
+MCFunctionRangeMap::const_iterator
+MCFunctionRangeMap::find(uint64_t Addr) const {
+  const_iterator I = std::lower_bound(begin(), end(), Addr);
+  if (I != end() && *I == Addr)
+    return I;
+  return end();
+}
+
+MCFunctionRangeMap::const_iterator
+MCFunctionRangeMap::findContaining(uint64_t Addr) const {
+  const_iterator I = findNextStart(Addr);
+  if (I == begin())
+    return end();
+  return --I;
+}
+
+MCFunctionRangeMap::const_iterator
+MCFunctionRangeMap::findNextStart(uint64_t Addr) const {
+  return std::upper_bound(begin(), end(), Addr);
+}
+
+std::pair<uint64_t, uint64_t>
+MCFunctionRangeMap::getShardRange(unsigned Shard, unsigned NumShards,
+                                  uint64_t EndAddr) const {
+  assert(Shard < NumShards && "Shard out of range");
+  // The start of the first function at least Size * K / NumShards bytes
+  // after the first one.
+  auto getBoundary = [&](unsigned K) -> uint64_t {
+    if (K == 0)
+      return 0;
+    if (K == NumShards || empty())
+      return UINT64_MAX;
+    const uint64_t Size = std::max(EndAddr, Starts.back() + 1) - Starts.front();
+    // Without overflowing, as Size * K might.
+    const uint64_t Offset =
+        Size / NumShards * K + Size % NumShards * K / NumShards;
+    const_iterator I = std::lower_bound(begin(), end(), Starts.front() + Offset);
+    return I == end() ? UINT64_MAX : *I;
+  };
+  return std::make_pair(getBoundary(Shard), getBoundary(Shard + 1));
+}
@@ -0,0 +1,18 @@
+//===- lib/MC/MCAnalysis/MCLoopInfo.cpp - MC CFG natural loops ------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MC/MCAnalysis/MCLoopInfo.h"
+#include "llvm/Analysis/LoopInfoImpl.h"
+
+using namespace llvm;
+
+void MCLoopInfo::recalculate(const MCDominatorTree &DT) {
+  releaseMemory();
+  analyze(DT);
+}
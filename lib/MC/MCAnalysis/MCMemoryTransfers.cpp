@@ -0,0 +1,186 @@
+//===- lib/MC/MCAnalysis/MCMemoryTransfers.cpp - Block copies and clears --===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MC/MCAnalysis/MCMemoryTransfers.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/BitVector.h"
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCInstrAnalysis.h"
+#include "llvm/MC/MCRegisterInfo.h"
+#include <algorithm>
+
+using namespace llvm;
+
+typedef MCInstrAnalysis::MemoryPair MemoryPair;
+
+/// \brief Check whether \p Pairs cover a block without gaps or overlaps.
+/// Return true if they do, and the block in \p Begin and \p Size.
+static bool isContiguous(ArrayRef<MemoryPair> Pairs, int64_t &Begin,
+                         uint64_t &Size) {
+  SmallVector<std::pair<int64_t, int64_t>, 8> Ranges;
+  for (const MemoryPair &P : Pairs)
+    Ranges.push_back(std::make_pair(P.Offset, P.Offset + 2 * P.RegSize));
+  std::sort(Ranges.begin(), Ranges.end());
+  Begin = Ranges.front().first;
+  int64_t End = Begin;
+  for (const auto &R : Ranges) {
+    if (R.first != End)
+      return false;
+    End = R.second;
+  }
+  Size = End - Begin;
+  return true;
+}
+
+namespace {
+/// \brief The runs of a block, found from its pairs.
+class BlockScanner {
+  const MCBasicBlock &BB;
+  const MCRegisterInfo &MRI;
+  const unsigned MinStores;
+  /// \brief The pair of each instruction of the block, and whether it is
+  /// one.
+  SmallVector<MemoryPair, 16> Pairs;
+  SmallVector<bool, 16> IsPair;
+
+  bool isClearAt(size_t I, unsigned BaseReg) const {
+    return IsPair[I] && Pairs[I].StoresZero && Pairs[I].BaseReg == BaseReg;
+  }
+
+  void setRange(MCMemoryTransfers::Transfer &T, size_t Begin,
+                size_t End) const {
+    T.BeginAddr = BB.begin()[Begin].Address;
+    T.EndAddr = BB.begin()[End - 1].Address + BB.begin()[End - 1].Size;
+  }
+
+public:
+  BlockScanner(const MCBasicBlock &BB, const MCInstrAnalysis &MIA,
+               const MCRegisterInfo &MRI, unsigned MinStores)
+      : BB(BB), MRI(MRI), MinStores(MinStores), Pairs(BB.size()),
+        IsPair(BB.size()) {
+    for (size_t I = 0, E = BB.size(); I != E; ++I)
+      IsPair[I] = MIA.evaluateMemoryPair(BB.begin()[I].Inst, Pairs[I]);
+  }
+
+  size_t size() const { return Pairs.size(); }
+
+  /// \brief Find a clear starting at \p I. Return the index of the
+  /// instruction after it, and the clear in \p T, or 0.
+  size_t findClear(size_t I, MCMemoryTransfers::Transfer &T) const {
+    if (!IsPair[I] || !Pairs[I].StoresZero)
+      return 0;
+    const unsigned BaseReg = Pairs[I].BaseReg;
+    size_t End = I;
+    while (End != size() && isClearAt(End, BaseReg))
+      ++End;
+    if (End - I < MinStores ||
+        !isContiguous(makeArrayRef(Pairs).slice(I, End - I), T.DstOffset,
+                      T.Size))
+      return 0;
+    setRange(T, I, End);
+    T.DstBaseReg = BaseReg;
+    T.SrcBaseReg = 0;
+    T.SrcOffset = 0;
+    return End;
+  }
+
+  /// \brief Find a copy starting at \p I. Return the index of the
+  /// instruction after it, and the copy in \p T, or 0.
+  size_t findCopy(size_t I, MCMemoryTransfers::Transfer &T) const {
+    if (!IsPair[I] || !Pairs[I].IsLoad)
+      return 0;
+    // The loads, into distinct registers that aren't their base, and the
+    // offset each register is loaded from.
+    const unsigned SrcBaseReg = Pairs[I].BaseReg;
+    BitVector Loaded(MRI.getNumRegs());
+    DenseMap<unsigned, int64_t> LoadOffsets;
+    size_t Stores = I;
+    for (; Stores != size() && IsPair[Stores] && Pairs[Stores].IsLoad &&
+           Pairs[Stores].BaseReg == SrcBaseReg;
+         ++Stores) {
+      const MemoryPair &P = Pairs[Stores];
+      for (unsigned R = 0; R != 2; ++R) {
+        if (Loaded.test(P.Regs[R]))
+          return 0;
+        for (MCRegAliasIterator AI(P.Regs[R], &MRI, true); AI.isValid(); ++AI)
+          Loaded.set(*AI);
+        if (Loaded.test(SrcBaseReg))
+          return 0;
+        LoadOffsets[P.Regs[R]] = P.Offset + R * P.RegSize;
+      }
+    }
+
+    // The stores of all the loaded registers, once each.
+    if (Stores == size() || !IsPair[Stores] || Pairs[Stores].IsLoad)
+      return 0;
+    const unsigned DstBaseReg = Pairs[Stores].BaseReg;
+    if (Loaded.test(DstBaseReg))
+      return 0;
+    T.Regs.clear();
+    size_t End = Stores;
+    for (; End != size() && T.Regs.size() != LoadOffsets.size(); ++End) {
+      const MemoryPair &P = Pairs[End];
+      if (!IsPair[End] || P.IsLoad || P.BaseReg != DstBaseReg)
+        return 0;
+      for (unsigned R = 0; R != 2; ++R) {
+        if (!LoadOffsets.count(P.Regs[R]))
+          return 0;
+        T.Regs.push_back(std::make_pair(P.Regs[R], P.Offset + R * P.RegSize));
+      }
+    }
+    if (End - Stores < MinStores || T.Regs.size() != LoadOffsets.size())
+      return 0;
+
+    // The blocks are the same size, and each register lands at the offset
+    // it was loaded from.
+    uint64_t StoreSize;
+    if (!isContiguous(makeArrayRef(Pairs).slice(I, Stores - I), T.SrcOffset,
+                      T.Size) ||
+        !isContiguous(makeArrayRef(Pairs).slice(Stores, End - Stores),
+                      T.DstOffset, StoreSize) ||
+        StoreSize != T.Size)
+      return 0;
+    for (const auto &RegOffset : T.Regs) {
+      // Each register is stored once.
+      auto LI = LoadOffsets.find(RegOffset.first);
+      if (LI == LoadOffsets.end() ||
+          LI->second - T.SrcOffset != RegOffset.second - T.DstOffset)
+        return 0;
+      LoadOffsets.erase(LI);
+    }
+    setRange(T, I, End);
+    T.DstBaseReg = DstBaseReg;
+    T.SrcBaseReg = SrcBaseReg;
+    return End;
+  }
+};
+} // end anonymous namespace
+
+void MCMemoryTransfers::analyze(const MCFunction &F,
+                                const MCInstrAnalysis &MIA,
+                                const MCRegisterInfo &MRI,
+                                unsigned MinStores) {
+  clear();
+  for (const MCBasicBlock *BB : F) {
+    BlockScanner Scanner(*BB, MIA, MRI, MinStores);
+    for (size_t I = 0, E = Scanner.size(); I != E;) {
+      Transfer T;
+      size_t End = Scanner.findClear(I, T);
+      if (!End)
+        End = Scanner.findCopy(I, T);
+      if (!End) {
+        ++I;
+        continue;
+      }
+      for (; I != End; ++I)
+        InstTransfers[BB->begin()[I].Address] = Transfers.size();
+      Transfers.push_back(std::move(T));
+    }
+  }
+}
@@ -11,12 +11,15 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/MC/MCAnalysis/MCFunction.h"
 #include <algorithm>
+#include <iterator>
+#include <memory>
 
 using namespace llvm;
 
 MCFunction *MCModule::createFunction(StringRef Name, uint64_t BeginAddr) {
   std::unique_ptr<MCFunction> MCF(new MCFunction(Name, this));
   FunctionsByAddr.insert(std::make_pair(BeginAddr, MCF.get()));
+  FunctionRangeListTy().swap(AddressIndex);
   Functions.push_back(std::move(MCF));
   return Functions.back().get();
 }
@@ -28,7 +31,121 @@ MCFunction *MCModule::findFunctionAt(uint64_t BeginAddr) {
   return FnIt->second;
 }
 
-MCModule::MCModule() {}
+const MCModule::FunctionRangeListTy &MCModule::getAddressIndex() const {
+  if (!AddressIndex.empty())
+    return AddressIndex;
+  std::vector<std::pair<uint64_t, uint64_t>> Blocks;
+  for (const auto &F : Functions) {
+    Blocks.clear();
+    for (const MCBasicBlock *BB : *F)
+      if (BB->getSizeInBytes())
+        Blocks.push_back(std::make_pair(BB->getStartAddr(), BB->getEndAddr()));
+    std::sort(Blocks.begin(), Blocks.end());
+    // Merge the contiguous blocks: most functions are a single range.
+    for (const auto &B : Blocks) {
+      if (!AddressIndex.empty() && AddressIndex.back().Function == F.get() &&
+          AddressIndex.back().End >= B.first) {
+        AddressIndex.back().End = std::max(AddressIndex.back().End, B.second);
+        continue;
+      }
+      FunctionRange R = {B.first, B.second, 0, F.get()};
+      AddressIndex.push_back(R);
+    }
+  }
+  std::sort(AddressIndex.begin(), AddressIndex.end(),
+            [](const FunctionRange &L, const FunctionRange &R) {
+              return L.Begin < R.Begin;
+            });
+  uint64_t MaxEnd = 0;
+  for (FunctionRange &R : AddressIndex)
+    R.MaxEnd = MaxEnd = std::max(MaxEnd, R.End);
+  return AddressIndex;
+}
+
+MCModule::AddressLocation
+MCModule::locate(FunctionRangeListTy::const_iterator I, uint64_t Addr) const {
+  AddressLocation Loc;
+  // The ranges can overlap: go back until none before can reach Addr.
+  while (I != AddressIndex.begin() && (I - 1)->MaxEnd > Addr) {
+    --I;
+    if (I->End <= Addr)
+      continue;
+    Loc.Function = I->Function;
+    Loc.Block = I->Function->findContaining(Addr);
+    if (Loc.Block)
+      Loc.Inst = Loc.Block->findInst(Addr);
+    break;
+  }
+  return Loc;
+}
+
+MCModule::AddressLocation MCModule::findContaining(uint64_t Addr) const {
+  const FunctionRangeListTy &Index = getAddressIndex();
+  auto I = std::upper_bound(
+      Index.begin(), Index.end(), Addr,
+      [](uint64_t A, const FunctionRange &R) { return A < R.Begin; });
+  return locate(I, Addr);
+}
+
+void MCModule::findContaining(ArrayRef<uint64_t> Addrs,
+                              std::vector<AddressLocation> &Locs) const {
+  const FunctionRangeListTy &Index = getAddressIndex();
+  std::vector<size_t> Order(Addrs.size());
+  for (size_t Q = 0, E = Addrs.size(); Q != E; ++Q)
+    Order[Q] = Q;
+  std::sort(Order.begin(), Order.end(),
+            [&](size_t L, size_t R) { return Addrs[L] < Addrs[R]; });
+  Locs.assign(Addrs.size(), AddressLocation());
+  auto I = Index.begin();
+  for (size_t Q : Order) {
+    while (I != Index.end() && I->Begin <= Addrs[Q])
+      ++I;
+    Locs[Q] = locate(I, Addrs[Q]);
+  }
+}
 
-MCModule::~MCModule() {
+// The heap memory of the string S, unless it fits inline.
+static size_t getHeapSize(const std::string &S) {
+  const char *Inline = reinterpret_cast<const char *>(&S);
+  if (S.data() >= Inline && S.data() < Inline + sizeof(S))
+    return 0;
+  return S.capacity() + 1;
 }
+
+// The heap memory of the operands of Inst, which only holds one inline.
+static size_t getHeapSize(const MCInst &Inst) {
+  return Inst.size() > 1 ? Inst.size() * sizeof(MCOperand) : 0;
+}
+
+MCModule::MemoryUsage MCModule::getMemoryUsage() const {
+  MemoryUsage Usage = {0, 0, 0};
+  Usage.Functions = Functions.capacity() * sizeof(Functions[0]) +
+                    FunctionsByAddr.getMemorySize() +
+                    AddressIndex.capacity() * sizeof(AddressIndex[0]);
+  for (const auto &F : Functions) {
+    Usage.Functions += sizeof(MCFunction) + getHeapSize(F->Name);
+    Usage.Insts += F->InstArrays.capacity() * sizeof(F->InstArrays[0]) +
+                   F->PackedInsts.capacity();
+    for (const std::vector<MCDecodedInst> &Insts : F->InstArrays) {
+      Usage.Insts += Insts.capacity() * sizeof(MCDecodedInst);
+      for (const MCDecodedInst &Inst : Insts)
+        Usage.Insts += getHeapSize(Inst.Inst);
+    }
+    Usage.Blocks += (F->Blocks.capacity() + F->SortedBlocks.capacity() +
+                     F->BlockChunks.capacity()) *
+                    sizeof(F->Blocks[0]);
+    Usage.Blocks += F->Edges.capacity() * sizeof(F->Edges[0]);
+    for (const MCBasicBlock *BB : F->Blocks) {
+      Usage.Blocks += sizeof(MCBasicBlock) + getHeapSize(BB->Name) +
+                      BB->OwnedEdges.capacity() * sizeof(BB->OwnedEdges[0]);
+      Usage.Insts += BB->OwnedInsts.capacity() * sizeof(MCDecodedInst);
+      for (const MCDecodedInst &Inst : BB->OwnedInsts)
+        Usage.Insts += getHeapSize(Inst.Inst);
+    }
+  }
+  return Usage;
+}
+
+MCModule::MCModule() {}
+
+MCModule::~MCModule() {}
@@ -0,0 +1,401 @@
+//===- MCModuleBinary.cpp - MCModule binary serialization -----------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines the compact binary representation of MCModule.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MC/MCAnalysis/MCModuleBinary.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCInstrInfo.h"
+#include "llvm/MC/MCRegisterInfo.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/MathExtras.h"
+#include <cstring>
+#include <vector>
+
+using namespace llvm;
+using namespace support;
+
+namespace {
+
+const char Magic[8] = {'M', 'C', 'C', 'F', 'G', 'B', 'I', 'N'};
+const uint32_t FormatVersion = 1;
+
+// All the records are made of unaligned little-endian integers: they have no
+// padding, and can be read in place anywhere in the file.
+struct HeaderRecord {
+  char Magic[8];
+  ulittle32_t Version;
+  // The size of the target enums, to detect another target description.
+  ulittle32_t NumOpcodes;
+  ulittle32_t NumRegs;
+  ulittle32_t TagSize;
+  ulittle64_t NumFunctions;
+  ulittle64_t NumBlocks;
+  ulittle64_t NumEdges;
+  ulittle64_t NumInsts;
+  ulittle64_t NumOperands;
+  ulittle64_t StringsSize;
+};
+
+struct FunctionRecord {
+  ulittle64_t BeginAddr;
+  ulittle64_t FirstBlock;
+  ulittle64_t NameOffset;
+  ulittle32_t NumBlocks;
+  ulittle32_t NameSize;
+};
+
+// The edges of a block are its successors, then its predecessors, as indices
+// of blocks of the same function.
+struct BlockRecord {
+  ulittle64_t StartAddr;
+  ulittle64_t SizeInBytes;
+  ulittle64_t FirstInst;
+  ulittle64_t FirstEdge;
+  ulittle32_t NumInsts;
+  ulittle32_t NumSuccs;
+  ulittle32_t NumPreds;
+  ulittle32_t Reserved;
+};
+
+struct EdgeRecord {
+  ulittle32_t Block;
+};
+
+struct InstRecord {
+  ulittle64_t Address;
+  ulittle64_t FirstOperand;
+  ulittle32_t Opcode;
+  ulittle16_t Size;
+  ulittle16_t NumOperands;
+};
+
+enum OperandKind { OK_Invalid, OK_Reg, OK_Imm, OK_FPImm };
+
+struct OperandRecord {
+  ulittle32_t Kind;
+  ulittle32_t Reserved;
+  ulittle64_t Value;
+};
+
+template <typename RecordTy> void writeRecord(raw_ostream &OS, RecordTy &R) {
+  OS.write(reinterpret_cast<const char *>(&R), sizeof(R));
+}
+
+} // end unnamed namespace
+
+namespace llvm {
+
+// MCModule and MCBasicBlock befriend this, to rebuild modules as they were.
+class MCModuleBinaryIO {
+public:
+  static StringRef write(raw_ostream &OS, const MCModule &MCM,
+                         const MCInstrInfo &MII, const MCRegisterInfo &MRI,
+                         StringRef Tag);
+  static StringRef read(std::unique_ptr<MCModule> &MCM, StringRef Data,
+                        const MCInstrInfo &MII, const MCRegisterInfo &MRI,
+                        StringRef Tag);
+};
+
+} // end namespace llvm
+
+StringRef MCModuleBinaryIO::write(raw_ostream &OS, const MCModule &MCM,
+                                  const MCInstrInfo &MII,
+                                  const MCRegisterInfo &MRI, StringRef Tag) {
+  // Functions don't know their address, only their module does.
+  DenseMap<const MCFunction *, uint64_t> BeginAddrs;
+  for (const auto &AddrFn : MCM.FunctionsByAddr)
+    BeginAddrs[AddrFn.second] = AddrFn.first;
+
+  HeaderRecord H;
+  std::memset(&H, 0, sizeof(H));
+  std::memcpy(H.Magic, Magic, sizeof(Magic));
+  H.Version = FormatVersion;
+  H.NumOpcodes = MII.getNumOpcodes();
+  H.NumRegs = MRI.getNumRegs();
+  H.TagSize = Tag.size();
+  uint64_t NumBlocks = 0, NumEdges = 0, NumInsts = 0, NumOperands = 0;
+  uint64_t StringsSize = Tag.size();
+  for (const auto &MCFN : MCM.funcs()) {
+    StringsSize += MCFN->getName().size();
+    for (const MCBasicBlock *BB : *MCFN) {
+      ++NumBlocks;
+      NumEdges += BB->succ_size() + BB->pred_size();
+      NumInsts += BB->size();
+      for (const MCDecodedInst &I : *BB) {
+        if (I.Size > UINT16_MAX || I.Inst.getNumOperands() > UINT16_MAX)
+          return "Instruction too large for the binary format.";
+        // FIXME: Like YAML, doesn't support expr/inst operands; the
+        // disassemblers don't create them.
+        for (const MCOperand &Op : I.Inst)
+          if (Op.isExpr() || Op.isInst())
+            return "Expression operands aren't supported.";
+        NumOperands += I.Inst.getNumOperands();
+      }
+    }
+  }
+  H.NumFunctions = MCM.Functions.size();
+  H.NumBlocks = NumBlocks;
+  H.NumEdges = NumEdges;
+  H.NumInsts = NumInsts;
+  H.NumOperands = NumOperands;
+  H.StringsSize = StringsSize;
+  writeRecord(OS, H);
+
+  uint64_t FirstBlock = 0, NameOffset = Tag.size();
+  for (const auto &MCFN : MCM.funcs()) {
+    FunctionRecord R;
+    auto It = BeginAddrs.find(MCFN.get());
+    if (It != BeginAddrs.end())
+      R.BeginAddr = It->second;
+    else
+      R.BeginAddr = MCFN->empty() ? 0 : MCFN->getEntryBlock()->getStartAddr();
+    R.FirstBlock = FirstBlock;
+    R.NameOffset = NameOffset;
+    R.NumBlocks = MCFN->size();
+    R.NameSize = MCFN->getName().size();
+    writeRecord(OS, R);
+    FirstBlock += MCFN->size();
+    NameOffset += MCFN->getName().size();
+  }
+
+  uint64_t FirstInst = 0, FirstEdge = 0;
+  for (const auto &MCFN : MCM.funcs()) {
+    for (const MCBasicBlock *BB : *MCFN) {
+      BlockRecord R;
+      R.StartAddr = BB->getStartAddr();
+      R.SizeInBytes = BB->getSizeInBytes();
+      R.FirstInst = FirstInst;
+      R.FirstEdge = FirstEdge;
+      R.NumInsts = BB->size();
+      R.NumSuccs = BB->succ_size();
+      R.NumPreds = BB->pred_size();
+      R.Reserved = 0;
+      writeRecord(OS, R);
+      FirstInst += BB->size();
+      FirstEdge += BB->succ_size() + BB->pred_size();
+    }
+  }
+
+  // The edges already are block indices, in the same order.
+  for (const auto &MCFN : MCM.funcs()) {
+    for (const MCBasicBlock *BB : *MCFN) {
+      for (uint32_t Other : BB->succ_indices()) {
+        EdgeRecord R;
+        R.Block = Other;
+        writeRecord(OS, R);
+      }
+      for (uint32_t Other : BB->pred_indices()) {
+        EdgeRecord R;
+        R.Block = Other;
+        writeRecord(OS, R);
+      }
+    }
+  }
+
+  uint64_t FirstOperand = 0;
+  for (const auto &MCFN : MCM.funcs()) {
+    for (const MCBasicBlock *BB : *MCFN) {
+      for (const MCDecodedInst &I : *BB) {
+        InstRecord R;
+        R.Address = I.Address;
+        R.FirstOperand = FirstOperand;
+        R.Opcode = I.Inst.getOpcode();
+        R.Size = I.Size;
+        R.NumOperands = I.Inst.getNumOperands();
+        writeRecord(OS, R);
+        FirstOperand += I.Inst.getNumOperands();
+      }
+    }
+  }
+
+  for (const auto &MCFN : MCM.funcs()) {
+    for (const MCBasicBlock *BB : *MCFN) {
+      for (const MCDecodedInst &I : *BB) {
+        for (const MCOperand &Op : I.Inst) {
+          OperandRecord R;
+          R.Reserved = 0;
+          R.Kind = OK_Invalid;
+          R.Value = 0;
+          if (Op.isReg()) {
+            R.Kind = OK_Reg;
+            R.Value = Op.getReg();
+          } else if (Op.isImm()) {
+            R.Kind = OK_Imm;
+            R.Value = Op.getImm();
+          } else if (Op.isFPImm()) {
+            R.Kind = OK_FPImm;
+            R.Value = DoubleToBits(Op.getFPImm());
+          }
+          writeRecord(OS, R);
+        }
+      }
+    }
+  }
+
+  OS << Tag;
+  for (const auto &MCFN : MCM.funcs())
+    OS << MCFN->getName();
+  return "";
+}
+
+StringRef MCModuleBinaryIO::read(std::unique_ptr<MCModule> &MCM,
+                                 StringRef Data, const MCInstrInfo &MII,
+                                 const MCRegisterInfo &MRI, StringRef Tag) {
+  if (!isMCModuleBinary(Data) || Data.size() < sizeof(HeaderRecord))
+    return "Not a binary MC module.";
+  const HeaderRecord &H =
+      *reinterpret_cast<const HeaderRecord *>(Data.data());
+  if (H.Version != FormatVersion)
+    return "Unsupported binary MC module version.";
+  if (H.NumOpcodes != MII.getNumOpcodes() || H.NumRegs != MRI.getNumRegs())
+    return "Binary MC module built for another target.";
+
+  // Find the arrays, checking that they fit, without overflowing.
+  uint64_t Offset = sizeof(HeaderRecord);
+  bool Truncated = false;
+  auto Take = [&](uint64_t Count, size_t RecordSize) {
+    const char *Begin = Data.data() + Offset;
+    if (Truncated || Count > (Data.size() - Offset) / RecordSize)
+      Truncated = true;
+    else
+      Offset += Count * RecordSize;
+    return Begin;
+  };
+  const FunctionRecord *Functions = reinterpret_cast<const FunctionRecord *>(
+      Take(H.NumFunctions, sizeof(FunctionRecord)));
+  const BlockRecord *Blocks = reinterpret_cast<const BlockRecord *>(
+      Take(H.NumBlocks, sizeof(BlockRecord)));
+  const EdgeRecord *Edges = reinterpret_cast<const EdgeRecord *>(
+      Take(H.NumEdges, sizeof(EdgeRecord)));
+  const InstRecord *Insts = reinterpret_cast<const InstRecord *>(
+      Take(H.NumInsts, sizeof(InstRecord)));
+  const OperandRecord *Operands = reinterpret_cast<const OperandRecord *>(
+      Take(H.NumOperands, sizeof(OperandRecord)));
+  const char *Strings = Take(H.StringsSize, 1);
+  if (Truncated)
+    return "Truncated binary MC module.";
+  const uint64_t StringsSize = H.StringsSize;
+  if (H.TagSize > StringsSize || StringRef(Strings, H.TagSize) != Tag)
+    return "Binary MC module built from another input.";
+
+  MCM.reset(new MCModule);
+  std::vector<MCDecodedInst> FnInsts;
+  for (uint64_t FI = 0, FE = H.NumFunctions; FI != FE; ++FI) {
+    const FunctionRecord &F = Functions[FI];
+    if (F.NameOffset > StringsSize || F.NameSize > StringsSize - F.NameOffset)
+      return "Invalid function name.";
+    const uint64_t FirstBlock = F.FirstBlock, NumBlocks = F.NumBlocks;
+    if (FirstBlock > H.NumBlocks || NumBlocks > H.NumBlocks - FirstBlock)
+      return "Invalid function blocks.";
+    MCFunction *MCFN = MCM->createFunction(
+        StringRef(Strings + F.NameOffset, F.NameSize), F.BeginAddr);
+
+    // The instructions of a function are contiguous: move them all at once
+    // to the module storage.
+    FnInsts.clear();
+    for (uint64_t BI = FirstBlock, BE = FirstBlock + NumBlocks; BI != BE;
+         ++BI) {
+      const BlockRecord &B = Blocks[BI];
+      const uint64_t FirstInst = B.FirstInst, NumInsts = B.NumInsts;
+      if (FirstInst > H.NumInsts || NumInsts > H.NumInsts - FirstInst)
+        return "Invalid block instructions.";
+      for (uint64_t II = FirstInst, IE = FirstInst + NumInsts; II != IE;
+           ++II) {
+        const InstRecord &I = Insts[II];
+        const uint64_t FirstOp = I.FirstOperand, NumOps = I.NumOperands;
+        if (I.Opcode >= H.NumOpcodes || FirstOp > H.NumOperands ||
+            NumOps > H.NumOperands - FirstOp)
+          return "Invalid instruction.";
+        MCInst Inst;
+        Inst.setOpcode(I.Opcode);
+        for (uint64_t OI = FirstOp, OE = FirstOp + NumOps; OI != OE; ++OI) {
+          const OperandRecord &Op = Operands[OI];
+          switch (Op.Kind) {
+          case OK_Invalid:
+            Inst.addOperand(MCOperand());
+            break;
+          case OK_Reg:
+            if (Op.Value >= H.NumRegs)
+              return "Invalid register operand.";
+            Inst.addOperand(MCOperand::createReg(Op.Value));
+            break;
+          case OK_Imm:
+            Inst.addOperand(MCOperand::createImm(Op.Value));
+            break;
+          case OK_FPImm:
+            Inst.addOperand(MCOperand::createFPImm(BitsToDouble(Op.Value)));
+            break;
+          default:
+            return "Invalid operand kind.";
+          }
+        }
+        FnInsts.push_back(MCDecodedInst(Inst, I.Address, I.Size));
+      }
+    }
+    MutableArrayRef<MCDecodedInst> OwnedInsts = MCFN->moveInsts(FnInsts);
+
+    MCFN->reserveBlocks(NumBlocks);
+    size_t InstIdx = 0;
+    for (uint64_t BI = FirstBlock, BE = FirstBlock + NumBlocks; BI != BE;
+         ++BI) {
+      const BlockRecord &B = Blocks[BI];
+      MCBasicBlock *MCBB = &MCFN->createBlock(B.StartAddr);
+      MCBB->setInsts(OwnedInsts.data() + InstIdx,
+                     OwnedInsts.data() + InstIdx + B.NumInsts,
+                     B.SizeInBytes);
+      InstIdx += B.NumInsts;
+    }
+
+    std::vector<uint32_t> FnEdges, EdgeBegins;
+    EdgeBegins.reserve(2 * NumBlocks + 1);
+    for (uint64_t BI = FirstBlock, BE = FirstBlock + NumBlocks; BI != BE;
+         ++BI) {
+      const BlockRecord &B = Blocks[BI];
+      const uint64_t FirstEdge = B.FirstEdge;
+      const uint64_t NumSuccs = B.NumSuccs, NumPreds = B.NumPreds;
+      if (FirstEdge > H.NumEdges ||
+          NumSuccs + NumPreds > H.NumEdges - FirstEdge)
+        return "Invalid block edges.";
+      EdgeBegins.push_back(FnEdges.size());
+      EdgeBegins.push_back(FnEdges.size() + NumSuccs);
+      for (uint64_t EI = 0, EE = NumSuccs + NumPreds; EI != EE; ++EI) {
+        const uint32_t Other = Edges[FirstEdge + EI].Block;
+        if (Other >= NumBlocks)
+          return "Invalid block edge.";
+        FnEdges.push_back(Other);
+      }
+    }
+    EdgeBegins.push_back(FnEdges.size());
+    MCFN->setEdges(std::move(FnEdges), EdgeBegins);
+  }
+  return "";
+}
+
+bool llvm::isMCModuleBinary(StringRef Data) {
+  return Data.startswith(StringRef(Magic, sizeof(Magic)));
+}
+
+StringRef llvm::mcmodule2binary(raw_ostream &OS, const MCModule &MCM,
+                                const MCInstrInfo &MII,
+                                const MCRegisterInfo &MRI, StringRef Tag) {
+  return MCModuleBinaryIO::write(OS, MCM, MII, MRI, Tag);
+}
+
+StringRef llvm::binary2mcmodule(std::unique_ptr<MCModule> &MCM,
+                                StringRef Data, const MCInstrInfo &MII,
+                                const MCRegisterInfo &MRI, StringRef Tag) {
+  StringRef Err = MCModuleBinaryIO::read(MCM, Data, MII, MRI, Tag);
+  if (!Err.empty())
+    MCM.reset();
+  return Err;
+}
@@ -327,8 +327,10 @@ StringRef YAML2MCModule::parse(const MCModuleYAML::Module &YAMLModule) {
     MCFunction *MCFN = nullptr;
     for (BBIt BBI = FI->BasicBlocks.begin(), BBE = FI->BasicBlocks.end();
          BBI != BBE; ++BBI) {
-      if (!MCFN)
+      if (!MCFN) {
         MCFN = MCM.createFunction(FI->Name, BBI->Address);
+        MCFN->reserveBlocks(FI->BasicBlocks.size());
+      }
       MCBasicBlock *MCBB = &MCFN->createBlock(BBI->Address);
       for (InstIt II = BBI->Insts.begin(), IE = BBI->Insts.end(); II != IE;
            ++II) {
@@ -360,6 +362,8 @@ StringRef YAML2MCModule::parse(const MCModuleYAML::Module &YAMLModule) {
         MCBB->addSuccessor(Succ);
       }
     }
+    if (MCFN)
+      MCFN->finalizeEdges();
   }
   return "";
 }
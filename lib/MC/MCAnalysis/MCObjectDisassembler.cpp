@@ -11,10 +11,14 @@
 
 #include "llvm/MC/MCObjectDisassembler.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/IntervalMap.h"
 #include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/Triple.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/MC/MCAnalysis/MCFunction.h"
 #include "llvm/MC/MCAnalysis/MCModule.h"
@@ -23,12 +27,22 @@
 #include "llvm/MC/MCInstrAnalysis.h"
 #include "llvm/Object/MachO.h"
 #include "llvm/Object/ObjectFile.h"
+#include "llvm/Object/SymbolSize.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/MachO.h"
 #include "llvm/Support/PrettyStackTrace.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/LEB128.h"
-#include <map>
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
+#include "llvm/Support/TraceEvents.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#include <set>
 
 using namespace llvm;
 using namespace object;
@@ -38,56 +52,145 @@ using namespace object;
 MCObjectDisassembler::MCObjectDisassembler(const ObjectFile &Obj,
                                            const MCDisassembler &Dis,
                                            const MCInstrAnalysis &MIA)
-    : Obj(Obj), Dis(Dis), MIA(MIA), MOS(nullptr), Stripped(true) {
+    : Obj(Obj), Dis(Dis), MIA(MIA), OpcodeClasses(MIA),
+      MOS(nullptr), ScanFunctionStarts(false),
+      NumJobs(1), PriorModule(nullptr), SliceMaxDepth(-1), RecordFunctionStats(false),
+      ShareDecodedBlocks(false) {
     if (const object::MachOObjectFile *MachO = dyn_cast<object::MachOObjectFile>(&Obj)) {
-        ObjCFile = std::unique_ptr<ObjectiveCFile>(new ObjectiveCFile((object::MachOObjectFile*)MachO));
+        AddrSpace.reset(new object::MachOAddressSpaceMap(*MachO));
+        UnwindInfo = object::MachOUnwindInfo::create(*MachO);
     }
+    switch (Obj.getArch()) {
+    case Triple::arm:
+    case Triple::armeb:
+    case Triple::aarch64:
+    case Triple::aarch64_be:
+      break;
+    default:
+      InstParsedList.setGranularity(1);
+      NoneGeneralOperandList.setGranularity(1);
+      break;
+    }
+    buildFunctionSymbols();
 }
 
-const MCObjectDisassembler::MemoryRegion &
-MCObjectDisassembler::getRegionFor(uint64_t Addr) {
-    if (Stripped) {
-        for (std::vector<MemoryRegion>::iterator it = SectionRegions.begin(); it != SectionRegions.end(); ++it) {
-            if (Addr >= it->Addr && Addr < (it->Addr + it->Bytes.size())) {
-                uint64_t Next = 0;
-                for (unsigned i = 0; i < FunctionStarts.size(); ++i) {
-                    if (FunctionStarts[i] <= Addr && FunctionStarts[i + 1] > Addr) {
-                        Next = FunctionStarts[i + 1];
-                        break;
-                    }
-                }
-                if (Next) {
-                    ArrayRef<uint8_t> data = it->Bytes.slice((Addr - it->Addr), (Next - Addr));
-//                auto Region = std::make_shared<MemoryRegion>(Addr, data);
-                    //FIXME: What about releasing??????!!!!!!
-                    MemoryRegion *Region = new MemoryRegion(Addr, data);
-                    return *Region;
-                } else {
-//                    ArrayRef<uint8_t> data = it->Bytes.slice(Addr - it->Addr);
-//                    MemoryRegion *Region = new MemoryRegion(Addr, data);
-//                    return *Region;
-                    auto Region =
-                            std::lower_bound(SectionRegions.begin(), SectionRegions.end(), Addr,
-                                             [](const MemoryRegion &L, uint64_t Addr) {
-                                                 return L.Addr + L.Bytes.size() <= Addr;
-                                             });
-                    if (Region != SectionRegions.end())
-                    if (Region->Addr <= Addr)
-                        return *Region;
-                }
-            }
-        }
-        return FallbackRegion;
-    }
-  auto Region =
-      std::lower_bound(SectionRegions.begin(), SectionRegions.end(), Addr,
-                       [](const MemoryRegion &L, uint64_t Addr) {
-                         return L.Addr + L.Bytes.size() <= Addr;
-                       });
-  if (Region != SectionRegions.end())
+void MCObjectDisassembler::buildFunctionSymbols() {
+  TraceScope Trace("function-symbols");
+  for (const auto &SymSize : computeSymbolSizes(Obj)) {
+    const SymbolRef &Symbol = SymSize.first;
+    if (Symbol.getType() != SymbolRef::ST_Function ||
+        (Symbol.getFlags() & SymbolRef::SF_Undefined))
+      continue;
+    ErrorOr<StringRef> NameOrErr = Symbol.getName();
+    ErrorOr<uint64_t> AddrOrErr = Symbol.getAddress();
+    ErrorOr<section_iterator> SecOrErr = Symbol.getSection();
+    if (!NameOrErr || NameOrErr->empty() || !AddrOrErr || !SecOrErr ||
+        *SecOrErr == Obj.section_end() || !(*SecOrErr)->isText())
+      continue;
+    // The Mach-O header symbol is in __TEXT, but not in the code.
+    const SectionRef &Sec = **SecOrErr;
+    if (*AddrOrErr < Sec.getAddress() ||
+        *AddrOrErr >= Sec.getAddress() + Sec.getSize())
+      continue;
+    FunctionSymbol FS;
+    FS.Addr = *AddrOrErr;
+    // Mach-O has no symbol sizes: computeSymbolSizes only tells the distance
+    // to the next symbol, which may be a label in the same function.
+    FS.Size = Obj.isMachO() ? 0 : SymSize.second;
+    FS.Name = *NameOrErr;
+    if (Obj.isMachO() && FS.Name.startswith("_"))
+      FS.Name = FS.Name.drop_front();
+    FunctionSymbols.push_back(FS);
+  }
+  // Of the aliases, keep the first of the symbol table.
+  std::stable_sort(FunctionSymbols.begin(), FunctionSymbols.end(),
+                   [](const FunctionSymbol &L, const FunctionSymbol &R) {
+                     return L.Addr < R.Addr;
+                   });
+  FunctionSymbols.erase(
+      std::unique(FunctionSymbols.begin(), FunctionSymbols.end(),
+                  [](const FunctionSymbol &L, const FunctionSymbol &R) {
+                    return L.Addr == R.Addr;
+                  }),
+      FunctionSymbols.end());
+}
+
+std::string MCObjectDisassembler::getFunctionName(uint64_t Addr) const {
+  const uint64_t ObjAddr = MOS ? MOS->getOriginalLoadAddr(Addr) : Addr;
+  auto I = std::lower_bound(FunctionSymbols.begin(), FunctionSymbols.end(),
+                            ObjAddr,
+                            [](const FunctionSymbol &FS, uint64_t Addr) {
+                              return FS.Addr < Addr;
+                            });
+  if (I != FunctionSymbols.end() && I->Addr == ObjAddr)
+    return I->Name;
+  return "fn_" + utohexstr(Addr);
+}
+
+// Find the region of the sorted \p Regions containing \p Addr, or null.
+template <typename RegionT>
+static const RegionT *findRegionIn(const std::vector<RegionT> &Regions,
+                                   uint64_t Addr) {
+  auto Region = std::lower_bound(Regions.begin(), Regions.end(), Addr,
+                                 [](const RegionT &L, uint64_t Addr) {
+                                   return L.Addr + L.Bytes.size() <= Addr;
+                                 });
+  if (Region != Regions.end())
     if (Region->Addr <= Addr)
-      return *Region;
-  return FallbackRegion;
+      return &*Region;
+  return nullptr;
+}
+
+const MCObjectDisassembler::MemoryRegion *
+MCObjectDisassembler::findSectionRegion(uint64_t Addr) const {
+  return findRegionIn(SectionRegions, Addr);
+}
+
+bool MCObjectDisassembler::readSectionInt(uint64_t Addr, unsigned Size,
+                                          uint64_t &Value) const {
+  const MemoryRegion *Region = findSectionRegion(Addr);
+  if (!Region)
+    Region = findRegionIn(DataRegions, Addr);
+  if (!Region || Addr + Size > Region->Addr + Region->Bytes.size())
+    return false;
+  const uint8_t *Bytes = Region->Bytes.data() + (Addr - Region->Addr);
+  Value = 0;
+  for (unsigned I = 0; I != Size; ++I)
+    Value |= uint64_t(Bytes[Obj.isLittleEndian() ? I : Size - 1 - I])
+             << (8 * I);
+  return true;
+}
+
+MCObjectDisassembler::MemoryRegion
+MCObjectDisassembler::getRegionFor(uint64_t Addr) const {
+  const MemoryRegion *Section = findSectionRegion(Addr);
+  if (!Section)
+    return FallbackRegion;
+
+  const uint64_t SectionEnd = Section->Addr + Section->Bytes.size();
+  uint64_t End = SectionEnd;
+  // We don't want to disassemble past the start of the next function.
+  if (!FunctionRanges.empty() && *FunctionRanges.begin() <= Addr)
+    End = std::min(FunctionRanges.getNextBoundary(Addr), SectionEnd);
+  // Nor into the data in code: jump tables and literal pools aren't
+  // instructions.
+  const DataInCodeRange *DI = findDataInCode(Addr);
+  if (DI) {
+    if (DI->first <= Addr)
+      return MemoryRegion();
+    End = std::min(End, DI->first);
+  }
+
+  return MemoryRegion(Addr,
+                      Section->Bytes.slice(Addr - Section->Addr, End - Addr));
+}
+
+const MCObjectDisassembler::DataInCodeRange *
+MCObjectDisassembler::findDataInCode(uint64_t Addr) const {
+  auto DI = std::upper_bound(
+      DataInCodeRanges.begin(), DataInCodeRanges.end(), Addr,
+      [](uint64_t A, const DataInCodeRange &R) { return A < R.second; });
+  return DI == DataInCodeRanges.end() ? nullptr : &*DI;
 }
 
 MCModule *MCObjectDisassembler::buildEmptyModule() {
@@ -95,9 +198,13 @@ MCModule *MCObjectDisassembler::buildEmptyModule() {
   return Module;
 }
 
-MCModule *MCObjectDisassembler::buildModule() {
-  MCModule *Module = buildEmptyModule();
+void MCObjectDisassembler::setSymbolizer(MCObjectSymbolizer *ObjectSymbolizer) {
+  MOS = ObjectSymbolizer;
+  if (MOS)
+    MOS->buildLookupTables();
+}
 
+void MCObjectDisassembler::collectSectionRegions() {
   if (SectionRegions.empty()) {
     for (const SectionRef &Section : Obj.sections()) {
         StringRef SectionName;
@@ -112,12 +219,23 @@ MCModule *MCObjectDisassembler::buildModule() {
         continue;
       if (MOS)
         StartAddr = MOS->getEffectiveLoadAddr(StartAddr);
-      if (!isText)
+      if (!isText) {
+        StringRef Contents;
+        if (!Section.isBSS() && !Section.isVirtual() &&
+            !Section.getContents(Contents))
+          DataRegions.emplace_back(
+              StartAddr, ArrayRef<uint8_t>(
+                             reinterpret_cast<const uint8_t *>(Contents.data()),
+                             Contents.size()));
         continue;
+      }
+
+        // Each section counts, even where it overlaps another.
+        const unsigned Granularity = InstParsedList.getGranularity();
+        LinearCodeSize += (SecSize + Granularity - 1) / Granularity;
+        InstParsedList.addRegion(StartAddr, SecSize);
+        NoneGeneralOperandList.addRegion(StartAddr, SecSize);
 
-        for(uint64_t i = StartAddr; i < StartAddr + SecSize; i += 4)
-            TextSegList.insert(i);
-        
       StringRef Contents;
       if (Section.getContents(Contents))
         continue;
@@ -126,16 +244,44 @@ MCModule *MCObjectDisassembler::buildModule() {
           ArrayRef<uint8_t>(reinterpret_cast<const uint8_t *>(Contents.data()),
                             Contents.size()));
     }
+    std::sort(DataRegions.begin(), DataRegions.end(),
+              [](const MemoryRegion &L, const MemoryRegion &R) {
+                return L.Addr < R.Addr;
+              });
     std::sort(SectionRegions.begin(), SectionRegions.end(),
               [](const MemoryRegion &L, const MemoryRegion &R) {
                 return L.Addr < R.Addr;
               });
+    DataInCodeRanges = getDataInCodeRanges();
   }
+}
 
+MCModule *MCObjectDisassembler::buildModule() {
+  MCModule *Module = buildEmptyModule();
+  collectSectionRegions();
   buildCFG(Module);
   return Module;
 }
 
+MCModule *MCObjectDisassembler::buildLazyModule() {
+  MCModule *Module = buildEmptyModule();
+  collectSectionRegions();
+  buildFunctionRanges();
+  TheProgress.NumFunctions =
+      std::count_if(FunctionRanges.begin(), FunctionRanges.end(),
+                    [&](uint64_t Addr) { return isWantedFunction(Addr); });
+  return Module;
+}
+
+void MCObjectDisassembler::buildFunctionRanges() {
+  if (FunctionStarts.empty()) {
+    FunctionRanges = MCFunctionRangeMap(findFunctionStarts());
+    FunctionRanges.setEnds(findFunctionEnds());
+  } else {
+    FunctionRanges = MCFunctionRangeMap(FunctionStarts);
+  }
+}
+
 namespace {
   struct BBInfo;
   typedef SmallPtrSet<BBInfo*, 2> BBInfoSetTy;
@@ -144,13 +290,19 @@ namespace {
     uint64_t BeginAddr;
     uint64_t SizeInBytes;
     MCBasicBlock *BB;
-    std::vector<MCDecodedInst> Insts;
+    /// The block's instructions, as [begin, end) indices in the function's
+    /// instruction list.
+    size_t InstsBegin, InstsEnd;
     MCObjectDisassembler::AddressSetTy SuccAddrs;
 
-    BBInfo() : BeginAddr(0), SizeInBytes(0), BB(nullptr) {}
+    BBInfo()
+        : BeginAddr(0), SizeInBytes(0), BB(nullptr), InstsBegin(0),
+          InstsEnd(0) {}
   };
 }
 
+typedef IntervalMap<uint64_t, uint32_t> BlockRangeMap;
+
 static void RemoveDupsFromAddressVector(MCObjectDisassembler::AddressSetTy &V) {
   std::sort(V.begin(), V.end());
   V.erase(std::unique(V.begin(), V.end()), V.end());
@@ -159,59 +311,58 @@ static void RemoveDupsFromAddressVector(MCObjectDisassembler::AddressSetTy &V) {
 void MCObjectDisassembler::buildCFG(MCModule *Module) {
   AddressSetTy CallTargets;
   AddressSetTy TailCallTargets;
-
-    bool S = true;
-    Stripped = false;
-
-//  for (const SymbolRef &Symbol : Obj.symbols()) {
-//    SymbolRef::Type SymType = Symbol.getType();
-//    DEBUG(errs() << Symbol.getName().get() << "\n");
-//    if (SymType == SymbolRef::ST_Function) {
-//      ErrorOr<uint64_t> SymAddrOrErr = Symbol.getAddress();
-//      if (SymAddrOrErr.getError())
-//        continue;
-//      uint64_t SymAddr = *SymAddrOrErr;
-//      if (MOS)
-//        SymAddr = MOS->getEffectiveLoadAddr(SymAddr);
-//      if (getRegionFor(SymAddr).Bytes.empty())
-//        continue;
-//      createFunction(Module, SymAddr, CallTargets, TailCallTargets);
-//      S = false;
-//    }
-//  }
-
-    Stripped = S;
-
-    if (Stripped) {
-        FunctionStarts = findFunctionStarts();
-        RemoveDupsFromAddressVector(FunctionStarts);
-
-        for (AddressSetTy::iterator it = FunctionStarts.begin(); it != FunctionStarts.end(); ++it) {
-        //FIXME: remove this
-//            if (*it < 0x100D5B894   ) {
-//                continue;
-//            }
+  ShareDecodedBlocks = true;
+
+    // The functions are delimited by their starts, which include those of
+    // the symbols, when the object has any.
+    buildFunctionRanges();
+    if (SliceRoots.empty())
+        TheProgress.NumFunctions =
+            std::count_if(FunctionRanges.begin(), FunctionRanges.end(),
+                          [&](uint64_t Addr) {
+                            return isWantedFunction(Addr);
+                          });
+
+    if (!SliceRoots.empty()) {
+        buildReachableFunctions(Module, CallTargets, TailCallTargets);
+    } else if (NumJobs > 1 && llvm_is_multithreaded()) {
+        AddressSetTy Wanted;
+        for (uint64_t BeginAddr : FunctionRanges)
+            if (isWantedFunction(BeginAddr))
+                Wanted.push_back(BeginAddr);
+        buildFunctionsInParallel(Module, Wanted, CallTargets,
+                                 TailCallTargets);
+    } else {
+        for (MCFunctionRangeMap::const_iterator it = FunctionRanges.begin(); it != FunctionRanges.end(); ++it) {
+            if (!isWantedFunction(*it))
+                continue;
             createFunction(Module, *it, CallTargets, TailCallTargets);
+            ++TheProgress.NumDoneFunctions;
         }
     }
 
   RemoveDupsFromAddressVector(CallTargets);
   RemoveDupsFromAddressVector(TailCallTargets);
+  ShareDecodedBlocks = false;
+  DenseMap<uint64_t, ArrayRef<MCDecodedInst>>().swap(DecodedBlocks);
+}
 
-  AddressSetTy NewCallTargets;
+ArrayRef<MCDecodedInst> MCObjectDisassembler::findDecodedBlock(uint64_t Addr) {
+  if (!ShareDecodedBlocks)
+    return ArrayRef<MCDecodedInst>();
+  std::lock_guard<std::mutex> Lock(DecodedBlocksLock);
+  return DecodedBlocks.lookup(Addr);
+}
 
-  while (!NewCallTargets.empty()) {
-    // First, create functions for all the previously found targets
-    for (uint64_t CallTarget : CallTargets) {
-      if (MOS)
-        CallTarget = MOS->getEffectiveLoadAddr(CallTarget);
-      createFunction(Module, CallTarget, NewCallTargets, TailCallTargets);
-    }
-    // Next, forget about those targets, since we just handled them.
-    CallTargets.clear();
-    RemoveDupsFromAddressVector(NewCallTargets);
-    CallTargets = NewCallTargets;
-  }
+void MCObjectDisassembler::addDecodedBlocks(
+    ArrayRef<std::pair<uint64_t, ArrayRef<MCDecodedInst>>> Blocks) {
+  if (!ShareDecodedBlocks)
+    return;
+  // The first function to decode a block keeps it: the others decoded the
+  // same instructions.
+  std::lock_guard<std::mutex> Lock(DecodedBlocksLock);
+  for (const auto &Block : Blocks)
+    DecodedBlocks.insert(Block);
 }
 
 namespace {
@@ -229,6 +380,196 @@ namespace {
   };
 } // end anonymous namespace
 
+void MCObjectDisassembler::mergeCoverageStats(uint64_t BeginAddr,
+                                              const CoverageStats &Stats) {
+  for (uint64_t Addr : Stats.ParsedInsts)
+    InstParsedList.insert(Addr);
+  for (uint64_t Addr : Stats.NoneGeneralOperandInsts)
+    NoneGeneralOperandList.insert(Addr);
+  for (unsigned i = 0, e = array_lengthof(DisInstSize); i != e; ++i)
+    DisInstSize[i] += Stats.DisInstSize[i];
+  if (RecordFunctionStats)
+    FuncStats[BeginAddr] = Stats.Cost;
+}
+
+bool MCObjectDisassembler::copyPriorFunction(MCFunction *MCFN,
+                                             uint64_t BeginAddr,
+                                             AddressSetTy &CallTargets,
+                                             AddressSetTy &TailCallTargets,
+                                             CoverageStats &Stats) {
+  if (!PriorModule || !PriorFilter(BeginAddr))
+    return false;
+  const MCFunction *Prior = PriorModule->findFunctionAt(BeginAddr);
+  if (!Prior || Prior->empty() || Prior->areInstsPacked() ||
+      Prior->areInstsReleased())
+    return false;
+  // The blocks are bounded by the range of the function, which depends on
+  // the function starts, not just on the code.
+  MCFunctionRangeMap::const_iterator It = FunctionRanges.find(BeginAddr);
+  if (It == FunctionRanges.end())
+    return false;
+  const uint64_t EndAddr = FunctionRanges.getEndAddr(It);
+  for (const MCBasicBlock *BB : *Prior)
+    if (BB->getStartAddr() < BeginAddr || BB->getEndAddr() > EndAddr)
+      return false;
+
+  MCFN->copyBlocks(*Prior);
+  // Find the calls, and count the instructions, as disassembleFunctionAt
+  // does.
+  for (const MCBasicBlock *BB : *MCFN)
+    for (const MCDecodedInst &DI : *BB) {
+      Stats.ParsedInsts.push_back(DI.Address);
+      if (DI.Inst.size() < array_lengthof(Stats.DisInstSize))
+        Stats.DisInstSize[DI.Inst.size()] += 1;
+      if (DI.Inst.getOpcode() == 0) {
+        Stats.NoneGeneralOperandInsts.push_back(DI.Address);
+        continue;
+      }
+      const MCInstrAnalysis::Classification C = DI.classify(MIA);
+      uint64_t Target;
+      if (!C.evaluateBranch(Target))
+        continue;
+      if (C.isCall()) {
+        CallTargets.push_back(Target);
+      } else if (MOS && !MOS->findExternalFunctionAt(Target).empty()) {
+        TailCallTargets.push_back(Target);
+        CallTargets.push_back(Target);
+      }
+    }
+  ++TheProgress.NumReusedFunctions;
+  return true;
+}
+
+void MCObjectDisassembler::disassembleFunction(
+    MCModule *Module, MCFunction *MCFN, uint64_t BeginAddr,
+    AddressSetTy &CallTargets, AddressSetTy &TailCallTargets,
+    CoverageStats &Stats) {
+  TraceScope Trace("disassemble", BeginAddr);
+  MCFN->UnwindEncoding = getUnwindEncoding(BeginAddr);
+  if (copyPriorFunction(MCFN, BeginAddr, CallTargets, TailCallTargets,
+                        Stats)) {
+    TheProgress.NumInsts += Stats.ParsedInsts.size();
+    if (FunctionCallback)
+      FunctionCallback(*MCFN);
+    return;
+  }
+  if (!RecordFunctionStats) {
+    disassembleFunctionAt(Module, MCFN, BeginAddr, CallTargets,
+                          TailCallTargets, Stats);
+    TheProgress.NumInsts += Stats.ParsedInsts.size();
+    if (FunctionCallback)
+      FunctionCallback(*MCFN);
+    return;
+  }
+  auto Start = std::chrono::steady_clock::now();
+  disassembleFunctionAt(Module, MCFN, BeginAddr, CallTargets, TailCallTargets,
+                        Stats);
+  std::chrono::duration<double> Total =
+      std::chrono::steady_clock::now() - Start;
+  // Everything that isn't decoding is the CFG recovery proper.
+  Stats.Cost.CFGSeconds =
+      std::max(0.0, Total.count() - Stats.Cost.DecodeSeconds);
+  Stats.Cost.NumInsts = Stats.ParsedInsts.size();
+  TheProgress.NumInsts += Stats.Cost.NumInsts;
+  if (FunctionCallback)
+    FunctionCallback(*MCFN);
+}
+
+void MCObjectDisassembler::buildFunctionsInParallel(
+    MCModule *Module, ArrayRef<uint64_t> Addrs, AddressSetTy &CallTargets,
+    AddressSetTy &TailCallTargets) {
+  struct FunctionJob {
+    uint64_t BeginAddr;
+    MCFunction *MCFN;
+    AddressSetTy CallTargets;
+    AddressSetTy TailCallTargets;
+    CoverageStats Stats;
+  };
+
+  // MCModule isn't thread-safe: create all the functions upfront, in the same
+  // order createFunction would have.
+  std::vector<FunctionJob> Jobs;
+  Jobs.reserve(Addrs.size());
+  for (uint64_t BeginAddr : Addrs) {
+    StringRef ExtFnName;
+    if (MOS)
+      ExtFnName = MOS->findExternalFunctionAt(BeginAddr);
+    if (!ExtFnName.empty()) {
+      Module->createFunction(ExtFnName, BeginAddr);
+      ++TheProgress.NumDoneFunctions;
+      continue;
+    }
+    if (Module->findFunctionAt(BeginAddr)) {
+      ++TheProgress.NumDoneFunctions;
+      continue;
+    }
+
+    Jobs.emplace_back();
+    FunctionJob &Job = Jobs.back();
+    Job.BeginAddr = BeginAddr;
+    Job.MCFN = Module->createFunction(getFunctionName(BeginAddr), BeginAddr);
+  }
+
+  // Each function only touches its own blocks and its own job, so the
+  // threads just grab the next function to disassemble until there are none
+  // left.
+  ThreadPool Pool(NumJobs - 1);
+  parallel_for(Pool, 0, Jobs.size(), [&](size_t I) {
+    FunctionJob &Job = Jobs[I];
+    AddrPrettyStackTraceEntry X(Job.BeginAddr, "Function");
+    disassembleFunction(Module, Job.MCFN, Job.BeginAddr, Job.CallTargets,
+                        Job.TailCallTargets, Job.Stats);
+    ++TheProgress.NumDoneFunctions;
+  });
+
+  // Finally, merge the results, in function order.
+  for (const FunctionJob &Job : Jobs) {
+    CallTargets.insert(CallTargets.end(), Job.CallTargets.begin(),
+                       Job.CallTargets.end());
+    TailCallTargets.insert(TailCallTargets.end(), Job.TailCallTargets.begin(),
+                           Job.TailCallTargets.end());
+    mergeCoverageStats(Job.BeginAddr, Job.Stats);
+  }
+}
+
+void MCObjectDisassembler::buildReachableFunctions(
+    MCModule *Module, AddressSetTy &CallTargets,
+    AddressSetTy &TailCallTargets) {
+  // Walk the call graph breadth-first, one call depth at a time: the
+  // functions of a depth are independent, and disassembled in parallel.
+  const bool Parallel = NumJobs > 1 && llvm_is_multithreaded();
+  AddressSetTy Worklist = SliceRoots;
+  std::set<uint64_t> Visited;
+  for (int Depth = 0; !Worklist.empty(); ++Depth) {
+    AddressSetTy Wave;
+    for (uint64_t BeginAddr : Worklist) {
+      if (!Visited.insert(BeginAddr).second || !isWantedFunction(BeginAddr))
+        continue;
+      // The roots were asked for; only follow calls to the known function
+      // starts, as the functions of a full build are those.
+      if (Depth && FunctionRanges.find(BeginAddr) == FunctionRanges.end())
+        continue;
+      Wave.push_back(BeginAddr);
+    }
+    TheProgress.NumFunctions += Wave.size();
+
+    AddressSetTy Callees;
+    if (Parallel) {
+      buildFunctionsInParallel(Module, Wave, Callees, TailCallTargets);
+    } else {
+      for (uint64_t BeginAddr : Wave) {
+        createFunction(Module, BeginAddr, Callees, TailCallTargets);
+        ++TheProgress.NumDoneFunctions;
+      }
+    }
+    CallTargets.insert(CallTargets.end(), Callees.begin(), Callees.end());
+    if (SliceMaxDepth >= 0 && Depth >= SliceMaxDepth)
+      break;
+    RemoveDupsFromAddressVector(Callees);
+    Worklist = std::move(Callees);
+  }
+}
+
 // Basic idea of the disassembly + discovery:
 //
 // start with the wanted address, insert it in the worklist
@@ -246,8 +587,23 @@ namespace {
 //
 void MCObjectDisassembler::disassembleFunctionAt(
     MCModule *Module, MCFunction *MCFN, uint64_t BBBeginAddr,
-    AddressSetTy &CallTargets, AddressSetTy &TailCallTargets) {
-  std::map<uint64_t, BBInfo> BBInfos;
+    AddressSetTy &CallTargets, AddressSetTy &TailCallTargets,
+    CoverageStats &Stats) {
+  // The blocks, in creation order, and their address ranges, mapped to their
+  // index in BBInfos. The ranges are closed, and those of the empty blocks
+  // hold their start address. A B+ tree keeps the search for the block
+  // containing or following an address logarithmic as blocks are added and
+  // split, without a node allocation per block.
+  std::vector<BBInfo> BBInfos;
+  BlockRangeMap::Allocator BlockRangeAlloc;
+  BlockRangeMap BlockRanges(BlockRangeAlloc);
+  DenseMap<uint64_t, uint32_t> BlockIndices;
+  // All the instructions of the function. Blocks are disassembled one at a
+  // time, so each of them is a contiguous slice of this list.
+  std::vector<MCDecodedInst> Insts;
+  // The indices in Insts of the instructions that aren't as decoded: the tail
+  // calls, and the returns added after them. They aren't shared.
+  std::vector<size_t> RewrittenInsts;
 
   typedef SmallSetVector<uint64_t, 16> AddrWorklistTy;
 
@@ -255,15 +611,15 @@ void MCObjectDisassembler::disassembleFunctionAt(
 
   DEBUG(dbgs() << "Starting CFG at " << utohexstr(BBBeginAddr) << "\n");
 
-    AddressSetTy::iterator startIt = std::find(FunctionStarts.begin(), FunctionStarts.end(), BBBeginAddr);
-    if (startIt == FunctionStarts.end()) {
+    MCFunctionRangeMap::const_iterator startIt = FunctionRanges.find(BBBeginAddr);
+    if (startIt == FunctionRanges.end()) {
         llvm_unreachable("");
     }
-    AddressSetTy::iterator endIt = startIt;
-    std::advance(endIt, 1);
 
     uint64_t startAddr = *startIt;
-    uint64_t endAddr = (endIt == FunctionStarts.end()) ? INT64_MAX : *endIt;
+    uint64_t endAddr = FunctionRanges.getEndAddr(startIt);
+    // The return added after the tail calls.
+    const unsigned RetOpc = OpcodeClasses.getReturnOpcode();
 
     if (BBBeginAddr == 0x10001BBF4) {
         assert(true);
@@ -278,51 +634,51 @@ void MCObjectDisassembler::disassembleFunctionAt(
     DEBUG(dbgs() << "Looking for block at " << utohexstr(BeginAddr) << "\n");
 
     // Look for a BB at BeginAddr.
-    auto BeforeIt = std::upper_bound(
-        BBInfos.begin(), BBInfos.end(), BeginAddr,
-        [](uint64_t Addr, const std::pair<uint64_t, BBInfo> &BBI) {
-          return Addr < BBI.second.BeginAddr+BBI.second.SizeInBytes;
-        });
+    // Find the first block ending after BeginAddr: the one containing it, or
+    // else the next one.
+    BlockRangeMap::iterator BeforeIt = BlockRanges.find(BeginAddr);
+    const bool HasBefore = BeforeIt.valid();
 
-    assert((BeforeIt == BBInfos.end() || BeforeIt->first != BeginAddr) &&
+    assert((!HasBefore || BeforeIt.start() != BeginAddr) &&
            "Visited same basic block twice!");
 
     // Found a BB containing BeginAddr, we have to split it.
-    if (BeforeIt != BBInfos.end() && BeforeIt->first < BeginAddr) {
+    if (HasBefore && BeforeIt.start() < BeginAddr) {
+      const uint32_t BeforeIdx = BeforeIt.value();
+      const uint64_t BeforeStop = BeforeIt.stop();
+      BeforeIt.setStop(BeginAddr - 1);
+      BlockRanges.insert(BeginAddr, BeforeStop, BBInfos.size());
+      BlockIndices[BeginAddr] = BBInfos.size();
+      BBInfos.emplace_back();
+      BBInfo &NewBB = BBInfos.back();
+      NewBB.BeginAddr = BeginAddr;
 
-      BBInfo &BeforeBB = BeforeIt->second;
+      BBInfo &BeforeBB = BBInfos[BeforeIdx];
       DEBUG(dbgs() << "Found block at " << utohexstr(BeforeBB.BeginAddr)
                    << ", needs splitting at " << utohexstr(BeginAddr) << "\n");
 
       assert(BeginAddr < BeforeBB.BeginAddr + BeforeBB.SizeInBytes &&
              "Address isn't inside block?");
 
-      BBInfo &NewBB = BBInfos[BeginAddr];
-      NewBB.BeginAddr = BeginAddr;
-
-      auto SplitInst = BeforeBB.Insts.end();
-      for (auto I = BeforeBB.Insts.begin(), E = BeforeBB.Insts.end(); I != E;
-           ++I) {
-        if (BeginAddr == I->Address) {
-          SplitInst = I;
-          break;
-        }
-      }
+      auto InstsBegin = Insts.begin() + BeforeBB.InstsBegin;
+      auto InstsEnd = Insts.begin() + BeforeBB.InstsEnd;
+      auto SplitInst = std::lower_bound(
+          InstsBegin, InstsEnd, BeginAddr,
+          [](const MCDecodedInst &I, uint64_t Addr) {
+            return I.Address < Addr;
+          });
 
-      assert(SplitInst != BeforeBB.Insts.end() &&
+      assert(SplitInst != InstsEnd && SplitInst->Address == BeginAddr &&
              "Split point does not fall on an instruction boundary!");
 
-      // FIXME: use a list instead for free splicing?
-
-      // Splice the remaining instructions to the new block.
-      // While SplitInst is still valid, decrease the size to match.
+      // Split the slice: the remaining instructions go to the new block.
       const uint64_t SplitOffset = SplitInst->Address - BeforeBB.BeginAddr;
       NewBB.SizeInBytes = BeforeBB.SizeInBytes - SplitOffset;
       BeforeBB.SizeInBytes = SplitOffset;
 
-      // Now do the actual splicing out of BeforeBB.
-      NewBB.Insts.insert(NewBB.Insts.begin(), SplitInst, BeforeBB.Insts.end());
-      BeforeBB.Insts.erase(SplitInst, BeforeBB.Insts.end());
+      NewBB.InstsBegin = SplitInst - Insts.begin();
+      NewBB.InstsEnd = BeforeBB.InstsEnd;
+      BeforeBB.InstsEnd = NewBB.InstsBegin;
 
       // Move the successors to the new block.
       std::swap(NewBB.SuccAddrs, BeforeBB.SuccAddrs);
@@ -330,7 +686,12 @@ void MCObjectDisassembler::disassembleFunctionAt(
       BeforeBB.SuccAddrs.push_back(BeginAddr);
     } else {
       // If we didn't find a BB, then we have to disassemble to create one!
-      const MemoryRegion &Region = getRegionFor(BeginAddr);
+      const MemoryRegion Region = getRegionFor(BeginAddr);
+      if (Region.Bytes.empty() && isDataInCode(BeginAddr)) {
+        DEBUG(dbgs() << "Not disassembling data in code at "
+                     << utohexstr(BeginAddr) << "\n");
+        continue;
+      }
       if (Region.Bytes.empty()) {
         //report_fatal_error(("No suitable region for disassembly at 0x" +
         errs() << "No suitable region for disassembly at 0x" <<
@@ -342,51 +703,92 @@ void MCObjectDisassembler::disassembleFunctionAt(
       uint64_t EndAddr = EndRegion;
 
       // We want to stop before the next BB and have a fallthrough to it.
-      if (BeforeIt != BBInfos.end())
-        EndAddr = std::min(EndAddr, BeforeIt->first);
-
-      BBInfo &BBI = BBInfos[BeginAddr];
+      const uint64_t NextBBAddr = HasBefore ? BeforeIt.start() : 0;
+      if (HasBefore)
+        EndAddr = std::min(EndAddr, NextBBAddr);
+
+      const uint32_t BBIdx = BBInfos.size();
+      BlockIndices[BeginAddr] = BBIdx;
+      BBInfos.emplace_back();
+      BBInfo &BBI = BBInfos.back();
       BBI.BeginAddr = BeginAddr;
 
-      assert(BBI.Insts.empty() && "Basic Block already exists!");
+      assert(BBI.InstsBegin == BBI.InstsEnd && "Basic Block already exists!");
+      BBI.InstsBegin = BBI.InstsEnd = Insts.size();
 
       DEBUG(dbgs() << "No existing block found, starting disassembly from "
                    << utohexstr(Region.Addr) << " to "
                    << utohexstr(Region.Addr + Region.Bytes.size()) << "\n");
 
-      auto AddInst = [&](MCInst &I, uint64_t Addr, uint64_t Size) {
+      auto AddInst = [&](MCInst &I, uint64_t Addr, uint64_t Size,
+                         MCInstrAnalysis::Classification C) {
         const uint64_t NextAddr = BBI.BeginAddr + BBI.SizeInBytes;
         assert(NextAddr == Addr);
-        BBI.Insts.emplace_back(I, NextAddr, Size);
+        assert(BBI.InstsEnd == Insts.size());
+        Insts.emplace_back(I, NextAddr, Size, C);
+        BBI.InstsEnd = Insts.size();
         BBI.SizeInBytes += Size;
       };
 
       uint64_t InstSize;
+      // The instructions another function decoded from Addr on, if it has a
+      // block starting here, or at the end of the previous shared one.
+      ArrayRef<MCDecodedInst> Shared;
+      bool LookUpShared = true;
 
       for (uint64_t Addr = BeginAddr; Addr < EndAddr; Addr += InstSize) {
 
         MCInst Inst;
+        // The control flow properties of Inst, classified once.
+        MCInstrAnalysis::Classification Class;
+        bool Decoded;
+        if (LookUpShared) {
+          Shared = findDecodedBlock(Addr);
+          LookUpShared = false;
+        }
+        if (!Shared.empty() && Shared.front().Address == Addr) {
+          Inst = Shared.front().Inst;
+          InstSize = Shared.front().Size;
+          Class = Shared.front().Class;
+          Decoded = true;
+          Shared = Shared.slice(1);
+          LookUpShared = Shared.empty();
+          ++TheProgress.NumSharedInsts;
+        } else {
+          Shared = ArrayRef<MCDecodedInst>();
           
 //        ArrayRef<uint8_t> inst4Test = {0x1F, 0x20, 0x03, 0xD5};
 //        ArrayRef<uint8_t> inst4Test = {0xD5, 0x03, 0x20, 0x1F}; capstone consider this inst as `nop', disassembler dump it as `<MCInst 0 <MCOperand Reg:157> <MCOperand Reg:166> <MCOperand Reg:136> <MCOperand Reg:136>>', that is the operand is `0'
-        if (Dis.getInstruction(Inst, InstSize,
-                               Region.Bytes.slice(Addr - Region.Addr), Addr,
-                               nulls(), nulls())) {
+          std::chrono::steady_clock::time_point DecodeStart;
+          if (RecordFunctionStats)
+            DecodeStart = std::chrono::steady_clock::now();
+          Decoded = Dis.getInstruction(
+              Inst, InstSize, Region.Bytes.slice(Addr - Region.Addr), Addr,
+              nulls(), nulls());
+          if (RecordFunctionStats) {
+            std::chrono::duration<double> D =
+                std::chrono::steady_clock::now() - DecodeStart;
+            Stats.Cost.DecodeSeconds += D.count();
+          }
+        }
+        if (Decoded) {
 
-            InstParsedList.insert(Addr);
+            Stats.ParsedInsts.push_back(Addr);
 //            errs() << sizeof(Inst) << "\n";
 //            InstSize
 //            if(Inst.size() > MaximumInstSize)
             
-            DisInstSize[Inst.size()] += 1;
+            if (Inst.size() < array_lengthof(Stats.DisInstSize))
+              Stats.DisInstSize[Inst.size()] += 1;
 //            Inst.dump();
             if(Inst.getOpcode() == 0)
             {
-                NoneGeneralOperandList.insert(Addr);
-                AddInst(Inst, Addr, InstSize);
+                Stats.NoneGeneralOperandInsts.push_back(Addr);
+                AddInst(Inst, Addr, InstSize, Class);
                 continue;
             }
-            
+            if (!Class.isClassified())
+              Class = MIA.classify(Inst, Addr, InstSize);
         } else {
           DEBUG(dbgs() << "Failed disassembly at " << utohexstr(Addr) << "!\n");
           break;
@@ -394,27 +796,22 @@ void MCObjectDisassembler::disassembleFunctionAt(
 
         uint64_t BranchTarget;
           bool isTailcall = false;
+          unsigned TailCallOpc = 0;
           bool lastInst = false;
 
           if (Addr == 4297609936) {
               isTailcall = false;
           }
 
-          if (MIA.evaluateBranch(Inst, Addr, InstSize, BranchTarget) && (startAddr <= Addr && Addr <= endAddr)) {
-              if (!MIA.isCall(Inst)) {
+          if (Class.evaluateBranch(BranchTarget) && (startAddr <= Addr && Addr <= endAddr)) {
+              if (!Class.isCall()) {
                   if (BranchTarget && !(startAddr <= BranchTarget && BranchTarget <= endAddr)) {
-                      bool isDefined = false;
-                      for (AddressSetTy::iterator startIt = FunctionStarts.begin(); startIt != FunctionStarts.end(); ++startIt) {
-                          AddressSetTy::iterator endIt = startIt;
-                          std::advance(endIt, 1);
-                          if (endIt == FunctionStarts.end())
-                              continue;
-                          if ((*startIt) <= BranchTarget && BranchTarget <= (*endIt)) {
-                              isDefined = true;
-                              break;
-                          }
-                      }
-                      if (isDefined && Inst.getOpcode() == 104) {
+                      bool isDefined = FunctionRanges.isInBoundedFunction(BranchTarget);
+                      // A jump to another function is a tail call: it is
+                      // rewritten to the matching call, followed by a return.
+                      TailCallOpc =
+                          OpcodeClasses.getTailCallOpcode(Inst.getOpcode());
+                      if (isDefined && TailCallOpc && RetOpc) {
                           isTailcall = true;
                       }
 
@@ -423,17 +820,21 @@ void MCObjectDisassembler::disassembleFunctionAt(
           }
 
           if (isTailcall) {
-              Inst.setOpcode(125);
+              Inst.setOpcode(TailCallOpc);
+              Class = MIA.classify(Inst, Addr, InstSize);
           }
 
-          AddInst(Inst, Addr, InstSize);
+          AddInst(Inst, Addr, InstSize, Class);
 
           if (isTailcall) {
+              RewrittenInsts.push_back(Insts.size() - 1);
+              // The return has no size: it mustn't overlap the block that
+              // may follow the jump.
               MCInst retInst;
-              MCOperand retOp;
-              retOp.createReg(2);
-              retInst.setOpcode(1343);
-              AddInst(retInst, Addr + InstSize, 4);
+              retInst.setOpcode(RetOpc);
+              AddInst(retInst, Addr + InstSize, 0,
+                      MIA.classify(retInst, Addr + InstSize, 0));
+              RewrittenInsts.push_back(Insts.size() - 1);
 
               if ((Addr + InstSize) == endAddr) {
                   lastInst = true;
@@ -441,37 +842,62 @@ void MCObjectDisassembler::disassembleFunctionAt(
                   lastInst = true;
               }
           }
-        if (Inst.getOpcode() == 1343) {
-            assert(true);
-        }
-
-        if (MIA.evaluateBranch(Inst, Addr, InstSize, BranchTarget)) {
+        if (Class.evaluateBranch(BranchTarget)) {
           DEBUG(dbgs() << "Found branch to " << utohexstr(BranchTarget)
                        << "!\n");
-          if (MIA.isCall(Inst)) {
+          if (Class.isCall()) {
             DEBUG(dbgs() << "Found call!\n");
             CallTargets.push_back(BranchTarget);
           } else {
               if (checkBranch(Inst, BranchTarget)) {
-//                  Inst.setOpcode(125);
+//                  Inst.setOpcode(TailCallOpc);
 //                  CallTargets.push_back(BranchTarget);
               }
           }
         }
 
-        if (MIA.isTerminator(Inst) || lastInst) {
+        if (Class.isTerminator() || lastInst) {
           DEBUG(dbgs() << "Found terminator!\n");
           // Now we have a complete basic block, add successors.
 
           // Add the fallthrough block, and mark it for visiting.
-          if (MIA.isConditionalBranch(Inst)) {
+          if (Class.isConditionalBranch()) {
             BBI.SuccAddrs.push_back(Addr + InstSize);
             Worklist.insert(Addr + InstSize);
           }
+          // If the terminator branches through a jump table, its targets are
+          // the successors. The bounds check of the index usually ends the
+          // block falling through to this one.
+          if (Class.isIndirectBranch() && !Class.isCall()) {
+            std::vector<MCInst> PrevInsts;
+            std::vector<uint64_t> PrevAddrs;
+            auto AddInsts = [&](const BBInfo &Info) {
+              for (size_t I = Info.InstsBegin; I != Info.InstsEnd; ++I) {
+                PrevInsts.push_back(Insts[I].Inst);
+                PrevAddrs.push_back(Insts[I].Address);
+              }
+            };
+            // This block isn't in BlockRanges yet.
+            auto It = BlockRanges.find(BBI.BeginAddr - 1);
+            if (BBI.BeginAddr && It.valid() &&
+                It.start() < BBI.BeginAddr) {
+              const BBInfo &Prev = BBInfos[It.value()];
+              if (Prev.BeginAddr + Prev.SizeInBytes == BBI.BeginAddr)
+                AddInsts(Prev);
+            }
+            AddInsts(BBI);
+            AddressSetTy Targets;
+            findJumpTableTargets(PrevInsts, PrevAddrs, startAddr, endAddr,
+                                 Targets);
+            for (uint64_t Target : Targets) {
+              BBI.SuccAddrs.push_back(Target);
+              Worklist.insert(Target);
+            }
+          }
           // If the terminator is a branch, add the target block.
-          if (MIA.isBranch(Inst)) {
+          if (Class.isBranch()) {
             uint64_t BranchTarget;
-            if (MIA.evaluateBranch(Inst, Addr, InstSize, BranchTarget)) {
+            if (Class.evaluateBranch(BranchTarget)) {
               StringRef ExtFnName;
               if (MOS &&
                   !(ExtFnName = MOS->findExternalFunctionAt(BranchTarget))
@@ -487,36 +913,98 @@ void MCObjectDisassembler::disassembleFunctionAt(
           break;
         }
       }
+
+      // The last instruction may overlap the next block: the range stops
+      // before it, for the next block to be the one found there.
+      uint64_t Stop = BeginAddr + std::max<uint64_t>(BBI.SizeInBytes, 1) - 1;
+      if (HasBefore)
+        Stop = std::min(Stop, NextBBAddr - 1);
+      BlockRanges.insert(BeginAddr, Stop, BBIdx);
     }
   }
 
-  // First, create all blocks.
+  // The rewritten instructions go by pairs: the tail call, then the return.
+  for (size_t I = 0; I < RewrittenInsts.size(); I += 2)
+    MCFN->TailCalls.push_back(Insts[RewrittenInsts[I]].Address);
+  std::sort(MCFN->TailCalls.begin(), MCFN->TailCalls.end());
+
+  // First, create all blocks, as slices of the function-owned instructions.
+  MutableArrayRef<MCDecodedInst> FnInsts = MCFN->moveInsts(Insts);
+  MCFN->reserveBlocks(Worklist.size());
+  // The blocks that couldn't be disassembled are empty.
+  for (uint64_t BeginAddr : Worklist)
+    if (BlockIndices.insert(std::make_pair(BeginAddr, BBInfos.size())).second)
+      BBInfos.emplace_back();
   for (size_t wi = 0, we = Worklist.size(); wi != we; ++wi) {
     const uint64_t BeginAddr = Worklist[wi];
-    BBInfo *BBI = &BBInfos[BeginAddr];
-    MCBasicBlock *&MCBB = BBI->BB;
-
-    MCBB = &MCFN->createBlock(BeginAddr);
+    BBInfo &BBI = BBInfos[BlockIndices[BeginAddr]];
+    BBI.BB = &MCFN->createBlock(BeginAddr);
+    BBI.BB->setInsts(FnInsts.data() + BBI.InstsBegin,
+                     FnInsts.data() + BBI.InstsEnd, BBI.SizeInBytes);
+  }
 
-    std::swap(MCBB->Insts, BBI->Insts);
-    MCBB->InstCount = MCBB->Insts.size();
-    MCBB->SizeInBytes = BBI->SizeInBytes;
+  // Share the blocks as decoded, up to their first rewritten instruction.
+  std::vector<std::pair<uint64_t, ArrayRef<MCDecodedInst>>> Shareable;
+  for (const BBInfo &BBI : BBInfos) {
+    size_t InstsEnd = BBI.InstsEnd;
+    auto RI = std::lower_bound(RewrittenInsts.begin(), RewrittenInsts.end(),
+                               BBI.InstsBegin);
+    if (RI != RewrittenInsts.end())
+      InstsEnd = std::min(InstsEnd, *RI);
+    if (BBI.InstsBegin < InstsEnd)
+      Shareable.push_back(std::make_pair(
+          BBI.BeginAddr, makeArrayRef(FnInsts.data() + BBI.InstsBegin,
+                                      FnInsts.data() + InstsEnd)));
   }
+  addDecodedBlocks(Shareable);
+
+  // Next, add all successors, by block index; the predecessors follow.
+  std::vector<uint32_t> Succs, SuccBegins;
+  SuccBegins.reserve(Worklist.size() + 1);
+  for (uint64_t BeginAddr : Worklist) {
+    BBInfo &BBI = BBInfos[BlockIndices[BeginAddr]];
+    RemoveDupsFromAddressVector(BBI.SuccAddrs);
+    SuccBegins.push_back(Succs.size());
+    for (uint64_t Address : BBI.SuccAddrs) {
+      auto It = BlockIndices.find(Address);
+      assert(It != BlockIndices.end() && "Couldn't find block successor?!");
+      Succs.push_back(BBInfos[It->second].BB->getIndex());
+    }
+  }
+  SuccBegins.push_back(Succs.size());
+  MCFN->setSuccessors(Succs, SuccBegins);
+}
 
-  // Next, add all predecessors/successors.
-  for (size_t wi = 0, we = Worklist.size(); wi != we; ++wi) {
-    const uint64_t BeginAddr = Worklist[wi];
-    BBInfo *BBI = &BBInfos[BeginAddr];
-    MCBasicBlock *&MCBB = BBI->BB;
-    RemoveDupsFromAddressVector(BBI->SuccAddrs);
-    for (uint64_t Address : BBI->SuccAddrs) {
-      MCBasicBlock *Succ = BBInfos[Address].BB;
-      assert(Succ && "Couldn't find block successor?!");
-      // FIXME: Sort the succs/preds at the end?
-      MCBB->Successors.push_back(Succ);
-      Succ->Predecessors.push_back(MCBB);
+void MCObjectDisassembler::findJumpTableTargets(ArrayRef<MCInst> Insts,
+                                                ArrayRef<uint64_t> Addrs,
+                                                uint64_t FnBegin,
+                                                uint64_t FnEnd,
+                                                AddressSetTy &Targets) const {
+  // The tables of unknown size are only read this far.
+  static const uint64_t MaxUnboundedEntries = 1024;
+  MCInstrAnalysis::JumpTable JT;
+  if (!MIA.evaluateJumpTable(Insts, Addrs, JT))
+    return;
+  const uint64_t NumEntries = JT.NumEntries ? JT.NumEntries
+                                            : MaxUnboundedEntries;
+  for (uint64_t I = 0; I != NumEntries; ++I) {
+    uint64_t Entry;
+    if (!readSectionInt(JT.TableAddr + I * JT.EntrySize, JT.EntrySize, Entry))
+      break;
+    if (JT.SignedEntries && JT.EntrySize < 8)
+      Entry = SignExtend64(Entry, 8 * JT.EntrySize);
+    const uint64_t Target = JT.Base + (Entry << JT.EntryShift);
+    // The end of the last function isn't known: the text sections bound it.
+    if (Target < FnBegin || Target >= FnEnd || !findSectionRegion(Target)) {
+      if (!JT.NumEntries)
+        break;
+      continue;
     }
+    Targets.push_back(Target);
   }
+  DEBUG(dbgs() << "Found jump table at " << utohexstr(JT.TableAddr) << " with "
+               << Targets.size() << " targets\n");
+  RemoveDupsFromAddressVector(Targets);
 }
 
 MCFunction *
@@ -538,64 +1026,338 @@ MCObjectDisassembler::createFunction(MCModule *Module, uint64_t BeginAddr,
 
   // Finally, just create a new one.
   MCFunction *MCFN =
-      Module->createFunction(("fn_" + utohexstr(BeginAddr)).c_str(), BeginAddr);
-  disassembleFunctionAt(Module, MCFN, BeginAddr, CallTargets, TailCallTargets);
+      Module->createFunction(getFunctionName(BeginAddr), BeginAddr);
+  CoverageStats Stats;
+  disassembleFunction(Module, MCFN, BeginAddr, CallTargets, TailCallTargets,
+                      Stats);
+  mergeCoverageStats(BeginAddr, Stats);
   return MCFN;
 }
 
 llvm::MCObjectDisassembler::AddressSetTy MCObjectDisassembler::findFunctionStarts() {
     AddressSetTy Starts;
 
+    // Without LC_FUNCTION_STARTS, as in other objects, or when it was
+    // stripped, the functions are found from the calls to them.
     MachOObjectFile *MachO = dyn_cast<MachOObjectFile>((ObjectFile*)&Obj);
-
-    assert(MachO && "Handling Stripped Binaries is only handled for Mach-O");
-
-    MachOObjectFile::load_command_iterator Load_it = MachO->begin_load_commands();
-    MachOObjectFile::load_command_iterator Load_it_end = MachO->end_load_commands();
-    for(; Load_it != Load_it_end; ++Load_it) {
-        if (Load_it->C.cmd == MachO::LC_FUNCTION_STARTS) {
-            uint32_t *Cmd_ptr = (uint32_t*) Load_it->Ptr;
-            uint32_t Offset = Cmd_ptr[2];
-            uint32_t Size = Cmd_ptr[3];
-            MachO::linkedit_data_command c = MachO->getLinkeditDataLoadCommand(*Load_it);
-//            errs() << c.dataoff << "\n" << c.datasize << "\n";
-            StringRef FunctionStarts = MachO->getData().slice(Offset, Offset + Size);
-//            MemoryBuffer buffer = MemoryBuffer::getMemBuffer(FunctionStarts);
-            uint64_t LastFunctionStart = 0x0;
-            for (unsigned i = 0; i < Size;) {
-                unsigned n = 0;
-                char *p = (char*) &FunctionStarts.data()[i];
-                uint64_t V = decodeULEB128((uint8_t*)p, &n);
-                assert(n);
-                LastFunctionStart += V;
-                Starts.push_back(LastFunctionStart | 0x100000000);
-                i += n;
-            }
+    bool HasFunctionStarts = false;
+
+    // The starts are ULEB128 deltas, the first from the start of __TEXT, the
+    // others from the previous start. A 0 delta ends them.
+    uint64_t TextAddr = 0;
+    StringRef Deltas;
+    if (MachO) {
+      for (const auto &Load : MachO->load_commands()) {
+        StringRef SegName;
+        uint64_t VMAddr = 0;
+        if (Load.C.cmd == MachO::LC_SEGMENT_64) {
+            MachO::segment_command_64 Seg = MachO->getSegment64LoadCommand(Load);
+            SegName = StringRef(Seg.segname, strnlen(Seg.segname, 16));
+            VMAddr = Seg.vmaddr;
+        } else if (Load.C.cmd == MachO::LC_SEGMENT) {
+            MachO::segment_command Seg = MachO->getSegmentLoadCommand(Load);
+            SegName = StringRef(Seg.segname, strnlen(Seg.segname, 16));
+            VMAddr = Seg.vmaddr;
+        } else if (Load.C.cmd == MachO::LC_FUNCTION_STARTS) {
+            MachO::linkedit_data_command C =
+                MachO->getLinkeditDataLoadCommand(Load);
+            Deltas = MachO->getData().slice(C.dataoff,
+                                            uint64_t(C.dataoff) + C.datasize);
+            HasFunctionStarts = true;
         }
+        if (SegName == "__TEXT")
+            TextAddr = VMAddr;
+      }
+    }
+
+    const uint8_t *Begin = reinterpret_cast<const uint8_t *>(Deltas.begin());
+    const uint8_t *End = reinterpret_cast<const uint8_t *>(Deltas.end());
+    Starts.reserve(Deltas.size() / 2);
+    uint64_t Addr = TextAddr;
+    decodeULEB128Run(Begin, End, [&](uint64_t Delta) {
+        if (!Delta)
+            return false;
+        Addr += Delta;
+        Starts.push_back(MOS ? MOS->getEffectiveLoadAddr(Addr) : Addr);
+        return true;
+    });
+
+    // The unwind info ranges start at functions too, some of which may not
+    // be in LC_FUNCTION_STARTS, as when it was stripped.
+    if (!UnwindInfo.empty()) {
+        AddressSetTy UnwindStarts;
+        UnwindStarts.reserve(UnwindInfo.size());
+        for (const object::MachOUnwindInfo::Entry &E : UnwindInfo)
+            UnwindStarts.push_back(MOS ? MOS->getEffectiveLoadAddr(E.BeginAddr)
+                                       : E.BeginAddr);
+        AddressSetTy Merged;
+        Merged.reserve(Starts.size() + UnwindStarts.size());
+        std::set_union(Starts.begin(), Starts.end(), UnwindStarts.begin(),
+                       UnwindStarts.end(), std::back_inserter(Merged));
+        Starts.swap(Merged);
+    }
+
+    // And so do the function symbols, of the objects that aren't stripped.
+    if (!FunctionSymbols.empty()) {
+        AddressSetTy SymbolStarts;
+        SymbolStarts.reserve(FunctionSymbols.size());
+        for (const FunctionSymbol &FS : FunctionSymbols)
+            SymbolStarts.push_back(MOS ? MOS->getEffectiveLoadAddr(FS.Addr)
+                                       : FS.Addr);
+        AddressSetTy Merged;
+        Merged.reserve(Starts.size() + SymbolStarts.size());
+        std::set_union(Starts.begin(), Starts.end(), SymbolStarts.begin(),
+                       SymbolStarts.end(), std::back_inserter(Merged));
+        Starts.swap(Merged);
     }
 
-//    for (auto &f : Starts) {
-//        errs() << utohexstr(f) << "\n";
-//    }
+    // The deltas are positive: the starts are sorted and unique already.
+    if (HasFunctionStarts && !ScanFunctionStarts)
+        return Starts;
+
+    AddressSetTy CallTargets = scanFunctionStarts();
+    AddressSetTy Merged;
+    Merged.reserve(Starts.size() + CallTargets.size());
+    std::set_union(Starts.begin(), Starts.end(), CallTargets.begin(),
+                   CallTargets.end(), std::back_inserter(Merged));
+    DEBUG(dbgs() << "Scanned " << CallTargets.size() << " call targets, "
+                 << Merged.size() - Starts.size()
+                 << " not in the function starts\n");
+    return Merged;
+}
 
-    std::sort(Starts.begin(), Starts.end());
+MCObjectDisassembler::AddressSetTy MCObjectDisassembler::findFunctionEnds() {
+  AddressSetTy Ends;
+  Ends.reserve(UnwindInfo.size());
+  for (const object::MachOUnwindInfo::Entry &E : UnwindInfo)
+    Ends.push_back(MOS ? MOS->getEffectiveLoadAddr(E.EndAddr) : E.EndAddr);
+  for (const FunctionSymbol &FS : FunctionSymbols)
+    if (FS.Size)
+      Ends.push_back(MOS ? MOS->getEffectiveLoadAddr(FS.Addr + FS.Size)
+                         : FS.Addr + FS.Size);
+  return Ends;
+}
 
-    return Starts;
+uint32_t MCObjectDisassembler::getUnwindEncoding(uint64_t Addr) const {
+  if (UnwindInfo.empty())
+    return 0;
+  const object::MachOUnwindInfo::Entry *E =
+      UnwindInfo.find(MOS ? MOS->getOriginalLoadAddr(Addr) : Addr);
+  return E ? E->Encoding : 0;
+}
+
+MCObjectDisassembler::AddressSetTy MCObjectDisassembler::scanFunctionStarts() {
+  TraceScope Trace("scan-function-starts");
+  collectSectionRegions();
+  AddressSetTy Targets;
+  for (const MemoryRegion &Region : SectionRegions) {
+    // Scan the pieces of the region between its data-in-code ranges.
+    const uint64_t End = Region.Addr + Region.Bytes.size();
+    for (uint64_t Addr = Region.Addr; Addr < End;) {
+      const DataInCodeRange *DI = findDataInCode(Addr);
+      const uint64_t Stop = DI ? std::min(End, std::max(Addr, DI->first)) : End;
+      if (!MIA.findDirectCallTargets(
+              Region.Bytes.slice(Addr - Region.Addr, Stop - Addr), Addr,
+              Targets))
+        return AddressSetTy();
+      if (!DI)
+        break;
+      Addr = DI->second;
+    }
+  }
+  // The entrypoint isn't called, but is a function as well.
+  if (MOS)
+    if (uint64_t Entrypoint = MOS->getEntrypoint())
+      Targets.push_back(Entrypoint);
+  // The targets out of the code are bogus, data that looks like a call, and
+  // the stubs aren't functions of the object.
+  Targets.erase(std::remove_if(Targets.begin(), Targets.end(),
+                               [&](uint64_t Target) {
+                                 return !findSectionRegion(Target) ||
+                                        isDataInCode(Target) ||
+                                        (AddrSpace &&
+                                         AddrSpace->isStub(Target)) ||
+                                        (MOS && !MOS->findExternalFunctionAt(
+                                                        Target).empty());
+                               }),
+                Targets.end());
+  RemoveDupsFromAddressVector(Targets);
+  return Targets;
 }
 
 bool MCObjectDisassembler::checkBranch(MCInst &Inst, uint64_t Target) {
-    if (!ObjCFile)
-        return false;
-    std::string FunctionName = ObjCFile->getFunctionName(Target);
-    for (object::section_iterator S_it = Obj.section_begin(); S_it != Obj.section_end(); ++S_it) {
-        StringRef SectionName;
-        if (!S_it->getName(SectionName)) {
-            if (SectionName == "__stubs") {
-                if (S_it->getAddress() <= Target && Target < (S_it->getAddress() + S_it->getSize())) {
-                    return true;
-                }
-            }
-        }
+    return AddrSpace && AddrSpace->isStub(Target);
+}
+
+const char *
+MCObjectDisassembler::getCoverageGapKindName(CoverageGap::KindTy Kind) {
+  switch (Kind) {
+  case CoverageGap::DataInCode:     return "data-in-code";
+  case CoverageGap::Padding:        return "padding";
+  case CoverageGap::MissedFunction: return "missed-function";
+  }
+  llvm_unreachable("Unknown coverage gap kind!");
+}
+
+std::vector<std::pair<uint64_t, uint64_t>>
+MCObjectDisassembler::getDataInCodeRanges() const {
+  std::vector<std::pair<uint64_t, uint64_t>> Ranges;
+  const MachOObjectFile *MachO = dyn_cast<MachOObjectFile>(&Obj);
+  if (!MachO)
+    return Ranges;
+
+  // The entries are offsets from the first segment that is mapped.
+  uint64_t BaseAddr = 0;
+  for (const auto &Load : MachO->load_commands()) {
+    StringRef SegName;
+    uint64_t VMAddr;
+    if (Load.C.cmd == MachO::LC_SEGMENT_64) {
+      MachO::segment_command_64 Seg = MachO->getSegment64LoadCommand(Load);
+      SegName = StringRef(Seg.segname, strnlen(Seg.segname, 16));
+      VMAddr = Seg.vmaddr;
+    } else if (Load.C.cmd == MachO::LC_SEGMENT) {
+      MachO::segment_command Seg = MachO->getSegmentLoadCommand(Load);
+      SegName = StringRef(Seg.segname, strnlen(Seg.segname, 16));
+      VMAddr = Seg.vmaddr;
+    } else {
+      continue;
     }
+    if (SegName == "__PAGEZERO")
+      continue;
+    BaseAddr = VMAddr;
+    break;
+  }
+
+  for (dice_iterator DI = MachO->begin_dices(), DE = MachO->end_dices();
+       DI != DE; ++DI) {
+    uint32_t Offset;
+    uint16_t Length;
+    if (DI->getOffset(Offset) || DI->getLength(Length))
+      continue;
+    uint64_t Addr = BaseAddr + Offset;
+    if (MOS)
+      Addr = MOS->getEffectiveLoadAddr(Addr);
+    Ranges.push_back(std::make_pair(Addr, Addr + Length));
+  }
+  std::sort(Ranges.begin(), Ranges.end());
+  return Ranges;
+}
+
+bool MCObjectDisassembler::isPadding(ArrayRef<uint8_t> Bytes,
+                                     uint64_t Size) const {
+  Bytes = Bytes.slice(0, Size);
+  if (std::all_of(Bytes.begin(), Bytes.end(),
+                  [](uint8_t B) { return B == 0; }))
+    return true;
+  switch (Obj.getArch()) {
+  case Triple::aarch64:
+    return Size == 4 && Bytes[0] == 0x1f && Bytes[1] == 0x20 &&
+           Bytes[2] == 0x03 && Bytes[3] == 0xd5;
+  case Triple::arm:
+    return (Size == 4 && Bytes[0] == 0x00 && Bytes[1] == 0xf0 &&
+            Bytes[2] == 0x20 && Bytes[3] == 0xe3) ||
+           (Size == 2 && Bytes[0] == 0x00 && Bytes[1] == 0xbf);
+  case Triple::x86:
+  case Triple::x86_64: {
+    // nop, int3, and the multi-byte nops: 66* 0f 1f.
+    if (Size == 1)
+      return Bytes[0] == 0x90 || Bytes[0] == 0xcc;
+    size_t I = 0;
+    while (I != Size && Bytes[I] == 0x66)
+      ++I;
+    return I + 1 < Size && Bytes[I] == 0x0f && Bytes[I + 1] == 0x1f;
+  }
+  default:
     return false;
+  }
+}
+
+void MCObjectDisassembler::classifyCoverageGap(
+    CoverageGap &Gap,
+    ArrayRef<std::pair<uint64_t, uint64_t>> DataInCode) const {
+  Gap.Kind = CoverageGap::DataInCode;
+  auto DI = std::upper_bound(DataInCode.begin(), DataInCode.end(),
+                             Gap.BeginAddr,
+                             [](uint64_t Addr,
+                                const std::pair<uint64_t, uint64_t> &R) {
+                               return Addr < R.second;
+                             });
+  if (DI != DataInCode.end() && DI->first < Gap.EndAddr)
+    return;
+
+  const MemoryRegion *Region = findSectionRegion(Gap.BeginAddr);
+  if (!Region)
+    return;
+  const uint64_t End =
+      std::min(Gap.EndAddr, Region->Addr + Region->Bytes.size());
+  ArrayRef<uint8_t> Bytes = Region->Bytes.slice(Gap.BeginAddr - Region->Addr,
+                                                End - Gap.BeginAddr);
+
+  // Skip the padding, then look for code up to the first terminator: a
+  // function that nothing calls, or that is only reached through a table.
+  uint64_t Addr = Gap.BeginAddr;
+  bool SeenCode = false;
+  uint64_t InstSize;
+  for (; Addr < End; Addr += InstSize) {
+    ArrayRef<uint8_t> InstBytes = Bytes.slice(Addr - Gap.BeginAddr);
+    MCInst Inst;
+    if (!Dis.getInstruction(Inst, InstSize, InstBytes, Addr, nulls(),
+                            nulls()) ||
+        !InstSize || Addr + InstSize > End) {
+      // Zeros don't always decode, but are still padding.
+      const uint64_t Slot = std::min<uint64_t>(
+          InstParsedList.getGranularity(), End - Addr);
+      if (SeenCode || !isPadding(InstBytes, Slot))
+        return;
+      InstSize = Slot;
+      continue;
+    }
+    if (!SeenCode) {
+      if (isPadding(InstBytes, InstSize))
+        continue;
+      SeenCode = true;
+      Gap.CodeAddr = Addr;
+    }
+    if (MIA.isReturn(Inst) || MIA.isUnconditionalBranch(Inst) ||
+        MIA.isIndirectBranch(Inst))
+      break;
+  }
+  // Code that runs into the end of the gap falls through to the next block.
+  Gap.Kind = SeenCode ? CoverageGap::MissedFunction : CoverageGap::Padding;
+}
+
+MCObjectDisassembler::CoverageGapListTy
+MCObjectDisassembler::findCoverageGaps(const MCModule &Module) {
+  collectSectionRegions();
+
+  std::vector<std::pair<uint64_t, uint64_t>> Blocks;
+  for (const auto &F : Module.funcs())
+    for (const MCBasicBlock *BB : *F)
+      if (BB->getSizeInBytes())
+        Blocks.push_back(std::make_pair(BB->getStartAddr(), BB->getEndAddr()));
+  std::sort(Blocks.begin(), Blocks.end());
+
+  // The gaps are what the blocks leave of each section.
+  CoverageGapListTy Gaps;
+  auto BI = Blocks.begin();
+  for (const MemoryRegion &Region : SectionRegions) {
+    const uint64_t RegionEnd = Region.Addr + Region.Bytes.size();
+    uint64_t Covered = Region.Addr;
+    // Blocks outside of the sections are in the fallback region.
+    while (BI != Blocks.end() && BI->second <= Region.Addr)
+      ++BI;
+    for (; BI != Blocks.end() && BI->first < RegionEnd; ++BI) {
+      if (BI->first > Covered)
+        Gaps.emplace_back(Covered, BI->first);
+      Covered = std::max(Covered, BI->second);
+    }
+    if (Covered < RegionEnd)
+      Gaps.emplace_back(Covered, RegionEnd);
+  }
+
+  ThreadPool Pool(NumJobs - 1);
+  parallel_for(Pool, 0, Gaps.size(), [&](size_t I) {
+    classifyCoverageGap(Gaps[I], DataInCodeRanges);
+  });
+  return Gaps;
 }
@@ -28,45 +28,15 @@ using namespace object;
 
 //===- Helpers ------------------------------------------------------------===//
 
-static bool RelocRelocOffsetComparator(const object::RelocationRef &LHS,
-                                       const object::RelocationRef &RHS) {
-  return LHS.getOffset() < RHS.getOffset();
-}
-
-static bool RelocU64OffsetComparator(const object::RelocationRef &LHS,
-                                     uint64_t RHSOffset) {
-  return LHS.getOffset() < RHSOffset;
-}
-
 //===- MCMachObjectSymbolizer ---------------------------------------------===//
 
 MCMachObjectSymbolizer::MCMachObjectSymbolizer(
     MCContext &Ctx, std::unique_ptr<MCRelocationInfo> RelInfo,
     const MachOObjectFile &MOOF, uint64_t VMAddrSlide)
     : MCObjectSymbolizer(Ctx, std::move(RelInfo), MOOF), MOOF(MOOF),
-      StubsStart(0), StubsCount(0), StubSize(0), StubsIndSymIndex(0),
-      VMAddrSlide(VMAddrSlide) {
-
-  for (const SectionRef &Section : MOOF.sections()) {
-    StringRef Name;
-    Section.getName(Name);
-    if (Name == "__stubs") {
-      SectionRef StubsSec = Section;
-      if (MOOF.is64Bit()) {
-        MachO::section_64 S = MOOF.getSection64(StubsSec.getRawDataRefImpl());
-        StubsIndSymIndex = S.reserved1;
-        StubSize = S.reserved2;
-      } else {
-        MachO::section S = MOOF.getSection(StubsSec.getRawDataRefImpl());
-        StubsIndSymIndex = S.reserved1;
-        StubSize = S.reserved2;
-      }
-      assert(StubSize && "Mach-O stub entry size can't be zero!");
-      StubsStart = StubsSec.getAddress();
-      StubsCount = StubsSec.getSize();
-      StubsCount /= StubSize;
-    }
-  }
+      AddrSpace(MOOF), VMAddrSlide(VMAddrSlide) {
+  assert((!AddrSpace.getStubs() || AddrSpace.getStubs()->Reserved2) &&
+         "Mach-O stub entry size can't be zero!");
 
   // Also look for the init/exit func sections.
   for (const SectionRef &Section : MOOF.sections()) {
@@ -81,6 +51,8 @@ MCMachObjectSymbolizer::MCMachObjectSymbolizer(
       Section.getContents(ModExitContents);
     }
   }
+
+  buildStubFunctionNames();
 }
 
 // FIXME: Only do the translations for addresses actually inside the object.
@@ -113,35 +85,48 @@ ArrayRef<uint64_t> MCMachObjectSymbolizer::getStaticExitFunctions() {
 }
 
 StringRef MCMachObjectSymbolizer::findExternalFunctionAt(uint64_t Addr) {
-  Addr = getOriginalLoadAddr(Addr);
-  // FIXME: also, this can all be done at the very beginning, by iterating over
-  // all stubs and creating the calls to outside functions. Is it worth it
-  // though?
-  if (!StubSize)
-    return StringRef();
-  uint64_t StubIdx = (Addr - StubsStart) / StubSize;
-  if (StubIdx >= StubsCount)
-    return StringRef();
-
-  uint32_t SymtabIdx =
-      MOOF.getIndirectSymbolTableEntry(MOOF.getDysymtabLoadCommand(), StubIdx);
-  symbol_iterator SI = MOOF.getSymbolByIndex(SymtabIdx);
-
-  assert(SI != MOOF.symbol_end() && "Stub wasn't found in the symbol table!");
-
-  const MachO::nlist_64 &SymNList =
-      MOOF.getSymbol64TableEntry(SI->getRawDataRefImpl());
-  if ((SymNList.n_type & MachO::N_TYPE) != MachO::N_UNDF)
+  uint64_t StubIdx;
+  if (!AddrSpace.getStubIndex(getOriginalLoadAddr(Addr), StubIdx) ||
+      StubIdx >= StubFunctionNames.size())
     return StringRef();
+  return StubFunctionNames[StubIdx];
+}
 
-  ErrorOr<StringRef> SymNameOrErr = SI->getName();
-  if (auto ec = SymNameOrErr.getError())
-    report_fatal_error(ec.message());
-  StringRef SymName = *SymNameOrErr;
+void MCMachObjectSymbolizer::buildStubFunctionNames() {
+  const MachOAddressSpaceMap::Range *Stubs = AddrSpace.getStubs();
+  if (!Stubs || !Stubs->Reserved2)
+    return;
+  StubFunctionNames.resize((Stubs->End - Stubs->Start) / Stubs->Reserved2);
+
+  const MachO::dysymtab_command Dysymtab = MOOF.getDysymtabLoadCommand();
+  const uint32_t NumSyms = MOOF.getSymtabLoadCommand().nsyms;
+  for (size_t StubIdx = 0, E = StubFunctionNames.size(); StubIdx != E;
+       ++StubIdx) {
+    // The indirect symbols of the stubs start at the section's reserved1.
+    const uint64_t IndirectIdx = Stubs->Reserved1 + StubIdx;
+    if (IndirectIdx >= Dysymtab.nindirectsyms)
+      break;
+    // This also skips INDIRECT_SYMBOL_LOCAL and INDIRECT_SYMBOL_ABS.
+    uint32_t SymtabIdx =
+        MOOF.getIndirectSymbolTableEntry(Dysymtab, IndirectIdx);
+    if (SymtabIdx >= NumSyms)
+      continue;
+    symbol_iterator SI = MOOF.getSymbolByIndex(SymtabIdx);
 
-  assert(SymName.front() == '_' && "Mach-O symbol doesn't start with '_'!");
+    uint8_t NType =
+        MOOF.is64Bit()
+            ? MOOF.getSymbol64TableEntry(SI->getRawDataRefImpl()).n_type
+            : MOOF.getSymbolTableEntry(SI->getRawDataRefImpl()).n_type;
+    if ((NType & MachO::N_TYPE) != MachO::N_UNDF)
+      continue;
 
-  return SymName.substr(1);
+    ErrorOr<StringRef> SymNameOrErr = SI->getName();
+    if (SymNameOrErr.getError() || !SymNameOrErr->startswith("_")) {
+      DEBUG(dbgs() << "Unexpected symbol name for stub #" << StubIdx << "\n");
+      continue;
+    }
+    StubFunctionNames[StubIdx] = SymNameOrErr->substr(1);
+  }
 }
 
 uint64_t MCMachObjectSymbolizer::getEntrypoint() {
@@ -214,8 +199,10 @@ MCObjectSymbolizer::MCObjectSymbolizer(
     MCContext &Ctx, std::unique_ptr<MCRelocationInfo> RelInfo,
     const ObjectFile &Obj)
     : MCSymbolizer(Ctx, std::move(RelInfo)), Obj(Obj),
-      SymbolSizes(computeSymbolSizes(Obj)) {
+      SymbolSizes(computeSymbolSizes(Obj)), RelocCursor(0),
+      AddrToFunctionSymbolBuilt(false) {
   buildSectionList();
+  buildRelocationList();
 }
 
 uint64_t MCObjectSymbolizer::getEntrypoint() {
@@ -241,6 +228,9 @@ uint64_t MCObjectSymbolizer::getEffectiveLoadAddr(uint64_t Addr) {
 
 uint64_t MCObjectSymbolizer::getOriginalLoadAddr(uint64_t Addr) { return Addr; }
 
+// This can run on several threads at once, once the lookup tables are
+// built: the symbols are referenced through the concurrent cache of the
+// context, and the other expressions are created under its lock.
 bool MCObjectSymbolizer::
 tryAddingSymbolicOperand(MCInst &MI, raw_ostream &cStream,
                          int64_t Value, uint64_t Address, bool IsBranch,
@@ -248,14 +238,17 @@ tryAddingSymbolicOperand(MCInst &MI, raw_ostream &cStream,
   if (IsBranch) {
     StringRef ExtFnName = findExternalFunctionAt((uint64_t)Value);
     if (!ExtFnName.empty()) {
-      MCSymbol *Sym = Ctx.getOrCreateSymbol(ExtFnName);
-      const MCExpr *Expr = MCSymbolRefExpr::create(Sym, Ctx);
-      MI.addOperand(MCOperand::createExpr(Expr));
+      MI.addOperand(MCOperand::createExpr(
+          Ctx.getOrCreateSymbolRefConcurrently(ExtFnName)));
       return true;
     }
   }
 
-  if (const RelocationRef *R = findRelocationAt(Address + Offset)) {
+  size_t Cursor = RelocCursor.load(std::memory_order_relaxed);
+  const RelocationRef *R = findRelocationAt(Address + Offset, Cursor);
+  RelocCursor.store(Cursor, std::memory_order_relaxed);
+  if (R) {
+    std::unique_lock<std::mutex> Lock = Ctx.lockForCreation();
     if (const MCExpr *RelExpr = RelInfo->createExprForRelocation(*R)) {
       MI.addOperand(MCOperand::createExpr(RelExpr));
       return true;
@@ -269,12 +262,12 @@ tryAddingSymbolicOperand(MCInst &MI, raw_ostream &cStream,
     return false;
 
   uint64_t SymbolOffset;
-  MCSymbol *Sym = findContainingFunction(Value, SymbolOffset);
+  const MCExpr *Expr = findContainingFunction(Value, SymbolOffset);
 
-  if (!Sym)
+  if (!Expr)
     return false;
-  const MCExpr *Expr = MCSymbolRefExpr::create(Sym, Ctx);
   if (SymbolOffset) {
+    std::unique_lock<std::mutex> Lock = Ctx.lockForCreation();
     const MCExpr *Off = MCConstantExpr::create(SymbolOffset, Ctx);
     Expr = MCBinaryExpr::createAdd(Expr, Off, Ctx);
   }
@@ -282,11 +275,10 @@ tryAddingSymbolicOperand(MCInst &MI, raw_ostream &cStream,
   return true;
 }
 
-MCSymbol *MCObjectSymbolizer::
+const MCSymbolRefExpr *MCObjectSymbolizer::
 findContainingFunction(uint64_t Addr, uint64_t &Offset)
 {
-  if (AddrToFunctionSymbol.empty())
-    buildAddrToFunctionSymbolMap();
+  buildLookupTables();
 
   const FunctionSymbol FS(Addr);
   auto SB = AddrToFunctionSymbol.begin();
@@ -301,14 +293,22 @@ findContainingFunction(uint64_t Addr, uint64_t &Offset)
   // and zero size.
   --SI;
   const uint64_t SymAddr = SI->Addr;
-  MCSymbol *Sym = 0;
+  const MCSymbolRefExpr *Ref = nullptr;
   Offset = Addr - SymAddr;
   do {
     if (SymAddr == Addr || SymAddr + SI->Size > Addr)
-      Sym = SI->Sym;
+      Ref = SI->Ref;
   } while (SI != SB && (--SI)->Addr == SymAddr);
 
-  return Sym;
+  return Ref;
+}
+
+void MCObjectSymbolizer::buildLookupTables() {
+  // The sections, their relocations, and the stubs, are built upfront.
+  if (!AddrToFunctionSymbolBuilt) {
+    buildAddrToFunctionSymbolMap();
+    AddrToFunctionSymbolBuilt = true;
+  }
 }
 
 void MCObjectSymbolizer::buildAddrToFunctionSymbolMap() {
@@ -333,8 +333,9 @@ void MCObjectSymbolizer::buildAddrToFunctionSymbolMap() {
     if (SymName.empty() || SymType != SymbolRef::ST_Function)
       continue;
 
-    MCSymbol *Sym = Ctx.getOrCreateSymbol(SymName);
-    AddrToFunctionSymbol.push_back(FunctionSymbol(SymAddr, SymSize, Sym));
+    // The references are shared by all the operands to the function.
+    AddrToFunctionSymbol.push_back(FunctionSymbol(
+        SymAddr, SymSize, Ctx.getOrCreateSymbolRefConcurrently(SymName)));
   }
   std::stable_sort(AddrToFunctionSymbol.begin(), AddrToFunctionSymbol.end());
 }
@@ -377,15 +378,28 @@ MCObjectSymbolizer::findSectionInfoContaining(uint64_t Addr) {
 }
 
 const RelocationRef *MCObjectSymbolizer::findRelocationAt(uint64_t Addr) const {
-  const SectionInfo *SecInfo = findSectionInfoContaining(Addr);
-  if (!SecInfo)
-    return nullptr;
-  // FIXME: Offset vs Addr ?
-  auto RI = std::lower_bound(SecInfo->Relocs.begin(), SecInfo->Relocs.end(),
-                             Addr, RelocU64OffsetComparator);
-  if (RI == SecInfo->Relocs.end())
+  size_t Cursor = 0;
+  return findRelocationAt(Addr, Cursor);
+}
+
+const RelocationRef *
+MCObjectSymbolizer::findRelocationAt(uint64_t Addr, size_t &Cursor) const {
+  // Going back, as to another block, starts over.
+  if (Cursor > RelocAddrs.size() || (Cursor && RelocAddrs[Cursor - 1] >= Addr))
+    Cursor = 0;
+  // The next instructions of a block have their relocations a few entries
+  // ahead at most: walk there, and search what's left if that's not enough.
+  auto I = RelocAddrs.begin() + Cursor, E = RelocAddrs.end();
+  for (unsigned Steps = 0; I != E && *I < Addr; ++I) {
+    if (++Steps == 8) {
+      I = std::lower_bound(I, E, Addr);
+      break;
+    }
+  }
+  Cursor = I - RelocAddrs.begin();
+  if (I == E || *I != Addr)
     return nullptr;
-  return &*RI;
+  return &SortedRelocs[Cursor];
 }
 
 void MCObjectSymbolizer::buildSectionList() {
@@ -393,12 +407,9 @@ void MCObjectSymbolizer::buildSectionList() {
     SortedSections.push_back(Section);
   std::sort(SortedSections.begin(), SortedSections.end());
 
+  // Sanity check that we don't have overlapping sections.
   uint64_t PrevSecEnd = 0;
   for (auto &SecInfo : SortedSections) {
-    // First build the relocation map for this section.
-    buildRelocationByAddrMap(SecInfo);
-
-    // Also, sanity check that we don't have overlapping sections.
     uint64_t SAddr = SecInfo.Section.getAddress();
     uint64_t SSize = SecInfo.Section.getSize();
     if (PrevSecEnd > SAddr)
@@ -407,12 +418,31 @@ void MCObjectSymbolizer::buildSectionList() {
   }
 }
 
-void MCObjectSymbolizer::buildRelocationByAddrMap(
-  MCObjectSymbolizer::SectionInfo &SecInfo) {
-  for (const RelocationRef &Reloc : SecInfo.Section.relocations())
-    SecInfo.Relocs.push_back(Reloc);
-  std::stable_sort(SecInfo.Relocs.begin(), SecInfo.Relocs.end(),
-                   RelocRelocOffsetComparator);
+void MCObjectSymbolizer::buildRelocationList() {
+  std::vector<std::pair<uint64_t, RelocationRef>> Relocs;
+  for (const SectionRef &Section : Obj.sections()) {
+    section_iterator Target = Section.getRelocatedSection();
+    if (Target == Obj.section_end())
+      continue;
+    // The relocations of an object file are at offsets in the section they
+    // apply to; the others are at their address already.
+    uint64_t Base = Obj.isRelocatableObject() ? Target->getAddress() : 0;
+    for (const RelocationRef &Reloc : Section.relocations())
+      Relocs.push_back(std::make_pair(Base + Reloc.getOffset(), Reloc));
+  }
+  // The first relocation at an address is the one that is looked up: keep
+  // the order of the tables.
+  std::stable_sort(Relocs.begin(), Relocs.end(),
+                   [](const std::pair<uint64_t, RelocationRef> &L,
+                      const std::pair<uint64_t, RelocationRef> &R) {
+                     return L.first < R.first;
+                   });
+  RelocAddrs.reserve(Relocs.size());
+  SortedRelocs.reserve(Relocs.size());
+  for (const auto &R : Relocs) {
+    RelocAddrs.push_back(R.first);
+    SortedRelocs.push_back(R.second);
+  }
 }
 
 MCObjectSymbolizer *
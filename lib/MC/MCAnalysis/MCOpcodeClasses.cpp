@@ -0,0 +1,53 @@
+//===- lib/MC/MCAnalysis/MCOpcodeClasses.cpp - Opcode classes -------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MC/MCAnalysis/MCOpcodeClasses.h"
+#include "llvm/MC/MCInstrAnalysis.h"
+#include "llvm/MC/MCInstrDesc.h"
+#include "llvm/MC/MCInstrInfo.h"
+
+using namespace llvm;
+
+uint8_t MCOpcodeClasses::computeClass(const MCInstrDesc &Desc) {
+  uint8_t Class = 0;
+  if (Desc.isBranch())
+    Class |= Branch;
+  if (Desc.isConditionalBranch())
+    Class |= CondBranch;
+  if (Desc.isIndirectBranch())
+    Class |= IndirectBranch;
+  if (Desc.isCall())
+    Class |= Call;
+  if (Desc.isReturn())
+    Class |= Return;
+  if (Desc.isTerminator())
+    Class |= Terminator;
+  if (Desc.isBarrier())
+    Class |= Barrier;
+  return Class;
+}
+
+MCOpcodeClasses::MCOpcodeClasses(const MCInstrAnalysis &MIA)
+    : ReturnOpcode(MIA.getReturnOpcode()) {
+  const MCInstrInfo &MII = MIA.getInstrInfo();
+  const unsigned NumOpcodes = MII.getNumOpcodes();
+  Classes.resize(NumOpcodes);
+  for (unsigned Opc = 0; Opc != NumOpcodes; ++Opc)
+    Classes[Opc] = computeClass(MII.get(Opc));
+
+  // There are few direct jumps: only they are asked for their call.
+  for (unsigned Opc = 0; Opc != NumOpcodes; ++Opc) {
+    if (!isDirectJump(Opc) || MII.get(Opc).isPseudo())
+      continue;
+    if (unsigned CallOpc = MIA.getTailCallOpcode(Opc)) {
+      TailCallOpcodes.resize(Opc + 1);
+      TailCallOpcodes[Opc] = CallOpc;
+    }
+  }
+}
@@ -0,0 +1,50 @@
+//===- lib/MC/MCAnalysis/MCRegisterUsage.cpp ------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MC/MCAnalysis/MCRegisterUsage.h"
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCInst.h"
+#include "llvm/MC/MCInstrInfo.h"
+#include "llvm/MC/MCRegisterInfo.h"
+
+using namespace llvm;
+
+MCRegisterUsage::MCRegisterUsage(const MCInstrInfo &MII,
+                                 const MCRegisterInfo &MRI)
+    : MII(MII), Read(MRI.getNumRegs()), Written(MRI.getNumRegs()) {}
+
+void MCRegisterUsage::addInst(const MCInst &Inst) {
+  const MCInstrDesc &Desc = MII.get(Inst.getOpcode());
+  for (unsigned I = 0, E = Inst.getNumOperands(); I != E; ++I) {
+    const MCOperand &MO = Inst.getOperand(I);
+    if (!MO.isReg() || !MO.getReg())
+      continue;
+    // Tied defs (say, writeback base registers) are both read and written.
+    if (I < Desc.getNumDefs()) {
+      Written.set(MO.getReg());
+      if (Desc.getOperandConstraint(I, MCOI::TIED_TO) == -1)
+        continue;
+    }
+    Read.set(MO.getReg());
+  }
+  for (const MCPhysReg *R = Desc.getImplicitUses(); R && *R; ++R)
+    Read.set(*R);
+  for (const MCPhysReg *R = Desc.getImplicitDefs(); R && *R; ++R)
+    Written.set(*R);
+}
+
+void MCRegisterUsage::addBasicBlock(const MCBasicBlock &BB) {
+  for (const MCDecodedInst &DI : BB)
+    addInst(DI.Inst);
+}
+
+void MCRegisterUsage::addFunction(const MCFunction &F) {
+  for (const MCBasicBlock *BB : F)
+    addBasicBlock(*BB);
+}
@@ -9,10 +9,12 @@
 
 #include "llvm/MC/MCContext.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/MC/MCAssembler.h"
 #include "llvm/MC/MCAsmInfo.h"
 #include "llvm/MC/MCDwarf.h"
+#include "llvm/MC/MCExpr.h"
 #include "llvm/MC/MCLabel.h"
 #include "llvm/MC/MCObjectFileInfo.h"
 #include "llvm/MC/MCRegisterInfo.h"
@@ -82,6 +84,8 @@ void MCContext::reset() {
 
   UsedNames.clear();
   Symbols.clear();
+  for (ConcurrentSymbolShard &Shard : ConcurrentSymbolShards)
+    Shard.Refs.clear();
   Allocator.Reset();
   Instances.clear();
   CompilationDir.clear();
@@ -121,6 +125,19 @@ MCSymbol *MCContext::getOrCreateSymbol(const Twine &Name) {
   return Sym;
 }
 
+const MCSymbolRefExpr *
+MCContext::getOrCreateSymbolRefConcurrently(StringRef Name) {
+  ConcurrentSymbolShard &Shard =
+      ConcurrentSymbolShards[HashString(Name) % NumConcurrentSymbolShards];
+  std::lock_guard<std::mutex> ShardLock(Shard.Lock);
+  const MCSymbolRefExpr *&Ref = Shard.Refs[Name];
+  if (!Ref) {
+    std::lock_guard<std::mutex> Lock(CreationLock);
+    Ref = MCSymbolRefExpr::create(getOrCreateSymbol(Name), *this);
+  }
+  return Ref;
+}
+
 MCSymbolELF *MCContext::getOrCreateSectionSymbol(const MCSectionELF &Section) {
   MCSymbolELF *&Sym = SectionSymbols[&Section];
   if (Sym)
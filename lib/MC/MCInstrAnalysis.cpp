@@ -29,3 +29,73 @@ bool MCInstrAnalysis::evaluateBranch(const MCInst &Inst, uint64_t Addr,
   Addr = Absolute;
   return true;
 }
+
+MCInstrAnalysis::Classification
+MCInstrAnalysis::classify(const MCInst &Inst, uint64_t Addr,
+                          uint64_t Size) const {
+  const MCInstrDesc &Desc = Info->get(Inst.getOpcode());
+  Classification C;
+  C.Flags = Classification::Classified;
+  if (Desc.isBranch())
+    C.Flags |= Classification::Branch;
+  if (Desc.isConditionalBranch())
+    C.Flags |= Classification::ConditionalBranch;
+  if (Desc.isUnconditionalBranch())
+    C.Flags |= Classification::UnconditionalBranch;
+  if (Desc.isIndirectBranch())
+    C.Flags |= Classification::IndirectBranch;
+  if (Desc.isCall())
+    C.Flags |= Classification::Call;
+  if (Desc.isReturn())
+    C.Flags |= Classification::Return;
+  if (Desc.isTerminator())
+    C.Flags |= Classification::Terminator;
+  if ((Desc.isBranch() || Desc.isCall()) &&
+      evaluateBranch(Inst, Addr, Size, C.Target))
+    C.Flags |= Classification::HasTarget;
+  return C;
+}
+
+// Do \p A and \p B take the same kinds of operands.
+static bool haveSameOperands(const MCInstrDesc &A, const MCInstrDesc &B) {
+  if (A.getNumOperands() != B.getNumOperands() ||
+      A.getNumDefs() != B.getNumDefs())
+    return false;
+  for (unsigned I = 0, E = A.getNumOperands(); I != E; ++I) {
+    const MCOperandInfo &AI = A.OpInfo[I], &BI = B.OpInfo[I];
+    if (AI.RegClass != BI.RegClass || AI.OperandType != BI.OperandType)
+      return false;
+  }
+  return true;
+}
+
+unsigned MCInstrAnalysis::getTailCallOpcode(unsigned JumpOpcode) const {
+  const MCInstrDesc &Jump = Info->get(JumpOpcode);
+  unsigned CallOpcode = 0;
+  for (unsigned Opc = 0, E = Info->getNumOpcodes(); Opc != E; ++Opc) {
+    const MCInstrDesc &Desc = Info->get(Opc);
+    if (!Desc.isCall() || Desc.isReturn() || Desc.isIndirectBranch() ||
+        Desc.isPseudo() || !haveSameOperands(Jump, Desc))
+      continue;
+    // Several calls only differ by their encoding (X86 has one per operand
+    // size): which one is right depends on the mode.
+    if (CallOpcode)
+      return 0;
+    CallOpcode = Opc;
+  }
+  return CallOpcode;
+}
+
+unsigned MCInstrAnalysis::getReturnOpcode() const {
+  unsigned RetOpcode = 0;
+  for (unsigned Opc = 0, E = Info->getNumOpcodes(); Opc != E; ++Opc) {
+    const MCInstrDesc &Desc = Info->get(Opc);
+    if (!Desc.isReturn() || Desc.isCall() || Desc.isBranch() ||
+        Desc.isPseudo() || Desc.hasUnmodeledSideEffects())
+      continue;
+    if (RetOpcode)
+      return 0;
+    RetOpcode = Opc;
+  }
+  return RetOpcode;
+}
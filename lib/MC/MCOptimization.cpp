@@ -8,187 +8,508 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/MC/MCOptimization.h"
-//#include "Target/AArch64/AArch64.h"
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/StringSwitch.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Timer.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
 
 using namespace llvm;
 using namespace object;
 
+MCPeephole::~MCPeephole() {}
+
+MCOptimization::MCOptimization(MCModule* target_module, llvm::object::MachOObjectFile* target_obj_file,
+                               const MCInstrInfo &MII, const MCRegisterInfo &MRI)
+    : cur_module(target_module), cur_file(target_obj_file),
+      address_space(*target_obj_file) {
+    for(unsigned tmp_op = 0, tmp_e = MII.getNumOpcodes(); tmp_op != tmp_e; ++tmp_op){
+        opcodes_by_name[MII.getName(tmp_op)] = tmp_op;
+    }
+    for(unsigned tmp_reg = 1, tmp_e = MRI.getNumRegs(); tmp_reg != tmp_e; ++tmp_reg){
+        regs_by_name[MRI.getName(tmp_reg)] = tmp_reg;
+    }
+    analyze_macho_file_for_dynamic_symbol_name(cur_file);
+}
+
+MCOptimization::~MCOptimization() {}
 
 /*
- dynamic symbol table: value 
-  value-> symboltable index 
-  symbol table index-> symbol table string table index
+ stub index -> dynamic symbol table index (from __stubs reserved1)
+  dynamic symbol table value -> symbol table index
+  symbol table index -> symbol table string table index
   string table index -> symbol name
+
+ every stub is resolved once, here: peepholes look stubs up by index
  */
 void MCOptimization::analyze_macho_file_for_dynamic_symbol_name(llvm::object::MachOObjectFile* target_file){
-    bool has_stub_section = false;
-    bool has_string_table = false;
-    for(section_iterator target_section = target_file->section_begin();
-    target_section!=target_file->section_end(); ++target_section){
-        StringRef Name;
-        target_section->getName(Name);
-        if(Name == "__stubs"){
-            has_stub_section = true;
-            stub_section_add = target_section->getAddress();
-            stub_section_size = target_section->getSize();
-        }
+    const MachOAddressSpaceMap::Range* stubs = address_space.getStubs();
+    if(!stubs || !stubs->Reserved2){
+        return;
     }
+    stub_names.resize((stubs->End - stubs->Start) / stubs->Reserved2);
+
     MachO::dysymtab_command tmp_dysymtab_cmd = target_file->getDysymtabLoadCommand();
     MachO::symtab_command tmp_symtab_cmd = target_file->getSymtabLoadCommand();
     StringRef file_data = target_file->getData();
-    uint32_t dysymtable_off = tmp_dysymtab_cmd.indirectsymoff;
-    uint32_t dysymtable_size =  tmp_dysymtab_cmd.nindirectsyms;
-    uint32_t symtable_off = tmp_symtab_cmd.symoff;
-    uint32_t symtable_size = tmp_symtab_cmd.nsyms;
-    uint32_t str_off = tmp_symtab_cmd.stroff;
-
-    uint8_t* file_add = (uint8_t*)file_data.data();
-    uint64_t* dysymtable_name_add = (uint64_t*)malloc(sizeof(uint64_t)*dysymtable_size);
-    uint32_t* dysymtable_add = (uint32_t*)(file_add + dysymtable_off);
-    machO_sym_table* symtab_add = (machO_sym_table*)(file_add + symtable_off);
-    uint8_t* str_add = file_add+str_off;
-    
-    // get the dynamic sym table name address 
-    // the stub index is the dynamic symbol table index
-    for(uint32_t tmp_i=0;tmp_i<dysymtable_size;tmp_i++){
-        uint32_t tmp_sym_value = *(dysymtable_add+tmp_i);
-        if(tmp_sym_value>symtable_size){
+    const uint64_t nlist_size = target_file->is64Bit() ? sizeof(MachO::nlist_64) : sizeof(MachO::nlist);
+
+    // don't read past the end of the file, even with broken load commands
+    if(uint64_t(tmp_dysymtab_cmd.indirectsymoff) + uint64_t(tmp_dysymtab_cmd.nindirectsyms) * 4 > file_data.size() ||
+       uint64_t(tmp_symtab_cmd.symoff) + uint64_t(tmp_symtab_cmd.nsyms) * nlist_size > file_data.size() ||
+       uint64_t(tmp_symtab_cmd.stroff) + tmp_symtab_cmd.strsize > file_data.size()){
+        return;
+    }
+
+    const char* file_add = file_data.data();
+    const uint32_t* dysymtable_add = (const uint32_t*)(file_add + tmp_dysymtab_cmd.indirectsymoff);
+    const char* symtab_add = file_add + tmp_symtab_cmd.symoff;
+    StringRef str_table(file_add + tmp_symtab_cmd.stroff, tmp_symtab_cmd.strsize);
+
+    for(uint64_t tmp_i=0;tmp_i<stub_names.size();tmp_i++){
+        uint64_t tmp_dysym_idx = stubs->Reserved1 + tmp_i;
+        if(tmp_dysym_idx>=tmp_dysymtab_cmd.nindirectsyms){
+            break;
+        }
+        // INDIRECT_SYMBOL_LOCAL and INDIRECT_SYMBOL_ABS are out of range too
+        uint32_t tmp_sym_value = dysymtable_add[tmp_dysym_idx];
+        if(tmp_sym_value>=tmp_symtab_cmd.nsyms){
+            continue;
+        }
+        // n_strx is the first field of both nlist and nlist_64
+        uint32_t tmp_str_idx = *(const uint32_t*)(symtab_add + tmp_sym_value * nlist_size);
+        if(tmp_str_idx>=str_table.size()){
             continue;
         }
-        machO_sym_table* tmp_sym_table = symtab_add+tmp_sym_value;
-        uint32_t tmp_str_idx = tmp_sym_table->str_index;
-        uint8_t* sym_name_add = str_add+tmp_str_idx;
-        *(dysymtable_name_add+tmp_i) = (uint64_t)sym_name_add;
+        StringRef tmp_name = str_table.substr(tmp_str_idx);
+        stub_names[tmp_i] = tmp_name.substr(0, tmp_name.find('\0'));
+    }
+}
+
+StringRef MCOptimization::getStubName(uint64_t Addr) const {
+    uint64_t stub_index;
+    if(!getStubIndex(Addr, stub_index)){
+        return StringRef();
     }
-    sym_name_add = dysymtable_name_add;
-    sym_size = dysymtable_size;
+    return stub_names[stub_index];
+}
+
+void MCOptimization::addPeephole(std::unique_ptr<MCPeephole> P){
+    PeepholeInfo PI;
+    PI.P = std::move(P);
+    PI.NumRewrites = 0;
+    PI.WallTime = 0;
+    peepholes.push_back(std::move(PI));
+}
+
+void MCOptimization::addDefaultPeepholes(){
+    addPeephole(createARCEliminationPeephole(*this));
+    addPeephole(createSelectorPropagationPeephole(*this));
+    addPeephole(createStackCanaryStrippingPeephole(*this));
+    addPeephole(createNopRemovalPeephole(*this));
 }
 
-char* MCOptimization::get_called_func_name(uint64_t target_address){
-    
-   
-    if(target_address < stub_section_add){
-        return nullptr;
+void MCOptimization::try_to_optimize(unsigned NumJobs){
+    std::vector<MCFunction*> funcs;
+    for(MCModule::func_iterator FI = cur_module->func_begin(),
+    FE = cur_module->func_end();FI !=FE; ++FI){
+        funcs.push_back(&(**FI));
     }
-    if(target_address>(stub_section_add+stub_section_size)){
-        return nullptr;
+
+    // the same threads run all the peepholes, along with this one
+    ThreadPool pool(NumJobs > 1 ? NumJobs - 1 : 0);
+    for(PeepholeInfo& PI : peepholes){
+        TimeRecord start = TimeRecord::getCurrentTime(true);
+
+        // each function owns its instructions: they can be rewritten in parallel
+        const MCPeephole& P = *PI.P;
+        PerThread<uint64_t> num_rewrites(pool);
+        parallel_for(pool, 0, funcs.size(), [&](size_t tmp_i) {
+            num_rewrites.local() += P.runOnFunction(*funcs[tmp_i]);
+        });
+        for(uint64_t n : num_rewrites){
+            PI.NumRewrites += n;
+        }
+
+        TimeRecord elapsed = TimeRecord::getCurrentTime(false);
+        elapsed -= start;
+        PI.WallTime += elapsed.getWallTime();
     }
-    uint64_t stub_index = (target_address-stub_section_add)/stub_item_size;
-    if(stub_index>sym_size){
-        llvm_unreachable("stub index large than symbol table size");
+}
+
+void MCOptimization::printStatistics(raw_ostream &OS) const {
+    for(const PeepholeInfo& PI : peepholes){
+        OS << "MC peephole " << PI.P->getName() << ": " << PI.NumRewrites
+           << " rewrites, " << format("%.4f", PI.WallTime) << "s\n";
     }
-    uint64_t called_func_name_add  = *(sym_name_add+stub_index);
-    char* tmp_name;
-    tmp_name = (char*)called_func_name_add;
-    return tmp_name;
 }
 
+//===----------------------------------------------------------------------===//
+// AArch64 peepholes
+//===----------------------------------------------------------------------===//
+
+namespace {
+/// \brief The opcodes and registers common to the AArch64 peepholes.
+/// A peephole whose opcodes are missing (another target) does nothing.
+class AArch64Peephole : public MCPeephole {
+protected:
+    const MCOptimization& MCO;
+    unsigned BL, HINT;
+    unsigned X0, X1;
+    bool Valid;
+
+    AArch64Peephole(const MCOptimization& MCO)
+        : MCO(MCO), BL(MCO.getOpcode("BL")), HINT(MCO.getOpcode("HINT")),
+          X0(MCO.getReg("X0")), X1(MCO.getReg("X1")) {
+        Valid = BL && HINT && X0 && X1;
+    }
+
+    // the target of a bl, if it is one
+    bool getCallTarget(const MCDecodedInst& I, uint64_t& Target) const {
+        if(I.Inst.getOpcode() != BL || I.Inst.getNumOperands() != 1 || !I.Inst.getOperand(0).isImm()){
+            return false;
+        }
+        Target = I.Address + uint64_t(I.Inst.getOperand(0).getImm()) * 4;
+        return true;
+    }
+
+    // the index of the stub a bl goes through, if it does
+    bool getCalledStub(const MCDecodedInst& I, uint64_t& StubIndex) const {
+        uint64_t Target;
+        return getCallTarget(I, Target) && MCO.getStubIndex(Target, StubIndex);
+    }
+
+    // replace I by a nop (hint #0)
+    void makeNop(MCInst& I) const {
+        I.setOpcode(HINT);
+        I.clear();
+        I.addOperand(MCOperand::createImm(0));
+    }
+};
 
 /*
-  optimize different pattern code 
+ https://clang.llvm.org/docs/AutomaticReferenceCounting.html
+
+ id objc_autorelease(id value);
+ void objc_autoreleasePoolPop(void *pool);
+ void *objc_autoreleasePoolPush(void);
+ id objc_autoreleaseReturnValue(id value);
+ void objc_copyWeak(id *dest, id *src); x
+ void objc_destroyWeak(id *object);
+ id objc_initWeak(id *object, id value);
+ id objc_loadWeak(id *object);
+ id objc_loadWeakRetained(id *object);
+ void objc_moveWeak(id *dest, id *src);
+ void objc_release(id value);
+ id objc_retain(id value);
+ id objc_retainAutorelease(id value);
+ id objc_retainAutoreleaseReturnValue(id value);
+ id objc_retainAutoreleasedReturnValue(id value);
+ id objc_retainBlock(id value);
+ void objc_storeStrong(id *object, id value);
+ id objc_storeWeak(id *object, id value);
+
  */
-void MCOptimization::optimize_func_code(MCFunction* target_func){
-    for(MCFunction::iterator BI = target_func->begin(),
-    BE = target_func->end();BI!=BE;BI++){
-        MCBasicBlock* tmp_bb;
-        tmp_bb = *BI;
-        MCInst* pre_inst=nullptr;
-        const int base_x = 199;
-        std::vector<MCDecodedInst> optimized_inst = std::vector<MCDecodedInst>();
-        for(auto tmp_decode_inst=tmp_bb->begin();
-        tmp_decode_inst!=tmp_bb->end();tmp_decode_inst++){
-            MCInst* tmp_inst; 
-            tmp_inst = (MCInst*)&(tmp_decode_inst->Inst);
-            unsigned tmp_opcode = tmp_inst->getOpcode();
-            switch(tmp_opcode){
-                default:
+/// \brief Replace calls to the ARC runtime by their effect on the registers,
+/// or by nothing.
+class ARCElimination : public AArch64Peephole {
+    // what a call through a stub does, as far as ARC is concerned
+    enum ARCCallKind : uint8_t {
+        ARC_None,          // not an ARC runtime function
+        ARC_NoSideEffect,  // erased
+        ARC_MoveX1ToX0,    // replaced by mov x0, x1
+        ARC_StrX1ToX0,     // replaced by str x1, [x0]
+        ARC_LdrX0ToX0      // replaced by ldr x0, [x0]
+    };
+    // the ARCCallKind of each stub, by stub index
+    std::vector<uint8_t> stub_kinds;
+    unsigned ORRXrs, LDRXui, STRXui, XZR;
+
+    static ARCCallKind classify_arc_call(StringRef name){
+        return StringSwitch<ARCCallKind>(name)
+// for these explicitly state as `Always returns value'
+            .Case("_objc_autorelease", ARC_NoSideEffect)
+            .Case("_objc_autoreleaseReturnValue", ARC_NoSideEffect)
+            .Case("_objc_retain", ARC_NoSideEffect)
+            .Case("_objc_retainAutorelease", ARC_NoSideEffect)
+            .Case("_objc_retainAutoreleaseReturnValue", ARC_NoSideEffect)
+            .Case("_objc_retainAutoreleasedReturnValue", ARC_NoSideEffect)
+// for those remainings that take 1 arguments.
+            .Case("_objc_release", ARC_NoSideEffect)
+            .Case("_objc_destroyWeak", ARC_NoSideEffect)
+            .Case("_objc_autoreleasePoolPush", ARC_NoSideEffect)
+            .Case("_objc_autoreleasePoolPop", ARC_NoSideEffect)
+
+            .Case("_objc_copyWeak", ARC_MoveX1ToX0)
+            .Case("_objc_moveWeak", ARC_MoveX1ToX0)
+
+            .Case("_objc_storeStrong", ARC_StrX1ToX0)
+            .Case("_objc_storeWeak", ARC_StrX1ToX0)
+            .Case("_objc_initWeak", ARC_StrX1ToX0)
+
+            .Case("_objc_loadWeak", ARC_LdrX0ToX0)
+            .Case("_objc_loadWeakRetained", ARC_LdrX0ToX0)
+            .Default(ARC_None);
+    }
+
+public:
+    ARCElimination(const MCOptimization& MCO)
+        : AArch64Peephole(MCO), ORRXrs(MCO.getOpcode("ORRXrs")),
+          LDRXui(MCO.getOpcode("LDRXui")), STRXui(MCO.getOpcode("STRXui")),
+          XZR(MCO.getReg("XZR")) {
+        Valid = Valid && ORRXrs && LDRXui && STRXui && XZR;
+        stub_kinds.resize(MCO.getNumStubs());
+        for(size_t tmp_i = 0; tmp_i < stub_kinds.size(); tmp_i++){
+            stub_kinds[tmp_i] = classify_arc_call(MCO.getStubNameByIndex(tmp_i));
+        }
+    }
+
+    const char* getName() const override { return "ARC elimination"; }
+
+    unsigned runOnFunction(MCFunction& F) const override {
+        if(!Valid){
+            return 0;
+        }
+        unsigned num_rewrites = 0;
+        for(MCBasicBlock* BB : F){
+            for(MCDecodedInst& I : *BB){
+                uint64_t stub_index;
+                if(!getCalledStub(I, stub_index)){
+                    continue;
+                }
+                MCInst& tmp_inst = I.Inst;
+                switch(stub_kinds[stub_index]){
+                    default:
+                        continue;
+                    case ARC_NoSideEffect:
+                        makeNop(tmp_inst);
+                    break;
+                    case ARC_MoveX1ToX0:
+                        tmp_inst.setOpcode(ORRXrs);  // orr x0, xzr, x1
+                        tmp_inst.clear();
+                        tmp_inst.addOperand(MCOperand::createReg(X0));
+                        tmp_inst.addOperand(MCOperand::createReg(XZR));
+                        tmp_inst.addOperand(MCOperand::createReg(X1));
+                        tmp_inst.addOperand(MCOperand::createImm(0));
+                    break;
+                    case ARC_LdrX0ToX0:
+                        tmp_inst.setOpcode(LDRXui);  // ldr x0, [x0]
+                        tmp_inst.clear();
+                        tmp_inst.addOperand(MCOperand::createReg(X0));
+                        tmp_inst.addOperand(MCOperand::createReg(X0));
+                        tmp_inst.addOperand(MCOperand::createImm(0));
+                    break;
+                    case ARC_StrX1ToX0:
+                        tmp_inst.setOpcode(STRXui);  // str x1, [x0]
+                        tmp_inst.clear();
+                        tmp_inst.addOperand(MCOperand::createReg(X1));
+                        tmp_inst.addOperand(MCOperand::createReg(X0));
+                        tmp_inst.addOperand(MCOperand::createImm(0));
+                    break;
+                }
+                num_rewrites++;
+            }
+        }
+        return num_rewrites;
+    }
+};
+
+/// \brief Turn selector loads into constants:
+///   adrp xN, selref@PAGE                adrp xN, sel@PAGE
+///   ldr  xN, [xN, selref@PAGEOFF]   ->  add  xN, xN, sel@PAGEOFF
+/// where selref is an __objc_selrefs entry, which holds the address of sel,
+/// in __objc_methname. Selector loads into another register than the base
+/// are left alone: the rewritten adrp would change the base.
+class SelectorPropagation : public AArch64Peephole {
+    unsigned ADRP, LDRXui, ADDXri;
+    uint64_t selrefs_address;
+    StringRef selrefs;
+
+    // read the selector at selref, if it points into __objc_methname
+    bool read_selector(uint64_t selref, uint64_t& sel) const {
+        if(selref < selrefs_address || selref - selrefs_address + 8 > selrefs.size()){
+            return false;
+        }
+        sel = support::endian::read64le(selrefs.data() + (selref - selrefs_address));
+        return MCO.getAddressSpace().getKind(sel) == MachOAddressSpaceMap::SK_ObjCMethName;
+    }
+
+public:
+    SelectorPropagation(const MCOptimization& MCO)
+        : AArch64Peephole(MCO), ADRP(MCO.getOpcode("ADRP")),
+          LDRXui(MCO.getOpcode("LDRXui")), ADDXri(MCO.getOpcode("ADDXri")),
+          selrefs_address(0) {
+        for(const SectionRef& Section : MCO.getFile().sections()){
+            StringRef Name;
+            if(!Section.getName(Name) && Name == "__objc_selrefs"){
+                selrefs_address = Section.getAddress();
+                Section.getContents(selrefs);
                 break;
-                case OP_BL:{
-                    if(tmp_inst->getNumOperands()!=1){
-                        llvm_unreachable("OP_BL has more than one operand");
-                    }
-                    MCOperand tmp_operand = tmp_inst->getOperand(0);
-                    if(tmp_operand.isImm()==false){
-                      llvm_unreachable("OP_BL the first operand is not imm");
-                    }
-                    
-                    uint64_t target_address = tmp_decode_inst->Address;
-                    target_address = target_address + tmp_operand.getImm()*4;
-                    //if(target_address>cur_file->){
-                    char* target_func_name =  get_called_func_name(target_address);
-                    if(target_func_name==nullptr){
-                        break;
-                    }
-                    for (std::string s : NoneSideEffectAPI) {
-                    
-                        if(strcmp(target_func_name, s.c_str()) == 0){
-//                            errs() << s << "\n";
-                           // optimized_inst.push_back(*tmp_decode_inst);
-                           uint64_t cur_inst_add = tmp_decode_inst->Address;
-                            tmp_inst->setOpcode(0);
-                            NoneSemanticARC++;
-                        }
+            }
+        }
+        Valid = Valid && ADRP && LDRXui && ADDXri && !selrefs.empty() &&
+                MCO.getFile().isLittleEndian();
+    }
 
-                    }
+    const char* getName() const override { return "objc_msgSend selector propagation"; }
 
-                    for (std::string s : MoveX1ToX0Call){
-                        if(strcmp(target_func_name, s.c_str())==0){
-                            //tmp_inst->setOpcode();
-                            tmp_inst->setOpcode(1315);  //orrXrs
-                            tmp_inst->clear();
-                            
-                            tmp_inst->addOperand(MCOperand::createReg(base_x+0));
-                            tmp_inst->addOperand(MCOperand::createReg(7));
-                            tmp_inst->addOperand(MCOperand::createReg(base_x+1));
-                            tmp_inst->addOperand(MCOperand::createImm(0));
-                            SemanticARC++;
-
-                        }
-                    }
-                    for (std::string s: LDRX0ADDToX0Call){
-                        if(strcmp(target_func_name,s.c_str())==0){
-                            tmp_inst->setOpcode(1112);//LdrXui
-                            tmp_inst->clear();
-                            tmp_inst->addOperand(MCOperand::createReg(base_x+0));
-                            tmp_inst->addOperand(MCOperand::createReg(base_x+0));
-                            tmp_inst->addOperand(MCOperand::createImm(0));
-                            SemanticARC++;
-
-                        }
-                    }
+    unsigned runOnFunction(MCFunction& F) const override {
+        if(!Valid){
+            return 0;
+        }
+        unsigned num_rewrites = 0;
+        for(MCBasicBlock* BB : F){
+            for(MCBasicBlock::iterator I = BB->begin(), E = BB->end(); I != E && I + 1 != E; ++I){
+                MCInst& Adrp = I->Inst;
+                MCInst& Ldr = (I + 1)->Inst;
+                if(Adrp.getOpcode() != ADRP || Ldr.getOpcode() != LDRXui ||
+                   !Adrp.getOperand(1).isImm() || !Ldr.getOperand(2).isImm()){
+                    continue;
+                }
+                unsigned Reg = Adrp.getOperand(0).getReg();
+                if(Ldr.getOperand(0).getReg() != Reg || Ldr.getOperand(1).getReg() != Reg){
+                    continue;
+                }
+                uint64_t page = (I->Address & ~0xFFFULL) + uint64_t(Adrp.getOperand(1).getImm()) * 4096;
+                uint64_t selref = page + uint64_t(Ldr.getOperand(2).getImm()) * 8;
+                uint64_t sel;
+                if(!read_selector(selref, sel)){
+                    continue;
+                }
 
-                    for(std::string s: StrX1ToX0ADDCall){
-                        if(strcmp(target_func_name,s.c_str())==0){
-                            tmp_inst->setOpcode(2102); //StrXui
-                            tmp_inst->clear();
-                            tmp_inst->addOperand(MCOperand::createReg(base_x+0));
-                            tmp_inst->addOperand(MCOperand::createReg(base_x+1));
-                            tmp_inst->addOperand(MCOperand::createImm(0));
-                            SemanticARC++;
+                Adrp.getOperand(1).setImm(int64_t(sel >> 12) - int64_t(I->Address >> 12));
+                Ldr.setOpcode(ADDXri);
+                Ldr.clear();
+                Ldr.addOperand(MCOperand::createReg(Reg));
+                Ldr.addOperand(MCOperand::createReg(Reg));
+                Ldr.addOperand(MCOperand::createImm(sel & 0xFFF));
+                Ldr.addOperand(MCOperand::createImm(0));  // lsl #0
+                num_rewrites++;
+                ++I;
+            }
+        }
+        return num_rewrites;
+    }
+};
 
-                        }
-                    }
+/// \brief Remove the stack protector checks: the conditional branches to
+/// blocks starting with a call to ___stack_chk_fail become nops, and so do the
+/// calls once no other path reaches them. The other calls, e.g. those the
+/// compiler placed on the fall-through path, become traps (brk #1): the
+/// failing path never runs into the next block. The guard loads and the
+/// compare are left in place: they then have no use.
+class StackCanaryStripping : public AArch64Peephole {
+    unsigned Bcc, BRK;
+    BitVector chk_fail_stubs;
+
+    bool is_chk_fail_call(const MCDecodedInst& I) const {
+        uint64_t stub_index;
+        return getCalledStub(I, stub_index) && chk_fail_stubs.test(stub_index);
+    }
 
+    void make_trap(MCInst& I) const {
+        I.setOpcode(BRK);
+        I.clear();
+        I.addOperand(MCOperand::createImm(1));
+    }
+
+public:
+    StackCanaryStripping(const MCOptimization& MCO)
+        : AArch64Peephole(MCO), Bcc(MCO.getOpcode("Bcc")),
+          BRK(MCO.getOpcode("BRK")), chk_fail_stubs(MCO.getNumStubs()) {
+        for(size_t tmp_i = 0; tmp_i < MCO.getNumStubs(); tmp_i++){
+            if(MCO.getStubNameByIndex(tmp_i) == "___stack_chk_fail"){
+                chk_fail_stubs.set(tmp_i);
+            }
+        }
+        Valid = Valid && Bcc && BRK && chk_fail_stubs.any();
+    }
+
+    const char* getName() const override { return "stack canary stripping"; }
+
+    unsigned runOnFunction(MCFunction& F) const override {
+        if(!Valid){
+            return 0;
+        }
+        unsigned num_rewrites = 0;
+        for(MCBasicBlock* BB : F){
+            if(BB->empty()){
+                continue;
+            }
+            const bool starts_with_fail = is_chk_fail_call(*BB->begin());
+            // the block is only unreachable once all its predecessors are
+            // conditional branches to it, rewritten
+            bool unreachable = starts_with_fail && BB->pred_begin() != BB->pred_end();
+            for(auto PI = BB->pred_begin(), PE = BB->pred_end(); starts_with_fail && PI != PE; ++PI){
+                // predecessors are in F too, which we are allowed to modify
+                MCBasicBlock* Pred = const_cast<MCBasicBlock*>(*PI);
+                MCDecodedInst* Br = Pred->empty() ? nullptr : &Pred->back();
+                if(!Br || Br->Inst.getOpcode() != Bcc || Br->Inst.getNumOperands() != 2 ||
+                   !Br->Inst.getOperand(1).isImm() || Br->Address + 4 == BB->getStartAddr()){
+                    unreachable = false;
+                    continue;
                 }
+                uint64_t target = Br->Address + uint64_t(Br->Inst.getOperand(1).getImm()) * 4;
+                if(target != BB->getStartAddr()){
+                    unreachable = false;
+                    continue;
+                }
+                makeNop(Br->Inst);
+                num_rewrites++;
             }
-            
-       }
-       
+            for(MCDecodedInst& I : *BB){
+                if(is_chk_fail_call(I)){
+                    if(unreachable){
+                        makeNop(I.Inst);
+                    }else{
+                        make_trap(I.Inst);
+                    }
+                    num_rewrites++;
+                }
+            }
+        }
+        return num_rewrites;
     }
-}
+};
 
-void MCOptimization::try_to_optimize(){
-    for(MCModule::func_iterator FI = cur_module->func_begin(),
-    FE = cur_module->func_end();FI !=FE; ++FI){
-        MCFunction* tmp_func;
-        tmp_func = &(**FI);
-        optimize_func_code(tmp_func);
+/// \brief Erase the nops (hint #0), including those left by the other
+/// peepholes. The other instructions keep their addresses.
+class NopRemoval : public AArch64Peephole {
+public:
+    NopRemoval(const MCOptimization& MCO) : AArch64Peephole(MCO) {}
+
+    const char* getName() const override { return "NOP removal"; }
+
+    unsigned runOnFunction(MCFunction& F) const override {
+        if(!Valid){
+            return 0;
+        }
+        unsigned num_rewrites = 0;
+        for(MCBasicBlock* BB : F){
+            num_rewrites += BB->removeInsts([&](const MCDecodedInst& I) {
+                return I.Inst.getOpcode() == HINT && I.Inst.getNumOperands() == 1 &&
+                       I.Inst.getOperand(0).isImm() && I.Inst.getOperand(0).getImm() == 0;
+            });
+        }
+        return num_rewrites;
     }
-//    errs()<<"bl _obj_release size : "<<BL_OBJ_RELEASE_SIZE<<"\n";
-}
+};
+} // end anonymous namespace
 
-uint64_t MCOptimization::getNoneSemanticARCCount() const {return NoneSemanticARC;}
-uint64_t MCOptimization::getSemanticARCCount() const {return SemanticARC;}
+std::unique_ptr<MCPeephole> llvm::createARCEliminationPeephole(const MCOptimization& MCO){
+    return std::unique_ptr<MCPeephole>(new ARCElimination(MCO));
+}
+std::unique_ptr<MCPeephole> llvm::createSelectorPropagationPeephole(const MCOptimization& MCO){
+    return std::unique_ptr<MCPeephole>(new SelectorPropagation(MCO));
+}
+std::unique_ptr<MCPeephole> llvm::createStackCanaryStrippingPeephole(const MCOptimization& MCO){
+    return std::unique_ptr<MCPeephole>(new StackCanaryStripping(MCO));
+}
+std::unique_ptr<MCPeephole> llvm::createNopRemovalPeephole(const MCOptimization& MCO){
+    return std::unique_ptr<MCPeephole>(new NopRemoval(MCO));
+}
 
 //http://infocenter.arm.com/help/index.jsp?topic=/com.arm.doc.dui0489h/Cjafcggi.html
-
@@ -0,0 +1,213 @@
+//===- DyldSharedCache.cpp - Images of a dyld shared cache ----------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Object/DyldSharedCache.h"
+#include "llvm/Object/MachO.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/Path.h"
+#include <algorithm>
+
+using namespace llvm;
+using namespace object;
+
+// The fields of dyld_cache_header this reads.
+enum {
+  CacheMappingOffset = 0x10,
+  CacheMappingCount = 0x14,
+  CacheImagesOffsetOld = 0x18,
+  CacheImagesCountOld = 0x1C,
+  CacheSlideInfoOffset = 0x38,
+  CacheSlideInfoSize = 0x40,
+  // Since the caches with subcaches, the images moved here, and the old
+  // fields are 0.
+  CacheImagesOffset = 0x1C0,
+  CacheImagesCount = 0x1C4
+};
+
+static const uint64_t MappingInfoSize = 32;
+static const uint64_t ImageInfoSize = 32;
+
+bool DyldSharedCache::isDyldSharedCache(StringRef Buffer) {
+  return Buffer.startswith("dyld_v1");
+}
+
+DyldSharedCache::DyldSharedCache(MemoryBufferRef Buffer)
+    : Buffer(Buffer), SlideVersion(0), DeltaMask(0), ValueAdd(0) {}
+
+ErrorOr<std::unique_ptr<DyldSharedCache>>
+DyldSharedCache::create(MemoryBufferRef Buffer) {
+  std::unique_ptr<DyldSharedCache> Cache(new DyldSharedCache(Buffer));
+  if (std::error_code EC = Cache->parse())
+    return EC;
+  return std::move(Cache);
+}
+
+std::error_code DyldSharedCache::parse() {
+  StringRef Data = Buffer.getBuffer();
+  if (!isDyldSharedCache(Data) || Data.size() < CacheSlideInfoSize + 8)
+    return object_error::invalid_file_type;
+  const uint8_t *Base = Data.bytes_begin();
+  auto read32 = [&](uint64_t Off) {
+    return support::endian::read32le(Base + Off);
+  };
+  auto read64 = [&](uint64_t Off) {
+    return support::endian::read64le(Base + Off);
+  };
+
+  uint64_t MappingOffset = read32(CacheMappingOffset);
+  uint64_t MappingCount = read32(CacheMappingCount);
+  if (MappingOffset + MappingCount * MappingInfoSize > Data.size())
+    return object_error::parse_failed;
+  for (uint64_t I = 0; I != MappingCount; ++I) {
+    uint64_t Off = MappingOffset + I * MappingInfoSize;
+    Mapping M = {read64(Off), read64(Off + 8), read64(Off + 16)};
+    if (M.FileOffset + M.Size > Data.size())
+      return object_error::parse_failed;
+    Mappings.push_back(M);
+  }
+
+  uint64_t ImagesOffset = read32(CacheImagesOffsetOld);
+  uint64_t ImagesCount = read32(CacheImagesCountOld);
+  // The header is as large as the mappings start, so that the older caches
+  // don't have the new fields.
+  if (!ImagesCount && MappingOffset >= CacheImagesCount + 4) {
+    ImagesOffset = read32(CacheImagesOffset);
+    ImagesCount = read32(CacheImagesCount);
+  }
+  if (ImagesOffset + ImagesCount * ImageInfoSize > Data.size())
+    return object_error::parse_failed;
+  for (uint64_t I = 0; I != ImagesCount; ++I) {
+    uint64_t Off = ImagesOffset + I * ImageInfoSize;
+    uint64_t PathOffset = read32(Off + 24);
+    if (PathOffset >= Data.size())
+      return object_error::parse_failed;
+    StringRef Path = Data.substr(PathOffset);
+    Image Img = {read64(Off), Path.substr(0, Path.find('\0'))};
+    Images.push_back(Img);
+  }
+
+  // The slide info of the first caches: version 2 for arm64, whose pointers
+  // keep the delta to the next one in their top bits, and version 3 for
+  // arm64e, whose authenticated pointers are offsets from the cache.
+  if (MappingOffset >= CacheSlideInfoSize + 8) {
+    uint64_t SlideOffset = read64(CacheSlideInfoOffset);
+    uint64_t SlideSize = read64(CacheSlideInfoSize);
+    if (SlideOffset && SlideSize >= 40 &&
+        SlideOffset + SlideSize <= Data.size()) {
+      uint32_t Version = read32(SlideOffset);
+      if (Version == 2) {
+        SlideVersion = 2;
+        DeltaMask = read64(SlideOffset + 24);
+        ValueAdd = read64(SlideOffset + 32);
+      } else if (Version == 3) {
+        SlideVersion = 3;
+        ValueAdd = read64(SlideOffset + 16);
+      }
+    }
+  }
+  return std::error_code();
+}
+
+const DyldSharedCache::Image *
+DyldSharedCache::findImage(StringRef Path) const {
+  const Image *Found = nullptr;
+  unsigned NumNamed = 0;
+  for (const Image &I : Images) {
+    if (I.Path == Path)
+      return &I;
+    if (sys::path::filename(I.Path) == Path) {
+      Found = &I;
+      ++NumNamed;
+    }
+  }
+  return NumNamed == 1 ? Found : nullptr;
+}
+
+bool DyldSharedCache::getFileOffset(uint64_t Addr, uint64_t &Offset) const {
+  for (const Mapping &M : Mappings)
+    if (Addr >= M.Address && Addr - M.Address < M.Size) {
+      Offset = M.FileOffset + (Addr - M.Address);
+      return true;
+    }
+  return false;
+}
+
+ErrorOr<std::unique_ptr<MachOObjectFile>>
+DyldSharedCache::createImageObject(const Image &I) const {
+  uint64_t Offset;
+  if (!getFileOffset(I.Address, Offset))
+    return object_error::parse_failed;
+  return ObjectFile::createMachOObjectFile(Buffer, Offset);
+}
+
+bool DyldSharedCache::readPointer(uint64_t Addr, uint64_t &Value) const {
+  uint64_t Offset;
+  if (!getFileOffset(Addr, Offset) || Offset + 8 > Buffer.getBufferSize())
+    return false;
+  uint64_t Raw = support::endian::read64le(
+      Buffer.getBuffer().bytes_begin() + Offset);
+  switch (SlideVersion) {
+  case 2:
+    Value = Raw & ~DeltaMask;
+    if (Value)
+      Value += ValueAdd;
+    break;
+  case 3:
+    if (Raw >> 63) {
+      // auth: a 32-bit offset from the cache.
+      Value = ValueAdd + (Raw & 0xFFFFFFFF);
+    } else {
+      // plain: a 43-bit address, with its top byte in bits 43 to 50.
+      Value = (Raw & 0x7FFFFFFFFFFULL) | (((Raw >> 43) & 0xFF) << 56);
+    }
+    break;
+  default:
+    Value = Raw;
+  }
+  return true;
+}
+
+void DyldSharedCache::buildSymbols() const {
+  for (const Image &I : Images) {
+    auto MachOOrErr = createImageObject(I);
+    if (!MachOOrErr)
+      continue;
+    for (const SymbolRef &Sym : (*MachOOrErr)->symbols()) {
+      uint32_t Flags = Sym.getFlags();
+      if (!(Flags & SymbolRef::SF_Global) ||
+          (Flags & SymbolRef::SF_Undefined))
+        continue;
+      ErrorOr<uint64_t> AddrOrErr = Sym.getAddress();
+      ErrorOr<StringRef> NameOrErr = Sym.getName();
+      if (!AddrOrErr || !NameOrErr || !*AddrOrErr)
+        continue;
+      Symbols.push_back(std::make_pair(*AddrOrErr, *NameOrErr));
+    }
+  }
+  // Of the images that export the same address, as re-exports do, the first
+  // one wins.
+  std::stable_sort(Symbols.begin(), Symbols.end(),
+                   [](const std::pair<uint64_t, StringRef> &L,
+                      const std::pair<uint64_t, StringRef> &R) {
+                     return L.first < R.first;
+                   });
+}
+
+StringRef DyldSharedCache::findSymbolAt(uint64_t Addr) const {
+  std::call_once(SymbolsBuilt, [this]() { buildSymbols(); });
+  auto I = std::lower_bound(Symbols.begin(), Symbols.end(),
+                            std::make_pair(Addr, StringRef()),
+                            [](const std::pair<uint64_t, StringRef> &L,
+                               const std::pair<uint64_t, StringRef> &R) {
+                              return L.first < R.first;
+                            });
+  if (I == Symbols.end() || I->first != Addr)
+    return StringRef();
+  return I->second;
+}
@@ -0,0 +1,86 @@
+//===- MachOAddressSpaceMap.cpp - Mach-O section kind lookup --------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Object/MachOAddressSpaceMap.h"
+#include "llvm/ADT/StringSwitch.h"
+#include "llvm/Object/MachO.h"
+#include <algorithm>
+
+using namespace llvm;
+using namespace object;
+
+static MachOAddressSpaceMap::SectionKind
+getSectionKind(StringRef Name, bool IsText) {
+  typedef MachOAddressSpaceMap M;
+  M::SectionKind Kind = StringSwitch<M::SectionKind>(Name)
+      .Case("__stubs", M::SK_Stubs)
+      .Case("__stub_helper", M::SK_StubHelper)
+      .Case("__cstring", M::SK_CString)
+      .Case("__objc_methname", M::SK_ObjCMethName)
+      .Case("__objc_const", M::SK_ObjCConst)
+      .Case("__objc_classrefs", M::SK_ObjCClassRefs)
+      .Case("__objc_selrefs", M::SK_ObjCSelRefs)
+      .Case("__la_symbol_ptr", M::SK_LazySymbolPtr)
+      .Case("__nl_symbol_ptr", M::SK_NonLazySymbolPtr)
+      .Case("__got", M::SK_NonLazySymbolPtr)
+      .Default(M::SK_Other);
+  if (Kind == M::SK_Other && IsText)
+    return M::SK_Text;
+  return Kind;
+}
+
+MachOAddressSpaceMap::MachOAddressSpaceMap(const MachOObjectFile &MachO)
+    : HasStubs(false), Stubs() {
+  for (const SectionRef &Section : MachO.sections()) {
+    uint64_t Size = Section.getSize();
+    if (!Size)
+      continue;
+
+    StringRef Name;
+    if (Section.getName(Name))
+      continue;
+
+    Range R;
+    R.Start = Section.getAddress();
+    R.End = R.Start + Size;
+    R.Kind = getSectionKind(Name, Section.isText());
+    if (MachO.is64Bit()) {
+      MachO::section_64 S = MachO.getSection64(Section.getRawDataRefImpl());
+      R.Reserved1 = S.reserved1;
+      R.Reserved2 = S.reserved2;
+    } else {
+      MachO::section S = MachO.getSection(Section.getRawDataRefImpl());
+      R.Reserved1 = S.reserved1;
+      R.Reserved2 = S.reserved2;
+    }
+    Ranges.push_back(R);
+
+    // Stubs are looked up on every branch: keep them at hand.
+    if (R.Kind == SK_Stubs && !HasStubs) {
+      HasStubs = true;
+      Stubs = R;
+    }
+  }
+
+  std::sort(Ranges.begin(), Ranges.end(),
+            [](const Range &L, const Range &R) { return L.Start < R.Start; });
+}
+
+const MachOAddressSpaceMap::Range *
+MachOAddressSpaceMap::findRange(uint64_t Addr) const {
+  auto I = std::upper_bound(
+      Ranges.begin(), Ranges.end(), Addr,
+      [](uint64_t Addr, const Range &R) { return Addr < R.Start; });
+  if (I == Ranges.begin())
+    return nullptr;
+  --I;
+  if (Addr < I->End)
+    return &*I;
+  return nullptr;
+}
@@ -0,0 +1,405 @@
+//===- MachOBindingIndex.cpp - Mach-O dyld binding lookup -----------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Object/MachOBindingIndex.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/LEB128.h"
+#include "llvm/Support/MathExtras.h"
+#include <algorithm>
+
+using namespace llvm;
+using namespace object;
+
+static bool compareBindings(const MachOBindingIndex::Binding &L,
+                            const MachOBindingIndex::Binding &R) {
+  if (L.Address != R.Address)
+    return L.Address < R.Address;
+  return L.Kind < R.Kind;
+}
+
+MachOBindingIndex::MachOBindingIndex(const MachOObjectFile &MachO) {
+  // Bindings are relative to segments, numbered in load command order.
+  std::vector<uint64_t> SegmentAddrs, SegmentOffsets;
+  // The address the image is mapped at: that of the segment mapping the
+  // headers, __TEXT.
+  uint64_t ImageBase = 0;
+  bool HasChainedFixups = false;
+  for (const auto &Load : MachO.load_commands()) {
+    uint64_t VMAddr, FileOff, FileSize;
+    if (Load.C.cmd == MachO::LC_SEGMENT_64) {
+      MachO::segment_command_64 Seg = MachO.getSegment64LoadCommand(Load);
+      VMAddr = Seg.vmaddr;
+      FileOff = Seg.fileoff;
+      FileSize = Seg.filesize;
+    } else if (Load.C.cmd == MachO::LC_SEGMENT) {
+      MachO::segment_command Seg = MachO.getSegmentLoadCommand(Load);
+      VMAddr = Seg.vmaddr;
+      FileOff = Seg.fileoff;
+      FileSize = Seg.filesize;
+    } else {
+      HasChainedFixups |= Load.C.cmd == MachO::LC_DYLD_CHAINED_FIXUPS;
+      continue;
+    }
+    SegmentAddrs.push_back(VMAddr);
+    SegmentOffsets.push_back(FileOff);
+    if (FileOff == 0 && FileSize != 0 && !ImageBase)
+      ImageBase = VMAddr;
+  }
+
+  auto AddAll = [&](iterator_range<bind_iterator> Table,
+                    MachOBindEntry::Kind K) {
+    for (const MachOBindEntry &Entry : Table) {
+      if (Entry.segmentIndex() >= SegmentAddrs.size())
+        continue;
+      Binding B;
+      B.Address = SegmentAddrs[Entry.segmentIndex()] + Entry.segmentOffset();
+      B.SymbolName = Entry.symbolName();
+      B.Addend = Entry.addend();
+      B.Ordinal = Entry.ordinal();
+      B.Kind = K;
+      Bindings.push_back(B);
+    }
+  };
+  // The arm64e images before chained fixups thread their pointers the same
+  // way, from their bind opcodes, which then start with the size of the
+  // ordinal table. The bind table can't be iterated then: it never gets
+  // past that opcode.
+  ArrayRef<uint8_t> Opcodes = MachO.getDyldInfoBindOpcodes();
+  const bool HasThreadedBinds =
+      !HasChainedFixups && !Opcodes.empty() &&
+      Opcodes[0] ==
+          (MachO::BIND_OPCODE_THREADED |
+           MachO::BIND_SUBOPCODE_THREADED_SET_BIND_ORDINAL_TABLE_SIZE_ULEB);
+  if (!HasThreadedBinds)
+    AddAll(MachO.bindTable(), MachOBindEntry::Kind::Regular);
+  AddAll(MachO.lazyBindTable(), MachOBindEntry::Kind::Lazy);
+  AddAll(MachO.weakBindTable(), MachOBindEntry::Kind::Weak);
+  if (HasChainedFixups)
+    addChainedFixups(MachO, SegmentAddrs, SegmentOffsets, ImageBase);
+  if (HasThreadedBinds)
+    addThreadedBinds(MachO, SegmentAddrs, SegmentOffsets, ImageBase);
+
+  // Keep the opcode order of bindings to the same address.
+  std::stable_sort(Bindings.begin(), Bindings.end(), compareBindings);
+}
+
+const MachOBindingIndex::Binding *
+MachOBindingIndex::find(uint64_t Addr, MachOBindEntry::Kind K) const {
+  Binding Key;
+  Key.Address = Addr;
+  Key.Kind = K;
+  auto I = std::lower_bound(Bindings.begin(), Bindings.end(), Key,
+                            compareBindings);
+  if (I == Bindings.end() || I->Address != Addr || I->Kind != K)
+    return nullptr;
+  return &*I;
+}
+
+namespace {
+/// \brief The symbols the chained binds refer to, by import index.
+struct ChainedImport {
+  StringRef Name;
+  int64_t Addend;
+  int Ordinal;
+};
+} // end anonymous namespace
+
+// Read the imports of the chained fixups in Data, or return false if they
+// are malformed.
+static bool readChainedImports(StringRef Data, uint32_t Format,
+                               uint32_t ImportsOffset, uint32_t Count,
+                               uint32_t SymbolsOffset,
+                               std::vector<ChainedImport> &Imports) {
+  using namespace support::endian;
+  const uint64_t Size = Format == MachO::DYLD_CHAINED_IMPORT
+                            ? 4
+                            : Format == MachO::DYLD_CHAINED_IMPORT_ADDEND ? 8
+                                                                          : 16;
+  if (ImportsOffset > Data.size() ||
+      uint64_t(Count) * Size > Data.size() - ImportsOffset ||
+      SymbolsOffset > Data.size())
+    return false;
+  const StringRef Symbols = Data.substr(SymbolsOffset);
+  const char *P = Data.data() + ImportsOffset;
+  Imports.resize(Count);
+  for (ChainedImport &Import : Imports) {
+    uint64_t NameOffset;
+    if (Format == MachO::DYLD_CHAINED_IMPORT_ADDEND64) {
+      uint64_t Raw = read64le(P);
+      Import.Ordinal = int16_t(Raw & 0xFFFF);
+      NameOffset = Raw >> 32;
+      Import.Addend = int64_t(read64le(P + 8));
+    } else {
+      uint32_t Raw = read32le(P);
+      Import.Ordinal = int8_t(Raw & 0xFF);
+      NameOffset = Raw >> 9;
+      Import.Addend =
+          Format == MachO::DYLD_CHAINED_IMPORT_ADDEND ? int32_t(read32le(P + 4))
+                                                      : 0;
+    }
+    P += Size;
+    if (NameOffset >= Symbols.size())
+      return false;
+    Import.Name = Symbols.substr(NameOffset);
+    Import.Name = Import.Name.substr(0, Import.Name.find('\0'));
+  }
+  return true;
+}
+
+// Only the 64-bit formats of user space images are supported.
+static bool isSupportedChainFormat(uint16_t Format) {
+  switch (Format) {
+  case MachO::DYLD_CHAINED_PTR_ARM64E:
+  case MachO::DYLD_CHAINED_PTR_ARM64E_USERLAND:
+  case MachO::DYLD_CHAINED_PTR_ARM64E_USERLAND24:
+  case MachO::DYLD_CHAINED_PTR_64:
+  case MachO::DYLD_CHAINED_PTR_64_OFFSET:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Walk the chain of pointers of Format starting at Offset in the segment at
+// SegAddr, SegFileOff in File, adding its binds to Bindings and the values of
+// its pointers to Values. Return false if the chain leaves the file.
+static bool addChain(StringRef File, uint16_t Format, uint64_t SegAddr,
+                     uint64_t SegFileOff, uint64_t Offset,
+                     ArrayRef<ChainedImport> Imports, uint64_t ImageBase,
+                     std::vector<MachOBindingIndex::Binding> &Bindings,
+                     std::vector<std::pair<uint64_t, uint64_t>> &Values) {
+  using namespace support::endian;
+  const bool IsARM64E = Format == MachO::DYLD_CHAINED_PTR_ARM64E ||
+                        Format == MachO::DYLD_CHAINED_PTR_ARM64E_USERLAND ||
+                        Format == MachO::DYLD_CHAINED_PTR_ARM64E_USERLAND24;
+  const bool IsOffset = Format != MachO::DYLD_CHAINED_PTR_ARM64E &&
+                        Format != MachO::DYLD_CHAINED_PTR_64;
+  const unsigned Stride = IsARM64E ? 8 : 4;
+  for (;;) {
+    const uint64_t FileOff = SegFileOff + Offset;
+    if (FileOff > File.size() || File.size() - FileOff < 8)
+      return false;
+    const uint64_t Raw = read64le(File.data() + FileOff);
+    const uint64_t Addr = SegAddr + Offset;
+    bool IsBind, IsAuth = false;
+    uint64_t Next;
+    if (IsARM64E) {
+      IsBind = (Raw >> 62) & 1;
+      IsAuth = Raw >> 63;
+      Next = (Raw >> 51) & 0x7FF;
+    } else {
+      IsBind = Raw >> 63;
+      Next = (Raw >> 51) & 0xFFF;
+    }
+
+    if (IsBind) {
+      uint32_t Ordinal;
+      int64_t Addend;
+      if (IsARM64E) {
+        Ordinal = Format == MachO::DYLD_CHAINED_PTR_ARM64E_USERLAND24
+                      ? Raw & 0xFFFFFF
+                      : Raw & 0xFFFF;
+        Addend = IsAuth ? 0 : SignExtend64<19>((Raw >> 32) & 0x7FFFF);
+      } else {
+        Ordinal = Raw & 0xFFFFFF;
+        Addend = (Raw >> 24) & 0xFF;
+      }
+      if (Ordinal < Imports.size()) {
+        MachOBindingIndex::Binding B;
+        B.Address = Addr;
+        B.SymbolName = Imports[Ordinal].Name;
+        B.Addend = Imports[Ordinal].Addend + Addend;
+        B.Ordinal = Imports[Ordinal].Ordinal;
+        B.Kind = MachOBindEntry::Kind::Regular;
+        Bindings.push_back(B);
+      }
+      Values.push_back(std::make_pair(Addr, uint64_t(0)));
+    } else {
+      uint64_t Target;
+      if (IsAuth) {
+        // The authenticated pointers are always offsets.
+        Target = ImageBase + (Raw & 0xFFFFFFFF);
+      } else {
+        Target = IsARM64E ? Raw & 0x7FFFFFFFFFFULL : Raw & 0xFFFFFFFFFULL;
+        uint64_t High8 = (Raw >> (IsARM64E ? 43 : 36)) & 0xFF;
+        if (IsOffset)
+          Target += ImageBase;
+        Target |= High8 << 56;
+      }
+      Values.push_back(std::make_pair(Addr, Target));
+    }
+    if (!Next)
+      return true;
+    Offset += Next * Stride;
+  }
+}
+
+void MachOBindingIndex::addChainedFixups(const MachOObjectFile &MachO,
+                                         ArrayRef<uint64_t> SegmentAddrs,
+                                         ArrayRef<uint64_t> SegmentOffsets,
+                                         uint64_t ImageBase) {
+  using namespace support::endian;
+  MachO::linkedit_data_command LC = {0, 0, 0, 0};
+  for (const auto &Load : MachO.load_commands())
+    if (Load.C.cmd == MachO::LC_DYLD_CHAINED_FIXUPS)
+      LC = MachO.getLinkeditDataLoadCommand(Load);
+  const StringRef File = MachO.getData();
+  if (LC.dataoff > File.size() || LC.datasize > File.size() - LC.dataoff)
+    return;
+  const StringRef Data = File.substr(LC.dataoff, LC.datasize);
+
+  // The header: version, starts, imports, symbols, import count and format,
+  // symbols format. Compressed symbols aren't supported.
+  if (Data.size() < 28 || read32le(Data.data()) != 0 ||
+      read32le(Data.data() + 24) != 0)
+    return;
+  const uint32_t StartsOffset = read32le(Data.data() + 4);
+  const uint32_t ImportsFormat = read32le(Data.data() + 20);
+  if (ImportsFormat < MachO::DYLD_CHAINED_IMPORT ||
+      ImportsFormat > MachO::DYLD_CHAINED_IMPORT_ADDEND64)
+    return;
+  std::vector<ChainedImport> Imports;
+  if (!readChainedImports(Data, ImportsFormat, read32le(Data.data() + 8),
+                          read32le(Data.data() + 16),
+                          read32le(Data.data() + 12), Imports))
+    return;
+
+  // The starts of the chains: for each segment, the offset of its starts,
+  // which are the page size, the pointer format, and the offset of the first
+  // pointer of each page.
+  if (StartsOffset > Data.size() || Data.size() - StartsOffset < 4)
+    return;
+  const StringRef Starts = Data.substr(StartsOffset);
+  const uint32_t SegCount = read32le(Starts.data());
+  if (SegCount > SegmentAddrs.size() || (Starts.size() - 4) / 4 < SegCount)
+    return;
+  for (uint32_t Seg = 0; Seg != SegCount; ++Seg) {
+    const uint32_t SegInfoOffset = read32le(Starts.data() + 4 + Seg * 4);
+    if (!SegInfoOffset)
+      continue;
+    if (SegInfoOffset > Starts.size() || Starts.size() - SegInfoOffset < 22)
+      return;
+    const char *SegInfo = Starts.data() + SegInfoOffset;
+    const uint16_t PageSize = read16le(SegInfo + 4);
+    const uint16_t Format = read16le(SegInfo + 6);
+    const uint16_t PageCount = read16le(SegInfo + 20);
+    if (Starts.size() - SegInfoOffset < 22 + PageCount * 2u)
+      return;
+
+    if (!isSupportedChainFormat(Format))
+      continue;
+
+    for (uint16_t Page = 0; Page != PageCount; ++Page) {
+      const uint16_t PageStart = read16le(SegInfo + 22 + Page * 2);
+      if (PageStart == MachO::DYLD_CHAINED_PTR_START_NONE)
+        continue;
+      if (!addChain(File, Format, SegmentAddrs[Seg], SegmentOffsets[Seg],
+                    uint64_t(Page) * PageSize + PageStart, Imports, ImageBase,
+                    Bindings, ChainedValues))
+        return;
+    }
+  }
+  std::sort(ChainedValues.begin(), ChainedValues.end());
+}
+
+void MachOBindingIndex::addThreadedBinds(const MachOObjectFile &MachO,
+                                         ArrayRef<uint64_t> SegmentAddrs,
+                                         ArrayRef<uint64_t> SegmentOffsets,
+                                         uint64_t ImageBase) {
+  // The binds of the threaded opcodes only fill the ordinal table; the
+  // pointers are chained as DYLD_CHAINED_PTR_ARM64E ones, from each address
+  // the opcodes apply the table at.
+  ArrayRef<uint8_t> Opcodes = MachO.getDyldInfoBindOpcodes();
+  const uint8_t *P = Opcodes.begin(), *End = Opcodes.end();
+  const StringRef File = MachO.getData();
+  std::vector<ChainedImport> Imports;
+  ChainedImport Import = {StringRef(), 0, 0};
+  uint64_t Seg = 0, Offset = 0;
+  auto ReadULEB = [&]() {
+    unsigned Count;
+    uint64_t Value = decodeULEB128(P, End, &Count);
+    P = Count ? P + Count : End;
+    return Value;
+  };
+  while (P != End) {
+    const uint8_t Opcode = *P & MachO::BIND_OPCODE_MASK;
+    const uint8_t Imm = *P & MachO::BIND_IMMEDIATE_MASK;
+    ++P;
+    switch (Opcode) {
+    case MachO::BIND_OPCODE_DONE:
+      P = End;
+      break;
+    case MachO::BIND_OPCODE_SET_DYLIB_ORDINAL_IMM:
+      Import.Ordinal = Imm;
+      break;
+    case MachO::BIND_OPCODE_SET_DYLIB_ORDINAL_ULEB:
+      Import.Ordinal = ReadULEB();
+      break;
+    case MachO::BIND_OPCODE_SET_DYLIB_SPECIAL_IMM:
+      Import.Ordinal = Imm ? int8_t(MachO::BIND_OPCODE_MASK | Imm) : 0;
+      break;
+    case MachO::BIND_OPCODE_SET_SYMBOL_TRAILING_FLAGS_IMM: {
+      StringRef Rest(reinterpret_cast<const char *>(P), End - P);
+      Import.Name = Rest.substr(0, Rest.find('\0'));
+      P = std::min(End, P + Import.Name.size() + 1);
+      break;
+    }
+    case MachO::BIND_OPCODE_SET_TYPE_IMM:
+      break;
+    case MachO::BIND_OPCODE_SET_ADDEND_SLEB: {
+      unsigned Count;
+      Import.Addend = decodeSLEB128(P, &Count);
+      P = std::min(End, P + Count);
+      break;
+    }
+    case MachO::BIND_OPCODE_SET_SEGMENT_AND_OFFSET_ULEB:
+      Seg = Imm;
+      Offset = ReadULEB();
+      break;
+    case MachO::BIND_OPCODE_ADD_ADDR_ULEB:
+      Offset += ReadULEB();
+      break;
+    case MachO::BIND_OPCODE_DO_BIND:
+      Imports.push_back(Import);
+      break;
+    case MachO::BIND_OPCODE_THREADED:
+      if (Imm == MachO::BIND_SUBOPCODE_THREADED_SET_BIND_ORDINAL_TABLE_SIZE_ULEB)
+        Imports.reserve(ReadULEB());
+      else if (Imm == MachO::BIND_SUBOPCODE_THREADED_APPLY &&
+               Seg < SegmentAddrs.size() &&
+               !addChain(File, MachO::DYLD_CHAINED_PTR_ARM64E,
+                         SegmentAddrs[Seg], SegmentOffsets[Seg], Offset,
+                         Imports, ImageBase, Bindings, ChainedValues))
+        P = End;
+      break;
+    default:
+      // The other binds have no meaning with threaded ones.
+      P = End;
+    }
+  }
+  std::sort(ChainedValues.begin(), ChainedValues.end());
+}
+
+bool MachOBindingIndex::getChainedValue(uint64_t Addr, uint64_t &Value) const {
+  auto I = std::lower_bound(ChainedValues.begin(), ChainedValues.end(),
+                            std::make_pair(Addr, uint64_t(0)));
+  if (I == ChainedValues.end() || I->first != Addr)
+    return false;
+  Value = I->second;
+  return true;
+}
+
+void MachOBindingIndex::applyChainedFixups(
+    uint64_t Addr, MutableArrayRef<uint8_t> Bytes) const {
+  auto I = std::lower_bound(ChainedValues.begin(), ChainedValues.end(),
+                            std::make_pair(Addr, uint64_t(0)));
+  for (auto E = ChainedValues.end();
+       I != E && I->first - Addr + 8 <= Bytes.size(); ++I)
+    support::endian::write64le(Bytes.data() + (I->first - Addr), I->second);
+}
@@ -178,7 +178,8 @@ static ErrorOr<MachOObjectFile::LoadCommandInfo>
 getFirstLoadCommandInfo(const MachOObjectFile *Obj) {
   unsigned HeaderSize = Obj->is64Bit() ? sizeof(MachO::mach_header_64)
                                        : sizeof(MachO::mach_header);
-  return getLoadCommandInfo(Obj, getPtr(Obj, HeaderSize));
+  return getLoadCommandInfo(Obj,
+                            getPtr(Obj, Obj->getHeaderOffset() + HeaderSize));
 }
 
 static ErrorOr<MachOObjectFile::LoadCommandInfo>
@@ -190,7 +191,8 @@ getNextLoadCommandInfo(const MachOObjectFile *Obj,
 template <typename T>
 static void parseHeader(const MachOObjectFile *Obj, T &Header,
                         std::error_code &EC) {
-  auto HeaderOrErr = getStructOrErr<T>(Obj, getPtr(Obj, 0));
+  auto HeaderOrErr =
+      getStructOrErr<T>(Obj, getPtr(Obj, Obj->getHeaderOffset()));
   if (HeaderOrErr)
     Header = HeaderOrErr.get();
   else
@@ -225,9 +227,10 @@ static std::error_code parseSegmentLoadCommand(
 }
 
 MachOObjectFile::MachOObjectFile(MemoryBufferRef Object, bool IsLittleEndian,
-                                 bool Is64bits, std::error_code &EC)
+                                 bool Is64bits, std::error_code &EC,
+                                 uint64_t HeaderOffset)
     : ObjectFile(getMachOType(IsLittleEndian, Is64bits), Object),
-      SymtabLoadCmd(nullptr), DysymtabLoadCmd(nullptr),
+      HeaderOffset(HeaderOffset), SymtabLoadCmd(nullptr), DysymtabLoadCmd(nullptr),
       DataInCodeLoadCmd(nullptr), LinkOptHintsLoadCmd(nullptr),
       DyldInfoLoadCmd(nullptr), UuidLoadCmd(nullptr),
       HasPageZeroSegment(false) {
@@ -1241,12 +1244,13 @@ bool ExportEntry::operator==(const ExportEntry &Other) const {
 
 uint64_t ExportEntry::readULEB128(const uint8_t *&Ptr) {
   unsigned Count;
-  uint64_t Result = decodeULEB128(Ptr, &Count);
-  Ptr += Count;
-  if (Ptr > Trie.end()) {
+  uint64_t Result = decodeULEB128(Ptr, Trie.end(), &Count);
+  if (!Count) {
     Ptr = Trie.end();
     Malformed = true;
+    return Result;
   }
+  Ptr += Count;
   return Result;
 }
 
@@ -1511,12 +1515,13 @@ void MachORebaseEntry::moveNext() {
 
 uint64_t MachORebaseEntry::readULEB128() {
   unsigned Count;
-  uint64_t Result = decodeULEB128(Ptr, &Count);
-  Ptr += Count;
-  if (Ptr > Opcodes.end()) {
+  uint64_t Result = decodeULEB128(Ptr, Opcodes.end(), &Count);
+  if (!Count) {
     Ptr = Opcodes.end();
     Malformed = true;
+    return Result;
   }
+  Ptr += Count;
   return Result;
 }
 
@@ -1745,12 +1750,13 @@ void MachOBindEntry::moveNext() {
 
 uint64_t MachOBindEntry::readULEB128() {
   unsigned Count;
-  uint64_t Result = decodeULEB128(Ptr, &Count);
-  Ptr += Count;
-  if (Ptr > Opcodes.end()) {
+  uint64_t Result = decodeULEB128(Ptr, Opcodes.end(), &Count);
+  if (!Count) {
     Ptr = Opcodes.end();
     Malformed = true;
+    return Result;
   }
+  Ptr += Count;
   return Result;
 }
 
@@ -2292,18 +2298,21 @@ bool MachOObjectFile::isRelocatableObject() const {
 }
 
 ErrorOr<std::unique_ptr<MachOObjectFile>>
-ObjectFile::createMachOObjectFile(MemoryBufferRef Buffer) {
-  StringRef Magic = Buffer.getBuffer().slice(0, 4);
+ObjectFile::createMachOObjectFile(MemoryBufferRef Buffer,
+                                  uint64_t HeaderOffset) {
+  if (HeaderOffset > Buffer.getBufferSize())
+    return object_error::parse_failed;
+  StringRef Magic = Buffer.getBuffer().substr(HeaderOffset, 4);
   std::error_code EC;
   std::unique_ptr<MachOObjectFile> Ret;
   if (Magic == "\xFE\xED\xFA\xCE")
-    Ret.reset(new MachOObjectFile(Buffer, false, false, EC));
+    Ret.reset(new MachOObjectFile(Buffer, false, false, EC, HeaderOffset));
   else if (Magic == "\xCE\xFA\xED\xFE")
-    Ret.reset(new MachOObjectFile(Buffer, true, false, EC));
+    Ret.reset(new MachOObjectFile(Buffer, true, false, EC, HeaderOffset));
   else if (Magic == "\xFE\xED\xFA\xCF")
-    Ret.reset(new MachOObjectFile(Buffer, false, true, EC));
+    Ret.reset(new MachOObjectFile(Buffer, false, true, EC, HeaderOffset));
   else if (Magic == "\xCF\xFA\xED\xFE")
-    Ret.reset(new MachOObjectFile(Buffer, true, true, EC));
+    Ret.reset(new MachOObjectFile(Buffer, true, true, EC, HeaderOffset));
   else
     return object_error::parse_failed;
 
@@ -0,0 +1,54 @@
+//===- MachOStringSection.cpp - Mach-O C string section index -------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Object/MachOStringSection.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+using namespace llvm;
+using namespace object;
+
+MachOStringSection::MachOStringSection(uint64_t Address, StringRef Contents)
+    : Address(Address), Contents(Contents) {
+  assert(Contents.size() <= UINT32_MAX && "String section too large");
+  // memchr compares a vector of bytes at a time: the strings are much longer
+  // than that, so this is faster than looking at each byte here.
+  const char *Begin = Contents.data();
+  const char *End = Begin + Contents.size();
+  for (const char *S = Begin; S != End;) {
+    const char *Nul =
+        static_cast<const char *>(std::memchr(S, '\0', End - S));
+    if (!Nul)
+      Nul = End;
+    if (Nul != S) {
+      Range R;
+      R.Begin = S - Begin;
+      R.End = Nul - Begin;
+      Strings.push_back(R);
+    }
+    S = Nul == End ? End : Nul + 1;
+  }
+}
+
+StringRef MachOStringSection::getString(uint64_t Addr) const {
+  if (!contains(Addr))
+    return StringRef();
+  const uint32_t Offset = Addr - Address;
+  // Find the last string that starts at or before Offset.
+  auto I = std::upper_bound(
+      Strings.begin(), Strings.end(), Offset,
+      [](uint32_t Offset, const Range &R) { return Offset < R.Begin; });
+  if (I == Strings.begin())
+    return StringRef();
+  --I;
+  if (Offset >= I->End)
+    return StringRef();
+  return Contents.slice(Offset, I->End);
+}
@@ -0,0 +1,257 @@
+//===- MachOUnwindInfo.cpp - Mach-O compact unwind info index -------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Object/MachOUnwindInfo.h"
+#include "llvm/Object/MachO.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/MathExtras.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace llvm;
+using namespace object;
+
+namespace {
+// The layout of the section, as in <mach-o/compact_unwind_encoding.h>: a
+// header, the common encodings, the personalities, then the first level
+// index, whose entries point to the second level pages. The last entry of
+// the index is a sentinel, at the end of the last function.
+enum {
+  IndexEntrySize = 3 * 4,
+  RegularPageKind = 2,
+  CompressedPageKind = 3
+};
+
+// The frame modes, and where the saved registers are in the encodings.
+enum : uint32_t {
+  ModeMask = 0x0F000000,
+
+  ARM64Frameless = 0x02000000,
+  ARM64Dwarf = 0x03000000,
+  ARM64Frame = 0x04000000,
+  ARM64GPRPairsMask = 0x0000001F,
+  ARM64FPRPairsMask = 0x00000F00,
+
+  X86FramePointer = 0x01000000,
+  X86StackImmediate = 0x02000000,
+  X86StackIndirect = 0x03000000,
+  X86Dwarf = 0x04000000,
+  X86FrameRegsMask = 0x00007FFF,
+  X86StackRegCountMask = 0x00001C00,
+  X86StackRegCountShift = 10
+};
+
+// Reads the little-endian words of a section, out of bounds reads failing.
+class Reader {
+  StringRef Contents;
+
+public:
+  explicit Reader(StringRef Contents) : Contents(Contents) {}
+
+  bool read32(uint64_t Offset, uint32_t &Value) const {
+    if (Offset + 4 > Contents.size())
+      return false;
+    Value = support::endian::read32le(Contents.data() + Offset);
+    return true;
+  }
+  bool read16(uint64_t Offset, uint16_t &Value) const {
+    if (Offset + 2 > Contents.size())
+      return false;
+    Value = support::endian::read16le(Contents.data() + Offset);
+    return true;
+  }
+};
+} // end anonymous namespace
+
+MachOUnwindInfo::MachOUnwindInfo(StringRef Contents, uint64_t TextAddr,
+                                 Triple::ArchType Arch)
+    : Arch(Arch) {
+  const Reader R(Contents);
+  uint32_t Header[7];
+  for (unsigned I = 0; I != 7; ++I)
+    if (!R.read32(I * 4, Header[I]))
+      return;
+  const uint32_t Version = Header[0];
+  const uint32_t CommonEncodingsStart = Header[1];
+  const uint32_t NumCommonEncodings = Header[2];
+  const uint32_t IndicesStart = Header[5];
+  const uint32_t NumIndices = Header[6];
+  if (Version != 1 || NumIndices < 2)
+    return;
+
+  // The function offsets, and their encodings, of all the pages.
+  std::vector<std::pair<uint32_t, uint32_t>> Functions;
+  uint32_t EndOffset = 0;
+  for (uint32_t I = 0; I != NumIndices; ++I) {
+    const uint64_t IndexEntry = IndicesStart + uint64_t(I) * IndexEntrySize;
+    uint32_t BaseOffset, PageStart;
+    if (!R.read32(IndexEntry, BaseOffset) ||
+        !R.read32(IndexEntry + 4, PageStart))
+      return;
+    if (I == NumIndices - 1) {
+      EndOffset = BaseOffset;
+      break;
+    }
+
+    uint32_t Kind;
+    uint16_t EntriesStart, NumEntries;
+    if (!R.read32(PageStart, Kind) || !R.read16(PageStart + 4, EntriesStart) ||
+        !R.read16(PageStart + 6, NumEntries))
+      return;
+    if (Kind == RegularPageKind) {
+      // The entries are pairs of a function offset and its encoding.
+      for (uint32_t J = 0; J != NumEntries; ++J) {
+        const uint64_t Entry = uint64_t(PageStart) + EntriesStart + J * 8;
+        uint32_t FunctionOffset, Encoding;
+        if (!R.read32(Entry, FunctionOffset) || !R.read32(Entry + 4, Encoding))
+          return;
+        Functions.push_back(std::make_pair(FunctionOffset, Encoding));
+      }
+    } else if (Kind == CompressedPageKind) {
+      // The entries are the offset from the first function of the page, in
+      // the low 24 bits, and the index of the encoding in the top 8: in the
+      // common encodings, then in those of the page.
+      uint16_t EncodingsStart, NumEncodings;
+      if (!R.read16(PageStart + 8, EncodingsStart) ||
+          !R.read16(PageStart + 10, NumEncodings))
+        return;
+      for (uint32_t J = 0; J != NumEntries; ++J) {
+        uint32_t Entry;
+        if (!R.read32(uint64_t(PageStart) + EntriesStart + J * 4, Entry))
+          return;
+        const uint32_t EncodingIdx = Entry >> 24;
+        uint32_t Encoding;
+        if (EncodingIdx < NumCommonEncodings) {
+          if (!R.read32(CommonEncodingsStart + uint64_t(EncodingIdx) * 4,
+                        Encoding))
+            return;
+        } else if (EncodingIdx - NumCommonEncodings < NumEncodings) {
+          if (!R.read32(uint64_t(PageStart) + EncodingsStart +
+                            (EncodingIdx - NumCommonEncodings) * 4,
+                        Encoding))
+            return;
+        } else {
+          return;
+        }
+        Functions.push_back(
+            std::make_pair(BaseOffset + (Entry & 0xFFFFFF), Encoding));
+      }
+    } else {
+      return;
+    }
+  }
+
+  // The pages are sorted, and so are their entries: each range ends at the
+  // start of the next one.
+  if (!std::is_sorted(Functions.begin(), Functions.end()))
+    std::sort(Functions.begin(), Functions.end());
+  Entries.reserve(Functions.size());
+  for (size_t I = 0, E = Functions.size(); I != E; ++I) {
+    const uint32_t End = I + 1 == E ? EndOffset : Functions[I + 1].first;
+    if (End <= Functions[I].first)
+      continue;
+    Entry NewEntry;
+    NewEntry.BeginAddr = TextAddr + Functions[I].first;
+    NewEntry.EndAddr = TextAddr + End;
+    NewEntry.Encoding = Functions[I].second;
+    Entries.push_back(NewEntry);
+  }
+}
+
+MachOUnwindInfo MachOUnwindInfo::create(const MachOObjectFile &Obj) {
+  uint64_t TextAddr = 0;
+  for (const auto &Load : Obj.load_commands()) {
+    StringRef SegName;
+    uint64_t VMAddr;
+    if (Load.C.cmd == MachO::LC_SEGMENT_64) {
+      MachO::segment_command_64 Seg = Obj.getSegment64LoadCommand(Load);
+      SegName = StringRef(Seg.segname, strnlen(Seg.segname, 16));
+      VMAddr = Seg.vmaddr;
+    } else if (Load.C.cmd == MachO::LC_SEGMENT) {
+      MachO::segment_command Seg = Obj.getSegmentLoadCommand(Load);
+      SegName = StringRef(Seg.segname, strnlen(Seg.segname, 16));
+      VMAddr = Seg.vmaddr;
+    } else {
+      continue;
+    }
+    if (SegName == "__TEXT") {
+      TextAddr = VMAddr;
+      break;
+    }
+  }
+
+  for (const SectionRef &Section : Obj.sections()) {
+    StringRef Name;
+    if (Section.getName(Name) || Name != "__unwind_info")
+      continue;
+    if (Obj.getSectionFinalSegmentName(Section.getRawDataRefImpl()) !=
+        "__TEXT")
+      continue;
+    StringRef Contents;
+    if (Section.getContents(Contents))
+      break;
+    return MachOUnwindInfo(Contents, TextAddr,
+                           static_cast<Triple::ArchType>(Obj.getArch()));
+  }
+  return MachOUnwindInfo();
+}
+
+const MachOUnwindInfo::Entry *MachOUnwindInfo::find(uint64_t Addr) const {
+  auto I = std::upper_bound(
+      Entries.begin(), Entries.end(), Addr,
+      [](uint64_t Addr, const Entry &E) { return Addr < E.BeginAddr; });
+  if (I == Entries.begin())
+    return nullptr;
+  --I;
+  return Addr < I->EndAddr ? &*I : nullptr;
+}
+
+MachOUnwindInfo::FrameKind
+MachOUnwindInfo::getFrameKind(Triple::ArchType Arch, uint32_t Encoding) {
+  const uint32_t Mode = Encoding & ModeMask;
+  switch (Arch) {
+  case Triple::aarch64:
+    switch (Mode) {
+    case ARM64Frameless: return FramelessFrame;
+    case ARM64Frame:     return PointerFrame;
+    case ARM64Dwarf:     return DwarfFrame;
+    default:             return UnknownFrame;
+    }
+  case Triple::x86:
+  case Triple::x86_64:
+    switch (Mode) {
+    case X86FramePointer:   return PointerFrame;
+    case X86StackImmediate:
+    case X86StackIndirect:  return FramelessFrame;
+    case X86Dwarf:          return DwarfFrame;
+    default:                return UnknownFrame;
+    }
+  default:
+    return UnknownFrame;
+  }
+}
+
+int MachOUnwindInfo::getNumSavedRegs(Triple::ArchType Arch,
+                                     uint32_t Encoding) {
+  const FrameKind Kind = getFrameKind(Arch, Encoding);
+  if (Kind != FramelessFrame && Kind != PointerFrame)
+    return -1;
+  if (Arch == Triple::aarch64)
+    // One bit by pair of registers, the same in both frame kinds.
+    return 2 * (countPopulation(Encoding & ARM64GPRPairsMask) +
+                countPopulation(Encoding & ARM64FPRPairsMask));
+  if (Kind == FramelessFrame)
+    return (Encoding & X86StackRegCountMask) >> X86StackRegCountShift;
+  // Five 3-bit register numbers, 0 for none.
+  int NumRegs = 0;
+  for (uint32_t Regs = Encoding & X86FrameRegsMask; Regs; Regs >>= 3)
+    if (Regs & 7)
+      ++NumRegs;
+  return NumRegs;
+}
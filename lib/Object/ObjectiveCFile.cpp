@@ -1,63 +1,79 @@
 #include <llvm/ADT/StringExtras.h>
+#include "llvm/ADT/Twine.h"
 #include "llvm/Object/ObjectiveCFile.h"
+#include <cstring>
 #include "llvm/Support/raw_os_ostream.h"
-#include "llvm/Support/LEB128.h"
 #include "llvm/Support/Debug.h"
+#include <algorithm>
 
 #define DEBUG_TYPE "object-c"
 using namespace llvm;
 using namespace object;
 
 
+// With chained fixups, the pointers of the sections are chained and encode
+// their fixup: they are read from a copy with the values they have in the
+// other images, the targets of the rebases, and 0 for the binds.
+ArrayRef<uint8_t> ObjectiveCFile::getSectionData(const SectionRef &Section) {
+    StringRef Contents;
+    Section.getContents(Contents);
+    if (!Binds->hasChainedFixups())
+        return ArrayRef<uint8_t>((const uint8_t*)Contents.data(), Contents.size());
+    uint8_t *Copy = SectionAlloc.Allocate<uint8_t>(Contents.size());
+    std::copy(Contents.begin(), Contents.end(), Copy);
+    MutableArrayRef<uint8_t> Bytes(Copy, Contents.size());
+    Binds->applyChainedFixups(Section.getAddress(), Bytes);
+    return Bytes;
+}
+
 void ObjectiveCFile::resolveMethods() {
+    Resolved = true;
     for(section_iterator S_it = MachO->section_begin(); S_it != MachO->section_end(); ++S_it){
         StringRef SectionName;
         S_it->getName(SectionName);
         if (SectionName == "__objc_classlist") {
             ObjcClasslistAddress = S_it->getAddress();
-            StringRef ObjcClasslistContent;
-            S_it->getContents(ObjcClasslistContent);
-            ObjcClasslistData = ArrayRef<uint8_t>((uint8_t*)ObjcClasslistContent.data(), ObjcClasslistContent.size());
+            ObjcClasslistData = getSectionData(*S_it);
         } else if (SectionName == "__objc_data") {
             ObjcDataAddress = S_it->getAddress();
-            StringRef ObjcDataContent;
-            S_it->getContents(ObjcDataContent);
-            ObjcDataData = ArrayRef<uint8_t>((uint8_t*)ObjcDataContent.data(), ObjcDataContent.size());
+            ObjcDataData = getSectionData(*S_it);
         } else if (SectionName == "__data") {
             DataAddress = S_it->getAddress();
-            StringRef DataContent;
-            S_it->getContents(DataContent);
-            DataData = ArrayRef<uint8_t>((uint8_t*)DataContent.data(), DataContent.size());
+            DataData = getSectionData(*S_it);
         } else if (SectionName == "__objc_const") {
             ObjcConstAddress = S_it->getAddress();
-            StringRef ObjcConstContent;
-            S_it->getContents(ObjcConstContent);
-            ObjcConstData = ArrayRef<uint8_t>((uint8_t*)ObjcConstContent.data(), ObjcConstContent.size());
+            ObjcConstData = getSectionData(*S_it);
         } else if (SectionName == "__objc_classname") {
-            ObjcClassnamesAddress = S_it->getAddress();
             StringRef ObjcClassnamesContent;
             S_it->getContents(ObjcClassnamesContent);
-            ObjcClassnamesData = ArrayRef<uint8_t>((uint8_t*)ObjcClassnamesContent.data(), ObjcClassnamesContent.size());
+            ObjcClassnames = MachOStringSection(S_it->getAddress(), ObjcClassnamesContent);
         } else if (SectionName == "__cstring") {
-            cStringsAddress = S_it->getAddress();
             StringRef cStringsContent;
             S_it->getContents(cStringsContent);
             DEBUG(errs() << "[+]cStringsContent.data address: " << cStringsContent.data() 
                 << "\tcStringsContent.size: " << cStringsContent.size() << "\n");
-            cStringsData = ArrayRef<uint8_t>((uint8_t*)cStringsContent.data(), cStringsContent.size());
+            cStrings = MachOStringSection(S_it->getAddress(), cStringsContent);
         } else if (SectionName == "__objc_methname") {
-            ObjcMethodnamesAddress = S_it->getAddress();
             StringRef ObjcMethodnamesContent;
             S_it->getContents(ObjcMethodnamesContent);
-            ObjcMethodnamesData = ArrayRef<uint8_t>((uint8_t*)ObjcMethodnamesContent.data(), ObjcMethodnamesContent.size());
+            ObjcMethodnames = MachOStringSection(S_it->getAddress(), ObjcMethodnamesContent);
+        } else if (SectionName == "__cfstring") {
+            CFStringsAddress = S_it->getAddress();
+            CFStringsData = getSectionData(*S_it);
         } else if (SectionName == "__objc_catlist") {
             ObjcCatlistAddress = S_it->getAddress();
-            StringRef ObjcCatlistContent;
-            S_it->getContents(ObjcCatlistContent);
-            ObjcCatlistData = ArrayRef<uint8_t>((uint8_t*)ObjcCatlistContent.data(), ObjcCatlistContent.size());
+            ObjcCatlistData = getSectionData(*S_it);
+        } else if (SectionName == "__objc_selrefs") {
+            ObjcSelrefsAddress = S_it->getAddress();
+            ObjcSelrefsData = getSectionData(*S_it);
+        } else if (SectionName == "__objc_classrefs") {
+            ObjcClassrefsAddress = S_it->getAddress();
+            ObjcClassrefsData = getSectionData(*S_it);
         }
     }
 
+    resolveStringXRefs();
+
     if (!(ObjcClasslistAddress && ObjcClasslistData.size())) {
         return;
     }
@@ -65,14 +81,14 @@ void ObjectiveCFile::resolveMethods() {
     assert(ObjcClasslistAddress && ObjcClasslistData.size());
     assert(ObjcDataAddress && ObjcDataData.size());
     assert(ObjcConstAddress && ObjcConstData.size());
-    assert(ObjcClassnamesAddress && ObjcClassnamesData.size());
-    assert(ObjcMethodnamesAddress && ObjcMethodnamesData.size());
+    assert(ObjcClassnames.getAddress() && ObjcClassnames.getContents().size());
+    assert(ObjcMethodnames.getAddress() && ObjcMethodnames.getContents().size());
     //assert(ObjcCatlistAddress && ObjcCatlistData.size());
 
     for (unsigned ClasslistIdx = 0; ClasslistIdx < ObjcClasslistData.size(); ClasslistIdx += sizeof(uint64_t)) {
         uint64_t ClassRef = *((uint64_t*)ObjcClasslistData.slice(ClasslistIdx).data());
         ObjcDataStruct_t *ClassData;
-        if (ClassRef >= DataAddress) {
+        if (DataAddress <= ClassRef && ClassRef < DataAddress + DataData.size()) {
             ClassData = (ObjcDataStruct_t*)DataData.slice(ClassRef - DataAddress).data();
         } else {
             assert(ObjcDataAddress <= ClassRef && ClassRef <= ObjcDataAddress + ObjcDataData.size());
@@ -91,6 +107,7 @@ void ObjectiveCFile::resolveMethods() {
         bool isSwiftClass = (bool)(ClassData->Data & 1);
         ObjcClassInfoStruct_t *ClassInfo = (ObjcClassInfoStruct_t*)ObjcConstData.slice((ClassData->Data  -  ObjcConstAddress), isSwiftClass, true).data();
         //errs() << "[+] ClassInfo size: 0x" << utohexstr(sizeof(*ClassInfo)) << "\n";           
+        ClassNames[ClassRef] = getClassName(ClassInfo, isSwiftClass);
         resolveMethods(ClassInfo, false, isSwiftClass);
 
         if (ClassData->ISA) {
@@ -102,7 +119,6 @@ void ObjectiveCFile::resolveMethods() {
                 ObjcClassInfoStruct_t *ISAClassInfo = (ObjcClassInfoStruct_t*)ObjcConstData.slice(ISAData->Data - ObjcConstAddress).data();
                 DEBUG(errs() << "[+]ISAClassInfo->BaseMethods address: "<< utohexstr(ISAClassInfo->BaseMethods) << "\n");
                 DEBUG(errs() << "[+]ISAClassInfo->Name: 0x" << utohexstr(ISAClassInfo->Name) << "\n");
-                //(errs() << getClassName(ObjcClassnamesData, ObjcClassnamesAddress, ISAClassInfo->Name) << "\n");
                 resolveMethods(ISAClassInfo, true, true);
             } else{
                 ObjcDataStruct_t *ISAData = (ObjcDataStruct_t *) ObjcDataData.slice(ClassData->ISA - ObjcDataAddress).data();
@@ -111,8 +127,6 @@ void ObjectiveCFile::resolveMethods() {
                 ObjcClassInfoStruct_t *ISAClassInfo = (ObjcClassInfoStruct_t*)ObjcConstData.slice(ISAData->Data - ObjcConstAddress).data();
                 //errs() << utohexstr(ISAClassInfo->BaseMethods) << "\n";
                 DEBUG(errs() << "[+]ISAClassInfo->Name: 0x" << utohexstr(ISAClassInfo->Name) << "\n");
-
-                //errs() << getClassName(ObjcClassnamesData, ObjcClassnamesAddress, ISAClassInfo->Name) << "\n";
                 resolveMethods(ISAClassInfo, true, false);
             }
         }
@@ -137,37 +151,129 @@ void ObjectiveCFile::resolveMethods() {
             resolveMethods(catInfo, true, CatRef, ClassInfo, isSwiftClass);
         }
     }
+
+    // Keep the first method found for each implementation.
+    std::stable_sort(Methods.begin(), Methods.end(),
+                     [](const ObjcMethod_t &L, const ObjcMethod_t &R) {
+                         return L.IMP < R.IMP;
+                     });
+    Methods.erase(std::unique(Methods.begin(), Methods.end(),
+                              [](const ObjcMethod_t &L, const ObjcMethod_t &R) {
+                                  return L.IMP == R.IMP;
+                              }),
+                  Methods.end());
+
+    std::sort(StringXRefs.begin(), StringXRefs.end(),
+              [](const std::pair<uint64_t, uint64_t> &L,
+                 const std::pair<uint64_t, uint64_t> &R) {
+                  return std::make_pair(L.second, L.first) <
+                         std::make_pair(R.second, R.first);
+              });
+    StringXRefs.erase(std::unique(StringXRefs.begin(), StringXRefs.end()),
+                      StringXRefs.end());
+}
+
+void ObjectiveCFile::resolveStringXRefs() {
+    for (unsigned Idx = 0; Idx + sizeof(uint64_t) <= ObjcSelrefsData.size(); Idx += sizeof(uint64_t)) {
+        uint64_t Name = *((const uint64_t*)ObjcSelrefsData.slice(Idx).data());
+        if (ObjcMethodnames.contains(Name))
+            StringXRefs.push_back(std::make_pair(ObjcSelrefsAddress + Idx, Name));
+    }
+    // A CFString is {isa, flags, characters, length}: only the characters
+    // point to a string.
+    const unsigned CFStringSize = 4 * sizeof(uint64_t);
+    const unsigned CharactersOffset = 2 * sizeof(uint64_t);
+    for (unsigned Idx = 0; Idx + CFStringSize <= CFStringsData.size(); Idx += CFStringSize) {
+        uint64_t Str = *((const uint64_t*)CFStringsData.slice(Idx + CharactersOffset).data());
+        if (cStrings.contains(Str))
+            StringXRefs.push_back(std::make_pair(CFStringsAddress + Idx + CharactersOffset, Str));
+    }
+}
+
+void ObjectiveCFile::addMethod(uint64_t IMP, bool ClassMethod, StringRef ClassName,
+                               StringRef MethodName) {
+    ObjcMethod_t M;
+    M.Class.ClassName = ClassName;
+    M.MethodName = MethodName;
+    M.isClassMethod = ClassMethod;
+    M.IMP = IMP;
+    Methods.push_back(M);
+}
+
+StringRef ObjectiveCFile::getFunctionName(uint64_t Address) const {
+    ensureResolved();
+    std::lock_guard<std::mutex> L(Lock);
+    auto Cached = FunctionNames.find(Address);
+    if (Cached != FunctionNames.end())
+        return Cached->second;
+
+    auto It = std::lower_bound(Methods.begin(), Methods.end(), Address,
+                               [](const ObjcMethod_t &M, uint64_t Addr) {
+                                   return M.IMP < Addr;
+                               });
+    if (It == Methods.end() || It->IMP != Address)
+        return StringRef();
+    std::string N = getMethodName(*It);
+    StringRef Name(NameSaver.save(StringRef(N)), N.size());
+    FunctionNames[Address] = Name;
+    return Name;
+}
+
+std::string ObjectiveCFile::getMethodName(const ObjcMethod_t &M) {
+    return (Twine(M.isClassMethod ? "+[" : "-[") + M.Class.ClassName + " " +
+            M.MethodName + "]").str();
+}
+
+std::vector<std::pair<uint64_t, StringRef>>
+ObjectiveCFile::getSelectorRefs() const {
+    ensureResolved();
+    std::vector<std::pair<uint64_t, StringRef>> Refs;
+    for (unsigned Idx = 0; Idx + sizeof(uint64_t) <= ObjcSelrefsData.size(); Idx += sizeof(uint64_t)) {
+        uint64_t Name = *((const uint64_t*)ObjcSelrefsData.slice(Idx).data());
+        if (!ObjcMethodnames.contains(Name))
+            continue;
+        Refs.push_back(std::make_pair(ObjcSelrefsAddress + Idx, ObjcMethodnames.getString(Name)));
+    }
+    return Refs;
 }
 
-//Objective-C class name
-StringRef ObjectiveCFile::getClassName(ArrayRef<uint8_t> &ObjcClassnames, uint64_t ObjcClassNamesAddress,
-                                         uint64_t Address) {
-    if(!(ObjcClassNamesAddress <= Address && Address <= ObjcClassNamesAddress + ObjcClassnames.size())){
-        DEBUG(errs() << "[+] assert failed:\n\tObjcClassNamesAddress: 0x" << utohexstr(ObjcClassnamesAddress) 
-            << "\n\tObjcClassNames size: 0x" << utohexstr(ObjcClassnames.size()) << "\n\tAddress: 0x" << utohexstr(Address) << "\n");
+std::vector<std::pair<uint64_t, StringRef>>
+ObjectiveCFile::getClassRefs() const {
+    ensureResolved();
+    std::vector<std::pair<uint64_t, StringRef>> Refs;
+    for (unsigned Idx = 0; Idx + sizeof(uint64_t) <= ObjcClassrefsData.size(); Idx += sizeof(uint64_t)) {
+        uint64_t RefAddress = ObjcClassrefsAddress + Idx;
+        uint64_t Class = *((const uint64_t*)ObjcClassrefsData.slice(Idx).data());
+        StringRef Name = ClassNames.lookup(Class);
+        if (Name.empty() && !Class) {
+            // The classes of other images are bound by the dynamic linker.
+            Name = Binds->getSymbolName(RefAddress, MachOBindEntry::Kind::Regular);
+            if (Name.startswith("_OBJC_CLASS_$_"))
+                Name = Name.substr(strlen("_OBJC_CLASS_$_"));
+        }
+        if (!Name.empty())
+            Refs.push_back(std::make_pair(RefAddress, Name));
     }
-    StringRef s((char*)ObjcClassnames.slice(Address - ObjcClassNamesAddress).data());
-    return s;
+    return Refs;
 }
 
-//Swift class name
-StringRef ObjectiveCFile::getClassName(ArrayRef<uint8_t> &cStrings, uint64_t cStringsAddress,
-                                         uint64_t Address, bool isSwiftClass) {
-    if(!(cStringsAddress <= Address && Address <= cStringsAddress + cStrings.size())){
-        DEBUG(errs() << "[+] assert failed:\n\tcStringsAddress: 0x" << utohexstr(cStringsAddress) 
-            << "\n\tObjcClassNames size: 0x" << utohexstr(cStrings.size()) << "\n\tAddress: 0x" << utohexstr(Address) << "\n");
+// The name of an Objective-C class is in __objc_classname, that of a Swift
+// class in __cstring.
+StringRef ObjectiveCFile::getClassName(const ObjcClassInfoStruct_t *ClassInfo, bool isSwiftClass) {
+    const MachOStringSection &Strings = isSwiftClass ? cStrings : ObjcClassnames;
+    if (!Strings.contains(ClassInfo->Name)) {
+        DEBUG(errs() << "[+] assert failed:\n\tClass names address: 0x" << utohexstr(Strings.getAddress())
+            << "\n\tClass names size: 0x" << utohexstr(Strings.getContents().size()) << "\n\tAddress: 0x" << utohexstr(ClassInfo->Name) << "\n");
+        return StringRef();
     }
-    StringRef s((char*)cStrings.slice(Address - cStringsAddress).data());
-    return s;
+    StringXRefs.push_back(std::make_pair(getConstAddress(&ClassInfo->Name), ClassInfo->Name));
+    return Strings.getString(ClassInfo->Name);
 }
 
-StringRef ObjectiveCFile::getMethodName(ArrayRef<uint8_t> &ObjcMethodnames, uint64_t ObjcMethodnamesAddress,
-                                          uint64_t Address) {
-    assert(ObjcMethodnamesAddress <= Address && Address <= ObjcMethodnamesAddress + ObjcMethodnames.size());
-    //errs() << "[+]Address: 0x" << utohexstr(Address) << "\tAddress - ObjcMethodnamesAddress: " 
-    //    << (Address - ObjcMethodnamesAddress) << "\tObjcMethodnames.size(): 0x" << utohexstr(ObjcMethodnames.size()) << "\n";
-    StringRef s((char*)ObjcMethodnames.slice(Address - ObjcMethodnamesAddress).data());
-    return s;
+StringRef ObjectiveCFile::getMethodName(const ObjcMethodListEntry_t &Entry) {
+    assert(ObjcMethodnames.contains(Entry.Name));
+    StringXRefs.push_back(std::make_pair(getConstAddress(&Entry.Name), Entry.Name));
+    return ObjcMethodnames.getString(Entry.Name);
 }
 
 void ObjectiveCFile::resolveMethods(ObjcClassInfoStruct_t *ClassInfo, bool ClassMethods, bool isSwiftClass) {
@@ -175,13 +281,7 @@ void ObjectiveCFile::resolveMethods(ObjcClassInfoStruct_t *ClassInfo, bool Class
         return;
     }
 
-    StringRef ClassName;
-    if(isSwiftClass) {
-        ClassName = getClassName(cStringsData, cStringsAddress, ClassInfo->Name, true);
-    }
-    else{
-        ClassName = getClassName(ObjcClassnamesData, ObjcClassnamesAddress, ClassInfo->Name);
-    }
+    StringRef ClassName = getClassName(ClassInfo, isSwiftClass);
 
     if (ClassName == "LastPassModel") {
         assert(true);
@@ -191,26 +291,11 @@ void ObjectiveCFile::resolveMethods(ObjcClassInfoStruct_t *ClassInfo, bool Class
     for (unsigned MethodIdx = 0; MethodIdx < MethodlistHeader->Count; ++MethodIdx) {
         if (!MethodlistEntry[MethodIdx].Implementation)
             continue;
-        StringRef Methodname = getMethodName(ObjcMethodnamesData, ObjcMethodnamesAddress, MethodlistEntry[MethodIdx].Name);
+        StringRef Methodname = getMethodName(MethodlistEntry[MethodIdx]);
         if (Methodname == "notifyInAppPurchasingEnabledChanged") {
             assert(true);
         }
-        /*
-            add by -death to repair the conversion between stringref and twine
-             */
-        //std::string N = ((ClassMethods ? "+[" : "-[") + ClassName + " " + Methodname + "]").str();
-        std::string N;
-        if(ClassMethods == true){
-            N = StringRef("+[").str() + ClassName.str() + StringRef(" ").str() + Methodname.str() + StringRef("]").str();
-        }
-        else{
-            N = StringRef("-[").str() + ClassName.str() + StringRef(" ").str() + Methodname.str() + StringRef("]").str();
-        }
-        /*
-        add by -death
-         */
-        // errs() << utohexstr(MethodlistEntry[MethodIdx].Implementation) << ": " << N << "\n";
-        FunctionNames.insert(std::pair<uint64_t, std::string>(MethodlistEntry[MethodIdx].Implementation, N));
+        addMethod(MethodlistEntry[MethodIdx].Implementation, ClassMethods, ClassName, Methodname);
     }
     //errs() << "[+]resolveMethods end.\n";
 }
@@ -225,13 +310,7 @@ void ObjectiveCFile::resolveMethods(ObjcCatInfoStruct_t *CatInfo, bool ClassMeth
     if (CatInfo->Class) {
         assert(ClassInfo && ClassInfo->Name);
         DEBUG(dbgs() << "[+]CatInfo->Name address: 0x" << utohexstr(CatInfo->Name));
-        StringRef ClassName;
-        if(isSwiftClass) {
-            ClassName = getClassName(cStringsData, cStringsAddress, ClassInfo->Name, true);
-        }
-        else{
-            ClassName = getClassName(ObjcClassnamesData, ObjcClassnamesAddress, ClassInfo->Name);
-        }
+        StringRef ClassName = getClassName(ClassInfo, isSwiftClass);
     } else {
         //Pointer do function name is not set yet -> binding info
         ClassName = getClassName(CatInfoAddress + 8);
@@ -248,19 +327,8 @@ void ObjectiveCFile::resolveMethods(ObjcCatInfoStruct_t *CatInfo, bool ClassMeth
         for (unsigned MethodIdx = 0; MethodIdx < MethodlistHeader->Count; ++MethodIdx) {
             if (!MethodlistEntry[MethodIdx].Implementation)
                 continue;
-            StringRef Methodname = getMethodName(ObjcMethodnamesData, ObjcMethodnamesAddress,
-                                                 MethodlistEntry[MethodIdx].Name);
-            /*
-            add by -death to repair the conversion between stringref and twine
-             */
-            std::string tmp_N = StringRef("-[").str() + ClassName.str() + StringRef(" ").str() + Methodname.str() + StringRef("]").str();
-            StringRef N = StringRef(tmp_N);
-            /*
-            add by -death
-             */
-            //StringRef N = ("-[" + ClassName + " " + Methodname + "]").str();
-            // errs() << utohexstr(MethodlistEntry[MethodIdx].Implementation) << ": " << N << "\n";
-            FunctionNames.insert(std::pair<uint64_t, std::string>(MethodlistEntry[MethodIdx].Implementation, N.str()));
+            StringRef Methodname = getMethodName(MethodlistEntry[MethodIdx]);
+            addMethod(MethodlistEntry[MethodIdx].Implementation, false, ClassName, Methodname);
         }
     }
 
@@ -272,131 +340,15 @@ void ObjectiveCFile::resolveMethods(ObjcCatInfoStruct_t *CatInfo, bool ClassMeth
         for (unsigned MethodIdx = 0; MethodIdx < MethodlistHeader->Count; ++MethodIdx) {
             if (!MethodlistEntry[MethodIdx].Implementation)
                 continue;
-            StringRef Methodname = getMethodName(ObjcMethodnamesData, ObjcMethodnamesAddress,
-                                                 MethodlistEntry[MethodIdx].Name);
-            /*
-            add by -death to repair the conversion between stringref and twine
-             */
-            std::string tmp_N = StringRef("+[").str() + ClassName.str() + StringRef(" ").str() + Methodname.str() + StringRef("]").str();
-            StringRef N = StringRef(tmp_N);
-            //StringRef N = ("+[" + ClassName + " " + Methodname + "]").str();
-            /*
-            add by -death
-             */
-            // errs() << utohexstr(MethodlistEntry[MethodIdx].Implementation) << ": " << N << "\n";
-            FunctionNames.insert(std::pair<uint64_t, std::string>(MethodlistEntry[MethodIdx].Implementation, N.str()));
+            StringRef Methodname = getMethodName(MethodlistEntry[MethodIdx]);
+            addMethod(MethodlistEntry[MethodIdx].Implementation, true, ClassName, Methodname);
         }
     }
 }
 
 StringRef ObjectiveCFile::getClassName(uint64_t Pointer) {
-    ArrayRef<uint8_t> BindOpcodes = MachO->getDyldInfoBindOpcodes();
-
-    uint64_t SegmentNo = 0;
-    int64_t Offset = 0;
-    StringRef SymbolName;
-
-    for (unsigned Idx = 0; Idx < BindOpcodes.size();) {
-        if (Idx == 283) {
-            assert(true);
-        }
-        unsigned Opcode = *BindOpcodes.slice(Idx).data();
-
-        if ((Opcode & ~0xF) == MachO::BIND_OPCODE_SET_DYLIB_ORDINAL_IMM) {
-            unsigned Imm = Opcode & 0xF;
-            Idx++;
-        } else if ((Opcode & ~0xF) == MachO::BIND_OPCODE_SET_SYMBOL_TRAILING_FLAGS_IMM) {
-            Idx++;
-            SymbolName = (const char*)BindOpcodes.slice(Idx).data();
-            Idx += SymbolName.size() + 1;
-        } else if (Opcode == (MachO::BIND_OPCODE_SET_TYPE_IMM | 0x1)) {
-            //Set type pointer
-            Idx++;
-        } else if ((Opcode & ~0xF) == MachO::BIND_OPCODE_SET_SEGMENT_AND_OFFSET_ULEB) {
-            SegmentNo = Opcode & 0xF;
-            Idx++;
-            unsigned n;
-            Offset = decodeULEB128(BindOpcodes.slice(Idx).data(), &n);
-            Idx += n;
-        } else if (Opcode == MachO::BIND_OPCODE_DO_BIND) {
-            MachO::segment_command_64 Segment = getSegment(SegmentNo);
-            if (Segment.vmaddr + Offset == Pointer) {
-                return SymbolName;
-            }
-            //FIXME: is this add correct???
-            Offset += 8;
-            Idx++;
-        } else if (Opcode == MachO::BIND_OPCODE_ADD_ADDR_ULEB) {
-            Idx++;
-            unsigned n;
-            Offset += decodeULEB128(BindOpcodes.slice(Idx).data(), &n);
-            Idx += n;
-        } else if ((Opcode & ~0xF) == MachO::BIND_OPCODE_DO_BIND_ADD_ADDR_IMM_SCALED) {
-            unsigned Scaled = (Opcode & 0xF) * 8;
-            if (getSegment(SegmentNo).vmaddr + Offset == Pointer) {
-                return SymbolName;
-            }
-//            addClass(SymbolName, getSegment(SegmentNo).vmaddr + Offset);
-            //FIXME: again the add of 8
-            Offset += Scaled + 8;
-            Idx++;
-        } else if (Opcode == MachO::BIND_OPCODE_DO_BIND_ULEB_TIMES_SKIPPING_ULEB) {
-            //TODO:
-            Idx++;
-            unsigned n;
-            uint64_t Count = decodeULEB128(BindOpcodes.slice(Idx).data(), &n);
-            Idx += n;
-            n = 0;
-            uint64_t Skip = decodeULEB128(BindOpcodes.slice(Idx).data(), &n);
-            for (unsigned i = 0; i < Count; ++i) {
-//                addClass(SymbolName, getSegment(SegmentNo).vmaddr + Offset);
-                if (getSegment(SegmentNo).vmaddr + Offset == Pointer) {
-                    return SymbolName;
-                }
-                Offset += 8 + Skip;
-            }
-            Idx += n;
-        } else if (Opcode == MachO::BIND_OPCODE_DO_BIND_ADD_ADDR_ULEB) {
-//            addClass(SymbolName, getSegment(SegmentNo).vmaddr + Offset);
-            if (getSegment(SegmentNo).vmaddr + Offset == Pointer) {
-                return SymbolName;
-            }
-            Idx++;
-            unsigned n;
-            Offset += decodeULEB128(BindOpcodes.slice(Idx).data(), &n) + 8;
-            Idx += n;
-        } else if (Opcode == MachO::BIND_OPCODE_DONE) {
-            break;
-        } else if (Opcode == MachO::BIND_OPCODE_SET_DYLIB_ORDINAL_ULEB) {
-            Idx++;
-            unsigned n;
-            uint64_t dylib = decodeULEB128(BindOpcodes.slice(Idx).data(), &n) + 8;
-            Idx += n;
-        } else if (Opcode == MachO::BIND_OPCODE_SET_ADDEND_SLEB) {
-            Idx++;
-            unsigned n;
-            uint64_t addend = decodeSLEB128(BindOpcodes.slice(Idx).data(), &n);
-            Idx += n;
-        } else {
-            errs() << "0X" << utohexstr(Idx) << "\n";
-            errs() << "0x" << utohexstr(Opcode) << "\n";
-            assert(false);
-        }
-    }
-    llvm_unreachable("");
+    StringRef SymbolName = Binds->getSymbolName(Pointer, MachOBindEntry::Kind::Regular);
+    DEBUG(if (SymbolName.empty())
+              dbgs() << "[!]No binding at 0x" << utohexstr(Pointer) << "\n");
+    return SymbolName;
 }
-
-MachO::segment_command_64 ObjectiveCFile::getSegment(uint64_t SegmentNo) {
-    uint64_t Idx = 0;
-    for(object::MachOObjectFile::load_command_iterator L_it = MachO->begin_load_commands();
-        L_it != MachO->end_load_commands(); ++L_it) {
-        if (L_it->C.cmd == MachO::LC_SEGMENT_64) {
-            if (Idx == SegmentNo) {
-                return MachO->getSegment64LoadCommand(*L_it);
-            } else {
-                Idx++;
-            }
-        }
-    }
-    llvm_unreachable("Cant find segment");
-};
@@ -0,0 +1,506 @@
+//===- SwiftMetadataIndex.cpp - Mach-O Swift metadata index ---------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Object/SwiftMetadataIndex.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/Object/MachO.h"
+#include "llvm/Support/Endian.h"
+#include <algorithm>
+
+using namespace llvm;
+using namespace object;
+
+namespace {
+// The layouts of the Swift 5 ABI (swift/ABI/Metadata.h), in bytes.
+enum : unsigned {
+  // ContextDescriptorFlags.
+  CDF_KindMask = 0x1f,
+  CDF_IsGeneric = 0x80,
+  // The class flags, in the kind-specific high half.
+  CDF_ClassHasVTable = 1u << 31,
+  CDF_ClassHasOverrideTable = 1u << 30,
+  CDF_ClassHasResilientSuperclass = 1u << 29,
+  CDF_MetadataInitShift = 16,
+  CDF_MetadataInitMask = 3,
+
+  CK_Module = 0,
+  CK_Protocol = 3,
+  CK_Class = 16,
+  CK_TypeFirst = 16,
+  CK_TypeLast = 31,
+
+  MI_Singleton = 1,
+  MI_Foreign = 2,
+
+  // {Flags, Parent, Name, AccessFunction, Fields} of the type descriptors,
+  // then {Superclass, MetadataNegativeSizeInWords,
+  // MetadataPositiveSizeInWords, NumImmediateMembers, NumFields,
+  // FieldOffsetVectorOffset} of the class descriptors.
+  TD_Parent = 4,
+  TD_Name = 8,
+  TD_AccessFunction = 12,
+  TD_Fields = 16,
+  ClassDescriptorSize = 44,
+
+  // MethodDescriptorFlags, also those of the protocol requirements, but for
+  // the kinds.
+  MDF_KindMask = 0xf,
+  MDF_IsInstance = 0x10,
+  MDF_IsAsync = 0x40,
+  MethodDescriptorSize = 8,
+  MethodOverrideDescriptorSize = 12,
+
+  // {Flags, Parent, Name, NumRequirementsInSignature, NumRequirements,
+  // AssociatedTypeNames} of the protocol descriptors.
+  PD_NumRequirementsInSignature = 12,
+  PD_NumRequirements = 16,
+  ProtocolDescriptorSize = 24,
+  GenericRequirementSize = 12,
+  ProtocolRequirementSize = 8,
+  PRK_AsyncFlag = 0x20,
+
+  // {Protocol, TypeRef, WitnessTablePattern, Flags} of the conformances.
+  PC_TypeRef = 4,
+  PC_WitnessTable = 8,
+  PC_Flags = 12,
+  PCF_TypeRefKindShift = 3,
+  PCF_TypeRefKindMask = 7,
+
+  // TypeReferenceKind.
+  TRK_DirectTypeDescriptor = 0,
+  TRK_IndirectTypeDescriptor = 1,
+  TRK_DirectObjCClassName = 2,
+
+  // {MangledTypeName, Superclass, Kind, FieldRecordSize, NumFields} of the
+  // field descriptors, then the records, {Flags, MangledTypeName, FieldName}.
+  FD_FieldRecordSize = 10,
+  FD_NumFields = 12,
+  FieldDescriptorSize = 16,
+  FR_FieldName = 8,
+  FieldRecordSize = 12
+};
+} // end anonymous namespace
+
+static SwiftMetadataIndex::MethodKind getMethodKind(uint32_t Flags) {
+  typedef SwiftMetadataIndex S;
+  switch (Flags & MDF_KindMask) {
+  case 0: return S::MK_Method;
+  case 1: return S::MK_Init;
+  case 2: return S::MK_Getter;
+  case 3: return S::MK_Setter;
+  case 4: return S::MK_ModifyCoroutine;
+  case 5: return S::MK_ReadCoroutine;
+  default: return S::MK_Other;
+  }
+}
+
+// The protocol requirements have the base protocols first.
+static SwiftMetadataIndex::MethodKind getRequirementKind(uint32_t Flags) {
+  typedef SwiftMetadataIndex S;
+  switch (Flags & MDF_KindMask) {
+  case 1: return S::MK_Method;
+  case 2: return S::MK_Init;
+  case 3: return S::MK_Getter;
+  case 4: return S::MK_Setter;
+  case 5: return S::MK_ReadCoroutine;
+  case 6: return S::MK_ModifyCoroutine;
+  default: return S::MK_Other;
+  }
+}
+
+const char *SwiftMetadataIndex::getMethodKindName(MethodKind Kind) {
+  switch (Kind) {
+  case MK_Method: return "method";
+  case MK_Init: return "init";
+  case MK_Getter: return "getter";
+  case MK_Setter: return "setter";
+  case MK_ModifyCoroutine: return "modify";
+  case MK_ReadCoroutine: return "read";
+  case MK_Other: break;
+  }
+  return "function";
+}
+
+SwiftMetadataIndex::SwiftMetadataIndex(const MachOObjectFile &MachO)
+    : MachO(MachO), Resolved(false) {}
+
+const SwiftMetadataIndex::Section *
+SwiftMetadataIndex::findSection(uint64_t Addr) const {
+  auto I = std::upper_bound(
+      Sections.begin(), Sections.end(), Addr,
+      [](uint64_t Addr, const Section &S) { return Addr < S.Address; });
+  if (I == Sections.begin())
+    return nullptr;
+  --I;
+  if (Addr - I->Address >= I->Contents.size())
+    return nullptr;
+  return &*I;
+}
+
+bool SwiftMetadataIndex::read32(uint64_t Addr, uint32_t &Value) const {
+  const Section *S = findSection(Addr);
+  if (!S || Addr - S->Address + 4 > S->Contents.size())
+    return false;
+  Value = support::endian::read32le(S->Contents.data() + (Addr - S->Address));
+  return true;
+}
+
+bool SwiftMetadataIndex::read64(uint64_t Addr, uint64_t &Value) const {
+  const Section *S = findSection(Addr);
+  if (!S || Addr - S->Address + 8 > S->Contents.size())
+    return false;
+  Value = support::endian::read64le(S->Contents.data() + (Addr - S->Address));
+  return true;
+}
+
+bool SwiftMetadataIndex::isCode(uint64_t Addr) const {
+  const Section *S = findSection(Addr);
+  return S && S->IsText;
+}
+
+StringRef SwiftMetadataIndex::getCString(uint64_t Addr) const {
+  const Section *S = findSection(Addr);
+  if (!S)
+    return StringRef();
+  StringRef Str = S->Contents.substr(Addr - S->Address);
+  return Str.substr(0, Str.find('\0'));
+}
+
+uint64_t SwiftMetadataIndex::getRelative(uint64_t Addr) const {
+  uint32_t Offset;
+  if (!read32(Addr, Offset) || !Offset)
+    return 0;
+  return Addr + int64_t(int32_t(Offset));
+}
+
+uint64_t SwiftMetadataIndex::getRelativeIndirectable(uint64_t Addr) const {
+  uint32_t Offset;
+  if (!read32(Addr, Offset) || !Offset)
+    return 0;
+  uint64_t Target = Addr + int64_t(int32_t(Offset & ~1u));
+  if (!(Offset & 1))
+    return Target;
+  // The pointer is bound by the dynamic linker if the target is in another
+  // image: it is still null here.
+  uint64_t Pointer;
+  if (!read64(Target, Pointer))
+    return 0;
+  return Pointer;
+}
+
+std::string SwiftMetadataIndex::getContextName(uint64_t Descriptor,
+                                               unsigned Depth) const {
+  uint32_t Flags;
+  // The parents of a type are few: more is a cycle.
+  if (Depth > 16 || !read32(Descriptor, Flags))
+    return std::string();
+  unsigned Kind = Flags & CDF_KindMask;
+  std::string Parent;
+  if (Kind != CK_Module)
+    if (uint64_t P = getRelativeIndirectable(Descriptor + TD_Parent))
+      Parent = getContextName(P, Depth + 1);
+  // Extensions only have the mangled name of the type they extend: their
+  // members are named after the module. Anonymous contexts have no name.
+  if (Kind != CK_Module && Kind != CK_Protocol && Kind < CK_TypeFirst)
+    return Parent;
+  StringRef Name;
+  if (uint64_t N = getRelative(Descriptor + TD_Name))
+    Name = getCString(N);
+  if (Parent.empty())
+    return Name;
+  return (Twine(Parent) + "." + Name).str();
+}
+
+void SwiftMetadataIndex::resolve() {
+  Resolved = true;
+  StringRef TypesContents, FieldsContents, ProtoContents;
+  uint64_t TypesAddr = 0, FieldsAddr = 0, ProtoAddr = 0;
+  for (const SectionRef &S : MachO.sections()) {
+    StringRef Name, Contents;
+    if (S.getName(Name) || S.getContents(Contents) || Contents.empty())
+      continue;
+    Section Sec = {S.getAddress(), Contents, S.isText()};
+    Sections.push_back(Sec);
+    if (Name == "__swift5_types") {
+      TypesAddr = Sec.Address;
+      TypesContents = Contents;
+    } else if (Name == "__swift5_fieldmd") {
+      FieldsAddr = Sec.Address;
+      FieldsContents = Contents;
+    } else if (Name == "__swift5_proto") {
+      ProtoAddr = Sec.Address;
+      ProtoContents = Contents;
+    }
+  }
+  if (TypesContents.empty() && ProtoContents.empty())
+    return;
+  std::sort(Sections.begin(), Sections.end(),
+            [](const Section &L, const Section &R) {
+              return L.Address < R.Address;
+            });
+
+  // The types point to their fields.
+  addFields(FieldsAddr, FieldsContents);
+
+  for (uint64_t Off = 0; Off + 4 <= TypesContents.size(); Off += 4) {
+    uint64_t Entry = TypesAddr + Off;
+    uint32_t Value;
+    if (!read32(Entry, Value) || !Value)
+      continue;
+    // The low bits are the TypeReferenceKind.
+    uint64_t Target = Entry + int64_t(int32_t(Value & ~3u));
+    switch (Value & 3) {
+    case TRK_DirectTypeDescriptor:
+      addType(Target);
+      break;
+    case TRK_IndirectTypeDescriptor: {
+      uint64_t Descriptor;
+      if (read64(Target, Descriptor) && Descriptor)
+        addType(Descriptor);
+      break;
+    }
+    default:
+      break;
+    }
+  }
+
+  for (uint64_t Off = 0; Off + 4 <= ProtoContents.size(); Off += 4)
+    if (uint64_t Descriptor = getRelative(ProtoAddr + Off))
+      addConformance(Descriptor);
+
+  // Keep the first name found for each function.
+  std::stable_sort(FunctionNames.begin(), FunctionNames.end(),
+                   [](const std::pair<uint64_t, std::string> &L,
+                      const std::pair<uint64_t, std::string> &R) {
+                     return L.first < R.first;
+                   });
+  FunctionNames.erase(
+      std::unique(FunctionNames.begin(), FunctionNames.end(),
+                  [](const std::pair<uint64_t, std::string> &L,
+                     const std::pair<uint64_t, std::string> &R) {
+                    return L.first == R.first;
+                  }),
+      FunctionNames.end());
+}
+
+void SwiftMetadataIndex::addFields(uint64_t Addr, StringRef Contents) {
+  // The field descriptors are laid out back to back.
+  for (uint64_t Off = 0; Off + FieldDescriptorSize <= Contents.size();) {
+    const char *D = Contents.data() + Off;
+    unsigned RecordSize = support::endian::read16le(D + FD_FieldRecordSize);
+    uint32_t NumFields = support::endian::read32le(D + FD_NumFields);
+    uint64_t Size = FieldDescriptorSize + uint64_t(NumFields) * RecordSize;
+    if (RecordSize < FieldRecordSize || Off + Size > Contents.size())
+      break;
+    std::vector<StringRef> &Names = FieldDescriptors[Addr + Off];
+    for (uint32_t I = 0; I != NumFields; ++I) {
+      uint64_t Record = Addr + Off + FieldDescriptorSize + I * RecordSize;
+      uint64_t Name = getRelative(Record + FR_FieldName);
+      Names.push_back(Name ? getCString(Name) : StringRef());
+    }
+    Off += Size;
+  }
+}
+
+void SwiftMetadataIndex::addType(uint64_t Descriptor) {
+  uint32_t Flags;
+  if (!read32(Descriptor, Flags) || TypeIndex.count(Descriptor))
+    return;
+  unsigned Kind = Flags & CDF_KindMask;
+  if (Kind < CK_TypeFirst || Kind > CK_TypeLast)
+    return;
+  TypeIndex[Descriptor] = Types.size();
+  Types.push_back(Type());
+  Type &T = Types.back();
+  T.Descriptor = Descriptor;
+  T.Kind = Kind;
+  T.Name = getContextName(Descriptor);
+  T.AccessFunction = getRelative(Descriptor + TD_AccessFunction);
+  T.VTableOffset = 0;
+  if (uint64_t Fields = getRelative(Descriptor + TD_Fields)) {
+    auto FI = FieldDescriptors.find(Fields);
+    if (FI != FieldDescriptors.end())
+      T.Fields = FI->second;
+  }
+  if (T.AccessFunction && isCode(T.AccessFunction))
+    FunctionNames.push_back(std::make_pair(
+        T.AccessFunction, "type metadata accessor for " + T.Name));
+  if (Kind == CK_Class)
+    addClassVTable(T, Flags);
+}
+
+void SwiftMetadataIndex::addClassVTable(Type &T, uint32_t Flags) {
+  // The generic classes have a header of variable size first.
+  if (Flags & CDF_IsGeneric)
+    return;
+  uint64_t Addr = T.Descriptor + ClassDescriptorSize;
+  if (Flags & CDF_ClassHasResilientSuperclass)
+    Addr += 4;
+  switch ((Flags >> CDF_MetadataInitShift) & CDF_MetadataInitMask) {
+  case MI_Singleton: Addr += 12; break;
+  case MI_Foreign: Addr += 4; break;
+  default: break;
+  }
+
+  if (Flags & CDF_ClassHasVTable) {
+    uint32_t Offset, Size;
+    if (!read32(Addr, Offset) || !read32(Addr + 4, Size))
+      return;
+    Addr += 8;
+    T.VTableOffset = Offset;
+    for (uint32_t I = 0; I != Size; ++I, Addr += MethodDescriptorSize) {
+      uint32_t MFlags;
+      if (!read32(Addr, MFlags))
+        return;
+      Method M;
+      M.Descriptor = Addr;
+      M.Kind = getMethodKind(MFlags);
+      M.IsInstance = MFlags & MDF_IsInstance;
+      // The implementation of an async method is an async function pointer.
+      M.Impl = 0;
+      if (!(MFlags & MDF_IsAsync)) {
+        uint64_t Impl = getRelative(Addr + 4);
+        if (isCode(Impl))
+          M.Impl = Impl;
+      }
+      MethodOffsets[Addr] = Offset + I;
+      if (M.Impl)
+        FunctionNames.push_back(std::make_pair(
+            M.Impl, (Twine(T.Name) + "." + getMethodKindName(M.Kind) + "." +
+                     Twine(I)).str()));
+      T.VTable.push_back(M);
+    }
+  }
+
+  if (Flags & CDF_ClassHasOverrideTable) {
+    uint32_t Size;
+    if (!read32(Addr, Size))
+      return;
+    Addr += 4;
+    for (uint32_t I = 0; I != Size; ++I, Addr += MethodOverrideDescriptorSize) {
+      Override O;
+      O.Method = getRelativeIndirectable(Addr + 4);
+      uint64_t Impl = getRelative(Addr + 8);
+      // The method of a superclass of the image gives the kind.
+      uint32_t MFlags;
+      MethodKind Kind = MK_Other;
+      if (O.Method && read32(O.Method, MFlags)) {
+        Kind = getMethodKind(MFlags);
+        if (MFlags & MDF_IsAsync)
+          Impl = 0;
+      }
+      O.Impl = isCode(Impl) ? Impl : 0;
+      if (O.Impl)
+        FunctionNames.push_back(std::make_pair(
+            O.Impl, (Twine(T.Name) + ".override." + getMethodKindName(Kind) +
+                     "." + Twine(I)).str()));
+      T.Overrides.push_back(O);
+    }
+  }
+}
+
+void SwiftMetadataIndex::addConformance(uint64_t Descriptor) {
+  uint32_t Flags;
+  if (!read32(Descriptor + PC_Flags, Flags))
+    return;
+  Conformances.push_back(Conformance());
+  Conformance &C = Conformances.back();
+  C.Descriptor = Descriptor;
+  C.Type = 0;
+  uint64_t TypeRef = getRelative(Descriptor + PC_TypeRef);
+  switch ((Flags >> PCF_TypeRefKindShift) & PCF_TypeRefKindMask) {
+  case TRK_DirectTypeDescriptor:
+    C.Type = TypeRef;
+    break;
+  case TRK_IndirectTypeDescriptor:
+    if (!TypeRef || !read64(TypeRef, C.Type))
+      C.Type = 0;
+    break;
+  case TRK_DirectObjCClassName:
+    if (TypeRef)
+      C.TypeName = getCString(TypeRef);
+    break;
+  default:
+    break;
+  }
+  if (C.Type)
+    C.TypeName = getContextName(C.Type);
+
+  uint64_t Protocol = getRelativeIndirectable(Descriptor);
+  uint64_t WitnessTable = getRelative(Descriptor + PC_WitnessTable);
+  if (Protocol) {
+    C.ProtocolName = getContextName(Protocol);
+    if (WitnessTable)
+      addProtocolWitnesses(C, Protocol, WitnessTable);
+  }
+}
+
+void SwiftMetadataIndex::addProtocolWitnesses(Conformance &C,
+                                              uint64_t Protocol,
+                                              uint64_t WitnessTable) {
+  uint32_t NumSignature, NumRequirements;
+  if (!read32(Protocol + PD_NumRequirementsInSignature, NumSignature) ||
+      !read32(Protocol + PD_NumRequirements, NumRequirements))
+    return;
+  uint64_t Requirement = Protocol + ProtocolDescriptorSize +
+                         uint64_t(NumSignature) * GenericRequirementSize;
+  // The first word of the witness table is the conformance descriptor: the
+  // witnesses follow, one per requirement.
+  for (uint32_t I = 0; I != NumRequirements;
+       ++I, Requirement += ProtocolRequirementSize) {
+    uint32_t RFlags;
+    uint64_t Impl;
+    if (!read32(Requirement, RFlags) || !read64(WitnessTable + 8 * (I + 1), Impl))
+      return;
+    MethodKind Kind = getRequirementKind(RFlags);
+    if (Kind == MK_Other || (RFlags & PRK_AsyncFlag) || !isCode(Impl))
+      continue;
+    Conformance::Witness W = {I, Kind, Impl};
+    C.Witnesses.push_back(W);
+    FunctionNames.push_back(std::make_pair(
+        Impl, (Twine("protocol witness for ") + C.ProtocolName + "." +
+               getMethodKindName(Kind) + "." + Twine(I) + " in " +
+               C.TypeName).str()));
+  }
+}
+
+const SwiftMetadataIndex::Type *
+SwiftMetadataIndex::getType(uint64_t Descriptor) const {
+  ensureResolved();
+  auto I = TypeIndex.find(Descriptor);
+  return I == TypeIndex.end() ? nullptr : &Types[I->second];
+}
+
+StringRef SwiftMetadataIndex::getFunctionName(uint64_t Address) const {
+  ensureResolved();
+  auto I = std::lower_bound(FunctionNames.begin(), FunctionNames.end(),
+                            Address,
+                            [](const std::pair<uint64_t, std::string> &N,
+                               uint64_t Addr) { return N.first < Addr; });
+  if (I == FunctionNames.end() || I->first != Address)
+    return StringRef();
+  return I->second;
+}
+
+uint64_t SwiftMetadataIndex::getVTableImpl(uint64_t Descriptor,
+                                           unsigned WordOffset) const {
+  const Type *T = getType(Descriptor);
+  if (!T)
+    return 0;
+  if (WordOffset >= T->VTableOffset &&
+      WordOffset - T->VTableOffset < T->VTable.size())
+    return T->VTable[WordOffset - T->VTableOffset].Impl;
+  // The methods of the superclasses are where they are in theirs.
+  for (const Override &O : T->Overrides) {
+    auto MI = MethodOffsets.find(O.Method);
+    if (MI != MethodOffsets.end() && MI->second == WordOffset)
+      return O.Impl;
+  }
+  return 0;
+}
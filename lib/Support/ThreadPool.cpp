@@ -0,0 +1,159 @@
+//===-- ThreadPool.cpp - A work-stealing thread pool ----------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Compiler.h"
+#include "llvm/Support/Threading.h"
+
+using namespace llvm;
+
+// The pool the current thread is a worker of, and its index there.
+static LLVM_THREAD_LOCAL const ThreadPool *CurrentPool = nullptr;
+static LLVM_THREAD_LOCAL unsigned CurrentIndex = 0;
+
+ThreadPool::ThreadPool(unsigned NumThreads)
+    : NumQueued(0), NumPending(0), Stopping(false), NextQueue(0) {
+  if (!llvm_is_multithreaded())
+    NumThreads = 0;
+  for (unsigned I = 0; I != NumThreads; ++I)
+    Queues.emplace_back(new WorkerQueue);
+  for (unsigned I = 0; I != NumThreads; ++I)
+    Threads.emplace_back([this, I] { runWorker(I); });
+}
+
+ThreadPool::~ThreadPool() {
+  wait();
+  {
+    std::lock_guard<std::mutex> Guard(Lock);
+    Stopping = true;
+  }
+  WorkAvailable.notify_all();
+  for (std::thread &T : Threads)
+    T.join();
+}
+
+unsigned ThreadPool::getThreadIndex() const {
+  return CurrentPool == this ? CurrentIndex : getNumThreads();
+}
+
+void ThreadPool::async(TaskTy Task) {
+  if (Threads.empty()) {
+    Task();
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> Guard(Lock);
+    unsigned Index = getThreadIndex();
+    if (Index == getNumThreads())
+      Index = NextQueue++ % getNumThreads();
+    {
+      std::lock_guard<std::mutex> QueueGuard(Queues[Index]->Lock);
+      Queues[Index]->Tasks.push_back(std::move(Task));
+    }
+    ++NumQueued;
+    ++NumPending;
+  }
+  WorkAvailable.notify_one();
+}
+
+bool ThreadPool::takeTask(unsigned Self, TaskTy &Task) {
+  const unsigned NumQueues = Queues.size();
+  if (!NumQueues)
+    return false;
+  // Outside the pool, start stealing from the first queue.
+  if (Self < NumQueues) {
+    WorkerQueue &Own = *Queues[Self];
+    std::lock_guard<std::mutex> Guard(Own.Lock);
+    if (!Own.Tasks.empty()) {
+      Task = std::move(Own.Tasks.back());
+      Own.Tasks.pop_back();
+      return true;
+    }
+  }
+  for (unsigned I = 1; I <= NumQueues; ++I) {
+    WorkerQueue &Victim = *Queues[(Self + I) % NumQueues];
+    std::lock_guard<std::mutex> Guard(Victim.Lock);
+    if (!Victim.Tasks.empty()) {
+      Task = std::move(Victim.Tasks.front());
+      Victim.Tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::runTask(TaskTy &Task) {
+  {
+    std::lock_guard<std::mutex> Guard(Lock);
+    --NumQueued;
+  }
+  Task();
+  std::lock_guard<std::mutex> Guard(Lock);
+  if (--NumPending == 0)
+    AllDone.notify_all();
+}
+
+bool ThreadPool::runQueuedTask() {
+  TaskTy Task;
+  if (!takeTask(getThreadIndex(), Task))
+    return false;
+  runTask(Task);
+  return true;
+}
+
+void ThreadPool::runWorker(unsigned Self) {
+  CurrentPool = this;
+  CurrentIndex = Self;
+  for (;;) {
+    TaskTy Task;
+    if (takeTask(Self, Task)) {
+      runTask(Task);
+      continue;
+    }
+    std::unique_lock<std::mutex> Guard(Lock);
+    WorkAvailable.wait(Guard, [&] { return Stopping || NumQueued; });
+    if (Stopping && !NumQueued)
+      return;
+  }
+}
+
+void ThreadPool::wait() {
+  std::unique_lock<std::mutex> Guard(Lock);
+  AllDone.wait(Guard, [&] { return !NumPending; });
+}
+
+void TaskGroup::async(ThreadPool::TaskTy Task) {
+  {
+    std::lock_guard<std::mutex> Guard(Lock);
+    ++NumPending;
+  }
+  Pool.async([this, Task] {
+    Task();
+    std::lock_guard<std::mutex> Guard(Lock);
+    if (--NumPending == 0)
+      AllDone.notify_all();
+  });
+}
+
+void TaskGroup::wait() {
+  for (;;) {
+    {
+      std::lock_guard<std::mutex> Guard(Lock);
+      if (!NumPending)
+        return;
+    }
+    // Help with the queued tasks, the group's or not: once none are left,
+    // the group's are all running.
+    if (Pool.runQueuedTask())
+      continue;
+    std::unique_lock<std::mutex> Guard(Lock);
+    AllDone.wait(Guard, [&] { return !NumPending; });
+    return;
+  }
+}
@@ -0,0 +1,127 @@
+//===-- TraceEvents.cpp - Chrome trace events -----------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/TraceEvents.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/Compiler.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/raw_ostream.h"
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+std::atomic<bool> trace::Enabled(false);
+
+namespace {
+struct TraceEvent {
+  const char *Name;
+  std::string Detail;
+  uint64_t Addr;
+  bool HasAddr;
+  int64_t Start;
+  int64_t Duration;
+};
+
+/// \brief The events of a thread. It is only ever touched by its thread,
+/// until the events are written.
+struct ThreadTrace {
+  unsigned Tid;
+  std::vector<TraceEvent> Events;
+};
+
+/// \brief The traces of all the threads, which outlive them.
+struct TraceState {
+  std::mutex Lock;
+  std::vector<std::unique_ptr<ThreadTrace>> Threads;
+};
+} // end anonymous namespace
+
+static ManagedStatic<TraceState> State;
+static std::chrono::steady_clock::time_point TraceStart;
+static LLVM_THREAD_LOCAL ThreadTrace *CurrentThreadTrace;
+
+static ThreadTrace &getThreadTrace() {
+  if (!CurrentThreadTrace) {
+    std::lock_guard<std::mutex> L(State->Lock);
+    State->Threads.emplace_back(new ThreadTrace());
+    CurrentThreadTrace = State->Threads.back().get();
+    CurrentThreadTrace->Tid = State->Threads.size();
+  }
+  return *CurrentThreadTrace;
+}
+
+void llvm::enableTraceEvents() {
+  TraceStart = std::chrono::steady_clock::now();
+  trace::Enabled = true;
+}
+
+int64_t llvm::getTraceTime() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - TraceStart)
+      .count();
+}
+
+void llvm::recordTraceEvent(const char *Name, StringRef Detail,
+                            int64_t Start) {
+  if (!areTraceEventsEnabled())
+    return;
+  TraceEvent E = {Name, Detail, 0, false, Start, getTraceTime() - Start};
+  getThreadTrace().Events.push_back(std::move(E));
+}
+
+void TraceScope::begin() { Start = getTraceTime(); }
+
+void TraceScope::end() {
+  TraceEvent E = {Name, Detail, Addr, HasAddr, Start, getTraceTime() - Start};
+  getThreadTrace().Events.push_back(std::move(E));
+}
+
+static void writeJSONString(raw_ostream &OS, StringRef Str) {
+  OS << '"';
+  for (unsigned char C : Str) {
+    if (C == '"' || C == '\\')
+      OS << '\\' << C;
+    else if (C < 0x20)
+      OS << format("\\u%04x", C);
+    else
+      OS << C;
+  }
+  OS << '"';
+}
+
+void llvm::writeTraceEvents(raw_ostream &OS) {
+  std::lock_guard<std::mutex> L(State->Lock);
+  OS << "{\"traceEvents\": [";
+  bool First = true;
+  for (const auto &T : State->Threads) {
+    for (const TraceEvent &E : T->Events) {
+      OS << (First ? "\n  " : ",\n  ");
+      First = false;
+      OS << "{\"name\": ";
+      writeJSONString(OS, E.Name);
+      OS << ", \"ph\": \"X\", \"pid\": 1, \"tid\": " << T->Tid
+         << ", \"ts\": " << E.Start << ", \"dur\": " << E.Duration;
+      if (E.HasAddr) {
+        OS << ", \"args\": {\"function\": \"fn_" << utohexstr(E.Addr)
+           << "\"}";
+      } else if (!E.Detail.empty()) {
+        OS << ", \"args\": {\"detail\": ";
+        writeJSONString(OS, E.Detail);
+        OS << '}';
+      }
+      OS << '}';
+    }
+  }
+  OS << "\n],\n\"displayTimeUnit\": \"ms\"}\n";
+}
@@ -10,7 +10,9 @@ DCInstrSema *createAArch64DCInstrSema(StringRef TT,
                                   const MCInstrInfo &MII) {
   (void)MRI;
   (void)MII;
-  return new AArch64InstrSema(DRS);
+  DCInstrSema *DIS = new AArch64InstrSema(DRS);
+  DIS->setTargetTriple(TT);
+  return DIS;
 }
 
 DCRegisterSema *createAArch64DCRegisterSema(StringRef TT,
@@ -0,0 +1,265 @@
+//===-- AArch64ExclusiveLoops.cpp - LL/SC retry loops ---------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "AArch64ExclusiveLoops.h"
+#include "MCTargetDesc/AArch64AddressingModes.h"
+#include "MCTargetDesc/AArch64MCTargetDesc.h"
+#include "Utils/AArch64BaseInfo.h"
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCRegisterInfo.h"
+
+using namespace llvm;
+
+/// \brief Check whether \p Inst is an exclusive load. Return true if it is,
+/// and its size and whether it acquires.
+static bool getExclusiveLoad(const MCInst &Inst, unsigned &Size,
+                             bool &Acquire) {
+  Acquire = false;
+  switch (Inst.getOpcode()) {
+  case AArch64::LDAXRB: Acquire = true; // fallthrough
+  case AArch64::LDXRB:  Size = 1; return true;
+  case AArch64::LDAXRH: Acquire = true; // fallthrough
+  case AArch64::LDXRH:  Size = 2; return true;
+  case AArch64::LDAXRW: Acquire = true; // fallthrough
+  case AArch64::LDXRW:  Size = 4; return true;
+  case AArch64::LDAXRX: Acquire = true; // fallthrough
+  case AArch64::LDXRX:  Size = 8; return true;
+  default:
+    return false;
+  }
+}
+
+/// \brief Check whether \p Inst is an exclusive store. Return true if it is,
+/// and its size and whether it releases.
+static bool getExclusiveStore(const MCInst &Inst, unsigned &Size,
+                              bool &Release) {
+  Release = false;
+  switch (Inst.getOpcode()) {
+  case AArch64::STLXRB: Release = true; // fallthrough
+  case AArch64::STXRB:  Size = 1; return true;
+  case AArch64::STLXRH: Release = true; // fallthrough
+  case AArch64::STXRH:  Size = 2; return true;
+  case AArch64::STLXRW: Release = true; // fallthrough
+  case AArch64::STXRW:  Size = 4; return true;
+  case AArch64::STLXRX: Release = true; // fallthrough
+  case AArch64::STXRX:  Size = 8; return true;
+  default:
+    return false;
+  }
+}
+
+static AtomicOrdering getOrdering(bool Acquire, bool Release) {
+  if (Acquire && Release)
+    return AcquireRelease;
+  if (Acquire)
+    return llvm::Acquire;
+  return Release ? llvm::Release : Monotonic;
+}
+
+/// \brief Check whether \p I branches back to \p Start while \p StatusReg,
+/// the status of the exclusive store, says it failed.
+static bool isRetryBranch(const MCDecodedInst &I, unsigned StatusReg,
+                          uint64_t Start) {
+  const MCInst &Inst = I.Inst;
+  return Inst.getOpcode() == AArch64::CBNZW &&
+         Inst.getOperand(0).getReg() == StatusReg &&
+         I.Address + Inst.getOperand(1).getImm() * 4 == Start;
+}
+
+/// \brief Check whether \p Inst computes a register from \p LoadReg and an
+/// operand, as atomicrmw can. Return true if it does, and the operation,
+/// the operand, and the register written in \p L.
+static bool getRMWOperation(const MCInst &Inst, unsigned LoadReg,
+                            AArch64ExclusiveLoops::Loop &L) {
+  if (Inst.getNumOperands() < 3 || !Inst.getOperand(1).isReg() ||
+      Inst.getOperand(1).getReg() != LoadReg)
+    return false;
+  L.OperandReg = 0;
+  L.Imm = 0;
+  switch (Inst.getOpcode()) {
+  case AArch64::ADDWri: case AArch64::ADDXri:
+  case AArch64::SUBWri: case AArch64::SUBXri:
+    L.Op = Inst.getOpcode() == AArch64::ADDWri ||
+                   Inst.getOpcode() == AArch64::ADDXri
+               ? AtomicRMWInst::Add
+               : AtomicRMWInst::Sub;
+    L.Imm = Inst.getOperand(2).getImm()
+            << AArch64_AM::getShiftValue(Inst.getOperand(3).getImm());
+    break;
+  case AArch64::ANDWri: case AArch64::ANDXri:
+  case AArch64::ORRWri: case AArch64::ORRXri:
+  case AArch64::EORWri: case AArch64::EORXri: {
+    const unsigned Opc = Inst.getOpcode();
+    const bool Is64 = Opc == AArch64::ANDXri || Opc == AArch64::ORRXri ||
+                      Opc == AArch64::EORXri;
+    L.Op = Opc == AArch64::ANDWri || Opc == AArch64::ANDXri
+               ? AtomicRMWInst::And
+               : Opc == AArch64::ORRWri || Opc == AArch64::ORRXri
+                     ? AtomicRMWInst::Or
+                     : AtomicRMWInst::Xor;
+    L.Imm = AArch64_AM::decodeLogicalImmediate(Inst.getOperand(2).getImm(),
+                                               Is64 ? 64 : 32);
+    break;
+  }
+  case AArch64::ADDWrs: case AArch64::ADDXrs: L.Op = AtomicRMWInst::Add; break;
+  case AArch64::SUBWrs: case AArch64::SUBXrs: L.Op = AtomicRMWInst::Sub; break;
+  case AArch64::ANDWrs: case AArch64::ANDXrs: L.Op = AtomicRMWInst::And; break;
+  case AArch64::ORRWrs: case AArch64::ORRXrs: L.Op = AtomicRMWInst::Or; break;
+  case AArch64::EORWrs: case AArch64::EORXrs: L.Op = AtomicRMWInst::Xor; break;
+  default:
+    return false;
+  }
+  // The shifted register forms, without a shift.
+  if (Inst.getOperand(2).isReg()) {
+    if (Inst.getOperand(3).getImm())
+      return false;
+    L.OperandReg = Inst.getOperand(2).getReg();
+  }
+  L.StoreReg = Inst.getOperand(0).getReg();
+  return true;
+}
+
+bool AArch64ExclusiveLoops::overlap(unsigned RegA, unsigned RegB) const {
+  return MRI->isSubRegisterEq(RegA, RegB) || MRI->isSuperRegister(RegA, RegB);
+}
+
+bool AArch64ExclusiveLoops::findRMW(const MCBasicBlock &BB, Loop &L) const {
+  if (BB.size() != 3 && BB.size() != 4)
+    return false;
+  const MCDecodedInst &Load = BB.begin()[0];
+  const MCDecodedInst &Store = BB.begin()[BB.size() - 2];
+  const MCDecodedInst &Branch = BB.back();
+  unsigned StoreSize;
+  bool Acquire, Release;
+  if (!getExclusiveLoad(Load.Inst, L.Size, Acquire) ||
+      !getExclusiveStore(Store.Inst, StoreSize, Release) ||
+      StoreSize != L.Size)
+    return false;
+  L.LoadReg = Load.Inst.getOperand(0).getReg();
+  L.AddrReg = Load.Inst.getOperand(1).getReg();
+  L.StatusReg = Store.Inst.getOperand(0).getReg();
+  if (Store.Inst.getOperand(2).getReg() != L.AddrReg ||
+      !isRetryBranch(Branch, L.StatusReg, BB.getStartAddr()))
+    return false;
+
+  // Without an operation, the stored register is exchanged.
+  if (BB.size() == 3) {
+    L.Op = AtomicRMWInst::Xchg;
+    L.StoreReg = L.OperandReg = Store.Inst.getOperand(1).getReg();
+    L.Imm = 0;
+  } else if (!getRMWOperation(BB.begin()[1].Inst, L.LoadReg, L) ||
+             L.StoreReg != Store.Inst.getOperand(1).getReg()) {
+    return false;
+  }
+  // The loop writes the loaded and stored registers, and the status, but
+  // neither the address, nor the operand, that each try reads again.
+  if (overlap(L.AddrReg, L.LoadReg) || overlap(L.AddrReg, L.StoreReg) ||
+      overlap(L.AddrReg, L.StatusReg) || overlap(L.StatusReg, L.LoadReg) ||
+      overlap(L.StatusReg, L.StoreReg))
+    return false;
+  if (L.OperandReg &&
+      (overlap(L.OperandReg, L.LoadReg) ||
+       overlap(L.OperandReg, L.StatusReg) ||
+       (L.Op != AtomicRMWInst::Xchg && overlap(L.OperandReg, L.StoreReg))))
+    return false;
+
+  L.IsCmpXchg = false;
+  L.Ordering = getOrdering(Acquire, Release);
+  L.LoadAddr = Load.Address;
+  L.StoreAddr = Store.Address;
+  L.BranchAddr = Branch.Address;
+  return true;
+}
+
+bool AArch64ExclusiveLoops::findCmpXchg(const MCBasicBlock &BB,
+                                        const MCBasicBlock &StoreBB,
+                                        Loop &L) const {
+  // The store is only reached from the comparison.
+  if (BB.size() != 3 || StoreBB.size() != 2 ||
+      StoreBB.getStartAddr() != BB.getEndAddr() || StoreBB.pred_size() != 1)
+    return false;
+  const MCDecodedInst &Load = BB.begin()[0];
+  const MCInst &Cmp = BB.begin()[1].Inst;
+  const MCInst &BranchNE = BB.back().Inst;
+  const MCDecodedInst &Store = StoreBB.begin()[0];
+  const MCDecodedInst &Branch = StoreBB.back();
+  unsigned StoreSize;
+  bool Acquire, Release;
+  if (!getExclusiveLoad(Load.Inst, L.Size, Acquire) ||
+      !getExclusiveStore(Store.Inst, StoreSize, Release) ||
+      StoreSize != L.Size)
+    return false;
+  L.LoadReg = Load.Inst.getOperand(0).getReg();
+  L.AddrReg = Load.Inst.getOperand(1).getReg();
+  L.StatusReg = Store.Inst.getOperand(0).getReg();
+  L.StoreReg = Store.Inst.getOperand(1).getReg();
+  if (Store.Inst.getOperand(2).getReg() != L.AddrReg ||
+      !isRetryBranch(Branch, L.StatusReg, BB.getStartAddr()))
+    return false;
+
+  // cmp LoadReg, OperandReg; b.ne: the store is only reached if they are
+  // equal, as the cmpxchg only stores then.
+  if ((Cmp.getOpcode() != AArch64::SUBSWrs &&
+       Cmp.getOpcode() != AArch64::SUBSXrs) ||
+      (Cmp.getOperand(0).getReg() != AArch64::WZR &&
+       Cmp.getOperand(0).getReg() != AArch64::XZR) ||
+      Cmp.getOperand(1).getReg() != L.LoadReg ||
+      Cmp.getOperand(3).getImm() != 0 ||
+      BranchNE.getOpcode() != AArch64::Bcc ||
+      BranchNE.getOperand(0).getImm() != AArch64CC::NE)
+    return false;
+  L.OperandReg = Cmp.getOperand(2).getReg();
+  L.Imm = 0;
+
+  // The expected and new values are read at the load, before it writes
+  // the loaded register.
+  if (overlap(L.LoadReg, L.AddrReg) || overlap(L.LoadReg, L.OperandReg) ||
+      overlap(L.LoadReg, L.StoreReg) || overlap(L.StatusReg, L.AddrReg) ||
+      overlap(L.StatusReg, L.StoreReg))
+    return false;
+
+  L.IsCmpXchg = true;
+  L.Op = AtomicRMWInst::BAD_BINOP;
+  L.Ordering = getOrdering(Acquire, Release);
+  L.LoadAddr = Load.Address;
+  L.StoreAddr = Store.Address;
+  L.BranchAddr = Branch.Address;
+  return true;
+}
+
+void AArch64ExclusiveLoops::analyze(const MCFunction &F,
+                                    const MCRegisterInfo &MRI) {
+  clear();
+  this->MRI = &MRI;
+  for (const MCBasicBlock *BB : F) {
+    Loop L;
+    bool Found = findRMW(*BB, L);
+    for (auto SI = BB->succ_begin(), SE = BB->succ_end(); !Found && SI != SE;
+         ++SI)
+      Found = findCmpXchg(*BB, **SI, L);
+    if (!Found)
+      continue;
+    InstLoops[L.LoadAddr] = Loops.size();
+    InstLoops[L.StoreAddr] = Loops.size();
+    InstLoops[L.BranchAddr] = Loops.size();
+    Loops.push_back(L);
+  }
+}
+
+const AArch64ExclusiveLoops::Loop *
+AArch64ExclusiveLoops::lookup(uint64_t Addr, InstKind &Kind) const {
+  auto I = InstLoops.find(Addr);
+  if (I == InstLoops.end()) {
+    Kind = None;
+    return nullptr;
+  }
+  const Loop &L = Loops[I->second];
+  Kind = Addr == L.LoadAddr ? Load : Addr == L.StoreAddr ? Store : Branch;
+  return &L;
+}
@@ -0,0 +1,97 @@
+//===-- AArch64ExclusiveLoops.h - LL/SC retry loops -------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares AArch64ExclusiveLoops, the load-exclusive/store-exclusive
+// retry loops of an MCFunction that compilers emit for the atomic operations,
+// so that AArch64InstrSema translates each one to a single atomicrmw or
+// cmpxchg.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIB_TARGET_AARCH64_DC_AARCH64EXCLUSIVELOOPS_H
+#define LLVM_LIB_TARGET_AARCH64_DC_AARCH64EXCLUSIVELOOPS_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/IR/Instructions.h"
+#include <vector>
+
+namespace llvm {
+
+class MCBasicBlock;
+class MCFunction;
+class MCRegisterInfo;
+
+/// \brief The exclusive loops of a function, of two shapes:
+///   - a read-modify-write, in a single block:
+///       loop: ldxr  x8, [x0]
+///             add   x9, x8, #1      (or sub, and, orr, eor, or nothing)
+///             stxr  w10, x9, [x0]
+///             cbnz  w10, loop
+///     translated to an atomicrmw at the load;
+///   - a compare and swap, in two blocks:
+///       loop: ldaxr x8, [x0]
+///             cmp   x8, x1
+///             b.ne  fail
+///             stlxr w10, x2, [x0]
+///             cbnz  w10, loop
+///     translated to a cmpxchg at the load, the comparison and its branch
+///     left as they are.
+/// The store then only clears its status register, and the branch back to
+/// the load falls through instead: the loop is gone.
+class AArch64ExclusiveLoops {
+public:
+  struct Loop {
+    bool IsCmpXchg;
+    /// \brief The operation of a read-modify-write.
+    AtomicRMWInst::BinOp Op;
+    /// \brief The size of the memory access, in bytes.
+    unsigned Size;
+    AtomicOrdering Ordering;
+    unsigned AddrReg;
+    /// \brief The register loaded, the one stored, and the one the store
+    /// writes its status to.
+    unsigned LoadReg, StoreReg, StatusReg;
+    /// \brief The operand of a read-modify-write, a register, or \p Imm if
+    /// 0, or the register of the value a compare and swap expects.
+    unsigned OperandReg;
+    uint64_t Imm;
+    /// \brief The addresses of the load, of the store, and of the branch
+    /// back to the load.
+    uint64_t LoadAddr, StoreAddr, BranchAddr;
+  };
+
+  enum InstKind { None, Load, Store, Branch };
+
+private:
+  const MCRegisterInfo *MRI;
+  std::vector<Loop> Loops;
+  DenseMap<uint64_t, unsigned> InstLoops;
+
+  bool overlap(unsigned RegA, unsigned RegB) const;
+  bool findRMW(const MCBasicBlock &BB, Loop &L) const;
+  bool findCmpXchg(const MCBasicBlock &BB, const MCBasicBlock &StoreBB,
+                   Loop &L) const;
+
+public:
+  AArch64ExclusiveLoops() : MRI(nullptr) {}
+
+  void analyze(const MCFunction &F, const MCRegisterInfo &MRI);
+  void clear() {
+    Loops.clear();
+    InstLoops.clear();
+  }
+
+  /// \brief Get the loop the instruction at \p Addr is the load, the store
+  /// or the branch of, in \p Kind, or null.
+  const Loop *lookup(uint64_t Addr, InstKind &Kind) const;
+};
+
+} // end namespace llvm
+
+#endif
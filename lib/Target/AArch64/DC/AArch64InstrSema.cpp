@@ -4,6 +4,7 @@
 #include "MCTargetDesc/AArch64MCTargetDesc.h"
 #include "llvm/ADT/APInt.h"
 #include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringSwitch.h"
 #include "llvm/CodeGen/ISDOpcodes.h"
 #include "llvm/CodeGen/ValueTypes.h"
 #include "llvm/IR/BasicBlock.h"
@@ -20,6 +21,7 @@
 #include "llvm/IR/TypeBuilder.h"
 #include "AArch64GenSema.inc"
 #include "MCTargetDesc/AArch64AddressingModes.h"
+#include "llvm/MC/MCInstrInfo.h"
 #include "llvm/Support/Debug.h"
 
 #define DEBUG_TYPE "dc-sema"
@@ -36,37 +38,665 @@ int64_t getOnes(int64_t Num) {
     return O;
 }
 
-namespace llvm {
-    namespace AArch64 {
-        enum NZCVShift {
-            N = 31,
-            Z = 30,
-            C = 29,
-            V = 28,
-        };
+// Parse a NEON arrangement suffix, such as "v16b" or "v1d".
+static bool parseArrangement(StringRef Name, unsigned &NumElts,
+                             unsigned &EltBits) {
+    if (!Name.startswith("v") || Name.size() < 3)
+        return false;
+    switch (Name.back()) {
+        default: return false;
+        case 'b': EltBits = 8; break;
+        case 'h': EltBits = 16; break;
+        case 's': EltBits = 32; break;
+        case 'd': EltBits = 64; break;
+    }
+    if (Name.substr(1, Name.size() - 2).getAsInteger(10, NumElts))
+        return false;
+    return NumElts * EltBits == 64 || NumElts * EltBits == 128;
+}
+
+// Describe the NEON structure load/store \p Name, if it is one that
+// translateLdSt handles:
+//   [LD|ST]<N>[One|Two|Three|Four]v<arrangement>[_POST]
+//   [LD|ST]<N>i<element size>[_POST]
+//   LD<N>Rv<arrangement>[_POST]
+static AArch64InstrSema::LdStDesc getLdStDesc(StringRef Name) {
+    typedef AArch64InstrSema::LdStDesc LdStDesc;
+    LdStDesc D = LdStDesc();
+    if (!(Name.startswith("LD") || Name.startswith("ST")) || Name.size() < 4 ||
+        Name[2] < '1' || Name[2] > '4')
+        return D;
+    bool IsLoad = Name[0] == 'L';
+    unsigned N = Name[2] - '0';
+    StringRef Rest = Name.substr(3);
+    bool IsPost = Rest.endswith("_POST");
+    if (IsPost)
+        Rest = Rest.drop_back(5);
+
+    unsigned NumElts = 0, EltBits = 0;
+    LdStDesc::KindTy Kind = LdStDesc::None;
+    unsigned NumVectors = N;
+    if (Rest.startswith("Rv")) {
+        // Load and replicate to all lanes.
+        if (!IsLoad || !parseArrangement(Rest.substr(1), NumElts, EltBits))
+            return D;
+        Kind = LdStDesc::Replicate;
+    } else if (Rest.startswith("i")) {
+        // Single lane.
+        if (Rest.substr(1).getAsInteger(10, EltBits) ||
+            (EltBits != 8 && EltBits != 16 && EltBits != 32 && EltBits != 64))
+            return D;
+        NumElts = 128 / EltBits;
+        Kind = LdStDesc::Lane;
+    } else {
+        // Multiple structures: the number of registers follows the
+        // interleaving factor, except for LD1/ST1.
+        size_t VPos = Rest.find('v');
+        if (VPos == StringRef::npos)
+            return D;
+        NumVectors = StringSwitch<unsigned>(Rest.substr(0, VPos))
+                         .Case("One", 1)
+                         .Case("Two", 2)
+                         .Case("Three", 3)
+                         .Case("Four", 4)
+                         .Default(0);
+        if (!NumVectors || (N != 1 && N != NumVectors) ||
+            !parseArrangement(Rest.substr(VPos), NumElts, EltBits))
+            return D;
+        Kind = LdStDesc::Multiple;
+    }
+    D.Kind = Kind;
+    D.IsLoad = IsLoad;
+    D.IsPost = IsPost;
+    D.Interleaved = Kind == LdStDesc::Multiple && N != 1;
+    D.NumVectors = NumVectors;
+    D.NumElements = NumElts;
+    D.ElemBits = EltBits;
+    return D;
+}
+
+// Describe the Q or D register pair load/store \p Opcode, if it is one that
+// translateVectorPair handles.
+static bool getVectorPair(unsigned Opcode, AArch64InstrSema::VectorPair &P) {
+    typedef AArch64InstrSema::VectorPair VectorPair;
+    P.IsLoad = false;
+    P.Index = VectorPair::Offset;
+    switch (Opcode) {
+        default:
+            return false;
+        case AArch64::LDPQi: case AArch64::LDNPQi:
+            P.IsLoad = true; P.RegBytes = 16; break;
+        case AArch64::LDPQpre:
+            P.IsLoad = true; P.RegBytes = 16; P.Index = VectorPair::Pre; break;
+        case AArch64::LDPQpost:
+            P.IsLoad = true; P.RegBytes = 16; P.Index = VectorPair::Post; break;
+        case AArch64::STPQi: case AArch64::STNPQi:
+            P.RegBytes = 16; break;
+        case AArch64::STPQpre:
+            P.RegBytes = 16; P.Index = VectorPair::Pre; break;
+        case AArch64::STPQpost:
+            P.RegBytes = 16; P.Index = VectorPair::Post; break;
+        case AArch64::LDPDi: case AArch64::LDNPDi:
+            P.IsLoad = true; P.RegBytes = 8; break;
+        case AArch64::LDPDpre:
+            P.IsLoad = true; P.RegBytes = 8; P.Index = VectorPair::Pre; break;
+        case AArch64::LDPDpost:
+            P.IsLoad = true; P.RegBytes = 8; P.Index = VectorPair::Post; break;
+        case AArch64::STPDi: case AArch64::STNPDi:
+            P.RegBytes = 8; break;
+        case AArch64::STPDpre:
+            P.RegBytes = 8; P.Index = VectorPair::Pre; break;
+        case AArch64::STPDpost:
+            P.RegBytes = 8; P.Index = VectorPair::Post; break;
     }
+    return true;
 }
 
 AArch64InstrSema::AArch64InstrSema(DCRegisterSema &DRS) :
         DCInstrSema(AArch64::OpcodeToSemaIdx, AArch64::InstSemantics, AArch64::ConstantArray,
-                    DRS) {
+                    AArch64::SemanticsHash, DRS), AArch64DRS(static_cast<AArch64RegisterSema &>(DRS)),
+        LdStDescs(DRS.MII.getNumOpcodes()), MergedPair(nullptr),
+        LogicalImmsCtx(nullptr) {
+    for (unsigned Op = 0, E = DRS.MII.getNumOpcodes(); Op != E; ++Op)
+        LdStDescs[Op] = getLdStDesc(DRS.MII.getName(Op));
+
+    // Fold the ADRP + ADD/LDR pairs into the addresses they compute.
+    FoldConstants = true;
+
+    // Hints (NOP, YIELD, WFE, ...), prefetches, barriers and exclusive monitor
+    // clears have no effect on the translated program.
+    // Nor do the pointer authentication code additions, as PACIASP, a hint:
+    // the translation doesn't sign pointers.
+    static const unsigned Nops[] = {
+        AArch64::HINT,   AArch64::PRFMl,   AArch64::PRFMroW, AArch64::PRFMroX,
+        AArch64::PRFMui, AArch64::PRFUMi,  AArch64::DMB,     AArch64::DSB,
+        AArch64::ISB,    AArch64::CLREX,   AArch64::PACIA,   AArch64::PACIB,
+        AArch64::PACDA,  AArch64::PACDB,   AArch64::PACIZA,  AArch64::PACIZB,
+        AArch64::PACDZA, AArch64::PACDZB};
+    for (unsigned Op : Nops)
+        NopOpcodes.set(Op);
+}
+
+bool AArch64InstrSema::translateLdSt(const LdStDesc &D) {
+    const MCInst &Inst = CurrentInst->Inst;
+    // Post-indexed forms first define the updated base register, and end with
+    // the offset register, XZR for an immediate offset of the access size.
+    // Lane loads also have the tied input vector list.
+    unsigned VecRegNo = Inst.getOperand(D.IsPost ? 1 : 0).getReg();
+    unsigned NextOp = (D.IsPost ? 2 : 1);
+    unsigned LaneIdx = 0;
+    if (D.Kind == LdStDesc::Lane) {
+        NextOp += D.IsLoad;
+        LaneIdx = Inst.getOperand(NextOp++).getImm();
+    }
+    unsigned BaseRegNo = Inst.getOperand(NextOp).getReg();
+    Value *Base = getReg(BaseRegNo);
+
+    Type *EltTy = Builder->getIntNTy(D.ElemBits);
+    unsigned AccessBits = 0;
+    switch (D.Kind) {
+        default:
+            llvm_unreachable("Not a structure load/store!");
+        case LdStDesc::Multiple: {
+            AccessBits = D.NumVectors * D.NumElements * D.ElemBits;
+            Type *Ty = Builder->getIntNTy(AccessBits);
+            Value *Addr = getGuestPtr(Base, Ty->getPointerTo());
+            if (!D.Interleaved) {
+                if (D.IsLoad)
+                    setReg(VecRegNo, Builder->CreateLoad(Addr));
+                else
+                    Builder->CreateStore(getReg(VecRegNo), Addr);
+                break;
+            }
+            // LD2-LD4/ST2-ST4: element j of register r is at j * N + r in
+            // memory, a single shuffle away from (or to) r * NumElements + j.
+            unsigned N = D.NumVectors, NE = D.NumElements;
+            Type *VecTy = VectorType::get(EltTy, N * NE);
+            SmallVector<int, 64> Mask(N * NE);
+            for (unsigned k = 0; k != N * NE; ++k)
+                Mask[k] = D.IsLoad ? (k % NE) * N + k / NE : (k % N) * NE + k / N;
+            Value *V = D.IsLoad ? Builder->CreateLoad(Addr) : getReg(VecRegNo);
+            V = Builder->CreateBitCast(V, VecTy);
+            V = Builder->CreateShuffleVector(V, UndefValue::get(VecTy), Mask);
+            V = Builder->CreateBitCast(V, Ty);
+            if (D.IsLoad)
+                setReg(VecRegNo, V);
+            else
+                Builder->CreateStore(V, Addr);
+            break;
+        }
+        case LdStDesc::Lane: {
+            // Lane LaneIdx of each of the NumVectors registers, in memory as a
+            // <NumVectors x EltTy> vector.
+            unsigned N = D.NumVectors, NE = D.NumElements;
+            AccessBits = N * D.ElemBits;
+            Type *MemTy = VectorType::get(EltTy, N);
+            Type *RegsTy = VectorType::get(EltTy, N * NE);
+            Value *Addr = getGuestPtr(Base, MemTy->getPointerTo());
+            Value *Regs = getReg(VecRegNo);
+            Type *RegsIntTy = Regs->getType();
+            Regs = Builder->CreateBitCast(Regs, RegsTy);
+            if (D.IsLoad) {
+                // Widen the loaded elements to the registers' width, and
+                // blend them in.
+                Value *Mem = Builder->CreateLoad(Addr);
+                SmallVector<int, 64> WidenMask(N * NE), BlendMask(N * NE);
+                for (unsigned k = 0; k != N * NE; ++k) {
+                    WidenMask[k] = k % N;
+                    BlendMask[k] = k % NE == LaneIdx ? N * NE + k / NE : k;
+                }
+                Mem = Builder->CreateShuffleVector(Mem, UndefValue::get(MemTy),
+                                                   WidenMask);
+                Regs = Builder->CreateShuffleVector(Regs, Mem, BlendMask);
+                setReg(VecRegNo, Builder->CreateBitCast(Regs, RegsIntTy));
+            } else {
+                SmallVector<int, 4> Mask(N);
+                for (unsigned i = 0; i != N; ++i)
+                    Mask[i] = i * NE + LaneIdx;
+                Builder->CreateStore(
+                    Builder->CreateShuffleVector(Regs, UndefValue::get(RegsTy),
+                                                 Mask),
+                    Addr);
+            }
+            break;
+        }
+        case LdStDesc::Replicate: {
+            // Load NumVectors elements, and broadcast each to its register.
+            unsigned N = D.NumVectors, NE = D.NumElements;
+            AccessBits = N * D.ElemBits;
+            Type *MemTy = VectorType::get(EltTy, N);
+            Value *Addr = getGuestPtr(Base, MemTy->getPointerTo());
+            Value *Mem = Builder->CreateLoad(Addr);
+            SmallVector<int, 64> Mask(N * NE);
+            for (unsigned k = 0; k != N * NE; ++k)
+                Mask[k] = k / NE;
+            Value *Regs =
+                Builder->CreateShuffleVector(Mem, UndefValue::get(MemTy), Mask);
+            setReg(VecRegNo, Builder->CreateBitCast(
+                                 Regs, Builder->getIntNTy(N * NE * D.ElemBits)));
+            break;
+        }
+    }
 
+    if (D.IsPost) {
+        unsigned OffsetRegNo = Inst.getOperand(Inst.getNumOperands() - 1).getReg();
+        Value *Offset = OffsetRegNo == AArch64::XZR
+                            ? Builder->getInt64(AccessBits / 8)
+                            : getReg(OffsetRegNo);
+        setReg(Inst.getOperand(0).getReg(), Builder->CreateAdd(Base, Offset));
+    }
+    return true;
+}
+
+bool AArch64InstrSema::translateVectorPair() {
+    VectorPair P;
+    if (!getVectorPair(CurrentInst->Inst.getOpcode(), P))
+        return false;
+    // The second of two merged pairs was translated with the first.
+    if (CurrentInst == MergedPair) {
+        MergedPair = nullptr;
+        return true;
+    }
+
+    // The pre- and post-indexed forms first define the updated base register.
+    const MCInst &Inst = CurrentInst->Inst;
+    const unsigned RegOp = P.Index == VectorPair::Offset ? 0 : 1;
+    SmallVector<unsigned, 4> Regs;
+    Regs.push_back(Inst.getOperand(RegOp).getReg());
+    Regs.push_back(Inst.getOperand(RegOp + 1).getReg());
+    const unsigned BaseRegNo = Inst.getOperand(RegOp + 2).getReg();
+    const int64_t Imm = Inst.getOperand(RegOp + 3).getImm();
+
+    // The next instruction of the block, if it is the same pair from the
+    // same base, right after this one in memory, is a single wider access:
+    //   ldp q0, q1, [x1]             ldp q0, q1, [x1]
+    //   ldp q2, q3, [x1, #32]   =>   (one <8 x i64> load)
+    // unless it is translated otherwise, as a spill or a memory transfer.
+    const MCDecodedInst *Next = CurrentInst + 1;
+    if (P.Index == VectorPair::Offset && TheMCBB &&
+        CurrentInst >= TheMCBB->begin() && Next < TheMCBB->end() &&
+        Next->Inst.getOpcode() == Inst.getOpcode() &&
+        Next->Inst.getOperand(2).getReg() == BaseRegNo &&
+        Next->Inst.getOperand(3).getImm() == Imm + 2 &&
+        !CalleeSavedSpills.isSpill(Next->Address) &&
+        !MemoryTransfers.lookup(Next->Address)) {
+        Regs.push_back(Next->Inst.getOperand(0).getReg());
+        Regs.push_back(Next->Inst.getOperand(1).getReg());
+        MergedPair = Next;
+    }
+
+    Value *Base = getReg(BaseRegNo);
+    Value *Offset = Builder->getInt64(Imm * P.RegBytes);
+    Value *Addr = Base;
+    if (Imm && P.Index != VectorPair::Post)
+        Addr = Builder->CreateAdd(Base, Offset);
+
+    // The registers are the i64 elements of a single vector, one for each D
+    // register, two for each Q register.
+    const unsigned RegElts = P.RegBytes / 8;
+    Type *I64Ty = Builder->getInt64Ty();
+    Type *VecTy = VectorType::get(I64Ty, Regs.size() * RegElts);
+    Value *Ptr = getGuestPtr(Addr, VecTy->getPointerTo());
+    if (P.IsLoad) {
+        Value *V = Builder->CreateAlignedLoad(Ptr, 1);
+        for (unsigned I = 0, E = Regs.size(); I != E; ++I) {
+            if (RegElts == 1) {
+                setReg(Regs[I], Builder->CreateExtractElement(
+                                    V, Builder->getInt32(I)));
+                continue;
+            }
+            const int Mask[] = {int(2 * I), int(2 * I + 1)};
+            setReg(Regs[I],
+                   Builder->CreateBitCast(
+                       Builder->CreateShuffleVector(V, UndefValue::get(VecTy),
+                                                    Mask),
+                       Builder->getInt128Ty()));
+        }
+    } else {
+        // Concatenate the registers, two vectors at a time.
+        SmallVector<Value *, 4> Parts;
+        for (unsigned Reg : Regs)
+            Parts.push_back(Builder->CreateBitCast(
+                getReg(Reg), VectorType::get(I64Ty, RegElts)));
+        while (Parts.size() > 1) {
+            const unsigned PartElts = Parts[0]->getType()->getVectorNumElements();
+            SmallVector<int, 8> Mask(2 * PartElts);
+            for (unsigned k = 0; k != Mask.size(); ++k)
+                Mask[k] = k;
+            for (unsigned I = 0, E = Parts.size() / 2; I != E; ++I)
+                Parts[I] = Builder->CreateShuffleVector(Parts[2 * I],
+                                                        Parts[2 * I + 1], Mask);
+            Parts.resize(Parts.size() / 2);
+        }
+        Builder->CreateAlignedStore(Parts[0], Ptr, 1);
+    }
+
+    if (P.Index == VectorPair::Pre)
+        setReg(Inst.getOperand(0).getReg(), Addr);
+    else if (P.Index == VectorPair::Post)
+        setReg(Inst.getOperand(0).getReg(), Builder->CreateAdd(Base, Offset));
+    return true;
+}
+
+void AArch64InstrSema::translateTableLookup() {
+    const MCInst &Inst = CurrentInst->Inst;
+    unsigned Opcode = Inst.getOpcode();
+    StringRef Name = DRS.MII.getName(Opcode);
+    bool IsTBX = Name.startswith("TBX");
+    unsigned NumElts = Name.startswith("TBLv8i8") || Name.startswith("TBXv8i8")
+                           ? 8 : 16;
+    unsigned NumTables = StringSwitch<unsigned>(Name.substr(Name.find("i8") + 2))
+                             .Case("One", 1)
+                             .Case("Two", 2)
+                             .Case("Three", 3)
+                             .Case("Four", 4)
+                             .Default(0);
+    assert(NumTables && "Unknown table lookup instruction!");
+
+    // TBX has the tied destination as its first input.
+    unsigned DstRegNo = Inst.getOperand(0).getReg();
+    unsigned FirstOp = IsTBX ? 2 : 1;
+    Type *ByteTy = Builder->getInt8Ty();
+    Type *ResTy = VectorType::get(ByteTy, NumElts);
+    Type *TableTy = VectorType::get(ByteTy, 16);
+    Type *TablesTy = VectorType::get(ByteTy, 16 * NumTables);
+
+    // The table registers are a single register list: split it in 16-byte
+    // vectors.
+    Value *Tables = Builder->CreateBitCast(
+        getReg(Inst.getOperand(FirstOp).getReg()), TablesTy);
+    Value *Indices = Builder->CreateBitCast(
+        getReg(Inst.getOperand(FirstOp + 1).getReg()), ResTy);
+
+    SmallVector<Value *, 6> Args;
+    Type *DstIntTy = DRS.getRegType(DstRegNo);
+    if (IsTBX)
+        Args.push_back(Builder->CreateBitCast(
+            Builder->CreateZExtOrTrunc(getReg(DstRegNo),
+                                       Builder->getIntNTy(NumElts * 8)),
+            ResTy));
+    for (unsigned T = 0; T != NumTables; ++T) {
+        SmallVector<int, 16> Mask(16);
+        for (unsigned i = 0; i != 16; ++i)
+            Mask[i] = T * 16 + i;
+        Args.push_back(NumTables == 1 ? Tables : Builder->CreateShuffleVector(
+            Tables, UndefValue::get(TablesTy), Mask));
+    }
+    Args.push_back(Indices);
+
+    static const Intrinsic::ID TBLIntrinsics[] = {
+        Intrinsic::aarch64_neon_tbl1, Intrinsic::aarch64_neon_tbl2,
+        Intrinsic::aarch64_neon_tbl3, Intrinsic::aarch64_neon_tbl4};
+    static const Intrinsic::ID TBXIntrinsics[] = {
+        Intrinsic::aarch64_neon_tbx1, Intrinsic::aarch64_neon_tbx2,
+        Intrinsic::aarch64_neon_tbx3, Intrinsic::aarch64_neon_tbx4};
+    Intrinsic::ID IID = (IsTBX ? TBXIntrinsics : TBLIntrinsics)[NumTables - 1];
+    Value *Res = Builder->CreateCall(
+        Intrinsic::getDeclaration(TheModule, IID, ResTy), Args);
+    Res = Builder->CreateBitCast(Res, Builder->getIntNTy(NumElts * 8));
+    setReg(DstRegNo, Builder->CreateZExtOrTrunc(Res, DstIntTy));
+}
+
+bool AArch64InstrSema::getObjCMessageRegs(unsigned &ReceiverReg,
+                                           unsigned &SelectorReg) const {
+    ReceiverReg = AArch64::X0;
+    SelectorReg = AArch64::X1;
+    return true;
+}
+
+bool AArch64InstrSema::getObjCARCRegs(unsigned &Arg0Reg, unsigned &Arg1Reg,
+                                      unsigned &ResultReg) const {
+    Arg0Reg = AArch64::X0;
+    Arg1Reg = AArch64::X1;
+    ResultReg = AArch64::X0;
+    return true;
+}
+
+static const unsigned AArch64IntArgRegs[] = {
+    AArch64::X0, AArch64::X1, AArch64::X2, AArch64::X3,
+    AArch64::X4, AArch64::X5, AArch64::X6, AArch64::X7};
+static const unsigned AArch64FPArgRegs[] = {
+    AArch64::Q0, AArch64::Q1, AArch64::Q2, AArch64::Q3,
+    AArch64::Q4, AArch64::Q5, AArch64::Q6, AArch64::Q7};
+
+bool AArch64InstrSema::getExternalCallRegs(ExternalCallRegs &Regs) const {
+    Regs.IntArgRegs = AArch64IntArgRegs;
+    Regs.FPArgRegs = AArch64FPArgRegs;
+    Regs.IntResultReg = AArch64::X0;
+    Regs.FPResultReg = AArch64::Q0;
+    // bl leaves the stack alone.
+    Regs.StackPtrReg = AArch64::SP;
+    Regs.ReturnAddrSize = 0;
+    return true;
+}
+
+// Get the size of the ivar loads and stores of the accessors, or 0.
+static unsigned getAccessorMemSize(unsigned Opcode, bool &IsStore) {
+    IsStore = false;
+    switch (Opcode) {
+    case AArch64::LDRXui: return 8;
+    case AArch64::LDRWui: return 4;
+    case AArch64::LDRHHui: return 2;
+    case AArch64::LDRBBui: return 1;
+    }
+    IsStore = true;
+    switch (Opcode) {
+    case AArch64::STRXui: return 8;
+    case AArch64::STRWui: return 4;
+    case AArch64::STRHHui: return 2;
+    case AArch64::STRBBui: return 1;
+    }
+    return 0;
+}
+
+bool AArch64InstrSema::matchObjCAccessor(const MCFunction &MCFN,
+                                         DCObjCAccessor &A) const {
+    if (MCFN.size() != 1)
+        return false;
+    const MCBasicBlock &BB = *MCFN.getEntryBlock();
+    if (BB.size() < 2 || BB.size() > 3)
+        return false;
+    const MCDecodedInst &Last = BB.back();
+    A.RuntimeFn = StringRef();
+    if (Last.Inst.getOpcode() == AArch64::B) {
+        if (!StubTargets)
+            return false;
+        auto EI = StubTargets->ExternalNames.find(
+            Last.Address + Last.Inst.getOperand(0).getImm() * 4);
+        if (EI == StubTargets->ExternalNames.end())
+            return false;
+        A.RuntimeFn = EI->second;
+    } else if (Last.Inst.getOpcode() != AArch64::RET ||
+               Last.Inst.getOperand(0).getReg() != AArch64::LR) {
+        return false;
+    }
+
+    // The strong setters pass the address of the ivar and the value on:
+    //   add x0, x0, #off ; mov x1, x2   (in either order)
+    if (BB.size() == 3) {
+        if (A.RuntimeFn != "objc_storeStrong")
+            return false;
+        A.IsSetter = true;
+        A.Size = 8;
+        bool HasAdd = false, HasMove = false;
+        for (unsigned I = 0; I != 2; ++I) {
+            const MCInst &Inst = BB.begin()[I].Inst;
+            if (Inst.getOpcode() == AArch64::ADDXri &&
+                Inst.getOperand(0).getReg() == AArch64::X0 &&
+                Inst.getOperand(1).getReg() == AArch64::X0 &&
+                AArch64_AM::getShiftValue(Inst.getOperand(3).getImm()) == 0) {
+                HasAdd = true;
+                A.Offset = Inst.getOperand(2).getImm();
+            } else if (Inst.getOpcode() == AArch64::ORRXrs &&
+                       Inst.getOperand(0).getReg() == AArch64::X1 &&
+                       Inst.getOperand(1).getReg() == AArch64::XZR &&
+                       Inst.getOperand(2).getReg() == AArch64::X2 &&
+                       Inst.getOperand(3).getImm() == 0) {
+                HasMove = true;
+            }
+        }
+        return HasAdd && HasMove;
+    }
+
+    // The others load into the result, or store the value, at an offset
+    // from self.
+    const MCInst &Inst = BB.begin()->Inst;
+    A.Size = getAccessorMemSize(Inst.getOpcode(), A.IsSetter);
+    if (!A.Size || Inst.getOperand(1).getReg() != AArch64::X0)
+        return false;
+    const unsigned Reg = Inst.getOperand(0).getReg();
+    const unsigned ValueReg = A.IsSetter ? AArch64::X2 : AArch64::X0;
+    if (Reg != ValueReg && Reg != getWRegFromXReg(ValueReg))
+        return false;
+    A.Offset = Inst.getOperand(2).getImm() * A.Size;
+    // Only the getters of objects go through the runtime.
+    return A.RuntimeFn.empty() ||
+           (!A.IsSetter && A.Size == 8 &&
+            A.RuntimeFn == "objc_retainAutoreleaseReturnValue");
+}
+
+bool AArch64InstrSema::isNZCVLiveOut(const MCBasicBlock &MCBB) const {
+    // The blocks without known successors, e.g. returns and indirect
+    // branches, leave the flags to code we don't see.
+    if (MCBB.succ_begin() == MCBB.succ_end())
+        return true;
+    for (const MCBasicBlock *Succ :
+         make_range(MCBB.succ_begin(), MCBB.succ_end())) {
+        bool Written = false;
+        for (const MCDecodedInst &DI : *Succ) {
+            const MCInstrDesc &Desc = DRS.MII.get(DI.Inst.getOpcode());
+            // MRS can read NZCV as a system register.
+            if (Desc.hasImplicitUseOfPhysReg(AArch64::NZCV) ||
+                DI.Inst.getOpcode() == AArch64::MRS)
+                return true;
+            if (Desc.hasImplicitDefOfPhysReg(AArch64::NZCV)) {
+                Written = true;
+                break;
+            }
+        }
+        if (!Written)
+            return true;
+    }
+    return false;
+}
+
+void AArch64InstrSema::analyzeTargetFunction(const MCFunction &MCFN) {
+    ExclusiveLoops.clear();
+    if (translatesAtomicLoops())
+        ExclusiveLoops.analyze(MCFN, DRS.MRI);
+}
+
+bool AArch64InstrSema::translateExclusiveLoopInst() {
+    typedef AArch64ExclusiveLoops::Loop Loop;
+    AArch64ExclusiveLoops::InstKind Kind;
+    const Loop *L = ExclusiveLoops.lookup(CurrentInst->Address, Kind);
+    if (!L)
+        return false;
+    switch (Kind) {
+    case AArch64ExclusiveLoops::Load: {
+        // The whole loop is done here: the loaded register gets the old
+        // value, that the operation, or the comparison, then read.
+        Type *MemTy = Builder->getIntNTy(L->Size * 8);
+        Value *Ptr = getGuestPtr(getReg(L->AddrReg), MemTy->getPointerTo());
+        Value *Old;
+        if (L->IsCmpXchg) {
+            Value *Expected =
+                Builder->CreateTrunc(getReg(L->OperandReg), MemTy);
+            Value *New = Builder->CreateTrunc(getReg(L->StoreReg), MemTy);
+            Old = Builder->CreateExtractValue(
+                Builder->CreateAtomicCmpXchg(
+                    Ptr, Expected, New, L->Ordering,
+                    AtomicCmpXchgInst::getStrongestFailureOrdering(
+                        L->Ordering)),
+                0);
+        } else {
+            Value *Operand =
+                L->OperandReg
+                    ? Builder->CreateTrunc(getReg(L->OperandReg), MemTy)
+                    : ConstantInt::get(MemTy, L->Imm);
+            Old = Builder->CreateAtomicRMW(L->Op, Ptr, Operand, L->Ordering);
+        }
+        setReg(L->LoadReg,
+               Builder->CreateZExt(Old, DRS.getRegType(L->LoadReg)));
+        return true;
+    }
+    case AArch64ExclusiveLoops::Store:
+        // The store was done at the load, and succeeded.
+        setReg(L->StatusReg,
+               ConstantInt::get(DRS.getRegType(L->StatusReg), 0));
+        return true;
+    case AArch64ExclusiveLoops::Branch:
+        Builder->CreateBr(
+            getOrCreateBasicBlock(CurrentInst->Address + CurrentInst->Size));
+        return true;
+    case AArch64ExclusiveLoops::None:
+        break;
+    }
+    return false;
 }
 
 bool AArch64InstrSema::translateTargetInst() {
-    printInstruction();
+    DEBUG(printInstruction());
     unsigned Opcode = CurrentInst->Inst.getOpcode();
-    //errs() << "[+]CurrentInst->Inst: " << "\n";
 
-    switch (Opcode) {
+    // At the start of each block, find out whether the flags left pending at
+    // its end need to be materialized.
+    if (TheMCBB && CurrentInst == TheMCBB->begin())
+        AArch64DRS.setNZCVLiveOut(isNZCVLiveOut(*TheMCBB));
+
+    if (translateExclusiveLoopInst())
+        return true;
 
-      //due to the size of this cases they were moved to a separate file
-#include "LD_ST_cases.h"
+    // NEON structure loads and stores are described by LdStDescs.
+    const LdStDesc &LdSt = LdStDescs[Opcode];
+    if (LdSt.Kind != LdStDesc::None)
+        return translateLdSt(LdSt);
+    if (translateVectorPair())
+        return true;
+
+    switch (Opcode) {
 
-        case AArch64::RET: {
+        case AArch64::RET:
+        case AArch64::RETAA:
+        case AArch64::RETAB: {
             Builder->CreateBr(ExitBB);
             return true;
         }
+        // The translation doesn't sign pointers (PAC* are nops): the
+        // pointer authentication branches, and authentications, only strip
+        // the code of the pointers signed outside of it.
+        case AArch64::BRAA:
+        case AArch64::BRAB:
+        case AArch64::BRAAZ:
+        case AArch64::BRABZ: {
+            insertIndirectBr(stripPointerAuth(getReg(getRegOp(0)), false));
+            return true;
+        }
+        case AArch64::BLRAA:
+        case AArch64::BLRAB:
+        case AArch64::BLRAAZ:
+        case AArch64::BLRABZ: {
+            insertCall(stripPointerAuth(getReg(getRegOp(0)), false));
+            return true;
+        }
+        case AArch64::AUTIA:
+        case AArch64::AUTIB:
+        case AArch64::AUTIZA:
+        case AArch64::AUTIZB:
+        case AArch64::XPACI:
+        case AArch64::AUTDA:
+        case AArch64::AUTDB:
+        case AArch64::AUTDZA:
+        case AArch64::AUTDZB:
+        case AArch64::XPACD: {
+            const bool IsData =
+                Opcode == AArch64::AUTDA || Opcode == AArch64::AUTDB ||
+                Opcode == AArch64::AUTDZA || Opcode == AArch64::AUTDZB ||
+                Opcode == AArch64::XPACD;
+            unsigned Rd = getRegOp(0);
+            setReg(Rd, stripPointerAuth(getReg(Rd), IsData));
+            return true;
+        }
         case AArch64::UBFMXri:
         case AArch64::UBFMWri:
         case AArch64::BFMWri:
@@ -190,17 +820,6 @@ bool AArch64InstrSema::translateTargetInst() {
             setReg(CurrentInst->Inst.getOperand(0).getReg(), Builder->CreateBitCast(res, Builder->getInt64Ty()));
             return true;
         }
-            //Prefetch instructions are not handled (which is valid)
-        case AArch64::PRFMl:
-        case AArch64::PRFMroW:
-        case AArch64::PRFMroX:
-        case AArch64::PRFMui:
-        case AArch64::PRFUMi: {
-            return true;
-        }
-        case AArch64::DMB: {
-            return true;
-        }
 
 
         case AArch64::TBLv16i8Four:
@@ -218,26 +837,75 @@ bool AArch64InstrSema::translateTargetInst() {
         case AArch64::TBXv8i8Four:
         case AArch64::TBXv8i8One:
         case AArch64::TBXv8i8Three:
-        case AArch64::TBXv8i8Two:
-        {
-            //FIXME
-            errs() << "TBLv16i8One not handled yet!\n";
+        case AArch64::TBXv8i8Two: {
+            translateTableLookup();
             return true;
         }
         case AArch64::FCVTLv2i32:
         case AArch64::FCVTLv4i16:
         case AArch64::FCVTLv4i32:
-        case AArch64::FCVTLv8i16:
+        case AArch64::FCVTLv8i16: {
+            // Extend the low (or, for FCVTL2, high) half of the source.
+            bool High = Opcode == AArch64::FCVTLv4i32 ||
+                        Opcode == AArch64::FCVTLv8i16;
+            bool FromHalf = Opcode == AArch64::FCVTLv4i16 ||
+                            Opcode == AArch64::FCVTLv8i16;
+            Type *SrcEltTy = FromHalf ? Builder->getHalfTy() : Builder->getFloatTy();
+            Type *DstEltTy = FromHalf ? Builder->getFloatTy() : Builder->getDoubleTy();
+            unsigned NumElts = FromHalf ? 4 : 2;
+
+            uint64_t DstRegNo = CurrentInst->Inst.getOperand(0).getReg();
+            Value *Src = getReg(CurrentInst->Inst.getOperand(1).getReg());
+            unsigned SrcElts = Src->getType()->getIntegerBitWidth() /
+                               SrcEltTy->getPrimitiveSizeInBits();
+            Type *SrcTy = VectorType::get(SrcEltTy, SrcElts);
+            Src = Builder->CreateBitCast(Src, SrcTy);
+            SmallVector<int, 4> Mask(NumElts);
+            for (unsigned i = 0; i != NumElts; ++i)
+                Mask[i] = High ? NumElts + i : i;
+            Src = Builder->CreateShuffleVector(Src, UndefValue::get(SrcTy), Mask);
+            Value *Res = Builder->CreateFPExt(Src, VectorType::get(DstEltTy, NumElts));
+            setReg(DstRegNo, Builder->CreateBitCast(Res, Builder->getIntNTy(128)));
+            return true;
+        }
         case AArch64::FCVTNv2i32:
         case AArch64::FCVTNv4i16:
         case AArch64::FCVTNv4i32:
         case AArch64::FCVTNv8i16: {
-            //errs() << "[-----]FCVTNv\n";
-            uint64_t DstRegNo = CurrentInst->Inst.getOperand(0).getReg();
-            Value *Src = getReg(CurrentInst->Inst.getOperand(1).getReg());
-            Value *Dst = getReg(DstRegNo);
-            Src = Builder->CreateZExtOrTrunc(Src, Dst->getType());
-            setReg(DstRegNo, Src);
+            // Narrow to a 64-bit vector, written to the destination, or to
+            // the high half of it for FCVTN2, which has a tied input.
+            bool High = Opcode == AArch64::FCVTNv4i32 ||
+                        Opcode == AArch64::FCVTNv8i16;
+            bool ToHalf = Opcode == AArch64::FCVTNv4i16 ||
+                          Opcode == AArch64::FCVTNv8i16;
+            Type *SrcEltTy = ToHalf ? Builder->getFloatTy() : Builder->getDoubleTy();
+            Type *DstEltTy = ToHalf ? Builder->getHalfTy() : Builder->getFloatTy();
+            unsigned NumElts = ToHalf ? 4 : 2;
+
+            const MCInst &Inst = CurrentInst->Inst;
+            uint64_t DstRegNo = Inst.getOperand(0).getReg();
+            Value *Src = getReg(Inst.getOperand(High ? 2 : 1).getReg());
+            Src = Builder->CreateBitCast(Src, VectorType::get(SrcEltTy, NumElts));
+            Type *ResTy = VectorType::get(DstEltTy, NumElts);
+            Value *Res = Builder->CreateFPTrunc(Src, ResTy);
+            if (High) {
+                Type *DstTy = VectorType::get(DstEltTy, 2 * NumElts);
+                Value *Dst = Builder->CreateBitCast(getReg(DstRegNo), DstTy);
+                SmallVector<int, 8> WidenMask(2 * NumElts), BlendMask(2 * NumElts);
+                for (unsigned i = 0; i != 2 * NumElts; ++i) {
+                    WidenMask[i] = i % NumElts;
+                    BlendMask[i] = i < NumElts ? i : i + NumElts;
+                }
+                Res = Builder->CreateShuffleVector(Res, UndefValue::get(ResTy),
+                                                   WidenMask);
+                Res = Builder->CreateShuffleVector(Dst, Res, BlendMask);
+                Res = Builder->CreateBitCast(Res, Builder->getIntNTy(128));
+            } else {
+                Res = Builder->CreateBitCast(Res, Builder->getInt64Ty());
+                Res = Builder->CreateZExtOrTrunc(
+                    Res, getReg(DstRegNo)->getType());
+            }
+            setReg(DstRegNo, Res);
             return true;
         }
         case AArch64::FMLAv4i32_indexed:
@@ -271,21 +939,29 @@ bool AArch64InstrSema::translateTargetInst() {
             return true;
         }
     }
-    if (Idx) {
-        DEBUG(errs() << "Use table\n");
-        return false;
+    // Use the semantics table; instructions without semantics are reported
+    // by DCInstrSema.
+    return false;
+}
+
+ConstantInt *AArch64InstrSema::getLogicalImm(uint64_t Enc, unsigned RegSize) {
+    LLVMContext &C = Builder->getContext();
+    if (LogicalImmsCtx != &C) {
+        LogicalImms.clear();
+        LogicalImmsCtx = &C;
     }
-    // llvm_unreachable("not handled yet");
-    //FIXME: unhandled instruction should lead to an error...
-    return true;
+    // The encodings are 13 bits: N:immr:imms.
+    ConstantInt *&Imm = LogicalImms[(Enc << 1) | (RegSize == 64)];
+    if (!Imm)
+        Imm = ConstantInt::get(IntegerType::get(C, RegSize),
+                               AArch64_AM::decodeLogicalImmediate(Enc, RegSize));
+    return Imm;
 }
 
 void AArch64InstrSema::translateCustomOperand(unsigned OperandType, unsigned MIOperandNo) {
     switch (OperandType) {
         default: {
-            errs() << "Unhandled OpType: " << OperandType << "\n";
-            errs() << utohexstr(CurrentInst->Address) << "\n";
-            llvm_unreachable("");
+            unknownSemantics("unhandled operand type " + Twine(OperandType));
             break;
         }
         case AArch64::OpTypes::SUBanonymous_745:
@@ -366,7 +1042,7 @@ void AArch64InstrSema::translateCustomOperand(unsigned OperandType, unsigned MIO
         }
         case AArch64::OpTypes::VectorIndex1: {
             DEBUG(errs() << "Operand:VectorIndex1\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::VectorIndexB: {
@@ -403,7 +1079,7 @@ void AArch64InstrSema::translateCustomOperand(unsigned OperandType, unsigned MIO
             uint64_t Imm = getImmOp(MIOperandNo);
             uint64_t Shift = getImmOp(MIOperandNo + 1);
 
-            Type *ResType = ResEVT.getTypeForEVT(*Ctx);
+            Type *ResType = getTypeForVT(ResEVT);
             Value *Cst =
                     ConstantInt::get(cast<IntegerType>(ResType), Imm << Shift);
             registerResult(Cst);
@@ -411,12 +1087,12 @@ void AArch64InstrSema::translateCustomOperand(unsigned OperandType, unsigned MIO
         }
         case AArch64::OpTypes::addsub_shifted_imm32_neg: {
             DEBUG(errs() << "Operand:addsub_shifted_imm32_neg\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::addsub_shifted_imm64_neg: {
             DEBUG(errs() << "Operand:addsub_shifted_imm64_neg\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::adrlabel: {
@@ -464,87 +1140,87 @@ void AArch64InstrSema::translateCustomOperand(unsigned OperandType, unsigned MIO
         }
         case AArch64::OpTypes::anonymous_1014_movimm: {
             DEBUG(errs() << "Operand:anonymous_1014_movimm\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::anonymous_1015_movimm: {
             DEBUG(errs() << "Operand:anonymous_1015_movimm\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::anonymous_1016_movimm: {
             DEBUG(errs() << "Operand:anonymous_1016_movimm\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::anonymous_1017_movimm: {
             DEBUG(errs() << "Operand:anonymous_1017_movimm\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::anonymous_1018_movimm: {
             DEBUG(errs() << "Operand:anonymous_1018_movimm\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::anonymous_1019_movimm: {
             DEBUG(errs() << "Operand:anonymous_1019_movimm\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::anonymous_1020_movimm: {
             DEBUG(errs() << "Operand:anonymous_1020_movimm\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::anonymous_1021_movimm: {
             DEBUG(errs() << "Operand:anonymous_1021_movimm\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::anonymous_1022_movimm: {
             DEBUG(errs() << "Operand:anonymous_1022_movimm\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::anonymous_1023_movimm: {
             DEBUG(errs() << "Operand:anonymous_1023_movimm\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::anonymous_1024_movimm: {
             DEBUG(errs() << "Operand:anonymous_1024_movimm\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::anonymous_1025_movimm: {
             DEBUG(errs() << "Operand:anonymous_1025_movimm\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::arith_extend: {
             DEBUG(errs() << "Operand:arith_extend\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::arith_extend64: {
             DEBUG(errs() << "Operand:arith_extend64\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::arith_extendlsl64: {
             DEBUG(errs() << "Operand:arith_extendlsl64\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::arith_shift32: {
             DEBUG(errs() << "Operand:arith_shift32\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::arith_shift64: {
             DEBUG(errs() << "Operand:arith_shift64\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::arith_shifted_reg32:
@@ -564,119 +1240,101 @@ void AArch64InstrSema::translateCustomOperand(unsigned OperandType, unsigned MIO
         }
         case AArch64::OpTypes::barrier_op: {
             DEBUG(errs() << "Operand:barrier_op\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::ccode: {
             DEBUG(errs() << "Operand:ccode\n");
             uint64_t CC = getImmOp(MIOperandNo);
+            AArch64DRS.skipNextNZCVGet();
+            // After a comparison, e.g. CMP + B.cond, the condition compares
+            // its operands directly.
+            if (Value *Fused = AArch64DRS.getFusedCondition(CC)) {
+                DEBUG(errs() << "CC: " << CC << ", fused\n");
+                registerResult(Fused);
+                break;
+            }
             Value *Cmp = NULL;
+            // Only the flags the condition reads are computed, see
+            // AArch64RegisterSema::setNZCVLazily.
+            auto Flag = [&](AArch64::NZCVShift Shift) {
+                return AArch64DRS.getNZCVFlag(Shift);
+            };
             switch (CC) {
                 case AArch64CC::EQ: {
                     DEBUG(errs() << "CC: EQ\n");
-                    Value *NZCV = getReg(AArch64::NZCV);
-                    Value *Z_flag = Builder->CreateAnd(NZCV, Builder->getInt32(0x1 << AArch64::NZCVShift::Z));
-                    Cmp = Builder->CreateICmpNE(Z_flag, Builder->getInt32(0));
+                    Cmp = Flag(AArch64::Z);
                     break;
                 }
                 case AArch64CC::NE: {
                     DEBUG(errs() << "CC: NE\n");
-                    Value *NZCV = getReg(AArch64::NZCV);
-                    Value *Z_flag = Builder->CreateAnd(NZCV, Builder->getInt32(0x1 << AArch64::NZCVShift::Z));
-                    Cmp = Builder->CreateICmpEQ(Z_flag, Builder->getInt32(0));
+                    Cmp = Builder->CreateNot(Flag(AArch64::Z));
                     break;
                 }
                 case AArch64CC::HS: {
                     DEBUG(errs() << "CC: HS\n");
-                    Value *NZCV = getReg(AArch64::NZCV);
-                    Value *C_flag = Builder->CreateAnd(NZCV, Builder->getInt32(0x1 << AArch64::NZCVShift::C));
-                    Cmp = Builder->CreateICmpNE(C_flag, Builder->getInt32(0));
+                    Cmp = Flag(AArch64::C);
                     break;
                 }
                 case AArch64CC::LO: {
                     DEBUG(errs() << "CC: LO\n");
-                    Value *NZCV = getReg(AArch64::NZCV);
-                    Value *C_flag = Builder->CreateAnd(NZCV, Builder->getInt32(0x1 << AArch64::NZCVShift::C));
-                    Cmp = Builder->CreateICmpEQ(C_flag, Builder->getInt32(0));
+                    Cmp = Builder->CreateNot(Flag(AArch64::C));
                     break;
                 }
                 case AArch64CC::MI: {
                     DEBUG(errs() << "CC: MI\n");
-                    Value *NZCV = getReg(AArch64::NZCV);
-                    Value *N_flag = Builder->CreateAnd(NZCV, Builder->getInt32(0x1 << AArch64::NZCVShift::N));
-                    Cmp = Builder->CreateICmpNE(N_flag, Builder->getInt32(0));
+                    Cmp = Flag(AArch64::N);
                     break;
                 }
                 case AArch64CC::PL: {
                     DEBUG(errs() << "CC: PL\n");
-                    Value *NZCV = getReg(AArch64::NZCV);
-                    Value *N_flag = Builder->CreateAnd(NZCV, Builder->getInt32(0x1 << AArch64::NZCVShift::N));
-                    Cmp = Builder->CreateICmpEQ(N_flag, Builder->getInt32(0));
+                    Cmp = Builder->CreateNot(Flag(AArch64::N));
                     break;
                 }
                 case AArch64CC::VS: {
                     DEBUG(errs() << "CC: VS\n");
-                    Value *NZCV = getReg(AArch64::NZCV);
-                    Value *V_flag = Builder->CreateAnd(NZCV, Builder->getInt32(0x1 << AArch64::NZCVShift::V));
-                    Cmp = Builder->CreateICmpNE(V_flag, Builder->getInt32(0));
+                    Cmp = Flag(AArch64::V);
                     break;
                 }
                 case AArch64CC::VC: {
                     DEBUG(errs() << "CC: VC\n");
-                    Value *NZCV = getReg(AArch64::NZCV);
-                    Value *V_flag = Builder->CreateAnd(NZCV, Builder->getInt32(0x1 << AArch64::NZCVShift::V));
-                    Cmp = Builder->CreateICmpEQ(V_flag, Builder->getInt32(0));
+                    Cmp = Builder->CreateNot(Flag(AArch64::V));
                     break;
                 }
                 case AArch64CC::HI: {
                     DEBUG(errs() << "CC: HI\n");
-                    Value *NZCV = getReg(AArch64::NZCV);
-                    Value *C_flag = Builder->CreateAnd(NZCV, Builder->getInt32(0x1 << AArch64::NZCVShift::C));
-                    Value *Z_flag = Builder->CreateAnd(NZCV, Builder->getInt32(0x1 << AArch64::NZCVShift::Z));
-                    Cmp = Builder->CreateAnd(Builder->CreateICmpNE(C_flag, Builder->getInt32(0)), Builder->CreateICmpEQ(Z_flag, Builder->getInt32(0)));
+                    Cmp = Builder->CreateAnd(Flag(AArch64::C),
+                                             Builder->CreateNot(Flag(AArch64::Z)));
                     break;
                 }
                 case AArch64CC::LS: {
                     DEBUG(errs() << "CC: LS\n");
-                    Value *NZCV = getReg(AArch64::NZCV);
-                    Value *C_flag = Builder->CreateAnd(NZCV, Builder->getInt32(0x1 << AArch64::NZCVShift::C));
-                    Value *Z_flag = Builder->CreateAnd(NZCV, Builder->getInt32(0x1 << AArch64::NZCVShift::Z));
-                    Cmp = Builder->CreateOr(Builder->CreateICmpEQ(C_flag, Builder->getInt32(0)), Builder->CreateICmpNE(Z_flag, Builder->getInt32(0)));
+                    Cmp = Builder->CreateOr(Builder->CreateNot(Flag(AArch64::C)),
+                                            Flag(AArch64::Z));
                     break;
                 }
                 case AArch64CC::GE: {
                     DEBUG(errs() << "CC: GE\n");
-                    Value *NZCV = getReg(AArch64::NZCV);
-                    Value *N_flag = Builder->CreateAnd(NZCV, Builder->getInt32(0x1 << AArch64::NZCVShift::N));
-                    Value *V_flag = Builder->CreateAnd(NZCV, Builder->getInt32(0x1 << AArch64::NZCVShift::V));
-                    Cmp = Builder->CreateICmpEQ(N_flag, V_flag);
+                    Cmp = Builder->CreateICmpEQ(Flag(AArch64::N), Flag(AArch64::V));
                     break;
                 }
                 case AArch64CC::LT: {
                     DEBUG(errs() << "CC: LT\n");
-                    Value *NZCV = getReg(AArch64::NZCV);
-                    Value *N_flag = Builder->CreateAnd(NZCV, Builder->getInt32(0x1 << AArch64::NZCVShift::N));
-                    Value *V_flag = Builder->CreateAnd(NZCV, Builder->getInt32(0x1 << AArch64::NZCVShift::V));
-                    Cmp = Builder->CreateICmpNE(N_flag, V_flag);
+                    Cmp = Builder->CreateICmpNE(Flag(AArch64::N), Flag(AArch64::V));
                     break;
                 }
                 case AArch64CC::GT: {
                     DEBUG(errs() << "CC: GT\n");
-                    Value *NZCV = getReg(AArch64::NZCV);
-                    Value *Z_flag = Builder->CreateAnd(NZCV, Builder->getInt32(0x1 << AArch64::NZCVShift::Z));
-                    Value *N_flag = Builder->CreateAnd(NZCV, Builder->getInt32(0x1 << AArch64::NZCVShift::N));
-                    Value *V_flag = Builder->CreateAnd(NZCV, Builder->getInt32(0x1 << AArch64::NZCVShift::V));
-                    Cmp = Builder->CreateICmpEQ(N_flag, V_flag);
-                    Cmp = Builder->CreateAnd(Builder->CreateICmpEQ(Z_flag, Builder->getInt32(0)), Cmp);
+                    Cmp = Builder->CreateAnd(
+                        Builder->CreateNot(Flag(AArch64::Z)),
+                        Builder->CreateICmpEQ(Flag(AArch64::N), Flag(AArch64::V)));
                     break;
                 }
                 case AArch64CC::LE: {
                     DEBUG(errs() << "CC: LE\n");
-                    Value *NZCV = getReg(AArch64::NZCV);
-                    Value *Z_flag = Builder->CreateAnd(NZCV, Builder->getInt32(0x1 << AArch64::NZCVShift::Z));
-                    Value *N_flag = Builder->CreateAnd(NZCV, Builder->getInt32(0x1 << AArch64::NZCVShift::N));
-                    Value *V_flag = Builder->CreateAnd(NZCV, Builder->getInt32(0x1 << AArch64::NZCVShift::V));
-                    Cmp = Builder->CreateOr(Builder->CreateICmpNE(Z_flag, Builder->getInt32(0)), Builder->CreateICmpNE(N_flag, V_flag));
+                    Cmp = Builder->CreateOr(
+                        Flag(AArch64::Z),
+                        Builder->CreateICmpNE(Flag(AArch64::N), Flag(AArch64::V)));
                     break;
                 }
                 case AArch64CC::AL: {
@@ -696,12 +1354,12 @@ void AArch64InstrSema::translateCustomOperand(unsigned OperandType, unsigned MIO
         }
         case AArch64::OpTypes::f32imm: {
             DEBUG(errs() << "Operand:f32imm\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::f64imm: {
             DEBUG(errs() << "Operand:f64imm\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::fixedpoint_f32_i32: {
@@ -755,12 +1413,12 @@ void AArch64InstrSema::translateCustomOperand(unsigned OperandType, unsigned MIO
         }
         case AArch64::OpTypes::i16imm: {
             DEBUG(errs() << "Operand:i16imm\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::i1imm: {
             DEBUG(errs() << "Operand:i1imm\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::i32imm: {
@@ -770,102 +1428,102 @@ void AArch64InstrSema::translateCustomOperand(unsigned OperandType, unsigned MIO
         }
         case AArch64::OpTypes::i32shift_a: {
             DEBUG(errs() << "Operand:i32shift_a\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::i32shift_b: {
             DEBUG(errs() << "Operand:i32shift_b\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::i32shift_sext_i16: {
             DEBUG(errs() << "Operand:i32shift_sext_i16\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::i32shift_sext_i8: {
             DEBUG(errs() << "Operand:i32shift_sext_i8\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::i64imm: {
             DEBUG(errs() << "Operand:i64imm\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::i64shift_a: {
             DEBUG(errs() << "Operand:i64shift_a\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::i64shift_b: {
             DEBUG(errs() << "Operand:i64shift_b\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::i64shift_sext_i16: {
             DEBUG(errs() << "Operand:i64shift_sext_i16\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::i64shift_sext_i32: {
             DEBUG(errs() << "Operand:i64shift_sext_i32\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::i64shift_sext_i8: {
             DEBUG(errs() << "Operand:i64shift_sext_i8\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::i8imm: {
             DEBUG(errs() << "Operand:i8imm\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::imm0_127: {
             DEBUG(errs() << "Operand:imm0_127\n");
-            Type *ResType = ResEVT.getTypeForEVT(*Ctx);
+            Type *ResType = getTypeForVT(ResEVT);
             Value *Cst = ConstantInt::get(cast<IntegerType>(ResType), getImmOp(MIOperandNo));
             registerResult(Cst);
             break;
         }
         case AArch64::OpTypes::imm0_15: {
             DEBUG(errs() << "Operand:imm0_15\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::imm0_255: {
             DEBUG(errs() << "Operand:imm0_255\n");
-            Type *ResType = ResEVT.getTypeForEVT(*Ctx);
+            Type *ResType = getTypeForVT(ResEVT);
             Value *Cst = ConstantInt::get(cast<IntegerType>(ResType), getImmOp(MIOperandNo));
             registerResult(Cst);
             break;
         }
         case AArch64::OpTypes::imm0_31: {
             DEBUG(errs() << "Operand:imm0_31\n");
-            Type *ResType = ResEVT.getTypeForEVT(*Ctx);
+            Type *ResType = getTypeForVT(ResEVT);
             Value *Cst = ConstantInt::get(cast<IntegerType>(ResType), getImmOp(MIOperandNo));
             registerResult(Cst);
             break;
         }
         case AArch64::OpTypes::imm0_63: {
             DEBUG(errs() << "Operand:imm0_63\n");
-            Type *ResType = ResEVT.getTypeForEVT(*Ctx);
+            Type *ResType = getTypeForVT(ResEVT);
             Value *Cst = ConstantInt::get(cast<IntegerType>(ResType), getImmOp(MIOperandNo));
             registerResult(Cst);
             break;
         }
         case AArch64::OpTypes::imm0_65535: {
             DEBUG(errs() << "Operand:imm0_65535\n");
-            Type *ResType = ResEVT.getTypeForEVT(*Ctx);
+            Type *ResType = getTypeForVT(ResEVT);
             Value *Cst = ConstantInt::get(cast<IntegerType>(ResType), getImmOp(MIOperandNo));
             registerResult(Cst);
             break;
         }
         case AArch64::OpTypes::imm0_7: {
             DEBUG(errs() << "Operand:imm0_7\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::imm32_0_15:
@@ -878,46 +1536,44 @@ void AArch64InstrSema::translateCustomOperand(unsigned OperandType, unsigned MIO
                     DEBUG(errs() << "Operand:imm32_0_31\n");
                     break;
             }
-            Type *ResType = ResEVT.getTypeForEVT(*Ctx);
+            Type *ResType = getTypeForVT(ResEVT);
             Value *Cst = ConstantInt::get(cast<IntegerType>(ResType), getImmOp(MIOperandNo));
             registerResult(Cst);
             break;
         }
         case AArch64::OpTypes::inv_ccode: {
             DEBUG(errs() << "Operand:inv_ccode\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::logical_imm32: {
             DEBUG(errs() << "Operand:logical_imm32\n");
-            uint64_t logical_imm = AArch64_AM::decodeLogicalImmediate(getImmOp(MIOperandNo), 32);
-            registerResult(Builder->getInt32(logical_imm));
+            registerResult(getLogicalImm(getImmOp(MIOperandNo), 32));
             break;
         }
         case AArch64::OpTypes::logical_imm32_not: {
             DEBUG(errs() << "Operand:logical_imm32_not\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::logical_imm64: {
             DEBUG(errs() << "Operand:logical_imm64\n");
-            uint64_t logical_imm = AArch64_AM::decodeLogicalImmediate(getImmOp(MIOperandNo), 64);
-            registerResult(Builder->getInt64(logical_imm));
+            registerResult(getLogicalImm(getImmOp(MIOperandNo), 64));
             break;
         }
         case AArch64::OpTypes::logical_imm64_not: {
             DEBUG(errs() << "Operand:logical_imm64_not\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::logical_shift32: {
             DEBUG(errs() << "Operand:logical_shift32\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::logical_shift64: {
             DEBUG(errs() << "Operand:logical_shift64\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::logical_shifted_reg32:
@@ -953,31 +1609,31 @@ void AArch64InstrSema::translateCustomOperand(unsigned OperandType, unsigned MIO
         }
         case AArch64::OpTypes::logical_vec_hw_shift: {
             DEBUG(errs() << "Operand:logical_vec_hw_shift\n");
-            Type *ResType = ResEVT.getTypeForEVT(*Ctx);
+            Type *ResType = getTypeForVT(ResEVT);
             Value *Cst = ConstantInt::get(cast<IntegerType>(ResType), getImmOp(MIOperandNo));
             registerResult(Cst);
             break;
         }
         case AArch64::OpTypes::logical_vec_shift: {
             DEBUG(errs() << "Operand:logical_vec_shift\n");
-            Type *ResType = ResEVT.getTypeForEVT(*Ctx);
+            Type *ResType = getTypeForVT(ResEVT);
             Value *Cst = ConstantInt::get(cast<IntegerType>(ResType), getImmOp(MIOperandNo));
             registerResult(Cst);
             break;
         }
         case AArch64::OpTypes::maski16_or_more: {
             DEBUG(errs() << "Operand:maski16_or_more\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::maski8_or_more: {
             DEBUG(errs() << "Operand:maski8_or_more\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::move_vec_shift: {
             DEBUG(errs() << "Operand:move_vec_shift\n");
-            Type *ResType = ResEVT.getTypeForEVT(*Ctx);
+            Type *ResType = getTypeForVT(ResEVT);
             Value *Cst =
                     ConstantInt::get(cast<IntegerType>(ResType), getImmOp(MIOperandNo)- 256);
             registerResult(Cst);
@@ -985,7 +1641,7 @@ void AArch64InstrSema::translateCustomOperand(unsigned OperandType, unsigned MIO
         }
         case AArch64::OpTypes::movimm32_imm: {
             DEBUG(errs() << "Operand:movimm32_imm\n");
-            Type *ResType = ResEVT.getTypeForEVT(*Ctx);
+            Type *ResType = getTypeForVT(ResEVT);
             Value *Cst =
                     ConstantInt::get(cast<IntegerType>(ResType), getImmOp(MIOperandNo));
             registerResult(Cst);
@@ -1004,7 +1660,7 @@ void AArch64InstrSema::translateCustomOperand(unsigned OperandType, unsigned MIO
                 }
             }
 
-            Type *ResType = ResEVT.getTypeForEVT(*Ctx);
+            Type *ResType = getTypeForVT(ResEVT);
             Value *Cst =
                     ConstantInt::get(cast<IntegerType>(ResType), getImmOp(MIOperandNo));
             registerResult(Cst);
@@ -1012,72 +1668,72 @@ void AArch64InstrSema::translateCustomOperand(unsigned OperandType, unsigned MIO
         }
         case AArch64::OpTypes::movk_symbol_g0: {
             DEBUG(errs() << "Operand:movk_symbol_g0\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::movk_symbol_g1: {
             DEBUG(errs() << "Operand:movk_symbol_g1\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::movk_symbol_g2: {
             DEBUG(errs() << "Operand:movk_symbol_g2\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::movk_symbol_g3: {
             DEBUG(errs() << "Operand:movk_symbol_g3\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::movz_symbol_g0: {
             DEBUG(errs() << "Operand:movz_symbol_g0\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::movz_symbol_g1: {
             DEBUG(errs() << "Operand:movz_symbol_g1\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::movz_symbol_g2: {
             DEBUG(errs() << "Operand:movz_symbol_g2\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::movz_symbol_g3: {
             DEBUG(errs() << "Operand:movz_symbol_g3\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::mrs_sysreg_op: {
             DEBUG(errs() << "Operand:mrs_sysreg_op\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::msr_sysreg_op: {
             DEBUG(errs() << "Operand:msr_sysreg_op\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::neg_addsub_shifted_imm32: {
             DEBUG(errs() << "Operand:neg_addsub_shifted_imm32\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::neg_addsub_shifted_imm64: {
             DEBUG(errs() << "Operand:neg_addsub_shifted_imm64\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::prfop: {
             DEBUG(errs() << "Operand:prfop\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::pstatefield_op: {
             DEBUG(errs() << "Operand:pstatefield_op\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::ro_Wextend128:
@@ -1169,7 +1825,7 @@ void AArch64InstrSema::translateCustomOperand(unsigned OperandType, unsigned MIO
         }
         case AArch64::OpTypes::simm9: {
             DEBUG(errs() << "Operand:simm9\n");
-            Type *ResType = ResEVT.getTypeForEVT(*Ctx);
+            Type *ResType = getTypeForVT(ResEVT);
             Value *Cst =
                     ConstantInt::get(cast<IntegerType>(ResType), getImmOp(MIOperandNo));
             registerResult(Cst);
@@ -1177,32 +1833,32 @@ void AArch64InstrSema::translateCustomOperand(unsigned OperandType, unsigned MIO
         }
         case AArch64::OpTypes::simm9_offset_fb128: {
             DEBUG(errs() << "Operand:simm9_offset_fb128\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::simm9_offset_fb16: {
             DEBUG(errs() << "Operand:simm9_offset_fb16\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::simm9_offset_fb32: {
             DEBUG(errs() << "Operand:simm9_offset_fb32\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::simm9_offset_fb64: {
             DEBUG(errs() << "Operand:simm9_offset_fb64\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::simm9_offset_fb8: {
             DEBUG(errs() << "Operand:simm9_offset_fb8\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::sys_cr_op: {
             DEBUG(errs() << "Operand:sys_cr_op\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::tbz_imm0_31_diag: {
@@ -1214,7 +1870,7 @@ void AArch64InstrSema::translateCustomOperand(unsigned OperandType, unsigned MIO
         }
         case AArch64::OpTypes::tbz_imm0_31_nodiag: {
             DEBUG(errs() << "Operand:tbz_imm0_31_nodiag\n");
-            llvm_unreachable("Operand not implemented");
+            unknownSemantics("operand not implemented");
             break;
         }
         case AArch64::OpTypes::tbz_imm32_63: {
@@ -1266,7 +1922,7 @@ void AArch64InstrSema::translateCustomOperand(unsigned OperandType, unsigned MIO
                     break;
             }
             assert(Scale);
-            Type *ResType = ResEVT.getTypeForEVT(*Ctx);
+            Type *ResType = getTypeForVT(ResEVT);
             Value *Cst =
                     ConstantInt::get(cast<IntegerType>(ResType), Scale * getImmOp(MIOperandNo));
             registerResult(Cst);
@@ -1304,14 +1960,14 @@ void AArch64InstrSema::translateCustomOperand(unsigned OperandType, unsigned MIO
         }
         case AArch64::OpTypes::vecshiftR32: {
             DEBUG(errs() << "Operand:vecshiftR32\n");
-            Type *ResType = ResEVT.getTypeForEVT(*Ctx);
+            Type *ResType = getTypeForVT(ResEVT);
             Value *Cst = ConstantInt::get(cast<IntegerType>(ResType), getImmOp(MIOperandNo));
             registerResult(Cst);
             break;
         }
         case AArch64::OpTypes::vecshiftR32Narrow: {
             DEBUG(errs() << "Operand:vecshiftR32Narrow\n");
-            Type *ResType = ResEVT.getTypeForEVT(*Ctx);
+            Type *ResType = getTypeForVT(ResEVT);
             Value *Cst = ConstantInt::get(cast<IntegerType>(ResType), getImmOp(MIOperandNo));
             registerResult(Cst);
             break;
@@ -1323,7 +1979,7 @@ void AArch64InstrSema::translateCustomOperand(unsigned OperandType, unsigned MIO
         }
         case AArch64::OpTypes::vecshiftR64Narrow: {
             DEBUG(errs() << "Operand:vecshiftR64Narrow\n");
-            Type *ResType = ResEVT.getTypeForEVT(*Ctx);
+            Type *ResType = getTypeForVT(ResEVT);
             Value *Cst = ConstantInt::get(cast<IntegerType>(ResType), getImmOp(MIOperandNo));
             registerResult(Cst);
             break;
@@ -1384,6 +2040,15 @@ Value *AArch64InstrSema::getNZCVFlag(Value *N, Value *Z, Value *C, Value *V) {
     return NZCV;
 }
 
+Value *AArch64InstrSema::stripPointerAuth(Value *Ptr, bool IsData) {
+    // The user space addresses of arm64e have 47 bits: the code is above them,
+    // under the top byte of the data pointers, which keep it.
+    const uint64_t AddrMask = (1ULL << 47) - 1;
+    return Builder->CreateAnd(
+        Ptr, Builder->getInt64(IsData ? AddrMask | 0xFF00000000000000ULL
+                                      : AddrMask));
+}
+
 Value *AArch64InstrSema::ArithExtend(Value *Value, Type *ExtType, uint64_t Ext) {
     switch (Ext) {
         default:
@@ -1435,15 +2100,16 @@ Value *AArch64InstrSema::FPCompare(Value * LHS, Value * RHS) {
 void AArch64InstrSema::translateTargetOpcode() {
     switch (Opcode) {
         default:
-            errs() << Opcode << "\n";
-            llvm_unreachable("unknown opcode!");
+            unknownSemantics("unknown target opcode " + Twine(Opcode));
+            break;
         case AArch64ISD::ADDS: {
             ResEVT = NextVT();
             Value *V1 = getNextOperand();
             Value *V2 = getNextOperand();
-            Value *Result = Builder->CreateBinOp(Instruction::Sub, V1, V2);
+            Value *Result = Builder->CreateBinOp(Instruction::Add, V1, V2);
             registerResult(Result);
-            registerResult(getNZCVFlags(Result, V1, V2));
+            registerResult(
+                AArch64DRS.setNZCVLazily(Result, V1, V2, /*IsAdd=*/true));
             break;
         }
         case AArch64ISD::CALL: {
@@ -1456,7 +2122,7 @@ void AArch64InstrSema::translateTargetOpcode() {
             Value *V2 = getNextOperand();
             Value *Result = Builder->CreateBinOp(Instruction::Sub, V1, V2);
             registerResult(Result);
-            registerResult(getNZCVFlags(Result, V1, V2));
+            registerResult(AArch64DRS.setNZCVLazily(Result, V1, V2));
             break;
         }
         case AArch64ISD::BRCOND: {
@@ -1501,12 +2167,12 @@ void AArch64InstrSema::translateTargetOpcode() {
         }
         case AArch64ISD::WrapperLarge: {
             DEBUG(errs() << "ISD: WrapperLarge\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::TLSDESC_CALLSEQ: {
             DEBUG(errs() << "ISD: TLSDESC_CALLSEQ\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::ADRP: {
@@ -1517,17 +2183,17 @@ void AArch64InstrSema::translateTargetOpcode() {
         }
         case AArch64ISD::ADDlow: {
             DEBUG(errs() << "ISD: ADDlow\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::LOADgot: {
             DEBUG(errs() << "ISD: LOADgot\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::RET_FLAG: {
             DEBUG(errs() << "ISD: RET_FLAG\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::CSEL: {
@@ -1541,27 +2207,27 @@ void AArch64InstrSema::translateTargetOpcode() {
         }
         case AArch64ISD::FCSEL: {
             DEBUG(errs() << "ISD: FCSEL\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::CSINV: {
             DEBUG(errs() << "ISD: CSINV\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::CSNEG: {
             DEBUG(errs() << "ISD: CSNEG\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::CSINC: {
             DEBUG(errs() << "ISD: CSINC\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::THREAD_POINTER: {
             DEBUG(errs() << "ISD: THREAD_POINTER\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::ADC: {
@@ -1649,7 +2315,7 @@ void AArch64InstrSema::translateTargetOpcode() {
             Value *RHS = getNextOperand();
             Value *Result = Builder->CreateAnd(LHS, RHS);
             registerResult(Result);
-            registerResult(getNZCVFlags(Result));
+            registerResult(AArch64DRS.setNZCVLazily(Result, nullptr, nullptr));
             break;
         }
         case AArch64ISD::CCMN: {
@@ -1720,7 +2386,7 @@ void AArch64InstrSema::translateTargetOpcode() {
                 Elem = Builder->CreateShl(Elem, SVT.getScalarSizeInBits());
             }
 
-            Vector = Builder->CreateBitCast(Vector, ResEVT.getTypeForEVT(*Ctx));
+            Vector = Builder->CreateBitCast(Vector, getTypeForVT(ResEVT));
             registerResult(Vector);
 
             break;
@@ -1755,7 +2421,7 @@ void AArch64InstrSema::translateTargetOpcode() {
             for (unsigned i = 0; i < ResEVT.getSimpleVT().getVectorNumElements(); ++i) {
                 Vector = Builder->CreateInsertElement(Vector, Elem, i);
             }
-            registerResult(Builder->CreateBitCast(Vector, ResEVT.getTypeForEVT(*Ctx)));
+            registerResult(Builder->CreateBitCast(Vector, getTypeForVT(ResEVT)));
 
             break;
         }
@@ -1808,7 +2474,7 @@ void AArch64InstrSema::translateTargetOpcode() {
             imm = Builder->CreateZExtOrTrunc(imm, ResEVT.getVectorElementType().getTypeForEVT(*Ctx));
 
             Value *result = Builder->getInt(APInt(ResEVT.getSizeInBits(), 0));
-            result = Builder->CreateBitCast(result, ResEVT.getTypeForEVT(*Ctx));
+            result = Builder->CreateBitCast(result, getTypeForVT(ResEVT));
             for (unsigned i = 0; i < ResEVT.getVectorNumElements(); ++i) {
                 result = Builder->CreateInsertElement(result, imm, i);
             }
@@ -1817,7 +2483,7 @@ void AArch64InstrSema::translateTargetOpcode() {
         }
 //        case AArch64ISD::MOVIedit: {
 //            errs() << "ISD: MOVIedit\n";
-//            llvm_unreachable("Not implemented");
+//            unknownSemantics("target opcode not implemented");
 //            break;
 //        }
         case AArch64ISD::MOVImsl: {
@@ -1831,7 +2497,7 @@ void AArch64InstrSema::translateTargetOpcode() {
             imm = Builder->CreateOr(imm, lo);
 
             Value *result = Builder->getInt(APInt(ResEVT.getSizeInBits(), 0));
-            result = Builder->CreateBitCast(result, ResEVT.getTypeForEVT(*Ctx));
+            result = Builder->CreateBitCast(result, getTypeForVT(ResEVT));
             for (unsigned i = 0; i < ResEVT.getVectorNumElements(); ++i) {
                 result = Builder->CreateInsertElement(result, imm, i);
             }
@@ -1855,7 +2521,7 @@ void AArch64InstrSema::translateTargetOpcode() {
                     Elem = Builder->CreateShl(Elem, SVT.getScalarSizeInBits());
                 }
 
-                Vector = Builder->CreateBitCast(Vector, ResEVT.getTypeForEVT(*Ctx));
+                Vector = Builder->CreateBitCast(Vector, getTypeForVT(ResEVT));
                 registerResult(Vector);
             } else {
                 llvm_unreachable("has to be a vector?");
@@ -1866,7 +2532,7 @@ void AArch64InstrSema::translateTargetOpcode() {
         case AArch64ISD::MVNIshift: {
             DEBUG(errs() << "ISD: MVNIshift\n");
             Value *result = Builder->getInt(APInt(ResEVT.getSizeInBits(), 0));
-            result = Builder->CreateBitCast(result, ResEVT.getTypeForEVT(*Ctx));
+            result = Builder->CreateBitCast(result, getTypeForVT(ResEVT));
 
             Value *elem = getNextOperand();
             Value *shift = getNextOperand();
@@ -1891,7 +2557,7 @@ void AArch64InstrSema::translateTargetOpcode() {
             imm = Builder->CreateOr(imm, lo);
 
             Value *result = Builder->getInt(APInt(ResEVT.getSizeInBits(), 0));
-            result = Builder->CreateBitCast(result, ResEVT.getTypeForEVT(*Ctx));
+            result = Builder->CreateBitCast(result, getTypeForVT(ResEVT));
             for (unsigned i = 0; i < ResEVT.getVectorNumElements(); ++i) {
                 result = Builder->CreateInsertElement(result, imm, i);
             }
@@ -1907,7 +2573,7 @@ void AArch64InstrSema::translateTargetOpcode() {
             Value *shift = getNextOperand();
 
             Value *result = Builder->getInt(APInt(ResEVT.getSizeInBits(), 0));
-            result = Builder->CreateBitCast(result, ResEVT.getTypeForEVT(*Ctx));
+            result = Builder->CreateBitCast(result, getTypeForVT(ResEVT));
 
             if (VectorType *maskTy = dyn_cast<VectorType>(mask->getType())) {
                 llvm_unreachable("not implemented yet..");
@@ -1925,7 +2591,7 @@ void AArch64InstrSema::translateTargetOpcode() {
         case AArch64ISD::ORRi: {
             DEBUG(errs() << "ISD: ORRi\n");
             Value *result = Builder->getInt(APInt(ResEVT.getSizeInBits(), 0));
-            result = Builder->CreateBitCast(result, ResEVT.getTypeForEVT(*Ctx));
+            result = Builder->CreateBitCast(result, getTypeForVT(ResEVT));
 
             Value *vec = getNextOperand();
 
@@ -1944,12 +2610,12 @@ void AArch64InstrSema::translateTargetOpcode() {
         }
         case AArch64ISD::BSL: {
             DEBUG(errs() << "ISD: BSL\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::NEG: {
             DEBUG(errs() << "ISD: NEG\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::ZIP1: {
@@ -2008,7 +2674,7 @@ void AArch64InstrSema::translateTargetOpcode() {
         }
         case AArch64ISD::REV16: {
             DEBUG(errs() << "ISD: REV16\n");
-            //llvm_unreachable("Not implemented");
+            //unknownSemantics("target opcode not implemented");
             //BugID: vlc_0x100C6D7D0
             Value *in = getNextOperand();
             in = Builder->CreateBitCast(in, VectorType::get(Builder->getInt16Ty(), ResEVT.getSizeInBits() / 16));
@@ -2027,7 +2693,7 @@ void AArch64InstrSema::translateTargetOpcode() {
                 Value *rev = Builder->CreateCall(intr, args);
                 result = Builder->CreateInsertElement(result, rev, i);
             }
-            result = Builder->CreateBitCast(result, ResEVT.getTypeForEVT(*Ctx));
+            result = Builder->CreateBitCast(result, getTypeForVT(ResEVT));
             registerResult(result);
             break;
         }
@@ -2037,7 +2703,7 @@ void AArch64InstrSema::translateTargetOpcode() {
             // Two possibilites here:
             // REV32 Vd.<T>, Vn.<T> => Element reverse in 32-bit words (vector). Where <T> is 8B, 16B, 4H, or 8H.
             // REV32 Xd, Xm => Reverse Bytes in Words (extended)
-            //llvm_unreachable("Not implemented");
+            //unknownSemantics("target opcode not implemented");
             Value *in = getNextOperand();
             in = Builder->CreateBitCast(in, VectorType::get(Builder->getInt32Ty(), ResEVT.getSizeInBits() / 32));
 
@@ -2055,7 +2721,7 @@ void AArch64InstrSema::translateTargetOpcode() {
                 Value *rev = Builder->CreateCall(intr, args);
                 result = Builder->CreateInsertElement(result, rev, i);
             }
-            result = Builder->CreateBitCast(result, ResEVT.getTypeForEVT(*Ctx));
+            result = Builder->CreateBitCast(result, getTypeForVT(ResEVT));
             registerResult(result);
             break;
         }
@@ -2078,7 +2744,7 @@ void AArch64InstrSema::translateTargetOpcode() {
                 Value *rev = Builder->CreateCall(intr, args);
                 result = Builder->CreateInsertElement(result, rev, i);
             }
-            result = Builder->CreateBitCast(result, ResEVT.getTypeForEVT(*Ctx));
+            result = Builder->CreateBitCast(result, getTypeForVT(ResEVT));
             registerResult(result);
             break;
         }
@@ -2136,13 +2802,13 @@ void AArch64InstrSema::translateTargetOpcode() {
         //modified
         case AArch64ISD::SQSHL_I: 
         //    DEBUG(errs() << "ISD: SQSHL_I\n");
-        //    llvm_unreachable("Not implemented");
+        //    unknownSemantics("target opcode not implemented");
         //    break;
         //}
         //BugID: koubei_100BF4608
         case AArch64ISD::UQSHL_I: {
             DEBUG(errs() << "ISD: UQSHL_I\n");
-            //llvm_unreachable("Not implemented");
+            //unknownSemantics("target opcode not implemented");
             Value *op1 = getNextOperand();
             ConstantInt *shift = dyn_cast<ConstantInt>(getNextOperand());
             assert(shift);
@@ -2170,7 +2836,7 @@ void AArch64InstrSema::translateTargetOpcode() {
         //modified
         case AArch64ISD::SQSHLU_I: {
             DEBUG(errs() << "ISD: SQSHLU_I\n");
-            //llvm_unreachable("Not implemented");
+            //unknownSemantics("target opcode not implemented");
             Value *op1 = getNextOperand();
             ConstantInt *shift = dyn_cast<ConstantInt>(getNextOperand());
             assert(shift);
@@ -2221,7 +2887,7 @@ void AArch64InstrSema::translateTargetOpcode() {
         //BugID: vlc_100C6C330
         case AArch64ISD::URSHR_I: {
             DEBUG(errs() << "ISD: URSHR_I\n");
-            //llvm_unreachable("Not implemented");
+            //unknownSemantics("target opcode not implemented");
             Value *op1 = getNextOperand();
             ConstantInt *shift = dyn_cast<ConstantInt>(getNextOperand());
             assert(shift);
@@ -2268,7 +2934,7 @@ void AArch64InstrSema::translateTargetOpcode() {
         }
         case AArch64ISD::CMGE: {
             DEBUG(errs() << "ISD: CMGE\n");
-            //llvm_unreachable("Not implemented");
+            //unknownSemantics("target opcode not implemented");
             MVT SVT = ResEVT.getSimpleVT();
 
             Value *Vector1 = getNextOperand();
@@ -2396,7 +3062,7 @@ void AArch64InstrSema::translateTargetOpcode() {
                 Constant *allOnes = ConstantInt::get(elemTy, -1U, false);
 
                 Value *result = Builder->getInt(APInt(ResEVT.getSizeInBits(), 0));
-                result = Builder->CreateBitCast(result, ResEVT.getTypeForEVT(*Ctx));
+                result = Builder->CreateBitCast(result, getTypeForVT(ResEVT));
 
                 for (unsigned i = 0; i < ResEVT.getVectorNumElements(); ++i) {
                     Value *elem1 = Builder->CreateExtractElement(op1, i);
@@ -2475,7 +3141,7 @@ void AArch64InstrSema::translateTargetOpcode() {
         }
         case AArch64ISD::CMGEz: {
             DEBUG(errs() << "ISD: CMGEz\n");
-            //llvm_unreachable("Not implemented");
+            //unknownSemantics("target opcode not implemented");
             assert(ResEVT.getSimpleVT().isVector());
 
             Value *vector1 = getNextOperand();
@@ -2497,7 +3163,7 @@ void AArch64InstrSema::translateTargetOpcode() {
         }
         case AArch64ISD::CMGTz: {
             DEBUG(errs() << "ISD: CMGTz\n");
-            //llvm_unreachable("Not implemented");
+            //unknownSemantics("target opcode not implemented");
             assert(ResEVT.getSimpleVT().isVector());
 
             Value *vector1 = getNextOperand();
@@ -2561,32 +3227,32 @@ void AArch64InstrSema::translateTargetOpcode() {
         }
         case AArch64ISD::SADDV: {
             DEBUG(errs() << "ISD: SADDV\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::UADDV: {
             DEBUG(errs() << "ISD: UADDV\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::SMINV: {
             DEBUG(errs() << "ISD: SMINV\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::UMINV: {
             DEBUG(errs() << "ISD: UMINV\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::SMAXV: {
             DEBUG(errs() << "ISD: SMAXV\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::UMAXV: {
             DEBUG(errs() << "ISD: UMAXV\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::NOT: {
@@ -2609,7 +3275,7 @@ void AArch64InstrSema::translateTargetOpcode() {
             }
 
             registerResult(Result);
-            //llvm_unreachable("Not implemented");
+            //unknownSemantics("target opcode not implemented");
 
             break;
         }
@@ -2620,9 +3286,9 @@ void AArch64InstrSema::translateTargetOpcode() {
             Value *Result = getNextOperand();
 
             Value *ValueVec = getNextOperand();
-            ValueVec = Builder->CreateBitCast(ValueVec, ResEVT.getTypeForEVT(*Ctx));
+            ValueVec = Builder->CreateBitCast(ValueVec, getTypeForVT(ResEVT));
             Value *cmpVec = getNextOperand();
-            cmpVec = Builder->CreateBitCast(cmpVec, ResEVT.getTypeForEVT(*Ctx));
+            cmpVec = Builder->CreateBitCast(cmpVec, getTypeForVT(ResEVT));
 
             Value *zero = Builder->getInt(APInt(ResEVT.getSimpleVT().getVectorElementType().getSizeInBits(), 0));
             for (unsigned i = 0; i < ResEVT.getSimpleVT().getVectorNumElements(); ++i) {
@@ -2668,162 +3334,162 @@ void AArch64InstrSema::translateTargetOpcode() {
         }
         case AArch64ISD::TC_RETURN: {
             DEBUG(errs() << "ISD: TC_RETURN\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::PREFETCH: {
             DEBUG(errs() << "ISD: PREFETCH\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::SITOF: {
             DEBUG(errs() << "ISD: SITOF\n");
-            Type *ResType = ResEVT.getTypeForEVT(*Ctx);
+            Type *ResType = getTypeForVT(ResEVT);
             Value *Op = getNextOperand();
             if (!Op->getType()->isIntegerTy()) {
-                Op = Builder->CreateBitCast(Op, IntegerType::get(getGlobalContext(), ResType->getScalarSizeInBits()));
+                Op = Builder->CreateBitCast(Op, IntegerType::get(*Ctx, ResType->getScalarSizeInBits()));
             }
             registerResult(Builder->CreateSIToFP(Op, ResType));
             break;
         }
         case AArch64ISD::UITOF: {
             DEBUG(errs() << "ISD: UITOF\n");
-            Type *ResType = ResEVT.getTypeForEVT(*Ctx);
+            Type *ResType = getTypeForVT(ResEVT);
             Value *Op = getNextOperand();
             if (!Op->getType()->isIntegerTy()) {
-                Op = Builder->CreateBitCast(Op, IntegerType::get(getGlobalContext(), ResType->getScalarSizeInBits()));
+                Op = Builder->CreateBitCast(Op, IntegerType::get(*Ctx, ResType->getScalarSizeInBits()));
             }
             registerResult(Builder->CreateUIToFP(Op, ResType));
             break;
         }
         case AArch64ISD::NVCAST: {
             DEBUG(errs() << "ISD: NVCAST\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::SMULL: {
             DEBUG(errs() << "ISD: SMULL\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::UMULL: {
             DEBUG(errs() << "ISD: UMULL\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::LD2post: {
             DEBUG(errs() << "ISD: LD2post\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::LD3post: {
             DEBUG(errs() << "ISD: LD3post\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::LD4post: {
             DEBUG(errs() << "ISD: LD4post\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::ST2post: {
             DEBUG(errs() << "ISD: ST2post\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::ST3post: {
             DEBUG(errs() << "ISD: ST3post\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::ST4post: {
             DEBUG(errs() << "ISD: ST4post\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::LD1x2post: {
             DEBUG(errs() << "ISD: LD1x2post\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::LD1x3post: {
             DEBUG(errs() << "ISD: LD1x3post\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::LD1x4post: {
             DEBUG(errs() << "ISD: LD1x4post\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         } 
         case AArch64ISD::ST1x2post: {
             DEBUG(errs() << "ISD: ST1x2post\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::ST1x3post: {
             DEBUG(errs() << "ISD: ST1x3post\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::ST1x4post: {
             DEBUG(errs() << "ISD: ST1x4post\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::LD1DUPpost: {
             DEBUG(errs() << "ISD: LD1DUPpost\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::LD2DUPpost: {
             DEBUG(errs() << "ISD: LD2DUPpost\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::LD3DUPpost: {
             DEBUG(errs() << "ISD: LD3DUPpost\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::LD4DUPpost: {
             DEBUG(errs() << "ISD: LD4DUPpost\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::LD1LANEpost: {
             DEBUG(errs() << "ISD: LD1LANEpost\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::LD2LANEpost: {
             DEBUG(errs() << "ISD: LD2LANEpost\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::LD3LANEpost: {
             DEBUG(errs() << "ISD: LD3LANEpost\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::LD4LANEpost: {
             DEBUG(errs() << "ISD: LD4LANEpost\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::ST2LANEpost: {
             DEBUG(errs() << "ISD: ST2LANEpost\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::ST3LANEpost: {
             DEBUG(errs() << "ISD: ST3LANEpost\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::ST4LANEpost: {
             DEBUG(errs() << "ISD: ST4LANEpost\n");
-            llvm_unreachable("Not implemented");
+            unknownSemantics("target opcode not implemented");
             break;
         }
         case AArch64ISD::AARCH_REG_EXT: {
@@ -2870,14 +3536,16 @@ void AArch64InstrSema::translateTargetOpcode() {
 void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
     switch (IntrinsicID) {
         default:
-            errs() << "[!]intrinsic not handled: " << IntrinsicID <<"\n";
-            // llvm_unreachable("intrinsic not handled");
+            unknownSemantics(
+                "unhandled intrinsic " +
+                Intrinsic::getName((Intrinsic::ID)IntrinsicID));
+            break;
         case Intrinsic::aarch64_neon_abs:
         {
             Value *op = getNextOperand();
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(*Ctx));
+            types.push_back(getTypeForVT(ResEVT));
 
             Function *intrinsic = Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types);
 
@@ -2898,7 +3566,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             args.push_back(op2);
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(getGlobalContext()));
+            types.push_back(getTypeForVT(ResEVT));
             Value *result = Builder->CreateCall(Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types), args);
 
             registerResult(result);
@@ -2970,7 +3638,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             args.push_back(op);
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(getGlobalContext()));
+            types.push_back(getTypeForVT(ResEVT));
             types.push_back(op->getType());
             
             Value *result = Builder->CreateCall(Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types), args);
@@ -3005,7 +3673,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             Value *op = getNextOperand();
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(*Ctx));
+            types.push_back(getTypeForVT(ResEVT));
             types.push_back(op->getType());
 
             Function *intrinsic = Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types);
@@ -3044,7 +3712,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             Value *op = getNextOperand();
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(*Ctx));
+            types.push_back(getTypeForVT(ResEVT));
             types.push_back(op->getType());
 
             Function *intrinsic = Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types);
@@ -3086,7 +3754,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             Value *op2 = getNextOperand();
 
             std::vector<Type*> types;
-            // types.push_back(ResEVT.getTypeForEVT(getGlobalContext()));
+            // types.push_back(getTypeForVT(ResEVT));
             types.push_back(op1->getType());
 
             Function *intrinsic = Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types);
@@ -3145,7 +3813,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             Value *op2 = getNextOperand();
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(*Ctx));
+            types.push_back(getTypeForVT(ResEVT));
 
             Function *intrinsic = Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types);
 
@@ -3172,7 +3840,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             Value *op = getNextOperand();
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(*Ctx));
+            types.push_back(getTypeForVT(ResEVT));
             types.push_back(op->getType());
 
             Function *intrinsic = Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types);
@@ -3191,7 +3859,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             Value *op = getNextOperand();
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(*Ctx));
+            types.push_back(getTypeForVT(ResEVT));
 
             Function *intrinsic = Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types);
 
@@ -3211,7 +3879,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             args.push_back(op2);
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(getGlobalContext()));
+            types.push_back(getTypeForVT(ResEVT));
 
             Value *result = Builder->CreateCall(Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types), args);
             registerResult(result);
@@ -3229,7 +3897,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             args.push_back(op2);
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(getGlobalContext()));
+            types.push_back(getTypeForVT(ResEVT));
 
             Value *result = Builder->CreateCall(Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types), args);
             registerResult(result);
@@ -3261,7 +3929,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             args.push_back(op1);
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(getGlobalContext()));
+            types.push_back(getTypeForVT(ResEVT));
             types.push_back(op1->getType());
 
 
@@ -3286,7 +3954,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             add by -death end 
             */
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(getGlobalContext()));
+            types.push_back(getTypeForVT(ResEVT));
 
 
             Value *result = Builder->CreateCall(Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types), args);
@@ -3300,7 +3968,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             Value *op2 = getNextOperand();
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(*Ctx));
+            types.push_back(getTypeForVT(ResEVT));
 
             Function *intrinsic = Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types);
 
@@ -3316,7 +3984,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             Value *op = getNextOperand();
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(*Ctx));
+            types.push_back(getTypeForVT(ResEVT));
 
             Function *intrinsic = Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types);
 
@@ -3353,7 +4021,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             args.push_back(op2);
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(getGlobalContext()));
+            types.push_back(getTypeForVT(ResEVT));
 
             Value *result = Builder->CreateCall(Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types), args);
             registerResult(result);
@@ -3391,7 +4059,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             args.push_back(op2);
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(getGlobalContext()));
+            types.push_back(getTypeForVT(ResEVT));
 
             Value *result = Builder->CreateCall(Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types), args);
             registerResult(result);
@@ -3405,7 +4073,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             args.push_back(op2);
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(getGlobalContext()));
+            types.push_back(getTypeForVT(ResEVT));
 
             Value *result = Builder->CreateCall(Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types), args);
             registerResult(result);
@@ -3421,7 +4089,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             args.push_back(op2);
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(getGlobalContext()));
+            types.push_back(getTypeForVT(ResEVT));
 
             Value *result = Builder->CreateCall(Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types), args);
             registerResult(result);
@@ -3446,7 +4114,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             Value *op = getNextOperand();
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(*Ctx));
+            types.push_back(getTypeForVT(ResEVT));
 
             Function *intrinsic = Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types);
 
@@ -3480,7 +4148,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             args.push_back(op2);
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(getGlobalContext()));
+            types.push_back(getTypeForVT(ResEVT));
 
             Value *result = Builder->CreateCall(Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types), args);
             registerResult(result);
@@ -3507,7 +4175,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
         //     args.push_back(op1);
 
         //     std::vector<Type*> types;
-        //     types.push_back(ResEVT.getTypeForEVT(getGlobalContext()));
+        //     types.push_back(getTypeForVT(ResEVT));
 
         //     Value *result = Builder->CreateCall(Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types), args);
         //     registerResult(result);
@@ -3529,7 +4197,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             args.push_back(op2);
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(getGlobalContext()));
+            types.push_back(getTypeForVT(ResEVT));
             Value *result = Builder->CreateCall(Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types), args);
 
             registerResult(result);
@@ -3564,7 +4232,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             args.push_back(op);
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(*Ctx));
+            types.push_back(getTypeForVT(ResEVT));
             types.push_back(op->getType());
 
             Function *intrinsic = Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types);
@@ -3577,7 +4245,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             Value *op = getNextOperand();
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(*Ctx));
+            types.push_back(getTypeForVT(ResEVT));
             types.push_back(op->getType());
 
 
@@ -3614,7 +4282,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             args.push_back(op2);
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(getGlobalContext()));
+            types.push_back(getTypeForVT(ResEVT));
 
             Value *result = Builder->CreateCall(Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types), args);
             registerResult(result);
@@ -3640,7 +4308,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             Value *op = getNextOperand();
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(*Ctx));
+            types.push_back(getTypeForVT(ResEVT));
             types.push_back(op->getType());
 
             Function *intrinsic = Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types);
@@ -3674,7 +4342,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             Value *op2 = getNextOperand();
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(*Ctx));
+            types.push_back(getTypeForVT(ResEVT));
 
             Function *intrinsic = Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types);
 
@@ -3711,7 +4379,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             args.push_back(op2);
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(getGlobalContext()));
+            types.push_back(getTypeForVT(ResEVT));
 
             Value *result = Builder->CreateCall(Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types), args);
             registerResult(result);
@@ -3724,7 +4392,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             Value *op2 = getNextOperand();
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(getGlobalContext()));
+            types.push_back(getTypeForVT(ResEVT));
 
             Function *intrinsic = Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types);
 
@@ -3757,7 +4425,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             Value *op = getNextOperand();
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(*Ctx));
+            types.push_back(getTypeForVT(ResEVT));
             /*
             add by -death
             */
@@ -3822,7 +4490,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             args.push_back(op1);
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(getGlobalContext()));
+            types.push_back(getTypeForVT(ResEVT));
 
             Value *result = Builder->CreateCall(Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types), args);
             registerResult(result);
@@ -3855,7 +4523,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             args.push_back(op2);
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(getGlobalContext()));
+            types.push_back(getTypeForVT(ResEVT));
             types.push_back(op1->getType());
 
             Value *result = Builder->CreateCall(Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types), args);
@@ -3876,7 +4544,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             args.push_back(op2);
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(getGlobalContext()));
+            types.push_back(getTypeForVT(ResEVT));
             types.push_back(op1->getType());
 
             Value *result = Builder->CreateCall(Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types), args);
@@ -3893,7 +4561,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             args.push_back(op3);
 
             std::vector<Type*> types;
-            types.push_back(ResEVT.getTypeForEVT(getGlobalContext()));
+            types.push_back(getTypeForVT(ResEVT));
             //   types.push_back(op1->getType());
 
             Value *result = Builder->CreateCall(Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types), args);
@@ -3910,7 +4578,7 @@ void AArch64InstrSema::translateTargetIntrinsic(unsigned IntrinsicID) {
             // args.push_back(op3);
 
             std::vector<Type*> types;
-            // types.push_back(ResEVT.getTypeForEVT(getGlobalContext()));
+            // types.push_back(getTypeForVT(ResEVT));
             types.push_back(op1->getType());
             Function *intrinsic = Intrinsic::getDeclaration(TheModule, (llvm::Intrinsic::ID)IntrinsicID, types);
             op3 = Builder->CreateZExtOrTrunc(op3, intrinsic->getArgumentList().back().getType());
@@ -1,30 +1,111 @@
 #ifndef LLVM_LIB_TARGET_AARCH64_DC_AARCH64INSTRSEMA_H
 #define LLVM_LIB_TARGET_AARCH64_DC_AARCH64INSTRSEMA_H
 
+#include "AArch64ExclusiveLoops.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/DC/DCInstrSema.h"
 #include "llvm/Support/Compiler.h"
 
 namespace llvm {
 
+class AArch64RegisterSema;
+
 class AArch64InstrSema : public DCInstrSema {
 
 public:
+  // How a NEON structure load/store (LDn/STn) accesses its registers and
+  // memory.
+  struct LdStDesc {
+    enum KindTy : uint8_t {
+      None,     ///< Not a structure load/store.
+      Multiple, ///< Whole registers.
+      Lane,     ///< One lane of each register.
+      Replicate ///< One element, broadcast to all lanes of each register.
+    };
+    KindTy Kind;
+    bool IsLoad;
+    bool IsPost;
+    /// LD2-LD4/ST2-ST4 multiple structures, with interleaved elements.
+    bool Interleaved;
+    uint8_t NumVectors;
+    /// Elements in each register (lanes of a Q register for Lane).
+    uint8_t NumElements;
+    uint8_t ElemBits;
+  };
+
+  // How a Q or D register pair load/store (LDP/STP/LDNP/STNP) addresses
+  // memory.
+  struct VectorPair {
+    enum IndexTy : uint8_t { Offset, Pre, Post };
+    bool IsLoad;
+    IndexTy Index;
+    uint8_t RegBytes;
+  };
+
   AArch64InstrSema(DCRegisterSema &DRS);
 
   virtual void translateTargetOpcode();
   virtual void translateCustomOperand(unsigned OperandType,
                                       unsigned MIOperandNo);
   virtual void translateImplicit(unsigned RegNo) {};
+  // The accessors are a single block: a load or store, then a return, or the
+  // tail call of the ARC runtime.
+  bool matchObjCAccessor(const MCFunction &MCFN,
+                         DCObjCAccessor &A) const override;
 protected:
     virtual bool translateTargetInst() override;
+    // Find the exclusive loops, with -enable-dc-atomic-loops.
+    void analyzeTargetFunction(const MCFunction &MCFN) override;
     virtual void translateTargetIntrinsic(unsigned IntrinsicID);
+    // objc_msgSend takes the receiver in x0, and the selector in x1.
+    bool getObjCMessageRegs(unsigned &ReceiverReg,
+                            unsigned &SelectorReg) const override;
+    // The ARC runtime functions take x0 and x1, and return in x0.
+    bool getObjCARCRegs(unsigned &Arg0Reg, unsigned &Arg1Reg,
+                        unsigned &ResultReg) const override;
+    // The C functions take x0 to x7 and v0 to v7, and return in x0 or v0.
+    bool getExternalCallRegs(ExternalCallRegs &Regs) const override;
 
 private:
+    AArch64RegisterSema &AArch64DRS;
+
+    // The LdStDesc of each opcode, derived once from the instruction names.
+    std::vector<LdStDesc> LdStDescs;
+
+    // The logical immediates decoded so far, by encoding and register size,
+    // as constants of LogicalImmsCtx. The same few masks come up over and
+    // over in a binary.
+    DenseMap<unsigned, ConstantInt *> LogicalImms;
+    LLVMContext *LogicalImmsCtx;
+    ConstantInt *getLogicalImm(uint64_t Enc, unsigned RegSize);
+
+    // The exclusive loops of the current function.
+    AArch64ExclusiveLoops ExclusiveLoops;
+    // Translate the current instruction if it is the load, the store or the
+    // branch back of one of ExclusiveLoops, and return true, or return false.
+    bool translateExclusiveLoopInst();
+
+    bool translateLdSt(const LdStDesc &D);
+    // The Q and D register pairs, as <N x i64> vector loads and stores. Two
+    // pairs of the same block, one right after the other in memory, are a
+    // single access, at the first: MergedPair is the second.
+    bool translateVectorPair();
+    const MCDecodedInst *MergedPair;
+    // TBL/TBX, as aarch64.neon.tbl/tbx intrinsics.
+    void translateTableLookup();
+
     void printInstruction();
 
+    // Whether a successor of \p MCBB can read NZCV before it writes it.
+    bool isNZCVLiveOut(const MCBasicBlock &MCBB) const;
+
     Value *getNZCVFlags(Value *Result, Value *LHS = NULL, Value *RHS = NULL);
     Value *getNZCVFlag(Value *N, Value *Z, Value *C = NULL, Value *V = NULL);
 
+    // Strip the pointer authentication code from the top bits of \p Ptr,
+    // keeping the top byte of the data pointers (\p IsData).
+    Value *stripPointerAuth(Value *Ptr, bool IsData);
+
     Value *ArithExtend(Value *Value, Type *ExtType, uint64_t Ext);
     Value *FPCompare(Value *LHS, Value *RHS);
 };
@@ -1,7 +1,10 @@
 #include <llvm/MC/MCAnalysis/MCFunction.h>
 #include <llvm/ADT/StringExtras.h>
 #include "AArch64RegisterSema.h"
+#include "Utils/AArch64BaseInfo.h"
 
+#include "llvm/IR/Intrinsics.h"
+#include "llvm/IR/Module.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/Debug.h"
 
@@ -13,15 +16,30 @@ static void AArch64InitSpecialRegSizes(DCRegisterSema::RegSizeTy &RegSizes) {
 //    RegSizes[AArch64::D0] = 128;
 }
 
+static DCRegisterSema::RegSetRank
+AArch64GetRegSetRank(const MCRegisterInfo &MRI, unsigned RegNo) {
+  if (RegNo == AArch64::NZCV ||
+      MRI.getRegClass(AArch64::GPR64spRegClassID).contains(RegNo))
+    return DCRegisterSema::RSR_Hot;
+  // The Q registers, and the tuples of them.
+  for (MCSubRegIterator SRI(RegNo, &MRI, /*IncludeSelf=*/true); SRI.isValid();
+       ++SRI)
+    if (MRI.getRegClass(AArch64::FPR8RegClassID).contains(*SRI))
+      return DCRegisterSema::RSR_Vector;
+  return DCRegisterSema::RSR_Rare;
+}
+
 AArch64RegisterSema::AArch64RegisterSema(const MCRegisterInfo &MRI,
                                          const MCInstrInfo &MII,
                                          const DataLayout &DL) : DCRegisterSema(MRI, MII, DL,
-                                                                                AArch64InitSpecialRegSizes) {
-
+                                                                                AArch64InitSpecialRegSizes,
+                                                                                AArch64GetRegSetRank),
+      NZCVLiveOut(true), SkipNZCVGet(false) {
+  clearPendingNZCV();
 }
 
 Type *AArch64RegisterSema::getRegType(unsigned RegNo) {
-  return Type::getInt64Ty(getGlobalContext());
+  return Type::getInt64Ty(*Ctx);
 }
 
 void AArch64RegisterSema::insertInitRegSetCode(Function *InitFn) {
@@ -47,7 +65,8 @@ void AArch64RegisterSema::insertInitRegSetCode(Function *InitFn) {
 
   // put a pointer to the test stack in RSP
   Idx[1] = Builder->getInt32(RegOffsetsInSet[RegLargestSupers[AArch64::SP]]);
-  Builder->CreateStore(RSP, Builder->CreateInBoundsGEP(RegSet, Idx));
+  Builder->CreateStore(getGuestAddr(RSP),
+                       Builder->CreateInBoundsGEP(RegSet, Idx));
   Builder->CreateRetVoid();
 }
 
@@ -112,6 +131,176 @@ void AArch64RegisterSema::onRegisterGet(unsigned RegNo) {
 //    if (RegNo == AArch64::WZR) {
 //        RegVals[RegNo] = Builder->getInt32(0);
 //    }
+  if (RegNo != AArch64::NZCV)
+    return;
+  if (SkipNZCVGet) {
+    SkipNZCVGet = false;
+    return;
+  }
+  if (!PendingNZCV.Result)
+    return;
+
+  // NZCV is read as a whole: materialize the pending flags.
+  const AArch64::NZCVShift Shifts[] = {AArch64::N, AArch64::Z, AArch64::C,
+                                       AArch64::V};
+  Value *NZCV = Builder->getInt32(0);
+  for (AArch64::NZCVShift Shift : Shifts)
+    NZCV = Builder->CreateOr(
+        NZCV, Builder->CreateShl(
+                  Builder->CreateZExt(getNZCVFlag(Shift), Builder->getInt32Ty()),
+                  Shift));
+  clearPendingNZCV();
+  setRegValWithName(RegNo, NZCV);
+}
+
+void AArch64RegisterSema::clearPendingNZCV() {
+  PendingNZCV.Result = PendingNZCV.LHS = PendingNZCV.RHS = nullptr;
+  PendingNZCV.IsAdd = false;
+  std::fill(std::begin(PendingNZCV.Flags), std::end(PendingNZCV.Flags),
+            nullptr);
+}
+
+Value *AArch64RegisterSema::setNZCVLazily(Value *Result, Value *LHS,
+                                          Value *RHS, bool IsAdd) {
+  // As with X86 EFLAGS, we only really need NZCV to have a local value, for
+  // the end of the block to store the flags to.
+  clearPendingNZCV();
+  getReg(AArch64::NZCV);
+  PendingNZCV.Result = Result;
+  PendingNZCV.LHS = LHS;
+  PendingNZCV.RHS = RHS;
+  PendingNZCV.IsAdd = IsAdd;
+  return UndefValue::get(Builder->getInt32Ty());
+}
+
+Value *AArch64RegisterSema::computeNZCVFlag(AArch64::NZCVShift Shift) {
+  Value *Result = PendingNZCV.Result;
+  Value *Zero = Constant::getNullValue(Result->getType());
+  switch (Shift) {
+  case AArch64::N:
+    return Builder->CreateICmpSLT(Result, Zero);
+  case AArch64::Z:
+    return Builder->CreateICmpEQ(Result, Zero);
+  case AArch64::C:
+  case AArch64::V: {
+    if (!PendingNZCV.LHS)
+      return Builder->getFalse();
+    // C is set when the sum carries, or when the subtraction doesn't borrow,
+    // V when either overflows.
+    Intrinsic::ID ID;
+    if (PendingNZCV.IsAdd)
+      ID = Shift == AArch64::C ? Intrinsic::uadd_with_overflow
+                               : Intrinsic::sadd_with_overflow;
+    else
+      ID = Shift == AArch64::C ? Intrinsic::usub_with_overflow
+                               : Intrinsic::ssub_with_overflow;
+    Value *Args[] = {PendingNZCV.LHS, PendingNZCV.RHS};
+    Value *Overflow = Builder->CreateExtractValue(
+        Builder->CreateCall(
+            Intrinsic::getDeclaration(TheModule, ID, Result->getType()), Args),
+        1);
+    if (Shift == AArch64::C && !PendingNZCV.IsAdd)
+      return Builder->CreateNot(Overflow);
+    return Overflow;
+  }
+  }
+  llvm_unreachable("Unknown NZCV flag");
+}
+
+Value *AArch64RegisterSema::getNZCVFlag(AArch64::NZCVShift Shift) {
+  if (!PendingNZCV.Result) {
+    Value *Bit =
+        Builder->CreateAnd(getReg(AArch64::NZCV), Builder->getInt32(1 << Shift));
+    return Builder->CreateICmpNE(Bit, Builder->getInt32(0));
+  }
+  Value *&Flag = PendingNZCV.Flags[Shift - AArch64::V];
+  if (!Flag)
+    Flag = computeNZCVFlag(Shift);
+  return Flag;
+}
+
+Value *AArch64RegisterSema::getFusedCondition(unsigned CC) {
+  // After a sum, e.g. CMN, the conditions don't compare its operands: those
+  // that only read Z and N are just as simple from the flags.
+  if (!PendingNZCV.Result || PendingNZCV.IsAdd)
+    return nullptr;
+
+  CmpInst::Predicate Pred;
+  switch (CC) {
+  default: return nullptr;
+  case AArch64CC::EQ: Pred = CmpInst::ICMP_EQ; break;
+  case AArch64CC::NE: Pred = CmpInst::ICMP_NE; break;
+  case AArch64CC::HS: Pred = CmpInst::ICMP_UGE; break;
+  case AArch64CC::LO: Pred = CmpInst::ICMP_ULT; break;
+  case AArch64CC::HI: Pred = CmpInst::ICMP_UGT; break;
+  case AArch64CC::LS: Pred = CmpInst::ICMP_ULE; break;
+  case AArch64CC::GE: Pred = CmpInst::ICMP_SGE; break;
+  case AArch64CC::LT: Pred = CmpInst::ICMP_SLT; break;
+  case AArch64CC::GT: Pred = CmpInst::ICMP_SGT; break;
+  case AArch64CC::LE: Pred = CmpInst::ICMP_SLE; break;
+  }
+
+  // After a subtraction, e.g. CMP, the condition compares its operands.
+  if (PendingNZCV.LHS)
+    return Builder->CreateICmp(Pred, PendingNZCV.LHS, PendingNZCV.RHS);
+
+  // After a logical operation, C and V are clear: the signed conditions
+  // compare the result to 0, and the unsigned ones are constants, which the
+  // flags give just as well.
+  if (CmpInst::isUnsigned(Pred))
+    return nullptr;
+  Value *Result = PendingNZCV.Result;
+  return Builder->CreateICmp(Pred, Result,
+                             Constant::getNullValue(Result->getType()));
+}
+
+void AArch64RegisterSema::FinalizeBasicBlock() {
+  // This materializes the pending flags, if any, and if they are live.
+  if (!NZCVLiveOut)
+    clearPendingNZCV();
+  DCRegisterSema::FinalizeBasicBlock();
+  clearPendingNZCV();
+  NZCVLiveOut = true;
+}
+
+// AAPCS64: callees read their arguments in X0-X7 and Q0-Q7, the indirect
+// result location in X8, and the frame record, link register and stack
+// pointer.
+static const MCPhysReg CalleeReadRegList[] = {
+    AArch64::X0, AArch64::X1, AArch64::X2, AArch64::X3, AArch64::X4,
+    AArch64::X5, AArch64::X6, AArch64::X7, AArch64::X8, AArch64::FP,
+    AArch64::LR, AArch64::SP, AArch64::Q0, AArch64::Q1, AArch64::Q2,
+    AArch64::Q3, AArch64::Q4, AArch64::Q5, AArch64::Q6, AArch64::Q7};
+
+bool AArch64RegisterSema::isCalleeReadReg(unsigned RegNo) const {
+  for (MCPhysReg Reg : CalleeReadRegList)
+    if (MRI.isSubRegisterEq(RegNo, Reg))
+      return true;
+  return false;
+}
+
+// AAPCS64: callees preserve X19-X28, the frame pointer and the stack pointer.
+// They also preserve the low halves of V8-V15, but the upper halves aren't:
+// all vector registers are considered clobbered.
+// NonVolatileRegistersPass relies on these, too.
+static bool isCalleeSavedGPR(unsigned Reg) {
+  return (Reg >= AArch64::X19 && Reg <= AArch64::X28) || Reg == AArch64::FP ||
+         Reg == AArch64::SP;
+}
+
+bool AArch64RegisterSema::isCallClobberedReg(unsigned RegNo) const {
+  // A register is preserved if it is only made of callee-saved GPRs.
+  const MCRegisterClass &GPRs = MRI.getRegClass(AArch64::GPR64spRegClassID);
+  bool HasGPR = false;
+  for (MCSubRegIterator SRI(RegNo, &MRI, /*IncludeSelf=*/true); SRI.isValid();
+       ++SRI) {
+    if (!GPRs.contains(*SRI))
+      continue;
+    if (!isCalleeSavedGPR(*SRI))
+      return true;
+    HasGPR = true;
+  }
+  return !HasGPR;
 }
 
 Value *AArch64RegisterSema::getReg(unsigned RegNo) {
@@ -125,40 +314,40 @@ Value *AArch64RegisterSema::getReg(unsigned RegNo) {
     if (!RegVals[RegNo]) {
       Value *QQQQ = getRegNoCallback(RegNo + (AArch64::Q0_Q1_Q2_Q3 - AArch64::Q0));
       Value *Q = Builder->CreateTrunc(QQQQ, Builder->getInt128Ty());
-      RegVals[RegNo] = Q;
-      return RegVals[RegNo];
+      setRegVal(RegNo, Q);
+      return Q;
     }
   }
   if (RegNo >= AArch64::D0 && RegNo <= AArch64::D31) {
     if (!RegVals[RegNo]) {
       Value *QQQQ = getRegNoCallback(RegNo + (AArch64::Q0_Q1_Q2_Q3 - AArch64::D0));
       Value *D = Builder->CreateTrunc(QQQQ, Builder->getInt64Ty());
-      RegVals[RegNo] = D;
-      return RegVals[RegNo];
+      setRegVal(RegNo, D);
+      return D;
     }
   }
   if (RegNo >= AArch64::S0 && RegNo <= AArch64::S31) {
     if (!RegVals[RegNo]) {
       Value *QQQQ = getRegNoCallback(RegNo + (AArch64::Q0_Q1_Q2_Q3 - AArch64::S0));
       Value *S = Builder->CreateTrunc(QQQQ, Builder->getInt32Ty());
-      RegVals[RegNo] = S;
-      return RegVals[RegNo];
+      setRegVal(RegNo, S);
+      return S;
     }
   }
   if (RegNo >= AArch64::H0 && RegNo <= AArch64::H31) {
     if (!RegVals[RegNo]) {
       Value *QQQQ = getRegNoCallback(RegNo + (AArch64::Q0_Q1_Q2_Q3 - AArch64::H0));
       Value *H = Builder->CreateTrunc(QQQQ, Builder->getInt16Ty());
-      RegVals[RegNo] = H;
-      return RegVals[RegNo];
+      setRegVal(RegNo, H);
+      return H;
     }
   }
   if (RegNo >= AArch64::B0 && RegNo <= AArch64::B31) {
     if (!RegVals[RegNo]) {
       Value *QQQQ = getRegNoCallback(RegNo + (AArch64::Q0_Q1_Q2_Q3 - AArch64::B0));
       Value *B = Builder->CreateTrunc(QQQQ, Builder->getInt8Ty());
-      RegVals[RegNo] = B;
-      return RegVals[RegNo];
+      setRegVal(RegNo, B);
+      return B;
     }
   }
   if (RegNo >= AArch64::Q0_Q1 && RegNo <= AArch64::Q31_Q0) {
@@ -168,8 +357,8 @@ Value *AArch64RegisterSema::getReg(unsigned RegNo) {
     Value *Reg1 = getReg(AArch64::Q0 + diff1);
     Value *Reg2 = getReg(AArch64::Q0 + diff2);
 
-    Reg1 = Builder->CreateZExt(Reg1, IntegerType::get(getGlobalContext(), 256));
-    Reg2 = Builder->CreateZExt(Reg2, IntegerType::get(getGlobalContext(), 256));
+    Reg1 = Builder->CreateZExt(Reg1, IntegerType::get(*Ctx, 256));
+    Reg2 = Builder->CreateZExt(Reg2, IntegerType::get(*Ctx, 256));
     Reg2 = Builder->CreateShl(Reg2, 128);
 
     return Builder->CreateOr(Reg1, Reg2);
@@ -179,11 +368,11 @@ Value *AArch64RegisterSema::getReg(unsigned RegNo) {
     int64_t diff1 = (RegNo - AArch64::D0_D1) % 32;
     int64_t diff2 = (RegNo - AArch64::D0_D1 + 1) % 32;
 
-    Value *Reg1 = getReg(AArch64::Q0 + diff1);
-    Value *Reg2 = getReg(AArch64::Q0 + diff2);
+    Value *Reg1 = getReg(AArch64::D0 + diff1);
+    Value *Reg2 = getReg(AArch64::D0 + diff2);
 
-    Reg1 = Builder->CreateZExtOrTrunc(Reg1, IntegerType::get(getGlobalContext(), 128));
-    Reg2 = Builder->CreateZExtOrTrunc(Reg2, IntegerType::get(getGlobalContext(), 128));
+    Reg1 = Builder->CreateZExtOrTrunc(Reg1, IntegerType::get(*Ctx, 128));
+    Reg2 = Builder->CreateZExtOrTrunc(Reg2, IntegerType::get(*Ctx, 128));
     Reg2 = Builder->CreateShl(Reg2, 64);
 
     return Builder->CreateOr(Reg1, Reg2);
@@ -198,10 +387,10 @@ Value *AArch64RegisterSema::getReg(unsigned RegNo) {
     Value *Reg2 = getReg(AArch64::Q0 + diff2);
     Value *Reg3 = getReg(AArch64::Q0 + diff3);
 
-    Reg1 = Builder->CreateZExt(Reg1, IntegerType::get(getGlobalContext(), 384));
-    Reg2 = Builder->CreateZExt(Reg2, IntegerType::get(getGlobalContext(), 384));
+    Reg1 = Builder->CreateZExt(Reg1, IntegerType::get(*Ctx, 384));
+    Reg2 = Builder->CreateZExt(Reg2, IntegerType::get(*Ctx, 384));
     Reg2 = Builder->CreateShl(Reg2, 128);
-    Reg3 = Builder->CreateZExt(Reg3, IntegerType::get(getGlobalContext(), 384));
+    Reg3 = Builder->CreateZExt(Reg3, IntegerType::get(*Ctx, 384));
     Reg3 = Builder->CreateShl(Reg3, 256);
 
     return Builder->CreateOr(Reg1, Builder->CreateOr(Reg2, Reg3));
@@ -215,10 +404,10 @@ Value *AArch64RegisterSema::getReg(unsigned RegNo) {
     Value *Reg2 = getReg(AArch64::Q0 + diff2);
     Value *Reg3 = getReg(AArch64::Q0 + diff3);
 
-    Reg1 = Builder->CreateZExt(Reg1, IntegerType::get(getGlobalContext(), 384));
-    Reg2 = Builder->CreateZExt(Reg2, IntegerType::get(getGlobalContext(), 384));
+    Reg1 = Builder->CreateZExt(Reg1, IntegerType::get(*Ctx, 384));
+    Reg2 = Builder->CreateZExt(Reg2, IntegerType::get(*Ctx, 384));
     Reg2 = Builder->CreateShl(Reg2, 128);
-    Reg3 = Builder->CreateZExt(Reg3, IntegerType::get(getGlobalContext(), 384));
+    Reg3 = Builder->CreateZExt(Reg3, IntegerType::get(*Ctx, 384));
     Reg3 = Builder->CreateShl(Reg3, 256);
 
     return Builder->CreateOr(Reg1, Builder->CreateOr(Reg2, Reg3));
@@ -229,14 +418,14 @@ Value *AArch64RegisterSema::getReg(unsigned RegNo) {
     int64_t diff2 = (RegNo - AArch64::D0_D1_D2 + 1) % 32;
     int64_t diff3 = (RegNo - AArch64::D0_D1_D2 + 2) % 32;
 
-    Value *Reg1 = getReg(AArch64::Q0 + diff1);
-    Value *Reg2 = getReg(AArch64::Q0 + diff2);
-    Value *Reg3 = getReg(AArch64::Q0 + diff3);
+    Value *Reg1 = getReg(AArch64::D0 + diff1);
+    Value *Reg2 = getReg(AArch64::D0 + diff2);
+    Value *Reg3 = getReg(AArch64::D0 + diff3);
 
-    Reg1 = Builder->CreateZExt(Reg1, IntegerType::get(getGlobalContext(), 192));
-    Reg2 = Builder->CreateZExt(Reg2, IntegerType::get(getGlobalContext(), 192));
+    Reg1 = Builder->CreateZExt(Reg1, IntegerType::get(*Ctx, 192));
+    Reg2 = Builder->CreateZExt(Reg2, IntegerType::get(*Ctx, 192));
     Reg2 = Builder->CreateShl(Reg2, 64);
-    Reg3 = Builder->CreateZExt(Reg3, IntegerType::get(getGlobalContext(), 192));
+    Reg3 = Builder->CreateZExt(Reg3, IntegerType::get(*Ctx, 192));
     Reg3 = Builder->CreateShl(Reg3, 128);
 
     return Builder->CreateOr(Reg1, Builder->CreateOr(Reg2, Reg3));
@@ -253,12 +442,12 @@ Value *AArch64RegisterSema::getReg(unsigned RegNo) {
     Value *Reg3 = getReg(AArch64::Q0 + diff3);
     Value *Reg4 = getReg(AArch64::Q0 + diff4);
 
-    Reg1 = Builder->CreateZExt(Reg1, IntegerType::get(getGlobalContext(), 512));
-    Reg2 = Builder->CreateZExt(Reg2, IntegerType::get(getGlobalContext(), 512));
+    Reg1 = Builder->CreateZExt(Reg1, IntegerType::get(*Ctx, 512));
+    Reg2 = Builder->CreateZExt(Reg2, IntegerType::get(*Ctx, 512));
     Reg2 = Builder->CreateShl(Reg2, 128);
-    Reg3 = Builder->CreateZExt(Reg3, IntegerType::get(getGlobalContext(), 512));
+    Reg3 = Builder->CreateZExt(Reg3, IntegerType::get(*Ctx, 512));
     Reg3 = Builder->CreateShl(Reg3, 256);
-    Reg4 = Builder->CreateZExt(Reg4, IntegerType::get(getGlobalContext(), 512));
+    Reg4 = Builder->CreateZExt(Reg4, IntegerType::get(*Ctx, 512));
     Reg4 = Builder->CreateShl(Reg4, 384);
 
     return Builder->CreateOr(Reg1, Builder->CreateOr(Reg2, Builder->CreateOr(Reg3, Reg4)));
@@ -270,17 +459,17 @@ Value *AArch64RegisterSema::getReg(unsigned RegNo) {
     int64_t diff3 = (RegNo - AArch64::D0_D1_D2_D3 + 2) % 32;
     int64_t diff4 = (RegNo - AArch64::D0_D1_D2_D3 + 3) % 32;
 
-    Value *Reg1 = getReg(AArch64::Q0 + diff1);
-    Value *Reg2 = getReg(AArch64::Q0 + diff2);
-    Value *Reg3 = getReg(AArch64::Q0 + diff3);
-    Value *Reg4 = getReg(AArch64::Q0 + diff4);
+    Value *Reg1 = getReg(AArch64::D0 + diff1);
+    Value *Reg2 = getReg(AArch64::D0 + diff2);
+    Value *Reg3 = getReg(AArch64::D0 + diff3);
+    Value *Reg4 = getReg(AArch64::D0 + diff4);
 
-    Reg1 = Builder->CreateZExt(Reg1, IntegerType::get(getGlobalContext(), 256));
-    Reg2 = Builder->CreateZExt(Reg2, IntegerType::get(getGlobalContext(), 256));
+    Reg1 = Builder->CreateZExt(Reg1, IntegerType::get(*Ctx, 256));
+    Reg2 = Builder->CreateZExt(Reg2, IntegerType::get(*Ctx, 256));
     Reg2 = Builder->CreateShl(Reg2, 64);
-    Reg3 = Builder->CreateZExt(Reg3, IntegerType::get(getGlobalContext(), 256));
+    Reg3 = Builder->CreateZExt(Reg3, IntegerType::get(*Ctx, 256));
     Reg3 = Builder->CreateShl(Reg3, 128);
-    Reg4 = Builder->CreateZExt(Reg4, IntegerType::get(getGlobalContext(), 256));
+    Reg4 = Builder->CreateZExt(Reg4, IntegerType::get(*Ctx, 256));
     Reg4 = Builder->CreateShl(Reg4, 192);
 
     return Builder->CreateOr(Reg1, Builder->CreateOr(Reg2, Builder->CreateOr(Reg3, Reg4)));
@@ -289,6 +478,12 @@ Value *AArch64RegisterSema::getReg(unsigned RegNo) {
 }
 
 void AArch64RegisterSema::setReg(unsigned RegNo, Value *Val) {
+  if (RegNo == AArch64::NZCV) {
+    // The flags are pending, see setNZCVLazily.
+    if (PendingNZCV.Result && isa<UndefValue>(Val))
+      return;
+    clearPendingNZCV();
+  }
   if (RegNo == 0) {
     //FIXME: possibly PC
     DEBUG(errs() << utohexstr(CurrentInst->Address) << ": Register 0 set (PC???)\n");
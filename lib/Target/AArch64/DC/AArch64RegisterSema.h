@@ -6,12 +6,53 @@
 #include "llvm/ADT/SmallVector.h"
 
 namespace llvm {
+    namespace AArch64 {
+        // The bit of each flag in NZCV.
+        enum NZCVShift {
+            N = 31,
+            Z = 30,
+            C = 29,
+            V = 28,
+        };
+    }
+
     class AArch64RegisterSema : public DCRegisterSema {
     public:
       AArch64RegisterSema(const MCRegisterInfo &MRI,
                       const MCInstrInfo &MII,
                       const DataLayout &DL);
 
+      // Define NZCV lazily, as the flags of \p Result, the difference of \p LHS
+      // and \p RHS, or their sum if \p IsAdd, or, if they are null, a logical
+      // result, which clears C and V. Only the flags read with getNZCVFlag are
+      // computed: NZCV itself is, only when read as a whole, or at the end of
+      // the basic block.
+      // Returns the value the semantics put in NZCV, which stands for the
+      // pending flags.
+      Value *setNZCVLazily(Value *Result, Value *LHS, Value *RHS,
+                           bool IsAdd = false);
+
+      // Get the flag of NZCV at bit \p Shift, as an i1.
+      Value *getNZCVFlag(AArch64::NZCVShift Shift);
+
+      // Get the condition \p CC, an AArch64CC::CondCode, as a single icmp of
+      // the operands the flags are pending for, or null if it can't be, e.g.
+      // when the flags aren't pending, or are those of a sum. The flags aren't
+      // computed.
+      Value *getFusedCondition(unsigned CC);
+
+      // Set whether NZCV is live out of the current basic block: if it isn't,
+      // the pending flags are dropped at its end, rather than materialized.
+      // It is, by default, for each block.
+      void setNZCVLiveOut(bool LiveOut) { NZCVLiveOut = LiveOut; }
+
+      // Don't materialize the pending flags for the next read of NZCV: the
+      // semantics read it after each condition code, which already has the
+      // flags it needs, and don't use it.
+      void skipNextNZCVGet() { SkipNZCVGet = true; }
+
+      virtual void FinalizeBasicBlock() override;
+
       virtual void insertInitRegSetCode(Function *InitFn);
       virtual void insertFiniRegSetCode(Function *FiniFn);
 
@@ -24,10 +65,35 @@ namespace llvm {
 
         virtual void onRegisterGet(unsigned RegNo) override;
 
+        virtual bool isCalleeReadReg(unsigned RegNo) const override;
+
+        virtual bool isCallClobberedReg(unsigned RegNo) const override;
+
+        virtual unsigned getStackPointerReg() const override {
+          return AArch64::SP;
+        }
+
     public:
+        // BL and RET keep the return address in LR.
+        virtual bool doCallsUseStack() const override { return false; }
+
         virtual Value *getReg(unsigned RegNo) override;
 
         virtual void setReg(unsigned RegNo, Value *Val) override;
+
+    private:
+        // The operation NZCV is pending for, see setNZCVLazily, if Result
+        // isn't null, and the flags computed from it so far.
+        struct PendingNZCVTy {
+            Value *Result, *LHS, *RHS;
+            bool IsAdd;
+            Value *Flags[4];
+        } PendingNZCV;
+        bool NZCVLiveOut;
+        bool SkipNZCVGet;
+
+        void clearPendingNZCV();
+        Value *computeNZCVFlag(AArch64::NZCVShift Shift);
     };
 }
 
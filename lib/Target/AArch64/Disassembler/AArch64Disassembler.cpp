@@ -17,6 +17,7 @@
 #include "Utils/AArch64BaseInfo.h"
 #include "llvm/MC/MCFixedLenDisassembler.h"
 #include "llvm/MC/MCInst.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/TargetRegistry.h"
@@ -25,6 +26,14 @@ using namespace llvm;
 
 #define DEBUG_TYPE "aarch64-disassembler"
 
+// The instructions with FP or SIMD operands are disassembled as PHIs, which
+// the CFG builder counts and the translation skips, unless this is set.
+static cl::opt<bool>
+DecodeFPSIMD("aarch64-decode-fp-simd",
+             cl::desc("Disassemble the AArch64 instructions with FP or SIMD "
+                      "operands, rather than as PHIs"),
+             cl::init(false), cl::Hidden);
+
 // Pull DecodeStatus and its enum values into the global namespace.
 typedef llvm::MCDisassembler::DecodeStatus DecodeStatus;
 
@@ -180,7 +189,7 @@ static DecodeStatus DecodeXSeqPairsClassRegisterClass(MCInst &Inst,
 
 static void TagNoneGeneralOperand(MCInst &Inst)
 {
-//    if (OptimizeOption)   //How to deliver this argument?
+    if (!DecodeFPSIMD)
         Inst.setOpcode(AArch64::PHI);
 }
 
@@ -229,8 +238,9 @@ DecodeStatus AArch64Disassembler::getInstruction(MCInst &MI, uint64_t &Size,
   uint32_t Insn =
       (Bytes[3] << 24) | (Bytes[2] << 16) | (Bytes[1] << 8) | (Bytes[0] << 0);
 
-  // Calling the auto-generated decoder function.
-  return decodeInstruction(DecoderTable32, MI, Insn, Address, this, STI);
+  // Calling the auto-generated decoder function, the decoder table compiled
+  // by -direct-dispatch-decoder.
+  return decodeDirect32(MI, Insn, Address, this, STI);
 }
 
 static MCSymbolizer *
@@ -1304,6 +1314,9 @@ static DecodeStatus DecodePairLdStInstruction(llvm::MCInst &Inst, uint32_t insn,
   case AArch64::STPQpre:
     DecodeFPR128RegisterClass(Inst, Rt, Addr, Decoder);
     DecodeFPR128RegisterClass(Inst, Rt2, Addr, Decoder);
+    // The Q and D register pairs are translated, as vector accesses: they
+    // keep their opcode.
+    Inst.setOpcode(Opcode);
     break;
   case AArch64::LDNPDi:
   case AArch64::STNPDi:
@@ -1315,6 +1328,7 @@ static DecodeStatus DecodePairLdStInstruction(llvm::MCInst &Inst, uint32_t insn,
   case AArch64::STPDpre:
     DecodeFPR64RegisterClass(Inst, Rt, Addr, Decoder);
     DecodeFPR64RegisterClass(Inst, Rt2, Addr, Decoder);
+    Inst.setOpcode(Opcode);
     break;
   case AArch64::LDNPSi:
   case AArch64::STNPSi:
@@ -16,13 +16,17 @@
 #include "AArch64ELFStreamer.h"
 #include "AArch64MCAsmInfo.h"
 #include "InstPrinter/AArch64InstPrinter.h"
+#include "MCTargetDesc/AArch64AddressingModes.h"
+#include "Utils/AArch64BaseInfo.h"
 #include "llvm/MC/MCCodeGenInfo.h"
 #include "llvm/MC/MCInstrAnalysis.h"
 #include "llvm/MC/MCInstrInfo.h"
 #include "llvm/MC/MCRegisterInfo.h"
 #include "llvm/MC/MCStreamer.h"
 #include "llvm/MC/MCSubtargetInfo.h"
+#include "llvm/Support/Endian.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/TargetRegistry.h"
 
 using namespace llvm;
@@ -36,6 +40,94 @@ using namespace llvm;
 #define GET_REGINFO_MC_DESC
 #include "AArch64GenRegisterInfo.inc"
 
+// Find the last of the first \p End instructions of \p Insts that writes
+// \p Reg, or its W sub-register, or return -1.
+static int findRegDef(ArrayRef<MCInst> Insts, const MCInstrInfo &MII,
+                      int End, unsigned Reg) {
+  const unsigned WReg = getWRegFromXReg(Reg);
+  for (int I = End - 1; I >= 0; --I) {
+    const MCInst &Inst = Insts[I];
+    if (!MII.get(Inst.getOpcode()).getNumDefs() || !Inst.getNumOperands() ||
+        !Inst.getOperand(0).isReg())
+      continue;
+    const unsigned Def = Inst.getOperand(0).getReg();
+    if (Def == Reg || Def == WReg)
+      return I;
+  }
+  return -1;
+}
+
+// Evaluate the address \p Reg holds before the instruction \p End of
+// \p Insts, when it is built with ADR, or with ADRP and an ADD of the offset
+// in the page.
+static bool evaluateAddress(ArrayRef<MCInst> Insts, ArrayRef<uint64_t> Addrs,
+                            const MCInstrInfo &MII, int End, unsigned Reg,
+                            uint64_t &Addr) {
+  const int I = findRegDef(Insts, MII, End, Reg);
+  if (I < 0)
+    return false;
+  const MCInst &Inst = Insts[I];
+  switch (Inst.getOpcode()) {
+  case AArch64::ADR:
+    if (!Inst.getOperand(1).isImm())
+      return false;
+    Addr = Addrs[I] + Inst.getOperand(1).getImm();
+    return true;
+  case AArch64::ADRP:
+    if (!Inst.getOperand(1).isImm())
+      return false;
+    Addr = (Addrs[I] & ~UINT64_C(0xfff)) + Inst.getOperand(1).getImm() * 4096;
+    return true;
+  case AArch64::ADDXri: {
+    uint64_t Base;
+    if (!Inst.getOperand(2).isImm() ||
+        !evaluateAddress(Insts, Addrs, MII, I, Inst.getOperand(1).getReg(),
+                         Base))
+      return false;
+    Addr = Base + (Inst.getOperand(2).getImm() << Inst.getOperand(3).getImm());
+    return true;
+  }
+  }
+  return false;
+}
+
+// Find the number of entries of a jump table indexed by \p Index, before the
+// instruction \p End of \p Insts, from the bounds check that branches away
+// from it: a compare with an immediate, then a b.hi or b.hs.
+static uint64_t findJumpTableBound(ArrayRef<MCInst> Insts,
+                                   const MCInstrInfo &MII, int End,
+                                   unsigned Index) {
+  const int IndexDef = findRegDef(Insts, MII, End, Index);
+  for (int I = End - 1; I > 0 && I > IndexDef; --I) {
+    const MCInst &Br = Insts[I];
+    if (Br.getOpcode() != AArch64::Bcc)
+      continue;
+    const MCInst &Cmp = Insts[I - 1];
+    if ((Cmp.getOpcode() != AArch64::SUBSWri &&
+         Cmp.getOpcode() != AArch64::SUBSXri) ||
+        !Cmp.getOperand(2).isImm() || Cmp.getOperand(3).getImm() != 0)
+      return 0;
+    const unsigned Reg = Cmp.getOperand(1).getReg();
+    if (Reg != Index && Reg != getWRegFromXReg(Index))
+      return 0;
+    const uint64_t Imm = Cmp.getOperand(2).getImm();
+    switch (Br.getOperand(0).getImm()) {
+    case AArch64CC::HI: return Imm + 1;
+    case AArch64CC::HS: return Imm;
+    }
+    return 0;
+  }
+  return 0;
+}
+
+// AAPCS64: callees preserve X19-X28, the frame pointer, and the low halves
+// of V8-V15. The link register is saved along with the frame pointer, in the
+// frame record.
+static bool isCalleeSavedSpillReg(unsigned Reg) {
+  return (Reg >= AArch64::X19 && Reg <= AArch64::X28) || Reg == AArch64::FP ||
+         Reg == AArch64::LR || (Reg >= AArch64::D8 && Reg <= AArch64::D15);
+}
+
 namespace llvm {
     namespace AArch64 {
         class AArch64MMCInstrAnalysis : public MCInstrAnalysis {
@@ -88,6 +180,102 @@ namespace llvm {
                 }
                 return MCInstrAnalysis::evaluateBranch(Inst, Addr, Size, Target);
             }
+            // The address computations, and the literal loads, whose
+            // offset is in words.
+            bool evaluatePCRelativeAddress(const MCInst &Inst, uint64_t Addr,
+                                           uint64_t Size, unsigned &OpIdx,
+                                           uint64_t &Target) const override {
+                if (Inst.getNumOperands() < 2 || !Inst.getOperand(1).isImm())
+                    return false;
+                const int64_t Imm = Inst.getOperand(1).getImm();
+                switch (Inst.getOpcode()) {
+                case AArch64::ADR:
+                    Target = Addr + Imm;
+                    break;
+                case AArch64::ADRP:
+                    Target = (Addr & ~UINT64_C(0xfff)) + Imm * 4096;
+                    break;
+                case AArch64::LDRWl:
+                case AArch64::LDRXl:
+                case AArch64::LDRSl:
+                case AArch64::LDRDl:
+                case AArch64::LDRQl:
+                case AArch64::LDRSWl:
+                case AArch64::PRFMl:
+                    Target = Addr + Imm * 4;
+                    break;
+                default:
+                    return false;
+                }
+                OpIdx = 1;
+                return true;
+            }
+            // Recognize the jump tables of switches, as compilers lower them:
+            //   adrp xT, table@PAGE
+            //   add  xT, xT, table@PAGEOFF
+            //   (adr xB, base)
+            //   ldrsw xE, [xT, xI, lsl #2]   (or ldrh, ldrb)
+            //   add  xD, xB, xE (, lsl #2)
+            //   br   xD
+            // where the base is the table itself unless it is set with adr.
+            bool evaluateJumpTable(ArrayRef<MCInst> Insts,
+                                   ArrayRef<uint64_t> Addrs,
+                                   JumpTable &JT) const override {
+                const int BrIdx = int(Insts.size()) - 1;
+                if (BrIdx < 0 || Insts[BrIdx].getOpcode() != AArch64::BR)
+                    return false;
+                const int AddIdx = findRegDef(Insts, *Info, BrIdx,
+                                              Insts[BrIdx].getOperand(0).getReg());
+                if (AddIdx < 0 || Insts[AddIdx].getOpcode() != AArch64::ADDXrs)
+                    return false;
+                const MCInst &Add = Insts[AddIdx];
+                const unsigned Shifter = Add.getOperand(3).getImm();
+                if (AArch64_AM::getShiftType(Shifter) != AArch64_AM::LSL)
+                    return false;
+                JT.EntryShift = AArch64_AM::getShiftValue(Shifter);
+
+                // The shifted operand is the entry; without a shift, it can
+                // be either.
+                for (unsigned EntryOp = 2; EntryOp >= 1; --EntryOp) {
+                    if (EntryOp == 1 && JT.EntryShift)
+                        break;
+                    const unsigned EntryReg = Add.getOperand(EntryOp).getReg();
+                    const unsigned BaseReg = Add.getOperand(3 - EntryOp).getReg();
+                    const int LoadIdx = findRegDef(Insts, *Info, AddIdx, EntryReg);
+                    if (LoadIdx < 0)
+                        continue;
+                    const MCInst &Load = Insts[LoadIdx];
+                    switch (Load.getOpcode()) {
+                    case AArch64::LDRSWroX:
+                    case AArch64::LDRSWroW:
+                        JT.EntrySize = 4;
+                        JT.SignedEntries = true;
+                        break;
+                    case AArch64::LDRHHroX:
+                    case AArch64::LDRHHroW:
+                        JT.EntrySize = 2;
+                        JT.SignedEntries = false;
+                        break;
+                    case AArch64::LDRBBroX:
+                    case AArch64::LDRBBroW:
+                        JT.EntrySize = 1;
+                        JT.SignedEntries = false;
+                        break;
+                    default:
+                        continue;
+                    }
+                    if (!evaluateAddress(Insts, Addrs, *Info, LoadIdx,
+                                         Load.getOperand(1).getReg(),
+                                         JT.TableAddr) ||
+                        !evaluateAddress(Insts, Addrs, *Info, AddIdx, BaseReg,
+                                         JT.Base))
+                        continue;
+                    JT.NumEntries = findJumpTableBound(
+                        Insts, *Info, LoadIdx, Load.getOperand(2).getReg());
+                    return true;
+                }
+                return false;
+            }
             virtual bool isCall(const MCInst &Inst) const {
                 switch (Inst.getOpcode()) {
                     case AArch64::BL: {
@@ -99,6 +287,219 @@ namespace llvm {
                 }
                 return false;
             }
+            // BL is 100101 followed by imm26. The words are matched 64 at a
+            // time into a mask first, a loop the compiler vectorizes, and the
+            // targets only computed for the matches.
+            bool findDirectCallTargets(
+                ArrayRef<uint8_t> Bytes, uint64_t Addr,
+                std::vector<uint64_t> &Targets) const override {
+                const size_t NumWords = Bytes.size() / 4;
+                uint32_t Words[64];
+                for (size_t Begin = 0; Begin < NumWords; Begin += 64) {
+                    const size_t N = std::min<size_t>(64, NumWords - Begin);
+                    const uint8_t *P = Bytes.data() + 4 * Begin;
+                    uint64_t Matches = 0;
+                    for (size_t I = 0; I != N; ++I) {
+                        Words[I] = support::endian::read32le(P + 4 * I);
+                        Matches |= uint64_t((Words[I] >> 26) == 0x25) << I;
+                    }
+                    while (Matches) {
+                        const unsigned I = countTrailingZeros(Matches);
+                        Matches &= Matches - 1;
+                        Targets.push_back(
+                            Addr + 4 * (Begin + I) +
+                            SignExtend64<26>(Words[I] & 0x3ffffff) * 4);
+                    }
+                }
+                return true;
+            }
+            Classification classify(const MCInst &Inst, uint64_t Addr,
+                                    uint64_t Size) const override {
+                Classification C = MCInstrAnalysis::classify(Inst, Addr, Size);
+                // As isCall: only BL and BLR.
+                if (AArch64MMCInstrAnalysis::isCall(Inst)) {
+                    C.Flags |= Classification::Call;
+                } else {
+                    C.Flags &= ~Classification::Call;
+                    if (!C.isBranch())
+                        C.Flags &= ~Classification::HasTarget;
+                }
+                return C;
+            }
+            // The saves and restores of the prologues and epilogues:
+            //   stp x29, x30, [sp, #-16]!    ldp x29, x30, [sp], #16
+            //   stp x20, x19, [sp, #16]      ldp x20, x19, [sp, #16]
+            //   str x21, [sp, #8]            ldr x21, [sp, #8]
+            // and the same with D registers.
+            bool evaluateStackSpill(const MCInst &Inst,
+                                    StackSpill &S) const override {
+                // The operand of the first register, and whether there is a
+                // writeback, before it, and a second register, after it.
+                unsigned RegOp = 0;
+                bool Pair = false, Pre = false, Post = false;
+                S.IsLoad = false;
+                S.RegSize = 8;
+                switch (Inst.getOpcode()) {
+                case AArch64::STPXpre: case AArch64::STPDpre:
+                    RegOp = 1; Pair = true; Pre = true; break;
+                case AArch64::STPXi: case AArch64::STPDi:
+                    Pair = true; break;
+                case AArch64::STRXpre: case AArch64::STRDpre:
+                    RegOp = 1; Pre = true; break;
+                case AArch64::STRXui: case AArch64::STRDui:
+                    break;
+                case AArch64::LDPXpost: case AArch64::LDPDpost:
+                    RegOp = 1; Pair = true; Post = true; S.IsLoad = true; break;
+                case AArch64::LDPXi: case AArch64::LDPDi:
+                    Pair = true; S.IsLoad = true; break;
+                case AArch64::LDRXpost: case AArch64::LDRDpost:
+                    RegOp = 1; Post = true; S.IsLoad = true; break;
+                case AArch64::LDRXui: case AArch64::LDRDui:
+                    S.IsLoad = true; break;
+                default:
+                    return false;
+                }
+                S.NumRegs = Pair ? 2 : 1;
+                const unsigned BaseOp = RegOp + S.NumRegs;
+                S.BaseReg = Inst.getOperand(BaseOp).getReg();
+                if (S.BaseReg != AArch64::SP)
+                    return false;
+                for (unsigned I = 0; I != S.NumRegs; ++I) {
+                    S.Regs[I] = Inst.getOperand(RegOp + I).getReg();
+                    if (!isCalleeSavedSpillReg(S.Regs[I]))
+                        return false;
+                }
+                // The pairs and the unsigned offsets are scaled, the pre-
+                // and post-indexed single registers aren't.
+                int64_t Imm = Inst.getOperand(BaseOp + 1).getImm();
+                if (Pair || (!Pre && !Post))
+                    Imm *= S.RegSize;
+                S.Offset = Post ? 0 : Imm;
+                S.SPAdjust = Pre || Post ? Imm : 0;
+                return true;
+            }
+            bool evaluateStackAdjust(const MCInst &Inst,
+                                     int64_t &Adjust) const override {
+                const unsigned Opc = Inst.getOpcode();
+                if ((Opc != AArch64::ADDXri && Opc != AArch64::SUBXri) ||
+                    Inst.getOperand(0).getReg() != AArch64::SP ||
+                    Inst.getOperand(1).getReg() != AArch64::SP)
+                    return false;
+                Adjust = Inst.getOperand(2).getImm()
+                         << AArch64_AM::getShiftValue(
+                                Inst.getOperand(3).getImm());
+                if (Opc == AArch64::SUBXri)
+                    Adjust = -Adjust;
+                return true;
+            }
+            // The pairs of registers at a scaled offset from a base:
+            //   ldp q0, q1, [x1, #32]        stp xzr, xzr, [x0, #16]
+            bool evaluateMemoryPair(const MCInst &Inst,
+                                    MemoryPair &P) const override {
+                P.IsLoad = false;
+                switch (Inst.getOpcode()) {
+                case AArch64::LDPWi: case AArch64::LDPSi:
+                    P.IsLoad = true; P.RegSize = 4; break;
+                case AArch64::LDPXi: case AArch64::LDPDi:
+                    P.IsLoad = true; P.RegSize = 8; break;
+                case AArch64::LDPQi:
+                    P.IsLoad = true; P.RegSize = 16; break;
+                case AArch64::STPWi: case AArch64::STPSi:
+                    P.RegSize = 4; break;
+                case AArch64::STPXi: case AArch64::STPDi:
+                    P.RegSize = 8; break;
+                case AArch64::STPQi:
+                    P.RegSize = 16; break;
+                default:
+                    return false;
+                }
+                P.Regs[0] = Inst.getOperand(0).getReg();
+                P.Regs[1] = Inst.getOperand(1).getReg();
+                P.BaseReg = Inst.getOperand(2).getReg();
+                P.Offset = Inst.getOperand(3).getImm() * P.RegSize;
+                P.StoresZero = !P.IsLoad &&
+                               (P.Regs[0] == AArch64::XZR ||
+                                P.Regs[0] == AArch64::WZR) &&
+                               P.Regs[1] == P.Regs[0];
+                return true;
+            }
+            // The address computations and pointer loads of calls:
+            //   adrp x8, sym@PAGE           movz x8, #0x1234, lsl #16
+            //   add  x8, x8, sym@PAGEOFF    movk x8, #0x5678
+            //   ldr  x9, [x8, #16]          mov  x9, x8
+            bool evaluateConstantDef(const MCInst &Inst, uint64_t Addr,
+                                     uint64_t Size,
+                                     ConstantDef &D) const override {
+                unsigned OpIdx;
+                uint64_t Target;
+                if (evaluatePCRelativeAddress(Inst, Addr, Size, OpIdx,
+                                              Target)) {
+                    if (Inst.getOpcode() != AArch64::ADR &&
+                        Inst.getOpcode() != AArch64::ADRP)
+                        return false;
+                    D.Kind = ConstantDef::Value;
+                    D.DefReg = Inst.getOperand(0).getReg();
+                    D.Imm = Target;
+                    return true;
+                }
+                D.SrcReg = 0;
+                switch (Inst.getOpcode()) {
+                case AArch64::MOVZXi:
+                case AArch64::MOVNXi: {
+                    uint64_t Imm = uint64_t(Inst.getOperand(1).getImm())
+                                   << Inst.getOperand(2).getImm();
+                    D.Kind = ConstantDef::Value;
+                    D.Imm = Inst.getOpcode() == AArch64::MOVNXi ? ~Imm : Imm;
+                    break;
+                }
+                case AArch64::MOVKXi: {
+                    const unsigned Shift = Inst.getOperand(3).getImm();
+                    D.Kind = ConstantDef::Insert;
+                    D.SrcReg = Inst.getOperand(1).getReg();
+                    D.Imm = uint64_t(Inst.getOperand(2).getImm()) << Shift;
+                    D.Mask = UINT64_C(0xffff) << Shift;
+                    break;
+                }
+                case AArch64::ADDXri:
+                case AArch64::SUBXri: {
+                    int64_t Imm = Inst.getOperand(2).getImm()
+                                  << AArch64_AM::getShiftValue(
+                                         Inst.getOperand(3).getImm());
+                    D.Kind = ConstantDef::Add;
+                    D.SrcReg = Inst.getOperand(1).getReg();
+                    D.Imm = Inst.getOpcode() == AArch64::SUBXri ? -Imm : Imm;
+                    break;
+                }
+                case AArch64::ORRXrs:
+                    // mov xD, xS
+                    if (Inst.getOperand(1).getReg() != AArch64::XZR ||
+                        Inst.getOperand(3).getImm() != 0)
+                        return false;
+                    D.Kind = ConstantDef::Add;
+                    D.SrcReg = Inst.getOperand(2).getReg();
+                    D.Imm = 0;
+                    break;
+                case AArch64::LDRXui:
+                    D.Kind = ConstantDef::Load;
+                    D.SrcReg = Inst.getOperand(1).getReg();
+                    D.Imm = Inst.getOperand(2).getImm() * 8;
+                    break;
+                default:
+                    return false;
+                }
+                D.DefReg = Inst.getOperand(0).getReg();
+                // The zero register isn't set, and the stack pointer isn't
+                // a constant.
+                if (D.DefReg == AArch64::XZR || D.DefReg == AArch64::SP ||
+                    D.SrcReg == AArch64::SP)
+                    return false;
+                return true;
+            }
+            // All the returns have side effects, and RET_ReallyLR is a
+            // codegen pseudo.
+            virtual unsigned getReturnOpcode() const {
+                return AArch64::RET;
+            }
         };
     }
 }
@@ -354,6 +354,18 @@ public:
     return MCInstrAnalysis::isConditionalBranch(Inst);
   }
 
+  Classification classify(const MCInst &Inst, uint64_t Addr,
+                          uint64_t Size) const override {
+    Classification C = MCInstrAnalysis::classify(Inst, Addr, Size);
+    // As isConditionalBranch and isUnconditionalBranch.
+    if (Inst.getOpcode() == ARM::Bcc &&
+        Inst.getOperand(1).getImm() == ARMCC::AL) {
+      C.Flags &= ~Classification::ConditionalBranch;
+      C.Flags |= Classification::UnconditionalBranch;
+    }
+    return C;
+  }
+
   bool evaluateBranch(const MCInst &Inst, uint64_t Addr,
                       uint64_t Size, uint64_t &Target) const override {
     // We only handle PCRel branches for now.
@@ -10,7 +10,9 @@ DCInstrSema *createX86DCInstrSema(StringRef TT,
                                   const MCInstrInfo &MII) {
   (void)MRI;
   (void)MII;
-  return new X86InstrSema(DRS);
+  DCInstrSema *DIS = new X86InstrSema(DRS);
+  DIS->setTargetTriple(TT);
+  return DIS;
 }
 
 DCRegisterSema *createX86DCRegisterSema(StringRef TT,
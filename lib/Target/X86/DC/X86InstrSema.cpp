@@ -37,9 +37,26 @@ using namespace llvm;
 
 X86InstrSema::X86InstrSema(DCRegisterSema &DRS)
     : DCInstrSema(X86::OpcodeToSemaIdx, X86::InstSemantics, X86::ConstantArray,
-                  DRS),
+                  X86::SemanticsHash, DRS),
       X86DRS((X86RegisterSema &)DRS), LastPrefix(0) {}
 
+static const unsigned X86IntArgRegs[] = {X86::RDI, X86::RSI, X86::RDX,
+                                         X86::RCX, X86::R8,  X86::R9};
+static const unsigned X86FPArgRegs[] = {X86::XMM0, X86::XMM1, X86::XMM2,
+                                        X86::XMM3, X86::XMM4, X86::XMM5,
+                                        X86::XMM6, X86::XMM7};
+
+bool X86InstrSema::getExternalCallRegs(ExternalCallRegs &Regs) const {
+  Regs.IntArgRegs = X86IntArgRegs;
+  Regs.FPArgRegs = X86FPArgRegs;
+  Regs.IntResultReg = X86::RAX;
+  Regs.FPResultReg = X86::XMM0;
+  // call pushes the return address, that the callee's ret pops.
+  Regs.StackPtrReg = X86::RSP;
+  Regs.ReturnAddrSize = 8;
+  return true;
+}
+
 bool X86InstrSema::translateTargetInst() {
   unsigned Opcode = CurrentInst->Inst.getOpcode();
 
@@ -162,8 +179,8 @@ bool X86InstrSema::translateTargetInst() {
       case X86::MOVSB: SizeInBits = 8;  break;
       }
       Type *MemTy = Type::getIntNPtrTy(Builder->getContext(), SizeInBits);
-      Value *Dst = Builder->CreateIntToPtr(getReg(X86::RDI), MemTy);
-      Value *Src = Builder->CreateIntToPtr(getReg(X86::RSI), MemTy);
+      Value *Dst = getGuestPtr(getReg(X86::RDI), MemTy);
+      Value *Src = getGuestPtr(getReg(X86::RSI), MemTy);
       Value *Len = getReg(X86::RCX);
       // FIXME: Add support for reverse copying, depending on Direction Flag.
       // We don't support CLD/STD yet anyway, so this isn't a big deal for now.
@@ -204,29 +221,39 @@ bool X86InstrSema::translateTargetInst() {
   case X86::CPUID: {
     // FIXME: There's no reason to have a function, this is just a hack to get
     // it working.
-    Builder->CreateCall(Intrinsic::getDeclaration(TheModule, Intrinsic::trap));
+    Builder->CreateCall(getTrapFunction());
     Builder->CreateUnreachable();
     return true;
   }
   case X86::XGETBV: {
     // FIXME: XCR[0] support is missing, they're not even in X86RegisterInfo.td
-    Builder->CreateCall(Intrinsic::getDeclaration(TheModule, Intrinsic::trap));
+    Builder->CreateCall(getTrapFunction());
     Builder->CreateUnreachable();
     return true;
   }
   case X86::XSAVE: {
     // FIXME: See XGETBV.
-    Builder->CreateCall(Intrinsic::getDeclaration(TheModule, Intrinsic::trap));
+    Builder->CreateCall(getTrapFunction());
     Builder->CreateUnreachable();
     return true;
   }
   case X86::XRSTOR: {
     // FIXME: See XGETBV.
-    Builder->CreateCall(Intrinsic::getDeclaration(TheModule, Intrinsic::trap));
+    Builder->CreateCall(getTrapFunction());
     Builder->CreateUnreachable();
     return true;
   }
 
+  case X86::PALIGNR128rr:
+  case X86::PALIGNR128rm:
+  case X86::VPALIGNR128rr:
+  case X86::VPALIGNR128rm:
+  case X86::VPALIGNR256rr:
+  case X86::VPALIGNR256rm:
+    // The PALIGNR patterns have their sources swapped, and have no semantics.
+    translatePALIGNR(Opcode);
+    return true;
+
   case X86::REP_PREFIX:
   case X86::LOCK_PREFIX: {
     LastPrefix = Opcode;
@@ -478,7 +505,6 @@ void X86InstrSema::translateTargetOpcode() {
     Value *Src2 = getNextOperand();
     unsigned MaskImm = cast<ConstantInt>(getNextOperand())->getZExtValue();
     SmallVector<int, 8> Mask;
-    DecodePSHUFMask(ResEVT.getSimpleVT(), MaskImm, Mask);
     switch (Opcode) {
     case X86ISD::SHUFP:
       DecodeSHUFPMask(ResEVT.getSimpleVT(), MaskImm, Mask); break;
@@ -492,6 +518,193 @@ void X86InstrSema::translateTargetOpcode() {
   case X86ISD::HADD:  translateHorizontalBinop(Instruction::Add);  break;
   case X86ISD::FHSUB: translateHorizontalBinop(Instruction::FSub); break;
   case X86ISD::FHADD: translateHorizontalBinop(Instruction::FAdd); break;
+
+  case X86ISD::PCMPEQ:
+  case X86ISD::PCMPGT: {
+    Value *Src1 = getNextOperand(), *Src2 = getNextOperand();
+    Value *Cmp = Opcode == X86ISD::PCMPEQ ? Builder->CreateICmpEQ(Src1, Src2)
+                                          : Builder->CreateICmpSGT(Src1, Src2);
+    registerResult(Builder->CreateSExt(Cmp, Src1->getType()));
+    break;
+  }
+  case X86ISD::ANDNP: {
+    Value *Src1 = getNextOperand(), *Src2 = getNextOperand();
+    registerResult(Builder->CreateAnd(Builder->CreateNot(Src1), Src2));
+    break;
+  }
+  case X86ISD::PSIGN: {
+    Value *Src1 = getNextOperand(), *Src2 = getNextOperand();
+    Value *Zero = Constant::getNullValue(Src1->getType());
+    Value *Res = Builder->CreateSelect(Builder->CreateICmpSLT(Src2, Zero),
+                                       Builder->CreateNeg(Src1), Src1);
+    registerResult(
+        Builder->CreateSelect(Builder->CreateICmpEQ(Src2, Zero), Zero, Res));
+    break;
+  }
+  case X86ISD::PMULUDQ:
+  case X86ISD::PMULDQ: {
+    // The low doublewords of each quadword, extended.
+    Type *ResType = ResEVT.getTypeForEVT(*Ctx);
+    Value *Src1 = Builder->CreateBitCast(getNextOperand(), ResType);
+    Value *Src2 = Builder->CreateBitCast(getNextOperand(), ResType);
+    if (Opcode == X86ISD::PMULUDQ) {
+      Constant *Lo = ConstantInt::get(ResType, 0xFFFFFFFFULL);
+      Src1 = Builder->CreateAnd(Src1, Lo);
+      Src2 = Builder->CreateAnd(Src2, Lo);
+    } else {
+      Constant *Half = ConstantInt::get(ResType, 32);
+      Src1 = Builder->CreateAShr(Builder->CreateShl(Src1, Half), Half);
+      Src2 = Builder->CreateAShr(Builder->CreateShl(Src2, Half), Half);
+    }
+    registerResult(Builder->CreateMul(Src1, Src2));
+    break;
+  }
+  case X86ISD::PACKSS:
+  case X86ISD::PACKUS: {
+    Value *Src1 = getNextOperand(), *Src2 = getNextOperand();
+    translatePack(Src1, Src2, Opcode == X86ISD::PACKSS);
+    break;
+  }
+
+  case X86ISD::VSHLI:
+  case X86ISD::VSRLI:
+  case X86ISD::VSRAI:
+  case X86ISD::VSHL:
+  case X86ISD::VSRL:
+  case X86ISD::VSRA: {
+    Value *Src = getNextOperand();
+    Value *Count = getNextOperand();
+    if (Count->getType()->isVectorTy()) {
+      // The count is the low quadword of the register.
+      unsigned NumQuads = Count->getType()->getPrimitiveSizeInBits() / 64;
+      Count = Builder->CreateExtractElement(
+          Builder->CreateBitCast(
+              Count, VectorType::get(Builder->getInt64Ty(), NumQuads)),
+          Builder->getInt32(0));
+    }
+    Count = Builder->CreateZExtOrTrunc(Count, Builder->getInt64Ty());
+    Instruction::BinaryOps BinOp;
+    switch (Opcode) {
+    default: llvm_unreachable("Not a vector shift!");
+    case X86ISD::VSHLI: case X86ISD::VSHL: BinOp = Instruction::Shl;  break;
+    case X86ISD::VSRLI: case X86ISD::VSRL: BinOp = Instruction::LShr; break;
+    case X86ISD::VSRAI: case X86ISD::VSRA: BinOp = Instruction::AShr; break;
+    }
+    translateVectorShift(BinOp, Src, Count);
+    break;
+  }
+  case X86ISD::VSHLDQ:
+  case X86ISD::VSRLDQ: {
+    // Byte shifts of each 128-bit lane.
+    Value *Src = getNextOperand();
+    unsigned Imm = cast<ConstantInt>(getNextOperand())->getZExtValue();
+    MVT ByteVT = MVT::getVectorVT(MVT::i8, ResEVT.getSizeInBits() / 8);
+    SmallVector<int, 32> Mask;
+    if (Opcode == X86ISD::VSHLDQ)
+      DecodePSLLDQMask(ByteVT, Imm, Mask);
+    else
+      DecodePSRLDQMask(ByteVT, Imm, Mask);
+    Type *ByteTy = EVT(ByteVT).getTypeForEVT(*Ctx);
+    translateShuffle(Mask, Builder->CreateBitCast(Src, ByteTy));
+    break;
+  }
+  case X86ISD::PSHUFB: {
+    Value *Src = getNextOperand(), *MaskVal = getNextOperand();
+    SmallVector<int, 32> Mask;
+    if (Constant *C = dyn_cast<Constant>(MaskVal))
+      DecodePSHUFBMask(C, Mask);
+    if (!Mask.empty()) {
+      translateShuffle(Mask, Src);
+      break;
+    }
+    // The mask is only known when running: pick each byte. A byte indexes
+    // its own 128-bit lane, and is zeroed if its mask has the top bit set.
+    unsigned NumElts = ResEVT.getVectorNumElements();
+    Value *Zero = Builder->getInt8(0);
+    Value *Res = Constant::getNullValue(Src->getType());
+    for (unsigned i = 0; i != NumElts; ++i) {
+      Value *M = Builder->CreateExtractElement(MaskVal, Builder->getInt32(i));
+      Value *Idx = Builder->CreateOr(Builder->CreateAnd(M, 15),
+                                     Builder->getInt8(i & ~15U));
+      Value *Elt = Builder->CreateExtractElement(Src, Idx);
+      Elt = Builder->CreateSelect(Builder->CreateICmpSLT(M, Zero), Zero, Elt);
+      Res = Builder->CreateInsertElement(Res, Elt, Builder->getInt32(i));
+    }
+    registerResult(Res);
+    break;
+  }
+  case X86ISD::BLENDI: {
+    Value *Src1 = getNextOperand(), *Src2 = getNextOperand();
+    unsigned Imm = cast<ConstantInt>(getNextOperand())->getZExtValue();
+    SmallVector<int, 16> Mask;
+    DecodeBLENDMask(ResEVT.getSimpleVT(), Imm, Mask);
+    translateShuffle(Mask, Src1, Src2);
+    break;
+  }
+  case X86ISD::VBROADCAST: {
+    Value *Src = getNextOperand();
+    if (Src->getType()->isVectorTy())
+      Src = Builder->CreateExtractElement(Src, Builder->getInt32(0));
+    registerResult(
+        Builder->CreateVectorSplat(ResEVT.getVectorNumElements(), Src));
+    break;
+  }
+  case X86ISD::MOVSHDUP:
+  case X86ISD::MOVSLDUP:
+  case X86ISD::MOVDDUP: {
+    Value *Src = getNextOperand();
+    SmallVector<int, 8> Mask;
+    switch (Opcode) {
+    case X86ISD::MOVSHDUP:
+      DecodeMOVSHDUPMask(ResEVT.getSimpleVT(), Mask); break;
+    case X86ISD::MOVSLDUP:
+      DecodeMOVSLDUPMask(ResEVT.getSimpleVT(), Mask); break;
+    case X86ISD::MOVDDUP:
+      DecodeMOVDDUPMask(ResEVT.getSimpleVT(), Mask); break;
+    }
+    translateShuffle(Mask, Src);
+    break;
+  }
+  case X86ISD::VPERMI: {
+    Value *Src = getNextOperand();
+    unsigned Imm = cast<ConstantInt>(getNextOperand())->getZExtValue();
+    if (ResEVT.getVectorNumElements() != 4) {
+      unknownSemantics("unsupported VPERMI width");
+      return;
+    }
+    SmallVector<int, 4> Mask;
+    DecodeVPERMMask(Imm, Mask);
+    translateShuffle(Mask, Src);
+    break;
+  }
+  case X86ISD::VPERM2X128: {
+    Value *Src1 = getNextOperand(), *Src2 = getNextOperand();
+    unsigned Imm = cast<ConstantInt>(getNextOperand())->getZExtValue();
+    SmallVector<int, 8> Mask;
+    DecodeVPERM2X128Mask(ResEVT.getSimpleVT(), Imm, Mask);
+    translateShuffle(Mask, Src1, Src2);
+    break;
+  }
+  case X86ISD::PEXTRB:
+  case X86ISD::PEXTRW: {
+    Value *Src = getNextOperand();
+    unsigned NumElts = Src->getType()->getVectorNumElements();
+    unsigned Idx = cast<ConstantInt>(getNextOperand())->getZExtValue();
+    Value *Elt = Builder->CreateExtractElement(
+        Src, Builder->getInt32(Idx & (NumElts - 1)));
+    registerResult(Builder->CreateZExt(Elt, ResEVT.getTypeForEVT(*Ctx)));
+    break;
+  }
+  case X86ISD::PINSRB:
+  case X86ISD::PINSRW: {
+    Value *Src = getNextOperand(), *Val = getNextOperand();
+    VectorType *VecTy = cast<VectorType>(Src->getType());
+    unsigned Idx = cast<ConstantInt>(getNextOperand())->getZExtValue();
+    registerResult(Builder->CreateInsertElement(
+        Src, Builder->CreateTrunc(Val, VecTy->getElementType()),
+        Builder->getInt32(Idx & (VecTy->getNumElements() - 1))));
+    break;
+  }
   }
 }
 
@@ -536,7 +749,9 @@ void X86InstrSema::translateCustomOperand(unsigned OperandType,
   case X86::OpTypes::i64i32imm:
   case X86::OpTypes::i64imm: {
     // FIXME: Is there anything special to do with the sext/zext?
-    Type *ResType = ResEVT.getTypeForEVT(*Ctx);
+    // The element indices of PEXTR/PINSR are pointer-sized.
+    Type *ResType = ResEVT == MVT::iPTR ? Builder->getInt64Ty()
+                                        : ResEVT.getTypeForEVT(*Ctx);
     Value *Cst =
         ConstantInt::get(cast<IntegerType>(ResType), getImmOp(MIOpNo));
     registerResult(Cst);
@@ -600,7 +815,7 @@ void X86InstrSema::translateAddr(unsigned MIOperandNo,
 
   if (VT != MVT::iPTRAny) {
     Type *PtrTy = EVT(VT).getTypeForEVT(*Ctx)->getPointerTo();
-    Res = Builder->CreateIntToPtr(Res, PtrTy);
+    Res = getGuestPtr(Res, PtrTy);
   }
 
   registerResult(Res);
@@ -615,7 +830,7 @@ void X86InstrSema::translatePush(Value *Val) {
   Value *OpSizeVal = ConstantInt::get(
       IntegerType::get(*Ctx, OldSP->getType()->getIntegerBitWidth()), OpSize);
   Value *NewSP = Builder->CreateSub(OldSP, OpSizeVal);
-  Value *SPPtr = Builder->CreateIntToPtr(NewSP, Val->getType()->getPointerTo());
+  Value *SPPtr = getGuestPtr(NewSP, Val->getType()->getPointerTo());
   Builder->CreateStore(Val, SPPtr);
 
   setReg(X86::RSP, NewSP);
@@ -629,7 +844,7 @@ Value *X86InstrSema::translatePop(unsigned OpSize) {
   Value *OpSizeVal = ConstantInt::get(
       IntegerType::get(*Ctx, OldSP->getType()->getIntegerBitWidth()), OpSize);
   Value *NewSP = Builder->CreateAdd(OldSP, OpSizeVal);
-  Value *SPPtr = Builder->CreateIntToPtr(OldSP, OpTy->getPointerTo());
+  Value *SPPtr = getGuestPtr(OldSP, OpTy->getPointerTo());
   Value *Val = Builder->CreateLoad(SPPtr);
 
   setReg(X86::RSP, NewSP);
@@ -641,21 +856,92 @@ void X86InstrSema::translateHorizontalBinop(Instruction::BinaryOps BinOp) {
   Type *VecTy = ResEVT.getTypeForEVT(*Ctx);
   assert(VecTy->isVectorTy());
   assert(VecTy == Src1->getType() && VecTy == Src2->getType());
+  // Each 128-bit lane of the result has the sums of the pairs of the lane of
+  // the first source, then of the second: combine the even elements with the
+  // odd ones.
   unsigned NumElt = VecTy->getVectorNumElements();
-  Value *Res = UndefValue::get(VecTy);
-  Value *Srcs[2] = { Src1, Src2 };
-  for (int opi = 0, ope = 2; opi != ope; ++opi) {
-    for (int i = 0, e = NumElt / 2; i != e; ++i) {
-      Value *EltRes = Builder->CreateBinOp(
-          BinOp, Builder->CreateExtractElement(Srcs[opi], Builder->getInt32(i)),
-          Builder->CreateExtractElement(Srcs[opi], Builder->getInt32(i + 1)));
-      Res = Builder->CreateInsertElement(Res, EltRes,
-                                         Builder->getInt32(i + opi * NumElt));
+  unsigned NumLaneElts = 128 / VecTy->getScalarSizeInBits();
+  SmallVector<Constant *, 16> Even, Odd;
+  for (unsigned l = 0; l != NumElt; l += NumLaneElts) {
+    for (unsigned s = 0; s != 2; ++s) {
+      for (unsigned i = 0; i != NumLaneElts; i += 2) {
+        Even.push_back(Builder->getInt32(s * NumElt + l + i));
+        Odd.push_back(Builder->getInt32(s * NumElt + l + i + 1));
+      }
+    }
+  }
+  Value *Evens =
+      Builder->CreateShuffleVector(Src1, Src2, ConstantVector::get(Even));
+  Value *Odds =
+      Builder->CreateShuffleVector(Src1, Src2, ConstantVector::get(Odd));
+  registerResult(Builder->CreateBinOp(BinOp, Evens, Odds));
+}
+
+void X86InstrSema::translateVectorShift(Instruction::BinaryOps BinOp,
+                                        Value *Src, Value *Count) {
+  VectorType *VecTy = cast<VectorType>(Src->getType());
+  unsigned EltBits = VecTy->getScalarSizeInBits();
+  // Counts past the element size don't wrap: they shift everything out, but
+  // for the sign of the arithmetic shifts.
+  if (ConstantInt *CI = dyn_cast<ConstantInt>(Count)) {
+    uint64_t C = CI->getZExtValue();
+    if (C >= EltBits) {
+      if (BinOp != Instruction::AShr) {
+        registerResult(Constant::getNullValue(VecTy));
+        return;
+      }
+      C = EltBits - 1;
     }
+    registerResult(
+        Builder->CreateBinOp(BinOp, Src, ConstantInt::get(VecTy, C)));
+    return;
   }
+  Value *TooLarge = Builder->CreateICmpUGE(Count, Builder->getInt64(EltBits));
+  if (BinOp == Instruction::AShr)
+    Count =
+        Builder->CreateSelect(TooLarge, Builder->getInt64(EltBits - 1), Count);
+  Value *Amt = Builder->CreateVectorSplat(
+      VecTy->getNumElements(),
+      Builder->CreateTrunc(Count, VecTy->getElementType()));
+  Value *Res = Builder->CreateBinOp(BinOp, Src, Amt);
+  if (BinOp != Instruction::AShr)
+    Res = Builder->CreateSelect(TooLarge, Constant::getNullValue(VecTy), Res);
   registerResult(Res);
 }
 
+void X86InstrSema::translatePack(Value *Src1, Value *Src2, bool IsSigned) {
+  VectorType *SrcTy = cast<VectorType>(Src1->getType());
+  VectorType *ResTy = cast<VectorType>(ResEVT.getTypeForEVT(*Ctx));
+  unsigned SrcBits = SrcTy->getScalarSizeInBits();
+  unsigned ResBits = ResTy->getScalarSizeInBits();
+  // The sources are signed either way; only the range they saturate to
+  // differs.
+  APInt Min = IsSigned ? APInt::getSignedMinValue(ResBits).sext(SrcBits)
+                       : APInt::getMinValue(SrcBits);
+  APInt Max = IsSigned ? APInt::getSignedMaxValue(ResBits).sext(SrcBits)
+                       : APInt::getMaxValue(ResBits).zext(SrcBits);
+  Constant *MinV = ConstantInt::get(SrcTy, Min);
+  Constant *MaxV = ConstantInt::get(SrcTy, Max);
+  Type *TruncTy = VectorType::get(ResTy->getElementType(),
+                                  SrcTy->getNumElements());
+  auto Saturate = [&](Value *V) {
+    V = Builder->CreateSelect(Builder->CreateICmpSLT(V, MinV), MinV, V);
+    V = Builder->CreateSelect(Builder->CreateICmpSGT(V, MaxV), MaxV, V);
+    return Builder->CreateTrunc(V, TruncTy);
+  };
+  // Each 128-bit lane of the result has the lane of the first source, then
+  // the one of the second.
+  unsigned NumElts = SrcTy->getNumElements();
+  unsigned NumLaneElts = 128 / SrcBits;
+  SmallVector<Constant *, 32> Mask;
+  for (unsigned l = 0; l != NumElts; l += NumLaneElts)
+    for (unsigned s = 0; s != 2; ++s)
+      for (unsigned i = 0; i != NumLaneElts; ++i)
+        Mask.push_back(Builder->getInt32(s * NumElts + l + i));
+  registerResult(Builder->CreateShuffleVector(
+      Saturate(Src1), Saturate(Src2), ConstantVector::get(Mask)));
+}
+
 void X86InstrSema::translateDivRem(bool isThreeOperand, bool isSigned) {
   EVT Re2EVT = NextVT();
   assert(Re2EVT == ResEVT && "X86 division result type mismatch!");
@@ -699,34 +985,79 @@ void X86InstrSema::translateDivRem(bool isThreeOperand, bool isSigned) {
 
 void X86InstrSema::translateShuffle(SmallVectorImpl<int> &Mask, Value *V1,
                                     Value *V2) {
+  registerResult(Builder->CreateBitCast(createShuffle(Mask, V1, V2),
+                                        ResEVT.getTypeForEVT(*Ctx)));
+}
+
+Value *X86InstrSema::createShuffle(ArrayRef<int> Mask, Value *V1, Value *V2) {
   Type *VecTy = V1->getType();
-  Type *EltTy = VecTy->getVectorElementType();
   unsigned NumElts = VecTy->getVectorNumElements();
+  assert(Mask.size() == NumElts && "Shuffle mask doesn't match its inputs!");
 
   SmallVector<Constant *, 8> MaskCV(NumElts);
-
+  // The zeroed elements, when both inputs are operands.
+  SmallVector<Constant *, 8> ZeroMaskCV;
   bool V2IsZero = false;
 
   for (size_t i = 0; i < Mask.size(); ++i) {
     if (Mask[i] == SM_SentinelZero) {
-      V2IsZero = true;
-      MaskCV[i] = Builder->getInt32(NumElts);
+      if (V2) {
+        if (ZeroMaskCV.empty())
+          for (unsigned j = 0; j != NumElts; ++j)
+            ZeroMaskCV.push_back(Builder->getInt32(j));
+        ZeroMaskCV[i] = Builder->getInt32(NumElts);
+        MaskCV[i] = UndefValue::get(Builder->getInt32Ty());
+      } else {
+        V2IsZero = true;
+        MaskCV[i] = Builder->getInt32(NumElts);
+      }
     } else if (Mask[i] == SM_SentinelUndef)
-      MaskCV[i] = UndefValue::get(EltTy);
+      MaskCV[i] = UndefValue::get(Builder->getInt32Ty());
     else
       MaskCV[i] = Builder->getInt32(Mask[i]);
   }
 
-  assert((!V2IsZero || !V2) &&
-         "Second shuffle input can't be zero and an operand at the same time!");
-
-  if (!V2)
-    V2 = UndefValue::get(V1->getType());
   if (V2IsZero)
     V2 = Constant::getNullValue(VecTy);
+  else if (!V2)
+    V2 = UndefValue::get(VecTy);
+
+  Value *Res =
+      Builder->CreateShuffleVector(V1, V2, ConstantVector::get(MaskCV));
+  if (!ZeroMaskCV.empty())
+    Res = Builder->CreateShuffleVector(Res, Constant::getNullValue(VecTy),
+                                       ConstantVector::get(ZeroMaskCV));
+  return Res;
+}
 
-  registerResult(
-      Builder->CreateShuffleVector(V1, V2, ConstantVector::get(MaskCV)));
+void X86InstrSema::translatePALIGNR(unsigned Opcode) {
+  bool IsMem = Opcode == X86::PALIGNR128rm || Opcode == X86::VPALIGNR128rm ||
+               Opcode == X86::VPALIGNR256rm;
+  bool Is256 = Opcode == X86::VPALIGNR256rr || Opcode == X86::VPALIGNR256rm;
+  MVT VT = Is256 ? MVT::v32i8 : MVT::v16i8;
+  Type *VecTy = EVT(VT).getTypeForEVT(*Ctx);
+
+  // The result is the bytes of each lane of the first source, above those
+  // of the second, shifted right by the immediate.
+  unsigned DstReg = getRegOp(0);
+  Value *Hi = Builder->CreateBitCast(getReg(getRegOp(1)), VecTy);
+  Value *Lo;
+  if (IsMem) {
+    translateAddr(2, VT.SimpleTy);
+    Lo = Builder->CreateLoad(Vals.back());
+  } else {
+    Lo = Builder->CreateBitCast(getReg(getRegOp(2)), VecTy);
+  }
+  unsigned Imm = getImmOp(IsMem ? 7 : 3);
+
+  SmallVector<int, 32> Mask;
+  DecodePALIGNRMask(VT, Imm, Mask);
+  // Past both sources, the bytes are zero.
+  for (unsigned i = 0, e = Mask.size(); i != e; ++i)
+    if (i % 16 + Imm >= 32)
+      Mask[i] = SM_SentinelZero;
+  setReg(DstReg, Builder->CreateBitCast(createShuffle(Mask, Lo, Hi),
+                                        DRS.getRegType(DstReg)));
 }
 
 void X86InstrSema::translateCMPXCHG(unsigned MemOpType, unsigned CmpReg) {
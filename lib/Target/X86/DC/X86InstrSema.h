@@ -43,10 +43,17 @@ public:
   void translateTargetOpcode();
   void translateCustomOperand(unsigned OperandType, unsigned MIOperandNo);
   void translateImplicit(unsigned RegNo);
-    virtual void translateTargetIntrinsic(unsigned IntrinsicID) { llvm_unreachable("Not implemented");}
+  void translateTargetIntrinsic(unsigned IntrinsicID) {
+    unknownSemantics("intrinsics not implemented");
+  }
 
   bool translateTargetInst();
 
+protected:
+  // The C functions take rdi to r9 and xmm0 to xmm7, and return in rax or
+  // xmm0, popping the return address.
+  bool getExternalCallRegs(ExternalCallRegs &Regs) const override;
+
 private:
   void translateAddr(unsigned MIOperandNo,
                      MVT::SimpleValueType VT = MVT::iPTRAny);
@@ -56,9 +63,14 @@ private:
 
   void translateDivRem(bool isThreeOperand, bool isSigned);
   void translateHorizontalBinop(Instruction::BinaryOps BinOp);
+  void translateVectorShift(Instruction::BinaryOps BinOp, Value *Src,
+                            Value *Count);
+  void translatePack(Value *Src1, Value *Src2, bool IsSigned);
 
   void translateShuffle(SmallVectorImpl<int> &Mask, Value *V1,
                         Value *V2 = nullptr);
+  Value *createShuffle(ArrayRef<int> Mask, Value *V1, Value *V2 = nullptr);
+  void translatePALIGNR(unsigned Opcode);
 
   void translateCMPXCHG(unsigned MemOpType, unsigned CmpReg);
 };
@@ -28,10 +28,23 @@ static void X86InitSpecialRegSizes(DCRegisterSema::RegSizeTy &RegSizes) {
   RegSizes[X86::RIP] = 64;
 }
 
+static DCRegisterSema::RegSetRank X86GetRegSetRank(const MCRegisterInfo &MRI,
+                                                   unsigned RegNo) {
+  if (RegNo == X86::EFLAGS ||
+      MRI.getRegClass(X86::GR64RegClassID).contains(RegNo))
+    return DCRegisterSema::RSR_Hot;
+  // The ZMM registers, when there's no larger one, the YMM or XMM registers.
+  for (MCSubRegIterator SRI(RegNo, &MRI, /*IncludeSelf=*/true); SRI.isValid();
+       ++SRI)
+    if (MRI.getRegClass(X86::VR128XRegClassID).contains(*SRI))
+      return DCRegisterSema::RSR_Vector;
+  return DCRegisterSema::RSR_Rare;
+}
+
 X86RegisterSema::X86RegisterSema(const MCRegisterInfo &MRI,
                                  const MCInstrInfo &MII,
                                  const DataLayout &DL)
-    : DCRegisterSema(MRI, MII, DL, X86InitSpecialRegSizes),
+    : DCRegisterSema(MRI, MII, DL, X86InitSpecialRegSizes, X86GetRegSetRank),
       LastEFLAGSChangingDef(0), LastEFLAGSDef(0),
       LastEFLAGSDefWasPartialINCDEC(false), SFVals(X86::MAX_FLAGS + 1),
       SFAssignments(X86::MAX_FLAGS + 1), CCVals(X86::COND_INVALID),
@@ -50,6 +63,34 @@ bool X86RegisterSema::doesSubRegIndexClearSuper(unsigned SubRegIdx) const {
   return false;
 }
 
+// The System V x86-64 calling convention, which Darwin uses too: arguments
+// are passed in RDI, RSI, RDX, RCX, R8, R9 and XMM0-7, with the number of
+// vector registers used by a variadic call in AL. The frame pointer is read
+// as well, by the callees that walk the frame chain.
+static const MCPhysReg CalleeReadRegList[] = {
+    X86::RDI,  X86::RSI,  X86::RDX,  X86::RCX,  X86::R8,   X86::R9,
+    X86::RAX,  X86::RSP,  X86::RBP,  X86::XMM0, X86::XMM1, X86::XMM2,
+    X86::XMM3, X86::XMM4, X86::XMM5, X86::XMM6, X86::XMM7};
+
+bool X86RegisterSema::isCalleeReadReg(unsigned RegNo) const {
+  for (MCPhysReg Reg : CalleeReadRegList)
+    if (MRI.isSubRegisterEq(RegNo, Reg))
+      return true;
+  return false;
+}
+
+// Callees preserve RBX, RBP, RSP and R12-R15; all the vector registers are
+// clobbered.
+static const MCPhysReg CalleeSavedRegList[] = {
+    X86::RBX, X86::RBP, X86::RSP, X86::R12, X86::R13, X86::R14, X86::R15};
+
+bool X86RegisterSema::isCallClobberedReg(unsigned RegNo) const {
+  for (MCPhysReg Reg : CalleeSavedRegList)
+    if (RegNo == Reg)
+      return false;
+  return true;
+}
+
 void X86RegisterSema::clearCCSF() {
   for (size_t i = 0, e = SFVals.size(); i != e; ++i)
     SFVals[i] = 0;
@@ -182,7 +223,7 @@ Value *X86RegisterSema::getCC(X86::CondCode CC) {
 
 void X86RegisterSema::setCC(X86::CondCode CC, Value *CCV) {
   CCVals[CC] = CCV;
-  if (!CCV->hasName())
+  if (getNameLevel() == NL_All && !CCV->hasName())
     CCV->setName(
         (Twine(getCCName(CC)) + "_" + utostr(CCAssignments[CC]++)).str());
 }
@@ -306,7 +347,7 @@ Value *X86RegisterSema::createEFLAGSFromSFs(Value *OldEFLAGS) {
 void X86RegisterSema::setSF(X86::StatusFlag SF, Value *Val) {
   // No need to recreate EFLAGS, because this is only called from updateEFLAGS.
   SFVals[SF] = Val;
-  if (!Val->hasName())
+  if (getNameLevel() == NL_All && !Val->hasName())
     Val->setName((Twine(getSFName(SF)) + "_" +
                   utostr(SFAssignments[SF]++)).str());
 }
@@ -346,7 +387,8 @@ void X86RegisterSema::insertInitRegSetCode(Function *InitFn) {
 
   // put a pointer to the test stack in RSP
   Idx[1] = Builder->getInt32(RegOffsetsInSet[RegLargestSupers[X86::RSP]]);
-  Builder->CreateStore(RSP, Builder->CreateInBoundsGEP(RegSet, Idx));
+  Builder->CreateStore(getGuestAddr(RSP),
+                       Builder->CreateInBoundsGEP(RegSet, Idx));
 
   // ac comes in EDI
   Idx[1] = Builder->getInt32(RegOffsetsInSet[RegLargestSupers[X86::EDI]]);
@@ -355,8 +397,9 @@ void X86RegisterSema::insertInitRegSetCode(Function *InitFn) {
 
   // av comes in RSI
   Idx[1] = Builder->getInt32(RegOffsetsInSet[X86::RSI]);
-  Builder->CreateStore(Builder->CreatePtrToInt(ArgV, Builder->getInt64Ty()),
-                       Builder->CreateInBoundsGEP(RegSet, Idx));
+  Builder->CreateStore(
+      getGuestAddr(Builder->CreatePtrToInt(ArgV, Builder->getInt64Ty())),
+      Builder->CreateInBoundsGEP(RegSet, Idx));
 
   // Initialize EFLAGS to 0x202 (empirical).
   Idx[1] = Builder->getInt32(RegOffsetsInSet[RegLargestSupers[X86::EFLAGS]]);
@@ -49,6 +49,10 @@ public:
 private:
   bool doesSubRegIndexClearSuper(unsigned SubRegIdx) const override;
 
+  bool isCalleeReadReg(unsigned RegNo) const override;
+  bool isCallClobberedReg(unsigned RegNo) const override;
+  unsigned getStackPointerReg() const override { return X86::RSP; }
+
   void onRegisterGet(unsigned RegNo) override;
   void onRegisterSet(unsigned RegNo, Value *RegVal) override;
 
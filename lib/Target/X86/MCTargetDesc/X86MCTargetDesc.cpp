@@ -14,6 +14,7 @@
 #include "X86MCTargetDesc.h"
 #include "InstPrinter/X86ATTInstPrinter.h"
 #include "InstPrinter/X86IntelInstPrinter.h"
+#include "X86BaseInfo.h"
 #include "X86MCAsmInfo.h"
 #include "llvm/ADT/Triple.h"
 #include "llvm/MC/MCCodeGenInfo.h"
@@ -223,8 +224,35 @@ static MCRelocationInfo *createX86MCRelocationInfo(const Triple &TheTriple,
   return llvm::createMCRelocationInfo(TheTriple, Ctx);
 }
 
+namespace {
+class X86MCInstrAnalysis : public MCInstrAnalysis {
+public:
+  X86MCInstrAnalysis(const MCInstrInfo *Info) : MCInstrAnalysis(Info) {}
+
+  // The RIP-relative memory operands are relative to the next instruction.
+  bool evaluatePCRelativeAddress(const MCInst &Inst, uint64_t Addr,
+                                 uint64_t Size, unsigned &OpIdx,
+                                 uint64_t &Target) const override {
+    const MCInstrDesc &Desc = Info->get(Inst.getOpcode());
+    int MemOp = X86II::getMemoryOperandNo(Desc.TSFlags, Inst.getOpcode());
+    if (MemOp < 0)
+      return false;
+    MemOp += X86II::getOperandBias(Desc);
+    if (unsigned(MemOp) + X86::AddrDisp >= Inst.getNumOperands())
+      return false;
+    const MCOperand &Base = Inst.getOperand(MemOp + X86::AddrBaseReg);
+    const MCOperand &Disp = Inst.getOperand(MemOp + X86::AddrDisp);
+    if (!Base.isReg() || Base.getReg() != X86::RIP || !Disp.isImm())
+      return false;
+    OpIdx = MemOp + X86::AddrDisp;
+    Target = Addr + Size + Disp.getImm();
+    return true;
+  }
+};
+} // end anonymous namespace
+
 static MCInstrAnalysis *createX86MCInstrAnalysis(const MCInstrInfo *Info) {
-  return new MCInstrAnalysis(Info);
+  return new X86MCInstrAnalysis(Info);
 }
 
 // Force static initialization.
@@ -0,0 +1,39 @@
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj %s -o %t.o
+
+// With -REC_add, the instructions are tagged with the address they were
+// translated from, and -addr-table writes those as runs: the index of the
+// first instruction of each run in its function, and its address, or '-'.
+// RUN: llvm-dec -REC_add -addr-table=%t.tab -o %t.ll %t.o
+// RUN: FileCheck %s --check-prefix=TABLE < %t.tab
+// RUN: FileCheck %s --check-prefix=TAGS < %t.ll
+// TABLE:      fn_0 8
+// TABLE-NEXT: 0 0
+// TABLE-NEXT: 4 4
+// TABLE-NEXT: 8 0
+// TABLE-NEXT: 9 8
+// TABLE-NEXT: 13 -
+// TABLE-NEXT: 14 0
+// TABLE-NEXT: 16 4
+// TABLE-NEXT: 17 8
+// TAGS-LABEL: bb_0:
+// TAGS: %X0_1 = add i64 %X0_0, 1, !num [[A0:![0-9]+]]
+// TAGS: %X1_0 = add i64 %X0_1, 2, !num [[A4:![0-9]+]]
+// TAGS: [[A0]] = !{i64 0}
+// TAGS: [[A4]] = !{i64 4}
+
+// -strip-addr-tags leaves the table unchanged, and the IR without the tags.
+// RUN: llvm-dec -REC_add -strip-addr-tags -addr-table=%t.stripped.tab \
+// RUN:   -o %t.stripped.ll %t.o
+// RUN: cmp %t.tab %t.stripped.tab
+// RUN: FileCheck %s --check-prefix=STRIPPED < %t.stripped.ll
+// STRIPPED-NOT: !num
+// STRIPPED-LABEL: bb_0:
+// STRIPPED: %X0_1 = add i64 %X0_0, 1{{$}}
+// STRIPPED: %X1_0 = add i64 %X0_1, 2{{$}}
+// STRIPPED-NOT: !num
+
+.globl _f
+_f:
+add x0, x0, #1
+add x1, x0, #2
+ret
@@ -0,0 +1,40 @@
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj %s -o %t.o
+// RUN: llvm-dec -o - %t.o | FileCheck %s
+
+// The pages are explicit: the relocations of an object aren't applied.
+// __text is at 0, and __objc_selrefs right after it, at 0x30.
+
+// CHECK-DAG: @selref_30 = external global i8*
+// CHECK-DAG: @selref_38 = external global i8*
+
+// CHECK-LABEL: define void @fn_0(
+// CHECK: bb_0:
+
+// ADRP + ADD is the address of the entry, and so is ADRP + LDR offset.
+// CHECK-NEXT: [[P1:%[0-9]+]] = inttoptr i64 ptrtoint (i8** @selref_30 to i64) to i64*
+// CHECK-NEXT: %X1_0 = load i64, i64* [[P1]]
+// CHECK-NEXT: [[P0:%[0-9]+]] = inttoptr i64 ptrtoint (i8** @selref_38 to i64) to i64*
+// CHECK-NEXT: %X0_0 = load i64, i64* [[P0]]
+
+// An address outside of the data sections stays an integer.
+// CHECK-NEXT: [[P2:%[0-9]+]] = inttoptr i64 16 to i64*
+// CHECK-NEXT: %X2_0 = load i64, i64* [[P2]]
+
+// CHECK: store i64 ptrtoint (i8** @selref_30 to i64), i64* %X8
+// CHECK: store i64 16, i64* %X10
+.globl _main
+_main:
+adrp x8, #0
+add x8, x8, #0x30
+ldr x1, [x8]
+adrp x9, #0
+ldr x0, [x9, #0x38]
+adrp x10, #0
+add x10, x10, #0x10
+ldr x2, [x10]
+ret
+.p2align 4
+
+.section __DATA,__objc_selrefs,literal_pointers,no_dead_strip
+.quad 0
+.quad 0
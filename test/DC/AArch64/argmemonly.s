@@ -0,0 +1,38 @@
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj %s -o %t.o
+// RUN: llvm-dec -call-summaries -o - %t.o | FileCheck %s
+// RUN: llvm-dec -o - %t.o | FileCheck %s --check-prefix=NOSUMMARIES
+
+.globl _main
+_main:
+ldr x0, [x1]
+bl _add
+bl _twice
+str x0, [x1]
+ret
+
+// Only the registers: argmemonly.
+_add:
+add x0, x0, #1
+ret
+
+// Only calls functions that only access the registers.
+_twice:
+mov x9, x30
+bl _add
+bl _add
+ret x9
+
+// Loads.
+_load:
+ldr x0, [x0]
+ret
+
+// CHECK: define void @fn_0(%regset* noalias nocapture) {
+// CHECK: call void @fn_14(%regset* %0)
+// CHECK: call void @fn_1C(%regset* %0)
+// CHECK: define void @fn_14(%regset* noalias nocapture) [[ARGMEM:#[0-9]+]] {
+// CHECK: define void @fn_1C(%regset* noalias nocapture) [[ARGMEM]] {
+// CHECK: define void @fn_2C(%regset* noalias nocapture) {
+// CHECK: attributes [[ARGMEM]] = { argmemonly }
+
+// NOSUMMARIES-NOT: argmemonly
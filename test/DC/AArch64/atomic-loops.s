@@ -0,0 +1,54 @@
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj %s -o %t.o
+// RUN: llvm-dec -enable-dc-atomic-loops -o - %t.o | FileCheck %s
+// RUN: llvm-dec -o - %t.o | FileCheck %s --check-prefix=PLAIN
+
+.globl _main
+_main:
+// A fetch and add.
+Lrmw:
+ldaxr w8, [x0]
+add w9, w8, #1
+stlxr w10, w9, [x0]
+cbnz w10, Lrmw
+// An exchange.
+Lxchg:
+ldxr x8, [x1]
+stxr w10, x2, [x1]
+cbnz w10, Lxchg
+// A compare and swap.
+Lcas:
+ldaxr x8, [x0]
+cmp x8, x3
+b.ne Lfail
+stlxr w10, x4, [x0]
+cbnz w10, Lcas
+// The operand changes at each try: not an atomicrmw.
+Lother:
+ldxr x8, [x0]
+add x9, x8, x9
+stxr w10, x9, [x0]
+cbnz w10, Lother
+Lfail:
+clrex
+ret
+
+// CHECK-LABEL: bb_0:
+// CHECK: [[OLD:%W8_[0-9]+]] = atomicrmw add i32* %{{[0-9]+}}, i32 1 acq_rel
+// CHECK: %W9_{{[0-9]+}} = add i32 [[OLD]], 1
+// CHECK: br label %bb_10
+// CHECK-LABEL: bb_10:
+// CHECK: atomicrmw xchg i64* %{{[0-9]+}}, i64 %X2_{{[0-9]+}} monotonic
+// CHECK: br label %bb_1C
+// CHECK-LABEL: bb_1C:
+// CHECK: [[PAIR:%[0-9]+]] = cmpxchg i64* %{{[0-9]+}}, i64 %X3_{{[0-9]+}}, i64 %X4_{{[0-9]+}} acq_rel acquire
+// CHECK: %X8_{{[0-9]+}} = extractvalue { i64, i1 } [[PAIR]], 0
+// CHECK: br i1 %{{[0-9]+}}, label %bb_40, label %bb_28
+// CHECK-LABEL: bb_28:
+// CHECK-NOT: store i64 %X4
+// CHECK: br label %bb_30
+// CHECK-LABEL: bb_30:
+// CHECK-NOT: atomicrmw
+// CHECK: br i1 %{{[0-9]+}}, label %bb_30, label %bb_40
+
+// PLAIN-NOT: atomicrmw
+// PLAIN-NOT: cmpxchg
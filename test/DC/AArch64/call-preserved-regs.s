@@ -0,0 +1,45 @@
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj %s -o %t.o
+// RUN: llvm-dec -o - %t.o | FileCheck %s --check-prefix=NONE
+// RUN: llvm-dec -dc-passes=nvregs -o - %t.o | FileCheck %s
+
+// Without the pass, every register is saved to the regset before the call,
+// and reloaded after it.
+// NONE-LABEL: bb_0_call:
+// NONE: store i64 {{%[0-9]+}}, i64* %X19_ptr
+// NONE: call void @fn_20(
+// NONE: [[X19:%X19_[0-9]+]] = load i64, i64* %X19_ptr
+// NONE: store i64 [[X19]], i64* %X19
+
+// X19 is callee-saved, and not read by the callee: its stores to the regset
+// are dropped, before the call and on exit, and the value it had before the
+// call is used after it.
+// CHECK-LABEL: exit_fn_0:
+// CHECK-NOT: store i64 {{.*}}, i64* %X19_ptr
+// CHECK: ret void
+
+// The frame pointer is callee-saved too, but callees read it: it is still
+// stored before the call, and that value is forwarded after it. X9 is
+// clobbered by the call, and reloaded.
+// CHECK-LABEL: bb_0_call:
+// CHECK: [[FP:%[0-9]+]] = load i64, i64* %FP
+// CHECK-NEXT: store i64 [[FP]], i64* %FP_ptr
+// CHECK: store i64 {{%[0-9]+}}, i64* %X9_ptr
+// CHECK-NEXT: [[X19:%[0-9]+]] = load i64, i64* %X19
+// CHECK-NEXT: call void @fn_20(
+// CHECK: [[X9:%X9_[0-9]+]] = load i64, i64* %X9_ptr
+// CHECK: store i64 [[FP]], i64* %FP
+// CHECK: store i64 [[X9]], i64* %X9
+// CHECK: store i64 [[X19]], i64* %X19
+// CHECK-NEXT: br label %bb_cC
+
+.globl _f
+_f:
+mov x19, #5
+mov x29, #3
+mov x9, #7
+bl #20
+add x1, x19, #1
+add x2, x29, #1
+add x3, x9, #1
+ret
+ret
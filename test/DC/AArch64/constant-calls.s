@@ -0,0 +1,49 @@
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj %s -o %t.o
+// RUN: llvm-dec -resolve-constant-calls -o - %t.o | FileCheck %s
+// RUN: llvm-dec -o - %t.o | FileCheck %s --check-prefix=DYNAMIC
+
+.globl _main
+_main:
+// A constant, set in another block.
+movz x10, #0x34
+cbz x0, 1f
+mov x1, #1
+1:
+blr x10
+// A pointer of the table at 0x40, from its address, set in another block.
+adrp x8, #0
+add x8, x8, #0x40
+cbz x0, 2f
+mov x1, #2
+2:
+ldr x9, [x8, #8]
+blr x9
+// Not a constant.
+ldr x11, [x0]
+blr x11
+ret
+
+_callee:
+ret
+_other:
+ret
+
+.section __DATA,__const
+.p2align 3
+.quad 0
+.quad 0x38
+
+// CHECK-LABEL: define void @fn_0(
+// CHECK: call void @fn_34(%regset* %0)
+// CHECK: call void @fn_38(%regset* %0)
+// CHECK: call void (%regset*)* @__llvm_dc_translate_at(
+// CHECK-NOT: call void (%regset*)* @__llvm_dc_translate_at(
+// CHECK-LABEL: define void @fn_34(
+// CHECK-LABEL: define void @fn_38(
+
+// DYNAMIC-LABEL: define void @fn_0(
+// DYNAMIC: call void (%regset*)* @__llvm_dc_translate_at(
+// DYNAMIC: call void (%regset*)* @__llvm_dc_translate_at(
+// DYNAMIC: call void (%regset*)* @__llvm_dc_translate_at(
+// DYNAMIC-NOT: call void @fn_3
+// DYNAMIC-LABEL: define i32 @main(
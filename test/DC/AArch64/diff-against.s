@@ -0,0 +1,54 @@
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj %s -o %t.old.o
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj -defsym=NEW=1 %s \
+// RUN:   -o %t.new.o
+// RUN: llvm-dec -mc-only -o %t.old.triage %t.old.o
+// RUN: llvm-dec -diff-against=%t.old.triage -diff-report=%t.diff -o - \
+// RUN:   %t.new.o 2>&1 | FileCheck %s
+// RUN: FileCheck %s --check-prefix=REPORT < %t.diff
+
+.globl _main
+_main:
+.ifdef NEW
+bl _h
+.endif
+bl _f
+bl _g
+bl _k
+ret
+
+.ifdef NEW
+_h:
+sub x0, x0, #3
+ret
+.endif
+
+_f:
+add x0, x0, #1
+ret
+
+_g:
+.ifdef NEW
+mul x0, x0, x0
+.else
+mul x0, x0, x1
+.endif
+ret
+
+_k:
+lsl x0, x0, #2
+ret
+
+// CHECK: Diff: 1 added, 0 removed, 2 changed, 2 unchanged functions
+
+// Only the added and changed functions are translated: _f and _k didn't
+// change, they only moved.
+// CHECK-DAG: define void @fn_0(
+// CHECK-DAG: define void @fn_14(
+// CHECK-DAG: declare void @fn_1C(
+// CHECK-DAG: define void @fn_24(
+// CHECK-DAG: declare void @fn_2C(
+
+// REPORT: added 0x14 h
+// REPORT-NEXT: changed 0x0 0x0 {{.*}}
+// REPORT-NEXT: changed 0x18 0x24 g
+// REPORT-NOT: {{.}}
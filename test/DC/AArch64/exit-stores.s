@@ -0,0 +1,29 @@
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj %s -o %t.o
+// RUN: llvm-dec -o - %t.o | FileCheck %s
+
+// The exit block stores back the registers written on some path (X9), or
+// through a sub-register (X10), from their local copy, which still holds the
+// incoming value on the other paths. Those only read (X0, X11) aren't.
+// CHECK-LABEL: exit_fn_0:
+// CHECK-NEXT: [[X9:%[0-9]+]] = load i64, i64* %X9
+// CHECK-NEXT: store i64 [[X9]], i64* %X9_ptr
+// CHECK-NEXT: [[X10:%[0-9]+]] = load i64, i64* %X10
+// CHECK-NEXT: store i64 [[X10]], i64* %X10_ptr
+// CHECK-NEXT: [[X12:%[0-9]+]] = load i64, i64* %X12
+// CHECK-NEXT: store i64 [[X12]], i64* %X12_ptr
+// CHECK-NEXT: ret void
+
+// CHECK-LABEL: bb_4:
+// CHECK: store i64 {{%X9_[0-9]+}}, i64* %X9
+// CHECK-LABEL: bb_8:
+// CHECK: [[W10:%W10_[0-9]+]] = add i32
+// CHECK: [[X10EXT:%X10_[0-9]+]] = zext i32 [[W10]] to i64
+// CHECK: store i64 [[X10EXT]], i64* %X10
+
+.globl _f
+_f:
+cbz x0, #8
+mov x9, #1
+add w10, w10, #1
+add x12, x11, #0
+ret
@@ -0,0 +1,65 @@
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj %s -o %t.o
+// RUN: llvm-dec -o - %t.o | FileCheck %s
+
+.globl _main
+_main:
+bl _cmp
+bl _cmn
+bl _cmn_hs
+bl _tst
+ret
+
+// After CMP, the condition compares the operands of the subtraction.
+// CHECK-LABEL: define void @fn_14(
+// CHECK: [[SUB:%[0-9]+]] = sub i64 [[L:%X0_[0-9]+]], [[R:%[0-9]+]]
+// CHECK: [[C:%[0-9]+]] = icmp slt i64 [[L]], [[R]]
+// CHECK: br i1 [[C]], label %bb_20, label %bb_1C
+_cmp:
+cmp x0, x1
+b.lt 1f
+mov x0, #1
+1:
+ret
+
+// CMN adds: its conditions are read from the flags of the sum.
+// CHECK-LABEL: define void @fn_24(
+// CHECK: [[SUM:%[0-9]+]] = add i64 [[L:%X0_[0-9]+]], [[R:%[0-9]+]]
+// CHECK-NOT: icmp slt i64 [[L]], [[R]]
+// CHECK: [[SO:%[0-9]+]] = call { i64, i1 } @llvm.sadd.with.overflow.i64(i64 [[L]], i64 [[R]])
+// CHECK: [[V:%[0-9]+]] = extractvalue { i64, i1 } [[SO]], 1
+// CHECK: [[N:%[0-9]+]] = icmp slt i64 [[SUM]], 0
+// CHECK: [[C:%[0-9]+]] = icmp ne i1 [[N]], [[V]]
+// CHECK: br i1 [[C]], label %bb_30, label %bb_2C
+_cmn:
+cmn x0, x1
+b.lt 1f
+mov x0, #1
+1:
+ret
+
+// C is the carry of the sum, not the borrow of a subtraction.
+// CHECK-LABEL: define void @fn_34(
+// CHECK: add i64 [[L:%X0_[0-9]+]], [[R:%[0-9]+]]
+// CHECK: [[UO:%[0-9]+]] = call { i64, i1 } @llvm.uadd.with.overflow.i64(i64 [[L]], i64 [[R]])
+// CHECK: [[C:%[0-9]+]] = extractvalue { i64, i1 } [[UO]], 1
+// CHECK-NOT: xor i1 [[C]], true
+// CHECK: br i1 [[C]], label %bb_40, label %bb_3C
+_cmn_hs:
+cmn x0, x1
+b.hs 1f
+mov x0, #1
+1:
+ret
+
+// After TST, a logical operation, the signed conditions compare the result
+// to 0.
+// CHECK-LABEL: define void @fn_44(
+// CHECK: [[AND:%[0-9]+]] = and i64
+// CHECK: [[C:%[0-9]+]] = icmp sgt i64 [[AND]], 0
+// CHECK: br i1 [[C]], label %bb_50, label %bb_4C
+_tst:
+tst x0, x1
+b.gt 1f
+mov x0, #1
+1:
+ret
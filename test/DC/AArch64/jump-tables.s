@@ -0,0 +1,76 @@
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj %s -o %t.o
+// RUN: llvm-dec -o - %t.o | FileCheck %s
+
+.globl _main
+_main:
+bl _bounded
+bl _unbounded
+ret
+
+// The CMP bounds the table: each of its entries is a case of the switch, and
+// the other targets are translated when they're first reached.
+// CHECK-LABEL: define void @fn_C(
+// CHECK: [[T:%X9_[0-9]+]] = add i64 40,
+// CHECK: switch i64 [[T]], label %[[DEFAULT:[0-9]+]] [
+// CHECK-NEXT: i64 40, label %bb_28
+// CHECK-NEXT: i64 48, label %bb_30
+// CHECK-NEXT: i64 56, label %bb_38
+// CHECK-NEXT: i64 64, label %bb_40
+// CHECK-NEXT: ]
+// CHECK: ; <label>:[[DEFAULT]]
+// CHECK-NEXT: inttoptr i64 [[T]] to i8*
+// CHECK-NEXT: call void (%regset*)* @__llvm_dc_translate_at(
+_bounded:
+cmp w0, #3
+b.hi Ldefault
+adr x8, Ltable
+adr x9, Lcase0
+ldrsw x10, [x8, x0, lsl #2]
+add x9, x9, x10
+br x9
+Lcase0:
+mov x0, #10
+ret
+Lcase1:
+mov x0, #11
+ret
+Lcase2:
+mov x0, #12
+ret
+Lcase3:
+mov x0, #13
+ret
+Ldefault:
+mov x0, #0
+ret
+.p2align 2
+Ltable:
+.long Lcase0-Lcase0
+.long Lcase1-Lcase0
+.long Lcase2-Lcase0
+.long Lcase3-Lcase0
+
+// Without a bound, the table ends at its first entry outside of the function.
+// This is the last function: the end of the section bounds it.
+// CHECK-LABEL: define void @fn_60(
+// CHECK: switch i64 [[T:%X9_[0-9]+]], label %{{[0-9]+}} [
+// CHECK-NEXT: i64 116, label %bb_74
+// CHECK-NEXT: i64 124, label %bb_7C
+// CHECK-NEXT: ]
+_unbounded:
+adr x8, Lbytes
+adr x9, Lb0
+ldrb w10, [x8, x0]
+add x9, x9, x10, lsl #2
+br x9
+Lb0:
+mov x0, #20
+ret
+Lb1:
+mov x0, #21
+ret
+Lbytes:
+.byte (Lb0-Lb0)>>2
+.byte (Lb1-Lb0)>>2
+.byte 0xff
+.p2align 2
@@ -0,0 +1,37 @@
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj %s -o %t.o
+// RUN: llvm-dec -mc-only -o - %t.o 2>&1 | FileCheck %s
+// RUN: not llvm-dec -mc-only -stream-functions=1 -o %t.ll %t.o 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=CONFLICT
+
+.globl _main
+_main:
+bl _f
+bl _g
+ret
+
+_f:
+cbz x0, 1f
+add x0, x0, #2
+1:
+ret
+
+// The tail call is a call, and the return synthesized after it.
+_g:
+b _f
+
+.cstring
+.asciz "triage"
+
+// Nothing is translated.
+// CHECK-NOT: define
+// CHECK: Triage: 3 functions, 0 stubs, 3 calls, 1 strings (0 xrefs)
+// CHECK-NEXT: func 0x0 1 3 {{[0-9a-f]+}} {{.*}}
+// CHECK-NEXT: func 0xc 3 3 {{[0-9a-f]+}} f
+// CHECK-NEXT: func 0x18 1 2 {{[0-9a-f]+}} g
+// CHECK-NEXT: call 0x0 0xc
+// CHECK-NEXT: call 0x0 0x18
+// CHECK-NEXT: call 0x18 0xc
+// CHECK-NEXT: string 0x{{[0-9a-f]+}} __cstring "triage"
+// CHECK-NOT: define
+
+// CONFLICT: -mc-only can't be used with -stream-functions
@@ -0,0 +1,35 @@
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj %s -o %t.o
+// RUN: llvm-dec -collapse-memory-transfers -o - %t.o | FileCheck %s
+// RUN: llvm-dec -o - %t.o | FileCheck %s --check-prefix=PAIRS
+
+.globl _main
+_main:
+// A copy, stored in another order than loaded.
+ldp x8, x9, [x1]
+ldp x10, x11, [x1, #16]
+stp x10, x11, [x0, #16]
+stp x8, x9, [x0]
+// A clear.
+stp xzr, xzr, [x2, #16]
+stp xzr, xzr, [x2]
+// The registers are swapped: not a copy.
+ldp x12, x13, [x3]
+ldp x14, x15, [x3, #16]
+stp x14, x15, [x4]
+stp x12, x13, [x4, #16]
+ret
+
+// CHECK-LABEL: bb_0:
+// CHECK: [[DST:%[0-9]+]] = inttoptr i64 %X0_0 to i8*
+// CHECK: [[SRC:%[0-9]+]] = inttoptr i64 %X1_0 to i8*
+// CHECK: call void @llvm.memmove.p0i8.p0i8.i64(i8* [[DST]], i8* [[SRC]], i64 32, i32 1, i1 false)
+// CHECK: %X10_0 = load i64
+// CHECK: %X11_0 = load i64
+// CHECK: %X8_0 = load i64
+// CHECK: %X9_0 = load i64
+// CHECK: call void @llvm.memset.p0i8.i64(i8* %{{[0-9]+}}, i8 0, i64 32, i32 1, i1 false)
+// CHECK-NOT: @llvm.mem
+// CHECK: %X12_{{[0-9]+}} = load i64
+// CHECK: br label %exit_fn_0
+
+// PAIRS-NOT: @llvm.mem
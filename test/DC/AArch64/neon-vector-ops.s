@@ -0,0 +1,71 @@
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj %s -o %t.o
+// RUN: llvm-dec -aarch64-decode-fp-simd -o - %t.o | FileCheck %s
+
+.globl _main
+_main:
+ld2 {v0.4s, v1.4s}, [x0]
+st3 {v2.8b, v3.8b, v4.8b}, [x1]
+tbl v5.16b, {v6.16b, v7.16b}, v8.16b
+tbx v9.8b, {v10.16b}, v11.8b
+fcvtl v12.2d, v13.2s
+fcvtl2 v14.4s, v15.8h
+fcvtn v16.2s, v17.2d
+fcvtn2 v18.4s, v19.2d
+ret
+
+// CHECK-LABEL: bb_0:
+
+// LD2: the loaded elements are deinterleaved into the two registers.
+// CHECK: [[P:%[0-9]+]] = inttoptr i64 %X0_0 to i256*
+// CHECK-NEXT: [[V:%[0-9]+]] = load i256, i256* [[P]]
+// CHECK-NEXT: [[E:%[0-9]+]] = bitcast i256 [[V]] to <8 x i32>
+// CHECK-NEXT: [[S:%[0-9]+]] = shufflevector <8 x i32> [[E]], <8 x i32> undef, <8 x i32> <i32 0, i32 2, i32 4, i32 6, i32 1, i32 3, i32 5, i32 7>
+// CHECK-NEXT: [[T:%[0-9]+]] = bitcast <8 x i32> [[S]] to i256
+// CHECK-NEXT: %Q0_0 = trunc i256 [[T]] to i128
+// CHECK-NEXT: [[HI:%[0-9]+]] = lshr i256 [[T]], 128
+// CHECK-NEXT: %Q1_0 = trunc i256 [[HI]] to i128
+
+// ST3 of D registers: each contributes its 64 bits, which are interleaved.
+// CHECK: [[P:%[0-9]+]] = inttoptr i64 %X1_0 to i192*
+// CHECK: [[D2:%[0-9]+]] = trunc i512 %Q2_Q3_Q4_Q5_0 to i64
+// CHECK: [[D3:%[0-9]+]] = trunc i512 %Q3_Q4_Q5_Q6_0 to i64
+// CHECK: [[D4:%[0-9]+]] = trunc i512 %Q4_Q5_Q6_Q7_0 to i64
+// CHECK-NEXT: [[X2:%[0-9]+]] = zext i64 [[D2]] to i192
+// CHECK-NEXT: [[X3:%[0-9]+]] = zext i64 [[D3]] to i192
+// CHECK-NEXT: [[S3:%[0-9]+]] = shl i192 [[X3]], 64
+// CHECK-NEXT: [[X4:%[0-9]+]] = zext i64 [[D4]] to i192
+// CHECK-NEXT: [[S4:%[0-9]+]] = shl i192 [[X4]], 128
+// CHECK-NEXT: [[O:%[0-9]+]] = or i192 [[S3]], [[S4]]
+// CHECK-NEXT: [[V:%[0-9]+]] = or i192 [[X2]], [[O]]
+// CHECK-NEXT: [[E:%[0-9]+]] = bitcast i192 [[V]] to <24 x i8>
+// CHECK-NEXT: [[S:%[0-9]+]] = shufflevector <24 x i8> [[E]], <24 x i8> undef, <24 x i32> <i32 0, i32 8, i32 16, i32 1, i32 9, i32 17, i32 2, i32 10, i32 18, i32 3, i32 11, i32 19, i32 4, i32 12, i32 20, i32 5, i32 13, i32 21, i32 6, i32 14, i32 22, i32 7, i32 15, i32 23>
+// CHECK-NEXT: [[T:%[0-9]+]] = bitcast <24 x i8> [[S]] to i192
+// CHECK-NEXT: store i192 [[T]], i192* [[P]]
+
+// TBL of two registers: the table is split back into its registers.
+// CHECK: [[LO:%[0-9]+]] = shufflevector <32 x i8> [[TBL:%[0-9]+]], <32 x i8> undef, <16 x i32> <i32 0, i32 1, i32 2, i32 3, i32 4, i32 5, i32 6, i32 7, i32 8, i32 9, i32 10, i32 11, i32 12, i32 13, i32 14, i32 15>
+// CHECK-NEXT: [[HI:%[0-9]+]] = shufflevector <32 x i8> [[TBL]], <32 x i8> undef, <16 x i32> <i32 16, i32 17, i32 18, i32 19, i32 20, i32 21, i32 22, i32 23, i32 24, i32 25, i32 26, i32 27, i32 28, i32 29, i32 30, i32 31>
+// CHECK-NEXT: [[R:%[0-9]+]] = call <16 x i8> @llvm.aarch64.neon.tbl2.v16i8(<16 x i8> [[LO]], <16 x i8> [[HI]], <16 x i8> %{{[0-9]+}})
+// CHECK-NEXT: %Q5_0 = bitcast <16 x i8> [[R]] to i128
+
+// TBX: the destination is also an operand, for the indices out of range.
+// CHECK: [[R:%[0-9]+]] = call <8 x i8> @llvm.aarch64.neon.tbx1.v8i8(<8 x i8> %{{[0-9]+}}, <16 x i8> %{{[0-9]+}}, <8 x i8> %{{[0-9]+}})
+// CHECK-NEXT: %D9_0 = bitcast <8 x i8> [[R]] to i64
+
+// FCVTL widens the lower half, FCVTL2 the upper half.
+// CHECK: [[E:%[0-9]+]] = fpext <2 x float> %{{[0-9]+}} to <2 x double>
+// CHECK-NEXT: %Q12_0 = bitcast <2 x double> [[E]] to i128
+// CHECK: [[H:%[0-9]+]] = shufflevector <8 x half> %{{[0-9]+}}, <8 x half> undef, <4 x i32> <i32 4, i32 5, i32 6, i32 7>
+// CHECK-NEXT: [[E:%[0-9]+]] = fpext <4 x half> [[H]] to <4 x float>
+// CHECK-NEXT: %Q14_0 = bitcast <4 x float> [[E]] to i128
+
+// FCVTN narrows to the lower half, clearing the upper one; FCVTN2 narrows to
+// the upper half, keeping the lower one.
+// CHECK: [[N:%[0-9]+]] = fptrunc <2 x double> %{{[0-9]+}} to <2 x float>
+// CHECK-NEXT: %D16_0 = bitcast <2 x float> [[N]] to i64
+// CHECK: %Q16_Q17_Q18_Q19_1 = zext i64 %D16_0 to i512
+// CHECK: [[N:%[0-9]+]] = fptrunc <2 x double> %{{[0-9]+}} to <2 x float>
+// CHECK: [[L:%[0-9]+]] = bitcast i128 %{{[0-9]+}} to <4 x float>
+// CHECK-NEXT: [[W:%[0-9]+]] = shufflevector <2 x float> [[N]], <2 x float> undef, <4 x i32> <i32 0, i32 1, i32 0, i32 1>
+// CHECK-NEXT: [[B:%[0-9]+]] = shufflevector <4 x float> [[L]], <4 x float> [[W]], <4 x i32> <i32 0, i32 1, i32 4, i32 5>
+// CHECK-NEXT: %Q18_0 = bitcast <4 x float> [[B]] to i128
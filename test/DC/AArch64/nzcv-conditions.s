@@ -0,0 +1,232 @@
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj %s -o %t.o
+// RUN: llvm-dec -o - %t.o | FileCheck %s
+
+// The conditions read the flags of a CMN, which aren't fused into a compare:
+// each computes the flags it reads, right after the sum, and NZCV is only
+// materialized from them at the end of the block.
+
+.globl _main
+_main:
+bl _eq
+bl _ne
+bl _hs
+bl _lo
+bl _mi
+bl _pl
+bl _vs
+bl _vc
+bl _hi
+bl _ls
+bl _ge
+bl _lt
+bl _gt
+bl _le
+ret
+
+// Z is the sum being 0.
+// CHECK-LABEL: define void @fn_3C(
+// CHECK: [[S:%[0-9]+]] = add i64 [[L:%X0_[0-9]+]], [[R:%[0-9]+]]
+// CHECK-NEXT: load i32, i32* %NZCV
+// CHECK-NEXT: [[C:%[0-9]+]] = icmp eq i64 [[S]], 0
+// CHECK: br i1 [[C]], label %bb_48, label %bb_44
+_eq:
+cmn x0, x1
+b.eq 1f
+mov x0, #1
+1:
+ret
+
+// CHECK-LABEL: define void @fn_4C(
+// CHECK: [[S:%[0-9]+]] = add i64 [[L:%X0_[0-9]+]], [[R:%[0-9]+]]
+// CHECK-NEXT: load i32, i32* %NZCV
+// CHECK-NEXT: [[Z:%[0-9]+]] = icmp eq i64 [[S]], 0
+// CHECK-NEXT: [[C:%[0-9]+]] = xor i1 [[Z]], true
+// CHECK: br i1 [[C]], label %bb_58, label %bb_54
+_ne:
+cmn x0, x1
+b.ne 1f
+mov x0, #1
+1:
+ret
+
+// C is the carry out of the sum.
+// CHECK-LABEL: define void @fn_5C(
+// CHECK: [[S:%[0-9]+]] = add i64 [[L:%X0_[0-9]+]], [[R:%[0-9]+]]
+// CHECK-NEXT: load i32, i32* %NZCV
+// CHECK-NEXT: [[UO:%[0-9]+]] = call { i64, i1 } @llvm.uadd.with.overflow.i64(i64 [[L]], i64 [[R]])
+// CHECK-NEXT: [[C:%[0-9]+]] = extractvalue { i64, i1 } [[UO]], 1
+// CHECK: br i1 [[C]], label %bb_68, label %bb_64
+_hs:
+cmn x0, x1
+b.hs 1f
+mov x0, #1
+1:
+ret
+
+// CHECK-LABEL: define void @fn_6C(
+// CHECK: [[S:%[0-9]+]] = add i64 [[L:%X0_[0-9]+]], [[R:%[0-9]+]]
+// CHECK-NEXT: load i32, i32* %NZCV
+// CHECK-NEXT: [[UO:%[0-9]+]] = call { i64, i1 } @llvm.uadd.with.overflow.i64(i64 [[L]], i64 [[R]])
+// CHECK-NEXT: [[CF:%[0-9]+]] = extractvalue { i64, i1 } [[UO]], 1
+// CHECK-NEXT: [[C:%[0-9]+]] = xor i1 [[CF]], true
+// CHECK: br i1 [[C]], label %bb_78, label %bb_74
+_lo:
+cmn x0, x1
+b.lo 1f
+mov x0, #1
+1:
+ret
+
+// N is the sign of the sum.
+// CHECK-LABEL: define void @fn_7C(
+// CHECK: [[S:%[0-9]+]] = add i64 [[L:%X0_[0-9]+]], [[R:%[0-9]+]]
+// CHECK-NEXT: load i32, i32* %NZCV
+// CHECK-NEXT: [[C:%[0-9]+]] = icmp slt i64 [[S]], 0
+// CHECK: br i1 [[C]], label %bb_88, label %bb_84
+_mi:
+cmn x0, x1
+b.mi 1f
+mov x0, #1
+1:
+ret
+
+// CHECK-LABEL: define void @fn_8C(
+// CHECK: [[S:%[0-9]+]] = add i64 [[L:%X0_[0-9]+]], [[R:%[0-9]+]]
+// CHECK-NEXT: load i32, i32* %NZCV
+// CHECK-NEXT: [[N:%[0-9]+]] = icmp slt i64 [[S]], 0
+// CHECK-NEXT: [[C:%[0-9]+]] = xor i1 [[N]], true
+// CHECK: br i1 [[C]], label %bb_98, label %bb_94
+_pl:
+cmn x0, x1
+b.pl 1f
+mov x0, #1
+1:
+ret
+
+// V is the signed overflow of the sum.
+// CHECK-LABEL: define void @fn_9C(
+// CHECK: [[S:%[0-9]+]] = add i64 [[L:%X0_[0-9]+]], [[R:%[0-9]+]]
+// CHECK-NEXT: load i32, i32* %NZCV
+// CHECK-NEXT: [[SO:%[0-9]+]] = call { i64, i1 } @llvm.sadd.with.overflow.i64(i64 [[L]], i64 [[R]])
+// CHECK-NEXT: [[C:%[0-9]+]] = extractvalue { i64, i1 } [[SO]], 1
+// CHECK: br i1 [[C]], label %bb_A8, label %bb_A4
+_vs:
+cmn x0, x1
+b.vs 1f
+mov x0, #1
+1:
+ret
+
+// CHECK-LABEL: define void @fn_AC(
+// CHECK: [[S:%[0-9]+]] = add i64 [[L:%X0_[0-9]+]], [[R:%[0-9]+]]
+// CHECK-NEXT: load i32, i32* %NZCV
+// CHECK-NEXT: [[SO:%[0-9]+]] = call { i64, i1 } @llvm.sadd.with.overflow.i64(i64 [[L]], i64 [[R]])
+// CHECK-NEXT: [[V:%[0-9]+]] = extractvalue { i64, i1 } [[SO]], 1
+// CHECK-NEXT: [[C:%[0-9]+]] = xor i1 [[V]], true
+// CHECK: br i1 [[C]], label %bb_B8, label %bb_B4
+_vc:
+cmn x0, x1
+b.vc 1f
+mov x0, #1
+1:
+ret
+
+// The flags the condition computed are those NZCV is made of.
+// CHECK-LABEL: define void @fn_BC(
+// CHECK: [[S:%[0-9]+]] = add i64 [[L:%X0_[0-9]+]], [[R:%[0-9]+]]
+// CHECK-NEXT: load i32, i32* %NZCV
+// CHECK-NEXT: [[Z:%[0-9]+]] = icmp eq i64 [[S]], 0
+// CHECK-NEXT: [[NZ:%[0-9]+]] = xor i1 [[Z]], true
+// CHECK-NEXT: [[UO:%[0-9]+]] = call { i64, i1 } @llvm.uadd.with.overflow.i64(i64 [[L]], i64 [[R]])
+// CHECK-NEXT: [[CF:%[0-9]+]] = extractvalue { i64, i1 } [[UO]], 1
+// CHECK-NEXT: [[C:%[0-9]+]] = and i1 [[CF]], [[NZ]]
+// CHECK: zext i1 [[Z]] to i32
+// CHECK: zext i1 [[CF]] to i32
+// CHECK: br i1 [[C]], label %bb_C8, label %bb_C4
+_hi:
+cmn x0, x1
+b.hi 1f
+mov x0, #1
+1:
+ret
+
+// CHECK-LABEL: define void @fn_CC(
+// CHECK: [[S:%[0-9]+]] = add i64 [[L:%X0_[0-9]+]], [[R:%[0-9]+]]
+// CHECK-NEXT: load i32, i32* %NZCV
+// CHECK-NEXT: [[Z:%[0-9]+]] = icmp eq i64 [[S]], 0
+// CHECK-NEXT: [[UO:%[0-9]+]] = call { i64, i1 } @llvm.uadd.with.overflow.i64(i64 [[L]], i64 [[R]])
+// CHECK-NEXT: [[CF:%[0-9]+]] = extractvalue { i64, i1 } [[UO]], 1
+// CHECK-NEXT: [[NC:%[0-9]+]] = xor i1 [[CF]], true
+// CHECK-NEXT: [[C:%[0-9]+]] = or i1 [[NC]], [[Z]]
+// CHECK: br i1 [[C]], label %bb_D8, label %bb_D4
+_ls:
+cmn x0, x1
+b.ls 1f
+mov x0, #1
+1:
+ret
+
+// CHECK-LABEL: define void @fn_DC(
+// CHECK: [[S:%[0-9]+]] = add i64 [[L:%X0_[0-9]+]], [[R:%[0-9]+]]
+// CHECK-NEXT: load i32, i32* %NZCV
+// CHECK-NEXT: [[SO:%[0-9]+]] = call { i64, i1 } @llvm.sadd.with.overflow.i64(i64 [[L]], i64 [[R]])
+// CHECK-NEXT: [[V:%[0-9]+]] = extractvalue { i64, i1 } [[SO]], 1
+// CHECK-NEXT: [[N:%[0-9]+]] = icmp slt i64 [[S]], 0
+// CHECK-NEXT: [[C:%[0-9]+]] = icmp eq i1 [[N]], [[V]]
+// CHECK: br i1 [[C]], label %bb_E8, label %bb_E4
+_ge:
+cmn x0, x1
+b.ge 1f
+mov x0, #1
+1:
+ret
+
+// CHECK-LABEL: define void @fn_EC(
+// CHECK: [[S:%[0-9]+]] = add i64 [[L:%X0_[0-9]+]], [[R:%[0-9]+]]
+// CHECK-NEXT: load i32, i32* %NZCV
+// CHECK-NEXT: [[SO:%[0-9]+]] = call { i64, i1 } @llvm.sadd.with.overflow.i64(i64 [[L]], i64 [[R]])
+// CHECK-NEXT: [[V:%[0-9]+]] = extractvalue { i64, i1 } [[SO]], 1
+// CHECK-NEXT: [[N:%[0-9]+]] = icmp slt i64 [[S]], 0
+// CHECK-NEXT: [[C:%[0-9]+]] = icmp ne i1 [[N]], [[V]]
+// CHECK: br i1 [[C]], label %bb_F8, label %bb_F4
+_lt:
+cmn x0, x1
+b.lt 1f
+mov x0, #1
+1:
+ret
+
+// CHECK-LABEL: define void @fn_FC(
+// CHECK: [[S:%[0-9]+]] = add i64 [[L:%X0_[0-9]+]], [[R:%[0-9]+]]
+// CHECK-NEXT: load i32, i32* %NZCV
+// CHECK-NEXT: [[SO:%[0-9]+]] = call { i64, i1 } @llvm.sadd.with.overflow.i64(i64 [[L]], i64 [[R]])
+// CHECK-NEXT: [[V:%[0-9]+]] = extractvalue { i64, i1 } [[SO]], 1
+// CHECK-NEXT: [[N:%[0-9]+]] = icmp slt i64 [[S]], 0
+// CHECK-NEXT: [[NV:%[0-9]+]] = icmp eq i1 [[N]], [[V]]
+// CHECK-NEXT: [[Z:%[0-9]+]] = icmp eq i64 [[S]], 0
+// CHECK-NEXT: [[NZ:%[0-9]+]] = xor i1 [[Z]], true
+// CHECK-NEXT: [[C:%[0-9]+]] = and i1 [[NZ]], [[NV]]
+// CHECK: br i1 [[C]], label %bb_108, label %bb_104
+_gt:
+cmn x0, x1
+b.gt 1f
+mov x0, #1
+1:
+ret
+
+// CHECK-LABEL: define void @fn_10C(
+// CHECK: [[S:%[0-9]+]] = add i64 [[L:%X0_[0-9]+]], [[R:%[0-9]+]]
+// CHECK-NEXT: load i32, i32* %NZCV
+// CHECK-NEXT: [[SO:%[0-9]+]] = call { i64, i1 } @llvm.sadd.with.overflow.i64(i64 [[L]], i64 [[R]])
+// CHECK-NEXT: [[V:%[0-9]+]] = extractvalue { i64, i1 } [[SO]], 1
+// CHECK-NEXT: [[N:%[0-9]+]] = icmp slt i64 [[S]], 0
+// CHECK-NEXT: [[NV:%[0-9]+]] = icmp ne i1 [[N]], [[V]]
+// CHECK-NEXT: [[Z:%[0-9]+]] = icmp eq i64 [[S]], 0
+// CHECK-NEXT: [[C:%[0-9]+]] = or i1 [[Z]], [[NV]]
+// CHECK: br i1 [[C]], label %bb_118, label %bb_114
+_le:
+cmn x0, x1
+b.le 1f
+mov x0, #1
+1:
+ret
@@ -0,0 +1,83 @@
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj %s -o %t.o
+// RUN: llvm-dec -synthesize-objc-accessors -o - %t.o | FileCheck %s
+// RUN: llvm-dec -o - %t.o | FileCheck %s --check-prefix=TRANSLATED
+
+// Anything else is translated.
+// CHECK-LABEL: define void @"-[Model next]"(
+// CHECK: alloca i64
+
+// The getter loads the ivar into the result directly.
+// CHECK-LABEL: define void @"-[Model count]"(
+// CHECK-NOT: alloca
+// CHECK: add i64 %{{[0-9]+}}, 8
+// CHECK: load i64, i64* %
+// CHECK: ret void
+
+// The setter stores the low half of its argument.
+// CHECK-LABEL: define void @"-[Model setFlag:]"(
+// CHECK-NOT: alloca
+// CHECK: add i64 %{{[0-9]+}}, 16
+// CHECK: trunc i64 %{{[0-9]+}} to i32
+// CHECK: store i32
+// CHECK: ret void
+
+// TRANSLATED-LABEL: define void @"-[Model count]"(
+// TRANSLATED: alloca i64
+
+.globl _main
+_main:
+ret
+_count:
+ldr x0, [x0, #8]
+ret
+_setFlag:
+str w2, [x0, #16]
+ret
+_next:
+ldr x0, [x0, #8]
+add x0, x0, #1
+ret
+
+// The metadata of the class Model, with the addresses laid out here, as the
+// Objective-C sections of an object file are left to the linker to fill.
+.section __DATA,__objc_const
+.p2align 3
+// class_ro_t, at 0x20.
+.long 0, 8, 24, 0
+.quad 0
+.quad 0xe8
+.quad 0x68
+.quad 0, 0, 0, 0
+// method_list_t, at 0x68.
+.long 24, 3
+.quad 0xee
+.quad 0
+.quad 0x4
+.quad 0xf4
+.quad 0
+.quad 0xc
+.quad 0xfd
+.quad 0
+.quad 0x14
+
+.section __DATA,__objc_data
+.p2align 3
+// class_t, at 0xb8, without a metaclass.
+.quad 0, 0, 0, 0
+.quad 0x20
+
+.section __DATA,__objc_classlist
+.p2align 3
+.quad 0xb8
+
+.section __TEXT,__objc_classname,cstring_literals
+.asciz "Model"
+.section __TEXT,__objc_methname,cstring_literals
+.asciz "count"
+.asciz "setFlag:"
+.asciz "next"
+
+// After all the classes.
+.section __DATA,__data
+.p2align 3
+.quad 0
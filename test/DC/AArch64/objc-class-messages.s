@@ -0,0 +1,90 @@
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj %s -o %t.o
+// RUN: llvm-dec -o - %t.o | FileCheck %s
+
+// The addresses the relocations of an object would give: the sections are
+// at the end of the previous one, aligned to 16 bytes.
+.set STUB, 0x30
+.set METHNAME, 0x40
+.set CLASSNAME, 0x50
+.set CONST, 0x60
+.set METHODS, CONST + 144
+.set METACLASS, 0x110
+.set CLASS, METACLASS + 40
+.set SELREF, 0x170
+.set CLASSREF, 0x180
+.set ANSWER, 0x28
+
+// The receiver and the selector come from references of the block: the
+// message goes to +[Foo answer], the class method the metadata has for them.
+// CHECK-LABEL: define void @fn_0(
+// CHECK-NOT: @objc_msgSend
+// CHECK: call void @"+[Foo answer]"(%regset* %0)
+// CHECK: define void @"+[Foo answer]"(
+.globl _main
+_main:
+adrp x8, #0
+ldr x0, [x8, #CLASSREF]
+adrp x9, #0
+ldr x1, [x9, #SELREF]
+bl #(STUB - 0x10)
+ret
+
+// The class of the receiver isn't known: the message stays a call to
+// objc_msgSend.
+// CHECK-LABEL: define void @fn_18(
+// CHECK: call void @objc_msgSend(%regset* %0)
+.globl _other
+_other:
+adrp x9, #0
+ldr x1, [x9, #SELREF]
+bl #(STUB - 0x20)
+ret
+
+_answer:
+mov x0, #42
+ret
+
+.section __TEXT,__stubs,symbol_stubs,pure_instructions,12
+.p2align 4
+.indirect_symbol _objc_msgSend
+nop
+ldr x16, #8
+br x16
+
+.section __TEXT,__objc_methname,cstring_literals
+.p2align 4
+.asciz "answer"
+.asciz "q16@0:8"
+
+.section __TEXT,__objc_classname,cstring_literals
+.p2align 4
+.asciz "Foo"
+
+.section __DATA,__objc_const
+.p2align 4
+// The class_ro_t of the metaclass, with the method list, then of the class.
+.long 1, 40, 40, 0
+.quad 0, CLASSNAME, METHODS, 0, 0, 0, 0
+.long 0, 8, 8, 0
+.quad 0, CLASSNAME, 0, 0, 0, 0, 0
+// The method list: +answer.
+.long 24, 1
+.quad METHNAME, METHNAME + 7, ANSWER
+
+.section __DATA,__objc_data
+.p2align 4
+// The metaclass, then the class.
+.quad 0, 0, 0, 0, CONST
+.quad METACLASS, 0, 0, 0, CONST + 72
+
+.section __DATA,__objc_classlist,regular,no_dead_strip
+.p2align 4
+.quad CLASS
+
+.section __DATA,__objc_selrefs,literal_pointers,no_dead_strip
+.p2align 4
+.quad METHNAME
+
+.section __DATA,__objc_classrefs,regular,no_dead_strip
+.p2align 4
+.quad CLASS
@@ -0,0 +1,37 @@
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj %s -o %t.o
+// RUN: llvm-dec -O2 -dc-outline-cold -o - %t.o | FileCheck %s
+// RUN: llvm-dec -O2 -dc-outline-cold -o - %t.o | opt -verify -disable-output
+// RUN: llvm-dec -O2 -o - %t.o | FileCheck %s -check-prefix=NOOUTLINE
+
+// The path to the trap, with the block before it, is outlined once the
+// function is optimized.
+.globl _main
+_main:
+cbz x0, Lfail
+add x0, x0, #1
+ret
+Lfail:
+ldr x3, [x1]
+add x3, x3, x2
+str x3, [x1, #8]
+brk #1
+
+// CHECK-LABEL: define void @fn_0(
+// CHECK: bb_0:
+// CHECK-NEXT: [[C:%[0-9]+]] = icmp eq i64 %X0_init, 0
+// CHECK-NEXT: br i1 [[C]], label %codeRepl, label %bb_4
+// CHECK: codeRepl:
+// CHECK-NEXT: call void @fn_0.cold(
+// CHECK-NOT: @llvm.trap
+// CHECK: }
+
+// CHECK: define internal void @fn_0.cold(
+// CHECK-SAME: #[[ATTRS:[0-9]+]] {
+// CHECK: bb_C:
+// CHECK: %X3_{{[0-9]+}} = add i64 %X3_{{[0-9]+}}, %X2_init
+// CHECK: call void @llvm.trap()
+// CHECK-NEXT: unreachable
+// CHECK: attributes #[[ATTRS]] = { cold minsize noinline optsize }
+
+// NOOUTLINE-NOT: cold
+// NOOUTLINE: call void @llvm.trap()
@@ -0,0 +1,21 @@
+// RUN: llvm-mc -triple=aarch64-linux-gnu -filetype=obj %s -o %t.o
+// RUN: llvm-dec -mc-only -o - %t.o 2>&1 | FileCheck %s
+
+// The text sections of a relocatable object both start at address 0: their
+// addresses are tracked once, but the linear size counts the instructions of
+// both.
+.text
+.globl f
+f:
+add x0, x0, #1
+ret
+
+.section .text.g,"ax",@progbits
+.globl g
+g:
+sub x0, x0, #1
+ret
+
+// CHECK: Section: .text
+// CHECK: Section: .text.g
+// CHECK: Linear code size: 4
@@ -0,0 +1,31 @@
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj %s -o %t.o
+// RUN: rm -rf %t.cache
+
+// The call basic blocks translated on other threads are found back by the
+// tags of their calls once linked, the same as those translated in place,
+// and the tags don't reach the output.
+// RUN: llvm-dec -quality-metrics -o %t.serial.ll %t.o 2>&1 | FileCheck %s
+// RUN: llvm-dec -dc-jobs=2 -quality-metrics -o %t.ll %t.o 2>&1 \
+// RUN:   | FileCheck %s
+// RUN: FileCheck %s --check-prefix=IR < %t.ll
+
+// So are those of cached translations, and of those optimized once read
+// back from the cache.
+// RUN: llvm-dec -dc-jobs=2 -dc-cache=%t.cache -quality-metrics -o /dev/null \
+// RUN:   %t.o 2>&1 | FileCheck %s
+// RUN: llvm-dec -dc-jobs=2 -dc-cache=%t.cache -quality-metrics -o /dev/null \
+// RUN:   %t.o 2>&1 | FileCheck %s
+// RUN: llvm-dec -dc-jobs=2 -dc-cache=%t.cache -dc-cache-unoptimized -O1 \
+// RUN:   -quality-metrics -o %t.opt.ll %t.o 2>&1 | FileCheck %s
+// RUN: FileCheck %s --check-prefix=IR < %t.opt.ll
+
+// CHECK: call basic blocks: 2
+// IR-NOT: dc.call.bb
+
+.globl _main
+_main:
+bl #12
+nop
+ret
+bl #-12
+ret
@@ -0,0 +1,59 @@
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj %s -o %t.o
+// RUN: llvm-dec -o - %t.o | FileCheck %s
+
+// The authentications and strips of instruction pointers keep the 47 bits of
+// the address, and the signing instructions (PACIBSP is hint #27) are nops:
+// X1 isn't even read.
+// CHECK-LABEL: define void @fn_0(
+// CHECK-NOT: %X1
+// CHECK-LABEL: bb_0:
+// CHECK: [[X0:%X0_[0-9]+]] = load i64, i64* %X0
+// CHECK-NEXT: [[X0AUT:%X0_[0-9]+]] = and i64 [[X0]], 140737488355327
+// CHECK: [[X2:%X2_[0-9]+]] = load i64, i64* %X2
+// CHECK-NEXT: [[X2AUT:%X2_[0-9]+]] = and i64 [[X2]], 140737488355327
+// CHECK: [[X3:%X3_[0-9]+]] = load i64, i64* %X3
+// CHECK-NEXT: [[X3AUT:%X3_[0-9]+]] = and i64 [[X3]], 140737488355327
+// CHECK-DAG: store i64 [[X0AUT]], i64* %X0
+// CHECK-DAG: store i64 [[X2AUT]], i64* %X2
+// CHECK-DAG: store i64 [[X3AUT]], i64* %X3
+// CHECK: br label %exit_fn_0
+_fn_code:
+  hint #27
+  paciza x1
+  autia x0, x1
+  autizb x2
+  xpaci x3
+  retab
+
+// Data pointers also keep their top byte, 0xFF007FFFFFFFFFFF.
+// CHECK-LABEL: bb_18:
+// CHECK: [[X0:%X0_[0-9]+]] = load i64, i64* %X0
+// CHECK-NEXT: and i64 [[X0]], -71916856549572609
+// CHECK: [[X2:%X2_[0-9]+]] = load i64, i64* %X2
+// CHECK-NEXT: and i64 [[X2]], -71916856549572609
+// CHECK: [[X3:%X3_[0-9]+]] = load i64, i64* %X3
+// CHECK-NEXT: and i64 [[X3]], -71916856549572609
+// CHECK: br label %exit_fn_18
+_fn_data:
+  pacda x0, x1
+  autda x0, x1
+  autdzb x2
+  xpacd x3
+  ret
+
+// The authenticated branches and calls go to their stripped target.
+// CHECK-LABEL: bb_2C:
+// CHECK: [[X16:%X16_[0-9]+]] = load i64, i64* %X16
+// CHECK-NEXT: [[TARGET:%[0-9]+]] = and i64 [[X16]], 140737488355327
+// CHECK-NEXT: inttoptr i64 [[TARGET]] to i8*
+_fn_br:
+  braa x16, x17
+
+// CHECK-LABEL: bb_30:
+// CHECK: [[X8:%X8_[0-9]+]] = load i64, i64* %X8
+// CHECK-NEXT: [[TARGET:%[0-9]+]] = and i64 [[X8]], 140737488355327
+// CHECK-NEXT: inttoptr i64 [[TARGET]] to i8*
+// CHECK: call void %{{[0-9]+}}(%regset* %0)
+_fn_call:
+  blraaz x8
+  ret
@@ -0,0 +1,53 @@
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj %s -o %t.o
+// RUN: rm -rf %t.ll %t.ll.hash %t.cache %t.a.ll %t.b.ll %t.c.ll
+
+// With -skip-unchanged, the second run finds the output written from the
+// same input, with the same options, and doesn't decompile again.
+// RUN: llvm-dec -skip-unchanged -o %t.ll %t.o 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=DECOMPILE
+// RUN: llvm-dec -skip-unchanged -o %t.ll %t.o 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=SKIP
+// RUN: FileCheck %s --check-prefix=IR < %t.ll
+
+// Another input, or other options, decompile again.
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj -defsym CHANGED=1 %s \
+// RUN:   -o %t.o
+// RUN: llvm-dec -skip-unchanged -o %t.ll %t.o 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=DECOMPILE
+// RUN: FileCheck %s --check-prefix=CHANGED < %t.ll
+// RUN: llvm-dec -skip-unchanged -dc-fold -o %t.ll %t.o 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=DECOMPILE
+// RUN: llvm-dec -skip-unchanged -dc-fold -o %t.ll %t.o 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=SKIP
+
+// -output-cache keeps the outputs by hash: another output of the same input
+// is taken from it, until the input changes.
+// RUN: llvm-dec -output-cache=%t.cache -o %t.a.ll %t.o 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=DECOMPILE
+// RUN: llvm-dec -output-cache=%t.cache -o %t.b.ll %t.o 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=CACHED
+// RUN: cmp %t.a.ll %t.b.ll
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj %s -o %t.o
+// RUN: llvm-dec -output-cache=%t.cache -o %t.c.ll %t.o 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=DECOMPILE
+// RUN: FileCheck %s --check-prefix=IR < %t.c.ll
+
+// DECOMPILE: Section: __text
+// DECOMPILE-NOT: is up to date
+// DECOMPILE-NOT: is taken from the output cache
+// SKIP-NOT: Section: __text
+// SKIP: skip-unchanged.s.tmp.ll' is up to date.
+// CACHED-NOT: Section: __text
+// CACHED: skip-unchanged.s.tmp.b.ll' is taken from the output cache.
+
+// IR: add i64 %X0_0, 1
+// CHANGED: add i64 %X0_0, 2
+
+.globl _f
+_f:
+.ifndef CHANGED
+add x0, x0, #1
+.else
+add x0, x0, #2
+.endif
+ret
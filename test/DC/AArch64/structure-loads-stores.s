@@ -0,0 +1,62 @@
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj %s -o %t.o
+// RUN: llvm-dec -aarch64-decode-fp-simd -o - %t.o | FileCheck %s
+
+.globl _main
+_main:
+ld1 {v0.4s, v1.4s}, [x0]
+ld1 {v2.h}[3], [x1]
+ld1r {v3.8h}, [x2]
+ld1 {v4.16b}, [x3], #16
+ld1 {v5.2d}, [x4], x5
+ld2 {v6.s, v7.s}[1], [x6], #8
+st1 {v2.s}[1], [x7]
+ld4r {v16.16b, v17.16b, v18.16b, v19.16b}, [x8]
+ret
+
+// CHECK-LABEL: bb_0:
+
+// LD1 of two registers: a single access.
+// CHECK: [[P:%[0-9]+]] = inttoptr i64 %X0_0 to i256*
+// CHECK-NEXT: [[V:%[0-9]+]] = load i256, i256* [[P]]
+// CHECK-NEXT: %Q0_0 = trunc i256 [[V]] to i128
+// CHECK-NEXT: [[HI:%[0-9]+]] = lshr i256 [[V]], 128
+// CHECK-NEXT: %Q1_0 = trunc i256 [[HI]] to i128
+
+// One lane: the loaded element is blended into the lane.
+// CHECK: [[P:%[0-9]+]] = inttoptr i64 %X1_0 to <1 x i16>*
+// CHECK: [[E:%[0-9]+]] = load <1 x i16>, <1 x i16>* [[P]]
+// CHECK-NEXT: [[S:%[0-9]+]] = shufflevector <1 x i16> [[E]], <1 x i16> undef, <8 x i32> zeroinitializer
+// CHECK-NEXT: [[B:%[0-9]+]] = shufflevector <8 x i16> %{{[0-9]+}}, <8 x i16> [[S]], <8 x i32> <i32 0, i32 1, i32 2, i32 8, i32 4, i32 5, i32 6, i32 7>
+// CHECK-NEXT: %Q2_0 = bitcast <8 x i16> [[B]] to i128
+
+// Load and replicate.
+// CHECK: [[P:%[0-9]+]] = inttoptr i64 %X2_0 to <1 x i16>*
+// CHECK-NEXT: [[E:%[0-9]+]] = load <1 x i16>, <1 x i16>* [[P]]
+// CHECK-NEXT: [[S:%[0-9]+]] = shufflevector <1 x i16> [[E]], <1 x i16> undef, <8 x i32> zeroinitializer
+// CHECK-NEXT: %Q3_0 = bitcast <8 x i16> [[S]] to i128
+
+// Post-indexed, by the access size, then by a register.
+// CHECK: [[P:%[0-9]+]] = inttoptr i64 %X3_0 to i128*
+// CHECK-NEXT: %Q4_0 = load i128, i128* [[P]]
+// CHECK: %X3_1 = add i64 %X3_0, 16
+// CHECK: [[P:%[0-9]+]] = inttoptr i64 %X4_0 to i128*
+// CHECK-NEXT: %Q5_0 = load i128, i128* [[P]]
+// CHECK: %X4_1 = add i64 %X4_0, %X5_0
+
+// Lane 1 of two registers, post-indexed.
+// CHECK: [[P:%[0-9]+]] = inttoptr i64 %X6_0 to <2 x i32>*
+// CHECK: [[E:%[0-9]+]] = load <2 x i32>, <2 x i32>* [[P]]
+// CHECK-NEXT: [[S:%[0-9]+]] = shufflevector <2 x i32> [[E]], <2 x i32> undef, <8 x i32> <i32 0, i32 1, i32 0, i32 1, i32 0, i32 1, i32 0, i32 1>
+// CHECK-NEXT: shufflevector <8 x i32> %{{[0-9]+}}, <8 x i32> [[S]], <8 x i32> <i32 0, i32 8, i32 2, i32 3, i32 4, i32 9, i32 6, i32 7>
+// CHECK: %X6_1 = add i64 %X6_0, 8
+
+// Store one lane.
+// CHECK: [[P:%[0-9]+]] = inttoptr i64 %X7_0 to <1 x i32>*
+// CHECK: [[V:%[0-9]+]] = bitcast i128 %Q2_0 to <4 x i32>
+// CHECK-NEXT: [[L:%[0-9]+]] = shufflevector <4 x i32> [[V]], <4 x i32> undef, <1 x i32> <i32 1>
+// CHECK-NEXT: store <1 x i32> [[L]], <1 x i32>* [[P]]
+
+// Load and replicate to four registers: element r to each lane of register r.
+// CHECK: [[P:%[0-9]+]] = inttoptr i64 %X8_0 to <4 x i8>*
+// CHECK-NEXT: [[E:%[0-9]+]] = load <4 x i8>, <4 x i8>* [[P]]
+// CHECK-NEXT: shufflevector <4 x i8> [[E]], <4 x i8> undef, <64 x i32> <i32 0, {{(i32 0, )+}}i32 0, i32 1, {{(i32 1, )+}}i32 1, i32 2, {{(i32 2, )+}}i32 2, i32 3, {{(i32 3, )+}}i32 3>
@@ -0,0 +1,43 @@
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj %s -o %t.o
+// RUN: llvm-dec -enable-dc-structured-loops -o - %t.o | FileCheck %s
+// RUN: llvm-dec -enable-dc-structured-loops -o - %t.o | opt -verify -disable-output
+
+// An outer loop with two latches and an exit also reached from before it,
+// around an inner loop already in simplified form.
+.globl _main
+_main:
+cbz x0, Lexit
+Louter:
+mov x2, #4
+Linner:
+sub x2, x2, #1
+cbnz x2, Linner
+sub x0, x0, #1
+cbz x1, Lskip
+add x1, x1, #1
+cbnz x0, Louter
+b Lexit
+Lskip:
+cbnz x0, Louter
+Lexit:
+ret
+
+// CHECK-LABEL: bb_0:
+// CHECK: br i1 %{{[0-9]+}}, label %bb_28, label %bb_4.preheader
+// CHECK: bb_4.preheader:
+// CHECK-NEXT: br label %bb_4
+// CHECK: bb_4.backedge:
+// CHECK-NEXT: br label %bb_4
+// CHECK: bb_4:
+// CHECK-SAME: preds = %bb_4.backedge, %bb_4.preheader
+// CHECK: bb_8:
+// CHECK-SAME: preds = %bb_8, %bb_4
+// CHECK-NOT: bb_8.
+// CHECK: bb_18:
+// CHECK: br i1 %{{[0-9]+}}, label %bb_4.backedge, label %bb_20
+// CHECK: bb_24:
+// CHECK: br i1 %{{[0-9]+}}, label %bb_4.backedge, label %bb_28.loopexit
+// CHECK: bb_28.loopexit:
+// CHECK-NEXT: br label %bb_28
+// CHECK: bb_28:
+// CHECK-SAME: preds = %bb_28.loopexit, %bb_20, %bb_0
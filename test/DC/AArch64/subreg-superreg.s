@@ -0,0 +1,32 @@
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj %s -o %t.o
+// RUN: llvm-dec -o - %t.o | FileCheck %s
+
+// A W register write zero-extends into its X register, which the following
+// read of the X register sees.
+// CHECK-LABEL: bb_0:
+// CHECK: [[X0:%X0_[0-9]+]] = load i64, i64* %X0
+// CHECK: [[W0:%W0_[0-9]+]] = trunc i64 [[X0]] to i32
+// CHECK: [[W0ADD:%W0_[0-9]+]] = add i32 [[W0]], 1
+// CHECK: [[X0EXT:%X0_[0-9]+]] = zext i32 [[W0ADD]] to i64
+// CHECK: [[X0SHL:%[0-9]+]] = shl i64 [[X0EXT]], 0
+// CHECK: [[X1:%X1_[0-9]+]] = or i64 0, [[X0SHL]]
+add w0, w0, #1
+mov x1, x0
+
+// An X register write is seen by the following read of its W register.
+// CHECK: [[X2:%X2_[0-9]+]] = load i64, i64* %X2
+// CHECK: [[X2SHL:%[0-9]+]] = shl i64 [[X2]], 0
+// CHECK: [[X0MOV:%X0_[0-9]+]] = or i64 0, [[X2SHL]]
+// CHECK: [[W0MOV:%W0_[0-9]+]] = trunc i64 [[X0MOV]] to i32
+// CHECK: [[W3:%W3_[0-9]+]] = add i32 [[W0MOV]], 2
+// CHECK: [[X3:%X3_[0-9]+]] = zext i32 [[W3]] to i64
+mov x0, x2
+add w3, w0, #2
+
+// Only the X registers are stored back.
+// CHECK-DAG: store i64 [[X0MOV]], i64* %X0
+// CHECK-DAG: store i64 [[X1]], i64* %X1
+// CHECK-DAG: store i64 [[X3]], i64* %X3
+// CHECK-NOT: store i32
+// CHECK: br label %exit_fn_0
+ret
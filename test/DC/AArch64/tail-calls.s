@@ -0,0 +1,44 @@
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj %s -o %t.o
+// RUN: llvm-dec -o - %t.o | FileCheck %s
+// RUN: llvm-dec -enable-dc-tail-call-returns=0 -o - %t.o \
+// RUN:   | FileCheck %s --check-prefix=EXIT
+
+.globl _main
+_main:
+bl _f
+bl _g
+bl _h
+ret
+
+// The jump to _g is a tail call: it is translated as a call, then a return.
+_f:
+cbz x0, 1f
+add x0, x0, #2
+b 2f
+1:
+mov x0, #1
+ret
+
+_h:
+ret
+
+_g:
+2:
+add x0, x0, #1
+ret
+
+// The block after the tail call keeps its own instructions.
+// CHECK-LABEL: define void @fn_10(
+// CHECK: bb_1C:
+// CHECK: %X0_{{[0-9]+}} = shl i64
+// CHECK-NEXT: store i64 %X0_{{[0-9]+}}, i64* %X0
+// CHECK-NEXT: br label %exit_fn_10
+// The call leaves the regset as the function returns it.
+// CHECK: call void @fn_28(%regset* %0)
+// CHECK: bb_c18:
+// CHECK-NEXT: ret void
+
+// EXIT-LABEL: define void @fn_10(
+// EXIT: call void @fn_28(%regset* %0)
+// EXIT: bb_c18:
+// EXIT-NEXT: br label %exit_fn_10
@@ -0,0 +1,30 @@
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj %s -o %t.o
+// RUN: rm -rf %t.cache
+
+// The first run translates both functions, the second reuses them.
+// RUN: llvm-dec -dc-cache=%t.cache -o /dev/null %t.o 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=MISS
+// RUN: llvm-dec -dc-cache=%t.cache -o /dev/null %t.o 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=HIT
+
+// Another translation option, or other passes, translate again.
+// RUN: llvm-dec -dc-cache=%t.cache -enable-dc-regset-diff -o /dev/null %t.o \
+// RUN:   2>&1 | FileCheck %s --check-prefix=MISS
+// RUN: llvm-dec -dc-cache=%t.cache -O1 -o /dev/null %t.o 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=MISS
+
+// Each configuration keeps its entries.
+// RUN: llvm-dec -dc-cache=%t.cache -O1 -o /dev/null %t.o 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=HIT
+// RUN: llvm-dec -dc-cache=%t.cache -o /dev/null %t.o 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=HIT
+
+// MISS: reused 0 of 2 function translations
+// HIT: reused 2 of 2 function translations
+
+.globl _main
+_main:
+bl #8
+ret
+add x0, x0, #1
+ret
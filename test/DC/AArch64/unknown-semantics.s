@@ -0,0 +1,37 @@
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj %s -o %t.o
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj -defsym NOCRC=1 %s \
+// RUN:   -o %t.nocrc.o
+
+// Semantics that can't be translated, e.g. an unhandled intrinsic, are fatal
+// by default.
+// RUN: not llvm-dec -o /dev/null %t.o 2>&1 | FileCheck %s --check-prefix=FATAL
+// FATAL: LLVM ERROR: DC: unhandled intrinsic llvm.aarch64.crc32b in CRC32Brr at 0x0
+
+// Instructions without semantics at all are dropped, and counted.
+// RUN: llvm-dec -o - %t.nocrc.o 2>&1 | FileCheck %s --check-prefix=DROP
+// DROP: DC: 1 instructions (1 opcodes) dropped, without semantics:
+// DROP-NEXT: 1  MSR
+// DROP-NOT: dc.unknown
+
+// With -enable-dc-unknown-fallback, both are translated to opaque calls, with
+// the instruction address.
+// RUN: llvm-dec -enable-dc-unknown-fallback -o - %t.o 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=FALLBACK
+// FALLBACK: DC: 2 instructions (2 opcodes) translated to opaque dc.unknown calls:
+// FALLBACK-NEXT: 1  CRC32Brr
+// FALLBACK-NEXT: 1  MSR
+// FALLBACK-LABEL: define void @fn_0(
+// FALLBACK: call void @dc.unknown.CRC32Brr(%regset* %0, i64 0)
+// FALLBACK: call void @dc.unknown.MSR(%regset* %0, i64 4)
+// FALLBACK: declare void @dc.unknown.CRC32Brr(%regset*, i64)
+// FALLBACK: declare void @dc.unknown.MSR(%regset*, i64)
+
+.globl _f
+_f:
+.ifndef NOCRC
+crc32b w0, w1, w2
+.else
+nop
+.endif
+msr tpidr_el0, x0
+ret
@@ -0,0 +1,35 @@
+// RUN: llvm-mc -triple=arm64-apple-darwin -filetype=obj %s -o %t.o
+// RUN: llvm-dec -o - %t.o | FileCheck %s
+
+.globl _main
+_main:
+// Two Q pairs, one right after the other: a single access.
+ldp q0, q1, [x1]
+ldp q2, q3, [x1, #32]
+stp q0, q1, [x0, #64]
+stp d8, d9, [x2, #16]
+ldp d4, d5, [x3], #16
+stp q4, q5, [x4, #-32]!
+ret
+
+// CHECK-LABEL: bb_0:
+// CHECK: [[P:%[0-9]+]] = inttoptr i64 %X1_0 to <8 x i64>*
+// CHECK: [[V:%[0-9]+]] = load <8 x i64>, <8 x i64>* [[P]], align 1
+// CHECK: [[Q0:%[0-9]+]] = shufflevector <8 x i64> [[V]], <8 x i64> undef, <2 x i32> <i32 0, i32 1>
+// CHECK: %Q0_0 = bitcast <2 x i64> [[Q0]] to i128
+// CHECK: [[Q3:%[0-9]+]] = shufflevector <8 x i64> [[V]], <8 x i64> undef, <2 x i32> <i32 6, i32 7>
+// CHECK: %Q3_0 = bitcast <2 x i64> [[Q3]] to i128
+// CHECK-NOT: load <
+// CHECK: add i64 %X0_0, 64
+// CHECK: shufflevector <2 x i64> %{{[0-9]+}}, <2 x i64> %{{[0-9]+}}, <4 x i32> <i32 0, i32 1, i32 2, i32 3>
+// CHECK: store <4 x i64>
+// CHECK: add i64 %X2_0, 16
+// CHECK: store <2 x i64>
+// CHECK: [[D:%[0-9]+]] = load <2 x i64>, <2 x i64>* %{{[0-9]+}}, align 1
+// CHECK: %D4_0 = extractelement <2 x i64> [[D]], i32 0
+// CHECK: %D5_0 = extractelement <2 x i64> [[D]], i32 1
+// CHECK: %X3_1 = add i64 %X3_0, 16
+// CHECK: %X4_1 = add i64 %X4_0, -32
+// CHECK: inttoptr i64 %X4_1 to <4 x i64>*
+// CHECK: store <4 x i64>
+// CHECK: store i64 %X4_1, i64* %X4
@@ -0,0 +1,20 @@
+; The bitcode of hello-world.macho-x86_64 that serve.test queries, as
+; llvm-dec would write it if fn_100000F30 referred to its string, directly
+; and through a CFString.
+
+%struct.__CFString = type { i8*, i32, i8*, i64 }
+
+@cstr_100000F8E = weak_odr constant [13 x i8] c"Hello world\0A\00", align 1
+@__CFConstantStringClassReference = external global [0 x i32]
+@cfstring_100001000 = weak_odr constant %struct.__CFString { i8* bitcast ([0 x i32]* @__CFConstantStringClassReference to i8*), i32 1992, i8* getelementptr inbounds ([13 x i8], [13 x i8]* @cstr_100000F8E, i32 0, i32 0), i64 12 }
+
+define void @fn_100000F30(i64* %R) {
+  store i64 ptrtoint ([13 x i8]* @cstr_100000F8E to i64), i64* %R
+  store i64 ptrtoint (%struct.__CFString* @cfstring_100001000 to i64), i64* %R
+  call void @fn_100000F6C(i64* %R)
+  ret void
+}
+
+define void @fn_100000F6C(i64* %R) {
+  ret void
+}
@@ -0,0 +1,46 @@
+# RUN: llvm-mc -x86-asm-syntax=intel -triple=x86_64-unknown-darwin %s -filetype=obj -o %t.o
+# RUN: llvm-dec -o - %t.o | FileCheck %s --check-prefix=NONE
+# RUN: llvm-dec -dc-passes=nvregs -o - %t.o | FileCheck %s
+
+# NONE-LABEL: bb_0_call:
+# NONE: store i64 {{%[0-9]+}}, i64* %RBX_ptr
+# NONE: call void @fn_1A(
+# NONE: [[RBX:%RBX_[0-9]+]] = load i64, i64* %RBX_ptr
+# NONE: store i64 [[RBX]], i64* %RBX
+
+# With the SysV convention, RBX is preserved, and callees don't read it: it
+# isn't stored to the regset, around the call or on exit.
+# CHECK-LABEL: exit_fn_0:
+# CHECK-NOT: store i64 {{.*}}, i64* %RBX_ptr
+# CHECK: ret void
+
+# RBP and RSP are preserved as well, but read by the callee, which may walk
+# the frame chain: they are stored before the call, and those values are
+# used after it. RCX is clobbered, and reloaded.
+# CHECK-LABEL: bb_0_call:
+# CHECK: [[RBP:%[0-9]+]] = load i64, i64* %RBP
+# CHECK-NEXT: store i64 [[RBP]], i64* %RBP_ptr
+# CHECK-NEXT: [[RBX:%[0-9]+]] = load i64, i64* %RBX
+# CHECK-NEXT: [[RCXSAVE:%[0-9]+]] = load i64, i64* %RCX
+# CHECK-NEXT: store i64 [[RCXSAVE]], i64* %RCX_ptr
+# CHECK: [[RSP:%[0-9]+]] = load i64, i64* %RSP
+# CHECK-NEXT: store i64 [[RSP]], i64* %RSP_ptr
+# CHECK: call void @fn_1A(
+# CHECK: [[RCX:%RCX_[0-9]+]] = load i64, i64* %RCX_ptr
+# CHECK: store i64 [[RBP]], i64* %RBP
+# CHECK-NEXT: store i64 [[RBX]], i64* %RBX
+# CHECK-NEXT: store i64 [[RCX]], i64* %RCX
+# CHECK-NEXT: store i64 {{%RIP_[0-9]+}}, i64* %RIP
+# CHECK-NEXT: store i64 [[RSP]], i64* %RSP
+
+f:
+ mov rbx, 5
+ mov rbp, 3
+ mov rcx, 7
+ call g
+ add rbx, 1
+ add rbp, 1
+ add rcx, 1
+ ret
+g:
+ ret
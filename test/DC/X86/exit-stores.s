@@ -0,0 +1,35 @@
+# RUN: llvm-mc -x86-asm-syntax=intel -triple=x86_64-unknown-darwin %s -filetype=obj -o %t.o
+# RUN: llvm-dec -o - %t.o | FileCheck %s
+
+# RCX is only written when RDI isn't zero, and RAX only through AL: both are
+# stored back on exit, along with the other written registers. RDI and RSI
+# are only read, and keep their regset value.
+# CHECK-LABEL: exit_fn_0:
+# CHECK-NEXT: [[EFLAGS:%[0-9]+]] = load i32, i32* %EFLAGS
+# CHECK-NEXT: store i32 [[EFLAGS]], i32* %EFLAGS_ptr
+# CHECK-NEXT: [[RAX:%[0-9]+]] = load i64, i64* %RAX
+# CHECK-NEXT: store i64 [[RAX]], i64* %RAX_ptr
+# CHECK-NEXT: [[RCX:%[0-9]+]] = load i64, i64* %RCX
+# CHECK-NEXT: store i64 [[RCX]], i64* %RCX_ptr
+# CHECK-NEXT: [[RDX:%[0-9]+]] = load i64, i64* %RDX
+# CHECK-NEXT: store i64 [[RDX]], i64* %RDX_ptr
+# CHECK-NEXT: [[RIP:%[0-9]+]] = load i64, i64* %RIP
+# CHECK-NEXT: store i64 [[RIP]], i64* %RIP_ptr
+# CHECK-NEXT: [[RSP:%[0-9]+]] = load i64, i64* %RSP
+# CHECK-NEXT: store i64 [[RSP]], i64* %RSP_ptr
+# CHECK-NEXT: ret void
+
+# CHECK-LABEL: bb_5:
+# CHECK: store i64 1, i64* %RCX
+# CHECK-LABEL: bb_C:
+# CHECK: [[RAXAL:%RAX_[0-9]+]] = or i64
+# CHECK: store i64 [[RAXAL]], i64* %RAX
+
+f:
+ test rdi, rdi
+ je 1f
+ mov rcx, 1
+1:
+ mov al, 1
+ mov rdx, rsi
+ ret
@@ -0,0 +1,59 @@
+#RUN: llvm-mc -x86-asm-syntax=intel -triple=x86_64-unknown-darwin < %s -filetype=obj -o - | llvm-dec -merge-identical -o - - 2>%t.log | FileCheck %s
+#RUN: FileCheck %s --check-prefix=LOG < %t.log
+
+# The displacements are spelled out: the assembler would relocate each load
+# against the following symbol, with a different addend.
+
+.global _main
+_main:
+mov eax, dword ptr [rip + 0x3d]
+ret
+
+# get_a and get_b load the same constant.
+get_a:
+push rbp
+mov rbp, rsp
+mov eax, dword ptr [rip + 0x32]
+add eax, 1
+pop rbp
+ret
+
+get_b:
+push rbp
+mov rbp, rsp
+mov eax, dword ptr [rip + 0x23]
+add eax, 1
+pop rbp
+ret
+
+# get_c adds another immediate, and get_d loads another constant.
+get_c:
+push rbp
+mov rbp, rsp
+mov eax, dword ptr [rip + 0x14]
+add eax, 2
+pop rbp
+ret
+
+get_d:
+push rbp
+mov rbp, rsp
+mov eax, dword ptr [rip + 0x9]
+add eax, 1
+pop rbp
+ret
+
+.long 41
+.long 42
+
+# LOG: Identical functions: 1
+
+# CHECK-LABEL: define void @fn_7(
+# CHECK: add i32 %{{.*}}, 1
+# CHECK-LABEL: define void @fn_25(
+# CHECK: add i32 %{{.*}}, 2
+# CHECK-LABEL: define void @fn_34(
+# CHECK: add i32 %{{.*}}, 1
+# CHECK-LABEL: define void @fn_16(
+# CHECK-NEXT: tail call void @fn_7(%regset* %0)
+# CHECK-NEXT: ret void
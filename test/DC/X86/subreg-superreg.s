@@ -0,0 +1,51 @@
+# RUN: llvm-mc -x86-asm-syntax=intel -triple=x86_64-unknown-darwin %s -filetype=obj -o %t.o
+# RUN: llvm-dec -o - %t.o | FileCheck %s
+
+f:
+# AL and AX writes are inserted in each of their super-registers, leaving
+# the other bits; EAX writes zero-extend into RAX. The following reads of RAX
+# see them.
+# CHECK-LABEL: bb_0:
+# CHECK: [[RAX0:%RAX_[0-9]+]] = load i64, i64* %RAX
+# CHECK: [[AL:%[0-9]+]] = zext i8 1 to i64
+# CHECK: [[RAXMASK:%[0-9]+]] = and i64 [[RAX0]], -256
+# CHECK: [[RAX1:%RAX_[0-9]+]] = or i64 [[AL]], [[RAXMASK]]
+ mov al, 1
+ mov rcx, rax
+# CHECK: [[AX:%[0-9]+]] = zext i16 2 to i64
+# CHECK: [[RAXMASK2:%[0-9]+]] = and i64 [[RAX1]], -65536
+# CHECK: [[RAX2:%RAX_[0-9]+]] = or i64 [[AX]], [[RAXMASK2]]
+ mov ax, 2
+ mov rdx, rax
+# CHECK: [[RAX3:%RAX_[0-9]+]] = zext i32 3 to i64
+ mov eax, 3
+ mov rsi, rax
+
+# A RAX write is seen by the following reads of AX, EAX and AL.
+# CHECK: [[RDI:%RDI_[0-9]+]] = load i64, i64* %RDI
+# CHECK: [[AX3:%AX_[0-9]+]] = trunc i64 [[RDI]] to i16
+# CHECK: [[RBX0:%RBX_[0-9]+]] = load i64, i64* %RBX
+# CHECK: [[BX:%[0-9]+]] = zext i16 [[AX3]] to i64
+# CHECK: [[RBXMASK:%[0-9]+]] = and i64 [[RBX0]], -65536
+# CHECK: [[RBX1:%RBX_[0-9]+]] = or i64 [[BX]], [[RBXMASK]]
+# CHECK: [[EAX:%EAX_[0-9]+]] = trunc i64 [[RDI]] to i32
+# CHECK: [[R8:%R8_[0-9]+]] = zext i32 [[EAX]] to i64
+# CHECK: [[AL1:%AL_[0-9]+]] = trunc i64 [[RDI]] to i8
+# CHECK: [[R90:%R9_[0-9]+]] = load i64, i64* %R9
+# CHECK: [[R9B:%[0-9]+]] = zext i8 [[AL1]] to i64
+# CHECK: [[R9MASK:%[0-9]+]] = and i64 [[R90]], -256
+# CHECK: [[R9:%R9_[0-9]+]] = or i64 [[R9B]], [[R9MASK]]
+ mov rax, rdi
+ mov bx, ax
+ mov r8d, eax
+ mov r9b, al
+
+# CHECK-DAG: store i64 [[RDI]], i64* %RAX
+# CHECK-DAG: store i64 [[RBX1]], i64* %RBX
+# CHECK-DAG: store i64 [[RAX1]], i64* %RCX
+# CHECK-DAG: store i64 [[RAX2]], i64* %RDX
+# CHECK-DAG: store i64 [[RAX3]], i64* %RSI
+# CHECK-DAG: store i64 [[R8]], i64* %R8
+# CHECK-DAG: store i64 [[R9]], i64* %R9
+# CHECK: br label %exit_fn_0
+ ret
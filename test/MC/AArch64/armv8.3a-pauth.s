@@ -0,0 +1,61 @@
+// RUN: llvm-mc -triple arm64-apple-darwin -show-encoding < %s | FileCheck %s
+
+//------------------------------------------------------------------------------
+// Pointer authentication, as arm64e code uses it
+//------------------------------------------------------------------------------
+        retaa
+        retab
+        braa   x16, x17
+        brab   x1, sp
+        braaz  x16
+        brabz  x2
+        blraa  x8, x9
+        blrab  x8, sp
+        blraaz x8
+        blrabz x3
+        pacia  x16, x17
+        pacib  x30, sp
+        pacda  x0, x1
+        pacdb  x2, x3
+        autia  x16, x17
+        autib  x30, sp
+        autda  x8, x9
+        autdb  x4, x5
+        paciza x16
+        pacizb x30
+        pacdza x1
+        pacdzb x2
+        autiza x16
+        autizb x30
+        autdza x3
+        autdzb x4
+        xpaci  x30
+        xpacd  x8
+// CHECK: retaa   ; encoding: [0xff,0x0b,0x5f,0xd6]
+// CHECK: retab   ; encoding: [0xff,0x0f,0x5f,0xd6]
+// CHECK: braa x16, x17   ; encoding: [0x11,0x0a,0x1f,0xd7]
+// CHECK: brab x1, sp   ; encoding: [0x3f,0x0c,0x1f,0xd7]
+// CHECK: braaz x16   ; encoding: [0x1f,0x0a,0x1f,0xd6]
+// CHECK: brabz x2   ; encoding: [0x5f,0x0c,0x1f,0xd6]
+// CHECK: blraa x8, x9   ; encoding: [0x09,0x09,0x3f,0xd7]
+// CHECK: blrab x8, sp   ; encoding: [0x1f,0x0d,0x3f,0xd7]
+// CHECK: blraaz x8   ; encoding: [0x1f,0x09,0x3f,0xd6]
+// CHECK: blrabz x3   ; encoding: [0x7f,0x0c,0x3f,0xd6]
+// CHECK: pacia x16, x17   ; encoding: [0x30,0x02,0xc1,0xda]
+// CHECK: pacib x30, sp   ; encoding: [0xfe,0x07,0xc1,0xda]
+// CHECK: pacda x0, x1   ; encoding: [0x20,0x08,0xc1,0xda]
+// CHECK: pacdb x2, x3   ; encoding: [0x62,0x0c,0xc1,0xda]
+// CHECK: autia x16, x17   ; encoding: [0x30,0x12,0xc1,0xda]
+// CHECK: autib x30, sp   ; encoding: [0xfe,0x17,0xc1,0xda]
+// CHECK: autda x8, x9   ; encoding: [0x28,0x19,0xc1,0xda]
+// CHECK: autdb x4, x5   ; encoding: [0xa4,0x1c,0xc1,0xda]
+// CHECK: paciza x16   ; encoding: [0xf0,0x23,0xc1,0xda]
+// CHECK: pacizb x30   ; encoding: [0xfe,0x27,0xc1,0xda]
+// CHECK: pacdza x1   ; encoding: [0xe1,0x2b,0xc1,0xda]
+// CHECK: pacdzb x2   ; encoding: [0xe2,0x2f,0xc1,0xda]
+// CHECK: autiza x16   ; encoding: [0xf0,0x33,0xc1,0xda]
+// CHECK: autizb x30   ; encoding: [0xfe,0x37,0xc1,0xda]
+// CHECK: autdza x3   ; encoding: [0xe3,0x3b,0xc1,0xda]
+// CHECK: autdzb x4   ; encoding: [0xe4,0x3f,0xc1,0xda]
+// CHECK: xpaci x30   ; encoding: [0xfe,0x43,0xc1,0xda]
+// CHECK: xpacd x8   ; encoding: [0xe8,0x47,0xc1,0xda]
@@ -0,0 +1,603 @@
+//===-- dc-bench.cpp - Benchmark the decompilation pipeline ---------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This program measures the throughput of each phase of the decompilation:
+// the MC CFG recovery (MCObjectDisassembler), the instruction semantics
+// (DCInstrSema::translateInst), the register set finalization
+// (DCRegisterSema, through DCInstrSema::FinalizeBasicBlock/FinalizeFunction),
+// and each of the passes DCTranslator runs on the translated functions.
+//
+// The inputs are either synthetic AArch64 kernels, generated in memory, or
+// recorded binaries given on the command line.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/Triple.h"
+#include "llvm/DC/DCInstrSema.h"
+#include "llvm/DC/DCRegisterSema.h"
+#include "llvm/DC/DCTranslatedInstTracker.h"
+#include "llvm/DC/DCTranslator.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/Module.h"
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCAnalysis/MCModule.h"
+#include "llvm/MC/MCAsmInfo.h"
+#include "llvm/MC/MCContext.h"
+#include "llvm/MC/MCDisassembler.h"
+#include "llvm/MC/MCInstrAnalysis.h"
+#include "llvm/MC/MCInstrInfo.h"
+#include "llvm/MC/MCObjectDisassembler.h"
+#include "llvm/MC/MCObjectFileInfo.h"
+#include "llvm/MC/MCRegisterInfo.h"
+#include "llvm/MC/MCSubtargetInfo.h"
+#include "llvm/Object/MachO.h"
+#include "llvm/Object/ObjectFile.h"
+#include "llvm/Pass.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/MachO.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/PrettyStackTrace.h"
+#include "llvm/Support/Signals.h"
+#include "llvm/Support/TargetRegistry.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+using namespace llvm;
+using namespace object;
+
+namespace {
+enum KernelKind { K_ALU, K_NEON, K_Call, K_Switch, K_StateMachine };
+}
+
+static cl::list<std::string>
+InputFilenames(cl::Positional,
+               cl::desc("<recorded inputs (default = synthetic kernels)>"),
+               cl::ZeroOrMore);
+
+static cl::list<KernelKind>
+Kernels("kernel",
+    cl::desc("Synthetic AArch64 kernels to run, when there is no input "
+             "(default = all)"),
+    cl::values(clEnumValN(K_ALU, "alu", "Straight-line integer arithmetic"),
+               clEnumValN(K_NEON, "neon",
+                          "Straight-line NEON arithmetic (decoded as none "
+                          "general operand instructions)"),
+               clEnumValN(K_Call, "call",
+                          "Objective-C style message sends, in a frame"),
+               clEnumValN(K_Switch, "switch",
+                          "Large switches, as compare and branch chains"),
+               clEnumValN(K_StateMachine, "statemachine",
+                          "State machines, whose dense back-edges split "
+                          "the blocks already recovered"),
+               clEnumValEnd),
+    cl::CommaSeparated);
+
+static cl::opt<unsigned>
+NumFunctions("functions",
+    cl::desc("Number of functions of each synthetic kernel (default = 100)"),
+    cl::value_desc("n"), cl::init(100u));
+
+static cl::opt<unsigned>
+FunctionSize("function-size",
+    cl::desc("Number of instructions of each synthetic function "
+             "(default = 100)"),
+    cl::value_desc("n"), cl::init(100u));
+
+static cl::opt<unsigned>
+Repeat("repeat",
+    cl::desc("Run each input <n> times, and report the fastest run of each "
+             "phase (default = 3)"),
+    cl::value_desc("n"), cl::init(3u));
+
+static cl::opt<unsigned>
+TransOptLevel("O",
+              cl::desc("Optimization level of DCTranslator, which selects "
+                       "the passes measured. [-O0, -O1, -O2, or -O3] "
+                       "(default = '-O3')"),
+              cl::Prefix,
+              cl::init(3u));
+
+static StringRef ToolName;
+
+//===----------------------------------------------------------------------===//
+// Synthetic AArch64 kernels.
+//===----------------------------------------------------------------------===//
+
+// The synthetic code lives where the text of a Mach-O executable does.
+static const uint64_t SyntheticBase = 0x100000000ULL;
+
+static uint32_t encodeRRR(uint32_t Opc, unsigned Rd, unsigned Rn, unsigned Rm) {
+  return Opc | (Rm << 16) | (Rn << 5) | Rd;
+}
+static uint32_t encodeRRI(uint32_t Opc, unsigned Rd, unsigned Rn,
+                          unsigned Imm12) {
+  return Opc | ((Imm12 & 0xfff) << 10) | (Rn << 5) | Rd;
+}
+
+namespace {
+/// \brief Some code to benchmark: either a recorded binary, or a kernel
+/// generated in a Mach-O-like address space.
+struct BenchInput {
+  std::string Name;
+  std::unique_ptr<MemoryBuffer> Buffer;
+  std::unique_ptr<ObjectFile> Obj;
+  /// \brief The code and function starts of a synthetic kernel, which has no
+  /// sections: it is disassembled as the fallback region.
+  std::vector<uint8_t> Code;
+  std::vector<uint64_t> Starts;
+
+  uint64_t getPC() const { return SyntheticBase + Code.size(); }
+  void emit(uint32_t Inst) {
+    for (unsigned i = 0; i != 4; ++i)
+      Code.push_back(uint8_t(Inst >> (8 * i)));
+  }
+  void emitBranch(uint32_t Opc, uint64_t From, uint64_t To, unsigned Bits,
+                  unsigned Shift) {
+    const uint32_t Mask = (1U << Bits) - 1;
+    const uint32_t Offset = uint32_t(int64_t(To - From) / 4) & Mask;
+    uint32_t Inst = Opc | (Offset << Shift);
+    for (unsigned i = 0; i != 4; ++i)
+      Code[From - SyntheticBase + i] = uint8_t(Inst >> (8 * i));
+  }
+};
+} // end anonymous namespace
+
+static const uint32_t RET = 0xd65f03c0;
+
+static void emitALUFunction(BenchInput &In, unsigned Size) {
+  static const uint32_t Opcodes[] = {
+      0x8b000000, // add  xd, xn, xm
+      0xca000000, // eor  xd, xn, xm
+      0xeb000000, // subs xd, xn, xm
+      0x8a000000, // and  xd, xn, xm
+  };
+  for (unsigned i = 0; i + 1 < Size; ++i) {
+    const unsigned Rd = i % 16, Rn = (i + 3) % 16, Rm = (i + 7) % 16;
+    switch (i % 6) {
+    case 0:
+      In.emit(encodeRRI(0x91000000, Rd, Rn, i)); // add xd, xn, #i
+      break;
+    case 1:
+      // madd xd, xn, xm, xa
+      In.emit(encodeRRR(0x9b000000, Rd, Rn, Rm) | (((i + 11) % 16) << 10));
+      break;
+    default:
+      In.emit(encodeRRR(Opcodes[i % 6 - 2], Rd, Rn, Rm));
+      break;
+    }
+  }
+  In.emit(RET);
+}
+
+// The AArch64 disassembler tags the instructions on FP/SIMD registers as
+// "none general operand" ones (opcode 0), which the translation skips: this
+// measures that path, until they get semantics.
+static void emitNEONFunction(BenchInput &In, unsigned Size) {
+  static const uint32_t Opcodes[] = {
+      0x4ea08400, // add  vd.4s, vn.4s, vm.4s
+      0x4e20cc00, // fmla vd.4s, vn.4s, vm.4s
+      0x6e20dc00, // fmul vd.4s, vn.4s, vm.4s
+      0x4e20d400, // fadd vd.4s, vn.4s, vm.4s
+      0x6e201c00, // eor  vd.16b, vn.16b, vm.16b
+  };
+  for (unsigned i = 0; i + 1 < Size; ++i)
+    In.emit(encodeRRR(Opcodes[i % array_lengthof(Opcodes)], i % 32,
+                      (i + 5) % 32, (i + 13) % 32));
+  In.emit(RET);
+}
+
+static void emitCallFunction(BenchInput &In, unsigned Size, uint64_t Callee) {
+  In.emit(0xa9bf7bfd); // stp x29, x30, [sp, #-16]!
+  In.emit(0x910003fd); // mov x29, sp
+  // Each send is: mov x0, x19; add x1, x20, #sel; bl callee; mov x19, x0
+  for (unsigned i = 0; 4 * (i + 1) + 4 <= Size; ++i) {
+    In.emit(0xaa1303e0);
+    In.emit(encodeRRI(0x91000000, 1, 20, 8 * i));
+    In.emit(0);
+    In.emitBranch(0x94000000, In.getPC() - 4, Callee, 26, 0);
+    In.emit(0xaa0003f3);
+  }
+  In.emit(0xa8c17bfd); // ldp x29, x30, [sp], #16
+  In.emit(RET);
+}
+
+static void emitSwitchFunction(BenchInput &In, unsigned Size) {
+  // cmp w0, #k; b.eq case_k, for each case, then the default, and the cases:
+  // add x0, x0, #k; b join. They all join on the final ret.
+  const unsigned NumCases = std::max(1U, std::min(4095U, (Size - 3) / 4));
+  std::vector<uint64_t> Branches, Cases, Jumps;
+  for (unsigned k = 0; k != NumCases; ++k) {
+    In.emit(encodeRRI(0x7100001f, 0, 0, k)); // cmp w0, #k
+    Branches.push_back(In.getPC());
+    In.emit(0);
+  }
+  In.emit(0xd2800000); // mov x0, #0
+  Jumps.push_back(In.getPC());
+  In.emit(0);
+  for (unsigned k = 0; k != NumCases; ++k) {
+    Cases.push_back(In.getPC());
+    In.emit(encodeRRI(0x91000000, 0, 0, k));
+    Jumps.push_back(In.getPC());
+    In.emit(0);
+  }
+  const uint64_t Join = In.getPC();
+  In.emit(RET);
+  for (unsigned k = 0; k != NumCases; ++k)
+    In.emitBranch(0x54000000, Branches[k], Cases[k], 19, 5); // b.eq
+  for (uint64_t Jump : Jumps)
+    In.emitBranch(0x14000000, Jump, Join, 26, 0); // b
+}
+
+static void emitStateMachineFunction(BenchInput &In, unsigned Size) {
+  // Each state is: add x1, x1, #s; subs x0, x0, #1; b.ne state_t; add x2, x2,
+  // #s, where state_t is an earlier state, picked pseudo-randomly, and the
+  // branch goes to its subs. The fallthrough is recovered first, so each
+  // back-edge splits a block in the middle: this is the worst case of the
+  // block lookup and splitting of the CFG recovery.
+  const unsigned NumStates = std::max(1U, (Size - 1) / 4);
+  // b.cond reaches 1MB back: stay well within it.
+  const unsigned MaxDistance = 1U << 16;
+  uint32_t Seed = 0x2545f491;
+  std::vector<uint64_t> Subs, Branches;
+  for (unsigned S = 0; S != NumStates; ++S) {
+    In.emit(encodeRRI(0x91000000, 1, 1, S));  // add x1, x1, #s
+    Subs.push_back(In.getPC());
+    In.emit(encodeRRI(0xf1000000, 0, 0, 1));  // subs x0, x0, #1
+    Branches.push_back(In.getPC());
+    In.emit(0);
+    In.emit(encodeRRI(0x91000000, 2, 2, S));  // add x2, x2, #s
+  }
+  In.emit(RET);
+  for (unsigned S = 0; S != NumStates; ++S) {
+    Seed = Seed * 1103515245 + 12345;
+    const unsigned Distance = (Seed >> 8) % std::min(S + 1, MaxDistance);
+    In.emitBranch(0x54000001, Branches[S], Subs[S - Distance], 19, 5); // b.ne
+  }
+}
+
+/// \brief A Mach-O arm64 header, with no load commands: the synthetic code
+/// isn't in a section, but in the fallback region of MCObjectDisassembler.
+static std::unique_ptr<ObjectFile> createEmptyAArch64Object(BenchInput &In) {
+  MachO::mach_header_64 Header = {};
+  Header.magic = MachO::MH_MAGIC_64;
+  Header.cputype = MachO::CPU_TYPE_ARM64;
+  Header.cpusubtype = MachO::CPU_SUBTYPE_ARM64_ALL;
+  Header.filetype = MachO::MH_EXECUTE;
+  In.Buffer = MemoryBuffer::getMemBufferCopy(
+      StringRef(reinterpret_cast<const char *>(&Header), sizeof(Header)),
+      In.Name);
+  auto ObjOrErr = ObjectFile::createObjectFile(In.Buffer->getMemBufferRef());
+  if (!ObjOrErr)
+    return nullptr;
+  return std::move(*ObjOrErr);
+}
+
+static bool createSyntheticInput(KernelKind K, BenchInput &In) {
+  static const char *const Names[] = {"alu", "neon", "call", "switch",
+                                      "statemachine"};
+  In.Name = Names[K];
+  const unsigned Size = std::max(FunctionSize.getValue(), 8U);
+  // The call kernel sends all its messages to a leaf, as objc_msgSend.
+  uint64_t Callee = 0;
+  if (K == K_Call) {
+    Callee = In.getPC();
+    In.Starts.push_back(Callee);
+    In.emit(RET);
+  }
+  for (unsigned F = 0; F != NumFunctions; ++F) {
+    In.Starts.push_back(In.getPC());
+    switch (K) {
+    case K_ALU: emitALUFunction(In, Size); break;
+    case K_NEON: emitNEONFunction(In, Size); break;
+    case K_Call: emitCallFunction(In, Size, Callee); break;
+    case K_Switch: emitSwitchFunction(In, Size); break;
+    case K_StateMachine: emitStateMachineFunction(In, Size); break;
+    }
+  }
+  In.Obj = createEmptyAArch64Object(In);
+  return bool(In.Obj);
+}
+
+static bool loadRecordedInput(StringRef Filename, BenchInput &In) {
+  In.Name = Filename;
+  auto BufOrErr = MemoryBuffer::getFile(Filename, -1,
+                                        /*RequiresNullTerminator=*/false);
+  if (std::error_code EC = BufOrErr.getError()) {
+    errs() << ToolName << ": '" << Filename << "': " << EC.message() << ".\n";
+    return false;
+  }
+  In.Buffer = std::move(*BufOrErr);
+  auto ObjOrErr = ObjectFile::createObjectFile(In.Buffer->getMemBufferRef());
+  if (std::error_code EC = ObjOrErr.getError()) {
+    errs() << ToolName << ": '" << Filename << "': " << EC.message() << ".\n";
+    return false;
+  }
+  In.Obj = std::move(*ObjOrErr);
+  return true;
+}
+
+//===----------------------------------------------------------------------===//
+// Measurements.
+//===----------------------------------------------------------------------===//
+
+namespace {
+typedef std::chrono::steady_clock Clock;
+
+/// \brief The cost of a phase: the time it took, and the number of items,
+/// machine or IR instructions, it went through.
+struct PhaseResult {
+  std::string Name;
+  const char *Unit;
+  double Seconds;
+  uint64_t Items;
+};
+
+/// \brief Adds the time between its construction and destruction to
+/// \p Seconds.
+class ScopedClock {
+  double &Seconds;
+  Clock::time_point Start;
+
+public:
+  explicit ScopedClock(double &Seconds)
+      : Seconds(Seconds), Start(Clock::now()) {}
+  ~ScopedClock() {
+    std::chrono::duration<double> D = Clock::now() - Start;
+    Seconds += D.count();
+  }
+};
+
+/// \brief What a target needs for the benchmark.
+struct TargetSetup {
+  const Target *TheTarget;
+  std::string TripleName;
+  std::unique_ptr<const MCRegisterInfo> MRI;
+  std::unique_ptr<const MCAsmInfo> MAI;
+  std::unique_ptr<const MCSubtargetInfo> STI;
+  std::unique_ptr<const MCInstrInfo> MII;
+  std::unique_ptr<const MCObjectFileInfo> MOFI;
+  std::unique_ptr<MCContext> Ctx;
+  std::unique_ptr<MCDisassembler> DisAsm;
+  std::unique_ptr<const MCInstrAnalysis> MIA;
+};
+} // end anonymous namespace
+
+static bool setupTarget(const ObjectFile &Obj, TargetSetup &TS) {
+  Triple TheTriple("unknown-unknown-unknown");
+  TheTriple.setArch(Triple::ArchType(Obj.getArch()));
+  if (Obj.isMachO())
+    TheTriple.setObjectFormat(Triple::MachO);
+  std::string Error;
+  TS.TheTarget = TargetRegistry::lookupTarget("", TheTriple, Error);
+  if (!TS.TheTarget) {
+    errs() << ToolName << ": " << Error << "\n";
+    return false;
+  }
+  TS.TripleName = TheTriple.getTriple();
+  TS.MRI.reset(TS.TheTarget->createMCRegInfo(TS.TripleName));
+  TS.MAI.reset(TS.TheTarget->createMCAsmInfo(*TS.MRI, TS.TripleName));
+  TS.STI.reset(TS.TheTarget->createMCSubtargetInfo(TS.TripleName, "", ""));
+  TS.MII.reset(TS.TheTarget->createMCInstrInfo());
+  if (!TS.MRI || !TS.MAI || !TS.STI || !TS.MII) {
+    errs() << ToolName << ": no MC description for " << TS.TripleName << "\n";
+    return false;
+  }
+  TS.MOFI.reset(new MCObjectFileInfo);
+  TS.Ctx.reset(new MCContext(TS.MAI.get(), TS.MRI.get(), TS.MOFI.get()));
+  TS.DisAsm.reset(TS.TheTarget->createMCDisassembler(*TS.STI, *TS.Ctx));
+  TS.MIA.reset(TS.TheTarget->createMCInstrAnalysis(TS.MII.get()));
+  if (!TS.DisAsm || !TS.MIA) {
+    errs() << ToolName << ": no disassembler for " << TS.TripleName << "\n";
+    return false;
+  }
+  return true;
+}
+
+static uint64_t countInstructions(const Function &F) {
+  uint64_t NumInsts = 0;
+  for (const BasicBlock &BB : F)
+    NumInsts += BB.size();
+  return NumInsts;
+}
+
+/// \brief Run all the phases on \p In once, adding their costs to
+/// \p Results, which holds the same phases, in the same order, on each run.
+static bool runOnce(const BenchInput &In, const TargetSetup &TS,
+                    TransOpt::Level OptLevel,
+                    std::vector<PhaseResult> &Results) {
+  MCObjectDisassembler OD(*In.Obj, *TS.DisAsm, *TS.MIA);
+  std::unique_ptr<MCModule> MCM;
+  double MCSeconds = 0;
+  {
+    ScopedClock C(MCSeconds);
+    if (!In.Starts.empty()) {
+      OD.setFallbackRegion(SyntheticBase, In.Code);
+      OD.setFunctionStarts(In.Starts);
+    }
+    MCM.reset(OD.buildModule());
+  }
+  uint64_t NumMCInsts = 0;
+  for (const auto &MCFN : MCM->funcs())
+    for (const MCBasicBlock *BB : *MCFN)
+      NumMCInsts += BB->size();
+
+  // This mirrors DCTranslator::translateFunction, with each phase timed
+  // apart.
+  const DataLayout DL("");
+  LLVMContext Ctx;
+  std::unique_ptr<DCRegisterSema> DRS(TS.TheTarget->createDCRegisterSema(
+      TS.TripleName, *TS.MRI, *TS.MII, DL));
+  std::unique_ptr<DCInstrSema> DIS;
+  if (DRS)
+    DIS.reset(TS.TheTarget->createDCInstrSema(TS.TripleName, *DRS, *TS.MRI,
+                                              *TS.MII));
+  if (!DIS) {
+    errs() << ToolName << ": no DC semantics for " << TS.TripleName << "\n";
+    return false;
+  }
+  std::unique_ptr<Module> M(new Module("dc-bench", Ctx));
+  M->setDataLayout(DL);
+  DIS->SwitchToModule(M.get());
+
+  std::vector<std::unique_ptr<FunctionPass>> Passes =
+      DCTranslator::createFunctionPasses(OptLevel, *DRS);
+  std::vector<std::string> PassNames;
+  // Each pass gets its own manager, to be timed alone.
+  std::vector<std::unique_ptr<legacy::FunctionPassManager>> FPMs;
+  for (auto &P : Passes) {
+    PassNames.push_back(P->getPassName());
+    FPMs.emplace_back(new legacy::FunctionPassManager(M.get()));
+    DCTranslator::addAliasAnalyses(*FPMs.back());
+    FPMs.back()->add(P.release());
+    FPMs.back()->doInitialization();
+  }
+  std::vector<double> PassSeconds(FPMs.size());
+  std::vector<uint64_t> PassInsts(FPMs.size());
+
+  double TranslateSeconds = 0, FinalizeSeconds = 0;
+  uint64_t NumTranslatedInsts = 0;
+  for (const auto &MCFN : MCM->funcs()) {
+    if (MCFN->empty())
+      continue;
+    DIS->setCurrentAddress(MCFN->getEntryBlock()->getStartAddr());
+    DIS->SwitchToFunction(&*MCFN);
+    std::vector<const MCBasicBlock *> BasicBlocks(MCFN->begin(), MCFN->end());
+    std::sort(BasicBlocks.begin(), BasicBlocks.end(),
+              [](const MCBasicBlock *L, const MCBasicBlock *R) {
+                return L->getStartAddr() < R->getStartAddr();
+              });
+    for (const MCBasicBlock *BB : BasicBlocks) {
+      DIS->setCurrentAddress(BB->getStartAddr());
+      DIS->getOrCreateBasicBlock(BB->getStartAddr());
+    }
+    for (const MCBasicBlock *BB : *MCFN) {
+      DIS->setCurrentAddress(BB->getStartAddr());
+      DIS->SwitchToBasicBlock(BB);
+      {
+        ScopedClock C(TranslateSeconds);
+        for (const MCDecodedInst &I : *BB)
+          DIS->translateInst(I);
+      }
+      NumTranslatedInsts += BB->size();
+      ScopedClock C(FinalizeSeconds);
+      DIS->FinalizeBasicBlock();
+    }
+    Function *Fn;
+    {
+      ScopedClock C(FinalizeSeconds);
+      Fn = DIS->FinalizeFunction();
+    }
+    for (size_t i = 0, e = FPMs.size(); i != e; ++i) {
+      PassInsts[i] += countInstructions(*Fn);
+      ScopedClock C(PassSeconds[i]);
+      FPMs[i]->run(*Fn);
+    }
+  }
+  for (auto &FPM : FPMs)
+    FPM->doFinalization();
+
+  std::vector<PhaseResult> Run;
+  Run.push_back({"disassemble", "MC insts", MCSeconds, NumMCInsts});
+  Run.push_back({"translateInst", "MC insts", TranslateSeconds,
+                 NumTranslatedInsts});
+  Run.push_back({"finalize", "MC insts", FinalizeSeconds,
+                 NumTranslatedInsts});
+  for (size_t i = 0, e = FPMs.size(); i != e; ++i)
+    Run.push_back({"pass: " + PassNames[i], "IR insts", PassSeconds[i],
+                   PassInsts[i]});
+
+  // Keep the fastest run of each phase.
+  if (Results.empty()) {
+    // The instructions without semantics make the translation look cheap.
+    DIS->printUnknownInstSummary(errs());
+    Results = std::move(Run);
+    return true;
+  }
+  for (size_t i = 0, e = Results.size(); i != e; ++i)
+    if (Run[i].Seconds < Results[i].Seconds)
+      Results[i] = Run[i];
+  return true;
+}
+
+static void printResults(const BenchInput &In,
+                         ArrayRef<PhaseResult> Results) {
+  outs() << "== " << In.Name << " ==\n";
+  outs() << "  phase                                   seconds      items"
+            "      items/s\n";
+  for (const PhaseResult &R : Results)
+    outs() << format("  %-36s %10.6f %10llu %12.4g", R.Name.c_str(),
+                     R.Seconds, (unsigned long long)R.Items,
+                     R.Seconds > 0 ? R.Items / R.Seconds : 0.0)
+           << " " << R.Unit << "/s\n";
+}
+
+int main(int argc, char **argv) {
+  sys::PrintStackTraceOnErrorSignal();
+  PrettyStackTraceProgram X(argc, argv);
+  llvm_shutdown_obj Y;
+
+  InitializeAllTargetInfos();
+  InitializeAllTargetMCs();
+  InitializeAllTargetDCs();
+  InitializeAllDisassemblers();
+
+  cl::ParseCommandLineOptions(argc, argv, "DC pipeline benchmark\n");
+  ToolName = argv[0];
+
+  TransOpt::Level OptLevel;
+  switch (TransOptLevel) {
+  default:
+    errs() << ToolName << ": invalid optimization level.\n";
+    return 1;
+  case 0: OptLevel = TransOpt::None; break;
+  case 1: OptLevel = TransOpt::Less; break;
+  case 2: OptLevel = TransOpt::Default; break;
+  case 3: OptLevel = TransOpt::Aggressive; break;
+  }
+
+  std::vector<std::unique_ptr<BenchInput>> Inputs;
+  if (InputFilenames.empty()) {
+    std::vector<KernelKind> Kinds(Kernels.begin(), Kernels.end());
+    if (Kinds.empty())
+      Kinds = {K_ALU, K_NEON, K_Call, K_Switch, K_StateMachine};
+    for (KernelKind K : Kinds) {
+      Inputs.emplace_back(new BenchInput);
+      if (!createSyntheticInput(K, *Inputs.back())) {
+        errs() << ToolName << ": can't create the " << Inputs.back()->Name
+               << " kernel.\n";
+        return 1;
+      }
+    }
+  } else {
+    for (const std::string &Filename : InputFilenames) {
+      Inputs.emplace_back(new BenchInput);
+      if (!loadRecordedInput(Filename, *Inputs.back()))
+        return 1;
+    }
+  }
+
+  for (const auto &In : Inputs) {
+    TargetSetup TS;
+    if (!setupTarget(*In->Obj, TS))
+      return 1;
+    std::vector<PhaseResult> Results;
+    for (unsigned i = 0, e = std::max(1U, Repeat.getValue()); i != e; ++i)
+      if (!runOnce(*In, TS, OptLevel, Results))
+        return 1;
+    printResults(*In, Results);
+  }
+  return 0;
+}
@@ -4,13 +4,9 @@
 #include "llvm/ADT/Triple.h"
 #include "llvm/Analysis/ValueTracking.h"
 #include "llvm/DC/DCInstrSema.h"
+#include "llvm/DC/DCJIT.h"
 #include "llvm/DC/DCRegisterSema.h"
 #include "llvm/DC/DCTranslator.h"
-#include "llvm/ExecutionEngine/Orc/CompileUtils.h"
-#include "llvm/ExecutionEngine/Orc/IRCompileLayer.h"
-#include "llvm/ExecutionEngine/Orc/LambdaResolver.h"
-#include "llvm/ExecutionEngine/Orc/LazyEmittingLayer.h"
-#include "llvm/ExecutionEngine/Orc/ObjectLinkingLayer.h"
 #include "llvm/ExecutionEngine/ExecutionEngine.h"
 #include "llvm/IR/Instructions.h"
 #include "llvm/MC/MCAnalysis/MCFunction.h"
@@ -30,11 +26,13 @@
 #include "llvm/MC/MCSubtargetInfo.h"
 #include "llvm/Object/MachO.h"
 #include "llvm/Object/ObjectFile.h"
+#include "llvm/Object/SymbolSize.h"
 #include "llvm/Pass.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/DynamicLibrary.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/MemoryObject.h"
@@ -46,13 +44,19 @@
 #include <dlfcn.h>
 #include <mach-o/dyld.h>
 #include <memory>
+#include <unistd.h>
 
 // See dyncore.h, this makes sure the DYNCore library is loaded.
 extern "C" void LLVMLinkInDYNCore() {}
 
 using namespace llvm;
 using namespace object;
-using namespace orc;
+
+static cl::opt<bool>
+PerfMap("perf-map",
+        cl::desc("Write the JIT'd functions to /tmp/perf-<pid>.map, so that "
+                 "perf attributes their samples to the guest functions"),
+        cl::init(false));
 
 static std::string TripleName;
 
@@ -86,71 +90,64 @@ static const Target *getTarget(const ObjectFile *Obj) {
   return TheTarget;
 }
 
-template <typename T>
-static std::vector<T> singletonSet(T t) {
-  std::vector<T> Vec;
-  Vec.push_back(std::move(t));
-  return Vec;
-}
-
-class DYNJIT {
-public:
-  typedef ObjectLinkingLayer<> ObjLayerT;
-  typedef IRCompileLayer<ObjLayerT> CompileLayerT;
-  typedef LazyEmittingLayer<CompileLayerT> LazyEmitLayerT;
-
-  typedef LazyEmitLayerT::ModuleSetHandleT ModuleHandleT;
-
-  DYNJIT(TargetMachine &TM)
-      : DL(TM.createDataLayout()), CompileLayer(ObjectLayer, SimpleCompiler(TM)),
-        LazyEmitLayer(CompileLayer) {}
-
-  std::string mangle(const std::string &Name) {
-    std::string MangledName;
-    {
-      raw_string_ostream MangledNameStream(MangledName);
-      Mangler::getNameWithPrefix(MangledNameStream, Name, DL);
+/// \brief Describe the functions of each object the JIT loads in a perf map:
+/// one "<start> <size> <name>" line per function. The translated functions
+/// are named "fn_<addr>" after the guest function they come from, followed
+/// by the guest address range of its blocks.
+class PerfMapWriter {
+  raw_ostream *OS;
+  MCModule *MCM;
+
+  void writeObject(const ObjectFile &Obj,
+                   const RuntimeDyld::LoadedObjectInfo &Info) {
+    for (const auto &SymSize : computeSymbolSizes(Obj)) {
+      const SymbolRef &Sym = SymSize.first;
+      if (Sym.getType() != SymbolRef::ST_Function || !SymSize.second)
+        continue;
+      ErrorOr<StringRef> Name = Sym.getName();
+      ErrorOr<uint64_t> Addr = Sym.getAddress();
+      ErrorOr<section_iterator> Sec = Sym.getSection();
+      if (!Name || !Addr || !Sec || *Sec == Obj.section_end())
+        continue;
+      const uint64_t LoadAddr =
+          Info.getSectionLoadAddress(**Sec) + *Addr - (*Sec)->getAddress();
+
+      // Drop the Mach-O global prefix.
+      StringRef FnName = *Name;
+      if (Obj.isMachO() && FnName.startswith("_"))
+        FnName = FnName.drop_front();
+      *OS << utohexstr(LoadAddr) << ' ' << utohexstr(SymSize.second) << ' '
+          << FnName;
+
+      uint64_t GuestAddr;
+      MCFunction *MCFN = nullptr;
+      if (FnName.startswith("fn_") &&
+          !FnName.drop_front(3).getAsInteger(16, GuestAddr))
+        MCFN = MCM->findFunctionAt(GuestAddr);
+      if (MCFN && !MCFN->empty()) {
+        uint64_t Begin = ~0ULL, End = 0;
+        for (const MCBasicBlock *BB : *MCFN) {
+          Begin = std::min(Begin, BB->getStartAddr());
+          End = std::max(End, BB->getEndAddr());
+        }
+        *OS << " [0x" << utohexstr(Begin) << "-0x" << utohexstr(End) << ']';
+      }
+      *OS << '\n';
     }
-    return MangledName;
-  }
-
-  ModuleHandleT addModule(Module *M) {
-    // Dump the IR we found.
-    DEBUG(M->dump());
-    // We need a memory manager to allocate memory and resolve symbols for this
-    // new module. Create one that resolves symbols by looking back into the
-    // JIT.
-    auto Resolver = createLambdaResolver(
-        [&](const std::string &Name) {
-          if (auto Sym = findSymbol(Name))
-            return RuntimeDyld::SymbolInfo(Sym.getAddress(), Sym.getFlags());
-          else if (auto Addr =
-                       RTDyldMemoryManager::getSymbolAddressInProcess(Name))
-            return RuntimeDyld::SymbolInfo(Addr, JITSymbolFlags::Exported);
-          return RuntimeDyld::SymbolInfo(nullptr);
-        },
-        [](const std::string &S) { return nullptr; });
-
-    return LazyEmitLayer.addModuleSet(singletonSet(std::move(M)),
-                                      make_unique<SectionMemoryManager>(),
-                                      std::move(Resolver));
-  }
-
-  void removeModule(ModuleHandleT H) { LazyEmitLayer.removeModuleSet(H); }
-
-  JITSymbol findSymbol(const std::string &Name) {
-    return LazyEmitLayer.findSymbol(Name, true);
   }
 
-  JITSymbol findUnmangledSymbol(const std::string Name) {
-    return findSymbol(mangle(Name));
+public:
+  /// \brief Write to \p OS, if not null, the functions of \p MCM.
+  PerfMapWriter(raw_ostream *OS, MCModule *MCM) : OS(OS), MCM(MCM) {}
+
+  void operator()(const ObjectFile &Obj,
+                  const RuntimeDyld::LoadedObjectInfo &Info) {
+    if (!OS)
+      return;
+    writeObject(Obj, Info);
+    // perf reads the map when it reports, possibly before we exit.
+    OS->flush();
   }
-
-private:
-  const DataLayout DL;
-  ObjLayerT ObjectLayer;
-  CompileLayerT CompileLayer;
-  LazyEmitLayerT LazyEmitLayer;
 };
 
 static uint64_t loadRegFromSet(uint8_t *RegSet, unsigned Offset, unsigned Size){
@@ -167,25 +164,6 @@ static uint64_t loadRegFromSet(uint8_t *RegSet, unsigned Offset, unsigned Size){
   }
 }
 
-static DCTranslator *__dc_DT;
-static DYNJIT *__dc_JIT;
-
-// FIXME: We need to handle cache invalidation when functions are freed.
-//static DenseMap<void *, void *> TranslationCache(128);
-
-static void *__llvm_dc_translate_at(void *addr) {
-  void *ptr;
-  Function *F = __dc_DT->translateRecursivelyAt((uint64_t)addr);
-  DEBUG(dbgs() << "Jumping to " << F->getName() << "\n");
-  ptr = (void*)__dc_JIT->findUnmangledSymbol(F->getName()).getAddress();
-  if (!ptr) {
-    __dc_JIT->addModule(__dc_DT->finalizeTranslationModule());
-    auto FnSymbol = __dc_JIT->findUnmangledSymbol(F->getName());
-    ptr = (void*)FnSymbol.getAddress();
-  }
-  return ptr;
-}
-
 // FIXME: This is all mach-o hacks to get this working.
 struct ProgramVars {
   const void*   mh;
@@ -358,24 +336,34 @@ void dyn_entry(int ac, char **av, const char **envp, const char **apple,
     exit(1);
   }
 
-  DIS->setDynTranslateAtCallback(
-      reinterpret_cast<void *>(&__llvm_dc_translate_at));
-
   // Add the program's symbols into the JIT's search space.
   if (sys::DynamicLibrary::LoadLibraryPermanently(nullptr)) {
     errs() << "error: unable to load program symbols.\n";
     exit(1);
   }
 
-  DYNJIT J(*TM);
+  // perf looks for the symbols of JIT'd code in /tmp/perf-<pid>.map.
+  std::unique_ptr<raw_fd_ostream> PerfMapOS;
+  if (PerfMap) {
+    std::string PerfMapFilename =
+        "/tmp/perf-" + std::to_string(::getpid()) + ".map";
+    std::error_code EC;
+    PerfMapOS.reset(
+        new raw_fd_ostream(PerfMapFilename, EC, sys::fs::F_Text));
+    if (EC) {
+      errs() << ToolName << ": '" << PerfMapFilename << "': " << EC.message()
+             << ".\n";
+      exit(1);
+    }
+  }
 
   std::unique_ptr<DCTranslator> DT(
     new DCTranslator(getGlobalContext(), DL,
                      TransOpt::Default, *DIS, *DRS,
                      *MIP, *STI, *MCM, OD.get()));
 
-  __dc_DT = DT.get();
-  __dc_JIT = &J;
+  // The indirect branches and calls are translated as they are reached.
+  DCJIT J(*DT, *TM, PerfMapWriter(PerfMapOS.get(), MCM.get()));
 
   // Now run it !
 
@@ -384,7 +372,7 @@ void dyn_entry(int ac, char **av, const char **envp, const char **apple,
   Function *FiniRegSetFn = DT->getFiniRegSetFunction();
 
   // Add these to the JIT.
-  J.addModule(DT->finalizeTranslationModule());
+  J.addCurrentModule();
 
   const StructLayout *SL = DL.getStructLayout(DRS->getRegSetType());
   std::vector<uint8_t> RegSet(SL->getSizeInBytes());
@@ -397,35 +385,25 @@ void dyn_entry(int ac, char **av, const char **envp, const char **apple,
 
   auto InitRegSetFnFP =
       (void (*)(uint8_t *, uint8_t *, uint32_t, uint32_t, char **))
-        (intptr_t)J.findUnmangledSymbol(InitRegSetFn->getName()).getAddress();
+        J.getFunctionAddress(InitRegSetFn);
   auto RunInitRegSet = [&]() {
     InitRegSetFnFP(RegSet.data(), StackPtr.data(), StackSize, argc, argv);
   };
 
   RunInitRegSet();
 
-  auto RunIRFunction = [&](Function *Fn) {
-    auto FnSymbol = J.findUnmangledSymbol(Fn->getName());
-    DEBUG(dbgs() << "Jumping to " << Fn->getName() << "\n");
-    auto FnPointer = (void (*)(uint8_t *))(intptr_t)FnSymbol.getAddress();
+  auto RunTranslatedAt = [&](uint64_t Addr) {
+    DEBUG(dbgs() << "Jumping to " << utohexstr(Addr) << "\n");
+    auto FnPointer = (void (*)(uint8_t *))J.getTranslatedAt(Addr);
     return FnPointer(RegSet.data());
   };
 
-  // Translate all static init functions.
+  // Translate and run all static init functions.
   auto TranslateAndRunStaticInitExit = [&](ArrayRef<uint64_t> Fns) {
-    std::vector<Function *> TranslatedFns;
-    TranslatedFns.reserve(Fns.size());
-    for (auto FnAddr : Fns)
-      TranslatedFns.push_back(
-          DT->translateRecursivelyAt(MOS->getEffectiveLoadAddr(FnAddr)));
-    DEBUG(DT->printCurrentModule(dbgs()));
-
-    // Add these to the JIT, and run them.
-    J.addModule(DT->finalizeTranslationModule());
-    for (auto Fn : TranslatedFns) {
-      DEBUG(dbgs() << "Executing static init/fini function " << Fn->getName()
-                   << "\n");
-      RunIRFunction(Fn);
+    for (auto FnAddr : Fns) {
+      DEBUG(dbgs() << "Executing static init/fini function at "
+                   << utohexstr(FnAddr) << "\n");
+      RunTranslatedAt(MOS->getEffectiveLoadAddr(FnAddr));
       // Reset the register state. Since we don't look at the return address,
       // this takes care of faking the push/pop.
       RunInitRegSet();
@@ -438,16 +416,11 @@ void dyn_entry(int ac, char **av, const char **envp, const char **apple,
   uint64_t CurPC = MOS->getEffectiveLoadAddr(MOS->getEntrypoint());
   assert(dlsym(RTLD_MAIN_ONLY, "main") == (void *)CurPC);
   do {
-    Function *Fn = DT->translateRecursivelyAt(CurPC);
-    DEBUG(dbgs() << "Executing function " << Fn->getName() << "\n");
-    J.addModule(DT->finalizeTranslationModule());
-    RunIRFunction(Fn);
+    RunTranslatedAt(CurPC);
     CurPC = loadRegFromSet(RegSet.data(), RegSetPCOffset, RegSetPCSize);
   } while (CurPC != ~0ULL);
 
-  auto FiniRegSetFnFP =
-      (int (*)(uint8_t *))(intptr_t)J.findUnmangledSymbol(
-                                          FiniRegSetFn->getName()).getAddress();
+  auto FiniRegSetFnFP = (int (*)(uint8_t *))J.getFunctionAddress(FiniRegSetFn);
   auto RunFiniRegSet = [&]() { return FiniRegSetFnFP(RegSet.data()); };
 
   int exitVal = RunFiniRegSet();
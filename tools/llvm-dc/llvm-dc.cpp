@@ -1,12 +1,18 @@
 #define DEBUG_TYPE "llvm-dc"
+#include "llvm/DC/DCBlockProfile.h"
+#include "llvm/DC/DCCallSummaries.h"
+#include "llvm/DC/DCGuestMemory.h"
 #include "llvm/DC/DCInstrSema.h"
+#include "llvm/DC/DCJIT.h"
 #include "llvm/DC/DCRegisterSema.h"
 #include "llvm/DC/DCTranslator.h"
 #include "llvm/ADT/Triple.h"
 #include "llvm/ADT/StringExtras.h"
+#include "llvm/ExecutionEngine/ExecutionEngine.h"
 #include "llvm/MC/MCAnalysis/MCCachingDisassembler.h"
 #include "llvm/MC/MCAnalysis/MCFunction.h"
 #include "llvm/MC/MCAnalysis/MCModule.h"
+#include "llvm/MC/MCAnalysis/MCModuleBinary.h"
 #include "llvm/MC/MCAnalysis/MCModuleYAML.h"
 #include "llvm/MC/MCAsmInfo.h"
 #include "llvm/MC/MCContext.h"
@@ -19,6 +25,7 @@
 #include "llvm/MC/MCRegisterInfo.h"
 #include "llvm/MC/MCSubtargetInfo.h"
 #include "llvm/MC/MCObjectFileInfo.h"
+#include "llvm/Object/MachO.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/ManagedStatic.h"
@@ -28,13 +35,18 @@
 #include "llvm/Support/TargetRegistry.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetMachine.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
 
 using namespace llvm;
 using namespace object;
 
 
 static cl::opt<std::string>
-InputFilename(cl::Positional, cl::desc("Input YAML MCModule file"), cl::Required);
+InputFilename(cl::Positional, cl::desc("Input MCModule file, YAML or binary"),
+              cl::Required);
 
 static cl::opt<std::string>
 TripleName("triple", cl::desc("Target triple to disassemble for, "
@@ -57,6 +69,57 @@ EnableDisassemblyCache("enable-mcod-disass-cache",
     cl::desc("Enable the MC Object disassembly instruction cache"),
     cl::init(false), cl::Hidden);
 
+static cl::opt<std::string>
+RunAt("run-at",
+      cl::desc("Run the function at this address, in the JIT, translating "
+               "the code it reaches as it runs, instead of printing the IR"),
+      cl::value_desc("address"));
+
+static cl::opt<bool>
+RunLazily("run-lazily",
+          cl::desc("With -run-at, translate each function when it is first "
+                   "called, rather than along with its caller"),
+          cl::init(true));
+
+static cl::opt<bool>
+CallSummaries("call-summaries",
+              cl::desc("Only save and restore, around the calls, the "
+                       "registers the callees can read and clobber"),
+              cl::init(false));
+
+static cl::opt<bool>
+ElideCalleeSaved("elide-callee-saved",
+                 cl::desc("Skip the saves and restores of the callee-saved "
+                          "registers in the prologues and epilogues"),
+                 cl::init(false));
+
+static cl::opt<std::string>
+GuestImage("guest-image",
+           cl::desc("With -run-at, map the segments of the Mach-O <file> as "
+                    "the memory of the code, at their own addresses if the "
+                    "host has them free, and elsewhere otherwise"),
+           cl::value_desc("file"));
+
+static cl::opt<std::string>
+GuestBase("guest-base",
+          cl::desc("With -guest-image, map the segments at this host address, "
+                   "rather than at their own"),
+          cl::value_desc("address"));
+
+static cl::opt<std::string>
+ExpandBlockTrace("expand-block-trace",
+                 cl::desc("Print the instructions run, per the trace that "
+                          "-enable-dc-block-trace wrote to <file>, from the "
+                          "blocks of the input, instead of translating it"),
+                 cl::value_desc("file"));
+
+static cl::opt<std::string>
+BlockProfile("block-profile",
+             cl::desc("Weigh the translated branches with the edge counts "
+                      "of the trace that -enable-dc-block-trace wrote to "
+                      "<file>"),
+             cl::value_desc("file"));
+
 static StringRef ToolName;
 
 static const Target *getTarget() {
@@ -76,6 +139,92 @@ static const Target *getTarget() {
   return TheTarget;
 }
 
+// Print the instructions of each block of the trace in Filename, one address
+// and function per line, under the thread headers of the trace.
+static int expandBlockTrace(const MCModule &MCM, StringRef Filename) {
+  auto BufOrErr = MemoryBuffer::getFileOrSTDIN(Filename);
+  if (std::error_code EC = BufOrErr.getError()) {
+    errs() << ToolName << ": '" << Filename << "': " << EC.message() << "\n";
+    return 1;
+  }
+  SmallVector<StringRef, 256> Lines;
+  (*BufOrErr)->getBuffer().split(Lines, "\n", -1, /*KeepEmpty=*/false);
+
+  // Look up all the blocks of the trace at once, each once.
+  std::vector<uint64_t> Addrs(Lines.size(), 0);
+  for (size_t I = 0, E = Lines.size(); I != E; ++I)
+    if (Lines[I].getAsInteger(16, Addrs[I]) &&
+        !Lines[I].startswith("thread ") && !Lines[I].startswith("dropped ")) {
+      errs() << ToolName << ": '" << Filename << "':" << (I + 1)
+             << ": invalid block trace entry\n";
+      return 1;
+    }
+  std::vector<uint64_t> Blocks(Addrs);
+  std::sort(Blocks.begin(), Blocks.end());
+  Blocks.erase(std::unique(Blocks.begin(), Blocks.end()), Blocks.end());
+  std::vector<MCModule::AddressLocation> Locs;
+  MCM.findContaining(Blocks, Locs);
+
+  for (size_t I = 0, E = Lines.size(); I != E; ++I) {
+    uint64_t Addr;
+    if (Lines[I].getAsInteger(16, Addr)) {
+      outs() << Lines[I] << "\n";
+      continue;
+    }
+    const MCModule::AddressLocation &L =
+        Locs[std::lower_bound(Blocks.begin(), Blocks.end(), Addr) -
+             Blocks.begin()];
+    if (!L.Block || L.Block->getStartAddr() != Addr) {
+      outs() << utohexstr(Addr) << " ?\n";
+      continue;
+    }
+    for (const MCDecodedInst &DI : *L.Block)
+      outs() << utohexstr(DI.Address) << ' ' << L.Function->getName() << "\n";
+  }
+  return 0;
+}
+
+// Run the function at Addr, and the code it returns to, until it returns to
+// the caller set up by the register set initialization, then print the value
+// it exits with.
+static int runTranslatedCode(DCTranslator &DT, DCRegisterSema &DRS,
+                             const MCRegisterInfo &MRI, const DataLayout &DL,
+                             TargetMachine &TM, uint64_t Addr) {
+  DCJIT JIT(DT, TM, DCJIT::ObjectLoadedFnTy(), RunLazily);
+  Function *InitRegSetFn = DT.getInitRegSetFunction();
+  Function *FiniRegSetFn = DT.getFiniRegSetFunction();
+  JIT.addCurrentModule();
+  auto InitRegSetFP =
+      (void (*)(uint8_t *, uint8_t *, uint32_t, uint32_t, char **))
+          JIT.getFunctionAddress(InitRegSetFn);
+  auto FiniRegSetFP = (int (*)(uint8_t *))JIT.getFunctionAddress(FiniRegSetFn);
+
+  const StructLayout *SL = DL.getStructLayout(DRS.getRegSetType());
+  std::vector<uint8_t> RegSet(SL->getSizeInBytes());
+  const unsigned StackSize = 1024 * 1024;
+  std::vector<uint8_t> Stack(StackSize);
+  std::string ProgName = InputFilename;
+  char *Argv[] = {&ProgName[0], nullptr};
+  InitRegSetFP(RegSet.data(), Stack.data(), StackSize, 1, Argv);
+
+  size_t PCSize, PCOffset;
+  std::tie(PCSize, PCOffset) =
+      DRS.getRegSizeOffsetInRegSet(MRI.getProgramCounter());
+  uint64_t PC = Addr;
+  do {
+    auto FnFP = (void (*)(uint8_t *))JIT.getTranslatedAt(PC);
+    FnFP(RegSet.data());
+    PC = 0;
+    std::memcpy(&PC, RegSet.data() + PCOffset, PCSize);
+  } while (PC != ~0ULL);
+
+  outs() << "exit value: " << FiniRegSetFP(RegSet.data()) << "\n";
+  DEBUG(dbgs() << JIT.getNumTranslations() << " translations, "
+               << JIT.getNumLookups() << " lookups, "
+               << JIT.getNumObjCCacheFills() << " message caches filled\n");
+  return 0;
+}
+
 int main(int argc, char **argv) {
   sys::PrintStackTraceOnErrorSignal();
   PrettyStackTraceProgram X(argc, argv);
@@ -153,13 +302,22 @@ int main(int argc, char **argv) {
            << ": " << ec.message() <<"\n";
     return 1;
   }
+  // llvm-mccfg -binary writes the compact representation, much faster to
+  // read than YAML.
   std::unique_ptr<MCModule> MCM;
-  StringRef ErrMsg = yaml2mcmodule(MCM, (*FileBuf)->getBuffer(), *MII, *MRI);
+  const StringRef Data = (*FileBuf)->getBuffer();
+  const bool IsBinary = isMCModuleBinary(Data);
+  StringRef ErrMsg = IsBinary ? binary2mcmodule(MCM, Data, *MII, *MRI)
+                              : yaml2mcmodule(MCM, Data, *MII, *MRI);
   if (!ErrMsg.empty()) {
-    errs() << "error: unable to read yaml mcmodule: " << ErrMsg << "\n";
+    errs() << "error: unable to read " << (IsBinary ? "binary" : "yaml")
+           << " mcmodule: " << ErrMsg << "\n";
     return 1;
   }
 
+  if (!ExpandBlockTrace.empty())
+    return expandBlockTrace(*MCM, ExpandBlockTrace);
+
   TransOpt::Level TOLvl;
   switch (TransOptLevel) {
   default:
@@ -173,6 +331,59 @@ int main(int argc, char **argv) {
 
   // FIXME: should we have a non-default datalayout?
   DataLayout DL("");
+  // The JIT runs the code on the host.
+  uint64_t RunAddr = 0;
+  std::unique_ptr<TargetMachine> TM;
+  if (!RunAt.empty()) {
+    if (StringRef(RunAt).getAsInteger(0, RunAddr)) {
+      errs() << ToolName << ": invalid -run-at address '" << RunAt << "'\n";
+      return 1;
+    }
+    InitializeNativeTarget();
+    InitializeNativeTargetAsmPrinter();
+    TM.reset(EngineBuilder().selectTarget());
+    if (!TM) {
+      errs() << "error: unable to select the host target to run on\n";
+      return 1;
+    }
+    DL = TM->createDataLayout();
+  }
+
+  // The memory of the code is mapped before it is translated: the loads and
+  // stores depend on where it is.
+  DCGuestMemory GuestMemory;
+  std::unique_ptr<MemoryBuffer> GuestImageBuf;
+  std::unique_ptr<ObjectFile> GuestImageObj;
+  if (!GuestImage.empty() && TM) {
+    uint64_t GuestHostAddr = 0;
+    if (!GuestBase.empty() &&
+        StringRef(GuestBase).getAsInteger(0, GuestHostAddr)) {
+      errs() << ToolName << ": invalid -guest-base address '" << GuestBase
+             << "'\n";
+      return 1;
+    }
+    auto BufOrErr = MemoryBuffer::getFile(GuestImage);
+    if (std::error_code EC = BufOrErr.getError()) {
+      errs() << ToolName << ": '" << GuestImage << "': " << EC.message()
+             << "\n";
+      return 1;
+    }
+    GuestImageBuf = std::move(*BufOrErr);
+    auto ObjOrErr =
+        ObjectFile::createObjectFile(GuestImageBuf->getMemBufferRef());
+    MachOObjectFile *MachO =
+        ObjOrErr ? dyn_cast<MachOObjectFile>(ObjOrErr->get()) : nullptr;
+    if (!MachO) {
+      errs() << ToolName << ": '" << GuestImage << "': not a Mach-O file\n";
+      return 1;
+    }
+    GuestImageObj = std::move(*ObjOrErr);
+    if (std::error_code EC = GuestMemory.map(*MachO, GuestHostAddr)) {
+      errs() << ToolName << ": unable to map '" << GuestImage
+             << "': " << EC.message() << "\n";
+      return 1;
+    }
+  }
 
   std::unique_ptr<DCRegisterSema> DRS(
       TheTarget->createDCRegisterSema(TripleName, *MRI, *MII, DL));
@@ -180,6 +391,7 @@ int main(int argc, char **argv) {
     errs() << "error: no dc register sema for target " << TripleName << "\n";
     return 1;
   }
+  DRS->setGuestMemoryBase(GuestMemory.getBase());
   std::unique_ptr<DCInstrSema> DIS(
       TheTarget->createDCInstrSema(TripleName, *DRS, *MRI, *MII));
   if (!DIS) {
@@ -190,6 +402,31 @@ int main(int argc, char **argv) {
   std::unique_ptr<DCTranslator> DT(new DCTranslator(
       getGlobalContext(), DL, TOLvl, *DIS, *DRS, *MIP, *STI,
       *MCM, /* MCOD= */ 0, AnnotateIROutput));
+  DCCallSummaries Summaries;
+  if (CallSummaries && MIA) {
+    Summaries.compute(*MCM, *MIA, *DRS, /*Stubs=*/nullptr, /*NumJobs=*/1);
+    DT->setCallSummaries(&Summaries);
+  }
+  if (ElideCalleeSaved && MIA)
+    DT->setCalleeSavedSpillAnalysis(MIA.get());
+  DCBlockProfile Profile;
+  if (!BlockProfile.empty()) {
+    auto BufOrErr = MemoryBuffer::getFile(BlockProfile);
+    if (std::error_code EC = BufOrErr.getError()) {
+      errs() << ToolName << ": '" << BlockProfile << "': " << EC.message()
+             << "\n";
+      return 1;
+    }
+    std::string ErrMsg;
+    if (!Profile.read((*BufOrErr)->getBuffer(), *MCM, ErrMsg)) {
+      errs() << ToolName << ": '" << BlockProfile << "': " << ErrMsg << "\n";
+      return 1;
+    }
+    DT->setBlockProfile(&Profile);
+  }
+
+  if (TM)
+    return runTranslatedCode(*DT, *DRS, *MRI, DL, *TM, RunAddr);
 
   DT->translateAllKnownFunctions();
   DT->printCurrentModule(outs());
@@ -0,0 +1,132 @@
+//===-- CallGraphFile.cpp - Write the call graph of llvm-dec --------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "CallGraphFile.h"
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCAnalysis/MCModule.h"
+#include "llvm/MC/MCInstrAnalysis.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/ToolOutputFile.h"
+#include <algorithm>
+
+using namespace llvm;
+
+uint32_t DCCallGraph::find(uint64_t Addr) const {
+  auto I = std::lower_bound(Addrs.begin(), Addrs.end(), Addr);
+  if (I == Addrs.end() || *I != Addr)
+    return ~0U;
+  return I - Addrs.begin();
+}
+
+StringRef DCCallGraph::getName(uint32_t I) const {
+  if (NameOffsets[I] == ~0U)
+    return StringRef();
+  return StringRef(Names.data() + NameOffsets[I]);
+}
+
+void llvm::buildCallGraph(const MCModule &MCM, const MCInstrAnalysis &MIA,
+                          const DCStubTargets &Stubs,
+                          const DCFunctionNameMap &Names, DCCallGraph &CG) {
+  // The calls, by caller address, with the stubs to local functions
+  // resolved.
+  std::vector<std::pair<uint64_t, uint64_t>> Calls;
+  std::vector<uint64_t> &Addrs = CG.Addrs;
+  Addrs.clear();
+  for (const auto &MCFN : MCM.funcs()) {
+    if (MCFN->empty())
+      continue;
+    const uint64_t Caller = MCFN->getEntryBlock()->getStartAddr();
+    Addrs.push_back(Caller);
+    for (const MCBasicBlock *BB : *MCFN)
+      for (const MCDecodedInst &I : *BB) {
+        const MCInstrAnalysis::Classification C = I.classify(MIA);
+        uint64_t Callee;
+        if (!C.isCall() || !C.evaluateBranch(Callee))
+          continue;
+        auto LI = Stubs.LocalAddrs.find(Callee);
+        if (LI != Stubs.LocalAddrs.end())
+          Callee = LI->second;
+        Calls.push_back(std::make_pair(Caller, Callee));
+        Addrs.push_back(Callee);
+      }
+  }
+  std::sort(Addrs.begin(), Addrs.end());
+  Addrs.erase(std::unique(Addrs.begin(), Addrs.end()), Addrs.end());
+  std::sort(Calls.begin(), Calls.end());
+  Calls.erase(std::unique(Calls.begin(), Calls.end()), Calls.end());
+
+  // The nodes without a name are "fn_<address>", as in the translation.
+  CG.Names.clear();
+  CG.NameOffsets.clear();
+  CG.NameOffsets.reserve(Addrs.size());
+  for (uint64_t Addr : Addrs) {
+    StringRef Name;
+    auto NI = Names.find(Addr);
+    auto EI = Stubs.ExternalNames.find(Addr);
+    if (NI != Names.end())
+      Name = NI->second;
+    else if (EI != Stubs.ExternalNames.end())
+      Name = EI->second;
+    if (Name.empty()) {
+      CG.NameOffsets.push_back(~0U);
+      continue;
+    }
+    CG.NameOffsets.push_back(CG.Names.size());
+    CG.Names.append(Name.begin(), Name.end());
+    CG.Names.push_back('\0');
+  }
+
+  // The calls are sorted by caller: each row is a contiguous range of them.
+  CG.EdgeBegins.clear();
+  CG.EdgeBegins.reserve(Addrs.size() + 1);
+  auto CI = Calls.begin();
+  for (uint64_t Addr : Addrs) {
+    CG.EdgeBegins.push_back(CI - Calls.begin());
+    while (CI != Calls.end() && CI->first == Addr)
+      ++CI;
+  }
+  CG.EdgeBegins.push_back(Calls.size());
+  CG.Edges.clear();
+  CG.Edges.reserve(Calls.size());
+  for (const auto &Call : Calls)
+    CG.Edges.push_back(CG.find(Call.second));
+}
+
+bool llvm::writeCallGraphFile(StringRef Filename, const DCCallGraph &CG,
+                              raw_ostream &Log) {
+  std::error_code EC;
+  tool_output_file Out(Filename, EC, sys::fs::F_None);
+  if (EC) {
+    Log << Filename << ": " << EC.message() << '\n';
+    return false;
+  }
+  raw_ostream &OS = Out.os();
+  support::endian::Writer<support::little> W(OS);
+  OS.write("DCCG\0\0\0\1", 8);
+  W.write<uint64_t>(CG.Addrs.size());
+  W.write<uint64_t>(CG.Edges.size());
+  W.write<uint64_t>(CG.Names.size());
+  for (uint64_t Addr : CG.Addrs)
+    W.write<uint64_t>(Addr);
+  for (uint32_t Offset : CG.NameOffsets)
+    W.write<uint32_t>(Offset);
+  for (uint32_t Begin : CG.EdgeBegins)
+    W.write<uint32_t>(Begin);
+  for (uint32_t Edge : CG.Edges)
+    W.write<uint32_t>(Edge);
+  OS << CG.Names;
+  Out.keep();
+
+  const size_t NumNamed =
+      CG.size() - std::count(CG.NameOffsets.begin(), CG.NameOffsets.end(), ~0U);
+  Log << "Call graph: " << CG.size() << " functions (" << NumNamed
+      << " named), " << CG.Edges.size() << " calls\n";
+  return true;
+}
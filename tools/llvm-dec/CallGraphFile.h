@@ -0,0 +1,78 @@
+//===-- CallGraphFile.h - Write the call graph of llvm-dec ------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares buildCallGraph and writeCallGraphFile, used by llvm-dec
+// to find the direct call graph of the machine code, before it is translated,
+// and to write it in a compact binary format that can be mapped and queried
+// as is.
+//
+// The file is a compressed sparse row adjacency list, all little-endian:
+//   char     Magic[8]                 "DCCG\0\0\0\1" (the last byte is the
+//                                     version)
+//   uint64_t NumNodes, NumEdges, NamesSize
+//   uint64_t Addrs[NumNodes]          the functions, and the external
+//                                     functions they call through stubs,
+//                                     sorted by address
+//   uint32_t NameOffsets[NumNodes]    the offset of the name of each node in
+//                                     Names, or ~0U if it has none: it is
+//                                     then "fn_<address>"
+//   uint32_t EdgeBegins[NumNodes + 1] the edges of node I are
+//                                     Edges[EdgeBegins[I], EdgeBegins[I + 1])
+//   uint32_t Edges[NumEdges]          the index of each callee, sorted
+//   char     Names[NamesSize]         the names, NUL-terminated
+//
+// The calls through stubs to local functions go to the functions. The tail
+// calls, which the disassembler turns into calls, are calls.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CALLGRAPHFILE_H
+#define LLVM_CALLGRAPHFILE_H
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/DC/DCInstrSema.h"
+#include <string>
+#include <vector>
+
+namespace llvm {
+
+class MCInstrAnalysis;
+class MCModule;
+class raw_ostream;
+
+/// \brief The direct call graph, as laid out in the file.
+struct DCCallGraph {
+  std::vector<uint64_t> Addrs;
+  std::vector<uint32_t> NameOffsets;
+  std::vector<uint32_t> EdgeBegins;
+  std::vector<uint32_t> Edges;
+  std::string Names;
+
+  size_t size() const { return Addrs.size(); }
+  /// \brief The index of the node at \p Addr, or ~0U if there's none.
+  uint32_t find(uint64_t Addr) const;
+  /// \brief The name of node \p I, or an empty string if it has none.
+  StringRef getName(uint32_t I) const;
+};
+
+/// \brief Find in \p CG the direct calls of the functions of \p MCM, with
+/// \p MIA. The functions are named after \p Names, and the external
+/// functions after \p Stubs. The instructions of \p MCM must not be
+/// released yet.
+void buildCallGraph(const MCModule &MCM, const MCInstrAnalysis &MIA,
+                    const DCStubTargets &Stubs, const DCFunctionNameMap &Names,
+                    DCCallGraph &CG);
+
+/// \brief Write \p CG to \p Filename, and sum it up in \p Log.
+bool writeCallGraphFile(StringRef Filename, const DCCallGraph &CG,
+                        raw_ostream &Log);
+
+} // end namespace llvm
+
+#endif
@@ -0,0 +1,181 @@
+//===-- FunctionDiff.cpp - Diff the functions of two versions -------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "FunctionDiff.h"
+#include "KnownFunctions.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCAnalysis/MCModule.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/ToolOutputFile.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+
+using namespace llvm;
+
+void llvm::computeFunctionSignatures(const MCModule &MCM,
+                                     const MCInstrAnalysis &MIA,
+                                     const DCStubTargets &Stubs,
+                                     const DCFunctionNameMap &Names,
+                                     DCFunctionSignatures &Sigs) {
+  Sigs.clear();
+  for (const auto &MCFN : MCM.funcs()) {
+    if (MCFN->empty())
+      continue;
+    DCFunctionSignature Sig;
+    Sig.Addr = MCFN->getEntryBlock()->getStartAddr();
+    Sig.Fingerprint = computeFunctionFingerprint(*MCFN, MIA, Stubs);
+    // The symbol names are as good, if the metadata doesn't name it.
+    auto NI = Names.find(Sig.Addr);
+    if (NI != Names.end())
+      Sig.Name = NI->second;
+    else if (MCFN->getName() != "fn_" + utohexstr(Sig.Addr))
+      Sig.Name = MCFN->getName();
+    Sigs.push_back(std::move(Sig));
+  }
+  std::sort(Sigs.begin(), Sigs.end(),
+            [](const DCFunctionSignature &L, const DCFunctionSignature &R) {
+              return L.Addr < R.Addr;
+            });
+}
+
+bool llvm::readFunctionSignatures(StringRef Filename,
+                                  DCFunctionSignatures &Sigs,
+                                  raw_ostream &Log) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> BufOrErr =
+      MemoryBuffer::getFile(Filename);
+  if (std::error_code EC = BufOrErr.getError()) {
+    Log << Filename << ": " << EC.message() << '\n';
+    return false;
+  }
+  Sigs.clear();
+  SmallVector<StringRef, 16> Lines;
+  (*BufOrErr)->getBuffer().split(Lines, "\n", -1, /*KeepEmpty=*/false);
+  for (unsigned I = 0, E = Lines.size(); I != E; ++I) {
+    // Only the functions are needed, and listed first.
+    if (!Lines[I].startswith("func "))
+      break;
+    // func <address> <blocks> <instructions> <fingerprint> <name>
+    SmallVector<StringRef, 6> Fields;
+    Lines[I].split(Fields, " ", 5);
+    DCFunctionSignature Sig;
+    if (Fields.size() != 6 || Fields[1].getAsInteger(0, Sig.Addr) ||
+        Fields[4].getAsInteger(16, Sig.Fingerprint) || Fields[5].empty()) {
+      Log << Filename << ":" << (I + 1) << ": invalid function '" << Lines[I]
+          << "'\n";
+      return false;
+    }
+    if (Fields[5] != "fn_" + utohexstr(Sig.Addr))
+      Sig.Name = Fields[5];
+    Sigs.push_back(std::move(Sig));
+  }
+  return true;
+}
+
+void llvm::diffFunctions(const DCFunctionSignatures &Old,
+                         const DCFunctionSignatures &New,
+                         DCFunctionDiff &Diff) {
+  static const unsigned Ambiguous = ~0U;
+  std::vector<bool> OldMatched(Old.size()), NewMatched(New.size());
+
+  // The names that several functions share, as the methods of categories,
+  // don't tell them apart.
+  StringMap<unsigned> OldByName;
+  for (unsigned I = 0, E = Old.size(); I != E; ++I)
+    if (!Old[I].Name.empty()) {
+      auto Inserted = OldByName.insert(std::make_pair(Old[I].Name, I));
+      if (!Inserted.second)
+        Inserted.first->second = Ambiguous;
+    }
+  StringMap<unsigned> NewNameCounts;
+  for (const DCFunctionSignature &Sig : New)
+    if (!Sig.Name.empty())
+      ++NewNameCounts[Sig.Name];
+  for (unsigned I = 0, E = New.size(); I != E; ++I) {
+    if (New[I].Name.empty() || NewNameCounts[New[I].Name] != 1)
+      continue;
+    auto OI = OldByName.find(New[I].Name);
+    if (OI == OldByName.end() || OI->second == Ambiguous)
+      continue;
+    OldMatched[OI->second] = NewMatched[I] = true;
+    if (Old[OI->second].Fingerprint == New[I].Fingerprint)
+      ++Diff.NumUnchanged;
+    else
+      Diff.Changed.push_back(std::make_pair(OI->second, I));
+  }
+
+  // The functions left, named or not, with a fingerprint that a single one
+  // of each version has, didn't change: they only moved, or were renamed.
+  DenseMap<uint64_t, unsigned> OldByFingerprint;
+  for (unsigned I = 0, E = Old.size(); I != E; ++I)
+    if (!OldMatched[I]) {
+      auto Inserted =
+          OldByFingerprint.insert(std::make_pair(Old[I].Fingerprint, I));
+      if (!Inserted.second)
+        Inserted.first->second = Ambiguous;
+    }
+  DenseMap<uint64_t, unsigned> NewFingerprintCounts;
+  for (unsigned I = 0, E = New.size(); I != E; ++I)
+    if (!NewMatched[I])
+      ++NewFingerprintCounts[New[I].Fingerprint];
+  for (unsigned I = 0, E = New.size(); I != E; ++I) {
+    if (NewMatched[I] || NewFingerprintCounts[New[I].Fingerprint] != 1)
+      continue;
+    auto OI = OldByFingerprint.find(New[I].Fingerprint);
+    if (OI == OldByFingerprint.end() || OI->second == Ambiguous)
+      continue;
+    OldMatched[OI->second] = NewMatched[I] = true;
+    ++Diff.NumUnchanged;
+  }
+
+  for (unsigned I = 0, E = New.size(); I != E; ++I)
+    if (!NewMatched[I])
+      Diff.Added.push_back(I);
+  for (unsigned I = 0, E = Old.size(); I != E; ++I)
+    if (!OldMatched[I])
+      Diff.Removed.push_back(I);
+}
+
+// Print the name of \p Sig, "fn_<address>" if it has none.
+static raw_ostream &printName(raw_ostream &OS, const DCFunctionSignature &Sig) {
+  if (Sig.Name.empty())
+    return OS << "fn_" << utohexstr(Sig.Addr);
+  return OS << Sig.Name;
+}
+
+bool llvm::writeFunctionDiff(StringRef Filename,
+                             const DCFunctionSignatures &Old,
+                             const DCFunctionSignatures &New,
+                             const DCFunctionDiff &Diff, raw_ostream &Log) {
+  std::error_code EC;
+  tool_output_file Out(Filename, EC, sys::fs::F_Text);
+  if (EC) {
+    Log << Filename << ": " << EC.message() << '\n';
+    return false;
+  }
+  raw_ostream &OS = Out.os();
+  for (unsigned I : Diff.Added)
+    printName(OS << format("added 0x%" PRIx64 " ", New[I].Addr), New[I])
+        << '\n';
+  for (unsigned I : Diff.Removed)
+    printName(OS << format("removed 0x%" PRIx64 " ", Old[I].Addr), Old[I])
+        << '\n';
+  for (const auto &OldNew : Diff.Changed)
+    printName(OS << format("changed 0x%" PRIx64, Old[OldNew.first].Addr)
+                 << format(" 0x%" PRIx64 " ", New[OldNew.second].Addr),
+              New[OldNew.second])
+        << '\n';
+  Out.keep();
+  return true;
+}
@@ -0,0 +1,92 @@
+//===-- FunctionDiff.h - Diff the functions of two versions -----*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares the function diff of llvm-dec -diff-against, used to
+// only translate the functions of a new version of a binary that are not in
+// the -mc-only tables of an earlier one, or that changed since.
+//
+// The functions are matched by name first: a named function that keeps its
+// name, Objective-C method or Swift metadata one, is the same function, and
+// changed if its fingerprint, see KnownFunctions.h, did. The others, as the
+// unnamed functions, are matched by fingerprint, when a single one of each
+// version has it: the addresses are no use, they shift from one version to
+// the next. The functions left are added, or removed.
+//
+// The report is a text file, one line per function that isn't unchanged, by
+// kind then address:
+//   added <address> <name>
+//   removed <old address> <name>
+//   changed <old address> <address> <name>
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_FUNCTIONDIFF_H
+#define LLVM_FUNCTIONDIFF_H
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/DC/DCInstrSema.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace llvm {
+
+class MCInstrAnalysis;
+class MCModule;
+class raw_ostream;
+
+/// \brief What the diff knows of a function: its start address, its
+/// fingerprint, and its name, or an empty string if it has none.
+struct DCFunctionSignature {
+  uint64_t Addr;
+  uint64_t Fingerprint;
+  std::string Name;
+};
+
+/// \brief The functions of a version, sorted by address.
+typedef std::vector<DCFunctionSignature> DCFunctionSignatures;
+
+/// \brief The functions that aren't unchanged, as indices in the old and the
+/// new signatures, sorted by address.
+struct DCFunctionDiff {
+  std::vector<unsigned> Added;
+  std::vector<unsigned> Removed;
+  std::vector<std::pair<unsigned, unsigned>> Changed;
+  unsigned NumUnchanged;
+
+  DCFunctionDiff() : NumUnchanged(0) {}
+};
+
+/// \brief Get, in \p Sigs, the signatures of the functions of \p MCM, named
+/// after \p Names, with \p MIA and \p Stubs to fingerprint them. The
+/// instructions of \p MCM must not be released yet.
+void computeFunctionSignatures(const MCModule &MCM, const MCInstrAnalysis &MIA,
+                               const DCStubTargets &Stubs,
+                               const DCFunctionNameMap &Names,
+                               DCFunctionSignatures &Sigs);
+
+/// \brief Read, in \p Sigs, the signatures of the functions of the -mc-only
+/// tables \p Filename, reporting the errors to \p Log.
+bool readFunctionSignatures(StringRef Filename, DCFunctionSignatures &Sigs,
+                            raw_ostream &Log);
+
+/// \brief Diff the functions \p New of a version against those, \p Old, of
+/// an earlier one, in \p Diff.
+void diffFunctions(const DCFunctionSignatures &Old,
+                   const DCFunctionSignatures &New, DCFunctionDiff &Diff);
+
+/// \brief Write the report of \p Diff, of \p New against \p Old, to
+/// \p Filename.
+bool writeFunctionDiff(StringRef Filename, const DCFunctionSignatures &Old,
+                       const DCFunctionSignatures &New,
+                       const DCFunctionDiff &Diff, raw_ostream &Log);
+
+} // end namespace llvm
+
+#endif
@@ -0,0 +1,68 @@
+//===-- FunctionNames.cpp - Name the functions of llvm-dec ----------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "FunctionNames.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/Object/ObjectiveCFile.h"
+#include "llvm/Object/SwiftMetadataIndex.h"
+#include <algorithm>
+
+using namespace llvm;
+
+// Name the function at \p Addr \p Name, unless it already has a name.
+static void addFunctionName(uint64_t Addr, std::string Name,
+                            StringMap<unsigned> &LastSuffix,
+                            DCFunctionNameMap &Names) {
+  if (Names.count(Addr))
+    return;
+  // IR names can't hold NULs, which broken metadata can give us.
+  std::replace(Name.begin(), Name.end(), '\0', '0');
+  auto Inserted = LastSuffix.insert(std::make_pair(Name, 0));
+  if (!Inserted.second) {
+    // The entries don't move when the map grows.
+    unsigned &Suffix = Inserted.first->second;
+    std::string Unique;
+    do
+      Unique = (Twine(Name) + "." + Twine(++Suffix)).str();
+    while (!LastSuffix.insert(std::make_pair(Unique, 0)).second);
+    Name = std::move(Unique);
+  }
+  Names[Addr] = std::move(Name);
+}
+
+void llvm::buildFunctionNames(const ObjectiveCFile &ObjC,
+                              const object::SwiftMetadataIndex *Swift,
+                              DCFunctionNameMap &Names) {
+  // The next suffix of each name already given, to make the others unique,
+  // the way IR names are.
+  StringMap<unsigned> LastSuffix;
+  // The methods are sorted by address: the first one at an address names it.
+  for (const ObjectiveCFile::ObjcMethod_t &M : ObjC.getMethods())
+    addFunctionName(M.IMP, ObjectiveCFile::getMethodName(M), LastSuffix,
+                    Names);
+  // The @objc methods of Swift classes keep their Objective-C names.
+  if (Swift)
+    for (const auto &N : Swift->getFunctionNames())
+      addFunctionName(N.first, N.second, LastSuffix, Names);
+}
+
+void llvm::buildObjCMessageIndex(const ObjectiveCFile &ObjC,
+                                 DCObjCMessageIndex &Index) {
+  for (const ObjectiveCFile::ObjcMethod_t &M : ObjC.getMethods())
+    if (M.isClassMethod)
+      Index.ClassMethods.insert(
+          std::make_pair(ObjectiveCFile::getMethodName(M), M.IMP));
+  // The references are also what the messages are tagged with, even when
+  // none is resolved.
+  for (const auto &Ref : ObjC.getSelectorRefs())
+    Index.SelectorRefs[Ref.first] = Ref.second;
+  for (const auto &Ref : ObjC.getClassRefs())
+    Index.ClassRefs[Ref.first] = Ref.second;
+}
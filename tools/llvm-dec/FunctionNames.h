@@ -0,0 +1,48 @@
+//===-- FunctionNames.h - Name the functions of llvm-dec --------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares buildFunctionNames, used by llvm-dec to name the
+// functions it translates after the Objective-C methods and the Swift vtable
+// entries and protocol witnesses they implement, and
+// buildObjCMessageIndex, to call the methods of the messages to classes
+// directly.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_FUNCTIONNAMES_H
+#define LLVM_FUNCTIONNAMES_H
+
+#include "llvm/DC/DCInstrSema.h"
+
+namespace llvm {
+
+class ObjectiveCFile;
+namespace object {
+class SwiftMetadataIndex;
+}
+
+/// \brief Name the methods of \p ObjC, "-[Class selector]" or
+/// "+[Class selector]", by implementation address, into \p Names, then the
+/// other functions \p Swift, if any, names.
+/// The names are made unique, in address order, and IR-safe. This only
+/// depends on the metadata of \p ObjC and \p Swift: it can run while the
+/// code is disassembled.
+void buildFunctionNames(const ObjectiveCFile &ObjC,
+                        const object::SwiftMetadataIndex *Swift,
+                        DCFunctionNameMap &Names);
+
+/// \brief Index the class methods of \p ObjC by "+[Class selector]" name,
+/// and its selector and class references, into \p Index. Like the names,
+/// this only depends on the metadata of \p ObjC.
+void buildObjCMessageIndex(const ObjectiveCFile &ObjC,
+                           DCObjCMessageIndex &Index);
+
+} // end namespace llvm
+
+#endif
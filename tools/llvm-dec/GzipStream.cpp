@@ -0,0 +1,110 @@
+//===-- GzipStream.cpp - Compress the outputs of llvm-dec -----------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "GzipStream.h"
+#include "llvm/Config/config.h"
+#include "llvm/Support/ThreadPool.h"
+#include <algorithm>
+#include <cstring>
+#if LLVM_ENABLE_ZLIB == 1 && HAVE_ZLIB_H
+#include <zlib.h>
+#endif
+
+using namespace llvm;
+
+// Large enough for the compression to be as good as that of the whole, and
+// small enough for the threads to share the modules of a few MB.
+static const size_t BlockSize = 1 << 20;
+
+raw_gzip_ostream::raw_gzip_ostream(raw_ostream &OS, unsigned NumJobs,
+                                   unsigned Level)
+    : OS(OS), Pool(new ThreadPool(NumJobs > 1 ? NumJobs - 1 : 0)),
+      Current(0), Pos(0), Level(std::min(std::max(Level, 1U), 9U)),
+      Failed(false) {
+  // The caller compresses a block as well.
+  Blocks.resize(Pool->getNumThreads() + 1);
+  Compressed.resize(Blocks.size());
+  Blocks[0].reserve(BlockSize);
+}
+
+raw_gzip_ostream::~raw_gzip_ostream() { finish(); }
+
+bool raw_gzip_ostream::isAvailable() {
+#if LLVM_ENABLE_ZLIB == 1 && HAVE_LIBZ
+  return true;
+#else
+  return false;
+#endif
+}
+
+#if LLVM_ENABLE_ZLIB == 1 && HAVE_LIBZ
+// Compress \p In to a gzip member, in \p Out.
+static bool compressBlock(const std::string &In, int Level, std::string &Out) {
+  z_stream Z;
+  memset(&Z, 0, sizeof(Z));
+  // 16 more window bits ask for the gzip header and trailer.
+  if (deflateInit2(&Z, Level, Z_DEFLATED, MAX_WBITS + 16, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK)
+    return false;
+  Out.resize(deflateBound(&Z, In.size()));
+  Z.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(In.data()));
+  Z.avail_in = In.size();
+  Z.next_out = reinterpret_cast<Bytef *>(&Out[0]);
+  Z.avail_out = Out.size();
+  const bool Done = deflate(&Z, Z_FINISH) == Z_STREAM_END;
+  Out.resize(Z.total_out);
+  deflateEnd(&Z);
+  return Done;
+}
+#else
+static bool compressBlock(const std::string &, int, std::string &) {
+  return false;
+}
+#endif
+
+void raw_gzip_ostream::compressBlocks() {
+  const size_t NumBlocks = Current + !Blocks[Current].empty();
+  std::vector<char> Done(NumBlocks);
+  parallel_for(*Pool, 0, NumBlocks, [&](size_t I) {
+    Done[I] = compressBlock(Blocks[I], Level, Compressed[I]);
+  });
+  for (size_t I = 0; I != NumBlocks; ++I) {
+    if (!Done[I])
+      Failed = true;
+    else
+      OS.write(Compressed[I].data(), Compressed[I].size());
+    Blocks[I].clear();
+  }
+  Current = 0;
+}
+
+void raw_gzip_ostream::write_impl(const char *Ptr, size_t Size) {
+  Pos += Size;
+  while (Size) {
+    std::string &Block = Blocks[Current];
+    const size_t N = std::min(Size, BlockSize - Block.size());
+    Block.append(Ptr, N);
+    Ptr += N;
+    Size -= N;
+    if (Block.size() < BlockSize)
+      break;
+    if (Current + 1 == Blocks.size()) {
+      compressBlocks();
+    } else {
+      ++Current;
+      Blocks[Current].reserve(BlockSize);
+    }
+  }
+}
+
+bool raw_gzip_ostream::finish() {
+  flush();
+  compressBlocks();
+  return !Failed;
+}
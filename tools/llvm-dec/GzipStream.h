@@ -0,0 +1,72 @@
+//===-- GzipStream.h - Compress the outputs of llvm-dec ---------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares raw_gzip_ostream, used by llvm-dec -compress-output to
+// write its outputs gzip-compressed, as fast as the parallel printer and
+// bitcode writer fill them.
+//
+// What is written is cut in blocks of 1 MB, compressed in parallel, each to
+// a gzip member of its own, and written in order. The members of a gzip file
+// are decompressed one after the other, so the output is a gzip file as any
+// other for gunzip, zcat or llvm-dis through a pipe; it is only a little
+// larger than compressing it as a whole, the blocks not sharing their
+// dictionary.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_GZIPSTREAM_H
+#define LLVM_GZIPSTREAM_H
+
+#include "llvm/Support/raw_ostream.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace llvm {
+
+class ThreadPool;
+
+class raw_gzip_ostream : public raw_ostream {
+public:
+  /// \brief Write the compression of what is written to this stream to
+  /// \p OS, at \p Level, from 1 (fastest) to 9 (smallest), with \p NumJobs
+  /// threads.
+  raw_gzip_ostream(raw_ostream &OS, unsigned NumJobs, unsigned Level);
+  ~raw_gzip_ostream() override;
+
+  /// \brief Whether llvm-dec was built with zlib.
+  static bool isAvailable();
+
+  /// \brief Compress and write what is left. Return false if a block
+  /// couldn't be compressed.
+  bool finish();
+
+private:
+  raw_ostream &OS;
+  std::unique_ptr<ThreadPool> Pool;
+  /// \brief A block per thread, kept with its memory from one round of
+  /// compression to the next: those before Current are full, and Current is
+  /// being filled.
+  std::vector<std::string> Blocks;
+  std::vector<std::string> Compressed;
+  size_t Current;
+  uint64_t Pos;
+  int Level;
+  bool Failed;
+
+  /// \brief Compress the blocks up to Current, and write them.
+  void compressBlocks();
+
+  void write_impl(const char *Ptr, size_t Size) override;
+  uint64_t current_pos() const override { return Pos; }
+};
+
+} // end namespace llvm
+
+#endif
@@ -0,0 +1,165 @@
+//===-- IPAFile.cpp - Executable extraction from IPA archives -------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "IPAFile.h"
+#include "llvm/Config/config.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/Errc.h"
+#include <algorithm>
+#if LLVM_ENABLE_ZLIB == 1 && HAVE_ZLIB_H
+#include <zlib.h>
+#endif
+
+#define DEBUG_TYPE "ipa-file"
+
+using namespace llvm;
+using namespace support;
+
+namespace {
+// The zip records we use, and their signatures.
+const uint32_t LocalHeaderSig = 0x04034b50;
+const uint32_t CentralHeaderSig = 0x02014b50;
+const uint32_t EndOfCentralDirSig = 0x06054b50;
+const size_t LocalHeaderSize = 30;
+const size_t CentralHeaderSize = 46;
+const size_t EndOfCentralDirSize = 22;
+
+const uint16_t MethodStored = 0;
+const uint16_t MethodDeflated = 8;
+
+struct ZipMember {
+  StringRef Name;
+  uint16_t Method;
+  uint32_t CompressedSize;
+  uint32_t UncompressedSize;
+  uint32_t LocalHeaderOffset;
+};
+} // end anonymous namespace
+
+bool llvm::isZipArchive(StringRef Data) {
+  return Data.size() >= 4 && endian::read32le(Data.data()) == LocalHeaderSig;
+}
+
+// Is Name "Payload/<App>.app/<App>", the usual main executable of <App>?
+static bool isMainExecutable(StringRef Name) {
+  if (!Name.startswith("Payload/"))
+    return false;
+  Name = Name.substr(strlen("Payload/"));
+  std::pair<StringRef, StringRef> DirFile = Name.split('/');
+  return DirFile.first.endswith(".app") &&
+         DirFile.first.drop_back(strlen(".app")) == DirFile.second;
+}
+
+static ErrorOr<ZipMember> findMember(StringRef Zip, StringRef MemberName) {
+  // The end of central directory record is followed by a comment of at most
+  // 64k bytes.
+  if (Zip.size() < EndOfCentralDirSize)
+    return errc::invalid_argument;
+  size_t EOCD = Zip.size() - EndOfCentralDirSize;
+  const size_t Lowest = EOCD > 0xFFFF ? EOCD - 0xFFFF : 0;
+  while (endian::read32le(Zip.data() + EOCD) != EndOfCentralDirSig) {
+    if (EOCD == Lowest)
+      return errc::invalid_argument;
+    --EOCD;
+  }
+  const char *EOCDPtr = Zip.data() + EOCD;
+  const uint16_t NumEntries = endian::read16le(EOCDPtr + 10);
+  const uint32_t CDOffset = endian::read32le(EOCDPtr + 16);
+  // Zip64 archives, with more than 64k entries or over 4GB, put 0xFF.. here.
+  if (NumEntries == 0xFFFF || CDOffset == 0xFFFFFFFF)
+    return errc::function_not_supported;
+
+  uint64_t Offset = CDOffset;
+  for (unsigned I = 0; I != NumEntries; ++I) {
+    if (Offset + CentralHeaderSize > Zip.size())
+      return errc::invalid_argument;
+    const char *Header = Zip.data() + Offset;
+    if (endian::read32le(Header) != CentralHeaderSig)
+      return errc::invalid_argument;
+    const uint16_t NameLen = endian::read16le(Header + 28);
+    const uint16_t ExtraLen = endian::read16le(Header + 30);
+    const uint16_t CommentLen = endian::read16le(Header + 32);
+    if (Offset + CentralHeaderSize + NameLen > Zip.size())
+      return errc::invalid_argument;
+
+    StringRef Name(Header + CentralHeaderSize, NameLen);
+    if (MemberName.empty() ? isMainExecutable(Name) : Name == MemberName) {
+      ZipMember M;
+      M.Name = Name;
+      M.Method = endian::read16le(Header + 10);
+      M.CompressedSize = endian::read32le(Header + 20);
+      M.UncompressedSize = endian::read32le(Header + 24);
+      M.LocalHeaderOffset = endian::read32le(Header + 42);
+      return M;
+    }
+    Offset += CentralHeaderSize + NameLen + ExtraLen + CommentLen;
+  }
+  return errc::no_such_file_or_directory;
+}
+
+ErrorOr<std::unique_ptr<MemoryBuffer>>
+llvm::extractIPAMember(MemoryBufferRef ZipRef, StringRef MemberName) {
+  StringRef Zip = ZipRef.getBuffer();
+  ErrorOr<ZipMember> MOrErr = findMember(Zip, MemberName);
+  if (std::error_code EC = MOrErr.getError())
+    return EC;
+  const ZipMember &M = *MOrErr;
+  DEBUG(dbgs() << "Loading IPA member " << M.Name << "\n");
+
+  // The local header repeats the name, but has its own extra field.
+  const uint64_t Offset = M.LocalHeaderOffset;
+  if (Offset + LocalHeaderSize > Zip.size() ||
+      endian::read32le(Zip.data() + Offset) != LocalHeaderSig)
+    return errc::invalid_argument;
+  const uint64_t DataOffset = Offset + LocalHeaderSize +
+                              endian::read16le(Zip.data() + Offset + 26) +
+                              endian::read16le(Zip.data() + Offset + 28);
+  if (DataOffset + M.CompressedSize > Zip.size())
+    return errc::invalid_argument;
+  StringRef Data = Zip.substr(DataOffset, M.CompressedSize);
+
+  if (M.Method == MethodStored) {
+    if (M.CompressedSize != M.UncompressedSize)
+      return errc::invalid_argument;
+    // Object files are read in place, through aligned structures: only a
+    // member at an odd offset needs copying.
+    if (reinterpret_cast<uintptr_t>(Data.data()) % 16)
+      return MemoryBuffer::getMemBufferCopy(Data, M.Name);
+    return MemoryBuffer::getMemBuffer(Data, M.Name,
+                                      /*RequiresNullTerminator=*/false);
+  }
+  if (M.Method != MethodDeflated)
+    return errc::function_not_supported;
+
+#if LLVM_ENABLE_ZLIB == 1 && HAVE_LIBZ
+  std::unique_ptr<MemoryBuffer> Buf =
+      MemoryBuffer::getNewUninitMemBuffer(M.UncompressedSize, M.Name);
+  z_stream S;
+  S.zalloc = Z_NULL;
+  S.zfree = Z_NULL;
+  S.opaque = Z_NULL;
+  S.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(Data.data()));
+  S.avail_in = Data.size();
+  S.next_out =
+      reinterpret_cast<Bytef *>(const_cast<char *>(Buf->getBufferStart()));
+  S.avail_out = M.UncompressedSize;
+  // Zip members are raw deflate streams, without the zlib header.
+  if (inflateInit2(&S, -MAX_WBITS) != Z_OK)
+    return errc::not_enough_memory;
+  const int Res = inflate(&S, Z_FINISH);
+  const uLong TotalOut = S.total_out;
+  inflateEnd(&S);
+  if (Res != Z_STREAM_END || TotalOut != M.UncompressedSize)
+    return errc::invalid_argument;
+  return std::move(Buf);
+#else
+  return errc::function_not_supported;
+#endif
+}
@@ -0,0 +1,39 @@
+//===-- IPAFile.h - Executable extraction from IPA archives -----*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares the functions used by llvm-dec to read an executable
+// straight out of an IPA, the zip archive iOS applications are shipped in.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_IPAFILE_H
+#define LLVM_IPAFILE_H
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/ErrorOr.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include <memory>
+
+namespace llvm {
+
+/// \brief Return true if \p Data starts like a zip archive (and thus an IPA).
+bool isZipArchive(StringRef Data);
+
+/// \brief Get the member of the zip archive \p Zip named \p MemberName.
+/// If \p MemberName is empty, get the main executable of the application,
+/// "Payload/<Name>.app/<Name>".
+/// Stored members are returned as views of \p Zip, which must outlive them,
+/// unless they are misaligned.
+/// Deflated members are inflated in one pass, into a buffer of their size.
+ErrorOr<std::unique_ptr<MemoryBuffer>>
+extractIPAMember(MemoryBufferRef Zip, StringRef MemberName = "");
+
+} // end namespace llvm
+
+#endif
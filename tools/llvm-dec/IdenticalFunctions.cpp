@@ -0,0 +1,174 @@
+//===-- IdenticalFunctions.cpp - Find the identical functions -------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "IdenticalFunctions.h"
+#include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCAnalysis/MCModule.h"
+#include "llvm/MC/MCExpr.h"
+#include "llvm/MC/MCInstrAnalysis.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+// The contents of a function that its translation depends on, as a string
+// of words, without its address.
+class FunctionNormalizer {
+  const MCInstrAnalysis &MIA;
+  uint64_t Begin, End;
+  std::vector<uint64_t> &Words;
+
+  void addTarget(uint64_t Target) {
+    if (Target >= Begin && Target < End) {
+      Words.push_back('l');
+      Words.push_back(Target - Begin);
+    } else {
+      Words.push_back('a');
+      Words.push_back(Target);
+    }
+  }
+
+  void addInst(const MCDecodedInst &I) {
+    const MCInst &Inst = I.Inst;
+    Words.push_back(I.Address - Begin);
+    Words.push_back(I.Size);
+    Words.push_back(Inst.getOpcode());
+    Words.push_back(Inst.getNumOperands());
+
+    // The operand that encodes a relative address, if any, is replaced by
+    // the address: the branch targets are the last immediate.
+    int RelOp = -1;
+    uint64_t Target = 0;
+    unsigned OpIdx;
+    const MCInstrAnalysis::Classification C = I.classify(MIA);
+    if (C.evaluateBranch(Target)) {
+      for (unsigned Op = Inst.getNumOperands(); Op != 0; --Op)
+        if (Inst.getOperand(Op - 1).isImm()) {
+          RelOp = Op - 1;
+          break;
+        }
+    } else if (MIA.evaluatePCRelativeAddress(Inst, I.Address, I.Size, OpIdx,
+                                             Target)) {
+      RelOp = OpIdx;
+    }
+
+    for (unsigned Op = 0, E = Inst.getNumOperands(); Op != E; ++Op) {
+      const MCOperand &MO = Inst.getOperand(Op);
+      if (int(Op) == RelOp) {
+        addTarget(Target);
+      } else if (MO.isReg()) {
+        Words.push_back('r');
+        Words.push_back(MO.getReg());
+      } else if (MO.isImm()) {
+        Words.push_back('i');
+        Words.push_back(MO.getImm());
+      } else if (MO.isFPImm()) {
+        Words.push_back('f');
+        Words.push_back(DoubleToBits(MO.getFPImm()));
+      } else if (MO.isExpr()) {
+        std::string Str;
+        raw_string_ostream OS(Str);
+        MO.getExpr()->print(OS, nullptr);
+        Words.push_back('e');
+        Words.push_back(hash_value(OS.str()));
+      } else {
+        Words.push_back('-');
+      }
+    }
+  }
+
+public:
+  FunctionNormalizer(const MCInstrAnalysis &MIA, std::vector<uint64_t> &Words)
+      : MIA(MIA), Begin(0), End(0), Words(Words) {}
+
+  void add(const MCFunction &MCFN) {
+    Begin = MCFN.getEntryBlock()->getStartAddr();
+    End = Begin;
+    for (const MCBasicBlock *BB : MCFN)
+      End = std::max(End, BB->getEndAddr());
+
+    Words.push_back(MCFN.getUnwindEncoding());
+    Words.push_back(MCFN.size());
+    for (const MCBasicBlock *BB : MCFN) {
+      Words.push_back(BB->getStartAddr() - Begin);
+      Words.push_back(BB->size());
+      for (const MCDecodedInst &I : *BB)
+        addInst(I);
+      Words.push_back(BB->succ_end() - BB->succ_begin());
+      for (auto SI = BB->succ_begin(), SE = BB->succ_end(); SI != SE; ++SI)
+        addTarget((*SI)->getStartAddr());
+    }
+  }
+};
+} // end anonymous namespace
+
+static void normalizeFunction(const MCFunction &MCFN,
+                              const MCInstrAnalysis &MIA,
+                              std::vector<uint64_t> &Words) {
+  Words.clear();
+  FunctionNormalizer(MIA, Words).add(MCFN);
+}
+
+unsigned llvm::findIdenticalFunctions(const MCModule &MCM,
+                                      const MCInstrAnalysis &MIA,
+                                      unsigned MinInsts,
+                                      DenseMap<uint64_t, uint64_t> &Identical) {
+  // The functions, by hash of their normalized contents: only those of a
+  // bucket need to be compared.
+  DenseMap<uint64_t, SmallVector<const MCFunction *, 1>> Buckets;
+  std::vector<uint64_t> Words;
+  for (const auto &MCFN : MCM.funcs()) {
+    if (MCFN->empty())
+      continue;
+    unsigned NumInsts = 0;
+    for (const MCBasicBlock *BB : *MCFN)
+      NumInsts += BB->size();
+    if (NumInsts < MinInsts)
+      continue;
+    normalizeFunction(*MCFN, MIA, Words);
+    Buckets[hash_combine_range(Words.begin(), Words.end())].push_back(
+        MCFN.get());
+  }
+
+  unsigned NumIdentical = 0;
+  for (auto &Bucket : Buckets) {
+    SmallVectorImpl<const MCFunction *> &Fns = Bucket.second;
+    if (Fns.size() < 2)
+      continue;
+    std::sort(Fns.begin(), Fns.end(),
+              [](const MCFunction *L, const MCFunction *R) {
+                return L->getEntryBlock()->getStartAddr() <
+                       R->getEntryBlock()->getStartAddr();
+              });
+    // The distinct functions of the bucket: different functions can have
+    // the same hash.
+    std::vector<std::pair<uint64_t, std::vector<uint64_t>>> Distinct;
+    for (const MCFunction *MCFN : Fns) {
+      const uint64_t Addr = MCFN->getEntryBlock()->getStartAddr();
+      normalizeFunction(*MCFN, MIA, Words);
+      auto DI = std::find_if(
+          Distinct.begin(), Distinct.end(),
+          [&](const std::pair<uint64_t, std::vector<uint64_t>> &D) {
+            return D.second == Words;
+          });
+      if (DI == Distinct.end()) {
+        Distinct.push_back(std::make_pair(Addr, Words));
+        continue;
+      }
+      Identical[Addr] = DI->first;
+      ++NumIdentical;
+    }
+  }
+  return NumIdentical;
+}
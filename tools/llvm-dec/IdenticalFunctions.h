@@ -0,0 +1,42 @@
+//===-- IdenticalFunctions.h - Find the identical functions -----*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares findIdenticalFunctions, used by llvm-dec to translate
+// only once the functions whose machine code is the same, as the property
+// accessors and the thunks the compilers generate by the thousands, and to
+// define the others as calls to that translation.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_IDENTICALFUNCTIONS_H
+#define LLVM_IDENTICALFUNCTIONS_H
+
+#include "llvm/ADT/DenseMap.h"
+
+namespace llvm {
+
+class MCInstrAnalysis;
+class MCModule;
+
+/// \brief Map, in \p Identical, the start address of each function of
+/// \p MCM identical to another one at a lower address to the start of the
+/// lowest. Identical functions have the same instructions, blocks and
+/// edges, at the same offsets, and, with \p MIA, their branches and
+/// PC-relative operands refer to the same addresses, or to the same offset
+/// in each function. The functions of fewer than \p MinInsts instructions
+/// are left alone: a call to them is no smaller. The instructions of \p MCM
+/// must not be released yet.
+/// \returns the number of functions mapped.
+unsigned findIdenticalFunctions(const MCModule &MCM, const MCInstrAnalysis &MIA,
+                                unsigned MinInsts,
+                                DenseMap<uint64_t, uint64_t> &Identical);
+
+} // end namespace llvm
+
+#endif
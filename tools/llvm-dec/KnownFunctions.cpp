@@ -0,0 +1,198 @@
+//===-- KnownFunctions.cpp - Fingerprint the library functions ------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "KnownFunctions.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCAnalysis/MCModule.h"
+#include "llvm/MC/MCInstrAnalysis.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/ToolOutputFile.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace llvm;
+
+namespace {
+class FingerprintHasher {
+  MD5 Hash;
+
+public:
+  void add(uint64_t V) {
+    uint8_t Bytes[8];
+    support::endian::write64le(Bytes, V);
+    Hash.update(Bytes);
+  }
+  void add(StringRef S) {
+    add(S.size());
+    Hash.update(S);
+  }
+  uint64_t final() {
+    MD5::MD5Result Result;
+    Hash.final(Result);
+    return support::endian::read64le(Result);
+  }
+};
+} // end anonymous namespace
+
+static unsigned getNumInsts(const MCFunction &MCFN) {
+  unsigned NumInsts = 0;
+  for (const MCBasicBlock *BB : MCFN)
+    NumInsts += BB->size();
+  return NumInsts;
+}
+
+// Whether \p MCFN is worth fingerprinting.
+static bool isCandidate(const MCFunction &MCFN, unsigned MinInsts) {
+  return !MCFN.empty() && getNumInsts(MCFN) >= MinInsts;
+}
+
+uint64_t llvm::computeFunctionFingerprint(const MCFunction &MCFN,
+                                          const MCInstrAnalysis &MIA,
+                                          const DCStubTargets &Stubs) {
+  DenseMap<const MCBasicBlock *, unsigned> BlockIndices;
+  for (const MCBasicBlock *BB : MCFN)
+    BlockIndices.insert(std::make_pair(BB, BlockIndices.size()));
+
+  FingerprintHasher H;
+  H.add(MCFN.size());
+  for (const MCBasicBlock *BB : MCFN) {
+    H.add(BB->size());
+    for (const MCDecodedInst &I : *BB) {
+      H.add(I.Inst.getOpcode());
+      H.add(I.Inst.getNumOperands());
+      for (const MCOperand &Op : I.Inst) {
+        if (Op.isReg()) {
+          H.add('r');
+          H.add(Op.getReg());
+        } else {
+          H.add('-');
+        }
+      }
+      // The calls to the local functions are only told apart by the CFG
+      // shape, but those to the external functions by their name.
+      const MCInstrAnalysis::Classification C = I.classify(MIA);
+      uint64_t Target;
+      if (!C.isCall() || !C.evaluateBranch(Target))
+        continue;
+      auto EI = Stubs.ExternalNames.find(Target);
+      if (EI != Stubs.ExternalNames.end())
+        H.add(EI->second);
+    }
+    H.add(BB->succ_end() - BB->succ_begin());
+    for (auto SI = BB->succ_begin(), SE = BB->succ_end(); SI != SE; ++SI) {
+      auto BI = BlockIndices.find(*SI);
+      H.add(BI == BlockIndices.end() ? ~0ULL : BI->second);
+    }
+  }
+  return H.final();
+}
+
+bool llvm::readKnownFunctions(StringRef Filename, DCKnownFunctionMap &Known,
+                              raw_ostream &Log) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> BufOrErr =
+      MemoryBuffer::getFile(Filename);
+  if (std::error_code EC = BufOrErr.getError()) {
+    Log << Filename << ": " << EC.message() << '\n';
+    return false;
+  }
+  DenseSet<uint64_t> Ambiguous;
+  SmallVector<StringRef, 16> Lines;
+  (*BufOrErr)->getBuffer().split(Lines, "\n", -1, /*KeepEmpty=*/false);
+  for (unsigned I = 0, E = Lines.size(); I != E; ++I) {
+    StringRef Line = Lines[I].trim();
+    if (Line.empty() || Line.startswith("#"))
+      continue;
+    // The names of the methods have spaces: they are the rest of the line.
+    std::pair<StringRef, StringRef> Fields = Line.split(' ');
+    StringRef Name = Fields.second.trim();
+    uint64_t Fingerprint;
+    if (Fields.first.getAsInteger(16, Fingerprint) || Name.empty()) {
+      Log << Filename << ":" << (I + 1) << ": invalid known function '"
+          << Line << "'\n";
+      return false;
+    }
+    auto Inserted = Known.insert(std::make_pair(Fingerprint, Name.str()));
+    if (!Inserted.second && Inserted.first->second != Name)
+      Ambiguous.insert(Fingerprint);
+  }
+  for (uint64_t Fingerprint : Ambiguous)
+    Known.erase(Fingerprint);
+  return true;
+}
+
+bool llvm::writeFunctionFingerprints(StringRef Filename, const MCModule &MCM,
+                                     const MCInstrAnalysis &MIA,
+                                     const DCStubTargets &Stubs,
+                                     const DCFunctionNameMap &Names,
+                                     unsigned MinInsts, raw_ostream &Log) {
+  std::error_code EC;
+  tool_output_file Out(Filename, EC, sys::fs::F_Text);
+  if (EC) {
+    Log << Filename << ": " << EC.message() << '\n';
+    return false;
+  }
+  unsigned NumWritten = 0;
+  for (const auto &MCFN : MCM.funcs()) {
+    if (!isCandidate(*MCFN, MinInsts))
+      continue;
+    const uint64_t Addr = MCFN->getEntryBlock()->getStartAddr();
+    auto NI = Names.find(Addr);
+    StringRef Name = NI != Names.end() ? StringRef(NI->second)
+                                       : StringRef(MCFN->getName());
+    if (Name.empty() || Name == "fn_" + utohexstr(Addr))
+      continue;
+    Out.os() << format_hex_no_prefix(
+                    computeFunctionFingerprint(*MCFN, MIA, Stubs), 16)
+             << ' ' << Name << '\n';
+    ++NumWritten;
+  }
+  Out.keep();
+  Log << "Fingerprints: " << NumWritten << " functions\n";
+  return true;
+}
+
+unsigned llvm::matchKnownFunctions(const MCModule &MCM,
+                                   const MCInstrAnalysis &MIA,
+                                   const DCStubTargets &Stubs,
+                                   const DCKnownFunctionMap &Known,
+                                   unsigned MinInsts,
+                                   DenseSet<uint64_t> &Matched,
+                                   DCFunctionNameMap &Names) {
+  if (Known.empty())
+    return 0;
+  // The start of the function of each known fingerprint, or ~0 if several
+  // functions have it.
+  DenseMap<uint64_t, uint64_t> Matches;
+  for (const auto &MCFN : MCM.funcs()) {
+    if (!isCandidate(*MCFN, MinInsts))
+      continue;
+    const uint64_t Fingerprint = computeFunctionFingerprint(*MCFN, MIA, Stubs);
+    if (!Known.count(Fingerprint))
+      continue;
+    const uint64_t Addr = MCFN->getEntryBlock()->getStartAddr();
+    auto Inserted = Matches.insert(std::make_pair(Fingerprint, Addr));
+    if (!Inserted.second)
+      Inserted.first->second = ~0ULL;
+  }
+
+  unsigned NumMatched = 0;
+  for (const auto &FingerprintAddr : Matches) {
+    if (FingerprintAddr.second == ~0ULL)
+      continue;
+    Matched.insert(FingerprintAddr.second);
+    Names[FingerprintAddr.second] = Known.find(FingerprintAddr.first)->second;
+    ++NumMatched;
+  }
+  return NumMatched;
+}
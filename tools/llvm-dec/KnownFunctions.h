@@ -0,0 +1,82 @@
+//===-- KnownFunctions.h - Fingerprint the library functions ----*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares the fingerprints of the machine functions, used by
+// llvm-dec to recognize the functions of the libraries that are statically
+// linked in many binaries, and only declare them, under their name, instead
+// of translating them again.
+//
+// A fingerprint hashes the opcodes and the registers of the instructions,
+// the names of the external functions they call, and the shape of the CFG,
+// the blocks numbered in function order. The immediates are left out: most
+// are addresses, or offsets to them, that change from one binary to the next.
+//
+// The database is a text file, with one function per line:
+//
+//   <16 hex digits fingerprint> <name>
+//
+// and the lines starting with '#' ignored. -write-fingerprints writes the
+// functions of a binary in this format.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_KNOWNFUNCTIONS_H
+#define LLVM_KNOWNFUNCTIONS_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/DC/DCInstrSema.h"
+#include <string>
+
+namespace llvm {
+
+class MCFunction;
+class MCInstrAnalysis;
+class MCModule;
+class raw_ostream;
+
+/// \brief The known functions, by fingerprint. The fingerprints that several
+/// names share are ambiguous, and left out.
+typedef DenseMap<uint64_t, std::string> DCKnownFunctionMap;
+
+/// \brief Get the fingerprint of \p MCFN, with \p MIA and \p Stubs to find
+/// the external functions it calls. Its instructions must not be released
+/// yet.
+uint64_t computeFunctionFingerprint(const MCFunction &MCFN,
+                                    const MCInstrAnalysis &MIA,
+                                    const DCStubTargets &Stubs);
+
+/// \brief Read the database \p Filename into \p Known, reporting the errors
+/// to \p Log.
+bool readKnownFunctions(StringRef Filename, DCKnownFunctionMap &Known,
+                        raw_ostream &Log);
+
+/// \brief Write to \p Filename the fingerprints of the functions of \p MCM
+/// of at least \p MinInsts instructions, named after \p Names, or their
+/// symbol. The functions without a name are left out.
+bool writeFunctionFingerprints(StringRef Filename, const MCModule &MCM,
+                               const MCInstrAnalysis &MIA,
+                               const DCStubTargets &Stubs,
+                               const DCFunctionNameMap &Names,
+                               unsigned MinInsts, raw_ostream &Log);
+
+/// \brief Add to \p Matched the start addresses of the functions of \p MCM,
+/// of at least \p MinInsts instructions, that are in \p Known, and name them
+/// in \p Names. The smaller functions are too common to tell apart, and a
+/// fingerprint that several functions of \p MCM share is ignored as well.
+/// \returns the number of functions matched.
+unsigned matchKnownFunctions(const MCModule &MCM, const MCInstrAnalysis &MIA,
+                             const DCStubTargets &Stubs,
+                             const DCKnownFunctionMap &Known,
+                             unsigned MinInsts, DenseSet<uint64_t> &Matched,
+                             DCFunctionNameMap &Names);
+
+} // end namespace llvm
+
+#endif
@@ -0,0 +1,78 @@
+//===-- OutlinedFunctions.cpp - Find the outlined fragments ---------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "OutlinedFunctions.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCAnalysis/MCModule.h"
+#include "llvm/MC/MCInstrAnalysis.h"
+
+using namespace llvm;
+
+// Whether \p MCFN is straight-line code, that only calls, if at all, just
+// before returning: the tail calls are translated to a call and a return.
+static bool isStraightLine(const MCFunction &MCFN, const MCInstrAnalysis &MIA,
+                           unsigned MaxInsts) {
+  if (MCFN.size() != 1)
+    return false;
+  const MCBasicBlock &BB = *MCFN.getEntryBlock();
+  if (BB.empty() || BB.size() > MaxInsts || !MIA.isReturn(BB.back().Inst))
+    return false;
+  for (const MCDecodedInst *I = BB.begin(), *E = &BB.back() - 1; I < E; ++I)
+    if (MIA.isCall(I->Inst) || MIA.isBranch(I->Inst))
+      return false;
+  return true;
+}
+
+unsigned llvm::findOutlinedFunctions(const MCModule &MCM,
+                                     const MCInstrAnalysis &MIA,
+                                     const DCStubTargets &Stubs,
+                                     unsigned MaxInsts,
+                                     DenseSet<uint64_t> &Outlined) {
+  // The straight-line functions, by address, and the number of functions
+  // calling them, counting each caller once.
+  struct CallerCount {
+    unsigned NumCallers;
+    uint64_t LastCaller;
+  };
+  DenseMap<uint64_t, CallerCount> Candidates;
+  for (const auto &MCFN : MCM.funcs())
+    if (!MCFN->empty() && isStraightLine(*MCFN, MIA, MaxInsts))
+      Candidates[MCFN->getEntryBlock()->getStartAddr()] = {0, 0};
+  if (Candidates.empty())
+    return 0;
+
+  for (const auto &MCFN : MCM.funcs()) {
+    if (MCFN->empty())
+      continue;
+    const uint64_t Caller = MCFN->getEntryBlock()->getStartAddr();
+    for (const MCBasicBlock *BB : *MCFN)
+      for (const MCDecodedInst &I : *BB) {
+        const MCInstrAnalysis::Classification C = I.classify(MIA);
+        uint64_t Callee;
+        if (!C.isCall() || !C.evaluateBranch(Callee))
+          continue;
+        auto LI = Stubs.LocalAddrs.find(Callee);
+        if (LI != Stubs.LocalAddrs.end())
+          Callee = LI->second;
+        auto CI = Candidates.find(Callee);
+        if (Callee == Caller || CI == Candidates.end() ||
+            (CI->second.NumCallers && CI->second.LastCaller == Caller))
+          continue;
+        ++CI->second.NumCallers;
+        CI->second.LastCaller = Caller;
+      }
+  }
+
+  unsigned NumFound = 0;
+  for (const auto &KV : Candidates)
+    if (KV.second.NumCallers >= 2 && Outlined.insert(KV.first).second)
+      ++NumFound;
+  return NumFound;
+}
@@ -0,0 +1,42 @@
+//===-- OutlinedFunctions.h - Find the outlined fragments -------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares findOutlinedFunctions, used by llvm-dec to find the
+// fragments that the machine outliner of -Oz builds (OUTLINED_FUNCTION_<n>),
+// so that their translation is marked always-inline.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_OUTLINEDFUNCTIONS_H
+#define LLVM_OUTLINEDFUNCTIONS_H
+
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/DC/DCInstrSema.h"
+
+namespace llvm {
+
+class MCInstrAnalysis;
+class MCModule;
+
+/// \brief Add to \p Outlined the start addresses of the functions of \p MCM
+/// that look like outlined fragments. They are straight-line: a single
+/// block, of at most \p MaxInsts instructions, ending in a return, and
+/// without other calls than a tail call before it. They are also called,
+/// with \p MIA, from at least two other functions, as the outliner only
+/// extracts repeated sequences. The calls through the stubs of \p Stubs to
+/// local functions count. The instructions of \p MCM must not be released
+/// yet.
+/// \returns the number of fragments found.
+unsigned findOutlinedFunctions(const MCModule &MCM, const MCInstrAnalysis &MIA,
+                               const DCStubTargets &Stubs, unsigned MaxInsts,
+                               DenseSet<uint64_t> &Outlined);
+
+} // end namespace llvm
+
+#endif
@@ -0,0 +1,165 @@
+//===-- ProgressReporter.cpp - Periodic progress reports of llvm-dec ------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "ProgressReporter.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/raw_ostream.h"
+#include <cstdio>
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#endif
+
+using namespace llvm;
+
+uint64_t llvm::getResidentBytes() {
+#if defined(__linux__)
+  int FD = ::open("/proc/self/statm", O_RDONLY);
+  if (FD >= 0) {
+    char Buf[128];
+    ssize_t N = ::read(FD, Buf, sizeof(Buf) - 1);
+    ::close(FD);
+    unsigned long long Size, Resident;
+    if (N > 0) {
+      Buf[N] = '\0';
+      if (sscanf(Buf, "%llu %llu", &Size, &Resident) == 2)
+        return Resident * uint64_t(::sysconf(_SC_PAGESIZE));
+    }
+  }
+#elif defined(__APPLE__)
+  mach_task_basic_info_data_t Info;
+  mach_msg_type_number_t Count = MACH_TASK_BASIC_INFO_COUNT;
+  if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                reinterpret_cast<task_info_t>(&Info), &Count) == KERN_SUCCESS)
+    return Info.resident_size;
+#endif
+  return sys::Process::GetMallocUsage();
+}
+
+ProgressReporter::ProgressReporter(StringRef Input, double Interval,
+                                   bool ToStderr, StringRef StatusFile)
+    : Input(Input), Interval(Interval), ToStderr(ToStderr),
+      StatusFile(StatusFile), Stopping(false), Phase(nullptr),
+      PhaseCounters() {
+  if (!StatusFile.empty())
+    TempStatusFile = this->StatusFile + ".tmp";
+  Thread = std::thread([this] { run(); });
+}
+
+ProgressReporter::~ProgressReporter() {
+  {
+    std::lock_guard<std::mutex> L(Lock);
+    Stopping = true;
+  }
+  Wakeup.notify_one();
+  Thread.join();
+  report("finished");
+}
+
+void ProgressReporter::startPhase(const char *Name, Counters C) {
+  std::lock_guard<std::mutex> L(Lock);
+  Phase = Name;
+  PhaseCounters = C;
+  PhaseStart = std::chrono::steady_clock::now();
+}
+
+void ProgressReporter::endPhase() {
+  std::lock_guard<std::mutex> L(Lock);
+  Phase = nullptr;
+  PhaseCounters = Counters();
+}
+
+void ProgressReporter::run() {
+  std::unique_lock<std::mutex> L(Lock);
+  while (!Wakeup.wait_for(L, Interval, [this] { return Stopping; })) {
+    L.unlock();
+    report(nullptr);
+    L.lock();
+  }
+}
+
+void ProgressReporter::report(const char *Name) {
+  // Only the periodic reports, of a phase, go to stderr.
+  bool Print = ToStderr && !Name;
+  uint64_t NumFunctions = 0, NumDone = 0, NumInsts = 0;
+  double Seconds = 0;
+  {
+    // The counters are only read under the lock: endPhase comes before they
+    // are freed.
+    std::lock_guard<std::mutex> L(Lock);
+    if (!Name)
+      Name = Phase;
+    Print &= Phase != nullptr;
+    if (Phase && PhaseCounters.NumFunctions) {
+      NumFunctions = *PhaseCounters.NumFunctions;
+      NumDone = *PhaseCounters.NumDoneFunctions;
+      NumInsts = *PhaseCounters.NumInsts;
+      std::chrono::duration<double> D =
+          std::chrono::steady_clock::now() - PhaseStart;
+      Seconds = D.count();
+    }
+  }
+  const double InstsPerSecond = Seconds > 0 ? NumInsts / Seconds : 0;
+  // The time left is extrapolated from the functions done so far.
+  const double ETA =
+      NumDone && NumFunctions >= NumDone
+          ? Seconds * (NumFunctions - NumDone) / NumDone
+          : -1;
+  const uint64_t Resident = getResidentBytes();
+
+  // Everything is formatted on the stack: see the class comment.
+  char Buf[4096];
+  if (Print) {
+    int N = snprintf(Buf, sizeof(Buf),
+                     "progress: %s: %s %llu/%llu functions, %.0f insts/s, "
+                     "%llu MB resident",
+                     Input.c_str(), Name, (unsigned long long)NumDone,
+                     (unsigned long long)NumFunctions, InstsPerSecond,
+                     (unsigned long long)(Resident >> 20));
+    if (N > 0 && size_t(N) < sizeof(Buf) && ETA >= 0)
+      N += snprintf(Buf + N, sizeof(Buf) - N, ", ETA %llum%02llus",
+                    (unsigned long long)ETA / 60,
+                    (unsigned long long)ETA % 60);
+    if (N > 0 && size_t(N) < sizeof(Buf) - 1) {
+      Buf[N++] = '\n';
+      // A single write, so that the lines of concurrent inputs don't mix.
+      errs().write(Buf, N);
+    }
+  }
+
+  if (StatusFile.empty())
+    return;
+  int N = snprintf(Buf, sizeof(Buf),
+                   "input=%s\nphase=%s\nfunctions_done=%llu\n"
+                   "functions_total=%llu\ninsts=%llu\ninsts_per_second=%.0f\n"
+                   "rss_bytes=%llu\nphase_seconds=%.1f\neta_seconds=%.0f\n",
+                   Input.c_str(), Name ? Name : "other",
+                   (unsigned long long)NumDone,
+                   (unsigned long long)NumFunctions,
+                   (unsigned long long)NumInsts,
+                   InstsPerSecond, (unsigned long long)Resident, Seconds, ETA);
+  if (N <= 0 || size_t(N) >= sizeof(Buf))
+    return;
+  // Readers only ever see a complete status: it is written aside, then
+  // renamed over the previous one.
+  int FD;
+  if (sys::fs::openFileForWrite(TempStatusFile, FD, sys::fs::F_Text))
+    return;
+  raw_fd_ostream OS(FD, /*shouldClose=*/true, /*unbuffered=*/true);
+  OS.write(Buf, N);
+  OS.close();
+  if (OS.has_error()) {
+    OS.clear_error();
+    return;
+  }
+  sys::fs::rename(TempStatusFile, StatusFile);
+}
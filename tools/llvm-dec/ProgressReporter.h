@@ -0,0 +1,111 @@
+//===-- ProgressReporter.h - Progress reports of llvm-dec -------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares the ProgressReporter class, used by llvm-dec to report
+// how far a long decompilation is, from a thread of its own.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_PROGRESSREPORTER_H
+#define LLVM_PROGRESSREPORTER_H
+
+#include "llvm/ADT/StringRef.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace llvm {
+
+/// \brief Get the resident memory of the process, in bytes, or, where it is
+/// unknown, the memory malloc handed out.
+uint64_t getResidentBytes();
+
+/// \brief Report, every few seconds, the progress of the current phase of a
+/// decompilation: functions done out of the total, instructions per second,
+/// resident memory, and the time left in the phase.
+/// The phases count their progress themselves, in atomic counters: see
+/// MCObjectDisassembler::Progress and DCTranslator::Progress.
+///
+/// The reports are printed on stderr, and/or written to a status file, as
+/// "key=value" lines, replaced atomically. Once the reporter is destroyed,
+/// the status file has the phase "finished".
+///
+/// The reporting thread formats the reports on the stack rather than with
+/// malloc, so that the process can still fork worker processes, as
+/// DCTranslator does with -dc-isolate.
+class ProgressReporter {
+public:
+  /// \brief The counters of a phase, see startPhase.
+  struct Counters {
+    const std::atomic<uint64_t> *NumFunctions;
+    const std::atomic<uint64_t> *NumDoneFunctions;
+    const std::atomic<uint64_t> *NumInsts;
+  };
+
+  /// \brief Report the progress of \p Input every \p Interval seconds, on
+  /// stderr if \p ToStderr, and to \p StatusFile unless it is empty.
+  ProgressReporter(StringRef Input, double Interval, bool ToStderr,
+                   StringRef StatusFile);
+  ~ProgressReporter();
+
+  /// \brief Start the phase \p Name, whose progress is in \p P, until
+  /// endPhase. \p P must outlive the phase.
+  template <typename ProgressT>
+  void startPhase(const char *Name, const ProgressT &P) {
+    startPhase(Name, Counters{&P.NumFunctions, &P.NumDoneFunctions,
+                              &P.NumInsts});
+  }
+  void startPhase(const char *Name, Counters C);
+  void endPhase();
+
+private:
+  std::string Input;
+  std::chrono::duration<double> Interval;
+  bool ToStderr;
+  std::string StatusFile;
+  std::string TempStatusFile;
+
+  std::mutex Lock;
+  std::condition_variable Wakeup;
+  bool Stopping;
+  const char *Phase;
+  Counters PhaseCounters;
+  std::chrono::steady_clock::time_point PhaseStart;
+  std::thread Thread;
+
+  void run();
+  /// \brief Print or write the progress, in phase \p Name if not null.
+  void report(const char *Name);
+};
+
+/// \brief Start a phase of \p Reporter, if not null, for the lifetime of the
+/// object: the phase ends before its counters are freed.
+class ProgressPhase {
+  ProgressReporter *Reporter;
+
+public:
+  template <typename ProgressT>
+  ProgressPhase(ProgressReporter *Reporter, const char *Name,
+                const ProgressT &P)
+      : Reporter(Reporter) {
+    if (Reporter)
+      Reporter->startPhase(Name, P);
+  }
+  ~ProgressPhase() {
+    if (Reporter)
+      Reporter->endPhase();
+  }
+};
+
+} // end namespace llvm
+
+#endif
@@ -0,0 +1,454 @@
+//===-- QueryServer.cpp - Answer queries about a binary -------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "QueryServer.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Config/llvm-config.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/Module.h"
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCAnalysis/MCModule.h"
+#include "llvm/Object/ObjectiveCFile.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#if LLVM_ON_UNIX
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#else
+#include <io.h>
+#endif
+
+using namespace llvm;
+
+QueryServer::QueryServer(const MCModule &MCM, const DCCallGraph &CG,
+                         const ObjectiveCFile *ObjC, Module *Bitcode)
+    : CG(CG), ObjC(ObjC), Bitcode(Bitcode), HasSenders(false) {
+  // The reverse of the call graph, in the same layout.
+  CallerBegins.assign(CG.size() + 1, 0);
+  for (uint32_t Callee : CG.Edges)
+    ++CallerBegins[Callee + 1];
+  for (size_t I = 1, E = CallerBegins.size(); I != E; ++I)
+    CallerBegins[I] += CallerBegins[I - 1];
+  Callers.resize(CG.Edges.size());
+  std::vector<uint32_t> Next(CallerBegins.begin(), CallerBegins.end() - 1);
+  for (uint32_t Caller = 0, E = CG.size(); Caller != E; ++Caller)
+    for (uint32_t J = CG.EdgeBegins[Caller]; J != CG.EdgeBegins[Caller + 1];
+         ++J)
+      Callers[Next[CG.Edges[J]]++] = Caller;
+
+  for (uint32_t I = 0, E = CG.size(); I != E; ++I) {
+    StringRef Name = CG.getName(I);
+    if (Name.empty())
+      continue;
+    NodesByName.insert(std::make_pair(Name, I));
+    // "-[Class selector]", or "+[Class selector]".
+    if (Name.size() > 3 && (Name[0] == '-' || Name[0] == '+') &&
+        Name[1] == '[' && Name.back() == ']') {
+      size_t Space = Name.find(' ');
+      if (Space != StringRef::npos)
+        Methods[Name.slice(Space + 1, Name.size() - 1)].push_back(I);
+    }
+  }
+
+  for (const auto &MCFN : MCM.funcs()) {
+    if (MCFN->empty())
+      continue;
+    const uint64_t Entry = MCFN->getEntryBlock()->getStartAddr();
+    for (const MCBasicBlock *BB : *MCFN)
+      Blocks.push_back(std::make_pair(
+          std::make_pair(BB->getStartAddr(), BB->getEndAddr()), Entry));
+  }
+  std::sort(Blocks.begin(), Blocks.end());
+
+  if (ObjC)
+    for (const auto &Ref : ObjC->getSelectorRefs())
+      SelectorRefs[Ref.first] = Ref.second;
+}
+
+// Parse the hex address in S, with or without 0x, into Addr.
+static bool parseAddress(StringRef S, uint64_t &Addr) {
+  if (S.startswith("0x") || S.startswith("0X"))
+    S = S.drop_front(2);
+  return !S.empty() && !S.getAsInteger(16, Addr);
+}
+
+uint32_t QueryServer::findNode(StringRef Function) const {
+  uint64_t Addr;
+  if ((Function.startswith("0x") || Function.startswith("0X")) &&
+      parseAddress(Function, Addr))
+    return CG.find(Addr);
+  auto I = NodesByName.find(Function);
+  if (I != NodesByName.end())
+    return I->second;
+  if (Function.startswith("fn_") && parseAddress(Function.drop_front(3), Addr))
+    return CG.find(Addr);
+  return ~0U;
+}
+
+std::string QueryServer::getNodeName(uint32_t I) const {
+  StringRef Name = CG.getName(I);
+  if (!Name.empty())
+    return Name;
+  return "fn_" + utohexstr(CG.Addrs[I]);
+}
+
+void QueryServer::printNode(uint32_t I, raw_ostream &OS) const {
+  OS << utohexstr(CG.Addrs[I]) << ' ' << getNodeName(I) << '\n';
+}
+
+// Get in Addr the address GV is the global of, from its name, as
+// "cstr_<address>".
+static bool getGlobalAddress(const GlobalVariable *GV, uint64_t &Addr) {
+  std::pair<StringRef, StringRef> KindAddr = GV->getName().rsplit('_');
+  return !KindAddr.second.empty() && parseAddress(KindAddr.second, Addr);
+}
+
+void QueryServer::findRefs(Function &F, std::vector<DataRef> &FRefs) const {
+  SmallVector<Constant *, 16> Worklist;
+  SmallPtrSet<Constant *, 16> Seen;
+  for (BasicBlock &BB : F)
+    for (Instruction &I : BB)
+      for (Value *Op : I.operands())
+        if (Constant *C = dyn_cast<Constant>(Op))
+          if (Seen.insert(C).second)
+            Worklist.push_back(C);
+  while (!Worklist.empty()) {
+    Constant *C = Worklist.pop_back_val();
+    if (GlobalVariable *GV = dyn_cast<GlobalVariable>(C)) {
+      DataRef Ref = {0, GV};
+      if (getGlobalAddress(GV, Ref.Addr))
+        FRefs.push_back(Ref);
+      continue;
+    }
+    if (isa<GlobalValue>(C))
+      continue;
+    // The pointers into a section global are a GEP of it, to the offset of
+    // the address.
+    if (ConstantExpr *CE = dyn_cast<ConstantExpr>(C))
+      if (CE->getOpcode() == Instruction::GetElementPtr &&
+          CE->getNumOperands() == 3)
+        if (GlobalVariable *GV = dyn_cast<GlobalVariable>(CE->getOperand(0)))
+          if (ConstantInt *Offset = dyn_cast<ConstantInt>(CE->getOperand(2))) {
+            DataRef Ref = {0, GV};
+            if (GV->getName().startswith("section_") &&
+                getGlobalAddress(GV, Ref.Addr)) {
+              Ref.Addr += Offset->getZExtValue();
+              FRefs.push_back(Ref);
+              continue;
+            }
+          }
+    for (Value *Op : C->operands())
+      if (Constant *OpC = dyn_cast<Constant>(Op))
+        if (Seen.insert(OpC).second)
+          Worklist.push_back(OpC);
+  }
+  std::sort(FRefs.begin(), FRefs.end(),
+            [](const DataRef &L, const DataRef &R) { return L.Addr < R.Addr; });
+  FRefs.erase(std::unique(FRefs.begin(), FRefs.end(),
+                          [](const DataRef &L, const DataRef &R) {
+                            return L.Addr == R.Addr && L.GV == R.GV;
+                          }),
+              FRefs.end());
+}
+
+const std::vector<QueryServer::DataRef> *
+QueryServer::getRefs(uint32_t I, std::string &Error) {
+  auto It = Refs.find(I);
+  if (It != Refs.end())
+    return &It->second;
+  if (!Bitcode) {
+    Error = "no bitcode, see -serve-bitcode";
+    return nullptr;
+  }
+  const std::string Name = getNodeName(I);
+  Function *F = Bitcode->getFunction(Name);
+  if (!F) {
+    Error = "'" + Name + "' isn't in the bitcode";
+    return nullptr;
+  }
+  if (std::error_code EC = F->materialize()) {
+    Error = Name + ": " + EC.message();
+    return nullptr;
+  }
+  std::vector<DataRef> &FRefs = Refs[I];
+  findRefs(*F, FRefs);
+  return &FRefs;
+}
+
+bool QueryServer::findSenders(std::string &Error) {
+  if (HasSenders)
+    return true;
+  if (!Bitcode) {
+    Error = "no bitcode, see -serve-bitcode";
+    return false;
+  }
+  if (!ObjC) {
+    Error = "no Objective-C metadata";
+    return false;
+  }
+  // Each function is read in turn, and released again unless a query read
+  // it before: only what it refers to is kept.
+  for (Function &F : *Bitcode) {
+    const uint32_t I = findNode(F.getName());
+    if (I == ~0U || (F.isDeclaration() && !F.isMaterializable()))
+      continue;
+    auto It = Refs.find(I);
+    if (It == Refs.end()) {
+      const bool WasMaterializable = F.isMaterializable();
+      if (std::error_code EC = F.materialize()) {
+        Error = F.getName().str() + ": " + EC.message();
+        return false;
+      }
+      It = Refs.insert(std::make_pair(I, std::vector<DataRef>())).first;
+      findRefs(F, It->second);
+      if (WasMaterializable)
+        F.dematerialize();
+    }
+    for (const DataRef &Ref : It->second) {
+      if (!Ref.GV->getName().startswith("selref_"))
+        continue;
+      auto SI = SelectorRefs.find(Ref.Addr);
+      if (SI != SelectorRefs.end())
+        Senders[SI->second].push_back(I);
+    }
+  }
+  for (auto &Sender : Senders) {
+    std::vector<uint32_t> &Nodes = Sender.second;
+    std::sort(Nodes.begin(), Nodes.end());
+    Nodes.erase(std::unique(Nodes.begin(), Nodes.end()), Nodes.end());
+  }
+  HasSenders = true;
+  return true;
+}
+
+// The string the initializer of the cstr_ global GV has.
+static bool getCString(const GlobalVariable *GV, StringRef &Str) {
+  if (!GV || !GV->hasInitializer() || !GV->getName().startswith("cstr_"))
+    return false;
+  const ConstantDataSequential *CDS =
+      dyn_cast<ConstantDataSequential>(GV->getInitializer());
+  if (!CDS || !CDS->isString())
+    return false;
+  Str = CDS->isCString() ? CDS->getAsCString() : CDS->getAsString();
+  return true;
+}
+
+bool QueryServer::printString(const DataRef &Ref, raw_ostream &OS) const {
+  StringRef Name = Ref.GV->getName(), Kind = "cstring", Str;
+  bool Found = false;
+  if (Name.startswith("cstr_")) {
+    Found = getCString(Ref.GV, Str);
+  } else if (Name.startswith("cfstring_")) {
+    // The characters of a CFString are a C string global.
+    Kind = "cfstring";
+    if (Ref.GV->hasInitializer() &&
+        Ref.GV->getInitializer()->getNumOperands() > 2)
+      Found = getCString(
+          dyn_cast<GlobalVariable>(
+              Ref.GV->getInitializer()->getOperand(2)->stripPointerCasts()),
+          Str);
+  } else if (Name.startswith("section_") && ObjC &&
+             ObjC->getCStrings().contains(Ref.Addr)) {
+    Str = ObjC->getCStrings().getString(Ref.Addr);
+    Found = true;
+  }
+  if (!Found)
+    return false;
+  OS << utohexstr(Ref.Addr) << ' ' << Kind << " \"";
+  OS.write_escaped(Str) << "\"\n";
+  return true;
+}
+
+bool QueryServer::answer(StringRef Query, raw_ostream &OS) {
+  std::pair<StringRef, StringRef> CmdArg = Query.trim().split(' ');
+  const StringRef Cmd = CmdArg.first, Arg = CmdArg.second.trim();
+  if (Cmd == "quit")
+    return false;
+  if (Cmd.empty() || Cmd.startswith("#"))
+    return true;
+
+  std::string Error;
+  if (Cmd == "callers" || Cmd == "callees" || Cmd == "strings") {
+    const uint32_t I = findNode(Arg);
+    if (I == ~0U) {
+      OS << "error: no function '" << Arg << "'\n";
+      return true;
+    }
+    if (Cmd == "callers") {
+      for (uint32_t J = CallerBegins[I]; J != CallerBegins[I + 1]; ++J)
+        printNode(Callers[J], OS);
+    } else if (Cmd == "callees") {
+      for (uint32_t J = CG.EdgeBegins[I]; J != CG.EdgeBegins[I + 1]; ++J)
+        printNode(CG.Edges[J], OS);
+    } else if (const std::vector<DataRef> *FRefs = getRefs(I, Error)) {
+      for (const DataRef &Ref : *FRefs)
+        printString(Ref, OS);
+    } else {
+      OS << "error: " << Error << '\n';
+    }
+    return true;
+  }
+
+  if (Cmd == "function") {
+    uint64_t Addr;
+    if (!parseAddress(Arg, Addr)) {
+      OS << "error: invalid address '" << Arg << "'\n";
+      return true;
+    }
+    // The block starting last at or before the address.
+    auto It = std::upper_bound(
+        Blocks.begin(), Blocks.end(),
+        std::make_pair(std::make_pair(Addr, UINT64_MAX), UINT64_MAX));
+    if (It == Blocks.begin() || Addr >= std::prev(It)->first.second) {
+      OS << "error: no function at " << utohexstr(Addr) << '\n';
+      return true;
+    }
+    const uint32_t I = CG.find(std::prev(It)->second);
+    if (I != ~0U)
+      printNode(I, OS);
+    return true;
+  }
+
+  if (Cmd == "methods") {
+    auto It = Methods.find(Arg);
+    if (It != Methods.end())
+      for (uint32_t I : It->second)
+        printNode(I, OS);
+    return true;
+  }
+
+  if (Cmd == "selector") {
+    if (!findSenders(Error)) {
+      OS << "error: " << Error << '\n';
+      return true;
+    }
+    auto It = Senders.find(Arg);
+    if (It != Senders.end())
+      for (uint32_t I : It->second)
+        printNode(I, OS);
+    return true;
+  }
+
+  OS << "error: unknown query '" << Cmd << "'\n";
+  return true;
+}
+
+// Write all of Data to FD, or return false.
+static bool writeAll(int FD, StringRef Data) {
+  while (!Data.empty()) {
+    const int Written = ::write(FD, Data.data(), Data.size());
+    if (Written < 0) {
+      if (errno == EINTR)
+        continue;
+      return false;
+    }
+    Data = Data.drop_front(Written);
+  }
+  return true;
+}
+
+bool QueryServer::serve(int InFD, int OutFD) {
+  std::string Buffer;
+  char Chunk[4096];
+  for (;;) {
+    // Answer the complete lines read so far, then read more.
+    size_t Begin = 0, End;
+    while ((End = Buffer.find('\n', Begin)) != std::string::npos) {
+      std::string Answer;
+      raw_string_ostream OS(Answer);
+      const bool More =
+          answer(StringRef(Buffer).slice(Begin, End).rtrim("\r"), OS);
+      if (!More)
+        return true;
+      OS << '\n';
+      if (!writeAll(OutFD, OS.str()))
+        return false;
+      Begin = End + 1;
+    }
+    Buffer.erase(0, Begin);
+    const int Read = ::read(InFD, Chunk, sizeof(Chunk));
+    if (Read < 0 && errno == EINTR)
+      continue;
+    if (Read <= 0)
+      break;
+    Buffer.append(Chunk, Read);
+  }
+  // A last query without a newline.
+  if (!Buffer.empty()) {
+    std::string Answer;
+    raw_string_ostream OS(Answer);
+    if (answer(Buffer, OS)) {
+      OS << '\n';
+      return writeAll(OutFD, OS.str());
+    }
+  }
+  return true;
+}
+
+bool QueryServer::listen(StringRef Path, raw_ostream &Log) {
+#if LLVM_ON_UNIX
+  sockaddr_un Addr;
+  if (Path.size() >= sizeof(Addr.sun_path)) {
+    Log << Path << ": socket path too long\n";
+    return false;
+  }
+  memset(&Addr, 0, sizeof(Addr));
+  Addr.sun_family = AF_UNIX;
+  memcpy(Addr.sun_path, Path.data(), Path.size());
+
+  const int FD = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (FD < 0) {
+    Log << Path << ": " << strerror(errno) << '\n';
+    return false;
+  }
+  // A socket left by an earlier server is replaced, but nothing else is.
+  struct stat Status;
+  if (::lstat(Addr.sun_path, &Status) == 0) {
+    if (!S_ISSOCK(Status.st_mode)) {
+      Log << Path << ": exists and is not a socket\n";
+      ::close(FD);
+      return false;
+    }
+    ::unlink(Addr.sun_path);
+  }
+  if (::bind(FD, reinterpret_cast<sockaddr *>(&Addr), sizeof(Addr)) < 0 ||
+      ::listen(FD, 16) < 0) {
+    Log << Path << ": " << strerror(errno) << '\n';
+    ::close(FD);
+    return false;
+  }
+  // A client that goes away mid-answer only ends its connection.
+  signal(SIGPIPE, SIG_IGN);
+  Log << "Serving queries on " << Path << '\n';
+  Log.flush();
+  for (;;) {
+    const int Conn = ::accept(FD, nullptr, nullptr);
+    if (Conn < 0) {
+      if (errno == EINTR)
+        continue;
+      Log << Path << ": " << strerror(errno) << '\n';
+      ::close(FD);
+      return false;
+    }
+    serve(Conn, Conn);
+    ::close(Conn);
+  }
+#else
+  Log << Path << ": Unix sockets aren't supported on this host\n";
+  return false;
+#endif
+}
@@ -0,0 +1,113 @@
+//===-- QueryServer.h - Answer queries about a binary -----------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares the QueryServer class, used by llvm-dec -serve to answer
+// queries about a binary from what it keeps loaded: the MC CFG, the call
+// graph and the Objective-C metadata of the binary, and the bitcode an
+// earlier -bc run wrote, read lazily.
+//
+// The protocol is text, one query per line. Each answer is a line per result,
+// then an empty line:
+//   callers <function>    the functions calling <function>
+//   callees <function>    the functions <function> calls
+//   function <address>    the function whose code has <address>
+//   strings <function>    the C strings and CFStrings <function> refers to
+//   selector <selector>   the functions sending <selector>
+//   methods <selector>    the methods implementing <selector>
+//   quit                  close the connection
+// The lines starting with '#' are comments, answered by an empty line.
+// A function is a name or a hex address, and is answered as
+// "<hex address> <name>". A string is answered as
+// "<hex address> cstring|cfstring "<string>"", escaped as in C. A query that
+// fails is answered "error: <why>". The strings and selector queries need the
+// bitcode: the functions are only read from it once a query is about them,
+// and all are the first time a selector is.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_QUERYSERVER_H
+#define LLVM_QUERYSERVER_H
+
+#include "CallGraphFile.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include <string>
+#include <vector>
+
+namespace llvm {
+
+class Function;
+class GlobalVariable;
+class MCModule;
+class Module;
+class ObjectiveCFile;
+class raw_ostream;
+
+class QueryServer {
+public:
+  /// \brief Answer the queries about \p MCM, whose call graph is \p CG, with
+  /// the metadata of \p ObjC and the functions of \p Bitcode, if not null.
+  /// They must all outlive the server.
+  QueryServer(const MCModule &MCM, const DCCallGraph &CG,
+              const ObjectiveCFile *ObjC, Module *Bitcode);
+
+  /// \brief Answer \p Query to \p OS. Return false if it is quit.
+  bool answer(StringRef Query, raw_ostream &OS);
+
+  /// \brief Answer the queries read from \p InFD to \p OutFD, until quit, or
+  /// the end of the input. Return false if \p OutFD can't be written.
+  bool serve(int InFD, int OutFD);
+
+  /// \brief Answer the connections to the Unix socket at \p Path, one at a
+  /// time, until killed. Return false, after logging why in \p Log, if the
+  /// socket can't be created.
+  bool listen(StringRef Path, raw_ostream &Log);
+
+private:
+  /// \brief A global a function refers to, and the address it refers to: the
+  /// entry of the global, or where in a section global.
+  struct DataRef {
+    uint64_t Addr;
+    GlobalVariable *GV;
+  };
+
+  const DCCallGraph &CG;
+  const ObjectiveCFile *ObjC;
+  Module *Bitcode;
+  /// \brief The callers of each node, as CG has the callees.
+  std::vector<uint32_t> CallerBegins;
+  std::vector<uint32_t> Callers;
+  StringMap<uint32_t> NodesByName;
+  /// \brief The blocks, as (start, end, function) by start.
+  std::vector<std::pair<std::pair<uint64_t, uint64_t>, uint64_t>> Blocks;
+  /// \brief The "+[Class selector]" and "-[Class selector]" methods, by
+  /// selector.
+  StringMap<std::vector<uint32_t>> Methods;
+  /// \brief The selectors the selector references point to, by address.
+  DenseMap<uint64_t, StringRef> SelectorRefs;
+  /// \brief The globals each function read so far refers to.
+  DenseMap<uint32_t, std::vector<DataRef>> Refs;
+  /// \brief The functions sending each selector, found the first time one is
+  /// asked for.
+  StringMap<std::vector<uint32_t>> Senders;
+  bool HasSenders;
+
+  uint32_t findNode(StringRef Function) const;
+  std::string getNodeName(uint32_t I) const;
+  void printNode(uint32_t I, raw_ostream &OS) const;
+  const std::vector<DataRef> *getRefs(uint32_t I, std::string &Error);
+  void findRefs(Function &F, std::vector<DataRef> &FRefs) const;
+  bool findSenders(std::string &Error);
+  bool printString(const DataRef &Ref, raw_ostream &OS) const;
+};
+
+} // end namespace llvm
+
+#endif
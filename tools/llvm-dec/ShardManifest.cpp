@@ -0,0 +1,139 @@
+//===-- ShardManifest.cpp - Describe the output of a shard ----------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "ShardManifest.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/ToolOutputFile.h"
+
+using namespace llvm;
+
+bool ShardManifest::parseShard(StringRef Spec) {
+  std::pair<StringRef, StringRef> IN = Spec.split('/');
+  return !IN.first.trim().getAsInteger(10, Shard) &&
+         !IN.second.trim().getAsInteger(10, NumShards) && Shard < NumShards;
+}
+
+bool ShardManifest::write(StringRef Filename, raw_ostream &Log) const {
+  std::error_code EC;
+  tool_output_file Out(Filename, EC, sys::fs::F_Text);
+  if (EC) {
+    Log << Filename << ": " << EC.message() << '\n';
+    return false;
+  }
+  raw_ostream &OS = Out.os();
+  OS << "shard " << Shard << '/' << NumShards << ' ' << utohexstr(Begin) << ' '
+     << utohexstr(End) << '\n';
+  for (const std::string &M : Modules)
+    OS << "module " << M << '\n';
+  for (const auto &AddrName : Defined)
+    OS << "D " << utohexstr(AddrName.first) << ' ' << AddrName.second << '\n';
+  for (const auto &AddrName : Declared)
+    OS << "U " << utohexstr(AddrName.first) << ' ' << AddrName.second << '\n';
+  Out.keep();
+  return true;
+}
+
+bool ShardManifest::read(StringRef Filename, raw_ostream &Log) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> BufOrErr =
+      MemoryBuffer::getFile(Filename);
+  if (std::error_code EC = BufOrErr.getError()) {
+    Log << Filename << ": " << EC.message() << '\n';
+    return false;
+  }
+  const StringRef Dir = sys::path::parent_path(Filename);
+  SmallVector<StringRef, 64> Lines;
+  (*BufOrErr)->getBuffer().split(Lines, "\n", -1, /*KeepEmpty=*/false);
+  bool HasShard = false;
+  for (size_t I = 0, E = Lines.size(); I != E; ++I) {
+    std::pair<StringRef, StringRef> KindRest = Lines[I].split(' ');
+    StringRef Kind = KindRest.first, Rest = KindRest.second;
+    bool Valid = true;
+    if (Kind == "shard") {
+      SmallVector<StringRef, 3> Fields;
+      Rest.split(Fields, " ");
+      Valid = Fields.size() == 3 && parseShard(Fields[0]) &&
+              !Fields[1].getAsInteger(16, Begin) &&
+              !Fields[2].getAsInteger(16, End);
+      HasShard = true;
+    } else if (Kind == "module") {
+      SmallString<128> Path(Dir);
+      sys::path::append(Path, Rest);
+      Modules.push_back(Path.str());
+    } else if (Kind == "D" || Kind == "U") {
+      std::pair<StringRef, StringRef> AddrName = Rest.split(' ');
+      uint64_t Addr;
+      Valid = !AddrName.first.getAsInteger(16, Addr);
+      (Kind == "D" ? Defined : Declared)[Addr] = AddrName.second;
+    } else {
+      Valid = false;
+    }
+    if (!Valid) {
+      Log << Filename << ':' << (I + 1) << ": invalid manifest entry\n";
+      return false;
+    }
+  }
+  if (!HasShard) {
+    Log << Filename << ": not a shard manifest\n";
+    return false;
+  }
+  return true;
+}
+
+bool llvm::mergeShardManifests(ArrayRef<ShardManifest> Shards,
+                               ShardManifest &Merged, raw_ostream &Log) {
+  if (Shards.empty())
+    return false;
+  // The shards must partition the address space, so that each function is
+  // defined once.
+  const unsigned NumShards = Shards[0].NumShards;
+  std::vector<const ShardManifest *> ByIndex(NumShards);
+  for (const ShardManifest &S : Shards) {
+    if (S.NumShards != NumShards) {
+      Log << "shard " << S.Shard << '/' << S.NumShards << " isn't one of "
+          << NumShards << '\n';
+      return false;
+    }
+    if (ByIndex[S.Shard]) {
+      Log << "shard " << S.Shard << '/' << NumShards << " is listed twice\n";
+      return false;
+    }
+    ByIndex[S.Shard] = &S;
+  }
+  uint64_t Begin = 0;
+  for (unsigned I = 0; I != NumShards; ++I) {
+    if (!ByIndex[I]) {
+      Log << "shard " << I << '/' << NumShards << " is missing\n";
+      return false;
+    }
+    if (ByIndex[I]->Begin != Begin) {
+      Log << "shard " << I << '/' << NumShards
+          << " doesn't follow the previous one: was it run on another "
+             "input?\n";
+      return false;
+    }
+    Begin = ByIndex[I]->End;
+  }
+
+  Merged = ShardManifest();
+  for (const ShardManifest *S : ByIndex) {
+    Merged.Modules.insert(Merged.Modules.end(), S->Modules.begin(),
+                          S->Modules.end());
+    Merged.Defined.insert(S->Defined.begin(), S->Defined.end());
+  }
+  for (const ShardManifest *S : ByIndex)
+    for (const auto &AddrName : S->Declared)
+      if (!Merged.Defined.count(AddrName.first))
+        Merged.Declared.insert(AddrName);
+  return true;
+}
@@ -0,0 +1,70 @@
+//===-- ShardManifest.h - Describe the output of a shard --------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares the ShardManifest struct, used by llvm-dec to describe
+// what a -shard run wrote, and by -merge-shards to put the shards together.
+//
+// The file is text, one entry per line:
+//   shard <i>/<n> <hex begin> <hex end>
+//   module <module file>
+//   D <hex address> <function name>
+//   U <hex address> <function name>
+// The range is that of the function starts of the shard. The modules are
+// relative to the directory of the manifest. "D" lists the functions the
+// modules define, and "U" those they only declare, which another shard
+// defines, or nobody does.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_SHARDMANIFEST_H
+#define LLVM_SHARDMANIFEST_H
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/DataTypes.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace llvm {
+
+class raw_ostream;
+
+struct ShardManifest {
+  unsigned Shard;
+  unsigned NumShards;
+  uint64_t Begin;
+  uint64_t End;
+  std::vector<std::string> Modules;
+  std::map<uint64_t, std::string> Defined;
+  std::map<uint64_t, std::string> Declared;
+
+  ShardManifest() : Shard(0), NumShards(1), Begin(0), End(UINT64_MAX) {}
+
+  /// \brief Parse "<i>/<n>" into Shard and NumShards, or return false.
+  bool parseShard(StringRef Spec);
+
+  /// \brief Write the manifest to \p Filename, and log why in \p Log if it
+  /// fails.
+  bool write(StringRef Filename, raw_ostream &Log) const;
+
+  /// \brief Read the manifest at \p Filename, with its modules relative to
+  /// the current directory, or return false after logging why in \p Log.
+  bool read(StringRef Filename, raw_ostream &Log);
+};
+
+/// \brief Merge the manifests of all the shards of an input into \p Merged,
+/// a single shard with the modules and functions of all. Return false, after
+/// logging why in \p Log, if a shard is missing, or if they don't agree.
+bool mergeShardManifests(ArrayRef<ShardManifest> Shards,
+                         ShardManifest &Merged, raw_ostream &Log);
+
+} // end namespace llvm
+
+#endif
@@ -0,0 +1,113 @@
+//===-- ShardPipe.cpp - Send the streamed modules downstream --------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "ShardPipe.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/Config/llvm-config.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+#include <cerrno>
+#include <cstring>
+#if LLVM_ON_UNIX
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#else
+#include <io.h>
+#endif
+
+using namespace llvm;
+
+ShardPipe::~ShardPipe() {
+  if (ShouldClose)
+    ::close(FD);
+}
+
+// Connect to the Unix socket at Path, or return -1 with errno set.
+static int connectSocket(StringRef Path) {
+#if LLVM_ON_UNIX
+  sockaddr_un Addr;
+  if (Path.size() >= sizeof(Addr.sun_path)) {
+    errno = ENAMETOOLONG;
+    return -1;
+  }
+  memset(&Addr, 0, sizeof(Addr));
+  Addr.sun_family = AF_UNIX;
+  memcpy(Addr.sun_path, Path.data(), Path.size());
+  const int FD = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (FD < 0)
+    return -1;
+  if (::connect(FD, reinterpret_cast<sockaddr *>(&Addr), sizeof(Addr)) < 0) {
+    const int Err = errno;
+    ::close(FD);
+    errno = Err;
+    return -1;
+  }
+  return FD;
+#else
+  errno = ENOSYS;
+  return -1;
+#endif
+}
+
+bool ShardPipe::open(StringRef P, raw_ostream &Log) {
+  Path = P;
+  if (Path == "-") {
+    FD = 1;
+    ShouldClose = false;
+  } else {
+    sys::fs::file_status Status;
+    if (!sys::fs::status(Path, Status) &&
+        Status.type() == sys::fs::file_type::socket_file) {
+      FD = connectSocket(Path);
+      if (FD < 0) {
+        Log << Path << ": " << strerror(errno) << '\n';
+        return false;
+      }
+    } else if (std::error_code EC =
+                   sys::fs::openFileForWrite(Path, FD, sys::fs::F_None)) {
+      Log << Path << ": " << EC.message() << '\n';
+      return false;
+    }
+    ShouldClose = true;
+  }
+#if LLVM_ON_UNIX
+  // A consumer that goes away fails the send, instead of killing llvm-dec.
+  signal(SIGPIPE, SIG_IGN);
+#endif
+  return true;
+}
+
+static bool writeAll(int FD, StringRef Data) {
+  while (!Data.empty()) {
+    const int Written = ::write(FD, Data.data(), Data.size());
+    if (Written < 0) {
+      if (errno == EINTR)
+        continue;
+      return false;
+    }
+    Data = Data.drop_front(Written);
+  }
+  return true;
+}
+
+bool ShardPipe::send(unsigned Index, uint64_t First, uint64_t Last,
+                     unsigned NumFunctions, StringRef Data, raw_ostream &Log) {
+  const std::string Header =
+      ("shard " + Twine(Index) + " " + utohexstr(First) + " " +
+       utohexstr(Last) + " " + Twine(NumFunctions) + " " + Twine(Data.size()) +
+       "\n").str();
+  if (!writeAll(FD, Header) || !writeAll(FD, Data)) {
+    Log << Path << ": " << strerror(errno) << '\n';
+    return false;
+  }
+  return true;
+}
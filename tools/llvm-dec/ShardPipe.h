@@ -0,0 +1,60 @@
+//===-- ShardPipe.h - Send the streamed modules downstream ------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares the ShardPipe class, used by llvm-dec -stream-to to send
+// each module a -stream-* run writes to a consumer, as soon as it is written,
+// instead of leaving it on disk for after the run.
+//
+// The modules are sent in order on a single stream, each as a header line,
+// then the module itself:
+//   shard <i> <hex first> <hex last> <functions> <bytes>
+// <i> counts the modules from 0. <first> and <last> are the addresses of the
+// first and last functions the module defines, and <functions> their number
+// (0 0 0 for a module without any). <bytes> is the size of the bitcode or
+// text module that follows, so that a consumer can read it without parsing
+// it. The stream ends when llvm-dec does.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_SHARDPIPE_H
+#define LLVM_SHARDPIPE_H
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/DataTypes.h"
+#include <string>
+
+namespace llvm {
+
+class raw_ostream;
+
+class ShardPipe {
+public:
+  ShardPipe() : FD(-1), ShouldClose(false) {}
+  ~ShardPipe();
+
+  /// \brief Open \p Path: stdout with '-', a connection if it is a Unix
+  /// socket, and the file otherwise, as a FIFO, which waits for its reader.
+  /// Return false, after logging why in \p Log, if it can't be.
+  bool open(StringRef Path, raw_ostream &Log);
+
+  /// \brief Send the module \p Data, numbered \p Index, which defines
+  /// \p NumFunctions functions, from \p First to \p Last. Return false, after
+  /// logging why in \p Log, if the consumer went away.
+  bool send(unsigned Index, uint64_t First, uint64_t Last,
+            unsigned NumFunctions, StringRef Data, raw_ostream &Log);
+
+private:
+  std::string Path;
+  int FD;
+  bool ShouldClose;
+};
+
+} // end namespace llvm
+
+#endif
@@ -0,0 +1,67 @@
+//===-- StringsFile.cpp - Write the strings of a Mach-O file --------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "StringsFile.h"
+#include "llvm/Object/ObjectiveCFile.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/ToolOutputFile.h"
+#include <algorithm>
+
+using namespace llvm;
+using namespace object;
+
+void llvm::printStrings(raw_ostream &OS, const ObjectiveCFile &ObjC,
+                        StringRef Prefix, size_t &NumStrings,
+                        size_t &NumXRefs) {
+  // The xrefs are sorted by string address, as the strings are: the xrefs of
+  // each string follow those of the previous one.
+  typedef std::pair<uint64_t, uint64_t> XRef;
+  const std::vector<XRef> &XRefs = ObjC.getStringXRefs();
+  auto PrintSection = [&](StringRef Name, const MachOStringSection &Strings) {
+    auto XI = std::lower_bound(
+        XRefs.begin(), XRefs.end(), Strings.getAddress(),
+        [](const XRef &X, uint64_t Addr) { return X.second < Addr; });
+    for (size_t I = 0, E = Strings.size(); I != E; ++I) {
+      const MachOStringSection::Entry S = Strings[I];
+      const uint64_t End = S.Address + S.String.size();
+      // Skip the pointers to the terminator of the previous string.
+      while (XI != XRefs.end() && XI->second < S.Address)
+        ++XI;
+      OS << Prefix << format("0x%" PRIx64, S.Address) << ' ' << Name << " \"";
+      OS.write_escaped(S.String) << '"';
+      for (; XI != XRefs.end() && XI->second < End; ++XI, ++NumXRefs) {
+        OS << format(" 0x%" PRIx64, XI->first);
+        if (XI->second != S.Address)
+          OS << '+' << XI->second - S.Address;
+      }
+      OS << '\n';
+    }
+    NumStrings += Strings.size();
+  };
+  PrintSection("__cstring", ObjC.getCStrings());
+  PrintSection("__objc_methname", ObjC.getMethodNameStrings());
+  PrintSection("__objc_classname", ObjC.getClassNameStrings());
+}
+
+bool llvm::writeStringsFile(StringRef Filename, const ObjectiveCFile &ObjC,
+                            raw_ostream &Log) {
+  std::error_code EC;
+  tool_output_file Out(Filename, EC, sys::fs::F_Text);
+  if (EC) {
+    Log << Filename << ": " << EC.message() << '\n';
+    return false;
+  }
+  size_t NumStrings = 0, NumXRefs = 0;
+  printStrings(Out.os(), ObjC, "", NumStrings, NumXRefs);
+  Out.keep();
+
+  Log << "Strings: " << NumStrings << " strings, " << NumXRefs << " xrefs\n";
+  return true;
+}
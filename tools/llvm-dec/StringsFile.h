@@ -0,0 +1,47 @@
+//===-- StringsFile.h - Write the strings of a Mach-O file ------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares writeStringsFile, used by llvm-dec to list the strings of
+// the __cstring, __objc_methname and __objc_classname sections of a Mach-O
+// file, with the metadata that points to them.
+//
+// The file is text, one line per non-empty string, by section then address:
+//   <address> <section> "<string>" <xref>*
+// The string is escaped as in C. Each xref is the address of a pointer to the
+// string: a selector reference, a class or method name, or the characters of
+// a CFString. A pointer into the middle of a string, which the linker shares
+// with its suffix, is written "<pointer>+<offset>".
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_STRINGSFILE_H
+#define LLVM_STRINGSFILE_H
+
+#include "llvm/ADT/StringRef.h"
+#include <cstddef>
+
+namespace llvm {
+
+class ObjectiveCFile;
+class raw_ostream;
+
+/// \brief Write the strings of \p ObjC, and their xrefs, to \p Filename, and
+/// sum them up in \p Log.
+bool writeStringsFile(StringRef Filename, const ObjectiveCFile &ObjC,
+                      raw_ostream &Log);
+
+/// \brief Print the lines of writeStringsFile to \p OS, each after
+/// \p Prefix, and add the number of strings and xrefs printed to
+/// \p NumStrings and \p NumXRefs.
+void printStrings(raw_ostream &OS, const ObjectiveCFile &ObjC,
+                  StringRef Prefix, size_t &NumStrings, size_t &NumXRefs);
+
+} // end namespace llvm
+
+#endif
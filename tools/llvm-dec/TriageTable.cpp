@@ -0,0 +1,86 @@
+//===-- TriageTable.cpp - Write the llvm-dec -mc-only tables --------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "TriageTable.h"
+#include "CallGraphFile.h"
+#include "KnownFunctions.h"
+#include "StringsFile.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCAnalysis/MCModule.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/ToolOutputFile.h"
+#include <algorithm>
+#include <vector>
+
+using namespace llvm;
+
+bool llvm::writeTriageTable(StringRef Filename, const MCModule &MCM,
+                            const MCInstrAnalysis &MIA, const DCCallGraph &CG,
+                            const DCStubTargets &Stubs,
+                            const ObjectiveCFile *ObjC, raw_ostream &Log) {
+  std::error_code EC;
+  tool_output_file Out(Filename, EC, sys::fs::F_Text);
+  if (EC) {
+    Log << Filename << ": " << EC.message() << '\n';
+    return false;
+  }
+  raw_ostream &OS = Out.os();
+
+  // The functions are in the call graph, with the stubs they call: their
+  // names are taken from it.
+  size_t NumFunctions = 0;
+  for (const auto &MCFN : MCM.funcs()) {
+    if (MCFN->empty())
+      continue;
+    const uint64_t Addr = MCFN->getEntryBlock()->getStartAddr();
+    size_t NumInsts = 0;
+    for (const MCBasicBlock *BB : *MCFN)
+      NumInsts += BB->size();
+    StringRef Name = CG.getName(CG.find(Addr));
+    if (Name.empty())
+      Name = MCFN->getName();
+    OS << format("func 0x%" PRIx64, Addr) << ' ' << MCFN->size() << ' '
+       << NumInsts << ' '
+       << format_hex_no_prefix(computeFunctionFingerprint(*MCFN, MIA, Stubs),
+                               16)
+       << ' ';
+    if (Name.empty())
+      OS << "fn_" << utohexstr(Addr);
+    else
+      OS << Name;
+    OS << '\n';
+    ++NumFunctions;
+  }
+
+  std::vector<std::pair<uint64_t, StringRef>> Imports;
+  for (const auto &AddrName : Stubs.ExternalNames)
+    Imports.push_back(std::make_pair(AddrName.first, AddrName.second));
+  std::sort(Imports.begin(), Imports.end());
+  for (const auto &Import : Imports)
+    OS << format("stub 0x%" PRIx64, Import.first) << ' ' << Import.second
+       << '\n';
+
+  for (size_t I = 0, E = CG.size(); I != E; ++I)
+    for (uint32_t EI = CG.EdgeBegins[I], EE = CG.EdgeBegins[I + 1]; EI != EE;
+         ++EI)
+      OS << format("call 0x%" PRIx64, CG.Addrs[I])
+         << format(" 0x%" PRIx64, CG.Addrs[CG.Edges[EI]]) << '\n';
+
+  size_t NumStrings = 0, NumXRefs = 0;
+  if (ObjC)
+    printStrings(OS, *ObjC, "string ", NumStrings, NumXRefs);
+  Out.keep();
+
+  Log << "Triage: " << NumFunctions << " functions, " << Imports.size()
+      << " stubs, " << CG.Edges.size() << " calls, " << NumStrings
+      << " strings (" << NumXRefs << " xrefs)\n";
+  return true;
+}
@@ -0,0 +1,51 @@
+//===-- TriageTable.h - Write the llvm-dec -mc-only tables ------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares writeTriageTable, used by llvm-dec -mc-only to describe
+// an input from its MC CFG alone, without translating it, to decide quickly
+// whether it is worth decompiling.
+//
+// The file is text, one record per line, by kind then address:
+//   func <address> <blocks> <instructions> <fingerprint> <name>
+//   stub <address> <name>
+//   call <caller> <callee>
+//   string <address> <section> "<string>" <xref>*
+// The fingerprints are those of KnownFunctions.h, in 16 hex digits, for
+// -diff-against to match the functions of the next version of the binary.
+// The functions are named after the metadata, or their symbol, and
+// "fn_<address>" without either, as in the translation.
+// The stubs are those of the external functions. The calls are the direct
+// calls of the functions, with the calls through stubs to local functions
+// going to the functions. The strings are as in StringsFile.h, and only
+// listed for Mach-O files.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_TRIAGETABLE_H
+#define LLVM_TRIAGETABLE_H
+
+#include "llvm/ADT/StringRef.h"
+
+namespace llvm {
+
+class MCInstrAnalysis;
+class MCModule;
+class ObjectiveCFile;
+class raw_ostream;
+struct DCCallGraph;
+struct DCStubTargets;
+
+bool writeTriageTable(StringRef Filename, const MCModule &MCM,
+                      const MCInstrAnalysis &MIA, const DCCallGraph &CG,
+                      const DCStubTargets &Stubs, const ObjectiveCFile *ObjC,
+                      raw_ostream &Log);
+
+} // end namespace llvm
+
+#endif
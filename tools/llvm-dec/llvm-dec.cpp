@@ -1,14 +1,25 @@
 #define DEBUG_TYPE "llvm-dec"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/StringExtras.h"
 #include <unistd.h>
 #include "llvm/ADT/Triple.h"
+#include "llvm/Analysis/InstCount.h"
+#include "llvm/DC/DCAddressTable.h"
+#include "llvm/DC/DCCallSummaries.h"
+#include "llvm/DC/DCDecompilerSession.h"
 #include "llvm/DC/DCInstrSema.h"
+#include "llvm/DC/DCMachOObject.h"
+#include "llvm/DC/DCObjCMessageTable.h"
 #include "llvm/DC/DCRegisterSema.h"
+#include "llvm/DC/DCTranslationCache.h"
 #include "llvm/DC/DCTranslator.h"
 #include "llvm/MC/MCAsmInfo.h"
 #include "llvm/MC/MCAnalysis/MCCachingDisassembler.h"
 #include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCAnalysis/MCFunctionRangeMap.h"
 #include "llvm/MC/MCAnalysis/MCModule.h"
+#include "llvm/MC/MCAnalysis/MCModuleBinary.h"
 #include "llvm/MC/MCAnalysis/MCObjectSymbolizer.h"
 #include "llvm/MC/MCContext.h"
 #include "llvm/MC/MCDisassembler.h"
@@ -22,33 +33,116 @@
 #include "llvm/MC/MCRegisterInfo.h"
 #include "llvm/MC/MCSubtargetInfo.h"
 #include "llvm/MC/MCOptimization.h"
+#include "llvm/Object/DyldSharedCache.h"
+#include "llvm/Object/MachOBindingIndex.h"
+#include "llvm/Object/MachOUniversal.h"
 #include "llvm/Object/ObjectFile.h"
+#include "llvm/Object/ObjectiveCFile.h"
+#include "llvm/Object/SwiftMetadataIndex.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/MD5.h"
 #include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
 #include "llvm/Support/PrettyStackTrace.h"
+#include "llvm/Support/Regex.h"
 #include "llvm/Support/Signals.h"
 #include "llvm/Support/TargetRegistry.h"
 #include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/TraceEvents.h"
 #include "llvm/Support/raw_ostream.h"
-#include "FunctionNamePass.h"
-#include "TailCallPass.h"
+#include "CallGraphFile.h"
+#include "FunctionDiff.h"
+#include "GzipStream.h"
+#include "FunctionNames.h"
+#include "IdenticalFunctions.h"
+#include "KnownFunctions.h"
+#include "IPAFile.h"
+#include "OutlinedFunctions.h"
+#include "ProgressReporter.h"
+#include "QueryServer.h"
+#include "ShardManifest.h"
+#include "ShardPipe.h"
+#include "StringsFile.h"
+#include "TriageTable.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Metadata.h"
 #include "llvm/IR/PassManager.h"
 #include "llvm/IR/Verifier.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Linker/Linker.h"
+#include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/Bitcode/ReaderWriter.h"
 #include "llvm/Support/Timer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
+#if LLVM_ON_UNIX
+#include <poll.h>
+#include <sys/wait.h>
+#endif
 
 using namespace llvm;
 using namespace object;
 
 static cl::opt<std::string>
-InputFilename(cl::Positional, cl::desc("Input object file"), cl::Required);
+InputFilename(cl::Positional, cl::desc("<input object file>"));
+
+static cl::opt<std::string>
+BatchFilename("batch",
+    cl::desc("Decompile each of the files listed, one per line, in "
+             "<listfile>: the target is only set up once"),
+    cl::value_desc("listfile"));
+
+static cl::opt<unsigned>
+BatchJobs("batch-jobs",
+    cl::desc("Number of files decompiled concurrently with -batch "
+             "(default = 1)"),
+    cl::init(1u));
+
+static cl::opt<bool>
+ForkServer("fork-server",
+    cl::desc("Set the target up, then read the files to decompile, one per "
+             "line, from stdin, and decompile each in a child process "
+             "forked from this one, -batch-jobs at once, writing its status "
+             "to stdout: a crash only loses its own input"),
+    cl::init(false));
 
 static cl::opt<std::string>
 TripleName("triple", cl::desc("Target triple to disassemble for, "
                               "see -version for available targets"));
 
+static cl::opt<std::string>
+ArchName("arch", cl::desc("Slice of universal binaries to decompile "
+                          "(default = arm64)"),
+         cl::init("arm64"));
+
+static cl::list<std::string>
+SliceArchs("slices", cl::CommaSeparated,
+           cl::desc("Decompile these slices of the universal binary input "
+                    "concurrently, each to <output>.<arch>, loading the "
+                    "input once ('all' for all of them)"),
+           cl::value_desc("arch,..."));
+
+static cl::opt<std::string>
+IPAMember("ipa-member",
+          cl::desc("Member of the input IPA (zip) to decompile "
+                   "(default = Payload/<App>.app/<App>)"));
+
+static cl::opt<std::string>
+DyldCacheImage("dyld-cache-image",
+               cl::desc("Image of the input dyld shared cache to decompile, "
+                        "by install name, or by file name if it is unique"),
+               cl::value_desc("path"));
+
 static cl::opt<uint64_t>
 TranslationEntrypoint("entrypoint",
                       cl::desc("Address to start translating from "
@@ -77,6 +171,56 @@ EnableDisassemblyCache("enable-mcod-disass-cache",
     cl::desc("Enable the MC Object disassembly instruction cache"),
     cl::init(false), cl::Hidden);
 
+static cl::opt<bool>
+MCSymbolize("mc-symbolize",
+    cl::desc("Recover the MC CFG with the object symbolizer: the stubs are "
+             "external functions, named, and the jumps to them tail calls"),
+    cl::init(false));
+
+static cl::opt<bool>
+ScanFunctionStarts("scan-function-starts",
+    cl::desc("Also find the functions from the targets of the direct calls, "
+             "scanning the code, for those LC_FUNCTION_STARTS misses (this is "
+             "the default without it)"),
+    cl::init(false));
+
+static cl::opt<unsigned>
+MCJobs("mc-jobs",
+    cl::desc("Number of threads used to recover the MC CFG (default = 1)"),
+    cl::init(1u));
+
+static cl::opt<std::string>
+MCCheckpointDir("mc-checkpoint-dir",
+    cl::desc("Load the MC CFG of each input from <directory>, when it was "
+             "saved there from the same input, instead of recovering it, and "
+             "save it there otherwise; the unchanged functions of a signed "
+             "Mach-O are reused from the checkpoint of its earlier version"),
+    cl::value_desc("directory"));
+
+static cl::opt<unsigned>
+DCJobs("dc-jobs",
+    cl::desc("Number of threads used to optimize (with -MC_opt) and translate "
+             "functions (default = 1)"),
+    cl::init(1u));
+
+static cl::opt<unsigned>
+PrintJobs("print-jobs",
+    cl::desc("Number of threads used to print the functions of textual IR, "
+             "or to encode them as bitcode (default = -dc-jobs)"),
+    cl::init(0u));
+
+static cl::opt<std::string>
+TranslationCacheDir("dc-cache",
+    cl::desc("Reuse the translations of the functions unchanged since an "
+             "earlier run, kept in <directory>, and add the others"),
+    cl::value_desc("directory"));
+
+static cl::opt<bool>
+IsolateWorkers("dc-isolate",
+    cl::desc("Translate in -dc-jobs worker processes, and replace the "
+             "functions that crash them by traps"),
+    cl::init(false));
+
 static cl::opt<bool>
 OptimizeOption("MC_opt",cl::desc("try to optimize MC instruction"),cl::init(false));
 
@@ -84,13 +228,409 @@ static cl::opt<bool>
 RecordAdd("REC_add",cl::desc("start to record the address of instruction"),cl::init(false));
 
 static cl::opt<std::string>
-        OutputFilename("o", cl::desc("Output filename"), cl::value_desc("filename"));
+AddrTableFilename("addr-table",
+    cl::desc("Write the instruction address table (see -REC_add) to "
+             "<filename>"),
+    cl::value_desc("filename"));
+
+static cl::opt<std::string>
+ObjCMessageTableFilename("objc-message-table",
+    cl::desc("Write the objc_msgSend call sites, with their selector and "
+             "receiver class if known, sorted by selector, to <filename>"),
+    cl::value_desc("filename"));
+
+static cl::opt<bool>
+StripAddrTags("strip-addr-tags",
+    cl::desc("Remove the per-instruction address tags from the output, "
+             "leaving only the -addr-table"),
+    cl::init(false));
+
+static cl::opt<unsigned>
+StreamFunctions("stream-functions",
+    cl::desc("Write the output in modules of <n> translated functions, as "
+             "<output>.<i>.ll (or .bc), indexed in <output>.index"),
+    cl::value_desc("n"), cl::init(0u));
+
+static cl::opt<unsigned>
+StreamInsts("stream-insts",
+    cl::desc("Write the output in modules of about <n> thousand IR "
+             "instructions, as with -stream-functions"),
+    cl::value_desc("n"), cl::init(0u));
+
+static cl::opt<double>
+MaxMemory("max-memory",
+    cl::desc("Write the output in modules, as with -stream-functions, "
+             "whenever the resident memory reaches <n> GB, and free the "
+             "instructions of each function once translated"),
+    cl::value_desc("n"), cl::init(0.0));
+
+static cl::opt<bool>
+CompressOutput("compress-output",
+    cl::desc("Write the output, and the modules of -stream-*, gzip-compressed "
+             "on -print-jobs threads, as <output>.<i>.ll.gz (or .bc.gz) for "
+             "the modules, and the outputs named after the inputs"),
+    cl::init(false));
+
+static cl::opt<unsigned>
+CompressLevel("compress-level",
+    cl::desc("Level of -compress-output, from 1 (fastest) to 9 (smallest) "
+             "(default = 6)"),
+    cl::value_desc("n"), cl::init(6u));
+
+static cl::opt<std::string>
+StreamTo("stream-to",
+    cl::desc("Send the modules of -stream-* to <path> as they are written, "
+             "framed as in ShardPipe.h, instead of writing them beside the "
+             "output: to a FIFO, a Unix socket, or stdout with '-'"),
+    cl::value_desc("path"));
+
+static cl::list<std::string>
+OnlyRanges("only-range",
+    cl::desc("Only decompile the functions starting in [<begin>, <end>)"),
+    cl::value_desc("begin-end"), cl::CommaSeparated);
+
+static cl::opt<std::string>
+OnlyFunctions("only-func",
+    cl::desc("Only decompile the functions whose name (fn_<hex address>, or "
+             "the Objective-C method or Swift metadata name) matches "
+             "<regex>"),
+    cl::value_desc("regex"));
+
+static cl::opt<std::string>
+ShardSpec("shard",
+    cl::desc("Only decompile the <i>th of <n> address ranges of functions, "
+             "of about the same size, and list the functions it writes in "
+             "<output>.manifest"),
+    cl::value_desc("i/n"));
+
+static cl::list<std::string>
+MergeShards("merge-shards",
+    cl::desc("Link the modules of the given -shard manifests, of all the "
+             "shards of an input, into the output, and list its functions in "
+             "<output>.manifest"),
+    cl::value_desc("manifest"), cl::CommaSeparated);
+
+static cl::list<std::string>
+ReachableFrom("reachable-from",
+    cl::desc("Only decompile the functions at the given addresses, or "
+             "implementing the given Objective-C selectors or methods, and "
+             "those they call"),
+    cl::value_desc("address|selector"), cl::CommaSeparated);
+
+static cl::opt<int>
+ReachableDepth("reachable-depth",
+    cl::desc("Maximum number of calls from a -reachable-from function "
+             "(default = no limit)"),
+    cl::value_desc("n"), cl::init(-1));
+
+static cl::opt<bool>
+Recursive("recursive",
+    cl::desc("Only decompile the functions reachable, through direct calls, "
+             "from the entrypoint, the static initializers, the Objective-C "
+             "+load methods, and the -reachable-from functions"));
+
+static cl::opt<bool>
+Resume("resume",
+    cl::desc("Go on with an interrupted -stream-* run, from its journal, "
+             "<output>.journal: skip the functions already written, and "
+             "those that crashed the translation"),
+    cl::init(false));
+
+static cl::opt<bool>
+SkipUnchanged("skip-unchanged",
+    cl::desc("Don't decompile an input again if its output was written from "
+             "the same input, by the same llvm-dec, with the same options, "
+             "as recorded in <output>.hash"),
+    cl::init(false));
+
+static cl::opt<std::string>
+OutputCacheDir("output-cache",
+    cl::desc("Keep the outputs in <directory>, by hash of the input and the "
+             "options, and hard-link them from there instead of decompiling "
+             "again (not with -stream-* nor -addr-table)"),
+    cl::value_desc("directory"));
+
+static cl::opt<std::string>
+TelemetryFilename("telemetry",
+    cl::desc("Write the time each phase took, and the cost of each function, "
+             "as JSON to <file> (with -batch, to <output>.telemetry.json)"),
+    cl::value_desc("file"));
+
+static cl::opt<unsigned>
+TelemetryTop("telemetry-top",
+    cl::desc("Print the <n> functions that took the longest to disassemble "
+             "and translate"),
+    cl::value_desc("n"), cl::init(0u));
+
+static cl::opt<unsigned>
+ProgressInterval("progress",
+    cl::desc("Print the progress on stderr every <n> seconds: functions "
+             "done, instructions per second, resident memory and time left "
+             "in the phase"),
+    cl::value_desc("n"), cl::init(0u));
+
+static cl::opt<std::string>
+ProgressFilename("progress-file",
+    cl::desc("Write the progress to <file>, every -progress seconds (default "
+             "= 10), replacing it (with -batch, to <output>.progress)"),
+    cl::value_desc("file"));
+
+static cl::opt<bool>
+MemReport("mem-report",
+    cl::desc("Print an estimate of the memory used by the MC module, the "
+             "disassembly cache, the IR and the instruction tracker, after "
+             "the disassembly, the translation, and the output of each "
+             "module"),
+    cl::init(false));
+
+static cl::opt<std::string>
+CoverageReportFilename("coverage-report",
+    cl::desc("Write the ranges of the text sections that are in no basic "
+             "block to <file>, as data-in-code, padding or missed functions "
+             "(with -batch, to <output>.coverage)"),
+    cl::value_desc("file"));
+
+static cl::opt<std::string>
+CallGraphFilename("call-graph",
+    cl::desc("Write the direct calls between the functions, and to the "
+             "external functions, to <file>, in the binary format of "
+             "CallGraphFile.h (with -batch, to <output>.callgraph)"),
+    cl::value_desc("file"));
+
+static cl::opt<std::string>
+StringsFilename("strings",
+    cl::desc("Write the strings of the __cstring, __objc_methname and "
+             "__objc_classname sections, with the metadata pointing to them, "
+             "to <file>, as described in StringsFile.h (with -batch, to "
+             "<output>.strings)"),
+    cl::value_desc("file"));
+
+static cl::opt<bool>
+SectionGlobals("section-globals",
+    cl::desc("Translate the addresses in the read-only sections __const, "
+             "__objc_const and __cstring to offsets in a single external "
+             "global per section, @section_<address>, to back with the bytes "
+             "of the file, rather than to string constants"),
+    cl::init(false));
+
+static cl::opt<bool>
+CallSummaries("call-summaries",
+    cl::desc("Only save and restore, around each call to a function of the "
+             "binary, the registers it and its callees can read and clobber, "
+             "computed over the call graph; around the other calls, those "
+             "the calling convention allows"),
+    cl::init(false));
+
+static cl::opt<bool>
+ElideCalleeSaved("elide-callee-saved",
+    cl::desc("Skip the saves of the callee-saved registers in the "
+             "prologues, and their restores in the epilogues, where they "
+             "match: the restores give the registers their incoming value"),
+    cl::init(false));
+
+static cl::opt<bool>
+CollapseMemoryTransfers("collapse-memory-transfers",
+    cl::desc("Translate the runs of register pair loads and stores that "
+             "copy or clear a block of memory, as inlined structure copies "
+             "are unrolled to, to memmove and memset calls"),
+    cl::init(false));
+
+static cl::opt<bool>
+ResolveConstantCalls("resolve-constant-calls",
+    cl::desc("Translate the indirect calls to a register that holds a "
+             "constant on all the paths to them, or a pointer of the GOT or "
+             "of a constant pointer table, to direct calls"),
+    cl::init(false));
+
+static cl::opt<bool>
+InlineOutlined("inline-outlined",
+    cl::desc("Mark always-inline the translation of the functions that look "
+             "like the fragments of the machine outliner: short straight-line "
+             "code, called from several functions"),
+    cl::init(false));
+
+static cl::opt<bool>
+MergeIdentical("merge-identical",
+    cl::desc("Translate only once the functions whose machine code is the "
+             "same, up to the PC-relative operands referring to the same "
+             "addresses, and define the others as calls to it"),
+    cl::init(false));
+
+static cl::opt<bool>
+SynthesizeObjCAccessors("synthesize-objc-accessors",
+    cl::desc("Define the Objective-C methods that are synthesized property "
+             "accessors, a load or store of an instance variable, directly "
+             "instead of translating them"),
+    cl::init(false));
+
+static cl::opt<std::string>
+KnownFunctionsFilename("known-functions",
+    cl::desc("Only declare, under their name, the functions whose "
+             "fingerprint is in the database <file>, as described in "
+             "KnownFunctions.h, instead of translating them"),
+    cl::value_desc("file"));
+
+static cl::opt<std::string>
+FingerprintsFilename("write-fingerprints",
+    cl::desc("Write the fingerprints of the named functions to <file>, to "
+             "build the database of -known-functions (with -batch, to "
+             "<output>.fingerprints)"),
+    cl::value_desc("file"));
 
+static cl::opt<bool>
+QualityMetrics("quality-metrics",
+    cl::desc("Print the size of the IR relative to the machine code, and "
+             "the time spent optimizing it, to catch the changes that make "
+             "the translation faster but its output bigger"),
+    cl::init(false));
+
+static cl::opt<bool>
+FreeMCInsts("free-mc-insts",
+    cl::desc("Free the instructions and blocks of each machine function once "
+             "it is translated, keeping only its address and name (always "
+             "off with -annot)"),
+    cl::init(true));
+
+static cl::opt<bool>
+PackMCInsts("pack-mc-insts",
+    cl::desc("Keep the instructions of the machine functions in a compact "
+             "encoding until each is translated, once the MC CFG is "
+             "complete"),
+    cl::init(false));
+
+static cl::opt<bool>
+FusedTranslation("fused-translation",
+    cl::desc("Disassemble each function right before translating it, and "
+             "free its instructions right after, instead of building the "
+             "whole MC module first (ignored with the options that need it, "
+             "as -annot, -MC_opt or -dc-jobs)"),
+    cl::init(false));
+
+static cl::opt<std::string>
+TraceFilename("trace-file",
+    cl::desc("Write the time spans of the phases, and of each function on "
+             "each thread, to <file>, in the Trace Event Format of "
+             "chrome://tracing"),
+    cl::value_desc("file"));
+
+static cl::opt<std::string>
+ServePath("serve",
+    cl::desc("Instead of decompiling the input, keep its MC CFG, names and "
+             "call graph loaded, and answer the queries of QueryServer.h on "
+             "the Unix socket <path>, or on stdin with '-'"),
+    cl::value_desc("path"));
+
+static cl::opt<bool>
+MCOnly("mc-only",
+    cl::desc("Instead of decompiling the input, stop once its MC CFG and "
+             "names are built, and write its functions, stubs, direct calls "
+             "and strings as the text tables of TriageTable.h (with -batch, "
+             "to <output>.triage)"),
+    cl::init(false));
+
+static cl::opt<std::string>
+DiffAgainst("diff-against",
+    cl::desc("Only translate the functions added or changed since the "
+             "earlier version of the input that -mc-only wrote <tables> of, "
+             "matched as described in FunctionDiff.h, and declare the others"),
+    cl::value_desc("tables"));
+
+static cl::opt<std::string>
+DiffReportFilename("diff-report",
+    cl::desc("Write the functions -diff-against finds added, removed or "
+             "changed to <file> (with -batch, to <output>.diff)"),
+    cl::value_desc("file"));
+
+static cl::opt<std::string>
+ServeBitcode("serve-bitcode",
+    cl::desc("Bitcode of the input, written by an earlier -bc run, that "
+             "-serve reads lazily to answer the strings and selector "
+             "queries"),
+    cl::value_desc("file"));
 
+static cl::opt<std::string>
+        OutputFilename("o", cl::desc("Output filename (with -batch, output "
+                                     "directory; default = beside each "
+                                     "input)"),
+                       cl::value_desc("filename"));
 
 static StringRef ToolName;
 
-static const Target *getTarget(const ObjectFile *Obj) {
+// The extension of the modules written.
+static const char *getModuleExtension() {
+  if (CompressOutput)
+    return PrintBitcode ? ".bc.gz" : ".ll.gz";
+  return PrintBitcode ? ".bc" : ".ll";
+}
+
+// The extension of the outputs named after the input.
+static const char *getOutputExtension() {
+  if (MCOnly)
+    return ".triage";
+  return getModuleExtension();
+}
+
+// Whether the output is written in modules, as the translation goes.
+static bool isStreaming() {
+  return StreamFunctions || StreamInsts || MaxMemory > 0;
+}
+
+// The option that needs the whole MC module before the translation, or null
+// if -fused-translation can be used.
+static const char *getFusedTranslationConflict() {
+  if (AnnotateIROutput)
+    return "-annot";
+  if (OptimizeOption)
+    return "-MC_opt";
+  if (DCJobs > 1)
+    return "-dc-jobs";
+  if (!TranslationCacheDir.empty())
+    return "-dc-cache";
+  if (IsolateWorkers)
+    return "-dc-isolate";
+  if (!MCCheckpointDir.empty())
+    return "-mc-checkpoint-dir";
+  if (!ReachableFrom.empty())
+    return "-reachable-from";
+  if (Recursive)
+    return "-recursive";
+  if (!ServePath.empty())
+    return "-serve";
+  if (MCOnly)
+    return "-mc-only";
+  if (!DiffAgainst.empty())
+    return "-diff-against";
+  if (!CoverageReportFilename.empty())
+    return "-coverage-report";
+  if (!CallGraphFilename.empty())
+    return "-call-graph";
+  if (CallSummaries)
+    return "-call-summaries";
+  if (InlineOutlined)
+    return "-inline-outlined";
+  if (MergeIdentical)
+    return "-merge-identical";
+  if (SynthesizeObjCAccessors)
+    return "-synthesize-objc-accessors";
+  if (!KnownFunctionsFilename.empty())
+    return "-known-functions";
+  if (!FingerprintsFilename.empty())
+    return "-write-fingerprints";
+  if (QualityMetrics)
+    return "-quality-metrics";
+  if (PackMCInsts)
+    return "-pack-mc-insts";
+  return nullptr;
+}
+
+// Opened once, in main, with -dc-cache: it is shared by all the inputs.
+static std::unique_ptr<DCTranslationCache> TranslationCache;
+
+// The command line arguments, but the tool name, for getOutputHash.
+static std::vector<std::string> ToolArgs;
+
+static const Target *getTarget(const ObjectFile *Obj,
+                               std::string &TheTripleName, raw_ostream &Log) {
   // Figure out the target triple.
   Triple TheTriple("unknown-unknown-unknown");
   if (TripleName.empty()) {
@@ -109,12 +649,12 @@ static const Target *getTarget(const ObjectFile *Obj) {
   std::string Error;
   const Target *TheTarget = TargetRegistry::lookupTarget("", TheTriple, Error);
   if (!TheTarget) {
-    errs() << ToolName << ": " << Error;
+    Log << ToolName << ": " << Error;
     return 0;
   }
 
-  // Update the triple name and return the found target.
-  TripleName = TheTriple.getTriple();
+  // Return the found target, and its triple name.
+  TheTripleName = TheTriple.getTriple();
   return TheTarget;
 }
 
@@ -130,138 +670,1109 @@ uint32_t get_all_code_size(MCModule* target_module){
   return code_size;
 }
 
+// The DC sessions of a thread, one per target: the semantics aren't shared
+// between threads, but each thread creates them once, and switches them to
+// the module of each input it decompiles.
+typedef std::map<const DCDecompilerTarget *,
+                 std::unique_ptr<DCDecompilerSession>> TargetSemaCache;
 
+// The target descriptions are shared by all inputs, on all threads.
+static const DCDecompilerTarget *getTargetSetup(StringRef TheTripleName,
+                                                raw_ostream &Log) {
+  static std::mutex SetupsMutex;
+  static StringMap<std::unique_ptr<DCDecompilerTarget>> Setups;
+  std::lock_guard<std::mutex> Lock(SetupsMutex);
+  std::unique_ptr<DCDecompilerTarget> &TS = Setups[TheTripleName];
+  if (TS)
+    return TS.get();
 
-int main(int argc, char **argv) {
-    //git
-  sys::PrintStackTraceOnErrorSignal();
-  PrettyStackTraceProgram X(argc, argv);
-  llvm_shutdown_obj Y;
+  std::string Error;
+  TS = DCDecompilerTarget::create(TheTripleName, Error);
+  if (!TS)
+    Log << "error: " << Error << "\n";
+  return TS.get();
+}
 
-  InitializeAllTargetInfos();
-  InitializeAllTargetDCs();
-  InitializeAllTargetMCs();
-  InitializeAllAsmParsers();
-  InitializeAllDisassemblers();
+static const DCDecompilerTarget *getTargetSetup(const ObjectFile *Obj,
+                                                raw_ostream &Log) {
+  std::string TheTripleName;
+  if (!getTarget(Obj, TheTripleName, Log))
+    return nullptr;
+  return getTargetSetup(TheTripleName, Log);
+}
 
-  cl::ParseCommandLineOptions(argc, argv, "Function disassembler\n");
+static DCDecompilerSession *getTargetSema(const DCDecompilerTarget &TS,
+                                          TargetSemaCache &Semas,
+                                          raw_ostream &Log) {
+  std::unique_ptr<DCDecompilerSession> &Sema = Semas[&TS];
+  if (Sema) {
+    // Only report the unknown instructions of the current input.
+    Sema->getInstrSema().clearUnknownInstCounts();
+    return Sema.get();
+  }
 
-  ToolName = argv[0];
-  
-  TimerGroup TG("... llvm-dec module time report ...");
-
-  Timer *BinLoadTimer = new Timer("Bin load overhead", TG);
-  BinLoadTimer->startTimer();
-  auto Binary = createBinary(InputFilename);
-  if (std::error_code ec = Binary.getError()) {
-    errs() << ToolName << ": '" << InputFilename << "': "
-           << ec.message() << ".\n";
-    return 1;
+  std::string Error;
+  Sema = DCDecompilerSession::create(TS, Error);
+  if (!Sema) {
+    Log << "error: " << Error << "\n";
+    return nullptr;
   }
-  BinLoadTimer->stopTimer();
-
-  Timer *MachOParseTimer = new Timer("Mach-O parse overhead", TG);
-  MachOParseTimer->startTimer();
-  ObjectFile *Obj;
-  if (!(Obj = dyn_cast<ObjectFile>((*Binary).getBinary())))
-    errs() << ToolName << ": '" << InputFilename << "': "
-           << "Unrecognized file type.\n";
-  MachOParseTimer->stopTimer();
-    
-  const Target *TheTarget = getTarget(Obj);
-
-  std::unique_ptr<const MCRegisterInfo> MRI(
-    TheTarget->createMCRegInfo(TripleName));
-  if (!MRI) {
-    errs() << "error: no register info for target " << TripleName << "\n";
-    return 1;
+  Sema->getInstrSema().setRecordAddresses(RecordAdd);
+  Sema->getInstrSema().setTagObjCMessages(!ObjCMessageTableFilename.empty());
+  return Sema.get();
+}
+
+// The tag of the MC CFG checkpoints of Obj: the checkpoint is only valid for
+// the same object, disassembled for the same target.
+static std::string getCheckpointTag(const ObjectFile &Obj,
+                                    StringRef TheTripleName) {
+  MD5 Hash;
+  Hash.update(Obj.getData());
+  MD5::MD5Result Result;
+  Hash.final(Result);
+  SmallString<32> Str;
+  MD5::stringifyResult(Result, Str);
+  return (TheTripleName + " " + Str).str();
+}
+
+namespace {
+/// \brief What the journal of a streaming run tells of it.
+/// The journal, <output>.journal, is written as the modules are, and has a
+/// line per event:
+///   F <index line>   a function of the module being written, as indexed
+///   M <i>            module <i> is written, with its functions
+///   Q <hex address>  the translation crashed in the function at the address
+struct StreamJournal {
+  /// The index lines of the functions of the modules written.
+  std::vector<std::string> IndexLines;
+  DenseSet<uint64_t> Written;
+  DenseSet<uint64_t> Crashed;
+  unsigned NumModules;
+
+  StreamJournal() : NumModules(0) {}
+};
+} // end anonymous namespace
+
+// Read the journal in File, if any, ignoring the functions of a module that
+// wasn't completely written.
+static void readStreamJournal(StringRef File, StreamJournal &J) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> BufOrErr =
+      MemoryBuffer::getFile(File);
+  if (!BufOrErr)
+    return;
+  std::vector<std::string> Pending;
+  SmallVector<StringRef, 0> Lines;
+  (*BufOrErr)->getBuffer().split(Lines, "\n", -1, /*KeepEmpty=*/false);
+  for (StringRef Line : Lines) {
+    StringRef Kind = Line.substr(0, 2), Rest = Line.substr(2);
+    unsigned Module;
+    uint64_t Addr;
+    if (Kind == "F ") {
+      Pending.push_back(Rest);
+    } else if (Kind == "M " && !Rest.getAsInteger(10, Module)) {
+      for (StringRef IndexLine : Pending)
+        if (!IndexLine.split(' ').first.getAsInteger(16, Addr))
+          J.Written.insert(Addr);
+      J.IndexLines.insert(J.IndexLines.end(), Pending.begin(), Pending.end());
+      Pending.clear();
+      J.NumModules = std::max(J.NumModules, Module + 1);
+    } else if (Kind == "Q " && !Rest.getAsInteger(16, Addr)) {
+      J.Crashed.insert(Addr);
+    }
   }
+}
 
-  // Set up disassembler.
-  std::unique_ptr<const MCAsmInfo> MAI(
-    TheTarget->createMCAsmInfo(*MRI, TripleName));
-  if (!MAI) {
-    errs() << "error: no assembly info for target " << TripleName << "\n";
-    return 1;
+// The journal of the input being decompiled, for the crash handlers, or -1.
+static std::atomic<int> CrashJournalFD(-1);
+
+// Journal the function the crashing thread was translating, if any.
+// This runs in signal handlers: it doesn't allocate, nor use streams.
+static void journalCrash(void *) {
+  uint64_t Addr;
+  const int FD = CrashJournalFD;
+  if (FD < 0 || !DCTranslator::getFunctionInTranslation(Addr))
+    return;
+  char Buf[sizeof("Q \n") + 16];
+  char *End = Buf + sizeof(Buf), *P = End;
+  *--P = '\n';
+  do {
+    *--P = hexdigit(Addr % 16);
+    Addr /= 16;
+  } while (Addr);
+  *--P = ' ';
+  *--P = 'Q';
+  ssize_t Written = ::write(FD, P, End - P);
+  (void)Written;
+}
+
+// Report fatal errors as usual, but journal the function that caused them.
+static void journalFatalError(void *, const std::string &Reason, bool) {
+  const std::string Message = "LLVM ERROR: " + Reason + "\n";
+  ssize_t Written = ::write(2, Message.data(), Message.size());
+  (void)Written;
+  journalCrash(nullptr);
+}
+
+// Describe the function slice options, and the others that change the MC
+// CFG, to tell apart the checkpoints of different slices.
+static std::string getFunctionSliceOptions() {
+  std::string Options;
+  raw_string_ostream OS(Options);
+  if (MCSymbolize)
+    OS << " symbolize";
+  for (const std::string &Range : OnlyRanges)
+    OS << " range=" << Range;
+  if (!OnlyFunctions.empty())
+    OS << " func=" << OnlyFunctions;
+  if (!ShardSpec.empty())
+    OS << " shard=" << ShardSpec;
+  for (const std::string &Root : ReachableFrom)
+    OS << " root=" << Root;
+  if (Recursive)
+    OS << " recursive";
+  if (!ReachableFrom.empty() || Recursive)
+    OS << " depth=" << ReachableDepth;
+  return OS.str();
+}
+
+// Return the end of the section containing Addr, or 0.
+static uint64_t getSectionEnd(const ObjectFile &Obj, uint64_t Addr) {
+  for (const SectionRef &Section : Obj.sections()) {
+    const uint64_t Begin = Section.getAddress(), Size = Section.getSize();
+    if (Begin <= Addr && Addr - Begin < Size)
+      return Begin + Size;
+  }
+  return 0;
+}
+
+// Restrict the functions OD disassembles, hence translates, to those asked
+// for with -only-range, -only-func, -shard, -reachable-from and -recursive.
+// The range of the shard is set in Shard.
+// Return false, after logging why, if the options are invalid.
+static bool setupFunctionSlice(MCObjectDisassembler &OD,
+                               MCObjectSymbolizer &MOS,
+                               const ObjectFile &Obj,
+                               const ObjectiveCFile *ObjC,
+                               const SwiftMetadataIndex *Swift,
+                               ShardManifest &Shard, raw_ostream &Log) {
+  std::vector<std::pair<uint64_t, uint64_t>> Ranges;
+  for (StringRef Range : OnlyRanges) {
+    std::pair<StringRef, StringRef> BeginEnd = Range.split('-');
+    uint64_t Begin, End;
+    if (BeginEnd.first.trim().getAsInteger(0, Begin) ||
+        BeginEnd.second.trim().getAsInteger(0, End) || Begin >= End) {
+      Log << ToolName << ": invalid -only-range '" << Range << "'\n";
+      return false;
+    }
+    Ranges.push_back(std::make_pair(Begin, End));
+  }
+
+  // std::function needs a copyable functor.
+  std::shared_ptr<Regex> FuncRegex;
+  if (!OnlyFunctions.empty()) {
+    FuncRegex = std::make_shared<Regex>(OnlyFunctions);
+    std::string Error;
+    if (!FuncRegex->isValid(Error)) {
+      Log << ToolName << ": invalid -only-func regex: " << Error << "\n";
+      return false;
+    }
+  }
+
+  if (!ShardSpec.empty()) {
+    if (!Shard.parseShard(ShardSpec)) {
+      Log << ToolName << ": invalid -shard '" << ShardSpec << "'\n";
+      return false;
+    }
+    // The starts are only read once: buildModule uses them as well.
+    MCObjectDisassembler::AddressSetTy Starts = OD.findFunctionStarts();
+    OD.setFunctionStarts(Starts);
+    const MCFunctionRangeMap Functions(std::move(Starts));
+    const uint64_t EndAddr =
+        Functions.empty() ? 0 : getSectionEnd(Obj, *(Functions.end() - 1));
+    std::pair<uint64_t, uint64_t> Range =
+        Functions.getShardRange(Shard.Shard, Shard.NumShards, EndAddr);
+    Shard.Begin = Range.first;
+    Shard.End = Range.second;
+  }
+
+  const uint64_t ShardBegin = Shard.Begin, ShardEnd = Shard.End;
+  if (!Ranges.empty() || FuncRegex || !ShardSpec.empty())
+    OD.setFunctionFilter([=](uint64_t BeginAddr) {
+      if (BeginAddr < ShardBegin || BeginAddr >= ShardEnd)
+        return false;
+      if (!Ranges.empty() &&
+          std::none_of(Ranges.begin(), Ranges.end(),
+                       [&](const std::pair<uint64_t, uint64_t> &R) {
+                         return R.first <= BeginAddr && BeginAddr < R.second;
+                       }))
+        return false;
+      if (!FuncRegex)
+        return true;
+      if (FuncRegex->match("fn_" + utohexstr(BeginAddr)))
+        return true;
+      if (ObjC && FuncRegex->match(ObjC->getFunctionName(BeginAddr)))
+        return true;
+      return Swift && FuncRegex->match(Swift->getFunctionName(BeginAddr));
+    });
+
+  if (ReachableFrom.empty() && !Recursive)
+    return true;
+  MCObjectDisassembler::AddressSetTy Roots;
+  if (Recursive) {
+    // What the loader runs: the rest is reached from these.
+    uint64_t Entrypoint = TranslationEntrypoint;
+    if (!Entrypoint)
+      Entrypoint = MOS.getEntrypoint();
+    if (Entrypoint)
+      Roots.push_back(Entrypoint);
+    // createMCObjectSymbolizer makes a Mach-O symbolizer for Mach-O files.
+    if (isa<MachOObjectFile>(Obj))
+      for (uint64_t Addr :
+           static_cast<MCMachObjectSymbolizer &>(MOS).getStaticInitFunctions())
+        Roots.push_back(MOS.getEffectiveLoadAddr(Addr));
+    if (ObjC)
+      for (const ObjectiveCFile::ObjcMethod_t &M : ObjC->getMethods())
+        if (M.isClassMethod && M.MethodName == "load")
+          Roots.push_back(M.IMP);
+    if (Roots.empty()) {
+      Log << ToolName << ": -recursive found no entrypoint to start from\n";
+      return false;
+    }
+  }
+  for (StringRef Root : ReachableFrom) {
+    uint64_t Addr;
+    if (!Root.getAsInteger(0, Addr)) {
+      Roots.push_back(Addr);
+      continue;
+    }
+    // Not an address: a selector, or a full "-[Class selector]" method name.
+    bool Found = false;
+    if (ObjC)
+      for (const ObjectiveCFile::ObjcMethod_t &M : ObjC->getMethods())
+        if (M.MethodName == Root || ObjC->getFunctionName(M.IMP) == Root) {
+          Roots.push_back(M.IMP);
+          Found = true;
+        }
+    if (!Found) {
+      Log << ToolName << ": no function implements '" << Root << "'\n";
+      return false;
+    }
+  }
+  OD.setReachableFrom(std::move(Roots), ReachableDepth);
+  return true;
+}
+
+// Load the MC CFG saved in File, if it has the given Tag.
+static void loadMCCheckpoint(std::unique_ptr<MCModule> &MCM, StringRef File,
+                             StringRef Tag, const MCInstrInfo &MII,
+                             const MCRegisterInfo &MRI, raw_ostream &Log) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> BufOrErr =
+      MemoryBuffer::getFile(File, /*FileSize=*/-1,
+                            /*RequiresNullTerminator=*/false);
+  if (!BufOrErr)
+    return;
+  StringRef Err =
+      binary2mcmodule(MCM, (*BufOrErr)->getBuffer(), MII, MRI, Tag);
+  if (!Err.empty())
+    Log << ToolName << ": ignoring MC CFG checkpoint '" << File << "': " << Err
+        << "\n";
+}
+
+static void saveMCCheckpoint(const MCModule &MCM, StringRef File,
+                             StringRef Tag, const MCInstrInfo &MII,
+                             const MCRegisterInfo &MRI, raw_ostream &Log) {
+  // Write a temporary file, renamed once complete: concurrent runs, or
+  // -batch inputs with the same name, never see a partial checkpoint.
+  SmallString<128> TempPath;
+  int FD;
+  std::error_code EC = sys::fs::createUniqueFile(File + "-%%%%%%.tmp", FD,
+                                                 TempPath);
+  if (!EC) {
+    raw_fd_ostream OS(FD, /*shouldClose=*/true);
+    StringRef Err = mcmodule2binary(OS, MCM, MII, MRI, Tag);
+    OS.close();
+    if (!Err.empty() || OS.has_error()) {
+      OS.clear_error();
+      sys::fs::remove(TempPath);
+      Log << ToolName << ": unable to save MC CFG checkpoint '" << File
+          << "': " << (Err.empty() ? StringRef("write error") : Err) << "\n";
+      return;
+    }
+    EC = sys::fs::rename(TempPath, File);
+    if (EC)
+      sys::fs::remove(TempPath);
+  }
+  if (EC)
+    Log << ToolName << ": unable to save MC CFG checkpoint '" << File
+        << "': " << EC.message() << "\n";
+}
+
+// The page hashes of the code signature of the object of a checkpoint are
+// saved next to it, in <checkpoint>.pages, so that the next run of a changed
+// object can reuse the functions of the pages that didn't change. The file has
+// a line for the tag of the checkpoint without the hash of the object, so that
+// it only matches the same options, one for the whole tag, one for the page
+// size, and one per page hash.
+static bool readCheckpointPages(StringRef File, StringRef BaseTag,
+                                std::string &Tag, DCCodePageHashes &Pages) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> BufOrErr = MemoryBuffer::getFile(File);
+  if (!BufOrErr)
+    return false;
+  SmallVector<StringRef, 64> Lines;
+  (*BufOrErr)->getBuffer().split(Lines, "\n", -1, /*KeepEmpty=*/false);
+  if (Lines.size() < 3 || Lines[0] != BaseTag ||
+      Lines[2].getAsInteger(10, Pages.PageSize))
+    return false;
+  Tag = Lines[1];
+  Pages.Hashes.assign(Lines.begin() + 3, Lines.end());
+  return true;
+}
+
+static void writeCheckpointPages(StringRef File, StringRef BaseTag,
+                                 StringRef Tag, const DCCodePageHashes &Pages,
+                                 raw_ostream &Log) {
+  SmallString<128> TempPath;
+  int FD;
+  std::error_code EC = sys::fs::createUniqueFile(File + "-%%%%%%.tmp", FD,
+                                                 TempPath);
+  if (!EC) {
+    raw_fd_ostream OS(FD, /*shouldClose=*/true);
+    OS << BaseTag << "\n" << Tag << "\n" << Pages.PageSize << "\n";
+    for (const std::string &Hash : Pages.Hashes)
+      OS << Hash << "\n";
+    OS.close();
+    if (OS.has_error()) {
+      OS.clear_error();
+      EC = std::make_error_code(std::errc::io_error);
+    } else {
+      EC = sys::fs::rename(TempPath, File);
+    }
+    if (EC)
+      sys::fs::remove(TempPath);
+  }
+  if (EC)
+    Log << ToolName << ": unable to save page hashes '" << File
+        << "': " << EC.message() << "\n";
+}
+
+namespace {
+/// \brief A Timer that also keeps its total wall time, for -telemetry, as
+/// Timer doesn't tell it, and records its spans for -trace-file, as events
+/// named \p TraceName about \p Input.
+class PhaseTimer {
+  Timer T;
+  const char *TraceName;
+  StringRef Input;
+  std::chrono::steady_clock::time_point Start;
+  int64_t TraceStart;
+  double Seconds;
+
+public:
+  PhaseTimer(StringRef Name, const char *TraceName, StringRef Input,
+             TimerGroup &TG)
+      : T(Name, TG), TraceName(TraceName), Input(Input), TraceStart(0),
+        Seconds(0) {}
+
+  void startTimer() {
+    T.startTimer();
+    Start = std::chrono::steady_clock::now();
+    if (areTraceEventsEnabled())
+      TraceStart = getTraceTime();
+  }
+  void stopTimer() {
+    std::chrono::duration<double> D = std::chrono::steady_clock::now() - Start;
+    Seconds += D.count();
+    T.stopTimer();
+    recordTraceEvent(TraceName, Input, TraceStart);
+  }
+  double getSeconds() const { return Seconds; }
+};
+
+/// \brief The cost of a function, in all the phases.
+struct FunctionTelemetry {
+  uint64_t Addr;
+  std::string Name;
+  MCObjectDisassembler::FunctionStats MC;
+  DCTranslator::FunctionStats DC;
+
+  double getTotalSeconds() const {
+    return MC.DecodeSeconds + MC.CFGSeconds + DC.TranslateSeconds +
+           DC.OptimizeSeconds;
+  }
+};
+} // end anonymous namespace
+
+static void writeJSONString(raw_ostream &OS, StringRef Str) {
+  OS << '"';
+  for (unsigned char C : Str) {
+    if (C == '"' || C == '\\')
+      OS << '\\' << C;
+    else if (C < 0x20)
+      OS << format("\\u%04x", C);
+    else
+      OS << C;
+  }
+  OS << '"';
+}
+
+/// \brief Write the telemetry of \p InputFile, as JSON, to \p Filename.
+/// The functions go in address order.
+namespace {
+/// \brief Estimate of the heap memory used by an IR module, by component.
+struct IRMemoryUsage {
+  /// \brief The functions, blocks and instructions, with their operands.
+  size_t Insts;
+  /// \brief The metadata attachments, and the nodes they reach.
+  size_t Metadata;
+  /// \brief The names of the values.
+  size_t Names;
+};
+} // end anonymous namespace
+
+/// \brief Estimate the memory used by \p M. The instructions are counted as
+/// the Instruction base class: this is a lower bound.
+static IRMemoryUsage getIRMemoryUsage(const Module &M) {
+  IRMemoryUsage Usage = {0, 0, 0};
+  auto AddName = [&](const Value &V) {
+    if (V.hasName())
+      Usage.Names += sizeof(ValueName) + V.getName().size() + 1;
+  };
+  for (const GlobalVariable &GV : M.globals()) {
+    AddName(GV);
+    Usage.Insts += sizeof(GlobalVariable);
+  }
+  for (const GlobalAlias &GA : M.aliases()) {
+    AddName(GA);
+    Usage.Insts += sizeof(GlobalAlias);
+  }
+
+  SmallPtrSet<const Metadata *, 32> SeenMD;
+  SmallVector<const Metadata *, 32> MDWorklist;
+  SmallVector<std::pair<unsigned, MDNode *>, 4> MDs;
+  for (const Function &F : M) {
+    AddName(F);
+    Usage.Insts += sizeof(Function);
+    for (const Argument &A : F.args()) {
+      AddName(A);
+      Usage.Insts += sizeof(Argument);
+    }
+    for (const BasicBlock &BB : F) {
+      AddName(BB);
+      Usage.Insts += sizeof(BasicBlock);
+      for (const Instruction &I : BB) {
+        AddName(I);
+        Usage.Insts += sizeof(Instruction) + I.getNumOperands() * sizeof(Use);
+        MDs.clear();
+        I.getAllMetadata(MDs);
+        Usage.Metadata +=
+            MDs.size() * sizeof(std::pair<unsigned, TrackingMDNodeRef>);
+        for (const auto &KindMD : MDs)
+          if (SeenMD.insert(KindMD.second).second)
+            MDWorklist.push_back(KindMD.second);
+      }
+    }
+  }
+  while (!MDWorklist.empty()) {
+    const Metadata *MD = MDWorklist.pop_back_val();
+    if (const MDNode *N = dyn_cast<MDNode>(MD)) {
+      Usage.Metadata +=
+          sizeof(MDNode) + N->getNumOperands() * sizeof(MDOperand);
+      for (const MDOperand &Op : N->operands())
+        if (Op && SeenMD.insert(Op.get()).second)
+          MDWorklist.push_back(Op.get());
+    } else if (const MDString *S = dyn_cast<MDString>(MD)) {
+      Usage.Metadata += sizeof(MDString) + S->getLength();
+    } else {
+      Usage.Metadata += sizeof(ConstantAsMetadata);
+    }
+  }
+  return Usage;
+}
+
+/// \brief Print in \p Log, for -mem-report, the memory used at the end of
+/// \p Phase by each component that is alive, that is, not null.
+static void printMemoryReport(raw_ostream &Log, StringRef Phase,
+                              const MCModule *MCM,
+                              const MCCachingDisassembler *DisAsmCache,
+                              const Module *M,
+                              const DCTranslatedInstTracker *Tracker) {
+  auto MB = [](uint64_t Bytes) { return format("%.1f MB", Bytes / 1048576.0); };
+  Log << "Memory after " << Phase << ": " << MB(getResidentBytes())
+      << " resident\n";
+  if (MCM) {
+    MCModule::MemoryUsage Usage = MCM->getMemoryUsage();
+    Log << "  MC module: functions " << MB(Usage.Functions) << ", blocks "
+        << MB(Usage.Blocks) << ", instructions " << MB(Usage.Insts) << "\n";
+  }
+  if (DisAsmCache)
+    Log << "  Disassembly cache: " << MB(DisAsmCache->getMemoryUsage())
+        << "\n";
+  if (M) {
+    IRMemoryUsage Usage = getIRMemoryUsage(*M);
+    Log << "  IR: instructions " << MB(Usage.Insts) << ", metadata "
+        << MB(Usage.Metadata) << ", value names " << MB(Usage.Names) << "\n";
+  }
+  if (Tracker)
+    Log << "  Instruction tracker: " << MB(Tracker->getMemoryUsage()) << "\n";
+}
+
+/// \brief Print in \p Log, for -quality-metrics, the translation quality: the
+/// \p IR written for the machine code of \p MCM, with its \p NumCallBBs call
+/// basic blocks, and the \p OptimizeSeconds it took to optimize.
+static void printQualityMetrics(raw_ostream &Log, uint64_t NumMCInsts,
+                                const InstCounts &IR, uint64_t NumCallBBs,
+                                double OptimizeSeconds) {
+  auto Ratio = [](uint64_t N, uint64_t D) {
+    return format("%.2f", D ? double(N) / D : 0.0);
+  };
+  Log << "Translation quality:\n"
+      << "  MC instructions: " << NumMCInsts << "\n"
+      << "  IR instructions: " << IR.NumInsts << " ("
+      << Ratio(IR.NumInsts, NumMCInsts) << " per MC instruction)\n"
+      << "  IR functions: " << IR.NumFunctions << "\n"
+      << "  allocas: " << IR.get(Instruction::Alloca) << " ("
+      << Ratio(IR.get(Instruction::Alloca), IR.NumFunctions)
+      << " per function)\n"
+      << "  call basic blocks: " << NumCallBBs << "\n"
+      << "  loads: " << IR.get(Instruction::Load) << ", stores: "
+      << IR.get(Instruction::Store) << "\n"
+      << "  FPM time: " << format("%.3f", OptimizeSeconds) << "s\n";
+}
+
+/// \brief Write \p Gaps to \p Filename, one range per line, and sum them up
+/// in \p Log.
+static bool
+writeCoverageReport(StringRef Filename,
+                    const MCObjectDisassembler::CoverageGapListTy &Gaps,
+                    raw_ostream &Log) {
+  typedef MCObjectDisassembler::CoverageGap CoverageGap;
+  std::error_code EC;
+  tool_output_file Out(Filename, EC, sys::fs::F_Text);
+  if (EC) {
+    Log << Filename << ": " << EC.message() << '\n';
+    return false;
+  }
+  raw_ostream &OS = Out.os();
+  uint64_t Bytes[CoverageGap::MissedFunction + 1] = {};
+  unsigned Count[CoverageGap::MissedFunction + 1] = {};
+  OS << "# begin end kind [code]\n";
+  for (const CoverageGap &Gap : Gaps) {
+    OS << "0x" << utohexstr(Gap.BeginAddr) << " 0x" << utohexstr(Gap.EndAddr)
+       << ' ' << MCObjectDisassembler::getCoverageGapKindName(Gap.Kind);
+    if (Gap.Kind == CoverageGap::MissedFunction)
+      OS << " 0x" << utohexstr(Gap.CodeAddr);
+    OS << '\n';
+    Bytes[Gap.Kind] += Gap.EndAddr - Gap.BeginAddr;
+    ++Count[Gap.Kind];
+  }
+  Out.keep();
+
+  Log << "Uncovered code:";
+  for (unsigned K = 0; K <= CoverageGap::MissedFunction; ++K)
+    Log << (K ? "," : "") << ' ' << Bytes[K] << " bytes of "
+        << MCObjectDisassembler::getCoverageGapKindName(
+               CoverageGap::KindTy(K))
+        << " in " << Count[K] << " ranges";
+  Log << '\n';
+  return true;
+}
+
+static bool writeTelemetry(StringRef Filename, StringRef InputFile,
+                           ArrayRef<std::pair<const char *, double>> Phases,
+                           ArrayRef<FunctionTelemetry> Functions,
+                           raw_ostream &Log) {
+  std::error_code EC;
+  tool_output_file Out(Filename, EC, sys::fs::F_Text);
+  if (EC) {
+    Log << Filename << ": " << EC.message() << '\n';
+    return false;
+  }
+  raw_ostream &OS = Out.os();
+  OS << "{\n  \"input\": ";
+  writeJSONString(OS, InputFile);
+  OS << ",\n  \"phases\": {";
+  for (size_t I = 0, E = Phases.size(); I != E; ++I)
+    OS << (I ? ", " : "") << '"' << Phases[I].first
+       << "\": " << format("%.6f", Phases[I].second);
+  OS << "},\n  \"functions\": [";
+  for (size_t I = 0, E = Functions.size(); I != E; ++I) {
+    const FunctionTelemetry &F = Functions[I];
+    OS << (I ? "," : "") << "\n    {\"address\": \"0x" << utohexstr(F.Addr)
+       << "\", \"name\": ";
+    writeJSONString(OS, F.Name);
+    OS << format(", \"decode\": %.6f, \"cfg\": %.6f, \"translate\": %.6f, "
+                 "\"optimize\": %.6f",
+                 F.MC.DecodeSeconds, F.MC.CFGSeconds, F.DC.TranslateSeconds,
+                 F.DC.OptimizeSeconds)
+       << ", \"mc_insts\": " << F.MC.NumInsts
+       << ", \"ir_insts\": " << F.DC.NumIRInsts
+       << ", \"malloc_bytes\": " << F.DC.MallocBytes << "}";
+  }
+  OS << "\n  ]\n}\n";
+  Out.keep();
+  return true;
+}
+
+namespace {
+/// \brief An input, mapped and parsed. With -slices, it is loaded once, and
+/// its slices are decompiled from it concurrently.
+struct LoadedInput {
+  std::unique_ptr<MemoryBuffer> Input;
+  /// \brief The member of an IPA, inflated.
+  std::unique_ptr<MemoryBuffer> IPAMemberBuf;
+  /// \brief A dyld shared cache, and its -dyld-cache-image image.
+  std::unique_ptr<DyldSharedCache> Cache;
+  std::unique_ptr<MachOObjectFile> CacheImage;
+  /// \brief Any other input, as universal binaries.
+  std::unique_ptr<Binary> Bin;
+};
+} // end anonymous namespace
+
+/// \brief Map and parse \p InputFile into \p In.
+static bool loadInput(StringRef InputFile, LoadedInput &In, raw_ostream &Log) {
+  // The input is mapped once, and never copied: the object file, and all that
+  // is built from it, only keep views of the mapping (or, for a compressed
+  // IPA member, of the buffer it is inflated into). Standard input is read
+  // into memory instead.
+  ErrorOr<std::unique_ptr<MemoryBuffer>> InputOrErr =
+      InputFile == "-" ? MemoryBuffer::getSTDIN()
+                       : MemoryBuffer::getFile(InputFile, -1,
+                                               /*RequiresNullTerminator=*/false);
+  if (std::error_code ec = InputOrErr.getError()) {
+    Log << ToolName << ": '" << InputFile << "': "
+        << ec.message() << ".\n";
+    return false;
+  }
+  In.Input = std::move(*InputOrErr);
+  MemoryBufferRef InputRef = In.Input->getMemBufferRef();
+
+  if (isZipArchive(InputRef.getBuffer())) {
+    auto MemberOrErr = extractIPAMember(InputRef, IPAMember);
+    if (std::error_code ec = MemberOrErr.getError()) {
+      Log << ToolName << ": '" << InputFile << "': "
+          << (IPAMember.empty() ? "main executable" : IPAMember.c_str())
+          << ": " << ec.message() << ".\n";
+      return false;
+    }
+    In.IPAMemberBuf = std::move(*MemberOrErr);
+    InputRef = In.IPAMemberBuf->getMemBufferRef();
+  }
+
+  // The images of a dyld shared cache are parsed in place, in the mapping of
+  // the whole cache; the stubs to the other images are resolved through it.
+  if (DyldSharedCache::isDyldSharedCache(InputRef.getBuffer())) {
+    auto CacheOrErr = DyldSharedCache::create(InputRef);
+    if (std::error_code ec = CacheOrErr.getError()) {
+      Log << ToolName << ": '" << InputFile << "': "
+          << ec.message() << ".\n";
+      return false;
+    }
+    In.Cache = std::move(*CacheOrErr);
+    const DyldSharedCache::Image *Img = In.Cache->findImage(DyldCacheImage);
+    if (!Img) {
+      Log << ToolName << ": '" << InputFile << "': "
+          << (DyldCacheImage.empty()
+                  ? "a dyld shared cache needs -dyld-cache-image"
+                  : "no image '" + DyldCacheImage + "' in the cache")
+          << ".\n";
+      return false;
+    }
+    auto ImageOrErr = In.Cache->createImageObject(*Img);
+    if (std::error_code ec = ImageOrErr.getError()) {
+      Log << ToolName << ": '" << InputFile << "': " << Img->Path
+          << ": " << ec.message() << ".\n";
+      return false;
+    }
+    In.CacheImage = std::move(*ImageOrErr);
+    return true;
+  }
+
+  ErrorOr<std::unique_ptr<Binary>> BinaryOrErr = createBinary(InputRef);
+  if (std::error_code ec = BinaryOrErr.getError()) {
+    Log << ToolName << ": '" << InputFile << "': "
+        << ec.message() << ".\n";
+    return false;
   }
+  In.Bin = std::move(*BinaryOrErr);
+  return true;
+}
+
+/// \brief Whether each input writes its reports beside its output, rather
+/// than to the files the options name.
+static bool hasManyOutputs() {
+  return !BatchFilename.empty() || ForkServer || !SliceArchs.empty();
+}
 
-  std::unique_ptr<const MCSubtargetInfo> STI(
-      TheTarget->createMCSubtargetInfo(TripleName, "", ""));
-  if (!STI) {
-    errs() << "error: no subtarget info for target " << TripleName << "\n";
+/// \brief Decompile the \p Arch slice of \p InputFile to \p OutputFile,
+/// logging to \p Log. The target semantics are taken from, or added to,
+/// \p Semas. The input is loaded, unless \p Shared already has it.
+/// \brief Answer the queries of -serve about \p MCM, until the end of stdin,
+/// or forever on a socket.
+static int serveQueries(const MCModule &MCM, const MCInstrAnalysis *MIA,
+                        const DCStubTargets &Stubs,
+                        const DCFunctionNameMap &Names,
+                        const ObjectiveCFile *ObjC, raw_ostream &Log) {
+  if (!MIA) {
+    Log << ToolName << ": -serve needs the instruction analysis of the "
+                       "target.\n";
     return 1;
   }
+  DCCallGraph CG;
+  buildCallGraph(MCM, *MIA, Stubs, Names, CG);
+
+  // Only the function bodies the queries are about are read.
+  LLVMContext Ctx;
+  std::unique_ptr<Module> Bitcode;
+  if (!ServeBitcode.empty()) {
+    SMDiagnostic Err;
+    Bitcode = getLazyIRFileModule(ServeBitcode, Err, Ctx);
+    if (!Bitcode) {
+      Err.print(ToolName.data(), Log);
+      return 1;
+    }
+  }
+
+  QueryServer Server(MCM, CG, ObjC, Bitcode.get());
+  if (ServePath == "-")
+    return Server.serve(0, 1) ? 0 : 1;
+  return Server.listen(ServePath, Log) ? 0 : 1;
+}
+
+/// \brief Diff the functions of \p MCM, named after \p Names, against those
+/// of the -diff-against tables, write the -diff-report, and add to
+/// \p Translated the start of the functions added or changed since.
+static bool diffAgainstTables(const MCModule &MCM, const MCInstrAnalysis &MIA,
+                              const DCStubTargets &Stubs,
+                              const DCFunctionNameMap &Names,
+                              StringRef OutputFile,
+                              DenseSet<uint64_t> &Translated,
+                              raw_ostream &Log) {
+  DCFunctionSignatures Old, New;
+  if (!readFunctionSignatures(DiffAgainst, Old, Log))
+    return false;
+  computeFunctionSignatures(MCM, MIA, Stubs, Names, New);
+  DCFunctionDiff Diff;
+  diffFunctions(Old, New, Diff);
+  Log << "Diff: " << Diff.Added.size() << " added, " << Diff.Removed.size()
+      << " removed, " << Diff.Changed.size() << " changed, "
+      << Diff.NumUnchanged << " unchanged functions\n";
+  if (!DiffReportFilename.empty()) {
+    const std::string Filename =
+        !hasManyOutputs() ? DiffReportFilename.getValue()
+                          : (OutputFile + ".diff").str();
+    if (!writeFunctionDiff(Filename, Old, New, Diff, Log))
+      return false;
+  }
+  for (unsigned I : Diff.Added)
+    Translated.insert(New[I].Addr);
+  for (const auto &OldNew : Diff.Changed)
+    Translated.insert(New[OldNew.second].Addr);
+  return true;
+}
+
+static int decompileInput(StringRef InputFile, StringRef OutputFile,
+                          StringRef Arch, TargetSemaCache &Semas,
+                          raw_ostream &Log,
+                          const LoadedInput *Shared = nullptr) {
+  TraceScope Trace("decompile", InputFile);
+  // The reports of a slice name it.
+  const std::string Label =
+      SliceArchs.empty() ? InputFile.str()
+                         : (InputFile + " (" + Arch + ")").str();
+  TimerGroup TG(!hasManyOutputs()
+                    ? "... llvm-dec module time report ..."
+                    : "... llvm-dec module time report: " + Label + " ...");
+
+  std::unique_ptr<ProgressReporter> Progress;
+  if (ProgressInterval || !ProgressFilename.empty()) {
+    std::string StatusFile = ProgressFilename;
+    if (!StatusFile.empty() && hasManyOutputs())
+      StatusFile = (OutputFile + ".progress").str();
+    Progress.reset(new ProgressReporter(
+        Label, ProgressInterval ? ProgressInterval : 10,
+        ProgressInterval != 0, StatusFile));
+  }
+
+  PhaseTimer BinLoadTimer("Bin load overhead", "load", InputFile, TG);
+  BinLoadTimer.startTimer();
+  LoadedInput OwnInput;
+  if (!Shared) {
+    if (!loadInput(InputFile, OwnInput, Log))
+      return 1;
+    Shared = &OwnInput;
+  }
+  DyldSharedCache *Cache = Shared->Cache.get();
+  BinLoadTimer.stopTimer();
 
-  std::unique_ptr<const MCInstrInfo> MII(TheTarget->createMCInstrInfo());
-  if (!MII) {
-    errs() << "error: no instruction info for target " << TripleName << "\n";
+  PhaseTimer MachOParseTimer("Mach-O parse overhead", "macho_parse",
+                             InputFile, TG);
+  MachOParseTimer.startTimer();
+  // Universal binaries: use the slice for \p Arch, in place.
+  std::unique_ptr<MachOObjectFile> Slice;
+  ObjectFile *Obj = Shared->CacheImage.get();
+  if (MachOUniversalBinary *UB =
+          dyn_cast_or_null<MachOUniversalBinary>(Shared->Bin.get())) {
+    auto SliceOrErr = UB->getObjectForArch(Arch);
+    if (std::error_code ec = SliceOrErr.getError()) {
+      Log << ToolName << ": '" << InputFile << "': " << Arch
+          << ": " << ec.message() << ".\n";
+      return 1;
+    }
+    Slice = std::move(*SliceOrErr);
+    Obj = Slice.get();
+  } else if (!Obj) {
+    Obj = dyn_cast_or_null<ObjectFile>(Shared->Bin.get());
+  }
+  if (!Obj) {
+    Log << ToolName << ": '" << InputFile << "': "
+        << "Unrecognized file type.\n";
     return 1;
   }
+  MachOParseTimer.stopTimer();
+
+  // The target description is shared by all inputs; what depends on the
+  // object, or keeps state while disassembling it, is created for it.
+  const DCDecompilerTarget *TS = getTargetSetup(Obj, Log);
+  if (!TS)
+    return 1;
+  const Target *TheTarget = &TS->getTarget();
+  const std::string &TheTripleName = TS->getTripleName();
+  const MCRegisterInfo &MRI = TS->getRegisterInfo();
+  const MCAsmInfo &MAI = TS->getAsmInfo();
+  const MCSubtargetInfo &STI = TS->getSubtargetInfo();
+  const MCInstrInfo &MII = TS->getInstrInfo();
+  const MCInstrAnalysis *MIA = TS->getInstrAnalysis();
 
   std::unique_ptr<const MCObjectFileInfo> MOFI(new MCObjectFileInfo);
-  MCContext Ctx(MAI.get(), MRI.get(), MOFI.get());
+  MCContext Ctx(&MAI, &MRI, MOFI.get());
 
   std::unique_ptr<MCDisassembler> DisAsm(
-      TheTarget->createMCDisassembler(*STI, Ctx));
+      TheTarget->createMCDisassembler(STI, Ctx));
   if (!DisAsm) {
-    errs() << "error: no disassembler for target " << TripleName << "\n";
+    Log << "error: no disassembler for target " << TheTripleName << "\n";
     return 1;
   }
 
   std::unique_ptr<MCDisassembler> DisAsmImpl;
+  MCCachingDisassembler *DisAsmCache = nullptr;
   if (EnableDisassemblyCache) {
     DisAsmImpl = std::move(DisAsm);
-    DisAsm.reset(new MCCachingDisassembler(*DisAsmImpl, *STI));
+    // AArch64 instructions are all 4 bytes wide.
+    const Triple::ArchType Arch = Triple(TheTripleName).getArch();
+    const bool FixedWidth =
+        Arch == Triple::aarch64 || Arch == Triple::aarch64_be;
+    DisAsmCache = new MCCachingDisassembler(*DisAsmImpl, STI, FixedWidth);
+    DisAsm.reset(DisAsmCache);
   }
 
-  std::unique_ptr<MCInstPrinter> MIP(
-      TheTarget->createMCInstPrinter(Triple(TripleName), 0, *MAI, *MII, *MRI));
+  std::unique_ptr<MCInstPrinter> MIP(TheTarget->createMCInstPrinter(
+      Triple(TheTripleName), 0, MAI, MII, MRI));
   if (!MIP) {
-    errs() << "error: no instprinter for target " << TripleName << "\n";
+    Log << "error: no instprinter for target " << TheTripleName << "\n";
     return 1;
   }
 
   std::unique_ptr<MCRelocationInfo> RelInfo(
-      TheTarget->createMCRelocationInfo(TripleName, Ctx));
+      TheTarget->createMCRelocationInfo(TheTripleName, Ctx));
   if (!RelInfo) {
-    errs() << "error: no relocation info for target " << TripleName << "\n";
+    Log << "error: no relocation info for target " << TheTripleName << "\n";
     return 1;
   }
   std::unique_ptr<MCObjectSymbolizer> MOS(
       TheTarget->createMCObjectSymbolizer(Ctx, *Obj, std::move(RelInfo)));
   if (!MOS) {
-    errs() << "error: no object symbolizer for target " << TripleName << "\n";
+    Log << "error: no object symbolizer for target " << TheTripleName << "\n";
     return 1;
   }
-  // FIXME: should we set the symbolizer on OD? maybe under a CLI option.
 
-  std::unique_ptr<const MCInstrAnalysis> MIA(
-      TheTarget->createMCInstrAnalysis(MII.get()));
+  // The bindings and the Objective-C and Swift metadata are needed to name
+  // functions, and to select them: they are parsed once, here.
+  MachOObjectFile *MachO = dyn_cast<MachOObjectFile>(Obj);
+  std::unique_ptr<MachOBindingIndex> Binds;
+  std::unique_ptr<ObjectiveCFile> ObjC;
+  std::unique_ptr<SwiftMetadataIndex> Swift;
+  // The stubs are resolved up front, so that calls to them are translated
+  // directly to calls to their targets.
+  DCStubTargets Stubs;
+  // The references to selectors, classes, CFStrings and GOT entries are
+  // translated to globals.
+  DCDataSectionList DataSections;
+  if (MachO) {
+    TraceScope Trace("objc", InputFile);
+    Binds.reset(new MachOBindingIndex(*MachO));
+    ObjC.reset(new ObjectiveCFile(MachO, Binds.get()));
+    Swift.reset(new SwiftMetadataIndex(*MachO));
+    resolveMachOStubs(*MachO, *Binds, *MOS, Stubs);
+    if (ResolveConstantCalls)
+      resolveMachOPointers(*MachO, *Binds, Stubs);
+    if (Cache)
+      resolveDyldCacheStubs(*MachO, *Cache, Stubs);
+    collectMachODataSections(*MachO, SectionGlobals, DataSections);
+    if (!StringsFilename.empty()) {
+      const std::string Filename =
+          !hasManyOutputs() ? StringsFilename.getValue()
+                            : (OutputFile + ".strings").str();
+      if (!writeStringsFile(Filename, *ObjC, Log))
+        return 1;
+    }
+  }
 
-  Timer *MCTimer = new Timer("MC overhead", TG);
-  MCTimer->startTimer();
+  PhaseTimer MCTimer("MC overhead", "cfg", InputFile, TG);
+  MCTimer.startTimer();
   std::unique_ptr<MCObjectDisassembler> OD(
       new MCObjectDisassembler(*Obj, *DisAsm, *MIA));
-  std::unique_ptr<MCModule> MCM(OD->buildModule());
-    
-  errs() << "Linear code size: " << utostr(OD->TextSegList.size()) << "\n";
-  errs() << "Recursive disassembled code size: " << utostr(OD->InstParsedList.size()) << "\n";
-  errs() << "None general operand code size: " << utostr(OD->NoneGeneralOperandList.size()) << "\n";
+  if (MCSymbolize)
+    OD->setSymbolizer(MOS.get());
+  OD->setScanFunctionStarts(ScanFunctionStarts);
+  // The generic disassembly cache isn't thread-safe.
+  if (DisAsmCache && !DisAsmCache->isThreadSafe() && MCJobs > 1)
+    Log << "warning: -mc-jobs is ignored with the disassembly cache\n";
+  else
+    OD->setNumJobs(MCJobs);
+  const bool WantTelemetry = !TelemetryFilename.empty() || TelemetryTop;
+  OD->setRecordFunctionStats(WantTelemetry);
+  ShardManifest Shard;
+  if (!setupFunctionSlice(*OD, *MOS, *Obj, ObjC.get(), Swift.get(), Shard,
+                          Log)) {
+    MCTimer.stopTimer();
+    return 1;
+  }
+  // The names of the functions only depend on the Objective-C and Swift
+  // metadata: they are built while the code is disassembled, and used by the
+  // translation.
+  PhaseTimer FuncTimer("Function naming overhead", "function_names",
+                       InputFile, TG);
+  DCFunctionNameMap FunctionNames;
+  DCObjCMessageIndex ObjCMessages;
+  std::thread NamingThread;
+  if (ObjC)
+    NamingThread = std::thread([&] {
+      TraceScope Trace("objc_names", InputFile);
+      buildFunctionNames(*ObjC, Swift.get(), FunctionNames);
+      buildObjCMessageIndex(*ObjC, ObjCMessages);
+    });
+  struct ThreadJoiner {
+    std::thread &T;
+    ~ThreadJoiner() {
+      if (T.joinable())
+        T.join();
+    }
+  } JoinNaming{NamingThread};
+  bool Fused = false;
+  if (FusedTranslation) {
+    if (const char *Conflict = getFusedTranslationConflict())
+      Log << ToolName << ": warning: -fused-translation is ignored with "
+          << Conflict << "\n";
+    else
+      Fused = true;
+  }
+  std::unique_ptr<MCModule> MCM;
+  std::string CheckpointFile, CheckpointTag, CheckpointBaseTag;
+  DCCodePageHashes PageHashes;
+  bool HasPageHashes = false;
+  if (!MCCheckpointDir.empty()) {
+    SmallString<128> Path(MCCheckpointDir);
+    // The slices of an input have a checkpoint each.
+    std::string Name = sys::path::filename(InputFile);
+    if (!SliceArchs.empty())
+      Name += "." + Arch.str();
+    sys::path::append(Path, Name + ".mccfg");
+    CheckpointFile = Path.str();
+    CheckpointBaseTag = TheTripleName + getFunctionSliceOptions();
+    if (Cache)
+      CheckpointBaseTag += " image=" + DyldCacheImage;
+    CheckpointTag = getCheckpointTag(*Obj, TheTripleName) +
+                    getFunctionSliceOptions();
+    if (Cache)
+      CheckpointTag += " image=" + DyldCacheImage;
+    loadMCCheckpoint(MCM, CheckpointFile, CheckpointTag, MII, MRI, Log);
+    if (MachO)
+      HasPageHashes = readCodePageHashes(*MachO, PageHashes);
+  }
+  if (!MCM) {
+  // A checkpoint of an earlier version of a signed object: the functions of
+  // the pages whose hash didn't change are copied from it.
+  std::unique_ptr<MCModule> PriorMCM;
+  std::vector<std::pair<uint64_t, uint64_t>> ChangedRanges;
+  if (HasPageHashes) {
+    std::string PriorTag;
+    DCCodePageHashes PriorPages;
+    if (readCheckpointPages(CheckpointFile + ".pages", CheckpointBaseTag,
+                            PriorTag, PriorPages) &&
+        findChangedCodeRanges(*MachO, PriorPages, PageHashes, ChangedRanges))
+      loadMCCheckpoint(PriorMCM, CheckpointFile, PriorTag, MII, MRI, Log);
+  }
+  if (PriorMCM) {
+    const MCFunctionRangeMap &Ranges = OD->getFunctionRanges();
+    OD->setPriorModule(PriorMCM.get(), [&](uint64_t BeginAddr) {
+      MCFunctionRangeMap::const_iterator It = Ranges.find(BeginAddr);
+      if (It == Ranges.end())
+        return false;
+      uint64_t EndAddr = Ranges.getEndAddr(It);
+      // The last function ends with its section.
+      for (const SectionRef &Section : MachO->sections()) {
+        const uint64_t SectAddr = Section.getAddress();
+        if (BeginAddr >= SectAddr &&
+            BeginAddr - SectAddr < Section.getSize()) {
+          EndAddr = std::min(EndAddr, SectAddr + Section.getSize());
+          break;
+        }
+      }
+      // The first changed range ending after the function must start after
+      // it.
+      auto Changed = std::upper_bound(
+          ChangedRanges.begin(), ChangedRanges.end(), BeginAddr,
+          [](uint64_t Addr, const std::pair<uint64_t, uint64_t> &R) {
+            return Addr < R.second;
+          });
+      return Changed == ChangedRanges.end() || Changed->first >= EndAddr;
+    });
+  }
+  {
+    ProgressPhase MCPhase(Progress.get(), "mc", OD->getProgress());
+    MCM.reset(Fused ? OD->buildLazyModule() : OD->buildModule());
+  }
+  if (PriorMCM)
+    Log << "Reused " << OD->getProgress().NumReusedFunctions << " of "
+        << OD->getProgress().NumFunctions
+        << " functions from the MC CFG checkpoint\n";
+  if (!CheckpointFile.empty()) {
+    saveMCCheckpoint(*MCM, CheckpointFile, CheckpointTag, MII, MRI, Log);
+    if (HasPageHashes)
+      writeCheckpointPages(CheckpointFile + ".pages", CheckpointBaseTag,
+                           CheckpointTag, PageHashes, Log);
+  }
+
+  Log << "Linear code size: " << utostr(OD->LinearCodeSize) << "\n";
+  Log << "Recursive disassembled code size: " << utostr(OD->InstParsedList.count()) << "\n";
+  Log << "None general operand code size: " << utostr(OD->NoneGeneralOperandList.count()) << "\n";
+  }
+  if (DisAsmCache && DisAsmCache->getNumLookups())
+    Log << "Disassembly cache hit rate: "
+        << format("%.2f", 100.0 * DisAsmCache->getNumHits() /
+                              DisAsmCache->getNumLookups())
+        << "% (" << DisAsmCache->getNumHits() << "/"
+        << DisAsmCache->getNumLookups() << ")\n";
+  if (uint64_t NumShared = OD->getProgress().NumSharedInsts)
+    Log << "Instructions shared between functions: " << NumShared << "\n";
 
 // to find the operands len distribution
 //    for (int i = 0; i < sizeof(OD->DisInstSize) / sizeof(unsigned int); i++)
 //        errs() << utostr(i) << " :" << utostr(OD->DisInstSize[i]) << "\n";
 
-//ugly coding, but I only find PackedVector support such kind of operation...
-//    for (size_t i = 0; i < OD->TextSegList.size(); ++i) {
-//      const uint64_t Addr = OD->TextSegList[i];
-//      if (OD->InstParsedList.count(Addr) == 0)
-//        errs() << "Cross check IDA for addr: 0x"<< utohexstr(Addr) << "\n";
-//    }
-        
-  MCTimer->stopTimer();
-//  delete MCTimer;
-    
+  MCTimer.stopTimer();
+  if (MemReport && MCM)
+    printMemoryReport(Log, "disassembly", MCM.get(), DisAsmCache, nullptr,
+                      nullptr);
+
+  if (!CoverageReportFilename.empty() && MCM) {
+    const std::string Filename =
+        !hasManyOutputs() ? CoverageReportFilename.getValue()
+                          : (OutputFile + ".coverage").str();
+    if (!writeCoverageReport(Filename, OD->findCoverageGaps(*MCM), Log))
+      return 1;
+  }
+
   /*
     add by -death
    */
@@ -269,25 +1780,64 @@ int main(int argc, char **argv) {
     uint32_t code_size;
     code_size = get_all_code_size(&(*MCM));
     if(MachOObjectFile *MachO = dyn_cast<MachOObjectFile>(Obj)){
-      std::unique_ptr<MCOptimization> MCOpt(new MCOptimization(&(*MCM),MachO));
-      MCOpt->try_to_optimize();
-      errs() << "None Semantic ARC code erased: " << utostr(MCOpt->getNoneSemanticARCCount()) << "\n";
-      errs() << "Semantic ARC code replaced: " << utostr(MCOpt->getSemanticARCCount()) << "\n";
+      std::unique_ptr<MCOptimization> MCOpt(new MCOptimization(&(*MCM),MachO,MII,MRI));
+      MCOpt->addDefaultPeepholes();
+      MCOpt->try_to_optimize(DCJobs);
+      MCOpt->printStatistics(Log);
     }
 
 //    errs()<<"all code size : "<<code_size<<"\n";
   }
 //    return 0;
   /*
-    add by -death end 
+    add by -death end
    */
   if (!MCM)
     return 1;
 
+  if (!ServePath.empty()) {
+    if (NamingThread.joinable())
+      NamingThread.join();
+    return serveQueries(*MCM, MIA, Stubs, FunctionNames, ObjC.get(), Log);
+  }
+
+  // The tables only need the MC CFG: the semantics aren't even set up.
+  if (MCOnly) {
+    if (!MIA) {
+      Log << ToolName << ": -mc-only needs the instruction analysis of the "
+                         "target.\n";
+      return 1;
+    }
+    if (NamingThread.joinable()) {
+      FuncTimer.startTimer();
+      NamingThread.join();
+      FuncTimer.stopTimer();
+    }
+    DCCallGraph CG;
+    buildCallGraph(*MCM, *MIA, Stubs, FunctionNames, CG);
+    if (!CallGraphFilename.empty()) {
+      const std::string Filename =
+          !hasManyOutputs() ? CallGraphFilename.getValue()
+                            : (OutputFile + ".callgraph").str();
+      if (!writeCallGraphFile(Filename, CG, Log))
+        return 1;
+    }
+    DenseSet<uint64_t> Changed;
+    if (!DiffAgainst.empty() &&
+        !diffAgainstTables(*MCM, *MIA, Stubs, FunctionNames, OutputFile,
+                           Changed, Log))
+      return 1;
+    if (NoPrint)
+      return 0;
+    if (!writeTriageTable(OutputFile, *MCM, *MIA, CG, Stubs, ObjC.get(), Log))
+      return 1;
+    return 0;
+  }
+
   TransOpt::Level TOLvl;
   switch (TransOptLevel) {
   default:
-    errs() << ToolName << ": invalid optimization level.\n";
+    Log << ToolName << ": invalid optimization level.\n";
     return 1;
   case 0: TOLvl = TransOpt::None; break;
   case 1: TOLvl = TransOpt::Less; break;
@@ -295,96 +1845,1239 @@ int main(int argc, char **argv) {
   case 3: TOLvl = TransOpt::Aggressive; break;
   }
 
-  // FIXME: should we have a non-default datalayout?
-  DataLayout DL("");
-  
+  const DataLayout &DL = TS->getDataLayout();
 
-  std::unique_ptr<DCRegisterSema> DRS(
-      TheTarget->createDCRegisterSema(TripleName, *MRI, *MII, DL));
-  if (!DRS) {
-    errs() << "error: no dc register sema for target " << TripleName << "\n";
-    return 1;
-  }
-  std::unique_ptr<DCInstrSema> DIS(
-      TheTarget->createDCInstrSema(TripleName, *DRS, *MRI, *MII));
-  if (!DIS) {
-    errs() << "error: no dc instruction sema for target " << TripleName << "\n";
+  DCDecompilerSession *Sema = getTargetSema(*TS, Semas, Log);
+  if (!Sema)
     return 1;
-  }
-   /*
-  add by -death 
-   */
-  getGlobalContext().setRecordOrNot(RecordAdd);
-  /*
-  add by -death end 
-   */
+  DCRegisterSema &DRS = Sema->getRegisterSema();
+  DCInstrSema &DIS = Sema->getInstrSema();
 
+  // Each input gets its own context: nothing is kept alive from one input to
+  // the next, and inputs translated concurrently don't share anything.
+  LLVMContext IRCtx;
   std::unique_ptr<DCTranslator> DT(
     new DCTranslator(
-                     getGlobalContext(),    /* LLVMContext */
+                     IRCtx,     /* LLVMContext */
                      DL,        /* DataLayout */
                      TOLvl,     /* TransOpt::Level */
-                     *DIS,      /* DCInstrSema */
-                     *DRS,      /* DCRegisterSema */
+                     DIS,       /* DCInstrSema */
+                     DRS,       /* DCRegisterSema */
                      *MIP,      /* MCInstPrinter */
-                     *STI,      /* MCSubtargetInfo */
+                     STI,       /* MCSubtargetInfo */
                      *MCM,      /* MCModule */
                      OD.get(),  /* MCObjectDisassembler */
                      AnnotateIROutput   /* EnableIRAnnotation */
                      ));
 
-  if (!TranslationEntrypoint)
-    TranslationEntrypoint = MOS->getEntrypoint();   /* MCObjectSymbolizer */
+  if (DCJobs > 1 || TranslationCache || IsolateWorkers) {
+    if (AnnotateIROutput)
+      Log << ToolName << ": warning: -dc-jobs, -dc-cache and -dc-isolate are "
+             "ignored with IR annotations\n";
+    DT->setNumJobs(DCJobs, [&](std::unique_ptr<DCRegisterSema> &WorkerDRS) {
+      WorkerDRS.reset(
+          TheTarget->createDCRegisterSema(TheTripleName, MRI, MII, DL));
+      std::unique_ptr<DCInstrSema> WorkerDIS;
+      if (WorkerDRS)
+        WorkerDIS.reset(
+            TheTarget->createDCInstrSema(TheTripleName, *WorkerDRS, MRI, MII));
+      return WorkerDIS;
+    });
+  }
+  if (TranslationCache)
+    DT->setTranslationCache(TranslationCache.get(), TheTripleName);
+  DT->setProcessIsolation(IsolateWorkers);
+  DT->setRecordFunctionStats(WantTelemetry);
+  DT->setReleaseMCInsts(FreeMCInsts || MaxMemory > 0);
+  DT->setStubTargets(&Stubs);
+  // The output isn't run: the external functions only need declarations.
+  DT->setExternalWrappers(false);
+  DT->setDataSections(&DataSections);
+  // Only wait for the names now: the time spent waiting is their overhead.
+  if (NamingThread.joinable()) {
+    FuncTimer.startTimer();
+    NamingThread.join();
+    FuncTimer.stopTimer();
+  }
+  DT->setFunctionNames(&FunctionNames);
+  DT->setObjCMessageIndex(&ObjCMessages);
+  // The outliner only extracts short sequences.
+  static const unsigned MaxOutlinedInsts = 32;
+  DenseSet<uint64_t> OutlinedFunctions;
+  if (InlineOutlined && MIA) {
+    Log << "Outlined fragments: "
+        << findOutlinedFunctions(*MCM, *MIA, Stubs, MaxOutlinedInsts,
+                                 OutlinedFunctions)
+        << "\n";
+    DT->setInlinedFunctions(&OutlinedFunctions);
+  }
+  // The smaller functions are too common to be told apart.
+  static const unsigned MinFingerprintInsts = 8;
+  if (!FingerprintsFilename.empty() && MIA) {
+    const std::string Filename =
+        !hasManyOutputs() ? FingerprintsFilename.getValue()
+                          : (OutputFile + ".fingerprints").str();
+    if (!writeFunctionFingerprints(Filename, *MCM, *MIA, Stubs, FunctionNames,
+                                   MinFingerprintInsts, Log))
+      return 1;
+  }
+  // Before the known functions are named: the diff matches the names of the
+  // binary.
+  DenseSet<uint64_t> DiffFunctions;
+  const bool Diffing = !DiffAgainst.empty() && MIA;
+  if (Diffing && !diffAgainstTables(*MCM, *MIA, Stubs, FunctionNames,
+                                    OutputFile, DiffFunctions, Log))
+    return 1;
+  DenseSet<uint64_t> KnownFunctions;
+  if (!KnownFunctionsFilename.empty() && MIA) {
+    DCKnownFunctionMap Known;
+    if (!readKnownFunctions(KnownFunctionsFilename, Known, Log))
+      return 1;
+    Log << "Known functions: "
+        << matchKnownFunctions(*MCM, *MIA, Stubs, Known, MinFingerprintInsts,
+                               KnownFunctions, FunctionNames)
+        << "\n";
+  }
+  // A thunk is no smaller than the shortest functions.
+  static const unsigned MinIdenticalInsts = 4;
+  DenseMap<uint64_t, uint64_t> IdenticalFunctions;
+  if (MergeIdentical && MIA)
+    Log << "Identical functions: "
+        << findIdenticalFunctions(*MCM, *MIA, MinIdenticalInsts,
+                                  IdenticalFunctions)
+        << "\n";
+  DenseMap<uint64_t, DCObjCAccessor> ObjCAccessors;
+  if (SynthesizeObjCAccessors && ObjC) {
+    DenseSet<uint64_t> Methods;
+    for (const auto &M : ObjC->getMethods())
+      Methods.insert(M.IMP);
+    for (const auto &MCFN : MCM->funcs()) {
+      DCObjCAccessor A;
+      if (!MCFN->empty() &&
+          Methods.count(MCFN->getEntryBlock()->getStartAddr()) &&
+          DIS.matchObjCAccessor(*MCFN, A))
+        ObjCAccessors[MCFN->getEntryBlock()->getStartAddr()] = A;
+    }
+    Log << "Objective-C accessors: " << ObjCAccessors.size() << "\n";
+  }
+  if (Diffing || !KnownFunctions.empty() || !IdenticalFunctions.empty() ||
+      !ObjCAccessors.empty())
+    DT->setFunctionFilter([&](uint64_t Addr) {
+      return (!Diffing || DiffFunctions.count(Addr)) &&
+             !KnownFunctions.count(Addr) && !IdenticalFunctions.count(Addr) &&
+             !ObjCAccessors.count(Addr);
+    });
+  // The calls are found in the instructions, before they are released.
+  if (!CallGraphFilename.empty() && MIA) {
+    const std::string Filename =
+        !hasManyOutputs() ? CallGraphFilename.getValue()
+                          : (OutputFile + ".callgraph").str();
+    DCCallGraph CG;
+    buildCallGraph(*MCM, *MIA, Stubs, FunctionNames, CG);
+    if (!writeCallGraphFile(Filename, CG, Log))
+      return 1;
+  }
+  DCCallSummaries Summaries;
+  if (CallSummaries && MIA) {
+    TraceScope Trace("call_summaries", InputFile);
+    Summaries.compute(*MCM, *MIA, DRS, &Stubs, DCJobs);
+    DT->setCallSummaries(&Summaries);
+  }
+  if (ElideCalleeSaved && MIA)
+    DT->setCalleeSavedSpillAnalysis(MIA);
+  if (CollapseMemoryTransfers && MIA)
+    DT->setMemoryTransferAnalysis(MIA);
+  if (ResolveConstantCalls && MIA)
+    DT->setConstantCallAnalysis(MIA);
+  // The instructions are gone once translated.
+  uint64_t NumMCInsts = 0;
+  if (QualityMetrics)
+    for (const auto &MCFN : MCM->funcs())
+      for (const MCBasicBlock *BB : *MCFN)
+        NumMCInsts += BB->size();
+
+  // Nothing reads the instructions before the translation anymore: they
+  // only take memory until then.
+  if (PackMCInsts) {
+    TraceScope Trace("pack_mc_insts", InputFile);
+    for (const auto &MCFN : MCM->funcs())
+      MCFN->packInsts();
+  }
+
+  uint64_t Entrypoint = TranslationEntrypoint;
+  if (!Entrypoint)
+    Entrypoint = MOS->getEntrypoint();   /* MCObjectSymbolizer */
+
+  std::unique_ptr<tool_output_file> TableOut;
+  if (!AddrTableFilename.empty()) {
+    std::error_code EC;
+    TableOut.reset(
+        new tool_output_file(AddrTableFilename, EC, sys::fs::F_Text));
+    if (EC) {
+      Log << EC.message() << '\n';
+      return -1;
+    }
+  }
+
+  // The call sites of all the modules, sorted once they are all written.
+  std::unique_ptr<tool_output_file> MessageTableOut;
+  std::vector<DCObjCMessageSite> MessageSites;
+  if (!ObjCMessageTableFilename.empty()) {
+    std::error_code EC;
+    MessageTableOut.reset(
+        new tool_output_file(ObjCMessageTableFilename, EC, sys::fs::F_Text));
+    if (EC) {
+      Log << EC.message() << '\n';
+      return -1;
+    }
+  }
+
+  Timer SaveBinTimer("Bin save overhead", TG);
+  // What -quality-metrics counts of the modules, once optimized.
+  InstCounts IRCounts;
+  uint64_t NumCallBBs = 0;
+
+  // With -shard, the modules, and the functions they define and declare, are
+  // listed in <output>.manifest, for -merge-shards.
+  const bool WantManifest = !ShardSpec.empty() && !NoPrint;
+  if (WantManifest && (OutputFile.empty() || OutputFile == "-")) {
+    Log << ToolName << ": -shard needs an output file.\n";
+    return 1;
+  }
+
+  // Account for the current module M, and strip it, before it is written.
+  auto PrepareModule = [&](Module &M) {
+    if (QualityMetrics) {
+      IRCounts.add(M);
+      NumCallBBs += DIS.getCallBasicBlocks().size();
+    }
+    if (MemReport)
+      printMemoryReport(Log, "output", MCM.get(), DisAsmCache, &M,
+                        AnnotateIROutput ? &DT->getTranslatedInstTracker()
+                                         : nullptr);
+
+    if (TableOut)
+      writeDCAddressTable(M, TableOut->os());
+    if (MessageTableOut)
+      collectDCObjCMessageSites(M, MessageSites);
+    if (StripAddrTags)
+      stripDCInstAddresses(M);
+  };
+
+  // Print M, as bitcode with -bc.
+  auto PrintModule = [&](Module &M, raw_ostream &OS) {
+    if (PrintBitcode) {
+      SaveBinTimer.startTimer();
+      WriteBitcodeToFile(&M, OS, /*ShouldPreserveUseListOrder=*/true,
+                         PrintJobs ? PrintJobs : DCJobs);
+      SaveBinTimer.stopTimer();
+    } else {
+      M.printInParallel(OS, PrintJobs ? PrintJobs : DCJobs);
+    }
+  };
+
+  // Write the current module M to Filename.
+  auto FinishModule = [&](Module &M, StringRef Filename) {
+    PrepareModule(M);
+    if (NoPrint)
+      return true;
+    if (WantManifest) {
+      Shard.Modules.push_back(sys::path::filename(Filename));
+      for (const auto &AddrFn : DT->getFunctions())
+        (AddrFn.second->isDeclaration() ? Shard.Declared
+                                        : Shard.Defined)[AddrFn.first] =
+            AddrFn.second->getName();
+    }
+    TraceScope Trace("write", Filename);
+    std::error_code EC;
+    sys::fs::OpenFlags OpenFlags = sys::fs::F_None;
+    if (!PrintBitcode && !CompressOutput)
+      OpenFlags |= sys::fs::F_Text;
+    tool_output_file FDOut(Filename, EC, OpenFlags);
+    if (EC) {
+      Log << EC.message() << '\n';
+      return false;
+    }
+    if (CompressOutput) {
+      raw_gzip_ostream GzOut(FDOut.os(), PrintJobs ? PrintJobs : DCJobs,
+                             CompressLevel);
+      PrintModule(M, GzOut);
+      if (!GzOut.finish()) {
+        Log << Filename << ": compression failed\n";
+        return false;
+      }
+    } else {
+      PrintModule(M, FDOut.os());
+    }
+    FDOut.keep();
+    //DT->printCurrentModule(FDOut.os());
+    return true;
+  };
+
+  // With -stream-*, the modules are written as <output>.<i>.ll (or .bc) as
+  // they fill up. The index lists the functions each one defines:
+  //   <hex address> <module file> <function name>
+  const bool Streaming = isStreaming();
+  std::unique_ptr<tool_output_file> IndexOut;
+  // The journal isn't removed on crashes: it is left for -resume.
+  const std::string JournalFile = (OutputFile + ".journal").str();
+  std::unique_ptr<raw_fd_ostream> JournalOut;
+  // Forget the journal in the crash handlers before closing it.
+  struct CrashJournalReset {
+    ~CrashJournalReset() { CrashJournalFD = -1; }
+  } ResetCrashJournal;
+  StreamJournal Journal;
+  unsigned NumStreamed = 0;
+  bool StreamFailed = false;
+  bool EntrypointStreamed = false;
+  // With -stream-to, the modules are sent downstream instead.
+  ShardPipe Pipe;
+  const bool Piped = Streaming && !StreamTo.empty() && !NoPrint;
+  auto StreamModule = [&](Module &M) {
+    const std::string Filename = (OutputFile + "." + Twine(NumStreamed++) +
+                                  getModuleExtension()).str();
+    if (Function *F = DT->getFunctionAt(Entrypoint))
+      EntrypointStreamed |= !F->isDeclaration();
+    // Index the functions before they are renamed.
+    std::vector<std::pair<uint64_t, Function *>> Functions;
+    for (const auto &AddrFn : DT->getFunctions())
+      if (!AddrFn.second->isDeclaration())
+        Functions.push_back(AddrFn);
+    std::sort(Functions.begin(), Functions.end(),
+              [](const std::pair<uint64_t, Function *> &L,
+                 const std::pair<uint64_t, Function *> &R) {
+                return L.first < R.first;
+              });
+    if (Piped) {
+      PrepareModule(M);
+      TraceScope Trace("send", Filename);
+      std::string Data;
+      {
+        raw_string_ostream OS(Data);
+        PrintModule(M, OS);
+      }
+      if (!Pipe.send(NumStreamed - 1,
+                     Functions.empty() ? 0 : Functions.front().first,
+                     Functions.empty() ? 0 : Functions.back().first,
+                     Functions.size(), Data, Log))
+        StreamFailed = true;
+      return;
+    }
+    if (!FinishModule(M, Filename)) {
+      StreamFailed = true;
+      return;
+    }
+    if (!IndexOut)
+      return;
+    for (const auto &AddrFn : Functions) {
+      const std::string IndexLine =
+          (utohexstr(AddrFn.first) + " " + sys::path::filename(Filename) +
+           " " + AddrFn.second->getName()).str();
+      IndexOut->os() << IndexLine << '\n';
+      if (JournalOut)
+        *JournalOut << "F " << IndexLine << '\n';
+    }
+    if (JournalOut)
+      *JournalOut << "M " << (NumStreamed - 1) << '\n';
+  };
+  if (Piped && !Pipe.open(StreamTo, Log))
+    return -1;
+  if (Streaming) {
+    if (!NoPrint && !Piped) {
+      if (OutputFile.empty() || OutputFile == "-") {
+        Log << ToolName << ": -stream-functions, -stream-insts and "
+               "-max-memory need an output file.\n";
+        return 1;
+      }
+      std::error_code EC;
+      IndexOut.reset(new tool_output_file((OutputFile + ".index").str(), EC,
+                                          sys::fs::F_Text));
+      if (EC) {
+        Log << EC.message() << '\n';
+        return -1;
+      }
+
+      if (Resume)
+        readStreamJournal(JournalFile, Journal);
+      // Start the journal over with what it keeps of the earlier runs.
+      int FD;
+      if ((EC = sys::fs::openFileForWrite(JournalFile, FD, sys::fs::F_Text))) {
+        Log << JournalFile << ": " << EC.message() << '\n';
+        return -1;
+      }
+      JournalOut.reset(new raw_fd_ostream(FD, /*shouldClose=*/true,
+                                          /*unbuffered=*/true));
+      for (const std::string &IndexLine : Journal.IndexLines) {
+        IndexOut->os() << IndexLine << '\n';
+        *JournalOut << "F " << IndexLine << '\n';
+      }
+      if (Journal.NumModules)
+        *JournalOut << "M " << (Journal.NumModules - 1) << '\n';
+      for (uint64_t Addr : Journal.Crashed) {
+        Log << ToolName << ": skipping fn_" << utohexstr(Addr)
+            << ", which crashed an earlier run\n";
+        *JournalOut << "Q " << utohexstr(Addr) << '\n';
+      }
+      if (Resume && Journal.NumModules)
+        Log << ToolName << ": resuming after " << Journal.Written.size()
+            << " functions, in " << Journal.NumModules << " modules\n";
+      NumStreamed = Journal.NumModules;
+      if (WantManifest) {
+        // The modules of the earlier runs are part of the shard.
+        for (unsigned I = 0; I != Journal.NumModules; ++I)
+          Shard.Modules.push_back(
+              (sys::path::filename(OutputFile) + "." + Twine(I) +
+               getModuleExtension()).str());
+        for (StringRef IndexLine : Journal.IndexLines) {
+          SmallVector<StringRef, 3> Fields;
+          IndexLine.split(Fields, " ", 2);
+          uint64_t Addr;
+          if (Fields.size() == 3 && !Fields[0].getAsInteger(16, Addr))
+            Shard.Defined[Addr] = Fields[2];
+        }
+      }
+      EntrypointStreamed = Journal.Written.count(Entrypoint);
+      if (!Journal.Written.empty() || !Journal.Crashed.empty())
+        DT->setFunctionFilter([&](uint64_t Addr) {
+          return !Journal.Written.count(Addr) && !Journal.Crashed.count(Addr) &&
+                 !KnownFunctions.count(Addr) &&
+                 !IdenticalFunctions.count(Addr) && !ObjCAccessors.count(Addr);
+        });
+      CrashJournalFD = FD;
+    }
+    DT->setModuleStreaming(StreamFunctions, uint64_t(StreamInsts) * 1000,
+                           StreamModule);
+    if (MaxMemory > 0)
+      DT->setModuleStreamingMemoryLimit(uint64_t(MaxMemory * (1 << 30)),
+                                        getResidentBytes);
+  }
 
-    Timer *DCTimer = new Timer("DC overhead", TG);
-    DCTimer->startTimer();
+    PhaseTimer DCTimer("DC overhead", "dc", InputFile, TG);
+    DCTimer.startTimer();
 //  DT->createMainFunctionWrapper(
-//      DT->translateRecursivelyAt(TranslationEntrypoint));
-    DT->translateAllKnownFunctions();
-    Function *main_fn = DT->getCurrentTranslationModule()->getFunction("fn_" + utohexstr(TranslationEntrypoint));
-    DCTimer->stopTimer();
- 
-    Timer *FuncTimer = new Timer("FunctionNamePass overhead", TG);
-    FuncTimer->startTimer();
+//      DT->translateRecursivelyAt(Entrypoint));
+    {
+        ProgressPhase DCPhase(Progress.get(), "dc", DT->getProgress());
+        if (Fused)
+          DT->translateAllFunctionsFused();
+        else
+          DT->translateAllKnownFunctions();
+    }
+    // The known functions only have a declaration, even when not called.
+    for (uint64_t Addr : KnownFunctions)
+        DT->getOrDeclareFunctionAt(Addr);
+    // The identical functions call the one that was translated, in address
+    // order.
+    {
+        std::vector<std::pair<uint64_t, uint64_t>> Thunks(
+            IdenticalFunctions.begin(), IdenticalFunctions.end());
+        std::sort(Thunks.begin(), Thunks.end());
+        for (const auto &Thunk : Thunks)
+            DT->createThunkFunction(Thunk.first, Thunk.second);
+    }
+    // So are the accessors.
+    {
+        std::vector<std::pair<uint64_t, DCObjCAccessor>> Accessors(
+            ObjCAccessors.begin(), ObjCAccessors.end());
+        std::sort(Accessors.begin(), Accessors.end(),
+                  [](const std::pair<uint64_t, DCObjCAccessor> &L,
+                     const std::pair<uint64_t, DCObjCAccessor> &R) {
+                      return L.first < R.first;
+                  });
+        for (const auto &Accessor : Accessors)
+            DT->createObjCAccessorFunction(Accessor.first, Accessor.second);
+    }
+    DIS.printUnknownInstSummary(Log);
+    for (uint64_t Addr : DT->getCrashedFunctions())
+        Log << ToolName << ": translation of fn_" << utohexstr(Addr)
+            << " crashed, it is replaced by a trap\n";
+    for (uint64_t Addr : DT->getOverBudgetFunctions())
+        Log << ToolName << ": translation of fn_" << utohexstr(Addr)
+            << " ran out of the -dc-function-budget, its other blocks trap\n";
+    for (uint64_t Addr : DT->getFlattenedFunctions())
+        Log << ToolName << ": fn_" << utohexstr(Addr)
+            << " looks flattened, it only ran the -dc-large-function-passes\n";
+    if (TranslationCache && !AnnotateIROutput)
+        Log << ToolName << ": reused " << DT->getNumCachedFunctions() << " of "
+            << (MCM->func_end() - MCM->func_begin()) << " function translations\n";
+    Function *main_fn = DT->getFunctionAt(Entrypoint);
+    // The entrypoint can be defined in a module that was already written.
+    if (!main_fn && EntrypointStreamed)
+        main_fn = DT->getOrDeclareFunctionAt(Entrypoint);
+    DCTimer.stopTimer();
+    if (MemReport)
+        printMemoryReport(Log, "translation", MCM.get(), DisAsmCache,
+                          DT->getCurrentTranslationModule(),
+                          AnnotateIROutput ? &DT->getTranslatedInstTracker()
+                                           : nullptr);
+
 //    assert(main_fn);
-    if (main_fn)
+    // Only the shard of the entrypoint has the wrapper, or they would all
+    // define main.
+    if (main_fn && Shard.Begin <= Entrypoint && Entrypoint < Shard.End)
         DT->createMainFunctionWrapper(main_fn);
 
-    if (MachOObjectFile *MachO = dyn_cast<MachOObjectFile>(Obj)) {
-        legacy::PassManager *pm = new legacy::PassManager();
-        MCObjectDisassembler::AddressSetTy functionStarts = OD->findFunctionStarts();
-//        pm->add(new TailCallPass(functionStarts));
-        pm->add(new FunctionNamePass(MachO, DisAsm));
-        pm->run(*DT->getCurrentTranslationModule());
-    }
-    FuncTimer->stopTimer();
-    
-    if (!NoPrint) {
-        std::error_code EC;
-        sys::fs::OpenFlags OpenFlags = sys::fs::F_None;
-        if (!Binary)
-            OpenFlags |= sys::fs::F_Text;
-        std::unique_ptr<tool_output_file> FDOut = llvm::make_unique<tool_output_file>(OutputFilename, EC,
-                                                         OpenFlags);
-        if (EC) {
-            errs() << EC.message() << '\n';
+    if (Streaming) {
+        StreamModule(*DT->getCurrentTranslationModule());
+        if (StreamFailed)
             return -1;
+        if (IndexOut)
+            IndexOut->keep();
+        // The run is complete: there is nothing left to resume.
+        if (JournalOut) {
+            CrashJournalFD = -1;
+            JournalOut.reset();
+            sys::fs::remove(JournalFile);
         }
-        
-
-        if (PrintBitcode) {
-            Timer *SaveBinTimer = new Timer("Bin save overhead", TG);
-            SaveBinTimer->startTimer();
-            WriteBitcodeToFile(DT->getCurrentTranslationModule(), FDOut->os(), true);
-            SaveBinTimer->stopTimer();
-        } else {
-            FDOut->os() << *DT->getCurrentTranslationModule();
+    } else if (!FinishModule(*DT->getCurrentTranslationModule(),
+                             OutputFile)) {
+        return -1;
+    }
+    if (WantManifest) {
+        // Streamed modules declare the functions of the earlier ones.
+        for (const auto &AddrName : Shard.Defined)
+            Shard.Declared.erase(AddrName.first);
+        if (!Shard.write((OutputFile + ".manifest").str(), Log))
+            return -1;
+    }
+    if (TableOut)
+        TableOut->keep();
+    if (MessageTableOut) {
+        writeDCObjCMessageTable(MessageSites, MessageTableOut->os());
+        MessageTableOut->keep();
+    }
+    if (QualityMetrics)
+        printQualityMetrics(Log, NumMCInsts, IRCounts, NumCallBBs,
+                            DT->getOptimizeSeconds());
+
+    if (!WantTelemetry)
+        return 0;
+    // Functions are only in the MC stats if they were disassembled here, and
+    // in the DC stats if they were translated here, not taken from a cache.
+    std::map<uint64_t, FunctionTelemetry> FuncTelemetry;
+    for (const auto &AddrStats : OD->getFunctionStats()) {
+        FunctionTelemetry &FT = FuncTelemetry[AddrStats.first];
+        FT.MC = AddrStats.second;
+    }
+    for (const DCTranslator::FunctionStats &Stats : DT->getFunctionStats())
+        FuncTelemetry[Stats.Addr].DC = Stats;
+    std::vector<FunctionTelemetry> Functions;
+    for (auto &AddrFT : FuncTelemetry) {
+        FunctionTelemetry &FT = AddrFT.second;
+        FT.Addr = AddrFT.first;
+        FT.DC.Addr = FT.Addr;
+        // Streamed out functions are gone, but had the same name.
+        if (Function *F = DT->getFunctionAt(FT.Addr))
+            FT.Name = F->getName();
+        else
+            FT.Name = DIS.getFunctionName(FT.Addr);
+        Functions.push_back(std::move(FT));
+    }
+
+    if (!TelemetryFilename.empty()) {
+        const std::pair<const char *, double> Phases[] = {
+            {"bin_load", BinLoadTimer.getSeconds()},
+            {"macho_parse", MachOParseTimer.getSeconds()},
+            {"mc", MCTimer.getSeconds()},
+            {"dc", DCTimer.getSeconds()},
+            {"function_names", FuncTimer.getSeconds()}};
+        const std::string Filename =
+            !hasManyOutputs() ? TelemetryFilename.getValue()
+                              : (OutputFile + ".telemetry.json").str();
+        if (!writeTelemetry(Filename, InputFile, Phases, Functions, Log))
+            return -1;
+    }
+
+    if (TelemetryTop) {
+        const size_t N = std::min<size_t>(TelemetryTop, Functions.size());
+        std::partial_sort(Functions.begin(), Functions.begin() + N,
+                          Functions.end(),
+                          [](const FunctionTelemetry &L,
+                             const FunctionTelemetry &R) {
+                              return L.getTotalSeconds() > R.getTotalSeconds();
+                          });
+        Log << "Slowest functions (decode, cfg, translate, optimize):\n";
+        for (size_t I = 0; I != N; ++I) {
+            const FunctionTelemetry &F = Functions[I];
+            Log << format("  %9.6fs (%.6f, %.6f, %.6f, %.6f) %6u insts  ",
+                          F.getTotalSeconds(), F.MC.DecodeSeconds,
+                          F.MC.CFGSeconds, F.DC.TranslateSeconds,
+                          F.DC.OptimizeSeconds, F.MC.NumInsts)
+                << F.Name << "\n";
         }
+    }
+  return 0;
+}
+
+/// \brief Compute, in \p Hash, what identifies the output of \p InputFile: its
+/// contents, the options, and the llvm-dec executable itself, by size and
+/// modification time. The names of the input and of the output aren't part of
+/// it, so that the output cache works for any of them.
+/// For universal binaries and IPAs, the slice or the member to decompile
+/// is picked by option: the whole input is hashed, which doesn't need to
+/// parse it.
+static bool getOutputHash(StringRef InputFile, std::string &Hash) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> InputOrErr = MemoryBuffer::getFile(
+      InputFile, -1, /*RequiresNullTerminator=*/false);
+  if (!InputOrErr)
+    return false;
+
+  MD5 H;
+  sys::fs::file_status Tool;
+  if (!sys::fs::status(sys::fs::getMainExecutable(
+                           ToolName.data(), (void *)&getOutputHash),
+                       Tool)) {
+    H.update(utostr(Tool.getSize()));
+    H.update(StringRef("\0", 1));
+    H.update(utostr(Tool.getLastModificationTime().toEpochTime()));
+    H.update(StringRef("\0", 1));
+  }
+  // The options that don't change the output are left out.
+  for (size_t I = 0, E = ToolArgs.size(); I != E; ++I) {
+    StringRef Arg = ToolArgs[I];
+    if (Arg == InputFilename)
+      continue;
+    StringRef Name =
+        Arg.startswith("-") ? Arg.ltrim("-").split('=').first : StringRef();
+    if (Name == "skip-unchanged")
+      continue;
+    if (Name == "o" || Name == "output-cache" || Name == "telemetry" ||
+        Name == "telemetry-top") {
+      // The value is the next argument, unless given with '='.
+      if (!Arg.count('='))
+        ++I;
+      continue;
+    }
+    H.update(Arg);
+    H.update(StringRef("\0", 1));
+  }
+  H.update((*InputOrErr)->getBuffer());
 
-        FDOut->keep();
-        //DT->printCurrentModule(FDOut->os());
+  MD5::MD5Result Result;
+  H.final(Result);
+  SmallString<32> Str;
+  MD5::stringifyResult(Result, Str);
+  Hash = Str.str();
+  return true;
+}
+
+/// \brief Replace \p To by a hard link to \p From, or by a copy of it, if it
+/// can't be linked, as across file systems.
+static bool linkOrCopyFile(StringRef From, StringRef To) {
+  sys::fs::remove(To);
+  return !sys::fs::create_hard_link(From, To) ||
+         !sys::fs::copy_file(From, To);
+}
+
+/// \brief Decompile \p InputFile to \p OutputFile, as decompileInput, unless
+/// -skip-unchanged or -output-cache find the output was already written.
+static int decompileFile(StringRef InputFile, StringRef OutputFile,
+                         TargetSemaCache &Semas, raw_ostream &Log) {
+  std::string Hash;
+  if ((!SkipUnchanged && OutputCacheDir.empty()) || NoPrint ||
+      OutputFile.empty() || OutputFile == "-" ||
+      !getOutputHash(InputFile, Hash))
+    return decompileInput(InputFile, OutputFile, ArchName, Semas, Log);
 
+  // With -stream-*, the index is only written once all the modules are.
+  const bool Streaming = isStreaming();
+  const std::string HashFile = (OutputFile + ".hash").str();
+  const std::string WrittenFile =
+      Streaming ? (OutputFile + ".index").str() : OutputFile.str();
+  if (SkipUnchanged && sys::fs::exists(WrittenFile) &&
+      (AddrTableFilename.empty() || sys::fs::exists(AddrTableFilename))) {
+    ErrorOr<std::unique_ptr<MemoryBuffer>> OldHash =
+        MemoryBuffer::getFile(HashFile);
+    if (OldHash && (*OldHash)->getBuffer().trim() == Hash) {
+      Log << ToolName << ": '" << OutputFile << "' is up to date.\n";
+      return 0;
+    }
+  }
+
+  auto WriteHash = [&]() {
+    std::error_code EC;
+    tool_output_file HashOut(HashFile, EC, sys::fs::F_Text);
+    if (EC) {
+      Log << HashFile << ": " << EC.message() << '\n';
+      return;
+    }
+    HashOut.os() << Hash << '\n';
+    HashOut.keep();
+  };
 
+  std::string CachedFile;
+  if (!OutputCacheDir.empty() && !Streaming && AddrTableFilename.empty()) {
+    SmallString<128> Path(OutputCacheDir);
+    sys::path::append(Path, Hash + getOutputExtension());
+    CachedFile = Path.str();
+    if (sys::fs::exists(CachedFile) && linkOrCopyFile(CachedFile, OutputFile)) {
+      Log << ToolName << ": '" << OutputFile
+          << "' is taken from the output cache.\n";
+      WriteHash();
+      return 0;
     }
+    // The output may be linked to a cached one: don't write through it.
+    sys::fs::remove(OutputFile);
+  }
+
+  // Whatever happens, the earlier output is gone.
+  sys::fs::remove(HashFile);
+  if (int Ret = decompileInput(InputFile, OutputFile, ArchName, Semas, Log))
+    return Ret;
+  if (!CachedFile.empty()) {
+    std::error_code EC = sys::fs::create_directories(OutputCacheDir);
+    if (!EC && !sys::fs::exists(CachedFile) &&
+        !linkOrCopyFile(OutputFile, CachedFile))
+      EC = std::make_error_code(std::errc::io_error);
+    if (EC)
+      Log << ToolName << ": warning: '" << OutputFile
+          << "' can't be added to the output cache: " << EC.message()
+          << ".\n";
+  }
+  WriteHash();
   return 0;
 }
+
+// With -batch, each input is written beside it, or in the -o directory, with
+// the extension of the output kind appended.
+static std::string getBatchOutputFilename(StringRef InputFile) {
+  SmallString<128> Path(OutputFilename);
+  if (Path.empty())
+    Path = InputFile;
+  else
+    sys::path::append(Path, sys::path::filename(InputFile));
+  Path += getOutputExtension();
+  return Path.str();
+}
+
+// Check that the options can be used with many inputs, named after the
+// batch \p Mode, and create the output directory.
+static bool checkBatchOutputs(StringRef Mode) {
+  if (!AddrTableFilename.empty()) {
+    errs() << ToolName << ": -addr-table can't be used with " << Mode
+           << ".\n";
+    return false;
+  }
+  if (!OutputFilename.empty() && !NoPrint) {
+    if (std::error_code ec = sys::fs::create_directories(OutputFilename)) {
+      errs() << ToolName << ": '" << OutputFilename << "': "
+             << ec.message() << ".\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+static int decompileBatch() {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> ListOrErr =
+      MemoryBuffer::getFileOrSTDIN(BatchFilename);
+  if (std::error_code ec = ListOrErr.getError()) {
+    errs() << ToolName << ": '" << BatchFilename << "': "
+           << ec.message() << ".\n";
+    return 1;
+  }
+  // One input per line; blank lines and '#' comments are skipped.
+  SmallVector<StringRef, 16> Lines;
+  (*ListOrErr)->getBuffer().split(Lines, "\n");
+  std::vector<std::string> Inputs;
+  for (StringRef Line : Lines) {
+    Line = Line.trim();
+    if (!Line.empty() && !Line.startswith("#"))
+      Inputs.push_back(Line);
+  }
+
+  if (!checkBatchOutputs("-batch"))
+    return 1;
+
+  // The inputs are independent: each thread grabs the next one, until there
+  // are none left. The log of each input is printed in one piece, once it is
+  // decompiled.
+  std::atomic<size_t> NextInput(0);
+  std::atomic<unsigned> NumFailed(0);
+  std::mutex LogMutex;
+  auto Worker = [&]() {
+    TargetSemaCache Semas;
+    for (size_t I = NextInput++; I < Inputs.size(); I = NextInput++) {
+      const std::string &InputFile = Inputs[I];
+      std::string LogStr;
+      raw_string_ostream Log(LogStr);
+      PrettyStackTraceString X(InputFile.c_str());
+      if (decompileFile(InputFile, getBatchOutputFilename(InputFile), Semas,
+                        Log))
+        ++NumFailed;
+      std::lock_guard<std::mutex> Lock(LogMutex);
+      errs() << "== " << InputFile << " ==\n" << Log.str();
+    }
+  };
+
+  std::vector<std::thread> Threads;
+  const size_t NumThreads = std::min<size_t>(BatchJobs, Inputs.size());
+  for (size_t i = 1; i < NumThreads; ++i)
+    Threads.emplace_back(Worker);
+  Worker();
+  for (std::thread &T : Threads)
+    T.join();
+
+  if (NumFailed)
+    errs() << ToolName << ": " << NumFailed << " of " << Inputs.size()
+           << " inputs failed.\n";
+  return NumFailed ? 1 : 0;
+}
+
+// With -fork-server, the parent sets up the target, and its semantics, once:
+// each child forked for an input gets them copy-on-write, and only pays for
+// the decompilation itself. A child that crashes, or runs out of memory,
+// only loses its own input.
+static int serveForks() {
+#if LLVM_ON_UNIX
+  if (!checkBatchOutputs("-fork-server"))
+    return 1;
+
+  // The target of the inputs is that of -triple, or of the -arch slice of a
+  // Mach-O, as getTarget finds it; the other targets are set up by each child
+  // that needs them.
+  std::string TheTripleName = TripleName;
+  if (TheTripleName.empty()) {
+    Triple TheTriple("unknown-unknown-unknown");
+    TheTriple.setArch(Triple(ArchName).getArch());
+    TheTriple.setObjectFormat(Triple::MachO);
+    TheTripleName = TheTriple.getTriple();
+  }
+  TargetSemaCache Semas;
+  const DCDecompilerTarget *TS = getTargetSetup(TheTripleName, errs());
+  if (!TS || !getTargetSema(*TS, Semas, errs()))
+    return 1;
+
+  std::map<pid_t, std::string> Children;
+  unsigned NumInputs = 0, NumFailed = 0;
+  // Report the status of the children that exited, waiting for one if
+  // \p Block.
+  auto Reap = [&](bool Block) {
+    for (;;) {
+      int Status;
+      const pid_t Pid = ::waitpid(-1, &Status, Block ? 0 : WNOHANG);
+      if (Pid < 0 && errno == EINTR)
+        continue;
+      if (Pid <= 0)
+        return;
+      auto It = Children.find(Pid);
+      if (It == Children.end())
+        continue;
+      outs() << It->second << ": ";
+      if (WIFEXITED(Status) && WEXITSTATUS(Status) == 0)
+        outs() << "ok\n";
+      else if (WIFSIGNALED(Status))
+        outs() << "crashed (signal " << WTERMSIG(Status) << ")\n";
+      else
+        outs() << "failed\n";
+      outs().flush();
+      if (!WIFEXITED(Status) || WEXITSTATUS(Status) != 0)
+        ++NumFailed;
+      Children.erase(It);
+      Block = false;
+    }
+  };
+
+  // The inputs come in as the client writes them: the children that exit
+  // meanwhile are reported without waiting for the next one.
+  std::string Buffer;
+  bool AtEOF = false;
+  auto ReadInput = [&](std::string &Input) {
+    for (;;) {
+      size_t End = Buffer.find('\n');
+      if (End == std::string::npos && AtEOF) {
+        if (Buffer.empty())
+          return false;
+        End = Buffer.size();
+      }
+      if (End != std::string::npos) {
+        // As with -batch, blank lines and '#' comments are skipped.
+        Input = StringRef(Buffer).substr(0, End).trim();
+        Buffer.erase(0, End + 1);
+        if (!Input.empty() && Input[0] != '#')
+          return true;
+        continue;
+      }
+      if (!Children.empty()) {
+        pollfd In = {0, POLLIN, 0};
+        if (::poll(&In, 1, /*timeout=*/100) == 0) {
+          Reap(/*Block=*/false);
+          continue;
+        }
+      }
+      char Chunk[4096];
+      const ssize_t Read = ::read(0, Chunk, sizeof(Chunk));
+      if (Read < 0 && errno == EINTR)
+        continue;
+      if (Read <= 0)
+        AtEOF = true;
+      else
+        Buffer.append(Chunk, Read);
+    }
+  };
+
+  std::string Input;
+  for (;;) {
+    if (Children.size() >= std::max(1u, unsigned(BatchJobs))) {
+      Reap(/*Block=*/true);
+      continue;
+    }
+    if (!ReadInput(Input))
+      break;
+    ++NumInputs;
+    const pid_t Pid = ::fork();
+    if (Pid < 0) {
+      errs() << ToolName << ": '" << Input << "': " << strerror(errno)
+             << ".\n";
+      ++NumFailed;
+      continue;
+    }
+    if (Pid == 0) {
+      // The log is printed in one piece, as with -batch.
+      std::string LogStr;
+      raw_string_ostream Log(LogStr);
+      PrettyStackTraceString X(Input.c_str());
+      const int Ret =
+          decompileFile(Input, getBatchOutputFilename(Input), Semas, Log);
+      errs() << "== " << Input << " ==\n" << Log.str();
+      errs().flush();
+      // Don't run the destructors and exit handlers of the parent.
+      _exit(Ret ? 1 : 0);
+    }
+    Children[Pid] = Input;
+  }
+  while (!Children.empty())
+    Reap(/*Block=*/true);
+
+  if (NumFailed)
+    errs() << ToolName << ": " << NumFailed << " of " << NumInputs
+           << " inputs failed.\n";
+  return NumFailed ? 1 : 0;
+#else
+  errs() << ToolName << ": -fork-server isn't supported on this host.\n";
+  return 1;
+#endif
+}
+
+// With -slices, each slice is written to the output, or beside the input,
+// with its arch before the extension.
+static std::string getSliceOutputFilename(StringRef Arch) {
+  SmallString<128> Path(OutputFilename);
+  if (Path.empty()) {
+    Path = InputFilename;
+    Path += getOutputExtension();
+  }
+  std::string Ext = sys::path::extension(Path);
+  sys::path::replace_extension(Path, Arch + Ext);
+  return Path.str();
+}
+
+static int decompileSlices() {
+  if (OutputFilename == "-" || !AddrTableFilename.empty()) {
+    errs() << ToolName << ": -slices can't be used with "
+           << (OutputFilename == "-" ? "-o -" : "-addr-table") << ".\n";
+    return 1;
+  }
+
+  // The input, and the universal binary header, are shared by the slices;
+  // so are the target setups, and the translation cache. The Objective-C and
+  // Swift metadata, and the function names, are parsed for each slice: their
+  // addresses, and those of their strings, aren't the same in two slices.
+  LoadedInput In;
+  if (!loadInput(InputFilename, In, errs()))
+    return 1;
+  const MachOUniversalBinary *UB =
+      dyn_cast_or_null<MachOUniversalBinary>(In.Bin.get());
+  if (!UB) {
+    errs() << ToolName << ": '" << InputFilename
+           << "': -slices needs a universal binary.\n";
+    return 1;
+  }
+  std::vector<std::string> Archs;
+  for (const std::string &Arch : SliceArchs) {
+    if (Arch != "all") {
+      Archs.push_back(Arch);
+      continue;
+    }
+    for (const auto &O : UB->objects()) {
+      std::string Name = O.getArchTypeName();
+      // The slices this doesn't know the arch of can't be selected.
+      if (Name.empty())
+        errs() << ToolName << ": '" << InputFilename
+               << "': warning: a slice of unknown arch is skipped.\n";
+      else
+        Archs.push_back(Name);
+    }
+  }
+  std::sort(Archs.begin(), Archs.end());
+  Archs.erase(std::unique(Archs.begin(), Archs.end()), Archs.end());
+
+  // As with -batch, the log of each slice is printed in one piece, once it
+  // is decompiled.
+  std::atomic<unsigned> NumFailed(0);
+  std::mutex LogMutex;
+  auto Worker = [&](const std::string &Arch) {
+    TargetSemaCache Semas;
+    std::string LogStr;
+    raw_string_ostream Log(LogStr);
+    PrettyStackTraceString X(Arch.c_str());
+    if (decompileInput(InputFilename, getSliceOutputFilename(Arch), Arch,
+                       Semas, Log, &In))
+      ++NumFailed;
+    std::lock_guard<std::mutex> Lock(LogMutex);
+    errs() << "== " << InputFilename << " (" << Arch << ") ==\n"
+           << Log.str();
+  };
+
+  std::vector<std::thread> Threads;
+  for (size_t I = 1; I < Archs.size(); ++I)
+    Threads.emplace_back(Worker, Archs[I]);
+  if (!Archs.empty())
+    Worker(Archs[0]);
+  for (std::thread &T : Threads)
+    T.join();
+
+  if (NumFailed)
+    errs() << ToolName << ": " << NumFailed << " of " << Archs.size()
+           << " slices failed.\n";
+  return NumFailed ? 1 : 0;
+}
+
+// Link the modules of the -merge-shards manifests into the output, and list
+// its functions in <output>.manifest.
+static int mergeShards() {
+  if (OutputFilename.empty() || OutputFilename == "-") {
+    errs() << ToolName << ": -merge-shards needs an output file.\n";
+    return 1;
+  }
+  std::vector<ShardManifest> Shards(MergeShards.size());
+  for (size_t I = 0, E = Shards.size(); I != E; ++I)
+    if (!Shards[I].read(MergeShards[I], errs()))
+      return 1;
+  ShardManifest Merged;
+  if (!mergeShardManifests(Shards, Merged, errs())) {
+    errs() << ToolName << ": can't merge the shards.\n";
+    return 1;
+  }
+
+  LLVMContext Ctx;
+  std::unique_ptr<Module> Composite;
+  std::unique_ptr<Linker> L;
+  for (const std::string &File : Merged.Modules) {
+    SMDiagnostic Err;
+    std::unique_ptr<Module> M = parseIRFile(File, Err, Ctx);
+    if (!M) {
+      Err.print(ToolName.data(), errs());
+      return 1;
+    }
+    if (!Composite) {
+      Composite = std::move(M);
+      L.reset(new Linker(Composite.get()));
+    } else if (L->linkInModule(M.get())) {
+      errs() << ToolName << ": " << File << ": can't be linked.\n";
+      return 1;
+    }
+  }
+  if (!Composite) {
+    errs() << ToolName << ": the shards have no modules.\n";
+    return 1;
+  }
+
+  if (!NoPrint) {
+    std::error_code EC;
+    tool_output_file Out(OutputFilename, EC,
+                         PrintBitcode ? sys::fs::F_None : sys::fs::F_Text);
+    if (EC) {
+      errs() << OutputFilename << ": " << EC.message() << '\n';
+      return 1;
+    }
+    if (PrintBitcode)
+      WriteBitcodeToFile(Composite.get(), Out.os());
+    else
+      Composite->print(Out.os(), nullptr);
+    Out.keep();
+  }
+  Merged.Modules.assign(1, sys::path::filename(OutputFilename));
+  return Merged.write(OutputFilename + ".manifest", errs()) ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
+    //git
+  sys::PrintStackTraceOnErrorSignal();
+  PrettyStackTraceProgram X(argc, argv);
+  llvm_shutdown_obj Y;
+
+  InitializeAllTargetInfos();
+  InitializeAllTargetDCs();
+  InitializeAllTargetMCs();
+  InitializeAllAsmParsers();
+  InitializeAllDisassemblers();
+
+  cl::ParseCommandLineOptions(argc, argv, "Function disassembler\n");
+
+  ToolName = argv[0];
+  ToolArgs.assign(argv + 1, argv + argc);
+
+  if (!TranslationCacheDir.empty()) {
+    ErrorOr<std::unique_ptr<DCTranslationCache>> CacheOrErr =
+        DCTranslationCache::create(TranslationCacheDir);
+    if (std::error_code EC = CacheOrErr.getError()) {
+      errs() << ToolName << ": " << TranslationCacheDir << ": "
+             << EC.message() << ".\n";
+      return 1;
+    }
+    TranslationCache = std::move(*CacheOrErr);
+  }
+
+  if (isStreaming()) {
+    // Journal the functions that crash the translation, for -resume.
+    sys::AddSignalHandler(journalCrash, nullptr);
+    install_fatal_error_handler(journalFatalError, nullptr);
+  } else if (Resume) {
+    errs() << ToolName << ": -resume needs -stream-functions, "
+                          "-stream-insts or -max-memory.\n";
+    return 1;
+  }
+
+  if (!StreamTo.empty()) {
+    // The modules of a single input are sent, in order, and not kept.
+    if (!isStreaming()) {
+      errs() << ToolName << ": -stream-to needs -stream-functions, "
+                            "-stream-insts or -max-memory.\n";
+      return 1;
+    }
+    const char *Conflict = !BatchFilename.empty() ? "-batch"
+                           : ForkServer ? "-fork-server"
+                           : !SliceArchs.empty() ? "-slices"
+                           : !ShardSpec.empty() ? "-shard"
+                           : Resume ? "-resume"
+                           : SkipUnchanged ? "-skip-unchanged"
+                           : !OutputCacheDir.empty() ? "-output-cache"
+                           : CompressOutput ? "-compress-output"
+                           : nullptr;
+    if (Conflict) {
+      errs() << ToolName << ": -stream-to can't be used with " << Conflict
+             << ".\n";
+      return 1;
+    }
+  }
+
+  if (CompressOutput) {
+    if (!raw_gzip_ostream::isAvailable()) {
+      errs() << ToolName << ": -compress-output needs zlib.\n";
+      return 1;
+    }
+    // -merge-shards reads the modules as they are.
+    if (!ShardSpec.empty() || !MergeShards.empty()) {
+      errs() << ToolName << ": -compress-output can't be used with "
+             << (!ShardSpec.empty() ? "-shard" : "-merge-shards") << ".\n";
+      return 1;
+    }
+  }
+
+  if (!DiffReportFilename.empty() && DiffAgainst.empty()) {
+    errs() << ToolName << ": -diff-report needs -diff-against.\n";
+    return 1;
+  }
+
+  if (MCOnly) {
+    // Nothing is translated: there are no modules to stream, nor to merge.
+    const char *Conflict = isStreaming() ? "-stream-functions, -stream-insts "
+                                           "and -max-memory"
+                           : !ServePath.empty() ? "-serve"
+                           : !ShardSpec.empty() ? "-shard"
+                           : !MergeShards.empty() ? "-merge-shards"
+                           : nullptr;
+    if (Conflict) {
+      errs() << ToolName << ": -mc-only can't be used with " << Conflict
+             << ".\n";
+      return 1;
+    }
+  }
+
+  if (IsolateWorkers && BatchJobs > 1) {
+    errs() << ToolName << ": -dc-isolate can't be used with -batch-jobs.\n";
+    return 1;
+  }
+
+  if (!SliceArchs.empty()) {
+    if (!BatchFilename.empty() || Resume || !TripleName.empty()) {
+      errs() << ToolName << ": -slices can't be used with "
+             << (!BatchFilename.empty() ? "-batch"
+                                        : Resume ? "-resume" : "-triple")
+             << ".\n";
+      return 1;
+    }
+  }
+
+  if (!ServePath.empty() &&
+      (!BatchFilename.empty() || !SliceArchs.empty() ||
+       !MergeShards.empty())) {
+    errs() << ToolName << ": -serve can't be used with "
+           << (!BatchFilename.empty() ? "-batch"
+                                      : !SliceArchs.empty() ? "-slices"
+                                                            : "-merge-shards")
+           << ".\n";
+    return 1;
+  }
+
+  if (ForkServer &&
+      (!BatchFilename.empty() || !SliceArchs.empty() || !ServePath.empty() ||
+       !MergeShards.empty())) {
+    errs() << ToolName << ": -fork-server can't be used with "
+           << (!BatchFilename.empty()
+                   ? "-batch"
+                   : !SliceArchs.empty()
+                         ? "-slices"
+                         : !ServePath.empty() ? "-serve" : "-merge-shards")
+           << ".\n";
+    return 1;
+  }
+
+  if (!BatchFilename.empty() || ForkServer) {
+    const char *Mode = ForkServer ? "-fork-server" : "-batch";
+    if (Resume) {
+      errs() << ToolName << ": -resume can't be used with " << Mode << ".\n";
+      return 1;
+    }
+    if (!InputFilename.empty()) {
+      errs() << ToolName << ": an input file can't be used with " << Mode
+             << ".\n";
+      return 1;
+    }
+  } else if (InputFilename.empty() && MergeShards.empty()) {
+    errs() << ToolName << ": no input file (nor -batch list).\n";
+    return 1;
+  }
+
+  if (!MergeShards.empty())
+    return mergeShards();
+
+  if (!TraceFilename.empty())
+    enableTraceEvents();
+
+  int Ret;
+  if (!BatchFilename.empty()) {
+    Ret = decompileBatch();
+  } else if (ForkServer) {
+    Ret = serveForks();
+  } else if (!SliceArchs.empty()) {
+    Ret = decompileSlices();
+  } else {
+    TargetSemaCache Semas;
+    Ret = decompileFile(InputFilename, OutputFilename, Semas, errs());
+  }
+
+  // All the threads are joined by now.
+  if (!TraceFilename.empty()) {
+    std::error_code EC;
+    tool_output_file TraceOut(TraceFilename, EC, sys::fs::F_Text);
+    if (EC) {
+      errs() << TraceFilename << ": " << EC.message() << '\n';
+      return 1;
+    }
+    writeTraceEvents(TraceOut.os());
+    TraceOut.keep();
+  }
+  return Ret;
+}
@@ -16,9 +16,11 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/Bitcode/ReaderWriter.h"
 #include "llvm/IR/AssemblyAnnotationWriter.h"
+#include "llvm/IR/Constants.h"
 #include "llvm/IR/DebugInfo.h"
 #include "llvm/IR/DiagnosticInfo.h"
 #include "llvm/IR/DiagnosticPrinter.h"
@@ -90,7 +92,11 @@ public:
   void emitInstructionAnnot(const Instruction *I,
                               formatted_raw_ostream &OS) override{
     if(MDNode* tmp_md = I->getMetadata("num")){
-      OS << "[0x" << cast<MDString>(tmp_md->getOperand(0))->getString() << "]";
+      const MDOperand &Op = tmp_md->getOperand(0);
+      if (ConstantInt *CI = mdconst::dyn_extract<ConstantInt>(Op))
+        OS << "[0x" << utohexstr(CI->getZExtValue()) << "]";
+      else
+        OS << "[0x" << cast<MDString>(Op)->getString() << "]";
     }
     else
     {
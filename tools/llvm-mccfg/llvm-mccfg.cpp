@@ -18,6 +18,7 @@
 #include "llvm/MC/MCAnalysis/MCCachingDisassembler.h"
 #include "llvm/MC/MCAnalysis/MCFunction.h"
 #include "llvm/MC/MCAnalysis/MCModule.h"
+#include "llvm/MC/MCAnalysis/MCModuleBinary.h"
 #include "llvm/MC/MCAnalysis/MCModuleYAML.h"
 #include "llvm/MC/MCAsmInfo.h"
 #include "llvm/MC/MCContext.h"
@@ -45,14 +46,17 @@
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/PrettyStackTrace.h"
+#include "llvm/Support/Regex.h"
 #include "llvm/Support/Signals.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/TargetRegistry.h"
 #include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/ToolOutputFile.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cctype>
 #include <cstring>
+#include <mutex>
 #include <system_error>
 
 using namespace llvm;
@@ -82,14 +86,42 @@ MAttrs("mattr",
   cl::value_desc("a1,+a2,-a3,..."));
 
 static cl::opt<bool>
-EmitDOT("emit-dot", cl::desc("Write the CFG for every function found in the"
-                             "object to a graphviz .dot file"));
+EmitBinary("binary",
+    cl::desc("Write the MCModule in its compact binary representation, which "
+             "llvm-dc reads much faster, rather than in YAML"),
+    cl::init(false));
+
+static cl::opt<std::string>
+OutputFilename("o", cl::desc("Output filename (default = stdout)"),
+               cl::value_desc("filename"), cl::init("-"));
+
+static cl::opt<bool>
+EmitDOT("emit-dot", cl::desc("Write the CFG for every function found in the "
+                             "object to a graphviz .dot file, as soon as it "
+                             "is built, by the -mc-jobs threads"));
+
+static cl::opt<std::string>
+DOTFilter("dot-filter",
+    cl::desc("With -emit-dot, only write the functions whose name matches "
+             "<regex>"),
+    cl::value_desc("regex"));
+
+static cl::opt<unsigned>
+DOTMinBlocks("dot-min-blocks",
+    cl::desc("With -emit-dot, only write the functions of at least <n> "
+             "basic blocks (default = 0)"),
+    cl::value_desc("n"), cl::init(0));
 
 static cl::opt<bool>
 EnableDisassemblyCache("enable-mcod-disass-cache",
     cl::desc("Enable the MC Object disassembly instruction cache"),
     cl::init(false), cl::Hidden);
 
+static cl::opt<unsigned>
+MCJobs("mc-jobs",
+    cl::desc("Number of threads used to recover the MC CFG (default = 1)"),
+    cl::init(1u));
+
 static StringRef ToolName;
 
 static const Target *getTarget(const ObjectFile *Obj = nullptr) {
@@ -193,16 +225,17 @@ struct DOTGraphTraits<DOTMCFunction> : public DefaultDOTGraphTraits {
 } // end llvm namespace
 
 // Write a graphviz file for the CFG inside an MCFunction.
-// FIXME: Use GraphWriter
 static void emitDOTFile(const char *FileName, const MCFunction &f,
                         MCInstPrinter *IP, const MCSubtargetInfo &STI) {
   // Start a new dot file.
   std::error_code EC;
-
-
   raw_fd_ostream Out(FileName, EC, sys::fs::F_Text);
   if (EC) {
-    errs() << ToolName << ": warning: " << EC.message() << '\n';
+    // The functions are written by several threads.
+    static std::mutex ErrsMutex;
+    std::lock_guard<std::mutex> Lock(ErrsMutex);
+    errs() << ToolName << ": warning: " << FileName << ": " << EC.message()
+           << '\n';
     return;
   }
   DOTMCFunction DOTFn(f, *IP, STI);
@@ -247,10 +280,13 @@ static void emitDOTFile(const char *FileName, const MCFunction &f,
 #endif
 }
 
-static void DumpObject(const ObjectFile *Obj) {
-  outs() << '\n';
-  outs() << "# " << Obj->getFileName()
-         << ":\tfile format " << Obj->getFileFormatName() << "\n\n";
+static void DumpObject(const ObjectFile *Obj, raw_ostream &OS) {
+  // The binary representation is the whole output.
+  if (!EmitBinary) {
+    OS << '\n';
+    OS << "# " << Obj->getFileName()
+       << ":\tfile format " << Obj->getFileFormatName() << "\n\n";
+  }
 
   const Target *TheTarget = getTarget(Obj);
   // getTarget() will have already issued a diagnostic if necessary, so
@@ -307,9 +343,15 @@ static void DumpObject(const ObjectFile *Obj) {
   }
 
   std::unique_ptr<MCDisassembler> DisAsmImpl;
+  MCCachingDisassembler *DisAsmCache = nullptr;
   if (EnableDisassemblyCache) {
     DisAsmImpl = std::move(DisAsm);
-    DisAsm.reset(new MCCachingDisassembler(*DisAsmImpl, *STI));
+    // AArch64 instructions are all 4 bytes wide.
+    const Triple::ArchType Arch = Triple(TripleName).getArch();
+    const bool FixedWidth =
+        Arch == Triple::aarch64 || Arch == Triple::aarch64_be;
+    DisAsmCache = new MCCachingDisassembler(*DisAsmImpl, *STI, FixedWidth);
+    DisAsm.reset(DisAsmCache);
   }
 
   std::unique_ptr<const MCInstrAnalysis> MIA(
@@ -326,23 +368,50 @@ static void DumpObject(const ObjectFile *Obj) {
 
   std::unique_ptr<MCObjectDisassembler> OD(
       new MCObjectDisassembler(*Obj, *DisAsm, *MIA));
-  std::unique_ptr<MCModule> Mod(OD->buildModule());
-  if (EmitDOT) {
-    for (MCModule::const_func_iterator FI = Mod->func_begin(),
-         FE = Mod->func_end();
-         FI != FE; ++FI) {
-      static int filenum = 0;
-      emitDOTFile((Twine((*FI)->getName()) + "_" +
-                   utostr(filenum) + ".dot").str().c_str(),
-                  **FI, IP.get(), *STI);
-      ++filenum;
-    }
+  // The generic disassembly cache isn't thread-safe.
+  if (DisAsmCache && !DisAsmCache->isThreadSafe() && MCJobs > 1)
+    errs() << "warning: -mc-jobs is ignored with the disassembly cache\n";
+  else
+    OD->setNumJobs(MCJobs);
+
+  // Write each function as soon as it is disassembled, on the thread that
+  // did, rather than all of them once the module is built. The files are
+  // named after the function and the object, for the members of an archive
+  // not to overwrite each other.
+  static unsigned ObjectNum = 0;
+  const unsigned DOTObjectNum = ObjectNum++;
+  Regex DOTRegex(DOTFilter);
+  std::string RegexError;
+  if (EmitDOT && !DOTFilter.empty() && !DOTRegex.isValid(RegexError)) {
+    errs() << ToolName << ": invalid -dot-filter: " << RegexError << '\n';
+    return;
   }
-  mcmodule2yaml(outs(), *Mod, *MII, *MRI);
+  if (EmitDOT)
+    OD->setFunctionCallback([&](const MCFunction &MCFN) {
+      if (MCFN.empty() || MCFN.size() < DOTMinBlocks ||
+          (!DOTFilter.empty() && !DOTRegex.match(MCFN.getName())))
+        return;
+      // The instruction printers aren't meant to be shared by threads.
+      std::unique_ptr<MCInstPrinter> FnIP(TheTarget->createMCInstPrinter(
+          Triple(TripleName), AsmPrinterVariant, *AsmInfo, *MII, *MRI));
+      emitDOTFile((Twine(MCFN.getName()) + "_" + utostr(DOTObjectNum) +
+                   ".dot").str().c_str(),
+                  MCFN, FnIP.get(), *STI);
+    });
+  std::unique_ptr<MCModule> Mod(OD->buildModule());
+  StringRef Err = EmitBinary ? mcmodule2binary(OS, *Mod, *MII, *MRI)
+                             : mcmodule2yaml(OS, *Mod, *MII, *MRI);
+  if (!Err.empty())
+    errs() << ToolName << ": '" << Obj->getFileName() << "': " << Err << '\n';
 }
 
 /// @brief Dump each object file in \a a;
-static void DumpArchive(const Archive *a) {
+static void DumpArchive(const Archive *a, raw_ostream &OS) {
+  if (EmitBinary) {
+    errs() << ToolName << ": '" << a->getFileName() << "': "
+           << "-binary only writes a single object\n";
+    return;
+  }
   for (Archive::child_iterator i = a->child_begin(), e = a->child_end(); i != e;
        ++i) {
     ErrorOr<std::unique_ptr<Binary>> ChildOrErr = i->getAsBinary();
@@ -354,7 +423,7 @@ static void DumpArchive(const Archive *a) {
       continue;
     }
     if (ObjectFile *o = dyn_cast<ObjectFile>(&*ChildOrErr.get()))
-      DumpObject(o);
+      DumpObject(o, OS);
     else
       errs() << ToolName << ": '" << a->getFileName() << "': "
               << "Unrecognized file type.\n";
@@ -362,7 +431,7 @@ static void DumpArchive(const Archive *a) {
 }
 
 /// @brief Open file and figure out how to dump it.
-static void DumpInput(StringRef file) {
+static void DumpInput(StringRef file, raw_ostream &OS) {
   // If file isn't stdin, check that it exists.
   if (file != "-" && !sys::fs::exists(file)) {
     errs() << ToolName << ": '" << file << "': " << "No such file\n";
@@ -378,9 +447,9 @@ static void DumpInput(StringRef file) {
   Binary &Binary = *BinaryOrErr.get().getBinary();
 
   if (Archive *a = dyn_cast<Archive>(&Binary))
-    DumpArchive(a);
+    DumpArchive(a, OS);
   else if (ObjectFile *o = dyn_cast<ObjectFile>(&Binary))
-    DumpObject(o);
+    DumpObject(o, OS);
   else
     errs() << ToolName << ": '" << file << "': " << "Unrecognized file type.\n";
 }
@@ -409,8 +478,22 @@ int main(int argc, char **argv) {
   if (InputFilenames.size() == 0)
     InputFilenames.push_back("a.out");
 
-  std::for_each(InputFilenames.begin(), InputFilenames.end(),
-                DumpInput);
+  if (EmitBinary && InputFilenames.size() > 1) {
+    errs() << ToolName << ": -binary only writes a single object\n";
+    return 1;
+  }
+
+  std::error_code EC;
+  tool_output_file Out(OutputFilename, EC,
+                       EmitBinary ? sys::fs::F_None : sys::fs::F_Text);
+  if (EC) {
+    errs() << ToolName << ": " << OutputFilename << ": " << EC.message()
+           << '\n';
+    return 1;
+  }
+  for (StringRef File : InputFilenames)
+    DumpInput(File, Out.os());
+  Out.keep();
 
   return 0;
 }
@@ -9,6 +9,7 @@
 
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/AsmParser/Parser.h"
 #include "llvm/Bitcode/BitstreamReader.h"
 #include "llvm/Bitcode/BitstreamWriter.h"
@@ -228,6 +229,85 @@ TEST(BitReaderTest, MaterializeFunctionsOutOfOrder) {
   EXPECT_FALSE(verifyModule(*M, &dbgs()));
 }
 
+// Tests that the function offsets of the module-level VST are relative to the
+// start of the bitcode, after the wrapper header emitted for Darwin.
+TEST(BitReaderTest, MaterializeFunctionsWithWrapperHeader) {
+  SmallString<1024> Mem;
+  LLVMContext Context;
+  std::unique_ptr<Module> M = getLazyModuleFromAssembly(
+      Context, Mem, "target triple = \"x86_64-apple-macosx10.10.0\"\n"
+                    "declare void @ext()\n"
+                    "define void @f() {\n"
+                    "  call void @ext()\n"
+                    "  ret void\n"
+                    "}\n"
+                    "define void @g() {\n"
+                    "  call void @f()\n"
+                    "  ret void\n"
+                    "}\n");
+  EXPECT_TRUE(isBitcodeWrapper((const unsigned char *)Mem.begin(),
+                               (const unsigned char *)Mem.end()));
+
+  Function *F = M->getFunction("f");
+  Function *G = M->getFunction("g");
+  ASSERT_TRUE(F && G && M->getFunction("ext"));
+
+  // Materialize g first, then the rest of the module.
+  G->materialize();
+  EXPECT_TRUE(F->empty());
+  EXPECT_FALSE(G->empty());
+  EXPECT_EQ(F, cast<CallInst>(G->front().front()).getCalledFunction());
+  EXPECT_FALSE(M->materializeAll());
+  EXPECT_FALSE(F->empty());
+  EXPECT_FALSE(verifyModule(*M, &dbgs()));
+}
+
+// Tests that writing the function bodies on several threads gives the same
+// bitcode, over enough functions for several jobs.
+TEST(BitReaderTest, WriteFunctionsInParallel) {
+  std::string Assembly = "@g = global i32 0\n"
+                         "define i32 @f0(i32 %x) {\n"
+                         "  ret i32 %x\n"
+                         "}\n";
+  for (unsigned I = 1; I != 300; ++I) {
+    std::string N = utostr(I), Prev = utostr(I - 1);
+    Assembly += "define i32 @f" + N + "(i32 %x) {\n"
+                "  %a = add i32 %x, " + N + "\n"
+                "  %b = add i32 %a, %x\n"
+                "  store i32 %b, i32* @g, !tag !0\n"
+                "  %c = call i32 @f" + Prev + "(i32 %b)\n"
+                "  ret i32 %c\n"
+                "}\n";
+  }
+  Assembly += "!0 = !{i32 1}\n";
+  std::unique_ptr<Module> Src = parseAssembly(Assembly.c_str());
+
+  SmallString<1024> Serial, Parallel;
+  {
+    raw_svector_ostream OS(Serial);
+    WriteBitcodeToFile(Src.get(), OS, /*ShouldPreserveUseListOrder=*/true);
+  }
+  {
+    raw_svector_ostream OS(Parallel);
+    WriteBitcodeToFile(Src.get(), OS, /*ShouldPreserveUseListOrder=*/true,
+                       /*NumJobs=*/4);
+  }
+  EXPECT_EQ(Serial.str(), Parallel.str());
+
+  LLVMContext Context;
+  ErrorOr<std::unique_ptr<Module>> ModuleOrErr = getLazyBitcodeModule(
+      MemoryBuffer::getMemBuffer(Parallel.str(), "test", false), Context);
+  ASSERT_TRUE(bool(ModuleOrErr));
+  Module &M = **ModuleOrErr;
+  Function *F = M.getFunction("f250");
+  ASSERT_TRUE(F);
+  EXPECT_FALSE(F->materialize());
+  EXPECT_FALSE(F->empty());
+  EXPECT_TRUE(M.getFunction("f249")->empty());
+  EXPECT_FALSE(M.materializeAll());
+  EXPECT_FALSE(verifyModule(M, &dbgs()));
+}
+
 TEST(BitReaderTest, MaterializeFunctionsForBlockAddr) { // PR11677
   SmallString<1024> Mem;
 
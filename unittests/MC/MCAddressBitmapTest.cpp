@@ -0,0 +1,88 @@
+//===- MCAddressBitmapTest.cpp --------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MC/MCAnalysis/MCAddressBitmap.h"
+#include "gtest/gtest.h"
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+
+TEST(MCAddressBitmapTest, InsertAndTest) {
+  MCAddressBitmap Map;
+  Map.addRegion(0x2000, 0x100);
+  Map.addRegion(0x1000, 0x10);
+  EXPECT_TRUE(Map.empty());
+
+  EXPECT_TRUE(Map.insert(0x1004));
+  EXPECT_FALSE(Map.insert(0x1004));
+  EXPECT_TRUE(Map.insert(0x20FC));
+  // Outside of all regions.
+  EXPECT_FALSE(Map.insert(0x1010));
+  EXPECT_FALSE(Map.insert(0xFFC));
+
+  EXPECT_EQ(2U, Map.count());
+  EXPECT_TRUE(Map.test(0x1004));
+  EXPECT_FALSE(Map.test(0x1008));
+  EXPECT_TRUE(Map.test(0x20FC));
+  EXPECT_FALSE(Map.test(0x1010));
+}
+
+TEST(MCAddressBitmapTest, SetAllRegion) {
+  MCAddressBitmap Map;
+  Map.addRegion(0x1000, 0x10, /*SetAll=*/true);
+  EXPECT_EQ(4U, Map.count());
+  EXPECT_FALSE(Map.insert(0x100C));
+  EXPECT_TRUE(Map.test(0x1000));
+}
+
+TEST(MCAddressBitmapTest, Iteration) {
+  MCAddressBitmap Map(1);
+  Map.addRegion(0x3000, 0x10);
+  Map.addRegion(0x1000, 0x10);
+  Map.addRegion(0x2000, 0x10);
+  EXPECT_TRUE(Map.begin() == Map.end());
+
+  Map.insert(0x300F);
+  Map.insert(0x1003);
+  Map.insert(0x1000);
+
+  std::vector<uint64_t> Addrs(Map.begin(), Map.end());
+  ASSERT_EQ(3U, Addrs.size());
+  EXPECT_EQ(0x1000U, Addrs[0]);
+  EXPECT_EQ(0x1003U, Addrs[1]);
+  EXPECT_EQ(0x300FU, Addrs[2]);
+}
+
+TEST(MCAddressBitmapTest, OverlappingRegions) {
+  // The sections of a relocatable object all start at 0.
+  MCAddressBitmap Map;
+  Map.addRegion(0, 0x8);
+  EXPECT_TRUE(Map.insert(0x4));
+  Map.addRegion(0, 0x10, /*SetAll=*/true);
+  Map.addRegion(0x20, 0x8);
+  EXPECT_TRUE(Map.insert(0x24));
+  // Merges the two regions before it, keeping their addresses.
+  Map.addRegion(0xC, 0x18);
+  EXPECT_EQ(5U, Map.count());
+  EXPECT_TRUE(Map.test(0xC));
+  EXPECT_FALSE(Map.test(0x10));
+  EXPECT_TRUE(Map.insert(0x10));
+  EXPECT_TRUE(Map.test(0x24));
+  EXPECT_FALSE(Map.insert(0x28));
+
+  std::vector<uint64_t> Addrs(Map.begin(), Map.end());
+  ASSERT_EQ(6U, Addrs.size());
+  EXPECT_EQ(0x0U, Addrs[0]);
+  EXPECT_EQ(0x10U, Addrs[4]);
+  EXPECT_EQ(0x24U, Addrs[5]);
+}
+
+} // end anonymous namespace
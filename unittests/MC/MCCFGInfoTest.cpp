@@ -0,0 +1,106 @@
+//===- MCCFGInfoTest.cpp --------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MC/MCAnalysis/MCCFGInfo.h"
+#include "MCTargetTest.h"
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCAnalysis/MCModule.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+// An entry, a loop with an inner loop of a single block, an exit, and a
+// block nothing branches to:
+//   0x100 -> 0x110 -> 0x120 -> 0x120
+//            0x110 <- 0x120 -> 0x130
+//   0x140
+struct LoopsFunction {
+  MCModule M;
+  MCFunction *F;
+  MCBasicBlock *Entry, *Header, *Inner, *Exit, *Unreachable;
+
+  LoopsFunction() : F(M.createFunction("f", 0x100)) {
+    Entry = &F->createBlock(0x100);
+    Header = &F->createBlock(0x110);
+    Inner = &F->createBlock(0x120);
+    Exit = &F->createBlock(0x130);
+    Unreachable = &F->createBlock(0x140);
+    addEdge(*Entry, *Header);
+    addEdge(*Header, *Inner);
+    addEdge(*Inner, *Inner);
+    addEdge(*Inner, *Header);
+    addEdge(*Inner, *Exit);
+  }
+};
+
+TEST(MCCFGInfoTest, Dominators) {
+  LoopsFunction LF;
+  MCCFGInfo Info;
+  Info.analyze(*LF.F);
+  const MCDominatorTree &DT = Info.getDomTree();
+  EXPECT_EQ(LF.Entry, DT.getRoot());
+  EXPECT_TRUE(DT.dominates(LF.Header, LF.Exit));
+  EXPECT_FALSE(DT.dominates(LF.Exit, LF.Inner));
+  EXPECT_EQ(LF.Inner, DT.getNode(LF.Exit)->getIDom()->getBlock());
+  EXPECT_FALSE(DT.isReachableFromEntry(LF.Unreachable));
+}
+
+TEST(MCCFGInfoTest, Loops) {
+  LoopsFunction LF;
+  MCCFGInfo Info;
+  Info.analyze(*LF.F);
+  const MCLoopInfo &LI = Info.getLoopInfo();
+  const MCLoop *Outer = LI.getLoopFor(LF.Header);
+  ASSERT_TRUE(Outer);
+  EXPECT_EQ(LF.Header, Outer->getHeader());
+  EXPECT_EQ(2U, Outer->getNumBlocks());
+  const MCLoop *Inner = LI.getLoopFor(LF.Inner);
+  ASSERT_TRUE(Inner);
+  EXPECT_EQ(Outer, Inner->getParentLoop());
+  EXPECT_EQ(2U, LI.getLoopDepth(LF.Inner));
+  EXPECT_FALSE(LI.getLoopFor(LF.Entry));
+  EXPECT_FALSE(LI.getLoopFor(LF.Exit));
+}
+
+TEST(MCCFGInfoTest, SCCs) {
+  LoopsFunction LF;
+  MCCFGInfo Info;
+  Info.analyze(*LF.F);
+  // The exit first, then the loop, then the entry.
+  ASSERT_EQ(3U, Info.getNumSCCs());
+  EXPECT_EQ(0U, Info.getSCCIndex(LF.Exit));
+  EXPECT_EQ(1U, Info.getSCCIndex(LF.Header));
+  EXPECT_EQ(1U, Info.getSCCIndex(LF.Inner));
+  EXPECT_EQ(2U, Info.getSCCIndex(LF.Entry));
+  EXPECT_EQ(MCCFGInfo::NoSCC, Info.getSCCIndex(LF.Unreachable));
+  EXPECT_EQ(2U, Info.getSCC(1).size());
+  EXPECT_FALSE(Info.isCyclicSCC(0));
+  EXPECT_TRUE(Info.isCyclicSCC(1));
+  EXPECT_FALSE(Info.isCyclicSCC(2));
+}
+
+TEST(MCCFGInfoTest, AnalyzeAll) {
+  LoopsFunction LF;
+  MCFunction *Empty = LF.M.createFunction("g", 0x200);
+  MCFunction *Single = LF.M.createFunction("h", 0x300);
+  MCBasicBlock &BB = Single->createBlock(0x300);
+  addEdge(BB, BB);
+  const MCFunction *Funcs[] = {LF.F, Empty, Single};
+  std::vector<MCCFGInfo> Infos = MCCFGInfo::analyzeAll(Funcs, 4);
+  ASSERT_EQ(3U, Infos.size());
+  EXPECT_EQ(3U, Infos[0].getNumSCCs());
+  EXPECT_EQ(0U, Infos[1].getNumSCCs());
+  EXPECT_EQ(1U, Infos[2].getNumSCCs());
+  EXPECT_TRUE(Infos[2].isCyclicSCC(0));
+  EXPECT_EQ(&BB, Infos[2].getLoopInfo().getLoopFor(&BB)->getHeader());
+}
+
+} // end anonymous namespace
@@ -0,0 +1,80 @@
+//===- MCCalleeSavedSpillsTest.cpp ----------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MC/MCAnalysis/MCCalleeSavedSpills.h"
+#include "MCTargetTest.h"
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCAnalysis/MCModule.h"
+#include "llvm/MC/MCInstBuilder.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+class MCCalleeSavedSpillsTest : public MCTargetTest {
+protected:
+  // Fill \p BB with a prologue saving FP, LR, X19 and X20, and an epilogue
+  // restoring them, X19 and X20 from \p RestoreImm, scaled by 8, from the
+  // stack pointer.
+  void addFunction(MCBasicBlock &BB, int64_t RestoreImm) {
+    const unsigned SP = getReg("SP"), FP = getReg("FP"), LR = getReg("LR"),
+                   X19 = getReg("X19"), X20 = getReg("X20");
+    BB.addInst(MCInstBuilder(getOpcode("STPXpre"))
+                   .addReg(SP).addReg(FP).addReg(LR).addReg(SP).addImm(-2), 4);
+    BB.addInst(MCInstBuilder(getOpcode("ADDXri"))
+                   .addReg(FP).addReg(SP).addImm(0).addImm(0), 4);
+    BB.addInst(MCInstBuilder(getOpcode("SUBXri"))
+                   .addReg(SP).addReg(SP).addImm(32).addImm(0), 4);
+    BB.addInst(MCInstBuilder(getOpcode("STPXi"))
+                   .addReg(X20).addReg(X19).addReg(SP).addImm(2), 4);
+    BB.addInst(MCInstBuilder(getOpcode("LDPXi"))
+                   .addReg(X20).addReg(X19).addReg(SP).addImm(RestoreImm), 4);
+    BB.addInst(MCInstBuilder(getOpcode("ADDXri"))
+                   .addReg(SP).addReg(SP).addImm(32).addImm(0), 4);
+    BB.addInst(MCInstBuilder(getOpcode("LDPXpost"))
+                   .addReg(SP).addReg(FP).addReg(LR).addReg(SP).addImm(2), 4);
+    BB.addInst(MCInstBuilder(getOpcode("RET")).addReg(LR), 4);
+  }
+};
+
+TEST_F(MCCalleeSavedSpillsTest, Matched) {
+  MCModule M;
+  MCFunction *F = M.createFunction("f", 0x100);
+  addFunction(F->createBlock(0x100), 2);
+
+  MCCalleeSavedSpills Spills;
+  ASSERT_TRUE(Spills.analyze(*F, *MIA, *MRI));
+  EXPECT_EQ(4U, Spills.getNumSpills());
+  EXPECT_TRUE(Spills.isSpill(0x100));
+  EXPECT_FALSE(Spills.isSpill(0x104));
+  EXPECT_TRUE(Spills.isSpill(0x10C));
+  EXPECT_TRUE(Spills.isSpill(0x110));
+  EXPECT_TRUE(Spills.isSpill(0x118));
+  const BitVector &Saved = Spills.getSavedRegs();
+  EXPECT_EQ(4U, Saved.count());
+  EXPECT_TRUE(Saved.test(getReg("FP")));
+  EXPECT_TRUE(Saved.test(getReg("LR")));
+  EXPECT_TRUE(Saved.test(getReg("X19")));
+  EXPECT_TRUE(Saved.test(getReg("X20")));
+}
+
+TEST_F(MCCalleeSavedSpillsTest, Mismatched) {
+  MCModule M;
+  MCFunction *F = M.createFunction("f", 0x100);
+  // X19 and X20 come back from the wrong slots.
+  addFunction(F->createBlock(0x100), 0);
+
+  MCCalleeSavedSpills Spills;
+  EXPECT_FALSE(Spills.analyze(*F, *MIA, *MRI));
+  EXPECT_TRUE(Spills.empty());
+  EXPECT_FALSE(Spills.isSpill(0x100));
+}
+
+} // end anonymous namespace
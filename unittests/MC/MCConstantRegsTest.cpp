@@ -0,0 +1,114 @@
+//===- MCConstantRegsTest.cpp ---------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MC/MCAnalysis/MCConstantRegs.h"
+#include "MCTargetTest.h"
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCAnalysis/MCModule.h"
+#include "llvm/MC/MCInstBuilder.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+class MCConstantRegsTest : public MCTargetTest {
+protected:
+  void addInst(MCBasicBlock &BB, StringRef Opcode, StringRef Reg,
+               int64_t Imm) {
+    BB.addInst(MCInstBuilder(getOpcode(Opcode)).addReg(getReg(Reg))
+                   .addImm(Imm), 4);
+  }
+
+  void addInst(MCBasicBlock &BB, StringRef Opcode, StringRef Reg0,
+               StringRef Reg1, int64_t Imm) {
+    BB.addInst(MCInstBuilder(getOpcode(Opcode)).addReg(getReg(Reg0))
+                   .addReg(getReg(Reg1)).addImm(Imm), 4);
+  }
+
+  void addMovZ(MCBasicBlock &BB, StringRef Reg, int64_t Imm) {
+    BB.addInst(MCInstBuilder(getOpcode("MOVZXi")).addReg(getReg(Reg))
+                   .addImm(Imm).addImm(0), 4);
+  }
+
+  bool lookup(const MCConstantRegs &Regs, uint64_t Addr, StringRef Reg,
+              MCConstantRegs::Value &V) const {
+    return Regs.lookup(Addr, getReg(Reg), V);
+  }
+};
+
+TEST_F(MCConstantRegsTest, Diamond) {
+  MCModule M;
+  MCFunction *F = M.createFunction("f", 0x100);
+  MCBasicBlock &Entry = F->createBlock(0x100);
+  addInst(Entry, "ADRP", "X8", 1);
+  addInst(Entry, "CBZX", "X0", 4);
+  MCBasicBlock &Left = F->createBlock(0x108);
+  addMovZ(Left, "X9", 1);
+  Left.addInst(MCInstBuilder(getOpcode("B")).addImm(3), 4);
+  MCBasicBlock &Right = F->createBlock(0x110);
+  addMovZ(Right, "X9", 2);
+  addMovZ(Right, "X10", 3);
+  MCBasicBlock &Join = F->createBlock(0x118);
+  addInst(Join, "LDRXui", "X10", "X8", 2);
+  Join.addInst(MCInstBuilder(getOpcode("BLR")).addReg(getReg("X10")), 4);
+  Join.addInst(MCInstBuilder(getOpcode("RET")).addReg(getReg("LR")), 4);
+  addEdge(Entry, Left);
+  addEdge(Entry, Right);
+  addEdge(Left, Join);
+  addEdge(Right, Join);
+
+  MCConstantRegs Regs;
+  Regs.analyze(*F, *MIA, *MII, *MRI);
+  MCConstantRegs::Value V;
+  ASSERT_TRUE(lookup(Regs, 0x118, "X8", V));
+  EXPECT_EQ(0x1000U, V.Val);
+  EXPECT_FALSE(V.IsLoad);
+  ASSERT_TRUE(lookup(Regs, 0x11C, "X10", V));
+  EXPECT_EQ(0x1010U, V.Val);
+  EXPECT_TRUE(V.IsLoad);
+  // The paths disagree.
+  EXPECT_FALSE(lookup(Regs, 0x118, "X9", V));
+  ASSERT_TRUE(lookup(Regs, 0x114, "X9", V));
+  EXPECT_EQ(2U, V.Val);
+  EXPECT_FALSE(lookup(Regs, 0x114, "W8", V));
+  // Not before it is set, nor after a call.
+  EXPECT_FALSE(lookup(Regs, 0x100, "X8", V));
+  EXPECT_FALSE(lookup(Regs, 0x120, "X8", V));
+}
+
+TEST_F(MCConstantRegsTest, Loop) {
+  MCModule M;
+  MCFunction *F = M.createFunction("f", 0x100);
+  MCBasicBlock &Entry = F->createBlock(0x100);
+  addMovZ(Entry, "X8", 1);
+  addMovZ(Entry, "X9", 2);
+  MCBasicBlock &Loop = F->createBlock(0x108);
+  Loop.addInst(MCInstBuilder(getOpcode("ADDXri")).addReg(getReg("X8"))
+                   .addReg(getReg("X8")).addImm(1).addImm(0), 4);
+  // Clobbers X9.
+  Loop.addInst(MCInstBuilder(getOpcode("ADDXrr")).addReg(getReg("X9"))
+                   .addReg(getReg("X8")).addReg(getReg("X8")), 4);
+  addInst(Loop, "CBNZX", "X0", -2);
+  MCBasicBlock &Exit = F->createBlock(0x114);
+  Exit.addInst(MCInstBuilder(getOpcode("RET")).addReg(getReg("LR")), 4);
+  addEdge(Entry, Loop);
+  addEdge(Loop, Loop);
+  addEdge(Loop, Exit);
+
+  MCConstantRegs Regs;
+  Regs.analyze(*F, *MIA, *MII, *MRI);
+  MCConstantRegs::Value V;
+  EXPECT_FALSE(lookup(Regs, 0x108, "X8", V));
+  EXPECT_FALSE(lookup(Regs, 0x108, "X9", V));
+  ASSERT_TRUE(lookup(Regs, 0x104, "X8", V));
+  EXPECT_EQ(1U, V.Val);
+}
+
+} // end anonymous namespace
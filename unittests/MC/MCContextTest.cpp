@@ -0,0 +1,48 @@
+//===- MCContextTest.cpp --------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MC/MCContext.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/MC/MCAsmInfo.h"
+#include "llvm/MC/MCExpr.h"
+#include "llvm/MC/MCSymbol.h"
+#include "llvm/Support/ThreadPool.h"
+#include "gtest/gtest.h"
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+
+TEST(MCContext, SymbolRefConcurrently) {
+  MCAsmInfo MAI;
+  MCContext Ctx(&MAI, nullptr, nullptr);
+
+  const unsigned NumNames = 64, NumRounds = 8;
+  std::vector<std::string> Names;
+  for (unsigned I = 0; I != NumNames; ++I)
+    Names.push_back(("sym" + Twine(I)).str());
+
+  // Every round asks for every name, so that the threads race to create them.
+  std::vector<const MCSymbolRefExpr *> Refs(NumNames * NumRounds);
+  ThreadPool Pool(3);
+  parallel_for(Pool, 0, Refs.size(), [&](size_t I) {
+    Refs[I] = Ctx.getOrCreateSymbolRefConcurrently(Names[I % NumNames]);
+  });
+
+  for (unsigned I = 0; I != Refs.size(); ++I) {
+    ASSERT_TRUE(Refs[I] != nullptr);
+    EXPECT_EQ(Refs[I % NumNames], Refs[I]);
+    EXPECT_EQ(Names[I % NumNames], Refs[I]->getSymbol().getName());
+    EXPECT_EQ(Ctx.lookupSymbol(Names[I % NumNames]), &Refs[I]->getSymbol());
+  }
+}
+
+} // end anonymous namespace
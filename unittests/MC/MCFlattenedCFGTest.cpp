@@ -0,0 +1,107 @@
+//===- MCFlattenedCFGTest.cpp ---------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MC/MCAnalysis/MCFlattenedCFG.h"
+#include "MCTargetTest.h"
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCAnalysis/MCModule.h"
+#include "llvm/MC/MCInstBuilder.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+class MCFlattenedCFGTest : public MCTargetTest {
+protected:
+  // Create, in \p F, an entry going to a dispatcher, with \p NumCases
+  // successors, which all go back to a hub before it. The cases set W8 to
+  // their number if \p SetState, and only add to it otherwise.
+  void addFlattened(MCFunction &F, unsigned NumCases, bool SetState) {
+    const unsigned W8 = getReg("W8");
+    MCBasicBlock &Entry = F.createBlock(0x100);
+    Entry.addInst(MCInstBuilder(getOpcode("MOVZWi"))
+                      .addReg(W8).addImm(0).addImm(0), 4);
+    MCBasicBlock &Dispatcher = F.createBlock(0x104);
+    Dispatcher.addInst(MCInstBuilder(getOpcode("BR")).addReg(getReg("X9")),
+                       4);
+    MCBasicBlock &Hub = F.createBlock(0x108);
+    Hub.addInst(MCInstBuilder(getOpcode("B")).addImm(-1), 4);
+    addEdge(Entry, Dispatcher);
+    addEdge(Hub, Dispatcher);
+    for (unsigned I = 0; I != NumCases; ++I) {
+      MCBasicBlock &Case = F.createBlock(0x200 + I * 8);
+      if (SetState)
+        Case.addInst(MCInstBuilder(getOpcode("MOVZWi"))
+                         .addReg(W8).addImm(I + 1).addImm(0), 4);
+      else
+        Case.addInst(MCInstBuilder(getOpcode("ADDWri"))
+                         .addReg(W8).addReg(W8).addImm(I + 1).addImm(0), 4);
+      Case.addInst(MCInstBuilder(getOpcode("B")).addImm(-1), 4);
+      addEdge(Dispatcher, Case);
+      addEdge(Case, Hub);
+    }
+  }
+};
+
+TEST_F(MCFlattenedCFGTest, Flattened) {
+  MCModule M;
+  MCFunction *F = M.createFunction("f", 0x100);
+  addFlattened(*F, 10, true);
+
+  MCFlattenedCFG Flat;
+  ASSERT_TRUE(Flat.analyze(*F, *MII));
+  EXPECT_EQ(0x108U, Flat.getHub()->getStartAddr());
+  EXPECT_EQ(0x104U, Flat.getDispatcher()->getStartAddr());
+  EXPECT_EQ(getReg("W8"), Flat.getStateReg());
+  EXPECT_EQ(10U, Flat.getNumCases());
+}
+
+TEST_F(MCFlattenedCFGTest, NoState) {
+  MCModule M;
+  MCFunction *F = M.createFunction("f", 0x100);
+  addFlattened(*F, 10, false);
+
+  MCFlattenedCFG Flat;
+  EXPECT_FALSE(Flat.analyze(*F, *MII));
+  EXPECT_TRUE(Flat.empty());
+}
+
+TEST_F(MCFlattenedCFGTest, FewCases) {
+  MCModule M;
+  MCFunction *F = M.createFunction("f", 0x100);
+  addFlattened(*F, MCFlattenedCFG::MinCases - 1, true);
+
+  MCFlattenedCFG Flat;
+  EXPECT_FALSE(Flat.analyze(*F, *MII));
+}
+
+TEST_F(MCFlattenedCFGTest, SharedExit) {
+  MCModule M;
+  MCFunction *F = M.createFunction("f", 0x100);
+  // Many blocks setting the result, then going to the same return.
+  const unsigned W0 = getReg("W0");
+  MCBasicBlock &Entry = F->createBlock(0x100);
+  Entry.addInst(MCInstBuilder(getOpcode("BR")).addReg(getReg("X9")), 4);
+  MCBasicBlock &Exit = F->createBlock(0x104);
+  Exit.addInst(MCInstBuilder(getOpcode("RET")).addReg(getReg("LR")), 4);
+  for (unsigned I = 0; I != 10; ++I) {
+    MCBasicBlock &Case = F->createBlock(0x200 + I * 8);
+    Case.addInst(MCInstBuilder(getOpcode("MOVZWi"))
+                     .addReg(W0).addImm(I).addImm(0), 4);
+    Case.addInst(MCInstBuilder(getOpcode("B")).addImm(-1), 4);
+    addEdge(Entry, Case);
+    addEdge(Case, Exit);
+  }
+
+  MCFlattenedCFG Flat;
+  EXPECT_FALSE(Flat.analyze(*F, *MII));
+}
+
+} // end anonymous namespace
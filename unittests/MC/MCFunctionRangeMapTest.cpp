@@ -0,0 +1,92 @@
+//===- MCFunctionRangeMapTest.cpp -----------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MC/MCAnalysis/MCFunctionRangeMap.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+TEST(MCFunctionRangeMapTest, SortsAndUniques) {
+  MCFunctionRangeMap Map({0x300, 0x100, 0x200, 0x100});
+
+  ASSERT_EQ(3U, Map.size());
+  EXPECT_EQ(0x100U, Map.getStarts()[0]);
+  EXPECT_EQ(0x200U, Map.getStarts()[1]);
+  EXPECT_EQ(0x300U, Map.getStarts()[2]);
+}
+
+TEST(MCFunctionRangeMapTest, Lookups) {
+  MCFunctionRangeMap Map({0x100, 0x200, 0x300});
+
+  EXPECT_EQ(Map.begin() + 1, Map.find(0x200));
+  EXPECT_EQ(Map.end(), Map.find(0x204));
+
+  EXPECT_EQ(Map.end(), Map.findContaining(0xFC));
+  EXPECT_EQ(Map.begin(), Map.findContaining(0x100));
+  EXPECT_EQ(Map.begin(), Map.findContaining(0x1FC));
+  EXPECT_EQ(Map.begin() + 2, Map.findContaining(0x400));
+
+  EXPECT_EQ(Map.begin(), Map.findNextStart(0xFC));
+  EXPECT_EQ(Map.begin() + 1, Map.findNextStart(0x100));
+  EXPECT_EQ(Map.end(), Map.findNextStart(0x300));
+
+  EXPECT_EQ(0x200U, Map.getEndAddr(Map.begin()));
+  EXPECT_EQ(UINT64_MAX, Map.getEndAddr(Map.begin() + 2));
+}
+
+TEST(MCFunctionRangeMapTest, BoundedFunctions) {
+  MCFunctionRangeMap Map({0x100, 0x200, 0x300});
+
+  EXPECT_FALSE(Map.isInBoundedFunction(0xFC));
+  EXPECT_TRUE(Map.isInBoundedFunction(0x100));
+  EXPECT_TRUE(Map.isInBoundedFunction(0x2FC));
+  EXPECT_TRUE(Map.isInBoundedFunction(0x300));
+  EXPECT_FALSE(Map.isInBoundedFunction(0x304));
+
+  EXPECT_FALSE(MCFunctionRangeMap({0x100}).isInBoundedFunction(0x100));
+}
+
+TEST(MCFunctionRangeMapTest, KnownEnds) {
+  // The first function is followed by padding, and the last one by data.
+  MCFunctionRangeMap Map({0x100, 0x200, 0x300});
+  Map.setEnds({0x380, 0x1F0, 0x380});
+  EXPECT_EQ(2U, Map.getEnds().size());
+
+  EXPECT_EQ(0x1F0U, Map.getEndAddr(Map.begin()));
+  EXPECT_EQ(0x300U, Map.getEndAddr(Map.begin() + 1));
+  EXPECT_EQ(0x380U, Map.getEndAddr(Map.begin() + 2));
+  EXPECT_EQ(0x200U, Map.getNextBoundary(0x1F0));
+  EXPECT_EQ(UINT64_MAX, Map.getNextBoundary(0x380));
+
+  EXPECT_TRUE(Map.isInBoundedFunction(0x37C));
+  EXPECT_FALSE(Map.isInBoundedFunction(0x380));
+  EXPECT_FALSE(Map.isInBoundedFunction(0xFC));
+}
+
+TEST(MCFunctionRangeMapTest, ShardRanges) {
+  // A large function first: the first shard only has it.
+  MCFunctionRangeMap Map({0x100, 0x500, 0x600, 0x700, 0x800});
+
+  typedef std::pair<uint64_t, uint64_t> Range;
+  EXPECT_EQ(Range(0, UINT64_MAX), Map.getShardRange(0, 1, 0x900));
+  EXPECT_EQ(Range(0, 0x500), Map.getShardRange(0, 2, 0x900));
+  EXPECT_EQ(Range(0x500, UINT64_MAX), Map.getShardRange(1, 2, 0x900));
+
+  // The ranges are consecutive, and a shard can be empty.
+  EXPECT_EQ(Range(0, 0x500), Map.getShardRange(0, 4, 0x900));
+  EXPECT_EQ(Range(0x500, 0x500), Map.getShardRange(1, 4, 0x900));
+  EXPECT_EQ(Range(0x500, 0x700), Map.getShardRange(2, 4, 0x900));
+  EXPECT_EQ(Range(0x700, UINT64_MAX), Map.getShardRange(3, 4, 0x900));
+
+  EXPECT_EQ(Range(0, UINT64_MAX), MCFunctionRangeMap().getShardRange(0, 2, 0));
+}
+
+} // end anonymous namespace
@@ -0,0 +1,205 @@
+//===- MCFunctionTest.cpp -------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCAnalysis/MCModule.h"
+#include "llvm/MC/MCInstBuilder.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+// Append NumInsts 4-byte instructions to BB.
+static void addInsts(MCBasicBlock &BB, unsigned NumInsts) {
+  for (unsigned I = 0; I != NumInsts; ++I)
+    BB.addInst(MCInstBuilder(I + 1), 4);
+}
+
+TEST(MCBasicBlockTest, RemoveInsts) {
+  MCModule M;
+  MCFunction *F = M.createFunction("f", 0x100);
+  MCBasicBlock &BB = F->createBlock(0x100);
+  for (unsigned Opcode : {1, 2, 1, 3})
+    BB.addInst(MCInstBuilder(Opcode), 4);
+
+  EXPECT_EQ(2U, BB.removeInsts([](const MCDecodedInst &I) {
+    return I.Inst.getOpcode() == 1;
+  }));
+
+  ASSERT_EQ(2U, BB.size());
+  EXPECT_EQ(2U, BB.begin()[0].Inst.getOpcode());
+  EXPECT_EQ(0x104U, BB.begin()[0].Address);
+  EXPECT_EQ(3U, BB.begin()[1].Inst.getOpcode());
+  EXPECT_EQ(0x10CU, BB.begin()[1].Address);
+  EXPECT_EQ(0x110U, BB.getEndAddr());
+
+  // Appending still goes after the last removed instruction.
+  BB.addInst(MCInstBuilder(4), 4);
+  EXPECT_EQ(0x110U, BB.back().Address);
+}
+
+TEST(MCFunctionTest, ReleaseInsts) {
+  MCModule M;
+  MCFunction *F = M.createFunction("f", 0x100);
+  std::vector<MCDecodedInst> Insts;
+  for (unsigned I = 0; I != 3; ++I)
+    Insts.push_back(MCDecodedInst(MCInstBuilder(I + 1), 0x100 + 4 * I, 4));
+  MutableArrayRef<MCDecodedInst> Owned = F->moveInsts(Insts);
+  MCBasicBlock &Entry = F->createBlock(0x100);
+  MCBasicBlock &Next = F->createBlock(0x108);
+  Entry.addSuccessor(&Next);
+  Next.addPredecessor(&Entry);
+  ASSERT_EQ(3U, Owned.size());
+  EXPECT_EQ(2U, Owned[1].Inst.getOpcode());
+
+  F->releaseInsts();
+  EXPECT_TRUE(F->areInstsReleased());
+  ASSERT_EQ(1U, F->size());
+  EXPECT_EQ(0x100U, F->getEntryBlock()->getStartAddr());
+  EXPECT_TRUE(F->getEntryBlock()->empty());
+  EXPECT_EQ(F->getEntryBlock()->succ_begin(), F->getEntryBlock()->succ_end());
+  EXPECT_EQ(F, M.findFunctionAt(0x100));
+  EXPECT_EQ("f", F->getName());
+  EXPECT_EQ(0U, M.getMemoryUsage().Insts);
+}
+
+TEST(MCFunctionTest, FindBlocks) {
+  MCModule M;
+  MCFunction *F = M.createFunction("f", 0x100);
+  // The entry block comes first, but isn't the first by address.
+  MCBasicBlock &Entry = F->createBlock(0x100);
+  MCBasicBlock &Before = F->createBlock(0xF0);
+  MCBasicBlock &After = F->createBlock(0x120);
+  addInsts(Entry, 2);
+  addInsts(Before, 1);
+  addInsts(After, 3);
+
+  EXPECT_EQ(&Entry, F->find(0x100));
+  EXPECT_EQ(&Before, F->find(0xF0));
+  EXPECT_EQ(nullptr, F->find(0x104));
+  EXPECT_EQ(&Entry, F->findContaining(0x107));
+  EXPECT_EQ(nullptr, F->findContaining(0x108));
+  EXPECT_EQ(&After, F->findContaining(0x12B));
+  EXPECT_EQ(nullptr, F->findContaining(0x12C));
+  EXPECT_EQ(&Entry, F->findFirstAfter(0xF0));
+  EXPECT_EQ(&After, F->findFirstAfter(0x100));
+  EXPECT_EQ(nullptr, F->findFirstAfter(0x120));
+
+  // Blocks created after a lookup are found too.
+  MCBasicBlock &Last = F->createBlock(0x200);
+  addInsts(Last, 1);
+  EXPECT_EQ(&Last, F->findContaining(0x202));
+}
+
+TEST(MCFunctionTest, Edges) {
+  MCModule M;
+  MCFunction *F = M.createFunction("f", 0x100);
+  MCBasicBlock &Entry = F->createBlock(0x100);
+  MCBasicBlock &Loop = F->createBlock(0x110);
+  MCBasicBlock &Exit = F->createBlock(0x120);
+  EXPECT_EQ(1U, Loop.getIndex());
+  EXPECT_EQ(&Exit, F->getBlock(2));
+
+  // Entry -> Loop -> {Loop, Exit}; the predecessors are in block order.
+  const uint32_t Succs[] = {1, 1, 2};
+  const uint32_t SuccBegins[] = {0, 1, 3, 3};
+  F->setSuccessors(Succs, SuccBegins);
+  ASSERT_EQ(2U, Loop.succ_size());
+  EXPECT_EQ(&Loop, *Loop.succ_begin());
+  EXPECT_EQ(&Exit, Loop.succ_begin()[1]);
+  ASSERT_EQ(2U, Loop.pred_size());
+  EXPECT_EQ(0U, Loop.pred_indices()[0]);
+  EXPECT_EQ(1U, Loop.pred_indices()[1]);
+  EXPECT_TRUE(Exit.isPredecessor(&Loop));
+  EXPECT_FALSE(Exit.isSuccessor(&Loop));
+  EXPECT_EQ(0U, Exit.succ_size());
+
+  // Adding an edge copies the block's edges, until they're finalized.
+  Exit.addSuccessor(&Entry);
+  Entry.addPredecessor(&Exit);
+  Entry.addPredecessor(&Exit);
+  EXPECT_TRUE(Exit.isSuccessor(&Entry));
+  ASSERT_EQ(1U, Entry.pred_size());
+  F->finalizeEdges();
+  EXPECT_EQ(&Loop, *Entry.succ_begin());
+  EXPECT_EQ(&Exit, *Entry.pred_begin());
+  EXPECT_EQ(&Entry, *Exit.succ_begin());
+  EXPECT_EQ(2U, Loop.succ_end() - Loop.succ_begin());
+  EXPECT_TRUE(Loop.isPredecessor(&Loop));
+}
+
+TEST(MCFunctionTest, CopyBlocks) {
+  MCModule Prior;
+  MCFunction *Src = Prior.createFunction("f", 0x100);
+  MCBasicBlock &Entry = Src->createBlock(0x100);
+  addInsts(Entry, 4);
+  MCBasicBlock &Loop = Src->createBlock(0x110);
+  addInsts(Loop, 2);
+  Entry.addSuccessor(&Loop);
+  Loop.addPredecessor(&Entry);
+  Loop.addSuccessor(&Loop);
+  Loop.addPredecessor(&Loop);
+
+  MCModule M;
+  MCFunction *F = M.createFunction("f", 0x100);
+  F->copyBlocks(*Src);
+  ASSERT_EQ(2U, F->size());
+  const MCBasicBlock *NewEntry = F->getBlock(0);
+  const MCBasicBlock *NewLoop = F->getBlock(1);
+  EXPECT_EQ(0x110U, NewLoop->getStartAddr());
+  EXPECT_EQ(0x118U, NewLoop->getEndAddr());
+  ASSERT_EQ(4U, NewEntry->size());
+  EXPECT_EQ(4U, NewEntry->begin()[3].Inst.getOpcode());
+  EXPECT_EQ(0x10CU, NewEntry->begin()[3].Address);
+  EXPECT_NE(Entry.begin(), NewEntry->begin());
+  EXPECT_EQ(NewLoop, *NewEntry->succ_begin());
+  EXPECT_TRUE(NewLoop->isSuccessor(NewLoop));
+  EXPECT_TRUE(NewLoop->isPredecessor(NewEntry));
+  EXPECT_EQ(2U, NewLoop->pred_size());
+}
+
+TEST(MCFunctionTest, PackInsts) {
+  MCModule M;
+  MCFunction *F = M.createFunction("f", 0x100);
+  MCBasicBlock &Entry = F->createBlock(0x100);
+  MCBasicBlock &Next = F->createBlock(0x10C);
+  Entry.addInst(MCInstBuilder(1).addReg(3).addImm(-5), 4);
+  Entry.addInst(MCInstBuilder(2).addFPImm(1.5).addImm(1ULL << 40), 8);
+  addInsts(Next, 3);
+  Entry.addSuccessor(&Next);
+  // Leave a gap, as the MC peepholes do.
+  Next.removeInsts([](const MCDecodedInst &I) { return I.Address == 0x110; });
+
+  EXPECT_TRUE(F->packInsts());
+  EXPECT_TRUE(F->areInstsPacked());
+  EXPECT_TRUE(Entry.empty());
+  EXPECT_EQ(0x10CU, Entry.getEndAddr());
+  EXPECT_TRUE(Entry.isSuccessor(&Next));
+
+  F->unpackInsts();
+  EXPECT_FALSE(F->areInstsPacked());
+  ASSERT_EQ(2U, Entry.size());
+  const MCInst &First = Entry.begin()[0].Inst;
+  EXPECT_EQ(1U, First.getOpcode());
+  ASSERT_EQ(2U, First.getNumOperands());
+  EXPECT_EQ(3U, First.getOperand(0).getReg());
+  EXPECT_EQ(-5, First.getOperand(1).getImm());
+  const MCDecodedInst &Second = Entry.begin()[1];
+  EXPECT_EQ(0x104U, Second.Address);
+  EXPECT_EQ(8U, Second.Size);
+  EXPECT_EQ(1.5, Second.Inst.getOperand(0).getFPImm());
+  EXPECT_EQ(int64_t(1) << 40, Second.Inst.getOperand(1).getImm());
+  ASSERT_EQ(2U, Next.size());
+  EXPECT_EQ(0x10CU, Next.begin()[0].Address);
+  EXPECT_EQ(0x114U, Next.begin()[1].Address);
+  EXPECT_EQ(0x118U, Next.getEndAddr());
+}
+
+} // end anonymous namespace
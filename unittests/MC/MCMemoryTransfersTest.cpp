@@ -0,0 +1,108 @@
+//===- MCMemoryTransfersTest.cpp ------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MC/MCAnalysis/MCMemoryTransfers.h"
+#include "MCTargetTest.h"
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCAnalysis/MCModule.h"
+#include "llvm/MC/MCInstBuilder.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+class MCMemoryTransfersTest : public MCTargetTest {
+protected:
+  void addPair(MCBasicBlock &BB, StringRef Opcode, StringRef Reg0,
+               StringRef Reg1, StringRef Base, int64_t Imm) {
+    BB.addInst(MCInstBuilder(getOpcode(Opcode))
+                   .addReg(getReg(Reg0)).addReg(getReg(Reg1))
+                   .addReg(getReg(Base)).addImm(Imm), 4);
+  }
+};
+
+TEST_F(MCMemoryTransfersTest, Clear) {
+  MCModule M;
+  MCFunction *F = M.createFunction("f", 0x100);
+  MCBasicBlock &BB = F->createBlock(0x100);
+  addPair(BB, "STPXi", "XZR", "XZR", "X0", 2);
+  addPair(BB, "STPXi", "XZR", "XZR", "X0", 0);
+  addPair(BB, "STPXi", "XZR", "XZR", "X0", 4);
+  // Not the same block.
+  addPair(BB, "STPXi", "XZR", "XZR", "X1", 0);
+  BB.addInst(MCInstBuilder(getOpcode("RET")).addReg(getReg("LR")), 4);
+
+  MCMemoryTransfers Transfers;
+  Transfers.analyze(*F, *MIA, *MRI);
+  ASSERT_EQ(1U, Transfers.size());
+  const MCMemoryTransfers::Transfer *T = Transfers.lookup(0x104);
+  ASSERT_TRUE(T);
+  EXPECT_EQ(T, Transfers.lookup(0x100));
+  EXPECT_EQ(T, Transfers.lookup(0x108));
+  EXPECT_FALSE(Transfers.lookup(0x10C));
+  EXPECT_TRUE(T->isClear());
+  EXPECT_EQ(0x100U, T->BeginAddr);
+  EXPECT_EQ(0x10CU, T->EndAddr);
+  EXPECT_EQ(getReg("X0"), T->DstBaseReg);
+  EXPECT_EQ(0, T->DstOffset);
+  EXPECT_EQ(48U, T->Size);
+}
+
+TEST_F(MCMemoryTransfersTest, Copy) {
+  MCModule M;
+  MCFunction *F = M.createFunction("f", 0x100);
+  MCBasicBlock &BB = F->createBlock(0x100);
+  addPair(BB, "LDPQi", "Q0", "Q1", "X1", 0);
+  addPair(BB, "LDPQi", "Q2", "Q3", "X1", 2);
+  addPair(BB, "STPQi", "Q2", "Q3", "X0", 3);
+  addPair(BB, "STPQi", "Q0", "Q1", "X0", 1);
+  BB.addInst(MCInstBuilder(getOpcode("RET")).addReg(getReg("LR")), 4);
+
+  MCMemoryTransfers Transfers;
+  Transfers.analyze(*F, *MIA, *MRI);
+  ASSERT_EQ(1U, Transfers.size());
+  const MCMemoryTransfers::Transfer *T = Transfers.lookup(0x100);
+  ASSERT_TRUE(T);
+  EXPECT_FALSE(T->isClear());
+  EXPECT_EQ(0x110U, T->EndAddr);
+  EXPECT_EQ(getReg("X1"), T->SrcBaseReg);
+  EXPECT_EQ(0, T->SrcOffset);
+  EXPECT_EQ(getReg("X0"), T->DstBaseReg);
+  EXPECT_EQ(16, T->DstOffset);
+  EXPECT_EQ(64U, T->Size);
+  ASSERT_EQ(4U, T->Regs.size());
+  EXPECT_EQ(getReg("Q2"), T->Regs[0].first);
+  EXPECT_EQ(48, T->Regs[0].second);
+  EXPECT_EQ(getReg("Q1"), T->Regs[3].first);
+  EXPECT_EQ(32, T->Regs[3].second);
+}
+
+TEST_F(MCMemoryTransfersTest, Mismatched) {
+  MCModule M;
+  MCFunction *F = M.createFunction("f", 0x100);
+  MCBasicBlock &BB = F->createBlock(0x100);
+  // The registers are swapped by the stores.
+  addPair(BB, "LDPXi", "X8", "X9", "X1", 0);
+  addPair(BB, "LDPXi", "X10", "X11", "X1", 2);
+  addPair(BB, "STPXi", "X10", "X11", "X0", 0);
+  addPair(BB, "STPXi", "X8", "X9", "X0", 2);
+  // The base is loaded.
+  addPair(BB, "LDPXi", "X8", "X1", "X1", 0);
+  addPair(BB, "LDPXi", "X10", "X11", "X1", 2);
+  addPair(BB, "STPXi", "X8", "X1", "X0", 0);
+  addPair(BB, "STPXi", "X10", "X11", "X0", 2);
+  BB.addInst(MCInstBuilder(getOpcode("RET")).addReg(getReg("LR")), 4);
+
+  MCMemoryTransfers Transfers;
+  Transfers.analyze(*F, *MIA, *MRI);
+  EXPECT_TRUE(Transfers.empty());
+}
+
+} // end anonymous namespace
@@ -0,0 +1,90 @@
+//===- MCModuleBinaryTest.cpp ---------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MC/MCAnalysis/MCModuleBinary.h"
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCAnalysis/MCModule.h"
+#include "llvm/MC/MCInstBuilder.h"
+#include "llvm/MC/MCInstrInfo.h"
+#include "llvm/MC/MCRegisterInfo.h"
+#include "llvm/Support/TargetRegistry.h"
+#include "llvm/Support/TargetSelect.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+TEST(MCModuleBinaryTest, RoundTrip) {
+  InitializeAllTargetInfos();
+  InitializeAllTargetMCs();
+  std::string Error;
+  const char *TripleName = "x86_64-pc-linux";
+  const Target *T = TargetRegistry::lookupTarget(TripleName, Error);
+  if (!T)
+    return;
+  std::unique_ptr<MCInstrInfo> MII(T->createMCInstrInfo());
+  std::unique_ptr<MCRegisterInfo> MRI(T->createMCRegInfo(TripleName));
+
+  MCModule M;
+  M.createFunction("ext", 0x50);
+  MCFunction *F = M.createFunction("f", 0x100);
+  MCBasicBlock &Entry = F->createBlock(0x100);
+  Entry.addInst(MCInstBuilder(1).addReg(2).addImm(-3), 4);
+  Entry.addInst(MCInstBuilder(2).addFPImm(0.5), 2);
+  MCBasicBlock &Exit = F->createBlock(0x106);
+  Exit.addInst(MCInstBuilder(3), 1);
+  Entry.addSuccessor(&Exit);
+  Exit.addPredecessor(&Entry);
+  Exit.addSuccessor(&Exit);
+
+  std::string Data;
+  raw_string_ostream OS(Data);
+  EXPECT_EQ("", mcmodule2binary(OS, M, *MII, *MRI, "tag"));
+  OS.flush();
+  EXPECT_TRUE(isMCModuleBinary(Data));
+
+  std::unique_ptr<MCModule> Read;
+  EXPECT_NE("", binary2mcmodule(Read, Data, *MII, *MRI, "other"));
+  EXPECT_FALSE(Read);
+  EXPECT_NE("", binary2mcmodule(Read, StringRef(Data).drop_back(2), *MII,
+                                *MRI, "tag"));
+  ASSERT_EQ("", binary2mcmodule(Read, Data, *MII, *MRI, "tag"));
+
+  ASSERT_TRUE(Read->findFunctionAt(0x50));
+  EXPECT_EQ("ext", Read->findFunctionAt(0x50)->getName());
+  EXPECT_TRUE(Read->findFunctionAt(0x50)->empty());
+
+  const MCFunction *RF = Read->findFunctionAt(0x100);
+  ASSERT_TRUE(RF);
+  EXPECT_EQ("f", RF->getName());
+  ASSERT_EQ(2U, RF->size());
+  const MCBasicBlock *REntry = RF->getEntryBlock();
+  const MCBasicBlock *RExit = RF->find(0x106);
+  ASSERT_TRUE(RExit);
+  EXPECT_EQ(0x100U, REntry->getStartAddr());
+  EXPECT_EQ(6U, REntry->getSizeInBytes());
+  ASSERT_EQ(2U, REntry->size());
+  const MCInst &I0 = REntry->begin()[0].Inst;
+  EXPECT_EQ(1U, I0.getOpcode());
+  ASSERT_EQ(2U, I0.getNumOperands());
+  EXPECT_EQ(2U, I0.getOperand(0).getReg());
+  EXPECT_EQ(-3, I0.getOperand(1).getImm());
+  EXPECT_EQ(0x104U, REntry->begin()[1].Address);
+  EXPECT_EQ(2U, REntry->begin()[1].Size);
+  EXPECT_EQ(0.5, REntry->begin()[1].Inst.getOperand(0).getFPImm());
+  EXPECT_EQ(0x107U, RExit->getEndAddr());
+
+  EXPECT_TRUE(REntry->isSuccessor(RExit));
+  EXPECT_TRUE(RExit->isPredecessor(REntry));
+  EXPECT_TRUE(RExit->isSuccessor(RExit));
+  EXPECT_FALSE(REntry->isPredecessor(RExit));
+}
+
+} // end anonymous namespace
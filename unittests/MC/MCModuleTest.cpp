@@ -0,0 +1,77 @@
+//===- MCModuleTest.cpp ---------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCAnalysis/MCModule.h"
+#include "llvm/MC/MCInstBuilder.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+// Add a block of NumInsts 4-byte instructions at Addr to F.
+static MCBasicBlock &addBlock(MCFunction &F, uint64_t Addr,
+                              unsigned NumInsts) {
+  MCBasicBlock &BB = F.createBlock(Addr);
+  for (unsigned I = 0; I != NumInsts; ++I)
+    BB.addInst(MCInstBuilder(I + 1), 4);
+  return BB;
+}
+
+TEST(MCModuleTest, FindContaining) {
+  MCModule M;
+  MCFunction *F = M.createFunction("f", 0x100);
+  addBlock(*F, 0x100, 2);
+  addBlock(*F, 0x108, 2);
+  MCFunction *G = M.createFunction("g", 0x200);
+  MCBasicBlock &GEntry = addBlock(*G, 0x200, 4);
+  // A function nested in the range of another: it is picked over it.
+  MCFunction *H = M.createFunction("h", 0x204);
+  MCBasicBlock &HEntry = addBlock(*H, 0x204, 1);
+
+  MCModule::AddressLocation Loc = M.findContaining(0x10A);
+  EXPECT_EQ(F, Loc.Function);
+  ASSERT_NE(nullptr, Loc.Block);
+  EXPECT_EQ(0x108U, Loc.Block->getStartAddr());
+  ASSERT_NE(nullptr, Loc.Inst);
+  EXPECT_EQ(0x108U, Loc.Inst->Address);
+
+  Loc = M.findContaining(0x205);
+  EXPECT_EQ(H, Loc.Function);
+  EXPECT_EQ(&HEntry, Loc.Block);
+  Loc = M.findContaining(0x20C);
+  EXPECT_EQ(G, Loc.Function);
+  EXPECT_EQ(&GEntry, Loc.Block);
+  EXPECT_EQ(0x20CU, Loc.Inst->Address);
+
+  EXPECT_EQ(nullptr, M.findContaining(0x110).Function);
+  EXPECT_EQ(nullptr, M.findContaining(0xFF).Function);
+  EXPECT_EQ(nullptr, M.findContaining(0x210).Function);
+
+  const uint64_t Addrs[] = {0x210, 0x104, 0x205, 0xFF, 0x20C, 0x100};
+  std::vector<MCModule::AddressLocation> Locs;
+  M.findContaining(Addrs, Locs);
+  ASSERT_EQ(6U, Locs.size());
+  for (unsigned I = 0; I != 6; ++I) {
+    Loc = M.findContaining(Addrs[I]);
+    EXPECT_EQ(Loc.Function, Locs[I].Function);
+    EXPECT_EQ(Loc.Block, Locs[I].Block);
+    EXPECT_EQ(Loc.Inst, Locs[I].Inst);
+  }
+
+  // Once released, only the entry block of a function is found.
+  F->releaseInsts();
+  Loc = M.findContaining(0x104);
+  EXPECT_EQ(F, Loc.Function);
+  EXPECT_EQ(F->getEntryBlock(), Loc.Block);
+  EXPECT_EQ(nullptr, Loc.Inst);
+}
+
+} // end anonymous namespace
@@ -0,0 +1,127 @@
+//===- MCOpcodeClassesTest.cpp --------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MC/MCAnalysis/MCOpcodeClasses.h"
+#include "MCTargetTest.h"
+#include "llvm/MC/MCInst.h"
+#include "gtest/gtest.h"
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+
+class MCOpcodeClassesAArch64Test : public MCTargetTest {};
+
+class MCOpcodeClassesX86Test : public MCTargetTest {
+protected:
+  MCOpcodeClassesX86Test() : MCTargetTest("x86_64-apple-darwin") {}
+};
+
+TEST_F(MCOpcodeClassesAArch64Test, Classes) {
+  MCOpcodeClasses Classes(*MIA);
+  const unsigned B = getOpcode("B"), BL = getOpcode("BL"),
+                 Bcc = getOpcode("Bcc"), BR = getOpcode("BR");
+  EXPECT_TRUE(Classes.isDirectJump(B));
+  EXPECT_FALSE(Classes.isDirectJump(BL));
+  EXPECT_FALSE(Classes.isDirectJump(Bcc));
+  EXPECT_FALSE(Classes.isDirectJump(BR));
+  EXPECT_TRUE(Classes.isCall(BL));
+  EXPECT_EQ(BL, Classes.getTailCallOpcode(B));
+  EXPECT_EQ(0U, Classes.getTailCallOpcode(Bcc));
+  EXPECT_EQ(getOpcode("RET"), Classes.getReturnOpcode());
+}
+
+TEST_F(MCOpcodeClassesX86Test, Classes) {
+  MCOpcodeClasses Classes(*MIA);
+  const unsigned JMP = getOpcode("JMP_4"), JE = getOpcode("JE_4");
+  EXPECT_TRUE(Classes.isDirectJump(JMP));
+  EXPECT_FALSE(Classes.isDirectJump(JE));
+  EXPECT_TRUE(Classes.getClass(JE) & MCOpcodeClasses::CondBranch);
+  EXPECT_TRUE(Classes.isCall(getOpcode("CALL64pcrel32")));
+  EXPECT_TRUE(Classes.isReturn(getOpcode("RETQ")));
+  // The calls only differ by their operand size: none is picked, and the
+  // disassembler leaves the tail calls alone.
+  EXPECT_EQ(0U, Classes.getTailCallOpcode(JMP));
+}
+
+TEST_F(MCOpcodeClassesAArch64Test, DirectCallTargets) {
+  // bl +8; b +4; bl -8; nops, then bl +0 in the second block of 64 words.
+  std::vector<uint32_t> Words(80, 0xd503201f);
+  Words[0] = 0x94000002;
+  Words[1] = 0x14000001;
+  Words[2] = 0x97fffffe;
+  Words[72] = 0x94000000;
+  std::vector<uint8_t> Bytes;
+  for (uint32_t W : Words)
+    for (unsigned I = 0; I != 4; ++I)
+      Bytes.push_back(uint8_t(W >> (8 * I)));
+  std::vector<uint64_t> Targets;
+  EXPECT_TRUE(MIA->findDirectCallTargets(Bytes, 0x1000, Targets));
+  std::vector<uint64_t> Expected = {0x1008, 0x1000, 0x1000 + 72 * 4};
+  EXPECT_EQ(Expected, Targets);
+}
+
+TEST_F(MCOpcodeClassesAArch64Test, PCRelativeAddress) {
+  const unsigned X0 = getReg("X0");
+  unsigned OpIdx;
+  uint64_t Target;
+
+  // adrp x0, #2 pages, from the middle of a page.
+  MCInst Adrp;
+  Adrp.setOpcode(getOpcode("ADRP"));
+  Adrp.addOperand(MCOperand::createReg(X0));
+  Adrp.addOperand(MCOperand::createImm(2));
+  EXPECT_TRUE(MIA->evaluatePCRelativeAddress(Adrp, 0x1234, 4, OpIdx, Target));
+  EXPECT_EQ(1U, OpIdx);
+  EXPECT_EQ(0x3000U, Target);
+
+  // ldr x0, #-8, in words.
+  MCInst Ldr;
+  Ldr.setOpcode(getOpcode("LDRXl"));
+  Ldr.addOperand(MCOperand::createReg(X0));
+  Ldr.addOperand(MCOperand::createImm(-2));
+  EXPECT_TRUE(MIA->evaluatePCRelativeAddress(Ldr, 0x1000, 4, OpIdx, Target));
+  EXPECT_EQ(0xFF8U, Target);
+
+  // add x0, x0, #8 isn't relative to the PC.
+  MCInst Add;
+  Add.setOpcode(getOpcode("ADDXri"));
+  Add.addOperand(MCOperand::createReg(X0));
+  Add.addOperand(MCOperand::createReg(X0));
+  Add.addOperand(MCOperand::createImm(8));
+  Add.addOperand(MCOperand::createImm(0));
+  EXPECT_FALSE(MIA->evaluatePCRelativeAddress(Add, 0x1000, 4, OpIdx, Target));
+}
+
+TEST_F(MCOpcodeClassesX86Test, PCRelativeAddress) {
+  unsigned OpIdx;
+  uint64_t Target;
+
+  // leaq 0x10(%rip), %rax, of 7 bytes, or from %rbx.
+  auto CreateLea = [&](StringRef Base) {
+    MCInst Lea;
+    Lea.setOpcode(getOpcode("LEA64r"));
+    Lea.addOperand(MCOperand::createReg(getReg("RAX")));
+    Lea.addOperand(MCOperand::createReg(getReg(Base)));
+    Lea.addOperand(MCOperand::createImm(1));
+    Lea.addOperand(MCOperand::createReg(0));
+    Lea.addOperand(MCOperand::createImm(0x10));
+    Lea.addOperand(MCOperand::createReg(0));
+    return Lea;
+  };
+  EXPECT_TRUE(MIA->evaluatePCRelativeAddress(CreateLea("RIP"), 0x1000, 7,
+                                             OpIdx, Target));
+  EXPECT_EQ(4U, OpIdx);
+  EXPECT_EQ(0x1017U, Target);
+  EXPECT_FALSE(MIA->evaluatePCRelativeAddress(CreateLea("RBX"), 0x1000, 7,
+                                              OpIdx, Target));
+}
+
+} // end anonymous namespace
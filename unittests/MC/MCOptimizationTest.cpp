@@ -0,0 +1,348 @@
+//===- MCOptimizationTest.cpp ---------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/MC/MCOptimization.h"
+#include "MCTargetTest.h"
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCAnalysis/MCModule.h"
+#include "llvm/MC/MCInstBuilder.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace object;
+
+namespace {
+
+const uint64_t TextAddr = 0x100000400ULL;
+const uint64_t StubsAddr = 0x100000500ULL;
+const uint64_t MethNameAddr = 0x100000600ULL;
+const uint64_t SelRefsAddr = 0x100001000ULL;
+
+// The symbols of the stubs, in stub order.
+const char *const StubNames[] = {"_objc_release", "_objc_copyWeak",
+                                 "_objc_storeStrong", "_objc_loadWeak",
+                                 "___stack_chk_fail", "_printf"};
+enum StubIndex {
+  Release,
+  CopyWeak,
+  StoreStrong,
+  LoadWeak,
+  StackChkFail,
+  Printf,
+  NumStubs
+};
+
+void append32(std::string &S, uint32_t V) {
+  char Bytes[4];
+  support::endian::write32le(Bytes, V);
+  S.append(Bytes, 4);
+}
+
+void append64(std::string &S, uint64_t V) {
+  char Bytes[8];
+  support::endian::write64le(Bytes, V);
+  S.append(Bytes, 8);
+}
+
+void appendName(std::string &S, StringRef Name) {
+  S.append(Name.data(), Name.size());
+  S.append(16 - Name.size(), '\0');
+}
+
+struct Section {
+  const char *Name;
+  uint64_t Addr, Size;
+  uint32_t Flags, Reserved1, Reserved2;
+};
+
+void appendSegment(std::string &S, StringRef Name, uint64_t VMAddr,
+                   uint64_t FileOff, uint64_t FileSize,
+                   ArrayRef<Section> Sections) {
+  append32(S, MachO::LC_SEGMENT_64);
+  append32(S, sizeof(MachO::segment_command_64) +
+                  Sections.size() * sizeof(MachO::section_64));
+  appendName(S, Name);
+  append64(S, VMAddr);
+  append64(S, 0x1000);
+  append64(S, FileOff);
+  append64(S, FileSize);
+  append32(S, 5);
+  append32(S, 5);
+  append32(S, Sections.size());
+  append32(S, 0);
+  for (const Section &Sect : Sections) {
+    appendName(S, Sect.Name);
+    appendName(S, Name);
+    append64(S, Sect.Addr);
+    append64(S, Sect.Size);
+    append32(S, FileOff + (Sect.Addr - VMAddr));
+    append32(S, 2);
+    append32(S, 0);
+    append32(S, 0);
+    append32(S, Sect.Flags);
+    append32(S, Sect.Reserved1);
+    append32(S, Sect.Reserved2);
+    append32(S, 0);
+  }
+}
+
+/// \brief Run the AArch64 peepholes on functions built by hand, against a
+/// 64-bit Mach-O executable with a stub for each of StubNames, and a
+/// selector reference to "sel", in __objc_methname.
+class MCOptimizationTest : public MCTargetTest {
+protected:
+  std::string Bytes;
+  std::unique_ptr<MachOObjectFile> Obj;
+  MCModule M;
+  std::unique_ptr<MCOptimization> MCO;
+
+  void SetUp() override {
+    MCTargetTest::SetUp();
+    buildImage();
+    ASSERT_TRUE(Obj != nullptr);
+    MCO.reset(new MCOptimization(&M, Obj.get(), *MII, *MRI));
+    ASSERT_EQ(size_t(NumStubs), MCO->getNumStubs());
+  }
+
+  void buildImage() {
+    const uint32_t DataFileOff = 0x800, SymOff = 0x900;
+    const Section Text[] = {
+        {"__text", TextAddr, 0x100,
+         MachO::S_ATTR_PURE_INSTRUCTIONS | MachO::S_ATTR_SOME_INSTRUCTIONS, 0,
+         0},
+        {"__stubs", StubsAddr, NumStubs * 12,
+         MachO::S_SYMBOL_STUBS | MachO::S_ATTR_PURE_INSTRUCTIONS, 0, 12},
+        {"__objc_methname", MethNameAddr, 9, MachO::S_CSTRING_LITERALS, 0, 0}};
+    const Section Data[] = {
+        {"__objc_selrefs", SelRefsAddr, 8, MachO::S_LITERAL_POINTERS, 0, 0}};
+
+    // One undefined symbol per stub, and the indirect symbol table mapping
+    // the stubs to them.
+    std::string Symbols, Strings(1, '\0'), Indirect;
+    for (unsigned I = 0; I != NumStubs; ++I) {
+      append32(Symbols, Strings.size());
+      Symbols += char(MachO::N_UNDF | MachO::N_EXT);
+      Symbols.append(3, '\0');
+      append64(Symbols, 0);
+      Strings += StubNames[I];
+      Strings += '\0';
+      append32(Indirect, I);
+    }
+    const uint32_t IndirectOff = SymOff + Symbols.size();
+    const uint32_t StrOff = IndirectOff + Indirect.size();
+
+    std::string Cmds;
+    appendSegment(Cmds, "__TEXT", TextAddr & ~0xFFFULL, 0, DataFileOff, Text);
+    appendSegment(Cmds, "__DATA", SelRefsAddr, DataFileOff, 8, Data);
+    append32(Cmds, MachO::LC_SYMTAB);
+    append32(Cmds, sizeof(MachO::symtab_command));
+    append32(Cmds, SymOff);
+    append32(Cmds, NumStubs);
+    append32(Cmds, StrOff);
+    append32(Cmds, Strings.size());
+    append32(Cmds, MachO::LC_DYSYMTAB);
+    append32(Cmds, sizeof(MachO::dysymtab_command));
+    for (unsigned I = 0; I != 4; ++I)
+      append32(Cmds, 0);
+    append32(Cmds, 0);
+    append32(Cmds, NumStubs);
+    for (unsigned I = 0; I != 6; ++I)
+      append32(Cmds, 0);
+    append32(Cmds, IndirectOff);
+    append32(Cmds, NumStubs);
+    for (unsigned I = 0; I != 4; ++I)
+      append32(Cmds, 0);
+
+    append32(Bytes, MachO::MH_MAGIC_64);
+    append32(Bytes, MachO::CPU_TYPE_ARM64);
+    append32(Bytes, 0);
+    append32(Bytes, MachO::MH_EXECUTE);
+    append32(Bytes, 4);
+    append32(Bytes, Cmds.size());
+    append32(Bytes, 0);
+    append32(Bytes, 0);
+    Bytes += Cmds;
+    Bytes.resize(MethNameAddr - (TextAddr & ~0xFFFULL), '\0');
+    Bytes.append("init\0sel\0", 9);
+    Bytes.resize(DataFileOff, '\0');
+    append64(Bytes, MethNameAddr + 5);
+    Bytes.resize(SymOff, '\0');
+    Bytes += Symbols + Indirect + Strings;
+
+    ErrorOr<std::unique_ptr<ObjectFile>> ObjOrErr =
+        ObjectFile::createMachOObjectFile(MemoryBufferRef(Bytes, "image"));
+    ASSERT_FALSE(ObjOrErr.getError());
+    Obj.reset(cast<MachOObjectFile>(ObjOrErr->release()));
+  }
+
+  // Append a call to the stub \p Stub to \p BB.
+  void addCall(MCBasicBlock &BB, unsigned Stub) {
+    const int64_t Offset = int64_t(StubsAddr + Stub * 12) -
+                           int64_t(BB.getStartAddr() + BB.getSizeInBytes());
+    BB.addInst(MCInstBuilder(getOpcode("BL")).addImm(Offset / 4), 4);
+  }
+
+  void addNop(MCBasicBlock &BB, int64_t Imm = 0) {
+    BB.addInst(MCInstBuilder(getOpcode("HINT")).addImm(Imm), 4);
+  }
+
+  bool isNop(const MCDecodedInst &I) {
+    return I.Inst.getOpcode() == getOpcode("HINT") &&
+           I.Inst.getOperand(0).getImm() == 0;
+  }
+
+  bool isCall(const MCDecodedInst &I) {
+    return I.Inst.getOpcode() == getOpcode("BL");
+  }
+
+  bool isTrap(const MCDecodedInst &I) {
+    return I.Inst.getOpcode() == getOpcode("BRK") &&
+           I.Inst.getOperand(0).getImm() == 1;
+  }
+};
+
+TEST_F(MCOptimizationTest, StubNames) {
+  for (unsigned I = 0; I != NumStubs; ++I)
+    EXPECT_EQ(StubNames[I], MCO->getStubName(StubsAddr + I * 12));
+  EXPECT_EQ("", MCO->getStubName(TextAddr));
+  EXPECT_EQ("", MCO->getStubName(StubsAddr + NumStubs * 12));
+}
+
+TEST_F(MCOptimizationTest, ARCElimination) {
+  MCFunction *F = M.createFunction("f", TextAddr);
+  MCBasicBlock &BB = F->createBlock(TextAddr);
+  for (unsigned Stub : {Release, CopyWeak, StoreStrong, LoadWeak, Printf})
+    addCall(BB, Stub);
+
+  EXPECT_EQ(4U, createARCEliminationPeephole(*MCO)->runOnFunction(*F));
+  const unsigned X0 = getReg("X0"), X1 = getReg("X1");
+  MCBasicBlock::iterator I = BB.begin();
+  EXPECT_TRUE(isNop(*I++));
+
+  // objc_copyWeak: mov x0, x1.
+  EXPECT_EQ(getOpcode("ORRXrs"), I->Inst.getOpcode());
+  EXPECT_EQ(X0, I->Inst.getOperand(0).getReg());
+  EXPECT_EQ(getReg("XZR"), I->Inst.getOperand(1).getReg());
+  EXPECT_EQ(X1, I->Inst.getOperand(2).getReg());
+  ++I;
+
+  // objc_storeStrong: str x1, [x0].
+  EXPECT_EQ(getOpcode("STRXui"), I->Inst.getOpcode());
+  EXPECT_EQ(X1, I->Inst.getOperand(0).getReg());
+  EXPECT_EQ(X0, I->Inst.getOperand(1).getReg());
+  EXPECT_EQ(0, I->Inst.getOperand(2).getImm());
+  ++I;
+
+  // objc_loadWeak: ldr x0, [x0].
+  EXPECT_EQ(getOpcode("LDRXui"), I->Inst.getOpcode());
+  EXPECT_EQ(X0, I->Inst.getOperand(0).getReg());
+  EXPECT_EQ(X0, I->Inst.getOperand(1).getReg());
+  ++I;
+
+  // Other calls are left alone.
+  EXPECT_TRUE(isCall(*I));
+}
+
+TEST_F(MCOptimizationTest, SelectorPropagation) {
+  const unsigned ADRP = getOpcode("ADRP"), LDRXui = getOpcode("LDRXui");
+  const unsigned X8 = getReg("X8"), X9 = getReg("X9");
+  MCFunction *F = M.createFunction("f", TextAddr);
+  MCBasicBlock &BB = F->createBlock(TextAddr);
+  // The selector reference is one page after the instructions.
+  BB.addInst(MCInstBuilder(ADRP).addReg(X8).addImm(1), 4);
+  BB.addInst(MCInstBuilder(LDRXui).addReg(X8).addReg(X8).addImm(0), 4);
+  // Loaded into another register than the base.
+  BB.addInst(MCInstBuilder(ADRP).addReg(X8).addImm(1), 4);
+  BB.addInst(MCInstBuilder(LDRXui).addReg(X9).addReg(X8).addImm(0), 4);
+  // Not a selector reference.
+  BB.addInst(MCInstBuilder(ADRP).addReg(X8).addImm(1), 4);
+  BB.addInst(MCInstBuilder(LDRXui).addReg(X8).addReg(X8).addImm(1), 4);
+
+  EXPECT_EQ(1U,
+            createSelectorPropagationPeephole(*MCO)->runOnFunction(*F));
+  MCBasicBlock::iterator I = BB.begin();
+  // adrp x8, sel@PAGE; add x8, x8, sel@PAGEOFF
+  EXPECT_EQ(ADRP, I->Inst.getOpcode());
+  EXPECT_EQ(0, I->Inst.getOperand(1).getImm());
+  ++I;
+  EXPECT_EQ(getOpcode("ADDXri"), I->Inst.getOpcode());
+  EXPECT_EQ(X8, I->Inst.getOperand(0).getReg());
+  EXPECT_EQ(X8, I->Inst.getOperand(1).getReg());
+  EXPECT_EQ(int64_t((MethNameAddr + 5) & 0xFFF),
+            I->Inst.getOperand(2).getImm());
+  ++I;
+
+  // The other pairs are left alone.
+  for (; I != BB.end(); I += 2) {
+    EXPECT_EQ(1, I->Inst.getOperand(1).getImm());
+    EXPECT_EQ(LDRXui, (I + 1)->Inst.getOpcode());
+  }
+}
+
+TEST_F(MCOptimizationTest, StackCanaryStripping) {
+  const unsigned Bcc = getOpcode("Bcc");
+  MCFunction *F = M.createFunction("f", TextAddr);
+  // b.ne fail; ret; fail: bl ___stack_chk_fail
+  MCBasicBlock &Entry = F->createBlock(TextAddr);
+  Entry.addInst(MCInstBuilder(Bcc).addImm(1).addImm(2), 4);
+  MCBasicBlock &Ret = F->createBlock(TextAddr + 4);
+  Ret.addInst(MCInstBuilder(getOpcode("RET")).addReg(getReg("LR")), 4);
+  MCBasicBlock &Fail = F->createBlock(TextAddr + 8);
+  addCall(Fail, StackChkFail);
+  addEdge(Entry, Ret);
+  addEdge(Entry, Fail);
+
+  EXPECT_EQ(2U, createStackCanaryStrippingPeephole(*MCO)->runOnFunction(*F));
+  EXPECT_TRUE(isNop(Entry.back()));
+  EXPECT_TRUE(isNop(Fail.back()));
+}
+
+TEST_F(MCOptimizationTest, StackCanaryStrippingTrap) {
+  const unsigned Bcc = getOpcode("Bcc");
+  MCFunction *F = M.createFunction("f", TextAddr);
+  // b.ne fail; nop; fail: bl ___stack_chk_fail; bl _printf
+  // fail is also reached from the nop: the call can't be erased, or the
+  // nop would run into the next instruction.
+  MCBasicBlock &Entry = F->createBlock(TextAddr);
+  Entry.addInst(MCInstBuilder(Bcc).addImm(1).addImm(2), 4);
+  MCBasicBlock &FallThrough = F->createBlock(TextAddr + 4);
+  addNop(FallThrough);
+  MCBasicBlock &Fail = F->createBlock(TextAddr + 8);
+  addCall(Fail, StackChkFail);
+  addCall(Fail, Printf);
+  addEdge(Entry, FallThrough);
+  addEdge(Entry, Fail);
+  addEdge(FallThrough, Fail);
+
+  EXPECT_EQ(2U, createStackCanaryStrippingPeephole(*MCO)->runOnFunction(*F));
+  EXPECT_TRUE(isNop(Entry.back()));
+  EXPECT_TRUE(isTrap(*Fail.begin()));
+  EXPECT_TRUE(isCall(Fail.back()));
+}
+
+TEST_F(MCOptimizationTest, NopRemoval) {
+  MCFunction *F = M.createFunction("f", TextAddr);
+  MCBasicBlock &BB = F->createBlock(TextAddr);
+  addNop(BB);
+  addCall(BB, Printf);
+  addNop(BB);
+  // hint #1 (yield) isn't a nop.
+  addNop(BB, 1);
+
+  EXPECT_EQ(2U, createNopRemovalPeephole(*MCO)->runOnFunction(*F));
+  ASSERT_EQ(2, BB.end() - BB.begin());
+  EXPECT_TRUE(isCall(*BB.begin()));
+  EXPECT_EQ(TextAddr + 4, BB.begin()->Address);
+  EXPECT_EQ(getOpcode("HINT"), BB.back().Inst.getOpcode());
+  EXPECT_EQ(TextAddr + 12, BB.back().Address);
+}
+
+} // end anonymous namespace
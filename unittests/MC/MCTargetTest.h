@@ -0,0 +1,80 @@
+//===- MCTargetTest.h - Fixture for the tests of target analyses ----------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// The fixture of the tests that build MC functions out of the instructions of
+// a target, and the helpers they share to build the CFG.
+//
+// The tests using it are only built with their target, see CMakeLists.txt: a
+// target that isn't registered fails the test.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_UNITTESTS_MC_MCTARGETTEST_H
+#define LLVM_UNITTESTS_MC_MCTARGETTEST_H
+
+#include "llvm/MC/MCAnalysis/MCFunction.h"
+#include "llvm/MC/MCInstrAnalysis.h"
+#include "llvm/MC/MCInstrInfo.h"
+#include "llvm/MC/MCRegisterInfo.h"
+#include "llvm/Support/TargetRegistry.h"
+#include "llvm/Support/TargetSelect.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <string>
+
+namespace llvm {
+
+// Add the edge from \p From to \p To to both of their lists.
+inline void addEdge(MCBasicBlock &From, MCBasicBlock &To) {
+  From.addSuccessor(&To);
+  To.addPredecessor(&From);
+}
+
+class MCTargetTest : public ::testing::Test {
+protected:
+  std::string TripleName;
+  const Target *TheTarget;
+  std::unique_ptr<MCInstrInfo> MII;
+  std::unique_ptr<MCRegisterInfo> MRI;
+  std::unique_ptr<MCInstrAnalysis> MIA;
+
+  explicit MCTargetTest(StringRef TripleName = "aarch64-apple-darwin")
+      : TripleName(TripleName), TheTarget(nullptr) {}
+
+  void SetUp() override {
+    InitializeAllTargetInfos();
+    InitializeAllTargetMCs();
+    std::string Error;
+    TheTarget = TargetRegistry::lookupTarget(TripleName, Error);
+    ASSERT_TRUE(TheTarget) << Error;
+    MII.reset(TheTarget->createMCInstrInfo());
+    MRI.reset(TheTarget->createMCRegInfo(TripleName));
+    MIA.reset(TheTarget->createMCInstrAnalysis(MII.get()));
+  }
+
+  // Find the opcode named \p Name, or 0.
+  unsigned getOpcode(StringRef Name) const {
+    for (unsigned Opc = 0, E = MII->getNumOpcodes(); Opc != E; ++Opc)
+      if (MII->getName(Opc) == Name)
+        return Opc;
+    return 0;
+  }
+
+  // Find the register named \p Name, or 0.
+  unsigned getReg(StringRef Name) const {
+    for (unsigned Reg = 1, E = MRI->getNumRegs(); Reg != E; ++Reg)
+      if (Name == MRI->getName(Reg))
+        return Reg;
+    return 0;
+  }
+};
+
+} // end namespace llvm
+
+#endif
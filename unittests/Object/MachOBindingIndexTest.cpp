@@ -0,0 +1,294 @@
+//===- llvm/unittest/Object/MachOBindingIndexTest.cpp ---------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Object/MachOBindingIndex.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace object;
+
+namespace {
+
+const uint64_t TextAddr = 0x100000000ULL;
+const uint64_t DataAddr = 0x100001000ULL;
+const uint64_t DataFileOff = 0x200;
+
+typedef MachOBindEntry::Kind Kind;
+
+void append32(std::string &S, uint32_t V) {
+  char Bytes[4];
+  support::endian::write32le(Bytes, V);
+  S.append(Bytes, 4);
+}
+
+void append64(std::string &S, uint64_t V) {
+  char Bytes[8];
+  support::endian::write64le(Bytes, V);
+  S.append(Bytes, 8);
+}
+
+void appendSegment(std::string &S, StringRef Name, uint64_t VMAddr,
+                   uint64_t FileOff, uint64_t FileSize) {
+  append32(S, MachO::LC_SEGMENT_64);
+  append32(S, sizeof(MachO::segment_command_64));
+  S.append(Name.data(), Name.size());
+  S.append(16 - Name.size(), '\0');
+  append64(S, VMAddr);
+  append64(S, 0x1000);
+  append64(S, FileOff);
+  append64(S, FileSize);
+  append32(S, 3);
+  append32(S, 3);
+  append32(S, 0);
+  append32(S, 0);
+}
+
+/// \brief A 64-bit Mach-O executable with a __TEXT segment mapping the
+/// headers, at TextAddr, and a __DATA segment at DataAddr, with the contents
+/// \p Data. The dyld info opcodes, or the chained fixups if not empty, follow
+/// the contents.
+struct MachOImage {
+  std::string Bytes;
+  std::unique_ptr<MachOObjectFile> Obj;
+
+  MachOImage(StringRef Data, StringRef Rebase, StringRef Bind,
+             StringRef WeakBind, StringRef LazyBind,
+             StringRef ChainedFixups = StringRef()) {
+    const bool Chained = !ChainedFixups.empty();
+    std::string Cmds;
+    appendSegment(Cmds, "__TEXT", TextAddr, 0, DataFileOff);
+    appendSegment(Cmds, "__DATA", DataAddr, DataFileOff, Data.size());
+    uint32_t Off = DataFileOff + Data.size();
+    if (Chained) {
+      append32(Cmds, MachO::LC_DYLD_CHAINED_FIXUPS);
+      append32(Cmds, sizeof(MachO::linkedit_data_command));
+      append32(Cmds, Off);
+      append32(Cmds, ChainedFixups.size());
+    } else {
+      append32(Cmds, MachO::LC_DYLD_INFO_ONLY);
+      append32(Cmds, sizeof(MachO::dyld_info_command));
+      for (StringRef Opcodes : {Rebase, Bind, WeakBind, LazyBind}) {
+        append32(Cmds, Opcodes.empty() ? 0 : Off);
+        append32(Cmds, Opcodes.size());
+        Off += Opcodes.size();
+      }
+      append32(Cmds, 0);
+      append32(Cmds, 0);
+    }
+
+    append32(Bytes, MachO::MH_MAGIC_64);
+    append32(Bytes, MachO::CPU_TYPE_ARM64);
+    append32(Bytes, 0);
+    append32(Bytes, MachO::MH_EXECUTE);
+    append32(Bytes, 3);
+    append32(Bytes, Cmds.size());
+    append32(Bytes, 0);
+    append32(Bytes, 0);
+    Bytes += Cmds;
+    Bytes.resize(DataFileOff, '\0');
+    Bytes += Data;
+    if (Chained)
+      Bytes += ChainedFixups;
+    else
+      Bytes += (Rebase + Bind + WeakBind + LazyBind).str();
+
+    ErrorOr<std::unique_ptr<ObjectFile>> ObjOrErr =
+        ObjectFile::createMachOObjectFile(MemoryBufferRef(Bytes, "image"));
+    EXPECT_FALSE(ObjOrErr.getError());
+    if (ObjOrErr)
+      Obj.reset(cast<MachOObjectFile>(ObjOrErr->release()));
+  }
+};
+
+// Binding opcodes, see <mach-o/loader.h>.
+const char Bind[] =
+    // _foo, from the first dylib, at __DATA+8, then _bar at the same address.
+    "\x11\x40_foo\0\x51\x71\x08\x90"
+    "\x40_bar\0\x71\x08\x90"
+    // _baz+4, at __DATA+0x10.
+    "\x60\x04\x40_baz\0\x71\x10\x90"
+    "\x00";
+const char WeakBind[] =
+    // _weak, at __DATA+8 too: a weak binding is looked up by its own kind.
+    "\x40_weak\0\x51\x71\x08\x90\x00";
+const char LazyBind[] =
+    // _lazy, from the second dylib, at __DATA+0x18.
+    "\x71\x18\x12\x40_lazy\0\x90\x00";
+// A rebase of the pointer at __DATA: it has no binding.
+const char Rebase[] = "\x11\x21\x00\x51\x00";
+
+StringRef opcodes(const char *Opcodes, size_t Size) {
+  // The literals end with an implicit null, which is a DONE opcode already.
+  return StringRef(Opcodes, Size - 1);
+}
+
+#define OPCODES(X) opcodes(X, sizeof(X))
+
+TEST(MachOBindingIndexTest, Opcodes) {
+  MachOImage Image(std::string(0x20, '\0'), OPCODES(Rebase), OPCODES(Bind),
+                   OPCODES(WeakBind), OPCODES(LazyBind));
+  ASSERT_TRUE(Image.Obj != nullptr);
+  MachOBindingIndex Index(*Image.Obj);
+  EXPECT_EQ(5u, Index.size());
+  EXPECT_FALSE(Index.hasChainedFixups());
+
+  // Both regular bindings of __DATA+8 are kept, the first one is found.
+  const MachOBindingIndex::Binding *B = Index.find(DataAddr + 8, Kind::Regular);
+  ASSERT_TRUE(B != nullptr);
+  EXPECT_EQ("_foo", B->SymbolName);
+  EXPECT_EQ(1, B->Ordinal);
+  EXPECT_EQ(0, B->Addend);
+  EXPECT_EQ("_weak", Index.getSymbolName(DataAddr + 8, Kind::Weak));
+  EXPECT_EQ("", Index.getSymbolName(DataAddr + 8, Kind::Lazy));
+
+  B = Index.find(DataAddr + 0x10, Kind::Regular);
+  ASSERT_TRUE(B != nullptr);
+  EXPECT_EQ("_baz", B->SymbolName);
+  EXPECT_EQ(4, B->Addend);
+
+  // The lazy bindings are only found as such.
+  B = Index.find(DataAddr + 0x18, Kind::Lazy);
+  ASSERT_TRUE(B != nullptr);
+  EXPECT_EQ("_lazy", B->SymbolName);
+  EXPECT_EQ(2, B->Ordinal);
+  EXPECT_EQ(nullptr, Index.find(DataAddr + 0x18, Kind::Regular));
+  EXPECT_EQ(nullptr, Index.find(DataAddr + 0x18, Kind::Weak));
+
+  // The rebased pointer has no binding, and no chained value without chained
+  // fixups.
+  uint64_t Value;
+  EXPECT_EQ(nullptr, Index.find(DataAddr, Kind::Regular));
+  EXPECT_FALSE(Index.getChainedValue(DataAddr, Value));
+}
+
+TEST(MachOBindingIndexTest, Misses) {
+  MachOImage Image(std::string(0x20, '\0'), OPCODES(Rebase), OPCODES(Bind),
+                   OPCODES(WeakBind), OPCODES(LazyBind));
+  ASSERT_TRUE(Image.Obj != nullptr);
+  MachOBindingIndex Index(*Image.Obj);
+  // Inside a bound pointer, between, before and past all the bindings.
+  for (uint64_t Addr : {DataAddr + 9, DataAddr + 0xC, TextAddr, DataAddr - 8,
+                        DataAddr + 0x20, uint64_t(0), ~uint64_t(0)}) {
+    EXPECT_EQ(nullptr, Index.find(Addr, Kind::Regular));
+    EXPECT_EQ(nullptr, Index.find(Addr, Kind::Lazy));
+    EXPECT_EQ(nullptr, Index.find(Addr, Kind::Weak));
+  }
+}
+
+TEST(MachOBindingIndexTest, Empty) {
+  MachOImage Image(std::string(0x10, '\0'), "", "", "", "");
+  ASSERT_TRUE(Image.Obj != nullptr);
+  MachOBindingIndex Index(*Image.Obj);
+  EXPECT_TRUE(Index.empty());
+  EXPECT_EQ(nullptr, Index.find(DataAddr, Kind::Regular));
+}
+
+TEST(MachOBindingIndexTest, ChainedFixups) {
+  // DYLD_CHAINED_PTR_64: a rebase to TextAddr + 0xF00, with a high byte,
+  // followed 8 bytes (2 strides) later by a bind of the first import + 3.
+  std::string Data;
+  append64(Data, (TextAddr + 0xF00) | (0x5AULL << 36) | (2ULL << 51));
+  append64(Data, (1ULL << 63) | (3ULL << 24));
+  append64(Data, 0x1234);
+
+  std::string Fixups;
+  const uint32_t StartsOff = 28, SegInfoOff = 12;
+  const uint32_t ImportsOff = StartsOff + SegInfoOff + 24;
+  const uint32_t SymbolsOff = ImportsOff + 4;
+  append32(Fixups, 0);
+  append32(Fixups, StartsOff);
+  append32(Fixups, ImportsOff);
+  append32(Fixups, SymbolsOff);
+  append32(Fixups, 1);
+  append32(Fixups, MachO::DYLD_CHAINED_IMPORT);
+  append32(Fixups, 0);
+  // The starts of __TEXT (none) and __DATA.
+  append32(Fixups, 2);
+  append32(Fixups, 0);
+  append32(Fixups, SegInfoOff);
+  // Size, page size and pointer format, segment offset, max valid pointer,
+  // page count and the start of the chain in each page.
+  append32(Fixups, 24);
+  Fixups += StringRef("\x00\x10", 2);
+  Fixups += StringRef("\x02\x00", 2);
+  append64(Fixups, DataAddr - TextAddr);
+  append32(Fixups, 0);
+  Fixups += StringRef("\x01\x00\x00\x00", 4);
+  // The import: the first dylib, and the name at offset 1.
+  append32(Fixups, 1 | (1 << 9));
+  Fixups += StringRef("\0_chained\0", 10);
+
+  MachOImage Image(Data, "", "", "", "", Fixups);
+  ASSERT_TRUE(Image.Obj != nullptr);
+  MachOBindingIndex Index(*Image.Obj);
+  EXPECT_TRUE(Index.hasChainedFixups());
+  EXPECT_EQ(1u, Index.size());
+
+  const MachOBindingIndex::Binding *B = Index.find(DataAddr + 8, Kind::Regular);
+  ASSERT_TRUE(B != nullptr);
+  EXPECT_EQ("_chained", B->SymbolName);
+  EXPECT_EQ(1, B->Ordinal);
+  EXPECT_EQ(3, B->Addend);
+
+  // The rebase has no binding, but its target as value; the bind is 0, and
+  // the pointer past the chain has none.
+  uint64_t Value;
+  EXPECT_EQ(nullptr, Index.find(DataAddr, Kind::Regular));
+  ASSERT_TRUE(Index.getChainedValue(DataAddr, Value));
+  EXPECT_EQ((TextAddr + 0xF00) | (0x5AULL << 56), Value);
+  ASSERT_TRUE(Index.getChainedValue(DataAddr + 8, Value));
+  EXPECT_EQ(0u, Value);
+  EXPECT_FALSE(Index.getChainedValue(DataAddr + 0x10, Value));
+
+  std::string Applied = Data;
+  Index.applyChainedFixups(
+      DataAddr, MutableArrayRef<uint8_t>(
+                    reinterpret_cast<uint8_t *>(&Applied[0]), Applied.size()));
+  EXPECT_EQ((TextAddr + 0xF00) | (0x5AULL << 56),
+            support::endian::read64le(Applied.data()));
+  EXPECT_EQ(0u, support::endian::read64le(Applied.data() + 8));
+  EXPECT_EQ(0x1234u, support::endian::read64le(Applied.data() + 0x10));
+}
+
+TEST(MachOBindingIndexTest, ThreadedBinds) {
+  // arm64e pointers, chained in strides of 8 bytes from __DATA: a rebase to
+  // TextAddr + 0xF00 with a high byte, a bind of the first ordinal + 2, and
+  // an authenticated rebase, to the offset 0xE00 from the image base.
+  std::string Data;
+  append64(Data, (TextAddr + 0xF00) | (0xABULL << 43) | (1ULL << 51));
+  append64(Data, (1ULL << 62) | (2ULL << 32) | (1ULL << 51));
+  append64(Data, (1ULL << 63) | 0xE00);
+
+  // The ordinal table holds _threaded, then the chain is applied.
+  const char Opcodes[] = "\xD0\x01\x11\x40_threaded\0\x90\x71\x00\xD1\x00";
+
+  MachOImage Image(Data, "", OPCODES(Opcodes), "", "");
+  ASSERT_TRUE(Image.Obj != nullptr);
+  MachOBindingIndex Index(*Image.Obj);
+  EXPECT_TRUE(Index.hasChainedFixups());
+  EXPECT_EQ(1u, Index.size());
+
+  const MachOBindingIndex::Binding *B = Index.find(DataAddr + 8, Kind::Regular);
+  ASSERT_TRUE(B != nullptr);
+  EXPECT_EQ("_threaded", B->SymbolName);
+  EXPECT_EQ(1, B->Ordinal);
+  EXPECT_EQ(2, B->Addend);
+
+  uint64_t Value;
+  ASSERT_TRUE(Index.getChainedValue(DataAddr, Value));
+  EXPECT_EQ((TextAddr + 0xF00) | (0xABULL << 56), Value);
+  ASSERT_TRUE(Index.getChainedValue(DataAddr + 8, Value));
+  EXPECT_EQ(0u, Value);
+  ASSERT_TRUE(Index.getChainedValue(DataAddr + 0x10, Value));
+  EXPECT_EQ(TextAddr + 0xE00, Value);
+}
+
+} // end anonymous namespace
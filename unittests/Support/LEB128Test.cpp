@@ -12,6 +12,7 @@
 #include "llvm/Support/LEB128.h"
 #include "llvm/Support/raw_ostream.h"
 #include <string>
+#include <vector>
 using namespace llvm;
 
 namespace {
@@ -119,6 +120,50 @@ TEST(LEB128Test, DecodeULEB128) {
 #undef EXPECT_DECODE_ULEB128_EQ
 }
 
+TEST(LEB128Test, DecodeULEB128Run) {
+  // Values of all sizes, so that the word at a time decoding sees them at
+  // all offsets, and the values longer than a word.
+  std::vector<uint64_t> Values;
+  for (unsigned Bits = 0; Bits != 64; ++Bits) {
+    Values.push_back(1ULL << Bits);
+    Values.push_back((1ULL << Bits) - 1);
+  }
+  Values.push_back(UINT64_MAX);
+  std::string Buffer;
+  raw_string_ostream OS(Buffer);
+  for (uint64_t Value : Values)
+    encodeULEB128(Value, OS);
+  // With padding, the last value is decoded a word at a time too.
+  encodeULEB128(42, OS, 4);
+  OS.flush();
+  Values.push_back(42);
+
+  const uint8_t *Begin = reinterpret_cast<const uint8_t *>(Buffer.data());
+  const uint8_t *End = Begin + Buffer.size();
+  std::vector<uint64_t> Decoded;
+  const uint8_t *P = decodeULEB128Run(Begin, End, [&](uint64_t Value) {
+    Decoded.push_back(Value);
+    return true;
+  });
+  EXPECT_EQ(End, P);
+  EXPECT_EQ(Values, Decoded);
+
+  // The decoding stops when asked to.
+  Decoded.clear();
+  P = decodeULEB128Run(Begin, End, [&](uint64_t Value) {
+    Decoded.push_back(Value);
+    return Decoded.size() != 3;
+  });
+  EXPECT_EQ(3U, Decoded.size());
+  EXPECT_EQ(Begin + 3, P);
+
+  // A value that doesn't end before the end isn't decoded.
+  unsigned Size;
+  const uint8_t Truncated[] = {0x80, 0x81};
+  decodeULEB128(Truncated, Truncated + 2, &Size);
+  EXPECT_EQ(0U, Size);
+}
+
 TEST(LEB128Test, DecodeSLEB128) {
 #define EXPECT_DECODE_SLEB128_EQ(EXPECTED, VALUE) \
   do { \
@@ -0,0 +1,73 @@
+//===- llvm/unittest/Support/ThreadPoolTest.cpp - ThreadPool tests --------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/ThreadPool.h"
+#include "gtest/gtest.h"
+#include <cstdlib>
+
+using namespace llvm;
+
+namespace {
+
+TEST(ThreadPoolTest, AsyncAndWait) {
+  for (unsigned NumThreads : {0U, 1U, 4U}) {
+    ThreadPool Pool(NumThreads);
+    std::atomic<unsigned> Count(0);
+    for (unsigned I = 0; I != 100; ++I)
+      Pool.async([&] {
+        // Tasks queued from a task go to the worker's queue.
+        Pool.async([&] { ++Count; });
+        ++Count;
+      });
+    Pool.wait();
+    EXPECT_EQ(200U, Count);
+  }
+}
+
+TEST(ThreadPoolTest, ParallelFor) {
+  ThreadPool Pool(4);
+  std::vector<unsigned> Squares(1000);
+  parallel_for(Pool, 0, Squares.size(),
+               [&](size_t I) { Squares[I] = I * I; });
+  for (unsigned I = 0; I != Squares.size(); ++I)
+    EXPECT_EQ(I * I, Squares[I]);
+
+  // Nested loops wait for their own indices only, helping with the others.
+  std::vector<std::atomic<unsigned>> Counts(16);
+  parallel_for(Pool, 0, Counts.size(), [&](size_t I) {
+    parallel_for(Pool, 0, 100, [&](size_t) { ++Counts[I]; });
+  });
+  for (const auto &Count : Counts)
+    EXPECT_EQ(100U, Count);
+
+  // Each thread counts the elements it saw: they sum up to all of them.
+  PerThread<unsigned> Seen(Pool);
+  parallel_for_each(Pool, Squares.begin(), Squares.end(),
+                    [&](unsigned) { ++Seen.local(); });
+  unsigned Total = 0;
+  for (unsigned N : Seen)
+    Total += N;
+  EXPECT_EQ(Squares.size(), Total);
+}
+
+TEST(ThreadPoolTest, ParallelSort) {
+  for (unsigned NumThreads : {0U, 3U, 4U}) {
+    ThreadPool Pool(NumThreads);
+    std::vector<int> Values;
+    std::srand(42);
+    for (unsigned I = 0; I != 20000; ++I)
+      Values.push_back(std::rand() % 1000);
+    std::vector<int> Expected = Values;
+    std::sort(Expected.begin(), Expected.end());
+    parallel_sort(Pool, Values.begin(), Values.end());
+    EXPECT_EQ(Expected, Values);
+  }
+}
+
+} // end anonymous namespace
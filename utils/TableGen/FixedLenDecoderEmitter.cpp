@@ -19,6 +19,7 @@
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/MC/MCFixedLenDisassembler.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/DataTypes.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/FormattedStream.h"
@@ -27,6 +28,7 @@
 #include "llvm/TableGen/Error.h"
 #include "llvm/TableGen/Record.h"
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -34,6 +36,13 @@ using namespace llvm;
 
 #define DEBUG_TYPE "decoder-emitter"
 
+static cl::opt<bool>
+DirectDispatchDecoder("direct-dispatch-decoder",
+                      cl::desc("Make -gen-disassembler emit the decoder "
+                               "tables as functions, decodeDirect<Namespace>"
+                               "<BitWidth>, rather than for decodeInstruction "
+                               "to interpret"));
+
 namespace {
 struct EncodingField {
   unsigned Base, Width, Offset;
@@ -99,6 +108,9 @@ public:
   void emitTable(formatted_raw_ostream &o, DecoderTable &Table,
                  unsigned Indentation, unsigned BitWidth,
                  StringRef Namespace) const;
+  // Emit the decoder state machine table as a function.
+  void emitDirectDecoder(formatted_raw_ostream &o, const DecoderTable &Table,
+                         unsigned BitWidth, StringRef Namespace) const;
   void emitPredicateFunction(formatted_raw_ostream &OS,
                              PredicateSet &Predicates,
                              unsigned Indentation) const;
@@ -865,6 +877,203 @@ void FixedLenDecoderEmitter::emitTable(formatted_raw_ostream &OS,
   OS.indent(Indentation) << "};\n\n";
 }
 
+namespace {
+// An entry of a decoder table, decoded.
+struct DecoderTableEntry {
+  uint8_t Kind;
+  unsigned Start, Len;
+  uint64_t Value, NegValue;
+  unsigned Opc, DecodeIdx;
+  // The index of the entry to continue at if the check fails.
+  uint64_t SkipTo;
+};
+} // End anonymous namespace
+
+static uint64_t readULEB128(DecoderTable::const_iterator &I) {
+  unsigned Len;
+  uint64_t Value = decodeULEB128(&*I, &Len);
+  I += Len;
+  return Value;
+}
+
+static uint64_t readNumToSkip(DecoderTable::const_iterator &I,
+                              const DecoderTable &Table) {
+  uint32_t NumToSkip = *I++;
+  NumToSkip |= (*I++) << 8;
+  return (I - Table.begin()) + NumToSkip;
+}
+
+// Emit the decoder state machine table as a function of the same arguments as
+// decodeInstruction, but the table. Each entry becomes the code that
+// decodeInstruction runs for it, labelled if another one continues there, so
+// that the function takes the same paths through the entries. The filters of
+// a field are also a switch on its value, to go to the matching one directly
+// rather than through the chain of failed ones.
+void FixedLenDecoderEmitter::emitDirectDecoder(formatted_raw_ostream &OS,
+                                               const DecoderTable &Table,
+                                               unsigned BitWidth,
+                                               StringRef Namespace) const {
+  std::map<uint64_t, DecoderTableEntry> Entries;
+  std::set<uint64_t> Labels;
+  for (DecoderTable::const_iterator I = Table.begin(), E = Table.end();
+       I != E;) {
+    uint64_t Pos = I - Table.begin();
+    DecoderTableEntry &Entry = Entries[Pos];
+    Entry = DecoderTableEntry();
+    Entry.Kind = *I++;
+    switch (Entry.Kind) {
+    default:
+      PrintFatalError("invalid decode table opcode");
+    case MCD::OPC_ExtractField:
+      Entry.Start = *I++;
+      Entry.Len = *I++;
+      break;
+    case MCD::OPC_FilterValue:
+      Entry.Value = readULEB128(I);
+      Entry.SkipTo = readNumToSkip(I, Table);
+      break;
+    case MCD::OPC_CheckField:
+      Entry.Start = *I++;
+      Entry.Len = *I++;
+      Entry.Value = readULEB128(I);
+      Entry.SkipTo = readNumToSkip(I, Table);
+      break;
+    case MCD::OPC_CheckPredicate:
+      Entry.Value = readULEB128(I);
+      Entry.SkipTo = readNumToSkip(I, Table);
+      break;
+    case MCD::OPC_Decode:
+    case MCD::OPC_TryDecode:
+      Entry.Opc = readULEB128(I);
+      Entry.DecodeIdx = readULEB128(I);
+      if (Entry.Kind == MCD::OPC_TryDecode)
+        Entry.SkipTo = readNumToSkip(I, Table);
+      break;
+    case MCD::OPC_SoftFail:
+      Entry.Value = readULEB128(I);
+      Entry.NegValue = readULEB128(I);
+      break;
+    case MCD::OPC_Fail:
+      break;
+    }
+    if (Entry.Kind != MCD::OPC_ExtractField &&
+        Entry.Kind != MCD::OPC_Decode && Entry.Kind != MCD::OPC_SoftFail &&
+        Entry.Kind != MCD::OPC_Fail)
+      Labels.insert(Entry.SkipTo);
+  }
+
+  // The filters following an extraction, in the order decodeInstruction
+  // tries them, each with the entry after it, and the entry after the last
+  // failure.
+  auto getFilterChain = [&](uint64_t Pos,
+                            std::vector<std::pair<uint64_t, uint64_t>> &Chain) {
+    std::set<uint64_t> Values;
+    auto I = Entries.find(Pos);
+    while (I != Entries.end() && I->second.Kind == MCD::OPC_FilterValue) {
+      auto Next = std::next(I);
+      assert(Next != Entries.end() && "filter at the end of the table!");
+      // The first filter of a value is the one that matches.
+      if (Values.insert(I->second.Value).second)
+        Chain.push_back(std::make_pair(I->second.Value, Next->first));
+      Pos = I->second.SkipTo;
+      I = Entries.find(Pos);
+    }
+    return Pos;
+  };
+  for (const auto &E : Entries) {
+    if (E.second.Kind != MCD::OPC_ExtractField)
+      continue;
+    std::vector<std::pair<uint64_t, uint64_t>> Chain;
+    Labels.insert(getFilterChain(std::next(Entries.find(E.first))->first,
+                                 Chain));
+    for (const auto &C : Chain)
+      Labels.insert(C.second);
+  }
+
+  OS << "template<typename InsnType>\n"
+     << "static DecodeStatus decodeDirect" << Namespace << BitWidth
+     << "(MCInst &MI, InsnType insn,\n"
+     << "    uint64_t Address, const void *DisAsm, const MCSubtargetInfo &STI) {\n"
+     << "  const FeatureBitset& Bits = STI.getFeatureBits();\n"
+     << "  (void)Bits;\n"
+     << "  uint32_t CurFieldValue = 0;\n"
+     << "  DecodeStatus S = MCDisassembler::Success;\n"
+     << "  bool DecodeComplete;\n";
+  for (const auto &E : Entries) {
+    const DecoderTableEntry &Entry = E.second;
+    if (Labels.count(E.first))
+      OS << "L" << E.first << ":\n";
+    switch (Entry.Kind) {
+    case MCD::OPC_ExtractField: {
+      OS << "  CurFieldValue = fieldFromInstruction(insn, " << Entry.Start
+         << ", " << Entry.Len << ");\n";
+      std::vector<std::pair<uint64_t, uint64_t>> Chain;
+      uint64_t Default =
+          getFilterChain(std::next(Entries.find(E.first))->first, Chain);
+      if (Chain.empty())
+        break;
+      OS << "  switch (CurFieldValue) {\n";
+      for (const auto &C : Chain)
+        OS << "  case " << C.first << ": goto L" << C.second << ";\n";
+      OS << "  default: goto L" << Default << ";\n"
+         << "  }\n";
+      break;
+    }
+    case MCD::OPC_FilterValue:
+      OS << "  if (CurFieldValue != " << Entry.Value << "U) goto L"
+         << Entry.SkipTo << ";\n";
+      break;
+    case MCD::OPC_CheckField:
+      OS << "  if (fieldFromInstruction(insn, " << Entry.Start << ", "
+         << Entry.Len << ") != " << Entry.Value << "U) goto L" << Entry.SkipTo
+         << ";\n";
+      break;
+    case MCD::OPC_CheckPredicate:
+      OS << "  if (!checkDecoderPredicate(" << Entry.Value
+         << ", Bits)) goto L" << Entry.SkipTo << ";\n";
+      break;
+    case MCD::OPC_Decode:
+      OS << "  // Opcode: "
+         << NumberedInstructions->at(Entry.Opc)->TheDef->getName() << "\n"
+         << "  MI.clear();\n"
+         << "  MI.setOpcode(" << Entry.Opc << ");\n"
+         << "  S = decodeToMCInst(S, " << Entry.DecodeIdx
+         << ", insn, MI, Address, DisAsm, DecodeComplete);\n"
+         << "  assert(DecodeComplete);\n"
+         << "  return S;\n";
+      break;
+    case MCD::OPC_TryDecode:
+      OS << "  // Opcode: "
+         << NumberedInstructions->at(Entry.Opc)->TheDef->getName() << "\n"
+         << "  {\n"
+         << "    MCInst TmpMI;\n"
+         << "    TmpMI.setOpcode(" << Entry.Opc << ");\n"
+         << "    S = decodeToMCInst(S, " << Entry.DecodeIdx
+         << ", insn, TmpMI, Address, DisAsm, DecodeComplete);\n"
+         << "    if (DecodeComplete) {\n"
+         << "      MI = TmpMI;\n"
+         << "      return S;\n"
+         << "    }\n"
+         << "    assert(S == MCDisassembler::Fail);\n"
+         << "    S = MCDisassembler::Success;\n"
+         << "  }\n"
+         << "  goto L" << Entry.SkipTo << ";\n";
+      break;
+    case MCD::OPC_SoftFail:
+      OS << "  if ((insn & InsnType(0x" << utohexstr(Entry.Value)
+         << "ULL)) || (~insn & InsnType(0x" << utohexstr(Entry.NegValue)
+         << "ULL)))\n"
+         << "    S = MCDisassembler::SoftFail;\n";
+      break;
+    case MCD::OPC_Fail:
+      OS << "  return MCDisassembler::Fail;\n";
+      break;
+    }
+  }
+  // The last entry is an OPC_Fail.
+  OS << "}\n\n";
+}
+
 void FixedLenDecoderEmitter::
 emitPredicateFunction(formatted_raw_ostream &OS, PredicateSet &Predicates,
                       unsigned Indentation) const {
@@ -2275,6 +2484,10 @@ void FixedLenDecoderEmitter::run(raw_ostream &o) {
   }
 
   DecoderTableInfo TableInfo;
+  // With -direct-dispatch-decoder, the tables to emit as functions, once the
+  // predicate and decoder functions they call are.
+  std::vector<std::pair<std::pair<std::string, unsigned>, DecoderTable>>
+      DirectTables;
   for (const auto &Opc : OpcMap) {
     // Emit the decoder for this namespace+width combination.
     FilterChooser FC(*NumberedInstructions, Opc.second, Operands,
@@ -2299,7 +2512,12 @@ void FixedLenDecoderEmitter::run(raw_ostream &o) {
     TableInfo.Table.push_back(MCD::OPC_Fail);
 
     // Print the table to the output stream.
-    emitTable(OS, TableInfo.Table, 0, FC.getBitWidth(), Opc.first.first);
+    if (!DirectDispatchDecoder)
+      emitTable(OS, TableInfo.Table, 0, FC.getBitWidth(), Opc.first.first);
+    else
+      DirectTables.push_back(std::make_pair(
+          std::make_pair(Opc.first.first, FC.getBitWidth()),
+          TableInfo.Table));
     OS.flush();
   }
 
@@ -2312,6 +2530,10 @@ void FixedLenDecoderEmitter::run(raw_ostream &o) {
   // Emit the main entry point for the decoder, decodeInstruction().
   emitDecodeInstruction(OS);
 
+  // Emit the tables as functions, which use the two above.
+  for (const auto &T : DirectTables)
+    emitDirectDecoder(OS, T.second, T.first.second, T.first.first);
+
   OS << "\n} // End llvm namespace\n";
 }
 
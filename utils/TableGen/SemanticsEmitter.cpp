@@ -16,11 +16,14 @@
 #include "CodeGenTarget.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/MD5.h"
 #include "llvm/Support/PrettyStackTrace.h"
 #include "llvm/Support/Signals.h"
+#include "llvm/TableGen/Error.h"
 #include "llvm/TableGen/Record.h"
 #include "llvm/TableGen/TableGenBackend.h"
 #include <algorithm>
+#include <map>
 
 using namespace llvm;
 
@@ -498,36 +501,125 @@ void SemanticsEmitter::run(raw_ostream &OS) {
   OS << "namespace " << TGName << " {\n";
   OS << "namespace {\n\n";
 
-  OS << "const unsigned InstSemantics[] = {\n";
-  OS << "  DCINS::END_OF_INSTRUCTION,\n";
-  CurSemaOffset = 1;
+  // The semantics are 16-bit values. The constant indices and operand
+  // numbers are checked here; the opcodes, types and registers are enum
+  // values, checked when the table is compiled.
+  if (SemaTarget.ConstantIdx.size() >= (1U << 16))
+    PrintFatalError("Too many semantics constants for a 16-bit index");
+  // Flatten the semantics of each instruction into the values of the table,
+  // remembering where each node starts, to print one per line.
+  struct InstTokens {
+    unsigned Inst;
+    std::vector<std::string> Tokens;
+    std::vector<unsigned> NodeStarts;
+  };
+  std::vector<InstTokens> Seqs;
   for (unsigned I = 0, E = InstIdx.size(); I != E; ++I) {
     if (InstIdx[I] == 0)
       continue;
-    InstSemantics &Sema = InstSemas[InstIdx[I]];
-    InstIdx[I] = CurSemaOffset++;
-    OS << "  // " << CGIByEnum[I]->TheDef->getName() << "\n";
-    for (std::vector<NodeSemantics>::const_iterator SI = Sema.Semantics.begin(),
-                                                    SE = Sema.Semantics.end();
-         SI != SE; ++SI) {
-      ++CurSemaOffset;
-      OS.indent(2) << SI->Opcode;
-      for (unsigned ti = 0, te = SI->Types.size(); ti != te; ++ti)
-        OS << ", " << llvm::getEnumName(SI->Types[ti]);
-      CurSemaOffset += SI->Types.size();
-      for (unsigned oi = 0, oe = SI->Operands.size(); oi != oe; ++oi)
-        OS << ", " << SI->Operands[oi];
-      CurSemaOffset += SI->Operands.size();
-      OS << ",\n";
+    Seqs.push_back(InstTokens());
+    InstTokens &Seq = Seqs.back();
+    Seq.Inst = I;
+    for (const NodeSemantics &NS : InstSemas[InstIdx[I]].Semantics) {
+      Seq.NodeStarts.push_back(Seq.Tokens.size());
+      Seq.Tokens.push_back(NS.Opcode);
+      for (MVT::SimpleValueType VT : NS.Types)
+        Seq.Tokens.push_back(llvm::getEnumName(VT));
+      for (const std::string &Op : NS.Operands) {
+        uint64_t V;
+        if (!StringRef(Op).getAsInteger(0, V) && V >= (1U << 16))
+          PrintFatalError(Twine("Semantics value ") + Op + " of " +
+                          CGIByEnum[I]->TheDef->getName() +
+                          " doesn't fit in 16 bits");
+        Seq.Tokens.push_back(Op);
+      }
     }
-    OS << "  DCINS::END_OF_INSTRUCTION,\n";
+    Seq.NodeStarts.push_back(Seq.Tokens.size());
+    Seq.Tokens.push_back("DCINS::END_OF_INSTRUCTION");
+  }
+
+  // The semantics are read from their start to their END_OF_INSTRUCTION, so
+  // the instructions whose semantics end those of another, e.g. the many
+  // that are identical, can share them. Sorted by their reversed values, a
+  // sequence ends another only if it ends the next one.
+  std::vector<unsigned> Order(Seqs.size());
+  for (unsigned I = 0, E = Seqs.size(); I != E; ++I)
+    Order[I] = I;
+  std::sort(Order.begin(), Order.end(), [&](unsigned A, unsigned B) {
+    return std::lexicographical_compare(
+        Seqs[A].Tokens.rbegin(), Seqs[A].Tokens.rend(),
+        Seqs[B].Tokens.rbegin(), Seqs[B].Tokens.rend());
+  });
+  std::vector<unsigned> Owner(Seqs.size());
+  for (unsigned I = Order.size(); I-- != 0;) {
+    const std::vector<std::string> &Tail = Seqs[Order[I]].Tokens;
+    Owner[Order[I]] = Order[I];
+    if (I + 1 == Order.size())
+      continue;
+    const std::vector<std::string> &Next = Seqs[Order[I + 1]].Tokens;
+    if (Tail.size() <= Next.size() &&
+        std::equal(Tail.rbegin(), Tail.rend(), Next.rbegin()))
+      Owner[Order[I]] = Owner[Order[I + 1]];
+  }
+
+  // Where, in the sequence of each owner, the others start.
+  std::map<unsigned, std::multimap<unsigned, unsigned>> Sharers;
+  for (unsigned I = 0, E = Seqs.size(); I != E; ++I) {
+    unsigned O = Owner[I];
+    Sharers[O].insert(std::make_pair(
+        Seqs[O].Tokens.size() - Seqs[I].Tokens.size(), Seqs[I].Inst));
   }
-  OS << "};\n\n";
 
-  OS << "const unsigned OpcodeToSemaIdx[] = {\n";
+  // The tables are hashed, for the translation cache to tell the entries
+  // translated with other semantics apart.
+  std::string TablesStr;
+  raw_string_ostream Tables(TablesStr);
+  Tables << "const uint16_t InstSemantics[] = {\n";
+  Tables << "  DCINS::END_OF_INSTRUCTION,\n";
+  CurSemaOffset = 1;
+  for (unsigned S = 0, SE = Seqs.size(); S != SE; ++S) {
+    if (Owner[S] != S)
+      continue;
+    const InstTokens &Seq = Seqs[S];
+    std::multimap<unsigned, unsigned> &Starts = Sharers[S];
+    auto SI = Starts.begin();
+    for (unsigned N = 0, NE = Seq.NodeStarts.size(); N != NE; ++N) {
+      unsigned Begin = Seq.NodeStarts[N];
+      unsigned End = N + 1 == NE ? Seq.Tokens.size() : Seq.NodeStarts[N + 1];
+      for (; SI != Starts.end() && SI->first < End; ++SI) {
+        InstIdx[SI->second] = CurSemaOffset + SI->first;
+        Tables << "  // " << CGIByEnum[SI->second]->TheDef->getName() << "\n";
+      }
+      Tables.indent(2) << Seq.Tokens[Begin];
+      for (unsigned T = Begin + 1; T != End; ++T)
+        Tables << ", " << Seq.Tokens[T];
+      Tables << ",\n";
+    }
+    CurSemaOffset += Seq.Tokens.size();
+  }
+  Tables << "};\n\n";
+  // The brace initialization already rejects the enum values that don't fit:
+  // spell out the bounds, to fail with a message.
+  Tables << "static_assert(" << TGName
+         << "::INSTRUCTION_LIST_END <= 0x10000 &&\n"
+         << "              " << TGName << "::NUM_TARGET_REGS <= 0x10000 &&\n"
+         << "              MVT::LAST_VALUETYPE <= 0x10000 &&\n"
+         << "              ISD::BUILTIN_OP_END <= DCINS::DC_OPCODE_START,\n"
+         << "              \"The " << TGName
+         << " semantics don't fit in 16 bits\");\n\n";
+
+  Tables << "const unsigned OpcodeToSemaIdx[] = {\n";
   for (unsigned I = 0, E = InstIdx.size(); I != E; ++I)
-    OS << InstIdx[I] << ", \t// " << CGIByEnum[I]->TheDef->getName() << "\n";
-  OS << "};\n\n";
+    Tables << InstIdx[I] << ", \t// " << CGIByEnum[I]->TheDef->getName()
+           << "\n";
+  Tables << "};\n\n";
+  // The table is indexed by opcode: catch any mismatch with the instruction
+  // enum, e.g. from a stale generated file, when compiling.
+  Tables << "static_assert(sizeof(OpcodeToSemaIdx) / "
+            "sizeof(OpcodeToSemaIdx[0]) == "
+         << TGName << "::INSTRUCTION_LIST_END,\n"
+         << "              \"The semantics don't match the " << TGName
+         << " instructions\");\n\n";
 
   std::vector<uint64_t> Constants(SemaTarget.ConstantIdx.size() + 1);
   for (SemanticsTarget::ConstantIdxMap::const_iterator
@@ -535,11 +627,20 @@ void SemanticsEmitter::run(raw_ostream &OS) {
            CE = SemaTarget.ConstantIdx.end();
        CI != CE; ++CI)
     Constants[CI->second] = CI->first;
-  OS << "const uint64_t ConstantArray[] = {\n";
+  Tables << "const uint64_t ConstantArray[] = {\n";
   for (unsigned I = 0, E = Constants.size(); I != E; ++I) {
-    OS.indent(2) << Constants[I] << "U,\n";
+    Tables.indent(2) << Constants[I] << "U,\n";
   }
-  OS << "};\n\n";
+  Tables << "};\n\n";
+
+  OS << Tables.str();
+  MD5 Hash;
+  Hash.update(Tables.str());
+  MD5::MD5Result Result;
+  Hash.final(Result);
+  SmallString<32> HashStr;
+  MD5::stringifyResult(Result, HashStr);
+  OS << "const char SemanticsHash[] = \"" << HashStr << "\";\n\n";
 
   OS << "\n} // end anonymous namespace\n";
   OS << "} // end namespace " << TGName << "\n";